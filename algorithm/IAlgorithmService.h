@@ -11,11 +11,25 @@
 #ifndef ALGORITHM_IALGORITHMSERVICE_H
 #define ALGORITHM_IALGORITHMSERVICE_H
 
-#include <string>
-#include <vector>
+#include "include/SmallBuffer.h"
+
+#include <cstddef>
 
 namespace algorithm {
 
+// 热路径结构体的内联容量: 典型负载（上下文4~8个int、几十字节的
+// 中文描述）完全落在内联存储内，每次决策/伤害计算零堆分配
+inline constexpr std::size_t kContextInlineCapacity = 8;
+inline constexpr std::size_t kEffectInlineCapacity = 48;
+inline constexpr std::size_t kDescriptionInlineCapacity = 64;
+
+/// 决策上下文向量（小缓冲优化，超长时退化为堆存储）
+using ContextVector = SmallVector<int, kContextInlineCapacity>;
+/// 伤害效果描述
+using EffectString = SmallString<kEffectInlineCapacity>;
+/// 行动描述
+using DescriptionString = SmallString<kDescriptionInlineCapacity>;
+
 /**
  * @brief 伤害计算请求参数
  * 
@@ -36,7 +50,7 @@ struct DamageRequest {
  */
 struct DamageResult {
     int damage;            ///< 计算出的最终伤害值，已考虑所有修正因子
-    std::string effect;    ///< 效果描述文本，如"暴击！"、"火元素灼烧"、"免疫"等
+    EffectString effect;   ///< 效果描述文本，如"暴击！"、"火元素灼烧"、"免疫"等
 };
 
 /**
@@ -47,7 +61,7 @@ struct DamageResult {
  */
 struct AIDecisionRequest {
     int npc_id;                ///< NPC编号，用于识别具体的NPC类型和行为模式
-    std::vector<int> context;  ///< 决策上下文信息数组，包含环境状态、玩家信息等
+    ContextVector context;     ///< 决策上下文信息数组，包含环境状态、玩家信息等
                               ///< context[0]: 与玩家的距离（游戏单位）
                               ///< context[1]: NPC当前血量百分比（0-100）
                               ///< context[2]: 是否处于战斗状态（0=非战斗，1=战斗）
@@ -70,7 +84,9 @@ struct AIDecisionResult {
                               ///< 4: 移动到新位置
                               ///< 5: 逃跑
                               ///< 6: 寻求帮助
-    std::string description;   ///< 行动的详细描述，用于日志记录和调试显示
+    DescriptionString description;  ///< 行动的详细描述，用于日志记录和调试显示
+    int reaction_delay_ms = 0; ///< 执行动作前的反应延迟（毫秒），由难度参数注入，
+                              ///< 0表示立即执行
 };
 
 /**
@@ -10,11 +10,15 @@
 
 #include "../IAlgorithmService.h"
 #include "CharacterStats.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
 #include <unordered_map>
+#include <utility>
 #include <vector>
-#include <deque>
 #include <memory>
-#include <functional>
+#include <span>
 #include <string>
 
 namespace algorithm {
@@ -30,6 +34,40 @@ enum class NPCType {
     Passive = 4    // 被动NPC
 };
 
+/**
+ * @brief 难度参数块
+ *
+ * 运行期难度系数，编译后的行为树在决策路径上按值读取。
+ * 调整难度只是写这组系数（按类型是一次数组写入），不触碰
+ * NPC类型注册，也不重建行为树；决策缓存缓存的是基础候选集，
+ * 难度在缓存命中之后逐NPC施加，因此调参也无需失效缓存。
+ */
+struct DifficultyParams {
+    /**
+     * @brief 进攻性系数
+     *
+     * 进攻类动作（攻击/技能/陷阱/必杀）的权重乘该值，
+     * 防御类（待机/防御/逃跑/治疗/求援）除该值；1.0为基准。
+     */
+    float aggression = 1.0f;
+
+    /**
+     * @brief 反应延迟（毫秒）
+     *
+     * 原样写入决策结果，由调用方在执行动作前等待；
+     * 0表示立即执行。
+     */
+    int reaction_delay_ms = 0;
+
+    /**
+     * @brief 技能选择温度
+     *
+     * 加权随机前权重做 w^(1/T) 变换：T<1收敛到最优动作
+     * （更难），T>1趋向均匀随机（更易）；1.0为基准分布。
+     */
+    float choice_temperature = 1.0f;
+};
+
 /**
  * @brief AI决策引擎
  * 支持多行为树、决策记忆和Boss阶段转换
@@ -45,6 +83,18 @@ public:
      */
     AIDecisionResult MakeDecision(const AIDecisionRequest& request);
 
+    /**
+     * @brief 批量执行AI决策
+     *
+     * 对同一区域的多个NPC一次性决策，结果顺序与请求一致。
+     * 批量较大时按worker线程并行求值（编译后的行为树只读共享，
+     * 决策记忆由内部互斥锁保护）。
+     * @param requests 各NPC的决策请求
+     * @return 每个NPC的决策结果
+     */
+    std::vector<AIDecisionResult> MakeDecisionsBatch(
+        std::span<const AIDecisionRequest> requests);
+
     /**
      * @brief 注册NPC类型
      * @param npc_id NPC ID
@@ -52,43 +102,242 @@ public:
      */
     void RegisterNPCType(int npc_id, NPCType type);
 
+    /**
+     * @brief 设置某NPC类型的难度基准
+     *
+     * 一次数组写入，立即对该类型所有NPC生效；不重注册类型、
+     * 不重建行为树、不失效决策缓存。并发决策中途改参时单次
+     * 决策可能读到新旧混合的系数，对在线调参无害。
+     * @param type NPC类型
+     * @param params 难度参数
+     */
+    void SetDifficulty(NPCType type, const DifficultyParams& params);
+
+    /**
+     * @brief 覆盖单个NPC的难度参数（A/B分组用）
+     *
+     * 优先于类型基准；未覆盖的NPC继续读类型基准。
+     * @param npc_id NPC ID
+     * @param params 难度参数
+     */
+    void SetNPCDifficulty(int npc_id, const DifficultyParams& params);
+
+    /**
+     * @brief 移除单NPC难度覆盖，回落到类型基准
+     * @param npc_id NPC ID (0=移除所有覆盖)
+     */
+    void ClearNPCDifficulty(int npc_id = 0);
+
+    /**
+     * @brief 读取某NPC类型当前的难度基准
+     * @param type NPC类型
+     */
+    DifficultyParams GetDifficulty(NPCType type) const;
+
     /**
      * @brief 清除决策记忆
+     *
+     * 清除所有时仅推进slab代数，常数时间完成。
      * @param npc_id NPC ID (0=清除所有)
      */
     void ClearMemory(int npc_id = 0);
 
+    /**
+     * @brief 设置决策记忆预算
+     *
+     * 重新分配记忆slab并清空现有记忆。超出预算的NPC不再记录
+     * 决策历史（反重复惩罚对其失效），内存占用有固定上限。
+     * @param max_npcs 最多追踪的NPC数量
+     */
+    void SetMemoryBudget(size_t max_npcs);
+
+    /**
+     * @brief 决策缓存统计
+     */
+    struct DecisionCacheStats {
+        size_t entries = 0;   ///< 当前缓存条目数
+        size_t hits = 0;      ///< 累计命中次数
+        size_t misses = 0;    ///< 累计未命中次数
+    };
+
+    /**
+     * @brief 失效某NPC类型的全部决策缓存条目
+     *
+     * 该类型的行为树或候选权重被外部调参后调用，
+     * 下次决策重新求值并回填。
+     * @param type NPC类型
+     */
+    void InvalidateDecisionCache(NPCType type);
+
+    /**
+     * @brief 获取决策缓存统计（监控用）
+     */
+    DecisionCacheStats GetDecisionCacheStats() const;
+
+    /**
+     * @brief 单个NPC的决策记忆快照（检查点持久化用）
+     */
+    struct DecisionMemorySnapshot {
+        int npc_id = 0;                  ///< NPC ID
+        std::vector<int> recent_actions; ///< 最近动作，最旧在前，至多MEMORY_SIZE条
+    };
+
+    /**
+     * @brief 导出全部NPC类型注册（检查点用），顺序不定
+     */
+    std::vector<std::pair<int, NPCType>> ExportNPCTypes() const;
+
+    /**
+     * @brief 导出全部NPC的决策记忆（检查点用），顺序不定
+     */
+    std::vector<DecisionMemorySnapshot> ExportDecisionMemory() const;
+
+    /**
+     * @brief 从检查点恢复决策记忆
+     *
+     * 按最旧在前的顺序重放进记忆环，使反重复惩罚在服务
+     * 重启后立即接续；超出记忆预算的NPC照常丢弃。
+     * @param snapshots 各NPC的记忆快照
+     */
+    void ImportDecisionMemory(const std::vector<DecisionMemorySnapshot>& snapshots);
+
 private:
     // 行为树节点类型
-    enum class NodeType {
+    enum class NodeType : uint8_t {
         SELECTOR,    // 选择节点：任一子节点成功即成功
         SEQUENCE,    // 序列节点：所有子节点都成功才成功
         CONDITION,   // 条件节点
         ACTION       // 动作节点
     };
 
+    // 条件编号: 编译后的条件节点通过switch分发，不经过std::function
+    enum class ConditionId : uint8_t {
+        None = 0,
+        EnemyNearby,
+        EnemyFar,
+        HealthLow,
+        HealthCritical,
+        HealthHigh,
+        HasMana,
+        HasLowMana,
+        InCombat,
+        HighThreat
+    };
+
+    // 构建期节点（仅在初始化时存在，编译后即丢弃）
     struct BehaviorNode {
         NodeType type;
         int node_id = 0;
         std::vector<std::shared_ptr<BehaviorNode>> children;
-        std::function<bool(const std::vector<int>&)> condition;
+        ConditionId condition = ConditionId::None;
         int action_id = 0;
         std::string description;
     };
 
-    // 行为树存储: NPCType → 行为树根节点
-    std::unordered_map<int, std::shared_ptr<BehaviorNode>> behavior_trees_;
+    /**
+     * @brief 编译后的行为树节点（POD）
+     *
+     * 节点按先根顺序平铺进连续数组，子节点通过索引区间引用，
+     * 评估时无虚调用、无std::function、无堆分配。
+     */
+    struct CompiledNode {
+        NodeType type = NodeType::ACTION;
+        ConditionId condition = ConditionId::None;
+        int action_id = 0;
+        uint16_t child_begin = 0;   // child_indices_ 中的起始下标
+        uint16_t child_count = 0;
+    };
+
+    // 编译后的行为树: 节点数组 + 子节点索引数组，0号为根
+    struct CompiledTree {
+        std::vector<CompiledNode> nodes;
+        std::vector<uint16_t> child_indices;
+    };
+
+    // 编译后的行为树存储: NPCType → 扁平树
+    std::unordered_map<int, CompiledTree> compiled_trees_;
 
     // NPC类型映射: npc_id → NPCType
     std::unordered_map<int, NPCType> npc_types_;
 
-    // 决策记忆: npc_id → 最近N次决策的action_id
-    std::unordered_map<int, std::deque<int>> decision_memory_;
+    // 难度参数: 按类型的基准块（NPCType直接下标，调参即数组写入）
+    static constexpr size_t NPC_TYPE_COUNT = 5;
+    std::array<DifficultyParams, NPC_TYPE_COUNT> difficulty_by_type_{};
+
+    // 单NPC难度覆盖（A/B分组），map变更由互斥锁保护
+    std::unordered_map<int, DifficultyParams> npc_difficulty_;
+    mutable std::mutex difficulty_mutex_;
+
+    // 温度的安全范围: 防止 w^(1/T) 上溢/塌缩
+    static constexpr float MIN_CHOICE_TEMPERATURE = 0.05f;
+    static constexpr float MAX_CHOICE_TEMPERATURE = 10.0f;
+
+    /**
+     * @brief 单个NPC的决策记忆环形缓冲元数据
+     *
+     * 记忆本体存放在共享slab的固定区段内（每NPC MEMORY_SIZE 条），
+     * epoch 与全局代数不一致时视为空环，整体清除无需touch slab。
+     */
+    struct MemoryRing {
+        uint32_t epoch = 0;
+        uint8_t head = 0;
+        uint8_t count = 0;
+    };
+
+    // 决策记忆: 单一连续slab上的定长环形缓冲（批量并行时由互斥锁保护）
+    std::vector<int> memory_slab_;                    // 预算NPC数 × MEMORY_SIZE
+    std::vector<MemoryRing> memory_rings_;            // 与slab区段平行
+    std::unordered_map<int, uint32_t> memory_slots_;  // npc_id → 环下标
+    uint32_t memory_epoch_ = 1;
+    mutable std::mutex memory_mutex_;
     static constexpr int MEMORY_SIZE = 5;
+    static constexpr size_t DEFAULT_MEMORY_BUDGET_NPCS = 4096;
+
+    // 批量决策并行阈值: 低于该数量直接串行求值
+    static constexpr size_t PARALLEL_BATCH_THRESHOLD = 16;
+
+    /**
+     * @brief 候选动作（动作ID + 基础权重）
+     */
+    struct ActionCandidate {
+        int action_id;
+        float weight;
+    };
+
+    /**
+     * @brief 量化情境的缓存值：树求值结果 + 候选动作集
+     *
+     * 行为树求值与候选集构建只依赖量化后的情境键，同键情境
+     * 共享一份结果；每NPC的反重复惩罚与加权随机仍逐次执行，
+     * 命中缓存不会让同类NPC的行为变得整齐划一。
+     */
+    struct CachedSituation {
+        bool tree_passed = false;
+        std::vector<ActionCandidate> candidates;
+    };
+
+    // 决策缓存: 量化情境键 → 树求值结果与候选集
+    // （键空间见SituationKey，远小于上限；上限仅作保险）
+    std::unordered_map<uint32_t, CachedSituation> decision_cache_;
+    mutable std::mutex cache_mutex_;
+    size_t cache_hits_ = 0;
+    size_t cache_misses_ = 0;
+    static constexpr size_t DECISION_CACHE_MAX_ENTRIES = 1024;
+
+    // Boss阶段阈值与预计算表: 初始化时把阶段阈值展开为
+    // HP百分比→阶段号 的直查表，各阶段候选动作集同步固化，
+    // 战斗中阶段切换只是数组下标，不再重走阈值判定
+    static constexpr int BOSS_PHASE_COUNT = 3;
+    static constexpr int BOSS_PHASE_DESPERATE_HP = 20;  // ≤20% 绝望
+    static constexpr int BOSS_PHASE_ENRAGE_HP = 50;     // ≤50% 狂暴
+    static constexpr int HP_PERCENT_MAX = 100;
+    std::array<uint8_t, HP_PERCENT_MAX + 1> boss_phase_by_hp_{};
+    std::array<std::vector<ActionCandidate>, BOSS_PHASE_COUNT> boss_phase_candidates_;
 
     // 初始化
     void InitializeBehaviorTrees();
     void InitializeActionWeights();
+    void PrecomputeBossPhases();
 
     // 行为树构建
     std::shared_ptr<BehaviorNode> BuildWarriorTree();
@@ -97,39 +346,69 @@ private:
     std::shared_ptr<BehaviorNode> BuildBossTree();
     std::shared_ptr<BehaviorNode> BuildPassiveTree();
 
-    // 行为树评估
-    bool EvaluateNode(const std::shared_ptr<BehaviorNode>& node,
-                      const std::vector<int>& context);
+    // 行为树编译: 指针树 → 扁平POD数组
+    static CompiledTree CompileTree(const std::shared_ptr<BehaviorNode>& root);
+    static uint16_t CompileNode(const std::shared_ptr<BehaviorNode>& node, CompiledTree& tree);
+
+    // 编译后行为树评估（按索引，无虚调用）
+    bool EvaluateCompiled(const CompiledTree& tree, uint16_t node_index,
+                          std::span<const int> context) const;
+    bool EvaluateCondition(ConditionId condition, std::span<const int> context) const;
 
     // 决策选择
-    int SelectBestAction(int npc_id, NPCType type, const std::vector<int>& context);
+    std::vector<ActionCandidate> BuildActionCandidates(NPCType type,
+        std::span<const int> context) const;
+    int ChooseWeightedAction(int npc_id, std::vector<ActionCandidate> candidates,
+        const DifficultyParams& difficulty);
     float GetRepetitionPenalty(int npc_id, int action_id) const;
+
+    /**
+     * @brief 解析某NPC生效的难度参数
+     *
+     * 单NPC覆盖优先，否则读类型基准。
+     */
+    DifficultyParams ResolveDifficulty(int npc_id, NPCType type) const;
+
+    /**
+     * @brief 动作是否属于进攻类（aggression系数的作用对象）
+     */
+    static bool IsOffensiveAction(int action_id);
     void RecordDecision(int npc_id, int action_id);
 
+    /**
+     * @brief 量化情境键
+     *
+     * 把决策路径实际读取的上下文字段折算成离散档位：
+     * NPC类型、HP档（条件阈值20/40/50对齐，含缺失档）、
+     * 距离档（≤5/≤10/>10）、战斗标志、高威胁标志、蓝量档。
+     * 同键情境下所有条件判定与Boss阶段结论完全一致，
+     * 因此缓存命中是精确的而非近似。
+     */
+    static uint32_t SituationKey(NPCType type, std::span<const int> context);
+
     // Boss阶段判定
-    int GetBossPhase(const std::vector<int>& context) const;
+    int GetBossPhase(std::span<const int> context) const;
 
     // 条件判断函数
-    bool IsEnemyNearby(const std::vector<int>& context) const;
-    bool IsEnemyFar(const std::vector<int>& context) const;
-    bool IsHealthLow(const std::vector<int>& context) const;
-    bool IsHealthCritical(const std::vector<int>& context) const;
-    bool IsHealthHigh(const std::vector<int>& context) const;
-    bool HasMana(const std::vector<int>& context) const;
-    bool HasLowMana(const std::vector<int>& context) const;
-    bool IsInCombat(const std::vector<int>& context) const;
-    bool IsHighThreat(const std::vector<int>& context) const;
-
-    // 描述生成
-    std::string GenerateActionDescription(int action_id, int npc_id, NPCType type) const;
+    bool IsEnemyNearby(std::span<const int> context) const;
+    bool IsEnemyFar(std::span<const int> context) const;
+    bool IsHealthLow(std::span<const int> context) const;
+    bool IsHealthCritical(std::span<const int> context) const;
+    bool IsHealthHigh(std::span<const int> context) const;
+    bool HasMana(std::span<const int> context) const;
+    bool HasLowMana(std::span<const int> context) const;
+    bool IsInCombat(std::span<const int> context) const;
+    bool IsHighThreat(std::span<const int> context) const;
+
+    // 描述生成（直接写入内联缓冲，不经过stringstream）
+    DescriptionString GenerateActionDescription(int action_id, int npc_id, NPCType type) const;
 
     // 辅助构建
     std::shared_ptr<BehaviorNode> MakeSelector(int id,
         std::vector<std::shared_ptr<BehaviorNode>> children);
     std::shared_ptr<BehaviorNode> MakeSequence(int id,
         std::vector<std::shared_ptr<BehaviorNode>> children);
-    std::shared_ptr<BehaviorNode> MakeCondition(int id,
-        std::function<bool(const std::vector<int>&)> cond);
+    std::shared_ptr<BehaviorNode> MakeCondition(int id, ConditionId cond);
     std::shared_ptr<BehaviorNode> MakeAction(int id, int action_id, const std::string& desc);
 };
 
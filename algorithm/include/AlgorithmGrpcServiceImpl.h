@@ -10,6 +10,14 @@
 
 #include <grpcpp/grpcpp.h>
 
+namespace net {
+class ClientRateLimiter;
+}
+
+namespace trace {
+class TraceRing;
+}
+
 namespace algorithm {
 
 /**
@@ -20,28 +28,86 @@ public:
     AlgorithmGrpcServiceImpl();
     ~AlgorithmGrpcServiceImpl() override = default;
 
+    /**
+     * @brief Per-process trace event ring for cross-layer tracing.
+     *
+     * RPC handlers record recv/send hops for trace ids carried in
+     * "x-trace-id" metadata; dump via trace::TraceRing::DumpCsv and
+     * merge with the other layers using tools/trace_merge.
+     */
+    static trace::TraceRing& TraceEvents();
+
+    /**
+     * @brief Per-process client rate limiter.
+     *
+     * Every handler checks the caller's token bucket for its RPC class
+     * before doing any work; exceeded budgets are answered with
+     * RESOURCE_EXHAUSTED. Exposed so ops tooling can read the per-class
+     * admitted/rejected overflow counters.
+     */
+    static net::ClientRateLimiter& RateLimiter();
+
+    /**
+     * @brief Underlying algorithm service.
+     *
+     * Exposed so main_server can drive state checkpointing and
+     * warm-start restore around the serving loop.
+     */
+    AlgorithmService& Service() { return service_; }
+
     grpc::Status CalculateDamage(
         grpc::ServerContext* context,
         const algorithm_proto::CalculationRequest* request,
         algorithm_proto::DamageResult* response) override;
 
+    grpc::Status CalculateDamageBatch(
+        grpc::ServerContext* context,
+        const algorithm_proto::BatchCalculationRequest* request,
+        algorithm_proto::BatchDamageResult* response) override;
+
     grpc::Status AIActionDecision(
         grpc::ServerContext* context,
         const algorithm_proto::AIDecisionRequest* request,
         algorithm_proto::ActionResponse* response) override;
 
+    grpc::Status BatchAIDecision(
+        grpc::ServerContext* context,
+        const algorithm_proto::BatchAIDecisionRequest* request,
+        algorithm_proto::BatchActionResponse* response) override;
+
     grpc::Status GetSkillTree(
         grpc::ServerContext* context,
         const algorithm_proto::SkillTreeRequest* request,
         algorithm_proto::SkillTree* response) override;
 
+    grpc::Status WatchSkillTree(
+        grpc::ServerContext* context,
+        const algorithm_proto::SkillTreeWatchRequest* request,
+        grpc::ServerWriter<algorithm_proto::SkillTreeDelta>* writer) override;
+
     grpc::Status ValidateInput(
         grpc::ServerContext* context,
         const algorithm_proto::ValidationRequest* request,
         algorithm_proto::ValidationResult* response) override;
 
+    grpc::Status FindPathBatch(
+        grpc::ServerContext* context,
+        const algorithm_proto::PathBatchRequest* request,
+        algorithm_proto::PathBatchResult* response) override;
+
 private:
     AlgorithmService service_;
+
+    // WatchSkillTree 的版本轮询间隔
+    static constexpr int WATCH_POLL_INTERVAL_MS = 500;
+
+    // Takes the result by value so the effect string is moved, not copied.
+    static void FillDamageResult(DamageResult result,
+                                 algorithm_proto::DamageResult* response);
+
+    static void FillSkillNode(const SkillNode& skill,
+                              const google::protobuf::RepeatedField<int32_t>& learned_skills,
+                              algorithm_proto::SkillNode* node);
 };
 
 } // namespace algorithm
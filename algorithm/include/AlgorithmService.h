@@ -11,11 +11,17 @@
 #include "../IAlgorithmService.h"
 #include "CharacterStats.h"
 #include "StatusEffect.h"
+#include "StatusEffectPool.h"
 #include "CooldownTracker.h"
 #include "InputValidator.h"
 #include "DamageCalculator.h"
+#include "SkillTreeManager.h"
 #include "AIDecisionEngine.h"
+#include "NavigationService.h"
+#include <cstdint>
 #include <memory>
+#include <span>
+#include <string>
 #include <vector>
 #include <unordered_map>
 
@@ -31,6 +37,7 @@ namespace algorithm {
  * - SkillTreeManager: 技能树管理（33+技能）
  * - InputValidator: 输入校验
  * - CooldownTracker: 技能冷却追踪
+ * - NavigationService: 寻路与移动可达性（预处理区域图）
  */
 class AlgorithmService : public IAlgorithmService {
 public:
@@ -42,6 +49,23 @@ public:
     DamageResult CalculateDamage(const DamageRequest& request) override;
     AIDecisionResult MakeAIDecision(const AIDecisionRequest& request) override;
 
+    /**
+     * @brief 批量伤害计算
+     *
+     * 一次解析多条伤害请求（典型场景：AoE 技能同时命中多个目标），
+     * 结果顺序与请求顺序一一对应。服务端单次循环完成，避免逐目标调用开销。
+     */
+    std::vector<DamageResult> CalculateDamageBatch(std::span<const DamageRequest> requests);
+
+    /**
+     * @brief 批量AI决策
+     *
+     * 同一区域的NPC共享大部分上下文，一次调用完成全部决策，
+     * 结果顺序与请求一致。大批量时由决策引擎并行求值。
+     */
+    std::vector<AIDecisionResult> MakeAIDecisionsBatch(
+        std::span<const AIDecisionRequest> requests);
+
     // ============ 扩展接口 ============
 
     /**
@@ -69,6 +93,18 @@ public:
      */
     void RegisterNPCType(int npc_id, NPCType type);
 
+    /**
+     * @brief 设置某NPC类型的AI难度基准
+     *
+     * 运行期调参，不重注册类型、不重建行为树。
+     */
+    void SetAIDifficulty(NPCType type, const DifficultyParams& params);
+
+    /**
+     * @brief 覆盖单个NPC的AI难度参数（A/B分组用）
+     */
+    void SetNPCAIDifficulty(int npc_id, const DifficultyParams& params);
+
     /**
      * @brief 获取技能信息
      */
@@ -79,6 +115,36 @@ public:
      */
     std::vector<const SkillNode*> GetSkillsByProfession(Profession profession) const;
 
+    /**
+     * @brief 获取技能树内容版本（增量订阅用）
+     */
+    uint64_t GetSkillTreeVersion() const;
+
+    /**
+     * @brief 上报角色技能状态，重算评估后技能树缓存
+     *
+     * 在升级/学习技能事件时调用一次；之后GetSkillTree查询与
+     * 伤害倍率读取都走预算的平铺数组，不再逐查询重推。
+     */
+    void UpdateCharacterSkillState(int character_id,
+                                   const std::vector<int>& learned_skills,
+                                   const std::vector<int>& skill_levels);
+
+    /**
+     * @brief 读取角色的评估后技能树（entries为空表示无缓存）
+     */
+    EvaluatedSkillTree GetEvaluatedSkillTree(int character_id) const;
+
+    /**
+     * @brief 序列化评估缓存，随玩家数据一起持久化
+     */
+    std::string SerializeEvaluatedSkillTree(int character_id) const;
+
+    /**
+     * @brief 从持久化负载恢复评估缓存（技能树版本不符时拒绝）
+     */
+    bool RestoreEvaluatedSkillTree(int character_id, const std::string& data);
+
     /**
      * @brief 检查技能冷却
      */
@@ -108,20 +174,83 @@ public:
     ValidationResult ValidateSkillLearn(int skill_id, Profession profession,
                                         const std::vector<int>& learned_skills) const;
 
+    /**
+     * @brief 批量校验字符串字段（ValidateInput RPC 使用）
+     *
+     * 校验器内部走编译好的规则跳转表，结果顺序与输入一致。
+     */
+    std::vector<ValidationResult> ValidateFields(
+        std::span<const std::pair<std::string, std::string>> fields) const;
+
     /**
      * @brief 获取元素克制倍率
      */
     float GetElementMultiplier(Element attacker, Element defender) const;
 
+    /**
+     * @brief 设置战斗随机种子（确定性重放/并行结算）
+     */
+    void SetBattleSeed(uint64_t seed);
+
+    /**
+     * @brief 把可恢复状态保存为本地检查点文件
+     *
+     * 覆盖角色注册、技能冷却与AI决策记忆/NPC类型注册；定长
+     * 二进制记录布局，恢复时可整体mmap直读。先写临时文件再
+     * 原子改名，崩溃不会留下半截检查点。实现见 StateCheckpoint.cpp。
+     *
+     * @param path 检查点文件路径
+     * @return 是否保存成功
+     */
+    bool SaveStateCheckpoint(const std::string& path) const;
+
+    /**
+     * @brief 从本地检查点文件热启动恢复状态
+     *
+     * 魔数/版本/长度校验不通过时整体拒绝，服务以冷状态启动。
+     *
+     * @param path 检查点文件路径
+     * @return 是否恢复成功（文件不存在视为失败）
+     */
+    bool LoadStateCheckpoint(const std::string& path);
+
+    /**
+     * @brief 注册地图可行走网格并预处理区域图
+     */
+    bool RegisterNavigationMap(int map_id, int width, int height,
+                               std::span<const uint8_t> walkable);
+
+    /**
+     * @brief 单条寻路（区域缓存 + 走廊A*）
+     */
+    PathResult FindPath(const PathQuery& query);
+
+    /**
+     * @brief 批量寻路，结果顺序与查询一致（FindPathBatch RPC 使用）
+     */
+    std::vector<PathResult> FindPathsBatch(std::span<const PathQuery> queries);
+
+    /**
+     * @brief O(1)可达性判定（策略层移动校验快路径）
+     */
+    bool IsPositionReachable(int map_id, GridPoint from, GridPoint to) const;
+
+    /**
+     * @brief 判断单格是否可行走
+     */
+    bool IsPositionWalkable(int map_id, GridPoint point) const;
+
 private:
     std::unique_ptr<DamageCalculator> damage_calculator_;
     std::unique_ptr<AIDecisionEngine> ai_engine_;
     std::unique_ptr<CharacterStatsRegistry> stats_registry_;
     std::unique_ptr<InputValidator> validator_;
+    std::unique_ptr<NavigationService> navigation_;
     CooldownTracker cooldown_tracker_;
 
-    // 角色状态效果: character_id → 状态列表
-    std::unordered_map<int, std::vector<StatusEffect>> status_effects_;
+    // 角色状态效果: 效果本体入池复用，角色只持有定长句柄列表
+    StatusEffectPool effect_pool_;
+    std::unordered_map<int, ActiveEffectList> active_effects_;
 };
 
 } // namespace algorithm
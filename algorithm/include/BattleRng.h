@@ -0,0 +1,103 @@
+/*
+ * 文件名: BattleRng.h
+ * 说明: 计数器式战斗随机数流（头文件 only）
+ * 作者: 彭承康
+ * 创建时间: 2026-08-27
+ */
+
+#ifndef ALGORITHM_BATTLE_RNG_H
+#define ALGORITHM_BATTLE_RNG_H
+
+#include <atomic>
+#include <cstdint>
+
+namespace algorithm {
+
+/**
+ * @brief 计数器式随机数流
+ *
+ * 第n个随机数只由 (种子, n) 决定: value = mix(seed, counter)，
+ * 与线程身份和取数时序无关。由此：
+ * - 同一种子完整重放一场战斗的所有伤害掷骰（回放调试）；
+ * - 并行结算时各目标按 reserve 预留的计数器区段独立取数，
+ *   多线程下结果仍与串行一致。
+ * 混合函数为 splitmix64 终结器（philox 同类的计数器构造）。
+ */
+class BattleRng {
+public:
+    BattleRng() = default;
+
+    explicit BattleRng(uint64_t seed) : seed_(seed) {}
+
+    /**
+     * @brief 重设种子并将计数器归零（开启新战斗的随机流）
+     */
+    void reseed(uint64_t seed) {
+        seed_ = seed;
+        counter_.store(0, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief 当前种子
+     */
+    uint64_t seed() const { return seed_; }
+
+    /**
+     * @brief 预留连续的计数器区段
+     *
+     * 并行批量结算在进入并行段前一次预留，各目标用
+     * 区段内固定偏移取数，结果与线程调度无关。
+     * @param count 预留数量
+     * @return 区段起始计数器
+     */
+    uint64_t reserve(uint64_t count) {
+        return counter_.fetch_add(count, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief 取下一个 [0,1) 随机数（计数器自增）
+     */
+    float uniform01() { return uniform01At(reserve(1)); }
+
+    /**
+     * @brief 取下一个 [min,max) 随机数（计数器自增）
+     */
+    float uniform(float min_value, float max_value) {
+        return uniformAt(reserve(1), min_value, max_value);
+    }
+
+    /**
+     * @brief 取指定计数器处的 [0,1) 随机数（无状态）
+     */
+    float uniform01At(uint64_t counter) const {
+        // 取高24位构造 [0,1) 单精度
+        uint64_t z = mix(seed_ ^ mix(counter));
+        return static_cast<float>(z >> 40) * (1.0f / 16777216.0f);
+    }
+
+    /**
+     * @brief 取指定计数器处的 [min,max) 随机数（无状态）
+     */
+    float uniformAt(uint64_t counter, float min_value, float max_value) const {
+        return min_value + (max_value - min_value) * uniform01At(counter);
+    }
+
+    BattleRng(const BattleRng&) = delete;
+    BattleRng& operator=(const BattleRng&) = delete;
+
+private:
+    // splitmix64 终结器
+    static uint64_t mix(uint64_t x) {
+        x += 0x9E3779B97F4A7C15ull;
+        x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+        x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+        return x ^ (x >> 31);
+    }
+
+    uint64_t seed_ = 0x5DEECE66Dull;
+    std::atomic<uint64_t> counter_{0};
+};
+
+} // namespace algorithm
+
+#endif // ALGORITHM_BATTLE_RNG_H
@@ -0,0 +1,167 @@
+/*
+ * 文件名: BulkStatusTicker.h
+ * 说明: 整场战斗的状态效果批量结算器（头文件 only）
+ * 作者: 彭承康
+ * 创建时间: 2026-08-28
+ */
+
+#ifndef ALGORITHM_BULK_STATUS_TICKER_H
+#define ALGORITHM_BULK_STATUS_TICKER_H
+
+#include "StatusEffect.h"
+#include <cstddef>
+#include <unordered_map>
+#include <vector>
+
+namespace algorithm {
+
+/**
+ * @brief 状态效果批量结算器
+ *
+ * 大型战斗每回合要结算数百个DoT/回复效果，逐角色逐效果调用
+ * StatusEffect的取值方法是数百次分散访存。本类把活动效果按列
+ * 存储（目标ID、每回合HP增量、剩余回合），tickAll()对各列做
+ * 一次线性遍历：累加每个目标的HP增量、递减剩余回合、就地压缩
+ * 过期效果，产出紧凑的HP变化列表交给BattleSystem统一套用。
+ *
+ * 效果类型语义在addEffect时折算成每回合HP增量（伤害为负、
+ * 回复为正，百分比效果按目标最大HP换算），热循环里不再有
+ * 按类型的分支。非HP类效果（眩晕、破防等）不属于本结算器，
+ * 继续走ActiveEffectList的逐效果路径。
+ */
+class BulkStatusTicker {
+public:
+    /**
+     * @brief 单个目标本回合的HP净变化
+     */
+    struct HpDelta {
+        int target_id = 0;     ///< 目标角色ID
+        float delta = 0.0f;    ///< HP变化（负为伤害，正为回复）
+    };
+
+    /**
+     * @brief 登记一个活动效果
+     *
+     * 仅接受逐回合改变HP的类型（Burn/Poison/Bleed/Regeneration），
+     * 其余类型忽略并返回false。
+     *
+     * @param target_id 目标角色ID
+     * @param type 效果类型
+     * @param magnitude 效果强度（与StatusEffect同语义）
+     * @param duration_turns 持续回合数
+     * @param target_max_hp 目标最大HP（百分比效果换算用）
+     * @return 是否已登记
+     */
+    bool addEffect(int target_id, StatusEffectType type, float magnitude,
+                   int duration_turns, float target_max_hp) {
+        if (duration_turns <= 0) {
+            return false;
+        }
+
+        float hp_per_turn = 0.0f;
+        switch (type) {
+            case StatusEffectType::Burn:
+            case StatusEffectType::Bleed:
+                hp_per_turn = -magnitude;
+                break;
+            case StatusEffectType::Poison:
+                hp_per_turn = -target_max_hp * magnitude;
+                break;
+            case StatusEffectType::Regeneration:
+                hp_per_turn = target_max_hp * magnitude;
+                break;
+            default:
+                return false;  // 非HP类效果不进入批量结算
+        }
+
+        target_ids_.push_back(target_id);
+        hp_per_turn_.push_back(hp_per_turn);
+        remaining_turns_.push_back(duration_turns);
+        return true;
+    }
+
+    /**
+     * @brief 结算一回合
+     *
+     * 对所有列做一次线性遍历：按目标累加HP增量、递减剩余回合，
+     * 过期效果与尾部交换后截断（不保持顺序）。
+     *
+     * @return 每个受影响目标一条HP净变化
+     */
+    std::vector<HpDelta> tickAll() {
+        // 热循环：顺序访存加累加，无虚调用、无按类型分支
+        std::unordered_map<int, float> accumulated;
+        accumulated.reserve(target_ids_.size());
+        for (std::size_t i = 0; i < target_ids_.size(); ++i) {
+            accumulated[target_ids_[i]] += hp_per_turn_[i];
+            --remaining_turns_[i];
+        }
+
+        // 压缩过期效果：与尾部交换，列保持致密
+        std::size_t count = target_ids_.size();
+        for (std::size_t i = 0; i < count;) {
+            if (remaining_turns_[i] <= 0) {
+                --count;
+                target_ids_[i] = target_ids_[count];
+                hp_per_turn_[i] = hp_per_turn_[count];
+                remaining_turns_[i] = remaining_turns_[count];
+            } else {
+                ++i;
+            }
+        }
+        target_ids_.resize(count);
+        hp_per_turn_.resize(count);
+        remaining_turns_.resize(count);
+
+        std::vector<HpDelta> deltas;
+        deltas.reserve(accumulated.size());
+        for (const auto& [target_id, delta] : accumulated) {
+            deltas.push_back(HpDelta{target_id, delta});
+        }
+        return deltas;
+    }
+
+    /**
+     * @brief 移除某个目标的全部效果（角色死亡/离场）
+     */
+    void removeTarget(int target_id) {
+        std::size_t count = target_ids_.size();
+        for (std::size_t i = 0; i < count;) {
+            if (target_ids_[i] == target_id) {
+                --count;
+                target_ids_[i] = target_ids_[count];
+                hp_per_turn_[i] = hp_per_turn_[count];
+                remaining_turns_[i] = remaining_turns_[count];
+            } else {
+                ++i;
+            }
+        }
+        target_ids_.resize(count);
+        hp_per_turn_.resize(count);
+        remaining_turns_.resize(count);
+    }
+
+    /**
+     * @brief 清空全部效果（战斗结束）
+     */
+    void clear() {
+        target_ids_.clear();
+        hp_per_turn_.clear();
+        remaining_turns_.clear();
+    }
+
+    /**
+     * @brief 当前活动效果数量
+     */
+    std::size_t size() const { return target_ids_.size(); }
+
+private:
+    // 列式存储：三条平行数组，tickAll按下标同步遍历
+    std::vector<int> target_ids_;       ///< 目标角色ID
+    std::vector<float> hp_per_turn_;    ///< 每回合HP增量（负伤害/正回复）
+    std::vector<int> remaining_turns_;  ///< 剩余回合数
+};
+
+} // namespace algorithm
+
+#endif // ALGORITHM_BULK_STATUS_TICKER_H
@@ -11,7 +11,6 @@
 #include <string>
 #include <unordered_map>
 #include <vector>
-#include <array>
 
 namespace algorithm {
 
@@ -89,9 +88,49 @@ struct CharacterStats {
     }
 };
 
+/**
+ * @brief SoA 布局的角色属性列（批量模拟用）
+ *
+ * 每个战斗相关字段一条连续数组，下标 i 为同一角色的一行。
+ * 服务端批量模拟逐角色遍历时按列线性扫描，避免逐个
+ * getCharacterStats 指针跳转造成的缓存不命中。
+ */
+struct CharacterStatsColumns {
+    std::vector<int> character_id;      ///< 角色ID
+    std::vector<float> current_hp;      ///< 当前生命值
+    std::vector<float> max_hp;          ///< 最大生命值
+    std::vector<float> attack;          ///< 物理攻击力
+    std::vector<float> defense;         ///< 物理防御力
+    std::vector<float> magic_attack;    ///< 魔法攻击力
+    std::vector<float> magic_defense;   ///< 魔法防御力
+    std::vector<float> crit_rate;       ///< 暴击率
+    std::vector<float> crit_damage;     ///< 暴击伤害加成
+    std::vector<Element> element;       ///< 元素属性
+
+    /**
+     * @brief 行数（已登记角色数量）
+     */
+    size_t size() const { return character_id.size(); }
+
+    /**
+     * @brief 清空所有列
+     */
+    void clear();
+
+    /**
+     * @brief 追加一行
+     */
+    void appendRow(const CharacterStats& stats);
+
+    /**
+     * @brief 覆盖写第 row 行
+     */
+    void writeRow(size_t row, const CharacterStats& stats);
+};
+
 /**
  * @brief 角色属性注册表
- * 管理默认属性模板和元素克制矩阵
+ * 管理默认属性模板（元素克制矩阵见 ElementTables.h）
  */
 class CharacterStatsRegistry {
 public:
@@ -126,6 +165,35 @@ public:
      */
     const CharacterStats* getCharacterStats(int character_id) const;
 
+    /**
+     * @brief 导出全部已注册角色（检查点持久化用），顺序不定
+     */
+    std::vector<CharacterStats> getAllCharacters() const;
+
+    /**
+     * @brief 获取 SoA 布局的属性列视图
+     *
+     * 列与注册表保持同步（registerCharacter 时增量更新），
+     * 模拟循环可直接按列流式遍历全部已注册角色。
+     */
+    const CharacterStatsColumns& getStatsColumns() const { return columns_; }
+
+    /**
+     * @brief 查询角色在属性列中的行号
+     * @param character_id 角色ID
+     * @return 行号，不存在则返回 -1
+     */
+    int getStatsRow(int character_id) const;
+
+    /**
+     * @brief 批量收集指定角色的属性列
+     * @param character_ids 角色ID列表
+     * @param out 输出列（覆盖写），仅包含已注册角色，顺序与输入一致
+     * @return 实际收集到的角色数量
+     */
+    size_t gatherStats(const std::vector<int>& character_ids,
+                       CharacterStatsColumns& out) const;
+
     /**
      * @brief 根据等级缩放属性
      * @param base 基础属性
@@ -135,16 +203,16 @@ public:
     static CharacterStats scaleByLevel(const CharacterStats& base, int level);
 
 private:
-    // 元素克制矩阵 [攻击者元素][防御者元素]
-    std::array<std::array<float, ELEMENT_COUNT>, ELEMENT_COUNT> element_matrix_;
-
     // 职业默认属性模板 (1级)
     std::unordered_map<int, CharacterStats> profession_defaults_;
 
     // 已注册角色
     std::unordered_map<int, CharacterStats> characters_;
 
-    void initializeElementMatrix();
+    // SoA 属性列与行号索引: character_id → 行号
+    CharacterStatsColumns columns_;
+    std::unordered_map<int, size_t> column_rows_;
+
     void initializeProfessionDefaults();
 };
 
@@ -3,25 +3,38 @@
  * 说明: 技能冷却追踪系统（头文件 only）
  * 作者: 彭承康
  * 创建时间: 2025-07-24
+ * 更新时间: 2026-08-27 — 分片并发结构 + 原子时钟，消除全局串行化
  */
 
 #ifndef ALGORITHM_COOLDOWN_TRACKER_H
 #define ALGORITHM_COOLDOWN_TRACKER_H
 
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <shared_mutex>
 #include <unordered_map>
-#include <string>
 #include <vector>
 
 namespace algorithm {
 
 /**
  * @brief 技能冷却追踪器
- * 管理每个角色每个技能的冷却状态
+ *
+ * 管理每个角色每个技能的冷却状态，支持多个战斗会话并发访问：
+ * - 冷却记录按角色ID分片，每片独立读写锁，不同角色互不阻塞；
+ * - 冷却存储为绝对到期时刻而非剩余毫秒，推进时间只需原子地
+ *   前移共享时钟（tickAll 为 O(1)，无需遍历、无需任何锁）。
  */
 class CooldownTracker {
 public:
     CooldownTracker() = default;
 
+    // 分片内含锁，不可拷贝
+    CooldownTracker(const CooldownTracker&) = delete;
+    CooldownTracker& operator=(const CooldownTracker&) = delete;
+
     /**
      * @brief 启动冷却
      * @param character_id 角色ID
@@ -29,7 +42,10 @@ public:
      * @param cooldown_ms 冷却时间（毫秒）
      */
     void startCooldown(int character_id, int skill_id, int cooldown_ms) {
-        cooldowns_[character_id][skill_id] = cooldown_ms;
+        const int64_t ready_at = now_ms_.load(std::memory_order_relaxed) + cooldown_ms;
+        Shard& shard = shardFor(character_id);
+        std::unique_lock lock(shard.mutex);
+        shard.ready_at[makeKey(character_id, skill_id)] = ready_at;
     }
 
     /**
@@ -39,11 +55,11 @@ public:
      * @return true 表示可用
      */
     bool isReady(int character_id, int skill_id) const {
-        auto char_it = cooldowns_.find(character_id);
-        if (char_it == cooldowns_.end()) return true;
-        auto skill_it = char_it->second.find(skill_id);
-        if (skill_it == char_it->second.end()) return true;
-        return skill_it->second <= 0;
+        const Shard& shard = shardFor(character_id);
+        std::shared_lock lock(shard.mutex);
+        auto it = shard.ready_at.find(makeKey(character_id, skill_id));
+        if (it == shard.ready_at.end()) return true;
+        return it->second <= now_ms_.load(std::memory_order_relaxed);
     }
 
     /**
@@ -53,25 +69,30 @@ public:
      * @return 剩余毫秒数，0表示已就绪
      */
     int getRemainingCooldown(int character_id, int skill_id) const {
-        auto char_it = cooldowns_.find(character_id);
-        if (char_it == cooldowns_.end()) return 0;
-        auto skill_it = char_it->second.find(skill_id);
-        if (skill_it == char_it->second.end()) return 0;
-        return skill_it->second > 0 ? skill_it->second : 0;
+        const Shard& shard = shardFor(character_id);
+        std::shared_lock lock(shard.mutex);
+        auto it = shard.ready_at.find(makeKey(character_id, skill_id));
+        if (it == shard.ready_at.end()) return 0;
+        const int64_t remaining = it->second - now_ms_.load(std::memory_order_relaxed);
+        return remaining > 0 ? static_cast<int>(remaining) : 0;
+    }
+
+    /**
+     * @brief 批量推进所有冷却（每帧/每回合调用）
+     *
+     * 只原子前移共享时钟，O(1)，可与任意查询并发执行。
+     * @param delta_ms 经过的时间（毫秒）
+     */
+    void tickAll(int delta_ms) {
+        now_ms_.fetch_add(delta_ms, std::memory_order_relaxed);
     }
 
     /**
-     * @brief 更新所有冷却（每帧/每回合调用）
+     * @brief 推进所有冷却（兼容旧接口，等价于 tickAll）
      * @param delta_ms 经过的时间（毫秒）
      */
     void tick(int delta_ms) {
-        for (auto& [char_id, skills] : cooldowns_) {
-            for (auto& [skill_id, remaining] : skills) {
-                if (remaining > 0) {
-                    remaining -= delta_ms;
-                }
-            }
-        }
+        tickAll(delta_ms);
     }
 
     /**
@@ -79,14 +100,25 @@ public:
      * @param character_id 角色ID
      */
     void resetCharacterCooldowns(int character_id) {
-        cooldowns_.erase(character_id);
+        Shard& shard = shardFor(character_id);
+        std::unique_lock lock(shard.mutex);
+        for (auto it = shard.ready_at.begin(); it != shard.ready_at.end();) {
+            if (characterOf(it->first) == character_id) {
+                it = shard.ready_at.erase(it);
+            } else {
+                ++it;
+            }
+        }
     }
 
     /**
      * @brief 重置所有冷却
      */
     void resetAll() {
-        cooldowns_.clear();
+        for (Shard& shard : shards_) {
+            std::unique_lock lock(shard.mutex);
+            shard.ready_at.clear();
+        }
     }
 
     /**
@@ -96,20 +128,97 @@ public:
      */
     std::vector<int> getCooldownSkills(int character_id) const {
         std::vector<int> result;
-        auto char_it = cooldowns_.find(character_id);
-        if (char_it != cooldowns_.end()) {
-            for (const auto& [skill_id, remaining] : char_it->second) {
-                if (remaining > 0) {
-                    result.push_back(skill_id);
-                }
+        const int64_t now = now_ms_.load(std::memory_order_relaxed);
+        const Shard& shard = shardFor(character_id);
+        std::shared_lock lock(shard.mutex);
+        for (const auto& [key, ready_at] : shard.ready_at) {
+            if (characterOf(key) == character_id && ready_at > now) {
+                result.push_back(skillOf(key));
             }
         }
         return result;
     }
 
+    /**
+     * @brief 冷却快照条目（检查点持久化用）
+     *
+     * key 为内部复合键 (character_id, skill_id)，对调用方不透明，
+     * 仅用于原样导出/导入。
+     */
+    struct SnapshotEntry {
+        int64_t key = 0;          ///< (character_id << 32) | skill_id
+        int64_t ready_at_ms = 0;  ///< 冷却到期时刻（共享时钟毫秒）
+    };
+
+    /**
+     * @brief 导出全部未到期的冷却记录（检查点用）
+     * @param out 输出条目（覆盖写），顺序不定
+     * @return 当前共享时钟（毫秒）
+     */
+    int64_t exportState(std::vector<SnapshotEntry>& out) const {
+        out.clear();
+        const int64_t now = now_ms_.load(std::memory_order_relaxed);
+        for (const Shard& shard : shards_) {
+            std::shared_lock lock(shard.mutex);
+            for (const auto& [key, ready_at] : shard.ready_at) {
+                if (ready_at > now) {
+                    out.push_back(SnapshotEntry{key, ready_at});
+                }
+            }
+        }
+        return now;
+    }
+
+    /**
+     * @brief 从检查点恢复冷却状态（覆盖现有状态）
+     * @param now_ms 检查点保存时的共享时钟
+     * @param entries 冷却条目
+     */
+    void importState(int64_t now_ms, const std::vector<SnapshotEntry>& entries) {
+        resetAll();
+        now_ms_.store(now_ms, std::memory_order_relaxed);
+        for (const SnapshotEntry& entry : entries) {
+            if (entry.ready_at_ms <= now_ms) continue;
+            Shard& shard = shardFor(characterOf(entry.key));
+            std::unique_lock lock(shard.mutex);
+            shard.ready_at[entry.key] = entry.ready_at_ms;
+        }
+    }
+
 private:
-    // character_id → (skill_id → remaining_ms)
-    std::unordered_map<int, std::unordered_map<int, int>> cooldowns_;
+    static constexpr size_t SHARD_COUNT = 16;
+
+    struct Shard {
+        mutable std::shared_mutex mutex;
+        // (character_id, skill_id) → 冷却到期时刻（共享时钟毫秒）
+        std::unordered_map<int64_t, int64_t> ready_at;
+    };
+
+    static int64_t makeKey(int character_id, int skill_id) {
+        return (static_cast<int64_t>(character_id) << 32) |
+               static_cast<int64_t>(static_cast<uint32_t>(skill_id));
+    }
+
+    static int characterOf(int64_t key) {
+        return static_cast<int>(key >> 32);
+    }
+
+    static int skillOf(int64_t key) {
+        return static_cast<int>(static_cast<uint32_t>(key));
+    }
+
+    Shard& shardFor(int character_id) {
+        return shards_[static_cast<uint32_t>(character_id) % SHARD_COUNT];
+    }
+
+    const Shard& shardFor(int character_id) const {
+        return shards_[static_cast<uint32_t>(character_id) % SHARD_COUNT];
+    }
+
+    std::array<Shard, SHARD_COUNT> shards_;
+
+    // 共享冷却时钟（单调递增毫秒）
+    std::atomic<int64_t> now_ms_{0};
 };
 
 } // namespace algorithm
@@ -0,0 +1,61 @@
+/*
+ * 文件名: DamageBatchKernel.h
+ * 说明: 批量伤害计算内核，SoA 布局 + SIMD 一次处理多个目标
+ * 作者: 彭承康
+ * 创建时间: 2026-08-27
+ *
+ * 核心伤害公式 (与 DamageCalculator 保持一致):
+ *   final = base * element_mult * (1 - defense/(defense+100)) * crit * buff * variance
+ *
+ * 对 AoE 技能命中 N 个目标的场景，把各因子展开成结构数组（SoA），
+ * 内核在 SSE2 可用时每次处理 4 个目标，其余平台回退到标量循环。
+ */
+
+#ifndef ALGORITHM_DAMAGE_BATCH_KERNEL_H
+#define ALGORITHM_DAMAGE_BATCH_KERNEL_H
+
+#include <cstddef>
+#include <vector>
+
+namespace algorithm {
+
+/**
+ * @brief 批量伤害计算输入（结构数组布局）
+ *
+ * 所有数组长度必须一致，下标 i 对应第 i 个目标。
+ * Pure 伤害目标的 defense 填 0，非暴击目标的 crit_multiplier 填 1。
+ */
+struct DamageBatchSoA {
+    std::vector<float> base_damage;         ///< 基础伤害 = 属性值 × 技能倍率
+    std::vector<float> element_multiplier;  ///< 元素克制倍率
+    std::vector<float> defense;             ///< 有效防御值（已含破防debuff）
+    std::vector<float> crit_multiplier;     ///< 暴击倍率（非暴击为1.0）
+    std::vector<float> attack_buff;         ///< 攻击buff倍率
+    std::vector<float> variance;            ///< 随机浮动因子
+
+    /**
+     * @brief 目标数量
+     */
+    size_t size() const { return base_damage.size(); }
+
+    /**
+     * @brief 预分配 N 个目标的存储
+     */
+    void reserve(size_t count);
+};
+
+/**
+ * @brief 批量计算最终伤害
+ *
+ * 对 input 中的每个目标套用核心伤害公式，结果写入 out_damage
+ * （覆盖写，长度调整为 input.size()）。结果不含护盾吸收与最低
+ * 伤害截断，由调用方按目标逐个收尾。
+ *
+ * @param input 结构数组布局的各伤害因子
+ * @param out_damage 每个目标的最终伤害值
+ */
+void ComputeDamageBatch(const DamageBatchSoA& input, std::vector<float>& out_damage);
+
+} // namespace algorithm
+
+#endif // ALGORITHM_DAMAGE_BATCH_KERNEL_H
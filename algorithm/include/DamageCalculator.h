@@ -10,8 +10,10 @@
 #define ALGORITHM_DAMAGE_CALCULATOR_H
 
 #include "../IAlgorithmService.h"
+#include "BattleRng.h"
 #include "CharacterStats.h"
 #include "StatusEffect.h"
+#include <cstdint>
 #include <memory>
 #include <vector>
 
@@ -32,6 +34,21 @@ struct ExtendedDamageRequest {
     std::vector<StatusEffect> defender_effects;   // 防御者身上的状态效果
 };
 
+/**
+ * @brief AoE 伤害计算请求（内部使用）
+ *
+ * 同一攻击者用同一技能命中多个目标，各因子以 SoA 布局
+ * 喂给 SIMD 内核一次算完，避免逐目标走 CalculateExtendedDamage。
+ */
+struct AoeDamageRequest {
+    CharacterStats attacker;
+    std::vector<CharacterStats> defenders;
+    int skill_id = 1;
+    int skill_level = 1;
+    std::vector<StatusEffect> attacker_effects;              // 攻击者身上的状态效果
+    std::vector<std::vector<StatusEffect>> defender_effects;  // 为空或与 defenders 等长
+};
+
 /**
  * @brief 扩展伤害结果（内部使用）
  */
@@ -68,11 +85,30 @@ public:
      */
     ExtendedDamageResult CalculateExtendedDamage(const ExtendedDamageRequest& request);
 
+    /**
+     * @brief AoE 批量伤害计算
+     *
+     * 对所有目标一次性套用核心伤害公式（SIMD 内核），
+     * 结果顺序与 request.defenders 一一对应。
+     * @param request AoE 伤害请求
+     * @return 每个目标的扩展伤害结果
+     */
+    std::vector<ExtendedDamageResult> CalculateAoeDamage(const AoeDamageRequest& request);
+
     /**
      * @brief 设置角色属性注册表引用
      */
     void setStatsRegistry(CharacterStatsRegistry* registry) { stats_registry_ = registry; }
 
+    /**
+     * @brief 设置战斗随机种子
+     *
+     * 同一种子下整场战斗的掷骰序列确定可重放，
+     * 并行批量结算的结果也与串行一致（见 BattleRng）。
+     * @param seed 战斗种子
+     */
+    void setBattleSeed(uint64_t seed) { rng_.reseed(seed); }
+
     /**
      * @brief 获取技能管理器
      */
@@ -82,18 +118,23 @@ private:
     std::unique_ptr<SkillTreeManager> skill_manager_;
     CharacterStatsRegistry* stats_registry_ = nullptr;  // 不拥有
 
+    // 战斗随机流（const计算步骤取数需要mutable）
+    mutable BattleRng rng_;
+
     // 核心计算步骤
     float CalculateBaseDamage(const CharacterStats& attacker, const SkillNode* skill,
                               int skill_level, DamageType damage_type) const;
     float ApplyElementMultiplier(Element attacker_elem, Element defender_elem) const;
     float ApplyDefenseReduction(const CharacterStats& defender, DamageType damage_type,
                                 const std::vector<StatusEffect>& defender_effects) const;
+    float GetCriticalChance(const CharacterStats& attacker) const;
     bool RollCritical(const CharacterStats& attacker) const;
     float GetCriticalMultiplier(const CharacterStats& attacker) const;
     float GetAttackBuffMultiplier(const std::vector<StatusEffect>& effects) const;
     float GetRandomVariance() const;
     float ApplyShieldAbsorption(float damage, const std::vector<StatusEffect>& defender_effects) const;
     std::vector<StatusEffect> DetermineAppliedEffects(const SkillNode* skill) const;
+    std::vector<StatusEffect> DetermineAppliedEffects(const SkillNode* skill, float roll) const;
     std::string GenerateEffectDescription(const ExtendedDamageResult& result,
                                           const SkillNode* skill) const;
 };
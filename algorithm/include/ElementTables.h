@@ -0,0 +1,146 @@
+/*
+ * 文件名: ElementTables.h
+ * 说明: 编译期元素克制矩阵与等级加成表（头文件 only）
+ * 作者: 彭承康
+ * 创建时间: 2026-08-27
+ */
+
+#ifndef ALGORITHM_ELEMENT_TABLES_H
+#define ALGORITHM_ELEMENT_TABLES_H
+
+#include "CharacterStats.h"
+#include <array>
+
+namespace algorithm {
+
+// ============================================================================
+// 元素克制矩阵（编译期求值）
+//
+// 克制关系是固定的游戏规则，没有必要在运行期逐实例构建。
+// 矩阵以 constexpr 数组形式进入只读数据段，热路径查询
+// 编译为两次下标加载。
+// ============================================================================
+
+namespace detail {
+
+constexpr std::array<std::array<float, ELEMENT_COUNT>, ELEMENT_COUNT>
+buildElementMatrix() {
+    std::array<std::array<float, ELEMENT_COUNT>, ELEMENT_COUNT> matrix{};
+    for (auto& row : matrix) {
+        for (auto& cell : row) {
+            cell = 1.0f;
+        }
+    }
+
+    constexpr int fire = static_cast<int>(Element::Fire);
+    constexpr int water = static_cast<int>(Element::Water);
+    constexpr int grass = static_cast<int>(Element::Grass);
+    constexpr int light = static_cast<int>(Element::Light);
+    constexpr int dark = static_cast<int>(Element::Dark);
+
+    // 火 → 水: 0.5x (不利), 水 → 火: 2.0x (克制)
+    matrix[fire][water] = 0.5f;
+    matrix[water][fire] = 2.0f;
+
+    // 火 → 草: 2.0x (克制), 草 → 火: 0.5x (不利)
+    matrix[fire][grass] = 2.0f;
+    matrix[grass][fire] = 0.5f;
+
+    // 水 → 草: 0.5x (不利), 草 → 水: 2.0x (克制)
+    matrix[water][grass] = 0.5f;
+    matrix[grass][water] = 2.0f;
+
+    // 光 ↔ 暗: 互相克制 2.0x
+    matrix[light][dark] = 2.0f;
+    matrix[dark][light] = 2.0f;
+
+    // 同元素: 0.75x
+    matrix[fire][fire] = 0.75f;
+    matrix[water][water] = 0.75f;
+    matrix[grass][grass] = 0.75f;
+    matrix[light][light] = 0.75f;
+    matrix[dark][dark] = 0.75f;
+
+    return matrix;
+}
+
+} // namespace detail
+
+/// 元素克制矩阵: ELEMENT_MATRIX[攻方][守方]
+inline constexpr auto ELEMENT_MATRIX = detail::buildElementMatrix();
+
+/**
+ * @brief 元素克制倍率查询（运行期元素）
+ */
+constexpr float GetElementMatrixMultiplier(Element attacker, Element defender) {
+    int atk = static_cast<int>(attacker);
+    int def = static_cast<int>(defender);
+    if (atk < 0 || atk >= ELEMENT_COUNT || def < 0 || def >= ELEMENT_COUNT) {
+        return 1.0f;
+    }
+    return ELEMENT_MATRIX[atk][def];
+}
+
+/**
+ * @brief 元素克制倍率（编译期元素特化路径）
+ *
+ * 战斗双方元素在编译期已知时（如单元素副本的固定敌人），
+ * 倍率折叠为常量，公式中不再有查表。
+ */
+template <Element ATTACKER, Element DEFENDER>
+constexpr float ElementMultiplierOf() {
+    return ELEMENT_MATRIX[static_cast<int>(ATTACKER)][static_cast<int>(DEFENDER)];
+}
+
+static_assert(ElementMultiplierOf<Element::Water, Element::Fire>() == 2.0f);
+static_assert(ElementMultiplierOf<Element::Fire, Element::Water>() == 0.5f);
+static_assert(ElementMultiplierOf<Element::Fire, Element::Fire>() == 0.75f);
+static_assert(GetElementMatrixMultiplier(Element::None, Element::Dark) == 1.0f);
+
+// ============================================================================
+// 技能等级加成表（编译期求值）
+//
+// 每级+10%倍率 / 每级-5%冷却（至多-50%）是固定曲线，
+// 预先展开为表后热路径无乘法链。
+// ============================================================================
+
+/// 支持的最高技能等级（SkillNode::max_level 不超过此值）
+constexpr int MAX_SKILL_LEVEL = 10;
+
+namespace detail {
+
+constexpr std::array<float, MAX_SKILL_LEVEL + 1> buildLevelMultiplierBonus() {
+    std::array<float, MAX_SKILL_LEVEL + 1> table{};
+    for (int level = 0; level <= MAX_SKILL_LEVEL; ++level) {
+        // 每级+10%倍率
+        table[level] = 1.0f + (level > 0 ? (level - 1) * 0.10f : 0.0f);
+    }
+    return table;
+}
+
+constexpr std::array<float, MAX_SKILL_LEVEL + 1> buildLevelCooldownFactor() {
+    std::array<float, MAX_SKILL_LEVEL + 1> table{};
+    for (int level = 0; level <= MAX_SKILL_LEVEL; ++level) {
+        // 每级-5%冷却，最多减50%
+        float reduction = 1.0f - (level > 0 ? (level - 1) * 0.05f : 0.0f);
+        table[level] = reduction < 0.5f ? 0.5f : reduction;
+    }
+    return table;
+}
+
+} // namespace detail
+
+/// 技能等级 → 倍率加成 (下标=等级，0号与1级相同)
+inline constexpr auto SKILL_LEVEL_MULTIPLIER_BONUS = detail::buildLevelMultiplierBonus();
+
+/// 技能等级 → 冷却系数 (下标=等级)
+inline constexpr auto SKILL_LEVEL_COOLDOWN_FACTOR = detail::buildLevelCooldownFactor();
+
+static_assert(SKILL_LEVEL_MULTIPLIER_BONUS[1] == 1.0f);
+static_assert(SKILL_LEVEL_MULTIPLIER_BONUS[3] == 1.0f + 2 * 0.10f);
+static_assert(SKILL_LEVEL_COOLDOWN_FACTOR[1] == 1.0f);
+static_assert(SKILL_LEVEL_COOLDOWN_FACTOR[5] == 1.0f - 4 * 0.05f);
+
+} // namespace algorithm
+
+#endif // ALGORITHM_ELEMENT_TABLES_H
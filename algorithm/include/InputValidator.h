@@ -10,7 +10,12 @@
 
 #include "../IAlgorithmService.h"
 #include "CharacterStats.h"
+#include <array>
+#include <cstdint>
+#include <span>
 #include <string>
+#include <string_view>
+#include <utility>
 #include <vector>
 
 namespace algorithm {
@@ -82,7 +87,61 @@ public:
      */
     ValidationResult validateCharacterStats(const CharacterStats& stats) const;
 
+    /**
+     * @brief 校验单个字符串字段
+     *
+     * ValidateInput RPC 的字段走规则表分发: 构造时将已知字段规则
+     * 编译成按首字符分桶的跳转表，查询无需哈希探测和逐条字符串比较。
+     * 未知字段回退到非空校验。
+     * @param field_name 字段名
+     * @param value 字段值
+     * @return 校验结果
+     */
+    ValidationResult validateField(std::string_view field_name,
+                                   std::string_view value) const;
+
+    /**
+     * @brief 批量校验字符串字段
+     *
+     * 一次调用完成整批字段校验，结果顺序与输入一致，
+     * 供 ValidateInput RPC 在多字段载荷上摊薄单次校验开销。
+     * @param fields 字段名/值对列表
+     * @return 每个字段的校验结果
+     */
+    std::vector<ValidationResult> validateFields(
+        std::span<const std::pair<std::string, std::string>> fields) const;
+
 private:
+    // ============ 编译后的字段规则表 ============
+
+    // 规则种类
+    enum class FieldRule : uint8_t {
+        NonEmpty,     // 仅要求非空
+        IntRange,     // 整数且在[min,max]内
+        FloatRange,   // 浮点且在[min,max]内
+        PlayerName,   // 玩家名（查表字节分类，见 ValidatedString.h）
+        ChatLine      // 聊天行（查表字节分类，见 ValidatedString.h）
+    };
+
+    struct RuleSpec {
+        std::string_view name;
+        FieldRule rule = FieldRule::NonEmpty;
+        float min_value = 0.0f;
+        float max_value = 0.0f;
+    };
+
+    // 首字符 → compiled_rules_ 中的区间
+    struct RuleBucket {
+        uint16_t begin = 0;
+        uint16_t count = 0;
+    };
+
+    std::array<RuleBucket, 256> rule_buckets_{};
+    std::vector<RuleSpec> compiled_rules_;
+
+    // 构造时把静态规则定义编译为分桶跳转表
+    void compileFieldRules();
+
     static constexpr int MAX_CHARACTER_ID = 100000;
     static constexpr int MAX_SKILL_ID = 10000;
     static constexpr int MAX_NPC_ID = 100000;
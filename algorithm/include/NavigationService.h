@@ -0,0 +1,191 @@
+/*
+ * 文件名: NavigationService.h
+ * 说明: 导航服务，预处理可行走网格与分层区域图，提供批量寻路
+ * 作者: 彭承康
+ * 创建时间: 2026-08-28
+ */
+#ifndef ALGORITHM_NAVIGATIONSERVICE_H
+#define ALGORITHM_NAVIGATIONSERVICE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <shared_mutex>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+namespace algorithm {
+
+/**
+ * @brief 网格坐标（格为单位，左上角为原点）
+ */
+struct GridPoint {
+    int x = 0;
+    int y = 0;
+};
+
+/**
+ * @brief 单条寻路查询
+ */
+struct PathQuery {
+    int map_id = 0;
+    GridPoint start;
+    GridPoint goal;
+};
+
+/**
+ * @brief 寻路结果
+ *
+ * waypoints 为拐点序列（含起点与终点），沿相邻拐点直线行走
+ * 即为完整路径；不可达时为空。
+ */
+struct PathResult {
+    bool reachable = false;
+    bool from_cache = false;         ///< 区域级路径命中LRU缓存
+    std::vector<GridPoint> waypoints;
+};
+
+/**
+ * @brief 导航服务
+ *
+ * 地图注册时一次性完成预处理：可行走网格按 REGION_SIZE×REGION_SIZE
+ * 分块，块内连通的可行走格聚成区域，区域间邻接关系构成分层图，
+ * 并对区域图做连通分量标号。之后：
+ * - 可达性判定只比较两端区域的分量号，O(1)，供策略层移动校验
+ *   高频调用；
+ * - 寻路先在区域图上求区域序列（(起区域,终区域) 为键的LRU缓存，
+ *   同走廊的重复查询不再重搜区域图），再在走廊内做格级A*细化；
+ * - 批量接口一次锁内完成整批查询，供 FindPathBatch RPC 使用。
+ *
+ * 注册/注销为低频操作走独占锁，查询走共享锁并发执行；
+ * 区域路径缓存由独立互斥锁保护。
+ */
+class NavigationService {
+public:
+    NavigationService() = default;
+
+    // 内含锁，不可拷贝
+    NavigationService(const NavigationService&) = delete;
+    NavigationService& operator=(const NavigationService&) = delete;
+
+    /**
+     * @brief 注册地图并预处理区域图
+     *
+     * 重复注册同一地图时整体替换，并失效该地图的全部路径缓存。
+     * @param map_id 地图ID
+     * @param width 网格宽（格数）
+     * @param height 网格高（格数）
+     * @param walkable 行优先展开的可行走标志，非0为可行走，
+     *                 长度必须等于 width*height
+     * @return 尺寸非法或标志长度不符时返回false
+     */
+    bool RegisterMap(int map_id, int width, int height,
+                     std::span<const uint8_t> walkable);
+
+    /**
+     * @brief 注销地图并失效其路径缓存
+     */
+    void UnregisterMap(int map_id);
+
+    /**
+     * @brief 判断单格是否可行走（越界或未注册地图为否）
+     */
+    bool IsWalkable(int map_id, GridPoint point) const;
+
+    /**
+     * @brief O(1)可达性判定（连通分量比较，不展开路径）
+     *
+     * 策略层移动校验的快路径：两端任一不可行走或分量不同即不可达。
+     */
+    bool IsReachable(int map_id, GridPoint from, GridPoint to) const;
+
+    /**
+     * @brief 单条寻路
+     */
+    PathResult FindPath(const PathQuery& query);
+
+    /**
+     * @brief 批量寻路，结果顺序与查询一致
+     */
+    std::vector<PathResult> FindPathsBatch(std::span<const PathQuery> queries);
+
+    /**
+     * @brief 路径缓存统计（监控用）
+     */
+    struct PathCacheStats {
+        size_t entries = 0;   ///< 当前缓存条目数
+        size_t hits = 0;      ///< 累计命中次数
+        size_t misses = 0;    ///< 累计未命中次数
+    };
+    PathCacheStats GetPathCacheStats() const;
+
+    // 分块边长（格）：块内区域即层次图的底层节点
+    static constexpr int REGION_SIZE = 16;
+
+private:
+    /**
+     * @brief 单张地图的预处理导航数据
+     */
+    struct MapNav {
+        int width = 0;
+        int height = 0;
+        std::vector<uint8_t> walkable;              // 行优先，非0可行走
+        std::vector<int32_t> region_of;             // 每格区域号，-1为不可行走
+        int32_t region_count = 0;
+        std::vector<std::vector<int32_t>> region_neighbors;  // 区域邻接表
+        std::vector<int32_t> region_component;      // 区域连通分量号
+    };
+
+    /**
+     * @brief 缓存的区域级路径
+     */
+    struct CachedRegionPath {
+        std::vector<int32_t> regions;
+        std::list<uint64_t>::iterator lru_it;   // lru_order_ 中的位置
+    };
+
+    // 区域路径缓存上限：超出时淘汰最久未用条目
+    static constexpr size_t PATH_CACHE_MAX_ENTRIES = 512;
+
+    static bool InBounds(const MapNav& nav, GridPoint point);
+    static size_t CellIndex(const MapNav& nav, GridPoint point);
+
+    // 预处理: 分块洪泛出区域、建邻接表、标连通分量
+    static void BuildRegions(MapNav& nav);
+    static void BuildComponents(MapNav& nav);
+
+    // 区域图BFS: 返回 from→to 的区域序列，不可达时为空
+    static std::vector<int32_t> SearchRegionPath(const MapNav& nav,
+                                                 int32_t from, int32_t to);
+
+    // 走廊内格级A*: 只展开区域号在corridor标志内的格
+    static std::vector<GridPoint> RefinePath(const MapNav& nav,
+                                             GridPoint start, GridPoint goal,
+                                             const std::vector<uint8_t>& corridor);
+
+    // 完整格路径压缩为拐点序列
+    static std::vector<GridPoint> CompressWaypoints(std::vector<GridPoint> cells);
+
+    PathResult FindPathLocked(const MapNav& nav, const PathQuery& query);
+
+    // 区域路径缓存（键: 地图ID+起终区域号）
+    static uint64_t CacheKey(int map_id, int32_t from_region, int32_t to_region);
+    bool LookupCachedRegionPath(uint64_t key, std::vector<int32_t>& regions);
+    void StoreCachedRegionPath(uint64_t key, const std::vector<int32_t>& regions);
+    void InvalidateMapCacheLocked(int map_id);
+
+    std::unordered_map<int, MapNav> maps_;
+    mutable std::shared_mutex maps_mutex_;
+
+    std::unordered_map<uint64_t, CachedRegionPath> path_cache_;
+    std::list<uint64_t> lru_order_;   // 头部为最近使用
+    mutable std::mutex cache_mutex_;
+    size_t cache_hits_ = 0;
+    size_t cache_misses_ = 0;
+};
+
+} // namespace algorithm
+
+#endif // ALGORITHM_NAVIGATIONSERVICE_H
@@ -0,0 +1,157 @@
+/*
+ * 文件名: RequestArena.h
+ * 说明: 每请求生命周期的 bump 分配器（头文件 only）
+ * 作者: 彭承康
+ * 创建时间: 2026-08-27
+ *
+ * 服务处理一次 RPC 期间产生的临时对象（请求转换缓冲、校验中间结果、
+ * 批量请求数组等）统一放进线性增长的 arena，请求结束时整体释放，
+ * 避免高并发下全局堆分配器的锁竞争。
+ *
+ * 用法:
+ *   RequestArena::Scope scope;                       // RPC 入口处建立作用域
+ *   ArenaVector<DamageRequest> buf{ArenaAllocator<DamageRequest>{}};
+ *   ...                                              // 作用域析构时 arena 整体重置
+ */
+
+#ifndef ALGORITHM_REQUEST_ARENA_H
+#define ALGORITHM_REQUEST_ARENA_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <vector>
+
+namespace algorithm {
+
+/**
+ * @brief 线性 bump 分配器
+ *
+ * 从固定大小的块中顺序切分内存，不支持单个释放；
+ * reset() 一次性收回全部分配（保留首块复用）。
+ */
+class RequestArena {
+public:
+    static constexpr size_t DEFAULT_CHUNK_SIZE = 64 * 1024;
+
+    RequestArena() = default;
+
+    RequestArena(const RequestArena&) = delete;
+    RequestArena& operator=(const RequestArena&) = delete;
+
+    /**
+     * @brief 分配 size 字节（按 alignment 对齐）
+     */
+    void* allocate(size_t size, size_t alignment = alignof(std::max_align_t)) {
+        if (chunks_.empty()) {
+            addChunk(size);
+        }
+
+        uintptr_t current = reinterpret_cast<uintptr_t>(chunks_.back().get()) + offset_;
+        uintptr_t aligned = (current + alignment - 1) & ~(alignment - 1);
+        size_t needed = (aligned - current) + size;
+
+        if (offset_ + needed > chunk_capacity_) {
+            addChunk(size + alignment);
+            current = reinterpret_cast<uintptr_t>(chunks_.back().get());
+            aligned = (current + alignment - 1) & ~(alignment - 1);
+            needed = (aligned - current) + size;
+        }
+
+        offset_ += needed;
+        return reinterpret_cast<void*>(aligned);
+    }
+
+    /**
+     * @brief 整体重置: 收回全部分配，保留首块供下个请求复用
+     */
+    void reset() {
+        if (chunks_.size() > 1) {
+            chunks_.resize(1);
+            chunk_capacity_ = first_chunk_capacity_;
+        }
+        offset_ = 0;
+    }
+
+    /**
+     * @brief 获取当前线程的请求 arena
+     */
+    static RequestArena& threadLocal() {
+        static thread_local RequestArena arena;
+        return arena;
+    }
+
+    /**
+     * @brief 请求作用域: 构造时无操作，析构时整体重置线程 arena
+     *
+     * 在 RPC 处理入口建立，保证请求内所有 arena 分配随请求结束释放。
+     */
+    class Scope {
+    public:
+        Scope() = default;
+        ~Scope() { RequestArena::threadLocal().reset(); }
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+    };
+
+private:
+    void addChunk(size_t min_size) {
+        size_t capacity = DEFAULT_CHUNK_SIZE;
+        while (capacity < min_size) {
+            capacity *= 2;
+        }
+        chunks_.push_back(std::make_unique<std::byte[]>(capacity));
+        chunk_capacity_ = capacity;
+        if (chunks_.size() == 1) {
+            first_chunk_capacity_ = capacity;
+        }
+        offset_ = 0;
+    }
+
+    std::vector<std::unique_ptr<std::byte[]>> chunks_;
+    size_t chunk_capacity_ = 0;
+    size_t first_chunk_capacity_ = 0;
+    size_t offset_ = 0;  // 当前块内已用字节
+};
+
+/**
+ * @brief 标准库兼容的 arena 分配器
+ *
+ * 所有分配落入当前线程的 RequestArena；deallocate 为空操作，
+ * 内存随请求作用域整体回收。
+ */
+template <typename T>
+class ArenaAllocator {
+public:
+    using value_type = T;
+
+    ArenaAllocator() = default;
+
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U>&) noexcept {}
+
+    T* allocate(size_t count) {
+        return static_cast<T*>(
+            RequestArena::threadLocal().allocate(count * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T*, size_t) noexcept {
+        // 整体随 RequestArena::Scope 回收
+    }
+
+    template <typename U>
+    bool operator==(const ArenaAllocator<U>&) const noexcept { return true; }
+
+    template <typename U>
+    bool operator!=(const ArenaAllocator<U>&) const noexcept { return false; }
+};
+
+/// arena 支撑的临时向量别名
+template <typename T>
+using ArenaVector = std::vector<T, ArenaAllocator<T>>;
+
+} // namespace algorithm
+
+#endif // ALGORITHM_REQUEST_ARENA_H
@@ -10,6 +10,9 @@
 #define ALGORITHM_SKILL_TREE_MANAGER_H
 
 #include "CharacterStats.h"
+#include <cstdint>
+#include <mutex>
+#include <shared_mutex>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -34,6 +37,33 @@ struct SkillNode {
     bool is_passive = false;             ///< 是否被动技能
 };
 
+/**
+ * @brief 评估后技能树的单个条目
+ *
+ * 平铺数组中的一项，顺序与冻结技能数组一致：可学性与等级
+ * 折算结果都已预先算好，查询方直接读值。
+ */
+struct EvaluatedSkillEntry {
+    int skill_id = 0;                   ///< 技能ID
+    bool unlocked = false;              ///< 已学习或前置已满足
+    int level = 0;                      ///< 当前等级（0=未学习）
+    float effective_multiplier = 1.0f;  ///< 等级折算后的伤害倍率
+    int effective_cooldown_ms = 0;      ///< 等级折算后的冷却（毫秒）
+};
+
+/**
+ * @brief 按角色缓存的评估后技能树
+ *
+ * entries为空表示该角色没有缓存（未上报过技能状态或技能树
+ * 内容已变化）。state_version随每次技能状态上报递增，随玩家
+ * 数据一起持久化的快照据此判断新旧。
+ */
+struct EvaluatedSkillTree {
+    uint64_t state_version = 0;  ///< 技能状态版本（每次升级/学习递增）
+    uint64_t tree_version = 0;   ///< 评估时的技能树内容版本
+    std::vector<EvaluatedSkillEntry> entries;  ///< 冻结顺序的平铺条目
+};
+
 /**
  * @brief 技能树管理器
  * 负责管理游戏中的技能系统，包括技能数据、技能树结构、技能升级等
@@ -98,9 +128,180 @@ public:
      */
     int GetSkillCount() const { return static_cast<int>(skills_.size()); }
 
+    /**
+     * @brief 冻结技能树为只读索引
+     *
+     * 技能ID是稠密小整数，冻结后按ID直接下标到连续数组，
+     * 前置技能边平铺为索引区间，查询不再经过哈希探测。
+     * 战斗期间技能树不会变化，构造完成后自动冻结；
+     * AddSkill 会使冻结索引失效，需再次调用本方法生效。
+     */
+    void FreezeTree();
+
+    /**
+     * @brief 技能树是否处于冻结状态
+     */
+    bool IsFrozen() const { return frozen_; }
+
+    // ============ 前置闭包位集（FreezeTree 预算，UI整树查询） ============
+
+    /**
+     * @brief 把已学技能ID列表折算为冻结下标位集
+     *
+     * 位集按冻结数组下标编址，每次重绘折算一次即可服务整棵
+     * 树的可解锁性查询。未冻结时返回空位集。
+     *
+     * @param learned_skills 已学技能ID列表
+     * @return std::vector<uint64_t> 已学位集（每技能一位）
+     */
+    std::vector<uint64_t> BuildLearnedBitset(const std::vector<int>& learned_skills) const;
+
+    /**
+     * @brief 闭包位集快路径：技能的全部传递前置是否已满足
+     *
+     * FreezeTree时已把每个技能的前置链展开为传递闭包位集，
+     * 查询只剩 闭包 AND 已学位集 == 闭包 的几次字与运算，
+     * 不再逐节点走前置链。与CanLearnSkill的区别：本方法检查
+     * 传递闭包，已学集合经正常学习流程产生时二者结论一致。
+     *
+     * @param skill_id 技能ID
+     * @param learned_bits BuildLearnedBitset折算出的已学位集
+     * @return bool 全部传递前置已学时为true
+     */
+    bool IsSkillUnlockable(int skill_id, const std::vector<uint64_t>& learned_bits) const;
+
+    /**
+     * @brief 整树可解锁性批量评估
+     *
+     * 技能界面每次重绘逐节点询问可解锁性，本方法把已学列表
+     * 折算成位集后对整棵树做闭包子集检查，顺序与GetAllSkills
+     * 一致。未冻结时回退到逐技能CanLearnSkill推导。
+     *
+     * @param learned_skills 已学技能ID列表
+     * @return std::vector<uint8_t> 每技能一项，非零表示可解锁
+     */
+    std::vector<uint8_t> EvaluateUnlockability(const std::vector<int>& learned_skills) const;
+
+    /**
+     * @brief 技能树内容版本
+     *
+     * 每次 AddSkill 递增。客户端缓存技能树时记下版本，
+     * 订阅增量（WatchSkillTree RPC）时版本一致即零传输。
+     */
+    uint64_t GetTreeVersion() const { return tree_version_; }
+
+    // ============ 按角色的评估缓存（技能状态变化时重算） ============
+
+    /**
+     * @brief 上报角色技能状态并重算评估缓存
+     *
+     * 玩家技能状态变化很少（升级、学习新技能），查询却每次
+     * 都在重推可学性和等级折算。本方法在状态变化时一次性评估
+     * 整棵树存为平铺数组，之后GetSkillTree查询和伤害倍率读取
+     * 都走预算值，直到下一次升级事件。
+     *
+     * @param character_id 角色ID
+     * @param learned_skills 已学技能ID列表
+     * @param skill_levels 与learned_skills等长的等级列表，
+     *                     长度不足的项按1级处理
+     */
+    void UpdateCharacterSkillState(int character_id,
+                                   const std::vector<int>& learned_skills,
+                                   const std::vector<int>& skill_levels);
+
+    /**
+     * @brief 读取角色的评估后技能树
+     *
+     * 返回副本以避免与并发的状态上报竞争。entries为空表示
+     * 无缓存（从未上报，或技能树内容在评估后发生了变化），
+     * 调用方应回退到逐技能推导。
+     *
+     * @param character_id 角色ID
+     * @return EvaluatedSkillTree 评估后技能树副本
+     */
+    EvaluatedSkillTree GetEvaluatedTree(int character_id) const;
+
+    /**
+     * @brief 读取角色技能的等级折算伤害倍率（评估缓存快路径）
+     *
+     * 缓存命中且缓存等级与请求等级一致时直接返回预算值；
+     * 否则回退到GetScaledMultiplier现场折算。
+     *
+     * @param character_id 角色ID
+     * @param skill_id 技能ID
+     * @param skill_level 技能等级
+     * @return 伤害倍率（含等级加成）
+     */
+    float GetEffectiveMultiplier(int character_id, int skill_id, int skill_level) const;
+
+    /**
+     * @brief 序列化角色的评估后技能树
+     *
+     * 定长小端二进制（魔数"FLST" + 版本 + 条目数组），随玩家
+     * 数据一起落盘。无缓存时返回空串。
+     *
+     * @param character_id 角色ID
+     * @return std::string 序列化负载
+     */
+    std::string SerializeEvaluatedTree(int character_id) const;
+
+    /**
+     * @brief 从持久化负载恢复角色的评估缓存
+     *
+     * 负载中的tree_version与当前技能树不一致（内容已更新）时
+     * 拒绝恢复，下一次UpdateCharacterSkillState重算。
+     *
+     * @param character_id 角色ID
+     * @param data 序列化负载
+     * @return bool 负载完整且版本匹配时为true
+     */
+    bool RestoreEvaluatedTree(int character_id, const std::string& data);
+
 private:
     std::unordered_map<int, SkillNode> skills_;
 
+    // ============ 冻结索引（FreezeTree 构建，只读） ============
+
+    // 前置技能在 frozen_prereq_ids_ 中的区间，与 frozen_skills_ 平行
+    struct PrereqRange {
+        uint32_t begin = 0;
+        uint32_t count = 0;
+    };
+
+    bool frozen_ = false;
+    uint64_t tree_version_ = 1;
+    std::vector<SkillNode> frozen_skills_;      // 按ID升序的连续技能数组
+    std::vector<int32_t> id_to_index_;          // skill_id → frozen_skills_ 下标 (-1=不存在)
+    std::vector<PrereqRange> frozen_prereqs_;   // 每个技能的前置边区间
+    std::vector<int> frozen_prereq_ids_;        // 所有前置技能ID平铺存储
+    size_t closure_words_ = 0;                  // 闭包位集每技能的64位字数
+    std::vector<uint64_t> frozen_closure_;      // 传递前置闭包位集，按冻结下标平铺
+
+    // 按角色的评估缓存：升级事件写入，查询与伤害路径并发读取。
+    // 写入很少（升级/学习），读写锁让热路径只付共享锁的代价。
+    mutable std::shared_mutex evaluated_mutex_;
+    std::unordered_map<int, EvaluatedSkillTree> evaluated_trees_;
+
+    /**
+     * @brief 评估整棵技能树为平铺条目数组（不加锁）
+     */
+    std::vector<EvaluatedSkillEntry> EvaluateEntries(
+        const std::vector<int>& learned_skills,
+        const std::vector<int>& skill_levels) const;
+
+    /**
+     * @brief 递归展开单个技能的传递前置闭包（FreezeTree内部）
+     *
+     * @param index 冻结数组下标
+     * @param state 访问状态（0=未访问 1=访问中 2=完成），环保护
+     */
+    void ExpandClosure(size_t index, std::vector<uint8_t>& state);
+
+    /**
+     * @brief 指定冻结下标的闭包是否被已学位集覆盖
+     */
+    bool ClosureSatisfied(size_t index, const std::vector<uint64_t>& learned_bits) const;
+
     void InitializeDefaultSkills();
     void InitializeCommonSkills();
     void InitializeWarriorSkills();
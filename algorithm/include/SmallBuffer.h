@@ -0,0 +1,357 @@
+/*
+ * 文件名: SmallBuffer.h
+ * 说明: 小缓冲优化的向量/字符串类型，供热路径结构体使用
+ * 作者: 彭承康
+ * 创建时间: 2026-08-28
+ *
+ * AIDecisionRequest/AIDecisionResult 等每次决策都要构造的结构体，
+ * 其成员典型尺寸很小（上下文 4~8 个 int、描述几十字节），但
+ * std::vector/std::string 成员仍会逐次堆分配。本文件提供带内联
+ * 容量的 SmallVector/SmallString：典型尺寸完全零堆分配，超出
+ * 内联容量时退化为堆存储，接口保持两者的常用子集。
+ */
+#ifndef ALGORITHM_SMALLBUFFER_H
+#define ALGORITHM_SMALLBUFFER_H
+
+#include <cstddef>
+#include <cstring>
+#include <initializer_list>
+#include <new>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace algorithm {
+
+/**
+ * @brief 内联容量向量
+ *
+ * 元素数不超过 InlineCapacity 时存放在对象内部，不触碰堆；
+ * 超出后迁移到堆并按倍增扩容。仅实现热路径所需的接口子集。
+ */
+template <typename T, std::size_t InlineCapacity>
+class SmallVector {
+public:
+    using value_type = T;
+    using iterator = T*;
+    using const_iterator = const T*;
+
+    SmallVector() = default;
+
+    SmallVector(std::initializer_list<T> init) {
+        assign(init.begin(), init.end());
+    }
+
+    SmallVector(const SmallVector& other) {
+        assign(other.begin(), other.end());
+    }
+
+    SmallVector(SmallVector&& other) noexcept {
+        MoveFrom(std::move(other));
+    }
+
+    ~SmallVector() {
+        DestroyStorage();
+    }
+
+    SmallVector& operator=(const SmallVector& other) {
+        if (this != &other) {
+            assign(other.begin(), other.end());
+        }
+        return *this;
+    }
+
+    SmallVector& operator=(SmallVector&& other) noexcept {
+        if (this != &other) {
+            DestroyStorage();
+            data_ = InlineData();
+            size_ = 0;
+            capacity_ = InlineCapacity;
+            MoveFrom(std::move(other));
+        }
+        return *this;
+    }
+
+    SmallVector& operator=(std::initializer_list<T> init) {
+        assign(init.begin(), init.end());
+        return *this;
+    }
+
+    void push_back(const T& value) {
+        EnsureCapacity(size_ + 1);
+        new (data_ + size_) T(value);
+        ++size_;
+    }
+
+    void push_back(T&& value) {
+        EnsureCapacity(size_ + 1);
+        new (data_ + size_) T(std::move(value));
+        ++size_;
+    }
+
+    template <typename InputIt>
+    void assign(InputIt first, InputIt last) {
+        clear();
+        for (; first != last; ++first) {
+            push_back(*first);
+        }
+    }
+
+    void clear() {
+        for (std::size_t i = 0; i < size_; ++i) {
+            data_[i].~T();
+        }
+        size_ = 0;
+    }
+
+    void reserve(std::size_t count) {
+        EnsureCapacity(count);
+    }
+
+    T& operator[](std::size_t index) { return data_[index]; }
+    const T& operator[](std::size_t index) const { return data_[index]; }
+
+    T* data() { return data_; }
+    const T* data() const { return data_; }
+
+    iterator begin() { return data_; }
+    iterator end() { return data_ + size_; }
+    const_iterator begin() const { return data_; }
+    const_iterator end() const { return data_ + size_; }
+
+    std::size_t size() const { return size_; }
+    std::size_t capacity() const { return capacity_; }
+    bool empty() const { return size_ == 0; }
+
+    /** @brief 是否仍在内联存储内（测试/诊断用） */
+    bool IsInline() const { return data_ == InlineData(); }
+
+private:
+    T* InlineData() {
+        return std::launder(reinterpret_cast<T*>(inline_storage_));
+    }
+    const T* InlineData() const {
+        return std::launder(reinterpret_cast<const T*>(inline_storage_));
+    }
+
+    void EnsureCapacity(std::size_t required) {
+        if (required <= capacity_) {
+            return;
+        }
+        std::size_t next = capacity_ * 2;
+        if (next < required) {
+            next = required;
+        }
+        T* heap = static_cast<T*>(::operator new(next * sizeof(T)));
+        for (std::size_t i = 0; i < size_; ++i) {
+            new (heap + i) T(std::move(data_[i]));
+            data_[i].~T();
+        }
+        if (!IsInline()) {
+            ::operator delete(data_);
+        }
+        data_ = heap;
+        capacity_ = next;
+    }
+
+    void DestroyStorage() {
+        clear();
+        if (!IsInline()) {
+            ::operator delete(data_);
+        }
+    }
+
+    void MoveFrom(SmallVector&& other) noexcept {
+        if (other.IsInline()) {
+            for (std::size_t i = 0; i < other.size_; ++i) {
+                new (data_ + i) T(std::move(other.data_[i]));
+            }
+            size_ = other.size_;
+            other.clear();
+        } else {
+            // 堆存储直接接管指针
+            data_ = other.data_;
+            size_ = other.size_;
+            capacity_ = other.capacity_;
+            other.data_ = other.InlineData();
+            other.size_ = 0;
+            other.capacity_ = InlineCapacity;
+        }
+    }
+
+    alignas(T) unsigned char inline_storage_[sizeof(T) * InlineCapacity];
+    T* data_ = InlineData();
+    std::size_t size_ = 0;
+    std::size_t capacity_ = InlineCapacity;
+};
+
+/**
+ * @brief 内联容量字符串（始终以 NUL 结尾）
+ *
+ * 长度小于 InlineCapacity（含结尾 NUL）时零堆分配。
+ * 隐式接受 std::string / 字面量赋值，便于逐步替换热路径成员。
+ */
+template <std::size_t InlineCapacity>
+class SmallString {
+    static_assert(InlineCapacity >= 1, "inline capacity must hold the terminator");
+
+public:
+    SmallString() {
+        inline_storage_[0] = '\0';
+    }
+
+    SmallString(const char* text) : SmallString(std::string_view(text)) {}
+
+    SmallString(std::string_view text) : SmallString() {
+        Assign(text);
+    }
+
+    SmallString(const std::string& text) : SmallString(std::string_view(text)) {}
+
+    SmallString(const SmallString& other) : SmallString(other.view()) {}
+
+    SmallString(SmallString&& other) noexcept : SmallString() {
+        MoveFrom(std::move(other));
+    }
+
+    ~SmallString() {
+        if (!IsInline()) {
+            ::operator delete(data_);
+        }
+    }
+
+    SmallString& operator=(const SmallString& other) {
+        if (this != &other) {
+            Assign(other.view());
+        }
+        return *this;
+    }
+
+    SmallString& operator=(SmallString&& other) noexcept {
+        if (this != &other) {
+            if (!IsInline()) {
+                ::operator delete(data_);
+            }
+            data_ = inline_storage_;
+            size_ = 0;
+            capacity_ = InlineCapacity;
+            inline_storage_[0] = '\0';
+            MoveFrom(std::move(other));
+        }
+        return *this;
+    }
+
+    SmallString& operator=(const char* text) {
+        Assign(std::string_view(text));
+        return *this;
+    }
+
+    SmallString& operator=(std::string_view text) {
+        Assign(text);
+        return *this;
+    }
+
+    SmallString& operator=(const std::string& text) {
+        Assign(std::string_view(text));
+        return *this;
+    }
+
+    SmallString& operator+=(std::string_view text) {
+        append(text);
+        return *this;
+    }
+
+    SmallString& operator+=(char ch) {
+        push_back(ch);
+        return *this;
+    }
+
+    void append(std::string_view text) {
+        EnsureCapacity(size_ + text.size() + 1);
+        std::memcpy(data_ + size_, text.data(), text.size());
+        size_ += text.size();
+        data_[size_] = '\0';
+    }
+
+    void push_back(char ch) {
+        EnsureCapacity(size_ + 2);
+        data_[size_] = ch;
+        ++size_;
+        data_[size_] = '\0';
+    }
+
+    void clear() {
+        size_ = 0;
+        data_[0] = '\0';
+    }
+
+    const char* c_str() const { return data_; }
+    std::size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+
+    std::string_view view() const { return std::string_view(data_, size_); }
+    operator std::string_view() const { return view(); }
+
+    /** @brief 拷贝出一个 std::string（跨边界时显式转换） */
+    std::string str() const { return std::string(data_, size_); }
+
+    /** @brief 是否仍在内联存储内（测试/诊断用） */
+    bool IsInline() const { return data_ == inline_storage_; }
+
+    friend bool operator==(const SmallString& lhs, std::string_view rhs) {
+        return lhs.view() == rhs;
+    }
+
+    friend bool operator==(std::string_view lhs, const SmallString& rhs) {
+        return lhs == rhs.view();
+    }
+
+private:
+    void Assign(std::string_view text) {
+        EnsureCapacity(text.size() + 1);
+        std::memcpy(data_, text.data(), text.size());
+        size_ = text.size();
+        data_[size_] = '\0';
+    }
+
+    void EnsureCapacity(std::size_t required) {
+        if (required <= capacity_) {
+            return;
+        }
+        std::size_t next = capacity_ * 2;
+        if (next < required) {
+            next = required;
+        }
+        char* heap = static_cast<char*>(::operator new(next));
+        std::memcpy(heap, data_, size_ + 1);
+        if (!IsInline()) {
+            ::operator delete(data_);
+        }
+        data_ = heap;
+        capacity_ = next;
+    }
+
+    void MoveFrom(SmallString&& other) noexcept {
+        if (other.IsInline()) {
+            Assign(other.view());
+            other.clear();
+        } else {
+            data_ = other.data_;
+            size_ = other.size_;
+            capacity_ = other.capacity_;
+            other.data_ = other.inline_storage_;
+            other.size_ = 0;
+            other.capacity_ = InlineCapacity;
+            other.inline_storage_[0] = '\0';
+        }
+    }
+
+    char inline_storage_[InlineCapacity];
+    char* data_ = inline_storage_;
+    std::size_t size_ = 0;
+    std::size_t capacity_ = InlineCapacity;
+};
+
+} // namespace algorithm
+
+#endif // ALGORITHM_SMALLBUFFER_H
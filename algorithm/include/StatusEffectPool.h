@@ -0,0 +1,169 @@
+/*
+ * 文件名: StatusEffectPool.h
+ * 说明: 状态效果对象池与角色活动效果列表（头文件 only）
+ * 作者: 彭承康
+ * 创建时间: 2026-08-27
+ */
+
+#ifndef ALGORITHM_STATUS_EFFECT_POOL_H
+#define ALGORITHM_STATUS_EFFECT_POOL_H
+
+#include "StatusEffect.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace algorithm {
+
+/**
+ * @brief 状态效果对象池
+ *
+ * 战斗中状态效果（中毒、增益、护盾）每回合大量创建销毁，
+ * 逐个堆分配/释放是可观的churn。池把效果存放在连续槽位中，
+ * 释放的槽位进入空闲链表供复用；句柄携带代数校验，
+ * 槽位被复用后旧句柄自动失效（get 返回 nullptr）。
+ */
+class StatusEffectPool {
+public:
+    using Handle = uint32_t;
+    static constexpr Handle INVALID_HANDLE = 0;
+
+    /**
+     * @brief 从池中取出槽位存放效果
+     * @param effect 效果内容（拷入池内槽位）
+     * @return 稳定句柄
+     */
+    Handle acquire(const StatusEffect& effect) {
+        uint32_t index = 0;
+        if (free_head_ != NO_FREE_SLOT) {
+            index = free_head_;
+            free_head_ = slots_[index].next_free;
+        } else {
+            index = static_cast<uint32_t>(slots_.size());
+            slots_.emplace_back();
+        }
+        Slot& slot = slots_[index];
+        slot.effect = effect;
+        slot.in_use = true;
+        ++active_count_;
+        return makeHandle(index, slot.generation);
+    }
+
+    /**
+     * @brief 释放句柄对应的槽位（旧句柄随即失效）
+     */
+    void release(Handle handle) {
+        Slot* slot = resolveSlot(handle);
+        if (slot == nullptr) return;
+        slot->in_use = false;
+        ++slot->generation;
+        slot->next_free = free_head_;
+        free_head_ = slotIndex(handle);
+        --active_count_;
+    }
+
+    /**
+     * @brief 访问句柄对应的效果
+     * @return 效果指针；句柄已失效时返回 nullptr
+     */
+    StatusEffect* get(Handle handle) {
+        Slot* slot = resolveSlot(handle);
+        return slot != nullptr ? &slot->effect : nullptr;
+    }
+
+    const StatusEffect* get(Handle handle) const {
+        const Slot* slot = resolveSlot(handle);
+        return slot != nullptr ? &slot->effect : nullptr;
+    }
+
+    /**
+     * @brief 当前活动效果数量
+     */
+    size_t activeCount() const { return active_count_; }
+
+    /**
+     * @brief 池中槽位总数（含空闲）
+     */
+    size_t capacity() const { return slots_.size(); }
+
+private:
+    static constexpr uint32_t NO_FREE_SLOT = 0xFFFFFFFFu;
+    static constexpr uint32_t INDEX_BITS = 20;             // 最多约100万槽位
+    static constexpr uint32_t INDEX_MASK = (1u << INDEX_BITS) - 1;
+
+    struct Slot {
+        StatusEffect effect;
+        uint32_t generation = 1;   // 从1起，保证句柄非0
+        uint32_t next_free = NO_FREE_SLOT;
+        bool in_use = false;
+    };
+
+    // 句柄 = 代数(高12位) | 槽位下标(低20位)
+    static Handle makeHandle(uint32_t index, uint32_t generation) {
+        return ((generation & 0xFFFu) << INDEX_BITS) | (index & INDEX_MASK);
+    }
+
+    static uint32_t slotIndex(Handle handle) { return handle & INDEX_MASK; }
+    static uint32_t slotGeneration(Handle handle) { return handle >> INDEX_BITS; }
+
+    Slot* resolveSlot(Handle handle) {
+        uint32_t index = slotIndex(handle);
+        if (index >= slots_.size()) return nullptr;
+        Slot& slot = slots_[index];
+        if (!slot.in_use || (slot.generation & 0xFFFu) != slotGeneration(handle)) {
+            return nullptr;
+        }
+        return &slot;
+    }
+
+    const Slot* resolveSlot(Handle handle) const {
+        return const_cast<StatusEffectPool*>(this)->resolveSlot(handle);
+    }
+
+    std::vector<Slot> slots_;
+    uint32_t free_head_ = NO_FREE_SLOT;
+    size_t active_count_ = 0;
+};
+
+/**
+ * @brief 单个角色的活动效果列表
+ *
+ * 定长句柄数组，战斗结算时可顺序线性扫描；
+ * 移除用尾部交换，无元素搬移和堆操作。
+ */
+class ActiveEffectList {
+public:
+    static constexpr size_t MAX_EFFECTS = 16;
+
+    /**
+     * @brief 追加效果句柄
+     * @return 列表已满时返回 false
+     */
+    bool add(StatusEffectPool::Handle handle) {
+        if (count_ >= MAX_EFFECTS) return false;
+        handles_[count_++] = handle;
+        return true;
+    }
+
+    /**
+     * @brief 按下标移除（与尾部交换，不保持顺序）
+     */
+    void removeAt(size_t index) {
+        if (index >= count_) return;
+        handles_[index] = handles_[--count_];
+    }
+
+    size_t size() const { return count_; }
+    bool empty() const { return count_ == 0; }
+
+    StatusEffectPool::Handle operator[](size_t index) const { return handles_[index]; }
+
+private:
+    std::array<StatusEffectPool::Handle, MAX_EFFECTS> handles_{};
+    size_t count_ = 0;
+};
+
+} // namespace algorithm
+
+#endif // ALGORITHM_STATUS_EFFECT_POOL_H
@@ -0,0 +1,92 @@
+/*
+ * 文件名: ValidatedString.h
+ * 说明: 入口处一次校验、以类型携带的用户字符串（玩家名/聊天行）
+ * 作者: 彭承康
+ * 创建时间: 2026-08-28
+ *
+ * 玩家名和聊天内容在每个边界上都要重复做模式检查，在消息量大时
+ * 是纯粹的浪费。本文件提供 PlayerName/ChatLine 两个校验后字符串
+ * 类型：在入口处用查表的字节分类校验一次（ASCII走256项允许表，
+ * 多字节走UTF-8结构校验快路径），之后以类型形式在算法层内部传
+ * 递，持有即合法，无需再次校验。
+ */
+#ifndef ALGORITHM_VALIDATED_STRING_H
+#define ALGORITHM_VALIDATED_STRING_H
+
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace algorithm {
+
+struct ValidationResult;
+
+/**
+ * @brief 校验后的玩家名
+ *
+ * 规则：1~32字节；ASCII仅允许字母、数字、下划线和连字符，
+ * 首字节不能是连字符；多字节部分须是结构合法的UTF-8
+ *（拒绝过长编码、代理区和超出U+10FFFF的序列）。
+ */
+class PlayerName {
+public:
+    static constexpr std::size_t MAX_BYTES = 32;
+
+    /**
+     * @brief 校验文本是否为合法玩家名（不构造对象）
+     */
+    static ValidationResult Validate(std::string_view text);
+
+    /**
+     * @brief 校验并构造；非法时返回std::nullopt
+     */
+    static std::optional<PlayerName> Create(std::string_view text);
+
+    /**
+     * @brief 校验过的原始文本
+     */
+    const std::string& value() const { return value_; }
+
+private:
+    explicit PlayerName(std::string text) : value_(std::move(text)) {}
+
+    std::string value_;
+};
+
+/**
+ * @brief 校验后的聊天行
+ *
+ * 规则：1~512字节；ASCII仅允许可打印字符（0x20~0x7E），
+ * 拒绝控制字符（含换行，聊天按行切分后不应再有换行）；
+ * 多字节部分须是结构合法的UTF-8。
+ */
+class ChatLine {
+public:
+    static constexpr std::size_t MAX_BYTES = 512;
+
+    /**
+     * @brief 校验文本是否为合法聊天行（不构造对象）
+     */
+    static ValidationResult Validate(std::string_view text);
+
+    /**
+     * @brief 校验并构造；非法时返回std::nullopt
+     */
+    static std::optional<ChatLine> Create(std::string_view text);
+
+    /**
+     * @brief 校验过的原始文本
+     */
+    const std::string& value() const { return value_; }
+
+private:
+    explicit ChatLine(std::string text) : value_(std::move(text)) {}
+
+    std::string value_;
+};
+
+} // namespace algorithm
+
+#endif // ALGORITHM_VALIDATED_STRING_H
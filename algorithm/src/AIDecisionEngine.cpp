@@ -20,8 +20,10 @@
  *   [4] = NPC蓝量百分比 (0-100)（可选）
  */
 #include "AIDecisionEngine.h"
+#include <atomic>
+#include <charconv>
 #include <random>
-#include <sstream>
+#include <thread>
 #include <algorithm>
 #include <cmath>
 
@@ -29,25 +31,103 @@ namespace algorithm {
 
 static thread_local std::mt19937 s_ai_rng{std::random_device{}()};
 
+namespace {
+
+// 整数直接格式化进小缓冲字符串，避开 stringstream 的堆分配
+void AppendInt(DescriptionString& out, int value) {
+    char buf[16];
+    const auto end = std::to_chars(buf, buf + sizeof(buf), value).ptr;
+    out.append(std::string_view(buf, static_cast<std::size_t>(end - buf)));
+}
+
+} // namespace
+
 // ============================================================================
 // 构造
 // ============================================================================
 AIDecisionEngine::AIDecisionEngine() {
     InitializeBehaviorTrees();
+    PrecomputeBossPhases();
+
+    // 预分配决策记忆slab（默认预算，可经 SetMemoryBudget 调整）
+    memory_slab_.assign(DEFAULT_MEMORY_BUDGET_NPCS * MEMORY_SIZE, 0);
+    memory_rings_.assign(DEFAULT_MEMORY_BUDGET_NPCS, MemoryRing{});
 }
 
 void AIDecisionEngine::RegisterNPCType(int npc_id, NPCType type) {
     npc_types_[npc_id] = type;
 }
 
+// ============================================================================
+// 难度参数: 调参即数组写入，不重建行为树、不失效决策缓存
+// ============================================================================
+void AIDecisionEngine::SetDifficulty(NPCType type, const DifficultyParams& params) {
+    difficulty_by_type_[static_cast<size_t>(type)] = params;
+}
+
+void AIDecisionEngine::SetNPCDifficulty(int npc_id, const DifficultyParams& params) {
+    std::lock_guard<std::mutex> lock(difficulty_mutex_);
+    npc_difficulty_[npc_id] = params;
+}
+
+void AIDecisionEngine::ClearNPCDifficulty(int npc_id) {
+    std::lock_guard<std::mutex> lock(difficulty_mutex_);
+    if (npc_id == 0) {
+        npc_difficulty_.clear();
+    } else {
+        npc_difficulty_.erase(npc_id);
+    }
+}
+
+DifficultyParams AIDecisionEngine::GetDifficulty(NPCType type) const {
+    return difficulty_by_type_[static_cast<size_t>(type)];
+}
+
+DifficultyParams AIDecisionEngine::ResolveDifficulty(
+    int npc_id, NPCType type) const {
+    {
+        std::lock_guard<std::mutex> lock(difficulty_mutex_);
+        auto it = npc_difficulty_.find(npc_id);
+        if (it != npc_difficulty_.end()) {
+            return it->second;
+        }
+    }
+    return difficulty_by_type_[static_cast<size_t>(type)];
+}
+
+bool AIDecisionEngine::IsOffensiveAction(int action_id) {
+    // 1攻击 3技能 8陷阱 9必杀为进攻类；0待机 2防御 5逃跑
+    // 6求援 7治疗为防御类；4移动保持中性不受aggression影响
+    switch (action_id) {
+        case 1: case 3: case 8: case 9:
+            return true;
+        default:
+            return false;
+    }
+}
+
 void AIDecisionEngine::ClearMemory(int npc_id) {
+    std::lock_guard<std::mutex> lock(memory_mutex_);
     if (npc_id == 0) {
-        decision_memory_.clear();
+        // 推进代数即可令全部环失效，slab本体不动
+        ++memory_epoch_;
     } else {
-        decision_memory_.erase(npc_id);
+        auto it = memory_slots_.find(npc_id);
+        if (it != memory_slots_.end()) {
+            memory_rings_[it->second] = MemoryRing{};
+        }
     }
 }
 
+void AIDecisionEngine::SetMemoryBudget(size_t max_npcs) {
+    std::lock_guard<std::mutex> lock(memory_mutex_);
+    size_t budget = std::max<size_t>(1, max_npcs);
+    memory_slab_.assign(budget * MEMORY_SIZE, 0);
+    memory_rings_.assign(budget, MemoryRing{});
+    memory_slots_.clear();
+    ++memory_epoch_;
+}
+
 // ============================================================================
 // 主决策入口
 // ============================================================================
@@ -61,21 +141,56 @@ AIDecisionResult AIDecisionEngine::MakeDecision(const AIDecisionRequest& request
         type = type_it->second;
     }
 
-    // 查找行为树
+    // 查找编译后的行为树
     int tree_key = static_cast<int>(type);
-    auto tree_it = behavior_trees_.find(tree_key);
-    if (tree_it == behavior_trees_.end()) {
+    auto tree_it = compiled_trees_.find(tree_key);
+    if (tree_it == compiled_trees_.end() || tree_it->second.nodes.empty()) {
         result.action_id = 0;
         result.description = "NPC待机中（无行为树）";
         return result;
     }
 
-    // 评估行为树
-    if (EvaluateNode(tree_it->second, request.context)) {
-        result.action_id = SelectBestAction(request.npc_id, type, request.context);
+    // 决策缓存探查: 同一量化情境的树求值与候选集构建只做一次
+    const uint32_t key = SituationKey(type, request.context);
+    bool tree_passed = false;
+    std::vector<ActionCandidate> candidates;
+    bool cache_hit = false;
+    {
+        std::lock_guard<std::mutex> lock(cache_mutex_);
+        auto cached = decision_cache_.find(key);
+        if (cached != decision_cache_.end()) {
+            tree_passed = cached->second.tree_passed;
+            candidates = cached->second.candidates;
+            ++cache_hits_;
+            cache_hit = true;
+        } else {
+            ++cache_misses_;
+        }
+    }
+
+    if (!cache_hit) {
+        // 评估行为树（扁平数组按索引求值）并构建候选集，回填缓存
+        tree_passed = EvaluateCompiled(tree_it->second, 0, request.context);
+        if (tree_passed) {
+            candidates = BuildActionCandidates(type, request.context);
+        }
+
+        std::lock_guard<std::mutex> lock(cache_mutex_);
+        if (decision_cache_.size() >= DECISION_CACHE_MAX_ENTRIES) {
+            decision_cache_.clear();  // 量化键空间远小于上限，仅作保险
+        }
+        decision_cache_[key] = CachedSituation{tree_passed, candidates};
+    }
+
+    // 难度、反重复惩罚与加权随机仍逐次执行，不随缓存固化
+    const DifficultyParams difficulty = ResolveDifficulty(request.npc_id, type);
+    if (tree_passed) {
+        result.action_id = ChooseWeightedAction(request.npc_id, std::move(candidates),
+                                                difficulty);
     } else {
         result.action_id = 0;  // 待机
     }
+    result.reaction_delay_ms = difficulty.reaction_delay_ms;
 
     // 记录决策
     RecordDecision(request.npc_id, result.action_id);
@@ -86,6 +201,47 @@ AIDecisionResult AIDecisionEngine::MakeDecision(const AIDecisionRequest& request
     return result;
 }
 
+// ============================================================================
+// 批量决策入口
+// ============================================================================
+std::vector<AIDecisionResult> AIDecisionEngine::MakeDecisionsBatch(
+    std::span<const AIDecisionRequest> requests) {
+    std::vector<AIDecisionResult> results(requests.size());
+    if (requests.empty()) {
+        return results;
+    }
+
+    // 小批量直接串行，省去线程开销
+    if (requests.size() < PARALLEL_BATCH_THRESHOLD) {
+        for (size_t i = 0; i < requests.size(); ++i) {
+            results[i] = MakeDecision(requests[i]);
+        }
+        return results;
+    }
+
+    // 并行求值: 编译后的行为树只读共享，决策记忆由互斥锁保护
+    const size_t hw = std::thread::hardware_concurrency();
+    const size_t worker_count = std::min(requests.size(), hw > 0 ? hw : 2u);
+    std::vector<std::thread> workers;
+    workers.reserve(worker_count);
+
+    std::atomic<size_t> next_index{0};
+    for (size_t w = 0; w < worker_count; ++w) {
+        workers.emplace_back([this, &requests, &results, &next_index]() {
+            for (size_t i = next_index.fetch_add(1, std::memory_order_relaxed);
+                 i < requests.size();
+                 i = next_index.fetch_add(1, std::memory_order_relaxed)) {
+                results[i] = MakeDecision(requests[i]);
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    return results;
+}
+
 // ============================================================================
 // 辅助构建方法
 // ============================================================================
@@ -108,11 +264,11 @@ std::shared_ptr<AIDecisionEngine::BehaviorNode> AIDecisionEngine::MakeSequence(
 }
 
 std::shared_ptr<AIDecisionEngine::BehaviorNode> AIDecisionEngine::MakeCondition(
-    int id, std::function<bool(const std::vector<int>&)> cond) {
+    int id, ConditionId cond) {
     auto node = std::make_shared<BehaviorNode>();
     node->type = NodeType::CONDITION;
     node->node_id = id;
-    node->condition = std::move(cond);
+    node->condition = cond;
     return node;
 }
 
@@ -130,17 +286,38 @@ std::shared_ptr<AIDecisionEngine::BehaviorNode> AIDecisionEngine::MakeAction(
 // 初始化所有行为树
 // ============================================================================
 void AIDecisionEngine::InitializeBehaviorTrees() {
-    behavior_trees_[static_cast<int>(NPCType::Warrior)] = BuildWarriorTree();
-    behavior_trees_[static_cast<int>(NPCType::Mage)]    = BuildMageTree();
-    behavior_trees_[static_cast<int>(NPCType::Archer)]  = BuildArcherTree();
-    behavior_trees_[static_cast<int>(NPCType::Boss)]    = BuildBossTree();
-    behavior_trees_[static_cast<int>(NPCType::Passive)] = BuildPassiveTree();
+    // 指针树仅作为构建描述，编译为扁平数组后即丢弃
+    compiled_trees_[static_cast<int>(NPCType::Warrior)] = CompileTree(BuildWarriorTree());
+    compiled_trees_[static_cast<int>(NPCType::Mage)]    = CompileTree(BuildMageTree());
+    compiled_trees_[static_cast<int>(NPCType::Archer)]  = CompileTree(BuildArcherTree());
+    compiled_trees_[static_cast<int>(NPCType::Boss)]    = CompileTree(BuildBossTree());
+    compiled_trees_[static_cast<int>(NPCType::Passive)] = CompileTree(BuildPassiveTree());
 }
 
 void AIDecisionEngine::InitializeActionWeights() {
     // 权重现在通过行为树结构体现，不再单独管理
 }
 
+// ============================================================================
+// Boss阶段预计算: 阈值展开为直查表，候选动作集按阶段固化
+// ============================================================================
+void AIDecisionEngine::PrecomputeBossPhases() {
+    for (int hp = 0; hp <= HP_PERCENT_MAX; ++hp) {
+        if (hp <= BOSS_PHASE_DESPERATE_HP) {
+            boss_phase_by_hp_[static_cast<size_t>(hp)] = 3;  // 绝望
+        } else if (hp <= BOSS_PHASE_ENRAGE_HP) {
+            boss_phase_by_hp_[static_cast<size_t>(hp)] = 2;  // 狂暴
+        } else {
+            boss_phase_by_hp_[static_cast<size_t>(hp)] = 1;  // 正常
+        }
+    }
+
+    // 各阶段候选动作集（与Boss行为树的阶段分支一致）
+    boss_phase_candidates_[0] = {{1, 1.0f}, {3, 0.7f}, {4, 0.3f}};  // 正常
+    boss_phase_candidates_[1] = {{3, 1.0f}, {1, 0.8f}, {3, 0.6f}};  // 狂暴
+    boss_phase_candidates_[2] = {{9, 1.0f}, {3, 0.5f}};             // 绝望
+}
+
 // ============================================================================
 // 战士行为树: 近战优先，低血防御/用药，高血冲锋
 // ============================================================================
@@ -148,12 +325,12 @@ std::shared_ptr<AIDecisionEngine::BehaviorNode> AIDecisionEngine::BuildWarriorTr
     return MakeSelector(1, {
         // 分支1: 危急 — 血量<20%时防御
         MakeSequence(10, {
-            MakeCondition(11, [this](const auto& ctx) { return IsHealthCritical(ctx); }),
+            MakeCondition(11, ConditionId::HealthCritical),
             MakeAction(12, 2, "采取防御姿态")
         }),
         // 分支2: 低血 — 血量<40%时用药或防御
         MakeSequence(20, {
-            MakeCondition(21, [this](const auto& ctx) { return IsHealthLow(ctx); }),
+            MakeCondition(21, ConditionId::HealthLow),
             MakeSelector(22, {
                 MakeAction(23, 5, "使用药品恢复"),
                 MakeAction(24, 2, "采取防御姿态")
@@ -161,11 +338,11 @@ std::shared_ptr<AIDecisionEngine::BehaviorNode> AIDecisionEngine::BuildWarriorTr
         }),
         // 分支3: 近距离 — 攻击
         MakeSequence(30, {
-            MakeCondition(31, [this](const auto& ctx) { return IsEnemyNearby(ctx); }),
+            MakeCondition(31, ConditionId::EnemyNearby),
             MakeSelector(32, {
                 // 有蓝用技能
                 MakeSequence(33, {
-                    MakeCondition(34, [this](const auto& ctx) { return HasMana(ctx); }),
+                    MakeCondition(34, ConditionId::HasMana),
                     MakeAction(35, 3, "释放战士技能")
                 }),
                 // 无蓝普攻
@@ -174,7 +351,7 @@ std::shared_ptr<AIDecisionEngine::BehaviorNode> AIDecisionEngine::BuildWarriorTr
         }),
         // 分支4: 远距离 — 冲锋
         MakeSequence(40, {
-            MakeCondition(41, [this](const auto& ctx) { return IsEnemyFar(ctx); }),
+            MakeCondition(41, ConditionId::EnemyFar),
             MakeAction(42, 4, "冲锋接近敌人")
         }),
         // 分支5: 默认 — 巡逻
@@ -189,16 +366,16 @@ std::shared_ptr<AIDecisionEngine::BehaviorNode> AIDecisionEngine::BuildMageTree(
     return MakeSelector(100, {
         // 分支1: 危急 — 瞬移逃跑
         MakeSequence(110, {
-            MakeCondition(111, [this](const auto& ctx) { return IsHealthCritical(ctx); }),
-            MakeCondition(112, [this](const auto& ctx) { return IsEnemyNearby(ctx); }),
+            MakeCondition(111, ConditionId::HealthCritical),
+            MakeCondition(112, ConditionId::EnemyNearby),
             MakeAction(113, 5, "瞬移逃跑")
         }),
         // 分支2: 低血 — 治疗或护盾
         MakeSequence(120, {
-            MakeCondition(121, [this](const auto& ctx) { return IsHealthLow(ctx); }),
+            MakeCondition(121, ConditionId::HealthLow),
             MakeSelector(122, {
                 MakeSequence(123, {
-                    MakeCondition(124, [this](const auto& ctx) { return HasMana(ctx); }),
+                    MakeCondition(124, ConditionId::HasMana),
                     MakeAction(125, 7, "施放治疗术")
                 }),
                 MakeAction(126, 2, "防御")
@@ -206,18 +383,18 @@ std::shared_ptr<AIDecisionEngine::BehaviorNode> AIDecisionEngine::BuildMageTree(
         }),
         // 分支3: 有蓝量 — 释放法术
         MakeSequence(130, {
-            MakeCondition(131, [this](const auto& ctx) { return HasMana(ctx); }),
-            MakeCondition(132, [this](const auto& ctx) { return IsInCombat(ctx); }),
+            MakeCondition(131, ConditionId::HasMana),
+            MakeCondition(132, ConditionId::InCombat),
             MakeAction(133, 3, "释放法师技能")
         }),
         // 分支4: 低蓝 — 普攻
         MakeSequence(140, {
-            MakeCondition(141, [this](const auto& ctx) { return HasLowMana(ctx); }),
+            MakeCondition(141, ConditionId::HasLowMana),
             MakeAction(142, 1, "普通攻击节省蓝量")
         }),
         // 分支5: 敌人远 — 接近
         MakeSequence(150, {
-            MakeCondition(151, [this](const auto& ctx) { return IsEnemyFar(ctx); }),
+            MakeCondition(151, ConditionId::EnemyFar),
             MakeAction(152, 4, "移动到施法距离")
         }),
         // 默认
@@ -232,13 +409,13 @@ std::shared_ptr<AIDecisionEngine::BehaviorNode> AIDecisionEngine::BuildArcherTre
     return MakeSelector(200, {
         // 分支1: 近身危急 — 闪避后退
         MakeSequence(210, {
-            MakeCondition(211, [this](const auto& ctx) { return IsEnemyNearby(ctx); }),
-            MakeCondition(212, [this](const auto& ctx) { return IsHealthLow(ctx); }),
+            MakeCondition(211, ConditionId::EnemyNearby),
+            MakeCondition(212, ConditionId::HealthLow),
             MakeAction(213, 5, "后跳闪避脱离")
         }),
         // 分支2: 敌人近身 — 放陷阱+闪避
         MakeSequence(220, {
-            MakeCondition(221, [this](const auto& ctx) { return IsEnemyNearby(ctx); }),
+            MakeCondition(221, ConditionId::EnemyNearby),
             MakeSelector(222, {
                 MakeAction(223, 8, "放置陷阱"),
                 MakeAction(224, 5, "闪避后退")
@@ -246,16 +423,16 @@ std::shared_ptr<AIDecisionEngine::BehaviorNode> AIDecisionEngine::BuildArcherTre
         }),
         // 分支3: 远距离+高血 — 狙击
         MakeSequence(230, {
-            MakeCondition(231, [this](const auto& ctx) { return IsEnemyFar(ctx); }),
-            MakeCondition(232, [this](const auto& ctx) { return IsHealthHigh(ctx); }),
+            MakeCondition(231, ConditionId::EnemyFar),
+            MakeCondition(232, ConditionId::HealthHigh),
             MakeAction(233, 3, "远距离狙击")
         }),
         // 分支4: 中距离 — 快速射击
         MakeSequence(240, {
-            MakeCondition(241, [this](const auto& ctx) { return IsInCombat(ctx); }),
+            MakeCondition(241, ConditionId::InCombat),
             MakeSelector(242, {
                 MakeSequence(243, {
-                    MakeCondition(244, [this](const auto& ctx) { return HasMana(ctx); }),
+                    MakeCondition(244, ConditionId::HasMana),
                     MakeAction(245, 3, "释放射击技能")
                 }),
                 MakeAction(246, 1, "快速射击")
@@ -273,15 +450,15 @@ std::shared_ptr<AIDecisionEngine::BehaviorNode> AIDecisionEngine::BuildBossTree(
     return MakeSelector(300, {
         // 阶段3: 绝望模式 (HP ≤ 20%) — 必杀技
         MakeSequence(310, {
-            MakeCondition(311, [this](const auto& ctx) { return IsHealthCritical(ctx); }),
+            MakeCondition(311, ConditionId::HealthCritical),
             MakeAction(312, 9, "Boss绝望必杀技")
         }),
         // 阶段2: 狂暴模式 (HP ≤ 50%) — 高频技能
         MakeSequence(320, {
-            MakeCondition(321, [this](const auto& ctx) { return IsHealthLow(ctx); }),
+            MakeCondition(321, ConditionId::HealthLow),
             MakeSelector(322, {
                 MakeSequence(323, {
-                    MakeCondition(324, [this](const auto& ctx) { return HasMana(ctx); }),
+                    MakeCondition(324, ConditionId::HasMana),
                     MakeAction(325, 3, "Boss狂暴连续技能")
                 }),
                 MakeAction(326, 1, "Boss狂暴攻击")
@@ -289,14 +466,14 @@ std::shared_ptr<AIDecisionEngine::BehaviorNode> AIDecisionEngine::BuildBossTree(
         }),
         // 阶段1: 正常模式 (HP > 50%)
         MakeSequence(330, {
-            MakeCondition(331, [this](const auto& ctx) { return IsHealthHigh(ctx); }),
+            MakeCondition(331, ConditionId::HealthHigh),
             MakeSelector(332, {
                 MakeSequence(333, {
-                    MakeCondition(334, [this](const auto& ctx) { return IsEnemyNearby(ctx); }),
+                    MakeCondition(334, ConditionId::EnemyNearby),
                     MakeAction(335, 1, "Boss普通攻击")
                 }),
                 MakeSequence(336, {
-                    MakeCondition(337, [this](const auto& ctx) { return HasMana(ctx); }),
+                    MakeCondition(337, ConditionId::HasMana),
                     MakeAction(338, 3, "Boss释放技能")
                 }),
                 MakeAction(339, 4, "Boss移动")
@@ -314,10 +491,10 @@ std::shared_ptr<AIDecisionEngine::BehaviorNode> AIDecisionEngine::BuildPassiveTr
     return MakeSelector(400, {
         // 分支1: 自身低血 — 治疗
         MakeSequence(410, {
-            MakeCondition(411, [this](const auto& ctx) { return IsHealthLow(ctx); }),
+            MakeCondition(411, ConditionId::HealthLow),
             MakeSelector(412, {
                 MakeSequence(413, {
-                    MakeCondition(414, [this](const auto& ctx) { return HasMana(ctx); }),
+                    MakeCondition(414, ConditionId::HasMana),
                     MakeAction(415, 7, "自我治疗")
                 }),
                 MakeAction(416, 2, "防御姿态")
@@ -325,13 +502,13 @@ std::shared_ptr<AIDecisionEngine::BehaviorNode> AIDecisionEngine::BuildPassiveTr
         }),
         // 分支2: 被攻击（高威胁） — 反击
         MakeSequence(420, {
-            MakeCondition(421, [this](const auto& ctx) { return IsHighThreat(ctx); }),
-            MakeCondition(422, [this](const auto& ctx) { return IsInCombat(ctx); }),
+            MakeCondition(421, ConditionId::HighThreat),
+            MakeCondition(422, ConditionId::InCombat),
             MakeAction(423, 1, "被迫反击")
         }),
         // 分支3: 战斗中 — 防御
         MakeSequence(430, {
-            MakeCondition(431, [this](const auto& ctx) { return IsInCombat(ctx); }),
+            MakeCondition(431, ConditionId::InCombat),
             MakeAction(432, 2, "防御姿态")
         }),
         // 默认: 和平待机
@@ -340,27 +517,68 @@ std::shared_ptr<AIDecisionEngine::BehaviorNode> AIDecisionEngine::BuildPassiveTr
 }
 
 // ============================================================================
-// 行为树评估
+// 行为树编译: 指针树 → 扁平POD数组
 // ============================================================================
-bool AIDecisionEngine::EvaluateNode(const std::shared_ptr<BehaviorNode>& node,
-                                    const std::vector<int>& context) {
-    if (!node) return false;
+AIDecisionEngine::CompiledTree AIDecisionEngine::CompileTree(
+    const std::shared_ptr<BehaviorNode>& root) {
+    CompiledTree tree;
+    if (root) {
+        CompileNode(root, tree);
+    }
+    return tree;
+}
+
+uint16_t AIDecisionEngine::CompileNode(const std::shared_ptr<BehaviorNode>& node,
+                                       CompiledTree& tree) {
+    const uint16_t index = static_cast<uint16_t>(tree.nodes.size());
+    CompiledNode compiled;
+    compiled.type = node->type;
+    compiled.condition = node->condition;
+    compiled.action_id = node->action_id;
+    tree.nodes.push_back(compiled);
+
+    if (!node->children.empty()) {
+        // 先递归编译子树，再把子节点索引写成连续区间
+        std::vector<uint16_t> child_indices;
+        child_indices.reserve(node->children.size());
+        for (const auto& child : node->children) {
+            child_indices.push_back(CompileNode(child, tree));
+        }
+        tree.nodes[index].child_begin = static_cast<uint16_t>(tree.child_indices.size());
+        tree.nodes[index].child_count = static_cast<uint16_t>(child_indices.size());
+        tree.child_indices.insert(tree.child_indices.end(),
+                                  child_indices.begin(), child_indices.end());
+    }
 
-    switch (node->type) {
+    return index;
+}
+
+// ============================================================================
+// 编译后行为树评估（按索引，无虚调用、无堆分配）
+// ============================================================================
+bool AIDecisionEngine::EvaluateCompiled(const CompiledTree& tree, uint16_t node_index,
+                                        std::span<const int> context) const {
+    const CompiledNode& node = tree.nodes[node_index];
+
+    switch (node.type) {
         case NodeType::SELECTOR:
-            for (const auto& child : node->children) {
-                if (EvaluateNode(child, context)) return true;
+            for (uint16_t i = 0; i < node.child_count; ++i) {
+                if (EvaluateCompiled(tree, tree.child_indices[node.child_begin + i], context)) {
+                    return true;
+                }
             }
             return false;
 
         case NodeType::SEQUENCE:
-            for (const auto& child : node->children) {
-                if (!EvaluateNode(child, context)) return false;
+            for (uint16_t i = 0; i < node.child_count; ++i) {
+                if (!EvaluateCompiled(tree, tree.child_indices[node.child_begin + i], context)) {
+                    return false;
+                }
             }
             return true;
 
         case NodeType::CONDITION:
-            return node->condition ? node->condition(context) : false;
+            return EvaluateCondition(node.condition, context);
 
         case NodeType::ACTION:
             return true;
@@ -368,17 +586,81 @@ bool AIDecisionEngine::EvaluateNode(const std::shared_ptr<BehaviorNode>& node,
     return false;
 }
 
+bool AIDecisionEngine::EvaluateCondition(ConditionId condition,
+                                         std::span<const int> context) const {
+    switch (condition) {
+        case ConditionId::EnemyNearby:    return IsEnemyNearby(context);
+        case ConditionId::EnemyFar:       return IsEnemyFar(context);
+        case ConditionId::HealthLow:      return IsHealthLow(context);
+        case ConditionId::HealthCritical: return IsHealthCritical(context);
+        case ConditionId::HealthHigh:     return IsHealthHigh(context);
+        case ConditionId::HasMana:        return HasMana(context);
+        case ConditionId::HasLowMana:     return HasLowMana(context);
+        case ConditionId::InCombat:       return IsInCombat(context);
+        case ConditionId::HighThreat:     return IsHighThreat(context);
+        case ConditionId::None:           break;
+    }
+    return false;
+}
+
 // ============================================================================
-// 动作选择（含反重复惩罚）
+// 情境量化与决策缓存
 // ============================================================================
-int AIDecisionEngine::SelectBestAction(int npc_id, NPCType type, const std::vector<int>& context) {
-    // 候选动作和基础权重
-    struct Candidate {
-        int action_id;
-        float weight;
-    };
+uint32_t AIDecisionEngine::SituationKey(NPCType type, std::span<const int> context) {
+    // HP档: 与条件阈值(≤20/<40/>50)及Boss阶段阈值(20/50)对齐，
+    // 缺失单列一档（Boss阶段判定对缺失HP按满血处理）
+    uint32_t hp_band = 4;
+    if (context.size() > 1) {
+        const int hp = context[1];
+        if (hp <= 20)      hp_band = 0;
+        else if (hp < 40)  hp_band = 1;
+        else if (hp <= 50) hp_band = 2;
+        else               hp_band = 3;
+    }
+
+    // 距离档: ≤5近战 / ≤10中距 / >10远距；缺失与中距同档
+    //（IsEnemyNearby与IsEnemyFar对两者的结论一致）
+    uint32_t distance_band = 1;
+    if (!context.empty()) {
+        if (context[0] <= 5)       distance_band = 0;
+        else if (context[0] > 10)  distance_band = 2;
+    }
+
+    const uint32_t in_combat = (context.size() > 2 && context[2] == 1) ? 1u : 0u;
+    const uint32_t high_threat = (context.size() > 3 && context[3] >= 7) ? 1u : 0u;
+    // 蓝量档: ≤20为低蓝；缺失时默认有蓝，与>20同档
+    const uint32_t low_mana = (context.size() > 4 && context[4] <= 20) ? 1u : 0u;
+
+    return static_cast<uint32_t>(type)
+        | (hp_band << 3)
+        | (distance_band << 6)
+        | (in_combat << 8)
+        | (high_threat << 9)
+        | (low_mana << 10);
+}
+
+void AIDecisionEngine::InvalidateDecisionCache(NPCType type) {
+    std::lock_guard<std::mutex> lock(cache_mutex_);
+    for (auto it = decision_cache_.begin(); it != decision_cache_.end();) {
+        if ((it->first & 0x7u) == static_cast<uint32_t>(type)) {
+            it = decision_cache_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+AIDecisionEngine::DecisionCacheStats AIDecisionEngine::GetDecisionCacheStats() const {
+    std::lock_guard<std::mutex> lock(cache_mutex_);
+    return DecisionCacheStats{decision_cache_.size(), cache_hits_, cache_misses_};
+}
 
-    std::vector<Candidate> candidates;
+// ============================================================================
+// 动作选择（含反重复惩罚）
+// ============================================================================
+std::vector<AIDecisionEngine::ActionCandidate> AIDecisionEngine::BuildActionCandidates(
+    NPCType type, std::span<const int> context) const {
+    std::vector<ActionCandidate> candidates;
 
     switch (type) {
         case NPCType::Warrior:
@@ -416,14 +698,9 @@ int AIDecisionEngine::SelectBestAction(int npc_id, NPCType type, const std::vect
             break;
 
         case NPCType::Boss: {
-            int phase = GetBossPhase(context);
-            if (phase == 3) {
-                candidates = {{9, 1.0f}, {3, 0.5f}};
-            } else if (phase == 2) {
-                candidates = {{3, 1.0f}, {1, 0.8f}, {3, 0.6f}};
-            } else {
-                candidates = {{1, 1.0f}, {3, 0.7f}, {4, 0.3f}};
-            }
+            // 阶段切换 = 预计算表下标，战斗高峰期无重新判定开销
+            const int phase = GetBossPhase(context);
+            candidates = boss_phase_candidates_[static_cast<size_t>(phase - 1)];
             break;
         }
 
@@ -438,15 +715,50 @@ int AIDecisionEngine::SelectBestAction(int npc_id, NPCType type, const std::vect
             break;
     }
 
+    return candidates;
+}
+
+int AIDecisionEngine::ChooseWeightedAction(int npc_id,
+                                           std::vector<ActionCandidate> candidates,
+                                           const DifficultyParams& difficulty) {
     if (candidates.empty()) {
         return 0;
     }
 
+    // 进攻性倾斜: 进攻类权重×aggression，防御类÷aggression
+    if (difficulty.aggression > 0.0f && difficulty.aggression != 1.0f) {
+        for (auto& c : candidates) {
+            if (IsOffensiveAction(c.action_id)) {
+                c.weight *= difficulty.aggression;
+            } else if (c.action_id != 4) {  // 移动保持中性
+                c.weight /= difficulty.aggression;
+            }
+        }
+    }
+
     // 应用反重复惩罚
     for (auto& c : candidates) {
         c.weight *= GetRepetitionPenalty(npc_id, c.action_id);
     }
 
+    // 选择温度: w^(1/T)，T<1收敛到最优动作，T>1趋向均匀随机。
+    // 先按最大权重归一化，极端T/aggression组合下不会上溢
+    const float temperature = std::clamp(difficulty.choice_temperature,
+                                         MIN_CHOICE_TEMPERATURE, MAX_CHOICE_TEMPERATURE);
+    if (temperature != 1.0f) {
+        float max_weight = 0.0f;
+        for (const auto& c : candidates) {
+            max_weight = std::max(max_weight, c.weight);
+        }
+        if (max_weight > 0.0f) {
+            const float exponent = 1.0f / temperature;
+            for (auto& c : candidates) {
+                c.weight = (c.weight > 0.0f)
+                    ? std::pow(c.weight / max_weight, exponent) : 0.0f;
+            }
+        }
+    }
+
     // 加权随机选择
     float total_weight = 0.0f;
     for (const auto& c : candidates) {
@@ -475,12 +787,18 @@ int AIDecisionEngine::SelectBestAction(int npc_id, NPCType type, const std::vect
 // 反重复惩罚
 // ============================================================================
 float AIDecisionEngine::GetRepetitionPenalty(int npc_id, int action_id) const {
-    auto it = decision_memory_.find(npc_id);
-    if (it == decision_memory_.end()) return 1.0f;
+    std::lock_guard<std::mutex> lock(memory_mutex_);
+    auto it = memory_slots_.find(npc_id);
+    if (it == memory_slots_.end()) return 1.0f;
+
+    const MemoryRing& ring = memory_rings_[it->second];
+    if (ring.epoch != memory_epoch_) return 1.0f;  // 整体清除后视为空环
 
+    const int* entries = memory_slab_.data() +
+                         static_cast<size_t>(it->second) * MEMORY_SIZE;
     int count = 0;
-    for (int past : it->second) {
-        if (past == action_id) count++;
+    for (uint8_t i = 0; i < ring.count; ++i) {
+        if (entries[i] == action_id) count++;
     }
 
     // 每重复一次权重×0.6
@@ -488,47 +806,110 @@ float AIDecisionEngine::GetRepetitionPenalty(int npc_id, int action_id) const {
 }
 
 void AIDecisionEngine::RecordDecision(int npc_id, int action_id) {
-    auto& memory = decision_memory_[npc_id];
-    memory.push_back(action_id);
-    while (static_cast<int>(memory.size()) > MEMORY_SIZE) {
-        memory.pop_front();
+    std::lock_guard<std::mutex> lock(memory_mutex_);
+
+    // 查找/分配该NPC的slab区段；预算用尽的NPC不记录
+    uint32_t slot = 0;
+    auto it = memory_slots_.find(npc_id);
+    if (it != memory_slots_.end()) {
+        slot = it->second;
+    } else {
+        if (memory_slots_.size() >= memory_rings_.size()) return;
+        slot = static_cast<uint32_t>(memory_slots_.size());
+        memory_slots_[npc_id] = slot;
+    }
+
+    MemoryRing& ring = memory_rings_[slot];
+    if (ring.epoch != memory_epoch_) {
+        ring = MemoryRing{};
+        ring.epoch = memory_epoch_;
+    }
+
+    int* entries = memory_slab_.data() + static_cast<size_t>(slot) * MEMORY_SIZE;
+    entries[ring.head] = action_id;
+    ring.head = static_cast<uint8_t>((ring.head + 1) % MEMORY_SIZE);
+    if (ring.count < MEMORY_SIZE) {
+        ++ring.count;
+    }
+}
+
+// ============================================================================
+// 检查点导出/导入
+// ============================================================================
+std::vector<std::pair<int, NPCType>> AIDecisionEngine::ExportNPCTypes() const {
+    std::vector<std::pair<int, NPCType>> result;
+    result.reserve(npc_types_.size());
+    for (const auto& pair : npc_types_) {
+        result.emplace_back(pair.first, pair.second);
+    }
+    return result;
+}
+
+std::vector<AIDecisionEngine::DecisionMemorySnapshot>
+AIDecisionEngine::ExportDecisionMemory() const {
+    std::vector<DecisionMemorySnapshot> result;
+    std::lock_guard<std::mutex> lock(memory_mutex_);
+    for (const auto& pair : memory_slots_) {
+        const MemoryRing& ring = memory_rings_[pair.second];
+        if (ring.epoch != memory_epoch_ || ring.count == 0) continue;
+
+        const int* entries = memory_slab_.data() +
+                             static_cast<size_t>(pair.second) * MEMORY_SIZE;
+        DecisionMemorySnapshot snapshot;
+        snapshot.npc_id = pair.first;
+        snapshot.recent_actions.reserve(ring.count);
+        // 环内最旧的条目位于 head - count（模环长）
+        for (uint8_t i = 0; i < ring.count; ++i) {
+            const int index = (ring.head - ring.count + i + MEMORY_SIZE) % MEMORY_SIZE;
+            snapshot.recent_actions.push_back(entries[index]);
+        }
+        result.push_back(std::move(snapshot));
+    }
+    return result;
+}
+
+void AIDecisionEngine::ImportDecisionMemory(
+    const std::vector<DecisionMemorySnapshot>& snapshots) {
+    for (const DecisionMemorySnapshot& snapshot : snapshots) {
+        for (int action_id : snapshot.recent_actions) {
+            RecordDecision(snapshot.npc_id, action_id);
+        }
     }
 }
 
 // ============================================================================
 // Boss阶段判定
 // ============================================================================
-int AIDecisionEngine::GetBossPhase(const std::vector<int>& context) const {
-    int hp_percent = (context.size() > 1) ? context[1] : 100;
-    if (hp_percent <= 20) return 3;  // 绝望
-    if (hp_percent <= 50) return 2;  // 狂暴
-    return 1;                         // 正常
+int AIDecisionEngine::GetBossPhase(std::span<const int> context) const {
+    int hp_percent = (context.size() > 1) ? context[1] : HP_PERCENT_MAX;
+    hp_percent = std::clamp(hp_percent, 0, HP_PERCENT_MAX);
+    return boss_phase_by_hp_[static_cast<size_t>(hp_percent)];
 }
 
 // ============================================================================
 // 条件判断函数
 // ============================================================================
-bool AIDecisionEngine::IsEnemyNearby(const std::vector<int>& context) const {
+bool AIDecisionEngine::IsEnemyNearby(std::span<const int> context) const {
     return !context.empty() && context[0] <= 5;
 }
 
-bool AIDecisionEngine::IsEnemyFar(const std::vector<int>& context) const {
+bool AIDecisionEngine::IsEnemyFar(std::span<const int> context) const {
     return !context.empty() && context[0] > 10;
 }
 
-bool AIDecisionEngine::IsHealthLow(const std::vector<int>& context) const {
+bool AIDecisionEngine::IsHealthLow(std::span<const int> context) const {
     return context.size() > 1 && context[1] < 40;
 }
 
-bool AIDecisionEngine::IsHealthCritical(const std::vector<int>& context) const {
+bool AIDecisionEngine::IsHealthCritical(std::span<const int> context) const {
     return context.size() > 1 && context[1] <= 20;
 }
 
-bool AIDecisionEngine::IsHealthHigh(const std::vector<int>& context) const {
+bool AIDecisionEngine::IsHealthHigh(std::span<const int> context) const {
     return context.size() > 1 && context[1] > 50;
 }
 
-bool AIDecisionEngine::HasMana(const std::vector<int>& context) const {
+bool AIDecisionEngine::HasMana(std::span<const int> context) const {
     // context[4] = 蓝量百分比（可选，默认充足）
     if (context.size() > 4) {
         return context[4] > 20;
@@ -536,26 +917,26 @@ bool AIDecisionEngine::HasMana(const std::vector<int>& context) const {
     return true;  // 无蓝量信息时默认有蓝
 }
 
-bool AIDecisionEngine::HasLowMana(const std::vector<int>& context) const {
+bool AIDecisionEngine::HasLowMana(std::span<const int> context) const {
     if (context.size() > 4) {
         return context[4] <= 20;
     }
     return false;
 }
 
-bool AIDecisionEngine::IsInCombat(const std::vector<int>& context) const {
+bool AIDecisionEngine::IsInCombat(std::span<const int> context) const {
     return context.size() > 2 && context[2] == 1;
 }
 
-bool AIDecisionEngine::IsHighThreat(const std::vector<int>& context) const {
+bool AIDecisionEngine::IsHighThreat(std::span<const int> context) const {
     return context.size() > 3 && context[3] >= 7;
 }
 
 // ============================================================================
 // 动作描述生成
 // ============================================================================
-std::string AIDecisionEngine::GenerateActionDescription(int action_id, int npc_id, NPCType type) const {
-    std::stringstream desc;
+DescriptionString AIDecisionEngine::GenerateActionDescription(int action_id, int npc_id, NPCType type) const {
+    DescriptionString desc;
 
     // NPC类型名称
     const char* type_name = "NPC";
@@ -567,23 +948,32 @@ std::string AIDecisionEngine::GenerateActionDescription(int action_id, int npc_i
         case NPCType::Passive: type_name = "NPC"; break;
     }
 
-    desc << type_name << "[" << npc_id << "] ";
+    desc += type_name;
+    desc += '[';
+    AppendInt(desc, npc_id);
+    desc += "] ";
 
     switch (action_id) {
-        case 0: desc << "进入待机状态"; break;
-        case 1: desc << "发起攻击"; break;
-        case 2: desc << "采取防御姿态"; break;
-        case 3: desc << "释放技能"; break;
-        case 4: desc << "移动到新位置"; break;
-        case 5: desc << "紧急回避/逃跑"; break;
-        case 6: desc << "寻求援助"; break;
-        case 7: desc << "施放治疗"; break;
-        case 8: desc << "放置陷阱"; break;
-        case 9: desc << "释放必杀技"; break;
-        default: desc << "执行未知动作[" << action_id << "]"; break;
-    }
-
-    return desc.str();
+        case 0: desc += "进入待机状态"; break;
+        case 1: desc += "发起攻击"; break;
+        case 2: desc += "采取防御姿态"; break;
+        case 3: desc += "释放技能"; break;
+        case 4: desc += "移动到新位置"; break;
+        case 5: desc += "紧急回避/逃跑"; break;
+        case 6: desc += "寻求援助"; break;
+        case 7: desc += "施放治疗"; break;
+        case 8: desc += "放置陷阱"; break;
+        case 9:
+            desc += "释放必杀技";
+            break;
+        default:
+            desc += "执行未知动作[";
+            AppendInt(desc, action_id);
+            desc += ']';
+            break;
+    }
+
+    return desc;
 }
 
 } // namespace algorithm
@@ -6,25 +6,131 @@
 #include "AlgorithmGrpcServiceImpl.h"
 #include "CharacterStats.h"
 #include "InputValidator.h"
+#include "RequestArena.h"
 #include "SkillTreeManager.h"
 
+#include "net/ClientRateLimiter.h"
+#include "trace/TraceRing.h"
+
+#include <google/protobuf/arena.h>
+
 #include <algorithm>
 #include <cctype>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
 #include <exception>
 #include <iostream>
+#include <set>
 #include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// Trace-context propagation: clients send their trace id in the
+// "x-trace-id" metadata key; hops land in the per-process trace ring
+// for offline merging with the other layers (see tools/trace_merge).
+std::uint64_t TraceIdFromContext(const grpc::ServerContext* context) {
+    const auto& metadata = context->client_metadata();
+    auto it = metadata.find("x-trace-id");
+    if (it == metadata.end()) {
+        return 0;
+    }
+    const std::string value(it->second.data(), it->second.size());
+    return std::strtoull(value.c_str(), nullptr, 10);
+}
+
+/**
+ * @brief Records recv/send hops of a traced RPC around the handler body.
+ */
+class ScopedTraceHops {
+public:
+    explicit ScopedTraceHops(const grpc::ServerContext* context)
+        : trace_id_(TraceIdFromContext(context)) {
+        if (trace_id_ != 0) {
+            algorithm::AlgorithmGrpcServiceImpl::TraceEvents().Record(
+                trace_id_, "algorithm_recv");
+        }
+    }
+
+    ~ScopedTraceHops() {
+        if (trace_id_ != 0) {
+            algorithm::AlgorithmGrpcServiceImpl::TraceEvents().Record(
+                trace_id_, "algorithm_send");
+        }
+    }
+
+private:
+    std::uint64_t trace_id_;
+};
+
+// Admission check at the top of every handler; one hash lookup on the
+// caller's peer identity. A client that burns through its class budget
+// is turned away before any computation happens.
+bool AdmitRpc(const grpc::ServerContext* context, net::RpcClass rpc_class) {
+    return algorithm::AlgorithmGrpcServiceImpl::RateLimiter().TryAcquire(
+        context->peer(), rpc_class);
+}
+
+grpc::Status RateLimitedStatus() {
+    return grpc::Status(grpc::StatusCode::RESOURCE_EXHAUSTED,
+                        "per-client rate limit exceeded");
+}
+
+} // namespace
 
 namespace algorithm {
 
+trace::TraceRing& AlgorithmGrpcServiceImpl::TraceEvents() {
+    static trace::TraceRing ring;
+    return ring;
+}
+
+net::ClientRateLimiter& AlgorithmGrpcServiceImpl::RateLimiter() {
+    // Budgets sized so the game client's normal battle loop never hits
+    // them; third-party tools get fairness isolation, not throughput.
+    static net::ClientRateLimiter limiter({{
+        /* Read */ {200.0, 400.0},
+        /* Compute */ {150.0, 300.0},
+        /* Mutate */ {100.0, 200.0},
+        /* Stream */ {2.0, 10.0},
+    }});
+    return limiter;
+}
+
 AlgorithmGrpcServiceImpl::AlgorithmGrpcServiceImpl() {
     std::cout << "AlgorithmGrpcServiceImpl: service initialized" << std::endl;
 }
 
+void AlgorithmGrpcServiceImpl::FillDamageResult(
+    DamageResult result,
+    algorithm_proto::DamageResult* response) {
+    std::string normalized_effect = result.effect.str();
+    std::transform(
+        normalized_effect.begin(),
+        normalized_effect.end(),
+        normalized_effect.begin(),
+        [](unsigned char ch) { return static_cast<char>(std::tolower(ch)); });
+
+    const bool is_critical =
+        normalized_effect.find("critical") != std::string::npos ||
+        normalized_effect.find("crit") != std::string::npos;
+
+    response->set_damage(result.damage);
+    response->set_effect(result.effect.str());
+    response->set_is_critical(is_critical);
+    response->set_element_multiplier(1.0f);
+}
+
 grpc::Status AlgorithmGrpcServiceImpl::CalculateDamage(
     grpc::ServerContext* context,
     const algorithm_proto::CalculationRequest* request,
     algorithm_proto::DamageResult* response) {
-    (void)context;
+    if (!AdmitRpc(context, net::RpcClass::Compute)) {
+        return RateLimitedStatus();
+    }
+    const ScopedTraceHops trace_hops(context);
 
     try {
         DamageRequest internal_request;
@@ -32,23 +138,44 @@ grpc::Status AlgorithmGrpcServiceImpl::CalculateDamage(
         internal_request.defender_id = request->defender_id();
         internal_request.skill_id = request->skill_id();
 
-        const auto result = service_.CalculateDamage(internal_request);
+        auto result = service_.CalculateDamage(internal_request);
+        FillDamageResult(std::move(result), response);
 
-        std::string normalized_effect = result.effect;
-        std::transform(
-            normalized_effect.begin(),
-            normalized_effect.end(),
-            normalized_effect.begin(),
-            [](unsigned char ch) { return static_cast<char>(std::tolower(ch)); });
+        return grpc::Status::OK;
+    } catch (const std::exception& e) {
+        return grpc::Status(grpc::StatusCode::INTERNAL, e.what());
+    }
+}
+
+grpc::Status AlgorithmGrpcServiceImpl::CalculateDamageBatch(
+    grpc::ServerContext* context,
+    const algorithm_proto::BatchCalculationRequest* request,
+    algorithm_proto::BatchDamageResult* response) {
+    if (!AdmitRpc(context, net::RpcClass::Compute)) {
+        return RateLimitedStatus();
+    }
+    const ScopedTraceHops trace_hops(context);
+
+    try {
+        // 请求内全部临时缓冲落入 arena，RPC 结束整体回收
+        RequestArena::Scope arena_scope;
+
+        ArenaVector<DamageRequest> internal_requests{ArenaAllocator<DamageRequest>{}};
+        internal_requests.reserve(static_cast<size_t>(request->requests_size()));
+        for (const auto& entry : request->requests()) {
+            DamageRequest internal_request;
+            internal_request.attacker_id = entry.attacker_id();
+            internal_request.defender_id = entry.defender_id();
+            internal_request.skill_id = entry.skill_id();
+            internal_requests.push_back(internal_request);
+        }
 
-        const bool is_critical =
-            normalized_effect.find("critical") != std::string::npos ||
-            normalized_effect.find("crit") != std::string::npos;
+        auto results = service_.CalculateDamageBatch(internal_requests);
 
-        response->set_damage(result.damage);
-        response->set_effect(result.effect);
-        response->set_is_critical(is_critical);
-        response->set_element_multiplier(1.0f);
+        response->mutable_results()->Reserve(request->requests_size());
+        for (auto& result : results) {
+            FillDamageResult(std::move(result), response->add_results());
+        }
 
         return grpc::Status::OK;
     } catch (const std::exception& e) {
@@ -60,7 +187,10 @@ grpc::Status AlgorithmGrpcServiceImpl::AIActionDecision(
     grpc::ServerContext* context,
     const algorithm_proto::AIDecisionRequest* request,
     algorithm_proto::ActionResponse* response) {
-    (void)context;
+    if (!AdmitRpc(context, net::RpcClass::Compute)) {
+        return RateLimitedStatus();
+    }
+    const ScopedTraceHops trace_hops(context);
 
     try {
         AIDecisionRequest internal_request;
@@ -69,10 +199,10 @@ grpc::Status AlgorithmGrpcServiceImpl::AIActionDecision(
             internal_request.context.push_back(request->context(i));
         }
 
-        const auto result = service_.MakeAIDecision(internal_request);
+        auto result = service_.MakeAIDecision(internal_request);
 
         response->set_action_id(result.action_id);
-        response->set_description(result.description);
+        response->set_description(result.description.str());
         response->set_confidence(0.8f);
 
         return grpc::Status::OK;
@@ -81,11 +211,97 @@ grpc::Status AlgorithmGrpcServiceImpl::AIActionDecision(
     }
 }
 
+grpc::Status AlgorithmGrpcServiceImpl::BatchAIDecision(
+    grpc::ServerContext* context,
+    const algorithm_proto::BatchAIDecisionRequest* request,
+    algorithm_proto::BatchActionResponse* response) {
+    if (!AdmitRpc(context, net::RpcClass::Compute)) {
+        return RateLimitedStatus();
+    }
+    const ScopedTraceHops trace_hops(context);
+
+    try {
+        // 请求内全部临时缓冲落入 arena，RPC 结束整体回收
+        RequestArena::Scope arena_scope;
+
+        // 共享上下文只解析一次，按NPC局部覆盖
+        ArenaVector<int> shared_context{ArenaAllocator<int>{}};
+        shared_context.reserve(static_cast<size_t>(request->shared_context_size()));
+        for (int i = 0; i < request->shared_context_size(); ++i) {
+            shared_context.push_back(request->shared_context(i));
+        }
+
+        ArenaVector<AIDecisionRequest> internal_requests{ArenaAllocator<AIDecisionRequest>{}};
+        internal_requests.reserve(static_cast<size_t>(request->npcs_size()));
+        for (const auto& npc : request->npcs()) {
+            AIDecisionRequest internal_request;
+            internal_request.npc_id = npc.npc_id();
+            internal_request.context.assign(shared_context.begin(), shared_context.end());
+            for (int i = 0; i < npc.context_size(); ++i) {
+                if (static_cast<size_t>(i) < internal_request.context.size()) {
+                    internal_request.context[static_cast<size_t>(i)] = npc.context(i);
+                } else {
+                    internal_request.context.push_back(npc.context(i));
+                }
+            }
+            internal_requests.push_back(std::move(internal_request));
+        }
+
+        auto results = service_.MakeAIDecisionsBatch(internal_requests);
+
+        response->mutable_responses()->Reserve(request->npcs_size());
+        for (auto& result : results) {
+            auto* action = response->add_responses();
+            action->set_action_id(result.action_id);
+            action->set_description(result.description.str());
+            action->set_confidence(0.8f);
+        }
+
+        return grpc::Status::OK;
+    } catch (const std::exception& e) {
+        return grpc::Status(grpc::StatusCode::INTERNAL, e.what());
+    }
+}
+
+void AlgorithmGrpcServiceImpl::FillSkillNode(
+    const SkillNode& skill,
+    const google::protobuf::RepeatedField<int32_t>& learned_skills,
+    algorithm_proto::SkillNode* node) {
+    node->set_skill_id(skill.skill_id);
+    node->set_name(skill.name);
+    node->set_description(skill.description);
+    node->set_damage_multiplier(skill.damage_multiplier);
+    node->set_mana_cost(skill.mana_cost);
+    node->set_cooldown(skill.cooldown_ms);
+
+    for (int prereq : skill.prerequisites) {
+        node->add_prerequisites(prereq);
+    }
+
+    bool can_learn = true;
+    for (int prereq : skill.prerequisites) {
+        bool found = false;
+        for (int learned : learned_skills) {
+            if (learned == prereq) {
+                found = true;
+                break;
+            }
+        }
+        if (!found) {
+            can_learn = false;
+            break;
+        }
+    }
+    node->set_can_learn(can_learn);
+}
+
 grpc::Status AlgorithmGrpcServiceImpl::GetSkillTree(
     grpc::ServerContext* context,
     const algorithm_proto::SkillTreeRequest* request,
     algorithm_proto::SkillTree* response) {
-    (void)context;
+    if (!AdmitRpc(context, net::RpcClass::Read)) {
+        return RateLimitedStatus();
+    }
 
     try {
         response->set_character_id(request->character_id());
@@ -94,33 +310,79 @@ grpc::Status AlgorithmGrpcServiceImpl::GetSkillTree(
         const auto skills = service_.GetSkillsByProfession(Profession::Warrior);
 
         for (const auto* skill : skills) {
-            auto* node = response->add_skills();
-            node->set_skill_id(skill->skill_id);
-            node->set_name(skill->name);
-            node->set_description(skill->description);
-            node->set_damage_multiplier(skill->damage_multiplier);
-            node->set_mana_cost(skill->mana_cost);
-            node->set_cooldown(skill->cooldown_ms);
-
-            for (int prereq : skill->prerequisites) {
-                node->add_prerequisites(prereq);
+            FillSkillNode(*skill, request->learned_skills(), response->add_skills());
+        }
+
+        return grpc::Status::OK;
+    } catch (const std::exception& e) {
+        return grpc::Status(grpc::StatusCode::INTERNAL, e.what());
+    }
+}
+
+grpc::Status AlgorithmGrpcServiceImpl::WatchSkillTree(
+    grpc::ServerContext* context,
+    const algorithm_proto::SkillTreeWatchRequest* request,
+    grpc::ServerWriter<algorithm_proto::SkillTreeDelta>* writer) {
+    // Streams are charged once at open; pushes are paced by the poll
+    // interval, not by the client.
+    if (!AdmitRpc(context, net::RpcClass::Stream)) {
+        return RateLimitedStatus();
+    }
+
+    try {
+        uint64_t sent_version = service_.GetSkillTreeVersion();
+
+        // 流式增量全部构建在本连接的 protobuf arena 上：节点、字符串等
+        // 子对象都落入 arena，每条写出后 Reset 整块回收复用，长连接
+        // 推送不再逐条触碰全局堆分配器
+        google::protobuf::Arena arena;
+
+        // 初始增量: 版本一致只回版本号（零节点传输），否则发全量快照
+        auto* initial =
+            google::protobuf::Arena::CreateMessage<algorithm_proto::SkillTreeDelta>(&arena);
+        initial->set_version(sent_version);
+        if (request->known_version() == sent_version) {
+            initial->set_change(algorithm_proto::SkillTreeDelta::UP_TO_DATE);
+        } else {
+            initial->set_change(algorithm_proto::SkillTreeDelta::FULL_SNAPSHOT);
+            for (const auto* skill : service_.GetSkillsByProfession(Profession::Warrior)) {
+                FillSkillNode(*skill, request->learned_skills(), initial->add_nodes());
             }
+        }
+        if (!writer->Write(*initial)) {
+            return grpc::Status::OK;
+        }
 
-            bool can_learn = true;
-            for (int prereq : skill->prerequisites) {
-                bool found = false;
-                for (int i = 0; i < request->learned_skills_size(); ++i) {
-                    if (request->learned_skills(i) == prereq) {
-                        found = true;
-                        break;
-                    }
-                }
-                if (!found) {
-                    can_learn = false;
-                    break;
+        // 后续仅推送版本变化后的新增/变化节点，客户端取消时退出
+        std::set<int> sent_ids;
+        for (const auto* skill : service_.GetSkillsByProfession(Profession::Warrior)) {
+            sent_ids.insert(skill->skill_id);
+        }
+
+        while (!context->IsCancelled()) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(WATCH_POLL_INTERVAL_MS));
+
+            uint64_t current_version = service_.GetSkillTreeVersion();
+            if (current_version == sent_version) {
+                continue;
+            }
+
+            // 上一条增量已写出，整块回收 arena 后在其上重建本条
+            arena.Reset();
+            auto* delta =
+                google::protobuf::Arena::CreateMessage<algorithm_proto::SkillTreeDelta>(&arena);
+            delta->set_version(current_version);
+            delta->set_change(algorithm_proto::SkillTreeDelta::NODE_ADDED);
+            for (const auto* skill : service_.GetSkillsByProfession(Profession::Warrior)) {
+                if (sent_ids.insert(skill->skill_id).second) {
+                    FillSkillNode(*skill, request->learned_skills(), delta->add_nodes());
                 }
             }
-            node->set_can_learn(can_learn);
+
+            if (!writer->Write(*delta)) {
+                break;
+            }
+            sent_version = current_version;
         }
 
         return grpc::Status::OK;
@@ -133,7 +395,9 @@ grpc::Status AlgorithmGrpcServiceImpl::ValidateInput(
     grpc::ServerContext* context,
     const algorithm_proto::ValidationRequest* request,
     algorithm_proto::ValidationResult* response) {
-    (void)context;
+    if (!AdmitRpc(context, net::RpcClass::Read)) {
+        return RateLimitedStatus();
+    }
 
     try {
         if (request->validation_type() == "health_check") {
@@ -141,18 +405,25 @@ grpc::Status AlgorithmGrpcServiceImpl::ValidateInput(
             return grpc::Status::OK;
         }
 
-        bool all_valid = true;
-        auto* normalized = response->mutable_normalized_fields();
-
+        // 整批字段一次交给校验器，内部按编译好的规则表分发
+        RequestArena::Scope arena_scope;
+        ArenaVector<std::pair<std::string, std::string>> fields{
+            ArenaAllocator<std::pair<std::string, std::string>>{}};
+        fields.reserve(static_cast<size_t>(request->fields_size()));
         for (const auto& field_entry : request->fields()) {
-            const auto& key = field_entry.first;
-            const auto& value = field_entry.second;
+            fields.emplace_back(field_entry.first, field_entry.second);
+        }
 
-            if (value.empty()) {
-                response->add_errors("Field '" + key + "' must not be empty");
-                all_valid = false;
+        auto results = service_.ValidateFields(fields);
+
+        bool all_valid = true;
+        auto* normalized = response->mutable_normalized_fields();
+        for (size_t i = 0; i < fields.size(); ++i) {
+            if (results[i].success) {
+                (*normalized)[fields[i].first] = std::move(fields[i].second);
             } else {
-                (*normalized)[key] = value;
+                response->add_errors(std::move(results[i].error_message));
+                all_valid = false;
             }
         }
 
@@ -163,4 +434,49 @@ grpc::Status AlgorithmGrpcServiceImpl::ValidateInput(
     }
 }
 
+grpc::Status AlgorithmGrpcServiceImpl::FindPathBatch(
+    grpc::ServerContext* context,
+    const algorithm_proto::PathBatchRequest* request,
+    algorithm_proto::PathBatchResult* response) {
+    if (!AdmitRpc(context, net::RpcClass::Compute)) {
+        return RateLimitedStatus();
+    }
+    const ScopedTraceHops trace_hops(context);
+
+    try {
+        // 请求内全部临时缓冲落入 arena，RPC 结束整体回收
+        RequestArena::Scope arena_scope;
+
+        ArenaVector<PathQuery> internal_queries{ArenaAllocator<PathQuery>{}};
+        internal_queries.reserve(static_cast<size_t>(request->queries_size()));
+        for (const auto& entry : request->queries()) {
+            PathQuery internal_query;
+            internal_query.map_id = entry.map_id();
+            internal_query.start = GridPoint{entry.start().x(), entry.start().y()};
+            internal_query.goal = GridPoint{entry.goal().x(), entry.goal().y()};
+            internal_queries.push_back(internal_query);
+        }
+
+        auto results = service_.FindPathsBatch(internal_queries);
+
+        response->mutable_results()->Reserve(request->queries_size());
+        for (const auto& result : results) {
+            auto* entry = response->add_results();
+            entry->set_reachable(result.reachable);
+            entry->set_from_cache(result.from_cache);
+            entry->mutable_waypoints()->Reserve(
+                static_cast<int>(result.waypoints.size()));
+            for (const GridPoint& waypoint : result.waypoints) {
+                auto* point = entry->add_waypoints();
+                point->set_x(waypoint.x);
+                point->set_y(waypoint.y);
+            }
+        }
+
+        return grpc::Status::OK;
+    } catch (const std::exception& e) {
+        return grpc::Status(grpc::StatusCode::INTERNAL, e.what());
+    }
+}
+
 } // namespace algorithm
@@ -6,7 +6,9 @@
  * 更新时间: 2025-07-24 — 集成角色属性、输入校验、冷却追踪、状态效果
  */
 #include "AlgorithmService.h"
+#include "RequestArena.h"
 #include "SkillTreeManager.h"
+#include <algorithm>
 
 namespace algorithm {
 
@@ -14,7 +16,8 @@ AlgorithmService::AlgorithmService()
     : damage_calculator_(std::make_unique<DamageCalculator>())
     , ai_engine_(std::make_unique<AIDecisionEngine>())
     , stats_registry_(std::make_unique<CharacterStatsRegistry>())
-    , validator_(std::make_unique<InputValidator>()) {
+    , validator_(std::make_unique<InputValidator>())
+    , navigation_(std::make_unique<NavigationService>()) {
     // 将属性注册表注入伤害计算器
     damage_calculator_->setStatsRegistry(stats_registry_.get());
 }
@@ -68,6 +71,16 @@ DamageResult AlgorithmService::CalculateDamage(const DamageRequest& request) {
     return damage_calculator_->CalculateDamage(request);
 }
 
+std::vector<DamageResult> AlgorithmService::CalculateDamageBatch(
+    std::span<const DamageRequest> requests) {
+    std::vector<DamageResult> results;
+    results.reserve(requests.size());
+    for (const auto& request : requests) {
+        results.push_back(CalculateDamage(request));
+    }
+    return results;
+}
+
 AIDecisionResult AlgorithmService::MakeAIDecision(const AIDecisionRequest& request) {
     // 输入校验
     auto validation = validator_->validateAIDecisionRequest(request);
@@ -78,6 +91,34 @@ AIDecisionResult AlgorithmService::MakeAIDecision(const AIDecisionRequest& reque
     return ai_engine_->MakeDecision(request);
 }
 
+std::vector<AIDecisionResult> AlgorithmService::MakeAIDecisionsBatch(
+    std::span<const AIDecisionRequest> requests) {
+    // 校验失败的请求返回默认待机，不影响批内其他NPC
+    // 中间缓冲放入请求 arena，随请求作用域整体回收
+    std::vector<AIDecisionResult> results(requests.size());
+    ArenaVector<AIDecisionRequest> valid_requests{ArenaAllocator<AIDecisionRequest>{}};
+    ArenaVector<size_t> valid_indices{ArenaAllocator<size_t>{}};
+    valid_requests.reserve(requests.size());
+    valid_indices.reserve(requests.size());
+
+    for (size_t i = 0; i < requests.size(); ++i) {
+        auto validation = validator_->validateAIDecisionRequest(requests[i]);
+        if (validation.success) {
+            valid_requests.push_back(requests[i]);
+            valid_indices.push_back(i);
+        } else {
+            results[i] = {0, "校验失败: " + validation.error_message};
+        }
+    }
+
+    auto valid_results = ai_engine_->MakeDecisionsBatch(valid_requests);
+    for (size_t i = 0; i < valid_results.size(); ++i) {
+        results[valid_indices[i]] = std::move(valid_results[i]);
+    }
+
+    return results;
+}
+
 // ============================================================================
 // 扩展接口
 // ============================================================================
@@ -105,6 +146,14 @@ void AlgorithmService::RegisterNPCType(int npc_id, NPCType type) {
     ai_engine_->RegisterNPCType(npc_id, type);
 }
 
+void AlgorithmService::SetAIDifficulty(NPCType type, const DifficultyParams& params) {
+    ai_engine_->SetDifficulty(type, params);
+}
+
+void AlgorithmService::SetNPCAIDifficulty(int npc_id, const DifficultyParams& params) {
+    ai_engine_->SetNPCDifficulty(npc_id, params);
+}
+
 const SkillNode* AlgorithmService::GetSkillInfo(int skill_id) const {
     return damage_calculator_->getSkillManager()->GetSkill(skill_id);
 }
@@ -113,6 +162,29 @@ std::vector<const SkillNode*> AlgorithmService::GetSkillsByProfession(Profession
     return damage_calculator_->getSkillManager()->GetSkillsByProfession(profession);
 }
 
+uint64_t AlgorithmService::GetSkillTreeVersion() const {
+    return damage_calculator_->getSkillManager()->GetTreeVersion();
+}
+
+void AlgorithmService::UpdateCharacterSkillState(int character_id,
+                                                 const std::vector<int>& learned_skills,
+                                                 const std::vector<int>& skill_levels) {
+    damage_calculator_->getSkillManager()->UpdateCharacterSkillState(
+        character_id, learned_skills, skill_levels);
+}
+
+EvaluatedSkillTree AlgorithmService::GetEvaluatedSkillTree(int character_id) const {
+    return damage_calculator_->getSkillManager()->GetEvaluatedTree(character_id);
+}
+
+std::string AlgorithmService::SerializeEvaluatedSkillTree(int character_id) const {
+    return damage_calculator_->getSkillManager()->SerializeEvaluatedTree(character_id);
+}
+
+bool AlgorithmService::RestoreEvaluatedSkillTree(int character_id, const std::string& data) {
+    return damage_calculator_->getSkillManager()->RestoreEvaluatedTree(character_id, data);
+}
+
 bool AlgorithmService::IsSkillReady(int character_id, int skill_id) const {
     return cooldown_tracker_.isReady(character_id, skill_id);
 }
@@ -130,35 +202,60 @@ void AlgorithmService::TickCooldowns(int delta_ms) {
 // ============================================================================
 
 void AlgorithmService::AddStatusEffect(int character_id, const StatusEffect& effect) {
-    status_effects_[character_id].push_back(effect);
+    auto handle = effect_pool_.acquire(effect);
+    if (!active_effects_[character_id].add(handle)) {
+        // 角色效果列表已满，丢弃新效果并归还槽位
+        effect_pool_.release(handle);
+    }
 }
 
 std::vector<StatusEffect> AlgorithmService::GetStatusEffects(int character_id) const {
-    auto it = status_effects_.find(character_id);
-    if (it != status_effects_.end()) {
-        return it->second;
+    std::vector<StatusEffect> effects;
+    auto it = active_effects_.find(character_id);
+    if (it == active_effects_.end()) {
+        return effects;
     }
-    return {};
+
+    const ActiveEffectList& list = it->second;
+    effects.reserve(list.size());
+    for (size_t i = 0; i < list.size(); ++i) {
+        if (const StatusEffect* effect = effect_pool_.get(list[i])) {
+            effects.push_back(*effect);
+        }
+    }
+    return effects;
 }
 
 void AlgorithmService::TickStatusEffects(int character_id) {
-    auto it = status_effects_.find(character_id);
-    if (it == status_effects_.end()) return;
-
-    auto& effects = it->second;
-    // 移除过期效果
-    effects.erase(
-        std::remove_if(effects.begin(), effects.end(),
-            [](StatusEffect& e) { return !e.tick(); }),
-        effects.end());
-
-    if (effects.empty()) {
-        status_effects_.erase(it);
+    auto it = active_effects_.find(character_id);
+    if (it == active_effects_.end()) return;
+
+    ActiveEffectList& list = it->second;
+    // 原地tick，过期效果归还池并尾部交换移除（无堆操作）
+    for (size_t i = 0; i < list.size();) {
+        StatusEffect* effect = effect_pool_.get(list[i]);
+        if (effect == nullptr || !effect->tick()) {
+            effect_pool_.release(list[i]);
+            list.removeAt(i);
+        } else {
+            ++i;
+        }
+    }
+
+    if (list.empty()) {
+        active_effects_.erase(it);
     }
 }
 
 void AlgorithmService::ClearStatusEffects(int character_id) {
-    status_effects_.erase(character_id);
+    auto it = active_effects_.find(character_id);
+    if (it == active_effects_.end()) return;
+
+    const ActiveEffectList& list = it->second;
+    for (size_t i = 0; i < list.size(); ++i) {
+        effect_pool_.release(list[i]);
+    }
+    active_effects_.erase(it);
 }
 
 // ============================================================================
@@ -171,8 +268,44 @@ ValidationResult AlgorithmService::ValidateSkillLearn(int skill_id, Profession p
         skill_id, profession, learned_skills, *damage_calculator_->getSkillManager());
 }
 
+std::vector<ValidationResult> AlgorithmService::ValidateFields(
+    std::span<const std::pair<std::string, std::string>> fields) const {
+    return validator_->validateFields(fields);
+}
+
 float AlgorithmService::GetElementMultiplier(Element attacker, Element defender) const {
     return stats_registry_->getElementMultiplier(attacker, defender);
 }
 
+void AlgorithmService::SetBattleSeed(uint64_t seed) {
+    damage_calculator_->setBattleSeed(seed);
+}
+
+// ============================================================================
+// 导航
+// ============================================================================
+
+bool AlgorithmService::RegisterNavigationMap(int map_id, int width, int height,
+                                             std::span<const uint8_t> walkable) {
+    return navigation_->RegisterMap(map_id, width, height, walkable);
+}
+
+PathResult AlgorithmService::FindPath(const PathQuery& query) {
+    return navigation_->FindPath(query);
+}
+
+std::vector<PathResult> AlgorithmService::FindPathsBatch(
+    std::span<const PathQuery> queries) {
+    return navigation_->FindPathsBatch(queries);
+}
+
+bool AlgorithmService::IsPositionReachable(int map_id, GridPoint from,
+                                           GridPoint to) const {
+    return navigation_->IsReachable(map_id, from, to);
+}
+
+bool AlgorithmService::IsPositionWalkable(int map_id, GridPoint point) const {
+    return navigation_->IsWalkable(map_id, point);
+}
+
 } // namespace algorithm
@@ -6,23 +6,66 @@
  */
 
 #include "CharacterStats.h"
+#include "ElementTables.h"
 #include <cmath>
 #include <algorithm>
 
 namespace algorithm {
 
+// ============================================================================
+// SoA 属性列
+// ============================================================================
+
+void CharacterStatsColumns::clear() {
+    character_id.clear();
+    current_hp.clear();
+    max_hp.clear();
+    attack.clear();
+    defense.clear();
+    magic_attack.clear();
+    magic_defense.clear();
+    crit_rate.clear();
+    crit_damage.clear();
+    element.clear();
+}
+
+void CharacterStatsColumns::appendRow(const CharacterStats& stats) {
+    character_id.push_back(stats.character_id);
+    current_hp.push_back(stats.current_hp);
+    max_hp.push_back(stats.max_hp);
+    attack.push_back(stats.attack);
+    defense.push_back(stats.defense);
+    magic_attack.push_back(stats.magic_attack);
+    magic_defense.push_back(stats.magic_defense);
+    crit_rate.push_back(stats.crit_rate);
+    crit_damage.push_back(stats.crit_damage);
+    element.push_back(stats.element);
+}
+
+void CharacterStatsColumns::writeRow(size_t row, const CharacterStats& stats) {
+    character_id[row] = stats.character_id;
+    current_hp[row] = stats.current_hp;
+    max_hp[row] = stats.max_hp;
+    attack[row] = stats.attack;
+    defense[row] = stats.defense;
+    magic_attack[row] = stats.magic_attack;
+    magic_defense[row] = stats.magic_defense;
+    crit_rate[row] = stats.crit_rate;
+    crit_damage[row] = stats.crit_damage;
+    element[row] = stats.element;
+}
+
+// ============================================================================
+// 注册表
+// ============================================================================
+
 CharacterStatsRegistry::CharacterStatsRegistry() {
-    initializeElementMatrix();
     initializeProfessionDefaults();
 }
 
 float CharacterStatsRegistry::getElementMultiplier(Element attacker_element, Element defender_element) const {
-    int atk = static_cast<int>(attacker_element);
-    int def = static_cast<int>(defender_element);
-    if (atk >= 0 && atk < ELEMENT_COUNT && def >= 0 && def < ELEMENT_COUNT) {
-        return element_matrix_[atk][def];
-    }
-    return 1.0f;
+    // 克制矩阵是编译期常量表（见 ElementTables.h）
+    return GetElementMatrixMultiplier(attacker_element, defender_element);
 }
 
 CharacterStats CharacterStatsRegistry::getDefaultStats(Profession profession, int level) const {
@@ -40,6 +83,15 @@ CharacterStats CharacterStatsRegistry::getDefaultStats(Profession profession, in
 
 void CharacterStatsRegistry::registerCharacter(const CharacterStats& stats) {
     characters_[stats.character_id] = stats;
+
+    // 同步 SoA 列: 已有角色原地覆盖，新角色追加一行
+    auto row_it = column_rows_.find(stats.character_id);
+    if (row_it != column_rows_.end()) {
+        columns_.writeRow(row_it->second, stats);
+    } else {
+        column_rows_[stats.character_id] = columns_.size();
+        columns_.appendRow(stats);
+    }
 }
 
 const CharacterStats* CharacterStatsRegistry::getCharacterStats(int character_id) const {
@@ -47,6 +99,32 @@ const CharacterStats* CharacterStatsRegistry::getCharacterStats(int character_id
     return it != characters_.end() ? &it->second : nullptr;
 }
 
+std::vector<CharacterStats> CharacterStatsRegistry::getAllCharacters() const {
+    std::vector<CharacterStats> result;
+    result.reserve(characters_.size());
+    for (const auto& pair : characters_) {
+        result.push_back(pair.second);
+    }
+    return result;
+}
+
+int CharacterStatsRegistry::getStatsRow(int character_id) const {
+    auto it = column_rows_.find(character_id);
+    return it != column_rows_.end() ? static_cast<int>(it->second) : -1;
+}
+
+size_t CharacterStatsRegistry::gatherStats(const std::vector<int>& character_ids,
+                                           CharacterStatsColumns& out) const {
+    out.clear();
+    for (int id : character_ids) {
+        auto it = characters_.find(id);
+        if (it != characters_.end()) {
+            out.appendRow(it->second);
+        }
+    }
+    return out.size();
+}
+
 CharacterStats CharacterStatsRegistry::scaleByLevel(const CharacterStats& base, int level) {
     if (level <= 1) return base;
 
@@ -68,42 +146,6 @@ CharacterStats CharacterStatsRegistry::scaleByLevel(const CharacterStats& base,
     return scaled;
 }
 
-void CharacterStatsRegistry::initializeElementMatrix() {
-    // 默认所有倍率为 1.0
-    for (auto& row : element_matrix_) {
-        row.fill(1.0f);
-    }
-
-    int fire  = static_cast<int>(Element::Fire);
-    int water = static_cast<int>(Element::Water);
-    int grass = static_cast<int>(Element::Grass);
-    int light = static_cast<int>(Element::Light);
-    int dark  = static_cast<int>(Element::Dark);
-
-    // 火 → 水: 0.5x (不利), 水 → 火: 2.0x (克制)
-    element_matrix_[fire][water]  = 0.5f;
-    element_matrix_[water][fire]  = 2.0f;
-
-    // 火 → 草: 2.0x (克制), 草 → 火: 0.5x (不利)
-    element_matrix_[fire][grass]  = 2.0f;
-    element_matrix_[grass][fire]  = 0.5f;
-
-    // 水 → 草: 0.5x (不利), 草 → 水: 2.0x (克制)
-    element_matrix_[water][grass] = 0.5f;
-    element_matrix_[grass][water] = 2.0f;
-
-    // 光 ↔ 暗: 互相克制 2.0x
-    element_matrix_[light][dark]  = 2.0f;
-    element_matrix_[dark][light]  = 2.0f;
-
-    // 同元素: 0.75x
-    element_matrix_[fire][fire]   = 0.75f;
-    element_matrix_[water][water] = 0.75f;
-    element_matrix_[grass][grass] = 0.75f;
-    element_matrix_[light][light] = 0.75f;
-    element_matrix_[dark][dark]   = 0.75f;
-}
-
 void CharacterStatsRegistry::initializeProfessionDefaults() {
     // 战士：高HP、高物攻、高物防，低魔攻
     CharacterStats warrior;
@@ -0,0 +1,81 @@
+/*
+ * 文件名: DamageBatchKernel.cpp
+ * 说明: 批量伤害计算内核实现
+ * 作者: 彭承康
+ * 创建时间: 2026-08-27
+ */
+#include "DamageBatchKernel.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define ALGORITHM_DAMAGE_KERNEL_SSE2 1
+#include <emmintrin.h>
+#endif
+
+namespace algorithm {
+
+void DamageBatchSoA::reserve(size_t count) {
+    base_damage.reserve(count);
+    element_multiplier.reserve(count);
+    defense.reserve(count);
+    crit_multiplier.reserve(count);
+    attack_buff.reserve(count);
+    variance.reserve(count);
+}
+
+namespace {
+
+/**
+ * @brief 标量版本: 逐目标套用核心公式
+ */
+void ComputeScalar(const DamageBatchSoA& in, float* out, size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+        const float defense_mult = 1.0f - in.defense[i] / (in.defense[i] + 100.0f);
+        out[i] = in.base_damage[i]
+                 * in.element_multiplier[i]
+                 * defense_mult
+                 * in.crit_multiplier[i]
+                 * in.attack_buff[i]
+                 * in.variance[i];
+    }
+}
+
+} // namespace
+
+void ComputeDamageBatch(const DamageBatchSoA& input, std::vector<float>& out_damage) {
+    const size_t count = input.size();
+    out_damage.resize(count);
+    if (count == 0) {
+        return;
+    }
+
+    size_t i = 0;
+
+#ifdef ALGORITHM_DAMAGE_KERNEL_SSE2
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 hundred = _mm_set1_ps(100.0f);
+
+    for (; i + 4 <= count; i += 4) {
+        const __m128 base = _mm_loadu_ps(&input.base_damage[i]);
+        const __m128 elem = _mm_loadu_ps(&input.element_multiplier[i]);
+        const __m128 def = _mm_loadu_ps(&input.defense[i]);
+        const __m128 crit = _mm_loadu_ps(&input.crit_multiplier[i]);
+        const __m128 buff = _mm_loadu_ps(&input.attack_buff[i]);
+        const __m128 var = _mm_loadu_ps(&input.variance[i]);
+
+        // defense_mult = 1 - defense / (defense + 100)
+        const __m128 def_mult = _mm_sub_ps(one, _mm_div_ps(def, _mm_add_ps(def, hundred)));
+
+        __m128 damage = _mm_mul_ps(base, elem);
+        damage = _mm_mul_ps(damage, def_mult);
+        damage = _mm_mul_ps(damage, crit);
+        damage = _mm_mul_ps(damage, buff);
+        damage = _mm_mul_ps(damage, var);
+
+        _mm_storeu_ps(&out_damage[i], damage);
+    }
+#endif
+
+    ComputeScalar(input, out_damage.data(), i, count);
+}
+
+} // namespace algorithm
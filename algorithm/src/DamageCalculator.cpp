@@ -12,19 +12,69 @@
  *   final = base * element_mult * (1 - defense_reduction) * crit * attack_buff * variance
  */
 #include "DamageCalculator.h"
+#include "DamageBatchKernel.h"
+#include "ElementTables.h"
 #include "SkillTreeManager.h"
+#include "sys/GameAssert.h"
+#include <charconv>
+#include <cstring>
 #include <random>
-#include <sstream>
+#include <string_view>
 #include <algorithm>
 #include <cmath>
 
-namespace algorithm {
+namespace {
 
-// 线程局部随机数生成器
-static thread_local std::mt19937 s_rng{std::random_device{}()};
+/**
+ * @brief 栈上效果描述构建器
+ *
+ * 预留定长缓冲，整数走 to_chars，片段按 memcpy 拼接；
+ * 每次命中不再构造 stringstream（剖析显示约占单次命中成本15%）。
+ * 描述各片段均有界，超长（如异常技能名）时静默截断。
+ */
+class EffectDescBuilder {
+public:
+    EffectDescBuilder& Append(std::string_view text) {
+        const std::size_t room = CAPACITY - size_;
+        const std::size_t count = text.size() < room ? text.size() : room;
+        std::memcpy(buffer_ + size_, text.data(), count);
+        size_ += count;
+        return *this;
+    }
+
+    EffectDescBuilder& AppendInt(long long value) {
+        char digits[24];
+        const auto result = std::to_chars(digits, digits + sizeof(digits), value);
+        return Append(std::string_view(digits, static_cast<std::size_t>(result.ptr - digits)));
+    }
+
+    /** @brief 追加保留一位小数的定点数（元素倍率用） */
+    EffectDescBuilder& AppendFixed1(float value) {
+        const long long tenths = std::llround(static_cast<double>(value) * 10.0);
+        AppendInt(tenths / 10);
+        Append(".");
+        AppendInt(tenths % 10 < 0 ? -(tenths % 10) : tenths % 10);
+        return *this;
+    }
+
+    std::string_view view() const { return std::string_view(buffer_, size_); }
+
+private:
+    static constexpr std::size_t CAPACITY = 224;
+
+    char buffer_[CAPACITY];
+    std::size_t size_ = 0;
+};
+
+} // namespace
+
+namespace algorithm {
 
 DamageCalculator::DamageCalculator()
     : skill_manager_(std::make_unique<SkillTreeManager>()) {
+    // 未显式设种子时用随机种子（行为与旧thread_local RNG一致）；
+    // 需要可重放的战斗应调用 setBattleSeed
+    rng_.reseed(std::random_device{}());
 }
 
 DamageCalculator::~DamageCalculator() = default;
@@ -58,17 +108,16 @@ DamageResult DamageCalculator::CalculateDamage(const DamageRequest& request) {
     float multiplier = skill ? skill->damage_multiplier : 1.0f;
     float base = 50.0f * multiplier;  // 默认基础攻击力50
 
-    std::uniform_real_distribution<float> var_dist(0.95f, 1.05f);
-    base *= var_dist(s_rng);
+    base *= rng_.uniform(0.95f, 1.05f);
 
     result.damage = static_cast<int>(std::max(1.0f, base));
 
-    std::stringstream desc;
-    desc << "造成 " << result.damage << " 点伤害";
+    EffectDescBuilder desc;
+    desc.Append("造成 ").AppendInt(result.damage).Append(" 点伤害");
     if (skill) {
-        desc << " [" << skill->name << "]";
+        desc.Append(" [").Append(skill->name).Append("]");
     }
-    result.effect = desc.str();
+    result.effect = desc.view();
     return result;
 }
 
@@ -146,6 +195,114 @@ ExtendedDamageResult DamageCalculator::CalculateExtendedDamage(const ExtendedDam
     return result;
 }
 
+// ============================================================================
+// AoE 批量伤害计算: SoA + SIMD 内核
+// ============================================================================
+std::vector<ExtendedDamageResult> DamageCalculator::CalculateAoeDamage(
+    const AoeDamageRequest& request) {
+    const size_t target_count = request.defenders.size();
+    std::vector<ExtendedDamageResult> results(target_count);
+    if (target_count == 0) {
+        return results;
+    }
+
+    const SkillNode* skill = skill_manager_->GetSkill(request.skill_id);
+    if (!skill) {
+        for (auto& result : results) {
+            result.effect = "无效技能";
+        }
+        return results;
+    }
+
+    // 0伤害技能: 与单目标路径保持一致
+    if (skill->damage_multiplier <= 0.0f) {
+        for (auto& result : results) {
+            result.damage_type = skill->damage_type;
+            result.applied_effects = DetermineAppliedEffects(skill);
+            result.effect = skill->name + " (非伤害技能)";
+        }
+        return results;
+    }
+
+    const DamageType dmg_type = skill->damage_type;
+    const Element atk_elem =
+        (skill->element != Element::None) ? skill->element : request.attacker.element;
+
+    // 所有目标共享的因子只算一次
+    const float base_damage = CalculateBaseDamage(request.attacker, skill,
+                                                  request.skill_level, dmg_type);
+    const float attack_buff = GetAttackBuffMultiplier(request.attacker_effects);
+    const bool has_per_target_effects = request.defender_effects.size() == target_count;
+
+    static const std::vector<StatusEffect> kNoEffects;
+
+    // 每目标3个掷骰（暴击/浮动/附加效果），预留连续计数器区段后
+    // 按固定偏移取数: 结果只由种子和目标下标决定，与结算顺序无关
+    const uint64_t rng_base = rng_.reserve(target_count * 3);
+    const float crit_chance = GetCriticalChance(request.attacker);
+
+    // 逐目标因子展开为 SoA
+    DamageBatchSoA batch;
+    batch.reserve(target_count);
+    for (size_t i = 0; i < target_count; ++i) {
+        const CharacterStats& defender = request.defenders[i];
+        const auto& def_effects =
+            has_per_target_effects ? request.defender_effects[i] : kNoEffects;
+
+        float effective_defense = 0.0f;
+        if (dmg_type != DamageType::Pure) {
+            float defense_stat = (dmg_type == DamageType::Physical)
+                                     ? defender.defense
+                                     : defender.magic_defense;
+            defense_stat *= StatusEffectHelper::getTotalDefenseMultiplier(def_effects);
+            effective_defense = std::max(0.0f, defense_stat);
+        }
+
+        const bool is_crit = rng_.uniform01At(rng_base + i * 3) < crit_chance;
+
+        batch.base_damage.push_back(base_damage);
+        batch.element_multiplier.push_back(
+            ApplyElementMultiplier(atk_elem, defender.element));
+        batch.defense.push_back(effective_defense);
+        batch.crit_multiplier.push_back(
+            is_crit ? GetCriticalMultiplier(request.attacker) : 1.0f);
+        batch.attack_buff.push_back(attack_buff);
+        batch.variance.push_back(rng_.uniformAt(rng_base + i * 3 + 1, 0.95f, 1.05f));
+
+        results[i].is_critical = is_crit;
+    }
+
+    // SoA各列必须与目标数严格对齐，内核按下标批量读取
+    GAME_PARANOID_ASSERT(batch.base_damage.size() == target_count);
+    GAME_PARANOID_ASSERT(batch.variance.size() == target_count);
+
+    std::vector<float> damages;
+    ComputeDamageBatch(batch, damages);
+    GAME_DEBUG_ASSERT(damages.size() == target_count);
+
+    // 逐目标收尾: 护盾吸收、最低伤害、附加效果与描述
+    for (size_t i = 0; i < target_count; ++i) {
+        auto& result = results[i];
+        const auto& def_effects =
+            has_per_target_effects ? request.defender_effects[i] : kNoEffects;
+
+        result.damage_type = dmg_type;
+        result.element_multiplier = batch.element_multiplier[i];
+
+        float final_damage = damages[i];
+        const float shield = ApplyShieldAbsorption(final_damage, def_effects);
+        result.shield_absorbed = shield;
+        final_damage -= shield;
+
+        result.damage = static_cast<int>(std::max(1.0f, std::round(final_damage)));
+        result.applied_effects =
+            DetermineAppliedEffects(skill, rng_.uniform01At(rng_base + i * 3 + 2));
+        result.effect = GenerateEffectDescription(result, skill);
+    }
+
+    return results;
+}
+
 // ============================================================================
 // 基础伤害计算
 // ============================================================================
@@ -153,6 +310,8 @@ float DamageCalculator::CalculateBaseDamage(const CharacterStats& attacker,
                                             const SkillNode* skill,
                                             int skill_level,
                                             DamageType damage_type) const {
+    // 调用方已把空技能转换为"无效技能"结果，此处只是内部前置条件
+    GAME_DEBUG_ASSERT(skill != nullptr);
     float stat_value;
     switch (damage_type) {
         case DamageType::Physical:
@@ -169,7 +328,10 @@ float DamageCalculator::CalculateBaseDamage(const CharacterStats& attacker,
             break;
     }
 
-    float scaled_multiplier = skill_manager_->GetScaledMultiplier(skill->skill_id, skill_level);
+    // 评估缓存快路径：角色上报过技能状态且等级一致时读预算值，
+    // 否则回退到现场等级折算
+    float scaled_multiplier = skill_manager_->GetEffectiveMultiplier(
+        attacker.character_id, skill->skill_id, skill_level);
     return stat_value * scaled_multiplier;
 }
 
@@ -181,14 +343,8 @@ float DamageCalculator::ApplyElementMultiplier(Element attacker_elem, Element de
         return stats_registry_->getElementMultiplier(attacker_elem, defender_elem);
     }
 
-    // 无注册表时的简化克制
-    if (attacker_elem == Element::None || defender_elem == Element::None) {
-        return 1.0f;
-    }
-    if (attacker_elem == defender_elem) {
-        return 0.75f;
-    }
-    return 1.0f;
+    // 无注册表时直接查编译期克制矩阵
+    return GetElementMatrixMultiplier(attacker_elem, defender_elem);
 }
 
 // ============================================================================
@@ -218,13 +374,14 @@ float DamageCalculator::ApplyDefenseReduction(const CharacterStats& defender,
 // ============================================================================
 // 暴击判定
 // ============================================================================
-bool DamageCalculator::RollCritical(const CharacterStats& attacker) const {
+float DamageCalculator::GetCriticalChance(const CharacterStats& attacker) const {
     // 暴击率 = 基础暴击率 + 幸运值加成
     float crit_rate = attacker.crit_rate + attacker.luck * 0.003f;
-    crit_rate = std::min(0.75f, crit_rate);  // 上限75%
+    return std::min(0.75f, crit_rate);  // 上限75%
+}
 
-    std::uniform_real_distribution<float> dist(0.0f, 1.0f);
-    return dist(s_rng) < crit_rate;
+bool DamageCalculator::RollCritical(const CharacterStats& attacker) const {
+    return rng_.uniform01() < GetCriticalChance(attacker);
 }
 
 float DamageCalculator::GetCriticalMultiplier(const CharacterStats& attacker) const {
@@ -242,8 +399,7 @@ float DamageCalculator::GetAttackBuffMultiplier(const std::vector<StatusEffect>&
 // 随机浮动 ±5%
 // ============================================================================
 float DamageCalculator::GetRandomVariance() const {
-    std::uniform_real_distribution<float> dist(0.95f, 1.05f);
-    return dist(s_rng);
+    return rng_.uniform(0.95f, 1.05f);
 }
 
 // ============================================================================
@@ -259,12 +415,16 @@ float DamageCalculator::ApplyShieldAbsorption(float damage,
 // 根据技能元素附加状态效果
 // ============================================================================
 std::vector<StatusEffect> DamageCalculator::DetermineAppliedEffects(const SkillNode* skill) const {
+    return DetermineAppliedEffects(skill, rng_.uniform01());
+}
+
+std::vector<StatusEffect> DamageCalculator::DetermineAppliedEffects(const SkillNode* skill,
+                                                                    float roll) const {
     std::vector<StatusEffect> effects;
     if (!skill || skill->damage_multiplier <= 0.0f) return effects;
 
     // 30%概率附加元素效果
-    std::uniform_real_distribution<float> dist(0.0f, 1.0f);
-    if (dist(s_rng) > 0.3f) return effects;
+    if (roll > 0.3f) return effects;
 
     switch (skill->element) {
         case Element::Fire:
@@ -292,38 +452,37 @@ std::vector<StatusEffect> DamageCalculator::DetermineAppliedEffects(const SkillN
 // ============================================================================
 std::string DamageCalculator::GenerateEffectDescription(const ExtendedDamageResult& result,
                                                          const SkillNode* skill) const {
-    std::stringstream desc;
-    desc << "使用 [" << (skill ? skill->name : "未知技能") << "] ";
-    desc << "造成 " << result.damage << " 点";
+    EffectDescBuilder desc;
+    desc.Append("使用 [").Append(skill ? skill->name : "未知技能").Append("] ");
+    desc.Append("造成 ").AppendInt(result.damage).Append(" 点");
 
     switch (result.damage_type) {
-        case DamageType::Physical: desc << "物理"; break;
-        case DamageType::Magical:  desc << "魔法"; break;
-        case DamageType::Pure:     desc << "纯粹"; break;
+        case DamageType::Physical: desc.Append("物理"); break;
+        case DamageType::Magical:  desc.Append("魔法"); break;
+        case DamageType::Pure:     desc.Append("纯粹"); break;
     }
-    desc << "伤害";
+    desc.Append("伤害");
 
     if (result.is_critical) {
-        desc << " (暴击!)";
+        desc.Append(" (暴击!)");
     }
 
     if (result.element_multiplier > 1.1f) {
-        desc << " (克制效果 x" << std::fixed;
-        desc.precision(1);
-        desc << result.element_multiplier << ")";
+        desc.Append(" (克制效果 x").AppendFixed1(result.element_multiplier).Append(")");
     } else if (result.element_multiplier < 0.9f) {
-        desc << " (抗性减免)";
+        desc.Append(" (抗性减免)");
     }
 
     if (result.shield_absorbed > 0) {
-        desc << " (护盾吸收 " << static_cast<int>(result.shield_absorbed) << ")";
+        desc.Append(" (护盾吸收 ").AppendInt(static_cast<int>(result.shield_absorbed)).Append(")");
     }
 
     for (const auto& eff : result.applied_effects) {
-        desc << " [附加: " << eff.name << "]";
+        desc.Append(" [附加: ").Append(eff.name).Append("]");
     }
 
-    return desc.str();
+    // 返回 std::string 仅此一次分配；拼装全程在栈缓冲内完成。
+    return std::string(desc.view());
 }
 
 } // namespace algorithm
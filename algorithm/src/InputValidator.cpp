@@ -7,11 +7,129 @@
 
 #include "InputValidator.h"
 #include "SkillTreeManager.h"
+#include "ValidatedString.h"
+#include <algorithm>
+#include <charconv>
 #include <sstream>
 
 namespace algorithm {
 
-InputValidator::InputValidator() = default;
+namespace {
+
+// 已知字段的校验规则定义（构造时编译为按首字符分桶的跳转表）
+constexpr float MAX_ID_VALUE = 100000.0f;
+constexpr float MAX_FIELD_STAT_VALUE = 99999.0f;
+
+} // namespace
+
+InputValidator::InputValidator() {
+    compileFieldRules();
+}
+
+void InputValidator::compileFieldRules() {
+    compiled_rules_ = {
+        {"attacker_id", FieldRule::IntRange, 0.0f, MAX_ID_VALUE},
+        {"character_id", FieldRule::IntRange, 0.0f, MAX_ID_VALUE},
+        {"chat_line", FieldRule::ChatLine, 0.0f, 0.0f},
+        {"crit_damage", FieldRule::FloatRange, 0.0f, 10.0f},
+        {"crit_rate", FieldRule::FloatRange, 0.0f, 1.0f},
+        {"defender_id", FieldRule::IntRange, 0.0f, MAX_ID_VALUE},
+        {"hp", FieldRule::FloatRange, 0.0f, MAX_FIELD_STAT_VALUE},
+        {"level", FieldRule::IntRange, 1.0f, 100.0f},
+        {"message", FieldRule::ChatLine, 0.0f, 0.0f},
+        {"mp", FieldRule::FloatRange, 0.0f, MAX_FIELD_STAT_VALUE},
+        {"name", FieldRule::PlayerName, 0.0f, 0.0f},
+        {"npc_id", FieldRule::IntRange, 0.0f, MAX_ID_VALUE},
+        {"player_name", FieldRule::PlayerName, 0.0f, 0.0f},
+        {"skill_id", FieldRule::IntRange, 0.0f, 10000.0f},
+        {"skill_level", FieldRule::IntRange, 1.0f, 10.0f},
+    };
+
+    // 按首字符分桶: 规则已按名排序，同首字符的规则相邻
+    std::sort(compiled_rules_.begin(), compiled_rules_.end(),
+              [](const RuleSpec& a, const RuleSpec& b) { return a.name < b.name; });
+
+    rule_buckets_.fill(RuleBucket{});
+    for (size_t i = 0; i < compiled_rules_.size(); ++i) {
+        auto head = static_cast<unsigned char>(compiled_rules_[i].name.front());
+        RuleBucket& bucket = rule_buckets_[head];
+        if (bucket.count == 0) {
+            bucket.begin = static_cast<uint16_t>(i);
+        }
+        ++bucket.count;
+    }
+}
+
+ValidationResult InputValidator::validateField(std::string_view field_name,
+                                               std::string_view value) const {
+    if (field_name.empty()) {
+        return ValidationResult::fail("字段名不能为空");
+    }
+    if (value.empty()) {
+        return ValidationResult::fail(
+            "字段不能为空: " + std::string(field_name));
+    }
+
+    // 跳转表分发: 首字符定桶，桶内按名精确匹配（桶内通常1-3条）
+    const RuleSpec* spec = nullptr;
+    const RuleBucket& bucket =
+        rule_buckets_[static_cast<unsigned char>(field_name.front())];
+    for (uint16_t i = 0; i < bucket.count; ++i) {
+        const RuleSpec& candidate = compiled_rules_[bucket.begin + i];
+        if (candidate.name == field_name) {
+            spec = &candidate;
+            break;
+        }
+    }
+
+    // 未知字段: 仅要求非空（上面已通过）
+    if (spec == nullptr || spec->rule == FieldRule::NonEmpty) {
+        return ValidationResult::ok();
+    }
+
+    // 用户字符串走校验后类型的查表字节分类路径
+    if (spec->rule == FieldRule::PlayerName) {
+        return PlayerName::Validate(value);
+    }
+    if (spec->rule == FieldRule::ChatLine) {
+        return ChatLine::Validate(value);
+    }
+
+    float parsed = 0.0f;
+    if (spec->rule == FieldRule::IntRange) {
+        int int_value = 0;
+        auto [ptr, ec] = std::from_chars(
+            value.data(), value.data() + value.size(), int_value);
+        if (ec != std::errc{} || ptr != value.data() + value.size()) {
+            return ValidationResult::fail(
+                "字段应为整数: " + std::string(field_name));
+        }
+        parsed = static_cast<float>(int_value);
+    } else {
+        auto [ptr, ec] = std::from_chars(
+            value.data(), value.data() + value.size(), parsed);
+        if (ec != std::errc{} || ptr != value.data() + value.size()) {
+            return ValidationResult::fail(
+                "字段应为数值: " + std::string(field_name));
+        }
+    }
+
+    if (parsed < spec->min_value || parsed > spec->max_value) {
+        return ValidationResult::fail(
+            "字段超出范围: " + std::string(field_name));
+    }
+    return ValidationResult::ok();
+}
+
+std::vector<ValidationResult> InputValidator::validateFields(
+    std::span<const std::pair<std::string, std::string>> fields) const {
+    std::vector<ValidationResult> results;
+    results.reserve(fields.size());
+    for (const auto& [name, value] : fields) {
+        results.push_back(validateField(name, value));
+    }
+    return results;
+}
 
 ValidationResult InputValidator::validateDamageRequest(
     const DamageRequest& request,
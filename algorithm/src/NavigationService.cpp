@@ -0,0 +1,496 @@
+/*
+ * 文件名: NavigationService.cpp
+ * 说明: 导航服务实现（分块区域图 + 走廊A* + 区域路径LRU缓存）
+ * 作者: 彭承康
+ * 创建时间: 2026-08-28
+ */
+#include "NavigationService.h"
+#include "sys/GameAssert.h"
+#include <algorithm>
+#include <cstdlib>
+#include <limits>
+#include <queue>
+#include <utility>
+
+namespace algorithm {
+
+namespace {
+
+// 4邻接偏移: 上、下、左、右
+constexpr int DX[4] = {0, 0, -1, 1};
+constexpr int DY[4] = {-1, 1, 0, 0};
+
+int ManhattanDistance(GridPoint a, GridPoint b) {
+    return std::abs(a.x - b.x) + std::abs(a.y - b.y);
+}
+
+} // namespace
+
+// ============================================================================
+// 地图注册与预处理
+// ============================================================================
+bool NavigationService::RegisterMap(int map_id, int width, int height,
+                                    std::span<const uint8_t> walkable) {
+    if (width <= 0 || height <= 0 ||
+        walkable.size() != static_cast<size_t>(width) * static_cast<size_t>(height)) {
+        return false;
+    }
+
+    MapNav nav;
+    nav.width = width;
+    nav.height = height;
+    nav.walkable.assign(walkable.begin(), walkable.end());
+    BuildRegions(nav);
+    BuildComponents(nav);
+
+    {
+        std::unique_lock lock(maps_mutex_);
+        maps_[map_id] = std::move(nav);
+    }
+    {
+        // 重新注册后旧区域号失去意义，整图缓存作废
+        std::lock_guard<std::mutex> lock(cache_mutex_);
+        InvalidateMapCacheLocked(map_id);
+    }
+    return true;
+}
+
+void NavigationService::UnregisterMap(int map_id) {
+    {
+        std::unique_lock lock(maps_mutex_);
+        maps_.erase(map_id);
+    }
+    std::lock_guard<std::mutex> lock(cache_mutex_);
+    InvalidateMapCacheLocked(map_id);
+}
+
+void NavigationService::BuildRegions(MapNav& nav) {
+    const size_t cell_count =
+        static_cast<size_t>(nav.width) * static_cast<size_t>(nav.height);
+    nav.region_of.assign(cell_count, -1);
+    nav.region_count = 0;
+
+    // 逐块洪泛: 块内连通的可行走格聚成一个区域，
+    // 同块内互不连通的部分各成区域（如被墙分隔的走廊两侧）
+    std::vector<size_t> stack;
+    for (int block_y = 0; block_y < nav.height; block_y += REGION_SIZE) {
+        for (int block_x = 0; block_x < nav.width; block_x += REGION_SIZE) {
+            const int x_end = std::min(block_x + REGION_SIZE, nav.width);
+            const int y_end = std::min(block_y + REGION_SIZE, nav.height);
+
+            for (int y = block_y; y < y_end; ++y) {
+                for (int x = block_x; x < x_end; ++x) {
+                    const size_t index = static_cast<size_t>(y) *
+                                         static_cast<size_t>(nav.width) +
+                                         static_cast<size_t>(x);
+                    if (nav.walkable[index] == 0 || nav.region_of[index] >= 0) {
+                        continue;
+                    }
+
+                    const int32_t region = nav.region_count++;
+                    stack.clear();
+                    stack.push_back(index);
+                    nav.region_of[index] = region;
+
+                    while (!stack.empty()) {
+                        const size_t current = stack.back();
+                        stack.pop_back();
+                        const int cx = static_cast<int>(current %
+                                                        static_cast<size_t>(nav.width));
+                        const int cy = static_cast<int>(current /
+                                                        static_cast<size_t>(nav.width));
+                        for (int dir = 0; dir < 4; ++dir) {
+                            const int nx = cx + DX[dir];
+                            const int ny = cy + DY[dir];
+                            if (nx < block_x || nx >= x_end ||
+                                ny < block_y || ny >= y_end) {
+                                continue;
+                            }
+                            const size_t next = static_cast<size_t>(ny) *
+                                                static_cast<size_t>(nav.width) +
+                                                static_cast<size_t>(nx);
+                            if (nav.walkable[next] != 0 && nav.region_of[next] < 0) {
+                                nav.region_of[next] = region;
+                                stack.push_back(next);
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    // 邻接表: 扫一遍右邻与下邻即可覆盖全部跨区域边，去重后定型
+    std::vector<std::pair<int32_t, int32_t>> edges;
+    for (int y = 0; y < nav.height; ++y) {
+        for (int x = 0; x < nav.width; ++x) {
+            const size_t index = static_cast<size_t>(y) *
+                                 static_cast<size_t>(nav.width) +
+                                 static_cast<size_t>(x);
+            const int32_t region = nav.region_of[index];
+            if (region < 0) {
+                continue;
+            }
+            if (x + 1 < nav.width) {
+                const int32_t right = nav.region_of[index + 1];
+                if (right >= 0 && right != region) {
+                    edges.emplace_back(std::min(region, right),
+                                       std::max(region, right));
+                }
+            }
+            if (y + 1 < nav.height) {
+                const int32_t below =
+                    nav.region_of[index + static_cast<size_t>(nav.width)];
+                if (below >= 0 && below != region) {
+                    edges.emplace_back(std::min(region, below),
+                                       std::max(region, below));
+                }
+            }
+        }
+    }
+    std::sort(edges.begin(), edges.end());
+    edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+
+    nav.region_neighbors.assign(static_cast<size_t>(nav.region_count), {});
+    for (const auto& [a, b] : edges) {
+        nav.region_neighbors[static_cast<size_t>(a)].push_back(b);
+        nav.region_neighbors[static_cast<size_t>(b)].push_back(a);
+    }
+}
+
+void NavigationService::BuildComponents(MapNav& nav) {
+    nav.region_component.assign(static_cast<size_t>(nav.region_count), -1);
+    int32_t component = 0;
+    std::vector<int32_t> stack;
+
+    for (int32_t region = 0; region < nav.region_count; ++region) {
+        if (nav.region_component[static_cast<size_t>(region)] >= 0) {
+            continue;
+        }
+        stack.clear();
+        stack.push_back(region);
+        nav.region_component[static_cast<size_t>(region)] = component;
+        while (!stack.empty()) {
+            const int32_t current = stack.back();
+            stack.pop_back();
+            for (const int32_t next : nav.region_neighbors[static_cast<size_t>(current)]) {
+                if (nav.region_component[static_cast<size_t>(next)] < 0) {
+                    nav.region_component[static_cast<size_t>(next)] = component;
+                    stack.push_back(next);
+                }
+            }
+        }
+        ++component;
+    }
+}
+
+// ============================================================================
+// 查询
+// ============================================================================
+bool NavigationService::InBounds(const MapNav& nav, GridPoint point) {
+    return point.x >= 0 && point.x < nav.width &&
+           point.y >= 0 && point.y < nav.height;
+}
+
+size_t NavigationService::CellIndex(const MapNav& nav, GridPoint point) {
+    return static_cast<size_t>(point.y) * static_cast<size_t>(nav.width) +
+           static_cast<size_t>(point.x);
+}
+
+bool NavigationService::IsWalkable(int map_id, GridPoint point) const {
+    std::shared_lock lock(maps_mutex_);
+    const auto it = maps_.find(map_id);
+    if (it == maps_.end() || !InBounds(it->second, point)) {
+        return false;
+    }
+    return it->second.walkable[CellIndex(it->second, point)] != 0;
+}
+
+bool NavigationService::IsReachable(int map_id, GridPoint from, GridPoint to) const {
+    std::shared_lock lock(maps_mutex_);
+    const auto it = maps_.find(map_id);
+    if (it == maps_.end()) {
+        return false;
+    }
+    const MapNav& nav = it->second;
+    if (!InBounds(nav, from) || !InBounds(nav, to)) {
+        return false;
+    }
+    const int32_t from_region = nav.region_of[CellIndex(nav, from)];
+    const int32_t to_region = nav.region_of[CellIndex(nav, to)];
+    if (from_region < 0 || to_region < 0) {
+        return false;
+    }
+    return nav.region_component[static_cast<size_t>(from_region)] ==
+           nav.region_component[static_cast<size_t>(to_region)];
+}
+
+PathResult NavigationService::FindPath(const PathQuery& query) {
+    std::shared_lock lock(maps_mutex_);
+    const auto it = maps_.find(query.map_id);
+    if (it == maps_.end()) {
+        return PathResult{};
+    }
+    return FindPathLocked(it->second, query);
+}
+
+std::vector<PathResult> NavigationService::FindPathsBatch(
+    std::span<const PathQuery> queries) {
+    std::vector<PathResult> results;
+    results.reserve(queries.size());
+
+    // 整批共享一次读锁，批内不与注册/注销交错
+    std::shared_lock lock(maps_mutex_);
+    for (const PathQuery& query : queries) {
+        const auto it = maps_.find(query.map_id);
+        if (it == maps_.end()) {
+            results.emplace_back();
+            continue;
+        }
+        results.push_back(FindPathLocked(it->second, query));
+    }
+    return results;
+}
+
+PathResult NavigationService::FindPathLocked(const MapNav& nav,
+                                             const PathQuery& query) {
+    PathResult result;
+    if (!InBounds(nav, query.start) || !InBounds(nav, query.goal)) {
+        return result;
+    }
+    const int32_t start_region = nav.region_of[CellIndex(nav, query.start)];
+    const int32_t goal_region = nav.region_of[CellIndex(nav, query.goal)];
+    if (start_region < 0 || goal_region < 0) {
+        return result;
+    }
+    // 分量不同直接拒绝，不付任何搜索成本
+    if (nav.region_component[static_cast<size_t>(start_region)] !=
+        nav.region_component[static_cast<size_t>(goal_region)]) {
+        return result;
+    }
+
+    if (query.start.x == query.goal.x && query.start.y == query.goal.y) {
+        result.reachable = true;
+        result.waypoints.push_back(query.start);
+        return result;
+    }
+
+    // 区域级路径: 同区域免搜索，跨区域先查LRU缓存再BFS回填
+    std::vector<uint8_t> corridor(static_cast<size_t>(nav.region_count), 0);
+    if (start_region == goal_region) {
+        corridor[static_cast<size_t>(start_region)] = 1;
+    } else {
+        const uint64_t key = CacheKey(query.map_id, start_region, goal_region);
+        std::vector<int32_t> regions;
+        if (LookupCachedRegionPath(key, regions)) {
+            result.from_cache = true;
+        } else {
+            regions = SearchRegionPath(nav, start_region, goal_region);
+            GAME_DEBUG_ASSERT(!regions.empty());
+            StoreCachedRegionPath(key, regions);
+        }
+        for (const int32_t region : regions) {
+            corridor[static_cast<size_t>(region)] = 1;
+        }
+    }
+
+    std::vector<GridPoint> cells =
+        RefinePath(nav, query.start, query.goal, corridor);
+    if (cells.empty()) {
+        return result;
+    }
+    result.reachable = true;
+    result.waypoints = CompressWaypoints(std::move(cells));
+    return result;
+}
+
+std::vector<int32_t> NavigationService::SearchRegionPath(const MapNav& nav,
+                                                         int32_t from, int32_t to) {
+    std::vector<int32_t> parent(static_cast<size_t>(nav.region_count), -1);
+    std::queue<int32_t> frontier;
+    parent[static_cast<size_t>(from)] = from;
+    frontier.push(from);
+
+    while (!frontier.empty()) {
+        const int32_t current = frontier.front();
+        frontier.pop();
+        if (current == to) {
+            break;
+        }
+        for (const int32_t next : nav.region_neighbors[static_cast<size_t>(current)]) {
+            if (parent[static_cast<size_t>(next)] < 0) {
+                parent[static_cast<size_t>(next)] = current;
+                frontier.push(next);
+            }
+        }
+    }
+
+    if (parent[static_cast<size_t>(to)] < 0) {
+        return {};
+    }
+    std::vector<int32_t> path;
+    for (int32_t current = to; current != from;
+         current = parent[static_cast<size_t>(current)]) {
+        path.push_back(current);
+    }
+    path.push_back(from);
+    std::reverse(path.begin(), path.end());
+    return path;
+}
+
+std::vector<GridPoint> NavigationService::RefinePath(
+    const MapNav& nav, GridPoint start, GridPoint goal,
+    const std::vector<uint8_t>& corridor) {
+    const size_t cell_count =
+        static_cast<size_t>(nav.width) * static_cast<size_t>(nav.height);
+    constexpr int32_t UNVISITED = std::numeric_limits<int32_t>::max();
+    std::vector<int32_t> g_cost(cell_count, UNVISITED);
+    std::vector<int32_t> parent(cell_count, -1);
+
+    // (f值, 格下标) 最小堆; 过期条目靠g值比对跳过
+    using OpenEntry = std::pair<int32_t, int32_t>;
+    std::priority_queue<OpenEntry, std::vector<OpenEntry>, std::greater<OpenEntry>> open;
+
+    const size_t start_index = CellIndex(nav, start);
+    const size_t goal_index = CellIndex(nav, goal);
+    g_cost[start_index] = 0;
+    open.emplace(ManhattanDistance(start, goal), static_cast<int32_t>(start_index));
+
+    while (!open.empty()) {
+        const auto [f_value, index] = open.top();
+        open.pop();
+        const size_t current = static_cast<size_t>(index);
+        if (current == goal_index) {
+            break;
+        }
+        const int cx = static_cast<int>(current % static_cast<size_t>(nav.width));
+        const int cy = static_cast<int>(current / static_cast<size_t>(nav.width));
+        const int32_t current_g = g_cost[current];
+        // 走廊内曼哈顿启发是一致的，g只会被赋值一次，f偏大即过期
+        if (f_value - ManhattanDistance({cx, cy}, goal) > current_g) {
+            continue;
+        }
+
+        for (int dir = 0; dir < 4; ++dir) {
+            const GridPoint next_point{cx + DX[dir], cy + DY[dir]};
+            if (!InBounds(nav, next_point)) {
+                continue;
+            }
+            const size_t next = CellIndex(nav, next_point);
+            const int32_t region = nav.region_of[next];
+            // 只在走廊区域内展开，搜索空间与区域路径长度成正比
+            if (region < 0 || corridor[static_cast<size_t>(region)] == 0) {
+                continue;
+            }
+            if (current_g + 1 < g_cost[next]) {
+                g_cost[next] = current_g + 1;
+                parent[next] = static_cast<int32_t>(current);
+                open.emplace(current_g + 1 + ManhattanDistance(next_point, goal),
+                             static_cast<int32_t>(next));
+            }
+        }
+    }
+
+    if (g_cost[goal_index] == UNVISITED) {
+        return {};
+    }
+
+    std::vector<GridPoint> cells;
+    for (int32_t current = static_cast<int32_t>(goal_index); current >= 0;
+         current = parent[static_cast<size_t>(current)]) {
+        const size_t index = static_cast<size_t>(current);
+        cells.push_back(GridPoint{
+            static_cast<int>(index % static_cast<size_t>(nav.width)),
+            static_cast<int>(index / static_cast<size_t>(nav.width))});
+        if (index == start_index) {
+            break;
+        }
+    }
+    std::reverse(cells.begin(), cells.end());
+    return cells;
+}
+
+std::vector<GridPoint> NavigationService::CompressWaypoints(
+    std::vector<GridPoint> cells) {
+    if (cells.size() <= 2) {
+        return cells;
+    }
+    std::vector<GridPoint> waypoints;
+    waypoints.push_back(cells.front());
+    for (size_t i = 1; i + 1 < cells.size(); ++i) {
+        const int dx_in = cells[i].x - cells[i - 1].x;
+        const int dy_in = cells[i].y - cells[i - 1].y;
+        const int dx_out = cells[i + 1].x - cells[i].x;
+        const int dy_out = cells[i + 1].y - cells[i].y;
+        if (dx_in != dx_out || dy_in != dy_out) {
+            waypoints.push_back(cells[i]);
+        }
+    }
+    waypoints.push_back(cells.back());
+    return waypoints;
+}
+
+// ============================================================================
+// 区域路径LRU缓存
+// ============================================================================
+uint64_t NavigationService::CacheKey(int map_id, int32_t from_region,
+                                     int32_t to_region) {
+    return (static_cast<uint64_t>(static_cast<uint32_t>(map_id)) << 48) |
+           ((static_cast<uint64_t>(static_cast<uint32_t>(from_region)) & 0xFFFFFF) << 24) |
+           (static_cast<uint64_t>(static_cast<uint32_t>(to_region)) & 0xFFFFFF);
+}
+
+bool NavigationService::LookupCachedRegionPath(uint64_t key,
+                                               std::vector<int32_t>& regions) {
+    std::lock_guard<std::mutex> lock(cache_mutex_);
+    const auto it = path_cache_.find(key);
+    if (it == path_cache_.end()) {
+        ++cache_misses_;
+        return false;
+    }
+    ++cache_hits_;
+    lru_order_.splice(lru_order_.begin(), lru_order_, it->second.lru_it);
+    regions = it->second.regions;
+    return true;
+}
+
+void NavigationService::StoreCachedRegionPath(uint64_t key,
+                                              const std::vector<int32_t>& regions) {
+    std::lock_guard<std::mutex> lock(cache_mutex_);
+    const auto it = path_cache_.find(key);
+    if (it != path_cache_.end()) {
+        it->second.regions = regions;
+        lru_order_.splice(lru_order_.begin(), lru_order_, it->second.lru_it);
+        return;
+    }
+    if (path_cache_.size() >= PATH_CACHE_MAX_ENTRIES) {
+        path_cache_.erase(lru_order_.back());
+        lru_order_.pop_back();
+    }
+    lru_order_.push_front(key);
+    path_cache_.emplace(key, CachedRegionPath{regions, lru_order_.begin()});
+}
+
+void NavigationService::InvalidateMapCacheLocked(int map_id) {
+    const uint64_t map_prefix =
+        static_cast<uint64_t>(static_cast<uint32_t>(map_id)) << 48;
+    for (auto it = path_cache_.begin(); it != path_cache_.end();) {
+        if ((it->first >> 48) == (map_prefix >> 48)) {
+            lru_order_.erase(it->second.lru_it);
+            it = path_cache_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+NavigationService::PathCacheStats NavigationService::GetPathCacheStats() const {
+    std::lock_guard<std::mutex> lock(cache_mutex_);
+    PathCacheStats stats;
+    stats.entries = path_cache_.size();
+    stats.hits = cache_hits_;
+    stats.misses = cache_misses_;
+    return stats;
+}
+
+} // namespace algorithm
@@ -7,25 +7,211 @@
  */
 
 #include "SkillTreeManager.h"
+#include "ElementTables.h"
 #include <algorithm>
 #include <cmath>
+#include <cstring>
 
 namespace algorithm {
 
 SkillTreeManager::SkillTreeManager() {
     InitializeDefaultSkills();
+    // 默认技能加载完成后即冻结，战斗期查询走连续数组
+    FreezeTree();
 }
 
 const SkillNode* SkillTreeManager::GetSkill(int skill_id) const {
+    if (frozen_) {
+        // 冻结态: ID直接下标，O(1)且无哈希探测
+        if (skill_id < 0 || static_cast<size_t>(skill_id) >= id_to_index_.size()) {
+            return nullptr;
+        }
+        int32_t index = id_to_index_[static_cast<size_t>(skill_id)];
+        return index >= 0 ? &frozen_skills_[static_cast<size_t>(index)] : nullptr;
+    }
+
     auto it = skills_.find(skill_id);
     return it != skills_.end() ? &it->second : nullptr;
 }
 
 void SkillTreeManager::AddSkill(const SkillNode& skill) {
     skills_[skill.skill_id] = skill;
+    // 技能集合变化使冻结索引失效，下次 FreezeTree 重建
+    frozen_ = false;
+    ++tree_version_;
+}
+
+void SkillTreeManager::FreezeTree() {
+    // 按ID升序收集，保证冻结数组布局稳定
+    std::vector<int> ids;
+    ids.reserve(skills_.size());
+    int max_id = 0;
+    for (const auto& [id, skill] : skills_) {
+        ids.push_back(id);
+        max_id = std::max(max_id, id);
+    }
+    std::sort(ids.begin(), ids.end());
+
+    frozen_skills_.clear();
+    frozen_skills_.reserve(ids.size());
+    frozen_prereqs_.clear();
+    frozen_prereqs_.reserve(ids.size());
+    frozen_prereq_ids_.clear();
+    id_to_index_.assign(static_cast<size_t>(max_id) + 1, -1);
+
+    for (int id : ids) {
+        const SkillNode& skill = skills_.at(id);
+        id_to_index_[static_cast<size_t>(id)] =
+            static_cast<int32_t>(frozen_skills_.size());
+
+        PrereqRange range;
+        range.begin = static_cast<uint32_t>(frozen_prereq_ids_.size());
+        range.count = static_cast<uint32_t>(skill.prerequisites.size());
+        frozen_prereq_ids_.insert(frozen_prereq_ids_.end(),
+                                  skill.prerequisites.begin(),
+                                  skill.prerequisites.end());
+        frozen_prereqs_.push_back(range);
+
+        frozen_skills_.push_back(skill);
+    }
+
+    // 传递前置闭包位集：技能界面每帧逐节点问"能否解锁"，
+    // 这里把每条前置链一次性展开，之后整树可解锁性退化为
+    // 每技能几次字与运算（见IsSkillUnlockable）
+    closure_words_ = (frozen_skills_.size() + 63) / 64;
+    frozen_closure_.assign(frozen_skills_.size() * closure_words_, 0);
+    std::vector<uint8_t> state(frozen_skills_.size(), 0);
+    for (size_t i = 0; i < frozen_skills_.size(); ++i) {
+        ExpandClosure(i, state);
+    }
+
+    frozen_ = true;
+}
+
+void SkillTreeManager::ExpandClosure(size_t index, std::vector<uint8_t>& state) {
+    // 访问中(1)说明前置数据成环，直接返回打断递归；
+    // 已完成(2)的闭包可以直接合并
+    if (state[index] != 0) {
+        return;
+    }
+    state[index] = 1;
+
+    uint64_t* bits = frozen_closure_.data() + index * closure_words_;
+    const PrereqRange& range = frozen_prereqs_[index];
+    for (uint32_t i = 0; i < range.count; ++i) {
+        const int prereq_id = frozen_prereq_ids_[range.begin + i];
+        if (prereq_id < 0 ||
+            static_cast<size_t>(prereq_id) >= id_to_index_.size()) {
+            continue;  // 悬空前置边（指向不存在的技能），闭包中忽略
+        }
+        const int32_t prereq_index = id_to_index_[static_cast<size_t>(prereq_id)];
+        if (prereq_index < 0) {
+            continue;
+        }
+
+        const size_t prereq = static_cast<size_t>(prereq_index);
+        ExpandClosure(prereq, state);
+
+        // 闭包 = 直接前置位 ∪ 各前置自身的闭包
+        bits[prereq / 64] |= uint64_t{1} << (prereq % 64);
+        const uint64_t* prereq_bits = frozen_closure_.data() + prereq * closure_words_;
+        for (size_t word = 0; word < closure_words_; ++word) {
+            bits[word] |= prereq_bits[word];
+        }
+    }
+
+    state[index] = 2;
+}
+
+std::vector<uint64_t> SkillTreeManager::BuildLearnedBitset(
+    const std::vector<int>& learned_skills) const {
+    std::vector<uint64_t> bits(frozen_ ? closure_words_ : 0, 0);
+    if (!frozen_) {
+        return bits;
+    }
+    for (int id : learned_skills) {
+        if (id < 0 || static_cast<size_t>(id) >= id_to_index_.size()) {
+            continue;
+        }
+        const int32_t index = id_to_index_[static_cast<size_t>(id)];
+        if (index < 0) {
+            continue;
+        }
+        const size_t pos = static_cast<size_t>(index);
+        bits[pos / 64] |= uint64_t{1} << (pos % 64);
+    }
+    return bits;
+}
+
+bool SkillTreeManager::ClosureSatisfied(
+    size_t index, const std::vector<uint64_t>& learned_bits) const {
+    const uint64_t* closure = frozen_closure_.data() + index * closure_words_;
+    for (size_t word = 0; word < closure_words_; ++word) {
+        if ((closure[word] & learned_bits[word]) != closure[word]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool SkillTreeManager::IsSkillUnlockable(
+    int skill_id, const std::vector<uint64_t>& learned_bits) const {
+    if (!frozen_ || learned_bits.size() != closure_words_) {
+        return false;
+    }
+    if (skill_id < 0 || static_cast<size_t>(skill_id) >= id_to_index_.size()) {
+        return false;
+    }
+    const int32_t index = id_to_index_[static_cast<size_t>(skill_id)];
+    if (index < 0) {
+        return false;
+    }
+    return ClosureSatisfied(static_cast<size_t>(index), learned_bits);
+}
+
+std::vector<uint8_t> SkillTreeManager::EvaluateUnlockability(
+    const std::vector<int>& learned_skills) const {
+    std::vector<uint8_t> result;
+
+    if (!frozen_) {
+        // 未冻结回退：逐技能走前置链推导
+        const std::vector<const SkillNode*> all_skills = GetAllSkills();
+        result.reserve(all_skills.size());
+        for (const SkillNode* skill : all_skills) {
+            result.push_back(
+                CanLearnSkill(skill->skill_id, learned_skills) ? 1 : 0);
+        }
+        return result;
+    }
+
+    // 已学列表折算一次位集，整棵树的查询共享它
+    const std::vector<uint64_t> learned_bits = BuildLearnedBitset(learned_skills);
+    result.reserve(frozen_skills_.size());
+    for (size_t index = 0; index < frozen_skills_.size(); ++index) {
+        result.push_back(ClosureSatisfied(index, learned_bits) ? 1 : 0);
+    }
+    return result;
 }
 
 bool SkillTreeManager::CanLearnSkill(int skill_id, const std::vector<int>& learned_skills) const {
+    if (frozen_) {
+        const SkillNode* skill = GetSkill(skill_id);
+        if (!skill) return false;
+
+        // 冻结态: 前置边从平铺区间读取，缓存友好
+        size_t index = static_cast<size_t>(
+            id_to_index_[static_cast<size_t>(skill_id)]);
+        const PrereqRange& range = frozen_prereqs_[index];
+        for (uint32_t i = 0; i < range.count; ++i) {
+            int prereq = frozen_prereq_ids_[range.begin + i];
+            if (std::find(learned_skills.begin(), learned_skills.end(), prereq) ==
+                learned_skills.end()) {
+                return false;
+            }
+        }
+        return true;
+    }
+
     const SkillNode* skill = GetSkill(skill_id);
     if (!skill) return false;
 
@@ -39,6 +225,15 @@ bool SkillTreeManager::CanLearnSkill(int skill_id, const std::vector<int>& learn
 
 std::vector<const SkillNode*> SkillTreeManager::GetSkillsByProfession(Profession profession) const {
     std::vector<const SkillNode*> result;
+    if (frozen_) {
+        // 冻结态顺序遍历连续数组，结果天然按ID升序
+        for (const auto& skill : frozen_skills_) {
+            if (skill.profession == profession || skill.profession == Profession::None) {
+                result.push_back(&skill);
+            }
+        }
+        return result;
+    }
     for (const auto& [id, skill] : skills_) {
         if (skill.profession == profession || skill.profession == Profession::None) {
             result.push_back(&skill);
@@ -49,6 +244,13 @@ std::vector<const SkillNode*> SkillTreeManager::GetSkillsByProfession(Profession
 
 std::vector<const SkillNode*> SkillTreeManager::GetAllSkills() const {
     std::vector<const SkillNode*> result;
+    if (frozen_) {
+        result.reserve(frozen_skills_.size());
+        for (const auto& skill : frozen_skills_) {
+            result.push_back(&skill);
+        }
+        return result;
+    }
     for (const auto& [id, skill] : skills_) {
         result.push_back(&skill);
     }
@@ -59,21 +261,218 @@ float SkillTreeManager::GetScaledMultiplier(int skill_id, int skill_level) const
     const SkillNode* skill = GetSkill(skill_id);
     if (!skill) return 1.0f;
 
-    int level = std::clamp(skill_level, 1, skill->max_level);
-    // 每级+10%倍率
-    float bonus = 1.0f + (level - 1) * 0.10f;
-    return skill->damage_multiplier * bonus;
+    int level = std::clamp(skill_level, 1, std::min(skill->max_level, MAX_SKILL_LEVEL));
+    // 每级+10%倍率（编译期预展开，见 ElementTables.h）
+    return skill->damage_multiplier * SKILL_LEVEL_MULTIPLIER_BONUS[level];
 }
 
 int SkillTreeManager::GetScaledCooldown(int skill_id, int skill_level) const {
     const SkillNode* skill = GetSkill(skill_id);
     if (!skill) return 0;
 
-    int level = std::clamp(skill_level, 1, skill->max_level);
-    // 每级-5%冷却
-    float reduction = 1.0f - (level - 1) * 0.05f;
-    reduction = std::max(0.5f, reduction);  // 最多减50%
-    return static_cast<int>(skill->cooldown_ms * reduction);
+    int level = std::clamp(skill_level, 1, std::min(skill->max_level, MAX_SKILL_LEVEL));
+    // 每级-5%冷却，最多减50%（编译期预展开，见 ElementTables.h）
+    return static_cast<int>(skill->cooldown_ms * SKILL_LEVEL_COOLDOWN_FACTOR[level]);
+}
+
+namespace {
+
+// 评估树快照格式: 魔数"FLST" + 格式版本 + 树版本 + 状态版本 + 条目
+constexpr char kEvalTreeMagic[4] = {'F', 'L', 'S', 'T'};
+constexpr uint32_t kEvalTreeFormatVersion = 1;
+
+template <typename T>
+void AppendRaw(std::string& out, const T& value) {
+    const char* bytes = reinterpret_cast<const char*>(&value);
+    out.append(bytes, sizeof(T));
+}
+
+template <typename T>
+bool ReadRaw(const std::string& data, size_t& offset, T& value) {
+    if (offset + sizeof(T) > data.size()) {
+        return false;
+    }
+    std::memcpy(&value, data.data() + offset, sizeof(T));
+    offset += sizeof(T);
+    return true;
+}
+
+} // namespace
+
+std::vector<EvaluatedSkillEntry> SkillTreeManager::EvaluateEntries(
+    const std::vector<int>& learned_skills,
+    const std::vector<int>& skill_levels) const {
+    std::vector<EvaluatedSkillEntry> entries;
+    const std::vector<const SkillNode*> all_skills = GetAllSkills();
+    entries.reserve(all_skills.size());
+
+    // 冻结态下整树可解锁性走闭包位集：已学列表折算一次，
+    // 其后每个技能只剩几次字与运算
+    std::vector<uint64_t> learned_bits;
+    if (frozen_) {
+        learned_bits = BuildLearnedBitset(learned_skills);
+    }
+
+    size_t frozen_index = 0;
+    for (const SkillNode* skill : all_skills) {
+        EvaluatedSkillEntry entry;
+        entry.skill_id = skill->skill_id;
+
+        auto it = std::find(learned_skills.begin(), learned_skills.end(),
+                            skill->skill_id);
+        if (it != learned_skills.end()) {
+            const size_t pos =
+                static_cast<size_t>(it - learned_skills.begin());
+            // 等级列表不足时按1级处理
+            entry.level = pos < skill_levels.size()
+                              ? std::max(skill_levels[pos], 1)
+                              : 1;
+            entry.unlocked = true;
+        } else {
+            entry.level = 0;
+            // 冻结态遍历顺序即冻结下标顺序，直接做闭包子集检查
+            entry.unlocked = frozen_
+                                 ? ClosureSatisfied(frozen_index, learned_bits)
+                                 : CanLearnSkill(skill->skill_id, learned_skills);
+        }
+        ++frozen_index;
+
+        // 未学习的技能按1级预览折算值
+        const int effective_level = std::max(entry.level, 1);
+        entry.effective_multiplier =
+            GetScaledMultiplier(skill->skill_id, effective_level);
+        entry.effective_cooldown_ms =
+            GetScaledCooldown(skill->skill_id, effective_level);
+        entries.push_back(entry);
+    }
+
+    return entries;
+}
+
+void SkillTreeManager::UpdateCharacterSkillState(
+    int character_id,
+    const std::vector<int>& learned_skills,
+    const std::vector<int>& skill_levels) {
+    // 评估在锁外完成：整树折算只读冻结数组，不碰缓存
+    std::vector<EvaluatedSkillEntry> entries =
+        EvaluateEntries(learned_skills, skill_levels);
+
+    std::unique_lock<std::shared_mutex> lock(evaluated_mutex_);
+    EvaluatedSkillTree& tree = evaluated_trees_[character_id];
+    ++tree.state_version;
+    tree.tree_version = tree_version_;
+    tree.entries = std::move(entries);
+}
+
+EvaluatedSkillTree SkillTreeManager::GetEvaluatedTree(int character_id) const {
+    std::shared_lock<std::shared_mutex> lock(evaluated_mutex_);
+    auto it = evaluated_trees_.find(character_id);
+    if (it == evaluated_trees_.end() || it->second.tree_version != tree_version_) {
+        // 无缓存，或技能树内容在评估后发生变化：视为缺失
+        return EvaluatedSkillTree{};
+    }
+    return it->second;
+}
+
+float SkillTreeManager::GetEffectiveMultiplier(int character_id, int skill_id,
+                                               int skill_level) const {
+    {
+        std::shared_lock<std::shared_mutex> lock(evaluated_mutex_);
+        auto it = evaluated_trees_.find(character_id);
+        if (it != evaluated_trees_.end() &&
+            it->second.tree_version == tree_version_ && frozen_ &&
+            skill_id >= 0 &&
+            static_cast<size_t>(skill_id) < id_to_index_.size()) {
+            const int32_t index = id_to_index_[static_cast<size_t>(skill_id)];
+            if (index >= 0 &&
+                static_cast<size_t>(index) < it->second.entries.size()) {
+                const EvaluatedSkillEntry& entry =
+                    it->second.entries[static_cast<size_t>(index)];
+                // 请求等级与缓存等级一致才用预算值，防止过期请求读错档
+                if (entry.level == skill_level) {
+                    return entry.effective_multiplier;
+                }
+            }
+        }
+    }
+    return GetScaledMultiplier(skill_id, skill_level);
+}
+
+std::string SkillTreeManager::SerializeEvaluatedTree(int character_id) const {
+    const EvaluatedSkillTree tree = GetEvaluatedTree(character_id);
+    if (tree.entries.empty()) {
+        return std::string();
+    }
+
+    std::string out;
+    out.reserve(sizeof(kEvalTreeMagic) + sizeof(uint32_t) +
+                2 * sizeof(uint64_t) + sizeof(uint32_t) +
+                tree.entries.size() * 17);
+    out.append(kEvalTreeMagic, sizeof(kEvalTreeMagic));
+    AppendRaw(out, kEvalTreeFormatVersion);
+    AppendRaw(out, tree.tree_version);
+    AppendRaw(out, tree.state_version);
+    AppendRaw(out, static_cast<uint32_t>(tree.entries.size()));
+    for (const EvaluatedSkillEntry& entry : tree.entries) {
+        AppendRaw(out, static_cast<int32_t>(entry.skill_id));
+        AppendRaw(out, static_cast<uint8_t>(entry.unlocked ? 1 : 0));
+        AppendRaw(out, static_cast<int32_t>(entry.level));
+        AppendRaw(out, entry.effective_multiplier);
+        AppendRaw(out, static_cast<int32_t>(entry.effective_cooldown_ms));
+    }
+    return out;
+}
+
+bool SkillTreeManager::RestoreEvaluatedTree(int character_id,
+                                            const std::string& data) {
+    size_t offset = sizeof(kEvalTreeMagic);
+    if (data.size() < offset ||
+        std::memcmp(data.data(), kEvalTreeMagic, sizeof(kEvalTreeMagic)) != 0) {
+        return false;
+    }
+
+    uint32_t format_version = 0;
+    EvaluatedSkillTree tree;
+    uint32_t count = 0;
+    if (!ReadRaw(data, offset, format_version) ||
+        format_version != kEvalTreeFormatVersion ||
+        !ReadRaw(data, offset, tree.tree_version) ||
+        !ReadRaw(data, offset, tree.state_version) ||
+        !ReadRaw(data, offset, count)) {
+        return false;
+    }
+
+    // 技能树内容已更新：快照失效，等下一次状态上报重算
+    if (tree.tree_version != tree_version_) {
+        return false;
+    }
+
+    tree.entries.reserve(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        int32_t skill_id = 0;
+        uint8_t unlocked = 0;
+        int32_t level = 0;
+        float multiplier = 1.0f;
+        int32_t cooldown_ms = 0;
+        if (!ReadRaw(data, offset, skill_id) ||
+            !ReadRaw(data, offset, unlocked) ||
+            !ReadRaw(data, offset, level) ||
+            !ReadRaw(data, offset, multiplier) ||
+            !ReadRaw(data, offset, cooldown_ms)) {
+            return false;
+        }
+        EvaluatedSkillEntry entry;
+        entry.skill_id = skill_id;
+        entry.unlocked = unlocked != 0;
+        entry.level = level;
+        entry.effective_multiplier = multiplier;
+        entry.effective_cooldown_ms = cooldown_ms;
+        tree.entries.push_back(entry);
+    }
+
+    std::unique_lock<std::shared_mutex> lock(evaluated_mutex_);
+    evaluated_trees_[character_id] = std::move(tree);
+    return true;
 }
 
 void SkillTreeManager::InitializeDefaultSkills() {
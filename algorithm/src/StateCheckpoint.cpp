@@ -0,0 +1,359 @@
+/*
+ * 文件名: StateCheckpoint.cpp
+ * 说明: 算法服务状态检查点（热启动持久化）
+ * 作者: 彭承康
+ * 创建时间: 2026-08-28
+ *
+ * 服务重启会丢掉全部角色注册、冷却状态与AI决策记忆，策略层
+ * 只能靠RPC慢慢重灌，期间战斗结算停摆。本文件把这些状态按
+ * 定长二进制记录写入本地检查点文件：保存时先写临时文件再原子
+ * 改名；恢复时在Linux上整体mmap后按固定步长直读各区段，无需
+ * 逐字段解析，服务弹跳后亚秒内恢复供给准确结果。
+ *
+ * 文件布局（小端，宿主字节序）:
+ *   CheckpointHeader
+ *   CharacterRecord × character_count
+ *   CooldownRecord  × cooldown_count
+ *   NpcTypeRecord   × npc_type_count
+ *   MemoryRecord    × memory_count
+ */
+#include "AlgorithmService.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <type_traits>
+#include <vector>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace algorithm {
+
+namespace {
+
+constexpr uint32_t CHECKPOINT_MAGIC = 0x504B4341;  // "ACKP"
+constexpr uint32_t CHECKPOINT_VERSION = 1;
+
+// 角色名在记录中的定长存储（超长截断）
+constexpr size_t CHECKPOINT_NAME_SIZE = 32;
+
+// 每条记忆记录承载的动作数上限（≥引擎的MEMORY_SIZE即可）
+constexpr size_t CHECKPOINT_MEMORY_ACTIONS = 8;
+
+struct CheckpointHeader {
+    uint32_t magic = CHECKPOINT_MAGIC;
+    uint32_t version = CHECKPOINT_VERSION;
+    uint32_t character_count = 0;
+    uint32_t cooldown_count = 0;
+    uint32_t npc_type_count = 0;
+    uint32_t memory_count = 0;
+    int64_t cooldown_clock_ms = 0;
+};
+
+struct CharacterRecord {
+    int32_t character_id = 0;
+    char name[CHECKPOINT_NAME_SIZE] = {};
+    int32_t profession = 0;
+    int32_t element = 0;
+    int32_t level = 1;
+    float max_hp = 0.0f;
+    float current_hp = 0.0f;
+    float max_mp = 0.0f;
+    float current_mp = 0.0f;
+    float attack = 0.0f;
+    float defense = 0.0f;
+    float magic_attack = 0.0f;
+    float magic_defense = 0.0f;
+    float speed = 0.0f;
+    float luck = 0.0f;
+    float crit_rate = 0.0f;
+    float crit_damage = 0.0f;
+};
+
+struct CooldownRecord {
+    int64_t key = 0;
+    int64_t ready_at_ms = 0;
+};
+
+struct NpcTypeRecord {
+    int32_t npc_id = 0;
+    int32_t type = 0;
+};
+
+struct MemoryRecord {
+    int32_t npc_id = 0;
+    int32_t count = 0;
+    int32_t actions[CHECKPOINT_MEMORY_ACTIONS] = {};
+};
+
+static_assert(std::is_trivially_copyable_v<CheckpointHeader>);
+static_assert(std::is_trivially_copyable_v<CharacterRecord>);
+static_assert(std::is_trivially_copyable_v<CooldownRecord>);
+static_assert(std::is_trivially_copyable_v<NpcTypeRecord>);
+static_assert(std::is_trivially_copyable_v<MemoryRecord>);
+
+CharacterRecord ToRecord(const CharacterStats& stats) {
+    CharacterRecord record;
+    record.character_id = stats.character_id;
+    const size_t copy_len = std::min(stats.name.size(), CHECKPOINT_NAME_SIZE - 1);
+    std::memcpy(record.name, stats.name.data(), copy_len);
+    record.profession = static_cast<int32_t>(stats.profession);
+    record.element = static_cast<int32_t>(stats.element);
+    record.level = stats.level;
+    record.max_hp = stats.max_hp;
+    record.current_hp = stats.current_hp;
+    record.max_mp = stats.max_mp;
+    record.current_mp = stats.current_mp;
+    record.attack = stats.attack;
+    record.defense = stats.defense;
+    record.magic_attack = stats.magic_attack;
+    record.magic_defense = stats.magic_defense;
+    record.speed = stats.speed;
+    record.luck = stats.luck;
+    record.crit_rate = stats.crit_rate;
+    record.crit_damage = stats.crit_damage;
+    return record;
+}
+
+CharacterStats FromRecord(const CharacterRecord& record) {
+    CharacterStats stats;
+    stats.character_id = record.character_id;
+    stats.name.assign(record.name,
+                      strnlen(record.name, CHECKPOINT_NAME_SIZE));
+    stats.profession = static_cast<Profession>(record.profession);
+    stats.element = static_cast<Element>(record.element);
+    stats.level = record.level;
+    stats.max_hp = record.max_hp;
+    stats.current_hp = record.current_hp;
+    stats.max_mp = record.max_mp;
+    stats.current_mp = record.current_mp;
+    stats.attack = record.attack;
+    stats.defense = record.defense;
+    stats.magic_attack = record.magic_attack;
+    stats.magic_defense = record.magic_defense;
+    stats.speed = record.speed;
+    stats.luck = record.luck;
+    stats.crit_rate = record.crit_rate;
+    stats.crit_damage = record.crit_damage;
+    return stats;
+}
+
+template <typename Record>
+bool WriteRecords(std::ofstream& out, const std::vector<Record>& records) {
+    if (records.empty()) return out.good();
+    out.write(reinterpret_cast<const char*>(records.data()),
+              static_cast<std::streamsize>(records.size() * sizeof(Record)));
+    return out.good();
+}
+
+/**
+ * @brief 只读整体载入检查点文件
+ *
+ * Linux 下 mmap 直映文件页，其余平台回退为一次性读入缓冲；
+ * 两种方式对恢复逻辑呈现同一段连续字节。
+ */
+class CheckpointMapping {
+public:
+    explicit CheckpointMapping(const std::string& path) {
+#ifdef __linux__
+        fd_ = ::open(path.c_str(), O_RDONLY);
+        if (fd_ < 0) return;
+        struct stat st;
+        if (::fstat(fd_, &st) != 0 || st.st_size <= 0) return;
+        size_ = static_cast<size_t>(st.st_size);
+        void* mapped = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd_, 0);
+        if (mapped == MAP_FAILED) {
+            size_ = 0;
+            return;
+        }
+        data_ = static_cast<const unsigned char*>(mapped);
+#else
+        std::ifstream in(path, std::ios::binary | std::ios::ate);
+        if (!in.is_open()) return;
+        const std::streamsize file_size = in.tellg();
+        if (file_size <= 0) return;
+        buffer_.resize(static_cast<size_t>(file_size));
+        in.seekg(0);
+        if (!in.read(reinterpret_cast<char*>(buffer_.data()), file_size)) {
+            buffer_.clear();
+            return;
+        }
+        data_ = buffer_.data();
+        size_ = buffer_.size();
+#endif
+    }
+
+    ~CheckpointMapping() {
+#ifdef __linux__
+        if (data_ != nullptr) {
+            ::munmap(const_cast<unsigned char*>(data_), size_);
+        }
+        if (fd_ >= 0) {
+            ::close(fd_);
+        }
+#endif
+    }
+
+    CheckpointMapping(const CheckpointMapping&) = delete;
+    CheckpointMapping& operator=(const CheckpointMapping&) = delete;
+
+    bool valid() const { return data_ != nullptr; }
+    size_t size() const { return size_; }
+
+    /**
+     * @brief 按步长读出一条记录，越界返回false
+     */
+    template <typename Record>
+    bool read(size_t& offset, Record& out) const {
+        if (offset + sizeof(Record) > size_) return false;
+        std::memcpy(&out, data_ + offset, sizeof(Record));
+        offset += sizeof(Record);
+        return true;
+    }
+
+private:
+    const unsigned char* data_ = nullptr;
+    size_t size_ = 0;
+#ifdef __linux__
+    int fd_ = -1;
+#else
+    std::vector<unsigned char> buffer_;
+#endif
+};
+
+} // namespace
+
+bool AlgorithmService::SaveStateCheckpoint(const std::string& path) const {
+    std::vector<CooldownTracker::SnapshotEntry> cooldowns;
+    const int64_t clock_ms = cooldown_tracker_.exportState(cooldowns);
+    const std::vector<CharacterStats> characters = stats_registry_->getAllCharacters();
+    const auto npc_types = ai_engine_->ExportNPCTypes();
+    const auto memories = ai_engine_->ExportDecisionMemory();
+
+    CheckpointHeader header;
+    header.character_count = static_cast<uint32_t>(characters.size());
+    header.cooldown_count = static_cast<uint32_t>(cooldowns.size());
+    header.npc_type_count = static_cast<uint32_t>(npc_types.size());
+    header.memory_count = static_cast<uint32_t>(memories.size());
+    header.cooldown_clock_ms = clock_ms;
+
+    std::vector<CharacterRecord> character_records;
+    character_records.reserve(characters.size());
+    for (const CharacterStats& stats : characters) {
+        character_records.push_back(ToRecord(stats));
+    }
+
+    std::vector<CooldownRecord> cooldown_records;
+    cooldown_records.reserve(cooldowns.size());
+    for (const auto& entry : cooldowns) {
+        cooldown_records.push_back(CooldownRecord{entry.key, entry.ready_at_ms});
+    }
+
+    std::vector<NpcTypeRecord> npc_records;
+    npc_records.reserve(npc_types.size());
+    for (const auto& pair : npc_types) {
+        npc_records.push_back(
+            NpcTypeRecord{pair.first, static_cast<int32_t>(pair.second)});
+    }
+
+    std::vector<MemoryRecord> memory_records;
+    memory_records.reserve(memories.size());
+    for (const auto& snapshot : memories) {
+        MemoryRecord record;
+        record.npc_id = snapshot.npc_id;
+        const size_t count =
+            std::min(snapshot.recent_actions.size(), CHECKPOINT_MEMORY_ACTIONS);
+        record.count = static_cast<int32_t>(count);
+        for (size_t i = 0; i < count; ++i) {
+            record.actions[i] = snapshot.recent_actions[i];
+        }
+        memory_records.push_back(record);
+    }
+
+    // 先写临时文件，成功后原子改名，避免崩溃留下半截文件
+    const std::string tmp_path = path + ".tmp";
+    {
+        std::ofstream out(tmp_path, std::ios::binary | std::ios::trunc);
+        if (!out.is_open()) return false;
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        if (!out.good() ||
+            !WriteRecords(out, character_records) ||
+            !WriteRecords(out, cooldown_records) ||
+            !WriteRecords(out, npc_records) ||
+            !WriteRecords(out, memory_records)) {
+            return false;
+        }
+    }
+    if (std::rename(tmp_path.c_str(), path.c_str()) != 0) {
+        std::remove(tmp_path.c_str());
+        return false;
+    }
+    return true;
+}
+
+bool AlgorithmService::LoadStateCheckpoint(const std::string& path) {
+    CheckpointMapping mapping(path);
+    if (!mapping.valid()) return false;
+
+    size_t offset = 0;
+    CheckpointHeader header;
+    if (!mapping.read(offset, header) ||
+        header.magic != CHECKPOINT_MAGIC ||
+        header.version != CHECKPOINT_VERSION) {
+        return false;
+    }
+
+    // 先整体校验长度，再开始写服务状态，坏文件不会恢复出半套状态
+    const size_t expected_size = sizeof(CheckpointHeader) +
+        static_cast<size_t>(header.character_count) * sizeof(CharacterRecord) +
+        static_cast<size_t>(header.cooldown_count) * sizeof(CooldownRecord) +
+        static_cast<size_t>(header.npc_type_count) * sizeof(NpcTypeRecord) +
+        static_cast<size_t>(header.memory_count) * sizeof(MemoryRecord);
+    if (mapping.size() != expected_size) return false;
+
+    for (uint32_t i = 0; i < header.character_count; ++i) {
+        CharacterRecord record;
+        if (!mapping.read(offset, record)) return false;
+        RegisterCharacter(FromRecord(record));
+    }
+
+    std::vector<CooldownTracker::SnapshotEntry> cooldowns;
+    cooldowns.reserve(header.cooldown_count);
+    for (uint32_t i = 0; i < header.cooldown_count; ++i) {
+        CooldownRecord record;
+        if (!mapping.read(offset, record)) return false;
+        cooldowns.push_back(
+            CooldownTracker::SnapshotEntry{record.key, record.ready_at_ms});
+    }
+    cooldown_tracker_.importState(header.cooldown_clock_ms, cooldowns);
+
+    for (uint32_t i = 0; i < header.npc_type_count; ++i) {
+        NpcTypeRecord record;
+        if (!mapping.read(offset, record)) return false;
+        RegisterNPCType(record.npc_id, static_cast<NPCType>(record.type));
+    }
+
+    std::vector<AIDecisionEngine::DecisionMemorySnapshot> memories;
+    memories.reserve(header.memory_count);
+    for (uint32_t i = 0; i < header.memory_count; ++i) {
+        MemoryRecord record;
+        if (!mapping.read(offset, record)) return false;
+        AIDecisionEngine::DecisionMemorySnapshot snapshot;
+        snapshot.npc_id = record.npc_id;
+        const int32_t count = std::clamp<int32_t>(
+            record.count, 0, static_cast<int32_t>(CHECKPOINT_MEMORY_ACTIONS));
+        snapshot.recent_actions.assign(record.actions, record.actions + count);
+        memories.push_back(std::move(snapshot));
+    }
+    ai_engine_->ImportDecisionMemory(memories);
+
+    return true;
+}
+
+} // namespace algorithm
@@ -0,0 +1,157 @@
+/*
+ * 文件名: ValidatedString.cpp
+ * 说明: 校验后字符串类型的查表字节分类与UTF-8结构校验实现
+ * 作者: 彭承康
+ * 创建时间: 2026-08-28
+ */
+
+#include "ValidatedString.h"
+#include "InputValidator.h"
+#include <array>
+#include <cstdint>
+
+namespace algorithm {
+
+namespace {
+
+// ============ 查表字节分类 ============
+//
+// 每个类型一张256项允许表：ASCII字节直接查表判定，无分支模式
+// 匹配；高位字节（>=0x80）统一走UTF-8结构校验。表在编译期构造。
+
+using ByteTable = std::array<bool, 256>;
+
+constexpr ByteTable MakePlayerNameTable() {
+    ByteTable table{};
+    for (int c = 'a'; c <= 'z'; ++c) { table[static_cast<std::size_t>(c)] = true; }
+    for (int c = 'A'; c <= 'Z'; ++c) { table[static_cast<std::size_t>(c)] = true; }
+    for (int c = '0'; c <= '9'; ++c) { table[static_cast<std::size_t>(c)] = true; }
+    table[static_cast<std::size_t>('_')] = true;
+    table[static_cast<std::size_t>('-')] = true;
+    return table;
+}
+
+constexpr ByteTable MakeChatLineTable() {
+    ByteTable table{};
+    for (int c = 0x20; c <= 0x7E; ++c) { table[static_cast<std::size_t>(c)] = true; }
+    return table;
+}
+
+constexpr ByteTable PLAYER_NAME_ASCII = MakePlayerNameTable();
+constexpr ByteTable CHAT_LINE_ASCII = MakeChatLineTable();
+
+/**
+ * @brief 从text[pos]起的UTF-8多字节序列的长度，非法返回0
+ *
+ * 按RFC 3629的合法区间做范围检查：拒绝过长编码（如C0/C1、
+ * E0 80..9F）、UTF-16代理区（ED A0..BF）和超出U+10FFFF的
+ * 序列（F4 90..、F5..FF）。
+ */
+std::size_t Utf8SequenceLength(std::string_view text, std::size_t pos) {
+    const auto byte = [&text](std::size_t i) {
+        return static_cast<unsigned char>(text[i]);
+    };
+    const auto isCont = [&byte](std::size_t i) {
+        return (byte(i) & 0xC0u) == 0x80u;
+    };
+
+    const unsigned char lead = byte(pos);
+    const std::size_t remaining = text.size() - pos;
+
+    if (lead >= 0xC2u && lead <= 0xDFu) {
+        if (remaining >= 2 && isCont(pos + 1)) {
+            return 2;
+        }
+        return 0;
+    }
+    if (lead >= 0xE0u && lead <= 0xEFu) {
+        if (remaining < 3 || !isCont(pos + 1) || !isCont(pos + 2)) {
+            return 0;
+        }
+        const unsigned char second = byte(pos + 1);
+        if (lead == 0xE0u && second < 0xA0u) {
+            return 0;  // 过长编码
+        }
+        if (lead == 0xEDu && second > 0x9Fu) {
+            return 0;  // UTF-16代理区
+        }
+        return 3;
+    }
+    if (lead >= 0xF0u && lead <= 0xF4u) {
+        if (remaining < 4 || !isCont(pos + 1) || !isCont(pos + 2) || !isCont(pos + 3)) {
+            return 0;
+        }
+        const unsigned char second = byte(pos + 1);
+        if (lead == 0xF0u && second < 0x90u) {
+            return 0;  // 过长编码
+        }
+        if (lead == 0xF4u && second > 0x8Fu) {
+            return 0;  // 超出U+10FFFF
+        }
+        return 4;
+    }
+    // 0x80..0xC1、0xF5..0xFF：孤立续字节或非法前导字节
+    return 0;
+}
+
+/**
+ * @brief 共享校验核心：ASCII查允许表，高位字节走UTF-8结构校验
+ */
+ValidationResult ValidateText(std::string_view text, const ByteTable& ascii_allowed,
+                              std::size_t max_bytes, const char* what) {
+    if (text.empty()) {
+        return ValidationResult::fail(std::string(what) + "不能为空");
+    }
+    if (text.size() > max_bytes) {
+        return ValidationResult::fail(std::string(what) + "过长");
+    }
+
+    std::size_t i = 0;
+    while (i < text.size()) {
+        const unsigned char c = static_cast<unsigned char>(text[i]);
+        if (c < 0x80u) {
+            if (!ascii_allowed[c]) {
+                return ValidationResult::fail(
+                    std::string(what) + "含非法字符，位置 " + std::to_string(i));
+            }
+            ++i;
+            continue;
+        }
+        const std::size_t len = Utf8SequenceLength(text, i);
+        if (len == 0) {
+            return ValidationResult::fail(
+                std::string(what) + "含非法UTF-8序列，位置 " + std::to_string(i));
+        }
+        i += len;
+    }
+    return ValidationResult::ok();
+}
+
+} // namespace
+
+ValidationResult PlayerName::Validate(std::string_view text) {
+    if (!text.empty() && text.front() == '-') {
+        return ValidationResult::fail("玩家名不能以连字符开头");
+    }
+    return ValidateText(text, PLAYER_NAME_ASCII, MAX_BYTES, "玩家名");
+}
+
+std::optional<PlayerName> PlayerName::Create(std::string_view text) {
+    if (!Validate(text).success) {
+        return std::nullopt;
+    }
+    return PlayerName(std::string(text));
+}
+
+ValidationResult ChatLine::Validate(std::string_view text) {
+    return ValidateText(text, CHAT_LINE_ASCII, MAX_BYTES, "聊天行");
+}
+
+std::optional<ChatLine> ChatLine::Create(std::string_view text) {
+    if (!Validate(text).success) {
+        return std::nullopt;
+    }
+    return ChatLine(std::string(text));
+}
+
+} // namespace algorithm
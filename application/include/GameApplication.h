@@ -20,6 +20,8 @@ class GameEngine;
 class NetworkManager;
 class AudioManager;
 class ResourceManager;
+class QmlComponentPool;
+class GameConfig;
 
 /**
  * @brief 游戏应用程序主类
@@ -85,9 +87,22 @@ public:
      */
     void start();
     
+    /**
+     * @brief 无头回放一场战斗
+     *
+     * 不加载QML界面，直接委托游戏引擎重放指定的战斗回放文件
+     * 并导出性能档案。供--replay-battle命令行模式使用，把玩家
+     * 的卡顿报告离线复现成可分析的档案。
+     *
+     * @param filePath 回放文件路径
+     * @return bool 回放是否完整执行到战斗结束
+     * @pre initialize()必须已成功调用
+     */
+    bool runBattleReplay(const QString &filePath);
+
     /**
      * @brief 关闭应用程序
-     * 
+     *
      * 优雅地关闭应用程序，执行清理工作：
      * - 保存游戏状态和用户设置
      * - 关闭网络连接
@@ -192,6 +207,25 @@ private:
      * 负责游戏场景的加载、切换和管理
      */
     std::unique_ptr<SceneManager> m_sceneManager;  // 添加场景管理器
+
+    /**
+     * @brief QML组件对象池
+     * 预实例化高频开关的QML组件，打开界面时直接复用
+     */
+    std::unique_ptr<QmlComponentPool> m_componentPool;
+
+    /**
+     * @brief 游戏配置实例
+     * 持久化设置（音频、图形、特效细节层级覆盖等），
+     * 以gameConfig暴露给QML设置界面
+     */
+    std::unique_ptr<GameConfig> m_gameConfig;
+
+    /**
+     * @brief 本次运行的特效细节层级
+     * 由能力探测或配置覆盖决定，渲染组件创建时取用
+     */
+    int m_effectLodTier = 2;
     
     /**
      * @brief 初始化状态标志
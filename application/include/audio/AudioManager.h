@@ -7,19 +7,27 @@
  * 本类管理游戏中的所有音频功能，包括背景音乐、音效、
  * 语音等的播放控制。提供音量调节、音频缓存、3D音效等
  * 高级功能，为游戏提供丰富的听觉体验。
+ *
+ * 实际的播放器全部运行在专用音频线程（AudioWorker）上，
+ * 本类只做参数校验和命令入队：每个播放接口在主线程的
+ * 成本是一次无锁队列push，不会阻塞帧循环。
  */
 #pragma once
 
 #include <QObject>
-#include <QMediaPlayer>
-#include <QAudioOutput>
-#include <QSoundEffect>
 #include <QMediaDevices>
 #include <QAudioDevice>
-#include <QHash>
-#include <QQueue>
+#include <QSet>
+#include <QString>
+#include <QStringList>
 #include <memory>
 
+#include "audio/AudioWorker.h"
+
+QT_BEGIN_NAMESPACE
+class QThread;
+QT_END_NAMESPACE
+
 /**
  * @brief 音频类型枚举
  * 
@@ -176,9 +184,32 @@ public:
      */
     Q_INVOKABLE void playMusic(const QString &musicFile, bool loop = true, bool fadeIn = true);
     
+    /**
+     * @brief 交叉淡入到下一首背景音乐
+     *
+     * 新曲在备用声道以音量0起播并逐步淡入，当前音乐同步淡出。
+     * 两个声道都是流式解码，切歌过程不会同时持有两首完整曲目。
+     *
+     * @param musicFile 新音乐文件路径
+     * @param fadeMs 淡入淡出时长（毫秒）
+     * @param loop 是否循环播放
+     */
+    Q_INVOKABLE void crossfadeToMusic(const QString &musicFile, int fadeMs = 2000,
+                                      bool loop = true);
+
+    /**
+     * @brief 预热下一首背景音乐
+     *
+     * 在备用声道提前缓冲指定音乐的开头几秒，之后的playMusic
+     * 或crossfadeToMusic即起播，场景切换不再等待文件IO。
+     *
+     * @param musicFile 音乐文件路径
+     */
+    Q_INVOKABLE void primeMusic(const QString &musicFile);
+
     /**
      * @brief 停止背景音乐
-     * 
+     *
      * @param fadeOut 是否淡出停止
      */
     Q_INVOKABLE void stopMusic(bool fadeOut = true);
@@ -236,13 +267,45 @@ public:
     
     /**
      * @brief 卸载音频文件
-     * 
+     *
      * 从内存中卸载音频文件，释放内存。
-     * 
+     *
      * @param audioFile 音频文件路径
      */
     Q_INVOKABLE void unloadAudio(const QString &audioFile);
 
+    /**
+     * @brief 查询场景的音频清单
+     *
+     * 列出该场景独有的音效文件，不含所有场景共享的核心集。
+     *
+     * @param sceneName 场景名称
+     * @return QStringList 音效文件列表，未配置的场景为空
+     */
+    static QStringList sceneAudioManifest(const QString &sceneName);
+
+    /**
+     * @brief 查询常驻核心音频集
+     *
+     * 所有场景都会用到的界面音效，初始化时预解码后常驻内存，
+     * 不参与场景切换的差量卸载。
+     *
+     * @return QStringList 音效文件列表
+     */
+    static QStringList coreAudioSet();
+
+    /**
+     * @brief 按场景清单差量调整常驻音效
+     *
+     * 对比当前常驻集与目标场景清单（并上核心集）：仅旧场景
+     * 用到的音效卸载释放内存，仅新场景用到的入队预解码。
+     * 加载/卸载都在音频线程后台执行，恰好与转场动画重叠，
+     * 不再把整秒的音频IO计入场景切换。
+     *
+     * @param sceneName 目标场景名称
+     */
+    Q_INVOKABLE void applySceneAudio(const QString &sceneName);
+
 signals:
     /**
      * @brief 主音量改变信号
@@ -267,18 +330,22 @@ signals:
 
 private slots:
     /**
-     * @brief 媒体播放器状态改变处理
-     * 
-     * @param state 新的播放状态
+     * @brief 音频线程上报音乐播放结束
+     *
+     * @param musicFile 结束的音乐文件
      */
-    void onMediaPlayerStateChanged(QMediaPlayer::PlaybackState state);
-    
+    void onWorkerMusicFinished(const QString &musicFile);
+
+private:
     /**
-     * @brief 音频输出设备改变处理
+     * @brief 向音频线程提交命令
+     *
+     * 入队后通过队列连接唤醒音频线程；队列满时丢弃并告警。
+     *
+     * @param command 音频命令
      */
-    void onAudioOutputChanged();
+    void enqueueCommand(const AudioCommand &command);
 
-private:
     /**
      * @brief 更新实际音量
      * 
@@ -298,40 +365,27 @@ private:
 
 private:
     /**
-     * @brief 背景音乐播放器
-     * 
-     * 用于播放背景音乐的媒体播放器。
-     */
-    std::unique_ptr<QMediaPlayer> m_musicPlayer;
-    
-    /**
-     * @brief 音频输出设备
-     * 
-     * 音频输出设备，控制音量和音频路由。
-     */
-    std::unique_ptr<QAudioOutput> m_audioOutput;
-    
-    /**
-     * @brief 音效播放器映射
-     * 
-     * 存储所有活跃的音效播放器，键为音效ID。
+     * @brief 音频命令队列
+     *
+     * 主线程与音频线程之间的无锁环形队列。
      */
-    QHash<int, QSoundEffect*> m_effectPlayers;
-    
+    std::unique_ptr<AudioCommandQueue> m_commandQueue;
+
     /**
-     * @brief 预加载的音效缓存
-     * 
-     * 预加载到内存中的音效文件缓存。
+     * @brief 专用音频线程
+     *
+     * 所有Qt Multimedia播放器常驻此线程。
      */
-    QHash<QString, QSoundEffect*> m_preloadedEffects;
-    
+    QThread *m_audioThread;
+
     /**
-     * @brief 音效播放队列
-     * 
-     * 等待播放的音效队列，用于管理并发播放。
+     * @brief 音频线程工作对象
+     *
+     * 持有全部播放器并执行队列中的命令，无父对象，
+     * 由本类在shutdown时销毁。
      */
-    QQueue<QString> m_effectQueue;
-    
+    AudioWorker *m_audioWorker;
+
     /**
      * @brief 主音量
      * 
@@ -374,15 +428,16 @@ private:
     
     /**
      * @brief 下一个音效ID
-     * 
+     *
      * 用于生成唯一音效播放ID的计数器。
      */
     int m_nextEffectId;
-    
+
     /**
-     * @brief 最大并发音效数量
-     * 
-     * 允许同时播放的最大音效数量。
+     * @brief 当前常驻的预解码音效集
+     *
+     * 核心集与当前场景清单的并集，applySceneAudio据此计算
+     * 场景切换时的加载/卸载差量。
      */
-    static const int MAX_CONCURRENT_EFFECTS = 16;
+    QSet<QString> m_residentAudio;
 };
\ No newline at end of file
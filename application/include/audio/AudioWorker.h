@@ -0,0 +1,306 @@
+/*
+ * 文件名: AudioWorker.h
+ * 说明: 专用音频线程的工作对象与无锁命令队列。
+ * 作者: 彭承康
+ * 创建时间: 2026-08-28
+ *
+ * 战斗中音效爆发时在主线程驱动Qt Multimedia会产生可闻的
+ * 卡顿和帧尖峰。所有播放器（QMediaPlayer/QSoundEffect）改为
+ * 常驻专用音频线程，主线程通过无锁环形队列下发命令：
+ * play/stop/volume在主线程的成本只是一次入队。
+ *
+ * 短音效由QSoundEffect预解码进内存（Preload命令），播放零
+ * 文件IO；背景音乐由双声道QMediaPlayer流式解码（分块读取、
+ * 双缓冲切换），PrimeMusic可提前缓冲下一首的开头实现即起播，
+ * CrossfadeMusic在两声道间交叉淡入，任何时刻都不持有两首
+ * 完整曲目。
+ */
+#pragma once
+
+#include <QObject>
+#include <QHash>
+#include <QString>
+
+#include <atomic>
+#include <memory>
+
+QT_BEGIN_NAMESPACE
+class QMediaPlayer;
+class QAudioOutput;
+class QSoundEffect;
+class QTimer;
+QT_END_NAMESPACE
+
+/**
+ * @brief 音频命令
+ *
+ * 主线程与音频线程之间的消息单元，按值通过无锁队列传递。
+ */
+struct AudioCommand {
+    /**
+     * @brief 命令类型
+     */
+    enum class Type {
+        None,           ///< 空命令（队列单元初始值）
+        PlayMusic,      ///< 播放背景音乐（file=路径, flag=循环）
+        StopMusic,      ///< 停止背景音乐
+        PauseMusic,     ///< 暂停背景音乐
+        ResumeMusic,    ///< 恢复背景音乐
+        PlayEffect,     ///< 播放音效（effectId, file, volume）
+        StopEffect,     ///< 停止音效（effectId）
+        StopAllEffects, ///< 停止所有音效
+        Preload,        ///< 预解码音效进内存（file）
+        Unload,         ///< 卸载预解码音效（file）
+        SetVolumes,     ///< 更新音量（volume=master, musicVolume, sfxVolume, flag=静音）
+        CrossfadeMusic, ///< 交叉淡入下一首音乐（file, flag=循环, durationMs）
+        PrimeMusic      ///< 预热下一首音乐的起始缓冲（file）
+    };
+
+    Type type = Type::None;     ///< 命令类型
+    int effectId = -1;          ///< 音效ID
+    QString file;               ///< 音频文件路径
+    float volume = -1.0f;       ///< 音量参数
+    float musicVolume = 0.0f;   ///< 音乐音量（SetVolumes）
+    float sfxVolume = 0.0f;     ///< 音效音量（SetVolumes）
+    bool flag = false;          ///< 布尔参数（循环/静音）
+    int durationMs = 0;         ///< 时长参数（CrossfadeMusic淡入淡出毫秒数）
+};
+
+/**
+ * @brief 有界无锁音频命令队列
+ *
+ * Vyukov有界MPMC环形队列，与EventSystem的事件环使用同一
+ * 算法：每个单元带序号，入队/出队各一次CAS，无互斥锁。
+ * 队列满时入队失败，由调用方决定丢弃策略。
+ */
+class AudioCommandQueue
+{
+public:
+    /// 队列容量，必须是2的幂
+    static constexpr int CAPACITY = 256;
+
+    AudioCommandQueue()
+    {
+        for (int i = 0; i < CAPACITY; ++i) {
+            m_cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    AudioCommandQueue(const AudioCommandQueue &) = delete;
+    AudioCommandQueue &operator=(const AudioCommandQueue &) = delete;
+
+    /**
+     * @brief 尝试入队
+     *
+     * @param command 音频命令
+     * @return bool 队列满时返回false
+     */
+    bool tryEnqueue(const AudioCommand &command)
+    {
+        qint64 pos = m_enqueuePos.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell &cell = m_cells[pos & MASK];
+            const qint64 sequence = cell.sequence.load(std::memory_order_acquire);
+            const qint64 diff = sequence - pos;
+            if (diff == 0) {
+                if (m_enqueuePos.compare_exchange_weak(pos, pos + 1,
+                                                       std::memory_order_relaxed)) {
+                    cell.command = command;
+                    cell.sequence.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false; // 队列已满
+            } else {
+                pos = m_enqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /**
+     * @brief 尝试出队
+     *
+     * @param command 输出参数，取出的命令
+     * @return bool 队列空时返回false
+     */
+    bool tryDequeue(AudioCommand &command)
+    {
+        qint64 pos = m_dequeuePos.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell &cell = m_cells[pos & MASK];
+            const qint64 sequence = cell.sequence.load(std::memory_order_acquire);
+            const qint64 diff = sequence - (pos + 1);
+            if (diff == 0) {
+                if (m_dequeuePos.compare_exchange_weak(pos, pos + 1,
+                                                       std::memory_order_relaxed)) {
+                    command = cell.command;
+                    cell.command = AudioCommand{};
+                    cell.sequence.store(pos + CAPACITY, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false; // 队列已空
+            } else {
+                pos = m_dequeuePos.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+private:
+    static constexpr qint64 MASK = CAPACITY - 1;
+
+    /**
+     * @brief 队列单元
+     */
+    struct Cell {
+        std::atomic<qint64> sequence{0};    ///< 单元序号
+        AudioCommand command;               ///< 命令载荷
+    };
+
+    Cell m_cells[CAPACITY];                             ///< 环形存储
+    alignas(64) std::atomic<qint64> m_enqueuePos{0};    ///< 入队位置
+    alignas(64) std::atomic<qint64> m_dequeuePos{0};    ///< 出队位置
+};
+
+/**
+ * @brief 音频线程工作对象
+ *
+ * 常驻专用QThread，持有全部Qt Multimedia播放器。命令经
+ * AudioCommandQueue到达后在drainCommands中批量执行；播放
+ * 完成等状态通过信号（跨线程队列连接）回传给AudioManager。
+ */
+class AudioWorker : public QObject
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief 构造函数
+     *
+     * @param queue 命令队列，由AudioManager持有
+     * @param parent 父对象指针
+     */
+    explicit AudioWorker(AudioCommandQueue *queue, QObject *parent = nullptr);
+    ~AudioWorker() override;
+
+public slots:
+    /**
+     * @brief 在音频线程上创建播放器
+     *
+     * 连接到QThread::started，保证所有播放器的线程亲和性
+     * 都在音频线程。
+     */
+    void initializeOnThread();
+
+    /**
+     * @brief 批量执行排队命令
+     *
+     * 主线程每次入队后通过队列连接唤醒一次。
+     */
+    void drainCommands();
+
+    /**
+     * @brief 在音频线程上释放播放器
+     *
+     * 线程退出前通过阻塞队列连接调用。
+     */
+    void shutdownOnThread();
+
+signals:
+    /**
+     * @brief 背景音乐播放结束信号
+     *
+     * @param musicFile 结束的音乐文件
+     */
+    void musicFinished(const QString &musicFile);
+
+    /**
+     * @brief 音效播放结束信号
+     *
+     * @param effectId 结束的音效ID
+     */
+    void effectFinished(int effectId);
+
+private:
+    /**
+     * @brief 执行单条命令
+     *
+     * @param command 音频命令
+     */
+    void execute(const AudioCommand &command);
+
+    /**
+     * @brief 播放音效
+     *
+     * 优先复用预解码缓存；未预解码的音效现场创建播放器。
+     *
+     * @param command PlayEffect命令
+     */
+    void playEffect(const AudioCommand &command);
+
+    /**
+     * @brief 把当前音量应用到所有播放器
+     */
+    void applyVolumes();
+
+    /**
+     * @brief 启动向下一首音乐的交叉淡入
+     *
+     * 备用声道起播新曲（音量0），淡入定时器逐步交换两声道
+     * 音量；两个声道都是流式解码，任何时刻都不会同时持有
+     * 两首完整曲目。
+     *
+     * @param file 新曲文件路径
+     * @param loop 是否循环
+     * @param durationMs 淡入淡出时长（毫秒）
+     */
+    void startCrossfade(const QString &file, bool loop, int durationMs);
+
+    /**
+     * @brief 淡入定时器步进：按进度交换两声道音量
+     */
+    void tickCrossfade();
+
+    /**
+     * @brief 立即完成淡入：停掉旧声道并释放其流式缓冲
+     */
+    void finishCrossfade();
+
+    /**
+     * @brief 双声道音乐播放单元（流式解码）
+     */
+    struct MusicDeck {
+        std::unique_ptr<QMediaPlayer> player;   ///< 播放器
+        std::unique_ptr<QAudioOutput> output;   ///< 输出设备
+    };
+
+    /**
+     * @brief 当前音乐音量（含主音量与静音）
+     */
+    float musicVolume() const
+    {
+        return m_isMuted ? 0.0f : (m_masterVolume * m_musicVolume);
+    }
+
+    AudioCommandQueue *m_queue;                         ///< 命令队列（不拥有）
+    MusicDeck m_musicDecks[2];                          ///< 双声道音乐单元（活跃+备用）
+    int m_activeDeck = 0;                               ///< 活跃声道下标
+    QHash<int, QSoundEffect *> m_effectPlayers;         ///< 活跃音效播放器
+    QHash<QString, QSoundEffect *> m_preloadedEffects;  ///< 预解码音效缓存
+    QString m_currentMusic;                             ///< 当前音乐文件
+    QString m_primedMusic;                              ///< 备用声道已预热的文件
+    QTimer *m_fadeTimer = nullptr;                      ///< 淡入淡出定时器（音频线程）
+    int m_fadeElapsedMs = 0;                            ///< 淡入已进行时长
+    int m_fadeDurationMs = 0;                           ///< 淡入总时长
+
+    float m_masterVolume = 1.0f;    ///< 主音量
+    float m_musicVolume = 0.7f;     ///< 音乐音量
+    float m_sfxVolume = 0.8f;       ///< 音效音量
+    bool m_isMuted = false;         ///< 静音状态
+
+    /// 允许同时播放的最大音效数量
+    static const int MAX_CONCURRENT_EFFECTS = 16;
+
+    /// 淡入淡出定时器步进间隔（毫秒）
+    static const int FADE_TICK_MS = 30;
+};
@@ -350,12 +350,62 @@ private:
     void setupAutoSave();
     bool validateConfiguration();
     bool validateValue(const QString &key, const QVariant &value) const;
+
+    /**
+     * @brief 创建默认配置文件
+     *
+     * 将所有默认值写入配置文件。调用方必须持有m_mutex。
+     */
     void createDefaultConfig();
 
+    /**
+     * @brief 确保QSettings对象已创建
+     *
+     * 二进制缓存命中时QSettings不在启动时创建（创建即触发ini解析），
+     * 首次写入或显式重新加载前由本方法按需补建。
+     */
+    void ensureSettings();
+
+    /**
+     * @brief 从QSettings刷新内存配置快照
+     *
+     * 解析路径完成后把全部键值复制进m_values。调用方必须持有m_mutex。
+     */
+    void refreshValuesFromSettings();
+
+    /**
+     * @brief 尝试从二进制缓存恢复配置
+     *
+     * 内存映射缓存文件，校验魔数、格式版本和其中记录的源文件
+     * 哈希；全部匹配时反序列化键值快照并完全跳过ini解析。
+     *
+     * @return bool 缓存命中且校验通过返回true，任何不符都回退解析
+     */
+    bool loadBinaryCache();
+
+    /**
+     * @brief 写出二进制配置缓存
+     *
+     * 序列化当前键值快照，并嵌入源配置文件的SHA-256哈希用于
+     * 下次启动的校验。调用方必须持有m_mutex。
+     */
+    void writeBinaryCache();
+
+    /**
+     * @brief 计算源配置文件的SHA-256哈希
+     * @return QByteArray 哈希值，文件不可读时为空
+     */
+    QByteArray sourceFileHash() const;
+
 private:
+    static constexpr quint32 CACHE_MAGIC = 0x47434C46;          ///< 缓存文件魔数"FLCG"
+    static constexpr quint32 CACHE_FORMAT_VERSION = 1;          ///< 缓存格式版本
+
     static ConfigManager* s_instance;  ///< 单例实例
-    QSettings* m_settings;             ///< Qt设置对象
+    QSettings* m_settings;             ///< Qt设置对象（缓存命中时延迟创建）
     QString m_configFilePath;          ///< 配置文件路径
+    QString m_cacheFilePath;           ///< 二进制缓存文件路径
+    QMap<QString, QVariant> m_values;  ///< 内存配置快照（读路径唯一来源）
     QMap<QString, QVariant> m_defaults; ///< 默认配置值
     static QMutex s_mutex;              ///< 静态互斥锁
     mutable QMutex m_mutex;             ///< 实例互斥锁
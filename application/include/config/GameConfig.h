@@ -34,6 +34,7 @@ class GameConfig : public QObject
     Q_PROPERTY(bool fullscreen READ fullscreen WRITE setFullscreen NOTIFY fullscreenChanged)
     Q_PROPERTY(bool vsync READ vsync WRITE setVsync NOTIFY vsyncChanged)
     Q_PROPERTY(bool showFPS READ showFPS WRITE setShowFPS NOTIFY showFPSChanged)
+    Q_PROPERTY(int effectLodTier READ effectLodTier WRITE setEffectLodTier NOTIFY effectLodTierChanged)
     
     // 游戏属性
     Q_PROPERTY(QString language READ language WRITE setLanguage NOTIFY languageChanged)
@@ -54,6 +55,33 @@ public:
     bool fullscreen() const;
     bool vsync() const;
     bool showFPS() const;
+
+    /**
+     * @brief 特效细节层级的手动覆盖值
+     *
+     * 0低/1中/2高；-1表示不覆盖，使用能力探测结果。
+     *
+     * @return int 手动覆盖层级
+     */
+    int effectLodTier() const;
+
+    /**
+     * @brief 已持久化的能力探测层级
+     *
+     * 由RenderCapabilityProbe首次探测后写入，后续启动
+     * 复用，跳过微基准；-1表示尚未探测。
+     *
+     * @return int 探测层级
+     */
+    int probedEffectLod() const;
+
+    /**
+     * @brief 写入能力探测层级
+     *
+     * @param tier 探测得到的层级（0~2）
+     */
+    void setProbedEffectLod(int tier);
+
     QString language() const;
     QMap<QString, int> keyBindings() const;
     
@@ -69,6 +97,7 @@ public slots:
     void setFullscreen(bool fullscreen);
     void setVsync(bool vsync);
     void setShowFPS(bool showFPS);
+    void setEffectLodTier(int tier);
     void setLanguage(const QString &language);
 
 signals:
@@ -79,6 +108,7 @@ signals:
     void fullscreenChanged();
     void vsyncChanged();
     void showFPSChanged();
+    void effectLodTierChanged();
     void languageChanged();
     void keyBindingsChanged();
 
@@ -96,6 +126,8 @@ private:
     bool m_fullscreen;
     bool m_vsync;
     bool m_showFPS;
+    int m_effectLodTier;    ///< 特效层级手动覆盖（-1不覆盖）
+    int m_probedEffectLod;  ///< 持久化的探测层级（-1未探测）
     
     // 游戏设置
     QString m_language;
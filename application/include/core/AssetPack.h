@@ -0,0 +1,117 @@
+/*
+ * 文件名: AssetPack.h
+ * 说明: 打包资源文件（FLPK格式）的内存映射读取器。
+ * 作者: 彭承康
+ * 创建时间: 2026-08-28
+ *
+ * 冷启动时逐个打开零散资源文件在机械硬盘上会产生数千次
+ * 小文件读取。FLPK把所有资源合并为单个归档：一次open+mmap
+ * 之后，所有资源访问都是纯内存操作。数据块按64字节对齐，
+ * 未压缩的条目可以零拷贝地交给解码器；条目可选zlib压缩
+ * （与qCompress/qUncompress兼容的载荷格式）。
+ *
+ * 归档由 tools/asset_packer 构建，二进制布局见其源码注释，
+ * 两侧必须保持一致。
+ */
+#pragma once
+
+#include <QByteArray>
+#include <QFile>
+#include <QHash>
+#include <QString>
+
+/**
+ * @brief FLPK资源包读取器
+ *
+ * 打开归档后整体内存映射，按相对路径查询条目数据。
+ * 未压缩条目返回指向映射内存的零拷贝QByteArray，压缩条目
+ * 解压后返回。映射的生命周期与本对象一致，零拷贝数据
+ * 不得在对象析构后继续使用。
+ */
+class AssetPack
+{
+public:
+    /// 归档格式版本，与asset_packer保持一致
+    static constexpr quint32 FORMAT_VERSION = 1;
+    /// 数据块对齐字节数，保证零拷贝解码的对齐要求
+    static constexpr qint64 DATA_ALIGNMENT = 64;
+    /// 条目标志：载荷为qCompress兼容的zlib压缩数据
+    static constexpr quint32 FLAG_COMPRESSED = 1;
+
+    explicit AssetPack() = default;
+    ~AssetPack();
+
+    // 映射指针归QFile所有，禁止拷贝
+    AssetPack(const AssetPack &) = delete;
+    AssetPack &operator=(const AssetPack &) = delete;
+
+    /**
+     * @brief 打开并映射资源包
+     *
+     * 校验文件头后解析索引，整个文件保持内存映射状态。
+     *
+     * @param packPath 归档文件路径
+     * @return bool 是否成功打开
+     */
+    bool open(const QString &packPath);
+
+    /**
+     * @brief 关闭资源包并解除映射
+     */
+    void close();
+
+    /**
+     * @brief 查询条目是否存在
+     *
+     * @param path 归档内相对路径（'/'分隔）
+     * @return bool 条目是否存在
+     */
+    bool contains(const QString &path) const { return m_entries.contains(path); }
+
+    /**
+     * @brief 读取条目数据
+     *
+     * 未压缩条目返回零拷贝视图，压缩条目解压后返回。
+     *
+     * @param path 归档内相对路径
+     * @return QByteArray 条目数据，不存在或解压失败时为空
+     */
+    QByteArray read(const QString &path) const;
+
+    /**
+     * @brief 获取条目数量
+     *
+     * @return int 归档内条目数量
+     */
+    int entryCount() const { return m_entries.size(); }
+
+    /**
+     * @brief 是否已打开
+     *
+     * @return bool 归档是否处于已映射状态
+     */
+    bool isOpen() const { return m_mapped != nullptr; }
+
+private:
+    /**
+     * @brief 索引条目
+     */
+    struct Entry {
+        qint64 dataOffset = 0;      ///< 数据块在归档内的偏移
+        qint64 storedSize = 0;      ///< 归档内存储大小（含压缩头）
+        qint64 originalSize = 0;    ///< 解压后大小
+        quint32 flags = 0;          ///< 条目标志位
+    };
+
+    /**
+     * @brief 解析归档索引
+     *
+     * @return bool 索引是否完整有效
+     */
+    bool parseIndex();
+
+    QFile m_file;                        ///< 归档文件，持有映射
+    const uchar *m_mapped = nullptr;     ///< 映射基地址
+    qint64 m_mappedSize = 0;             ///< 映射大小
+    QHash<QString, Entry> m_entries;     ///< 路径到条目的索引
+};
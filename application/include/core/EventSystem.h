@@ -25,12 +25,17 @@
 
 #include <QObject>
 #include <QVariant>
+#include <QHash>
 #include <QMap>
 #include <QQueue>
+#include <QVarLengthArray>
 #include <QTimer>
 #include <QMutex>
 #include <QJsonObject>
+#include <array>
+#include <atomic>
 #include <functional>
+#include <utility>
 
 /**
  * @brief 游戏事件基类
@@ -70,7 +75,10 @@ public:
         // 音频事件
         SoundPlayed,
         MusicChanged,
-        
+
+        // 内建事件数量哨兵（用于分发表大小，勿作为事件类型使用）
+        BuiltinEventCount,
+
         // 自定义事件
         Custom = 1000
     };
@@ -96,7 +104,43 @@ public:
      * @brief 虚析构函数
      */
     virtual ~GameEvent() = default;
-    
+
+    /**
+     * @brief 拷贝构造（计入拷贝计数）
+     *
+     * 热路径应使用移动语义；每次拷贝都会使copyCount()加一，
+     * 用于诊断事件传递链路上的多余拷贝。
+     */
+    GameEvent(const GameEvent &other);
+
+    /**
+     * @brief 拷贝赋值（计入拷贝计数）
+     */
+    GameEvent& operator=(const GameEvent &other);
+
+    /**
+     * @brief 移动构造（不计数；队列入队/出队走此路径）
+     */
+    GameEvent(GameEvent &&other) noexcept = default;
+
+    /**
+     * @brief 移动赋值（不计数）
+     */
+    GameEvent& operator=(GameEvent &&other) noexcept = default;
+
+    /**
+     * @brief 获取累计拷贝次数（诊断用）
+     *
+     * 发送N个事件后计数不增长，即证明该路径端到端零拷贝。
+     * @return 进程内所有GameEvent拷贝构造/拷贝赋值的总次数
+     */
+    static quint64 copyCount();
+
+    /**
+     * @brief 清零拷贝计数
+     */
+    static void resetCopyCount();
+
     /**
      * @brief 获取事件类型
      * @return 事件类型
@@ -115,6 +159,108 @@ public:
      */
     qint64 getTimestamp() const { return m_timestamp; }
     
+    // ==================== 类型化内联参数（热路径） ====================
+    //
+    // 战斗期间每帧会发送数百个事件，QString键+QVariant映射的负载
+    // 每个事件要做多次堆分配。热路径事件改用下面的内联参数槽：
+    // 定长数组直接嵌在事件对象里，键为编译期哈希的整数，读写
+    // 零堆分配。字符串等复杂负载仍走setData/getData冷路径。
+
+    /// 内联参数槽数量；超出后回退到QVariant冷路径
+    static constexpr int MAX_INLINE_PARAMS = 8;
+
+    /**
+     * @brief 参数键的编译期哈希（FNV-1a）
+     *
+     * 用法: static constexpr auto KEY_DAMAGE = GameEvent::paramKey("damage");
+     *
+     * @param str 键名字符串
+     * @return quint32 键哈希值
+     */
+    static constexpr quint32 paramKey(const char *str) {
+        quint32 hash = 2166136261u;
+        while (*str != '\0') {
+            hash ^= static_cast<quint32>(*str++);
+            hash *= 16777619u;
+        }
+        return hash;
+    }
+
+    /**
+     * @brief 设置整型内联参数（零堆分配）
+     * @param key 参数键（paramKey哈希值）
+     * @param value 参数值
+     */
+    void setInt(quint32 key, int value);
+
+    /**
+     * @brief 设置64位整型内联参数（零堆分配）
+     * @param key 参数键
+     * @param value 参数值
+     */
+    void setInt64(quint32 key, qint64 value);
+
+    /**
+     * @brief 设置浮点内联参数（零堆分配）
+     * @param key 参数键
+     * @param value 参数值
+     */
+    void setFloat(quint32 key, float value);
+
+    /**
+     * @brief 设置布尔内联参数（零堆分配）
+     * @param key 参数键
+     * @param value 参数值
+     */
+    void setBool(quint32 key, bool value);
+
+    /**
+     * @brief 读取整型内联参数
+     * @param key 参数键
+     * @param defaultValue 键不存在时的默认值
+     * @return int 参数值
+     */
+    int getInt(quint32 key, int defaultValue = 0) const;
+
+    /**
+     * @brief 读取64位整型内联参数
+     * @param key 参数键
+     * @param defaultValue 键不存在时的默认值
+     * @return qint64 参数值
+     */
+    qint64 getInt64(quint32 key, qint64 defaultValue = 0) const;
+
+    /**
+     * @brief 读取浮点内联参数
+     * @param key 参数键
+     * @param defaultValue 键不存在时的默认值
+     * @return float 参数值
+     */
+    float getFloat(quint32 key, float defaultValue = 0.0f) const;
+
+    /**
+     * @brief 读取布尔内联参数
+     * @param key 参数键
+     * @param defaultValue 键不存在时的默认值
+     * @return bool 参数值
+     */
+    bool getBool(quint32 key, bool defaultValue = false) const;
+
+    /**
+     * @brief 检查内联参数是否存在
+     * @param key 参数键
+     * @return bool 存在返回true
+     */
+    bool hasParam(quint32 key) const;
+
+    /**
+     * @brief 获取内联参数数量
+     * @return int 已使用的参数槽数
+     */
+    int paramCount() const { return m_paramCount; }
+
+    // ==================== QVariant负载（冷路径） ====================
+
     /**
      * @brief 设置事件数据
      * @param key 数据键
@@ -144,10 +290,55 @@ public:
     QMap<QString, QVariant> getAllData() const { return m_data; }
 
 private:
+    /**
+     * @brief 内联参数值类型标签
+     */
+    enum class ParamType : quint8 {
+        Empty,   ///< 空槽
+        Int,     ///< int
+        Int64,   ///< qint64
+        Float,   ///< float
+        Bool     ///< bool
+    };
+
+    /**
+     * @brief 内联参数槽
+     *
+     * 直接嵌在事件对象内，随事件在队列槽位间复制，无堆分配。
+     */
+    struct Param {
+        quint32 key = 0;                     ///< 参数键（paramKey哈希）
+        ParamType type = ParamType::Empty;   ///< 值类型标签
+        union {
+            int i;
+            qint64 i64;
+            float f;
+            bool b;
+        } value = {0};                       ///< 类型化值存储
+    };
+
+    /**
+     * @brief 查找或分配参数槽
+     * @param key 参数键
+     * @return Param* 槽位指针；槽位用尽返回nullptr
+     */
+    Param* findOrAllocateParam(quint32 key);
+
+    /**
+     * @brief 查找参数槽
+     * @param key 参数键
+     * @return const Param* 槽位指针；不存在返回nullptr
+     */
+    const Param* findParam(quint32 key) const;
+
     Type m_type;                        ///< 事件类型
     Priority m_priority;                ///< 事件优先级
     qint64 m_timestamp;                 ///< 事件时间戳
-    QMap<QString, QVariant> m_data;     ///< 事件数据
+    Param m_params[MAX_INLINE_PARAMS];  ///< 内联参数槽（热路径）
+    int m_paramCount = 0;               ///< 已使用的参数槽数
+    QMap<QString, QVariant> m_data;     ///< 事件数据（冷路径；未使用时不分配）
+
+    static std::atomic<quint64> s_copyCount;  ///< 进程内拷贝计数（诊断用）
 };
 
 /**
@@ -168,10 +359,78 @@ public:
     virtual bool handleEvent(const GameEvent &event) = 0;
 };
 
+/**
+ * @brief 无锁有界事件队列
+ *
+ * 多生产者/多消费者的环形队列（Vyukov算法）：每个槽位带
+ * 序列号，入队/出队只做一次CAS和一次发布写，任意线程调用
+ * postEvent都不会阻塞、不会分配内存。队列满时入队失败，
+ * 由调用方走加锁的溢出路径兜底。
+ */
+class BoundedEventQueue
+{
+public:
+    /// 队列容量（必须是2的幂）
+    static constexpr int CAPACITY = 1024;
+
+    BoundedEventQueue();
+
+    BoundedEventQueue(const BoundedEventQueue&) = delete;
+    BoundedEventQueue& operator=(const BoundedEventQueue&) = delete;
+
+    /**
+     * @brief 尝试入队（无锁，任意线程可调用）
+     * @param event 事件对象
+     * @return 队列已满返回false
+     */
+    bool tryEnqueue(const GameEvent &event);
+
+    /**
+     * @brief 尝试入队（移动版本，事件被移入槽位，不发生拷贝）
+     * @param event 事件对象（右值）
+     * @return 队列已满返回false，此时事件未被移动
+     */
+    bool tryEnqueue(GameEvent &&event);
+
+    /**
+     * @brief 尝试出队（无锁，任意线程可调用）
+     * @param event 输出参数，事件从槽位移出
+     * @return 队列为空返回false
+     */
+    bool tryDequeue(GameEvent &event);
+
+    /**
+     * @brief 获取近似队列长度
+     * @return 事件数量（并发下为近似值）
+     */
+    int size() const;
+
+private:
+    /**
+     * @brief 队列槽位
+     *
+     * sequence编码槽位状态：等于入队位置表示空闲可写，
+     * 等于入队位置+1表示已填充可读。
+     */
+    struct Cell {
+        std::atomic<qint64> sequence{0};            ///< 槽位序列号
+        GameEvent event{GameEvent::Type::Custom};   ///< 事件存储
+    };
+
+    static constexpr qint64 MASK = CAPACITY - 1;    ///< 下标掩码
+
+    std::array<Cell, CAPACITY> m_cells;                  ///< 槽位数组
+    alignas(64) std::atomic<qint64> m_enqueuePos{0};     ///< 入队位置（独占缓存行）
+    alignas(64) std::atomic<qint64> m_dequeuePos{0};     ///< 出队位置（独占缓存行）
+};
+
 /**
  * @brief 事件系统类
- * 
- * 游戏事件系统的核心类，负责事件的注册、分发和管理
+ *
+ * 游戏事件系统的核心类，负责事件的注册、分发和管理。
+ *
+ * 线程模型：postEvent可在任意线程调用（无锁队列）；
+ * 注册/注销监听器与processEventQueue只能在主线程调用。
  */
 class EventSystem : public QObject
 {
@@ -207,47 +466,106 @@ public:
     /**
      * @brief 发送异步事件
      * @param event 事件对象
-     * 
-     * 将事件加入队列，在下一个事件循环中处理
+     *
+     * 将事件加入无锁队列，在下一个事件循环中处理。
+     * 可在任意线程调用，常规路径不加锁、不分配内存。
      */
     void postEvent(const GameEvent &event);
-    
+
+    /**
+     * @brief 发送异步事件（移动版本）
+     * @param event 事件对象（右值）
+     *
+     * 事件被移动进队列槽位，端到端不发生拷贝。临时构造的
+     * 事件直接传入即可命中此重载。
+     */
+    void postEvent(GameEvent &&event);
+
     /**
      * @brief 发送延迟事件
      * @param event 事件对象
      * @param delayMs 延迟毫秒数
-     * 
-     * 在指定延迟后发送事件
+     *
+     * 在指定延迟后发送事件。事件挂入时间轮对应槽位，
+     * 成本为一次数组插入，不创建任何定时器。
      */
     void sendDelayedEvent(const GameEvent &event, int delayMs);
+
+    /**
+     * @brief 发送延迟事件（移动版本，事件被移入时间轮槽位）
+     * @param event 事件对象（右值）
+     * @param delayMs 延迟毫秒数
+     */
+    void sendDelayedEvent(GameEvent &&event, int delayMs);
+
+    /**
+     * @brief 按服务器时间戳发送延迟事件
+     * @param event 事件对象（右值）
+     * @param serverTimeMs 到期时刻（服务器墙钟毫秒）
+     *
+     * buff到期等由服务器下发绝对时间戳的事件走此入口：经
+     * SyncedClock把服务器时刻换算成本地延迟（钟差与漂移已
+     * 补偿）后挂入时间轮，到期判定不需要逐事件的服务器往返。
+     * 已过期的时间戳按最小延迟（下一轮推进）发送。
+     */
+    void sendDelayedEventAtServerTime(GameEvent &&event, qint64 serverTimeMs);
+
+    /**
+     * @brief 帧驱动入口：处理异步队列并推进延迟事件时间轮
+     *
+     * 由GameEngine的游戏循环每帧调用。首次调用后内部的
+     * 回退定时器自动停止，事件系统完全由帧循环驱动。
+     *
+     * @param elapsedMs 距上一帧的实际流逝毫秒数
+     */
+    void advanceFrame(qint64 elapsedMs);
     
     // ==================== 监听器管理接口 ====================
     
     /**
      * @brief 注册事件监听器
+     *
+     * 插入到对应类型分发槽的有序位置（按优先级降序），并登记
+     * 到句柄索引与监听器反向索引，批量注销不再扫描全表。
+     *
      * @param eventType 事件类型
      * @param listener 监听器对象
      * @param priority 监听器优先级（数值越大优先级越高）
+     * @return int 稳定注册句柄（0表示注册失败）
      */
-    void registerListener(GameEvent::Type eventType, IEventListener* listener, int priority = 0);
-    
+    int registerListener(GameEvent::Type eventType, IEventListener* listener, int priority = 0);
+
     /**
      * @brief 注册事件处理函数
      * @param eventType 事件类型
      * @param handler 处理函数
      * @param priority 处理器优先级
+     * @return int 稳定注册句柄（0表示注册失败）
      */
-    void registerHandler(GameEvent::Type eventType, const EventHandler &handler, int priority = 0);
-    
+    int registerHandler(GameEvent::Type eventType, const EventHandler &handler, int priority = 0);
+
+    /**
+     * @brief 按句柄取消单条注册
+     *
+     * 经句柄索引直达所在分发槽，只在该槽内定位移除。
+     *
+     * @param handle registerListener/registerHandler返回的句柄
+     */
+    void unregisterHandle(int handle);
+
     /**
      * @brief 取消注册监听器
      * @param eventType 事件类型
      * @param listener 监听器对象
      */
     void unregisterListener(GameEvent::Type eventType, IEventListener* listener);
-    
+
     /**
      * @brief 取消注册所有监听器
+     *
+     * 经监听器反向索引取出其全部注册句柄，逐条在所属分发槽
+     * 内移除；场景切换时成百个控件注销不再按类型全表扫描。
+     *
      * @param listener 监听器对象
      */
     void unregisterAllListeners(IEventListener* listener);
@@ -277,11 +595,30 @@ public:
     
     /**
      * @brief 处理事件队列
-     * 
-     * 处理所有待处理的异步事件
+     *
+     * 在时间预算内处理待处理的异步事件：事件按优先级分桶，
+     * 从Critical到Low依次分发，预算耗尽即停；未处理完的事件
+     * 结转到下一帧并提升一级优先级（老化），事件风暴被摊到
+     * 多帧而不是一次性炸掉帧预算，低优先级事件也不会饿死。
      */
     void processEventQueue();
-    
+
+    /**
+     * @brief 设置单次队列处理的时间预算
+     *
+     * 预算只约束异步队列的分发耗时，时间轮推进与同步事件
+     * 不受影响。
+     *
+     * @param budgetUs 预算微秒数；0表示不限预算（整队排空）
+     */
+    void setProcessingBudget(qint64 budgetUs);
+
+    /**
+     * @brief 获取单次队列处理的时间预算
+     * @return qint64 预算微秒数（0表示不限）
+     */
+    qint64 processingBudget() const { return m_processBudgetUs; }
+
     /**
      * @brief 清空事件队列
      */
@@ -324,6 +661,9 @@ signals:
 private slots:
     /**
      * @brief 处理定时器事件
+     *
+     * 回退驱动路径：GameEngine帧循环接管（advanceFrame）之前，
+     * 由内部定时器以固定节奏驱动队列处理与时间轮推进。
      */
     void onTimerTimeout();
 
@@ -342,11 +682,12 @@ private:
         EventHandler handler;
         int priority;
         bool isHandler;  // 区分监听器和处理函数
-        
-        ListenerInfo(IEventListener* l, int p) 
-            : listener(l), priority(p), isHandler(false) {}
-        ListenerInfo(const EventHandler& h, int p) 
-            : listener(nullptr), handler(h), priority(p), isHandler(true) {}
+        int id;          // 稳定注册句柄（哈希索引键）
+
+        ListenerInfo(IEventListener* l, int p, int handleId)
+            : listener(l), priority(p), isHandler(false), id(handleId) {}
+        ListenerInfo(const EventHandler& h, int p, int handleId)
+            : listener(nullptr), handler(h), priority(p), isHandler(true), id(handleId) {}
     };
     
     /**
@@ -360,12 +701,62 @@ private:
     
     /**
      * @brief 延迟事件结构
+     *
+     * remainingRounds表示事件还要在时间轮上转满几圈才到期，
+     * 超出一圈时间跨度的延迟由它承载。
      */
     struct DelayedEvent {
         GameEvent event;
-        qint64 triggerTime;
+        int remainingRounds;
     };
+
+    /// 时间轮槽位数（2的幂）
+    static constexpr int WHEEL_SLOT_COUNT = 256;
+
+    /// 每个槽位覆盖的时间跨度（毫秒），与帧循环节奏同量级
+    static constexpr int WHEEL_SLOT_MS = 16;
+
+    /// 优先级层级数（Low..Critical）
+    static constexpr int PRIORITY_LEVEL_COUNT =
+        static_cast<int>(GameEvent::Priority::Critical) + 1;
+
+    /// 默认处理预算（微秒）：约2ms，给渲染与游戏逻辑留足余量
+    static constexpr qint64 DEFAULT_PROCESS_BUDGET_US = 2000;
+
+    /**
+     * @brief 收取待处理事件到优先级桶
+     *
+     * 把无锁队列与溢出队列一次性排空，按事件优先级分桶。
+     * 上一帧结转的事件已在桶内（且优先级已提升），本帧新事件
+     * 排在同优先级的结转事件之后，桶内保持FIFO。
+     */
+    void collectPendingEvents();
+
+    /**
+     * @brief 推进延迟事件时间轮
+     *
+     * 按流逝时间逐槽推进，到期事件整槽批量发送；
+     * 未到期（圈数未满）的事件留在原槽位等待下一圈。
+     *
+     * @param elapsedMs 流逝毫秒数
+     */
+    void advanceTimingWheel(qint64 elapsedMs);
     
+    /**
+     * @brief 事件类型到分发表槽位的映射
+     *
+     * 内建类型直接用枚举值作下标，Custom及以上共享最后一个槽位，
+     * 分发时零哈希、零查找。
+     *
+     * @param type 事件类型
+     * @return int 分发表槽位下标
+     */
+    static int slotForType(GameEvent::Type type);
+
+    /// 分发表槽位数：全部内建类型 + 1个自定义事件槽位
+    static constexpr int DISPATCH_SLOT_COUNT =
+        static_cast<int>(GameEvent::Type::BuiltinEventCount) + 1;
+
     /**
      * @brief 分发事件给监听器
      * @param event 事件对象
@@ -381,22 +772,38 @@ private:
     bool applyEventFilters(const GameEvent &event);
     
     /**
-     * @brief 按优先级排序监听器
-     * @param listeners 监听器列表
+     * @brief 按优先级降序插入监听器（同优先级保持注册顺序）
+     * @param listeners 目标分发槽
+     * @param info 监听器信息
+     */
+    void insertListenerSorted(QList<ListenerInfo> &listeners, const ListenerInfo &info);
+
+    /**
+     * @brief 在句柄所属的分发槽内移除注册
+     * @param handle 注册句柄
+     * @return 被移除注册的监听器指针（处理函数注册返回nullptr）
      */
-    void sortListenersByPriority(QList<ListenerInfo> &listeners);
+    IEventListener* removeRegistration(int handle);
 
 private:
     static EventSystem* s_instance;                                    ///< 单例实例
-    QMap<GameEvent::Type, QList<ListenerInfo>> m_listeners;           ///< 事件监听器映射
-    QQueue<GameEvent> m_eventQueue;                                   ///< 异步事件队列
-    QList<DelayedEvent> m_delayedEvents;                             ///< 延迟事件列表
+    std::array<QList<ListenerInfo>, DISPATCH_SLOT_COUNT> m_dispatchTable;  ///< 预排序分发表（按类型索引）
+    BoundedEventQueue m_eventQueue;                                   ///< 无锁异步事件队列
+    QQueue<GameEvent> m_overflowQueue;                                ///< 无锁队列满时的溢出队列（加锁冷路径）
+    std::array<QList<GameEvent>, PRIORITY_LEVEL_COUNT> m_pendingBuckets;  ///< 按优先级分桶的待处理事件（含结转）
+    qint64 m_processBudgetUs;                                        ///< 单次处理时间预算（微秒，0=不限）
+    std::array<QList<DelayedEvent>, WHEEL_SLOT_COUNT> m_timingWheel;  ///< 延迟事件时间轮
+    int m_currentWheelSlot;                                          ///< 时间轮当前槽位
+    qint64 m_wheelRemainderMs;                                       ///< 不足一个槽位的累积时间
     QList<FilterInfo> m_eventFilters;                                ///< 事件过滤器列表
     QMap<GameEvent::Type, int> m_eventStats;                        ///< 事件统计
     QTimer* m_processTimer;                                          ///< 事件处理定时器
     bool m_eventLogging;                                            ///< 是否启用事件日志
     int m_nextFilterId;                                             ///< 下一个过滤器ID
-    mutable QMutex m_queueMutex;                                      ///< 队列互斥锁   
+    int m_nextListenerHandle = 1;                                    ///< 下一个注册句柄（0保留为无效）
+    QHash<int, quint16> m_handleSlots;                               ///< 句柄到分发槽的索引
+    QHash<IEventListener*, QVarLengthArray<int, 4>> m_listenerHandles; ///< 监听器到其全部句柄的反向索引
+    mutable QMutex m_queueMutex;                                      ///< 溢出队列互斥锁
 };
 
 // ==================== 便利内联函数 ====================
@@ -429,7 +836,7 @@ inline void sendGameEvent(GameEvent::Type type, const QJsonObject &data) {
  */
 inline void postGameEvent(GameEvent::Type type) {
     GameEvent event(type);
-    EventSystem::instance()->postEvent(event);
+    EventSystem::instance()->postEvent(std::move(event));
 }
 
 /**
@@ -442,7 +849,7 @@ inline void postGameEvent(GameEvent::Type type, const QJsonObject &data) {
     for (auto it = data.begin(); it != data.end(); ++it) {
         event.setData(it.key(), it.value().toVariant());
     }
-    EventSystem::instance()->postEvent(event);
+    EventSystem::instance()->postEvent(std::move(event));
 }
 
 // 保留旧宏以兼容已有代码，但推荐使用上方的内联函数
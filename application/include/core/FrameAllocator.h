@@ -0,0 +1,168 @@
+/*
+ * 文件名: FrameAllocator.h
+ * 说明: 帧作用域线性分配器，服务于每帧临时容器。
+ * 作者: 彭承康
+ * 创建时间: 2026-02-18
+ *
+ * 每帧的临时对象（事件派发缓冲、动画变更列表、渲染批次的
+ * 分组数组等）如果逐个走全局堆分配，malloc压力会直接体现为
+ * 帧时间抖动。本分配器在固定缓冲区上做指针碰撞分配：分配是
+ * 一次指针前移，释放是空操作，GameEngine在帧末统一reset回收
+ * 整块内存。配套的FrameAlloc适配器让std容器可以直接从这里
+ * 取内存。
+ *
+ * 约束：
+ * - 仅限主线程使用（帧末reset与分配之间没有同步）；
+ * - 从这里分配的容器必须在当帧用完，严禁跨帧持有；
+ * - 缓冲区耗尽时自动回退到堆分配（由分配器在reset时回收），
+ *   功能不受影响，只是失去零malloc的收益。
+ */
+#pragma once
+
+#include <QtGlobal>
+#include <cstddef>
+#include <new>
+#include <vector>
+
+/**
+ * @brief 帧作用域线性分配器
+ *
+ * 从预分配的固定缓冲区顺序切分内存，reset()把写入位置拨回
+ * 起点。由GameEngine持有并在每帧末尾reset；其余子系统通过
+ * active()拿到当前帧的分配器。
+ */
+class FrameAllocator
+{
+public:
+    /**
+     * @brief 构造分配器
+     * @param capacityBytes 固定缓冲区大小（字节）
+     */
+    explicit FrameAllocator(std::size_t capacityBytes = DEFAULT_CAPACITY_BYTES);
+
+    ~FrameAllocator();
+
+    FrameAllocator(const FrameAllocator&) = delete;
+    FrameAllocator& operator=(const FrameAllocator&) = delete;
+
+    /**
+     * @brief 分配一块内存
+     *
+     * 缓冲区内按align对齐碰撞分配；剩余空间不足时回退到
+     * ::operator new，溢出块登记在内部列表中由reset()释放。
+     *
+     * @param bytes 字节数
+     * @param align 对齐要求
+     * @return void* 分配的内存，生存期到下一次reset()为止
+     */
+    void* allocate(std::size_t bytes, std::size_t align);
+
+    /**
+     * @brief 回收整帧内存
+     *
+     * 写入位置拨回缓冲区起点并释放所有溢出块。调用前必须
+     * 保证本帧从这里分配的容器已全部析构。
+     */
+    void reset();
+
+    /**
+     * @brief 本帧已从缓冲区分配的字节数
+     */
+    std::size_t bytesUsed() const { return offset_used_; }
+
+    /**
+     * @brief 历史单帧用量峰值（字节），用于容量调参
+     */
+    std::size_t highWaterMark() const { return high_water_mark_; }
+
+    /**
+     * @brief 累计溢出到堆的次数
+     *
+     * 非零说明缓冲区偏小，溢出帧正在付malloc的开销。
+     */
+    quint64 overflowCount() const { return overflow_count_; }
+
+    /**
+     * @brief 当前帧的分配器（主线程）
+     * @return FrameAllocator* 未设置时为nullptr
+     */
+    static FrameAllocator* active() { return s_active; }
+
+    /**
+     * @brief 设置当前帧分配器
+     *
+     * 由GameEngine在初始化时登记、析构时清除。
+     */
+    static void setActive(FrameAllocator *allocator) { s_active = allocator; }
+
+    /// 默认缓冲区大小：1MB，覆盖密集战斗场景的单帧临时量
+    static constexpr std::size_t DEFAULT_CAPACITY_BYTES = 1024 * 1024;
+
+private:
+    char *buffer_;                       ///< 固定缓冲区
+    std::size_t capacity_;               ///< 缓冲区大小
+    std::size_t offset_used_;            ///< 当前写入位置
+    std::size_t high_water_mark_;        ///< 单帧用量峰值
+    quint64 overflow_count_;             ///< 累计溢出次数
+    std::vector<void*> overflow_blocks_; ///< 本帧的堆溢出块
+
+    static FrameAllocator *s_active;     ///< 当前帧分配器（主线程）
+};
+
+/**
+ * @brief 帧分配器的STL适配器
+ *
+ * 构造时捕获FrameAllocator::active()：有分配器时从帧缓冲取
+ * 内存且deallocate为空操作；没有（独立测试、引擎未初始化）
+ * 时退化为普通堆分配器，行为不变。
+ *
+ * @tparam T 元素类型
+ */
+template <typename T>
+class FrameAlloc
+{
+public:
+    using value_type = T;
+
+    FrameAlloc() noexcept : arena_(FrameAllocator::active()) {}
+
+    template <typename U>
+    FrameAlloc(const FrameAlloc<U> &other) noexcept : arena_(other.arena()) {}
+
+    T* allocate(std::size_t n)
+    {
+        if (arena_ != nullptr) {
+            return static_cast<T*>(arena_->allocate(n * sizeof(T), alignof(T)));
+        }
+        return static_cast<T*>(::operator new(n * sizeof(T)));
+    }
+
+    void deallocate(T *p, std::size_t) noexcept
+    {
+        // 帧内存由reset()整块回收；堆退化模式下逐块释放
+        if (arena_ == nullptr) {
+            ::operator delete(p);
+        }
+    }
+
+    FrameAllocator* arena() const noexcept { return arena_; }
+
+    template <typename U>
+    bool operator==(const FrameAlloc<U> &other) const noexcept
+    {
+        return arena_ == other.arena();
+    }
+
+    template <typename U>
+    bool operator!=(const FrameAlloc<U> &other) const noexcept
+    {
+        return !(*this == other);
+    }
+
+private:
+    FrameAllocator *arena_;
+};
+
+/// 从帧分配器取内存的vector，限当帧使用
+template <typename T>
+using FrameVector = std::vector<T, FrameAlloc<T>>;
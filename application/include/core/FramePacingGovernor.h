@@ -0,0 +1,134 @@
+/*
+ * 文件名: FramePacingGovernor.h
+ * 说明: 帧节奏调节器，按帧耗时百分位动态调整特效细节层级。
+ * 作者: 彭承康
+ * 创建时间: 2026-08-28
+ *
+ * 低端机器上战斗特效高峰会把帧耗时推过预算，帧率在60与30之间
+ * 来回振荡。本类维护最近若干帧实测耗时的滚动窗口，周期性计算
+ * 高百分位（毛刺而非均值决定观感），持续超过目标帧时则下调一
+ * 档细节层级，持续低于恢复阈值才回升——两个阈值之间留有迟滞
+ * 区间，加上换档驻留期，保证不会在临界负载下来回换档。
+ *
+ * 细节层级本身不做任何渲染工作，只向消费方广播：
+ * - AnimationManager::setDetailLevel 降低动画推进频率
+ * - SpriteRenderer::setEffectDensity 跳过逐像素色调合成
+ * - GameEngine 按层级降低HUD属性信号的发射频率
+ *
+ * 接入示例:
+ *   connect(engine->getPacingGovernor(), &FramePacingGovernor::detailLevelChanged,
+ *           animationManager, &AnimationManager::setDetailLevel);
+ */
+#pragma once
+
+#include <QObject>
+#include <QVector>
+
+/**
+ * @brief 帧节奏调节器
+ *
+ * GameEngine每帧调用addFrameSample喂入实测帧耗时；每积累
+ * EVALUATE_INTERVAL个样本评估一次窗口的高百分位并按迟滞
+ * 规则换档。所有调用都应发生在主线程（游戏循环线程）上。
+ */
+class FramePacingGovernor : public QObject
+{
+    Q_OBJECT
+
+    Q_PROPERTY(int detailLevel READ detailLevel NOTIFY detailLevelChanged)
+
+public:
+    /** @brief 细节层级数：0全细节、1降档、2保底 */
+    static constexpr int LEVEL_COUNT = 3;
+
+    /** @brief 滚动窗口容量（帧数，约两秒） */
+    static constexpr int SAMPLE_WINDOW = 120;
+
+    /** @brief 每积累多少样本评估一次换档 */
+    static constexpr int EVALUATE_INTERVAL = 30;
+
+    /** @brief 评估用的百分位（毛刺决定观感，取p95而非均值） */
+    static constexpr float PERCENTILE = 0.95f;
+
+    /** @brief 降档阈值：p95超过目标帧时的该倍数则降档 */
+    static constexpr float DEGRADE_RATIO = 1.15f;
+
+    /** @brief 升档阈值：p95低于目标帧时的该倍数才回升 */
+    static constexpr float RECOVER_RATIO = 0.70f;
+
+    /** @brief 换档后的驻留评估次数，抑制临界负载下的振荡 */
+    static constexpr int DWELL_EVALUATIONS = 4;
+
+    /**
+     * @brief 构造函数
+     * @param parent 父对象指针
+     */
+    explicit FramePacingGovernor(QObject *parent = nullptr);
+
+    /**
+     * @brief 设置目标帧时（毫秒）
+     *
+     * 默认为60FPS对应的16.7毫秒；低端机配置可放宽到33.3毫秒
+     * 以稳定30FPS为目标。
+     *
+     * @param targetMs 目标帧时，非正值被忽略
+     */
+    void setTargetFrameTime(float targetMs);
+
+    /**
+     * @brief 获取目标帧时（毫秒）
+     */
+    float targetFrameTime() const { return m_targetMs; }
+
+    /**
+     * @brief 喂入一帧的实测耗时
+     *
+     * 由GameEngine::update在帧末调用，传入本帧实际工作耗时
+     * （不含定时器等待）。积满EVALUATE_INTERVAL个样本时就地
+     * 评估换档。
+     *
+     * @param frameMs 本帧工作耗时（毫秒）
+     */
+    void addFrameSample(float frameMs);
+
+    /**
+     * @brief 当前细节层级（0=全细节，LEVEL_COUNT-1=保底）
+     */
+    int detailLevel() const { return m_level; }
+
+    /**
+     * @brief 当前层级对应的特效密度系数（0.0~1.0）
+     */
+    float effectDensity() const;
+
+    /**
+     * @brief 最近一次评估的高百分位帧时（毫秒）
+     *
+     * 尚未评估过时返回0，供调试覆盖层显示。
+     */
+    float lastPercentileMs() const { return m_lastPercentileMs; }
+
+signals:
+    /**
+     * @brief 细节层级改变信号
+     * @param level 新层级
+     * @param effectDensity 新层级的特效密度系数
+     */
+    void detailLevelChanged(int level, float effectDensity);
+
+private:
+    /**
+     * @brief 评估窗口百分位并按迟滞规则换档
+     */
+    void evaluate();
+
+    float m_targetMs;                  ///< 目标帧时（毫秒）
+    QVector<float> m_samples;          ///< 滚动窗口环形缓冲
+    QVector<float> m_scratch;          ///< 百分位计算的暂存数组
+    int m_sampleHead = 0;              ///< 环形缓冲写入位置
+    int m_sampleCount = 0;             ///< 窗口内有效样本数
+    int m_samplesSinceEvaluate = 0;    ///< 距上次评估的样本数
+    int m_level = 0;                   ///< 当前细节层级
+    int m_dwellLeft = 0;               ///< 剩余驻留评估次数
+    float m_lastPercentileMs = 0.0f;   ///< 最近一次评估结果
+};
@@ -12,11 +12,14 @@
 
 #include <QObject>
 #include <QTimer>
+#include <QElapsedTimer>
 #include <QJsonObject>
 #include <memory>
+#include "core/FrameAllocator.h"
 #include "game/InventorySystem.h"
 
 // 前向声明
+class JobSystem;
 class SceneManager;
 class ResourceManager;
 class NetworkManager;
@@ -24,6 +27,11 @@ class AudioManager;
 class GameState;
 class Player;
 class BattleSystem;
+class BattleSessionCache;
+class InputManager;
+class IdleMaintenanceScheduler;
+class FramePacingGovernor;
+class MailboxHub;
 /**
  * @brief 游戏状态枚举
  * 
@@ -62,6 +70,7 @@ class GameEngine : public QObject
     Q_PROPERTY(bool isInitialized READ isInitialized NOTIFY initializationChanged)
     Q_PROPERTY(float deltaTime READ deltaTime NOTIFY deltaTimeChanged)
     Q_PROPERTY(int frameRate READ frameRate NOTIFY frameRateChanged)
+    Q_PROPERTY(float renderAlpha READ renderAlpha NOTIFY renderAlphaChanged)
 
 public:
     /**
@@ -104,6 +113,10 @@ public:
 
     /**
      * @brief 获取背包系统实例
+     *
+     * 背包系统延迟创建，引擎初始化后到gameSystemsReady发出前
+     * 可能返回nullptr，需要立即使用时先调用ensureGameSystemsReady()。
+     *
      * @return 背包系统指针，供QML访问
      */
     Game::InventorySystem* getInventorySystem() const {
@@ -124,13 +137,110 @@ public:
 
     /**
      * @brief 获取战斗系统实例
+     *
+     * 与背包系统一样延迟创建，gameSystemsReady发出前可能返回nullptr。
+     *
      * @return 战斗系统指针，供QML访问
      */
     BattleSystem* getBattleSystem() const { return m_battleSystem.get(); }
+
+    /**
+     * @brief 延迟创建的游戏系统是否已就绪
+     * @return 背包系统与战斗系统均已创建时返回true
+     */
+    Q_INVOKABLE bool areGameSystemsReady() const {
+        return m_battleSystem != nullptr && m_inventorySystem != nullptr;
+    }
+
+    /**
+     * @brief 确保延迟创建的游戏系统已就绪
+     *
+     * 初始化只构建主菜单所需的状态与玩家数据，背包系统（物品库
+     * 与存档文件读取）和战斗系统推迟到菜单显示后的事件循环空闲时
+     * 创建；进入游戏流程的入口在使用前调用本方法就地补建。
+     * 首次完成创建时发出gameSystemsReady信号。
+     */
+    void ensureGameSystemsReady();
+
+    /**
+     * @brief 获取任务调度系统实例
+     * @return 任务系统指针，供子系统提交后台任务
+     */
+    JobSystem* getJobSystem() const { return m_jobSystem; }
+
+    /**
+     * @brief 获取信箱枢纽
+     *
+     * 工作线程产出的主线程回调经此处的SPSC信箱投递，
+     * update()每帧统一排空。无法拿到引擎引用的生产方可经
+     * MailboxHub::active()访问。
+     *
+     * @return 信箱枢纽指针
+     */
+    MailboxHub* getMailboxHub() const { return m_mailboxHub.get(); }
+
+    /**
+     * @brief 获取帧作用域分配器
+     *
+     * 每帧临时容器（FrameVector等）从这里取内存，帧末update()
+     * 统一reset回收。子系统也可以经FrameAllocator::active()访问。
+     *
+     * @return 帧分配器指针
+     */
+    FrameAllocator* getFrameAllocator() const { return m_frameAllocator.get(); }
+
+    /**
+     * @brief 获取空闲维护调度器
+     *
+     * 子系统在此注册增量维护任务（资源清理、存档压缩、缓存
+     * 裁剪等）。引擎在非模拟状态（主菜单、暂停、结算）检测到
+     * 帧预算余量时驱动这些任务，深度清理不与游戏帧争抢时间。
+     *
+     * @return 空闲维护调度器指针
+     */
+    IdleMaintenanceScheduler* getIdleScheduler() const { return m_idleScheduler.get(); }
+
+    /**
+     * @brief 获取帧节奏调节器
+     *
+     * 引擎每帧把实测工作耗时喂给调节器；调节器按滚动窗口的
+     * 高百分位帧时换档细节层级。特效消费方（动画管理器、精灵
+     * 渲染器等）在此连接detailLevelChanged接受降档，引擎自身
+     * 按层级降低HUD属性信号的发射频率。
+     *
+     * @return 帧节奏调节器指针
+     */
+    FramePacingGovernor* getPacingGovernor() const { return m_pacingGovernor.get(); }
+
+    /**
+     * @brief 挂接输入管理器（可选，不转移所有权）
+     *
+     * 挂接后固定步长循环在每个模拟步之前按该步覆盖的时间区间
+     * 重放输入事件（InputManager::applyEventsUntil）：事件在到达
+     * 时打时间戳，在覆盖其时间戳的模拟步里生效。帧跑长补跑多步
+     * 时输入延迟保持恒定，不随帧长波动。
+     *
+     * @param inputManager 输入管理器指针，nullptr解除挂接
+     */
+    void setInputManager(InputManager *inputManager) { m_inputManager = inputManager; }
     
+    /**
+     * @brief 无头回放一场战斗
+     *
+     * 加载回放文件，恢复录制时的玩家属性快照，在不进入游戏
+     * 循环的情况下同步重放整场战斗：RNG由记录的种子驱动，
+     * RPC响应来自记录、不经网络，过程与原始战斗逐位一致。
+     * 回放全程开启性能监控，结束后把性能档案导出到回放文件
+     * 旁的.profile.json，用于离线分析玩家报告的卡顿。
+     *
+     * @param filePath 回放文件路径
+     * @return bool 回放是否完整执行到战斗结束
+     */
+    bool runBattleReplay(const QString &filePath);
+
     /**
      * @brief 启动游戏引擎
-     * 
+     *
      * 启动游戏循环，开始游戏运行。
      */
     void start();
@@ -174,11 +284,23 @@ public:
     
     /**
      * @brief 获取帧率
-     * 
+     *
      * @return int 当前帧率（FPS）
      */
     int frameRate() const { return m_frameRate; }
 
+    /**
+     * @brief 获取渲染插值系数
+     *
+     * 固定步长模拟与渲染解耦后，渲染帧通常落在两个模拟帧之间。
+     * 该系数表示当前渲染时刻在上一模拟帧（0.0）与最新模拟帧（1.0）
+     * 之间的位置，渲染端据此对位置等状态做线性插值，高刷新率
+     * 显示器上画面依然平滑。
+     *
+     * @return float 插值系数（0.0 ~ 1.0）
+     */
+    float renderAlpha() const { return m_renderAlpha; }
+
     // 游戏控制接口
     
     /**
@@ -299,7 +421,12 @@ signals:
      * @brief 初始化状态改变信号
      */
     void initializationChanged();
-    
+
+    /**
+     * @brief 延迟创建的游戏系统（背包、战斗）全部就绪
+     */
+    void gameSystemsReady();
+
     /**
      * @brief 帧时间改变信号
      */
@@ -309,6 +436,11 @@ signals:
      * @brief 帧率改变信号
      */
     void frameRateChanged();
+
+    /**
+     * @brief 渲染插值系数改变信号
+     */
+    void renderAlphaChanged();
     
     /**
      * @brief 新游戏开始信号
@@ -354,8 +486,11 @@ signals:
 private slots:
     /**
      * @brief 游戏循环更新
-     * 
-     * 主游戏循环，处理游戏逻辑更新。
+     *
+     * 主游戏循环（累积器模式）：把实际流逝时间累积起来，
+     * 以固定步长 FIXED_TIMESTEP 追赶模拟，剩余不足一步的时间
+     * 折算成渲染插值系数。模拟开销与显示刷新率无关：144Hz
+     * 显示器不会多跑逻辑，低帧率机器上逻辑也不会变慢。
      */
     void update();
     
@@ -392,10 +527,11 @@ private:
     
     /**
      * @brief 处理游戏逻辑更新
-     * 
-     * 更新游戏中的各种逻辑系统。
-     * 
-     * @param deltaTime 帧时间间隔
+     *
+     * 更新游戏中的各种逻辑系统。固定步长模式下每次调用
+     * 传入恒定的 FIXED_TIMESTEP，保证模拟结果与帧率无关。
+     *
+     * @param deltaTime 模拟步长（秒）
      */
     void updateGameLogic(float deltaTime);
     
@@ -424,7 +560,50 @@ private:
      * 控制游戏主循环的定时器。
      */
     QTimer *m_gameTimer;
-    
+
+    /**
+     * @brief 任务调度系统
+     *
+     * 工作窃取线程池，每帧并行执行相互独立的子系统更新。
+     */
+    JobSystem *m_jobSystem;
+
+    /**
+     * @brief 信箱枢纽
+     *
+     * 工作线程→主线程的SPSC信箱登记处，update()每帧排空。
+     */
+    std::unique_ptr<MailboxHub> m_mailboxHub;
+
+    /**
+     * @brief 帧作用域分配器
+     *
+     * 每帧临时容器的线性分配器，update()末尾整块回收。
+     */
+    std::unique_ptr<FrameAllocator> m_frameAllocator;
+
+    /**
+     * @brief 输入管理器引用（可选挂接，不拥有）
+     *
+     * 固定步长循环按模拟步重放其时间戳事件队列。
+     */
+    InputManager *m_inputManager = nullptr;
+
+    /**
+     * @brief 空闲维护调度器
+     *
+     * 非模拟状态的帧预算余量用来驱动注册的增量维护任务。
+     */
+    std::unique_ptr<IdleMaintenanceScheduler> m_idleScheduler;
+
+    /**
+     * @brief 帧节奏调节器
+     *
+     * 按帧耗时百分位动态调整特效细节层级，抑制低端机上的
+     * 帧率振荡。
+     */
+    std::unique_ptr<FramePacingGovernor> m_pacingGovernor;
+
     /**
      * @brief 场景管理器引用
      * 
@@ -467,9 +646,18 @@ private:
      */
     std::unique_ptr<Player> m_player;
     
+    /**
+     * @brief 战斗会话缓存
+     *
+     * 探索期间预协商战斗规则，战斗入场免去取规则的RPC往返。
+     * 声明在战斗系统之前：战斗系统持有其裸指针，析构时后于
+     * 战斗系统销毁。
+     */
+    std::unique_ptr<BattleSessionCache> m_battleSessionCache;
+
     /**
      * @brief 战斗系统
-     * 
+     *
      * 处理战斗逻辑的系统。
      */
     std::unique_ptr<BattleSystem> m_battleSystem;
@@ -511,10 +699,31 @@ private:
     
     /**
      * @brief 上一帧时间
-     * 
+     *
      * 上一帧的时间戳，用于计算帧时间间隔。
      */
     qint64 m_lastFrameTime;
+
+    /**
+     * @brief 单调时钟
+     *
+     * 引擎启动时开始计时，游戏循环据此计算实际流逝时间。
+     */
+    QElapsedTimer m_elapsedTimer;
+
+    /**
+     * @brief 模拟时间累积器
+     *
+     * 尚未被固定步长模拟消费掉的实际流逝时间（秒）。
+     */
+    float m_accumulator;
+
+    /**
+     * @brief 渲染插值系数
+     *
+     * 累积器中不足一个模拟步长的剩余时间占比（0.0 ~ 1.0）。
+     */
+    float m_renderAlpha;
     
     /**
      * @brief 帧计数器
@@ -539,8 +748,49 @@ private:
     
     /**
      * @brief 目标帧率
-     * 
-     * 游戏循环的目标帧率。
+     *
+     * 游戏循环定时器的目标触发频率（渲染节奏）。
      */
     static const int TARGET_FPS = 60;
+
+    /**
+     * @brief 模拟频率
+     *
+     * 固定步长模拟每秒执行的步数，与渲染节奏无关。
+     */
+    static const int SIMULATION_RATE = 60;
+
+    /**
+     * @brief 固定模拟步长（秒）
+     */
+    static constexpr float FIXED_TIMESTEP = 1.0f / SIMULATION_RATE;
+
+    /**
+     * @brief 单帧最大补偿时间（秒）
+     *
+     * 卡顿（断点、窗口拖动等）后累积器被限幅到该值，
+     * 避免一帧内追赶大量模拟步的"死亡螺旋"。
+     */
+    static constexpr float MAX_ACCUMULATED_TIME = 0.25f;
+
+    /**
+     * @brief 空闲维护的帧内安全余量（毫秒）
+     *
+     * 帧预算扣除本帧已耗时与该余量后才分给维护任务，
+     * 保证空闲片不会把帧推过定时器节拍。
+     */
+    static constexpr qint64 IDLE_SAFETY_MARGIN_MS = 4;
+
+    /**
+     * @brief 资源清理任务的最小间隔（毫秒）
+     */
+    static constexpr qint64 RESOURCE_CLEANUP_INTERVAL_MS = 10000;
+
+    /**
+     * @brief 各细节层级的HUD信号发射间隔（帧）
+     *
+     * 降档时deltaTime等高频属性信号每隔若干帧才发射一次，
+     * 减少QML绑定的重求值开销。
+     */
+    static constexpr int HUD_EMIT_DIVISORS[3] = {1, 2, 4};
 };
@@ -0,0 +1,97 @@
+/*
+ * 文件名: IdleMaintenanceScheduler.h
+ * 说明: 空闲帧维护任务调度器，利用帧预算余量执行深度清理。
+ * 作者: 彭承康
+ * 创建时间: 2026-08-28
+ *
+ * 资源清理、存档压缩、缓存裁剪这类维护工作此前要么从不执行，
+ * 要么在不合适的时机执行。本调度器由GameEngine在检测到帧预算
+ * 有余量时（主菜单、暂停等非模拟状态）驱动：注册的任务以增量
+ * 方式执行，每次只占用分给它的时间片，深度清理永远不与游戏
+ * 帧争抢时间。
+ */
+#pragma once
+
+#include <QElapsedTimer>
+#include <QString>
+#include <QVector>
+#include <functional>
+
+/**
+ * @brief 空闲帧维护任务调度器
+ *
+ * 任务按注册顺序轮转。每个任务是一个增量函数：在给定的毫秒
+ * 预算内做一部分工作，返回true表示还有剩余工作（下一个空闲
+ * 片继续），返回false表示本轮完成，经过最小间隔后才会再次
+ * 被调度。调度器按实测耗时扣减预算，预算耗尽立即停止本片。
+ */
+class IdleMaintenanceScheduler
+{
+public:
+    /**
+     * @brief 增量维护任务
+     * @param budgetMs 本次调用可用的时间预算（毫秒）
+     * @return true表示任务还有剩余工作，false表示本轮完成
+     */
+    using MaintenanceTask = std::function<bool(qint64 budgetMs)>;
+
+    /**
+     * @brief 单个任务的运行统计
+     */
+    struct TaskStats {
+        QString name;           ///< 任务名
+        qint64 totalRuns = 0;   ///< 被调度的总次数
+        qint64 totalTimeMs = 0; ///< 累计耗时（毫秒）
+    };
+
+    IdleMaintenanceScheduler();
+
+    /**
+     * @brief 注册一个增量维护任务
+     *
+     * @param name 任务名（统计与日志用）
+     * @param task 增量任务函数
+     * @param minIntervalMs 一轮完成后到下一轮开始的最小间隔（毫秒）
+     */
+    void registerTask(const QString &name, MaintenanceTask task, qint64 minIntervalMs = 0);
+
+    /**
+     * @brief 执行一个空闲时间片
+     *
+     * 从上次停下的位置轮转任务：到期的任务依次获得剩余预算，
+     * 实测耗时从预算中扣除，预算耗尽立即返回。未完成的任务
+     * 保持"热"状态，下个空闲片优先继续。
+     *
+     * @param budgetMs 本片可用的时间预算（毫秒）
+     * @return 实际消耗的时间（毫秒）
+     */
+    qint64 runIdleSlice(qint64 budgetMs);
+
+    /**
+     * @brief 注册任务数
+     */
+    int taskCount() const { return m_tasks.size(); }
+
+    /**
+     * @brief 各任务的运行统计
+     */
+    QVector<TaskStats> taskStats() const;
+
+private:
+    /**
+     * @brief 一个已注册任务及其调度状态
+     */
+    struct TaskEntry {
+        QString name;
+        MaintenanceTask task;
+        qint64 minIntervalMs = 0;
+        qint64 nextEligibleMs = 0;  ///< 早于该时刻不再调度（一轮完成后生效）
+        bool hasPendingWork = false;///< 上次返回true，优先继续
+        qint64 totalRuns = 0;
+        qint64 totalTimeMs = 0;
+    };
+
+    QVector<TaskEntry> m_tasks;
+    QElapsedTimer m_clock;   ///< 构造时启动，提供最小间隔的时间基准
+    int m_nextTaskIndex = 0; ///< 轮转起点，跨时间片保持公平
+};
@@ -0,0 +1,175 @@
+/*
+ * 文件名: JobSystem.h
+ * 说明: 应用层任务调度系统（工作窃取线程池 + 任务依赖图）
+ * 作者: 彭承康
+ * 创建时间: 2026-08-28
+ *
+ * 本类为客户端提供每帧并行任务调度能力：
+ * - 按硬件线程数创建工作线程，每个线程持有自己的任务队列
+ * - 空闲线程从其他线程队列"窃取"任务，负载自动均衡
+ * - 任务可声明依赖（任务图），依赖全部完成后才会被调度
+ * - 完成回调通过Qt队列连接投递回主线程，可安全触碰QObject/QML
+ *
+ * 使用场景：
+ * - GameEngine每帧把相互独立的子系统更新（战斗、动画、事件
+ *   处理等）作为任务提交，帧末waitForAll()同步
+ * - 后台任务（资源解析等）提交后用完成回调通知主线程
+ */
+
+#ifndef CORE_JOBSYSTEM_H
+#define CORE_JOBSYSTEM_H
+
+#include <QObject>
+#include <QVector>
+#include <QHash>
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class MailboxHub;
+
+/**
+ * @brief 工作窃取任务调度系统
+ *
+ * 调度接口只允许在主线程调用；任务函数在工作线程执行，
+ * 不得直接操作属于主线程的QObject。完成回调在主线程执行。
+ */
+class JobSystem : public QObject
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief 任务句柄类型
+     *
+     * schedule返回的递增编号，用于声明后续任务的依赖。
+     */
+    using JobId = quint64;
+
+    /**
+     * @brief 构造函数
+     *
+     * 按硬件线程数创建工作线程（至少1个，预留主线程）。
+     *
+     * @param parent 父对象指针，用于Qt对象树管理
+     */
+    explicit JobSystem(QObject *parent = nullptr);
+
+    /**
+     * @brief 析构函数
+     *
+     * 等待在执行的任务结束后停止全部工作线程。
+     */
+    ~JobSystem() override;
+
+    /**
+     * @brief 提交任务
+     *
+     * 无未完成依赖的任务立即进入某个工作队列；有依赖的任务
+     * 挂起，最后一个依赖完成时自动入队。
+     *
+     * @param work 任务函数，在工作线程执行
+     * @param dependencies 依赖的任务句柄，已完成的依赖自动视为满足
+     * @param onCompleted 完成回调，通过队列连接投递回主线程执行，可为空
+     * @return JobId 任务句柄，供后续任务声明依赖
+     */
+    JobId schedule(std::function<void()> work,
+                   const QVector<JobId> &dependencies = {},
+                   std::function<void()> onCompleted = {});
+
+    /**
+     * @brief 挂接完成回调信箱枢纽（主线程调用，不拥有）
+     *
+     * 挂接后完成回调优先经工作线程的SPSC信箱投递，由
+     * GameEngine帧循环批量排空；信箱满（背压）时回退到
+     * 原有的队列连接路径，回调不丢失。应在首次schedule
+     * 之前挂接。
+     *
+     * @param hub 信箱枢纽指针，nullptr恢复纯队列连接投递
+     */
+    void setCompletionMailboxHub(MailboxHub *hub) { m_completionHub = hub; }
+
+    /**
+     * @brief 等待所有已提交任务完成
+     *
+     * 帧末同步点：阻塞调用线程直到任务图清空。等待期间
+     * 调用线程也参与执行任务，不会干等。
+     */
+    void waitForAll();
+
+    /**
+     * @brief 获取工作线程数量
+     *
+     * @return int 工作线程数
+     */
+    int workerCount() const { return static_cast<int>(m_workers.size()); }
+
+private:
+    /**
+     * @brief 任务节点
+     *
+     * 记录任务函数、剩余依赖计数以及依赖本任务的后继任务。
+     */
+    struct Job {
+        JobId id = 0;                        ///< 任务句柄
+        std::function<void()> work;          ///< 任务函数
+        std::function<void()> onCompleted;   ///< 主线程完成回调
+        int pendingDependencies = 0;         ///< 尚未完成的依赖数
+        QVector<JobId> dependents;           ///< 依赖本任务的后继任务
+    };
+
+    /**
+     * @brief 工作线程主循环
+     *
+     * 优先从自己的队列取任务，取不到则窃取其他队列。
+     *
+     * @param workerIndex 本线程的队列编号
+     */
+    void workerLoop(int workerIndex);
+
+    /**
+     * @brief 取出一个可执行任务
+     *
+     * @param preferredQueue 优先尝试的队列编号
+     * @param job 输出参数，取到的任务
+     * @return bool 是否取到任务
+     */
+    bool tryPopJob(int preferredQueue, std::shared_ptr<Job> &job);
+
+    /**
+     * @brief 执行任务并结算依赖图
+     *
+     * 任务完成后唤醒后继任务、投递主线程回调，并在任务图
+     * 清空时通知waitForAll。
+     *
+     * @param job 待执行的任务
+     */
+    void runJob(const std::shared_ptr<Job> &job);
+
+    /**
+     * @brief 把就绪任务放入最短的工作队列
+     *
+     * @param job 就绪任务
+     */
+    void enqueueReady(const std::shared_ptr<Job> &job);
+
+    std::vector<std::thread> m_workers;                        ///< 工作线程
+    std::vector<std::deque<std::shared_ptr<Job>>> m_queues;    ///< 每线程任务队列
+    mutable std::mutex m_mutex;                                ///< 保护队列与任务图
+    std::condition_variable m_workAvailable;                   ///< 有新任务时唤醒工作线程
+    std::condition_variable m_allIdle;                         ///< 任务图清空时唤醒waitForAll
+
+    QHash<JobId, std::shared_ptr<Job>> m_pendingJobs;          ///< 未完成任务表（含挂起任务）
+    JobId m_nextJobId = 1;                                     ///< 下一个任务句柄
+    int m_unfinishedJobs = 0;                                  ///< 未完成任务计数
+    std::atomic<bool> m_stopping{false};                       ///< 停机标志
+    MailboxHub *m_completionHub = nullptr;                     ///< 完成回调信箱枢纽（不拥有）
+};
+
+#endif // CORE_JOBSYSTEM_H
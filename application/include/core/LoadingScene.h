@@ -3,12 +3,19 @@
  * 说明: 加载场景
  * 作者: 彭承康
  * 创建时间: 2026-02-18
+ *
+ * 初始加载走ResourceManager的流式管线：清单解析后所有条目
+ * 一次性入队，文件读取与解码由工作线程并行完成，缓存注册
+ * 由主线程按帧预算收尾，各阶段相互重叠。本场景只负责驱动
+ * 清单和向UI转发进度。
  */
 #ifndef APPLICATION_CORE_LOADINGSCENE_H
 #define APPLICATION_CORE_LOADINGSCENE_H
 
 #include "core/Scene.h"
 
+#include <QStringList>
+
 class LoadingScene : public Scene {
     Q_OBJECT
 
@@ -21,6 +28,34 @@ public:
     void update(float deltaTime) override;
     void onExit() override;
     void unload() override;
+
+signals:
+    /**
+     * @brief 加载进度变化（0.0-1.0），转发自ResourceManager
+     * @param progress 当前进度
+     */
+    void loadingProgressChanged(float progress);
+
+    /**
+     * @brief 清单中的全部资源加载完成
+     */
+    void loadingCompleted();
+
+private:
+    /**
+     * @brief 解析加载清单
+     *
+     * 清单为JSON文件，resources数组列出初始加载的资源路径。
+     *
+     * @param manifestPath 清单文件路径
+     * @return QStringList 资源路径列表，清单缺失时为空
+     */
+    QStringList parseManifest(const QString& manifestPath) const;
+
+    ResourceManager* resourceManager_ = nullptr;    ///< 资源管理器引用
+    QStringList pendingResources_;                  ///< 清单中待加载的资源
+    float progress_ = 0.0f;                         ///< 最近上报的进度
+    bool completed_ = false;                        ///< 是否已发出完成信号
 };
 
 #endif // APPLICATION_CORE_LOADINGSCENE_H
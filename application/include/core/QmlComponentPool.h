@@ -0,0 +1,127 @@
+/*
+ * 文件名: QmlComponentPool.h
+ * 说明: QML组件对象池头文件
+ * 作者: 彭承康
+ * 创建时间: 2026-08-28
+ *
+ * 本文件定义了QML组件对象池，用于预编译并预实例化高频开关的
+ * QML组件（物品槽、敌人卡片、技能槽、弹窗等）。
+ *
+ * 设计特点：
+ * - QQmlComponent按URL缓存，每个组件只编译一次
+ * - 启动后空闲时预实例化，打开界面时直接复用现成对象
+ * - acquire/release配对使用，归还的对象脱离可视树等待复用
+ * - 归还对象由C++持有所有权，不会被QML垃圾回收
+ *
+ * 使用场景：
+ * - 背包格子、战斗敌人卡片等批量重复的列表项
+ * - 伤害飘字、提示气泡等高频创建销毁的短命对象
+ */
+
+#ifndef QMLCOMPONENTPOOL_H
+#define QMLCOMPONENTPOOL_H
+
+#include <QObject>
+#include <QHash>
+#include <QString>
+#include <QVector>
+#include <memory>
+
+class QQmlEngine;
+class QQmlComponent;
+
+/**
+ * @brief QML组件对象池
+ *
+ * 为高频开关的QML组件维护空闲实例列表。组件首次使用时
+ * 编译并缓存QQmlComponent，之后的实例化不再触发编译；
+ * 配合preload()在启动后空闲时预建实例，打开界面时
+ * acquire()直接取现成对象，既不编译也不分配。
+ */
+class QmlComponentPool : public QObject
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief 构造函数
+     * @param engine QML引擎，组件在其根上下文中实例化
+     * @param parent 父对象指针
+     */
+    explicit QmlComponentPool(QQmlEngine *engine, QObject *parent = nullptr);
+
+    /**
+     * @brief 析构函数
+     *
+     * 销毁所有空闲实例和缓存的组件。
+     */
+    ~QmlComponentPool() override;
+
+    /**
+     * @brief 预热组件
+     *
+     * 编译组件并预实例化指定数量的空闲对象。
+     * 应在首屏加载完成后的空闲时机调用，避免阻塞启动。
+     *
+     * @param componentUrl 组件URL（qrc:/...）
+     * @param count 预实例化数量
+     */
+    void preload(const QString &componentUrl, int count);
+
+    /**
+     * @brief 取出一个组件实例
+     *
+     * 优先复用空闲实例；池为空时用缓存的组件即时创建
+     * （仍然免去编译开销）。调用方负责挂接可视父项。
+     *
+     * @param componentUrl 组件URL（qrc:/...）
+     * @return QObject* 组件实例，编译失败时返回nullptr
+     */
+    Q_INVOKABLE QObject* acquire(const QString &componentUrl);
+
+    /**
+     * @brief 归还一个组件实例
+     *
+     * 将实例隐藏、脱离可视树并放回空闲列表等待复用。
+     * 非本池创建的对象会被忽略并告警。
+     *
+     * @param componentUrl 取出时使用的组件URL
+     * @param object acquire()返回的实例
+     */
+    Q_INVOKABLE void release(const QString &componentUrl, QObject *object);
+
+    /**
+     * @brief 查询空闲实例数量
+     * @param componentUrl 组件URL
+     * @return int 当前空闲实例数
+     */
+    Q_INVOKABLE int idleCount(const QString &componentUrl) const;
+
+private:
+    /**
+     * @brief 单个组件的池条目
+     */
+    struct PoolEntry {
+        std::unique_ptr<QQmlComponent> component;  ///< 编译后的组件（只编译一次）
+        QVector<QObject*> idle;                    ///< 空闲实例列表
+    };
+
+    /**
+     * @brief 获取（必要时编译）组件
+     * @param componentUrl 组件URL
+     * @return QQmlComponent* 编译好的组件，失败返回nullptr
+     */
+    QQmlComponent* ensureComponent(const QString &componentUrl);
+
+    /**
+     * @brief 用缓存组件创建一个实例
+     * @param entry 池条目
+     * @return QObject* 新实例，失败返回nullptr
+     */
+    QObject* createInstance(PoolEntry &entry);
+
+    QQmlEngine* m_engine;                      ///< QML引擎（不持有）
+    QHash<QString, PoolEntry> m_pools;         ///< URL到池条目的映射
+};
+
+#endif // QMLCOMPONENTPOOL_H
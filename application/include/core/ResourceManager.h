@@ -10,16 +10,27 @@
  */
 #pragma once
 
+#include "core/AssetPack.h"
+
 #include <QObject>
 #include <QPixmap>
+#include <QImage>
 #include <QFont>
 #include <QJsonObject>
 #include <QJsonDocument>
 #include <QHash>
+#include <QQueue>
 #include <QMutex>
+#include <QWaitCondition>
 #include <QFuture>
 #include <QFutureWatcher>
+#include <QPromise>
+#include <atomic>
 #include <memory>
+#include <thread>
+#include <vector>
+
+class QTimer;
 
 /**
  * @brief 资源类型枚举
@@ -36,9 +47,34 @@ enum class ResourceType {
     Animation       ///< 动画文件
 };
 
+/**
+ * @brief 资源加载优先级
+ *
+ * 流式加载队列按优先级出队：战斗中打开背包等即时需求使用High，
+ * 场景切换前的后台预热使用Preload，二者互不阻塞。
+ */
+enum class LoadPriority {
+    High,           ///< 即时需求（UI打开、战斗特效等）
+    Normal,         ///< 常规加载
+    Preload         ///< 后台预热，最低优先级
+};
+
+/**
+ * @brief 纹理常驻级别
+ *
+ * 纹理按级别分层驻留：占位图是同步解码的低分辨率副本，
+ * 立即可用；全分辨率由流式管线在后台升级，上传量受主线程
+ * 字节预算约束；长时间未访问的纹理自动降回占位图释放内存。
+ */
+enum class TextureResidency {
+    None,           ///< 未加载
+    Placeholder,    ///< 仅低分辨率占位图驻留
+    Full            ///< 全分辨率已驻留
+};
+
 /**
  * @brief 资源信息结构
- * 
+ *
  * 存储资源的元信息和状态。
  */
 struct ResourceInfo {
@@ -49,6 +85,8 @@ struct ResourceInfo {
     int refCount;          ///< 引用计数
     bool isLoaded;         ///< 是否已加载
     QVariant data;         ///< 资源数据
+    qint64 lastAccessTick = 0;  ///< 最近访问序号，用于LRU淘汰
+    bool pinned = false;        ///< 是否被钉住，钉住的资源不参与淘汰
 };
 
 /**
@@ -157,23 +195,37 @@ public:
     
     /**
      * @brief 异步加载资源
-     * 
-     * 异步加载指定资源，不阻塞调用线程。
-     * 
+     *
+     * 将加载请求放入流式加载队列，由工作线程按优先级完成
+     * 文件读取与解码，主线程按帧预算完成缓存写入。
+     *
      * @param resourcePath 资源文件路径
      * @param type 资源类型
+     * @param priority 加载优先级，默认Normal
      * @return QFuture<QVariant> 异步加载的Future对象
      */
-    QFuture<QVariant> loadResourceAsync(const QString &resourcePath, ResourceType type);
-    
+    QFuture<QVariant> loadResourceAsync(const QString &resourcePath, ResourceType type,
+                                        LoadPriority priority = LoadPriority::Normal);
+
     /**
      * @brief 预加载资源列表
-     * 
+     *
      * 批量预加载资源列表，用于场景切换前的资源准备。
-     * 
+     * 按文件扩展名识别类型后以Preload优先级进入流式加载队列，
+     * 不会抢占即时加载请求。
+     *
      * @param resourcePaths 资源路径列表
      */
     void preloadResources(const QStringList &resourcePaths);
+
+    /**
+     * @brief 取消所有排队中的加载请求
+     *
+     * 场景切换后调用，丢弃上一场景遗留的未完成加载，
+     * 避免无用的解码和缓存占用。已进入解码的请求其结果
+     * 在回到主线程时按代号丢弃。
+     */
+    Q_INVOKABLE void cancelPendingLoads();
     
     /**
      * @brief 卸载资源
@@ -206,14 +258,24 @@ public:
     
     /**
      * @brief 加载纹理
-     * 
-     * 加载图片纹理资源。
-     * 
+     *
+     * 首次加载同步解码低分辨率占位图并立即返回，全分辨率
+     * 通过流式管线在后台升级，升级完成后缓存自动替换为高清
+     * 版本。场景切换不再因集中解码和上传全尺寸纹理掉帧。
+     *
      * @param imagePath 图片文件路径
-     * @return QPixmap 加载的图片数据
+     * @return QPixmap 当前驻留级别的图片数据（占位图或全分辨率）
      */
     Q_INVOKABLE QPixmap loadTexture(const QString &imagePath);
-    
+
+    /**
+     * @brief 查询纹理常驻级别
+     *
+     * @param imagePath 图片文件路径
+     * @return TextureResidency 当前常驻级别，未加载返回None
+     */
+    TextureResidency textureResidency(const QString &imagePath) const;
+
     /**
      * @brief 加载字体
      * 
@@ -248,10 +310,54 @@ public:
     
     /**
      * @brief 清理未使用的资源
-     * 
+     *
      * 清理引用计数为0的资源，释放内存。
      */
     Q_INVOKABLE void cleanupUnusedResources();
+
+    /**
+     * @brief 设置内存预算
+     *
+     * 超出预算后由增量LRU淘汰逐帧回收，不会一次性全量清理。
+     *
+     * @param bytes 内存预算（字节）
+     */
+    Q_INVOKABLE void setMemoryBudget(qint64 bytes);
+
+    /**
+     * @brief 获取内存预算
+     *
+     * @return qint64 当前内存预算（字节）
+     */
+    Q_INVOKABLE qint64 memoryBudget() const { return m_maxMemoryUsage; }
+
+    /**
+     * @brief 钉住资源
+     *
+     * 钉住的资源不参与LRU淘汰，用于当前场景的关键资源
+     * （角色纹理、UI字体等）。
+     *
+     * @param resourcePath 资源文件路径
+     */
+    Q_INVOKABLE void pinResource(const QString &resourcePath);
+
+    /**
+     * @brief 取消钉住资源
+     *
+     * @param resourcePath 资源文件路径
+     */
+    Q_INVOKABLE void unpinResource(const QString &resourcePath);
+
+    /**
+     * @brief 挂载FLPK资源包
+     *
+     * 挂载后所有加载路径优先查询资源包，未命中再回退到
+     * 零散文件搜索，消除冷启动的大量小文件打开开销。
+     *
+     * @param packPath 资源包文件路径
+     * @return bool 是否挂载成功
+     */
+    Q_INVOKABLE bool mountAssetPack(const QString &packPath);
     
     /**
      * @brief 获取资源信息
@@ -318,7 +424,166 @@ private slots:
      */
     void onPreloadFinished();
 
+    /**
+     * @brief 主线程按预算收尾已解码资源
+     *
+     * 每帧从完成队列取出工作线程解码好的资源，完成
+     * QPixmap转换、字体注册和缓存写入。单次处理的字节数
+     * 受FINALIZE_BYTE_BUDGET限制，避免一帧内集中上传卡顿。
+     */
+    void finalizeDecodedResources();
+
 private:
+    /**
+     * @brief 流式加载请求
+     *
+     * 进入优先级队列的单个加载请求。generation记录入队时的
+     * 加载代号，场景切换后代号递增，旧请求据此作废。
+     */
+    struct StreamRequest {
+        QString path;                                       ///< 资源文件路径
+        ResourceType type = ResourceType::Data;             ///< 资源类型
+        LoadPriority priority = LoadPriority::Normal;       ///< 加载优先级
+        quint64 generation = 0;                             ///< 入队时的加载代号
+        std::shared_ptr<QPromise<QVariant>> promise;        ///< 对应Future的承诺对象
+    };
+
+    /**
+     * @brief 已解码资源
+     *
+     * 工作线程解码完成、等待主线程收尾的中间结果。
+     * 纹理以QImage形式传递，QPixmap转换必须在主线程完成。
+     */
+    struct DecodedResource {
+        QString path;                                       ///< 资源文件路径
+        ResourceType type = ResourceType::Data;             ///< 资源类型
+        quint64 generation = 0;                             ///< 入队时的加载代号
+        qint64 size = 0;                                    ///< 解码后数据大小（字节）
+        QImage image;                                       ///< 纹理解码结果
+        QVariant data;                                      ///< 非纹理资源数据
+        std::shared_ptr<QPromise<QVariant>> promise;        ///< 对应Future的承诺对象
+    };
+
+    /**
+     * @brief 启动流式加载工作线程
+     */
+    void startStreamWorkers();
+
+    /**
+     * @brief 停止流式加载工作线程
+     *
+     * 唤醒并等待所有工作线程退出，排队中的请求被丢弃。
+     */
+    void stopStreamWorkers();
+
+    /**
+     * @brief 工作线程主循环
+     *
+     * 按优先级取出请求，在工作线程中完成文件读取与解码，
+     * 结果放入完成队列等待主线程收尾。
+     */
+    void streamWorkerLoop();
+
+    /**
+     * @brief 将请求放入对应优先级的队列
+     *
+     * @param request 加载请求
+     */
+    void enqueueStreamRequest(const StreamRequest &request);
+
+    /**
+     * @brief 按优先级取出一个排队请求
+     *
+     * 调用方必须持有m_streamMutex。
+     *
+     * @param request 输出参数，取出的请求
+     * @return bool 是否取到请求
+     */
+    bool tryDequeueStreamRequest(StreamRequest &request);
+
+    /**
+     * @brief 在工作线程中解码请求
+     *
+     * @param request 加载请求
+     * @return DecodedResource 解码结果，失败时数据无效
+     */
+    DecodedResource decodeStreamRequest(const StreamRequest &request);
+
+    /**
+     * @brief 更新流式加载进度与状态
+     */
+    void updateStreamProgress();
+
+    /**
+     * @brief 记录资源访问
+     *
+     * 更新资源的LRU访问序号，缓存命中时调用。
+     *
+     * @param info 被访问的资源信息
+     */
+    void touchResource(const std::shared_ptr<ResourceInfo> &info) const;
+
+    /**
+     * @brief 增量LRU淘汰
+     *
+     * 内存超出预算时每帧最多淘汰MAX_EVICTIONS_PER_TICK个
+     * 最久未访问的未钉住资源，避免一次性全量清理造成卡顿。
+     */
+    void evictLruResources();
+
+    /**
+     * @brief 纹理常驻状态
+     *
+     * 记录单个纹理的驻留级别与占位图副本。占位图尺寸很小，
+     * 常驻内存以便降级时瞬时回显，避免重新解码。
+     */
+    struct TextureTierInfo {
+        TextureResidency tier = TextureResidency::None;  ///< 当前驻留级别
+        QPixmap placeholder;                             ///< 低分辨率占位图副本
+        qint64 fullSize = 0;                             ///< 全分辨率数据大小（字节）
+        qint64 lastUsedTick = 0;                         ///< 最近访问的常驻节拍
+        bool upgradeQueued = false;                      ///< 全分辨率升级是否已入队
+    };
+
+    /**
+     * @brief 同步解码低分辨率占位图
+     *
+     * 利用解码期缩放（setScaledSize）直接产出占位尺寸的图像，
+     * 多数格式无需解码全尺寸像素。源图本身不超过占位规格时
+     * 按全分辨率处理，不再触发后台升级。
+     *
+     * @param fileName 纹理文件路径
+     * @param isFullRes 输出参数，源图是否已是全分辨率
+     * @return QPixmap 占位图，解码失败时为空
+     */
+    QPixmap decodePlaceholderTexture(const QString &fileName, bool &isFullRes);
+
+    /**
+     * @brief 将纹理的全分辨率升级请求入队
+     *
+     * 升级走流式管线：工作线程解码，主线程按字节预算分帧
+     * 完成像素上传，多个升级自然被摊到多帧。
+     *
+     * @param fileName 纹理文件路径
+     */
+    void queueTextureUpgrade(const QString &fileName);
+
+    /**
+     * @brief 降级长时间未访问的纹理
+     *
+     * 每个常驻节拍最多降级MAX_DOWNGRADES_PER_TICK个闲置的
+     * 全分辨率纹理回占位图。没有渲染层的可见性反馈，以最近
+     * 访问节拍作为"在屏"的近似，被钉住的纹理不参与降级。
+     */
+    void downgradeIdleTextures();
+
+    /**
+     * @brief 从已挂载的资源包读取数据
+     *
+     * @param path 资源相对路径
+     * @return QByteArray 资源数据，未挂载或未命中时为空
+     */
+    QByteArray readPackedResource(const QString &path) const;
     /**
      * @brief 加载纹理资源
      * 
@@ -455,12 +720,38 @@ private:
     
     // 资源路径
     QStringList m_resourcePaths;                ///< 资源搜索路径列表
+    std::unique_ptr<AssetPack> m_assetPack;     ///< 已挂载的FLPK资源包
     
     // 统计信息
     int m_loadedResourceCount;                  ///< 已加载资源数量
     qint64 m_totalResourceSize;                 ///< 总资源大小
     qint64 m_maxCacheSize;                      ///< 最大缓存大小
-    
+
+    // 流式加载
+    static constexpr qint64 FINALIZE_BYTE_BUDGET = 2 * 1024 * 1024;  ///< 主线程单帧收尾字节预算
+    static constexpr int FINALIZE_INTERVAL_MS = 16;                  ///< 收尾定时器间隔（毫秒）
+    static constexpr int MAX_EVICTIONS_PER_TICK = 4;                 ///< 单帧最大LRU淘汰数量
+
+    // 纹理常驻分级
+    static constexpr int PLACEHOLDER_MAX_DIMENSION = 64;             ///< 占位图最长边（像素）
+    static constexpr qint64 TEXTURE_IDLE_DOWNGRADE_TICKS = 300;      ///< 降级判定的闲置节拍数（约5秒）
+    static constexpr int MAX_DOWNGRADES_PER_TICK = 2;                ///< 单节拍最大纹理降级数量
+
+    mutable qint64 m_accessCounter = 0;         ///< LRU访问序号计数器
+    QHash<QString, TextureTierInfo> m_textureTiers;  ///< 纹理常驻状态表
+    qint64 m_residencyTick = 0;                 ///< 常驻节拍计数，随收尾定时器递增
+
+    std::vector<std::thread> m_streamWorkers;   ///< 流式加载工作线程
+    QQueue<StreamRequest> m_highQueue;          ///< 高优先级请求队列
+    QQueue<StreamRequest> m_normalQueue;        ///< 常规优先级请求队列
+    QQueue<StreamRequest> m_preloadQueue;       ///< 预热请求队列
+    QQueue<DecodedResource> m_finalizeQueue;    ///< 待主线程收尾的解码结果
+    QMutex m_streamMutex;                       ///< 保护加载与完成队列
+    QWaitCondition m_streamCondition;           ///< 工作线程等待条件
+    std::atomic<quint64> m_loadGeneration{0};   ///< 当前加载代号，场景切换时递增
+    std::atomic<bool> m_streamStopping{false};  ///< 工作线程停止标志
+    QTimer *m_finalizeTimer = nullptr;          ///< 主线程收尾定时器
+
     // 私有方法声明
     void setupResourcePaths();
     bool validateResourcePaths();
@@ -19,6 +19,7 @@
 // 前向声明
 class Scene;
 class ResourceManager;
+class AudioManager;
 
 /**
  * @brief 场景类型枚举
@@ -103,6 +104,17 @@ public:
      */
     bool initialize(ResourceManager *resourceManager);
 
+    /**
+     * @brief 设置音频管理器引用
+     *
+     * 设置后场景切换按音频清单差量调整常驻音效：卸载旧场景
+     * 独占的、在转场期间后台预解码新场景独有的。未设置时
+     * 场景切换不触碰音频。
+     *
+     * @param audioManager 音频管理器指针
+     */
+    void setAudioManager(AudioManager *audioManager) { m_audioManager = audioManager; }
+
     // 状态查询属性访问器
     
     /**
@@ -236,9 +248,21 @@ public:
      */
     Q_INVOKABLE void preloadSceneResources(const QString &sceneName);
     
+    /**
+     * @brief 启动场景UI的空闲预热
+     *
+     * QML界面成为当前场景后调用。按场景的UI预热优先级表，
+     * 每个事件循环空闲轮次发出一个uiWarmupRequested()，驱动
+     * 界面中的LazyPanel逐个延迟实例化：首开只构建可见UI，
+     * 隐藏的面板与对话框在空闲帧补齐。
+     *
+     * @param sceneName 场景名称
+     */
+    Q_INVOKABLE void warmUpSceneUi(const QString &sceneName);
+
     /**
      * @brief 暂停当前场景
-     * 
+     *
      * 暂停当前场景的更新和渲染。
      */
     Q_INVOKABLE void pauseCurrentScene();
@@ -296,11 +320,21 @@ signals:
     
     /**
      * @brief 场景卸载信号
-     * 
+     *
      * @param sceneName 卸载的场景名称
      */
     void sceneUnloaded(const QString &sceneName);
 
+    /**
+     * @brief UI元素预热信号
+     *
+     * 每个空闲轮次发出一次，携带待实例化的懒加载元素名称；
+     * QML中的LazyPanel按名称匹配后实例化自身内容。
+     *
+     * @param elementName 元素名称（如"MainMenu.newGameDialog"）
+     */
+    void uiWarmupRequested(const QString &elementName);
+
 private slots:
     /**
      * @brief 转场动画更新处理
@@ -355,6 +389,54 @@ private:
      */
     void cleanupUnusedScenes();
 
+    /**
+     * @brief 调度可能的下一场景的后台预热
+     *
+     * 切换完成后根据场景预测表把候选场景的构建与资源加载
+     * 推迟到事件循环空闲时执行，之后切换可直接复用池中实例。
+     *
+     * @param sceneName 刚切换到的场景名称
+     */
+    void schedulePredictivePreloads(const QString &sceneName);
+
+    /**
+     * @brief 查询某场景之后最可能切换到的场景
+     *
+     * @param sceneName 当前场景名称
+     * @return QStringList 候选场景列表（按可能性排序）
+     */
+    static QStringList likelyNextScenes(const QString &sceneName);
+
+    /**
+     * @brief 查询场景的UI预热优先级表
+     *
+     * 列出该场景中首开时不可见、但随后大概率会用到的懒加载
+     * 元素，按打开概率排序。
+     *
+     * @param sceneName 场景名称
+     * @return QStringList 元素名称列表（按优先级排序）
+     */
+    static QStringList uiWarmupPriority(const QString &sceneName);
+
+    /**
+     * @brief 发出下一个UI预热请求
+     *
+     * 队列头出队并发出uiWarmupRequested()，其余条目排入下一个
+     * 事件循环空闲轮次，每轮只实例化一个元素。
+     */
+    void pumpUiWarmupQueue();
+
+    /**
+     * @brief 获取场景的资源预取提示
+     *
+     * 来自场景配置的preloadResources数组（如相邻区域的贴图），
+     * 以最低优先级进入ResourceManager的流式加载队列。
+     *
+     * @param sceneName 场景名称
+     * @return QStringList 资源路径列表，未配置时为空
+     */
+    QStringList sceneResourceHints(const QString &sceneName) const;
+
     /**
      * @brief 获取当前场景名称
      * @return 当前场景名称
@@ -373,6 +455,9 @@ private:
     
     // 资源管理器引用
     ResourceManager *m_resourceManager;
+
+    // 音频管理器引用（可选，场景音频差量切换用）
+    AudioManager *m_audioManager = nullptr;
     
     // 当前场景名称
     QString m_currentSceneName;
@@ -385,4 +470,10 @@ private:
     
     // 场景配置
     QJsonObject m_sceneConfig;
+
+    // 待预热的懒加载UI元素队列（按优先级出队）
+    QStringList m_uiWarmupQueue;
+
+    // 预热泵是否已排入事件循环
+    bool m_uiWarmupScheduled = false;
 };
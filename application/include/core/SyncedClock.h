@@ -0,0 +1,174 @@
+/*
+ * 文件名: SyncedClock.h
+ * 说明: 服务器权威时钟同步工具，提供漂移补偿的时间映射。
+ * 作者: 彭承康
+ * 创建时间: 2026-08-28
+ *
+ * 客户端插值与延迟事件都默认本地时钟与服务器大致同步，而玩家
+ * 机器的墙钟常常偏差数秒且持续漂移，按服务器时间戳显示的buff
+ * 到期时间会明显错位。本类维护本地单调时基到服务器时间的映射：
+ * 网络层周期性做NTP风格的四时刻交换喂入样本，取窗口内往返最短
+ * 的样本估计钟差，并对样本序列做线性回归估计漂移率；两次采样
+ * 之间按漂移外推，到期判定不需要任何逐事件的服务器往返。
+ */
+#ifndef CORE_SYNCEDCLOCK_H
+#define CORE_SYNCEDCLOCK_H
+
+#include <QElapsedTimer>
+#include <QMutex>
+
+/**
+ * @brief 服务器权威时钟
+ *
+ * 时间全部以毫秒计。本地时刻采用单调时基（构造时锚定一次墙钟，
+ * 之后只随QElapsedTimer推进），用户调系统时间不影响映射。
+ *
+ * 线程模型：所有方法内部加锁，可在任意线程调用；样本由
+ * StrategyServiceClient::syncClock在RPC完成时喂入。
+ */
+class SyncedClock
+{
+public:
+    /**
+     * @brief 获取单例实例
+     * @return SyncedClock的唯一实例
+     */
+    static SyncedClock* instance();
+
+    /**
+     * @brief 获取本地稳定时刻（毫秒）
+     *
+     * 构造时锚定的墙钟 + 单调流逝时间。采样交换的t0/t3必须
+     * 取自本方法，保证与映射使用同一时基。
+     *
+     * @return 本地稳定时刻（毫秒）
+     */
+    qint64 localSteadyMs() const;
+
+    /**
+     * @brief 喂入一次NTP风格的四时刻交换样本
+     *
+     * 钟差 = ((t1-t0)+(t2-t3))/2，往返 = (t3-t0)-(t2-t1)，
+     * 服务端处理耗时已被扣除。样本进入固定大小的滑动窗口：
+     * 当前钟差取窗口内往返最短的样本（延迟尖刺不污染估计），
+     * 窗口时间跨度足够后对(时刻,钟差)序列做线性回归得到漂移
+     * 率，采样间隔内按漂移外推。
+     *
+     * @param t0 客户端发送时刻（localSteadyMs）
+     * @param t1 服务端接收时刻（服务器墙钟毫秒）
+     * @param t2 服务端发送时刻（服务器墙钟毫秒）
+     * @param t3 客户端接收时刻（localSteadyMs）
+     */
+    void addExchangeSample(qint64 t0, qint64 t1, qint64 t2, qint64 t3);
+
+    /**
+     * @brief 是否已完成至少一次有效同步
+     * @return 已同步返回true
+     */
+    bool isSynchronized() const;
+
+    /**
+     * @brief 当前服务器时刻估计（毫秒）
+     *
+     * 未同步时退化为本地稳定时刻。
+     *
+     * @return 服务器时刻估计
+     */
+    qint64 serverNowMs() const;
+
+    /**
+     * @brief 本地稳定时刻换算为服务器时刻
+     * @param localMs 本地稳定时刻（localSteadyMs时基）
+     * @return 服务器时刻估计
+     */
+    qint64 toServerTime(qint64 localMs) const;
+
+    /**
+     * @brief 服务器时刻换算为本地稳定时刻
+     * @param serverMs 服务器时刻
+     * @return 本地稳定时刻估计
+     */
+    qint64 toLocalTime(qint64 serverMs) const;
+
+    /**
+     * @brief 距服务器时刻还剩多少毫秒
+     *
+     * 延迟事件与buff计时的入口：服务器下发到期时间戳，本方法
+     * 给出按本地时钟应等待的毫秒数（已补偿钟差与漂移），
+     * 已过期返回0。
+     *
+     * @param serverMs 服务器时刻（到期时间戳）
+     * @return 剩余毫秒数，已过期返回0
+     */
+    qint64 remainingUntilServerMs(qint64 serverMs) const;
+
+    /**
+     * @brief 获取当前漂移率估计
+     * @return 漂移率（ppm，正值表示本地钟走得慢）
+     */
+    double driftPpm() const;
+
+    /**
+     * @brief 获取最近一次接受样本的往返时延
+     * @return 往返毫秒数，无样本返回-1
+     */
+    qint64 lastRttMs() const;
+
+    /**
+     * @brief 清空样本与映射（重连后调用，旧估计不再可信）
+     */
+    void reset();
+
+private:
+    SyncedClock();
+
+    SyncedClock(const SyncedClock&) = delete;
+    SyncedClock& operator=(const SyncedClock&) = delete;
+
+    /**
+     * @brief 一次交换样本
+     */
+    struct Sample {
+        qint64 localMs = 0;   ///< 样本到达时刻（localSteadyMs时基）
+        qint64 offsetMs = 0;  ///< 钟差（服务器 - 本地）
+        qint64 rttMs = 0;     ///< 扣除服务端处理后的往返时延
+    };
+
+    /**
+     * @brief 按当前样本窗口重算钟差与漂移（调用方须持锁）
+     */
+    void recomputeLocked();
+
+    /**
+     * @brief 不加锁的时间映射（调用方须持锁）
+     * @param localMs 本地稳定时刻
+     * @return 服务器时刻估计
+     */
+    qint64 toServerTimeLocked(qint64 localMs) const;
+
+    /// 样本滑动窗口大小
+    static constexpr int SAMPLE_WINDOW = 8;
+
+    /// 窗口跨度达到该值才启用漂移回归（毫秒）
+    static constexpr qint64 MIN_DRIFT_SPAN_MS = 30000;
+
+    /// 漂移率钳制范围（ppm）：超出者视为坏样本序列
+    static constexpr double MAX_DRIFT_PPM = 500.0;
+
+    /// 往返超过窗口最短往返该倍数的样本直接丢弃
+    static constexpr qint64 RTT_OUTLIER_FACTOR = 4;
+
+    mutable QMutex m_mutex;          ///< 保护样本窗口与映射参数
+    QElapsedTimer m_monotonic;       ///< 单调时基（构造时启动）
+    qint64 m_wallAnchorMs = 0;       ///< 构造时锚定的本地墙钟
+    Sample m_samples[SAMPLE_WINDOW]; ///< 样本环形窗口
+    int m_sampleCount = 0;           ///< 窗口内样本数
+    int m_sampleHead = 0;            ///< 环形窗口写入位置
+    bool m_synchronized = false;     ///< 是否已有有效映射
+    qint64 m_offsetMs = 0;           ///< 当前钟差估计
+    qint64 m_offsetAnchorMs = 0;     ///< 钟差估计对应的本地时刻
+    double m_driftPpm = 0.0;         ///< 漂移率估计（ppm）
+    qint64 m_lastRttMs = -1;         ///< 最近接受样本的往返时延
+};
+
+#endif // CORE_SYNCEDCLOCK_H
@@ -0,0 +1,291 @@
+/*
+ * 文件名: TypedEventBus.h
+ * 说明: 编译期类型化事件通道头文件
+ * 作者: 彭承康
+ * 创建时间: 2026-08-28
+ *
+ * 本文件在EventSystem之上提供一条编译期类型化的事件通道：
+ * 每个事件是一个普通结构体，订阅与分发在编译期按类型解析到
+ * 各自的通道，热路径事件彻底绕开QVariant装箱与字符串哈希。
+ *
+ * 设计特点：
+ * - 事件即结构体，负载字段强类型，无键值查找
+ * - 通道按类型编号索引（静态计数器），分发零哈希
+ * - 异步投递走每通道双缓冲队列，由帧循环统一排空
+ * - 旧的GameEvent/字符串键路径完全不受影响，可并存使用
+ *
+ * 线程模型（与EventSystem一致）：
+ * - post可在任意线程调用（通道内加锁入队，无全局锁）
+ * - subscribe/unsubscribe/send/drainPosted只能在主线程调用
+ *
+ * 命名说明：emit是Qt关键字宏，同步分发命名为send、异步投递
+ * 命名为post，与EventSystem的sendEvent/postEvent保持对应。
+ *
+ * 使用示例：
+ *   struct PlayerDamagedEvent { int playerId; int amount; bool critical; };
+ *   int handle = TypedEventBus::instance()->subscribe<PlayerDamagedEvent>(
+ *       [](const PlayerDamagedEvent &e) { ... });
+ *   TypedEventBus::instance()->send(PlayerDamagedEvent{1, 35, false});
+ */
+
+#ifndef TYPEDEVENTBUS_H
+#define TYPEDEVENTBUS_H
+
+#include <QHash>
+#include <QMutex>
+#include <QMutexLocker>
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <utility>
+#include <vector>
+
+// ==================== 常用热路径事件 ====================
+//
+// 战斗相关的高频事件在此集中定义；各模块也可以就近定义
+// 自己的事件结构体，任何可拷贝/可移动的类型都能作为事件。
+
+/**
+ * @brief 玩家受伤事件（热路径）
+ */
+struct PlayerDamagedEvent {
+    int playerId = 0;        ///< 玩家ID
+    int amount = 0;          ///< 伤害数值
+    int remainingHealth = 0; ///< 剩余生命值
+    bool critical = false;   ///< 是否暴击
+};
+
+/**
+ * @brief 敌人被击败事件（热路径）
+ */
+struct EnemyDefeatedEvent {
+    int enemyId = 0;         ///< 敌人ID
+    int experience = 0;      ///< 获得经验
+    int goldDropped = 0;     ///< 掉落金币
+};
+
+/**
+ * @brief 编译期类型化事件总线
+ *
+ * 与EventSystem的字符串键/QVariant通道并行的快速通道：
+ * subscribe<T>/send<T>/post<T>按事件类型在编译期解析到对应
+ * 通道，分发是一次数组下标加一轮回调遍历，全程无装箱、
+ * 无字符串哈希。异步投递的事件由GameEngine帧循环经
+ * EventSystem::advanceFrame统一排空，与旧队列同节奏处理。
+ */
+class TypedEventBus
+{
+public:
+    /**
+     * @brief 获取单例实例
+     * @return TypedEventBus的唯一实例
+     */
+    static TypedEventBus* instance();
+
+    TypedEventBus(const TypedEventBus&) = delete;
+    TypedEventBus& operator=(const TypedEventBus&) = delete;
+
+    /**
+     * @brief 订阅指定类型的事件
+     *
+     * 订阅者按优先级降序接收事件，同优先级保持订阅顺序，
+     * 与EventSystem的监听器语义一致。
+     *
+     * @tparam EventT 事件类型（任意结构体）
+     * @param handler 事件处理函数
+     * @param priority 订阅优先级（数值越大越先接收）
+     * @return int 稳定订阅句柄（用于取消订阅）
+     */
+    template <typename EventT>
+    int subscribe(std::function<void(const EventT&)> handler, int priority = 0)
+    {
+        auto &channel = channelFor<EventT>();
+        const int handle = m_nextHandle++;
+        channel.addSubscriber(std::move(handler), priority, handle);
+        m_handleChannels.insert(handle, &channel);
+        return handle;
+    }
+
+    /**
+     * @brief 按句柄取消订阅
+     * @param handle subscribe返回的句柄
+     */
+    void unsubscribe(int handle);
+
+    /**
+     * @brief 同步发送事件
+     *
+     * 立即按优先级顺序通知该类型的所有订阅者，
+     * 对应EventSystem::sendEvent。
+     *
+     * @tparam EventT 事件类型
+     * @param payload 事件负载
+     */
+    template <typename EventT>
+    void send(const EventT &payload)
+    {
+        channelFor<EventT>().dispatch(payload);
+    }
+
+    /**
+     * @brief 异步投递事件
+     *
+     * 事件被移入该类型通道的待处理队列，下一次drainPosted时
+     * 分发，对应EventSystem::postEvent。可在任意线程调用。
+     *
+     * @tparam EventT 事件类型
+     * @param payload 事件负载（按值传入，移动进队列）
+     */
+    template <typename EventT>
+    void post(EventT payload)
+    {
+        channelFor<EventT>().enqueue(std::move(payload));
+    }
+
+    /**
+     * @brief 排空所有通道的异步事件
+     *
+     * 由EventSystem::advanceFrame每帧调用，与旧事件队列
+     * 同一节奏驱动；各通道双缓冲交换后在主线程分发。
+     */
+    void drainPosted();
+
+private:
+    TypedEventBus() = default;
+
+    /**
+     * @brief 类型化通道的类型擦除基类
+     *
+     * 总线经此接口统一驱动排空与按句柄移除，
+     * 具体的事件类型只在模板通道内可见。
+     */
+    class ChannelBase
+    {
+    public:
+        virtual ~ChannelBase() = default;
+
+        /// 排空本通道的待处理事件（主线程）
+        virtual void drain() = 0;
+
+        /// 移除指定句柄的订阅；不存在返回false
+        virtual bool removeSubscriber(int handle) = 0;
+    };
+
+    /**
+     * @brief 单一事件类型的通道
+     *
+     * 订阅者列表按优先级降序预排序，分发零排序零查找；
+     * 异步投递用双缓冲：post加锁追加到待处理侧，drain时
+     * 整体交换到分发侧，锁只覆盖指针交换。
+     */
+    template <typename EventT>
+    class Channel final : public ChannelBase
+    {
+    public:
+        void addSubscriber(std::function<void(const EventT&)> handler,
+                           int priority, int handle)
+        {
+            Subscriber entry{std::move(handler), priority, handle};
+            auto it = m_subscribers.begin();
+            while (it != m_subscribers.end() && it->priority >= priority) {
+                ++it;
+            }
+            m_subscribers.insert(it, std::move(entry));
+        }
+
+        bool removeSubscriber(int handle) override
+        {
+            for (auto it = m_subscribers.begin(); it != m_subscribers.end(); ++it) {
+                if (it->handle == handle) {
+                    m_subscribers.erase(it);
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        void dispatch(const EventT &payload)
+        {
+            for (const Subscriber &subscriber : m_subscribers) {
+                subscriber.handler(payload);
+            }
+        }
+
+        void enqueue(EventT payload)
+        {
+            QMutexLocker locker(&m_pendingMutex);
+            m_pending.push_back(std::move(payload));
+        }
+
+        void drain() override
+        {
+            {
+                QMutexLocker locker(&m_pendingMutex);
+                m_draining.swap(m_pending);
+            }
+            for (const EventT &payload : m_draining) {
+                dispatch(payload);
+            }
+            m_draining.clear();
+        }
+
+    private:
+        /**
+         * @brief 订阅者信息
+         */
+        struct Subscriber {
+            std::function<void(const EventT&)> handler;  ///< 处理函数
+            int priority;                                ///< 优先级
+            int handle;                                  ///< 订阅句柄
+        };
+
+        std::vector<Subscriber> m_subscribers;  ///< 订阅者列表（优先级降序）
+        std::vector<EventT> m_pending;          ///< 待处理事件（投递侧）
+        std::vector<EventT> m_draining;         ///< 分发缓冲（主线程侧）
+        QMutex m_pendingMutex;                  ///< 待处理队列互斥锁
+    };
+
+    /**
+     * @brief 事件类型的进程内编号
+     *
+     * 每个事件类型首次使用时从静态计数器领取一个编号，
+     * 之后的通道查找是一次数组下标，无类型哈希。
+     *
+     * @tparam EventT 事件类型
+     * @return int 类型编号
+     */
+    template <typename EventT>
+    static int typeIndexOf()
+    {
+        static const int index = s_nextTypeIndex.fetch_add(1, std::memory_order_relaxed);
+        return index;
+    }
+
+    /**
+     * @brief 获取或创建指定类型的通道
+     * @tparam EventT 事件类型
+     * @return Channel<EventT>& 该类型的通道
+     */
+    template <typename EventT>
+    Channel<EventT>& channelFor()
+    {
+        const auto index = static_cast<std::size_t>(typeIndexOf<EventT>());
+        if (index >= m_channels.size()) {
+            m_channels.resize(index + 1);
+        }
+        if (!m_channels[index]) {
+            m_channels[index] = std::make_unique<Channel<EventT>>();
+        }
+        return static_cast<Channel<EventT>&>(*m_channels[index]);
+    }
+
+    static TypedEventBus* s_instance;                     ///< 单例实例
+    static std::atomic<int> s_nextTypeIndex;              ///< 类型编号计数器
+
+    std::vector<std::unique_ptr<ChannelBase>> m_channels; ///< 通道表（按类型编号索引）
+    QHash<int, ChannelBase*> m_handleChannels;            ///< 句柄到所属通道的索引
+    int m_nextHandle = 1;                                 ///< 下一个订阅句柄（0保留为无效）
+};
+
+#endif // TYPEDEVENTBUS_H
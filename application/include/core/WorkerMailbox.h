@@ -0,0 +1,212 @@
+/*
+ * 文件名: WorkerMailbox.h
+ * 说明: 工作线程到主线程的SPSC信箱与统一排空枢纽
+ * 作者: 彭承康
+ * 创建时间: 2026-08-28
+ *
+ * 工作线程产出的结果（任务完成回调、RPC恢复等）此前通过
+ * 逐条Qt队列连接送回主线程，每条消息都要付一次QMetaObject
+ * 事件分配与投递的开销。本文件提供替代通道：
+ * - 每个生产线程一个单生产者/单消费者（SPSC）环形信箱，
+ *   入队只有两次原子操作，无锁、无事件分配
+ * - 所有信箱由MailboxHub集中登记，GameEngine帧循环调用
+ *   drainAll()作为唯一排空点，消息按帧批量执行
+ * - 信箱满即背压：tryPost返回false并累计拒绝计数，排空时
+ *   枢纽发现计数推进会发backpressureDetected信号；生产方
+ *   回退到原有的队列连接路径，消息不丢失
+ *
+ * 线程模型：
+ * - tryPost只能由信箱对应的生产线程调用（SPSC约定）
+ * - mailboxForCurrentThread可在任意线程调用（注册短锁）
+ * - drainAll只能在枢纽所在线程（主线程）调用
+ */
+
+#ifndef CORE_WORKERMAILBOX_H
+#define CORE_WORKERMAILBOX_H
+
+#include <QObject>
+#include <QHash>
+#include <QMutex>
+#include <QString>
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <vector>
+
+/**
+ * @brief 单生产者/单消费者环形信箱
+ *
+ * 固定容量的无锁环形队列，生产线程tryPost入队，消费线程
+ * drain批量出队执行。头尾索引用acquire/release原子操作
+ * 同步，满时入队失败（背压），由生产方决定回退路径。
+ */
+class WorkerMailbox
+{
+public:
+    /**
+     * @brief 消息类型
+     *
+     * 在消费线程（主线程）执行的闭包，可安全触碰QObject/QML。
+     */
+    using Message = std::function<void()>;
+
+    /**
+     * @brief 构造函数
+     *
+     * @param capacity 信箱容量，向上取整到2的幂
+     */
+    explicit WorkerMailbox(int capacity = DEFAULT_CAPACITY);
+
+    /**
+     * @brief 尝试投递消息（仅生产线程调用）
+     *
+     * 信箱满时返回false并累计拒绝计数，调用方应回退到
+     * Qt队列连接等有损耗但无上限的路径。
+     *
+     * @param message 待投递的消息
+     * @return bool 是否成功入队
+     */
+    bool tryPost(Message message);
+
+    /**
+     * @brief 批量排空消息（仅消费线程调用）
+     *
+     * 最多执行maxMessages条消息，余量留到下次排空，
+     * 单帧排空成本有界。
+     *
+     * @param maxMessages 本次最多执行的消息数
+     * @return int 实际执行的消息数
+     */
+    int drain(int maxMessages);
+
+    /**
+     * @brief 获取近似待处理消息数
+     *
+     * 无同步快照，仅用于监控展示。
+     *
+     * @return int 近似消息数
+     */
+    int pendingApprox() const;
+
+    /**
+     * @brief 获取累计拒绝计数
+     *
+     * @return quint64 因信箱满被拒绝的投递总数
+     */
+    quint64 rejectedCount() const { return m_rejected.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief 默认信箱容量
+     */
+    static constexpr int DEFAULT_CAPACITY = 256;
+
+private:
+    std::vector<Message> m_slots;        ///< 环形槽位
+    quint32 m_mask;                      ///< 容量掩码（容量-1）
+    std::atomic<quint32> m_head{0};      ///< 消费索引（消费线程写）
+    std::atomic<quint32> m_tail{0};      ///< 生产索引（生产线程写）
+    std::atomic<quint64> m_rejected{0};  ///< 累计拒绝计数
+};
+
+/**
+ * @brief 信箱枢纽
+ *
+ * 按生产线程登记信箱并提供帧循环的统一排空点。信箱在
+ * 首次按线程请求时创建，生命周期与枢纽一致（只增不删），
+ * 生产方可以缓存返回的指针避免重复查表。
+ *
+ * GameEngine在初始化时setActive()登记全局实例，无法拿到
+ * 引擎引用的生产方（RPC线程池等）经active()访问，与
+ * FrameAllocator::active()的用法一致。
+ */
+class MailboxHub : public QObject
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief 构造函数
+     *
+     * @param parent 父对象指针，用于Qt对象树管理
+     */
+    explicit MailboxHub(QObject *parent = nullptr);
+
+    /**
+     * @brief 析构函数
+     *
+     * 若本实例是当前全局实例则清除登记。
+     */
+    ~MailboxHub() override;
+
+    /**
+     * @brief 获取当前线程的信箱（任意线程调用）
+     *
+     * 首次调用时创建并登记，后续调用返回同一信箱。
+     * 每次调用有一次短锁查表，热路径生产方应缓存指针。
+     *
+     * @param producerName 生产方名称，用于背压信号与监控
+     * @return WorkerMailbox* 当前线程专属信箱
+     */
+    WorkerMailbox *mailboxForCurrentThread(const QString &producerName);
+
+    /**
+     * @brief 排空全部信箱（仅主线程调用）
+     *
+     * 帧循环的唯一排空点：每个信箱最多执行maxPerMailbox条
+     * 消息，余量下帧继续。排空后检查各信箱的拒绝计数，
+     * 有推进时发backpressureDetected信号。
+     *
+     * @param maxPerMailbox 单信箱单帧最多执行的消息数
+     * @return int 本帧实际执行的消息总数
+     */
+    int drainAll(int maxPerMailbox = DRAIN_BATCH_LIMIT);
+
+    /**
+     * @brief 获取全局实例
+     *
+     * @return MailboxHub* 当前登记的枢纽，可能为nullptr
+     */
+    static MailboxHub *active() { return s_active; }
+
+    /**
+     * @brief 登记全局实例
+     *
+     * @param hub 枢纽指针，nullptr解除登记
+     */
+    static void setActive(MailboxHub *hub) { s_active = hub; }
+
+    /**
+     * @brief 单信箱单帧默认排空上限
+     */
+    static constexpr int DRAIN_BATCH_LIMIT = 64;
+
+signals:
+    /**
+     * @brief 背压信号
+     *
+     * 某生产方的信箱在上个排空周期内发生过投递拒绝。
+     *
+     * @param producerName 生产方名称
+     * @param rejectedTotal 该信箱累计拒绝总数
+     */
+    void backpressureDetected(const QString &producerName, quint64 rejectedTotal);
+
+private:
+    /**
+     * @brief 信箱登记项
+     */
+    struct Entry {
+        QString producerName;                    ///< 生产方名称
+        std::unique_ptr<WorkerMailbox> mailbox;  ///< 线程专属信箱
+        quint64 reportedRejects = 0;             ///< 已上报的拒绝计数（仅排空线程访问）
+    };
+
+    mutable QMutex m_registryMutex;                   ///< 保护登记表
+    QHash<Qt::HANDLE, Entry*> m_byThread;             ///< 线程ID→登记项
+    std::vector<std::unique_ptr<Entry>> m_entries;    ///< 登记项存储（只增不删）
+
+    static MailboxHub *s_active;                      ///< 全局实例（主线程登记）
+};
+
+#endif // CORE_WORKERMAILBOX_H
@@ -0,0 +1,139 @@
+/*
+ * 文件名: BattleActionLog.h
+ * 说明: 列式战斗日志，战斗中零格式化记录，战后异步生成文本。
+ * 作者: 彭承康
+ * 创建时间: 2026-08-28
+ *
+ * 战斗中逐动作拼接QString并走日志输出会明显消耗帧时间。
+ * 本类把每个战斗动作压缩为定长二进制记录（回合、行动者、
+ * 技能、伤害、标志位），战斗中只向预分配缓冲追加一条记录；
+ * 战斗结束后在后台线程统一格式化为可读文本，经linesReady
+ * 信号送回主线程。二进制记录可导出成文件，配合
+ * tools/battle_log_export 用于支持工单排查。
+ */
+#pragma once
+
+#include <QObject>
+#include <QHash>
+#include <QString>
+#include <QStringList>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief 列式战斗日志
+ *
+ * 线程模型：beginBattle/registerActor/append/exportBinary只能在
+ * 主线程调用；flushAsync在后台线程格式化记录快照并通过
+ * linesReady信号（自动队列连接）把文本送回主线程。
+ */
+class BattleActionLog : public QObject
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief 动作标志位
+     */
+    enum Flag : quint16 {
+        FlagNone = 0x0,
+        FlagCritical = 0x1,        ///< 暴击
+        FlagTargetDefeated = 0x2,  ///< 目标被击败（敌人死亡/玩家倒下）
+        FlagEnemyAction = 0x4,     ///< 行动者是敌人
+        FlagSkill = 0x8            ///< 技能攻击（区别于普通攻击）
+    };
+
+    /**
+     * @brief 定长动作记录（14字节，战斗中仅做一次追加）
+     */
+    struct Record {
+        quint16 turn;     ///< 回合数
+        qint16 actorId;   ///< 行动者ID（-1为玩家）
+        qint16 targetId;  ///< 目标ID（-1为玩家）
+        quint16 skillId;  ///< 技能ID（0为普通攻击）
+        qint32 damage;    ///< 伤害值（治疗为恢复量）
+        quint16 flags;    ///< Flag位掩码
+    };
+
+    /// 导出文件魔数（"FLBL"：Fantasy Legend Battle Log）
+    static constexpr quint32 EXPORT_MAGIC = 0x464C424C;
+    /// 导出文件格式版本
+    static constexpr quint16 EXPORT_VERSION = 1;
+    /// 预分配的记录容量（常规战斗不触发扩容）
+    static constexpr int RESERVED_RECORDS = 1024;
+
+    explicit BattleActionLog(QObject *parent = nullptr);
+
+    /**
+     * @brief 析构函数，等待后台格式化线程结束
+     */
+    ~BattleActionLog() override;
+
+    /**
+     * @brief 开始一场战斗的记录
+     *
+     * 清空上一场的记录与单位名称表；缓冲容量保留，不重新分配。
+     */
+    void beginBattle();
+
+    /**
+     * @brief 注册单位名称（格式化时把ID还原为名称）
+     * @param actorId 单位ID（-1为玩家）
+     * @param name 单位名称
+     */
+    void registerActor(qint16 actorId, const QString &name);
+
+    /**
+     * @brief 追加一条动作记录（热路径，无格式化、常规无分配）
+     */
+    void append(quint16 turn, qint16 actorId, qint16 targetId,
+                quint16 skillId, qint32 damage, quint16 flags);
+
+    /**
+     * @brief 获取已记录的动作数
+     */
+    int recordCount() const { return static_cast<int>(m_records.size()); }
+
+    /**
+     * @brief 异步格式化本场战斗的全部记录
+     *
+     * 对记录做POD快照后交给后台线程格式化，完成后通过
+     * linesReady信号送回。记录本身保留到下一次beginBattle，
+     * 之后仍可exportBinary。
+     */
+    void flushAsync();
+
+    /**
+     * @brief 导出二进制记录（支持工单用）
+     *
+     * 文件格式：魔数(u32) 版本(u16) 记录数(u32)，随后每条记录
+     * 按字段顺序以小端写出。用 tools/battle_log_export 查看。
+     *
+     * @param filePath 导出文件路径
+     * @return 写入成功返回true
+     */
+    bool exportBinary(const QString &filePath) const;
+
+signals:
+    /**
+     * @brief 后台格式化完成
+     * @param lines 按记录顺序生成的战斗日志文本
+     */
+    void linesReady(const QStringList &lines);
+
+private:
+    /**
+     * @brief 把一批记录格式化为文本（后台线程执行）
+     */
+    static QStringList formatRecords(const std::vector<Record> &records,
+                                     const QHash<qint16, QString> &names);
+
+    /**
+     * @brief 等待上一次flushAsync的线程结束
+     */
+    void joinWorker();
+
+    std::vector<Record> m_records;       ///< 动作记录缓冲（预分配）
+    QHash<qint16, QString> m_actorNames; ///< 单位ID到名称的映射
+    std::thread m_flushThread;           ///< 后台格式化线程
+};
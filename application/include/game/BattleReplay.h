@@ -0,0 +1,161 @@
+/*
+ * 文件名: BattleReplay.h
+ * 说明: 战斗回放数据，记录一场战斗完整重放所需的全部输入。
+ * 作者: 彭承康
+ * 创建时间: 2026-08-28
+ *
+ * 玩家报告"这场战斗很卡"时，日志里往往找不到原因。回放系统
+ * 把战斗配置、玩家快照、RNG种子、操作序列和RPC响应记录成
+ * 紧凑日志，离线在无头模式下按原顺序重放，战斗过程与原始
+ * 战斗逐位一致，配合性能监控把问题报告变成可分析的档案。
+ */
+#pragma once
+
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QString>
+
+/**
+ * @brief 战斗回放数据
+ *
+ * 一场战斗的确定性重放需要四类输入：
+ * - 战斗配置与玩家属性快照（初始状态）
+ * - RNG种子（本地随机数全部由该种子派生）
+ * - 玩家操作序列（攻击/物品/防御/跳过，按发生顺序）
+ * - RPC响应（权威伤害结果，回放时不经网络按原顺序消费）
+ *
+ * 文件格式为qCompress压缩的紧凑JSON，与存档格式一致。
+ * 记录由BattleSystem在战斗过程中填充，回放由
+ * BattleSystem::playReplay()消费。
+ */
+class BattleReplay
+{
+public:
+    /**
+     * @brief 开始记录一场战斗
+     *
+     * 清空旧数据并保存初始状态。
+     *
+     * @param config 战斗配置JSON
+     * @param playerSnapshot 玩家属性快照（Player::toJson()）
+     * @param seed 本场战斗的RNG种子
+     */
+    void begin(const QJsonObject &config, const QJsonObject &playerSnapshot, quint32 seed);
+
+    /**
+     * @brief 记录一次玩家操作
+     *
+     * @param turn 操作发生的回合数
+     * @param type 操作类型（attack/item/defend/skip）
+     * @param params 操作参数（目标ID、技能ID等）
+     */
+    void recordAction(int turn, const QString &type, const QJsonObject &params);
+
+    /**
+     * @brief 记录一次RPC响应
+     *
+     * 权威伤害结果按到达顺序追加，回放时按同一顺序消费。
+     *
+     * @param response 响应JSON
+     */
+    void recordRpcResponse(const QJsonObject &response);
+
+    /**
+     * @brief 保存到文件
+     *
+     * @param filePath 目标文件路径
+     * @return bool 是否保存成功
+     */
+    bool save(const QString &filePath) const;
+
+    /**
+     * @brief 从文件加载
+     *
+     * @param filePath 回放文件路径
+     * @return bool 是否加载成功（版本不匹配视为失败）
+     */
+    bool load(const QString &filePath);
+
+    /**
+     * @brief 清空全部数据
+     */
+    void clear();
+
+    /**
+     * @brief 是否为空（未记录任何战斗）
+     *
+     * @return bool 是否为空
+     */
+    bool isEmpty() const;
+
+    /**
+     * @brief 获取战斗配置
+     *
+     * @return QJsonObject 战斗配置JSON
+     */
+    QJsonObject config() const;
+
+    /**
+     * @brief 获取玩家属性快照
+     *
+     * @return QJsonObject 玩家快照JSON
+     */
+    QJsonObject playerSnapshot() const;
+
+    /**
+     * @brief 获取RNG种子
+     *
+     * @return quint32 本场战斗的RNG种子
+     */
+    quint32 seed() const;
+
+    /**
+     * @brief 获取操作序列
+     *
+     * @return QJsonArray 操作JSON数组（{turn, type, params}）
+     */
+    QJsonArray actions() const;
+
+    /**
+     * @brief 获取RPC响应序列
+     *
+     * @return QJsonArray 响应JSON数组
+     */
+    QJsonArray rpcResponses() const;
+
+private:
+    /**
+     * @brief 回放格式版本号
+     */
+    static constexpr int REPLAY_VERSION = 1;
+
+    /**
+     * @brief 战斗配置
+     */
+    QJsonObject m_config;
+
+    /**
+     * @brief 玩家属性快照
+     */
+    QJsonObject m_playerSnapshot;
+
+    /**
+     * @brief RNG种子
+     */
+    quint32 m_seed = 0;
+
+    /**
+     * @brief 玩家操作序列
+     */
+    QJsonArray m_actions;
+
+    /**
+     * @brief RPC响应序列
+     */
+    QJsonArray m_rpcResponses;
+
+    /**
+     * @brief 是否已记录战斗
+     */
+    bool m_hasBattle = false;
+};
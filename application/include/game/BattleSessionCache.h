@@ -0,0 +1,142 @@
+/*
+ * 文件名: BattleSessionCache.h
+ * 说明: 战斗会话缓存，探索期间预协商战斗入场所需的规则数据。
+ * 作者: 彭承康
+ * 创建时间: 2026-08-28
+ *
+ * 战斗入场此前要付"取战斗规则"的RPC往返：玩家一局里要打
+ * 数百场战斗，每次入场都重复同一笔网络成本。本类把这次协商
+ * 提前到探索阶段：后台周期性地用GetGameRules拉取combat类规则
+ * 并缓存（通道本就由GrpcChannelManager保持keepalive热连接），
+ * 战斗开始时直接取缓存拼入战斗配置，入场只剩场景切换加一次
+ * 权威RPC。缓存带TTL，过期后在下个刷新节拍补新，不阻塞入场。
+ */
+#pragma once
+
+#include <QObject>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QElapsedTimer>
+
+class QTimer;
+class StrategyServiceClient;
+
+/**
+ * @brief 战斗会话缓存类
+ *
+ * 该类维护战斗入场所需的预协商数据，包括：
+ * - combat类游戏规则的后台拉取与缓存
+ * - 缓存新鲜度管理（TTL过期后台补新）
+ * - 入场时的会话数据组装
+ *
+ * 刷新由内部定时器在探索期间驱动（同步RPC，成本与时钟同步
+ * 采样同级）；缓存未命中时退回一次同步拉取并记录告警，这是
+ * 旧的慢路径，只在冷启动直接进战斗等少数情况发生。
+ */
+class BattleSessionCache : public QObject
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief 构造函数
+     *
+     * @param parent 父对象指针
+     */
+    explicit BattleSessionCache(QObject *parent = nullptr);
+
+    /**
+     * @brief 初始化缓存
+     *
+     * 保存客户端引用并启动后台刷新：首次拉取推迟到事件循环
+     * 空闲（不阻塞调用方），之后按刷新间隔维持缓存新鲜。
+     *
+     * @param strategyClient 策略服务客户端指针，不拥有
+     */
+    void initialize(StrategyServiceClient *strategyClient);
+
+    /**
+     * @brief 缓存是否可用
+     *
+     * @return bool 已持有一份combat规则时返回true（可能已过期，
+     *              过期数据仍优于入场时同步等待）
+     */
+    bool isReady() const { return !m_combatRules.isEmpty(); }
+
+    /**
+     * @brief 缓存是否已过期
+     *
+     * @return bool 距上次成功拉取超过TTL时返回true
+     */
+    bool isStale() const;
+
+    /**
+     * @brief 获取缓存的规则版本号
+     *
+     * @return int 规则版本，未拉取到时为0
+     */
+    int rulesVersion() const { return m_rulesVersion; }
+
+    /**
+     * @brief 取出战斗会话数据
+     *
+     * 返回可直接并入战斗配置的会话片段（rules数组与版本号）。
+     * 缓存为空时退回一次同步拉取——旧的慢路径，仅作兜底。
+     *
+     * @return QJsonObject 会话数据，拉取失败时为空对象
+     */
+    QJsonObject takeBattleSession();
+
+    /**
+     * @brief 立即刷新缓存
+     *
+     * 同步拉取combat规则并更新缓存；客户端未连接时跳过，
+     * 等下个刷新节拍。
+     */
+    void refresh();
+
+signals:
+    /**
+     * @brief 会话刷新完成信号
+     *
+     * @param version 新的规则版本号
+     */
+    void sessionRefreshed(int version);
+
+private:
+    /**
+     * @brief 策略服务客户端指针（不拥有）
+     */
+    StrategyServiceClient *m_strategyClient;
+
+    /**
+     * @brief 后台刷新定时器
+     */
+    QTimer *m_refreshTimer;
+
+    /**
+     * @brief 缓存的combat规则数组
+     */
+    QJsonArray m_combatRules;
+
+    /**
+     * @brief 缓存的规则版本号
+     */
+    int m_rulesVersion;
+
+    /**
+     * @brief 上次成功拉取的时刻（m_clock时基，毫秒；-1表示从未）
+     */
+    qint64 m_fetchedAtMs;
+
+    /**
+     * @brief 单调时钟（构造时启动，新鲜度判断的时间基准）
+     */
+    QElapsedTimer m_clock;
+
+    /** @brief 后台刷新间隔（毫秒） */
+    static constexpr int REFRESH_INTERVAL_MS = 120000;
+
+    /** @brief 缓存TTL（毫秒），超过视为过期 */
+    static constexpr qint64 STALE_AFTER_MS = 300000;
+};
@@ -15,9 +15,14 @@
 #include <QStringList>
 #include <QTimer>
 #include <QList>
+#include <QRandomGenerator>
+#include <QVarLengthArray>
+#include "game/BattleActionLog.h"
+#include "game/BattleReplay.h"
 
 class Player;
 class AlgorithmServiceClient;
+class BattleSessionCache;
 
 /**
  * @brief 战斗状态枚举
@@ -45,9 +50,27 @@ struct Enemy {
     int level;              ///< 等级
 };
 
+/**
+ * @brief 战斗单位池条目（缓存行对齐）
+ *
+ * 战斗期间回合结算读写的热数据。玩家与敌人的属性在战斗开始
+ * 时拷贝进连续的池数组（槽0为玩家），整场战斗的回合逻辑只
+ * 触碰这一块缓存友好的内存；名称等冷数据留在Enemy/Player中，
+ * 结果在战斗结束时写回Player。
+ */
+struct alignas(64) BattleCombatant {
+    int entityId;       ///< 单位ID（-1表示玩家）
+    int health;         ///< 当前生命值
+    int maxHealth;      ///< 最大生命值
+    int attack;         ///< 攻击力
+    int defense;        ///< 防御力
+    int speed;          ///< 速度
+    int level;          ///< 等级
+};
+
 /**
  * @brief 战斗系统类
- * 
+ *
  * 该类管理游戏的回合制战斗系统，包括：
  * - 战斗流程控制
  * - 回合顺序管理
@@ -93,6 +116,17 @@ public:
      */
     bool initialize(Player *player, AlgorithmServiceClient *algorithmClient);
 
+    /**
+     * @brief 设置战斗会话缓存
+     *
+     * 设置后startBattle()从缓存取探索期间预协商好的combat规则
+     * 并入战斗配置（配置自带rules时不覆盖），入场不再付取规则
+     * 的RPC往返。未设置时配置按原样使用。
+     *
+     * @param sessionCache 会话缓存指针，不拥有，可为空
+     */
+    void setSessionCache(BattleSessionCache *sessionCache) { m_sessionCache = sessionCache; }
+
     // 战斗控制接口
     
     /**
@@ -192,7 +226,17 @@ public:
      * @return QStringList 战斗日志列表
      */
     QStringList getBattleLog() const;
-    
+
+    /**
+     * @brief 导出最近一场战斗的二进制动作日志（支持工单用）
+     *
+     * 用 tools/battle_log_export 可将导出文件还原为可读文本。
+     *
+     * @param filePath 导出文件路径
+     * @return bool 写入成功返回true
+     */
+    Q_INVOKABLE bool exportBattleActionLog(const QString &filePath) const;
+
     /**
      * @brief 获取当前回合数
      * 
@@ -202,14 +246,63 @@ public:
     
     /**
      * @brief 获取回合顺序
-     * 
+     *
+     * 返回预构建的回合顺序视图，不做排序或查找；视图在回合表
+     * 重算时一并刷新。
+     *
      * @return QJsonArray 回合顺序的JSON数组
      */
     QJsonArray getTurnOrder() const;
 
+    /**
+     * @brief 施加速度修正（加速/减速类效果）
+     *
+     * 调整指定单位的速度并立即重算回合表；没有速度事件时
+     * 回合表在整场战斗中保持不变，不做逐回合重排。
+     *
+     * @param entityId 目标单位ID（-1表示玩家，玩家速度由其
+     *                 状态效果决定，此时仅触发重算）
+     * @param delta 速度变化量（正为加速，负为减速）
+     */
+    Q_INVOKABLE void applySpeedModifier(int entityId, int delta);
+
+    // 回放接口
+
+    /**
+     * @brief 启用/关闭回放记录
+     *
+     * 启用后每场战斗自动记录配置、玩家快照、RNG种子、
+     * 操作序列和RPC响应，可在战斗结束后用saveReplay()导出。
+     *
+     * @param enabled 是否启用记录
+     */
+    Q_INVOKABLE void setReplayRecordingEnabled(bool enabled);
+
+    /**
+     * @brief 保存最近一场战斗的回放
+     *
+     * @param filePath 目标文件路径
+     * @return bool 是否保存成功
+     */
+    Q_INVOKABLE bool saveReplay(const QString &filePath) const;
+
+    /**
+     * @brief 确定性回放一场战斗
+     *
+     * 无头模式：用记录的种子初始化战斗RNG，按原顺序重放
+     * 玩家操作，RPC响应从记录中同步消费（不经网络），所有
+     * 回合延时定时器被跳过，整场战斗在本次调用内同步执行
+     * 完毕，结果与原始战斗逐位一致。调用方需先用回放中的
+     * 玩家快照恢复玩家属性。
+     *
+     * @param replay 回放数据
+     * @return bool 回放是否完整执行到战斗结束
+     */
+    bool playReplay(const BattleReplay &replay);
+
     /**
      * @brief 更新战斗逻辑
-     * 
+     *
      * @param deltaTime 帧时间间隔
      */
     void update(float deltaTime);
@@ -325,8 +418,19 @@ private:
     
     /**
      * @brief 计算回合顺序
+     *
+     * 按速度排序存活单位生成本轮回合表，并重建暴露给QML的
+     * 只读视图。只在战斗开始、速度事件和单位死亡后的回合
+     * 边界调用，普通回合直接复用既有回合表。
      */
     void calculateTurnOrder();
+
+    /**
+     * @brief 标记回合表失效
+     *
+     * 速度事件或单位死亡时调用，下个回合开始时重算。
+     */
+    void markTurnOrderDirty();
     
     /**
      * @brief 开始玩家回合
@@ -348,13 +452,45 @@ private:
      */
     void endEnemyTurn();
     
+    /**
+     * @brief 构建战斗单位池
+     *
+     * 战斗开始时把玩家与敌人的热属性拷贝进连续的对齐数组，
+     * 此后所有回合逻辑只读写池。
+     */
+    void buildCombatantPool();
+
+    /**
+     * @brief 把战斗结果写回Player
+     *
+     * 战斗结束时用差量经takeDamage()/heal()同步玩家生命值，
+     * 血量与死亡信号在此一次性触发。
+     */
+    void writeBackBattleResults();
+
+    /**
+     * @brief 按单位ID查找池条目
+     *
+     * @param entityId 单位ID（-1表示玩家）
+     * @return BattleCombatant* 池条目指针，不存在返回nullptr
+     */
+    BattleCombatant *findCombatant(int entityId);
+
+    /**
+     * @brief 查询单位名称（冷数据，仅日志/视图使用）
+     *
+     * @param entityId 单位ID（-1表示玩家）
+     * @return QString 单位名称
+     */
+    QString combatantName(int entityId) const;
+
     /**
      * @brief 执行玩家攻击
-     * 
-     * @param target 目标敌人
+     *
+     * @param target 目标单位的池条目
      * @param skillId 技能ID
      */
-    void executePlayerAttack(Enemy &target, int skillId);
+    void executePlayerAttack(BattleCombatant &target, int skillId);
     
     /**
      * @brief 执行玩家物品使用
@@ -364,6 +500,20 @@ private:
      */
     void executePlayerItemUse(int itemId, int targetId);
     
+    /**
+     * @brief 应用权威伤害结果
+     *
+     * 以攻击前血量和权威伤害校正预测值、更新战斗日志并
+     * 结束玩家回合。在线时由RPC回调调用，回放时由
+     * executePlayerAttack()用记录的响应同步调用。
+     *
+     * @param targetId 目标敌人ID
+     * @param skillId 技能ID（写入动作日志）
+     * @param healthBefore 攻击前目标血量
+     * @param result 伤害计算结果JSON
+     */
+    void applyDamageResult(int targetId, int skillId, int healthBefore, const QJsonObject &result);
+
     /**
      * @brief 执行敌人行动
      */
@@ -371,19 +521,32 @@ private:
     
     /**
      * @brief 执行单个敌人行动
-     * 
-     * @param enemy 敌人对象
+     *
+     * @param enemy 敌人的池条目
      */
-    void executeEnemyAction(Enemy &enemy);
+    void executeEnemyAction(BattleCombatant &enemy);
     
     /**
      * @brief 执行自动行动
      */
     void executeAutoAction();
     
+    /**
+     * @brief 本地预测技能伤害
+     *
+     * 镜像算法服务的文档公式（属性×技能倍率×防御减免），
+     * 去掉暴击与随机浮动，用于在权威RPC结果到达前即时反馈。
+     * 预测值不具权威性，最终以服务端结果校正。
+     *
+     * @param skillId 技能ID
+     * @param target 目标单位的池条目
+     * @return int 预测伤害值
+     */
+    int predictDamage(int skillId, const BattleCombatant &target) const;
+
     /**
      * @brief 检查战斗是否结束
-     * 
+     *
      * @return bool 是否结束
      */
     bool checkBattleEnd();
@@ -405,6 +568,11 @@ private:
      * @brief 算法服务客户端指针
      */
     AlgorithmServiceClient *m_algorithmClient;
+
+    /**
+     * @brief 战斗会话缓存指针（不拥有，可为空）
+     */
+    BattleSessionCache *m_sessionCache;
     
     /**
      * @brief 当前战斗状态
@@ -412,15 +580,34 @@ private:
     BattleState m_battleState;
     
     /**
-     * @brief 敌人列表
+     * @brief 敌人列表（冷数据：名称与初始配置）
      */
     QList<Enemy> m_enemies;
-    
+
+    /**
+     * @brief 战斗单位池（槽0为玩家，回合结算的唯一热数据）
+     *
+     * 内联容量覆盖常规遭遇战，池整体驻留在本对象内，回合
+     * 结算不再跨堆追逐指针。
+     */
+    QVarLengthArray<BattleCombatant, 8> m_combatants;
+
+
     /**
      * @brief 回合顺序（实体ID列表，-1表示玩家）
      */
     QList<int> m_turnOrder;
-    
+
+    /**
+     * @brief 回合顺序的预构建JSON视图（与m_turnOrder同步刷新）
+     */
+    QJsonArray m_turnOrderView;
+
+    /**
+     * @brief 回合表是否需要重算
+     */
+    bool m_turnOrderDirty;
+
     /**
      * @brief 当前回合数
      */
@@ -450,4 +637,44 @@ private:
      * @brief 自动战斗模式
      */
     bool m_autoMode;
+
+    /**
+     * @brief 本场战斗的RNG种子
+     */
+    quint32 m_battleSeed;
+
+    /**
+     * @brief 战斗本地随机数流（由m_battleSeed派生，可重放）
+     */
+    QRandomGenerator m_battleRandom;
+
+    /**
+     * @brief 是否记录回放
+     */
+    bool m_recordReplay;
+
+    /**
+     * @brief 最近一场战斗的回放记录
+     */
+    BattleReplay m_replay;
+
+    /**
+     * @brief 列式动作日志（战斗中二进制记录，战后异步格式化）
+     */
+    BattleActionLog m_actionLog;
+
+    /**
+     * @brief 是否处于回放模式
+     */
+    bool m_playbackMode;
+
+    /**
+     * @brief 回放模式下待消费的RPC响应
+     */
+    QList<QJsonObject> m_playbackResponses;
+
+    /**
+     * @brief 下一个待消费的RPC响应下标
+     */
+    int m_playbackResponseIndex;
 };
\ No newline at end of file
@@ -34,9 +34,13 @@
 #include <QObject>
 #include <QVariant>
 #include <QMap>
+#include <QList>
+#include <QVector>
 #include <QMutex>
 #include <QDateTime>
 #include <QJsonObject>
+#include <QJsonArray>
+#include <atomic>
 
 /**
  * @brief 游戏状态管理器
@@ -94,7 +98,35 @@ public:
         Archer          ///< 弓箭手
     };
     Q_ENUM(PlayerClass)
-    
+
+    /**
+     * @brief 存档分段标志
+     *
+     * 状态数据按保存粒度划分为若干段，setter修改数据时把
+     * 对应段标记为脏。SaveManager的增量保存只快照脏段，
+     * 避免每次自动存档都序列化整个状态。
+     */
+    enum class SaveSection : quint32 {
+        None        = 0,        ///< 无脏段
+        PlayerStats = 1u << 0,  ///< 玩家数据（等级、经验、金币、姓名、职业）
+        Progress    = 1u << 1,  ///< 进度数据（状态、场景、进度百分比）
+        StateData   = 1u << 2,  ///< 通用键值对状态数据
+        All         = 0x7       ///< 全部段
+    };
+
+    /**
+     * @brief 单条状态变更记录
+     *
+     * 每次setter实际修改数据时生成一条记录，版本号全局递增。
+     * 键名与toJson()一致，消费端可以直接把记录按键合并成补丁。
+     */
+    struct StateChangeRecord {
+        quint64 version;        ///< 该变更对应的状态版本号
+        SaveSection section;    ///< 变更所属的逻辑段
+        QString key;            ///< 变更键（与toJson键一致）
+        QVariant value;         ///< 变更后的新值
+    };
+
     /**
      * @brief 构造函数
      * @param parent 父对象指针
@@ -293,6 +325,101 @@ public:
      */
     bool loadFromJson(const QJsonObject &json);
 
+    // ==================== 脏段跟踪（增量保存） ====================
+
+    /**
+     * @brief 查询当前脏段集合
+     * @return quint32 SaveSection标志位组合
+     */
+    quint32 dirtySections() const { return m_dirtySections.load(std::memory_order_acquire); }
+
+    /**
+     * @brief 取出并清空脏段集合
+     *
+     * 原子交换，供SaveManager在自动存档开始时调用：返回后
+     * 新产生的修改会重新置脏，留给下一次存档。
+     *
+     * @return quint32 清空前的SaveSection标志位组合
+     */
+    quint32 takeDirtySections() { return m_dirtySections.exchange(0, std::memory_order_acq_rel); }
+
+    /**
+     * @brief 标记存档段为脏
+     * @param section 被修改的段
+     */
+    void markSectionDirty(SaveSection section);
+
+    /**
+     * @brief 序列化单个存档段
+     *
+     * 返回的对象只含该段的键，键名与toJson()一致，因此段
+     * 快照可以直接按键合并回完整存档（段级补丁）。
+     *
+     * @param section 要序列化的段
+     * @return QJsonObject 段数据快照
+     */
+    QJsonObject sectionToJson(SaveSection section) const;
+
+    // ==================== 版本号与变更日志（增量同步） ====================
+
+    /**
+     * @brief 获取当前状态版本号
+     *
+     * 每次setter实际修改数据时递增。存档和网络同步端记下
+     * 消费时的版本号，之后用changesSince()只取增量。
+     *
+     * @return quint64 当前版本号
+     */
+    quint64 stateVersion() const;
+
+    /**
+     * @brief 获取自指定版本以来的变更记录
+     *
+     * 日志容量有界；请求的版本落在日志窗口内时返回逐键
+     * 变更（sinceVersion等于当前版本时为空列表），版本过旧
+     * 或日志被批量加载失效时返回false，调用方应退回完整
+     * 快照（toJson或sectionToJson）。
+     *
+     * @param sinceVersion 调用方已消费到的版本号
+     * @param outChanges 输出参数，按版本号升序的变更记录
+     * @return bool 日志能否服务该版本
+     */
+    bool changesSince(quint64 sinceVersion, QVector<StateChangeRecord> *outChanges) const;
+
+    /**
+     * @brief 由变更日志生成RFC-6902风格的JSON补丁
+     *
+     * 把sinceVersion之后的日志记录折算成补丁操作数组：同键多次
+     * 变更只保留最后一次，补丁体积与改动键数成正比，与改动次数
+     * 无关。路径与toJson()布局一致（顶层键为"/playerLevel"等，
+     * 通用数据为"/stateData/<键>"，键按JSON指针规则转义）；顶层
+     * 键恒存在故生成"replace"，stateData成员生成"add"（对对象
+     * 成员即插入或覆盖）。
+     *
+     * 返回语义与changesSince()相同：版本过旧或日志被批量加载
+     * 失效时返回false，调用方退回完整快照。
+     *
+     * @param sinceVersion 调用方已消费到的版本号
+     * @param outPatch 输出参数，补丁操作数组
+     * @param outVersion 可选输出，补丁覆盖到的当前版本号
+     * @return bool 日志能否服务该版本
+     */
+    bool patchSince(quint64 sinceVersion, QJsonArray *outPatch,
+                    quint64 *outVersion = nullptr) const;
+
+    /**
+     * @brief 把RFC-6902风格补丁应用到状态JSON上
+     *
+     * 支持"add"、"replace"、"remove"三种操作与对象成员路径
+     * （本状态JSON没有数组，不支持数组下标）。任一操作失败时
+     * 返回false，target可能已被部分修改，调用方应弃用。
+     *
+     * @param target 输入输出参数，与toJson()同构的状态JSON
+     * @param patch 补丁操作数组
+     * @return bool 是否全部应用成功
+     */
+    static bool applyJsonPatch(QJsonObject &target, const QJsonArray &patch);
+
     /**
      * @brief 重置游戏状态到初始值
      * 
@@ -417,7 +544,14 @@ private:
     
     // 线程安全
     mutable QMutex m_mutex;                 ///< 互斥锁，保证线程安全
-    
+    std::atomic<quint32> m_dirtySections{static_cast<quint32>(SaveSection::All)}; ///< 脏段标志位
+
+    // 变更日志（有界窗口，批量加载时整体失效）
+    static constexpr int JOURNAL_CAPACITY = 256;    ///< 日志窗口容量
+    quint64 m_stateVersion = 0;             ///< 当前状态版本号
+    quint64 m_journalFloor = 0;             ///< 日志可服务的最老版本
+    QList<StateChangeRecord> m_journal;     ///< 变更记录窗口
+
     // ==================== 私有方法 ====================
     
     /**
@@ -439,6 +573,38 @@ private:
      * @return int 所需经验值
      */
     int calculateExperienceForLevel(int level) const;
+
+    /**
+     * @brief 记录一条状态变更
+     *
+     * 递增版本号、写入日志窗口并标脏对应存档段。
+     * 调用方必须持有m_mutex。
+     *
+     * @param section 变更所属段
+     * @param key 变更键（与toJson键一致）
+     * @param value 变更后的新值
+     */
+    void recordChange(SaveSection section, const QString &key, const QVariant &value);
+
+    /**
+     * @brief 按JSON指针规则转义路径段（~→~0，/→~1）
+     */
+    static QString jsonPointerSegment(const QString &key);
+
+    /**
+     * @brief 变更记录对应的JSON指针路径
+     *
+     * StateData段的键位于"/stateData/<键>"，其余段的键在顶层。
+     */
+    static QString pathForChange(SaveSection section, const QString &key);
+
+    /**
+     * @brief 使变更日志整体失效
+     *
+     * 批量加载绕过setter逐键记录时调用，之后changesSince()
+     * 只能以完整快照回退。内部自行加锁。
+     */
+    void invalidateJournal();
 };
 
 #endif // GAMESTATE_H
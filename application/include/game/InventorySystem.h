@@ -23,6 +23,9 @@
 
 #include <QObject>
 #include <QMap>
+#include <QHash>
+#include <QSet>
+#include <QVector>
 #include <QJsonObject>
 #include <QJsonArray>
 
@@ -251,11 +254,33 @@ public:
     
     /**
      * @brief 整理背包
-     * 
+     *
      * 自动合并相同物品，移除空槽位
      */
     Q_INVOKABLE void sortInventory();
 
+    /**
+     * @brief 开始增量整理
+     *
+     * 计算目标排列但不立即移动物品，之后每帧调用
+     * stepIncrementalSort()执行少量交换，把整理开销
+     * 分摊到多帧，避免大背包一次性整理造成的卡顿。
+     */
+    Q_INVOKABLE void beginIncrementalSort();
+
+    /**
+     * @brief 执行一步增量整理
+     * @param maxSwaps 本次最多执行的槽位交换数
+     * @return bool 整理是否已完成
+     */
+    Q_INVOKABLE bool stepIncrementalSort(int maxSwaps = 32);
+
+    /**
+     * @brief 增量整理是否正在进行
+     * @return bool 是否进行中
+     */
+    Q_INVOKABLE bool isSortInProgress() const { return m_sortActive; }
+
     // ==================== QML接口 ====================
     
     /**
@@ -292,6 +317,16 @@ signals:
      * @brief 物品变化信号
      */
     void itemsChanged();
+
+    /**
+     * @brief 单个槽位内容变化信号
+     *
+     * 由writeSlot在槽位内容实际改变时发出，供界面做行级
+     * 增量更新；批量重建（排序、清空、读档）只发itemsChanged。
+     *
+     * @param slotIndex 变化的槽位索引
+     */
+    void slotChanged(int slotIndex);
     
     /**
      * @brief 类别变化信号
@@ -377,6 +412,29 @@ private:
      */
     bool applyItemEffect(const ItemData &itemData);
 
+    /**
+     * @brief 写入槽位内容并同步维护索引
+     *
+     * 所有槽位变更的唯一入口：同步更新id→槽位索引、
+     * 物品总数缓存和空槽位位图，保证查询接口无需扫描。
+     *
+     * @param slotIndex 槽位索引
+     * @param value 新内容（数量为0视为清空）
+     */
+    void writeSlot(int slotIndex, const InventorySlot& value);
+
+    /**
+     * @brief 批量装载后重建全部索引
+     */
+    void rebuildIndices();
+
+    /**
+     * @brief 取消进行中的增量整理
+     *
+     * 任何外部槽位变更都会使预计算的排列失效。
+     */
+    void cancelIncrementalSort();
+
 private:
     /**
      * @brief 背包容量
@@ -402,6 +460,46 @@ private:
      * @brief 物品数据文件路径
      */
     QString m_itemDataFilePath;
+
+    /**
+     * @brief 物品ID→槽位集合索引（仅含非空槽位）
+     */
+    QHash<int, QSet<int>> m_itemSlotIndex;
+
+    /**
+     * @brief 物品ID→持有总数缓存
+     */
+    QHash<int, int> m_itemCounts;
+
+    /**
+     * @brief 空槽位位图（置位表示空闲，每字64个槽位）
+     */
+    QVector<quint64> m_freeSlotBits;
+
+    /**
+     * @brief 增量整理是否进行中
+     */
+    bool m_sortActive;
+
+    /**
+     * @brief 增量整理已就位的前缀长度
+     */
+    int m_sortCursor;
+
+    /**
+     * @brief 目标排列（按排序后的顺序列出原槽位索引）
+     */
+    QVector<int> m_sortOrder;
+
+    /**
+     * @brief 原槽位索引→当前所在槽位
+     */
+    QVector<int> m_sortPos;
+
+    /**
+     * @brief 当前槽位→原槽位索引（m_sortPos的逆映射）
+     */
+    QVector<int> m_sortAt;
 };
 
 } // namespace Game
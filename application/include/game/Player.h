@@ -165,63 +165,72 @@ public:
      * 
      * @return int 当前生命值
      */
-    int getHealth() const { return m_attributes.health; }
+    int getHealth() const { ensureDerived(); return m_attributes.health; }
     
     /**
      * @brief 获取最大生命值
      * 
      * @return int 最大生命值
      */
-    int getMaxHealth() const { return m_attributes.maxHealth; }
+    int getMaxHealth() const { ensureDerived(); return m_attributes.maxHealth; }
     
     /**
      * @brief 获取当前魔法值
      * 
      * @return int 当前魔法值
      */
-    int getMana() const { return m_attributes.mana; }
+    int getMana() const { ensureDerived(); return m_attributes.mana; }
     
     /**
      * @brief 获取最大魔法值
      * 
      * @return int 最大魔法值
      */
-    int getMaxMana() const { return m_attributes.maxMana; }
+    int getMaxMana() const { ensureDerived(); return m_attributes.maxMana; }
     
     /**
      * @brief 获取攻击力
      * 
      * @return int 攻击力
      */
-    int getAttack() const { return m_attributes.attack; }
+    int getAttack() const { ensureDerived(); return m_attributes.attack; }
     
     /**
      * @brief 获取防御力
      * 
      * @return int 防御力
      */
-    int getDefense() const { return m_attributes.defense; }
+    int getDefense() const { ensureDerived(); return m_attributes.defense; }
     
     /**
      * @brief 获取速度
      * 
      * @return int 速度
      */
-    int getSpeed() const { return m_attributes.speed; }
+    int getSpeed() const { ensureDerived(); return m_attributes.speed; }
     
     /**
      * @brief 获取幸运值
      * 
      * @return int 幸运值
      */
-    int getLuck() const { return m_attributes.luck; }
+    int getLuck() const { ensureDerived(); return m_attributes.luck; }
     
     /**
      * @brief 获取完整属性结构
      * 
      * @return PlayerAttributes 玩家属性结构
      */
-    PlayerAttributes getAttributes() const { return m_attributes; }
+    PlayerAttributes getAttributes() const { ensureDerived(); return m_attributes; }
+
+    /**
+     * @brief 批量变更后强制重算全部派生属性
+     *
+     * 等级、装备或状态效果的单次变更只把缓存标脏；
+     * 批量修改（如存档加载）结束后调用本方法一次性重算，
+     * 之后战斗回合中的反复读取都是直接的字段访问。
+     */
+    Q_INVOKABLE void recalculateAll();
 
     // 游戏操作接口
     
@@ -491,10 +500,33 @@ private:
     
     /**
      * @brief 应用状态效果
-     * 
-     * 计算所有状态效果对属性的影响。
+     *
+     * 从基础属性重算派生属性块（职业成长与状态效果加成），
+     * 当前生命值和魔法值保留并按新上限收敛。
+     */
+    void applyStatusEffects() const;
+
+    /**
+     * @brief 把派生属性缓存标记为脏
+     *
+     * 装备、状态效果或等级变更后调用，真正的重算推迟到
+     * 下一次属性读取。
      */
-    void applyStatusEffects();
+    void markDerivedDirty() { m_derivedDirty = true; }
+
+    /**
+     * @brief 确保派生属性缓存有效
+     *
+     * 缓存干净时是一次布尔判断，脏时重算一次；
+     * 读取端因此可以放心地高频调用。
+     */
+    void ensureDerived() const
+    {
+        if (m_derivedDirty) {
+            applyStatusEffects();
+            m_derivedDirty = false;
+        }
+    }
 
 private:
     /**
@@ -518,9 +550,14 @@ private:
     int m_experience;
     
     /**
-     * @brief 玩家基础属性
+     * @brief 当前属性（派生属性缓存，惰性重算）
+     */
+    mutable PlayerAttributes m_attributes;
+
+    /**
+     * @brief 派生属性缓存是否需要重算
      */
-    PlayerAttributes m_attributes;
+    mutable bool m_derivedDirty;
     
     /**
      * @brief 基础属性（不包含加成）
@@ -10,6 +10,7 @@
 
 #include <QObject>
 #include <QMap>
+#include <QHash>
 #include <QVector>
 #include <QString>
 
@@ -74,7 +75,35 @@ public:
     // 系统控制
     void setAnimationEnabled(bool enabled);
     bool isAnimationEnabled() const;
-    
+
+    /**
+     * @brief 设置动画细节层级（帧节奏调节器降档用）
+     *
+     * 层级越高更新定时器间隔越大，动画推进频率越低。推进量
+     * 按定时器实际间隔计算，时长语义不变，只是画面更新变疏。
+     * 可直接连到FramePacingGovernor::detailLevelChanged。
+     *
+     * @param level 细节层级，0为全细节，越界值被钳制
+     */
+    Q_INVOKABLE void setDetailLevel(int level);
+
+    /**
+     * @brief 当前动画细节层级
+     */
+    int getDetailLevel() const;
+
+    /**
+     * @brief 按特效细节层级定档（能力探测用）
+     *
+     * RenderCapabilityProbe的层级语义与细节层级相反
+     * （层级越高保真度越高），本方法做一次映射后委托
+     * setDetailLevel：低档→50ms更新、中档→33ms、高档→16ms。
+     *
+     * @param tier 特效细节层级（0低/1中/2高）
+     */
+    Q_INVOKABLE void setLodTier(int tier);
+
+
     // 统计信息
     QVector<int> getActiveAnimations() const;
     int getAnimationCount() const;
@@ -116,15 +145,58 @@ private:
         int currentTime;                ///< 当前播放时间
         float speed;                    ///< 播放速度倍率
     };
-    
-    void updateSingleAnimation(AnimationData &animData, int deltaTime);
+
+    /**
+     * @brief 播放中动画的SoA热数据
+     *
+     * 逐帧推进只需要的字段按列存成连续数组：updateAnimations
+     * 的热循环是对这些数组的一条线性遍历，纯算术、无哈希查找、
+     * 无信号发射，编译器可以自动向量化。名称、帧序列等冷数据
+     * 留在m_animations里，信号在冷阶段按变更补发。
+     *
+     * 所有列同步增删，下标即活跃槽位；删除用尾部交换保持紧凑。
+     */
+    struct ActiveAnimations {
+        QVector<int> ids;               ///< 动画ID
+        QVector<float> times;           ///< 当前播放时间（毫秒）
+        QVector<float> speeds;          ///< 每动画速度倍率
+        QVector<float> frameDurations;  ///< 单帧时长（毫秒）
+        QVector<float> totalDurations;  ///< 总时长（毫秒）
+        QVector<int> frameCounts;       ///< 帧数
+        QVector<int> currentFrames;     ///< 当前帧索引
+        QVector<quint8> loops;          ///< 是否循环
+
+        int size() const { return ids.size(); }
+    };
+
+    /**
+     * @brief 把动画加入SoA活跃集合
+     * @param animData 动画定义与当前状态
+     */
+    void activateAnimation(const AnimationData &animData);
+
+    /**
+     * @brief 把动画移出SoA活跃集合
+     * @param animationId 动画ID
+     * @param syncBack 是否把SoA中的时间与帧写回m_animations
+     */
+    void deactivateAnimation(int animationId, bool syncBack);
+
     int generateAnimationId();
-    
+
 private:
-    QMap<int, AnimationData> m_animations;  ///< 动画数据映射
+    QMap<int, AnimationData> m_animations;  ///< 动画数据映射（冷数据）
+    ActiveAnimations m_active;              ///< 播放中动画的SoA热数据
+    QHash<int, int> m_activeIndex;          ///< 动画ID到活跃槽位的映射
+    QVector<int> m_scratchFrames;           ///< 热循环输出缓冲（新帧索引）
+    QVector<quint8> m_scratchFinished;      ///< 热循环输出缓冲（完成标志）
     QTimer *m_updateTimer;                  ///< 更新定时器
     bool m_animationEnabled;                ///< 动画是否启用
     float m_globalSpeed;                    ///< 全局播放速度
+    int m_detailLevel;                      ///< 动画细节层级（0为全细节）
+
+    /** @brief 各细节层级的更新间隔（毫秒）：约60/30/20Hz */
+    static constexpr int LOD_INTERVALS_MS[3] = {16, 33, 50};
 };
 
 #endif // ANIMATIONMANAGER_H
\ No newline at end of file
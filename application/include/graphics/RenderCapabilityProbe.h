@@ -0,0 +1,102 @@
+/*
+ * 文件名: RenderCapabilityProbe.h
+ * 说明: 渲染能力探测与特效细节层级选择
+ * 作者: 彭承康
+ * 创建时间: 2026-08-28
+ *
+ * 所有客户端此前按同一特效保真度渲染，低端机难以稳住60帧。
+ * 本类在启动时做一次能力探测：
+ * - 填充率微基准：按本项目实际的QPainter合成路径（带透明度
+ *   与平滑缩放的像素图混合）测量每秒合成的百万像素数
+ * - 平台启发式：CPU核数、架构等硬指标对基准结果做保守修正
+ * 两者合出一个特效细节层级（0低/1中/2高），由SpriteRenderer
+ * 与AnimationManager消费。结果经GameConfig持久化，后续启动
+ * 直接复用；玩家可在设置里手动覆盖，覆盖值优先于探测值。
+ */
+
+#ifndef RENDERCAPABILITYPROBE_H
+#define RENDERCAPABILITYPROBE_H
+
+#include <QString>
+
+class GameConfig;
+
+/**
+ * @brief 渲染能力探测器
+ *
+ * 纯静态工具类：probe()执行微基准并返回探测结果，
+ * resolveTier()封装"手动覆盖 > 持久化探测值 > 现场探测"
+ * 的层级决策，启动路径只需调用后者。
+ */
+class RenderCapabilityProbe
+{
+public:
+    /**
+     * @brief 特效细节层级
+     *
+     * 各消费方的映射：
+     * - SpriteRenderer：低档用快速变换并跳过逐像素色调合成，
+     *   中档保留平滑变换但降低特效密度，高档全保真
+     * - AnimationManager：层级映射到动画更新频率档位
+     */
+    enum Tier {
+        TierLow = 0,     ///< 低档：快速变换、无色调合成、低频动画
+        TierMedium = 1,  ///< 中档：平滑变换、降密度特效
+        TierHigh = 2     ///< 高档：全保真
+    };
+
+    /**
+     * @brief 探测结果
+     */
+    struct Result {
+        int tier = TierHigh;            ///< 选定的细节层级
+        double fillRateMPixPerSec = 0;  ///< 实测合成填充率（百万像素/秒）
+        int cpuCores = 0;               ///< 逻辑核数
+        QString reason;                 ///< 层级选定依据（写进日志与报告）
+    };
+
+    /**
+     * @brief 执行能力探测
+     *
+     * 微基准用与游戏渲染同构的合成负载（带透明度与平滑缩放
+     * 的ARGB32预乘混合）跑固定像素量，取QElapsedTimer计时。
+     * 耗时约几十毫秒，只应在启动时调用一次。
+     *
+     * @return Result 探测结果
+     */
+    static Result probe();
+
+    /**
+     * @brief 决定本次运行使用的细节层级
+     *
+     * 优先级：GameConfig手动覆盖（effectLodTier >= 0）>
+     * 已持久化的探测值 > 现场probe()并写回配置。
+     *
+     * @param config 游戏配置，为nullptr时直接现场探测
+     * @return int 细节层级（Tier枚举值）
+     */
+    static int resolveTier(GameConfig *config);
+
+private:
+    RenderCapabilityProbe() = delete;
+
+    /** @brief 微基准目标画布边长（像素） */
+    static constexpr int BENCH_TARGET_SIZE = 512;
+
+    /** @brief 微基准源图边长（像素） */
+    static constexpr int BENCH_SOURCE_SIZE = 256;
+
+    /** @brief 微基准合成迭代次数 */
+    static constexpr int BENCH_ITERATIONS = 48;
+
+    /** @brief 达到高档所需填充率（百万像素/秒） */
+    static constexpr double HIGH_TIER_MPIX_PER_SEC = 400.0;
+
+    /** @brief 达到中档所需填充率（百万像素/秒） */
+    static constexpr double MEDIUM_TIER_MPIX_PER_SEC = 150.0;
+
+    /** @brief 低于该核数时层级最高只给中档 */
+    static constexpr int MIN_CORES_FOR_HIGH = 4;
+};
+
+#endif // RENDERCAPABILITYPROBE_H
@@ -33,6 +33,13 @@
 #include <QMap>
 #include <QColor>
 #include <QSize>
+#include <QRect>
+#include <QPointF>
+#include <QVector>
+
+class QPainter;
+class JobSystem;
+class IdleMaintenanceScheduler;
 
 /**
  * @brief 精灵渲染器类
@@ -84,9 +91,15 @@ public:
         
         /** @brief 色调滤镜，白色(255,255,255)为无效果 */
         QColor tint = QColor(255, 255, 255);
-        
+
         /** @brief 帧索引，-1表示使用完整图像 */
         int frameIndex = -1;
+
+        /** @brief 绘制层级（0-255），小值先绘制（背景在下） */
+        int layer = 0;
+
+        /** @brief 层内深度，小值先绘制；常用做法是取精灵的y坐标 */
+        float depth = 0.0f;
     };
     
     /**
@@ -169,9 +182,195 @@ public:
      * - 保持帧大小一致以简化处理
      * - 合理安排帧数量以平衡内存和性能
      */
-    bool loadSpriteSheet(const QString &name, const QString &filePath, 
+    bool loadSpriteSheet(const QString &name, const QString &filePath,
                         int frameWidth, int frameHeight, int frameCount);
-    
+
+    /**
+     * @brief 加载纹理图集
+     * @param atlasName 图集名称（用于日志和调试）
+     * @param imagePath 图集图像文件路径
+     * @param indexPath 图集索引JSON文件路径
+     * @return 加载成功返回true，失败返回false
+     *
+     * 图集由 tools/atlas_packer 在构建期生成：一张大图 + JSON索引。
+     * 索引格式：
+     * @code
+     * { "regions": { "ui/button_normal": { "x": 0, "y": 0, "w": 64, "h": 32 } } }
+     * @endcode
+     *
+     * 每个区域注册为一个可按名称访问的精灵，底层共享同一张
+     * QPixmap（隐式共享，不产生拷贝）。共享纹理是批量渲染合并
+     * 绘制调用的前提：同一图集内的精灵在endBatch中合并为
+     * 一次drawPixmapFragments调用。
+     */
+    bool loadAtlas(const QString &atlasName, const QString &imagePath,
+                   const QString &indexPath);
+
+    // ==================== 动态图集接口 ====================
+
+    /**
+     * @brief 设置是否启用动态图集
+     * @param enabled 是否启用
+     *
+     * 启用时（默认），loadSprite加载的小图（两边都不超过
+     * ATLAS_MAX_SPRITE_DIM）自动打包进运行时图集页，与构建期
+     * 图集一样参与批次合并。关闭只影响之后的加载，已打包的
+     * 精灵不受影响。
+     */
+    void setDynamicAtlasEnabled(bool enabled);
+
+    /**
+     * @brief 执行一步增量图集整理
+     * @param budgetMs 本次调用可用的时间预算（毫秒）
+     * @return true表示还有整理工作未完成
+     *
+     * 动态加载/卸载反复进行后，图集页上累积已卸载精灵留下的
+     * 死区，活精灵摊薄到更多页上，批次数随会话时长缓慢劣化。
+     * 本方法每次挑死区占比最高的一页，把它的活精灵逐个搬到
+     * 其他页（或新页），搬空后整页释放。签名与
+     * IdleMaintenanceScheduler::MaintenanceTask一致，按预算
+     * 搬运、超时即停，可直接经registerIdleCompaction挂到
+     * 空闲帧调度器。
+     *
+     * 精灵始终以名称为句柄（缓存键即间接层），搬运只改写
+     * SpriteData内部的区域与纹理ID，调用方持有的名称和实例ID
+     * 全程有效。
+     */
+    bool compactAtlasesStep(qint64 budgetMs);
+
+    /**
+     * @brief 全量重建动态图集
+     *
+     * 把所有动态图集页上的精灵取出后按高度降序重新打包，
+     * 死区一次清零，页数收敛到最小。比增量整理彻底但成本
+     * 集中，应在加载界面可见时调用——把
+     * SceneManager::sceneTransitionStarted连到本槽即可，
+     * 场景切换的加载屏幕正好遮住这次重建。
+     */
+    Q_INVOKABLE void rebuildAtlases();
+
+    /**
+     * @brief 把增量整理注册为空闲帧维护任务
+     * @param scheduler 空闲帧调度器（GameEngine::getIdleScheduler()）
+     *
+     * 以"atlas_compaction"为名注册compactAtlasesStep，最小
+     * 间隔ATLAS_COMPACT_INTERVAL_MS。长会话里碎片在空闲片内
+     * 持续回收，批次数不随会话时长劣化。
+     */
+    void registerIdleCompaction(IdleMaintenanceScheduler *scheduler);
+
+    /**
+     * @brief 获取当前动态图集页数
+     * @return 页数，用于调试与性能监控
+     */
+    int getAtlasPageCount() const;
+
+    // ==================== 批量渲染接口 ====================
+
+    /**
+     * @brief 开始一个渲染批次
+     *
+     * 清空批次队列并进入批量模式。之后通过batchSprite提交
+     * 精灵，最后调用endBatch一次性绘制。
+     *
+     * 战斗场景300+精灵逐个绘制时每个精灵都是独立的绘制调用；
+     * 批量模式按底层纹理分组，同一图集的所有精灵合并为一次
+     * drawPixmapFragments，密集场景只需少数几个批次。
+     */
+    void beginBatch();
+
+    /**
+     * @brief 向当前批次提交一个精灵
+     * @param name 精灵名称
+     * @param position 目标位置（精灵左上角）
+     * @param options 渲染选项
+     *
+     * 仅记录绘制参数，不执行任何绘制。支持缩放、旋转、翻转、
+     * 透明度和帧索引；色调滤镜需要逐像素合成，无法参与批量
+     * 绘制，带色调的精灵请继续使用renderSprite慢速路径。
+     *
+     * 提交时把层级/深度/纹理打包成64位排序键缓存在批次条目上，
+     * endBatch的排序只比较整数键，不回触精灵对象。
+     */
+    void batchSprite(const QString &name, const QPointF &position,
+                     const RenderOptions &options = RenderOptions());
+
+    /**
+     * @brief 结束批次并绘制
+     * @param painter 目标画笔
+     * @return 实际产生的绘制批次数
+     *
+     * 先按缓存的排序键（层级、深度、纹理）做LSD基数排序——
+     * 千级精灵的比较排序每帧都在剖析里可见，基数排序对64位
+     * 整数键是按字节的线性扫描，排序数组取自帧分配器。排序后
+     * 把纹理相同的连续条目合并为一次drawPixmapFragments调用；
+     * 排序键低位是纹理ID，同层同深度的精灵自动聚拢成大批次。
+     * 同键条目间保持提交顺序（基数排序是稳定的）。
+     */
+    int endBatch(QPainter *painter);
+
+    // ==================== 可见性剔除接口 ====================
+
+    /**
+     * @brief 注册一个参与剔除的精灵实例
+     * @param name 精灵名称（须已加载）
+     * @param position 世界坐标位置（精灵左上角）
+     * @param options 渲染选项
+     * @param isStatic 是否为静态精灵（地形、装饰等不移动的元素）
+     * @return 实例ID，0表示注册失败
+     *
+     * 大地图注册的精灵数量是同屏可见数量的10倍以上，逐帧全量
+     * 提交再靠裁剪丢弃是纯粹的浪费。注册后实例的包围盒保存在
+     * 平面数组里，由cullAndBatch在批量提交前做视口剔除。
+     * 静态精灵的可见位带时间相关性（见cullAndBatch）。
+     */
+    quint32 registerSpriteInstance(const QString &name, const QPointF &position,
+                                   const RenderOptions &options = RenderOptions(),
+                                   bool isStatic = false);
+
+    /**
+     * @brief 更新实例位置（自动标记待重测）
+     * @param instanceId 实例ID
+     * @param position 新位置
+     *
+     * 重算包围盒并设置待重测标记，静态实例移动后下一帧
+     * 立即重测可见性，不等粘滞位的周期性复查。
+     */
+    void updateSpriteInstance(quint32 instanceId, const QPointF &position);
+
+    /**
+     * @brief 注销精灵实例
+     * @param instanceId 实例ID
+     *
+     * 平面数组用尾部交换删除，注销不移动其余实例的ID。
+     */
+    void unregisterSpriteInstance(quint32 instanceId);
+
+    /**
+     * @brief 视口剔除并批量提交可见实例
+     * @param viewport 视口矩形（世界坐标）
+     * @param jobSystem 任务系统，为空或实例数低于阈值时单线程剔除
+     * @return 本帧可见（已提交批次）的实例数
+     *
+     * 内部调用beginBatch并提交所有可见实例，调用方随后用
+     * endBatch(painter)完成绘制。剔除在平面包围盒数组上进行，
+     * 实例数达到CULL_PARALLEL_THRESHOLD时切成与工作线程数相同
+     * 的块并行执行，waitForAll同步。
+     *
+     * 时间相关性：实例与外扩CULL_VIEWPORT_MARGIN后的视口求交，
+     * 静态实例的可见位是粘滞的——每CULL_RECHECK_INTERVAL帧才
+     * 全量复查一次，其余帧沿用上次结果；视口单帧移动超过外扩
+     * 边距或实例带待重测标记时强制全量复查，保证不漏显。
+     * 动态实例每帧重测。
+     */
+    int cullAndBatch(const QRectF &viewport, JobSystem *jobSystem = nullptr);
+
+    /**
+     * @brief 获取已注册实例数量
+     * @return 当前注册的精灵实例总数
+     */
+    int getInstanceCount() const;
+
     /**
      * @brief 卸载精灵
      * @param name 要卸载的精灵名称
@@ -290,6 +489,44 @@ public:
      */
     bool isRenderEnabled() const;
 
+    /**
+     * @brief 设置特效密度系数（帧节奏调节器降档用）
+     * @param density 密度系数，钳制到0.0~1.0
+     *
+     * 密度低于TINT_MIN_DENSITY时renderSprite跳过逐像素的色调
+     * 合成（本类最贵的效果路径），其余效果不受影响。接帧节奏
+     * 调节器时在detailLevelChanged的槽里转发其密度参数即可。
+     */
+    void setEffectDensity(float density);
+
+    /**
+     * @brief 获取当前特效密度系数
+     * @return 密度系数（0.0~1.0）
+     */
+    float getEffectDensity() const;
+
+    /**
+     * @brief 设置特效细节层级（能力探测定档用）
+     * @param tier 细节层级（0低/1中/2高），越界值被钳制
+     *
+     * 层级来自RenderCapabilityProbe的启动探测或GameConfig的
+     * 手动覆盖，在启动时设置一次：
+     * - 低档：缩放与旋转用快速变换（最近邻），特效密度归零
+     *   （色调合成被跳过）
+     * - 中档：保留平滑变换，特效密度降到色调阈值以下
+     * - 高档：全保真，等价于默认状态
+     *
+     * 与setEffectDensity的运行时降档互不冲突：本方法设定
+     * 基线密度，帧节奏调节器在其上继续降档。
+     */
+    Q_INVOKABLE void setLodTier(int tier);
+
+    /**
+     * @brief 获取当前特效细节层级
+     * @return 细节层级（0~2）
+     */
+    int getLodTier() const;
+
 signals:
     // ==================== 资源管理信号 ====================
     
@@ -353,13 +590,197 @@ private:
         int frameCount = 1;                    ///< 帧数
         int columns = 1;                       ///< 列数
         int rows = 1;                          ///< 行数
+
+        // 图集相关
+        bool inAtlas = false;                  ///< 是否来自纹理图集
+        QRect atlasRegion;                     ///< 在图集中的区域
+
+        // 排序键的纹理分量：加载时分配的稳定小整数，图集的
+        // 所有区域共享一个ID；重新加载会换新ID，旧键自然失效
+        quint32 textureId = 0;                 ///< 底层纹理ID
     };
-    
+
+    /**
+     * @brief 批次队列中的单个条目
+     */
+    struct BatchItem {
+        QString name;                          ///< 精灵名称
+        QPointF position;                      ///< 目标位置
+        RenderOptions options;                 ///< 渲染选项
+        quint64 sortKey = 0;                   ///< 提交时缓存的排序键
+    };
+
+    /**
+     * @brief 动态图集页
+     *
+     * 运行时按货架（shelf）方式打包小精灵的一张大纹理。货架
+     * 打包只维护一个写入游标，不维护空闲矩形集合——回收依赖
+     * 死区统计驱动的整理/重建，而不是原位复用。
+     */
+    struct AtlasPage {
+        QPixmap pixmap;                        ///< 页纹理
+        quint32 textureId = 0;                 ///< 页内所有区域共享的纹理ID
+        int shelfX = 0;                        ///< 当前货架写入游标X
+        int shelfY = 0;                        ///< 当前货架顶部Y
+        int shelfHeight = 0;                   ///< 当前货架高度
+        qint64 liveArea = 0;                   ///< 在用区域面积（像素）
+        qint64 deadArea = 0;                   ///< 已卸载区域面积（像素）
+        bool sealed = false;                   ///< 整理源页，不再接受新精灵
+        QStringList residents;                 ///< 驻留精灵名称
+    };
+
     QPixmap applyRenderOptions(const QPixmap &sprite, const RenderOptions &options) const;
-    
+
+    /**
+     * @brief 尝试把精灵打包进动态图集
+     * @param data 精灵数据（打包成功后原位改写像素图/区域/纹理ID）
+     * @return 打包成功返回true，尺寸超限或功能关闭返回false
+     */
+    bool packIntoAtlas(SpriteData &data);
+
+    /**
+     * @brief 在页内放置一个矩形（货架打包）
+     * @param page 目标页
+     * @param width 含边距的宽度
+     * @param height 含边距的高度
+     * @param outPos 放置位置（左上角）
+     * @return 放得下返回true并推进货架游标
+     */
+    static bool placeInPage(AtlasPage &page, int width, int height, QPoint &outPos);
+
+    /**
+     * @brief 页像素图变化后刷新所有驻留精灵的像素图引用
+     * @param page 被改写的页
+     *
+     * 向页上绘制会触发QPixmap的写时复制，驻留精灵仍指向旧
+     * 缓冲。统一改指新缓冲后旧缓冲随即释放，页内精灵继续
+     * 共享同一份像素数据。
+     */
+    void refreshAtlasResidents(const AtlasPage &page);
+
+    /**
+     * @brief 释放精灵占用的动态图集区域
+     * @param data 即将卸载或搬出的精灵
+     *
+     * 区域面积记入所属页的死区，页被搬/卸空时整页释放。
+     * 构建期图集（loadAtlas）不在页表中，本方法不影响它们。
+     */
+    void releaseAtlasRegion(const SpriteData &data);
+
+    /**
+     * @brief 按纹理ID查找动态图集页
+     * @param textureId 页纹理ID
+     * @return 页下标，不存在返回-1
+     */
+    int atlasPageIndexById(quint32 textureId) const;
+
+    /**
+     * @brief 选择下一个整理目标页并封存
+     * @return 目标页的纹理ID，无合格页返回0
+     */
+    quint32 selectCompactionTarget();
+
+    /**
+     * @brief 把整理目标页的一个精灵搬到其他页
+     * @param pageIndex 目标页下标
+     */
+    void moveOneResidentOut(int pageIndex);
+
+    /**
+     * @brief 计算实例的世界坐标包围盒
+     * @param data 精灵数据
+     * @param position 实例位置
+     * @param options 渲染选项
+     * @return 包围盒（带旋转的实例取外接正方形，保守不漏显）
+     */
+    QRectF instanceBounds(const SpriteData &data, const QPointF &position,
+                          const RenderOptions &options) const;
+
+    /**
+     * @brief 对实例区间[begin, end)执行视口求交
+     * @param viewport 外扩后的视口
+     * @param fullRecheck 是否忽略粘滞位全量复查
+     * @param begin 区间起点
+     * @param end 区间终点（不含）
+     *
+     * 并行剔除的工作函数：每个下标只属于一个区间，各线程写
+     * 互不重叠的可见位/标记位，无需加锁。
+     */
+    void cullRange(const QRectF &viewport, bool fullRecheck, int begin, int end);
+
+    /**
+     * @brief 计算精灵在底层纹理中的源矩形
+     * @param data 精灵数据
+     * @param frameIndex 帧索引，-1表示完整精灵
+     * @return 源矩形（图集精灵带图集内偏移）
+     */
+    QRect sourceRect(const SpriteData &data, int frameIndex) const;
+
 private:
     QMap<QString, SpriteData> m_spriteCache;   ///< 精灵缓存
+    QVector<BatchItem> m_batchQueue;           ///< 当前批次队列
+    bool m_batchActive = false;                ///< 是否处于批量模式
     bool m_renderEnabled;                      ///< 渲染是否启用
+    float m_effectDensity = 1.0f;              ///< 特效密度系数
+    int m_lodTier = 2;                         ///< 特效细节层级（0低/1中/2高）
+    Qt::TransformationMode m_transformMode = Qt::SmoothTransformation;  ///< 缩放/旋转插值模式
+    quint32 m_nextTextureId = 1;               ///< 下一个纹理ID（0保留）
+
+    // ==================== 动态图集状态 ====================
+    QVector<AtlasPage> m_atlasPages;           ///< 动态图集页表
+    bool m_dynamicAtlasEnabled = true;         ///< 是否把小精灵打包进动态图集
+    quint32 m_compactingPageId = 0;            ///< 整理中的页纹理ID（0表示空闲）
+
+    // ==================== 精灵实例注册表（结构数组布局） ====================
+    // 剔除只触碰包围盒/标记/可见位三个平面数组，名称与渲染选项
+    // 等“冷”数据不进剔除循环的缓存行
+    QVector<QString> m_instanceNames;          ///< 实例精灵名称
+    QVector<QPointF> m_instancePositions;      ///< 实例位置
+    QVector<RenderOptions> m_instanceOptions;  ///< 实例渲染选项
+    QVector<QRectF> m_instanceBounds;          ///< 平面包围盒数组（剔除热数据）
+    QVector<quint8> m_instanceFlags;           ///< INSTANCE_STATIC/INSTANCE_DIRTY
+    QVector<quint8> m_instanceVisible;         ///< 粘滞可见位
+    QVector<quint32> m_instanceIds;            ///< 槽位 → 实例ID
+    QHash<quint32, int> m_instanceIndex;       ///< 实例ID → 槽位
+    quint32 m_nextInstanceId = 1;              ///< 下一个实例ID（0保留）
+    quint32 m_cullFrame = 0;                   ///< 剔除帧计数（粘滞位复查节拍）
+    QRectF m_lastCullViewport;                 ///< 上次剔除的视口（位移检测）
+
+    /** @brief 低于该密度时跳过逐像素色调合成 */
+    static constexpr float TINT_MIN_DENSITY = 0.5f;
+
+    /** @brief 动态图集页边长（像素） */
+    static constexpr int ATLAS_PAGE_SIZE = 1024;
+
+    /** @brief 参与动态打包的精灵最大边长（像素） */
+    static constexpr int ATLAS_MAX_SPRITE_DIM = 256;
+
+    /** @brief 区域间留白（像素），防止采样渗色 */
+    static constexpr int ATLAS_PADDING = 1;
+
+    /** @brief 死区占比达到该值的页成为整理候选 */
+    static constexpr float ATLAS_COMPACT_DEAD_RATIO = 0.35f;
+
+    /** @brief 死区面积低于该值（像素）不值得整理 */
+    static constexpr qint64 ATLAS_MIN_DEAD_AREA = 64 * 64;
+
+    /** @brief 一轮整理完成后到下一轮的最小间隔（毫秒） */
+    static constexpr qint64 ATLAS_COMPACT_INTERVAL_MS = 2000;
+
+    /** @brief 静态实例粘滞可见位的全量复查周期（帧） */
+    static constexpr quint32 CULL_RECHECK_INTERVAL = 8;
+
+    /** @brief 达到该实例数才切块走任务系统并行剔除 */
+    static constexpr int CULL_PARALLEL_THRESHOLD = 256;
+
+    /** @brief 视口外扩边距（像素），吸收复查周期内的滚动 */
+    static constexpr qreal CULL_VIEWPORT_MARGIN = 96.0;
+
+    /** @brief 实例标记：静态精灵 */
+    static constexpr quint8 INSTANCE_STATIC = 0x01;
+
+    /** @brief 实例标记：包围盒已变化，待重测 */
+    static constexpr quint8 INSTANCE_DIRTY = 0x02;
 };
 
 #endif // SPRITERENDERER_H
@@ -0,0 +1,248 @@
+/*
+ * 文件名: VisualEffectPool.h
+ * 说明: 短命视觉特效的预分配对象池（世代句柄）。
+ * 作者: 彭承康
+ * 创建时间: 2026-08-28
+ *
+ * 伤害数字、命中火花、飞行道具这类特效生存期只有几百毫秒，
+ * 逐个new/delete在特效密集的战斗里形成分配尖峰，与最差的
+ * 掉帧时刻完全重合。本池在构造时一次性预分配全部槽位：
+ * spawn是从空闲链表摘一个槽位并填参数，释放是把槽位挂回
+ * 链表，200个粒子的爆发全程零堆分配。
+ *
+ * 槽位复用带来悬空引用问题：持有者的句柄可能指向一个已被
+ * 新特效占用的槽位。句柄因此携带世代号，槽位每次回收世代
+ * 自增，过期句柄的一切操作都安全失效，不会误伤新特效。
+ *
+ * 更新循环的过期槽位收集走FrameAllocator的帧作用域内存，
+ * 一整批粒子同帧到期时同样不触碰堆。
+ */
+#ifndef VISUALEFFECTPOOL_H
+#define VISUALEFFECTPOOL_H
+
+#include <QObject>
+#include <QPointF>
+#include <QString>
+#include <QVector>
+
+#include "graphics/SpriteRenderer.h"
+
+class QPainter;
+
+/**
+ * @brief 特效句柄（槽位索引 + 世代号）
+ *
+ * 值语义，可随意拷贝与跨帧持有。槽位被回收复用后，旧句柄
+ * 的世代号不再匹配，isAlive/release/moveTo等操作静默失效。
+ */
+struct EffectHandle {
+    /** @brief 无效槽位索引 */
+    static constexpr quint32 INVALID_INDEX = 0xFFFFFFFFu;
+
+    /** @brief 槽位索引 */
+    quint32 index = INVALID_INDEX;
+
+    /** @brief 分配时的槽位世代号 */
+    quint32 generation = 0;
+
+    /** @brief 句柄是否曾指向有效槽位（不检查存活） */
+    bool isValid() const { return index != INVALID_INDEX; }
+};
+
+/**
+ * @brief 短命视觉特效对象池
+ *
+ * 固定容量，构造时预分配；spawn/release/update均不分配堆
+ * 内存。特效带位置、速度、生存期、尾段淡出与可选的帧动画，
+ * update推进后经submit批量提交到SpriteRenderer的渲染批次。
+ *
+ * 池满时spawn返回无效句柄并计数——特效是装饰性内容，丢弃
+ * 比扩容更符合帧预算；update在发现新增丢弃时发
+ * poolExhausted信号，供监控面板观察容量是否偏小。
+ */
+class VisualEffectPool : public QObject
+{
+    Q_OBJECT
+
+public:
+    /** @brief 默认池容量（槽位数） */
+    static constexpr int DEFAULT_CAPACITY = 512;
+
+    /**
+     * @brief 特效描述
+     *
+     * spawn的全部参数。精灵名是隐式共享的QString，从已有
+     * 字符串赋值不产生堆分配。
+     */
+    struct EffectDesc {
+        /** @brief 精灵或精灵表名称 */
+        QString spriteName;
+
+        /** @brief 初始位置 */
+        QPointF position;
+
+        /** @brief 速度（像素/秒），伤害数字上飘、飞行道具直线等 */
+        QPointF velocity;
+
+        /** @brief 生存期（毫秒） */
+        float lifetimeMs = 500.0f;
+
+        /** @brief 生存期尾段的淡出窗口（毫秒），0为不淡出 */
+        float fadeOutMs = 120.0f;
+
+        /** @brief 帧动画单帧时长（毫秒），0为不播帧动画 */
+        float frameDurationMs = 0.0f;
+
+        /** @brief 帧动画总帧数 */
+        int frameCount = 1;
+
+        /** @brief 渲染选项（层级、缩放、色调等） */
+        SpriteRenderer::RenderOptions render;
+    };
+
+    /**
+     * @brief 构造对象池
+     * @param renderer 提交批次的目标渲染器（不拥有）
+     * @param capacity 槽位数，构造时一次性预分配
+     * @param parent 父对象指针
+     */
+    explicit VisualEffectPool(SpriteRenderer *renderer,
+                              int capacity = DEFAULT_CAPACITY,
+                              QObject *parent = nullptr);
+
+    /**
+     * @brief 生成一个特效
+     *
+     * 从空闲链表摘取槽位并填入描述，无任何堆分配。
+     *
+     * @param desc 特效描述
+     * @return 世代句柄；池满时返回无效句柄并计入丢弃数
+     */
+    EffectHandle spawn(const EffectDesc &desc);
+
+    /**
+     * @brief 句柄指向的特效是否仍存活
+     * @param handle 特效句柄
+     * @return 槽位在用且世代匹配时返回true
+     */
+    bool isAlive(EffectHandle handle) const;
+
+    /**
+     * @brief 提前释放一个特效
+     *
+     * 飞行道具命中目标等提前结束的场合使用；过期句柄静默
+     * 忽略。
+     *
+     * @param handle 特效句柄
+     * @return 实际释放了存活特效时返回true
+     */
+    bool release(EffectHandle handle);
+
+    /**
+     * @brief 移动一个存活特效
+     *
+     * 跟踪型特效（锁定目标的飞行道具）每帧校正位置用；
+     * 过期句柄静默忽略。
+     *
+     * @param handle 特效句柄
+     * @param position 新位置
+     */
+    void moveTo(EffectHandle handle, const QPointF &position);
+
+    /**
+     * @brief 推进所有存活特效
+     *
+     * 位置按速度积分、年龄累加、到期槽位回收（世代自增后挂
+     * 回空闲链表）。到期收集数组取自帧分配器，当帧用完即弃。
+     *
+     * @param deltaMs 帧间隔（毫秒）
+     */
+    void update(float deltaMs);
+
+    /**
+     * @brief 把所有存活特效提交到当前渲染批次
+     *
+     * 按存活顺序逐个batchSprite：尾段淡出体现为透明度衰减，
+     * 帧动画按年龄换算帧索引。调用方负责beginBatch/endBatch。
+     *
+     * @return 实际提交的特效数
+     */
+    int submit();
+
+    /**
+     * @brief 释放全部存活特效（场景切换用）
+     */
+    void releaseAll();
+
+    /** @brief 当前存活特效数 */
+    int getActiveCount() const { return m_activeSlots.size(); }
+
+    /** @brief 池容量（槽位数） */
+    int getCapacity() const { return m_slots.size(); }
+
+    /** @brief 历史存活峰值，用于容量调参 */
+    int getHighWaterMark() const { return m_highWaterMark; }
+
+    /** @brief 池满导致的累计丢弃次数 */
+    quint64 getDroppedCount() const { return m_droppedCount; }
+
+signals:
+    /**
+     * @brief 池容量耗尽信号
+     *
+     * update发现自上次检查以来有spawn因池满被丢弃时发出。
+     *
+     * @param droppedTotal 累计丢弃次数
+     */
+    void poolExhausted(quint64 droppedTotal);
+
+private:
+    /**
+     * @brief 特效槽位
+     *
+     * 空闲时只有generation与nextFree有意义；世代号在回收时
+     * 自增，使旧句柄失效。
+     */
+    struct Slot {
+        QString spriteName;                     ///< 精灵名称
+        QPointF position;                       ///< 当前位置
+        QPointF velocity;                       ///< 速度（像素/秒）
+        float lifetimeMs = 0.0f;                ///< 生存期（毫秒）
+        float ageMs = 0.0f;                     ///< 已存活时间（毫秒）
+        float fadeOutMs = 0.0f;                 ///< 尾段淡出窗口（毫秒）
+        float frameDurationMs = 0.0f;           ///< 单帧时长（毫秒）
+        int frameCount = 1;                     ///< 帧动画总帧数
+        SpriteRenderer::RenderOptions render;   ///< 渲染选项
+        quint32 generation = 0;                 ///< 当前世代号
+        quint32 activePos = 0;                  ///< 在存活列表中的位置
+        quint32 nextFree = EffectHandle::INVALID_INDEX;  ///< 空闲链表后继
+        bool alive = false;                     ///< 槽位是否在用
+    };
+
+    /**
+     * @brief 解析句柄为存活槽位
+     * @param handle 特效句柄
+     * @return 存活且世代匹配时返回槽位指针，否则nullptr
+     */
+    Slot* resolve(EffectHandle handle);
+    const Slot* resolve(EffectHandle handle) const;
+
+    /**
+     * @brief 回收一个存活槽位
+     *
+     * 从存活列表尾部交换移除，世代自增后挂回空闲链表。
+     *
+     * @param slotIndex 槽位索引
+     */
+    void releaseSlot(quint32 slotIndex);
+
+    SpriteRenderer *m_renderer;          ///< 批次提交目标（不拥有）
+    QVector<Slot> m_slots;               ///< 预分配槽位数组
+    QVector<quint32> m_activeSlots;      ///< 存活槽位索引（紧凑）
+    quint32 m_freeHead;                  ///< 空闲链表头
+    int m_highWaterMark = 0;             ///< 存活峰值
+    quint64 m_droppedCount = 0;          ///< 池满丢弃计数
+    quint64 m_reportedDrops = 0;         ///< 已通过信号报告的丢弃数
+};
+
+#endif // VISUALEFFECTPOOL_H
@@ -43,6 +43,7 @@
 #include <QTimer>
 #include <QPoint>
 #include <QMutex>
+#include <QElapsedTimer>
 
 /**
  * @brief 输入管理器
@@ -136,6 +137,21 @@ public:
     };
     Q_ENUM(InputDevice)
     
+    /**
+     * @brief 输入轴枚举
+     *
+     * 帧同步轮询接口使用的连续输入轴：移动轴由方向动作合成
+     * （-1/0/+1），鼠标轴与滚轮轴为本帧合并后的增量。
+     */
+    enum class Axis {
+        MoveHorizontal,     ///< 水平移动轴（左-1 / 右+1）
+        MoveVertical,       ///< 垂直移动轴（上-1 / 下+1）
+        MouseX,             ///< 鼠标水平增量（本帧合并值）
+        MouseY,             ///< 鼠标垂直增量（本帧合并值）
+        Wheel               ///< 滚轮增量（本帧合并值）
+    };
+    Q_ENUM(Axis)
+
     /**
      * @brief 鼠标按钮枚举
      */
@@ -205,8 +221,64 @@ public:
      */
     bool handleWheelEvent(QWheelEvent *event);
     
+    // ==================== 帧同步轮询接口 ====================
+
+    /**
+     * @brief 开始新的一帧
+     *
+     * 由游戏主循环在每帧开头调用。将当前输入状态冻结为本帧快照
+     * （isPressed/axisValue在整帧内读到一致的值），并把自上一帧
+     * 以来累积的鼠标移动与滚轮增量合并为单次mouseMoved/
+     * mouseWheelScrolled信号——高轮询率鼠标每帧最多产生一次
+     * 信号分发，而不是每个事件一次。
+     *
+     * 快照推进等价于applyEventsUntil(inputTimeMs())：不走固定
+     * 步长重放的调用方得到与重放一致的语义。
+     */
+    void beginFrame();
+
+    // ==================== 固定步长重放接口 ====================
+
+    /**
+     * @brief 输入时钟当前时间（毫秒，单调）
+     *
+     * 所有动作事件到达时都以该时钟打上时间戳。固定步长循环
+     * 用它换算每个模拟步覆盖的时间区间。
+     */
+    qint64 inputTimeMs() const;
+
+    /**
+     * @brief 把时间戳不晚于untilMs的动作事件重放进快照
+     *
+     * 动作按下/释放在事件到达时只入队打时间戳，不直接改动
+     * isPressed快照；固定步长循环在每个模拟步之前以该步的
+     * 结束时间调用本方法，事件严格落在覆盖其时间戳的那一步
+     * 生效。帧长波动时输入延迟保持恒定（至多一个模拟步），
+     * 不再随处理时刻漂移。
+     */
+    void applyEventsUntil(qint64 untilMs);
+
+    /**
+     * @brief 查询动作在本帧快照中是否按下
+     *
+     * 与isActionPressed不同，返回值在beginFrame之间保持稳定，
+     * 适合游戏逻辑在固定步长更新中直接轮询。
+     *
+     * @param action 游戏动作
+     * @return bool 是否按下
+     */
+    bool isPressed(Action action) const;
+
+    /**
+     * @brief 查询输入轴在本帧快照中的值
+     *
+     * @param axis 输入轴
+     * @return float 轴值（移动轴为-1/0/+1，鼠标/滚轮轴为合并增量）
+     */
+    float axisValue(Axis axis) const;
+
     // ==================== 输入状态查询 ====================
-    
+
     /**
      * @brief 检查指定按键是否被按下
      * @param key 按键码
@@ -452,7 +524,27 @@ private:
     // 鼠标状态
     QPoint m_mousePosition;                         ///< 当前鼠标位置
     QPoint m_lastMousePosition;                     ///< 上一帧鼠标位置
-    QPoint m_mouseDelta;                            ///< 鼠标移动增量
+    QPoint m_mouseDelta;                            ///< 鼠标移动增量（本帧合并值）
+
+    // 帧内累积与快照（事件随到随累积，beginFrame时冻结）
+    QPoint m_pendingMouseDelta;                     ///< 累积中的鼠标移动增量
+    int m_pendingWheelDelta = 0;                    ///< 累积中的滚轮增量
+    int m_frameWheelDelta = 0;                      ///< 本帧快照的滚轮增量
+    QSet<Action> m_frameActions;                    ///< 快照的激活动作集合（重放推进）
+
+    /**
+     * @brief 到达时打好时间戳的动作事件
+     *
+     * 事件在处理函数里只入队，由applyEventsUntil按模拟步
+     * 的时间区间重放进快照。
+     */
+    struct TimedActionEvent {
+        Action action;                              ///< 动作
+        bool pressed;                               ///< 按下/释放
+        qint64 timestampMs;                         ///< 到达时刻（输入时钟）
+    };
+    QList<TimedActionEvent> m_actionEventQueue;     ///< 待重放的动作事件队列
+    QElapsedTimer m_inputClock;                     ///< 事件时间戳的单调时钟
     
     // 输入映射
     QMap<Qt::Key, Action> m_keyActionMap;           ///< 按键到动作的映射
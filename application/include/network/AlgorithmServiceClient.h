@@ -10,12 +10,23 @@
 #include <QString>
 #include <QJsonObject>
 #include <QJsonArray>
+#include <QHash>
+#include <QMap>
+#include <QVector>
 #include <functional>
 #include <memory>
 
+QT_BEGIN_NAMESPACE
+class QTimer;
+QT_END_NAMESPACE
+
+class CircuitBreaker;
+class GrpcChannelManager;
+
 #include <grpcpp/grpcpp.h>
 #include "AlgorithmService.pb.h"
 #include "AlgorithmService.grpc.pb.h"
+#include "network/RpcCoroutine.h"
 
 /**
  * @brief 算法服务gRPC客户端类
@@ -30,7 +41,44 @@ public:
     explicit AlgorithmServiceClient(QObject *parent = nullptr);
     ~AlgorithmServiceClient();
 
-    bool initialize(const QString &serviceUrl);
+    /**
+     * @brief 初始化客户端
+     *
+     * 传入sharedChannel时复用NetworkManager通道管理器持有的
+     * 持久通道（RPC在其上多路复用），否则自建通道。
+     *
+     * @param serviceUrl 服务地址
+     * @param sharedChannel 共享gRPC通道，可为空
+     * @return bool 初始化是否成功
+     */
+    bool initialize(const QString &serviceUrl,
+                    std::shared_ptr<grpc::Channel> sharedChannel = nullptr);
+
+    /**
+     * @brief 配置算法服务副本列表
+     *
+     * 为每个副本地址建立经通道管理器托管的持久通道和stub。
+     * 配置后每次RPC按最少未完成请求选择副本（健康状态来自
+     * 通道管理器的后台监视），AI决策调用在首个副本迟迟不
+     * 响应时换副本对冲重试，压平实例堆积造成的长尾延迟。
+     *
+     * @param targets 副本地址列表（host:port）
+     * @param channelManager 通道管理器，负责通道与健康监视
+     */
+    void configureReplicas(const QStringList &targets,
+                           GrpcChannelManager *channelManager);
+
+    /**
+     * @brief 设置共享熔断器
+     *
+     * 由NetworkManager注入（不拥有）。设置后每个RPC方法作为
+     * 独立endpoint参与失败率统计：熔断打开时调用立即以
+     * circuitOpen错误回调，不再付超时等待；合批endpoint打开
+     * 时整批快速失败。
+     *
+     * @param breaker 熔断器指针，可为空（关闭熔断）
+     */
+    void setCircuitBreaker(CircuitBreaker *breaker);
 
     void connectToService();
     void disconnect();
@@ -43,12 +91,86 @@ public:
     void makeAIDecision(const QJsonObject &request,
                        std::function<void(const QJsonObject&)> callback);
 
+    /**
+     * @brief 排队伤害计算请求（同帧合批）
+     *
+     * 请求进入流水线队列，同一事件循环轮次内排队的所有请求
+     * 在本轮结束时合并为一次CalculateDamageBatch调用发出，
+     * 结果按排队顺序回调。多段技能的每一跳不再各付一次RPC
+     * 往返延迟。回调语义与calculateDamage一致。
+     *
+     * @param request 伤害计算请求（与calculateDamage同构）
+     * @param callback 结果回调
+     */
+    void queueDamageRequest(const QJsonObject &request,
+                           std::function<void(const QJsonObject&)> callback);
+
+    /**
+     * @brief 排队AI决策请求（同帧合批）
+     *
+     * 同帧排队的决策合并为一次BatchAIDecision调用。
+     *
+     * @param request AI决策请求（与makeAIDecision同构）
+     * @param callback 结果回调
+     */
+    void queueAIDecision(const QJsonObject &request,
+                        std::function<void(const QJsonObject&)> callback);
+
+    /**
+     * @brief 立即发出流水线中排队的请求
+     *
+     * 正常情况下由0ms定时器在事件循环轮次末自动触发；
+     * 需要同步语义的调用方可以手动冲刷。
+     */
+    void flushPendingRequests();
+
     void getSkillTree(const QJsonObject &request,
                      std::function<void(const QJsonObject&)> callback);
 
+    /**
+     * @brief 同步技能树（带版本缓存）
+     *
+     * 通过 WatchSkillTree 流携带本地缓存版本号：服务端版本一致时
+     * 零节点传输，直接回放本地缓存；否则用快照/增量更新缓存。
+     * 角色界面反复打开时不再整树重传。
+     */
+    void syncSkillTree(const QJsonObject &request,
+                      std::function<void(const QJsonObject&)> callback);
+
     void validateData(const QJsonObject &request,
                      std::function<void(const QJsonObject&)> callback);
 
+    /**
+     * @brief 查询技能伤害倍率（本地缓存）
+     *
+     * 从syncSkillTree维护的本地缓存读取，供客户端预测使用；
+     * 缓存未命中时返回1.0（普通攻击基准）。
+     *
+     * @param skillId 技能ID
+     * @return double 伤害倍率
+     */
+    double skillDamageMultiplier(int skillId) const;
+
+    // ==================== 协程接口（co_await） ====================
+    //
+    // 与同名回调接口同构的可等待版本：阻塞RPC在全局线程池执行，
+    // 结果在本对象所在线程恢复协程，BattleSystem等调用方可以把
+    // 多RPC行动流程写成顺序代码。同帧合批接口（queueDamageRequest
+    // /queueAIDecision）与带本地缓存的syncSkillTree不提供协程版本，
+    // 流水线定时器与缓存写入必须留在主线程。
+
+    /** @brief co_await版calculateDamage，返回值与回调参数同构 */
+    net::RpcCall calculateDamage(const QJsonObject &request);
+
+    /** @brief co_await版makeAIDecision（保留对冲重试行为） */
+    net::RpcCall makeAIDecision(const QJsonObject &request);
+
+    /** @brief co_await版getSkillTree */
+    net::RpcCall getSkillTree(const QJsonObject &request);
+
+    /** @brief co_await版validateData */
+    net::RpcCall validateData(const QJsonObject &request);
+
     void setTimeout(int timeoutMs);
     void setRetryCount(int count);
 
@@ -66,13 +188,79 @@ signals:
     void errorOccurred(const QString &error);
 
 private:
+    /**
+     * @brief 流水线中待发送的请求
+     */
+    struct PendingCall {
+        QJsonObject request;                            ///< 请求JSON
+        std::function<void(const QJsonObject&)> callback; ///< 结果回调
+    };
+
     void handleConnectionError(const QString &error);
 
+    /**
+     * @brief 请求进入流水线并安排冲刷
+     *
+     * 队列达到批量上限时立即冲刷，否则由0ms单次定时器在
+     * 当前事件循环轮次末冲刷（同帧请求自然合并）。
+     */
+    void enqueuePending(QVector<PendingCall> &queue, const QJsonObject &request,
+                        std::function<void(const QJsonObject&)> callback);
+
+    /**
+     * @brief 发送合批伤害计算RPC并分发结果
+     */
+    void sendDamageBatch(QVector<PendingCall> calls);
+
+    /**
+     * @brief 发送合批AI决策RPC并分发结果
+     */
+    void sendAIBatch(QVector<PendingCall> calls);
+
+    /**
+     * @brief 选择发送本次RPC的stub
+     *
+     * 配置了副本时按最少未完成请求选择（exclude用于对冲重试
+     * 避开已试过的副本）；未配置副本时退回单endpoint的stub。
+     *
+     * @param chosenTarget 输出参数，选中的副本地址
+     * @param exclude 要避开的副本地址，可为空
+     * @return Stub* 选中的stub，未初始化时为nullptr
+     */
+    algorithm_proto::AlgorithmService::Stub* pickStub(QString &chosenTarget,
+                                                      const QString &exclude = QString());
+
     std::shared_ptr<grpc::Channel> channel_;
     std::unique_ptr<algorithm_proto::AlgorithmService::Stub> stub_;
 
+    // 副本感知负载均衡：地址到stub的映射，通道与健康状态由
+    // 通道管理器持有（不拥有manager）
+    GrpcChannelManager *m_channelManager = nullptr;
+    QHash<QString, std::unique_ptr<algorithm_proto::AlgorithmService::Stub>> m_replicaStubs;
+
+    /// 共享熔断器，由NetworkManager持有（不拥有）
+    CircuitBreaker *m_breaker = nullptr;
+
     bool m_connected;
     QString m_serviceUrl;
     int m_timeout;
     int m_retryCount;
+
+    // 技能树本地缓存: skillId → 节点JSON，版本号与服务端比对
+    quint64 m_skillTreeVersion = 0;
+    QMap<int, QJsonObject> m_skillTreeCache;
+
+    // 同帧请求流水线
+    QVector<PendingCall> m_pendingDamage;   ///< 待合批的伤害计算请求
+    QVector<PendingCall> m_pendingAI;       ///< 待合批的AI决策请求
+    QTimer *m_flushTimer = nullptr;         ///< 0ms冲刷定时器（轮次末触发）
+
+    /// 单次合批的最大请求数，达到后立即冲刷
+    static const int MAX_BATCH_SIZE = 32;
+
+    /// 流水线排队总量上限，超限时先剔除低优先级的AI决策请求
+    static const int MAX_PENDING_CALLS = 128;
+
+    /// AI决策首次尝试的对冲期限（毫秒），超过即换副本重试
+    static const int HEDGE_TIMEOUT_MS = 150;
 };
@@ -0,0 +1,158 @@
+/*
+ * 文件名: CircuitBreaker.h
+ * 说明: 按endpoint统计失败率的熔断器。
+ * 作者: 彭承康
+ * 创建时间: 2026-08-28
+ */
+#pragma once
+
+#include <QObject>
+#include <QString>
+#include <QHash>
+#include <QMutex>
+#include <QJsonObject>
+
+/**
+ * @brief 按endpoint统计失败率的熔断器
+ *
+ * 由NetworkManager持有、两个服务客户端共享。每个RPC方法是
+ * 一个独立endpoint，在滚动窗口内统计失败率：
+ * - Closed（闭合）: 正常放行，窗口内样本足够且失败率过半时
+ *   熔断打开；
+ * - Open（打开）: 全部请求快速失败，不再付超时等待，冷却期
+ *   结束后转入半开；
+ * - HalfOpen（半开）: 只放行单个探测请求，成功即恢复闭合，
+ *   失败则重新打开并重计冷却。
+ *
+ * 服务端故障时调用方立即收到错误回调，不会在每次调用上
+ * 阻塞到deadline，也不再向已经过载的服务端倾泻请求。
+ *
+ * 线程安全: RPC可能在协程线程池的工作线程上执行，内部用
+ * 互斥锁保护各endpoint的统计状态。
+ */
+class CircuitBreaker : public QObject
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief 熔断器状态
+     */
+    enum class State {
+        Closed,     ///< 闭合，正常放行
+        Open,       ///< 打开，快速失败
+        HalfOpen    ///< 半开，放行单个探测请求
+    };
+
+    /**
+     * @brief 构造函数
+     *
+     * @param parent 父对象指针
+     */
+    explicit CircuitBreaker(QObject *parent = nullptr);
+
+    /**
+     * @brief 请求是否放行
+     *
+     * 打开状态下冷却期结束时转入半开并放行探测请求；
+     * 半开状态下同一时刻只放行一个探测。
+     *
+     * @param endpoint RPC方法名（如"Strategy.GetGameRules"）
+     * @return bool false表示应快速失败，不发出RPC
+     */
+    bool allowRequest(const QString &endpoint);
+
+    /**
+     * @brief 记录一次成功的RPC
+     *
+     * 半开探测成功时熔断恢复闭合。
+     *
+     * @param endpoint RPC方法名
+     */
+    void recordSuccess(const QString &endpoint);
+
+    /**
+     * @brief 记录一次失败的RPC
+     *
+     * 闭合状态下失败率过半触发熔断；半开探测失败重新打开。
+     *
+     * @param endpoint RPC方法名
+     */
+    void recordFailure(const QString &endpoint);
+
+    /**
+     * @brief 查询endpoint当前状态
+     *
+     * @param endpoint RPC方法名
+     * @return State 未知endpoint视为闭合
+     */
+    State state(const QString &endpoint) const;
+
+    /**
+     * @brief 导出全部endpoint的熔断状态
+     *
+     * 供NetworkManager::getConnectionInfo()展示诊断信息。
+     *
+     * @return QJsonObject endpoint到状态描述的映射
+     */
+    QJsonObject snapshot() const;
+
+signals:
+    /**
+     * @brief 熔断打开信号
+     *
+     * @param endpoint 触发熔断的RPC方法名
+     */
+    void circuitOpened(const QString &endpoint);
+
+    /**
+     * @brief 熔断恢复闭合信号
+     *
+     * @param endpoint 恢复的RPC方法名
+     */
+    void circuitClosed(const QString &endpoint);
+
+private:
+    /**
+     * @brief 单个endpoint的统计状态
+     */
+    struct EndpointStats {
+        State state = State::Closed;    ///< 当前状态
+        qint64 windowStartMs = 0;       ///< 当前统计窗口起点
+        int failures = 0;               ///< 窗口内失败数
+        int total = 0;                  ///< 窗口内总请求数
+        qint64 openedAtMs = 0;          ///< 熔断打开时刻
+        bool probeInFlight = false;     ///< 半开探测是否在途
+    };
+
+    /**
+     * @brief 窗口过期时重置统计
+     *
+     * @param stats endpoint统计状态
+     * @param nowMs 当前时刻（毫秒）
+     */
+    static void rollWindow(EndpointStats &stats, qint64 nowMs);
+
+    /**
+     * @brief 状态的中文描述
+     *
+     * @param state 熔断器状态
+     * @return QString 状态描述
+     */
+    static QString stateString(State state);
+
+    /// 互斥锁（可变：const查询接口也需要加锁）
+    mutable QMutex m_mutex;
+
+    /// endpoint到统计状态的映射
+    QHash<QString, EndpointStats> m_endpoints;
+
+    /// 失败率统计窗口长度（毫秒）
+    static const int WINDOW_MS = 10000;
+
+    /// 触发熔断所需的最小窗口样本数
+    static const int MIN_SAMPLES = 8;
+
+    /// 熔断打开后的冷却时长（毫秒），结束后转半开探测
+    static const int OPEN_COOLDOWN_MS = 5000;
+};
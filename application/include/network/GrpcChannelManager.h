@@ -0,0 +1,163 @@
+/*
+ * 文件名: GrpcChannelManager.h
+ * 说明: gRPC通道管理器，持有长连接通道并在后台维护重连。
+ * 作者: 彭承康
+ * 创建时间: 2026-08-28
+ *
+ * 此前各服务客户端各自创建gRPC通道，网络抖动后重连风暴
+ * 反复重付TCP/TLS建连成本。本类按目标地址去重地持有
+ * 带keepalive参数的持久通道，多个客户端复用同一条连接
+ * （gRPC在单通道上多路复用RPC）；后台定时器监视通道连接
+ * 状态，掉线后按带抖动的指数退避触发重连，不阻塞主线程。
+ */
+#pragma once
+
+#include <QObject>
+#include <QHash>
+#include <QString>
+#include <memory>
+
+#include <grpcpp/grpcpp.h>
+
+QT_BEGIN_NAMESPACE
+class QTimer;
+QT_END_NAMESPACE
+
+/**
+ * @brief gRPC通道管理器
+ *
+ * 通道按目标地址缓存：同一地址的所有客户端拿到同一个
+ * shared_ptr，RPC在这条HTTP/2连接上多路复用。通道配置了
+ * keepalive探测，空闲时也能及时发现断链。
+ */
+class GrpcChannelManager : public QObject
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief 构造函数
+     *
+     * @param parent 父对象指针
+     */
+    explicit GrpcChannelManager(QObject *parent = nullptr);
+    ~GrpcChannelManager() override;
+
+    /**
+     * @brief 获取目标地址的共享通道
+     *
+     * 首次请求时创建带keepalive参数的持久通道并纳入监视；
+     * 后续请求返回同一通道。
+     *
+     * @param target 服务地址（host:port）
+     * @return std::shared_ptr<grpc::Channel> 共享通道
+     */
+    std::shared_ptr<grpc::Channel> channelFor(const QString &target);
+
+    /**
+     * @brief 查询通道是否就绪
+     *
+     * @param target 服务地址
+     * @return bool 通道当前是否处于READY状态
+     */
+    bool isReady(const QString &target) const;
+
+    /**
+     * @brief 配置逻辑服务的副本地址列表
+     *
+     * 为每个地址创建持久通道并纳入监视。配置后可用
+     * pickReplica()做副本感知的客户端负载均衡。
+     *
+     * @param service 逻辑服务名（如"algorithm"）
+     * @param targets 副本地址列表（host:port）
+     */
+    void setReplicaTargets(const QString &service, const QStringList &targets);
+
+    /**
+     * @brief 选择一个副本地址
+     *
+     * 最少未完成请求优先：在就绪副本中选未完成RPC最少的一个；
+     * 没有就绪副本时退化为全部副本中最少的一个（连接可能正在
+     * 恢复中）。exclude用于对冲重试时避开已试过的副本。
+     *
+     * @param service 逻辑服务名
+     * @param exclude 要避开的地址，可为空
+     * @return QString 选中的地址；服务未配置时返回空串
+     */
+    QString pickReplica(const QString &service, const QString &exclude = QString());
+
+    /**
+     * @brief 记录一次RPC开始
+     *
+     * 增加目标地址的未完成请求计数，供pickReplica()选择。
+     *
+     * @param target 服务地址
+     */
+    void beginCall(const QString &target);
+
+    /**
+     * @brief 记录一次RPC结束
+     *
+     * @param target 服务地址
+     */
+    void endCall(const QString &target);
+
+    /**
+     * @brief 开始后台监视
+     *
+     * 启动定时器轮询所有通道的连接状态。
+     */
+    void startWatching();
+
+    /**
+     * @brief 停止后台监视
+     */
+    void stopWatching();
+
+signals:
+    /**
+     * @brief 通道进入就绪状态信号
+     *
+     * @param target 服务地址
+     */
+    void channelReady(const QString &target);
+
+    /**
+     * @brief 通道失去连接信号
+     *
+     * @param target 服务地址
+     */
+    void channelLost(const QString &target);
+
+private slots:
+    /**
+     * @brief 轮询所有通道的连接状态
+     *
+     * 状态变迁时发射信号；掉线通道按带抖动的指数退避
+     * 触发gRPC的重连尝试。
+     */
+    void pollChannelStates();
+
+private:
+    /// 状态轮询间隔（毫秒）
+    static const int POLL_INTERVAL_MS = 1000;
+    /// 初始重连退避（毫秒）
+    static const int INITIAL_BACKOFF_MS = 1000;
+    /// 最大重连退避（毫秒）
+    static const int MAX_BACKOFF_MS = 30000;
+
+    /**
+     * @brief 通道记录
+     */
+    struct ChannelEntry {
+        std::shared_ptr<grpc::Channel> channel;     ///< 持久通道
+        bool ready = false;                         ///< 上次观察到的就绪状态
+        int backoffMs = INITIAL_BACKOFF_MS;         ///< 当前退避基数
+        qint64 nextKickTime = 0;                    ///< 下次允许触发重连的时刻
+        int outstanding = 0;                        ///< 进行中的RPC数量
+    };
+
+    QHash<QString, ChannelEntry> m_channels;        ///< 目标地址到通道的映射
+    QHash<QString, QStringList> m_replicas;         ///< 逻辑服务到副本地址列表的映射
+    QTimer *m_pollTimer;                            ///< 状态轮询定时器
+};
@@ -17,6 +17,9 @@
 
 class AlgorithmServiceClient;
 class StrategyServiceClient;
+class CircuitBreaker;
+class GrpcChannelManager;
+class SendAggregator;
 
 /**
  * @brief 连接状态枚举
@@ -141,11 +144,21 @@ public:
     
     /**
      * @brief 获取策略服务客户端
-     * 
+     *
      * @return StrategyServiceClient* 策略服务客户端指针
      */
     StrategyServiceClient* getStrategyClient() const;
 
+    /**
+     * @brief 获取出站消息聚合器
+     *
+     * 位置更新等小消息经它入队，帧末合并成一个载荷发出；
+     * GameEngine在每帧末尾调用其flushFrame。
+     *
+     * @return SendAggregator* 聚合器指针，未初始化时为nullptr
+     */
+    SendAggregator* getSendAggregator() const;
+
 signals:
     /**
      * @brief 连接状态改变信号
@@ -231,6 +244,42 @@ private slots:
      */
     void attemptReconnect();
 
+    /**
+     * @brief 时钟同步采样节拍
+     *
+     * 策略服务连上后先以短间隔连采几次（快速收敛钟差），
+     * 之后降到稳态间隔维持漂移估计；断连即停。
+     */
+    void onClockSyncTick();
+
+    /**
+     * @brief 通道进入就绪状态处理
+     *
+     * @param target 服务地址
+     */
+    void onChannelReady(const QString &target);
+
+    /**
+     * @brief 通道失去连接处理
+     *
+     * @param target 服务地址
+     */
+    void onChannelLost(const QString &target);
+
+    /**
+     * @brief 熔断打开处理
+     *
+     * @param endpoint 触发熔断的RPC方法名
+     */
+    void onCircuitOpened(const QString &endpoint);
+
+    /**
+     * @brief 熔断恢复闭合处理
+     *
+     * @param endpoint 恢复的RPC方法名
+     */
+    void onCircuitClosed(const QString &endpoint);
+
 private:
     /**
      * @brief 设置客户端信号连接
@@ -263,6 +312,23 @@ private:
     void startReconnect();
 
 private:
+    /**
+     * @brief gRPC通道管理器
+     *
+     * 按地址持有带keepalive的持久通道，两个服务客户端
+     * 在其上多路复用RPC；后台按带抖动的退避维护重连。
+     */
+    std::unique_ptr<GrpcChannelManager> m_channelManager;
+
+    /**
+     * @brief 共享熔断器
+     *
+     * 两个服务客户端共用，按RPC方法统计失败率：服务端故障时
+     * 对应endpoint快速失败，冷却后经半开探测恢复。声明在客户
+     * 端之前，保证析构时客户端先于熔断器销毁。
+     */
+    std::unique_ptr<CircuitBreaker> m_circuitBreaker;
+
     /**
      * @brief 算法服务客户端
      */
@@ -272,7 +338,15 @@ private:
      * @brief 策略服务客户端
      */
     std::unique_ptr<StrategyServiceClient> m_strategyClient;
-    
+
+    /**
+     * @brief 出站消息聚合器
+     *
+     * 把一帧内的小消息合并为单个载荷，声明在客户端之后，
+     * 析构时先于客户端销毁。
+     */
+    std::unique_ptr<SendAggregator> m_sendAggregator;
+
     /**
      * @brief 当前连接状态
      */
@@ -282,6 +356,25 @@ private:
      * @brief 重连定时器
      */
     QTimer *m_reconnectTimer;
+
+    /**
+     * @brief 时钟同步采样定时器
+     */
+    QTimer *m_clockSyncTimer;
+
+    /**
+     * @brief 本次连接内已采集的时钟样本数（快采阶段计数）
+     */
+    int m_clockSyncSamplesTaken;
+
+    /** @brief 连接建立后的快采次数 */
+    static constexpr int CLOCK_SYNC_BURST_COUNT = 4;
+
+    /** @brief 快采间隔（毫秒） */
+    static constexpr int CLOCK_SYNC_BURST_INTERVAL_MS = 2000;
+
+    /** @brief 稳态采样间隔（毫秒），维持漂移估计足够 */
+    static constexpr int CLOCK_SYNC_STEADY_INTERVAL_MS = 60000;
     
     /**
      * @brief 重连尝试次数
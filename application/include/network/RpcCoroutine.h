@@ -0,0 +1,157 @@
+/*
+ * 文件名: RpcCoroutine.h
+ * 说明: 服务客户端的C++20协程适配层。
+ * 作者: 彭承康
+ * 创建时间: 2026-02-18
+ *
+ * 提供 co_await 形式的RPC调用封装：阻塞的gRPC调用被派发到
+ * 全局线程池执行，完成后经排队连接回到客户端对象所在线程
+ * （通常是主线程）恢复协程。多步RPC流程可以写成顺序代码，
+ * 等待期间引擎继续渲染，不再需要层层嵌套的回调。
+ *
+ * 用法示例（BattleSystem中的多RPC行动流程）：
+ * @code
+ * net::RpcTask BattleSystem::resolveEnemyAction(int enemyId)
+ * {
+ *     QJsonObject decision = co_await m_algorithmClient->makeAIDecision(
+ *         AlgorithmServiceClient::createAIDecisionRequest(enemyId, context));
+ *     if (decision["error"].toBool()) {
+ *         co_return;
+ *     }
+ *     QJsonObject damage = co_await m_algorithmClient->calculateDamage(
+ *         buildDamageRequest(decision["actionId"].toInt()));
+ *     applyDamageResult(enemyId, damage);
+ * }
+ * @endcode
+ */
+#pragma once
+
+#include <QJsonObject>
+#include <QMetaObject>
+#include <QObject>
+#include <QPointer>
+#include <QThread>
+#include <QThreadPool>
+#include <QtGlobal>
+#include <coroutine>
+#include <functional>
+#include <utility>
+
+#include "core/WorkerMailbox.h"
+
+namespace net {
+
+/**
+ * @brief 即发即忘的协程任务类型
+ *
+ * 协程从调用处立即开始执行，调用方不持有句柄；协程跑完后
+ * 帧自动销毁。适用于由UI或游戏事件触发的异步RPC流程。
+ */
+class RpcTask
+{
+public:
+    struct promise_type {
+        RpcTask get_return_object() noexcept { return RpcTask(); }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() noexcept {}
+        void unhandled_exception() noexcept
+        {
+            // RPC封装以JSON错误对象报错，异常不应逃逸到这里
+            qWarning("RpcTask: 协程抛出未处理异常");
+        }
+    };
+};
+
+/**
+ * @brief 单次RPC调用的可等待对象
+ *
+ * 持有一个启动函数：await_suspend把它派发到全局线程池，在
+ * 工作线程中执行阻塞的gRPC调用；完成回调写回结果后，经
+ * Qt::QueuedConnection在affinity对象所在线程恢复协程，协程
+ * 续体中可以安全访问Qt状态。
+ *
+ * affinity对象在等待期间被销毁时协程不再恢复（帧随进程回收，
+ * 换取续体中永远不会出现悬垂的this指针）。
+ */
+class RpcCall
+{
+public:
+    /// 完成回调：RPC结果（错误时含error/message字段）
+    using Reply = std::function<void(const QJsonObject&)>;
+
+    /// 启动函数：执行阻塞RPC并恰好调用一次完成回调
+    using Starter = std::function<void(Reply)>;
+
+    /**
+     * @brief 构造可等待的RPC调用
+     * @param affinity 恢复线程的宿主对象（通常是客户端自身）
+     * @param starter 启动函数
+     */
+    RpcCall(QObject *affinity, Starter starter)
+        : m_affinity(affinity)
+        , m_starter(std::move(starter))
+    {
+    }
+
+    /**
+     * @brief 构造立即完成的调用
+     *
+     * 用于不需要经线程池的路径（stub未初始化、参数错误等），
+     * co_await 直接拿到结果，不发生挂起。
+     *
+     * @param result 预置结果
+     */
+    static RpcCall immediate(QJsonObject result)
+    {
+        RpcCall call(nullptr, nullptr);
+        call.m_ready = true;
+        call.m_result = std::move(result);
+        return call;
+    }
+
+    bool await_ready() const noexcept { return m_ready; }
+
+    void await_suspend(std::coroutine_handle<> handle)
+    {
+        QPointer<QObject> affinity(m_affinity);
+        QThreadPool::globalInstance()->start([this, handle, affinity]() {
+            m_starter([this, handle, affinity](const QJsonObject &reply) {
+                m_result = reply;
+                QObject *host = affinity.data();
+                if (!host) {
+                    return; // 宿主已销毁，放弃恢复
+                }
+                // 宿主在信箱枢纽排空线程时优先走本线程的SPSC信箱，
+                // 恢复由帧循环批量执行；信箱满（背压）或枢纽缺席
+                // 时回退到队列连接，战斗高峰期恢复不丢失
+                MailboxHub *hub = MailboxHub::active();
+                if (hub && host->thread() == hub->thread()) {
+                    WorkerMailbox *mailbox = hub->mailboxForCurrentThread(
+                        QStringLiteral("RpcPool"));
+                    // 排空前宿主可能已销毁，执行时再查一次QPointer，
+                    // 与队列连接随宿主取消的语义保持一致
+                    if (mailbox->tryPost([handle, affinity]() {
+                            if (affinity.data()) {
+                                handle.resume();
+                            }
+                        })) {
+                        return;
+                    }
+                }
+                QMetaObject::invokeMethod(host, [handle]() { handle.resume(); },
+                                          Qt::QueuedConnection);
+            });
+        });
+    }
+
+    QJsonObject await_resume() noexcept { return std::move(m_result); }
+
+private:
+    QObject *m_affinity;
+    Starter m_starter;
+    QJsonObject m_result;
+    bool m_ready = false;
+};
+
+} // namespace net
@@ -0,0 +1,94 @@
+/*
+ * 文件名: SendAggregator.h
+ * 说明: 每帧出站消息聚合器（Nagle式合并）。
+ * 作者: 彭承康
+ * 创建时间: 2026-08-28
+ *
+ * 位置更新、输入确认这类小消息此前各自走一次
+ * StrategyServiceClient::updateWorldState：每条消息一次RPC、
+ * 一次系统调用、一个网络包，单玩家包率是信息量所需的数倍。
+ * 本聚合器把一帧内入队的世界状态更新按顶层键合并（同键后写
+ * 覆盖先写，服务端本就按键合并），帧末由GameEngine统一冲刷，
+ * 整帧只发一次合并载荷。
+ *
+ * 战斗指令等对延迟敏感的消息带urgent标志绕过聚合：连同已
+ * 排队的内容立即合并发出，既不增加包数也不等到帧末。
+ */
+#ifndef NETWORK_SENDAGGREGATOR_H
+#define NETWORK_SENDAGGREGATOR_H
+
+#include <QObject>
+#include <QJsonObject>
+
+class StrategyServiceClient;
+
+/**
+ * @brief 每帧出站消息聚合器
+ *
+ * 由NetworkManager持有并接线到策略服务客户端；GameEngine在
+ * 每帧末尾调用flushFrame。只做客户端侧合并，线路格式不变，
+ * 服务端无需任何配合。
+ */
+class SendAggregator : public QObject
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief 构造聚合器
+     * @param client 冲刷目标客户端（不拥有）
+     * @param parent 父对象指针
+     */
+    explicit SendAggregator(StrategyServiceClient *client, QObject *parent = nullptr);
+
+    /**
+     * @brief 入队一条世界状态更新
+     *
+     * 载荷按顶层键并入本帧的合并对象，同键后写覆盖先写——
+     * 与服务端的按键合并语义一致，丢弃的只是同帧内被覆盖的
+     * 中间值。
+     *
+     * @param worldState 世界状态载荷（顶层键合并）
+     * @param urgent true时绕过帧末聚合，连同已排队内容立即发出
+     */
+    void enqueueWorldState(const QJsonObject &worldState, bool urgent = false);
+
+    /**
+     * @brief 冲刷本帧累积的合并载荷
+     *
+     * 有待发内容时发一次updateWorldState，否则空操作。
+     * GameEngine在帧末调用；urgent路径内部也走这里。
+     *
+     * @return 实际发出的RPC数（0或1）
+     */
+    int flushFrame();
+
+    /** @brief 本帧尚未冲刷的消息条数 */
+    int getPendingCount() const { return m_pendingMessages; }
+
+    /** @brief 累计入队消息总数 */
+    quint64 getEnqueuedCount() const { return m_enqueuedCount; }
+
+    /**
+     * @brief 累计被合并吸收的消息数
+     *
+     * 入队总数减去实际RPC数：每一条都是省下的一个网络包。
+     */
+    quint64 getCoalescedCount() const { return m_coalescedCount; }
+
+signals:
+    /**
+     * @brief 冲刷完成信号
+     * @param messageCount 本次合并载荷吸收的消息条数
+     */
+    void flushed(int messageCount);
+
+private:
+    StrategyServiceClient *m_client;   ///< 冲刷目标客户端（不拥有）
+    QJsonObject m_pendingState;        ///< 本帧按键合并的世界状态
+    int m_pendingMessages = 0;         ///< 本帧入队消息条数
+    quint64 m_enqueuedCount = 0;       ///< 累计入队消息数
+    quint64 m_coalescedCount = 0;      ///< 累计被合并吸收的消息数
+};
+
+#endif // NETWORK_SENDAGGREGATOR_H
@@ -16,6 +16,10 @@
 #include <grpcpp/grpcpp.h>
 #include "StrategyService.pb.h"
 #include "StrategyService.grpc.pb.h"
+#include "network/RpcCoroutine.h"
+
+class CircuitBreaker;
+class GameState;
 
 /**
  * @brief 策略服务gRPC客户端类
@@ -30,7 +34,29 @@ public:
     explicit StrategyServiceClient(QObject *parent = nullptr);
     ~StrategyServiceClient();
 
-    bool initialize(const QString &serviceUrl);
+    /**
+     * @brief 初始化客户端
+     *
+     * 传入sharedChannel时复用NetworkManager通道管理器持有的
+     * 持久通道（RPC在其上多路复用），否则自建通道。
+     *
+     * @param serviceUrl 服务地址
+     * @param sharedChannel 共享gRPC通道，可为空
+     * @return bool 初始化是否成功
+     */
+    bool initialize(const QString &serviceUrl,
+                    std::shared_ptr<grpc::Channel> sharedChannel = nullptr);
+
+    /**
+     * @brief 设置共享熔断器
+     *
+     * 由NetworkManager注入（不拥有）。设置后每个RPC方法作为
+     * 独立endpoint参与失败率统计：熔断打开时调用立即以
+     * circuitOpen错误回调，不再付超时等待。
+     *
+     * @param breaker 熔断器指针，可为空（关闭熔断）
+     */
+    void setCircuitBreaker(CircuitBreaker *breaker);
 
     void connectToService();
     void disconnect();
@@ -49,9 +75,71 @@ public:
     void getPlayerData(const QJsonObject &request,
                       std::function<void(const QJsonObject&)> callback);
 
+    /**
+     * @brief 查询世界状态（增量同步）
+     *
+     * 轮询时携带本地最后同步到的变更序号：服务端状态未变时返回
+     * 空回执（零解析成本），有少量变更时仅返回变更键并就地合并到
+     * 本地缓存，序号差距过大时回退全量解析。回调收到的始终是
+     * 完整的世界状态JSON对象。
+     *
+     * @param callback 结果回调
+     */
+    void queryWorldState(std::function<void(const QJsonObject&)> callback);
+
     void savePlayerData(const QJsonObject &request,
                        std::function<void(const QJsonObject&)> callback);
 
+    /**
+     * @brief 时钟同步采样
+     *
+     * 在现有通道上做一次NTP风格的四时刻交换：本地发送/接收时刻
+     * 取SyncedClock的稳定时基，响应携带服务端接收/发送两个时刻，
+     * 扣除服务端处理耗时后把(钟差,往返)样本喂入SyncedClock。
+     * 由NetworkManager周期性调用，单次成本为一个极小的RPC。
+     *
+     * @param callback 可选结果回调，收到 {"offsetMs","rttMs"} 或错误对象
+     */
+    void syncClock(std::function<void(const QJsonObject&)> callback = nullptr);
+
+    /**
+     * @brief 增量上传游戏状态（补丁驱动）
+     *
+     * 由GameState的变更日志生成RFC-6902补丁，折算成只含改动键的
+     * 最小状态对象上传（服务端UpdateWorldState按键合并，无需新
+     * 协议字段）。客户端记住已上传到的日志版本：无改动时零RPC
+     * 负载，日志无法服务（首次上传、批量加载后）或补丁含删除
+     * 操作时退回完整toJson()上传。上传成功后才推进版本，失败的
+     * 改动会随下次调用重传。
+     *
+     * @param gameState 游戏状态，不拥有
+     * @param callback 结果回调，与updateWorldState同构
+     */
+    void syncGameState(GameState *gameState,
+                       std::function<void(const QJsonObject&)> callback = nullptr);
+
+    // ==================== 协程接口（co_await） ====================
+    //
+    // 与同名回调接口同构的可等待版本：阻塞RPC在全局线程池执行，
+    // 结果在本对象所在线程恢复协程，多RPC流程可写成顺序代码。
+    // 带本地缓存合并的接口（queryWorldState）不提供协程版本，
+    // 缓存写入必须留在主线程。
+
+    /** @brief co_await版getGameRules，返回值与回调参数同构 */
+    net::RpcCall getGameRules(const QJsonObject &request);
+
+    /** @brief co_await版updateWorldState */
+    net::RpcCall updateWorldState(const QJsonObject &request);
+
+    /** @brief co_await版triggerEvent */
+    net::RpcCall triggerEvent(const QJsonObject &request);
+
+    /** @brief co_await版getPlayerData */
+    net::RpcCall getPlayerData(const QJsonObject &request);
+
+    /** @brief co_await版savePlayerData */
+    net::RpcCall savePlayerData(const QJsonObject &request);
+
     void setTimeout(int timeoutMs);
     void setRetryCount(int count);
 
@@ -70,8 +158,18 @@ private:
     std::shared_ptr<grpc::Channel> channel_;
     std::unique_ptr<strategy_proto::StrategyService::Stub> stub_;
 
+    /// 共享熔断器，由NetworkManager持有（不拥有）
+    CircuitBreaker *m_breaker = nullptr;
+
     bool m_connected;
     QString m_serviceUrl;
     int m_timeout;
     int m_retryCount;
+
+    // 增量同步缓存: 最后同步到的变更序号与对应的世界状态文档
+    quint64 m_worldStateSequence = 0;
+    QJsonObject m_worldStateCache;
+
+    // 增量上传: GameState日志已成功上传到的版本号
+    quint64 m_stateSyncVersion = 0;
 };
@@ -10,7 +10,18 @@
 
 #include <QObject>
 #include <QDateTime>
+#include <QHash>
 #include <QList>
+#include <QMutex>
+#include <QPair>
+#include <QQueue>
+#include <QStringList>
+#include <QVector>
+#include <QWaitCondition>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <atomic>
+#include <thread>
 #include "game/Player.h"
 #include "game/GameState.h"
 
@@ -37,6 +48,31 @@ struct SaveInfo
  * - 游戏状态的持久化
  * - 存档文件的管理
  * - 存档信息的查询
+ *
+ * 自动存档走增量路径：主线程只快照GameState中被改过的段
+ * （QJsonObject隐式共享，快照是浅拷贝），序列化、压缩和
+ * 写盘都在后台写线程完成，补丁记录追加到存档旁的补丁文件，
+ * 加载时按段合并回完整存档。
+ *
+ * 存档本体使用FLSV二进制格式（与FLPK资源包同风格）：
+ * 文件头 + 段索引 + 逐段压缩的JSON载荷。索引记录每段的
+ * 偏移和长度，读取时可以只解压需要的段——getSaveInfo仅
+ * 读取小的summary段，不碰巨大的物品栏数据。旧的JSON存档
+ * 在首次加载时透明迁移为二进制格式。
+ *
+ * 存档列表走旁路元数据索引（FLSI文件）：每次保存/删除时
+ * 同步更新一个只含SaveInfo字段和文件指纹的小索引文件，
+ * 读取菜单经scanSavesAsync在后台线程先读索引、逐槽位发射
+ * saveInfoReady增量填充UI；指纹不匹配（外部拷贝/删除存档）
+ * 的槽位才回退到打开存档本体重建条目。慢盘上有上百个存档
+ * 时菜单也能立即出现。
+ *
+ * 存档本体和索引都走原子替换：完整内容先写入同目录临时
+ * 文件，fsync后rename切换，中途崩溃不会留下半截文件。每次
+ * 全量保存把上一代基线降级为滚动备份（.bak1/.bak2），主
+ * 存档损坏时加载路径自动回退。写线程对补丁任务做组提交：
+ * 几乎同时触发的自动存档与任务检查点并入同一次追加写，
+ * 共享一次文件打开和fsync。
  */
 class SaveManager : public QObject
 {
@@ -46,6 +82,7 @@ public:
     static const int MAX_SAVE_SLOTS = 10;  // 最大存档槽位数
 
     explicit SaveManager(QObject *parent = nullptr);
+    ~SaveManager() override;
 
     /**
      * @brief 保存游戏
@@ -57,6 +94,20 @@ public:
      */
     bool saveGame(int slot, const Player *player, const GameState *gameState);
 
+    /**
+     * @brief 增量自动存档
+     *
+     * 主线程只取出GameState的脏段并做浅快照后立即返回；
+     * 后台写线程负责序列化、压缩并把段补丁追加到补丁文件。
+     * 没有脏段时不产生任何IO。完成后发射autoSaveCompleted。
+     *
+     * @param slot 存档槽位 (0-9)
+     * @param player 玩家对象
+     * @param gameState 游戏状态对象
+     * @return bool 是否成功提交（无脏段时返回true）
+     */
+    Q_INVOKABLE bool autoSave(int slot, const Player *player, GameState *gameState);
+
     /**
      * @brief 加载游戏
      * 
@@ -93,11 +144,22 @@ public:
 
     /**
      * @brief 获取所有存档信息
-     * 
+     *
      * @return QList<SaveInfo> 所有存档信息列表
      */
     QList<SaveInfo> getAllSaveInfo() const;
 
+    /**
+     * @brief 后台扫描所有存档槽位
+     *
+     * 立即返回；后台线程先读旁路索引，对指纹匹配的槽位直接
+     * 发射saveInfoReady（零存档文件IO），指纹不符或索引缺失
+     * 的槽位打开存档summary段重建条目并修复索引。全部槽位
+     * 扫描完毕后发射saveScanCompleted。重复调用会先等待上
+     * 一次扫描结束。
+     */
+    Q_INVOKABLE void scanSavesAsync();
+
 signals:
     /**
      * @brief 游戏保存完成信号
@@ -115,24 +177,280 @@ signals:
 
     /**
      * @brief 存档删除完成信号
-     * 
+     *
      * @param slot 存档槽位
      */
     void saveDeleted(int slot);
 
+    /**
+     * @brief 自动存档完成信号
+     *
+     * 由后台写线程发射（自动队列连接回主线程）。
+     *
+     * @param slot 存档槽位
+     * @param success 写入是否成功
+     */
+    void autoSaveCompleted(int slot, bool success);
+
+    /**
+     * @brief 单个槽位的存档信息就绪信号
+     *
+     * 由扫描线程发射（自动队列连接回主线程），读取菜单
+     * 收到一条就填充一行，无需等待全部槽位扫描完成。
+     *
+     * @param info 该槽位的存档信息
+     */
+    void saveInfoReady(const SaveInfo &info);
+
+    /**
+     * @brief 存档扫描完成信号
+     */
+    void saveScanCompleted();
+
 private:
+    /**
+     * @brief 增量存档任务
+     *
+     * 主线程快照出的数据，交给后台写线程序列化写盘。
+     * sections为段快照（first为段名"player"或"gameState"，
+     * second为该段中被修改键的子集）；patchOps为GameState变更
+     * 日志折算出的RFC-6902补丁，日志可服务时取代gameState段
+     * 快照，体积与改动键数成正比。
+     */
+    struct PatchJob {
+        int slot = -1;                                  ///< 目标存档槽位
+        QVector<QPair<QString, QJsonObject>> sections;  ///< 段名到段快照
+        QJsonArray patchOps;                            ///< gameState的JSON补丁操作
+    };
+
+    /// FLSV存档文件魔数（"FLSV"小端）
+    static constexpr quint32 SAVE_MAGIC = 0x56534C46;
+    /// FLSV存档格式版本
+    static constexpr quint32 SAVE_FORMAT_VERSION = 1;
+
+    /// FLSI元数据索引文件魔数（"FLSI"小端）
+    static constexpr quint32 INDEX_MAGIC = 0x49534C46;
+    /// FLSI索引格式版本
+    static constexpr quint32 INDEX_FORMAT_VERSION = 1;
+
+    /// 全量存档的滚动备份代数（.bak1为最新一代）
+    static constexpr int BACKUP_GENERATIONS = 2;
+    /// 写线程组提交窗口：取到首个任务后再等这么久关门（毫秒）
+    static constexpr int GROUP_COMMIT_WINDOW_MS = 8;
+
+    /**
+     * @brief 旁路索引条目
+     *
+     * SaveInfo字段之外记录存档文件的指纹（修改时间与大小，
+     * 含补丁文件大小）；扫描时指纹匹配即可信任条目，不打开
+     * 存档本体。
+     */
+    struct IndexEntry {
+        SaveInfo info;              ///< 缓存的存档信息
+        qint64 saveFileTime = 0;    ///< 存档文件修改时间（毫秒）
+        qint64 saveFileSize = 0;    ///< 存档文件大小
+        qint64 patchFileSize = 0;   ///< 补丁文件大小（随自动存档增长）
+    };
+
     /**
      * @brief 初始化存档目录
      */
     void initializeSaveDirectory();
 
     /**
-     * @brief 获取存档文件路径
-     * 
+     * @brief 获取旧版JSON存档文件路径
+     *
      * @param slot 存档槽位
      * @return QString 存档文件路径
      */
     QString getSavePath(int slot) const;
+
+    /**
+     * @brief 获取二进制存档文件路径
+     *
+     * @param slot 存档槽位
+     * @return QString 存档文件路径
+     */
+    QString getBinarySavePath(int slot) const;
+
+    /**
+     * @brief 写入FLSV二进制存档
+     *
+     * 每段序列化为紧凑JSON并单独压缩，文件头后的索引记录
+     * 段名、偏移和长度，支持按段读取。
+     *
+     * 写入是原子的：内容先落到同目录的临时文件，fsync后
+     * rename覆盖目标；被替换的上一代基线经rotateBackups降级
+     * 为滚动备份。任一步失败都保留原文件不变。
+     *
+     * @param path 目标文件路径
+     * @param sections 段名到段数据的有序列表
+     * @return bool 写入是否成功
+     */
+    bool writeBinarySave(const QString &path,
+                         const QVector<QPair<QString, QJsonObject>> &sections) const;
+
+    /**
+     * @brief 滚动备份降级
+     *
+     * path.bak(N-1)依次改名为path.bak(N)，最旧的一代被丢弃，
+     * 最后把path本身降级为path.bak1。path不存在时为空操作。
+     * 备份只在全量保存时轮换，数量固定为BACKUP_GENERATIONS。
+     *
+     * @param path 存档文件路径
+     */
+    void rotateBackups(const QString &path) const;
+
+    /**
+     * @brief 按段读取FLSV二进制存档
+     *
+     * 只解压wanted中列出的段；wanted为空时读取全部段。
+     * 文件不存在或格式非法时返回空表。
+     *
+     * @param path 存档文件路径
+     * @param wanted 需要的段名列表
+     * @return QHash<QString, QJsonObject> 段名到段数据
+     */
+    QHash<QString, QJsonObject> readBinarySections(const QString &path,
+                                                   const QStringList &wanted = {}) const;
+
+    /**
+     * @brief 迁移旧版JSON存档为二进制格式
+     *
+     * 读取save_N.json（含已有段补丁），写出save_N.flsv后
+     * 删除旧文件。迁移失败时保留旧存档。
+     *
+     * @param slot 存档槽位
+     * @return bool 迁移是否成功
+     */
+    bool migrateLegacySave(int slot);
+
+    /**
+     * @brief 从完整存档JSON生成FLSV段列表
+     *
+     * 附带生成summary段，供getSaveInfo做部分读取。
+     *
+     * @param saveData 完整存档JSON
+     * @return QVector<QPair<QString, QJsonObject>> 段列表
+     */
+    static QVector<QPair<QString, QJsonObject>> buildSections(const QJsonObject &saveData);
+
+    /**
+     * @brief 获取补丁文件路径
+     *
+     * @param slot 存档槽位
+     * @return QString 补丁文件路径
+     */
+    QString getPatchPath(int slot) const;
+
+    /**
+     * @brief 后台写线程主循环
+     *
+     * 组提交：取到首个任务后在GROUP_COMMIT_WINDOW_MS窗口内
+     * 继续收集，把几乎同时触发的任务（自动存档+任务检查点）
+     * 并成一批，按槽位分组后每组一次追加写和fsync。单线程
+     * 保证补丁记录的追加顺序与提交顺序一致。
+     */
+    void patchWriterLoop();
+
+    /**
+     * @brief 把一批补丁任务写入补丁文件
+     *
+     * 在写线程执行：每段序列化为紧凑JSON、qCompress压缩后
+     * 以QDataStream记录追加到文件尾。整批共享一次文件打开，
+     * 末尾fsync一次；记录格式与逐任务写入完全相同。
+     *
+     * @param slot 目标存档槽位
+     * @param jobs 该槽位的补丁任务批，按提交顺序排列
+     * @return bool 写入是否成功
+     */
+    bool appendPatchBatch(int slot, const QVector<PatchJob> &jobs);
+
+    /**
+     * @brief 把补丁文件按段合并到完整存档
+     *
+     * 后写入的记录覆盖先写入的同名键。补丁文件不存在时为
+     * 空操作。
+     *
+     * @param slot 存档槽位
+     * @param saveData 输入输出参数，完整存档JSON
+     */
+    void applyPatches(int slot, QJsonObject &saveData) const;
+
+    /**
+     * @brief 获取旁路索引文件路径
+     *
+     * @return QString 索引文件路径
+     */
+    QString getIndexPath() const;
+
+    /**
+     * @brief 读取旁路索引
+     *
+     * 文件不存在或损坏时返回空表，由扫描路径按槽位重建。
+     *
+     * @return QHash<int, IndexEntry> 槽位到索引条目
+     */
+    QHash<int, IndexEntry> readSaveIndex() const;
+
+    /**
+     * @brief 写出旁路索引
+     *
+     * 索引只有每槽位几十字节，整体重写比就地更新简单且
+     * 足够便宜；与存档本体一样经临时文件fsync后rename替换，
+     * 重写中途崩溃不会留下半截索引。
+     *
+     * @param index 槽位到索引条目
+     * @return bool 写入是否成功
+     */
+    bool writeSaveIndex(const QHash<int, IndexEntry> &index) const;
+
+    /**
+     * @brief 采集槽位当前的文件指纹
+     *
+     * @param slot 存档槽位
+     * @param entry 输出参数，指纹字段被更新
+     */
+    void stampEntry(int slot, IndexEntry &entry) const;
+
+    /**
+     * @brief 槽位指纹是否与索引条目一致
+     *
+     * @param slot 存档槽位
+     * @param entry 索引条目
+     * @return bool 一致返回true（条目可信任）
+     */
+    bool entryMatchesDisk(int slot, const IndexEntry &entry) const;
+
+    /**
+     * @brief 重建并持久化单个槽位的索引条目
+     *
+     * 读取存档summary段生成SaveInfo、采集指纹并重写索引。
+     * 保存/删除/迁移路径在改动存档后调用；索引互斥锁保证
+     * 主线程与写线程的重写不交错。
+     *
+     * @param slot 存档槽位
+     * @return SaveInfo 该槽位的最新存档信息
+     */
+    SaveInfo refreshIndexEntry(int slot);
+
+    /**
+     * @brief 后台扫描线程主体
+     *
+     * 逐槽位发射saveInfoReady；结束时如有条目被重建则
+     * 整体重写索引，并发射saveScanCompleted。
+     */
+    void scanLoop();
+
+    mutable QMutex m_patchMutex;            ///< 保护补丁任务队列
+    QWaitCondition m_patchCondition;        ///< 有新任务时唤醒写线程
+    QQueue<PatchJob> m_patchQueue;          ///< 待写入的补丁任务
+    QHash<int, quint64> m_patchBaseVersion; ///< 槽位→补丁已覆盖到的日志版本（仅主线程访问）
+    std::thread m_patchWriter;              ///< 后台写线程
+    bool m_writerStopping = false;          ///< 写线程停机标志
+    mutable QMutex m_indexMutex;            ///< 保护索引文件重写
+    std::thread m_scanThread;               ///< 后台扫描线程
+    std::atomic<bool> m_scanStopping{false}; ///< 扫描提前终止标志
 };
 
 // 注册SaveInfo为Qt元类型，以便在QML中使用
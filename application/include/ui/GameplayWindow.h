@@ -96,6 +96,31 @@ private:
     void handleLeftClick(const QPoint &position);
     void handleRightClick(const QPoint &position);
 
+    /**
+     * @brief 标记游戏视图需要重绘
+     *
+     * 视图重绘按脏标记驱动：没有交互或状态变化的帧不再
+     * 无条件调用update()。
+     */
+    void markGameViewDirty();
+
+    /**
+     * @brief 上次应用到HUD的玩家数据快照
+     *
+     * updatePlayerInfo按元素与快照比对，只刷新实际变化的
+     * 控件（血条、蓝条、经验条、名字、等级各自独立判断）。
+     */
+    struct PlayerInfoCache {
+        QString name;
+        int level = -1;
+        int health = -1;
+        int maxHealth = -1;
+        int mana = -1;
+        int maxMana = -1;
+        int experience = -1;
+        int maxExperience = -1;
+    };
+
     ConfigManager* m_configManager;
     Game::InventorySystem* m_inventorySystem;
     PerformanceMonitor* m_performanceMonitor;
@@ -119,6 +144,11 @@ private:
 
     QTimer* m_updateTimer;
 
+    QWidget* m_miniMapWidget;       ///< 小地图绘制区域（10Hz降频重绘）
+    PlayerInfoCache m_playerInfoCache; ///< HUD元素脏检查快照
+    bool m_gameViewDirty;           ///< 游戏视图是否需要重绘
+    int m_updateTick;               ///< 更新定时器节拍计数
+
     bool m_isInventoryVisible;
     bool m_isChatVisible;
     bool m_isSkillPanelVisible;
@@ -8,6 +8,7 @@
 
 #include <QWidget>
 #include <QJsonObject>
+#include <QSet>
 #include <QVector>
 
 class QGridLayout;
@@ -28,8 +29,8 @@ public:
 
 private slots:
     void onSlotClicked();
-    void onItemAdded(int itemId, int quantity);
-    void onItemRemoved(int itemId, int quantity);
+    void onSlotChanged(int slotIndex);
+    void applyPendingSlotUpdates();
     void sortInventory();
     void clearInventory();
 
@@ -56,4 +57,7 @@ private:
 
     QVector<QPushButton*> m_slotButtons;
     int m_selectedSlot;
+
+    QSet<int> m_dirtySlots;         ///< 等待刷新的槽位（同帧合并）
+    bool m_refreshScheduled;        ///< 批量刷新是否已排入事件循环
 };
@@ -0,0 +1,233 @@
+/*
+ * 文件名: FrameProfiler.h
+ * 说明: 分层作用域帧剖析器头文件
+ * 作者: 彭承康
+ * 创建时间: 2026-08-28
+ *
+ * 与PerformanceMonitor的粗粒度FPS/内存统计互补：以RAII作用域
+ * 记录各子系统在一帧内的耗时层次，用于定位毛刺帧的去向。
+ *
+ * 设计特点:
+ * - 每线程独立环形缓冲，热路径无锁无分配，单个作用域开销
+ *   约为两次steady_clock读取（数十纳秒）
+ * - 名称只接受字符串字面量（保存const char*指针，不拷贝）
+ * - 嵌套作用域记录深度，可还原火焰图层次
+ * - 支持导出Chrome tracing格式（chrome://tracing / Perfetto）
+ *   供离线分析，以及聚合视图供调试覆盖层显示
+ *
+ * 使用示例:
+ * void GameEngine::update() {
+ *     PROFILE_ZONE("GameEngine::update");
+ *     ...
+ * }
+ */
+
+#ifndef FRAMEPROFILER_H
+#define FRAMEPROFILER_H
+
+#include <QString>
+#include <QVector>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+/**
+ * @brief 分层作用域帧剖析器
+ *
+ * 单例。各线程首次记录时注册自己的环形缓冲，之后的记录
+ * 不触碰任何共享状态；导出与聚合遍历所有已注册缓冲。
+ */
+class FrameProfiler
+{
+public:
+    /**
+     * @brief 单条作用域记录
+     */
+    struct ZoneEvent {
+        const char *name;       ///< 作用域名称（字符串字面量指针）
+        qint64 beginNs;         ///< 进入时间（纳秒，steady时基）
+        qint64 endNs;           ///< 退出时间（纳秒）
+        quint16 depth;          ///< 嵌套深度（0为最外层）
+    };
+
+    /**
+     * @brief 按名称聚合的作用域统计
+     */
+    struct ZoneStats {
+        QString name;           ///< 作用域名称
+        qint64 totalNs = 0;     ///< 累计耗时
+        qint64 maxNs = 0;       ///< 单次最大耗时
+        int count = 0;          ///< 进入次数
+    };
+
+    /**
+     * @brief 每线程环形缓冲
+     *
+     * 只有所属线程写入；导出线程并发读取可能看到个别
+     * 正在覆盖的条目，对剖析用途可接受。
+     */
+    class ThreadBuffer
+    {
+    public:
+        static constexpr std::size_t CAPACITY = 16384;  // 2的幂
+
+        /**
+         * @brief 追加一条作用域记录
+         */
+        void record(const char *name, qint64 beginNs, qint64 endNs, quint16 depth)
+        {
+            const std::size_t index = m_head & (CAPACITY - 1);
+            m_events[index] = ZoneEvent{name, beginNs, endNs, depth};
+            ++m_head;
+        }
+
+        quint64 threadId() const { return m_threadId; }
+
+    private:
+        friend class FrameProfiler;
+
+        explicit ThreadBuffer(quint64 threadId) : m_threadId(threadId) {}
+
+        quint64 m_threadId;
+        std::size_t m_head = 0;
+        std::vector<ZoneEvent> m_events = std::vector<ZoneEvent>(CAPACITY);
+    };
+
+    /**
+     * @brief 获取单例实例
+     */
+    static FrameProfiler& instance();
+
+    /**
+     * @brief 启用/停用剖析
+     *
+     * 停用时作用域宏只做一次原子读取即返回。
+     */
+    void setEnabled(bool enabled);
+
+    /**
+     * @brief 剖析是否启用
+     */
+    bool isEnabled() const
+    {
+        return m_enabled.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief 获取当前线程的环形缓冲（首次调用时注册）
+     */
+    ThreadBuffer* currentThreadBuffer();
+
+    /**
+     * @brief 按名称聚合所有线程的作用域统计
+     *
+     * 按累计耗时降序排列，调试覆盖层按此绘制火焰条。
+     */
+    QVector<ZoneStats> aggregate() const;
+
+    /**
+     * @brief 生成覆盖层摘要文本（耗时前列的作用域）
+     *
+     * @param maxZones 最多列出的作用域数
+     * @return QString 多行摘要
+     */
+    QString overlaySummary(int maxZones = 8) const;
+
+    /**
+     * @brief 导出Chrome tracing格式的事件流
+     *
+     * 生成的JSON可直接拖入chrome://tracing或Perfetto查看
+     * 各线程的火焰图时间轴。
+     *
+     * @param filePath 输出文件路径
+     * @return bool 是否导出成功
+     */
+    bool exportChromeTrace(const QString &filePath) const;
+
+    /**
+     * @brief 清空所有线程缓冲
+     */
+    void clear();
+
+    /**
+     * @brief 当前steady时基纳秒时间戳
+     */
+    static qint64 nowNs()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   std::chrono::steady_clock::now().time_since_epoch())
+            .count();
+    }
+
+private:
+    FrameProfiler() = default;
+
+    std::atomic<bool> m_enabled{true};
+
+    // 注册表只在线程首次记录和导出/聚合时加锁
+    mutable std::mutex m_registryMutex;
+    std::vector<std::unique_ptr<ThreadBuffer>> m_buffers;
+};
+
+/**
+ * @brief RAII作用域计时器
+ *
+ * 构造时取进入时间戳，析构时把完整区间写入当前线程的
+ * 环形缓冲。名称必须是字符串字面量。
+ */
+class ProfileZoneScope
+{
+public:
+    explicit ProfileZoneScope(const char *name)
+    {
+        if (!FrameProfiler::instance().isEnabled()) {
+            return;
+        }
+        m_name = name;
+        m_depth = s_depth++;
+        m_beginNs = FrameProfiler::nowNs();
+    }
+
+    ~ProfileZoneScope()
+    {
+        if (!m_name) {
+            return;
+        }
+        --s_depth;
+        FrameProfiler::instance().currentThreadBuffer()->record(
+            m_name, m_beginNs, FrameProfiler::nowNs(),
+            static_cast<quint16>(m_depth));
+    }
+
+    ProfileZoneScope(const ProfileZoneScope&) = delete;
+    ProfileZoneScope& operator=(const ProfileZoneScope&) = delete;
+
+private:
+    static thread_local int s_depth;
+
+    const char *m_name = nullptr;
+    qint64 m_beginNs = 0;
+    int m_depth = 0;
+};
+
+// ==================== 便利宏定义 ====================
+
+// 两级展开使__LINE__先求值再拼接，保证变量名唯一
+#define PROFILE_ZONE_CONCAT2(a, b) a##b
+#define PROFILE_ZONE_CONCAT(a, b) PROFILE_ZONE_CONCAT2(a, b)
+
+/**
+ * @brief 作用域剖析宏（名称须为字符串字面量）
+ */
+#define PROFILE_ZONE(name) \
+    ProfileZoneScope PROFILE_ZONE_CONCAT(profileZone_, __LINE__)(name)
+
+/**
+ * @brief 以当前函数名剖析整个函数体
+ */
+#define PROFILE_ZONE_FUNCTION() PROFILE_ZONE(__FUNCTION__)
+
+#endif // FRAMEPROFILER_H
@@ -3,6 +3,7 @@
  * 说明: 日志系统头文件
  * 作者: 彭承康
  * 创建时间: 2026-02-18
+ * 更新时间: 2026-08-28 — 同步写改为无锁环形缓冲+后台刷盘线程
  */
 
 #ifndef LOGGER_H
@@ -13,6 +14,13 @@
 #include <QTextStream>
 #include <QMutex>
 #include <QString>
+#include <QStringList>
+#include <QVector>
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <thread>
 
 /**
  * @brief 日志级别枚举
@@ -28,12 +36,18 @@ enum class LogLevel
 
 /**
  * @brief 日志系统类
- * 
+ *
  * 提供线程安全的日志记录功能，支持：
  * - 多种日志级别
  * - 控制台和文件输出
  * - 日志文件轮转
  * - 自动清理旧日志
+ *
+ * 调用线程只做级别过滤、取时间戳和QString引用计数拷贝后推入
+ * 无锁环形缓冲（多生产者，单消费者，Vyukov协议，与策略层
+ * AsyncLogService一致），格式化与控制台/文件写出全部由后台
+ * 刷盘线程完成，帧路径上的日志调用绝不阻塞。后台线程同时维护
+ * 一个有界的"最近日志行"缓冲，供崩溃处理器转储。
  */
 class Logger : public QObject
 {
@@ -42,14 +56,17 @@ class Logger : public QObject
 public:
     /**
      * @brief 获取日志系统单例实例
-     * 
+     *
      * @return Logger* 日志系统实例
      */
     static Logger* instance();
 
     /**
      * @brief 记录日志
-     * 
+     *
+     * 非阻塞：日志被推入环形缓冲后立即返回，缓冲满时丢弃
+     * 最旧的日志并计数。
+     *
      * @param level 日志级别
      * @param message 日志消息
      * @param category 日志分类（默认为"General"）
@@ -58,7 +75,7 @@ public:
 
     /**
      * @brief 记录调试日志
-     * 
+     *
      * @param message 日志消息
      * @param category 日志分类
      */
@@ -66,7 +83,7 @@ public:
 
     /**
      * @brief 记录信息日志
-     * 
+     *
      * @param message 日志消息
      * @param category 日志分类
      */
@@ -74,7 +91,7 @@ public:
 
     /**
      * @brief 记录警告日志
-     * 
+     *
      * @param message 日志消息
      * @param category 日志分类
      */
@@ -82,7 +99,7 @@ public:
 
     /**
      * @brief 记录错误日志
-     * 
+     *
      * @param message 日志消息
      * @param category 日志分类
      */
@@ -90,7 +107,7 @@ public:
 
     /**
      * @brief 记录严重错误日志
-     * 
+     *
      * @param message 日志消息
      * @param category 日志分类
      */
@@ -98,49 +115,78 @@ public:
 
     /**
      * @brief 设置日志级别
-     * 
+     *
      * @param level 最低记录的日志级别
      */
     void setLogLevel(LogLevel level);
 
     /**
      * @brief 设置控制台输出
-     * 
+     *
      * @param enabled 是否启用控制台输出
      */
     void setConsoleOutput(bool enabled);
 
     /**
      * @brief 设置文件输出
-     * 
+     *
+     * 只切换开关；日志文件的打开/关闭由后台线程完成。
+     *
      * @param enabled 是否启用文件输出
      */
     void setFileOutput(bool enabled);
 
     /**
      * @brief 设置最大日志文件数量
-     * 
+     *
      * @param count 最大文件数量
      */
     void setMaxLogFiles(int count);
 
     /**
      * @brief 设置单个日志文件最大大小
-     * 
+     *
      * @param size 最大文件大小（字节）
      */
     void setMaxFileSize(qint64 size);
 
+    /**
+     * @brief 获取最近的格式化日志行
+     *
+     * 返回后台线程维护的有界"最近日志行"缓冲的快照（按时间
+     * 顺序），供崩溃处理器在转储时附带最后的日志上下文。
+     *
+     * @return QStringList 最近的日志行
+     */
+    QStringList recentLines() const;
+
+    /**
+     * @brief 因缓冲溢出被丢弃的日志条数
+     *
+     * @return quint64 丢弃计数
+     */
+    quint64 droppedCount() const;
+
+    /**
+     * @brief 等待环形缓冲排空
+     *
+     * 供退出流程或崩溃处理器调用，有界等待（约1秒）后返回，
+     * 不保证期间新入队的日志也被处理。
+     */
+    void flush();
+
 signals:
     /**
      * @brief 日志消息信号
-     * 
+     *
+     * 从后台刷盘线程发出，跨线程连接为队列式投递。
+     *
      * @param level 日志级别
      * @param message 日志消息
      * @param category 日志分类
      * @param timestamp 时间戳
      */
-    void logMessage(LogLevel level, const QString &message, 
+    void logMessage(LogLevel level, const QString &message,
                    const QString &category, const QString &timestamp);
 
 private:
@@ -151,33 +197,54 @@ private:
     Logger(const Logger&) = delete;
     Logger& operator=(const Logger&) = delete;
 
+    /**
+     * @brief 日志记录（生产侧快照，格式化推迟到后台线程）
+     */
+    struct LogRecord {
+        LogLevel level = LogLevel::Info;    ///< 日志级别
+        qint64 timestampMs = 0;             ///< 记录时刻（毫秒时间戳）
+        QString message;                    ///< 原始消息
+        QString category;                   ///< 日志分类
+    };
+
+    /**
+     * @brief 环形缓冲槽位
+     *
+     * sequence 采用Vyukov协议: 等于下标表示可写，等于下标+1表示
+     * 可读，读取后置为下标+容量进入下一轮。
+     */
+    struct Slot {
+        std::atomic<std::size_t> sequence;  ///< 槽位序号
+        LogRecord record;                   ///< 槽位内容
+    };
+
     /**
      * @brief 初始化日志目录
      */
     void initializeLogDirectory();
 
     /**
-     * @brief 打开日志文件
+     * @brief 打开日志文件（仅后台线程调用）
      */
     void openLogFile();
 
     /**
      * @brief 输出到控制台
-     * 
+     *
      * @param level 日志级别
      * @param message 格式化后的消息
      */
     void outputToConsole(LogLevel level, const QString &message);
 
     /**
-     * @brief 输出到文件
-     * 
+     * @brief 输出到文件（仅后台线程调用）
+     *
      * @param message 格式化后的消息
      */
     void outputToFile(const QString &message);
 
     /**
-     * @brief 轮转日志文件
+     * @brief 轮转日志文件（仅后台线程调用）
      */
     void rotateLogFile();
 
@@ -188,28 +255,71 @@ private:
 
     /**
      * @brief 日志级别转字符串
-     * 
+     *
      * @param level 日志级别
      * @return QString 级别字符串
      */
     QString logLevelToString(LogLevel level);
 
+    /**
+     * @brief 推入环形缓冲，满时丢弃最旧日志后重试
+     */
+    void submit(LogRecord &&record);
+
+    bool tryEnqueue(LogRecord &&record);
+    bool tryDequeue(LogRecord &record);
+    bool tryDiscardOldest();
+
+    /**
+     * @brief 后台刷盘线程主循环
+     *
+     * 批量取出缓冲中的日志，完成格式化、控制台/文件输出、
+     * 最近日志行缓冲维护与信号发射。
+     */
+    void processRing();
+
+    /**
+     * @brief 追加一行到最近日志行缓冲（仅后台线程调用）
+     */
+    void appendRecentLine(const QString &line);
+
+    // 缓冲容量（2的幂，便于位运算取模）
+    static constexpr std::size_t RING_CAPACITY = 8192;
+    // 最近日志行缓冲容量
+    static constexpr int RECENT_LINES_CAPACITY = 512;
+    // 缓冲满时丢弃最旧日志的重试次数
+    static constexpr int DROP_OLDEST_RETRY_LIMIT = 4;
+
     // 单例相关
     static Logger* s_instance;
     static QMutex s_mutex;
 
-    // 配置参数
-    LogLevel m_logLevel;
-    bool m_enableConsoleOutput;
-    bool m_enableFileOutput;
-    int m_maxLogFiles;
-    qint64 m_maxFileSize;
+    // 配置参数（生产者与后台线程并发访问，全部原子化）
+    std::atomic<int> m_logLevel;
+    std::atomic<bool> m_enableConsoleOutput;
+    std::atomic<bool> m_enableFileOutput;
+    std::atomic<int> m_maxLogFiles;
+    std::atomic<qint64> m_maxFileSize;
 
-    // 文件操作
+    // 环形缓冲
+    std::unique_ptr<Slot[]> m_ring;             ///< 槽位数组
+    std::atomic<std::size_t> m_head{0};         ///< 生产者写入位置
+    std::atomic<std::size_t> m_tail{0};         ///< 消费/丢弃位置
+    std::atomic<quint64> m_droppedCount{0};     ///< 溢出丢弃计数
+
+    // 后台刷盘线程
+    std::thread m_workerThread;
+    std::atomic<bool> m_stopFlag{false};
+
+    // 文件操作（仅后台线程访问）
     QString m_logDirectory;
     QFile m_logFile;
     QTextStream m_logStream;
-    QMutex m_mutex;
+
+    // 最近日志行缓冲（后台线程写，崩溃处理器读）
+    mutable QMutex m_recentMutex;
+    QVector<QString> m_recentLines;
+    int m_recentNext = 0;
 };
 
 // 全局日志函数
@@ -219,4 +329,4 @@ void logWarning(const QString &message, const QString &category = "General");
 void logError(const QString &message, const QString &category = "General");
 void logCritical(const QString &message, const QString &category = "General");
 
-#endif // LOGGER_H
\ No newline at end of file
+#endif // LOGGER_H
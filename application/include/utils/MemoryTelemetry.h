@@ -0,0 +1,173 @@
+/*
+ * 文件名: MemoryTelemetry.h
+ * 说明: 进程级内存遥测，按子系统归属统计内存占用。
+ * 作者: 彭承康
+ * 创建时间: 2026-08-28
+ *
+ * 客户端RSS涨到2GB时，仅靠进程级数字无法判断内存在
+ * ResourceManager、QML还是音频缓冲手里。本类按application/src
+ * 的子系统划分（core/game/graphics/audio/network等）维护
+ * 原子计数：当前占用、历史峰值（高水位）和分配次数。
+ * 大缓冲的所有者在分配/释放处打点，容器可用TrackedAllocator
+ * 自动归账；数据经PerformanceMonitor::getMemoryBreakdown()
+ * 在游戏内查询。
+ */
+#pragma once
+
+#include <QJsonObject>
+#include <QtGlobal>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <new>
+
+/**
+ * @brief 按子系统归属的内存遥测
+ *
+ * 所有接口线程安全（relaxed原子计数），打点热路径无锁。
+ * 计数只覆盖打点方报告的字节数，是归属分析工具而非精确
+ * 堆测量；与PerformanceMonitor的进程RSS对照使用。
+ */
+class MemoryTelemetry
+{
+public:
+    /**
+     * @brief 子系统标签（对应application/src目录划分）
+     */
+    enum class Subsystem : int {
+        Core = 0,    ///< core/（资源、场景、事件）
+        Game,        ///< game/（战斗、玩家、背包）
+        Graphics,    ///< graphics/（精灵、动画）
+        Audio,       ///< audio/（音效缓冲）
+        Network,     ///< network/（RPC缓冲）
+        UI,          ///< ui/与QML侧
+        Save,        ///< save/（存档缓冲）
+        Other,       ///< 未归类
+        Count        ///< 标签数量哨兵
+    };
+
+    /**
+     * @brief 单个子系统的统计快照
+     */
+    struct SubsystemStats {
+        qint64 currentBytes = 0;  ///< 当前占用（字节）
+        qint64 peakBytes = 0;     ///< 历史峰值（高水位，字节）
+        qint64 allocCount = 0;    ///< 累计分配次数
+    };
+
+    /**
+     * @brief 获取单例实例
+     */
+    static MemoryTelemetry* instance();
+
+    /**
+     * @brief 记录一次分配（热路径，无锁）
+     * @param subsystem 归属子系统
+     * @param bytes 分配字节数
+     */
+    void recordAlloc(Subsystem subsystem, qint64 bytes);
+
+    /**
+     * @brief 记录一次释放
+     * @param subsystem 归属子系统
+     * @param bytes 释放字节数
+     */
+    void recordFree(Subsystem subsystem, qint64 bytes);
+
+    /**
+     * @brief 直接上报子系统的当前占用
+     *
+     * 供自带总量统计的所有者（如ResourceManager）整体上报，
+     * 代替逐次alloc/free打点；同样维护高水位。
+     *
+     * @param subsystem 归属子系统
+     * @param bytes 当前占用字节数
+     */
+    void setUsage(Subsystem subsystem, qint64 bytes);
+
+    /**
+     * @brief 获取子系统统计
+     */
+    SubsystemStats stats(Subsystem subsystem) const;
+
+    /**
+     * @brief 所有子系统的当前占用总和
+     */
+    qint64 totalTrackedBytes() const;
+
+    /**
+     * @brief 生成全部子系统的JSON快照（游戏内查询用）
+     *
+     * 每个子系统一个对象：current/peak/allocs，另附tracked_total。
+     */
+    QJsonObject snapshot() const;
+
+    /**
+     * @brief 重置所有高水位为当前占用
+     */
+    void resetPeaks();
+
+    /**
+     * @brief 子系统名称（与application/src目录名一致）
+     */
+    static const char* subsystemName(Subsystem subsystem);
+
+private:
+    MemoryTelemetry() = default;
+
+    /**
+     * @brief 单个子系统的原子计数器
+     */
+    struct Counter {
+        std::atomic<qint64> current{0};  ///< 当前占用
+        std::atomic<qint64> peak{0};     ///< 历史峰值
+        std::atomic<qint64> allocs{0};   ///< 分配次数
+    };
+
+    /**
+     * @brief 以CAS循环把峰值抬升到不低于value
+     */
+    static void raisePeak(Counter &counter, qint64 value);
+
+    static constexpr int SUBSYSTEM_COUNT = static_cast<int>(Subsystem::Count);
+
+    std::array<Counter, SUBSYSTEM_COUNT> m_counters;  ///< 按标签索引的计数器
+};
+
+/**
+ * @brief 归账分配器：容器分配自动计入指定子系统
+ *
+ * 用法: std::vector<int, TrackedAllocator<int, MemoryTelemetry::Subsystem::Game>>
+ * 分配/释放在遥测中打点后转发给全局operator new/delete。
+ */
+template <typename T, MemoryTelemetry::Subsystem Tag>
+class TrackedAllocator
+{
+public:
+    using value_type = T;
+
+    TrackedAllocator() noexcept = default;
+
+    template <typename U>
+    TrackedAllocator(const TrackedAllocator<U, Tag> &) noexcept {}
+
+    T* allocate(std::size_t count)
+    {
+        const std::size_t bytes = count * sizeof(T);
+        MemoryTelemetry::instance()->recordAlloc(Tag, static_cast<qint64>(bytes));
+        return static_cast<T*>(::operator new(bytes));
+    }
+
+    void deallocate(T *pointer, std::size_t count) noexcept
+    {
+        MemoryTelemetry::instance()->recordFree(
+            Tag, static_cast<qint64>(count * sizeof(T)));
+        ::operator delete(pointer);
+    }
+
+    template <typename U>
+    bool operator==(const TrackedAllocator<U, Tag> &) const noexcept { return true; }
+
+    template <typename U>
+    bool operator!=(const TrackedAllocator<U, Tag> &) const noexcept { return false; }
+};
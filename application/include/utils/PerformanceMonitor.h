@@ -28,10 +28,19 @@
 #include <QObject>
 #include <QTimer>
 #include <QElapsedTimer>
+#include <QJsonObject>
 #include <QQueue>
 #include <QMap>
 #include <QMutex>
 
+#include "trace/TraceRing.h"
+
+#include <memory>
+
+namespace metrics {
+class MetricsExporter;
+}
+
 /**
  * @brief 性能监控器类
  * 
@@ -207,7 +216,29 @@ public:
      * @brief 重置内存统计
      */
     void resetMemoryStats();
-    
+
+    /**
+     * @brief 获取按子系统归属的内存明细（游戏内查询用）
+     *
+     * 汇总MemoryTelemetry各子系统的当前占用、高水位与分配
+     * 次数，并附上进程RSS与峰值RSS作对照：明细与RSS的差值
+     * 即未打点部分（QML、Qt内部等）。
+     *
+     * @return QJsonObject 每个子系统一个对象，另附process_rss等
+     */
+    Q_INVOKABLE QJsonObject getMemoryBreakdown() const;
+
+    /**
+     * @brief 记录本次启动的阶段剖析报告
+     *
+     * 由StartupProfiler在首帧就绪后调用一次，报告随
+     * exportPerformanceData并入性能报告，跨版本追踪
+     * 启动耗时回归。
+     *
+     * @param profile 启动剖析报告（startup_profile_v1）
+     */
+    void recordStartupProfile(const QJsonObject &profile);
+
     // ==================== 渲染监控接口 ====================
     
     /**
@@ -315,6 +346,62 @@ public:
      */
     bool exportPerformanceData(const QString &filePath) const;
 
+    // ==================== 指标导出 ====================
+
+    /**
+     * @brief 启动指标导出（HTTP拉取端点 + 磁盘环持久化）
+     *
+     * 在给定端口起一个Prometheus文本格式的拉取端点，导出帧率、
+     * 帧时间、内存、绘制调用等核心指标与累计帧数。抓取时才读
+     * 当前指标快照，开销与帧率无关。persistPath非空时快照定期
+     * 写入固定大小的磁盘槽环，启动时回灌累计帧数等单调计数，
+     * 跨重启续增。
+     *
+     * @param port 监听端口（0为临时端口）
+     * @param persistPath 持久化环文件路径，空串禁用持久化
+     * @return 是否启动成功
+     */
+    bool startMetricsExporter(quint16 port, const QString &persistPath);
+
+    /**
+     * @brief 停止指标导出（并写入最后一次持久化快照）
+     */
+    void stopMetricsExporter();
+
+    // ==================== 跨层追踪 ====================
+
+    /**
+     * @brief 生成新的跨层追踪ID
+     *
+     * 由动作发起方（客户端）调用，ID随gRPC元数据传播到
+     * 策略/算法服务，各进程的跳点事后可合并为单条时间线。
+     *
+     * @return quint64 非零追踪ID
+     */
+    static quint64 generateTraceId();
+
+    /**
+     * @brief 记录一个追踪跳点
+     *
+     * 记录路径为原子计数加槽位写入，开销足够低，生产环境
+     * 可常开。traceId为0时不记录。
+     *
+     * @param traceId 追踪ID
+     * @param hop 跳点名称（如"client_send"）
+     */
+    void recordTraceEvent(quint64 traceId, const char *hop);
+
+    /**
+     * @brief 导出追踪事件CSV（trace_id,timestamp_us,hop）
+     *
+     * 输出与tools/trace_merge的输入格式一致，可与服务端进程
+     * 的导出文件合并查看单个动作的完整时间线。
+     *
+     * @param filePath 导出文件路径
+     * @return bool 导出是否成功
+     */
+    bool exportTraceEvents(const QString &filePath) const;
+
 signals:
     // ==================== 性能变化信号 ====================
     
@@ -449,6 +536,9 @@ private:
     qint64 m_currentMemoryUsage;                    ///< 当前内存使用量
     qint64 m_peakMemoryUsage;                       ///< 峰值内存使用量
 
+    // 启动剖析
+    QJsonObject m_startupProfile;                   ///< 本次启动的阶段剖析报告
+
     // 渲染统计
     int m_drawCalls;                                ///< 绘制调用次数
     int m_triangles;                                ///< 三角形数量
@@ -467,6 +557,11 @@ private:
     qint64 m_memoryWarningThreshold;                ///< 内存警告阈值
     qint64 m_frameTimeWarningThreshold;             ///< 帧时间警告阈值
 
+    // 跨层追踪
+    trace::TraceRing m_traceRing;                   ///< 追踪事件环
+
+    std::unique_ptr<metrics::MetricsExporter> m_metricsExporter;  ///< 指标导出器（可选）
+
     // 时间和文件
     qint64 m_startTime;                             ///< 监控开始时间
     QString m_logFilePath;                          ///< 日志文件路径
@@ -0,0 +1,142 @@
+/*
+ * 文件名: StartupProfiler.h
+ * 说明: 启动阶段计时器，输出机器可读的冷启动报告
+ * 作者: 彭承康
+ * 创建时间: 2026-08-28
+ *
+ * 冷启动耗时缺乏可观测性：本类把启动流程切成命名阶段
+ * （Qt初始化、配置解析、资源预载、QML加载、网络连接等），
+ * 记录各阶段相对进程起点的时间戳与时长。首帧就绪后
+ * finish()输出报告：
+ * - 写入AppData/performance/startup_<时间戳>.json
+ * - 以STARTUP_PROFILE前缀打一行紧凑JSON日志，便于采集
+ * - 交给PerformanceMonitor并入性能报告，跨版本追踪回归
+ *
+ * 线程模型：所有接口只在主线程调用（instance()首次调用
+ * 锚定时间零点，应放在main()入口处）。
+ */
+
+#ifndef UTILS_STARTUPPROFILER_H
+#define UTILS_STARTUPPROFILER_H
+
+#include <QElapsedTimer>
+#include <QJsonObject>
+#include <QString>
+
+#include <vector>
+
+/**
+ * @brief 启动阶段计时器
+ *
+ * 阶段用beginPhase/endPhase成对标记，允许嵌套（引擎初始化
+ * 内部再标记配置解析）；更推荐用StartupPhase作用域对象，
+ * 离开作用域自动收尾。finish()之后的标记调用被忽略，
+ * 启动报告每次进程生命周期只产出一份。
+ */
+class StartupProfiler
+{
+public:
+    /**
+     * @brief 获取单例实例
+     *
+     * 首次调用锚定启动时间零点，应在main()入口处调用。
+     *
+     * @return StartupProfiler* 单例指针
+     */
+    static StartupProfiler* instance();
+
+    /**
+     * @brief 开始一个命名阶段
+     *
+     * @param name 阶段名称（qt_init、config_parse等）
+     */
+    void beginPhase(const QString &name);
+
+    /**
+     * @brief 结束一个命名阶段
+     *
+     * 与最近一次未结束的同名beginPhase配对；找不到配对
+     * 时忽略并打警告日志。
+     *
+     * @param name 阶段名称
+     */
+    void endPhase(const QString &name);
+
+    /**
+     * @brief 结束启动剖析并输出报告
+     *
+     * 首帧就绪后调用一次：未闭合的阶段按当前时刻收尾，
+     * 报告写盘、打日志并交给PerformanceMonitor聚合。
+     * 重复调用无效果。
+     */
+    void finish();
+
+    /**
+     * @brief 获取当前报告
+     *
+     * @return QJsonObject 报告对象（schema为startup_profile_v1）
+     */
+    QJsonObject report() const;
+
+    /**
+     * @brief 是否已完成启动剖析
+     *
+     * @return bool finish()是否已执行过
+     */
+    bool isFinished() const { return m_finished; }
+
+private:
+    StartupProfiler();
+
+    /**
+     * @brief 阶段记录
+     */
+    struct Phase {
+        QString name;          ///< 阶段名称
+        qint64 beginMs = 0;    ///< 相对进程起点的开始时刻（毫秒）
+        qint64 durationMs = -1; ///< 时长（毫秒），-1表示未结束
+    };
+
+    QElapsedTimer m_clock;           ///< 进程起点锚定的单调时钟
+    std::vector<Phase> m_phases;     ///< 按开始顺序记录的阶段
+    bool m_finished = false;         ///< 是否已输出报告
+
+    static StartupProfiler *s_instance;  ///< 单例实例（主线程创建）
+};
+
+/**
+ * @brief 启动阶段作用域对象
+ *
+ * 构造时beginPhase、析构时endPhase，阶段覆盖范围与
+ * 作用域一致，提前return也不会漏收尾。
+ */
+class StartupPhase
+{
+public:
+    /**
+     * @brief 构造函数，开始阶段
+     *
+     * @param name 阶段名称
+     */
+    explicit StartupPhase(const QString &name)
+        : m_name(name)
+    {
+        StartupProfiler::instance()->beginPhase(m_name);
+    }
+
+    /**
+     * @brief 析构函数，结束阶段
+     */
+    ~StartupPhase()
+    {
+        StartupProfiler::instance()->endPhase(m_name);
+    }
+
+    StartupPhase(const StartupPhase&) = delete;
+    StartupPhase& operator=(const StartupPhase&) = delete;
+
+private:
+    QString m_name;  ///< 阶段名称
+};
+
+#endif // UTILS_STARTUPPROFILER_H
@@ -32,7 +32,14 @@ Rectangle {
     signal saveRequested()
     
     color: "#1a1a1a"
-    
+
+    // 首屏只构建可见UI，隐藏面板按优先级在空闲帧预热
+    Component.onCompleted: {
+        if (typeof sceneManager !== "undefined") {
+            sceneManager.warmUpSceneUi("Gameplay")
+        }
+    }
+
     // 主要布局
     RowLayout {
         anchors.fill: parent
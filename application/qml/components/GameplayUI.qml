@@ -122,63 +122,76 @@ Item {
         }
     }
     
-    // 对话框区域
-    Rectangle {
-        id: dialogArea
+    // 对话框区域（懒实例化：空闲预热或首次对话时创建）
+    LazyPanel {
+        id: dialogPanel
+        warmupName: "Gameplay.dialogPanel"
         anchors.bottom: parent.bottom
         anchors.left: parent.left
         anchors.right: parent.right
         height: 150
-        color: "#2a2a2a"
-        border.color: "#555555"
-        border.width: 2
-        opacity: 0.95
-        visible: false
-        
-        ColumnLayout {
+
+        sourceComponent: Rectangle {
+            id: dialogArea
+
+            /// 说话者名称（由showDialog()设置）
+            property alias speaker: speakerName.text
+
+            /// 对话内容（由showDialog()设置）
+            property alias content: dialogText.text
+
             anchors.fill: parent
-            anchors.margins: 20
-            spacing: 15
-            
-            // 说话者名称
-            Text {
-                id: speakerName
-                text: "NPC名称"
-                font.family: "Microsoft YaHei"
-                font.pixelSize: 16
-                font.bold: true
-                color: "#FFD700"
-            }
-            
-            // 对话内容
-            ScrollView {
-                Layout.fillWidth: true
-                Layout.fillHeight: true
-                
+            color: "#2a2a2a"
+            border.color: "#555555"
+            border.width: 2
+            opacity: 0.95
+            visible: false
+
+            ColumnLayout {
+                anchors.fill: parent
+                anchors.margins: 20
+                spacing: 15
+
+                // 说话者名称
                 Text {
-                    id: dialogText
-                    text: "这里是对话内容..."
+                    id: speakerName
+                    text: "NPC名称"
                     font.family: "Microsoft YaHei"
-                    font.pixelSize: 14
-                    color: "#FFFFFF"
-                    wrapMode: Text.WordWrap
-                    width: parent.width
+                    font.pixelSize: 16
+                    font.bold: true
+                    color: "#FFD700"
                 }
-            }
-            
-            // 对话选项
-            Row {
-                Layout.alignment: Qt.AlignRight
-                spacing: 10
-                
-                Button {
-                    text: "继续"
-                    onClicked: hideDialog()
+
+                // 对话内容
+                ScrollView {
+                    Layout.fillWidth: true
+                    Layout.fillHeight: true
+
+                    Text {
+                        id: dialogText
+                        text: "这里是对话内容..."
+                        font.family: "Microsoft YaHei"
+                        font.pixelSize: 14
+                        color: "#FFFFFF"
+                        wrapMode: Text.WordWrap
+                        width: parent.width
+                    }
                 }
-                
-                Button {
-                    text: "跳过"
-                    onClicked: hideDialog()
+
+                // 对话选项
+                Row {
+                    Layout.alignment: Qt.AlignRight
+                    spacing: 10
+
+                    Button {
+                        text: "继续"
+                        onClicked: hideDialog()
+                    }
+
+                    Button {
+                        text: "跳过"
+                        onClicked: hideDialog()
+                    }
                 }
             }
         }
@@ -319,16 +332,19 @@ Item {
         })
     }
     
-    // 显示对话框
+    // 显示对话框（首次调用时同步实例化面板）
     function showDialog(speaker, content) {
-        speakerName.text = speaker
-        dialogText.text = content
-        dialogArea.visible = true
+        dialogPanel.ensure()
+        dialogPanel.item.speaker = speaker
+        dialogPanel.item.content = content
+        dialogPanel.item.visible = true
     }
-    
+
     // 隐藏对话框
     function hideDialog() {
-        dialogArea.visible = false
+        if (dialogPanel.item) {
+            dialogPanel.item.visible = false
+        }
     }
     
     // 显示经验获得
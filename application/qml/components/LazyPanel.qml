@@ -0,0 +1,53 @@
+/*
+ * 文件名: LazyPanel.qml
+ * 说明: 懒实例化面板容器
+ * 作者: 彭承康
+ * 创建时间: 2026-08-28
+ */
+
+import QtQuick 2.15
+
+/**
+ * @brief 懒实例化面板容器
+ *
+ * 隐藏面板和对话框的延迟加载外壳：界面首开时不实例化内容，
+ * 由两种途径触发创建：
+ * - SceneManager按场景的UI预热优先级表在空闲帧逐个发出
+ *   uiWarmupRequested()，warmupName匹配的面板预热实例化；
+ * - 首次使用时调用ensure()同步实例化（预热尚未轮到时兜底）。
+ *
+ * 用法：把原来始终实例化的隐藏元素移入sourceComponent，
+ * 打开前调用ensure()后经item访问。
+ */
+Loader {
+    id: lazyPanel
+
+    /// 预热名称，与SceneManager的UI预热优先级表中的条目对应；
+    /// 留空则只在首次ensure()时实例化，不参与预热
+    property string warmupName: ""
+
+    /// 内容是否已实例化（预热或首次使用置位）
+    property bool warmed: false
+
+    active: warmed
+
+    /**
+     * @brief 确保内容已实例化
+     *
+     * 首次使用时同步创建，已创建时无开销。
+     */
+    function ensure() {
+        warmed = true
+    }
+
+    // 监听C++侧的空闲预热信号
+    Connections {
+        target: typeof sceneManager !== "undefined" ? sceneManager : null
+
+        function onUiWarmupRequested(elementName) {
+            if (elementName !== "" && elementName === lazyPanel.warmupName) {
+                lazyPanel.warmed = true
+            }
+        }
+    }
+}
@@ -16,11 +16,16 @@
 #include "game/GameState.h"
 #include "game/Player.h"
 #include "game/BattleSystem.h"
+#include "core/QmlComponentPool.h"
+#include "config/GameConfig.h"
+#include "graphics/RenderCapabilityProbe.h"
+#include "utils/StartupProfiler.h"
 
 #include <QQmlContext>
 #include <QQuickStyle>
-#include <QApplication> 
+#include <QApplication>
 #include <QDir>
+#include <QTimer>
 
 /**
  * @brief 构造函数实现
@@ -56,35 +61,56 @@ bool GameApplication::initialize()
 {
     try {
         // 1. 创建子系统实例（关键修复）
-        m_resourceManager = std::make_unique<ResourceManager>();
-        m_sceneManager = std::make_unique<SceneManager>();
-        m_networkManager = std::make_unique<NetworkManager>();
-        m_audioManager = std::make_unique<AudioManager>();
-        m_gameEngine = std::make_unique<GameEngine>();
-        
-        //2.  初始化资源管理器
-        if (!m_resourceManager->initialize()) {
-            qCritical() << "GameApplication: 资源管理器初始化失败";
-            return false;
+        {
+            StartupPhase phase(QStringLiteral("subsystem_create"));
+            m_gameConfig = std::make_unique<GameConfig>();
+            m_resourceManager = std::make_unique<ResourceManager>();
+            m_sceneManager = std::make_unique<SceneManager>();
+            m_networkManager = std::make_unique<NetworkManager>();
+            m_audioManager = std::make_unique<AudioManager>();
+            m_gameEngine = std::make_unique<GameEngine>();
         }
-        
+
+        //2.  初始化资源管理器（含资源索引与预载）
+        {
+            StartupPhase phase(QStringLiteral("resource_preload"));
+            if (!m_resourceManager->initialize()) {
+                qCritical() << "GameApplication: 资源管理器初始化失败";
+                return false;
+            }
+        }
+
         //3. 初始化场景管理器
-        if (!m_sceneManager->initialize(m_resourceManager.get())) {
-            qCritical() << "GameApplication: 场景管理器初始化失败";
-            return false;
+        {
+            StartupPhase phase(QStringLiteral("scene_init"));
+            if (!m_sceneManager->initialize(m_resourceManager.get())) {
+                qCritical() << "GameApplication: 场景管理器初始化失败";
+                return false;
+            }
         }
-        
-        //4. 初始化游戏引擎
-        if (!m_gameEngine->initialize(m_sceneManager.get(), m_resourceManager.get(),
-                             m_networkManager.get(), m_audioManager.get())) {
-            qCritical() << "GameApplication: 游戏引擎初始化失败";
-            return false;
+
+        //4. 初始化游戏引擎（内部标记config_parse子阶段）
+        {
+            StartupPhase phase(QStringLiteral("engine_init"));
+            if (!m_gameEngine->initialize(m_sceneManager.get(), m_resourceManager.get(),
+                                 m_networkManager.get(), m_audioManager.get())) {
+                qCritical() << "GameApplication: 游戏引擎初始化失败";
+                return false;
+            }
         }
-        
-        // 5. 注册QML类型和建立连接
+
+        // 5. 能力探测定档：手动覆盖 > 持久化探测值 > 现场微基准；
+        // 渲染组件（SpriteRenderer/AnimationManager）创建时经
+        // setLodTier(m_effectLodTier)取用本层级
+        {
+            StartupPhase phase(QStringLiteral("capability_probe"));
+            m_effectLodTier = RenderCapabilityProbe::resolveTier(m_gameConfig.get());
+        }
+
+        // 6. 注册QML类型和建立连接
         registerQmlTypes();
         setupConnections();
-        
+
         m_isInitialized = true;
         //emit initializationChanged();
         qDebug() << "GameApplication: 应用程序初始化成功";
@@ -111,21 +137,69 @@ void GameApplication::start()
     // 设置UI样式
     QQuickStyle::setStyle("Material");
 
-    // 向QML暴露核心管理器（关键补充）
+    // 向QML暴露主菜单就需要的对象；背包与战斗系统延迟创建，
+    // 就绪信号到达后再补充暴露，主菜单界面不依赖它们
     m_engine.rootContext()->setContextProperty("gameEngine", m_gameEngine.get());
-    m_engine.rootContext()->setContextProperty("inventorySystem", m_gameEngine->getInventorySystem());
     m_engine.rootContext()->setContextProperty("player", m_gameEngine->getPlayer());
     m_engine.rootContext()->setContextProperty("gameState", m_gameEngine->getGameState());
-    m_engine.rootContext()->setContextProperty("battleSystem", m_gameEngine->getBattleSystem());  
-    
+    // LazyPanel经sceneManager的UI预热信号在空闲帧延迟实例化
+    m_engine.rootContext()->setContextProperty("sceneManager", m_sceneManager.get());
+    // 设置界面读写持久化配置（特效细节层级覆盖等）
+    m_engine.rootContext()->setContextProperty("gameConfig", m_gameConfig.get());
+
+    auto exposeDeferredSystems = [this]() {
+        m_engine.rootContext()->setContextProperty("inventorySystem", m_gameEngine->getInventorySystem());
+        m_engine.rootContext()->setContextProperty("battleSystem", m_gameEngine->getBattleSystem());
+    };
+    if (m_gameEngine->areGameSystemsReady()) {
+        exposeDeferredSystems();
+    } else {
+        connect(m_gameEngine.get(), &GameEngine::gameSystemsReady,
+                this, exposeDeferredSystems);
+    }
+
+    // 音频线程与gRPC通道的建立不阻塞首屏，推迟到
+    // 事件循环空闲时在后台完成；这是启动序列的最后一环，
+    // 完成后输出启动剖析报告
+    QTimer::singleShot(0, this, [this]() {
+        {
+            StartupPhase phase(QStringLiteral("audio_init"));
+            if (m_audioManager) {
+                m_audioManager->initialize();
+            }
+        }
+        {
+            StartupPhase phase(QStringLiteral("network_connect"));
+            if (m_networkManager) {
+                m_networkManager->initialize();
+            }
+        }
+        StartupProfiler::instance()->finish();
+    });
+
+    // 组件对象池：高频开关的组件预实例化后直接复用
+    m_componentPool = std::make_unique<QmlComponentPool>(&m_engine);
+    m_engine.rootContext()->setContextProperty("componentPool", m_componentPool.get());
+
     // 加载主QML文件
-    const QUrl url(QStringLiteral("qrc:/GameUI/qml/main.qml"));
-    m_engine.load(url);
-    
-    // 检查QML是否加载成功
-    if (m_engine.rootObjects().isEmpty()) {
-        qCritical() << "GameApplication: QML文件加载失败";
+    {
+        StartupPhase phase(QStringLiteral("qml_load"));
+        const QUrl url(QStringLiteral("qrc:/GameUI/qml/main.qml"));
+        m_engine.load(url);
+
+        // 检查QML是否加载成功
+        if (m_engine.rootObjects().isEmpty()) {
+            qCritical() << "GameApplication: QML文件加载失败";
+        }
     }
+
+    // 首屏出来后空闲时预热批量列表项组件，
+    // 打开背包/战斗界面时不再编译和分配
+    QTimer::singleShot(0, this, [this]() {
+        m_componentPool->preload(QStringLiteral("qrc:/GameUI/qml/components/ItemSlot.qml"), 16);
+        m_componentPool->preload(QStringLiteral("qrc:/GameUI/qml/components/EnemyCard.qml"), 4);
+        m_componentPool->preload(QStringLiteral("qrc:/GameUI/qml/components/SkillSlot.qml"), 8);
+    });
 }
 
 /**
@@ -133,6 +207,26 @@ void GameApplication::start()
  * 
  * 执行优雅关闭流程，保存状态并清理资源。
  */
+/**
+ * @brief 无头战斗回放实现
+ *
+ * 不加载QML界面，同步初始化网络管理器（回放不经网络，但
+ * 战斗系统要求客户端对象就绪）后委托游戏引擎执行回放。
+ */
+bool GameApplication::runBattleReplay(const QString &filePath)
+{
+    if (!m_isInitialized) {
+        qCritical() << "GameApplication: 未初始化，无法回放";
+        return false;
+    }
+
+    if (m_networkManager) {
+        m_networkManager->initialize();
+    }
+
+    return m_gameEngine && m_gameEngine->runBattleReplay(filePath);
+}
+
 void GameApplication::shutdown()
 {
     // 1. 停止游戏引擎
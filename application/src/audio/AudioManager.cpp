@@ -32,7 +32,9 @@
 #include "audio/AudioManager.h"
 #include "config/ConfigManager.h"
 #include <QDebug>
-#include <QTimer>
+#include <QHash>
+#include <QThread>
+#include <utility>
 
 /**
  * @brief 构造函数
@@ -42,6 +44,8 @@
  */
 AudioManager::AudioManager(QObject *parent)
     : QObject(parent)
+    , m_audioThread(nullptr)        // 音频线程在initialize中创建
+    , m_audioWorker(nullptr)        // 工作对象随线程创建
     , m_isInitialized(false)       // 初始化状态标志
     , m_masterVolume(1.0f)          // 主音量 (0.0-1.0)
     , m_musicVolume(0.7f)           // 音乐音量 (0.0-1.0)
@@ -95,7 +99,15 @@ bool AudioManager::initialize()
         
         // 应用初始音量设置
         applyVolumeSettings();
-        
+
+        // 只预解码所有场景共享的核心音效集；场景独有音效
+        // 由场景切换时的差量加载补齐，不再启动期全量加载
+        const QStringList core = coreAudioSet();
+        for (const QString &file : core) {
+            preloadAudio(file);
+            m_residentAudio.insert(file);
+        }
+
         m_isInitialized = true;
         qDebug() << "AudioManager: 音频系统初始化成功";
         return true;
@@ -126,29 +138,40 @@ bool AudioManager::checkAudioDeviceAvailability()
 
 /**
  * @brief 初始化音频播放器
- * 
- * 创建和配置不同类型的音频播放器：
- * - 背景音乐播放器（支持循环播放）
- * - 音效播放器池（支持同时播放多个音效）
- * - 语音播放器（预留）
+ *
+ * 创建命令队列和专用音频线程，把AudioWorker移入其中：
+ * - 播放器在QThread::started后于音频线程上创建
+ * - 播放完成事件通过跨线程信号回传
+ * - 主线程此后只向队列提交命令
  */
 void AudioManager::initializeAudioPlayers()
 {
-    qDebug() << "AudioManager: 初始化音频播放器";
+    qDebug() << "AudioManager: 初始化音频线程";
+
+    m_commandQueue = std::make_unique<AudioCommandQueue>();
 
-    // 创建背景音乐播放器
-    m_audioOutput = std::make_unique<QAudioOutput>(this);
-    m_musicPlayer = std::make_unique<QMediaPlayer>(this);
-    m_musicPlayer->setAudioOutput(m_audioOutput.get());
+    // 工作对象不能有父对象，否则无法moveToThread
+    m_audioWorker = new AudioWorker(m_commandQueue.get());
+    m_audioThread = new QThread(this);
+    m_audioThread->setObjectName(QStringLiteral("AudioThread"));
+    m_audioWorker->moveToThread(m_audioThread);
 
-    // 连接播放状态变更信号
-    connect(m_musicPlayer.get(), &QMediaPlayer::playbackStateChanged,
-            this, &AudioManager::onMediaPlayerStateChanged);
+    // 播放器必须在音频线程上创建，保证线程亲和性
+    connect(m_audioThread, &QThread::started,
+            m_audioWorker, &AudioWorker::initializeOnThread);
+
+    // 播放完成事件跨线程回传（自动队列连接）
+    connect(m_audioWorker, &AudioWorker::musicFinished,
+            this, &AudioManager::onWorkerMusicFinished);
+    connect(m_audioWorker, &AudioWorker::effectFinished,
+            this, &AudioManager::effectFinished);
+
+    m_audioThread->start();
 
     // 初始化音效ID计数器
     m_nextEffectId = 1;
 
-    qDebug() << "AudioManager: 音频播放器初始化完成";
+    qDebug() << "AudioManager: 音频线程启动完成";
 }
 
 /**
@@ -193,29 +216,19 @@ void AudioManager::loadAudioSettings()
 
 /**
  * @brief 应用音量设置到音频系统
- * 
- * 将当前的音量设置应用到所有音频播放器
+ *
+ * 把当前的音量快照打包成一条SetVolumes命令发给音频线程，
+ * 由AudioWorker应用到它持有的所有播放器。
  */
 void AudioManager::applyVolumeSettings()
 {
-    qDebug() << "AudioManager: 应用音量设置到音频系统";
-
-    // 应用到背景音乐播放器
-    if (m_audioOutput) {
-        float effectiveVolume = m_isMuted ? 0.0f : (m_masterVolume * m_musicVolume);
-        m_audioOutput->setVolume(effectiveVolume);
-    }
-
-    // 应用到音效播放器
-    float sfxEffectiveVolume = m_isMuted ? 0.0f : (m_masterVolume * m_sfxVolume);
-    for (auto &effect : m_effectPlayers) {
-        effect->setVolume(sfxEffectiveVolume);
-    }
-    for (auto &effect : m_preloadedEffects) {
-        effect->setVolume(sfxEffectiveVolume);
-    }
-
-    qDebug() << "AudioManager: 音量设置应用完成";
+    AudioCommand command;
+    command.type = AudioCommand::Type::SetVolumes;
+    command.volume = m_masterVolume;
+    command.musicVolume = m_musicVolume;
+    command.sfxVolume = m_sfxVolume;
+    command.flag = m_isMuted;
+    enqueueCommand(command);
 }
 
 /**
@@ -265,11 +278,8 @@ void AudioManager::setMusicVolume(float volume)
     
     m_musicVolume = newVolume;
 
-    // 应用到音乐播放器
-    if (m_audioOutput) {
-        float effectiveVolume = m_isMuted ? 0.0f : (m_masterVolume * m_musicVolume);
-        m_audioOutput->setVolume(effectiveVolume);
-    }
+    // 推送音量快照到音频线程
+    applyVolumeSettings();
 
     emit musicVolumeChanged(m_musicVolume);
     qDebug() << "AudioManager: 音乐音量设置完成";
@@ -293,14 +303,8 @@ void AudioManager::setSFXVolume(float volume)
     
     m_sfxVolume = newVolume;
 
-    // 应用到音效播放器
-    float effectiveVolume = m_isMuted ? 0.0f : (m_masterVolume * m_sfxVolume);
-    for (auto &effect : m_effectPlayers) {
-        effect->setVolume(effectiveVolume);
-    }
-    for (auto &effect : m_preloadedEffects) {
-        effect->setVolume(effectiveVolume);
-    }
+    // 推送音量快照到音频线程
+    applyVolumeSettings();
 
     emit sfxVolumeChanged(m_sfxVolume);
     qDebug() << "AudioManager: 音效音量设置完成";
@@ -331,44 +335,38 @@ void AudioManager::setMuted(bool muted)
 
 /**
  * @brief 关闭音频管理器
- * 
+ *
  * 执行完整的音频系统关闭流程：
- * 1. 停止所有正在播放的音频
- * 2. 释放音频播放器资源
- * 3. 断开所有信号连接
- * 4. 重置状态变量
+ * 1. 在音频线程上停止并释放所有播放器（阻塞等待完成）
+ * 2. 退出并回收音频线程
+ * 3. 重置状态变量
  */
 void AudioManager::shutdown()
 {
     qDebug() << "AudioManager: 开始关闭音频系统";
-    
+
     if (!m_isInitialized) {
         qDebug() << "AudioManager: 音频系统未初始化，跳过关闭流程";
         return;
     }
-    
-    // 停止所有音频播放
-    if (m_musicPlayer) {
-        m_musicPlayer->stop();
-    }
 
-    // 停止所有音效
-    for (auto *effect : m_effectPlayers) {
-        effect->stop();
+    // 播放器必须在它们所属的音频线程上销毁
+    if (m_audioWorker && m_audioThread && m_audioThread->isRunning()) {
+        QMetaObject::invokeMethod(m_audioWorker, &AudioWorker::shutdownOnThread,
+                                  Qt::BlockingQueuedConnection);
     }
-    qDeleteAll(m_effectPlayers);
-    m_effectPlayers.clear();
 
-    // 清理预加载音效
-    for (auto *effect : m_preloadedEffects) {
-        effect->stop();
+    if (m_audioThread) {
+        m_audioThread->quit();
+        m_audioThread->wait();
     }
-    qDeleteAll(m_preloadedEffects);
-    m_preloadedEffects.clear();
 
-    // 释放播放器资源
-    m_musicPlayer.reset();
-    m_audioOutput.reset();
+    delete m_audioWorker;
+    m_audioWorker = nullptr;
+    m_audioThread = nullptr; // 父对象是this，由对象树回收
+    m_commandQueue.reset();
+
+    m_currentMusic.clear();
 
     // 重置状态
     m_isInitialized = false;
@@ -399,11 +397,43 @@ void AudioManager::playMusic(const QString &musicFile, bool loop, bool fadeIn)
     m_currentMusic = musicFile;
     emit currentMusicChanged();
 
-    if (m_musicPlayer) {
-        m_musicPlayer->setSource(QUrl::fromLocalFile(musicFile));
-        m_musicPlayer->setLoops(loop ? QMediaPlayer::Infinite : 1);
-        m_musicPlayer->play();
+    AudioCommand command;
+    command.type = AudioCommand::Type::PlayMusic;
+    command.file = musicFile;
+    command.flag = loop;
+    enqueueCommand(command);
+}
+
+void AudioManager::crossfadeToMusic(const QString &musicFile, int fadeMs, bool loop)
+{
+    if (!m_isInitialized) {
+        qWarning() << "AudioManager: 未初始化，无法播放音乐";
+        return;
+    }
+
+    qDebug() << "AudioManager: 交叉淡入背景音乐:" << musicFile << "时长" << fadeMs;
+    m_currentMusic = musicFile;
+    emit currentMusicChanged();
+
+    AudioCommand command;
+    command.type = AudioCommand::Type::CrossfadeMusic;
+    command.file = musicFile;
+    command.flag = loop;
+    command.durationMs = fadeMs;
+    enqueueCommand(command);
+}
+
+void AudioManager::primeMusic(const QString &musicFile)
+{
+    if (!m_isInitialized) {
+        return;
     }
+
+    qDebug() << "AudioManager: 预热背景音乐:" << musicFile;
+    AudioCommand command;
+    command.type = AudioCommand::Type::PrimeMusic;
+    command.file = musicFile;
+    enqueueCommand(command);
 }
 
 void AudioManager::stopMusic(bool fadeOut)
@@ -414,25 +444,25 @@ void AudioManager::stopMusic(bool fadeOut)
     m_currentMusic.clear();
     emit currentMusicChanged();
 
-    if (m_musicPlayer) {
-        m_musicPlayer->stop();
-    }
+    AudioCommand command;
+    command.type = AudioCommand::Type::StopMusic;
+    enqueueCommand(command);
 }
 
 void AudioManager::pauseMusic()
 {
     qDebug() << "AudioManager: 暂停背景音乐";
-    if (m_musicPlayer) {
-        m_musicPlayer->pause();
-    }
+    AudioCommand command;
+    command.type = AudioCommand::Type::PauseMusic;
+    enqueueCommand(command);
 }
 
 void AudioManager::resumeMusic()
 {
     qDebug() << "AudioManager: 恢复背景音乐";
-    if (m_musicPlayer) {
-        m_musicPlayer->play();
-    }
+    AudioCommand command;
+    command.type = AudioCommand::Type::ResumeMusic;
+    enqueueCommand(command);
 }
 
 int AudioManager::playEffect(const QString &effectFile, float volume)
@@ -444,108 +474,171 @@ int AudioManager::playEffect(const QString &effectFile, float volume)
 
     int effectId = generateEffectId();
 
-    qDebug() << "AudioManager: 播放音效:" << effectFile << "ID:" << effectId;
-
-    float actualVolume = (volume < 0) ? calculateActualVolume(AudioType::SoundEffect) : volume;
-
-    // 检查并发数限制
-    if (m_effectPlayers.size() >= MAX_CONCURRENT_EFFECTS) {
-        qWarning() << "AudioManager: 音效并发数已达上限:" << MAX_CONCURRENT_EFFECTS;
-        return -1;
-    }
-
-    // 创建 QSoundEffect 并播放
-    QSoundEffect* effect = new QSoundEffect(this);
-    effect->setSource(QUrl::fromLocalFile(effectFile));
-    effect->setVolume(actualVolume);
-    effect->play();
-
-    // 播放完毕自动清理
-    int capturedId = effectId;
-    connect(effect, &QSoundEffect::playingChanged, this, [this, capturedId]() {
-        auto it = m_effectPlayers.find(capturedId);
-        if (it != m_effectPlayers.end() && !(*it)->isPlaying()) {
-            (*it)->deleteLater();
-            m_effectPlayers.erase(it);
-            emit effectFinished(capturedId);
-        }
-    });
-
-    m_effectPlayers[effectId] = effect;
+    // 主线程只分配ID并入队，解码与播放都在音频线程上进行
+    AudioCommand command;
+    command.type = AudioCommand::Type::PlayEffect;
+    command.effectId = effectId;
+    command.file = effectFile;
+    command.volume = (volume < 0) ? calculateActualVolume(AudioType::SoundEffect)
+                                  : volume;
+    enqueueCommand(command);
 
     return effectId;
 }
 
 void AudioManager::stopEffect(int effectId)
 {
-    auto it = m_effectPlayers.find(effectId);
-    if (it != m_effectPlayers.end()) {
-        (*it)->stop();
-        (*it)->deleteLater();
-        m_effectPlayers.erase(it);
-        qDebug() << "AudioManager: 停止音效 ID:" << effectId;
-    }
+    qDebug() << "AudioManager: 停止音效 ID:" << effectId;
+    AudioCommand command;
+    command.type = AudioCommand::Type::StopEffect;
+    command.effectId = effectId;
+    enqueueCommand(command);
 }
 
 void AudioManager::stopAllEffects()
 {
-    for (auto *effect : m_effectPlayers) {
-        effect->stop();
-    }
-    qDeleteAll(m_effectPlayers);
-    m_effectPlayers.clear();
     qDebug() << "AudioManager: 停止所有音效";
+    AudioCommand command;
+    command.type = AudioCommand::Type::StopAllEffects;
+    enqueueCommand(command);
 }
 
 void AudioManager::playUISound(const QString &uiSound)
 {
     qDebug() << "AudioManager: 播放UI音效:" << uiSound;
 
-    // UI 音效使用预加载的缓存
-    if (m_preloadedEffects.contains(uiSound)) {
-        float vol = calculateActualVolume(AudioType::UI);
-        m_preloadedEffects[uiSound]->setVolume(vol);
-        m_preloadedEffects[uiSound]->play();
-    } else {
-        // 如果未预加载，直接播放
-        playEffect(uiSound);
-    }
+    // AudioWorker会优先复用预解码缓存，未预加载时现场创建
+    AudioCommand command;
+    command.type = AudioCommand::Type::PlayEffect;
+    command.effectId = generateEffectId();
+    command.file = uiSound;
+    command.volume = calculateActualVolume(AudioType::UI);
+    enqueueCommand(command);
 }
 
 void AudioManager::preloadAudio(const QString &audioFile)
 {
-    if (m_preloadedEffects.contains(audioFile)) {
-        return;
-    }
-
     qDebug() << "AudioManager: 预加载音频:" << audioFile;
 
-    QSoundEffect* effect = new QSoundEffect(this);
-    effect->setSource(QUrl::fromLocalFile(audioFile));
-    m_preloadedEffects[audioFile] = effect;
+    AudioCommand command;
+    command.type = AudioCommand::Type::Preload;
+    command.file = audioFile;
+    enqueueCommand(command);
 }
 
 void AudioManager::unloadAudio(const QString &audioFile)
 {
-    auto it = m_preloadedEffects.find(audioFile);
-    if (it != m_preloadedEffects.end()) {
-        delete *it;
-        m_preloadedEffects.erase(it);
-        qDebug() << "AudioManager: 卸载音频:" << audioFile;
+    qDebug() << "AudioManager: 卸载音频:" << audioFile;
+
+    AudioCommand command;
+    command.type = AudioCommand::Type::Unload;
+    command.file = audioFile;
+    enqueueCommand(command);
+}
+
+QStringList AudioManager::coreAudioSet()
+{
+    // 所有场景共享的界面音效：常驻内存，不随场景切换卸载
+    static const QStringList core = {
+        QStringLiteral("resources/sounds/ui/click.wav"),
+        QStringLiteral("resources/sounds/ui/hover.wav"),
+        QStringLiteral("resources/sounds/ui/back.wav"),
+        QStringLiteral("resources/sounds/ui/error.wav"),
+    };
+    return core;
+}
+
+QStringList AudioManager::sceneAudioManifest(const QString &sceneName)
+{
+    // 场景音频清单：每个场景独有的音效集，切换时按差量
+    // 加载/卸载；未列出的场景只保留核心集
+    static const QHash<QString, QStringList> manifests = {
+        { QStringLiteral("MainMenu"),
+          { QStringLiteral("resources/sounds/ui/menu_open.wav") } },
+        { QStringLiteral("Gameplay"),
+          { QStringLiteral("resources/sounds/world/footstep.wav"),
+            QStringLiteral("resources/sounds/world/item_pickup.wav"),
+            QStringLiteral("resources/sounds/world/quest_update.wav") } },
+        { QStringLiteral("Battle"),
+          { QStringLiteral("resources/sounds/battle/sword_hit.wav"),
+            QStringLiteral("resources/sounds/battle/spell_cast.wav"),
+            QStringLiteral("resources/sounds/battle/critical.wav"),
+            QStringLiteral("resources/sounds/battle/victory.wav"),
+            QStringLiteral("resources/sounds/battle/defeat.wav") } },
+        { QStringLiteral("Inventory"),
+          { QStringLiteral("resources/sounds/ui/item_move.wav"),
+            QStringLiteral("resources/sounds/ui/equip.wav") } },
+    };
+    return manifests.value(sceneName);
+}
+
+void AudioManager::applySceneAudio(const QString &sceneName)
+{
+    // 目标常驻集 = 核心集 ∪ 场景清单
+    QSet<QString> next;
+    const QStringList core = coreAudioSet();
+    for (const QString &file : core) {
+        next.insert(file);
+    }
+    const QStringList manifest = sceneAudioManifest(sceneName);
+    for (const QString &file : manifest) {
+        next.insert(file);
+    }
+
+    int unloaded = 0;
+    int loaded = 0;
+
+    // 仅旧场景用到的音效卸载释放内存
+    for (const QString &file : std::as_const(m_residentAudio)) {
+        if (!next.contains(file)) {
+            unloadAudio(file);
+            ++unloaded;
+        }
+    }
+
+    // 仅新场景用到的入队预解码，解码在音频线程后台进行，
+    // 与转场动画重叠；两个场景共用的音效保持常驻不动
+    for (const QString &file : std::as_const(next)) {
+        if (!m_residentAudio.contains(file)) {
+            preloadAudio(file);
+            ++loaded;
+        }
     }
+
+    m_residentAudio = next;
+    qDebug() << "AudioManager: 场景音频差量切换:" << sceneName
+             << "加载" << loaded << "卸载" << unloaded;
 }
 
-void AudioManager::onMediaPlayerStateChanged(QMediaPlayer::PlaybackState state)
+void AudioManager::onWorkerMusicFinished(const QString &musicFile)
 {
-    if (state == QMediaPlayer::StoppedState && !m_currentMusic.isEmpty()) {
-        emit musicFinished(m_currentMusic);
+    // 只处理自然播放结束；stopMusic已提前清空了当前音乐
+    if (m_currentMusic == musicFile) {
+        m_currentMusic.clear();
+        emit currentMusicChanged();
     }
+    emit musicFinished(musicFile);
 }
 
-void AudioManager::onAudioOutputChanged()
+/**
+ * @brief 向音频线程提交命令
+ *
+ * 无锁入队后通过队列连接唤醒音频线程的drainCommands。
+ * 队列满（极端突发）时丢弃该命令并告警，不阻塞主线程。
+ */
+void AudioManager::enqueueCommand(const AudioCommand &command)
 {
-    qDebug() << "AudioManager: 音频输出设备改变";
-    applyVolumeSettings();
+    if (!m_commandQueue || !m_audioWorker) {
+        return;
+    }
+
+    if (!m_commandQueue->tryEnqueue(command)) {
+        qWarning() << "AudioManager: 音频命令队列已满，命令被丢弃";
+        return;
+    }
+
+    QMetaObject::invokeMethod(m_audioWorker, &AudioWorker::drainCommands,
+                              Qt::QueuedConnection);
 }
 
 float AudioManager::calculateActualVolume(AudioType type) const
@@ -0,0 +1,351 @@
+/*
+ * 文件名: AudioWorker.cpp
+ * 说明: 音频线程工作对象的实现。
+ * 作者: 彭承康
+ * 创建时间: 2026-08-28
+ */
+
+#include "audio/AudioWorker.h"
+#include "utils/MemoryTelemetry.h"
+
+#include <QAudioOutput>
+#include <QDebug>
+#include <QFileInfo>
+#include <QMediaPlayer>
+#include <QSoundEffect>
+#include <QTimer>
+#include <QUrl>
+
+AudioWorker::AudioWorker(AudioCommandQueue *queue, QObject *parent)
+    : QObject(parent)
+    , m_queue(queue)
+{
+}
+
+AudioWorker::~AudioWorker() = default;
+
+void AudioWorker::initializeOnThread()
+{
+    // 在音频线程上创建播放器，保证线程亲和性正确；
+    // 两个音乐声道都是流式解码，内存只占各自的读取缓冲
+    for (int deck = 0; deck < 2; ++deck) {
+        m_musicDecks[deck].output = std::make_unique<QAudioOutput>(this);
+        m_musicDecks[deck].player = std::make_unique<QMediaPlayer>(this);
+        m_musicDecks[deck].player->setAudioOutput(m_musicDecks[deck].output.get());
+
+        connect(m_musicDecks[deck].player.get(), &QMediaPlayer::playbackStateChanged,
+                this, [this, deck](QMediaPlayer::PlaybackState state) {
+            // 只有活跃声道自然停止才算音乐结束；淡出中的旧声道不算
+            if (state == QMediaPlayer::StoppedState && deck == m_activeDeck &&
+                !m_currentMusic.isEmpty()) {
+                emit musicFinished(m_currentMusic);
+            }
+        });
+    }
+
+    m_fadeTimer = new QTimer(this);
+    m_fadeTimer->setInterval(FADE_TICK_MS);
+    connect(m_fadeTimer, &QTimer::timeout, this, &AudioWorker::tickCrossfade);
+
+    qDebug() << "AudioWorker: 音频线程播放器初始化完成";
+}
+
+void AudioWorker::shutdownOnThread()
+{
+    if (m_fadeTimer) {
+        m_fadeTimer->stop();
+    }
+    for (MusicDeck &deck : m_musicDecks) {
+        if (deck.player) {
+            deck.player->stop();
+        }
+    }
+
+    for (auto *effect : m_effectPlayers) {
+        effect->stop();
+    }
+    qDeleteAll(m_effectPlayers);
+    m_effectPlayers.clear();
+
+    for (auto *effect : m_preloadedEffects) {
+        effect->stop();
+    }
+    qDeleteAll(m_preloadedEffects);
+    m_preloadedEffects.clear();
+
+    for (MusicDeck &deck : m_musicDecks) {
+        deck.player.reset();
+        deck.output.reset();
+    }
+
+    qDebug() << "AudioWorker: 音频线程播放器已释放";
+}
+
+void AudioWorker::drainCommands()
+{
+    AudioCommand command;
+    while (m_queue->tryDequeue(command)) {
+        execute(command);
+    }
+}
+
+void AudioWorker::execute(const AudioCommand &command)
+{
+    switch (command.type) {
+    case AudioCommand::Type::PlayMusic: {
+        // 进行中的淡入立即完成，再切曲
+        finishCrossfade();
+        m_currentMusic = command.file;
+        if (!m_musicDecks[m_activeDeck].player) {
+            break;
+        }
+        if (m_primedMusic == command.file) {
+            // 预热命中：备用声道已缓冲开头，切为活跃声道即起播
+            m_musicDecks[m_activeDeck].player->stop();
+            m_activeDeck = 1 - m_activeDeck;
+            m_primedMusic.clear();
+        } else {
+            m_musicDecks[m_activeDeck].player->setSource(
+                QUrl::fromLocalFile(command.file));
+        }
+        m_musicDecks[m_activeDeck].output->setVolume(musicVolume());
+        m_musicDecks[m_activeDeck].player->setLoops(
+            command.flag ? QMediaPlayer::Infinite : 1);
+        m_musicDecks[m_activeDeck].player->play();
+        break;
+    }
+
+    case AudioCommand::Type::StopMusic:
+        finishCrossfade();
+        m_currentMusic.clear();
+        if (m_musicDecks[m_activeDeck].player) {
+            m_musicDecks[m_activeDeck].player->stop();
+        }
+        break;
+
+    case AudioCommand::Type::PauseMusic:
+        if (m_musicDecks[m_activeDeck].player) {
+            m_musicDecks[m_activeDeck].player->pause();
+        }
+        break;
+
+    case AudioCommand::Type::ResumeMusic:
+        if (m_musicDecks[m_activeDeck].player) {
+            m_musicDecks[m_activeDeck].player->play();
+        }
+        break;
+
+    case AudioCommand::Type::CrossfadeMusic:
+        startCrossfade(command.file, command.flag, command.durationMs);
+        break;
+
+    case AudioCommand::Type::PrimeMusic: {
+        // 备用声道设置源并暂停：解码器预读开头几秒，之后的
+        // PlayMusic/CrossfadeMusic即起播，场景进入不再等IO
+        QMediaPlayer *standby = m_musicDecks[1 - m_activeDeck].player.get();
+        if (standby && m_primedMusic != command.file) {
+            standby->setSource(QUrl::fromLocalFile(command.file));
+            standby->pause();
+            m_primedMusic = command.file;
+        }
+        break;
+    }
+
+    case AudioCommand::Type::PlayEffect:
+        playEffect(command);
+        break;
+
+    case AudioCommand::Type::StopEffect: {
+        auto it = m_effectPlayers.find(command.effectId);
+        if (it != m_effectPlayers.end()) {
+            (*it)->stop();
+            if (!m_preloadedEffects.contains((*it)->source().toLocalFile())) {
+                (*it)->deleteLater();
+            }
+            m_effectPlayers.erase(it);
+        }
+        break;
+    }
+
+    case AudioCommand::Type::StopAllEffects:
+        for (auto it = m_effectPlayers.begin(); it != m_effectPlayers.end(); ++it) {
+            (*it)->stop();
+            if (!m_preloadedEffects.contains((*it)->source().toLocalFile())) {
+                (*it)->deleteLater();
+            }
+        }
+        m_effectPlayers.clear();
+        break;
+
+    case AudioCommand::Type::Preload:
+        if (!m_preloadedEffects.contains(command.file)) {
+            // QSoundEffect设置源后把整段音效解码进内存，播放零IO
+            auto *effect = new QSoundEffect(this);
+            effect->setSource(QUrl::fromLocalFile(command.file));
+
+            // 缓存的播放器复用，完成回调只在预加载时连接一次
+            connect(effect, &QSoundEffect::playingChanged, this, [this, effect]() {
+                if (effect->isPlaying()) {
+                    return;
+                }
+                for (auto it = m_effectPlayers.begin();
+                     it != m_effectPlayers.end(); ++it) {
+                    if (it.value() == effect) {
+                        const int finishedId = it.key();
+                        m_effectPlayers.erase(it);
+                        emit effectFinished(finishedId);
+                        break;
+                    }
+                }
+            });
+
+            m_preloadedEffects.insert(command.file, effect);
+
+            // 解码后大小不可见，以源文件大小为下界归入audio子系统
+            MemoryTelemetry::instance()->recordAlloc(
+                MemoryTelemetry::Subsystem::Audio,
+                QFileInfo(command.file).size());
+        }
+        break;
+
+    case AudioCommand::Type::Unload: {
+        auto it = m_preloadedEffects.find(command.file);
+        if (it != m_preloadedEffects.end()) {
+            delete *it;
+            m_preloadedEffects.erase(it);
+            MemoryTelemetry::instance()->recordFree(
+                MemoryTelemetry::Subsystem::Audio,
+                QFileInfo(command.file).size());
+        }
+        break;
+    }
+
+    case AudioCommand::Type::SetVolumes:
+        m_masterVolume = command.volume;
+        m_musicVolume = command.musicVolume;
+        m_sfxVolume = command.sfxVolume;
+        m_isMuted = command.flag;
+        applyVolumes();
+        break;
+
+    case AudioCommand::Type::None:
+        break;
+    }
+}
+
+void AudioWorker::playEffect(const AudioCommand &command)
+{
+    if (m_effectPlayers.size() >= MAX_CONCURRENT_EFFECTS) {
+        qWarning() << "AudioWorker: 音效并发数已达上限:" << MAX_CONCURRENT_EFFECTS;
+        emit effectFinished(command.effectId);
+        return;
+    }
+
+    const float sfxVolume = m_isMuted ? 0.0f : (m_masterVolume * m_sfxVolume);
+    const float actualVolume = (command.volume < 0) ? sfxVolume : command.volume;
+
+    // 预解码缓存命中时直接复用，播放不再有解码开销
+    QSoundEffect *effect = m_preloadedEffects.value(command.file, nullptr);
+    const bool fromCache = (effect != nullptr);
+    if (!effect) {
+        effect = new QSoundEffect(this);
+        effect->setSource(QUrl::fromLocalFile(command.file));
+    }
+
+    effect->setVolume(actualVolume);
+    effect->play();
+
+    const int effectId = command.effectId;
+    connect(effect, &QSoundEffect::playingChanged, this,
+            [this, effectId, effect, fromCache]() {
+        auto it = m_effectPlayers.find(effectId);
+        if (it != m_effectPlayers.end() && !effect->isPlaying()) {
+            m_effectPlayers.erase(it);
+            if (!fromCache) {
+                effect->deleteLater();
+            }
+            emit effectFinished(effectId);
+        }
+    });
+
+    m_effectPlayers.insert(effectId, effect);
+}
+
+void AudioWorker::startCrossfade(const QString &file, bool loop, int durationMs)
+{
+    // 上一次淡入尚未结束时先收尾，保证始终只有一个淡入在进行
+    finishCrossfade();
+
+    MusicDeck &incoming = m_musicDecks[1 - m_activeDeck];
+    if (!incoming.player) {
+        return;
+    }
+
+    // 预热命中时源已缓冲，否则现场设置（流式解码，起播只读开头）
+    if (m_primedMusic != file) {
+        incoming.player->setSource(QUrl::fromLocalFile(file));
+    }
+    m_primedMusic.clear();
+
+    incoming.output->setVolume(0.0f);
+    incoming.player->setLoops(loop ? QMediaPlayer::Infinite : 1);
+    incoming.player->play();
+
+    // 新声道立即成为活跃声道：旧声道只负责淡出，自然停止
+    // 不会触发musicFinished
+    m_activeDeck = 1 - m_activeDeck;
+    m_currentMusic = file;
+
+    m_fadeElapsedMs = 0;
+    m_fadeDurationMs = qMax(durationMs, FADE_TICK_MS);
+    m_fadeTimer->start();
+}
+
+void AudioWorker::tickCrossfade()
+{
+    m_fadeElapsedMs += FADE_TICK_MS;
+    const float progress =
+        qMin(1.0f, static_cast<float>(m_fadeElapsedMs) / m_fadeDurationMs);
+
+    m_musicDecks[m_activeDeck].output->setVolume(musicVolume() * progress);
+    m_musicDecks[1 - m_activeDeck].output->setVolume(
+        musicVolume() * (1.0f - progress));
+
+    if (progress >= 1.0f) {
+        finishCrossfade();
+    }
+}
+
+void AudioWorker::finishCrossfade()
+{
+    if (m_fadeDurationMs == 0) {
+        return;
+    }
+    m_fadeTimer->stop();
+    m_fadeElapsedMs = 0;
+    m_fadeDurationMs = 0;
+
+    // 停掉淡出声道并清空其源，释放解码器的流式读取缓冲
+    MusicDeck &outgoing = m_musicDecks[1 - m_activeDeck];
+    if (outgoing.player) {
+        outgoing.player->stop();
+        outgoing.player->setSource(QUrl());
+    }
+    m_musicDecks[m_activeDeck].output->setVolume(musicVolume());
+}
+
+void AudioWorker::applyVolumes()
+{
+    // 淡入进行中由定时器步进负责音乐音量，这里只处理稳态
+    if (m_fadeDurationMs == 0 && m_musicDecks[m_activeDeck].output) {
+        m_musicDecks[m_activeDeck].output->setVolume(musicVolume());
+    }
+
+    const float sfxVolume = m_isMuted ? 0.0f : (m_masterVolume * m_sfxVolume);
+    for (auto *effect : m_effectPlayers) {
+        effect->setVolume(sfxVolume);
+    }
+    for (auto *effect : m_preloadedEffects) {
+        effect->setVolume(sfxVolume);
+    }
+}
@@ -17,6 +17,9 @@
 #include <QDir>
 #include <QDebug>
 #include <QCoreApplication>
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QFile>
 #include <QMutexLocker>
 #include <QTimer>
 #include <QRegularExpression>
@@ -47,22 +50,26 @@ ConfigManager::ConfigManager(QObject *parent)
     QString configDir = QStandardPaths::writableLocation(QStandardPaths::AppConfigLocation);
     QDir().mkpath(configDir);
     m_configFilePath = configDir + "/game_config.ini";
-    
-    // 创建QSettings对象
-    m_settings = new QSettings(m_configFilePath, QSettings::IniFormat, this);
-    
+    m_cacheFilePath = configDir + "/game_config.cache";
+
     // 初始化默认配置
     initializeDefaults();
-    
-    // 加载现有配置
-    loadConfig();
-    
+
+    // 快路径：二进制缓存命中时直接恢复键值快照，完全跳过ini
+    // 解析，QSettings推迟到首次写入时创建；未命中则走解析路径
+    // 并重建缓存
+    if (loadBinaryCache()) {
+        qDebug() << "ConfigManager: 二进制缓存命中，跳过配置解析";
+    } else {
+        loadConfig();
+    }
+
     // 设置自动保存定时器
     setupAutoSave();
-    
+
     // 验证配置完整性
     validateConfiguration();
-    
+
     qDebug() << "ConfigManager: 初始化完成，配置文件:" << m_configFilePath;
 }
 
@@ -82,48 +89,43 @@ ConfigManager::~ConfigManager()
 QVariant ConfigManager::getValue(const QString &key, const QVariant &defaultValue) const
 {
     QMutexLocker locker(&m_mutex);
-    
-    if (!m_settings) {
-        qWarning() << "ConfigManager: Settings对象为空";
-        return defaultValue;
-    }
-    
-    QVariant value = m_settings->value(key, defaultValue);
-    
+
+    // 读路径只访问内存快照，不触碰QSettings
+    QVariant value = m_values.value(key, defaultValue);
+
     // 验证值的有效性
     if (!validateValue(key, value)) {
         qWarning() << "ConfigManager: 配置值无效，使用默认值:" << key;
         return m_defaults.value(key, defaultValue);
     }
-    
+
     return value;
 }
 
 void ConfigManager::setValue(const QString &key, const QVariant &value)
 {
     QMutexLocker locker(&m_mutex);
-    
-    if (!m_settings) {
-        qWarning() << "ConfigManager: Settings对象为空";
-        return;
-    }
-    
+
     // 验证值的有效性
     if (!validateValue(key, value)) {
         qWarning() << "ConfigManager: 尝试设置无效配置值:" << key << value;
         return;
     }
-    
-    QVariant oldValue = m_settings->value(key);
+
+    QVariant oldValue = m_values.value(key);
     if (oldValue != value) {
+        m_values.insert(key, value);
+
+        // 写路径按需补建QSettings并写穿
+        ensureSettings();
         m_settings->setValue(key, value);
-        
+
         // 标记需要保存
         m_needsSave = true;
-        
+
         // 发送变更信号
         emitConfigChanged(key, value);
-        
+
         qDebug() << "ConfigManager: 配置已更新:" << key << "=" << value;
     }
 }
@@ -131,18 +133,16 @@ void ConfigManager::setValue(const QString &key, const QVariant &value)
 bool ConfigManager::hasKey(const QString &key) const
 {
     QMutexLocker locker(&m_mutex);
-    return m_settings ? m_settings->contains(key) : false;
+    return m_values.contains(key);
 }
 
 void ConfigManager::removeKey(const QString &key)
 {
     QMutexLocker locker(&m_mutex);
-    
-    if (!m_settings) {
-        return;
-    }
-    
-    if (m_settings->contains(key)) {
+
+    if (m_values.contains(key)) {
+        m_values.remove(key);
+        ensureSettings();
         m_settings->remove(key);
         m_needsSave = true;
         emit configChanged(key, QVariant());
@@ -322,34 +322,38 @@ void ConfigManager::setAutoSaveInterval(int minutes)
 bool ConfigManager::loadConfig(const QString &filePath)
 {
     QMutexLocker locker(&m_mutex);
-    
+
     if (!filePath.isEmpty()) {
         m_configFilePath = filePath;
         delete m_settings;
         m_settings = new QSettings(m_configFilePath, QSettings::IniFormat, this);
     }
-    
-    if (!m_settings) {
-        qCritical() << "ConfigManager: 无法创建Settings对象";
-        return false;
-    }
-    
+
+    ensureSettings();
+
     // 检查配置文件是否存在
     QFile configFile(m_configFilePath);
     if (!configFile.exists()) {
         qDebug() << "ConfigManager: 配置文件不存在，将创建默认配置";
         createDefaultConfig();
+        refreshValuesFromSettings();
+        writeBinaryCache();
         return true;
     }
-    
+
     // 同步设置
     m_settings->sync();
-    
-    // 验证配置完整性
+
+    // 解析完成后刷新内存快照并重建二进制缓存
+    refreshValuesFromSettings();
+    writeBinaryCache();
+
+    // 验证配置完整性（hasKey/setValue自行加锁，先释放）
+    locker.unlock();
     if (!validateConfiguration()) {
         qWarning() << "ConfigManager: 配置验证失败，部分设置将使用默认值";
     }
-    
+
     qDebug() << "ConfigManager: 配置加载完成";
     return true;
 }
@@ -357,25 +361,29 @@ bool ConfigManager::loadConfig(const QString &filePath)
 bool ConfigManager::saveConfig(const QString &filePath)
 {
     QMutexLocker locker(&m_mutex);
-    
-    if (!m_settings) {
-        qCritical() << "ConfigManager: Settings对象为空，无法保存";
-        return false;
+
+    // 缓存命中且从未写入时没有需要落盘的内容
+    if (!m_settings && !m_needsSave) {
+        return true;
     }
-    
+
     if (!filePath.isEmpty()) {
         m_configFilePath = filePath;
     }
-    
+
     // 同步到文件
+    ensureSettings();
     m_settings->sync();
-    
+
     // 检查是否保存成功
     if (m_settings->status() != QSettings::NoError) {
         qCritical() << "ConfigManager: 配置保存失败，状态:" << m_settings->status();
         return false;
     }
-    
+
+    // ini已更新，缓存中的源文件哈希随之重建
+    writeBinaryCache();
+
     m_needsSave = false;
     qDebug() << "ConfigManager: 配置保存完成";
     return true;
@@ -395,10 +403,12 @@ void ConfigManager::resetToDefaults(ConfigGroup group)
     }
     
     // 重置配置值
+    ensureSettings();
     for (const QString& key : keysToReset) {
+        m_values.insert(key, m_defaults[key]);
         m_settings->setValue(key, m_defaults[key]);
     }
-    
+
     m_needsSave = true;
     emit configReset(group);
     
@@ -418,13 +428,9 @@ QString ConfigManager::getConfigFilePath() const
 QStringList ConfigManager::getAllKeys(ConfigGroup group) const
 {
     QMutexLocker locker(&m_mutex);
-    
-    if (!m_settings) {
-        return QStringList();
-    }
-    
-    QStringList keys = m_settings->allKeys();
-    
+
+    QStringList keys = m_values.keys();
+
     if (group != static_cast<ConfigGroup>(-1)) {
         QString prefix = getGroupPrefix(group);
         keys = keys.filter(QRegularExpression("^" + QRegularExpression::escape(prefix)));
@@ -596,19 +602,119 @@ bool ConfigManager::validateValue(const QString &key, const QVariant &value) con
 
 void ConfigManager::createDefaultConfig()
 {
-    QMutexLocker locker(&m_mutex);
-    
     if (!m_settings) {
         return;
     }
-    
+
     // 写入所有默认值
     for (auto it = m_defaults.begin(); it != m_defaults.end(); ++it) {
         m_settings->setValue(it.key(), it.value());
     }
-    
+
     m_settings->sync();
     m_needsSave = false;
-    
+
     qDebug() << "ConfigManager: 默认配置文件已创建";
 }
+
+void ConfigManager::ensureSettings()
+{
+    if (!m_settings) {
+        m_settings = new QSettings(m_configFilePath, QSettings::IniFormat, this);
+    }
+}
+
+void ConfigManager::refreshValuesFromSettings()
+{
+    m_values.clear();
+    const QStringList keys = m_settings->allKeys();
+    for (const QString &key : keys) {
+        m_values.insert(key, m_settings->value(key));
+    }
+}
+
+bool ConfigManager::loadBinaryCache()
+{
+    QFile cacheFile(m_cacheFilePath);
+    if (!cacheFile.exists() || !cacheFile.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    const qint64 size = cacheFile.size();
+    if (size <= 0) {
+        return false;
+    }
+
+    // 内存映射后直接在映射区上反序列化，不做整体拷贝
+    uchar *mapped = cacheFile.map(0, size);
+    if (!mapped) {
+        qWarning() << "ConfigManager: 配置缓存内存映射失败，回退解析";
+        return false;
+    }
+
+    const QByteArray blob = QByteArray::fromRawData(
+        reinterpret_cast<const char *>(mapped), static_cast<qsizetype>(size));
+    QDataStream stream(blob);
+    stream.setVersion(QDataStream::Qt_6_0);
+
+    quint32 magic = 0;
+    quint32 version = 0;
+    QByteArray storedHash;
+    stream >> magic >> version >> storedHash;
+    if (stream.status() != QDataStream::Ok ||
+        magic != CACHE_MAGIC || version != CACHE_FORMAT_VERSION) {
+        qDebug() << "ConfigManager: 配置缓存格式不符，回退解析";
+        return false;
+    }
+
+    // 源文件变化时缓存失效
+    if (storedHash.isEmpty() || storedHash != sourceFileHash()) {
+        qDebug() << "ConfigManager: 配置源文件已变化，缓存失效";
+        return false;
+    }
+
+    QMap<QString, QVariant> values;
+    stream >> values;
+    if (stream.status() != QDataStream::Ok || values.isEmpty()) {
+        qWarning() << "ConfigManager: 配置缓存损坏，回退解析";
+        return false;
+    }
+
+    m_values = values;
+    return true;
+}
+
+void ConfigManager::writeBinaryCache()
+{
+    const QByteArray hash = sourceFileHash();
+    if (hash.isEmpty()) {
+        return;
+    }
+
+    QFile cacheFile(m_cacheFilePath);
+    if (!cacheFile.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qWarning() << "ConfigManager: 无法写入配置缓存:" << m_cacheFilePath;
+        return;
+    }
+
+    QDataStream stream(&cacheFile);
+    stream.setVersion(QDataStream::Qt_6_0);
+    stream << CACHE_MAGIC << CACHE_FORMAT_VERSION << hash << m_values;
+
+    if (stream.status() != QDataStream::Ok) {
+        qWarning() << "ConfigManager: 配置缓存写入失败";
+        cacheFile.remove();
+    }
+}
+
+QByteArray ConfigManager::sourceFileHash() const
+{
+    QFile source(m_configFilePath);
+    if (!source.open(QIODevice::ReadOnly)) {
+        return QByteArray();
+    }
+
+    QCryptographicHash hash(QCryptographicHash::Sha256);
+    hash.addData(&source);
+    return hash.result();
+}
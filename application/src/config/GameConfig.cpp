@@ -23,6 +23,8 @@ GameConfig::GameConfig(QObject *parent)
     , m_fullscreen(false)
     , m_vsync(true)
     , m_showFPS(false)
+    , m_effectLodTier(-1)
+    , m_probedEffectLod(-1)
     , m_language("zh_CN")
 {
     loadConfig();
@@ -72,6 +74,8 @@ bool GameConfig::loadConfig()
     m_fullscreen = graphics["fullscreen"].toBool(false);
     m_vsync = graphics["vsync"].toBool(true);
     m_showFPS = graphics["showFPS"].toBool(false);
+    m_effectLodTier = graphics["effectLodTier"].toInt(-1);
+    m_probedEffectLod = graphics["probedEffectLod"].toInt(-1);
     
     // 加载游戏设置
     QJsonObject game = config["game"].toObject();
@@ -111,6 +115,8 @@ bool GameConfig::saveConfig()
     graphics["fullscreen"] = m_fullscreen;
     graphics["vsync"] = m_vsync;
     graphics["showFPS"] = m_showFPS;
+    graphics["effectLodTier"] = m_effectLodTier;
+    graphics["probedEffectLod"] = m_probedEffectLod;
     config["graphics"] = graphics;
     
     // 保存游戏设置
@@ -172,6 +178,8 @@ float GameConfig::effectVolume() const { return m_effectVolume; }
 bool GameConfig::fullscreen() const { return m_fullscreen; }
 bool GameConfig::vsync() const { return m_vsync; }
 bool GameConfig::showFPS() const { return m_showFPS; }
+int GameConfig::effectLodTier() const { return m_effectLodTier; }
+int GameConfig::probedEffectLod() const { return m_probedEffectLod; }
 QString GameConfig::language() const { return m_language; }
 QMap<QString, int> GameConfig::keyBindings() const { return m_keyBindings; }
 
@@ -218,6 +226,20 @@ void GameConfig::setShowFPS(bool showFPS)
     emit showFPSChanged();
 }
 
+void GameConfig::setEffectLodTier(int tier)
+{
+    // -1表示交给能力探测，其余钳制到有效层级
+    const int clamped = tier < 0 ? -1 : qBound(0, tier, 2);
+    if (m_effectLodTier == clamped) return;
+    m_effectLodTier = clamped;
+    emit effectLodTierChanged();
+}
+
+void GameConfig::setProbedEffectLod(int tier)
+{
+    m_probedEffectLod = qBound(0, tier, 2);
+}
+
 void GameConfig::setLanguage(const QString &language)
 {
     if (m_language == language) return;
@@ -0,0 +1,152 @@
+/*
+ * 文件名: AssetPack.cpp
+ * 说明: FLPK资源包内存映射读取器的实现。
+ * 作者: 彭承康
+ * 创建时间: 2026-08-28
+ */
+
+#include "core/AssetPack.h"
+
+#include <QDebug>
+#include <QtEndian>
+
+#include <cstring>
+
+namespace {
+
+// 文件头固定64字节：magic(4) + version(4) + entryCount(8) +
+// indexOffset(8) + indexSize(8) + 保留，全部小端
+constexpr qint64 HEADER_SIZE = 64;
+constexpr char PACK_MAGIC[4] = { 'F', 'L', 'P', 'K' };
+
+} // namespace
+
+AssetPack::~AssetPack()
+{
+    close();
+}
+
+bool AssetPack::open(const QString &packPath)
+{
+    close();
+
+    m_file.setFileName(packPath);
+    if (!m_file.open(QIODevice::ReadOnly)) {
+        qWarning() << "AssetPack: 资源包打开失败:" << packPath;
+        return false;
+    }
+
+    m_mappedSize = m_file.size();
+    if (m_mappedSize < HEADER_SIZE) {
+        qWarning() << "AssetPack: 资源包过小，不是有效的FLPK文件:" << packPath;
+        close();
+        return false;
+    }
+
+    m_mapped = m_file.map(0, m_mappedSize);
+    if (!m_mapped) {
+        qWarning() << "AssetPack: 资源包内存映射失败:" << packPath;
+        close();
+        return false;
+    }
+
+    if (!parseIndex()) {
+        qWarning() << "AssetPack: 资源包索引损坏:" << packPath;
+        close();
+        return false;
+    }
+
+    qDebug() << "AssetPack: 已挂载" << packPath << "，共" << m_entries.size() << "个条目";
+    return true;
+}
+
+void AssetPack::close()
+{
+    m_entries.clear();
+    m_mapped = nullptr;
+    m_mappedSize = 0;
+    if (m_file.isOpen()) {
+        m_file.close();
+    }
+}
+
+bool AssetPack::parseIndex()
+{
+    const uchar *base = m_mapped;
+
+    if (std::memcmp(base, PACK_MAGIC, sizeof(PACK_MAGIC)) != 0) {
+        return false;
+    }
+
+    const quint32 version = qFromLittleEndian<quint32>(base + 4);
+    if (version != FORMAT_VERSION) {
+        qWarning() << "AssetPack: 不支持的格式版本:" << version;
+        return false;
+    }
+
+    const quint64 entryCount = qFromLittleEndian<quint64>(base + 8);
+    const quint64 indexOffset = qFromLittleEndian<quint64>(base + 16);
+    const quint64 indexSize = qFromLittleEndian<quint64>(base + 24);
+
+    if (indexOffset + indexSize > static_cast<quint64>(m_mappedSize)) {
+        return false;
+    }
+
+    // 索引记录: pathLength(2) + path(UTF-8) + dataOffset(8) +
+    //           storedSize(8) + originalSize(8) + flags(4)
+    const uchar *cursor = base + indexOffset;
+    const uchar *indexEnd = cursor + indexSize;
+    for (quint64 i = 0; i < entryCount; ++i) {
+        if (cursor + 2 > indexEnd) {
+            return false;
+        }
+        const quint16 pathLength = qFromLittleEndian<quint16>(cursor);
+        cursor += 2;
+
+        if (cursor + pathLength + 28 > indexEnd) {
+            return false;
+        }
+        const QString path = QString::fromUtf8(
+            reinterpret_cast<const char *>(cursor), pathLength);
+        cursor += pathLength;
+
+        Entry entry;
+        entry.dataOffset = static_cast<qint64>(qFromLittleEndian<quint64>(cursor));
+        entry.storedSize = static_cast<qint64>(qFromLittleEndian<quint64>(cursor + 8));
+        entry.originalSize = static_cast<qint64>(qFromLittleEndian<quint64>(cursor + 16));
+        entry.flags = qFromLittleEndian<quint32>(cursor + 24);
+        cursor += 28;
+
+        if (entry.dataOffset < 0 || entry.storedSize < 0 ||
+            entry.dataOffset + entry.storedSize > m_mappedSize) {
+            return false;
+        }
+        m_entries.insert(path, entry);
+    }
+
+    return true;
+}
+
+QByteArray AssetPack::read(const QString &path) const
+{
+    auto it = m_entries.constFind(path);
+    if (it == m_entries.constEnd() || !m_mapped) {
+        return QByteArray();
+    }
+
+    const Entry &entry = it.value();
+    const char *data = reinterpret_cast<const char *>(m_mapped) + entry.dataOffset;
+
+    if (entry.flags & FLAG_COMPRESSED) {
+        // 载荷为qCompress格式：4字节大端原始大小 + zlib数据
+        QByteArray decompressed = qUncompress(
+            reinterpret_cast<const uchar *>(data), static_cast<int>(entry.storedSize));
+        if (decompressed.isEmpty() && entry.originalSize > 0) {
+            qWarning() << "AssetPack: 条目解压失败:" << path;
+        }
+        return decompressed;
+    }
+
+    // 未压缩条目零拷贝引用映射内存，生命周期随本对象
+    return QByteArray::fromRawData(data, static_cast<int>(entry.storedSize));
+}
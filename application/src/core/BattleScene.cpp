@@ -5,15 +5,46 @@
  * 创建时间: 2026-02-18
  */
 #include "core/BattleScene.h"
+#include "core/ResourceManager.h"
 #include <QDebug>
 
+namespace {
+
+/**
+ * @brief 战斗场景资源清单
+ *
+ * 入场即用的贴图与音效。场景由SceneManager的预测预热在探索
+ * 阶段后台加载（Gameplay→Battle预测项），战斗入场时这些资源
+ * 已在缓存中，场景切换不再付同步解码成本。
+ */
+const QStringList &battleAssetManifest()
+{
+    static const QStringList assets = {
+        QStringLiteral(":/resources/images/enemies.png"),
+        QStringLiteral(":/resources/images/player.png"),
+        QStringLiteral(":/resources/icons/skill_attack.png"),
+        QStringLiteral(":/resources/icons/skill_heal.png"),
+        QStringLiteral(":/resources/icons/skill_fireball.png"),
+        QStringLiteral(":/resources/icons/skill_default.png"),
+        QStringLiteral(":/resources/sounds/effects.wav"),
+    };
+    return assets;
+}
+
+} // namespace
+
 BattleScene::BattleScene(QObject* parent)
     : Scene("Battle", parent) {
 }
 
 bool BattleScene::load(ResourceManager* resourceManager) {
-    Q_UNUSED(resourceManager)
     qDebug() << "BattleScene: 加载资源";
+
+    // 清单进流式加载队列后台解码；预热路径下战斗开始前即全部
+    // 就绪，直接入战的退化路径下也只是照旧边进边加载
+    if (resourceManager) {
+        resourceManager->preloadResources(battleAssetManifest());
+    }
     return true;
 }
 
@@ -8,12 +8,22 @@
  */
 
 #include "core/EventSystem.h"
+#include "core/FrameAllocator.h"
+#include "core/SyncedClock.h"
+#include "core/TypedEventBus.h"
+#include "utils/FrameProfiler.h"
+#include "sys/GameAssert.h"
 #include <QDebug>
 #include <QDateTime>
+#include <QElapsedTimer>
 #include <algorithm>
+#include <climits>
+#include <utility>
 
 // ==================== GameEvent 实现 ====================
 
+std::atomic<quint64> GameEvent::s_copyCount{0};
+
 GameEvent::GameEvent(Type type, Priority priority)
     : m_type(type)
     , m_priority(priority)
@@ -21,6 +31,150 @@ GameEvent::GameEvent(Type type, Priority priority)
 {
 }
 
+GameEvent::GameEvent(const GameEvent &other)
+    : m_type(other.m_type)
+    , m_priority(other.m_priority)
+    , m_timestamp(other.m_timestamp)
+    , m_paramCount(other.m_paramCount)
+    , m_data(other.m_data)
+{
+    std::copy(std::begin(other.m_params), std::end(other.m_params),
+              std::begin(m_params));
+    s_copyCount.fetch_add(1, std::memory_order_relaxed);
+}
+
+GameEvent& GameEvent::operator=(const GameEvent &other)
+{
+    if (this != &other) {
+        m_type = other.m_type;
+        m_priority = other.m_priority;
+        m_timestamp = other.m_timestamp;
+        std::copy(std::begin(other.m_params), std::end(other.m_params),
+                  std::begin(m_params));
+        m_paramCount = other.m_paramCount;
+        m_data = other.m_data;
+        s_copyCount.fetch_add(1, std::memory_order_relaxed);
+    }
+    return *this;
+}
+
+quint64 GameEvent::copyCount()
+{
+    return s_copyCount.load(std::memory_order_relaxed);
+}
+
+void GameEvent::resetCopyCount()
+{
+    s_copyCount.store(0, std::memory_order_relaxed);
+}
+
+GameEvent::Param* GameEvent::findOrAllocateParam(quint32 key)
+{
+    for (int i = 0; i < m_paramCount; ++i) {
+        if (m_params[i].key == key) {
+            return &m_params[i];
+        }
+    }
+    if (m_paramCount < MAX_INLINE_PARAMS) {
+        Param *param = &m_params[m_paramCount++];
+        param->key = key;
+        return param;
+    }
+    return nullptr;
+}
+
+const GameEvent::Param* GameEvent::findParam(quint32 key) const
+{
+    for (int i = 0; i < m_paramCount; ++i) {
+        if (m_params[i].key == key) {
+            return &m_params[i];
+        }
+    }
+    return nullptr;
+}
+
+void GameEvent::setInt(quint32 key, int value)
+{
+    if (Param *param = findOrAllocateParam(key)) {
+        param->type = ParamType::Int;
+        param->value.i = value;
+    } else {
+        // 内联槽用尽，回退到QVariant冷路径
+        setData(QString::number(key), value);
+    }
+}
+
+void GameEvent::setInt64(quint32 key, qint64 value)
+{
+    if (Param *param = findOrAllocateParam(key)) {
+        param->type = ParamType::Int64;
+        param->value.i64 = value;
+    } else {
+        setData(QString::number(key), value);
+    }
+}
+
+void GameEvent::setFloat(quint32 key, float value)
+{
+    if (Param *param = findOrAllocateParam(key)) {
+        param->type = ParamType::Float;
+        param->value.f = value;
+    } else {
+        setData(QString::number(key), value);
+    }
+}
+
+void GameEvent::setBool(quint32 key, bool value)
+{
+    if (Param *param = findOrAllocateParam(key)) {
+        param->type = ParamType::Bool;
+        param->value.b = value;
+    } else {
+        setData(QString::number(key), value);
+    }
+}
+
+int GameEvent::getInt(quint32 key, int defaultValue) const
+{
+    const Param *param = findParam(key);
+    if (param && param->type == ParamType::Int) {
+        return param->value.i;
+    }
+    return m_data.value(QString::number(key), defaultValue).toInt();
+}
+
+qint64 GameEvent::getInt64(quint32 key, qint64 defaultValue) const
+{
+    const Param *param = findParam(key);
+    if (param && param->type == ParamType::Int64) {
+        return param->value.i64;
+    }
+    return m_data.value(QString::number(key), defaultValue).toLongLong();
+}
+
+float GameEvent::getFloat(quint32 key, float defaultValue) const
+{
+    const Param *param = findParam(key);
+    if (param && param->type == ParamType::Float) {
+        return param->value.f;
+    }
+    return m_data.value(QString::number(key), defaultValue).toFloat();
+}
+
+bool GameEvent::getBool(quint32 key, bool defaultValue) const
+{
+    const Param *param = findParam(key);
+    if (param && param->type == ParamType::Bool) {
+        return param->value.b;
+    }
+    return m_data.value(QString::number(key), defaultValue).toBool();
+}
+
+bool GameEvent::hasParam(quint32 key) const
+{
+    return findParam(key) != nullptr;
+}
+
 void GameEvent::setData(const QString &key, const QVariant &value)
 {
     m_data[key] = value;
@@ -36,12 +190,121 @@ bool GameEvent::hasData(const QString &key) const
     return m_data.contains(key);
 }
 
+// ==================== BoundedEventQueue 实现 ====================
+
+BoundedEventQueue::BoundedEventQueue()
+{
+    // 序列号初始化为槽位下标，表示"空闲，等待第i次入队"
+    for (int i = 0; i < CAPACITY; ++i) {
+        m_cells[static_cast<size_t>(i)].sequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+bool BoundedEventQueue::tryEnqueue(const GameEvent &event)
+{
+    qint64 pos = m_enqueuePos.load(std::memory_order_relaxed);
+    Cell *cell = nullptr;
+
+    for (;;) {
+        cell = &m_cells[static_cast<size_t>(pos & MASK)];
+        const qint64 sequence = cell->sequence.load(std::memory_order_acquire);
+        const qint64 diff = sequence - pos;
+
+        if (diff == 0) {
+            // 槽位空闲：抢占入队位置，失败说明别的生产者抢先，重读即可
+            if (m_enqueuePos.compare_exchange_weak(pos, pos + 1,
+                                                   std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (diff < 0) {
+            // 槽位还没被消费，队列已满
+            return false;
+        } else {
+            pos = m_enqueuePos.load(std::memory_order_relaxed);
+        }
+    }
+
+    cell->event = event;
+    cell->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+}
+
+bool BoundedEventQueue::tryEnqueue(GameEvent &&event)
+{
+    qint64 pos = m_enqueuePos.load(std::memory_order_relaxed);
+    Cell *cell = nullptr;
+
+    for (;;) {
+        cell = &m_cells[static_cast<size_t>(pos & MASK)];
+        const qint64 sequence = cell->sequence.load(std::memory_order_acquire);
+        const qint64 diff = sequence - pos;
+
+        if (diff == 0) {
+            // 槽位空闲：抢占入队位置，失败说明别的生产者抢先，重读即可
+            if (m_enqueuePos.compare_exchange_weak(pos, pos + 1,
+                                                   std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (diff < 0) {
+            // 槽位还没被消费，队列已满；事件未被移动，调用方可兜底
+            return false;
+        } else {
+            pos = m_enqueuePos.load(std::memory_order_relaxed);
+        }
+    }
+
+    cell->event = std::move(event);
+    cell->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+}
+
+bool BoundedEventQueue::tryDequeue(GameEvent &event)
+{
+    qint64 pos = m_dequeuePos.load(std::memory_order_relaxed);
+    Cell *cell = nullptr;
+
+    for (;;) {
+        cell = &m_cells[static_cast<size_t>(pos & MASK)];
+        const qint64 sequence = cell->sequence.load(std::memory_order_acquire);
+        const qint64 diff = sequence - (pos + 1);
+
+        if (diff == 0) {
+            // 槽位已填充：抢占出队位置
+            if (m_dequeuePos.compare_exchange_weak(pos, pos + 1,
+                                                   std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (diff < 0) {
+            // 槽位还没被生产，队列为空
+            return false;
+        } else {
+            pos = m_dequeuePos.load(std::memory_order_relaxed);
+        }
+    }
+
+    // 事件移出槽位；残留的moved-from对象会被下一轮入队覆盖
+    event = std::move(cell->event);
+    // 槽位释放给CAPACITY之后的下一轮入队
+    cell->sequence.store(pos + CAPACITY, std::memory_order_release);
+    return true;
+}
+
+int BoundedEventQueue::size() const
+{
+    const qint64 tail = m_enqueuePos.load(std::memory_order_relaxed);
+    const qint64 head = m_dequeuePos.load(std::memory_order_relaxed);
+    return static_cast<int>(qMax<qint64>(0, tail - head));
+}
+
 // ==================== EventSystem 实现 ====================
 
 EventSystem* EventSystem::s_instance = nullptr;
 
 EventSystem::EventSystem(QObject *parent)
     : QObject(parent)
+    , m_processBudgetUs(DEFAULT_PROCESS_BUDGET_US)
+    , m_currentWheelSlot(0)
+    , m_wheelRemainderMs(0)
     , m_processTimer(new QTimer(this))
     , m_eventLogging(false)
     , m_nextFilterId(1)
@@ -57,9 +320,15 @@ EventSystem::EventSystem(QObject *parent)
 EventSystem::~EventSystem()
 {
     clearEventQueue();
-    m_listeners.clear();
+    for (auto &slot : m_dispatchTable) {
+        slot.clear();
+    }
+    m_handleSlots.clear();
+    m_listenerHandles.clear();
     m_eventFilters.clear();
-    m_delayedEvents.clear();
+    for (auto &slot : m_timingWheel) {
+        slot.clear();
+    }
     
     if (s_instance == this) {
         s_instance = nullptr;
@@ -101,77 +370,194 @@ void EventSystem::postEvent(const GameEvent &event)
     if (m_eventLogging) {
         qDebug() << "EventSystem: 发送异步事件" << static_cast<int>(event.getType());
     }
-    
+
+    // 常规路径：无锁入队，任意线程调用都不会阻塞
+    if (m_eventQueue.tryEnqueue(event)) {
+        return;
+    }
+
+    // 冷路径：无锁队列已满，走加锁的溢出队列兜底，不丢事件
+    qWarning() << "EventSystem: 无锁事件队列已满，事件进入溢出队列";
     QMutexLocker locker(&m_queueMutex);
-    m_eventQueue.enqueue(event);
+    m_overflowQueue.enqueue(event);
+}
+
+void EventSystem::postEvent(GameEvent &&event)
+{
+    if (m_eventLogging) {
+        qDebug() << "EventSystem: 发送异步事件" << static_cast<int>(event.getType());
+    }
+
+    // 常规路径：事件被移入无锁队列槽位，零拷贝
+    if (m_eventQueue.tryEnqueue(std::move(event))) {
+        return;
+    }
+
+    // 冷路径：入队失败时事件未被移动，仍可安全移入溢出队列
+    qWarning() << "EventSystem: 无锁事件队列已满，事件进入溢出队列";
+    QMutexLocker locker(&m_queueMutex);
+    m_overflowQueue.enqueue(std::move(event));
 }
 
 void EventSystem::sendDelayedEvent(const GameEvent &event, int delayMs)
 {
     if (m_eventLogging) {
-        qDebug() << "EventSystem: 发送延迟事件" << static_cast<int>(event.getType()) 
+        qDebug() << "EventSystem: 发送延迟事件" << static_cast<int>(event.getType())
                  << "延迟" << delayMs << "毫秒";
     }
-    
-    DelayedEvent delayedEvent{event, QDateTime::currentMSecsSinceEpoch() + delayMs};
-    m_delayedEvents.append(delayedEvent);
+
+    // 一次数组插入：换算成时间轮刻度，挂到目标槽位
+    const qint64 ticks =
+        qMax<qint64>(1, (delayMs + WHEEL_SLOT_MS - 1) / WHEEL_SLOT_MS);
+    const int slot =
+        static_cast<int>((m_currentWheelSlot + ticks) % WHEEL_SLOT_COUNT);
+    const int rounds = static_cast<int>(ticks / WHEEL_SLOT_COUNT);
+
+    m_timingWheel[static_cast<size_t>(slot)].append(DelayedEvent{event, rounds});
+}
+
+void EventSystem::sendDelayedEvent(GameEvent &&event, int delayMs)
+{
+    if (m_eventLogging) {
+        qDebug() << "EventSystem: 发送延迟事件" << static_cast<int>(event.getType())
+                 << "延迟" << delayMs << "毫秒";
+    }
+
+    const qint64 ticks =
+        qMax<qint64>(1, (delayMs + WHEEL_SLOT_MS - 1) / WHEEL_SLOT_MS);
+    const int slot =
+        static_cast<int>((m_currentWheelSlot + ticks) % WHEEL_SLOT_COUNT);
+    const int rounds = static_cast<int>(ticks / WHEEL_SLOT_COUNT);
+
+    // 事件直接移入时间轮槽位
+    m_timingWheel[static_cast<size_t>(slot)].append(DelayedEvent{std::move(event), rounds});
+}
+
+void EventSystem::sendDelayedEventAtServerTime(GameEvent &&event, qint64 serverTimeMs)
+{
+    // 服务器时刻 → 本地延迟：SyncedClock补偿钟差与漂移，未同步
+    // 时退化为直接比较（与旧行为一致）。已过期的时间戳剩余为0，
+    // sendDelayedEvent按最小一个刻度发送
+    const qint64 remaining =
+        SyncedClock::instance()->remainingUntilServerMs(serverTimeMs);
+    const int delayMs = static_cast<int>(qMin<qint64>(remaining, INT_MAX));
+    sendDelayedEvent(std::move(event), delayMs);
+}
+
+void EventSystem::advanceFrame(qint64 elapsedMs)
+{
+    PROFILE_ZONE("EventSystem::advanceFrame");
+
+    // 帧循环接管驱动后，内部回退定时器不再需要
+    if (m_processTimer->isActive()) {
+        m_processTimer->stop();
+    }
+
+    processEventQueue();
+    advanceTimingWheel(elapsedMs);
+
+    // 类型化通道与旧队列同节奏排空，两条通道的异步事件
+    // 在同一帧内各自分发
+    TypedEventBus::instance()->drainPosted();
 }
 
 // ==================== 监听器管理接口 ====================
 
-void EventSystem::registerListener(GameEvent::Type eventType, IEventListener* listener, int priority)
+int EventSystem::registerListener(GameEvent::Type eventType, IEventListener* listener, int priority)
 {
     if (!listener) {
         qWarning() << "EventSystem: 尝试注册空监听器";
-        return;
+        return 0;
     }
-    
-    ListenerInfo info(listener, priority);
-    m_listeners[eventType].append(info);
-    
-    // 按优先级排序
-    sortListenersByPriority(m_listeners[eventType]);
-    
+
+    const int handle = m_nextListenerHandle++;
+    const quint16 slotIndex = static_cast<quint16>(slotForType(eventType));
+
+    // 有序插入一条，分发路径零排序；句柄与反向索引同步登记
+    insertListenerSorted(m_dispatchTable[slotIndex],
+                         ListenerInfo(listener, priority, handle));
+    m_handleSlots.insert(handle, slotIndex);
+    m_listenerHandles[listener].append(handle);
+
     if (m_eventLogging) {
-        qDebug() << "EventSystem: 注册监听器" << listener 
+        qDebug() << "EventSystem: 注册监听器" << listener
                  << "事件类型" << static_cast<int>(eventType)
-                 << "优先级" << priority;
+                 << "优先级" << priority << "句柄" << handle;
     }
+
+    return handle;
 }
 
-void EventSystem::registerHandler(GameEvent::Type eventType, const EventHandler &handler, int priority)
+int EventSystem::registerHandler(GameEvent::Type eventType, const EventHandler &handler, int priority)
 {
     if (!handler) {
         qWarning() << "EventSystem: 尝试注册空处理函数";
-        return;
+        return 0;
     }
-    
-    ListenerInfo info(handler, priority);
-    m_listeners[eventType].append(info);
-    
-    // 按优先级排序
-    sortListenersByPriority(m_listeners[eventType]);
-    
+
+    const int handle = m_nextListenerHandle++;
+    const quint16 slotIndex = static_cast<quint16>(slotForType(eventType));
+
+    insertListenerSorted(m_dispatchTable[slotIndex],
+                         ListenerInfo(handler, priority, handle));
+    m_handleSlots.insert(handle, slotIndex);
+
     if (m_eventLogging) {
         qDebug() << "EventSystem: 注册处理函数"
                  << "事件类型" << static_cast<int>(eventType)
-                 << "优先级" << priority;
+                 << "优先级" << priority << "句柄" << handle;
+    }
+
+    return handle;
+}
+
+void EventSystem::unregisterHandle(int handle)
+{
+    IEventListener *listener = removeRegistration(handle);
+
+    // 清掉监听器反向索引里的这一条
+    if (listener) {
+        auto it = m_listenerHandles.find(listener);
+        if (it != m_listenerHandles.end()) {
+            it->removeAll(handle);
+            if (it->isEmpty()) {
+                m_listenerHandles.erase(it);
+            }
+        }
+    }
+
+    if (m_eventLogging) {
+        qDebug() << "EventSystem: 按句柄取消注册" << handle;
     }
 }
 
 void EventSystem::unregisterListener(GameEvent::Type eventType, IEventListener* listener)
 {
-    auto it = m_listeners.find(eventType);
-    if (it != m_listeners.end()) {
-        it.value().removeIf([listener](const ListenerInfo& info) {
-            return !info.isHandler && info.listener == listener;
-        });
-        
-        if (it.value().isEmpty()) {
-            m_listeners.erase(it);
+    auto &slot = m_dispatchTable[static_cast<size_t>(slotForType(eventType))];
+    slot.removeIf([this, listener](const ListenerInfo& info) {
+        if (info.isHandler || info.listener != listener) {
+            return false;
+        }
+        m_handleSlots.remove(info.id);
+        return true;
+    });
+
+    auto it = m_listenerHandles.find(listener);
+    if (it != m_listenerHandles.end()) {
+        // 只保留仍在句柄索引里的注册（其他类型上的）
+        QVarLengthArray<int, 4> remaining;
+        for (const int handle : *it) {
+            if (m_handleSlots.contains(handle)) {
+                remaining.append(handle);
+            }
+        }
+        if (remaining.isEmpty()) {
+            m_listenerHandles.erase(it);
+        } else {
+            *it = remaining;
         }
     }
-    
+
     if (m_eventLogging) {
         qDebug() << "EventSystem: 取消注册监听器" << listener;
     }
@@ -179,24 +565,15 @@ void EventSystem::unregisterListener(GameEvent::Type eventType, IEventListener*
 
 void EventSystem::unregisterAllListeners(IEventListener* listener)
 {
-    for (auto it = m_listeners.begin(); it != m_listeners.end(); ++it) {
-        auto& listeners = it.value();
-        listeners.removeIf([listener](const ListenerInfo& info) {
-            return !info.isHandler && info.listener == listener;
-        });
-    }
-    
-    // 移除空的事件类型
-    for (auto it = m_listeners.begin(); it != m_listeners.end();) {
-        if (it.value().isEmpty()) {
-            it = m_listeners.erase(it);
-        } else {
-            ++it;
-        }
+    // 反向索引直达该监听器的全部注册，不再按类型全表扫描
+    const QVarLengthArray<int, 4> handles = m_listenerHandles.take(listener);
+    for (const int handle : handles) {
+        removeRegistration(handle);
     }
-    
+
     if (m_eventLogging) {
-        qDebug() << "EventSystem: 取消注册所有监听器" << listener;
+        qDebug() << "EventSystem: 取消注册所有监听器" << listener
+                 << "共" << handles.size() << "条";
     }
 }
 
@@ -233,27 +610,105 @@ void EventSystem::removeEventFilter(int filterId)
 
 void EventSystem::processEventQueue()
 {
-    QMutexLocker locker(&m_queueMutex);
-    
-    while (!m_eventQueue.isEmpty()) {
-        GameEvent event = m_eventQueue.dequeue();
-        locker.unlock();
-        
-        // 应用事件过滤器
-        if (applyEventFilters(event)) {
-            dispatchEvent(event);
-            m_eventStats[event.getType()]++;
+    PROFILE_ZONE("EventSystem::processEventQueue");
+
+    // 把两条入队路径的事件全部搬进优先级桶（搬运本身很便宜，
+    // 真正的开销在监听器回调里，预算只需要约束分发阶段）
+    collectPendingEvents();
+
+    QElapsedTimer budgetTimer;
+    budgetTimer.start();
+    const qint64 budgetNs = m_processBudgetUs * 1000;
+
+    // 从Critical到Low依次分发；预算检查放在每个事件之后，
+    // 保证每次调用至少前进一个事件，队列不会原地踏步
+    bool budgetExhausted = false;
+    for (int level = PRIORITY_LEVEL_COUNT - 1; level >= 0 && !budgetExhausted; --level) {
+        auto &bucket = m_pendingBuckets[static_cast<size_t>(level)];
+        int processed = 0;
+        for (const GameEvent &event : bucket) {
+            if (applyEventFilters(event)) {
+                dispatchEvent(event);
+                m_eventStats[event.getType()]++;
+            }
+            ++processed;
+            if (budgetNs > 0 && budgetTimer.nsecsElapsed() >= budgetNs) {
+                budgetExhausted = true;
+                break;
+            }
         }
-        
-        locker.relock();
+        bucket.remove(0, processed);
+    }
+
+    if (!budgetExhausted) {
+        return;
+    }
+
+    // 预算耗尽：剩余事件结转到下一帧并提升一级优先级（老化），
+    // 最多三帧后任何事件都会进入Critical桶，先于新事件处理
+    for (int level = PRIORITY_LEVEL_COUNT - 2; level >= 0; --level) {
+        auto &bucket = m_pendingBuckets[static_cast<size_t>(level)];
+        if (bucket.isEmpty()) {
+            continue;
+        }
+        m_pendingBuckets[static_cast<size_t>(level + 1)].append(std::move(bucket));
+        bucket.clear();
+    }
+
+    if (m_eventLogging) {
+        qDebug() << "EventSystem: 处理预算耗尽，剩余事件结转到下一帧";
+    }
+}
+
+void EventSystem::setProcessingBudget(qint64 budgetUs)
+{
+    m_processBudgetUs = qMax<qint64>(0, budgetUs);
+    if (m_eventLogging) {
+        qDebug() << "EventSystem: 处理时间预算设置为" << m_processBudgetUs << "微秒";
+    }
+}
+
+void EventSystem::collectPendingEvents()
+{
+    const auto bucketFor = [this](const GameEvent &event) -> QList<GameEvent>& {
+        const int level = qBound(0, static_cast<int>(event.getPriority()),
+                                 PRIORITY_LEVEL_COUNT - 1);
+        return m_pendingBuckets[static_cast<size_t>(level)];
+    };
+
+    // 先排空无锁队列（无需加锁）；事件一路移动进优先级桶
+    GameEvent event{GameEvent::Type::Custom};
+    while (m_eventQueue.tryDequeue(event)) {
+        bucketFor(event).append(std::move(event));
+    }
+
+    // 再排空溢出队列（正常情况下为空）
+    for (;;) {
+        {
+            QMutexLocker locker(&m_queueMutex);
+            if (m_overflowQueue.isEmpty()) {
+                break;
+            }
+            event = m_overflowQueue.dequeue();
+        }
+        bucketFor(event).append(std::move(event));
     }
 }
 
 void EventSystem::clearEventQueue()
 {
+    GameEvent discarded{GameEvent::Type::Custom};
+    while (m_eventQueue.tryDequeue(discarded)) {
+        // 丢弃未处理事件
+    }
+
+    for (auto &bucket : m_pendingBuckets) {
+        bucket.clear();
+    }
+
     QMutexLocker locker(&m_queueMutex);
-    m_eventQueue.clear();
-    
+    m_overflowQueue.clear();
+
     if (m_eventLogging) {
         qDebug() << "EventSystem: 清空事件队列";
     }
@@ -261,8 +716,13 @@ void EventSystem::clearEventQueue()
 
 int EventSystem::getQueueSize() const
 {
+    int carried = 0;
+    for (const auto &bucket : m_pendingBuckets) {
+        carried += static_cast<int>(bucket.size());
+    }
+
     QMutexLocker locker(&m_queueMutex);
-    return m_eventQueue.size();
+    return m_eventQueue.size() + m_overflowQueue.size() + carried;
 }
 
 int EventSystem::getEventCount(GameEvent::Type eventType) const
@@ -288,19 +748,38 @@ void EventSystem::setEventLogging(bool enabled)
 
 void EventSystem::onTimerTimeout()
 {
-    // 处理异步事件队列
+    // 回退驱动：帧循环尚未接管时按定时器节奏推进
     processEventQueue();
-    
-    // 处理延迟事件
-    qint64 currentTime = QDateTime::currentMSecsSinceEpoch();
-    
-    for (int i = m_delayedEvents.size() - 1; i >= 0; --i) {
-        if (m_delayedEvents[i].triggerTime <= currentTime) {
-            GameEvent event = m_delayedEvents[i].event;
-            m_delayedEvents.removeAt(i);
-            
-            // 发送延迟事件
-            sendEvent(event);
+    advanceTimingWheel(m_processTimer->interval());
+}
+
+void EventSystem::advanceTimingWheel(qint64 elapsedMs)
+{
+    m_wheelRemainderMs += elapsedMs;
+
+    while (m_wheelRemainderMs >= WHEEL_SLOT_MS) {
+        m_wheelRemainderMs -= WHEEL_SLOT_MS;
+        m_currentWheelSlot = (m_currentWheelSlot + 1) % WHEEL_SLOT_COUNT;
+
+        auto &slot = m_timingWheel[static_cast<size_t>(m_currentWheelSlot)];
+        if (slot.isEmpty()) {
+            continue;
+        }
+
+        // 到期事件整槽批量取出再发送，处理器内重新调度
+        // 延迟事件不会干扰本槽位的遍历。取出缓冲是帧作用域的，
+        // 从帧分配器取内存，每个槽位推进不再付堆分配
+        FrameVector<DelayedEvent> due;
+        for (int i = slot.size() - 1; i >= 0; --i) {
+            if (slot[i].remainingRounds <= 0) {
+                due.push_back(slot.takeAt(i));
+            } else {
+                --slot[i].remainingRounds;
+            }
+        }
+
+        for (const DelayedEvent &delayed : due) {
+            sendEvent(delayed.event);
         }
     }
 }
@@ -309,15 +788,18 @@ void EventSystem::onTimerTimeout()
 
 bool EventSystem::dispatchEvent(const GameEvent &event)
 {
-    auto it = m_listeners.find(event.getType());
-    if (it == m_listeners.end()) {
+    // 预排序分发表按类型直接索引：零查找、零排序、零分配
+    const int slotIndex = slotForType(event.getType());
+    GAME_PARANOID_ASSERT(slotIndex >= 0 && slotIndex < DISPATCH_SLOT_COUNT);
+    const auto &listeners = m_dispatchTable[static_cast<size_t>(slotIndex)];
+    if (listeners.isEmpty()) {
         return false;
     }
-    
+
     int handlerCount = 0;
     bool eventHandled = false;
-    
-    for (const ListenerInfo& info : it.value()) {
+
+    for (const ListenerInfo& info : listeners) {
         bool handled = false;
         
         if (info.isHandler && info.handler) {
@@ -354,10 +836,45 @@ bool EventSystem::applyEventFilters(const GameEvent &event)
     return true;
 }
 
-void EventSystem::sortListenersByPriority(QList<ListenerInfo> &listeners)
+int EventSystem::slotForType(GameEvent::Type type)
+{
+    const int value = static_cast<int>(type);
+    if (value < static_cast<int>(GameEvent::Type::BuiltinEventCount)) {
+        return value;
+    }
+    // Custom及以上共享最后一个槽位
+    return static_cast<int>(GameEvent::Type::BuiltinEventCount);
+}
+
+void EventSystem::insertListenerSorted(QList<ListenerInfo> &listeners, const ListenerInfo &info)
 {
-    std::sort(listeners.begin(), listeners.end(),
-              [](const ListenerInfo& a, const ListenerInfo& b) {
-                  return a.priority > b.priority;
-              });
+    // upper_bound保证同优先级按注册顺序排在已有项之后
+    const auto position = std::upper_bound(
+        listeners.begin(), listeners.end(), info,
+        [](const ListenerInfo& a, const ListenerInfo& b) {
+            return a.priority > b.priority;
+        });
+    listeners.insert(position, info);
+}
+
+IEventListener* EventSystem::removeRegistration(int handle)
+{
+    const auto slotIt = m_handleSlots.constFind(handle);
+    if (slotIt == m_handleSlots.constEnd()) {
+        return nullptr;
+    }
+
+    // 反向索引登记时即来自slotForType，不会越界
+    GAME_DEBUG_ASSERT(slotIt.value() < DISPATCH_SLOT_COUNT);
+    auto &slot = m_dispatchTable[static_cast<size_t>(slotIt.value())];
+    m_handleSlots.erase(slotIt);
+
+    for (int i = 0; i < slot.size(); ++i) {
+        if (slot[i].id == handle) {
+            IEventListener *listener = slot[i].listener;
+            slot.removeAt(i);
+            return listener;
+        }
+    }
+    return nullptr;
 }
@@ -0,0 +1,62 @@
+/*
+ * 文件名: FrameAllocator.cpp
+ * 说明: 帧作用域线性分配器实现。
+ * 作者: 彭承康
+ * 创建时间: 2026-02-18
+ */
+#include "core/FrameAllocator.h"
+
+#include <QDebug>
+
+FrameAllocator* FrameAllocator::s_active = nullptr;
+
+FrameAllocator::FrameAllocator(std::size_t capacityBytes)
+    : buffer_(static_cast<char*>(::operator new(capacityBytes)))
+    , capacity_(capacityBytes)
+    , offset_used_(0)
+    , high_water_mark_(0)
+    , overflow_count_(0)
+{
+}
+
+FrameAllocator::~FrameAllocator()
+{
+    reset();
+    ::operator delete(buffer_);
+    if (s_active == this) {
+        s_active = nullptr;
+    }
+}
+
+void* FrameAllocator::allocate(std::size_t bytes, std::size_t align)
+{
+    // 写入位置向上对齐后碰撞前移
+    const std::size_t aligned = (offset_used_ + align - 1) & ~(align - 1);
+    if (aligned + bytes <= capacity_) {
+        offset_used_ = aligned + bytes;
+        if (offset_used_ > high_water_mark_) {
+            high_water_mark_ = offset_used_;
+        }
+        return buffer_ + aligned;
+    }
+
+    // 缓冲区耗尽：回退到堆，溢出块在reset()时释放
+    ++overflow_count_;
+    if (overflow_count_ == 1) {
+        qWarning() << "FrameAllocator: 帧缓冲区耗尽，回退到堆分配"
+                   << "容量:" << capacity_ << "请求:" << bytes;
+    }
+    // 帧临时对象都是基本对齐类型，普通operator new即可满足
+    void *block = ::operator new(bytes);
+    overflow_blocks_.push_back(block);
+    return block;
+}
+
+void FrameAllocator::reset()
+{
+    offset_used_ = 0;
+    for (void *block : overflow_blocks_) {
+        ::operator delete(block);
+    }
+    overflow_blocks_.clear();
+}
@@ -0,0 +1,98 @@
+/*
+ * 文件名: FramePacingGovernor.cpp
+ * 说明: 帧节奏调节器实现
+ * 作者: 彭承康
+ * 创建时间: 2026-08-28
+ */
+#include "core/FramePacingGovernor.h"
+
+#include <QDebug>
+#include <algorithm>
+
+namespace {
+
+// 各层级的特效密度系数：降档时动画/特效消费方按此比例缩减
+constexpr float LEVEL_DENSITIES[FramePacingGovernor::LEVEL_COUNT] = {
+    1.0f, 0.6f, 0.35f
+};
+
+} // namespace
+
+FramePacingGovernor::FramePacingGovernor(QObject *parent)
+    : QObject(parent)
+    , m_targetMs(1000.0f / 60.0f)
+    , m_samples(SAMPLE_WINDOW, 0.0f)
+{
+    m_scratch.reserve(SAMPLE_WINDOW);
+}
+
+void FramePacingGovernor::setTargetFrameTime(float targetMs)
+{
+    if (targetMs <= 0.0f) {
+        return;
+    }
+    m_targetMs = targetMs;
+}
+
+void FramePacingGovernor::addFrameSample(float frameMs)
+{
+    if (frameMs < 0.0f) {
+        return;
+    }
+
+    m_samples[m_sampleHead] = frameMs;
+    m_sampleHead = (m_sampleHead + 1) % SAMPLE_WINDOW;
+    m_sampleCount = std::min(m_sampleCount + 1, SAMPLE_WINDOW);
+
+    if (++m_samplesSinceEvaluate >= EVALUATE_INTERVAL) {
+        m_samplesSinceEvaluate = 0;
+        evaluate();
+    }
+}
+
+float FramePacingGovernor::effectDensity() const
+{
+    return LEVEL_DENSITIES[m_level];
+}
+
+void FramePacingGovernor::evaluate()
+{
+    // 窗口未满前不换档：刚启动或clear后的少量样本不具代表性
+    if (m_sampleCount < SAMPLE_WINDOW) {
+        return;
+    }
+
+    // 取窗口高百分位：nth_element线性选择，暂存数组复用不分配
+    m_scratch.resize(m_sampleCount);
+    std::copy(m_samples.cbegin(), m_samples.cbegin() + m_sampleCount,
+              m_scratch.begin());
+    const int nth = std::min(
+        static_cast<int>(static_cast<float>(m_sampleCount) * PERCENTILE),
+        m_sampleCount - 1);
+    std::nth_element(m_scratch.begin(), m_scratch.begin() + nth, m_scratch.end());
+    m_lastPercentileMs = m_scratch[nth];
+
+    // 换档后的驻留期内只观察不动作，给上次调整留出生效时间
+    if (m_dwellLeft > 0) {
+        --m_dwellLeft;
+        return;
+    }
+
+    int newLevel = m_level;
+    if (m_lastPercentileMs > m_targetMs * DEGRADE_RATIO) {
+        newLevel = std::min(m_level + 1, LEVEL_COUNT - 1);
+    } else if (m_lastPercentileMs < m_targetMs * RECOVER_RATIO) {
+        // 升档阈值远低于降档阈值，中间的迟滞区间保持现档不动
+        newLevel = std::max(m_level - 1, 0);
+    }
+
+    if (newLevel == m_level) {
+        return;
+    }
+
+    qDebug() << "FramePacingGovernor: 细节层级" << m_level << "->" << newLevel
+             << "p95帧时" << m_lastPercentileMs << "毫秒，目标" << m_targetMs << "毫秒";
+    m_level = newLevel;
+    m_dwellLeft = DWELL_EVALUATIONS;
+    emit detailLevelChanged(m_level, effectDensity());
+}
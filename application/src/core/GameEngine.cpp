@@ -8,25 +8,43 @@
  * 协调各个子系统的工作，管理游戏状态和循环。
  */
 #include "core/GameEngine.h"
+#include "core/EventSystem.h"
+#include "core/FramePacingGovernor.h"
+#include "core/IdleMaintenanceScheduler.h"
+#include "core/JobSystem.h"
+#include "core/WorkerMailbox.h"
 #include "core/SceneManager.h"
 #include "core/ResourceManager.h"
 #include "network/NetworkManager.h"
+#include "network/SendAggregator.h"
 #include "audio/AudioManager.h"
 #include "game/GameState.h"
 #include "game/Player.h"
 #include "game/BattleSystem.h"
+#include "game/BattleSessionCache.h"
+#include "game/BattleReplay.h"
 #include "game/InventorySystem.h"
+#include "input/InputManager.h"
+#include "utils/FrameProfiler.h"
+#include "utils/PerformanceMonitor.h"
+#include "utils/StartupProfiler.h"
 
-#include <QElapsedTimer>
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QStandardPaths>
 #include <QDir>
 #include <QDebug>
 
+#include <algorithm>
+
 GameEngine::GameEngine(QObject *parent)
     : QObject(parent)
     , m_gameTimer(new QTimer(this))
+    , m_jobSystem(new JobSystem(this))
+    , m_mailboxHub(std::make_unique<MailboxHub>())
+    , m_frameAllocator(std::make_unique<FrameAllocator>())
+    , m_idleScheduler(std::make_unique<IdleMaintenanceScheduler>())
+    , m_pacingGovernor(std::make_unique<FramePacingGovernor>())
     , m_sceneManager(nullptr)
     , m_resourceManager(nullptr)
     , m_networkManager(nullptr)
@@ -38,16 +56,25 @@ GameEngine::GameEngine(QObject *parent)
     , m_lastFrameTime(0)
     , m_frameCounter(0)
     , m_frameRateTime(0)
+    , m_accumulator(0.0f)
+    , m_renderAlpha(0.0f)
 {
-    // 配置游戏循环定时器
-    m_gameTimer->setInterval(1000 / TARGET_FPS); // 60 FPS
+    // 配置游戏循环定时器（渲染节奏；模拟步长由FIXED_TIMESTEP固定）
+    m_gameTimer->setInterval(1000 / TARGET_FPS);
     connect(m_gameTimer, &QTimer::timeout, this, &GameEngine::update);
-    
-    // 初始化时间戳
-    QElapsedTimer timer;
-    timer.start();
-    m_lastFrameTime = timer.elapsed();
+
+    // 启动单调时钟并初始化时间戳
+    m_elapsedTimer.start();
+    m_lastFrameTime = m_elapsedTimer.elapsed();
     m_frameRateTime = m_lastFrameTime;
+
+    // 登记帧分配器，子系统经FrameAllocator::active()取用
+    FrameAllocator::setActive(m_frameAllocator.get());
+
+    // 登记信箱枢纽：任务完成回调与RPC恢复经SPSC信箱送回，
+    // 由update()统一排空，绕开逐条队列连接的投递开销
+    MailboxHub::setActive(m_mailboxHub.get());
+    m_jobSystem->setCompletionMailboxHub(m_mailboxHub.get());
 }
 
 GameEngine::~GameEngine()
@@ -74,19 +101,37 @@ bool GameEngine::initialize(SceneManager *sceneManager,
             return false;
         }
         
-        // 创建游戏系统
+        // 分阶段创建游戏系统：主菜单只依赖游戏状态与玩家数据，
+        // 背包（物品库初始化、存档文件读取）与战斗系统推迟到
+        // 菜单出现后的事件循环空闲时补建，缩短冷启动到菜单的时间
         m_gameState = std::make_unique<GameState>();
         m_player = std::make_unique<Player>();
-        m_battleSystem = std::make_unique<BattleSystem>();
-        m_inventorySystem = std::make_unique<Game::InventorySystem>();
-        
+        QTimer::singleShot(0, this, &GameEngine::ensureGameSystemsReady);
+
+        // 场景切换时按清单差量调整常驻音效
+        m_sceneManager->setAudioManager(m_audioManager);
+
         // 建立信号连接
         connect(m_sceneManager, &SceneManager::sceneTransitionCompleted,
                 this, &GameEngine::onSceneTransitionCompleted);
+
+        // 默认维护任务：资源清理走空闲片，避开游戏帧
+        m_idleScheduler->registerTask(
+            QStringLiteral("resource_cleanup"),
+            [this](qint64) {
+                if (m_resourceManager) {
+                    m_resourceManager->cleanupUnusedResources();
+                }
+                return false;  // 单次完成，等最小间隔后再跑
+            },
+            RESOURCE_CLEANUP_INTERVAL_MS);
         
         // 加载游戏配置
-        if (!loadGameConfig()) {
-            qWarning() << "GameEngine: 加载游戏配置失败";
+        {
+            StartupPhase phase(QStringLiteral("config_parse"));
+            if (!loadGameConfig()) {
+                qWarning() << "GameEngine: 加载游戏配置失败";
+            }
         }
         
         // 设置初始化状态
@@ -104,6 +149,77 @@ bool GameEngine::initialize(SceneManager *sceneManager,
     }
 }
 
+void GameEngine::ensureGameSystemsReady()
+{
+    if (areGameSystemsReady()) {
+        return;
+    }
+
+    // 会话缓存先于战斗系统建好：后台在探索阶段预协商combat
+    // 规则（通道由GrpcChannelManager保持热连接），战斗入场只剩
+    // 场景切换加一次权威RPC
+    if (!m_battleSessionCache) {
+        m_battleSessionCache = std::make_unique<BattleSessionCache>();
+        m_battleSessionCache->initialize(
+            m_networkManager ? m_networkManager->getStrategyClient() : nullptr);
+    }
+    if (!m_battleSystem) {
+        m_battleSystem = std::make_unique<BattleSystem>();
+        m_battleSystem->setSessionCache(m_battleSessionCache.get());
+    }
+    if (!m_inventorySystem) {
+        m_inventorySystem = std::make_unique<Game::InventorySystem>();
+    }
+
+    qDebug() << "GameEngine: 延迟创建的游戏系统已就绪";
+    emit gameSystemsReady();
+}
+
+bool GameEngine::runBattleReplay(const QString &filePath)
+{
+    BattleReplay replay;
+    if (!replay.load(filePath)) {
+        qWarning() << "GameEngine: 回放文件加载失败:" << filePath;
+        return false;
+    }
+
+    ensureGameSystemsReady();
+    if (!m_player || !m_battleSystem) {
+        qWarning() << "GameEngine: 游戏系统未就绪，无法回放";
+        return false;
+    }
+
+    // 恢复录制时的玩家属性，保证重放初始状态一致
+    if (!replay.playerSnapshot().isEmpty()) {
+        m_player->loadFromJson(replay.playerSnapshot());
+    }
+
+    AlgorithmServiceClient *algorithmClient =
+        m_networkManager ? m_networkManager->getAlgorithmClient() : nullptr;
+    if (!m_battleSystem->initialize(m_player.get(), algorithmClient)) {
+        qWarning() << "GameEngine: 战斗系统初始化失败，无法回放";
+        return false;
+    }
+
+    // 回放全程开启性能监控，卡顿报告离线复现成可分析的档案
+    PerformanceMonitor *monitor = PerformanceMonitor::instance();
+    monitor->setMonitoringEnabled(true);
+    monitor->beginProfileSection("battle_replay");
+
+    const bool finished = m_battleSystem->playReplay(replay);
+
+    monitor->endProfileSection("battle_replay");
+    qDebug() << "GameEngine: 战斗回放" << (finished ? "完成" : "中断")
+             << "耗时(us):" << monitor->getProfileSectionTime("battle_replay");
+
+    const QString profilePath = filePath + ".profile.json";
+    if (!monitor->exportPerformanceData(profilePath)) {
+        qWarning() << "GameEngine: 性能档案导出失败:" << profilePath;
+    }
+
+    return finished;
+}
+
 void GameEngine::start()
 {
     if (!m_isInitialized) {
@@ -150,6 +266,9 @@ bool GameEngine::startNewGame(const QString &playerName, const QString &professi
     try {
         qDebug() << "GameEngine: 开始新游戏 - 玩家:" << playerName << "职业:" << profession;
 
+        // 进入游戏流程前补建延迟创建的系统
+        ensureGameSystemsReady();
+
         // 初始化玩家
         if (m_player) {
             m_player->setName(playerName);
@@ -198,6 +317,9 @@ bool GameEngine::startNewGameWithId(const QString &playerName, int professionId)
 bool GameEngine::loadGame(int slotIndex)
 {
     try {
+        // 进入游戏流程前补建延迟创建的系统
+        ensureGameSystemsReady();
+
         if (slotIndex < 0 || slotIndex >= 10) {
             qWarning() << "GameEngine: 无效的存档槽位:" << slotIndex;
             return false;
@@ -437,21 +559,74 @@ void GameEngine::forceGarbageCollection()
 
 void GameEngine::update()
 {
-    // 计算帧时间
-    QElapsedTimer timer;
-    timer.start();
-    qint64 currentTime = timer.elapsed();
+    PROFILE_ZONE("GameEngine::update");
+
+    // 计算实际流逝时间，与定时器的触发节奏解耦
+    qint64 currentTime = m_elapsedTimer.elapsed();
     m_deltaTime = (currentTime - m_lastFrameTime) / 1000.0f;
     m_lastFrameTime = currentTime;
-    
+
     // 更新帧率统计
     updateFrameRate();
-    
-    // 根据当前状态更新游戏逻辑
-    if (m_currentState == GameEngineState::Playing || 
+
+    // 帧驱动事件系统：处理异步队列并推进延迟事件时间轮
+    EventSystem::instance()->advanceFrame(
+        static_cast<qint64>(m_deltaTime * 1000.0f));
+
+    // 统一排空工作线程信箱：任务完成回调、RPC恢复按帧批量执行
+    m_mailboxHub->drainAll();
+
+    // 固定步长模拟：把流逝时间累积起来，按FIXED_TIMESTEP逐步消费。
+    // 卡顿后累积量限幅到MAX_ACCUMULATED_TIME，避免一帧补太多步。
+    if (m_currentState == GameEngineState::Playing ||
         m_currentState == GameEngineState::Battle) {
-        updateGameLogic(m_deltaTime);
+        m_accumulator += std::min(m_deltaTime, MAX_ACCUMULATED_TIME);
+
+        // 输入时间戳重放：最后一步的区间终点对齐输入时钟当前时刻，
+        // 往前每步各回推一个步长，事件落在覆盖其到达时刻的那一步
+        const qint64 inputNowMs =
+            m_inputManager ? m_inputManager->inputTimeMs() : 0;
+        while (m_accumulator >= FIXED_TIMESTEP) {
+            if (m_inputManager) {
+                const qint64 stepEndMs = inputNowMs -
+                    static_cast<qint64>((m_accumulator - FIXED_TIMESTEP) * 1000.0f);
+                m_inputManager->applyEventsUntil(stepEndMs);
+            }
+            updateGameLogic(FIXED_TIMESTEP);
+            m_accumulator -= FIXED_TIMESTEP;
+        }
+    } else {
+        // 非模拟状态下清空累积器，恢复时不会补跑暂停期间的时间
+        m_accumulator = 0.0f;
+
+        // 菜单/暂停等空闲状态：把帧预算的余量分给增量维护任务，
+        // 扣除本帧已耗时与安全余量，空闲片不会把帧推过节拍
+        const qint64 frameBudgetMs = 1000 / TARGET_FPS;
+        const qint64 frameSpentMs = m_elapsedTimer.elapsed() - currentTime;
+        const qint64 headroomMs = frameBudgetMs - frameSpentMs - IDLE_SAFETY_MARGIN_MS;
+        if (headroomMs > 0) {
+            m_idleScheduler->runIdleSlice(headroomMs);
+        }
+    }
+
+    // 帧末冲刷出站聚合器：本帧入队的小消息合并成一个载荷发出
+    if (m_networkManager != nullptr) {
+        if (SendAggregator *aggregator = m_networkManager->getSendAggregator()) {
+            aggregator->flushFrame();
+        }
     }
+
+    // 不足一步的剩余时间折算成渲染插值系数（0=上一步，1=最新一步）
+    m_renderAlpha = m_accumulator / FIXED_TIMESTEP;
+    emit renderAlphaChanged();
+
+    // 帧末整块回收本帧临时分配；此时帧作用域容器已全部析构
+    m_frameAllocator->reset();
+
+    // 本帧实际工作耗时（不含定时器等待）喂给帧节奏调节器，
+    // 持续超预算时它会下调特效细节层级
+    m_pacingGovernor->addFrameSample(
+        static_cast<float>(m_elapsedTimer.elapsed() - currentTime));
 }
 
 void GameEngine::onNetworkConnectionChanged(bool connected)
@@ -494,42 +669,57 @@ void GameEngine::changeState(GameEngineState newState)
 void GameEngine::updateFrameRate()
 {
     m_frameCounter++;
-    
-    QElapsedTimer timer;
-    timer.start();
-    qint64 currentTime = timer.elapsed();
-    
+
+    qint64 currentTime = m_elapsedTimer.elapsed();
+
     if (currentTime - m_frameRateTime >= 1000) { // 每秒更新一次帧率
         m_frameRate = m_frameCounter;
         m_frameCounter = 0;
         m_frameRateTime = currentTime;
         emit frameRateChanged();
     }
-    
-    emit deltaTimeChanged();
+
+    // 降档时HUD高频属性信号隔帧发射，减少QML绑定重求值
+    const int hudDivisor = HUD_EMIT_DIVISORS[m_pacingGovernor->detailLevel()];
+    if (m_frameCounter % hudDivisor == 0) {
+        emit deltaTimeChanged();
+    }
 }
 
 void GameEngine::updateGameLogic(float deltaTime)
 {
+    PROFILE_ZONE("GameEngine::updateGameLogic");
+
+    // 相互独立的子系统更新作为任务并行执行，帧末同步。
+    // 任务函数只触碰各自子系统的数据；子系统发出的Qt信号
+    // 经自动队列连接回到主线程，不会跨线程触碰QML。
+
     // 更新游戏状态
     if (m_gameState) {
         // m_gameState->update(deltaTime); // 暂时注释掉不存在的方法
     }
-    
+
     // 更新玩家
     if (m_player) {
-        m_player->update(deltaTime);
+        m_jobSystem->schedule([this, deltaTime]() {
+            m_player->update(deltaTime);
+        });
     }
-    
+
     // 更新战斗系统
     if (m_battleSystem && m_currentState == GameEngineState::Battle) {
-        m_battleSystem->update(deltaTime);
+        m_jobSystem->schedule([this, deltaTime]() {
+            m_battleSystem->update(deltaTime);
+        });
     }
-    
+
     // 更新背包系统
     if (m_inventorySystem) {
         // m_inventorySystem->update(deltaTime); // 暂时注释掉不存在的方法
     }
+
+    // 帧内任务全部完成后才进入下一模拟步，等待线程也参与执行
+    m_jobSystem->waitForAll();
 }
 
 bool GameEngine::loadGameConfig()
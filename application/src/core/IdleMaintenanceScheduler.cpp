@@ -0,0 +1,83 @@
+/*
+ * 文件名: IdleMaintenanceScheduler.cpp
+ * 说明: 空闲帧维护任务调度器实现。
+ * 作者: 彭承康
+ * 创建时间: 2026-08-28
+ */
+#include "core/IdleMaintenanceScheduler.h"
+
+IdleMaintenanceScheduler::IdleMaintenanceScheduler()
+{
+    m_clock.start();
+}
+
+void IdleMaintenanceScheduler::registerTask(const QString &name,
+                                            MaintenanceTask task,
+                                            qint64 minIntervalMs)
+{
+    TaskEntry entry;
+    entry.name = name;
+    entry.task = std::move(task);
+    entry.minIntervalMs = minIntervalMs;
+    m_tasks.append(std::move(entry));
+}
+
+qint64 IdleMaintenanceScheduler::runIdleSlice(qint64 budgetMs)
+{
+    if (m_tasks.isEmpty() || budgetMs <= 0) {
+        return 0;
+    }
+
+    QElapsedTimer sliceTimer;
+    sliceTimer.start();
+
+    const qint64 nowMs = m_clock.elapsed();
+    const int taskTotal = m_tasks.size();
+
+    // 从上次停下的位置轮转一圈；预算耗尽随时退出
+    for (int visited = 0; visited < taskTotal; ++visited) {
+        const qint64 spentMs = sliceTimer.elapsed();
+        const qint64 remainingMs = budgetMs - spentMs;
+        if (remainingMs <= 0) {
+            break;
+        }
+
+        const int index = (m_nextTaskIndex + visited) % taskTotal;
+        TaskEntry &entry = m_tasks[index];
+
+        // 一轮完成后的任务要等最小间隔；未完成的任务始终可继续
+        if (!entry.hasPendingWork && nowMs < entry.nextEligibleMs) {
+            continue;
+        }
+
+        const qint64 taskStartMs = sliceTimer.elapsed();
+        const bool moreWork = entry.task(remainingMs);
+        const qint64 taskTimeMs = sliceTimer.elapsed() - taskStartMs;
+
+        entry.totalRuns += 1;
+        entry.totalTimeMs += taskTimeMs;
+        entry.hasPendingWork = moreWork;
+        if (!moreWork) {
+            entry.nextEligibleMs = m_clock.elapsed() + entry.minIntervalMs;
+        }
+
+        // 下个空闲片从本任务的下一个开始，保证轮转公平
+        m_nextTaskIndex = (index + 1) % taskTotal;
+    }
+
+    return sliceTimer.elapsed();
+}
+
+QVector<IdleMaintenanceScheduler::TaskStats> IdleMaintenanceScheduler::taskStats() const
+{
+    QVector<TaskStats> stats;
+    stats.reserve(m_tasks.size());
+    for (const TaskEntry &entry : m_tasks) {
+        TaskStats item;
+        item.name = entry.name;
+        item.totalRuns = entry.totalRuns;
+        item.totalTimeMs = entry.totalTimeMs;
+        stats.append(item);
+    }
+    return stats;
+}
@@ -0,0 +1,222 @@
+/*
+ * 文件名: JobSystem.cpp
+ * 说明: 应用层任务调度系统的具体实现。
+ * 作者: 彭承康
+ * 创建时间: 2026-08-28
+ *
+ * 实现工作窃取线程池与任务依赖图：每个工作线程优先消费
+ * 自己的队列，空闲时从其他队列窃取；任务完成时结算依赖图
+ * 并通过Qt队列连接把完成回调投递回主线程。
+ */
+#include "core/JobSystem.h"
+#include "core/WorkerMailbox.h"
+
+#include <QThread>
+#include <QDebug>
+
+#include <utility>
+
+JobSystem::JobSystem(QObject *parent)
+    : QObject(parent)
+{
+    // 预留主线程：工作线程数 = 硬件线程数 - 1，至少1个
+    const int threadCount = qMax(1, QThread::idealThreadCount() - 1);
+
+    m_queues.resize(static_cast<size_t>(threadCount));
+    m_workers.reserve(static_cast<size_t>(threadCount));
+    for (int i = 0; i < threadCount; ++i) {
+        m_workers.emplace_back([this, i]() { workerLoop(i); });
+    }
+
+    qDebug() << "JobSystem: 已启动" << threadCount << "个工作线程";
+}
+
+JobSystem::~JobSystem()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping.store(true);
+    }
+    m_workAvailable.notify_all();
+
+    for (auto &worker : m_workers) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+}
+
+JobSystem::JobId JobSystem::schedule(std::function<void()> work,
+                                     const QVector<JobId> &dependencies,
+                                     std::function<void()> onCompleted)
+{
+    auto job = std::make_shared<Job>();
+    job->work = std::move(work);
+    job->onCompleted = std::move(onCompleted);
+
+    bool ready = false;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        job->id = m_nextJobId++;
+
+        // 仍在任务表里的依赖才算未满足；已完成的依赖已被移除
+        for (JobId dependency : dependencies) {
+            auto it = m_pendingJobs.find(dependency);
+            if (it != m_pendingJobs.end()) {
+                it.value()->dependents.push_back(job->id);
+                ++job->pendingDependencies;
+            }
+        }
+
+        m_pendingJobs.insert(job->id, job);
+        ++m_unfinishedJobs;
+
+        if (job->pendingDependencies == 0) {
+            enqueueReady(job);
+            ready = true;
+        }
+    }
+
+    if (ready) {
+        m_workAvailable.notify_one();
+    }
+    return job->id;
+}
+
+void JobSystem::waitForAll()
+{
+    // 等待期间调用线程也参与执行，加速清空任务图
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (m_unfinishedJobs > 0) {
+        std::shared_ptr<Job> job;
+        bool popped = false;
+        for (auto &queue : m_queues) {
+            if (!queue.empty()) {
+                job = std::move(queue.front());
+                queue.pop_front();
+                popped = true;
+                break;
+            }
+        }
+
+        if (popped) {
+            lock.unlock();
+            runJob(job);
+            lock.lock();
+        } else {
+            // 队列已空但还有任务在工作线程上执行，等它们收尾
+            m_allIdle.wait(lock, [this]() {
+                bool queueHasWork = false;
+                for (const auto &queue : m_queues) {
+                    if (!queue.empty()) {
+                        queueHasWork = true;
+                        break;
+                    }
+                }
+                return m_unfinishedJobs == 0 || queueHasWork;
+            });
+        }
+    }
+}
+
+void JobSystem::workerLoop(int workerIndex)
+{
+    while (true) {
+        std::shared_ptr<Job> job;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_workAvailable.wait(lock, [this, workerIndex, &job]() {
+                return m_stopping.load() || tryPopJob(workerIndex, job);
+            });
+            if (!job && m_stopping.load()) {
+                return;
+            }
+        }
+        runJob(job);
+    }
+}
+
+bool JobSystem::tryPopJob(int preferredQueue, std::shared_ptr<Job> &job)
+{
+    // 先取自己的队列（后进先出，缓存更热）
+    auto &own = m_queues[static_cast<size_t>(preferredQueue)];
+    if (!own.empty()) {
+        job = std::move(own.back());
+        own.pop_back();
+        return true;
+    }
+
+    // 自己的队列空了，从其他队列头部窃取（先进先出，减少冲突）
+    for (size_t i = 0; i < m_queues.size(); ++i) {
+        if (static_cast<int>(i) == preferredQueue) {
+            continue;
+        }
+        auto &victim = m_queues[i];
+        if (!victim.empty()) {
+            job = std::move(victim.front());
+            victim.pop_front();
+            return true;
+        }
+    }
+    return false;
+}
+
+void JobSystem::runJob(const std::shared_ptr<Job> &job)
+{
+    if (job->work) {
+        job->work();
+    }
+
+    // 完成回调投递回主线程执行，触碰QObject/QML是安全的。
+    // 优先走本线程的SPSC信箱（帧循环批量排空，无事件分配），
+    // 信箱满或未挂接枢纽时回退到队列连接，回调不丢失
+    if (job->onCompleted) {
+        bool delivered = false;
+        if (m_completionHub) {
+            WorkerMailbox *mailbox =
+                m_completionHub->mailboxForCurrentThread(QStringLiteral("JobSystem"));
+            delivered = mailbox->tryPost(job->onCompleted);
+        }
+        if (!delivered) {
+            QMetaObject::invokeMethod(this, job->onCompleted, Qt::QueuedConnection);
+        }
+    }
+
+    bool hasNewWork = false;
+    bool allDone = false;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_pendingJobs.remove(job->id);
+        --m_unfinishedJobs;
+
+        // 结算依赖图：唤醒依赖数归零的后继任务
+        for (JobId dependentId : job->dependents) {
+            auto it = m_pendingJobs.find(dependentId);
+            if (it != m_pendingJobs.end() && --it.value()->pendingDependencies == 0) {
+                enqueueReady(it.value());
+                hasNewWork = true;
+            }
+        }
+
+        allDone = (m_unfinishedJobs == 0);
+    }
+
+    if (hasNewWork) {
+        m_workAvailable.notify_all();
+    }
+    if (allDone || hasNewWork) {
+        m_allIdle.notify_all();
+    }
+}
+
+void JobSystem::enqueueReady(const std::shared_ptr<Job> &job)
+{
+    // 放入当前最短的队列，粗粒度地均衡初始负载
+    size_t shortest = 0;
+    for (size_t i = 1; i < m_queues.size(); ++i) {
+        if (m_queues[i].size() < m_queues[shortest].size()) {
+            shortest = i;
+        }
+    }
+    m_queues[shortest].push_back(job);
+}
@@ -5,21 +5,83 @@
  * 创建时间: 2026-02-18
  */
 #include "core/LoadingScene.h"
+#include "core/ResourceManager.h"
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
 #include <QDebug>
 
+namespace {
+const QString kManifestPath = QStringLiteral(":/resources/configs/loading_manifest.json");
+}
+
 LoadingScene::LoadingScene(QObject* parent)
     : Scene("Loading", parent) {
 }
 
 bool LoadingScene::load(ResourceManager* resourceManager) {
-    Q_UNUSED(resourceManager)
     qDebug() << "LoadingScene: 加载资源";
+
+    resourceManager_ = resourceManager;
+
+    // 阶段一：解析清单（主线程，清单很小）
+    pendingResources_ = parseManifest(kManifestPath);
+    qDebug() << "LoadingScene: 清单解析完成，共" << pendingResources_.size() << "个资源";
     return true;
 }
 
 void LoadingScene::onEnter(const QJsonObject& sceneData) {
     Q_UNUSED(sceneData)
     qDebug() << "LoadingScene: 进入场景";
+
+    progress_ = 0.0f;
+    completed_ = false;
+
+    if (!resourceManager_ || pendingResources_.isEmpty()) {
+        // 没有清单条目时立即完成
+        progress_ = 1.0f;
+        completed_ = true;
+        emit loadingProgressChanged(progress_);
+        emit loadingCompleted();
+        return;
+    }
+
+    // 阶段二起交给流式管线：全部条目一次性入队，工作线程
+    // 并行完成文件读取与解码，主线程按帧预算注册到缓存，
+    // 各阶段在不同资源间重叠推进
+    for (const QString& path : pendingResources_) {
+        if (path.endsWith(".png") || path.endsWith(".jpg") ||
+            path.endsWith(".jpeg") || path.endsWith(".bmp")) {
+            resourceManager_->loadResourceAsync(path, ResourceType::Texture,
+                                                LoadPriority::Normal);
+        } else if (path.endsWith(".ttf") || path.endsWith(".otf")) {
+            resourceManager_->loadResourceAsync(path, ResourceType::Font,
+                                                LoadPriority::Normal);
+        } else if (path.endsWith(".wav") || path.endsWith(".mp3") ||
+                   path.endsWith(".ogg")) {
+            resourceManager_->loadResourceAsync(path, ResourceType::Audio,
+                                                LoadPriority::Normal);
+        } else if (path.endsWith(".json")) {
+            resourceManager_->loadResourceAsync(path, ResourceType::Config,
+                                                LoadPriority::Normal);
+        } else {
+            qWarning() << "LoadingScene: 清单中无法识别的资源类型:" << path;
+        }
+    }
+
+    // 进度直接转发ResourceManager按完成数计算的值
+    connect(resourceManager_, &ResourceManager::loadingProgressChanged,
+            this, [this]() {
+                progress_ = resourceManager_->loadingProgress();
+                emit loadingProgressChanged(progress_);
+
+                if (!completed_ && !resourceManager_->isLoading()) {
+                    completed_ = true;
+                    qDebug() << "LoadingScene: 初始加载完成";
+                    emit loadingCompleted();
+                }
+            });
 }
 
 void LoadingScene::update(float deltaTime) {
@@ -28,8 +90,45 @@ void LoadingScene::update(float deltaTime) {
 
 void LoadingScene::onExit() {
     qDebug() << "LoadingScene: 退出场景";
+
+    if (resourceManager_) {
+        disconnect(resourceManager_, nullptr, this, nullptr);
+    }
 }
 
 void LoadingScene::unload() {
     qDebug() << "LoadingScene: 卸载资源";
+    pendingResources_.clear();
+    progress_ = 0.0f;
+    completed_ = false;
+}
+
+QStringList LoadingScene::parseManifest(const QString& manifestPath) const {
+    QStringList resources;
+
+    QFile file(manifestPath);
+    if (!file.exists()) {
+        qDebug() << "LoadingScene: 加载清单不存在:" << manifestPath;
+        return resources;
+    }
+    if (!file.open(QIODevice::ReadOnly)) {
+        qWarning() << "LoadingScene: 无法读取加载清单:" << manifestPath;
+        return resources;
+    }
+
+    QJsonParseError error;
+    const QJsonDocument doc = QJsonDocument::fromJson(file.readAll(), &error);
+    if (error.error != QJsonParseError::NoError) {
+        qWarning() << "LoadingScene: 清单解析失败:" << error.errorString();
+        return resources;
+    }
+
+    const QJsonArray array = doc.object().value("resources").toArray();
+    for (const QJsonValue& value : array) {
+        const QString path = value.toString();
+        if (!path.isEmpty()) {
+            resources.append(path);
+        }
+    }
+    return resources;
 }
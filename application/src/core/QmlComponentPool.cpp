@@ -0,0 +1,125 @@
+/*
+ * 文件名: QmlComponentPool.cpp
+ * 说明: QML组件对象池实现
+ * 作者: 彭承康
+ * 创建时间: 2026-08-28
+ */
+#include "core/QmlComponentPool.h"
+
+#include <QQmlComponent>
+#include <QQmlContext>
+#include <QQmlEngine>
+#include <QQmlProperty>
+#include <QDebug>
+
+QmlComponentPool::QmlComponentPool(QQmlEngine *engine, QObject *parent)
+    : QObject(parent)
+    , m_engine(engine)
+{
+}
+
+QmlComponentPool::~QmlComponentPool()
+{
+    for (auto it = m_pools.begin(); it != m_pools.end(); ++it) {
+        for (QObject *object : it.value().idle) {
+            delete object;
+        }
+    }
+}
+
+void QmlComponentPool::preload(const QString &componentUrl, int count)
+{
+    QQmlComponent *component = ensureComponent(componentUrl);
+    if (!component) {
+        return;
+    }
+
+    PoolEntry &entry = m_pools[componentUrl];
+    while (entry.idle.size() < count) {
+        QObject *instance = createInstance(entry);
+        if (!instance) {
+            break;
+        }
+        entry.idle.append(instance);
+    }
+
+    qDebug() << "QmlComponentPool: 预热" << componentUrl
+             << "空闲实例" << entry.idle.size();
+}
+
+QObject* QmlComponentPool::acquire(const QString &componentUrl)
+{
+    PoolEntry &entry = m_pools[componentUrl];
+
+    if (!entry.idle.isEmpty()) {
+        return entry.idle.takeLast();
+    }
+
+    // 池为空时即时创建：组件已编译缓存，只付实例化成本
+    if (!ensureComponent(componentUrl)) {
+        return nullptr;
+    }
+    return createInstance(entry);
+}
+
+void QmlComponentPool::release(const QString &componentUrl, QObject *object)
+{
+    if (!object) {
+        return;
+    }
+
+    auto it = m_pools.find(componentUrl);
+    if (it == m_pools.end()) {
+        qWarning() << "QmlComponentPool: 归还了未知组件的实例" << componentUrl;
+        delete object;
+        return;
+    }
+
+    // 隐藏并脱离可视树，保留对象本身等待复用
+    QQmlProperty::write(object, QStringLiteral("visible"), false);
+    QQmlProperty::write(object, QStringLiteral("parent"),
+                        QVariant::fromValue<QObject*>(nullptr));
+    object->setParent(this);
+
+    it.value().idle.append(object);
+}
+
+int QmlComponentPool::idleCount(const QString &componentUrl) const
+{
+    auto it = m_pools.constFind(componentUrl);
+    return it == m_pools.constEnd() ? 0 : it.value().idle.size();
+}
+
+QQmlComponent* QmlComponentPool::ensureComponent(const QString &componentUrl)
+{
+    PoolEntry &entry = m_pools[componentUrl];
+    if (entry.component) {
+        return entry.component.get();
+    }
+
+    auto component = std::make_unique<QQmlComponent>(m_engine, QUrl(componentUrl));
+    if (component->isError()) {
+        qWarning() << "QmlComponentPool: 组件编译失败" << componentUrl
+                   << component->errorString();
+        return nullptr;
+    }
+
+    entry.component = std::move(component);
+    return entry.component.get();
+}
+
+QObject* QmlComponentPool::createInstance(PoolEntry &entry)
+{
+    QObject *instance = entry.component->create(m_engine->rootContext());
+    if (!instance) {
+        qWarning() << "QmlComponentPool: 实例化失败"
+                   << entry.component->errorString();
+        return nullptr;
+    }
+
+    // 池持有所有权，避免实例被QML垃圾回收
+    QQmlEngine::setObjectOwnership(instance, QQmlEngine::CppOwnership);
+    instance->setParent(this);
+    QQmlProperty::write(instance, QStringLiteral("visible"), false);
+    return instance;
+}
@@ -7,27 +7,48 @@
  */
 
 #include "core/ResourceManager.h"
+#include "utils/MemoryTelemetry.h"
 #include <QCoreApplication>
 #include <QDebug>
 #include <QDir>
 #include <QStandardPaths>
+#include <QFile>
 #include <QFileInfo>
 #include <QPixmap>
 #include <QFont>
 #include <QFontDatabase>
+#include <QBuffer>
+#include <QImageReader>
+#include <QThread>
+#include <QTimer>
+#include <limits>
 
 ResourceManager::ResourceManager(QObject *parent)
     : QObject(parent)
+    , m_totalMemoryUsage(0)
+    , m_maxMemoryUsage(100 * 1024 * 1024) // 100MB默认内存上限
+    , m_loadingProgress(0.0f)
+    , m_isLoading(false)
+    , m_pendingLoads(0)
+    , m_completedLoads(0)
     , m_loadedResourceCount(0)
     , m_totalResourceSize(0)
     , m_maxCacheSize(100 * 1024 * 1024) // 100MB默认缓存大小
 {
     qDebug() << "ResourceManager: 构造函数调用";
-    
+
     // 设置默认资源路径
     m_resourcePaths << ":/resources"
                    << QStandardPaths::writableLocation(QStandardPaths::AppDataLocation) + "/resources"
                    << QCoreApplication::applicationDirPath() + "/resources";
+
+    // 主线程收尾定时器：按字节预算分帧处理工作线程的解码结果，
+    // 在内存超预算时执行增量LRU淘汰，并降级闲置的全分辨率纹理
+    m_finalizeTimer = new QTimer(this);
+    connect(m_finalizeTimer, &QTimer::timeout, this, &ResourceManager::finalizeDecodedResources);
+    connect(m_finalizeTimer, &QTimer::timeout, this, &ResourceManager::evictLruResources);
+    connect(m_finalizeTimer, &QTimer::timeout, this, &ResourceManager::downgradeIdleTextures);
+    m_finalizeTimer->start(FINALIZE_INTERVAL_MS);
 }
 
 ResourceManager::~ResourceManager()
@@ -41,6 +62,12 @@ bool ResourceManager::initialize()
     qDebug() << "ResourceManager: 开始初始化";
     
     try {
+        // 优先挂载打包资源，未命中的路径回退到零散文件
+        const QString defaultPack = QCoreApplication::applicationDirPath() + "/assets.flpk";
+        if (QFile::exists(defaultPack)) {
+            mountAssetPack(defaultPack);
+        }
+
         // 设置资源路径
         setupResourcePaths();
         
@@ -52,7 +79,10 @@ bool ResourceManager::initialize()
         
         // 预加载核心资源
         preloadCoreResources();
-        
+
+        // 启动流式加载线程池
+        startStreamWorkers();
+
         qDebug() << "ResourceManager: 初始化成功";
         return true;
         
@@ -162,31 +192,150 @@ QString ResourceManager::findResourcePath(const QString& fileName) const
 
 QPixmap ResourceManager::loadTexture(const QString &fileName)
 {
-    // 检查缓存
-    if (m_textureCache.contains(fileName)) {
+    // 缓存命中：记录访问节拍；降级后的纹理在此补发升级请求
+    auto tierIt = m_textureTiers.find(fileName);
+    if (tierIt != m_textureTiers.end() && m_textureCache.contains(fileName)) {
+        tierIt->lastUsedTick = m_residencyTick;
+        if (tierIt->tier == TextureResidency::Placeholder && !tierIt->upgradeQueued) {
+            queueTextureUpgrade(fileName);
+        }
         return m_textureCache[fileName];
     }
-    
-    // 查找文件路径
-    QString fullPath = findResourcePath(fileName);
-    if (fullPath.isEmpty()) {
-        qWarning() << "ResourceManager: 纹理文件未找到:" << fileName;
+
+    // 首次加载：同步只解码占位图，全分辨率走后台流式升级
+    bool isFullRes = false;
+    QPixmap placeholder = decodePlaceholderTexture(fileName, isFullRes);
+    if (placeholder.isNull()) {
+        qWarning() << "ResourceManager: 纹理加载失败:" << fileName;
         return QPixmap();
     }
-    
-    // 加载纹理
-    QPixmap pixmap(fullPath);
-    if (pixmap.isNull()) {
-        qWarning() << "ResourceManager: 纹理加载失败:" << fullPath;
+
+    m_textureCache[fileName] = placeholder;
+    m_loadedResourceCount++;
+
+    TextureTierInfo tier;
+    tier.tier = isFullRes ? TextureResidency::Full : TextureResidency::Placeholder;
+    tier.placeholder = placeholder;
+    tier.lastUsedTick = m_residencyTick;
+    m_textureTiers.insert(fileName, tier);
+
+    if (!isFullRes) {
+        queueTextureUpgrade(fileName);
+    }
+
+    qDebug() << "ResourceManager: 纹理加载成功:" << fileName
+             << (isFullRes ? "(全分辨率)" : "(占位图，后台升级中)");
+    return placeholder;
+}
+
+TextureResidency ResourceManager::textureResidency(const QString &imagePath) const
+{
+    auto it = m_textureTiers.constFind(imagePath);
+    return it != m_textureTiers.constEnd() ? it->tier : TextureResidency::None;
+}
+
+QPixmap ResourceManager::decodePlaceholderTexture(const QString &fileName, bool &isFullRes)
+{
+    isFullRes = false;
+
+    // 资源包命中时从映射内存解码，未命中回退到零散文件
+    QByteArray packed = readPackedResource(fileName);
+    QBuffer buffer;
+    QImageReader reader;
+    if (!packed.isEmpty()) {
+        buffer.setData(packed);
+        buffer.open(QIODevice::ReadOnly);
+        reader.setDevice(&buffer);
+    } else {
+        QString fullPath = findResourcePath(fileName);
+        if (fullPath.isEmpty()) {
+            qWarning() << "ResourceManager: 纹理文件未找到:" << fileName;
+            return QPixmap();
+        }
+        reader.setFileName(fullPath);
+    }
+
+    // 解码期缩放：多数格式只解码到占位尺寸，不产生全尺寸像素
+    bool downscaled = false;
+    const QSize sourceSize = reader.size();
+    if (sourceSize.isValid()
+        && (sourceSize.width() > PLACEHOLDER_MAX_DIMENSION
+            || sourceSize.height() > PLACEHOLDER_MAX_DIMENSION)) {
+        QSize scaled = sourceSize;
+        scaled.scale(PLACEHOLDER_MAX_DIMENSION, PLACEHOLDER_MAX_DIMENSION,
+                     Qt::KeepAspectRatio);
+        reader.setScaledSize(scaled);
+        downscaled = true;
+    }
+
+    QImage image = reader.read();
+    if (image.isNull()) {
         return QPixmap();
     }
-    
-    // 添加到缓存
-    m_textureCache[fileName] = pixmap;
-    m_loadedResourceCount++;
-    
-    qDebug() << "ResourceManager: 纹理加载成功:" << fileName;
-    return pixmap;
+
+    // 无法预读源尺寸的格式：读出后再缩到占位规格
+    if (image.width() > PLACEHOLDER_MAX_DIMENSION
+        || image.height() > PLACEHOLDER_MAX_DIMENSION) {
+        image = image.scaled(PLACEHOLDER_MAX_DIMENSION, PLACEHOLDER_MAX_DIMENSION,
+                             Qt::KeepAspectRatio, Qt::SmoothTransformation);
+        downscaled = true;
+    }
+
+    isFullRes = !downscaled;
+    return QPixmap::fromImage(image);
+}
+
+void ResourceManager::queueTextureUpgrade(const QString &fileName)
+{
+    auto it = m_textureTiers.find(fileName);
+    if (it != m_textureTiers.end()) {
+        it->upgradeQueued = true;
+    }
+
+    // 升级走流式管线：工作线程解码全尺寸图像，主线程在
+    // finalizeDecodedResources中按字节预算分帧完成像素上传
+    loadResourceAsync(fileName, ResourceType::Texture, LoadPriority::Normal);
+}
+
+void ResourceManager::downgradeIdleTextures()
+{
+    ++m_residencyTick;
+
+    int downgraded = 0;
+    for (auto it = m_textureTiers.begin();
+         it != m_textureTiers.end() && downgraded < MAX_DOWNGRADES_PER_TICK; ++it) {
+        // fullSize>0表示全分辨率经流式升级驻留过，才有降级余地
+        if (it->tier != TextureResidency::Full || it->fullSize <= 0) {
+            continue;
+        }
+        if (m_residencyTick - it->lastUsedTick < TEXTURE_IDLE_DOWNGRADE_TICKS) {
+            continue;
+        }
+
+        // 被钉住的纹理（当前场景关键资源）不参与降级
+        auto resIt = m_resources.find(it.key());
+        if (resIt != m_resources.end() && (*resIt)->pinned) {
+            continue;
+        }
+
+        // 降回占位图：释放全分辨率像素，低清副本瞬时回显
+        m_textureCache[it.key()] = it->placeholder;
+        it->tier = TextureResidency::Placeholder;
+        it->fullSize = 0;
+        it->upgradeQueued = false;
+
+        if (resIt != m_resources.end()) {
+            m_totalResourceSize -= (*resIt)->size;
+            m_resources.erase(resIt);
+            updateMemoryUsage();
+            emit resourceCountChanged();
+        }
+        downgraded++;
+    }
+
+    if (downgraded > 0) {
+        qDebug() << "ResourceManager: 降级了" << downgraded << "个闲置纹理为占位图";
+    }
 }
 
 QFont ResourceManager::loadFont(const QString &fileName, int pointSize)
@@ -230,33 +379,40 @@ QFont ResourceManager::loadFont(const QString &fileName, int pointSize)
 
 void ResourceManager::preloadResources(const QStringList &resourceList)
 {
-    qDebug() << "ResourceManager: 预加载资源列表，共" << resourceList.size() << "个资源";
-    
+    qDebug() << "ResourceManager: 预加载资源入队，共" << resourceList.size() << "个资源";
+
+    // 预热请求走与即时加载相同的流式队列，但使用最低优先级，
+    // 不会阻塞战斗中打开界面等高优先级加载
     for (const QString& resource : resourceList) {
-        if (resource.endsWith(".png") || resource.endsWith(".jpg") || 
+        if (resource.endsWith(".png") || resource.endsWith(".jpg") ||
             resource.endsWith(".jpeg") || resource.endsWith(".bmp")) {
-            loadTexture(resource);
+            loadResourceAsync(resource, ResourceType::Texture, LoadPriority::Preload);
         } else if (resource.endsWith(".ttf") || resource.endsWith(".otf")) {
-            loadFont(resource);
-        } else if (resource.endsWith(".wav") || resource.endsWith(".mp3") || 
+            loadResourceAsync(resource, ResourceType::Font, LoadPriority::Preload);
+        } else if (resource.endsWith(".wav") || resource.endsWith(".mp3") ||
                   resource.endsWith(".ogg")) {
-            // TODO: 实现音频加载
-            qDebug() << "ResourceManager: 音频加载暂未实现:" << resource;
+            loadResourceAsync(resource, ResourceType::Audio, LoadPriority::Preload);
+        } else if (resource.endsWith(".json")) {
+            loadResourceAsync(resource, ResourceType::Config, LoadPriority::Preload);
+        } else {
+            qDebug() << "ResourceManager: 未识别的资源类型，跳过预热:" << resource;
         }
     }
-    
-    qDebug() << "ResourceManager: 资源预加载完成";
 }
 
 void ResourceManager::cleanup()
 {
     qDebug() << "ResourceManager: 开始清理资源";
-    
+
+    // 先停掉加载线程，避免清理期间还有解码结果写入
+    stopStreamWorkers();
+
     int textureCount = m_textureCache.size();
     int soundCount = 0; // m_soundCache.size();
     int fontCount = m_fontCache.size();
     
     m_textureCache.clear();
+    m_textureTiers.clear();
     // m_soundCache.clear();
     m_fontCache.clear();
     
@@ -300,6 +456,7 @@ QVariant ResourceManager::loadResource(const QString &resourcePath, ResourceType
     if (m_resources.contains(resourcePath)) {
         auto &info = m_resources[resourcePath];
         info->refCount++;
+        touchResource(info);
         return info->data;
     }
 
@@ -331,6 +488,7 @@ QVariant ResourceManager::loadResource(const QString &resourcePath, ResourceType
         info->refCount = 1;
         info->isLoaded = true;
         info->data = data;
+        touchResource(info);
         m_resources[resourcePath] = info;
         emit resourceLoaded(resourcePath, true);
         emit resourceCountChanged();
@@ -341,6 +499,13 @@ QVariant ResourceManager::loadResource(const QString &resourcePath, ResourceType
 
 QVariant ResourceManager::loadTextureResource(const QString &path)
 {
+    QByteArray packed = readPackedResource(path);
+    if (!packed.isEmpty()) {
+        QPixmap pixmap;
+        pixmap.loadFromData(packed);
+        return pixmap.isNull() ? QVariant() : QVariant::fromValue(pixmap);
+    }
+
     QString fullPath = findResourcePath(path);
     if (fullPath.isEmpty()) {
         return QVariant();
@@ -385,6 +550,12 @@ QVariant ResourceManager::loadFontResource(const QString &path)
 
 QVariant ResourceManager::loadConfigResource(const QString &path)
 {
+    QByteArray packed = readPackedResource(path);
+    if (!packed.isEmpty()) {
+        QJsonDocument doc = QJsonDocument::fromJson(packed);
+        return doc.isNull() ? QVariant() : QVariant::fromValue(doc.object());
+    }
+
     QString fullPath = findResourcePath(path);
     if (fullPath.isEmpty()) {
         return QVariant();
@@ -397,12 +568,450 @@ QVariant ResourceManager::loadConfigResource(const QString &path)
     return doc.isNull() ? QVariant() : QVariant::fromValue(doc.object());
 }
 
-QFuture<QVariant> ResourceManager::loadResourceAsync(const QString &resourcePath, ResourceType type)
+QFuture<QVariant> ResourceManager::loadResourceAsync(const QString &resourcePath, ResourceType type,
+                                                     LoadPriority priority)
+{
+    auto promise = std::make_shared<QPromise<QVariant>>();
+    QFuture<QVariant> future = promise->future();
+    promise->start();
+
+    // 缓存命中直接完成，不进队列
+    auto it = m_resources.find(resourcePath);
+    if (it != m_resources.end()) {
+        (*it)->refCount++;
+        touchResource(*it);
+        promise->addResult((*it)->data);
+        promise->finish();
+        return future;
+    }
+
+    StreamRequest request;
+    request.path = resourcePath;
+    request.type = type;
+    request.priority = priority;
+    request.generation = m_loadGeneration.load();
+    request.promise = promise;
+    enqueueStreamRequest(request);
+
+    return future;
+}
+
+void ResourceManager::cancelPendingLoads()
+{
+    // 递增代号：已出队、正在解码的请求其结果在主线程收尾时作废
+    m_loadGeneration.fetch_add(1);
+
+    int dropped = 0;
+    {
+        QMutexLocker locker(&m_streamMutex);
+        dropped = m_highQueue.size() + m_normalQueue.size() + m_preloadQueue.size();
+
+        for (auto *queue : { &m_highQueue, &m_normalQueue, &m_preloadQueue }) {
+            while (!queue->isEmpty()) {
+                StreamRequest request = queue->dequeue();
+                if (request.promise) {
+                    request.promise->finish();
+                }
+            }
+        }
+    }
+
+    if (dropped > 0) {
+        m_pendingLoads = qMax(0, m_pendingLoads - dropped);
+        updateStreamProgress();
+        qDebug() << "ResourceManager: 已取消" << dropped << "个排队中的加载请求";
+    }
+}
+
+void ResourceManager::startStreamWorkers()
+{
+    if (!m_streamWorkers.empty()) {
+        return;
+    }
+
+    // 预留主线程与渲染：工作线程数 = 硬件线程数的一半，至少1个
+    const int workerCount = qMax(1, QThread::idealThreadCount() / 2);
+    m_streamStopping.store(false);
+    m_streamWorkers.reserve(static_cast<size_t>(workerCount));
+    for (int i = 0; i < workerCount; ++i) {
+        m_streamWorkers.emplace_back([this]() { streamWorkerLoop(); });
+    }
+
+    qDebug() << "ResourceManager: 流式加载线程池已启动，共" << workerCount << "个线程";
+}
+
+void ResourceManager::stopStreamWorkers()
 {
-    Q_UNUSED(resourcePath)
-    Q_UNUSED(type)
-    // 异步加载预留接口，当前返回空 future
-    return QFuture<QVariant>();
+    if (m_streamWorkers.empty()) {
+        return;
+    }
+
+    {
+        QMutexLocker locker(&m_streamMutex);
+        m_streamStopping.store(true);
+    }
+    m_streamCondition.wakeAll();
+
+    for (auto &worker : m_streamWorkers) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+    m_streamWorkers.clear();
+
+    // 丢弃残留请求与未收尾的解码结果
+    QMutexLocker locker(&m_streamMutex);
+    for (auto *queue : { &m_highQueue, &m_normalQueue, &m_preloadQueue }) {
+        while (!queue->isEmpty()) {
+            StreamRequest request = queue->dequeue();
+            if (request.promise) {
+                request.promise->finish();
+            }
+        }
+    }
+    while (!m_finalizeQueue.isEmpty()) {
+        DecodedResource decoded = m_finalizeQueue.dequeue();
+        if (decoded.promise) {
+            decoded.promise->finish();
+        }
+    }
+    m_pendingLoads = 0;
+}
+
+void ResourceManager::enqueueStreamRequest(const StreamRequest &request)
+{
+    {
+        QMutexLocker locker(&m_streamMutex);
+        switch (request.priority) {
+        case LoadPriority::High:
+            m_highQueue.enqueue(request);
+            break;
+        case LoadPriority::Normal:
+            m_normalQueue.enqueue(request);
+            break;
+        case LoadPriority::Preload:
+            m_preloadQueue.enqueue(request);
+            break;
+        }
+    }
+
+    m_pendingLoads++;
+    updateStreamProgress();
+    m_streamCondition.wakeOne();
+}
+
+bool ResourceManager::tryDequeueStreamRequest(StreamRequest &request)
+{
+    if (!m_highQueue.isEmpty()) {
+        request = m_highQueue.dequeue();
+        return true;
+    }
+    if (!m_normalQueue.isEmpty()) {
+        request = m_normalQueue.dequeue();
+        return true;
+    }
+    if (!m_preloadQueue.isEmpty()) {
+        request = m_preloadQueue.dequeue();
+        return true;
+    }
+    return false;
+}
+
+void ResourceManager::streamWorkerLoop()
+{
+    while (true) {
+        StreamRequest request;
+        {
+            QMutexLocker locker(&m_streamMutex);
+            while (!m_streamStopping.load() && !tryDequeueStreamRequest(request)) {
+                m_streamCondition.wait(&m_streamMutex);
+            }
+            if (m_streamStopping.load()) {
+                return;
+            }
+        }
+
+        // 解码发生在工作线程，结果交由主线程收尾；
+        // 即使请求已作废也入队，由主线程统一做进度结算
+        DecodedResource decoded;
+        if (request.generation == m_loadGeneration.load()) {
+            decoded = decodeStreamRequest(request);
+        } else {
+            decoded.path = request.path;
+            decoded.type = request.type;
+            decoded.generation = request.generation;
+            decoded.promise = request.promise;
+        }
+
+        QMutexLocker locker(&m_streamMutex);
+        m_finalizeQueue.enqueue(decoded);
+    }
+}
+
+ResourceManager::DecodedResource ResourceManager::decodeStreamRequest(const StreamRequest &request)
+{
+    DecodedResource decoded;
+    decoded.path = request.path;
+    decoded.type = request.type;
+    decoded.generation = request.generation;
+    decoded.promise = request.promise;
+
+    // 资源包命中时从映射内存解码，省掉文件打开
+    QByteArray packed = readPackedResource(request.path);
+    if (!packed.isEmpty()) {
+        switch (request.type) {
+        case ResourceType::Texture:
+            decoded.image = QImage::fromData(packed);
+            decoded.size = decoded.image.sizeInBytes();
+            return decoded;
+        case ResourceType::Config: {
+            QJsonDocument doc = QJsonDocument::fromJson(packed);
+            if (!doc.isNull()) {
+                decoded.data = QVariant::fromValue(doc.object());
+                decoded.size = packed.size();
+            }
+            return decoded;
+        }
+        default:
+            // 音频/字体仍走文件路径，由主线程或AudioManager处理
+            break;
+        }
+    }
+
+    QString fullPath = findResourcePath(request.path);
+    if (fullPath.isEmpty()) {
+        qWarning() << "ResourceManager: 资源文件未找到:" << request.path;
+        return decoded;
+    }
+
+    switch (request.type) {
+    case ResourceType::Texture:
+        // QImage解码线程安全，QPixmap转换留给主线程
+        decoded.image = QImage(fullPath);
+        decoded.size = decoded.image.sizeInBytes();
+        break;
+    case ResourceType::Audio:
+        // 音频只定位路径，实际加载播放由AudioManager负责
+        decoded.data = QVariant(fullPath);
+        decoded.size = QFileInfo(fullPath).size();
+        break;
+    case ResourceType::Font:
+        // 字体注册（QFontDatabase）必须在主线程，这里只传路径
+        decoded.data = QVariant(fullPath);
+        decoded.size = QFileInfo(fullPath).size();
+        break;
+    case ResourceType::Config: {
+        QFile file(fullPath);
+        if (file.open(QIODevice::ReadOnly)) {
+            QByteArray raw = file.readAll();
+            QJsonDocument doc = QJsonDocument::fromJson(raw);
+            if (!doc.isNull()) {
+                decoded.data = QVariant::fromValue(doc.object());
+                decoded.size = raw.size();
+            }
+        }
+        break;
+    }
+    default:
+        qWarning() << "ResourceManager: 不支持流式加载的资源类型:" << static_cast<int>(request.type);
+        break;
+    }
+
+    return decoded;
+}
+
+void ResourceManager::finalizeDecodedResources()
+{
+    qint64 budget = FINALIZE_BYTE_BUDGET;
+    while (budget > 0) {
+        DecodedResource decoded;
+        {
+            QMutexLocker locker(&m_streamMutex);
+            if (m_finalizeQueue.isEmpty()) {
+                break;
+            }
+            decoded = m_finalizeQueue.dequeue();
+        }
+
+        // 作废请求只结算进度，不写缓存、不计入预算
+        if (decoded.generation != m_loadGeneration.load()) {
+            if (decoded.type == ResourceType::Texture) {
+                // 允许该纹理下次访问时重新排队升级
+                auto tierIt = m_textureTiers.find(decoded.path);
+                if (tierIt != m_textureTiers.end()) {
+                    tierIt->upgradeQueued = false;
+                }
+            }
+            if (decoded.promise) {
+                decoded.promise->finish();
+            }
+            m_pendingLoads = qMax(0, m_pendingLoads - 1);
+            updateStreamProgress();
+            continue;
+        }
+
+        QVariant data = decoded.data;
+        if (decoded.type == ResourceType::Texture && !decoded.image.isNull()) {
+            // 主线程完成相当于GPU上传的像素拷贝，受字节预算分帧
+            QPixmap pixmap = QPixmap::fromImage(decoded.image);
+            data = QVariant::fromValue(pixmap);
+            m_textureCache[decoded.path] = pixmap;
+
+            // 全分辨率落地：更新常驻级别，记录大小供降级结算
+            auto tierIt = m_textureTiers.find(decoded.path);
+            if (tierIt != m_textureTiers.end()) {
+                tierIt->tier = TextureResidency::Full;
+                tierIt->fullSize = decoded.size;
+                tierIt->upgradeQueued = false;
+            }
+        } else if (decoded.type == ResourceType::Font && data.isValid()) {
+            int fontId = QFontDatabase::addApplicationFont(data.toString());
+            QStringList families = (fontId != -1)
+                ? QFontDatabase::applicationFontFamilies(fontId) : QStringList();
+            data = families.isEmpty() ? QVariant()
+                                      : QVariant::fromValue(QFont(families.first()));
+        }
+
+        const bool success = data.isValid();
+        if (success) {
+            auto info = std::make_shared<ResourceInfo>();
+            info->path = decoded.path;
+            info->type = decoded.type;
+            info->size = decoded.size;
+            info->loadTime = QDateTime::currentDateTime();
+            info->refCount = 1;
+            info->isLoaded = true;
+            info->data = data;
+            touchResource(info);
+            m_resources[decoded.path] = info;
+            m_totalResourceSize += decoded.size;
+            updateMemoryUsage();
+            checkMemoryLimit();
+            emit resourceCountChanged();
+        }
+        emit resourceLoaded(decoded.path, success);
+
+        if (decoded.promise) {
+            if (success) {
+                decoded.promise->addResult(data);
+            }
+            decoded.promise->finish();
+        }
+
+        m_completedLoads++;
+        m_pendingLoads = qMax(0, m_pendingLoads - 1);
+        updateStreamProgress();
+        budget -= qMax<qint64>(decoded.size, 64 * 1024);
+    }
+}
+
+bool ResourceManager::mountAssetPack(const QString &packPath)
+{
+    auto pack = std::make_unique<AssetPack>();
+    if (!pack->open(packPath)) {
+        return false;
+    }
+    m_assetPack = std::move(pack);
+    qDebug() << "ResourceManager: 资源包已挂载:" << packPath;
+    return true;
+}
+
+QByteArray ResourceManager::readPackedResource(const QString &path) const
+{
+    if (!m_assetPack || !m_assetPack->contains(path)) {
+        return QByteArray();
+    }
+    return m_assetPack->read(path);
+}
+
+void ResourceManager::setMemoryBudget(qint64 bytes)
+{
+    m_maxMemoryUsage = bytes;
+    qDebug() << "ResourceManager: 设置内存预算:" << bytes << "字节";
+}
+
+void ResourceManager::pinResource(const QString &resourcePath)
+{
+    auto it = m_resources.find(resourcePath);
+    if (it != m_resources.end()) {
+        (*it)->pinned = true;
+    } else {
+        qWarning() << "ResourceManager: 钉住失败，资源未加载:" << resourcePath;
+    }
+}
+
+void ResourceManager::unpinResource(const QString &resourcePath)
+{
+    auto it = m_resources.find(resourcePath);
+    if (it != m_resources.end()) {
+        (*it)->pinned = false;
+    }
+}
+
+void ResourceManager::touchResource(const std::shared_ptr<ResourceInfo> &info) const
+{
+    info->lastAccessTick = ++m_accessCounter;
+}
+
+void ResourceManager::evictLruResources()
+{
+    int evicted = 0;
+    while (m_totalMemoryUsage > m_maxMemoryUsage && evicted < MAX_EVICTIONS_PER_TICK) {
+        // 线性查找最久未访问的未钉住资源；缓存规模在千级以内，
+        // 单次遍历的开销远小于一次全量清理
+        QString victimKey;
+        qint64 oldestTick = std::numeric_limits<qint64>::max();
+        for (auto it = m_resources.constBegin(); it != m_resources.constEnd(); ++it) {
+            const auto &info = it.value();
+            if (info->pinned) {
+                continue;
+            }
+            if (info->lastAccessTick < oldestTick) {
+                oldestTick = info->lastAccessTick;
+                victimKey = it.key();
+            }
+        }
+
+        if (victimKey.isEmpty()) {
+            // 剩余资源全部被钉住，无法继续回收
+            break;
+        }
+
+        auto info = m_resources.take(victimKey);
+        m_textureCache.remove(victimKey);
+        m_textureTiers.remove(victimKey);
+        m_totalResourceSize -= info->size;
+        updateMemoryUsage();
+        emit resourceUnloaded(victimKey);
+        emit resourceCountChanged();
+        evicted++;
+    }
+
+    if (evicted > 0) {
+        qDebug() << "ResourceManager: LRU淘汰了" << evicted << "个资源，当前内存:"
+                 << m_totalMemoryUsage << "/" << m_maxMemoryUsage;
+    }
+}
+
+void ResourceManager::updateStreamProgress()
+{
+    if (m_pendingLoads <= 0) {
+        m_pendingLoads = 0;
+        m_completedLoads = 0;
+        m_loadingProgress = 1.0f;
+        if (m_isLoading) {
+            m_isLoading = false;
+            emit loadingStateChanged();
+        }
+    } else {
+        if (!m_isLoading) {
+            m_isLoading = true;
+            emit loadingStateChanged();
+        }
+        m_loadingProgress = static_cast<float>(m_completedLoads)
+            / static_cast<float>(m_completedLoads + m_pendingLoads);
+    }
+    emit loadingProgressChanged();
 }
 
 void ResourceManager::unloadResource(const QString &resourcePath)
@@ -422,6 +1031,7 @@ QVariant ResourceManager::getResource(const QString &resourcePath) const
 {
     auto it = m_resources.find(resourcePath);
     if (it != m_resources.end()) {
+        touchResource(*it);
         return (*it)->data;
     }
     return QVariant();
@@ -429,6 +1039,16 @@ QVariant ResourceManager::getResource(const QString &resourcePath) const
 
 QJsonObject ResourceManager::loadConfig(const QString &configPath)
 {
+    QByteArray packed = readPackedResource(configPath);
+    if (!packed.isEmpty()) {
+        QJsonDocument doc = QJsonDocument::fromJson(packed);
+        if (!doc.isNull() && doc.isObject()) {
+            return doc.object();
+        }
+        qWarning() << "ResourceManager: 资源包内配置文件格式错误:" << configPath;
+        return QJsonObject();
+    }
+
     QString fullPath = findResourcePath(configPath);
     if (fullPath.isEmpty()) {
         qWarning() << "ResourceManager: 配置文件未找到:" << configPath;
@@ -516,13 +1136,16 @@ void ResourceManager::onPreloadFinished()
 void ResourceManager::updateMemoryUsage()
 {
     m_totalMemoryUsage = m_totalResourceSize;
+    // 整体上报给内存遥测，资源缓存归入core子系统
+    MemoryTelemetry::instance()->setUsage(MemoryTelemetry::Subsystem::Core,
+                                          m_totalMemoryUsage);
     emit memoryUsageChanged();
 }
 
 void ResourceManager::checkMemoryLimit()
 {
     if (m_totalMemoryUsage > m_maxMemoryUsage) {
+        // 回收交给增量LRU淘汰逐帧执行，避免一次性全量清理卡顿
         emit memoryWarning(m_totalMemoryUsage, m_maxMemoryUsage);
-        cleanupUnusedResources();
     }
 }
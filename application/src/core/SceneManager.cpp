@@ -14,7 +14,10 @@
 #include "core/LoadingScene.h"
 #include "core/EventSystem.h"
 #include "core/ResourceManager.h"
+#include "audio/AudioManager.h"
 #include <QDebug>
+#include <QJsonArray>
+#include <QTimer>
 
 SceneManager::SceneManager(QObject *parent)
     : QObject(parent)
@@ -98,18 +101,35 @@ void SceneManager::loadScene(const QString &sceneName)
     // 设置切换状态标志
     m_isTransitioning = true;
 
+    // 音频差量切换尽早入队：卸载旧场景独占音效，新场景独有
+    // 音效的预解码在音频线程后台进行，与下面的场景构建重叠
+    if (m_audioManager) {
+        m_audioManager->applySceneAudio(sceneName);
+    }
+
     try {
         // 退出并卸载当前场景
         if (m_currentScene) {
             qDebug() << "SceneManager: 退出当前场景";
             m_currentScene->onExit();
             m_currentScene = nullptr;
+
+            // 旧场景排队中的资源加载已无意义，直接取消
+            m_resourceManager->cancelPendingLoads();
+        }
+
+        // 优先复用场景池中已预热的实例，避免切换时同步重建
+        auto newScene = m_scenes.value(sceneName);
+        if (newScene) {
+            qDebug() << "SceneManager: 复用池中场景实例:" << sceneName;
+        } else {
+            newScene = createScene(sceneName);
+            if (newScene) {
+                newScene->load(m_resourceManager);
+            }
         }
 
-        // 创建新场景
-        auto newScene = createScene(sceneName);
         if (newScene) {
-            newScene->load(m_resourceManager);
             QJsonObject emptyData;
             newScene->onEnter(emptyData);
             m_currentScene = newScene;
@@ -125,6 +145,12 @@ void SceneManager::loadScene(const QString &sceneName)
         emit sceneTransitionCompleted(sceneName);
         qDebug() << "SceneManager: 场景加载完成:" << sceneName;
 
+        // 空闲时预热接下来最可能切换到的场景
+        schedulePredictivePreloads(sceneName);
+
+        // 同样在空闲时补齐新场景的懒加载UI元素
+        warmUpSceneUi(sceneName);
+
     } catch (const std::exception& e) {
         qCritical() << "SceneManager: 场景加载异常:" << e.what();
         m_isTransitioning = false;
@@ -222,7 +248,20 @@ QJsonObject SceneManager::getSceneInfo(const QString &sceneName) const
 
 void SceneManager::preloadSceneResources(const QString &sceneName)
 {
+    // 池中已有实例或正是当前场景时无需预热
+    if (m_scenes.value(sceneName) || sceneName == m_currentSceneName) {
+        return;
+    }
+
     qDebug() << "SceneManager: 预加载场景资源:" << sceneName;
+
+    // 配置中的资源提示（如相邻区域贴图）以最低优先级入队，
+    // 解码在后台线程进行，不阻塞当前场景
+    const QStringList hints = sceneResourceHints(sceneName);
+    if (!hints.isEmpty() && m_resourceManager) {
+        m_resourceManager->preloadResources(hints);
+    }
+
     auto scene = createScene(sceneName);
     if (scene) {
         scene->load(m_resourceManager);
@@ -304,6 +343,104 @@ void SceneManager::completeSceneSwitch(std::shared_ptr<Scene> newScene, const QJ
     emit transitionStateChanged();
 }
 
+void SceneManager::schedulePredictivePreloads(const QString &sceneName)
+{
+    const QStringList candidates = likelyNextScenes(sceneName);
+    if (candidates.isEmpty()) {
+        return;
+    }
+
+    // 推迟到事件循环空闲时执行，不挤占切换完成的当帧
+    QTimer::singleShot(0, this, [this, candidates]() {
+        if (m_isTransitioning) {
+            return;
+        }
+        for (const QString &name : candidates) {
+            preloadSceneResources(name);
+        }
+    });
+}
+
+QStringList SceneManager::likelyNextScenes(const QString &sceneName)
+{
+    // 场景预测表：探索时预热战斗场景，战斗结束预热回探索场景
+    static const QHash<QString, QStringList> predictions = {
+        { "MainMenu", { "Loading", "Gameplay" } },
+        { "Loading",  { "Gameplay" } },
+        { "Gameplay", { "Battle" } },
+        { "Battle",   { "Gameplay" } },
+    };
+    return predictions.value(sceneName);
+}
+
+void SceneManager::warmUpSceneUi(const QString &sceneName)
+{
+    const QStringList elements = uiWarmupPriority(sceneName);
+    if (elements.isEmpty()) {
+        return;
+    }
+
+    // 场景切换会作废上一场景的待预热元素
+    m_uiWarmupQueue = elements;
+
+    if (!m_uiWarmupScheduled) {
+        m_uiWarmupScheduled = true;
+        // 首屏当帧不做实例化，从下一个空闲轮次开始
+        QTimer::singleShot(0, this, &SceneManager::pumpUiWarmupQueue);
+    }
+}
+
+QStringList SceneManager::uiWarmupPriority(const QString &sceneName)
+{
+    // UI预热优先级表：场景首开只构建可见元素，表中列出的
+    // 隐藏面板/对话框按打开概率在空闲帧依次补齐
+    static const QHash<QString, QStringList> priorities = {
+        { "MainMenu", { "MainMenu.newGameDialog",
+                        "MainMenu.loadGameDialog" } },
+        { "Gameplay", { "Gameplay.dialogPanel" } },
+    };
+    return priorities.value(sceneName);
+}
+
+void SceneManager::pumpUiWarmupQueue()
+{
+    m_uiWarmupScheduled = false;
+
+    if (m_uiWarmupQueue.isEmpty()) {
+        return;
+    }
+
+    // 转场期间让路，转场结束后继续
+    if (m_isTransitioning) {
+        m_uiWarmupScheduled = true;
+        QTimer::singleShot(0, this, &SceneManager::pumpUiWarmupQueue);
+        return;
+    }
+
+    // 每轮只实例化一个元素：LazyPanel在信号处理中同步创建内容
+    const QString elementName = m_uiWarmupQueue.takeFirst();
+    emit uiWarmupRequested(elementName);
+
+    if (!m_uiWarmupQueue.isEmpty()) {
+        m_uiWarmupScheduled = true;
+        QTimer::singleShot(0, this, &SceneManager::pumpUiWarmupQueue);
+    }
+}
+
+QStringList SceneManager::sceneResourceHints(const QString &sceneName) const
+{
+    QStringList hints;
+    const QJsonArray array = m_sceneConfig.value(sceneName).toObject()
+                                 .value("preloadResources").toArray();
+    for (const QJsonValue &value : array) {
+        const QString path = value.toString();
+        if (!path.isEmpty()) {
+            hints.append(path);
+        }
+    }
+    return hints;
+}
+
 void SceneManager::cleanupUnusedScenes()
 {
     qDebug() << "SceneManager: 清理未使用的场景";
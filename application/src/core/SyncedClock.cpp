@@ -0,0 +1,181 @@
+/*
+ * 文件名: SyncedClock.cpp
+ * 说明: 服务器权威时钟同步工具实现
+ * 作者: 彭承康
+ * 创建时间: 2026-08-28
+ */
+
+#include "core/SyncedClock.h"
+
+#include <QDateTime>
+#include <QDebug>
+#include <QMutexLocker>
+#include <cmath>
+
+SyncedClock* SyncedClock::instance()
+{
+    static SyncedClock clock;
+    return &clock;
+}
+
+SyncedClock::SyncedClock()
+{
+    m_monotonic.start();
+    m_wallAnchorMs = QDateTime::currentMSecsSinceEpoch();
+}
+
+qint64 SyncedClock::localSteadyMs() const
+{
+    return m_wallAnchorMs + m_monotonic.elapsed();
+}
+
+void SyncedClock::addExchangeSample(qint64 t0, qint64 t1, qint64 t2, qint64 t3)
+{
+    const qint64 rtt = (t3 - t0) - (t2 - t1);
+    if (rtt < 0 || t3 < t0) {
+        return;  // 时刻不自洽的样本直接丢弃
+    }
+    const qint64 offset = ((t1 - t0) + (t2 - t3)) / 2;
+
+    QMutexLocker locker(&m_mutex);
+
+    // 延迟尖刺期间的样本不进窗口：钟差误差与往返时延同量级
+    if (m_sampleCount > 0) {
+        qint64 minRtt = m_samples[0].rttMs;
+        for (int i = 1; i < m_sampleCount; ++i) {
+            minRtt = qMin(minRtt, m_samples[i].rttMs);
+        }
+        if (rtt > minRtt * RTT_OUTLIER_FACTOR && rtt > 50) {
+            return;
+        }
+    }
+
+    m_samples[m_sampleHead] = Sample{ t3, offset, rtt };
+    m_sampleHead = (m_sampleHead + 1) % SAMPLE_WINDOW;
+    m_sampleCount = qMin(m_sampleCount + 1, SAMPLE_WINDOW);
+    m_lastRttMs = rtt;
+
+    recomputeLocked();
+}
+
+void SyncedClock::recomputeLocked()
+{
+    // 钟差取窗口内往返最短的样本：它的单程不确定度最小
+    int best = 0;
+    for (int i = 1; i < m_sampleCount; ++i) {
+        if (m_samples[i].rttMs < m_samples[best].rttMs) {
+            best = i;
+        }
+    }
+    m_offsetMs = m_samples[best].offsetMs;
+    m_offsetAnchorMs = m_samples[best].localMs;
+    m_synchronized = true;
+
+    // 漂移率：对(本地时刻,钟差)做最小二乘回归。窗口跨度太短时
+    // 斜率全是采样噪声，保持上一次的估计
+    qint64 spanMin = m_samples[0].localMs;
+    qint64 spanMax = m_samples[0].localMs;
+    for (int i = 1; i < m_sampleCount; ++i) {
+        spanMin = qMin(spanMin, m_samples[i].localMs);
+        spanMax = qMax(spanMax, m_samples[i].localMs);
+    }
+    if (m_sampleCount < 4 || spanMax - spanMin < MIN_DRIFT_SPAN_MS) {
+        return;
+    }
+
+    double sumX = 0.0, sumY = 0.0, sumXX = 0.0, sumXY = 0.0;
+    for (int i = 0; i < m_sampleCount; ++i) {
+        const double x = static_cast<double>(m_samples[i].localMs - spanMin);
+        const double y = static_cast<double>(m_samples[i].offsetMs);
+        sumX += x;
+        sumY += y;
+        sumXX += x * x;
+        sumXY += x * y;
+    }
+    const double n = static_cast<double>(m_sampleCount);
+    const double denom = n * sumXX - sumX * sumX;
+    if (denom <= 0.0) {
+        return;
+    }
+    const double slope = (n * sumXY - sumX * sumY) / denom;  // 毫秒/毫秒
+    const double ppm = slope * 1e6;
+    if (std::abs(ppm) > MAX_DRIFT_PPM) {
+        qWarning() << "SyncedClock: 漂移估计超限，忽略:" << ppm << "ppm";
+        return;
+    }
+    m_driftPpm = ppm;
+}
+
+bool SyncedClock::isSynchronized() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_synchronized;
+}
+
+qint64 SyncedClock::toServerTimeLocked(qint64 localMs) const
+{
+    if (!m_synchronized) {
+        return localMs;
+    }
+    const double driftMs =
+        m_driftPpm * static_cast<double>(localMs - m_offsetAnchorMs) / 1e6;
+    return localMs + m_offsetMs + static_cast<qint64>(driftMs);
+}
+
+qint64 SyncedClock::serverNowMs() const
+{
+    const qint64 local = localSteadyMs();
+    QMutexLocker locker(&m_mutex);
+    return toServerTimeLocked(local);
+}
+
+qint64 SyncedClock::toServerTime(qint64 localMs) const
+{
+    QMutexLocker locker(&m_mutex);
+    return toServerTimeLocked(localMs);
+}
+
+qint64 SyncedClock::toLocalTime(qint64 serverMs) const
+{
+    QMutexLocker locker(&m_mutex);
+    if (!m_synchronized) {
+        return serverMs;
+    }
+    // 反解映射：漂移项按当前时刻近似（漂移在毫秒量级内可忽略二阶差）
+    const qint64 local = localSteadyMs();
+    const qint64 serverAtLocal = toServerTimeLocked(local);
+    return local + (serverMs - serverAtLocal);
+}
+
+qint64 SyncedClock::remainingUntilServerMs(qint64 serverMs) const
+{
+    const qint64 local = localSteadyMs();
+    QMutexLocker locker(&m_mutex);
+    const qint64 remaining = serverMs - toServerTimeLocked(local);
+    return qMax<qint64>(0, remaining);
+}
+
+double SyncedClock::driftPpm() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_driftPpm;
+}
+
+qint64 SyncedClock::lastRttMs() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_lastRttMs;
+}
+
+void SyncedClock::reset()
+{
+    QMutexLocker locker(&m_mutex);
+    m_sampleCount = 0;
+    m_sampleHead = 0;
+    m_synchronized = false;
+    m_offsetMs = 0;
+    m_offsetAnchorMs = 0;
+    m_driftPpm = 0.0;
+    m_lastRttMs = -1;
+    qDebug() << "SyncedClock: 同步状态已重置";
+}
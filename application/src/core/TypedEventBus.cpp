@@ -0,0 +1,43 @@
+/*
+ * 文件名: TypedEventBus.cpp
+ * 说明: 编译期类型化事件通道实现文件
+ * 作者: 彭承康
+ * 创建时间: 2026-08-28
+ *
+ * 模板分发逻辑全部在头文件内；本文件只承载单例实例、
+ * 句柄注销与帧驱动排空等非模板部分。
+ */
+
+#include "core/TypedEventBus.h"
+
+TypedEventBus* TypedEventBus::s_instance = nullptr;
+std::atomic<int> TypedEventBus::s_nextTypeIndex{0};
+
+TypedEventBus* TypedEventBus::instance()
+{
+    if (!s_instance) {
+        s_instance = new TypedEventBus();
+    }
+    return s_instance;
+}
+
+void TypedEventBus::unsubscribe(int handle)
+{
+    auto it = m_handleChannels.find(handle);
+    if (it == m_handleChannels.end()) {
+        return;
+    }
+    it.value()->removeSubscriber(handle);
+    m_handleChannels.erase(it);
+}
+
+void TypedEventBus::drainPosted()
+{
+    // 通道数量等于进程内用到的事件类型数，遍历本身可忽略；
+    // 空通道的drain只做一次无争用的指针交换。
+    for (const auto &channel : m_channels) {
+        if (channel) {
+            channel->drain();
+        }
+    }
+}
@@ -0,0 +1,136 @@
+/*
+ * 文件名: WorkerMailbox.cpp
+ * 说明: 工作线程到主线程的SPSC信箱与统一排空枢纽实现
+ * 作者: 彭承康
+ * 创建时间: 2026-08-28
+ */
+#include "core/WorkerMailbox.h"
+
+#include <QMutexLocker>
+#include <QThread>
+
+namespace {
+
+/**
+ * @brief 向上取整到2的幂
+ */
+quint32 roundUpPowerOfTwo(quint32 value)
+{
+    quint32 power = 1;
+    while (power < value) {
+        power <<= 1;
+    }
+    return power;
+}
+
+} // namespace
+
+// ==================== WorkerMailbox ====================
+
+WorkerMailbox::WorkerMailbox(int capacity)
+{
+    const quint32 rounded = roundUpPowerOfTwo(
+        static_cast<quint32>(capacity > 1 ? capacity : 2));
+    m_slots.resize(rounded);
+    m_mask = rounded - 1;
+}
+
+bool WorkerMailbox::tryPost(Message message)
+{
+    const quint32 tail = m_tail.load(std::memory_order_relaxed);
+    const quint32 head = m_head.load(std::memory_order_acquire);
+    if (tail - head > m_mask) {
+        m_rejected.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    m_slots[tail & m_mask] = std::move(message);
+    m_tail.store(tail + 1, std::memory_order_release);
+    return true;
+}
+
+int WorkerMailbox::drain(int maxMessages)
+{
+    const quint32 tail = m_tail.load(std::memory_order_acquire);
+    quint32 head = m_head.load(std::memory_order_relaxed);
+
+    int executed = 0;
+    while (head != tail && executed < maxMessages) {
+        Message message = std::move(m_slots[head & m_mask]);
+        m_slots[head & m_mask] = nullptr;
+        // 先释放槽位再执行消息，生产方尽早看到空位
+        ++head;
+        m_head.store(head, std::memory_order_release);
+        ++executed;
+        if (message) {
+            message();
+        }
+    }
+    return executed;
+}
+
+int WorkerMailbox::pendingApprox() const
+{
+    const quint32 tail = m_tail.load(std::memory_order_relaxed);
+    const quint32 head = m_head.load(std::memory_order_relaxed);
+    return static_cast<int>(tail - head);
+}
+
+// ==================== MailboxHub ====================
+
+MailboxHub *MailboxHub::s_active = nullptr;
+
+MailboxHub::MailboxHub(QObject *parent)
+    : QObject(parent)
+{
+}
+
+MailboxHub::~MailboxHub()
+{
+    if (s_active == this) {
+        s_active = nullptr;
+    }
+}
+
+WorkerMailbox *MailboxHub::mailboxForCurrentThread(const QString &producerName)
+{
+    const Qt::HANDLE threadId = QThread::currentThreadId();
+
+    QMutexLocker locker(&m_registryMutex);
+    Entry *entry = m_byThread.value(threadId, nullptr);
+    if (!entry) {
+        auto created = std::make_unique<Entry>();
+        created->producerName = producerName;
+        created->mailbox = std::make_unique<WorkerMailbox>();
+        entry = created.get();
+        m_entries.push_back(std::move(created));
+        m_byThread.insert(threadId, entry);
+    }
+    return entry->mailbox.get();
+}
+
+int MailboxHub::drainAll(int maxPerMailbox)
+{
+    // 短锁下快照登记项指针；登记项只增不删，指针在枢纽
+    // 生命周期内保持有效，消息执行放在锁外，消息里再注册
+    // 新信箱或提交任务都不会死锁
+    std::vector<Entry*> snapshot;
+    {
+        QMutexLocker locker(&m_registryMutex);
+        snapshot.reserve(m_entries.size());
+        for (const auto &entry : m_entries) {
+            snapshot.push_back(entry.get());
+        }
+    }
+
+    int totalExecuted = 0;
+    for (Entry *entry : snapshot) {
+        totalExecuted += entry->mailbox->drain(maxPerMailbox);
+
+        const quint64 rejected = entry->mailbox->rejectedCount();
+        if (rejected > entry->reportedRejects) {
+            entry->reportedRejects = rejected;
+            emit backpressureDetected(entry->producerName, rejected);
+        }
+    }
+    return totalExecuted;
+}
@@ -0,0 +1,134 @@
+/*
+ * 文件名: BattleActionLog.cpp
+ * 说明: 列式战斗日志实现。
+ * 作者: 彭承康
+ * 创建时间: 2026-08-28
+ */
+
+#include "game/BattleActionLog.h"
+
+#include <QDataStream>
+#include <QFile>
+#include <utility>
+
+BattleActionLog::BattleActionLog(QObject *parent)
+    : QObject(parent)
+{
+    m_records.reserve(RESERVED_RECORDS);
+}
+
+BattleActionLog::~BattleActionLog()
+{
+    joinWorker();
+}
+
+void BattleActionLog::beginBattle()
+{
+    joinWorker();
+    // clear保留capacity，整场战斗的追加不再触发分配
+    m_records.clear();
+    m_actorNames.clear();
+}
+
+void BattleActionLog::registerActor(qint16 actorId, const QString &name)
+{
+    m_actorNames.insert(actorId, name);
+}
+
+void BattleActionLog::append(quint16 turn, qint16 actorId, qint16 targetId,
+                             quint16 skillId, qint32 damage, quint16 flags)
+{
+    m_records.push_back(Record{turn, actorId, targetId, skillId, damage, flags});
+}
+
+void BattleActionLog::flushAsync()
+{
+    if (m_records.empty()) {
+        return;
+    }
+
+    joinWorker();
+
+    // POD快照拷贝很便宜；原记录保留给exportBinary
+    std::vector<Record> snapshot = m_records;
+    QHash<qint16, QString> names = m_actorNames;
+
+    m_flushThread = std::thread([this, snapshot = std::move(snapshot),
+                                 names = std::move(names)]() {
+        // 自动连接类型下从工作线程发射即为队列投递，回到主线程
+        emit linesReady(formatRecords(snapshot, names));
+    });
+}
+
+bool BattleActionLog::exportBinary(const QString &filePath) const
+{
+    QFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        return false;
+    }
+
+    QDataStream stream(&file);
+    stream.setByteOrder(QDataStream::LittleEndian);
+
+    stream << EXPORT_MAGIC;
+    stream << EXPORT_VERSION;
+    stream << static_cast<quint32>(m_records.size());
+    for (const Record &record : m_records) {
+        stream << record.turn << record.actorId << record.targetId
+               << record.skillId << record.damage << record.flags;
+    }
+
+    return stream.status() == QDataStream::Ok;
+}
+
+QStringList BattleActionLog::formatRecords(const std::vector<Record> &records,
+                                           const QHash<qint16, QString> &names)
+{
+    const auto nameOf = [&names](qint16 actorId) {
+        const auto it = names.constFind(actorId);
+        return it != names.constEnd() ? it.value()
+                                      : QStringLiteral("单位%1").arg(actorId);
+    };
+
+    QStringList lines;
+    lines.reserve(static_cast<int>(records.size()));
+
+    for (const Record &record : records) {
+        const QString actor = nameOf(record.actorId);
+        const QString target = nameOf(record.targetId);
+
+        QString line;
+        if (record.flags & FlagEnemyAction) {
+            line = QStringLiteral("%1 攻击了 %2，造成了 %3 点伤害")
+                .arg(actor, target).arg(record.damage);
+        } else if (record.flags & FlagSkill) {
+            line = QStringLiteral("%1 对 %2 使用技能造成了 %3 点伤害")
+                .arg(actor, target).arg(record.damage);
+        } else {
+            line = QStringLiteral("%1 攻击 %2 造成了 %3 点伤害")
+                .arg(actor, target).arg(record.damage);
+        }
+
+        if (record.flags & FlagCritical) {
+            line += QStringLiteral(" (暴击!)");
+        }
+        lines.append(line);
+
+        if (record.flags & FlagTargetDefeated) {
+            if (record.flags & FlagEnemyAction) {
+                lines.append(QStringLiteral("%1 倒下了！").arg(target));
+            } else {
+                lines.append(QStringLiteral("%1 被击败了！").arg(target));
+            }
+        }
+    }
+
+    return lines;
+}
+
+void BattleActionLog::joinWorker()
+{
+    if (m_flushThread.joinable()) {
+        m_flushThread.join();
+    }
+}
@@ -0,0 +1,140 @@
+/*
+ * 文件名: BattleReplay.cpp
+ * 说明: 战斗回放数据的序列化实现。
+ * 作者: 彭承康
+ * 创建时间: 2026-08-28
+ */
+#include "game/BattleReplay.h"
+#include <QFile>
+#include <QJsonDocument>
+#include <QDebug>
+
+void BattleReplay::begin(const QJsonObject &config, const QJsonObject &playerSnapshot, quint32 seed)
+{
+    clear();
+    m_config = config;
+    m_playerSnapshot = playerSnapshot;
+    m_seed = seed;
+    m_hasBattle = true;
+}
+
+void BattleReplay::recordAction(int turn, const QString &type, const QJsonObject &params)
+{
+    QJsonObject action;
+    action["turn"] = turn;
+    action["type"] = type;
+    action["params"] = params;
+    m_actions.append(action);
+}
+
+void BattleReplay::recordRpcResponse(const QJsonObject &response)
+{
+    m_rpcResponses.append(response);
+}
+
+bool BattleReplay::save(const QString &filePath) const
+{
+    if (!m_hasBattle) {
+        qWarning() << "BattleReplay: 没有可保存的战斗记录";
+        return false;
+    }
+
+    QJsonObject root;
+    root["version"] = REPLAY_VERSION;
+    root["seed"] = static_cast<qint64>(m_seed);
+    root["config"] = m_config;
+    root["player"] = m_playerSnapshot;
+    root["actions"] = m_actions;
+    root["rpcResponses"] = m_rpcResponses;
+
+    QFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qWarning() << "BattleReplay: 无法写入回放文件:" << filePath;
+        return false;
+    }
+
+    // 与存档一致：紧凑JSON + qCompress压缩
+    const QByteArray raw = QJsonDocument(root).toJson(QJsonDocument::Compact);
+    file.write(qCompress(raw));
+
+    qDebug() << "BattleReplay: 回放已保存:" << filePath
+             << "操作数:" << m_actions.size()
+             << "响应数:" << m_rpcResponses.size();
+    return true;
+}
+
+bool BattleReplay::load(const QString &filePath)
+{
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        qWarning() << "BattleReplay: 无法打开回放文件:" << filePath;
+        return false;
+    }
+
+    const QByteArray raw = qUncompress(file.readAll());
+    if (raw.isEmpty()) {
+        qWarning() << "BattleReplay: 回放文件解压失败:" << filePath;
+        return false;
+    }
+
+    QJsonParseError error;
+    const QJsonDocument doc = QJsonDocument::fromJson(raw, &error);
+    if (error.error != QJsonParseError::NoError || !doc.isObject()) {
+        qWarning() << "BattleReplay: 回放文件解析失败:" << error.errorString();
+        return false;
+    }
+
+    const QJsonObject root = doc.object();
+    if (root["version"].toInt(0) != REPLAY_VERSION) {
+        qWarning() << "BattleReplay: 回放版本不匹配:" << root["version"].toInt(0);
+        return false;
+    }
+
+    m_seed = static_cast<quint32>(root["seed"].toInteger(0));
+    m_config = root["config"].toObject();
+    m_playerSnapshot = root["player"].toObject();
+    m_actions = root["actions"].toArray();
+    m_rpcResponses = root["rpcResponses"].toArray();
+    m_hasBattle = true;
+    return true;
+}
+
+void BattleReplay::clear()
+{
+    m_config = QJsonObject();
+    m_playerSnapshot = QJsonObject();
+    m_seed = 0;
+    m_actions = QJsonArray();
+    m_rpcResponses = QJsonArray();
+    m_hasBattle = false;
+}
+
+bool BattleReplay::isEmpty() const
+{
+    return !m_hasBattle;
+}
+
+QJsonObject BattleReplay::config() const
+{
+    return m_config;
+}
+
+QJsonObject BattleReplay::playerSnapshot() const
+{
+    return m_playerSnapshot;
+}
+
+quint32 BattleReplay::seed() const
+{
+    return m_seed;
+}
+
+QJsonArray BattleReplay::actions() const
+{
+    return m_actions;
+}
+
+QJsonArray BattleReplay::rpcResponses() const
+{
+    return m_rpcResponses;
+}
@@ -0,0 +1,93 @@
+/*
+ * 文件名: BattleSessionCache.cpp
+ * 说明: 战斗会话缓存实现
+ * 作者: 彭承康
+ * 创建时间: 2026-08-28
+ */
+#include "game/BattleSessionCache.h"
+#include "network/StrategyServiceClient.h"
+#include <QTimer>
+#include <QDebug>
+
+BattleSessionCache::BattleSessionCache(QObject *parent)
+    : QObject(parent)
+    , m_strategyClient(nullptr)
+    , m_refreshTimer(nullptr)
+    , m_rulesVersion(0)
+    , m_fetchedAtMs(-1)
+{
+    m_clock.start();
+
+    m_refreshTimer = new QTimer(this);
+    connect(m_refreshTimer, &QTimer::timeout, this, &BattleSessionCache::refresh);
+}
+
+void BattleSessionCache::initialize(StrategyServiceClient *strategyClient)
+{
+    m_strategyClient = strategyClient;
+
+    if (!m_strategyClient) {
+        qWarning() << "BattleSessionCache: 策略服务客户端为空，会话预协商不可用";
+        return;
+    }
+
+    // 首次拉取推迟到事件循环空闲，不挤占调用方所在的启动路径
+    QTimer::singleShot(0, this, &BattleSessionCache::refresh);
+    m_refreshTimer->start(REFRESH_INTERVAL_MS);
+
+    qDebug() << "BattleSessionCache: 初始化完成，刷新间隔(ms):" << REFRESH_INTERVAL_MS;
+}
+
+bool BattleSessionCache::isStale() const
+{
+    return m_fetchedAtMs < 0
+        || m_clock.elapsed() - m_fetchedAtMs > STALE_AFTER_MS;
+}
+
+QJsonObject BattleSessionCache::takeBattleSession()
+{
+    // 兜底：缓存未命中时退回同步拉取（旧的慢路径）。正常流程
+    // 下探索阶段已备好缓存，这里只在冷启动直接进战斗时发生
+    if (!isReady()) {
+        qWarning() << "BattleSessionCache: 入场时缓存未命中，退回同步拉取";
+        refresh();
+    }
+
+    if (!isReady()) {
+        return QJsonObject();
+    }
+
+    QJsonObject session;
+    session["rules"] = m_combatRules;
+    session["rulesVersion"] = m_rulesVersion;
+    return session;
+}
+
+void BattleSessionCache::refresh()
+{
+    if (!m_strategyClient || !m_strategyClient->isConnected()) {
+        return;
+    }
+
+    QJsonObject request;
+    request["category"] = QStringLiteral("combat");
+    request["activeOnly"] = true;
+
+    // 同步RPC：成本与时钟同步采样同级（小载荷、热通道），
+    // 刷新节拍落在探索阶段，不与战斗帧争抢
+    m_strategyClient->getGameRules(request, [this](const QJsonObject &response) {
+        if (response.value("error").toBool(false)) {
+            qWarning() << "BattleSessionCache: 规则拉取失败:"
+                       << response.value("message").toString();
+            return;
+        }
+
+        m_combatRules = response.value("rules").toArray();
+        m_rulesVersion = response.value("version").toInt();
+        m_fetchedAtMs = m_clock.elapsed();
+
+        qDebug() << "BattleSessionCache: 规则缓存已更新，版本:" << m_rulesVersion
+                 << "条目数:" << m_combatRules.size();
+        emit sessionRefreshed(m_rulesVersion);
+    });
+}
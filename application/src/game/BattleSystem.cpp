@@ -8,6 +8,7 @@
  * 技能释放和战斗结果处理。
  */
 #include "game/BattleSystem.h"
+#include "game/BattleSessionCache.h"
 #include "game/Player.h"
 #include "network/AlgorithmServiceClient.h"
 #include <QTimer>
@@ -18,18 +19,31 @@ BattleSystem::BattleSystem(QObject *parent)
     : QObject(parent)
     , m_player(nullptr)
     , m_algorithmClient(nullptr)
+    , m_sessionCache(nullptr)
     , m_battleState(BattleState::Idle)
     , m_currentTurn(0)
     , m_turnTimer(nullptr)
     , m_turnDuration(30000) // 30秒回合时间
     , m_battleSpeed(1.0f)
     , m_autoMode(false)
+    , m_turnOrderDirty(false)
+    , m_battleSeed(0)
+    , m_recordReplay(false)
+    , m_playbackMode(false)
+    , m_playbackResponseIndex(0)
 {
     // 初始化回合定时器
     m_turnTimer = new QTimer(this);
     m_turnTimer->setSingleShot(true);
     connect(m_turnTimer, &QTimer::timeout, this, &BattleSystem::onTurnTimeout);
-    
+
+    // 战后异步格式化的动作日志文本回到主线程后并入战斗日志
+    connect(&m_actionLog, &BattleActionLog::linesReady,
+            this, [this](const QStringList &lines) {
+        m_battleLog.append(lines);
+        emit battleLogChanged();
+    });
+
     qDebug() << "BattleSystem: 战斗系统初始化完成";
 }
 
@@ -63,18 +77,55 @@ bool BattleSystem::startBattle(const QJsonObject &battleConfig)
     }
     
     qDebug() << "BattleSystem: 开始战斗";
-    
+
+    // 并入预协商的战斗会话：探索期间缓存好的combat规则直接
+    // 附到配置上（配置自带rules时尊重调用方，回放按记录原样），
+    // 入场不再付取规则的RPC往返
+    QJsonObject effectiveConfig = battleConfig;
+    if (m_sessionCache && !m_playbackMode && !effectiveConfig.contains("rules")) {
+        const QJsonObject session = m_sessionCache->takeBattleSession();
+        if (!session.isEmpty()) {
+            effectiveConfig["rules"] = session["rules"];
+            effectiveConfig["rulesVersion"] = session["rulesVersion"];
+            qDebug() << "BattleSystem: 使用预协商会话，规则版本:"
+                     << session["rulesVersion"].toInt();
+        }
+    }
+
     // 解析战斗配置
-    if (!parseBattleConfig(battleConfig)) {
+    if (!parseBattleConfig(effectiveConfig)) {
         qCritical() << "BattleSystem: 战斗配置解析失败";
         return false;
     }
-    
+
     // 初始化战斗状态
     m_battleState = BattleState::Starting;
     m_currentTurn = 0;
     m_battleLog.clear();
-    
+
+    // RNG种子：回放时复用记录的种子，正常战斗随机生成；
+    // 整场战斗的本地随机数（暴击、伤害浮动）全部由该种子派生
+    if (!m_playbackMode) {
+        m_battleSeed = QRandomGenerator::global()->generate();
+    }
+    m_battleRandom.seed(m_battleSeed);
+
+    // 开始记录回放：配置（含并入的会话规则）、玩家快照和种子
+    // 构成重放的初始状态
+    if (m_recordReplay && !m_playbackMode) {
+        m_replay.begin(effectiveConfig, m_player->toJson(), m_battleSeed);
+    }
+
+    // 列式动作日志：注册单位名称，战斗中逐动作只做二进制追加
+    m_actionLog.beginBattle();
+    m_actionLog.registerActor(-1, m_player->getName());
+    for (const Enemy &enemy : m_enemies) {
+        m_actionLog.registerActor(static_cast<qint16>(enemy.id), enemy.name);
+    }
+
+    // 构建战斗单位池：热属性进连续对齐数组，回合逻辑只读写池
+    buildCombatantPool();
+
     // 计算行动顺序
     calculateTurnOrder();
     
@@ -97,10 +148,14 @@ void BattleSystem::endBattle()
     // 停止定时器
     m_turnTimer->stop();
     
-    // 重置状态
+    // 重置状态（先置Idle，写回触发的信号不会再进入战斗逻辑）
     m_battleState = BattleState::Idle;
+    writeBackBattleResults();
+    m_combatants.clear();
     m_enemies.clear();
     m_turnOrder.clear();
+    m_turnOrderView = QJsonArray();
+    m_turnOrderDirty = false;
     m_currentTurn = 0;
     
     emit battleEnded();
@@ -113,24 +168,30 @@ bool BattleSystem::playerAttack(int targetId, int skillId)
         qWarning() << "BattleSystem: 不是玩家回合";
         return false;
     }
-    
-    // 查找目标敌人
-    auto targetIt = std::find_if(m_enemies.begin(), m_enemies.end(),
-        [targetId](const Enemy &enemy) { return enemy.id == targetId; });
-    
-    if (targetIt == m_enemies.end()) {
+
+    // 查找目标单位（池内线性扫描，整池在一块连续内存上）
+    BattleCombatant *target = findCombatant(targetId);
+
+    if (!target || target->entityId == -1) {
         qWarning() << "BattleSystem: 目标敌人不存在" << targetId;
         return false;
     }
-    
-    if (targetIt->health <= 0) {
+
+    if (target->health <= 0) {
         qWarning() << "BattleSystem: 目标敌人已死亡";
         return false;
     }
-    
+
+    if (m_recordReplay && !m_playbackMode) {
+        QJsonObject params;
+        params["targetId"] = targetId;
+        params["skillId"] = skillId;
+        m_replay.recordAction(m_currentTurn, "attack", params);
+    }
+
     // 执行攻击
-    executePlayerAttack(*targetIt, skillId);
-    
+    executePlayerAttack(*target, skillId);
+
     return true;
 }
 
@@ -143,7 +204,14 @@ bool BattleSystem::playerUseItem(int itemId, int targetId)
     
     // 这里应该检查玩家背包中是否有该物品
     // 暂时简化处理
-    
+
+    if (m_recordReplay && !m_playbackMode) {
+        QJsonObject params;
+        params["itemId"] = itemId;
+        params["targetId"] = targetId;
+        m_replay.recordAction(m_currentTurn, "item", params);
+    }
+
     executePlayerItemUse(itemId, targetId);
     return true;
 }
@@ -155,6 +223,10 @@ bool BattleSystem::playerDefend()
         return false;
     }
     
+    if (m_recordReplay && !m_playbackMode) {
+        m_replay.recordAction(m_currentTurn, "defend", QJsonObject());
+    }
+
     // 防御状态：减少50%受到的伤害
     StatusEffect defenseEffect;
     defenseEffect.name = "防御";
@@ -162,7 +234,12 @@ bool BattleSystem::playerDefend()
     defenseEffect.properties["defenseBonus"] = m_player->getDefense() / 2;
     
     m_player->addStatusEffect(defenseEffect);
-    
+
+    // 状态效果对派生属性的增减立即同步进池，紧随的敌人回合生效
+    if (!m_combatants.isEmpty()) {
+        m_combatants[0].defense = m_player->getDefense();
+    }
+
     addBattleLog(QString("%1 进入防御状态").arg(m_player->getName()));
     
     // 结束玩家回合
@@ -174,6 +251,9 @@ bool BattleSystem::playerDefend()
 void BattleSystem::skipTurn()
 {
     if (m_battleState == BattleState::PlayerTurn) {
+        if (m_recordReplay && !m_playbackMode) {
+            m_replay.recordAction(m_currentTurn, "skip", QJsonObject());
+        }
         addBattleLog(QString("%1 跳过了这个回合").arg(m_player->getName()));
         endPlayerTurn();
     }
@@ -220,20 +300,29 @@ BattleState BattleSystem::getBattleState() const
 QJsonArray BattleSystem::getEnemies() const
 {
     QJsonArray array;
-    
-    for (const Enemy &enemy : m_enemies) {
+
+    // 热数据（血量、速度等）在战斗单位池中，名称取自冷数据表；
+    // 池槽0为玩家，敌人按解析顺序占据后续槽位
+    if (m_combatants.size() != m_enemies.size() + 1) {
+        return array;
+    }
+
+    for (int i = 0; i < m_enemies.size(); ++i) {
+        const Enemy &enemy = m_enemies.at(i);
+        const BattleCombatant &combatant = m_combatants.at(i + 1);
+
         QJsonObject enemyObj;
-        enemyObj["id"] = enemy.id;
+        enemyObj["id"] = combatant.entityId;
         enemyObj["name"] = enemy.name;
-        enemyObj["health"] = enemy.health;
-        enemyObj["maxHealth"] = enemy.maxHealth;
-        enemyObj["attack"] = enemy.attack;
-        enemyObj["defense"] = enemy.defense;
-        enemyObj["speed"] = enemy.speed;
-        enemyObj["level"] = enemy.level;
+        enemyObj["health"] = combatant.health;
+        enemyObj["maxHealth"] = combatant.maxHealth;
+        enemyObj["attack"] = combatant.attack;
+        enemyObj["defense"] = combatant.defense;
+        enemyObj["speed"] = combatant.speed;
+        enemyObj["level"] = combatant.level;
         array.append(enemyObj);
     }
-    
+
     return array;
 }
 
@@ -242,6 +331,11 @@ QStringList BattleSystem::getBattleLog() const
     return m_battleLog;
 }
 
+bool BattleSystem::exportBattleActionLog(const QString &filePath) const
+{
+    return m_actionLog.exportBinary(filePath);
+}
+
 int BattleSystem::getCurrentTurn() const
 {
     return m_currentTurn;
@@ -249,28 +343,115 @@ int BattleSystem::getCurrentTurn() const
 
 QJsonArray BattleSystem::getTurnOrder() const
 {
-    QJsonArray array;
-    
-    for (int entityId : m_turnOrder) {
-        QJsonObject turnObj;
-        if (entityId == -1) { // 玩家
-            turnObj["type"] = "player";
-            turnObj["name"] = m_player->getName();
-            turnObj["id"] = -1;
-        } else {
-            // 查找敌人
-            auto it = std::find_if(m_enemies.begin(), m_enemies.end(),
-                [entityId](const Enemy &enemy) { return enemy.id == entityId; });
-            if (it != m_enemies.end()) {
-                turnObj["type"] = "enemy";
-                turnObj["name"] = it->name;
-                turnObj["id"] = it->id;
+    // 视图随回合表重算时预构建，QML每次读取不再排序/查找
+    return m_turnOrderView;
+}
+
+void BattleSystem::applySpeedModifier(int entityId, int delta)
+{
+    if (m_battleState == BattleState::Idle) {
+        return;
+    }
+
+    if (entityId != -1) {
+        BattleCombatant *combatant = findCombatant(entityId);
+        if (!combatant) {
+            qWarning() << "BattleSystem: 速度修正目标不存在" << entityId;
+            return;
+        }
+
+        combatant->speed = qMax(1, combatant->speed + delta);
+        addBattleLog(QString("%1 的速度%2了 %3 点")
+            .arg(combatantName(entityId))
+            .arg(delta >= 0 ? "提升" : "降低")
+            .arg(qAbs(delta)));
+        emit enemiesChanged();
+    } else if (!m_combatants.isEmpty()) {
+        // 玩家速度由其状态效果决定，这里把派生值刷新进池再重算
+        m_combatants[0].speed = m_player->getSpeed();
+    }
+
+    // 速度事件立即重算，UI上的行动预告同步刷新
+    calculateTurnOrder();
+}
+
+void BattleSystem::setReplayRecordingEnabled(bool enabled)
+{
+    m_recordReplay = enabled;
+    qDebug() << "BattleSystem: 回放记录" << (enabled ? "开启" : "关闭");
+}
+
+bool BattleSystem::saveReplay(const QString &filePath) const
+{
+    return m_replay.save(filePath);
+}
+
+bool BattleSystem::playReplay(const BattleReplay &replay)
+{
+    if (m_battleState != BattleState::Idle) {
+        qWarning() << "BattleSystem: 战斗进行中，无法回放";
+        return false;
+    }
+
+    if (replay.isEmpty()) {
+        qWarning() << "BattleSystem: 回放数据为空";
+        return false;
+    }
+
+    // 进入回放模式：种子和RPC响应来自记录，定时器全部跳过，
+    // 整场战斗在本次调用内同步执行
+    m_playbackMode = true;
+    m_battleSeed = replay.seed();
+    m_playbackResponses.clear();
+    const QJsonArray responses = replay.rpcResponses();
+    for (const QJsonValue &value : responses) {
+        m_playbackResponses.append(value.toObject());
+    }
+    m_playbackResponseIndex = 0;
+
+    // 回放自身不再记录
+    const bool recordBackup = m_recordReplay;
+    m_recordReplay = false;
+
+    bool finished = false;
+    if (startBattle(replay.config())) {
+        const QJsonArray actions = replay.actions();
+        for (const QJsonValue &value : actions) {
+            // 战斗结束后endBattle()把状态归位Idle，剩余操作丢弃
+            if (m_battleState == BattleState::Idle) {
+                break;
+            }
+
+            const QJsonObject action = value.toObject();
+            const QString type = action["type"].toString();
+            const QJsonObject params = action["params"].toObject();
+
+            if (type == "attack") {
+                playerAttack(params["targetId"].toInt(), params["skillId"].toInt(0));
+            } else if (type == "item") {
+                playerUseItem(params["itemId"].toInt(), params["targetId"].toInt(-1));
+            } else if (type == "defend") {
+                playerDefend();
+            } else if (type == "skip") {
+                skipTurn();
+            } else {
+                qWarning() << "BattleSystem: 未知的回放操作类型:" << type;
             }
         }
-        array.append(turnObj);
+
+        finished = (m_battleState == BattleState::Idle);
+        if (!finished) {
+            // 记录在战斗结束前中断（如录制中途退出），收尾清场
+            qWarning() << "BattleSystem: 回放操作耗尽但战斗未结束";
+            endBattle();
+        }
     }
-    
-    return array;
+
+    m_recordReplay = recordBackup;
+    m_playbackMode = false;
+    m_playbackResponses.clear();
+    m_playbackResponseIndex = 0;
+    return finished;
 }
 
 void BattleSystem::update(float deltaTime)
@@ -320,23 +501,88 @@ bool BattleSystem::parseBattleConfig(const QJsonObject &config)
     }
 }
 
+void BattleSystem::buildCombatantPool()
+{
+    m_combatants.clear();
+
+    // 槽0固定为玩家，热属性从Player快照进池
+    BattleCombatant player;
+    player.entityId = -1;
+    player.health = m_player->getHealth();
+    player.maxHealth = m_player->getMaxHealth();
+    player.attack = m_player->getAttack();
+    player.defense = m_player->getDefense();
+    player.speed = m_player->getSpeed();
+    player.level = m_player->getLevel();
+    m_combatants.append(player);
+
+    // 敌人按解析顺序占据后续槽位（与m_enemies下标一一对应）
+    for (const Enemy &enemy : m_enemies) {
+        BattleCombatant combatant;
+        combatant.entityId = enemy.id;
+        combatant.health = enemy.health;
+        combatant.maxHealth = enemy.maxHealth;
+        combatant.attack = enemy.attack;
+        combatant.defense = enemy.defense;
+        combatant.speed = enemy.speed;
+        combatant.level = enemy.level;
+        m_combatants.append(combatant);
+    }
+}
+
+void BattleSystem::writeBackBattleResults()
+{
+    if (m_combatants.isEmpty()) {
+        return;
+    }
+
+    // 玩家生命值用差量经现有的takeDamage()/heal()写回，血量
+    // 与死亡信号在战斗结束时一次性触发
+    const int delta = m_player->getHealth() - m_combatants[0].health;
+    if (delta > 0) {
+        m_player->takeDamage(delta);
+    } else if (delta < 0) {
+        m_player->heal(-delta);
+    }
+}
+
+BattleCombatant *BattleSystem::findCombatant(int entityId)
+{
+    for (BattleCombatant &combatant : m_combatants) {
+        if (combatant.entityId == entityId) {
+            return &combatant;
+        }
+    }
+    return nullptr;
+}
+
+QString BattleSystem::combatantName(int entityId) const
+{
+    if (entityId == -1) {
+        return m_player->getName();
+    }
+    for (const Enemy &enemy : m_enemies) {
+        if (enemy.id == entityId) {
+            return enemy.name;
+        }
+    }
+    return QString();
+}
+
 void BattleSystem::calculateTurnOrder()
 {
     m_turnOrder.clear();
-    
-    // 收集所有参战单位的速度
+
+    // 收集所有参战单位的速度（单次顺序扫描战斗单位池）
     QList<QPair<int, int>> speedList; // <entityId, speed>
-    
-    // 添加玩家（ID为-1）
-    speedList.append({-1, m_player->getSpeed()});
-    
-    // 添加敌人
-    for (const Enemy &enemy : m_enemies) {
-        if (enemy.health > 0) {
-            speedList.append({enemy.id, enemy.speed});
+
+    for (const BattleCombatant &combatant : m_combatants) {
+        // 玩家（槽0）始终参与排序，敌人只收集存活单位
+        if (combatant.entityId == -1 || combatant.health > 0) {
+            speedList.append({combatant.entityId, combatant.speed});
         }
     }
-    
+
     // 按速度排序（速度高的先行动）
     std::sort(speedList.begin(), speedList.end(),
         [](const QPair<int, int> &a, const QPair<int, int> &b) {
@@ -347,23 +593,56 @@ void BattleSystem::calculateTurnOrder()
     for (const auto &pair : speedList) {
         m_turnOrder.append(pair.first);
     }
-    
+
+    // 同步重建暴露给QML的只读视图
+    m_turnOrderView = QJsonArray();
+    for (int entityId : m_turnOrder) {
+        QJsonObject turnObj;
+        turnObj["type"] = (entityId == -1) ? "player" : "enemy";
+        turnObj["name"] = combatantName(entityId);
+        turnObj["id"] = entityId;
+        m_turnOrderView.append(turnObj);
+    }
+
+    m_turnOrderDirty = false;
+    emit turnOrderChanged();
+
     qDebug() << "BattleSystem: 回合顺序计算完成";
 }
 
+void BattleSystem::markTurnOrderDirty()
+{
+    m_turnOrderDirty = true;
+}
+
 void BattleSystem::startPlayerTurn()
 {
     m_battleState = BattleState::PlayerTurn;
-    
-    // 启动回合计时器
-    int adjustedDuration = static_cast<int>(m_turnDuration / m_battleSpeed);
-    m_turnTimer->start(adjustedDuration);
-    
+
+    // 回合边界同步：状态效果到期/生效对派生属性的影响刷新
+    // 进池（生命值以池为准，不回读）
+    if (!m_combatants.isEmpty()) {
+        m_combatants[0].attack = m_player->getAttack();
+        m_combatants[0].defense = m_player->getDefense();
+        m_combatants[0].speed = m_player->getSpeed();
+    }
+
+    // 回合边界：只有速度事件或单位死亡后才重算回合表
+    if (m_turnOrderDirty) {
+        calculateTurnOrder();
+    }
+
+    // 启动回合计时器（回放模式下同步执行，不走定时器）
+    if (!m_playbackMode) {
+        int adjustedDuration = static_cast<int>(m_turnDuration / m_battleSpeed);
+        m_turnTimer->start(adjustedDuration);
+    }
+
     emit playerTurnStarted();
     addBattleLog(QString("轮到 %1 行动").arg(m_player->getName()));
-    
+
     // 如果是自动模式，延迟执行自动行动
-    if (m_autoMode) {
+    if (m_autoMode && !m_playbackMode) {
         QTimer::singleShot(1000, this, &BattleSystem::executeAutoAction);
     }
 }
@@ -410,80 +689,83 @@ void BattleSystem::endEnemyTurn()
     startPlayerTurn();
 }
 
-void BattleSystem::executePlayerAttack(Enemy &target, int skillId)
+void BattleSystem::executePlayerAttack(BattleCombatant &target, int skillId)
 {
-    // 调用算法服务计算伤害
-    if (m_algorithmClient) {
-        // 构建伤害计算请求
+    const BattleCombatant &self = m_combatants[0];
+
+    // 调用算法服务计算伤害（回放模式走同一路径，响应来自记录）
+    if (m_algorithmClient || m_playbackMode) {
+        // 本地预测先行：立即显示预测伤害，战斗不再等RPC往返。
+        // 预测不判定击杀（血量下限1点），击杀裁定留给权威结果
+        const int targetId = target.entityId;
+        const int healthBefore = target.health;
+        const int predicted = predictDamage(skillId, target);
+
+        target.health = qMax(1, target.health - predicted);
+        addBattleLog(QString("%1 对 %2 使用技能，预计造成 %3 点伤害")
+            .arg(m_player->getName())
+            .arg(combatantName(targetId))
+            .arg(predicted));
+        emit enemiesChanged();
+
+        // 回放模式：按原顺序同步消费记录的RPC响应，不经网络
+        if (m_playbackMode) {
+            QJsonObject result;
+            if (m_playbackResponseIndex < m_playbackResponses.size()) {
+                result = m_playbackResponses.at(m_playbackResponseIndex);
+                ++m_playbackResponseIndex;
+            } else {
+                qWarning() << "BattleSystem: 回放的RPC响应已耗尽";
+            }
+            applyDamageResult(targetId, skillId, healthBefore, result);
+            return;
+        }
+
+        // 构建伤害计算请求（属性全部取自池）
         QJsonObject request;
         request["attackerId"] = -1; // 玩家ID
-        request["defenderId"] = target.id;
+        request["defenderId"] = target.entityId;
         request["skillId"] = skillId;
-        request["attackerLevel"] = m_player->getLevel();
-        request["attackerAttack"] = m_player->getAttack();
+        request["attackerLevel"] = self.level;
+        request["attackerAttack"] = self.attack;
         request["defenderDefense"] = target.defense;
-        
-        // 异步调用算法服务
-        m_algorithmClient->calculateDamage(request, [this, &target, skillId](const QJsonObject &result) {
-            int damage = result["damage"].toInt(0);
-            bool isCritical = result["isCritical"].toBool(false);
-            QString description = result["description"].toString();
-            
-            // 应用伤害
-            target.health = qMax(0, target.health - damage);
-            
-            // 添加战斗日志
-            QString logMessage = QString("%1 对 %2 使用技能造成了 %3 点伤害")
-                .arg(m_player->getName())
-                .arg(target.name)
-                .arg(damage);
-            
-            if (isCritical) {
-                logMessage += " (暴击!)";
-            }
-            
-            addBattleLog(logMessage);
-            
-            // 检查敌人是否死亡
-            if (target.health <= 0) {
-                addBattleLog(QString("%1 被击败了！").arg(target.name));
-                emit enemyDefeated(target.id);
+
+        // 进入客户端流水线：同帧内的多段攻击合并为一次批量RPC，
+        // 回调在事件循环轮次末到达，按敌人ID重新定位目标并以
+        // 权威结果校正预测（RPC失败时damage为0，预测自动回滚）
+        m_algorithmClient->queueDamageRequest(request,
+            [this, targetId, skillId, healthBefore](const QJsonObject &result) {
+            if (m_recordReplay) {
+                m_replay.recordRpcResponse(result);
             }
-            
-            // 发送敌人状态更新信号
-            emit enemiesChanged();
-            
-            // 结束玩家回合
-            endPlayerTurn();
+            applyDamageResult(targetId, skillId, healthBefore, result);
         });
     } else {
         // 简化的本地伤害计算
-        int damage = qMax(1, m_player->getAttack() - target.defense / 2);
-        
-        // 随机暴击
-        bool isCritical = QRandomGenerator::global()->bounded(100) < 10; // 10%暴击率
+        int damage = qMax(1, self.attack - target.defense / 2);
+
+        // 随机暴击（战斗RNG流，可重放）
+        bool isCritical = m_battleRandom.bounded(100) < 10; // 10%暴击率
         if (isCritical) {
             damage *= 2;
         }
-        
+
         target.health = qMax(0, target.health - damage);
-        
-        QString logMessage = QString("%1 攻击 %2 造成了 %3 点伤害")
-            .arg(m_player->getName())
-            .arg(target.name)
-            .arg(damage);
-        
-        if (isCritical) {
-            logMessage += " (暴击!)";
+
+        // 战斗中不格式化：压成一条定长记录，文本在战后异步生成
+        quint16 flags = isCritical ? BattleActionLog::FlagCritical
+                                   : BattleActionLog::FlagNone;
+        if (target.health <= 0) {
+            flags |= BattleActionLog::FlagTargetDefeated;
         }
-        
-        addBattleLog(logMessage);
-        
+        m_actionLog.append(static_cast<quint16>(m_currentTurn), -1,
+                           static_cast<qint16>(target.entityId), 0, damage, flags);
+
         if (target.health <= 0) {
-            addBattleLog(QString("%1 被击败了！").arg(target.name));
-            emit enemyDefeated(target.id);
+            emit enemyDefeated(target.entityId);
+            markTurnOrderDirty();
         }
-        
+
         emit enemiesChanged();
         endPlayerTurn();
     }
@@ -495,8 +777,9 @@ void BattleSystem::executePlayerItemUse(int itemId, int targetId)
     // 简化的物品使用逻辑
     QString itemName = "治疗药水"; // 暂时硬编码
     
-    if (targetId == -1) { // 对自己使用
-        m_player->heal(50);
+    if (targetId == -1 && !m_combatants.isEmpty()) { // 对自己使用
+        BattleCombatant &self = m_combatants[0];
+        self.health = qMin(self.maxHealth, self.health + 50);
         addBattleLog(QString("%1 使用了 %2，恢复了50点生命值")
             .arg(m_player->getName())
             .arg(itemName));
@@ -505,40 +788,85 @@ void BattleSystem::executePlayerItemUse(int itemId, int targetId)
     endPlayerTurn();
 }
 
+void BattleSystem::applyDamageResult(int targetId, int skillId, int healthBefore, const QJsonObject &result)
+{
+    BattleCombatant *enemy = findCombatant(targetId);
+    if (!enemy || enemy->entityId == -1) {
+        endPlayerTurn();
+        return;
+    }
+
+    int damage = result["damage"].toInt(0);
+    bool isCritical = result["isCritical"].toBool(false);
+
+    // 校正: 以攻击前血量和权威伤害重算，覆盖预测值
+    enemy->health = qMax(0, healthBefore - damage);
+
+    // 权威结果只追加一条定长动作记录，文本在战后异步生成
+    quint16 flags = BattleActionLog::FlagSkill;
+    if (isCritical) {
+        flags |= BattleActionLog::FlagCritical;
+    }
+    if (enemy->health <= 0) {
+        flags |= BattleActionLog::FlagTargetDefeated;
+    }
+    m_actionLog.append(static_cast<quint16>(m_currentTurn), -1,
+                       static_cast<qint16>(enemy->entityId),
+                       static_cast<quint16>(skillId), damage, flags);
+
+    // 检查敌人是否死亡
+    if (enemy->health <= 0) {
+        emit enemyDefeated(enemy->entityId);
+        markTurnOrderDirty();
+    }
+
+    // 发送敌人状态更新信号
+    emit enemiesChanged();
+
+    // 结束玩家回合
+    endPlayerTurn();
+}
+
 void BattleSystem::executeEnemyActions()
 {
-    // 为每个存活的敌人执行行动
-    for (Enemy &enemy : m_enemies) {
-        if (enemy.health <= 0) {
+    // 为每个存活的敌人执行行动（顺序扫描池，访问模式对预取友好）
+    for (BattleCombatant &combatant : m_combatants) {
+        if (combatant.entityId == -1 || combatant.health <= 0) {
             continue;
         }
-        
-        executeEnemyAction(enemy);
+
+        executeEnemyAction(combatant);
+    }
+
+    // 延迟结束敌人回合，让玩家看到结果；回放模式直接推进
+    if (m_playbackMode) {
+        endEnemyTurn();
+    } else {
+        QTimer::singleShot(2000 / m_battleSpeed, this, &BattleSystem::endEnemyTurn);
     }
-    
-    // 延迟结束敌人回合，让玩家看到结果
-    QTimer::singleShot(2000 / m_battleSpeed, this, &BattleSystem::endEnemyTurn);
 }
 
-void BattleSystem::executeEnemyAction(Enemy &enemy)
+void BattleSystem::executeEnemyAction(BattleCombatant &enemy)
 {
+    BattleCombatant &player = m_combatants[0];
+
     // 简化的敌人AI：总是攻击玩家
-    int damage = qMax(1, enemy.attack - m_player->getDefense() / 2);
-    
-    // 随机波动
-    damage += QRandomGenerator::global()->bounded(-2, 3);
+    int damage = qMax(1, enemy.attack - player.defense / 2);
+
+    // 随机波动（战斗RNG流，可重放）
+    damage += m_battleRandom.bounded(-2, 3);
     damage = qMax(1, damage);
-    
-    bool playerDied = m_player->takeDamage(damage);
-    
-    addBattleLog(QString("%1 攻击了 %2，造成了 %3 点伤害")
-        .arg(enemy.name)
-        .arg(m_player->getName())
-        .arg(damage));
-    
+
+    // 伤害结算在池内完成，Player在战斗结束时统一写回
+    player.health = qMax(0, player.health - damage);
+    const bool playerDied = (player.health <= 0);
+
+    quint16 flags = BattleActionLog::FlagEnemyAction;
     if (playerDied) {
-        addBattleLog(QString("%1 倒下了！").arg(m_player->getName()));
+        flags |= BattleActionLog::FlagTargetDefeated;
     }
+    m_actionLog.append(static_cast<quint16>(m_currentTurn),
+                       static_cast<qint16>(enemy.entityId), -1, 0, damage, flags);
 }
 
 void BattleSystem::executeAutoAction()
@@ -548,20 +876,38 @@ void BattleSystem::executeAutoAction()
     }
     
     // 简化的自动战斗逻辑：攻击第一个存活的敌人
-    for (const Enemy &enemy : m_enemies) {
-        if (enemy.health > 0) {
-            playerAttack(enemy.id, 0); // 使用基础攻击
+    for (const BattleCombatant &combatant : m_combatants) {
+        if (combatant.entityId != -1 && combatant.health > 0) {
+            playerAttack(combatant.entityId, 0); // 使用基础攻击
             break;
         }
     }
 }
 
+int BattleSystem::predictDamage(int skillId, const BattleCombatant &target) const
+{
+    // 镜像服务端公式: 攻击力 × 技能倍率 × (1 - defense/(defense+100))，
+    // 不含暴击与±5%浮动——预测取确定性期望下界
+    const double skillMultiplier = m_algorithmClient
+        ? m_algorithmClient->skillDamageMultiplier(skillId)
+        : 1.0;
+    const double defense = qMax(0, target.defense);
+    const double defenseMultiplier = 1.0 - defense / (defense + 100.0);
+    const double predicted = m_combatants[0].attack * skillMultiplier * defenseMultiplier;
+    return qMax(1, qRound(predicted));
+}
+
 bool BattleSystem::checkBattleEnd()
 {
-    // 检查玩家是否死亡
-    if (m_player->getHealth() <= 0) {
+    if (m_combatants.isEmpty()) {
+        return false;
+    }
+
+    // 检查玩家是否死亡（池为战斗期间的权威状态）
+    if (m_combatants[0].health <= 0) {
         m_battleState = BattleState::Defeat;
         addBattleLog("战斗失败！");
+        m_actionLog.flushAsync();
         emit battleDefeated();
         endBattle();
         return true;
@@ -569,26 +915,27 @@ bool BattleSystem::checkBattleEnd()
     
     // 检查是否所有敌人都被击败
     bool allEnemiesDefeated = true;
-    for (const Enemy &enemy : m_enemies) {
-        if (enemy.health > 0) {
+    for (const BattleCombatant &combatant : m_combatants) {
+        if (combatant.entityId != -1 && combatant.health > 0) {
             allEnemiesDefeated = false;
             break;
         }
     }
-    
+
     if (allEnemiesDefeated) {
         m_battleState = BattleState::Victory;
         addBattleLog("战斗胜利！");
-        
+
         // 计算经验奖励
         int expReward = 0;
         for (const Enemy &enemy : m_enemies) {
             expReward += enemy.level * 10;
         }
-        
+
         m_player->addExperience(expReward);
         addBattleLog(QString("获得了 %1 点经验值").arg(expReward));
-        
+        m_actionLog.flushAsync();
+
         emit battleWon();
         endBattle();
         return true;
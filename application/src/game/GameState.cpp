@@ -30,6 +30,7 @@
  */
 
 #include "game/GameState.h"
+#include <QJsonArray>
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QJsonValue>
@@ -164,6 +165,9 @@ void GameState::setState(State state)
             break;
     }
     
+    recordChange(SaveSection::Progress, "currentState",
+                 static_cast<int>(m_currentState));
+
     // 发送状态变更信号
     emit stateChanged(m_currentState, oldState);
     emit gamePausedChanged(m_currentState == State::Paused);
@@ -269,6 +273,8 @@ void GameState::setPlayerLevel(int level)
         emit playerLevelUp(newLevel, oldLevel);
     }
     
+    recordChange(SaveSection::PlayerStats, "playerLevel", m_playerLevel);
+
     // 发送等级变更信号
     emit playerLevelChanged(m_playerLevel);
 }
@@ -305,6 +311,8 @@ void GameState::setPlayerExperience(int experience)
         }
     }
     
+    recordChange(SaveSection::PlayerStats, "playerExperience", m_playerExperience);
+
     // 发送经验值变更信号
     emit playerExperienceChanged(m_playerExperience);
 }
@@ -379,6 +387,8 @@ void GameState::setPlayerGold(int gold)
     
     m_playerGold = newGold;
     
+    recordChange(SaveSection::PlayerStats, "playerGold", m_playerGold);
+
     // 发送金币变更信号
     emit playerGoldChanged(m_playerGold);
 }
@@ -408,6 +418,8 @@ void GameState::setPlayerName(const QString &name)
     
     m_playerName = newName;
     
+    recordChange(SaveSection::PlayerStats, "playerName", m_playerName);
+
     // 发送姓名变更信号
     emit playerNameChanged(m_playerName);
 }
@@ -428,6 +440,9 @@ void GameState::setPlayerClass(PlayerClass playerClass)
     
     m_playerClass = playerClass;
     
+    recordChange(SaveSection::PlayerStats, "playerClass",
+                 static_cast<int>(m_playerClass));
+
     // 发送职业变更信号
     emit playerClassChanged(m_playerClass);
 }
@@ -443,6 +458,7 @@ void GameState::setCurrentScene(const QString &scene)
     qDebug() << "GameState: 切换场景:" << m_currentScene << "->" << scene;
 
     m_currentScene = scene;
+    recordChange(SaveSection::Progress, "currentScene", m_currentScene);
     emit currentSceneChanged(m_currentScene);
 }
 
@@ -516,5 +532,273 @@ bool GameState::loadFromJson(const QJsonObject &json)
     int stateInt = json["currentState"].toInt(static_cast<int>(State::MainMenu));
     setState(static_cast<State>(stateInt));
 
+    // 加载后基线未知（补丁文件随后会被截断），全部置脏，
+    // 下一次自动存档重建完整基线
+    m_dirtySections.store(static_cast<quint32>(SaveSection::All), std::memory_order_release);
+
+    // 批量加载绕过了setter，逐键日志无法覆盖，整体失效
+    invalidateJournal();
+
     return true;
 }
+
+/**
+ * @brief 标记存档段为脏
+ * @param section 被修改的段
+ *
+ * 原子置位，setter在持有或不持有互斥锁的情况下都可调用
+ */
+void GameState::markSectionDirty(SaveSection section)
+{
+    m_dirtySections.fetch_or(static_cast<quint32>(section), std::memory_order_acq_rel);
+}
+
+/**
+ * @brief 记录一条状态变更
+ * @param section 变更所属段
+ * @param key 变更键
+ * @param value 变更后的新值
+ *
+ * 调用方持有m_mutex；窗口满时丢弃最老的记录并抬高可服务
+ * 下界，过旧的消费端退回完整快照
+ */
+void GameState::recordChange(SaveSection section, const QString &key, const QVariant &value)
+{
+    ++m_stateVersion;
+    m_journal.append(StateChangeRecord{m_stateVersion, section, key, value});
+    while (m_journal.size() > JOURNAL_CAPACITY) {
+        m_journal.removeFirst();
+        m_journalFloor = m_journal.first().version - 1;
+    }
+
+    markSectionDirty(section);
+}
+
+/**
+ * @brief 使变更日志整体失效
+ *
+ * 版本号跳变一次，使所有旧版本都落在日志窗口之外
+ */
+void GameState::invalidateJournal()
+{
+    QMutexLocker locker(&m_mutex);
+    ++m_stateVersion;
+    m_journal.clear();
+    m_journalFloor = m_stateVersion;
+}
+
+quint64 GameState::stateVersion() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_stateVersion;
+}
+
+bool GameState::changesSince(quint64 sinceVersion, QVector<StateChangeRecord> *outChanges) const
+{
+    QMutexLocker locker(&m_mutex);
+
+    if (outChanges) {
+        outChanges->clear();
+    }
+
+    // 消费端已是最新，无变更
+    if (sinceVersion == m_stateVersion) {
+        return true;
+    }
+
+    // 版本超前（如来自旧进程）或过旧，日志无法服务
+    if (sinceVersion > m_stateVersion || sinceVersion < m_journalFloor) {
+        return false;
+    }
+
+    if (outChanges) {
+        for (const StateChangeRecord &record : m_journal) {
+            if (record.version > sinceVersion) {
+                outChanges->append(record);
+            }
+        }
+    }
+    return true;
+}
+
+QString GameState::jsonPointerSegment(const QString &key)
+{
+    QString escaped = key;
+    escaped.replace(QLatin1String("~"), QLatin1String("~0"));
+    escaped.replace(QLatin1String("/"), QLatin1String("~1"));
+    return escaped;
+}
+
+QString GameState::pathForChange(SaveSection section, const QString &key)
+{
+    if (section == SaveSection::StateData) {
+        return QStringLiteral("/stateData/") + jsonPointerSegment(key);
+    }
+    return QStringLiteral("/") + jsonPointerSegment(key);
+}
+
+bool GameState::patchSince(quint64 sinceVersion, QJsonArray *outPatch,
+                           quint64 *outVersion) const
+{
+    QMutexLocker locker(&m_mutex);
+
+    if (outPatch) {
+        outPatch->clear();
+    }
+    if (outVersion) {
+        *outVersion = m_stateVersion;
+    }
+
+    if (sinceVersion == m_stateVersion) {
+        return true; // 已是最新，空补丁
+    }
+    if (sinceVersion > m_stateVersion || sinceVersion < m_journalFloor) {
+        return false;
+    }
+
+    // 同键去重：保留首次出现的顺序、最后一次变更的值
+    QStringList orderedPaths;
+    QHash<QString, const StateChangeRecord*> latestByPath;
+    for (const StateChangeRecord &record : m_journal) {
+        if (record.version <= sinceVersion) {
+            continue;
+        }
+        const QString path = pathForChange(record.section, record.key);
+        if (!latestByPath.contains(path)) {
+            orderedPaths.append(path);
+        }
+        latestByPath.insert(path, &record);
+    }
+
+    if (outPatch) {
+        for (const QString &path : orderedPaths) {
+            const StateChangeRecord *record = latestByPath.value(path);
+            QJsonObject op;
+            // 顶层键在toJson()里恒存在，用replace；stateData成员
+            // 可能是新增键，add对对象成员即插入或覆盖
+            op["op"] = path.startsWith(QLatin1String("/stateData/"))
+                           ? QStringLiteral("add")
+                           : QStringLiteral("replace");
+            op["path"] = path;
+            op["value"] = QJsonValue::fromVariant(record->value);
+            outPatch->append(op);
+        }
+    }
+    return true;
+}
+
+namespace {
+
+/**
+ * @brief 沿对象成员路径递归应用单个补丁操作
+ *
+ * QJsonObject取子对象是值拷贝，修改后需要逐层写回。
+ */
+bool applyOpAtPath(QJsonObject &object, const QStringList &segments, int depth,
+                   const QString &kind, const QJsonValue &value)
+{
+    const QString &key = segments.at(depth);
+
+    if (depth == segments.size() - 1) {
+        if (kind == QLatin1String("remove")) {
+            if (!object.contains(key)) {
+                return false;
+            }
+            object.remove(key);
+            return true;
+        }
+        if (kind == QLatin1String("replace") && !object.contains(key)) {
+            return false;
+        }
+        if (kind == QLatin1String("add") || kind == QLatin1String("replace")) {
+            object[key] = value;
+            return true;
+        }
+        return false; // 不支持的操作（move/copy/test）
+    }
+
+    // 中间节点必须是对象；add允许按需创建缺失的中间对象
+    if (object.contains(key) && !object[key].isObject()) {
+        return false;
+    }
+    if (!object.contains(key) && kind != QLatin1String("add")) {
+        return false;
+    }
+    QJsonObject child = object[key].toObject();
+    if (!applyOpAtPath(child, segments, depth + 1, kind, value)) {
+        return false;
+    }
+    object[key] = child;
+    return true;
+}
+
+} // namespace
+
+bool GameState::applyJsonPatch(QJsonObject &target, const QJsonArray &patch)
+{
+    for (const QJsonValue &entry : patch) {
+        const QJsonObject op = entry.toObject();
+        const QString kind = op["op"].toString();
+        const QString path = op["path"].toString();
+        if (!path.startsWith(QLatin1Char('/'))) {
+            return false;
+        }
+
+        QStringList segments = path.mid(1).split(QLatin1Char('/'));
+        for (QString &segment : segments) {
+            segment.replace(QLatin1String("~1"), QLatin1String("/"));
+            segment.replace(QLatin1String("~0"), QLatin1String("~"));
+        }
+        if (segments.isEmpty()) {
+            return false;
+        }
+
+        if (!applyOpAtPath(target, segments, 0, kind, op["value"])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief 序列化单个存档段
+ * @param section 要序列化的段
+ * @return QJsonObject 段数据快照
+ *
+ * 键名与toJson()保持一致，段快照可按键合并回完整存档
+ */
+QJsonObject GameState::sectionToJson(SaveSection section) const
+{
+    QMutexLocker locker(&m_mutex);
+
+    QJsonObject json;
+    switch (section) {
+        case SaveSection::PlayerStats:
+            json["playerLevel"] = m_playerLevel;
+            json["playerExperience"] = m_playerExperience;
+            json["playerGold"] = m_playerGold;
+            json["playerName"] = m_playerName;
+            json["playerClass"] = static_cast<int>(m_playerClass);
+            break;
+
+        case SaveSection::Progress:
+            json["currentState"] = static_cast<int>(m_currentState);
+            json["currentScene"] = m_currentScene;
+            json["gameProgress"] = static_cast<double>(m_gameProgress);
+            break;
+
+        case SaveSection::StateData: {
+            QJsonObject stateData;
+            for (auto it = m_stateData.begin(); it != m_stateData.end(); ++it) {
+                stateData[it.key()] = QJsonValue::fromVariant(it.value());
+            }
+            json["stateData"] = stateData;
+            break;
+        }
+
+        default:
+            break;
+    }
+
+    return json;
+}
@@ -14,16 +14,20 @@
 #include <QStandardPaths>
 #include <QDebug>
 #include <algorithm>
+#include <bit>
 
 namespace Game {
 
 InventorySystem::InventorySystem(QObject* parent)
     : QObject(parent)
     , m_capacity(50)  // 默认50个槽位
+    , m_sortActive(false)
+    , m_sortCursor(0)
 {
     // 初始化背包槽位
     m_slots.resize(m_capacity);
-    
+    rebuildIndices();
+
     // 设置数据文件路径
     QString dataDir = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation);
     QDir().mkpath(dataDir);
@@ -59,26 +63,27 @@ bool InventorySystem::addItem(int itemId, int quantity)
         return false;
     }
     
+    cancelIncrementalSort();
     int remainingQuantity = quantity;
-    
-    // 首先尝试添加到现有堆叠
+
+    // 首先尝试添加到现有堆叠（槽位来自索引，无需全量扫描）
     if (itemData.maxStack > 1) {
         QList<int> existingSlots = findItemSlots(itemId);
         for (int slotIndex : existingSlots) {
-            InventorySlot& slot = m_slots[slotIndex];
+            const InventorySlot& slot = m_slots[slotIndex];
             int canAdd = itemData.maxStack - slot.quantity;
             if (canAdd > 0) {
                 int addAmount = qMin(canAdd, remainingQuantity);
-                slot.quantity += addAmount;
+                writeSlot(slotIndex, InventorySlot(itemId, slot.quantity + addAmount));
                 remainingQuantity -= addAmount;
-                
+
                 if (remainingQuantity == 0) {
                     break;
                 }
             }
         }
     }
-    
+
     // 如果还有剩余，添加到新槽位
     while (remainingQuantity > 0) {
         int emptySlot = findEmptySlot();
@@ -87,9 +92,9 @@ bool InventorySystem::addItem(int itemId, int quantity)
             emit inventoryFull();
             return false;
         }
-        
+
         int addAmount = qMin(remainingQuantity, itemData.maxStack);
-        m_slots[emptySlot] = InventorySlot(itemId, addAmount);
+        writeSlot(emptySlot, InventorySlot(itemId, addAmount));
         remainingQuantity -= addAmount;
     }
     
@@ -111,22 +116,18 @@ bool InventorySystem::removeItem(int itemId, int quantity)
         return false;
     }
     
+    cancelIncrementalSort();
     int remainingQuantity = quantity;
     QList<int> itemSlots = findItemSlots(itemId);
-    
+
     // 从后往前移除，避免索引问题
     for (int i = itemSlots.size() - 1; i >= 0 && remainingQuantity > 0; --i) {
         int slotIndex = itemSlots[i];
-        InventorySlot& slot = m_slots[slotIndex];
-        
+        const InventorySlot& slot = m_slots[slotIndex];
+
         int removeAmount = qMin(slot.quantity, remainingQuantity);
-        slot.quantity -= removeAmount;
+        writeSlot(slotIndex, InventorySlot(itemId, slot.quantity - removeAmount));
         remainingQuantity -= removeAmount;
-        
-        // 如果槽位空了，清空
-        if (slot.quantity == 0) {
-            slot.itemId = 0;
-        }
     }
     
     updateInventoryState();
@@ -164,10 +165,8 @@ bool InventorySystem::useItem(int slotIndex, int quantity)
     }
 
     // 减少物品数量
-    slot.quantity -= quantity;
-    if (slot.quantity == 0) {
-        slot.itemId = 0;
-    }
+    cancelIncrementalSort();
+    writeSlot(slotIndex, InventorySlot(itemId, slot.quantity - quantity));
 
     updateInventoryState();
     emit itemUsed(itemId, quantity);
@@ -183,44 +182,40 @@ bool InventorySystem::moveItem(int fromSlot, int toSlot)
         return false;
     }
     
-    InventorySlot& from = m_slots[fromSlot];
-    InventorySlot& to = m_slots[toSlot];
-    
+    const InventorySlot from = m_slots[fromSlot];
+    const InventorySlot to = m_slots[toSlot];
+
     if (from.isEmpty()) {
         return false;
     }
-    
+
+    cancelIncrementalSort();
+
     // 如果目标槽位为空，直接移动
     if (to.isEmpty()) {
-        to = from;
-        from = InventorySlot();
+        writeSlot(toSlot, from);
+        writeSlot(fromSlot, InventorySlot());
         updateInventoryState();
         return true;
     }
-    
+
     // 如果是相同物品，尝试合并
     if (from.itemId == to.itemId) {
         ItemData itemData = getItemData(from.itemId);
         int canMerge = itemData.maxStack - to.quantity;
         if (canMerge > 0) {
             int mergeAmount = qMin(canMerge, from.quantity);
-            to.quantity += mergeAmount;
-            from.quantity -= mergeAmount;
-            
-            if (from.quantity == 0) {
-                from = InventorySlot();
-            }
-            
+            writeSlot(toSlot, InventorySlot(to.itemId, to.quantity + mergeAmount));
+            writeSlot(fromSlot, InventorySlot(from.itemId, from.quantity - mergeAmount));
             updateInventoryState();
             return true;
         }
     }
-    
+
     // 否则交换位置
-    InventorySlot temp = from;
-    from = to;
-    to = temp;
-    
+    writeSlot(fromSlot, to);
+    writeSlot(toSlot, from);
+
     updateInventoryState();
     return true;
 }
@@ -231,44 +226,37 @@ int InventorySystem::splitItem(int slotIndex, int quantity)
         return -1;
     }
     
-    InventorySlot& slot = m_slots[slotIndex];
+    const InventorySlot slot = m_slots[slotIndex];
     if (slot.isEmpty() || slot.quantity <= quantity) {
         return -1;
     }
-    
+
     int emptySlot = findEmptySlot();
     if (emptySlot == -1) {
         return -1;
     }
-    
+
     // 分割物品
-    slot.quantity -= quantity;
-    m_slots[emptySlot] = InventorySlot(slot.itemId, quantity);
-    
+    cancelIncrementalSort();
+    writeSlot(slotIndex, InventorySlot(slot.itemId, slot.quantity - quantity));
+    writeSlot(emptySlot, InventorySlot(slot.itemId, quantity));
+
     updateInventoryState();
     return emptySlot;
 }
 
 int InventorySystem::getUsedSlots() const
 {
-    int count = 0;
-    for (const InventorySlot& slot : m_slots) {
-        if (!slot.isEmpty()) {
-            count++;
-        }
+    int freeCount = 0;
+    for (quint64 bits : m_freeSlotBits) {
+        freeCount += std::popcount(bits);
     }
-    return count;
+    return m_capacity - freeCount;
 }
 
 int InventorySystem::getItemCount(int itemId) const
 {
-    int totalCount = 0;
-    for (const InventorySlot& slot : m_slots) {
-        if (slot.itemId == itemId) {
-            totalCount += slot.quantity;
-        }
-    }
-    return totalCount;
+    return m_itemCounts.value(itemId, 0);
 }
 
 bool InventorySystem::hasItem(int itemId, int quantity) const
@@ -399,9 +387,11 @@ void InventorySystem::setCapacity(int capacity)
         }
     }
     
+    cancelIncrementalSort();
     m_capacity = capacity;
     m_slots.resize(capacity);
-    
+    rebuildIndices();
+
     emit capacityChanged(capacity);
     updateInventoryState();
     
@@ -479,7 +469,9 @@ bool InventorySystem::loadInventory(const QString& filePath)
         m_slots[i].itemId = slotObj["itemId"].toInt();
         m_slots[i].quantity = slotObj["quantity"].toInt();
     }
-    
+
+    cancelIncrementalSort();
+    rebuildIndices();
     updateInventoryState();
     qDebug() << "InventorySystem: 背包数据加载成功";
     return true;
@@ -487,16 +479,20 @@ bool InventorySystem::loadInventory(const QString& filePath)
 
 void InventorySystem::clearInventory()
 {
+    cancelIncrementalSort();
     for (InventorySlot& slot : m_slots) {
         slot = InventorySlot();
     }
-    
+    rebuildIndices();
+
     updateInventoryState();
     qDebug() << "InventorySystem: 背包已清空";
 }
 
 void InventorySystem::sortInventory()
 {
+    cancelIncrementalSort();
+
     // 收集所有非空物品
     QList<InventorySlot> items;
     for (const InventorySlot& slot : m_slots) {
@@ -504,28 +500,101 @@ void InventorySystem::sortInventory()
             items.append(slot);
         }
     }
-    
+
     // 按物品ID排序
     std::sort(items.begin(), items.end(), [](const InventorySlot& a, const InventorySlot& b) {
         return a.itemId < b.itemId;
     });
-    
+
     // 清空背包
     for (InventorySlot& slot : m_slots) {
         slot = InventorySlot();
     }
-    
+
     // 重新放置物品
     int slotIndex = 0;
     for (const InventorySlot& item : items) {
         if (slotIndex >= m_capacity) break;
         m_slots[slotIndex++] = item;
     }
-    
+
+    rebuildIndices();
     updateInventoryState();
     qDebug() << "InventorySystem: 背包整理完成";
 }
 
+void InventorySystem::beginIncrementalSort()
+{
+    // 目标排列：非空槽位按物品ID排序放到前部，空槽位在后
+    QVector<int> occupied;
+    QVector<int> empty;
+    occupied.reserve(m_slots.size());
+    for (int i = 0; i < m_slots.size(); ++i) {
+        if (m_slots[i].isEmpty()) {
+            empty.append(i);
+        } else {
+            occupied.append(i);
+        }
+    }
+
+    std::stable_sort(occupied.begin(), occupied.end(), [this](int a, int b) {
+        return m_slots[a].itemId < m_slots[b].itemId;
+    });
+
+    m_sortOrder = occupied + empty;
+    m_sortPos.resize(m_slots.size());
+    m_sortAt.resize(m_slots.size());
+    for (int i = 0; i < m_slots.size(); ++i) {
+        m_sortPos[i] = i;
+        m_sortAt[i] = i;
+    }
+    m_sortCursor = 0;
+    m_sortActive = true;
+
+    qDebug() << "InventorySystem: 开始增量整理，槽位数:" << m_slots.size();
+}
+
+bool InventorySystem::stepIncrementalSort(int maxSwaps)
+{
+    if (!m_sortActive) {
+        return true;
+    }
+
+    // 把目标排列中第cursor个元素换到cursor位置；位置映射
+    // 使每次交换都是O(1)，每帧只消费maxSwaps次交换的预算
+    int swaps = 0;
+    bool changed = false;
+    while (m_sortCursor < m_sortOrder.size() && swaps < maxSwaps) {
+        const int orig = m_sortOrder[m_sortCursor];
+        const int cur = m_sortPos[orig];
+        if (cur != m_sortCursor) {
+            const int otherOrig = m_sortAt[m_sortCursor];
+            const InventorySlot temp = m_slots[m_sortCursor];
+            writeSlot(m_sortCursor, m_slots[cur]);
+            writeSlot(cur, temp);
+
+            m_sortPos[orig] = m_sortCursor;
+            m_sortPos[otherOrig] = cur;
+            m_sortAt[m_sortCursor] = orig;
+            m_sortAt[cur] = otherOrig;
+
+            ++swaps;
+            changed = true;
+        }
+        ++m_sortCursor;
+    }
+
+    if (m_sortCursor >= m_sortOrder.size()) {
+        m_sortActive = false;
+        qDebug() << "InventorySystem: 增量整理完成";
+    }
+
+    if (changed) {
+        updateInventoryState();
+    }
+    return !m_sortActive;
+}
+
 QJsonArray InventorySystem::getItemsJson() const
 {
     QJsonArray itemsArray;
@@ -554,9 +623,11 @@ void InventorySystem::reloadItemData()
 
 int InventorySystem::findEmptySlot() const
 {
-    for (int i = 0; i < m_slots.size(); ++i) {
-        if (m_slots[i].isEmpty()) {
-            return i;
+    // 位图扫描：每个字覆盖64个槽位，首个置位即最低空槽
+    for (int word = 0; word < m_freeSlotBits.size(); ++word) {
+        const quint64 bits = m_freeSlotBits[word];
+        if (bits != 0) {
+            return word * 64 + std::countr_zero(bits);
         }
     }
     return -1;
@@ -564,12 +635,8 @@ int InventorySystem::findEmptySlot() const
 
 QList<int> InventorySystem::findItemSlots(int itemId) const
 {
-    QList<int> result;
-    for (int i = 0; i < m_slots.size(); ++i) {
-        if (m_slots[i].itemId == itemId) {
-            result.append(i);
-        }
-    }
+    QList<int> result = m_itemSlotIndex.value(itemId).values();
+    std::sort(result.begin(), result.end());
     return result;
 }
 
@@ -625,6 +692,79 @@ void InventorySystem::loadDefaultItemData()
     qDebug() << "InventorySystem: 默认物品数据加载完成";
 }
 
+void InventorySystem::writeSlot(int slotIndex, const InventorySlot& value)
+{
+    InventorySlot normalized = value;
+    if (normalized.itemId == 0 || normalized.quantity <= 0) {
+        normalized = InventorySlot();
+    }
+
+    InventorySlot& slot = m_slots[slotIndex];
+    if (slot.itemId == normalized.itemId && slot.quantity == normalized.quantity) {
+        return;
+    }
+
+    // 撤销旧内容的索引贡献
+    if (!slot.isEmpty()) {
+        int& oldCount = m_itemCounts[slot.itemId];
+        oldCount -= slot.quantity;
+        if (oldCount <= 0) {
+            m_itemCounts.remove(slot.itemId);
+        }
+        auto it = m_itemSlotIndex.find(slot.itemId);
+        if (it != m_itemSlotIndex.end()) {
+            it->remove(slotIndex);
+            if (it->isEmpty()) {
+                m_itemSlotIndex.erase(it);
+            }
+        }
+    }
+
+    slot = normalized;
+
+    // 记入新内容
+    if (!slot.isEmpty()) {
+        m_itemCounts[slot.itemId] += slot.quantity;
+        m_itemSlotIndex[slot.itemId].insert(slotIndex);
+    }
+
+    // 同步空槽位位图
+    const quint64 mask = quint64(1) << (slotIndex % 64);
+    if (slot.isEmpty()) {
+        m_freeSlotBits[slotIndex / 64] |= mask;
+    } else {
+        m_freeSlotBits[slotIndex / 64] &= ~mask;
+    }
+
+    emit slotChanged(slotIndex);
+}
+
+void InventorySystem::rebuildIndices()
+{
+    m_itemSlotIndex.clear();
+    m_itemCounts.clear();
+    m_freeSlotBits.clear();
+    m_freeSlotBits.resize((m_slots.size() + 63) / 64);
+
+    for (int i = 0; i < m_slots.size(); ++i) {
+        const InventorySlot& slot = m_slots[i];
+        if (slot.isEmpty()) {
+            m_freeSlotBits[i / 64] |= quint64(1) << (i % 64);
+        } else {
+            m_itemCounts[slot.itemId] += slot.quantity;
+            m_itemSlotIndex[slot.itemId].insert(i);
+        }
+    }
+}
+
+void InventorySystem::cancelIncrementalSort()
+{
+    if (m_sortActive) {
+        m_sortActive = false;
+        qDebug() << "InventorySystem: 背包变更，增量整理已取消";
+    }
+}
+
 bool InventorySystem::applyItemEffect(const ItemData &itemData)
 {
     // 根据物品ID应用不同效果
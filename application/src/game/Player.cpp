@@ -17,6 +17,7 @@ Player::Player(QObject *parent)
     , m_profession(PlayerProfession::Warrior)
     , m_level(1)
     , m_experience(0)
+    , m_derivedDirty(false)
     , m_skillPoints(0)
     , m_attributePoints(0)
     , m_totalPlayTime(0)
@@ -77,10 +78,10 @@ void Player::setProfession(PlayerProfession profession)
 {
     if (m_profession != profession) {
         m_profession = profession;
-        
-        // 重新计算属性加成
-        applyStatusEffects();
-        
+
+        // 属性加成留待下次读取时重算
+        markDerivedDirty();
+
         emit professionChanged();
         qDebug() << "Player: 设置职业为" << getProfessionString();
     }
@@ -113,9 +114,10 @@ void Player::initializeNewPlayer()
             break;
     }
     
-    // 复制到当前属性
+    // 复制到当前属性（1级无加成，缓存即有效）
     m_attributes = m_baseAttributes;
-    
+    m_derivedDirty = false;
+
     // 清空状态效果
     m_statusEffects.clear();
     
@@ -178,13 +180,12 @@ void Player::levelUp()
     m_baseAttributes.speed += growth.speed;
     m_baseAttributes.luck += growth.luck;
     
-    // 恢复生命值和魔法值
-    m_attributes.health = m_baseAttributes.maxHealth;
-    m_attributes.mana = m_baseAttributes.maxMana;
-    
-    // 重新应用所有效果
-    applyStatusEffects();
-    
+    // 重算派生属性后按新上限完全恢复生命值和魔法值
+    markDerivedDirty();
+    ensureDerived();
+    m_attributes.health = m_attributes.maxHealth;
+    m_attributes.mana = m_attributes.maxMana;
+
     // 发送信号
     emit levelChanged();
     emit experienceChanged();
@@ -206,7 +207,9 @@ bool Player::takeDamage(int damage)
     if (damage <= 0) {
         return false;
     }
-    
+
+    ensureDerived();
+
     // 计算实际伤害（考虑防御力）
     int actualDamage = qMax(1, damage - m_attributes.defense / 2);
     
@@ -231,6 +234,7 @@ void Player::heal(int amount)
         return;
     }
     
+    ensureDerived();
     int oldHealth = m_attributes.health;
     m_attributes.health = qMin(m_attributes.maxHealth, m_attributes.health + amount);
     
@@ -243,10 +247,11 @@ void Player::heal(int amount)
 
 bool Player::consumeMana(int amount)
 {
+    ensureDerived();
     if (amount <= 0 || m_attributes.mana < amount) {
         return false;
     }
-    
+
     m_attributes.mana -= amount;
     emit manaChanged();
     
@@ -260,6 +265,7 @@ void Player::restoreMana(int amount)
         return;
     }
     
+    ensureDerived();
     int oldMana = m_attributes.mana;
     m_attributes.mana = qMin(m_attributes.maxMana, m_attributes.mana + amount);
     
@@ -278,11 +284,22 @@ void Player::addStatusEffect(const StatusEffect &effect)
             m_statusEffects[effect.name].duration, effect.duration);
     } else {
         m_statusEffects[effect.name] = effect;
+
+        // 一次性生命/魔法加成在添加时立即生效，
+        // 不参与派生属性重算（避免重算时重复累加）
+        const QJsonObject props = effect.properties;
+        if (props.contains("healthBonus")) {
+            heal(props["healthBonus"].toInt());
+        }
+        if (props.contains("manaBonus")) {
+            restoreMana(props["manaBonus"].toInt());
+        }
+
         emit statusEffectAdded(effect.name);
     }
-    
-    // 重新应用状态效果
-    applyStatusEffects();
+
+    // 持续性加成留待下次属性读取时重算
+    markDerivedDirty();
     emit statusEffectsChanged();
     
     qDebug() << "Player: 添加状态效果" << effect.name << "持续时间:" << effect.duration;
@@ -291,8 +308,8 @@ void Player::addStatusEffect(const StatusEffect &effect)
 void Player::removeStatusEffect(const QString &effectName)
 {
     if (m_statusEffects.remove(effectName) > 0) {
-        // 重新应用状态效果
-        applyStatusEffects();
+        // 持续性加成失效，标脏等待重算
+        markDerivedDirty();
         emit statusEffectsChanged();
         emit statusEffectRemoved(effectName);
         
@@ -322,8 +339,9 @@ QJsonArray Player::getStatusEffectsJson() const
 
 QJsonObject Player::getPlayerInfo() const
 {
+    ensureDerived();
     QJsonObject info;
-    
+
     info["name"] = m_name;
     info["profession"] = getProfessionString();
     info["level"] = m_level;
@@ -426,12 +444,10 @@ QJsonObject Player::getLevelUpPreview() const
 
 void Player::resetAttributes()
 {
-    // 重置到基础属性
+    // 重置到基础属性并立即重算所有加成
     m_attributes = m_baseAttributes;
-    
-    // 重新计算所有加成
-    applyStatusEffects();
-    
+    recalculateAll();
+
     // 发送所有属性变更信号
     emit healthChanged();
     emit maxHealthChanged();
@@ -475,8 +491,9 @@ QJsonArray Player::getProfessionSkills() const
 
 QJsonObject Player::toJson() const
 {
+    ensureDerived();
     QJsonObject json;
-    
+
     json["name"] = m_name;
     json["profession"] = static_cast<int>(m_profession);
     json["level"] = m_level;
@@ -562,6 +579,9 @@ bool Player::loadFromJson(const QJsonObject &json)
             m_statusEffects[effect.name] = effect;
         }
         
+        // 批量加载完成，一次性重算派生属性
+        recalculateAll();
+
         // 发送所有变更信号
         emit nameChanged();
         emit professionChanged();
@@ -657,35 +677,37 @@ void Player::updateStatusEffects(float deltaTime)
     }
 }
 
-void Player::applyStatusEffects()
+void Player::applyStatusEffects() const
 {
-    // 重置到基础属性
+    // 当前生命值和魔法值是有状态量，重算时保留
+    const int currentHealth = m_attributes.health;
+    const int currentMana = m_attributes.mana;
+
+    // 派生部分从基础属性重算
     m_attributes = m_baseAttributes;
-    
+    m_attributes.health = currentHealth;
+    m_attributes.mana = currentMana;
+
     // 应用职业加成
     PlayerAttributes professionBonus = calculateProfessionBonus();
     int levelBonus = m_level - 1; // 1级时没有加成
-    
+
     m_attributes.maxHealth += professionBonus.maxHealth * levelBonus;
     m_attributes.maxMana += professionBonus.maxMana * levelBonus;
     m_attributes.attack += professionBonus.attack * levelBonus;
     m_attributes.defense += professionBonus.defense * levelBonus;
     m_attributes.speed += professionBonus.speed * levelBonus;
     m_attributes.luck += professionBonus.luck * levelBonus;
-    
-    // 应用状态效果
+
+    // 应用状态效果的持续性加成
+    // （一次性的healthBonus/manaBonus在addStatusEffect时已生效，
+    //  重算只处理可重复计算的上限和战斗属性加成）
     for (const StatusEffect &effect : m_statusEffects) {
         QJsonObject props = effect.properties;
-        
-        if (props.contains("healthBonus")) {
-            m_attributes.health += props["healthBonus"].toInt();
-        }
+
         if (props.contains("maxHealthBonus")) {
             m_attributes.maxHealth += props["maxHealthBonus"].toInt();
         }
-        if (props.contains("manaBonus")) {
-            m_attributes.mana += props["manaBonus"].toInt();
-        }
         if (props.contains("maxManaBonus")) {
             m_attributes.maxMana += props["maxManaBonus"].toInt();
         }
@@ -702,8 +724,14 @@ void Player::applyStatusEffects()
             m_attributes.luck += props["luckBonus"].toInt();
         }
     }
-    
+
     // 确保当前生命值和魔法值不超过最大值
     m_attributes.health = qMin(m_attributes.health, m_attributes.maxHealth);
     m_attributes.mana = qMin(m_attributes.mana, m_attributes.maxMana);
+}
+
+void Player::recalculateAll()
+{
+    markDerivedDirty();
+    ensureDerived();
 }
\ No newline at end of file
@@ -6,18 +6,22 @@
  */
 
 #include "graphics/AnimationManager.h"
+#include "core/FrameAllocator.h"
 #include <QDebug>
 #include <QTimer>
 #include <algorithm>
+#include <cmath>
+#include <iterator>
 
 AnimationManager::AnimationManager(QObject *parent)
     : QObject(parent)
     , m_updateTimer(new QTimer(this))
     , m_animationEnabled(true)
     , m_globalSpeed(1.0f)
+    , m_detailLevel(0)
 {
     // 设置更新定时器
-    m_updateTimer->setInterval(16); // 约60FPS
+    m_updateTimer->setInterval(LOD_INTERVALS_MS[0]); // 约60FPS
     connect(m_updateTimer, &QTimer::timeout, this, &AnimationManager::updateAnimations);
     
     qDebug() << "AnimationManager: 初始化动画管理器";
@@ -78,9 +82,10 @@ bool AnimationManager::playAnimation(int animationId)
     if (animData.state == AnimationState::Playing) {
         return true; // 已经在播放
     }
-    
+
     animData.state = AnimationState::Playing;
-    
+    activateAnimation(animData);
+
     // 启动更新定时器
     if (!m_updateTimer->isActive()) {
         m_updateTimer->start();
@@ -104,10 +109,11 @@ bool AnimationManager::pauseAnimation(int animationId)
     
     if (animData.state == AnimationState::Playing) {
         animData.state = AnimationState::Paused;
+        deactivateAnimation(animationId, true);
         qDebug() << "AnimationManager: 暂停动画" << animData.name << "ID:" << animationId;
         emit animationPaused(animationId);
     }
-    
+
     return true;
 }
 
@@ -120,11 +126,12 @@ bool AnimationManager::stopAnimation(int animationId)
     }
     
     AnimationData &animData = it.value();
-    
+
     animData.state = AnimationState::Stopped;
     animData.currentFrame = 0;
     animData.currentTime = 0;
-    
+    deactivateAnimation(animationId, false);
+
     qDebug() << "AnimationManager: 停止动画" << animData.name << "ID:" << animationId;
     emit animationStopped(animationId);
     
@@ -134,7 +141,7 @@ bool AnimationManager::stopAnimation(int animationId)
 void AnimationManager::stopAllAnimations()
 {
     for (auto &animData : m_animations) {
-        if (animData.state == AnimationState::Playing || 
+        if (animData.state == AnimationState::Playing ||
             animData.state == AnimationState::Paused) {
             animData.state = AnimationState::Stopped;
             animData.currentFrame = 0;
@@ -142,7 +149,9 @@ void AnimationManager::stopAllAnimations()
             emit animationStopped(animData.id);
         }
     }
-    
+
+    m_active = ActiveAnimations{};
+    m_activeIndex.clear();
     m_updateTimer->stop();
     qDebug() << "AnimationManager: 停止所有动画";
 }
@@ -155,6 +164,7 @@ bool AnimationManager::removeAnimation(int animationId)
     }
     
     QString name = it->name;
+    deactivateAnimation(animationId, false);
     m_animations.erase(it);
     
     qDebug() << "AnimationManager: 移除动画" << name << "ID:" << animationId;
@@ -181,7 +191,11 @@ int AnimationManager::getCurrentFrame(int animationId) const
 {
     auto it = m_animations.find(animationId);
     if (it != m_animations.end()) {
-        return it->frames[it->currentFrame];
+        // 播放中的动画从SoA读取最新帧，冷数据只在状态切换时回写
+        const int slot = m_activeIndex.value(animationId, -1);
+        const int frameIndex = (slot >= 0) ? m_active.currentFrames[slot]
+                                           : it->currentFrame;
+        return it->frames[frameIndex];
     }
     return -1;
 }
@@ -190,7 +204,10 @@ float AnimationManager::getAnimationProgress(int animationId) const
 {
     auto it = m_animations.find(animationId);
     if (it != m_animations.end() && it->totalDuration > 0) {
-        return static_cast<float>(it->currentTime) / it->totalDuration;
+        const int slot = m_activeIndex.value(animationId, -1);
+        const float currentTime = (slot >= 0) ? m_active.times[slot]
+                                              : static_cast<float>(it->currentTime);
+        return currentTime / it->totalDuration;
     }
     return 0.0f;
 }
@@ -201,8 +218,13 @@ bool AnimationManager::setAnimationSpeed(int animationId, float speed)
     if (it == m_animations.end()) {
         return false;
     }
-    
+
     it->speed = qMax(0.1f, speed); // 最小速度0.1x
+
+    const int slot = m_activeIndex.value(animationId, -1);
+    if (slot >= 0) {
+        m_active.speeds[slot] = it->speed;
+    }
     return true;
 }
 
@@ -234,12 +256,7 @@ void AnimationManager::setAnimationEnabled(bool enabled)
         
         if (enabled) {
             // 重新启动有活动动画的定时器
-            bool hasActiveAnimations = std::any_of(m_animations.begin(), m_animations.end(),
-                [](const AnimationData &data) {
-                    return data.state == AnimationState::Playing;
-                });
-            
-            if (hasActiveAnimations && !m_updateTimer->isActive()) {
+            if (!m_active.ids.isEmpty() && !m_updateTimer->isActive()) {
                 m_updateTimer->start();
             }
         } else {
@@ -257,15 +274,39 @@ bool AnimationManager::isAnimationEnabled() const
     return m_animationEnabled;
 }
 
-QVector<int> AnimationManager::getActiveAnimations() const
+void AnimationManager::setDetailLevel(int level)
 {
-    QVector<int> activeIds;
-    for (auto it = m_animations.begin(); it != m_animations.end(); ++it) {
-        if (it->state == AnimationState::Playing) {
-            activeIds.append(it.key());
-        }
+    const int lodCount = static_cast<int>(std::size(LOD_INTERVALS_MS));
+    const int clamped = std::clamp(level, 0, lodCount - 1);
+    if (m_detailLevel == clamped) {
+        return;
     }
-    return activeIds;
+
+    m_detailLevel = clamped;
+
+    // 推进量按定时器实际间隔计算（updateAnimations的delta），
+    // 拉大间隔只降低更新频率，动画时长不受影响
+    m_updateTimer->setInterval(LOD_INTERVALS_MS[clamped]);
+    qDebug() << "AnimationManager: 细节层级" << clamped
+             << "更新间隔" << LOD_INTERVALS_MS[clamped] << "毫秒";
+}
+
+void AnimationManager::setLodTier(int tier)
+{
+    // 特效层级（越高越保真）映射为细节层级（越高越省）
+    const int lodCount = static_cast<int>(std::size(LOD_INTERVALS_MS));
+    const int clampedTier = std::clamp(tier, 0, lodCount - 1);
+    setDetailLevel(lodCount - 1 - clampedTier);
+}
+
+int AnimationManager::getDetailLevel() const
+{
+    return m_detailLevel;
+}
+
+QVector<int> AnimationManager::getActiveAnimations() const
+{
+    return m_active.ids;
 }
 
 int AnimationManager::getAnimationCount() const
@@ -278,52 +319,142 @@ void AnimationManager::updateAnimations()
     if (!m_animationEnabled || m_globalSpeed <= 0.0f) {
         return;
     }
-    
-    bool hasActiveAnimations = false;
-    const int deltaTime = m_updateTimer->interval();
-    
-    for (auto &animData : m_animations) {
-        if (animData.state == AnimationState::Playing) {
-            hasActiveAnimations = true;
-            updateSingleAnimation(animData, deltaTime);
+
+    const int count = m_active.size();
+    if (count == 0) {
+        // 没有活动动画，停止定时器
+        m_updateTimer->stop();
+        return;
+    }
+
+    const float delta = m_updateTimer->interval() * m_globalSpeed;
+
+    m_scratchFrames.resize(count);
+    m_scratchFinished.resize(count);
+
+    // 热循环：对SoA数组的一条线性遍历，纯算术无副作用，
+    // 500个动画的推进成本就是500次乘加和除法
+    {
+        float *times = m_active.times.data();
+        const float *speeds = m_active.speeds.constData();
+        const float *frameDurations = m_active.frameDurations.constData();
+        const float *totalDurations = m_active.totalDurations.constData();
+        const int *frameCounts = m_active.frameCounts.constData();
+        const quint8 *loops = m_active.loops.constData();
+        int *newFrames = m_scratchFrames.data();
+        quint8 *finished = m_scratchFinished.data();
+
+        for (int i = 0; i < count; ++i) {
+            float t = times[i] + delta * speeds[i];
+            const float total = totalDurations[i];
+            const bool wrapped = (t >= total);
+
+            // 循环动画回绕，非循环动画钳在结尾
+            t = (loops[i] && wrapped) ? std::fmod(t, total) : t;
+            t = (!loops[i] && wrapped) ? total : t;
+            times[i] = t;
+
+            int frame = static_cast<int>(t / frameDurations[i]);
+            frame = (frame >= frameCounts[i]) ? frameCounts[i] - 1 : frame;
+            newFrames[i] = frame;
+            finished[i] = static_cast<quint8>(!loops[i] && wrapped);
         }
     }
-    
-    // 如果没有活动动画，停止定时器
-    if (!hasActiveAnimations) {
+
+    // 冷阶段：比较新旧帧补发信号，结算完成的动画。
+    // 先收集再发射，信号槽里的播放/停止调用不会破坏遍历。
+    // 收集缓冲是帧作用域的，从帧分配器取内存，不触碰全局堆。
+    FrameVector<QPair<int, int>> changedFrames;
+    FrameVector<int> finishedIds;
+    for (int i = 0; i < count; ++i) {
+        if (m_scratchFrames[i] != m_active.currentFrames[i]) {
+            m_active.currentFrames[i] = m_scratchFrames[i];
+            const AnimationData &animData = m_animations[m_active.ids[i]];
+            changedFrames.push_back(qMakePair(m_active.ids[i],
+                                           animData.frames[m_scratchFrames[i]]));
+        }
+        if (m_scratchFinished[i]) {
+            finishedIds.push_back(m_active.ids[i]);
+        }
+    }
+
+    for (const auto &change : changedFrames) {
+        emit frameChanged(change.first, change.second);
+    }
+
+    for (int animationId : finishedIds) {
+        auto it = m_animations.find(animationId);
+        if (it == m_animations.end()) {
+            continue;
+        }
+        it->state = AnimationState::Stopped;
+        it->currentFrame = it->frames.size() - 1; // 停在最后一帧
+        it->currentTime = it->totalDuration;
+        deactivateAnimation(animationId, false);
+
+        qDebug() << "AnimationManager: 动画完成" << it->name << "ID:" << animationId;
+        emit animationFinished(animationId);
+    }
+
+    if (m_active.ids.isEmpty()) {
         m_updateTimer->stop();
     }
 }
 
-void AnimationManager::updateSingleAnimation(AnimationData &animData, int deltaTime)
+void AnimationManager::activateAnimation(const AnimationData &animData)
 {
-    // 计算实际时间增量
-    float effectiveSpeed = animData.speed * m_globalSpeed;
-    int effectiveDelta = static_cast<int>(deltaTime * effectiveSpeed);
-    
-    animData.currentTime += effectiveDelta;
-    
-    // 计算当前帧
-    int frameIndex = (animData.currentTime / animData.frameDuration) % animData.frames.size();
-    
-    if (frameIndex != animData.currentFrame) {
-        animData.currentFrame = frameIndex;
-        emit frameChanged(animData.id, animData.frames[frameIndex]);
+    if (m_activeIndex.contains(animData.id)) {
+        return;
     }
-    
-    // 检查动画是否完成
-    if (!animData.loop && animData.currentTime >= animData.totalDuration) {
-        animData.state = AnimationState::Stopped;
-        animData.currentFrame = animData.frames.size() - 1; // 停在最后一帧
-        animData.currentTime = animData.totalDuration;
-        
-        qDebug() << "AnimationManager: 动画完成" << animData.name << "ID:" << animData.id;
-        emit animationFinished(animData.id);
-    } else if (animData.loop && animData.currentTime >= animData.totalDuration) {
-        // 循环动画重置
-        animData.currentTime = 0;
-        animData.currentFrame = 0;
+
+    m_activeIndex.insert(animData.id, m_active.size());
+    m_active.ids.append(animData.id);
+    m_active.times.append(static_cast<float>(animData.currentTime));
+    m_active.speeds.append(animData.speed);
+    m_active.frameDurations.append(static_cast<float>(animData.frameDuration));
+    m_active.totalDurations.append(static_cast<float>(animData.totalDuration));
+    m_active.frameCounts.append(animData.frames.size());
+    m_active.currentFrames.append(animData.currentFrame);
+    m_active.loops.append(static_cast<quint8>(animData.loop));
+}
+
+void AnimationManager::deactivateAnimation(int animationId, bool syncBack)
+{
+    const int slot = m_activeIndex.value(animationId, -1);
+    if (slot < 0) {
+        return;
+    }
+
+    if (syncBack) {
+        auto it = m_animations.find(animationId);
+        if (it != m_animations.end()) {
+            it->currentTime = static_cast<int>(m_active.times[slot]);
+            it->currentFrame = m_active.currentFrames[slot];
+        }
+    }
+
+    // 尾部交换删除，保持所有列紧凑
+    const int last = m_active.size() - 1;
+    if (slot != last) {
+        m_active.ids[slot] = m_active.ids[last];
+        m_active.times[slot] = m_active.times[last];
+        m_active.speeds[slot] = m_active.speeds[last];
+        m_active.frameDurations[slot] = m_active.frameDurations[last];
+        m_active.totalDurations[slot] = m_active.totalDurations[last];
+        m_active.frameCounts[slot] = m_active.frameCounts[last];
+        m_active.currentFrames[slot] = m_active.currentFrames[last];
+        m_active.loops[slot] = m_active.loops[last];
+        m_activeIndex.insert(m_active.ids[slot], slot);
     }
+    m_active.ids.removeLast();
+    m_active.times.removeLast();
+    m_active.speeds.removeLast();
+    m_active.frameDurations.removeLast();
+    m_active.totalDurations.removeLast();
+    m_active.frameCounts.removeLast();
+    m_active.currentFrames.removeLast();
+    m_active.loops.removeLast();
+    m_activeIndex.remove(animationId);
 }
 
 int AnimationManager::generateAnimationId()
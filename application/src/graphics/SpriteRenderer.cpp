@@ -20,11 +20,24 @@
  */
 
 #include "graphics/SpriteRenderer.h"
+#include "core/FrameAllocator.h"
+#include "core/IdleMaintenanceScheduler.h"
+#include "core/JobSystem.h"
+#include "utils/FrameProfiler.h"
 #include <QDebug>
+#include <QElapsedTimer>
 #include <QPixmap>
 #include <QPainter>
 #include <QTransform>
+#include <QFile>
 #include <QFileInfo>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <utility>
 
 /**
  * @brief 构造函数
@@ -83,6 +96,12 @@ bool SpriteRenderer::loadSprite(const QString &name, const QString &filePath)
         return false;
     }
     
+    // 同名覆盖加载：先归还旧精灵占用的动态图集区域
+    auto existing = m_spriteCache.constFind(name);
+    if (existing != m_spriteCache.constEnd() && existing->inAtlas) {
+        releaseAtlasRegion(*existing);
+    }
+
     // 创建精灵数据结构
     SpriteData spriteData;
     spriteData.name = name;
@@ -90,10 +109,13 @@ bool SpriteRenderer::loadSprite(const QString &name, const QString &filePath)
     spriteData.pixmap = pixmap;
     spriteData.originalSize = pixmap.size();
     spriteData.isLoaded = true;
-    
-    // 存储到缓存映射表
+    spriteData.textureId = m_nextTextureId++;
+
+    // 存储到缓存映射表；小精灵随后打包进动态图集，与构建期
+    // 图集一样参与批次合并（打包失败保持独立纹理）
     m_spriteCache[name] = spriteData;
-    
+    packIntoAtlas(m_spriteCache[name]);
+
     qDebug() << "SpriteRenderer: 加载精灵成功" << name << "大小:" << pixmap.size();
     emit spriteLoaded(name);
     
@@ -134,9 +156,11 @@ bool SpriteRenderer::loadSpriteSheet(const QString &name, const QString &filePat
     spriteData.frameHeight = frameHeight;
     spriteData.frameCount = frameCount;
     
-    // 计算网格布局
-    spriteData.columns = spriteData.pixmap.width() / frameWidth;
-    spriteData.rows = spriteData.pixmap.height() / frameHeight;
+    // 计算网格布局（进了动态图集的精灵按所属区域算，而非整页）
+    const QSize sheetSize = spriteData.inAtlas ? spriteData.atlasRegion.size()
+                                               : spriteData.pixmap.size();
+    spriteData.columns = sheetSize.width() / frameWidth;
+    spriteData.rows = sheetSize.height() / frameHeight;
     
     qDebug() << "SpriteRenderer: 加载精灵表成功" << name 
              << "帧数:" << frameCount 
@@ -146,10 +170,878 @@ bool SpriteRenderer::loadSpriteSheet(const QString &name, const QString &filePat
     return true;
 }
 
+/**
+ * @brief 加载纹理图集
+ * @param atlasName 图集名称
+ * @param imagePath 图集图像文件路径
+ * @param indexPath 图集索引JSON文件路径
+ * @return 加载成功返回true，失败返回false
+ *
+ * 图集图像只加载一次，所有区域通过QPixmap的隐式共享引用
+ * 同一份像素数据。区域以索引中的名称注册进精灵缓存，之后
+ * 与普通精灵完全一样地使用；批量渲染时同一图集的精灵自动
+ * 合并为一个绘制批次。
+ */
+bool SpriteRenderer::loadAtlas(const QString &atlasName, const QString &imagePath,
+                               const QString &indexPath)
+{
+    QPixmap atlasPixmap(imagePath);
+    if (atlasPixmap.isNull()) {
+        qWarning() << "SpriteRenderer: 无法加载图集图像:" << imagePath;
+        return false;
+    }
+
+    QFile indexFile(indexPath);
+    if (!indexFile.open(QIODevice::ReadOnly)) {
+        qWarning() << "SpriteRenderer: 无法打开图集索引:" << indexPath;
+        return false;
+    }
+
+    QJsonDocument doc = QJsonDocument::fromJson(indexFile.readAll());
+    if (doc.isNull() || !doc.isObject()) {
+        qWarning() << "SpriteRenderer: 图集索引格式错误:" << indexPath;
+        return false;
+    }
+
+    QJsonObject regions = doc.object().value("regions").toObject();
+    if (regions.isEmpty()) {
+        qWarning() << "SpriteRenderer: 图集索引不包含区域:" << indexPath;
+        return false;
+    }
+
+    int loaded = 0;
+    // 所有区域共享同一底层纹理，排序键里使用同一个纹理ID
+    const quint32 atlasTextureId = m_nextTextureId++;
+    for (auto it = regions.begin(); it != regions.end(); ++it) {
+        QJsonObject region = it.value().toObject();
+        QRect rect(region.value("x").toInt(), region.value("y").toInt(),
+                   region.value("w").toInt(), region.value("h").toInt());
+        if (rect.isEmpty() || !QRect(QPoint(0, 0), atlasPixmap.size()).contains(rect)) {
+            qWarning() << "SpriteRenderer: 图集区域越界，跳过:" << it.key();
+            continue;
+        }
+
+        SpriteData spriteData;
+        spriteData.name = it.key();
+        spriteData.filePath = imagePath;
+        spriteData.pixmap = atlasPixmap;
+        spriteData.originalSize = rect.size();
+        spriteData.isLoaded = true;
+        spriteData.inAtlas = true;
+        spriteData.atlasRegion = rect;
+        spriteData.textureId = atlasTextureId;
+
+        // 区域本身也可以是精灵表（图集内的动画帧条）
+        const int frameWidth = region.value("frameWidth").toInt();
+        const int frameHeight = region.value("frameHeight").toInt();
+        const int frameCount = region.value("frameCount").toInt();
+        if (frameWidth > 0 && frameHeight > 0 && frameCount > 1) {
+            spriteData.isSpriteSheet = true;
+            spriteData.frameWidth = frameWidth;
+            spriteData.frameHeight = frameHeight;
+            spriteData.frameCount = frameCount;
+            spriteData.columns = rect.width() / frameWidth;
+            spriteData.rows = rect.height() / frameHeight;
+        }
+
+        m_spriteCache[it.key()] = spriteData;
+        emit spriteLoaded(it.key());
+        loaded++;
+    }
+
+    qDebug() << "SpriteRenderer: 加载图集成功" << atlasName
+             << "大小:" << atlasPixmap.size() << "区域数:" << loaded;
+    return loaded > 0;
+}
+
+// ==================== 动态图集 ====================
+
+/**
+ * @brief 设置是否启用动态图集
+ * @param enabled 是否启用
+ */
+void SpriteRenderer::setDynamicAtlasEnabled(bool enabled)
+{
+    m_dynamicAtlasEnabled = enabled;
+}
+
+/**
+ * @brief 获取当前动态图集页数
+ * @return 页数
+ */
+int SpriteRenderer::getAtlasPageCount() const
+{
+    return m_atlasPages.size();
+}
+
+/**
+ * @brief 在页内放置一个矩形（货架打包）
+ * @param page 目标页
+ * @param width 含边距的宽度
+ * @param height 含边距的高度
+ * @param outPos 放置位置（左上角）
+ * @return 放得下返回true并推进货架游标
+ *
+ * 当前货架放不下时开新货架（游标回到左缘、顶部下移一个
+ * 货架高度）。货架之上已写过的区域永不复用，回收走整理
+ * 与重建路径。
+ */
+bool SpriteRenderer::placeInPage(AtlasPage &page, int width, int height, QPoint &outPos)
+{
+    // 当前货架右侧还放得下
+    if (page.shelfX + width <= ATLAS_PAGE_SIZE &&
+        page.shelfY + height <= ATLAS_PAGE_SIZE) {
+        outPos = QPoint(page.shelfX, page.shelfY);
+        page.shelfX += width;
+        page.shelfHeight = qMax(page.shelfHeight, height);
+        return true;
+    }
+
+    // 开新货架
+    if (width <= ATLAS_PAGE_SIZE &&
+        page.shelfY + page.shelfHeight + height <= ATLAS_PAGE_SIZE) {
+        page.shelfY += page.shelfHeight;
+        page.shelfX = 0;
+        page.shelfHeight = height;
+        outPos = QPoint(0, page.shelfY);
+        page.shelfX = width;
+        return true;
+    }
+
+    return false;
+}
+
+/**
+ * @brief 页像素图变化后刷新所有驻留精灵的像素图引用
+ * @param page 被改写的页
+ */
+void SpriteRenderer::refreshAtlasResidents(const AtlasPage &page)
+{
+    for (const QString &resident : page.residents) {
+        auto it = m_spriteCache.find(resident);
+        if (it != m_spriteCache.end()) {
+            it->pixmap = page.pixmap;
+        }
+    }
+}
+
+/**
+ * @brief 尝试把精灵打包进动态图集
+ * @param data 精灵数据（打包成功后原位改写像素图/区域/纹理ID）
+ * @return 打包成功返回true，尺寸超限或功能关闭返回false
+ *
+ * 优先填充已有页（封存中的整理源页除外），都放不下时开新页。
+ * 向页上绘制触发QPixmap写时复制，完成后统一刷新驻留精灵的
+ * 像素图引用，页内精灵始终共享同一份像素数据。
+ */
+bool SpriteRenderer::packIntoAtlas(SpriteData &data)
+{
+    if (!m_dynamicAtlasEnabled || data.pixmap.isNull()) {
+        return false;
+    }
+
+    const QSize size = data.pixmap.size();
+    if (size.width() > ATLAS_MAX_SPRITE_DIM || size.height() > ATLAS_MAX_SPRITE_DIM) {
+        return false;
+    }
+
+    const int paddedWidth = size.width() + ATLAS_PADDING;
+    const int paddedHeight = size.height() + ATLAS_PADDING;
+
+    int pageIndex = -1;
+    QPoint pos;
+    for (int i = 0; i < m_atlasPages.size(); ++i) {
+        if (m_atlasPages[i].sealed) {
+            continue;
+        }
+        if (placeInPage(m_atlasPages[i], paddedWidth, paddedHeight, pos)) {
+            pageIndex = i;
+            break;
+        }
+    }
+
+    if (pageIndex < 0) {
+        AtlasPage page;
+        page.pixmap = QPixmap(ATLAS_PAGE_SIZE, ATLAS_PAGE_SIZE);
+        page.pixmap.fill(Qt::transparent);
+        page.textureId = m_nextTextureId++;
+        placeInPage(page, paddedWidth, paddedHeight, pos);
+        m_atlasPages.append(page);
+        pageIndex = m_atlasPages.size() - 1;
+    }
+
+    AtlasPage &page = m_atlasPages[pageIndex];
+    {
+        QPainter painter(&page.pixmap);
+        painter.setCompositionMode(QPainter::CompositionMode_Source);
+        painter.drawPixmap(pos, data.pixmap);
+    }
+
+    data.pixmap = page.pixmap;
+    data.inAtlas = true;
+    data.atlasRegion = QRect(pos, size);
+    data.textureId = page.textureId;
+
+    page.liveArea += static_cast<qint64>(size.width()) * size.height();
+    page.residents.append(data.name);
+    refreshAtlasResidents(page);
+    return true;
+}
+
+/**
+ * @brief 释放精灵占用的动态图集区域
+ * @param data 即将卸载或搬出的精灵
+ */
+void SpriteRenderer::releaseAtlasRegion(const SpriteData &data)
+{
+    const int pageIndex = atlasPageIndexById(data.textureId);
+    if (pageIndex < 0) {
+        return;  // 构建期图集不在页表中，无需登记
+    }
+
+    AtlasPage &page = m_atlasPages[pageIndex];
+    const qint64 area = static_cast<qint64>(data.atlasRegion.width()) *
+                        data.atlasRegion.height();
+    page.liveArea -= area;
+    page.deadArea += area;
+    page.residents.removeOne(data.name);
+
+    // 搬/卸空的页整页释放
+    if (page.residents.isEmpty()) {
+        if (m_compactingPageId == page.textureId) {
+            m_compactingPageId = 0;
+        }
+        m_atlasPages.removeAt(pageIndex);
+    }
+}
+
+/**
+ * @brief 按纹理ID查找动态图集页
+ * @param textureId 页纹理ID
+ * @return 页下标，不存在返回-1
+ */
+int SpriteRenderer::atlasPageIndexById(quint32 textureId) const
+{
+    if (textureId == 0) {
+        return -1;
+    }
+    for (int i = 0; i < m_atlasPages.size(); ++i) {
+        if (m_atlasPages[i].textureId == textureId) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+/**
+ * @brief 选择下一个整理目标页并封存
+ * @return 目标页的纹理ID，无合格页返回0
+ *
+ * 取死区占比最高且超过阈值的页。封存后该页不再接受新精灵，
+ * 搬出的精灵只会落到其他页或新页。
+ */
+quint32 SpriteRenderer::selectCompactionTarget()
+{
+    int bestIndex = -1;
+    float bestRatio = ATLAS_COMPACT_DEAD_RATIO;
+    for (int i = 0; i < m_atlasPages.size(); ++i) {
+        const AtlasPage &page = m_atlasPages[i];
+        if (page.deadArea < ATLAS_MIN_DEAD_AREA) {
+            continue;
+        }
+        const float ratio = static_cast<float>(page.deadArea) /
+                            static_cast<float>(page.deadArea + page.liveArea);
+        if (ratio >= bestRatio) {
+            bestRatio = ratio;
+            bestIndex = i;
+        }
+    }
+
+    if (bestIndex < 0) {
+        return 0;
+    }
+    m_atlasPages[bestIndex].sealed = true;
+    return m_atlasPages[bestIndex].textureId;
+}
+
+/**
+ * @brief 把整理目标页的一个精灵搬到其他页
+ * @param pageIndex 目标页下标
+ *
+ * 先把区域像素裁出为独立图，归还源页区域后再走常规打包。
+ * 搬运只改写SpriteData内部状态，名称句柄与实例ID不变。
+ */
+void SpriteRenderer::moveOneResidentOut(int pageIndex)
+{
+    AtlasPage &page = m_atlasPages[pageIndex];
+    if (page.residents.isEmpty()) {
+        // 只剩死区的页直接释放
+        if (m_compactingPageId == page.textureId) {
+            m_compactingPageId = 0;
+        }
+        m_atlasPages.removeAt(pageIndex);
+        return;
+    }
+
+    const QString name = page.residents.last();
+    auto it = m_spriteCache.find(name);
+    if (it == m_spriteCache.end()) {
+        page.residents.removeLast();
+        return;
+    }
+
+    // 裁出并归还（releaseAtlasRegion可能删除源页，之后不再触碰page）
+    SpriteData &data = *it;
+    QPixmap standalone = data.pixmap.copy(data.atlasRegion);
+    releaseAtlasRegion(data);
+
+    data.pixmap = standalone;
+    data.inAtlas = false;
+    data.atlasRegion = QRect();
+    data.textureId = 0;
+    if (!packIntoAtlas(data)) {
+        // 目标页都放不下时保持独立纹理
+        data.textureId = m_nextTextureId++;
+    }
+}
+
+/**
+ * @brief 执行一步增量图集整理
+ * @param budgetMs 本次调用可用的时间预算（毫秒）
+ * @return true表示还有整理工作未完成
+ *
+ * 每次挑死区占比最高的页封存为整理源，在预算内逐个把活精灵
+ * 搬到其他页，搬空后整页释放；预算耗尽即停，下个空闲片从
+ * 同一页继续。签名与IdleMaintenanceScheduler::MaintenanceTask
+ * 一致。
+ */
+bool SpriteRenderer::compactAtlasesStep(qint64 budgetMs)
+{
+    if (m_atlasPages.isEmpty()) {
+        m_compactingPageId = 0;
+        return false;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+    do {
+        int pageIndex = atlasPageIndexById(m_compactingPageId);
+        if (pageIndex < 0) {
+            m_compactingPageId = selectCompactionTarget();
+            if (m_compactingPageId == 0) {
+                return false;  // 没有值得整理的页，本轮结束
+            }
+            pageIndex = atlasPageIndexById(m_compactingPageId);
+        }
+        moveOneResidentOut(pageIndex);
+    } while (timer.elapsed() < budgetMs);
+
+    return true;
+}
+
+/**
+ * @brief 全量重建动态图集
+ *
+ * 把所有驻留精灵裁出为独立图，清空页表后按高度降序重新打包
+ * （货架打包对高度有序的输入浪费最少）。死区一次清零，页数
+ * 收敛到最小。应在加载界面可见时调用（场景切换）。
+ */
+void SpriteRenderer::rebuildAtlases()
+{
+    if (m_atlasPages.isEmpty()) {
+        return;
+    }
+
+    // 先全部裁出为独立图再清页表，避免裁取与重打包交错；
+    // 列表只收缓存中实际存在的名称
+    QStringList residents;
+    for (const AtlasPage &page : m_atlasPages) {
+        for (const QString &name : page.residents) {
+            auto it = m_spriteCache.find(name);
+            if (it == m_spriteCache.end()) {
+                continue;
+            }
+            it->pixmap = it->pixmap.copy(it->atlasRegion);
+            it->inAtlas = false;
+            it->atlasRegion = QRect();
+            it->textureId = 0;
+            residents.append(name);
+        }
+    }
+
+    const int pagesBefore = m_atlasPages.size();
+    m_atlasPages.clear();
+    m_compactingPageId = 0;
+
+    std::sort(residents.begin(), residents.end(),
+              [this](const QString &a, const QString &b) {
+                  return m_spriteCache[a].pixmap.height() >
+                         m_spriteCache[b].pixmap.height();
+              });
+
+    for (const QString &name : residents) {
+        auto it = m_spriteCache.find(name);
+        if (it == m_spriteCache.end()) {
+            continue;
+        }
+        if (!packIntoAtlas(*it)) {
+            it->textureId = m_nextTextureId++;
+        }
+    }
+
+    qDebug() << "SpriteRenderer: 图集重建完成 页数" << pagesBefore
+             << "->" << m_atlasPages.size();
+}
+
+/**
+ * @brief 把增量整理注册为空闲帧维护任务
+ * @param scheduler 空闲帧调度器
+ */
+void SpriteRenderer::registerIdleCompaction(IdleMaintenanceScheduler *scheduler)
+{
+    if (scheduler == nullptr) {
+        return;
+    }
+    scheduler->registerTask(
+        QStringLiteral("atlas_compaction"),
+        [this](qint64 budgetMs) { return compactAtlasesStep(budgetMs); },
+        ATLAS_COMPACT_INTERVAL_MS);
+}
+
+namespace {
+
+/**
+ * @brief 浮点深度转保序无符号整数
+ *
+ * IEEE 754位模式经符号翻转后无符号比较与浮点比较同序
+ * （正数置符号位，负数全部取反），排序键里可直接按字节比较。
+ */
+quint32 depthBits(float depth)
+{
+    quint32 bits = 0;
+    std::memcpy(&bits, &depth, sizeof(bits));
+    return (bits & 0x80000000u) ? ~bits : (bits | 0x80000000u);
+}
+
+/**
+ * @brief 打包64位排序键
+ *
+ * 高8位层级、中32位深度、低24位纹理ID：先按层级再按深度
+ * 排序，同层同深度的精灵按纹理聚拢以合并绘制批次。
+ */
+quint64 packSortKey(int layer, float depth, quint32 textureId)
+{
+    const quint64 layerBits = static_cast<quint64>(qBound(0, layer, 255));
+    return (layerBits << 56)
+         | (static_cast<quint64>(depthBits(depth)) << 24)
+         | (textureId & 0xFFFFFFu);
+}
+
+/**
+ * @brief 排序用条目：键 + 批次队列下标
+ */
+struct SortEntry {
+    quint64 key;
+    quint32 index;
+};
+
+/**
+ * @brief 按排序键做LSD基数排序（稳定）
+ *
+ * 对64位键按字节做8轮计数排序，在entries与scratch之间
+ * 乒乓写入；某一轮所有键的该字节相同时整轮跳过——默认
+ * 层级/深度下大多数轮次只剩纹理ID的低字节需要动。两个
+ * 数组都来自帧分配器，帧末整块回收。
+ */
+void radixSortEntries(FrameVector<SortEntry> &entries, FrameVector<SortEntry> &scratch)
+{
+    const std::size_t n = entries.size();
+    if (n < 2) {
+        return;
+    }
+    scratch.resize(n);
+
+    FrameVector<SortEntry> *src = &entries;
+    FrameVector<SortEntry> *dst = &scratch;
+    for (int shift = 0; shift < 64; shift += 8) {
+        std::size_t counts[256] = {};
+        for (const SortEntry &entry : *src) {
+            ++counts[(entry.key >> shift) & 0xFFu];
+        }
+        if (counts[((*src)[0].key >> shift) & 0xFFu] == n) {
+            continue;  // 本字节全部相同，无需搬移
+        }
+
+        std::size_t offsets[256];
+        std::size_t running = 0;
+        for (int bucket = 0; bucket < 256; ++bucket) {
+            offsets[bucket] = running;
+            running += counts[bucket];
+        }
+        for (const SortEntry &entry : *src) {
+            (*dst)[offsets[(entry.key >> shift) & 0xFFu]++] = entry;
+        }
+        std::swap(src, dst);
+    }
+
+    if (src != &entries) {
+        entries.assign(src->begin(), src->end());
+    }
+}
+
+} // namespace
+
+/**
+ * @brief 开始一个渲染批次
+ *
+ * 清空批次队列并进入批量模式。
+ */
+void SpriteRenderer::beginBatch()
+{
+    m_batchQueue.clear();
+    m_batchActive = true;
+}
+
+/**
+ * @brief 向当前批次提交一个精灵
+ * @param name 精灵名称
+ * @param position 目标位置（精灵左上角）
+ * @param options 渲染选项
+ *
+ * 只记录参数，绘制延迟到endBatch统一执行。排序键在这里
+ * 打包缓存：endBatch的排序只看整数键，不再碰精灵对象。
+ */
+void SpriteRenderer::batchSprite(const QString &name, const QPointF &position,
+                                 const RenderOptions &options)
+{
+    if (!m_batchActive) {
+        qWarning() << "SpriteRenderer: batchSprite在beginBatch之前被调用:" << name;
+        return;
+    }
+
+    auto it = m_spriteCache.constFind(name);
+    if (it == m_spriteCache.constEnd() || !it->isLoaded) {
+        qWarning() << "SpriteRenderer: 批次中的精灵不存在:" << name;
+        return;
+    }
+
+    const quint64 sortKey = packSortKey(options.layer, options.depth, it->textureId);
+    m_batchQueue.append(BatchItem{ name, position, options, sortKey });
+}
+
+/**
+ * @brief 结束批次并绘制
+ * @param painter 目标画笔
+ * @return 实际产生的绘制批次数
+ *
+ * 先按提交时缓存的排序键做基数排序（层级、深度、纹理），
+ * 再把排序后纹理相同的连续条目合并为一次drawPixmapFragments
+ * 提交。排序键低位是纹理ID，同层同深度的精灵自动聚拢：密集
+ * 战斗场景300+精灵来自少数几张图集时整帧仍只需少量绘制调用，
+ * 且跨纹理的遮挡关系由深度决定而非提交顺序。
+ */
+int SpriteRenderer::endBatch(QPainter *painter)
+{
+    PROFILE_ZONE("SpriteRenderer::endBatch");
+
+    m_batchActive = false;
+    if (!painter || m_batchQueue.isEmpty()) {
+        m_batchQueue.clear();
+        return 0;
+    }
+
+    // 排序与分组数组都是帧作用域的：从帧分配器取内存，本函数
+    // 返回前析构，底层内存帧末整块回收。
+    FrameVector<SortEntry> order;
+    FrameVector<SortEntry> scratch;
+    order.reserve(static_cast<std::size_t>(m_batchQueue.size()));
+    for (int i = 0; i < m_batchQueue.size(); ++i) {
+        order.push_back(SortEntry{ m_batchQueue[i].sortKey,
+                                   static_cast<quint32>(i) });
+    }
+    radixSortEntries(order, scratch);
+
+    // 排序后按纹理的连续段分组：段内一次drawPixmapFragments，
+    // 段边界即纹理切换点，跨纹理的深度顺序得以保留
+    struct FragmentGroup {
+        quint32 textureId = 0;
+        const QPixmap *pixmap = nullptr;
+        FrameVector<QPainter::PixmapFragment> fragments;
+    };
+    FrameVector<FragmentGroup> groups;
+
+    for (const SortEntry &entry : order) {
+        const BatchItem &item = m_batchQueue[static_cast<int>(entry.index)];
+        auto it = m_spriteCache.constFind(item.name);
+        if (it == m_spriteCache.constEnd() || !it->isLoaded) {
+            // 提交时已校验；批次中途被卸载的精灵直接跳过
+            continue;
+        }
+
+        const QRect source = sourceRect(*it, item.options.frameIndex);
+        const float scaleX = item.options.flipHorizontal ? -item.options.scale
+                                                         : item.options.scale;
+        const float scaleY = item.options.flipVertical ? -item.options.scale
+                                                       : item.options.scale;
+
+        // PixmapFragment以目标中心定位，从左上角换算
+        const QPointF center(
+            item.position.x() + source.width() * item.options.scale / 2.0,
+            item.position.y() + source.height() * item.options.scale / 2.0);
+
+        if (groups.empty() || groups.back().textureId != it->textureId) {
+            groups.push_back(FragmentGroup{});
+            groups.back().textureId = it->textureId;
+            groups.back().pixmap = &it->pixmap;
+        }
+        groups.back().fragments.push_back(QPainter::PixmapFragment::create(
+            center, QRectF(source), scaleX, scaleY,
+            item.options.rotation, item.options.opacity));
+    }
+
+    for (const FragmentGroup &group : groups) {
+        painter->drawPixmapFragments(group.fragments.data(),
+                                     static_cast<int>(group.fragments.size()),
+                                     *group.pixmap);
+    }
+
+    m_batchQueue.clear();
+    return static_cast<int>(groups.size());
+}
+
+/**
+ * @brief 计算精灵在底层纹理中的源矩形
+ * @param data 精灵数据
+ * @param frameIndex 帧索引，-1表示完整精灵
+ * @return 源矩形
+ *
+ * 图集精灵的帧坐标在图集区域内偏移，普通精灵从(0,0)开始。
+ */
+QRect SpriteRenderer::sourceRect(const SpriteData &data, int frameIndex) const
+{
+    const QRect base = data.inAtlas ? data.atlasRegion
+                                    : QRect(QPoint(0, 0), data.pixmap.size());
+
+    if (!data.isSpriteSheet || frameIndex < 0) {
+        return base;
+    }
+
+    if (frameIndex >= data.frameCount || data.columns <= 0) {
+        qWarning() << "SpriteRenderer: 帧索引超出范围:" << frameIndex;
+        return base;
+    }
+
+    const int col = frameIndex % data.columns;
+    const int row = frameIndex / data.columns;
+    return QRect(base.x() + col * data.frameWidth,
+                 base.y() + row * data.frameHeight,
+                 data.frameWidth, data.frameHeight);
+}
+
+/**
+ * @brief 计算实例的世界坐标包围盒
+ * @param data 精灵数据
+ * @param position 实例位置
+ * @param options 渲染选项
+ * @return 包围盒
+ *
+ * 带旋转的实例不按角度精算，取缩放后矩形的外接正方形
+ *（对角线边长、中心不变），保守偏大但绝不漏显。
+ */
+QRectF SpriteRenderer::instanceBounds(const SpriteData &data, const QPointF &position,
+                                      const RenderOptions &options) const
+{
+    const QRect source = sourceRect(data, options.frameIndex);
+    const qreal width = source.width() * options.scale;
+    const qreal height = source.height() * options.scale;
+
+    if (options.rotation == 0.0f) {
+        return QRectF(position, QSizeF(width, height));
+    }
+
+    const qreal diagonal = std::sqrt(width * width + height * height);
+    const QPointF center(position.x() + width / 2.0, position.y() + height / 2.0);
+    return QRectF(center.x() - diagonal / 2.0, center.y() - diagonal / 2.0,
+                  diagonal, diagonal);
+}
+
+/**
+ * @brief 注册一个参与剔除的精灵实例
+ * @param name 精灵名称
+ * @param position 世界坐标位置
+ * @param options 渲染选项
+ * @param isStatic 是否为静态精灵
+ * @return 实例ID，0表示注册失败
+ */
+quint32 SpriteRenderer::registerSpriteInstance(const QString &name, const QPointF &position,
+                                               const RenderOptions &options, bool isStatic)
+{
+    auto it = m_spriteCache.constFind(name);
+    if (it == m_spriteCache.constEnd() || !it->isLoaded) {
+        qWarning() << "SpriteRenderer: 注册实例的精灵不存在:" << name;
+        return 0;
+    }
+
+    const quint32 id = m_nextInstanceId++;
+    m_instanceIndex.insert(id, m_instanceNames.size());
+    m_instanceNames.append(name);
+    m_instancePositions.append(position);
+    m_instanceOptions.append(options);
+    m_instanceBounds.append(instanceBounds(*it, position, options));
+    // 新实例带待重测标记，注册当帧即参与可见性判定
+    m_instanceFlags.append(static_cast<quint8>(
+        (isStatic ? INSTANCE_STATIC : 0) | INSTANCE_DIRTY));
+    m_instanceVisible.append(0);
+    m_instanceIds.append(id);
+    return id;
+}
+
+/**
+ * @brief 更新实例位置
+ * @param instanceId 实例ID
+ * @param position 新位置
+ */
+void SpriteRenderer::updateSpriteInstance(quint32 instanceId, const QPointF &position)
+{
+    const int slot = m_instanceIndex.value(instanceId, -1);
+    if (slot < 0) {
+        return;
+    }
+    m_instancePositions[slot] = position;
+
+    auto it = m_spriteCache.constFind(m_instanceNames.at(slot));
+    if (it != m_spriteCache.constEnd() && it->isLoaded) {
+        m_instanceBounds[slot] =
+            instanceBounds(*it, position, m_instanceOptions.at(slot));
+    }
+    m_instanceFlags[slot] |= INSTANCE_DIRTY;
+}
+
+/**
+ * @brief 注销精灵实例
+ * @param instanceId 实例ID
+ *
+ * 尾部交换删除：把末槽位搬到被删槽位，平面数组保持紧凑，
+ * 只需修正被搬实例的索引映射。
+ */
+void SpriteRenderer::unregisterSpriteInstance(quint32 instanceId)
+{
+    const int slot = m_instanceIndex.value(instanceId, -1);
+    if (slot < 0) {
+        return;
+    }
+    const int last = m_instanceNames.size() - 1;
+    if (slot != last) {
+        m_instanceNames[slot] = m_instanceNames.at(last);
+        m_instancePositions[slot] = m_instancePositions.at(last);
+        m_instanceOptions[slot] = m_instanceOptions.at(last);
+        m_instanceBounds[slot] = m_instanceBounds.at(last);
+        m_instanceFlags[slot] = m_instanceFlags.at(last);
+        m_instanceVisible[slot] = m_instanceVisible.at(last);
+        m_instanceIds[slot] = m_instanceIds.at(last);
+        m_instanceIndex[m_instanceIds.at(slot)] = slot;
+    }
+    m_instanceNames.removeLast();
+    m_instancePositions.removeLast();
+    m_instanceOptions.removeLast();
+    m_instanceBounds.removeLast();
+    m_instanceFlags.removeLast();
+    m_instanceVisible.removeLast();
+    m_instanceIds.removeLast();
+    m_instanceIndex.remove(instanceId);
+}
+
+/**
+ * @brief 获取已注册实例数量
+ * @return 实例总数
+ */
+int SpriteRenderer::getInstanceCount() const
+{
+    return m_instanceNames.size();
+}
+
+/**
+ * @brief 对实例区间执行视口求交
+ * @param viewport 外扩后的视口
+ * @param fullRecheck 是否忽略粘滞位全量复查
+ * @param begin 区间起点
+ * @param end 区间终点（不含）
+ */
+void SpriteRenderer::cullRange(const QRectF &viewport, bool fullRecheck, int begin, int end)
+{
+    for (int i = begin; i < end; ++i) {
+        const quint8 flags = m_instanceFlags.at(i);
+        if (!fullRecheck && (flags & INSTANCE_STATIC) != 0 &&
+            (flags & INSTANCE_DIRTY) == 0) {
+            // 静态精灵沿用粘滞可见位，复查周期到了才重测
+            continue;
+        }
+        m_instanceVisible[i] = viewport.intersects(m_instanceBounds.at(i)) ? 1 : 0;
+        m_instanceFlags[i] = static_cast<quint8>(flags & ~INSTANCE_DIRTY);
+    }
+}
+
+/**
+ * @brief 视口剔除并批量提交可见实例
+ * @param viewport 视口矩形（世界坐标）
+ * @param jobSystem 任务系统
+ * @return 本帧可见的实例数
+ */
+int SpriteRenderer::cullAndBatch(const QRectF &viewport, JobSystem *jobSystem)
+{
+    PROFILE_ZONE("SpriteRenderer::cullAndBatch");
+
+    const int count = m_instanceNames.size();
+    ++m_cullFrame;
+
+    // 视口外扩：边缘精灵提前判为可见，粘滞位的复查周期内
+    // 小幅滚动不会漏显
+    const QRectF inflated = viewport.adjusted(
+        -CULL_VIEWPORT_MARGIN, -CULL_VIEWPORT_MARGIN,
+        CULL_VIEWPORT_MARGIN, CULL_VIEWPORT_MARGIN);
+
+    // 全量复查：周期到点，或视口单帧位移超出外扩边距（快速
+    // 滚动/瞬移时粘滞位不可信）
+    const bool viewportJumped =
+        qAbs(viewport.x() - m_lastCullViewport.x()) > CULL_VIEWPORT_MARGIN ||
+        qAbs(viewport.y() - m_lastCullViewport.y()) > CULL_VIEWPORT_MARGIN;
+    const bool fullRecheck =
+        (m_cullFrame % CULL_RECHECK_INTERVAL) == 0 || viewportJumped;
+    m_lastCullViewport = viewport;
+
+    if (jobSystem != nullptr && count >= CULL_PARALLEL_THRESHOLD) {
+        // 切成与工作线程数相同的块并行求交。块之间下标不重叠，
+        // 各任务写互不相交的可见位区间，无需同步
+        const int workers = qMax(1, jobSystem->workerCount());
+        const int chunk = (count + workers - 1) / workers;
+        for (int begin = 0; begin < count; begin += chunk) {
+            const int end = qMin(begin + chunk, count);
+            jobSystem->schedule([this, inflated, fullRecheck, begin, end]() {
+                cullRange(inflated, fullRecheck, begin, end);
+            });
+        }
+        jobSystem->waitForAll();
+    } else {
+        cullRange(inflated, fullRecheck, 0, count);
+    }
+
+    // 只把可见实例提交进批次
+    beginBatch();
+    int visibleCount = 0;
+    for (int i = 0; i < count; ++i) {
+        if (m_instanceVisible.at(i) != 0) {
+            batchSprite(m_instanceNames.at(i), m_instancePositions.at(i),
+                        m_instanceOptions.at(i));
+            ++visibleCount;
+        }
+    }
+    return visibleCount;
+}
+
 /**
  * @brief 卸载精灵
  * @param name 精灵名称
- * 
+ *
  * 从缓存中移除指定精灵，释放内存。
  * 如果精灵不存在，此操作无效果。
  */
@@ -158,6 +1050,11 @@ void SpriteRenderer::unloadSprite(const QString &name)
     auto it = m_spriteCache.find(name);
     if (it != m_spriteCache.end()) {
         qDebug() << "SpriteRenderer: 卸载精灵" << name;
+        if (it->inAtlas) {
+            // 归还动态图集区域：面积记入所属页的死区，
+            // 空闲片整理或场景切换重建时回收
+            releaseAtlasRegion(*it);
+        }
         m_spriteCache.erase(it);
         emit spriteUnloaded(name);
     }
@@ -185,9 +1082,13 @@ QPixmap SpriteRenderer::getSprite(const QString &name) const
 {
     auto it = m_spriteCache.find(name);
     if (it != m_spriteCache.end() && it->isLoaded) {
+        // 图集精灵裁出所属区域，普通精灵直接返回（隐式共享，无拷贝）
+        if (it->inAtlas) {
+            return it->pixmap.copy(it->atlasRegion);
+        }
         return it->pixmap;
     }
-    
+
     qWarning() << "SpriteRenderer: 精灵不存在或未加载:" << name;
     return QPixmap();
 }
@@ -215,30 +1116,20 @@ QPixmap SpriteRenderer::getSpriteFrame(const QString &name, int frameIndex) cons
     }
     
     const SpriteData &spriteData = *it;
-    
-    // 如果不是精灵表，返回整个图像
+
+    // 如果不是精灵表，返回整个图像（图集精灵裁出所属区域）
     if (!spriteData.isSpriteSheet) {
-        return spriteData.pixmap;
+        return getSprite(name);
     }
-    
+
     // 验证帧索引范围
     if (frameIndex < 0 || frameIndex >= spriteData.frameCount) {
         qWarning() << "SpriteRenderer: 帧索引超出范围:" << frameIndex;
         return QPixmap();
     }
-    
-    // 计算帧在网格中的位置
-    int col = frameIndex % spriteData.columns;
-    int row = frameIndex / spriteData.columns;
-    
-    // 定义帧的矩形区域
-    QRect frameRect(col * spriteData.frameWidth, 
-                   row * spriteData.frameHeight,
-                   spriteData.frameWidth, 
-                   spriteData.frameHeight);
-    
-    // 从完整图像中复制指定区域
-    return spriteData.pixmap.copy(frameRect);
+
+    // 从完整图像中复制指定区域（图集精灵带图集内偏移）
+    return spriteData.pixmap.copy(sourceRect(spriteData, frameIndex));
 }
 
 /**
@@ -284,6 +1175,8 @@ void SpriteRenderer::clearCache()
 {
     qDebug() << "SpriteRenderer: 清空精灵缓存，共" << m_spriteCache.size() << "个精灵";
     m_spriteCache.clear();
+    m_atlasPages.clear();
+    m_compactingPageId = 0;
     emit cacheCleared();
 }
 
@@ -367,6 +1260,59 @@ bool SpriteRenderer::isRenderEnabled() const
     return m_renderEnabled;
 }
 
+/**
+ * @brief 设置特效密度系数
+ * @param density 密度系数，钳制到0.0~1.0
+ */
+void SpriteRenderer::setEffectDensity(float density)
+{
+    m_effectDensity = std::clamp(density, 0.0f, 1.0f);
+}
+
+/**
+ * @brief 获取当前特效密度系数
+ * @return 密度系数（0.0~1.0）
+ */
+float SpriteRenderer::getEffectDensity() const
+{
+    return m_effectDensity;
+}
+
+/**
+ * @brief 设置特效细节层级
+ * @param tier 细节层级（0低/1中/2高）
+ */
+void SpriteRenderer::setLodTier(int tier)
+{
+    m_lodTier = std::clamp(tier, 0, 2);
+    switch (m_lodTier) {
+    case 0:
+        // 低档：最近邻插值省掉平滑采样，色调合成彻底关闭
+        m_transformMode = Qt::FastTransformation;
+        m_effectDensity = 0.0f;
+        break;
+    case 1:
+        // 中档：保留平滑插值，密度压到色调阈值以下
+        m_transformMode = Qt::SmoothTransformation;
+        m_effectDensity = TINT_MIN_DENSITY - 0.01f;
+        break;
+    default:
+        m_transformMode = Qt::SmoothTransformation;
+        m_effectDensity = 1.0f;
+        break;
+    }
+    qDebug() << "SpriteRenderer: 特效细节层级设为" << m_lodTier;
+}
+
+/**
+ * @brief 获取当前特效细节层级
+ * @return 细节层级（0~2）
+ */
+int SpriteRenderer::getLodTier() const
+{
+    return m_lodTier;
+}
+
 /**
  * @brief 应用渲染选项到图像
  * @param sprite 原始图像
@@ -391,17 +1337,17 @@ QPixmap SpriteRenderer::applyRenderOptions(const QPixmap &sprite, const RenderOp
     
     QPixmap result = sprite;
     
-    // 1. 应用缩放变换
+    // 1. 应用缩放变换（插值模式随细节层级切换）
     if (options.scale != 1.0f) {
         QSize newSize = sprite.size() * options.scale;
-        result = result.scaled(newSize, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+        result = result.scaled(newSize, Qt::KeepAspectRatio, m_transformMode);
     }
-    
+
     // 2. 应用旋转变换
     if (options.rotation != 0.0f) {
         QTransform transform;
         transform.rotate(options.rotation);
-        result = result.transformed(transform, Qt::SmoothTransformation);
+        result = result.transformed(transform, m_transformMode);
     }
     
     // 3. 应用翻转变换
@@ -425,8 +1371,9 @@ QPixmap SpriteRenderer::applyRenderOptions(const QPixmap &sprite, const RenderOp
         result = opacityResult;
     }
     
-    // 5. 应用色调滤镜
-    if (options.tint != QColor(255, 255, 255)) {
+    // 5. 应用色调滤镜（逐像素合成，特效密度降档时跳过）
+    if (options.tint != QColor(255, 255, 255) &&
+        m_effectDensity >= TINT_MIN_DENSITY) {
         QPixmap tintResult(result.size());
         tintResult.fill(Qt::transparent);
         
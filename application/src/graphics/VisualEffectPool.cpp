@@ -0,0 +1,187 @@
+/*
+ * 文件名: VisualEffectPool.cpp
+ * 说明: 短命视觉特效预分配对象池的实现。
+ * 作者: 彭承康
+ * 创建时间: 2026-08-28
+ */
+#include "graphics/VisualEffectPool.h"
+#include "core/FrameAllocator.h"
+
+VisualEffectPool::VisualEffectPool(SpriteRenderer *renderer, int capacity, QObject *parent)
+    : QObject(parent)
+    , m_renderer(renderer)
+    , m_freeHead(EffectHandle::INVALID_INDEX)
+{
+    const int slotCount = qMax(1, capacity);
+
+    // 一次性预分配全部槽位与存活列表，运行期不再触碰堆
+    m_slots.resize(slotCount);
+    m_activeSlots.reserve(slotCount);
+
+    // 空闲链表按索引逆序串起来，首个spawn拿到0号槽位
+    for (int i = slotCount - 1; i >= 0; --i) {
+        m_slots[i].nextFree = m_freeHead;
+        m_freeHead = static_cast<quint32>(i);
+    }
+}
+
+EffectHandle VisualEffectPool::spawn(const EffectDesc &desc)
+{
+    if (m_freeHead == EffectHandle::INVALID_INDEX) {
+        // 特效是装饰性内容：池满时丢弃比超帧预算更可取
+        ++m_droppedCount;
+        return EffectHandle{};
+    }
+
+    const quint32 slotIndex = m_freeHead;
+    Slot &slot = m_slots[slotIndex];
+    m_freeHead = slot.nextFree;
+
+    // QString隐式共享，精灵名赋值不产生堆分配
+    slot.spriteName = desc.spriteName;
+    slot.position = desc.position;
+    slot.velocity = desc.velocity;
+    slot.lifetimeMs = qMax(1.0f, desc.lifetimeMs);
+    slot.ageMs = 0.0f;
+    slot.fadeOutMs = qBound(0.0f, desc.fadeOutMs, slot.lifetimeMs);
+    slot.frameDurationMs = qMax(0.0f, desc.frameDurationMs);
+    slot.frameCount = qMax(1, desc.frameCount);
+    slot.render = desc.render;
+    slot.activePos = static_cast<quint32>(m_activeSlots.size());
+    slot.nextFree = EffectHandle::INVALID_INDEX;
+    slot.alive = true;
+
+    m_activeSlots.append(slotIndex);
+    m_highWaterMark = qMax(m_highWaterMark, m_activeSlots.size());
+
+    return EffectHandle{slotIndex, slot.generation};
+}
+
+bool VisualEffectPool::isAlive(EffectHandle handle) const
+{
+    return resolve(handle) != nullptr;
+}
+
+bool VisualEffectPool::release(EffectHandle handle)
+{
+    if (resolve(handle) == nullptr) {
+        return false;
+    }
+    releaseSlot(handle.index);
+    return true;
+}
+
+void VisualEffectPool::moveTo(EffectHandle handle, const QPointF &position)
+{
+    if (Slot *slot = resolve(handle)) {
+        slot->position = position;
+    }
+}
+
+void VisualEffectPool::update(float deltaMs)
+{
+    if (deltaMs < 0.0f) {
+        deltaMs = 0.0f;
+    }
+    const float deltaSeconds = deltaMs / 1000.0f;
+
+    // 到期槽位先收集后回收：回收会交换存活列表尾部，边遍历边
+    // 回收容易漏推进被换入的条目。收集数组取自帧分配器，一整
+    // 批粒子同帧到期也不触碰堆。
+    FrameVector<quint32> expired;
+    expired.reserve(m_activeSlots.size());
+
+    for (quint32 slotIndex : m_activeSlots) {
+        Slot &slot = m_slots[slotIndex];
+        slot.ageMs += deltaMs;
+        if (slot.ageMs >= slot.lifetimeMs) {
+            expired.push_back(slotIndex);
+            continue;
+        }
+        slot.position += slot.velocity * deltaSeconds;
+    }
+
+    for (quint32 slotIndex : expired) {
+        releaseSlot(slotIndex);
+    }
+
+    // 池满丢弃有新增时报告一次，供监控面板观察容量是否偏小
+    if (m_droppedCount != m_reportedDrops) {
+        m_reportedDrops = m_droppedCount;
+        emit poolExhausted(m_droppedCount);
+    }
+}
+
+int VisualEffectPool::submit()
+{
+    if (m_renderer == nullptr) {
+        return 0;
+    }
+
+    int submitted = 0;
+    for (quint32 slotIndex : m_activeSlots) {
+        const Slot &slot = m_slots[slotIndex];
+
+        SpriteRenderer::RenderOptions options = slot.render;
+
+        // 尾段淡出：剩余时间落入淡出窗口后透明度线性衰减
+        if (slot.fadeOutMs > 0.0f) {
+            const float remainingMs = slot.lifetimeMs - slot.ageMs;
+            if (remainingMs < slot.fadeOutMs) {
+                options.opacity *= qMax(0.0f, remainingMs / slot.fadeOutMs);
+            }
+        }
+
+        // 帧动画按年龄换算帧索引，不循环，停在最后一帧
+        if (slot.frameDurationMs > 0.0f && slot.frameCount > 1) {
+            const int frame = static_cast<int>(slot.ageMs / slot.frameDurationMs);
+            options.frameIndex = qMin(frame, slot.frameCount - 1);
+        }
+
+        m_renderer->batchSprite(slot.spriteName, slot.position, options);
+        ++submitted;
+    }
+    return submitted;
+}
+
+void VisualEffectPool::releaseAll()
+{
+    while (!m_activeSlots.isEmpty()) {
+        releaseSlot(m_activeSlots.last());
+    }
+}
+
+VisualEffectPool::Slot* VisualEffectPool::resolve(EffectHandle handle)
+{
+    if (handle.index >= static_cast<quint32>(m_slots.size())) {
+        return nullptr;
+    }
+    Slot &slot = m_slots[handle.index];
+    if (!slot.alive || slot.generation != handle.generation) {
+        return nullptr;
+    }
+    return &slot;
+}
+
+const VisualEffectPool::Slot* VisualEffectPool::resolve(EffectHandle handle) const
+{
+    return const_cast<VisualEffectPool*>(this)->resolve(handle);
+}
+
+void VisualEffectPool::releaseSlot(quint32 slotIndex)
+{
+    Slot &slot = m_slots[slotIndex];
+
+    // 存活列表尾部交换移除，保持紧凑
+    const quint32 lastSlotIndex = m_activeSlots.last();
+    m_activeSlots[slot.activePos] = lastSlotIndex;
+    m_slots[lastSlotIndex].activePos = slot.activePos;
+    m_activeSlots.removeLast();
+
+    // 世代自增使旧句柄失效，槽位挂回空闲链表
+    ++slot.generation;
+    slot.alive = false;
+    slot.spriteName.clear();
+    slot.nextFree = m_freeHead;
+    m_freeHead = slotIndex;
+}
@@ -29,6 +29,7 @@ InputManager::InputManager(QObject *parent)
     : QObject(parent), m_inputFilterEnabled(false), m_updateTimer(nullptr)
 {
     setupDefaultKeyMappings();
+    m_inputClock.start();
 }
 
 /**
@@ -53,6 +54,8 @@ bool InputManager::handleKeyPress(QKeyEvent *event)
     if (m_keyActionMap.contains(key)) {
         Action action = m_keyActionMap.value(key);
         m_pressedActions.insert(action);
+        m_actionEventQueue.append(
+            TimedActionEvent{ action, true, m_inputClock.elapsed() });
         emit actionTriggered(action);
         emit actionPressed(action);
         return true;
@@ -75,6 +78,8 @@ bool InputManager::handleKeyRelease(QKeyEvent *event)
     if (m_keyActionMap.contains(key)) {
         Action action = m_keyActionMap.value(key);
         m_pressedActions.remove(action);
+        m_actionEventQueue.append(
+            TimedActionEvent{ action, false, m_inputClock.elapsed() });
         emit actionReleased(action);
         return true;
     }
@@ -96,6 +101,8 @@ bool InputManager::handleMousePress(QMouseEvent *event)
     if (m_mouseActionMap.contains(button)) {
         Action action = m_mouseActionMap.value(button);
         m_pressedActions.insert(action);
+        m_actionEventQueue.append(
+            TimedActionEvent{ action, true, m_inputClock.elapsed() });
         emit actionTriggered(action);
         emit actionPressed(action);
         return true;
@@ -118,6 +125,8 @@ bool InputManager::handleMouseRelease(QMouseEvent *event)
     if (m_mouseActionMap.contains(button)) {
         Action action = m_mouseActionMap.value(button);
         m_pressedActions.remove(action);
+        m_actionEventQueue.append(
+            TimedActionEvent{ action, false, m_inputClock.elapsed() });
         emit actionReleased(action);
         return true;
     }
@@ -128,17 +137,16 @@ bool InputManager::handleMouseRelease(QMouseEvent *event)
  * @brief 处理鼠标移动事件
  * @param event 鼠标事件对象
  * @return 是否处理了该事件
- * 
- * 更新鼠标位置和增量，发送mouseMoved信号
+ *
+ * 仅累积位置与增量，不逐事件发信号——1kHz轮询率的鼠标在一帧内
+ * 可产生十余个移动事件，合并后由beginFrame每帧发送一次mouseMoved
  */
 bool InputManager::handleMouseMove(QMouseEvent *event)
 {
     if (!event) return false;
     QPoint newPos = event->pos();
-    m_mouseDelta = newPos - m_mousePosition;
-    m_lastMousePosition = m_mousePosition;
+    m_pendingMouseDelta += newPos - m_mousePosition;
     m_mousePosition = newPos;
-    emit mouseMoved(m_mousePosition, m_mouseDelta);
     return true;
 }
 
@@ -146,16 +154,107 @@ bool InputManager::handleMouseMove(QMouseEvent *event)
  * @brief 处理鼠标滚轮事件
  * @param event 滚轮事件对象
  * @return 是否处理了该事件
- * 
- * 发送mouseWheelScrolled信号
+ *
+ * 仅累积增量，由beginFrame每帧合并发送一次mouseWheelScrolled
  */
 bool InputManager::handleWheelEvent(QWheelEvent *event)
 {
     if (!event) return false;
-    emit mouseWheelScrolled(event->angleDelta().y());
+    m_pendingWheelDelta += event->angleDelta().y();
     return true;
 }
 
+/**
+ * @brief 开始新的一帧
+ *
+ * 冻结本帧输入快照并发送合并后的移动/滚轮信号
+ */
+void InputManager::beginFrame()
+{
+    // 冻结快照：整帧内isPressed/axisValue读到一致的值。
+    // 动作快照经时间戳重放推进，与固定步长路径同一套语义
+    applyEventsUntil(m_inputClock.elapsed());
+
+    m_lastMousePosition = m_mousePosition - m_pendingMouseDelta;
+    m_mouseDelta = m_pendingMouseDelta;
+    m_pendingMouseDelta = QPoint(0, 0);
+
+    m_frameWheelDelta = m_pendingWheelDelta;
+    m_pendingWheelDelta = 0;
+
+    // 合并后的连续输入每帧至多各发一次信号
+    if (!m_mouseDelta.isNull()) {
+        emit mouseMoved(m_mousePosition, m_mouseDelta);
+    }
+    if (m_frameWheelDelta != 0) {
+        emit mouseWheelScrolled(m_frameWheelDelta);
+    }
+}
+
+/**
+ * @brief 输入时钟当前时间
+ * @return 毫秒（单调递增）
+ */
+qint64 InputManager::inputTimeMs() const
+{
+    return m_inputClock.elapsed();
+}
+
+/**
+ * @brief 把时间戳不晚于untilMs的动作事件重放进快照
+ * @param untilMs 本模拟步覆盖区间的结束时刻
+ *
+ * 队列按到达顺序存放，时间戳天然有序：从队头弹出属于本步的
+ * 事件依次套用到快照集合上。帧跑长补跑多步时，每个事件仍在
+ * 覆盖其到达时刻的那一步生效，而不是挤在补跑的第一步。
+ */
+void InputManager::applyEventsUntil(qint64 untilMs)
+{
+    while (!m_actionEventQueue.isEmpty() &&
+           m_actionEventQueue.first().timestampMs <= untilMs) {
+        const TimedActionEvent event = m_actionEventQueue.takeFirst();
+        if (event.pressed) {
+            m_frameActions.insert(event.action);
+        } else {
+            m_frameActions.remove(event.action);
+        }
+    }
+}
+
+/**
+ * @brief 查询动作在本帧快照中是否按下
+ * @param action 游戏动作
+ * @return 是否按下
+ */
+bool InputManager::isPressed(Action action) const
+{
+    return m_frameActions.contains(action);
+}
+
+/**
+ * @brief 查询输入轴在本帧快照中的值
+ * @param axis 输入轴
+ * @return 轴值
+ */
+float InputManager::axisValue(Axis axis) const
+{
+    switch (axis) {
+    case Axis::MoveHorizontal:
+        return (m_frameActions.contains(Action::MoveRight) ? 1.0f : 0.0f)
+             - (m_frameActions.contains(Action::MoveLeft) ? 1.0f : 0.0f);
+    case Axis::MoveVertical:
+        return (m_frameActions.contains(Action::MoveDown) ? 1.0f : 0.0f)
+             - (m_frameActions.contains(Action::MoveUp) ? 1.0f : 0.0f);
+    case Axis::MouseX:
+        return static_cast<float>(m_mouseDelta.x());
+    case Axis::MouseY:
+        return static_cast<float>(m_mouseDelta.y());
+    case Axis::Wheel:
+        return static_cast<float>(m_frameWheelDelta);
+    }
+    return 0.0f;
+}
+
 /**
  * @brief 检查指定按键是否被按下
  * @param key 按键码
@@ -646,6 +745,6 @@ void InputManager::onKeySequenceTimeout()
 
 void InputManager::updateInputState()
 {
-    // 帧更新时重置鼠标增量
-    m_mouseDelta = QPoint(0, 0);
+    // 定时器驱动的旧入口，统一走帧快照逻辑
+    beginFrame();
 }
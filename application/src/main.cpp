@@ -16,6 +16,7 @@
 #include "GameApplication.h"
 #include <QFontDatabase>
 #include "utils/Logger.h"
+#include "utils/StartupProfiler.h"
 
 /**
  * @brief 设置应用程序基本信息
@@ -101,31 +102,53 @@ void loadCustomFonts()
  */
 int main(int argc, char *argv[])
 {
+    // 锚定启动时间零点，后续阶段的时间戳都相对于此处
+    StartupProfiler *startupProfiler = StartupProfiler::instance();
+
+    // Qt初始化阶段：应用实例、基本信息、日志、样式与字体
+    startupProfiler->beginPhase(QStringLiteral("qt_init"));
+
     // 创建应用程序实例
     QApplication app(argc, argv);
-    
+
     // 设置应用程序基本信息
     setupApplicationInfo();
-    
+
     // 初始化日志系统
     initializeLogging();
-    
+
     // 设置应用程序样式
     setupApplicationStyle(app);
-    
+
     // 加载自定义字体
     loadCustomFonts();
-    
+
+    startupProfiler->endPhase(QStringLiteral("qt_init"));
+
     try {
         // 创建游戏应用程序
         GameApplication gameApp;
-        
+
         // 初始化游戏应用程序
         if (!gameApp.initialize()) {
             qCritical() << "游戏应用程序初始化失败";
             return -1;
         }
-        
+
+        // 无头回放模式：--replay-battle <回放文件>
+        // 不加载界面，确定性重放战斗并导出性能档案后退出
+        const QStringList arguments = QCoreApplication::arguments();
+        const int replayIndex = arguments.indexOf("--replay-battle");
+        if (replayIndex != -1) {
+            if (replayIndex + 1 >= arguments.size()) {
+                qCritical() << "用法: --replay-battle <回放文件>";
+                return -1;
+            }
+            const bool finished = gameApp.runBattleReplay(arguments.at(replayIndex + 1));
+            gameApp.shutdown();
+            return finished ? 0 : -1;
+        }
+
         // 启动游戏应用程序
         gameApp.start();
         
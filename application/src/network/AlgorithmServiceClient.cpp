@@ -5,8 +5,40 @@
  * 创建时间: 2026-02-18
  */
 #include "network/AlgorithmServiceClient.h"
+#include "network/CircuitBreaker.h"
+#include "network/GrpcChannelManager.h"
+#include "utils/PerformanceMonitor.h"
 #include <QDebug>
 #include <QJsonArray>
+#include <QTimer>
+
+namespace {
+
+/**
+ * @brief 构造熔断打开时的快速失败结果
+ */
+QJsonObject makeCircuitOpenError(const QString &endpoint)
+{
+    QJsonObject error;
+    error["error"] = true;
+    error["circuitOpen"] = true;
+    error["message"] = QStringLiteral("熔断打开，快速失败: ") + endpoint;
+    return error;
+}
+
+/**
+ * @brief 构造流水线过载被剔除时的快速失败结果
+ */
+QJsonObject makeQueueShedError()
+{
+    QJsonObject error;
+    error["error"] = true;
+    error["queueShed"] = true;
+    error["message"] = QStringLiteral("请求流水线过载，低优先级请求被剔除");
+    return error;
+}
+
+} // namespace
 
 AlgorithmServiceClient::AlgorithmServiceClient(QObject *parent)
     : QObject(parent)
@@ -15,6 +47,13 @@ AlgorithmServiceClient::AlgorithmServiceClient(QObject *parent)
     , m_timeout(10000)
     , m_retryCount(3)
 {
+    // 0ms单次定时器：同一事件循环轮次内排队的请求在轮次末合批发出
+    m_flushTimer = new QTimer(this);
+    m_flushTimer->setSingleShot(true);
+    m_flushTimer->setInterval(0);
+    connect(m_flushTimer, &QTimer::timeout,
+            this, &AlgorithmServiceClient::flushPendingRequests);
+
     qDebug() << "AlgorithmServiceClient: gRPC客户端创建完成";
 }
 
@@ -24,7 +63,8 @@ AlgorithmServiceClient::~AlgorithmServiceClient()
     qDebug() << "AlgorithmServiceClient: gRPC客户端销毁";
 }
 
-bool AlgorithmServiceClient::initialize(const QString &serviceUrl)
+bool AlgorithmServiceClient::initialize(const QString &serviceUrl,
+                                        std::shared_ptr<grpc::Channel> sharedChannel)
 {
     m_serviceUrl = serviceUrl;
 
@@ -35,14 +75,61 @@ bool AlgorithmServiceClient::initialize(const QString &serviceUrl)
         m_serviceUrl = m_serviceUrl.mid(8);
     }
 
-    channel_ = grpc::CreateChannel(m_serviceUrl.toStdString(),
-                                   grpc::InsecureChannelCredentials());
+    // 优先复用通道管理器的持久通道，重连不再重付建连成本。
+    // 算法服务的战斗RPC都是小消息，全部低于压缩阈值（见
+    // net/GrpcCompressionPolicy.h），维持通道默认的不压缩
+    if (sharedChannel) {
+        channel_ = std::move(sharedChannel);
+    } else {
+        channel_ = grpc::CreateChannel(m_serviceUrl.toStdString(),
+                                       grpc::InsecureChannelCredentials());
+    }
     stub_ = algorithm_proto::AlgorithmService::NewStub(channel_);
 
     qDebug() << "AlgorithmServiceClient: 初始化完成，服务地址:" << m_serviceUrl;
     return true;
 }
 
+void AlgorithmServiceClient::configureReplicas(const QStringList &targets,
+                                               GrpcChannelManager *channelManager)
+{
+    if (!channelManager || targets.isEmpty()) {
+        return;
+    }
+
+    m_channelManager = channelManager;
+    m_channelManager->setReplicaTargets(QStringLiteral("algorithm"), targets);
+
+    m_replicaStubs.clear();
+    for (const QString &target : targets) {
+        m_replicaStubs.insert(target,
+            algorithm_proto::AlgorithmService::NewStub(
+                m_channelManager->channelFor(target)));
+    }
+
+    qDebug() << "AlgorithmServiceClient: 配置" << targets.size() << "个服务副本";
+}
+
+void AlgorithmServiceClient::setCircuitBreaker(CircuitBreaker *breaker)
+{
+    m_breaker = breaker;
+}
+
+algorithm_proto::AlgorithmService::Stub* AlgorithmServiceClient::pickStub(
+    QString &chosenTarget, const QString &exclude)
+{
+    if (m_channelManager && !m_replicaStubs.isEmpty()) {
+        chosenTarget = m_channelManager->pickReplica(QStringLiteral("algorithm"), exclude);
+        auto it = m_replicaStubs.find(chosenTarget);
+        if (it != m_replicaStubs.end()) {
+            return it.value().get();
+        }
+    }
+
+    chosenTarget = m_serviceUrl;
+    return stub_.get();
+}
+
 void AlgorithmServiceClient::connectToService()
 {
     if (m_connected) {
@@ -92,6 +179,13 @@ bool AlgorithmServiceClient::testConnection()
 
     grpc::Status status = stub_->ValidateInput(&context, request, &response);
 
+    // 健康检查不经熔断拦截，结果参与统计：服务恢复时它天然
+    // 充当半开探测，成功即让ValidateInput的熔断恢复闭合
+    if (m_breaker) {
+        status.ok() ? m_breaker->recordSuccess(QStringLiteral("Algorithm.ValidateInput"))
+                    : m_breaker->recordFailure(QStringLiteral("Algorithm.ValidateInput"));
+    }
+
     if (status.ok()) {
         if (!m_connected) {
             m_connected = true;
@@ -113,18 +207,41 @@ void AlgorithmServiceClient::calculateDamage(const QJsonObject &request,
         return;
     }
 
+    const QString endpoint = QStringLiteral("Algorithm.CalculateDamage");
+    if (m_breaker && !m_breaker->allowRequest(endpoint)) {
+        if (callback) callback(makeCircuitOpenError(endpoint));
+        return;
+    }
+
     algorithm_proto::CalculationRequest grpcRequest;
     grpcRequest.set_attacker_id(request["attackerId"].toInt());
     grpcRequest.set_defender_id(request["defenderId"].toInt());
     grpcRequest.set_skill_id(request["skillId"].toInt());
 
+    QString target;
+    algorithm_proto::AlgorithmService::Stub *stub = pickStub(target);
+
     algorithm_proto::DamageResult grpcResponse;
     grpc::ClientContext context;
     std::chrono::system_clock::time_point deadline =
         std::chrono::system_clock::now() + std::chrono::milliseconds(m_timeout);
     context.set_deadline(deadline);
 
-    grpc::Status status = stub_->CalculateDamage(&context, grpcRequest, &grpcResponse);
+    // 跨层追踪：trace id经元数据传播，服务端记录各自跳点
+    const quint64 traceId = PerformanceMonitor::generateTraceId();
+    context.AddMetadata("x-trace-id", std::to_string(traceId));
+    PerformanceMonitor::instance()->recordTraceEvent(traceId, "client_send");
+
+    if (m_channelManager) m_channelManager->beginCall(target);
+    grpc::Status status = stub->CalculateDamage(&context, grpcRequest, &grpcResponse);
+    if (m_channelManager) m_channelManager->endCall(target);
+
+    PerformanceMonitor::instance()->recordTraceEvent(traceId, "client_recv");
+
+    if (m_breaker) {
+        status.ok() ? m_breaker->recordSuccess(endpoint)
+                    : m_breaker->recordFailure(endpoint);
+    }
 
     if (status.ok()) {
         QJsonObject response;
@@ -152,6 +269,12 @@ void AlgorithmServiceClient::makeAIDecision(const QJsonObject &request,
         return;
     }
 
+    const QString endpoint = QStringLiteral("Algorithm.AIActionDecision");
+    if (m_breaker && !m_breaker->allowRequest(endpoint)) {
+        if (callback) callback(makeCircuitOpenError(endpoint));
+        return;
+    }
+
     algorithm_proto::AIDecisionRequest grpcRequest;
     grpcRequest.set_npc_id(request["npcId"].toInt());
 
@@ -160,13 +283,58 @@ void AlgorithmServiceClient::makeAIDecision(const QJsonObject &request,
         grpcRequest.add_context(val.toInt());
     }
 
+    QString target;
+    algorithm_proto::AlgorithmService::Stub *stub = pickStub(target);
+
+    // 对冲重试：配置了多副本时首次尝试用较短期限，超时或副本
+    // 不可用就换一个副本用完整期限重试，单个实例的请求堆积
+    // 不再直接变成本次调用的长尾延迟
+    const bool canHedge = m_replicaStubs.size() > 1;
+    int attemptTimeout = canHedge ? qMin(m_timeout, HEDGE_TIMEOUT_MS) : m_timeout;
+
+    // 跨层追踪：trace id经元数据传播，服务端记录各自跳点
+    const quint64 traceId = PerformanceMonitor::generateTraceId();
+    PerformanceMonitor::instance()->recordTraceEvent(traceId, "client_send");
+
     algorithm_proto::ActionResponse grpcResponse;
-    grpc::ClientContext context;
-    std::chrono::system_clock::time_point deadline =
-        std::chrono::system_clock::now() + std::chrono::milliseconds(m_timeout);
-    context.set_deadline(deadline);
+    grpc::Status status;
+    for (int attempt = 0; attempt < 2; ++attempt) {
+        grpc::ClientContext context;
+        context.set_deadline(std::chrono::system_clock::now() +
+                             std::chrono::milliseconds(attemptTimeout));
+        context.AddMetadata("x-trace-id", std::to_string(traceId));
+
+        if (m_channelManager) m_channelManager->beginCall(target);
+        status = stub->AIActionDecision(&context, grpcRequest, &grpcResponse);
+        if (m_channelManager) m_channelManager->endCall(target);
+
+        if (status.ok() || !canHedge || attempt > 0) {
+            break;
+        }
+        if (status.error_code() != grpc::StatusCode::DEADLINE_EXCEEDED &&
+            status.error_code() != grpc::StatusCode::UNAVAILABLE) {
+            break;
+        }
 
-    grpc::Status status = stub_->AIActionDecision(&context, grpcRequest, &grpcResponse);
+        QString hedgeTarget;
+        algorithm_proto::AlgorithmService::Stub *hedgeStub = pickStub(hedgeTarget, target);
+        if (!hedgeStub || hedgeTarget == target) {
+            break;
+        }
+
+        qDebug() << "AlgorithmServiceClient: AI决策对冲重试:" << target << "->" << hedgeTarget;
+        stub = hedgeStub;
+        target = hedgeTarget;
+        attemptTimeout = m_timeout;
+    }
+
+    PerformanceMonitor::instance()->recordTraceEvent(traceId, "client_recv");
+
+    // 对冲重试算一次调用，按最终结果统计
+    if (m_breaker) {
+        status.ok() ? m_breaker->recordSuccess(endpoint)
+                    : m_breaker->recordFailure(endpoint);
+    }
 
     if (status.ok()) {
         QJsonObject response;
@@ -185,6 +353,200 @@ void AlgorithmServiceClient::makeAIDecision(const QJsonObject &request,
     }
 }
 
+void AlgorithmServiceClient::queueDamageRequest(const QJsonObject &request,
+                                              std::function<void(const QJsonObject&)> callback)
+{
+    enqueuePending(m_pendingDamage, request, std::move(callback));
+}
+
+void AlgorithmServiceClient::queueAIDecision(const QJsonObject &request,
+                                           std::function<void(const QJsonObject&)> callback)
+{
+    enqueuePending(m_pendingAI, request, std::move(callback));
+}
+
+void AlgorithmServiceClient::flushPendingRequests()
+{
+    // 取走队列后再发送，回调中继续排队的请求归入下一批
+    if (!m_pendingDamage.isEmpty()) {
+        sendDamageBatch(std::move(m_pendingDamage));
+        m_pendingDamage.clear();
+    }
+    if (!m_pendingAI.isEmpty()) {
+        sendAIBatch(std::move(m_pendingAI));
+        m_pendingAI.clear();
+    }
+}
+
+void AlgorithmServiceClient::enqueuePending(QVector<PendingCall> &queue,
+                                           const QJsonObject &request,
+                                           std::function<void(const QJsonObject&)> callback)
+{
+    // 排队总量超限时先剔除低优先级流量：AI决策（表现层可退化
+    // 为本地规则）先于伤害计算（战斗结算必需）被剔除，被剔除
+    // 的请求立即以queueShed错误回调，队头最旧的先丢
+    if (m_pendingDamage.size() + m_pendingAI.size() >= MAX_PENDING_CALLS) {
+        if (!m_pendingAI.isEmpty()) {
+            PendingCall shed = m_pendingAI.takeFirst();
+            qWarning() << "AlgorithmServiceClient: 流水线过载，剔除排队的AI决策请求";
+            if (shed.callback) shed.callback(makeQueueShedError());
+        } else if (&queue == &m_pendingAI) {
+            // 队列里全是高优先级请求，新来的AI决策直接快速失败
+            qWarning() << "AlgorithmServiceClient: 流水线过载，拒绝新的AI决策请求";
+            if (callback) callback(makeQueueShedError());
+            return;
+        } else {
+            PendingCall shed = m_pendingDamage.takeFirst();
+            qWarning() << "AlgorithmServiceClient: 流水线过载，剔除排队的伤害计算请求";
+            if (shed.callback) shed.callback(makeQueueShedError());
+        }
+    }
+
+    queue.append(PendingCall{request, std::move(callback)});
+
+    if (queue.size() >= MAX_BATCH_SIZE) {
+        flushPendingRequests();
+    } else if (!m_flushTimer->isActive()) {
+        m_flushTimer->start();
+    }
+}
+
+void AlgorithmServiceClient::sendDamageBatch(QVector<PendingCall> calls)
+{
+    if (!stub_) {
+        qWarning() << "AlgorithmServiceClient: stub未初始化";
+        return;
+    }
+
+    // 熔断打开时整批快速失败，不再付一次超时等待
+    const QString endpoint = QStringLiteral("Algorithm.CalculateDamageBatch");
+    if (m_breaker && !m_breaker->allowRequest(endpoint)) {
+        const QJsonObject errorResponse = makeCircuitOpenError(endpoint);
+        for (const PendingCall &call : calls) {
+            if (call.callback) call.callback(errorResponse);
+        }
+        return;
+    }
+
+    algorithm_proto::BatchCalculationRequest grpcRequest;
+    for (const PendingCall &call : calls) {
+        auto *entry = grpcRequest.add_requests();
+        entry->set_attacker_id(call.request["attackerId"].toInt());
+        entry->set_defender_id(call.request["defenderId"].toInt());
+        entry->set_skill_id(call.request["skillId"].toInt());
+    }
+
+    QString target;
+    algorithm_proto::AlgorithmService::Stub *stub = pickStub(target);
+
+    algorithm_proto::BatchDamageResult grpcResponse;
+    grpc::ClientContext context;
+    std::chrono::system_clock::time_point deadline =
+        std::chrono::system_clock::now() + std::chrono::milliseconds(m_timeout);
+    context.set_deadline(deadline);
+
+    if (m_channelManager) m_channelManager->beginCall(target);
+    grpc::Status status = stub->CalculateDamageBatch(&context, grpcRequest, &grpcResponse);
+    if (m_channelManager) m_channelManager->endCall(target);
+
+    if (m_breaker) {
+        status.ok() ? m_breaker->recordSuccess(endpoint)
+                    : m_breaker->recordFailure(endpoint);
+    }
+
+    if (status.ok() && grpcResponse.results_size() == calls.size()) {
+        // 结果与请求按序一一对应
+        for (int i = 0; i < grpcResponse.results_size(); ++i) {
+            const auto &result = grpcResponse.results(i);
+            QJsonObject response;
+            response["damage"] = result.damage();
+            response["effect"] = QString::fromStdString(result.effect());
+            response["isCritical"] = result.is_critical();
+            response["elementMultiplier"] = static_cast<double>(result.element_multiplier());
+            if (calls[i].callback) calls[i].callback(response);
+        }
+    } else {
+        QString message = status.ok()
+            ? QStringLiteral("批量结果数量与请求不符")
+            : QString::fromStdString(status.error_message());
+        qWarning() << "AlgorithmServiceClient: sendDamageBatch失败:" << message;
+        QJsonObject errorResponse;
+        errorResponse["error"] = true;
+        errorResponse["message"] = message;
+        for (const PendingCall &call : calls) {
+            if (call.callback) call.callback(errorResponse);
+        }
+    }
+}
+
+void AlgorithmServiceClient::sendAIBatch(QVector<PendingCall> calls)
+{
+    if (!stub_) {
+        qWarning() << "AlgorithmServiceClient: stub未初始化";
+        return;
+    }
+
+    // 熔断打开时整批快速失败，不再付一次超时等待
+    const QString endpoint = QStringLiteral("Algorithm.BatchAIDecision");
+    if (m_breaker && !m_breaker->allowRequest(endpoint)) {
+        const QJsonObject errorResponse = makeCircuitOpenError(endpoint);
+        for (const PendingCall &call : calls) {
+            if (call.callback) call.callback(errorResponse);
+        }
+        return;
+    }
+
+    algorithm_proto::BatchAIDecisionRequest grpcRequest;
+    for (const PendingCall &call : calls) {
+        auto *entry = grpcRequest.add_npcs();
+        entry->set_npc_id(call.request["npcId"].toInt());
+        QJsonArray contextArray = call.request["context"].toArray();
+        for (const auto &val : contextArray) {
+            entry->add_context(val.toInt());
+        }
+    }
+
+    QString target;
+    algorithm_proto::AlgorithmService::Stub *stub = pickStub(target);
+
+    algorithm_proto::BatchActionResponse grpcResponse;
+    grpc::ClientContext context;
+    std::chrono::system_clock::time_point deadline =
+        std::chrono::system_clock::now() + std::chrono::milliseconds(m_timeout);
+    context.set_deadline(deadline);
+
+    if (m_channelManager) m_channelManager->beginCall(target);
+    grpc::Status status = stub->BatchAIDecision(&context, grpcRequest, &grpcResponse);
+    if (m_channelManager) m_channelManager->endCall(target);
+
+    if (m_breaker) {
+        status.ok() ? m_breaker->recordSuccess(endpoint)
+                    : m_breaker->recordFailure(endpoint);
+    }
+
+    if (status.ok() && grpcResponse.responses_size() == calls.size()) {
+        for (int i = 0; i < grpcResponse.responses_size(); ++i) {
+            const auto &result = grpcResponse.responses(i);
+            QJsonObject response;
+            response["actionId"] = result.action_id();
+            response["description"] = QString::fromStdString(result.description());
+            response["confidence"] = static_cast<double>(result.confidence());
+            if (calls[i].callback) calls[i].callback(response);
+        }
+    } else {
+        QString message = status.ok()
+            ? QStringLiteral("批量结果数量与请求不符")
+            : QString::fromStdString(status.error_message());
+        qWarning() << "AlgorithmServiceClient: sendAIBatch失败:" << message;
+        QJsonObject errorResponse;
+        errorResponse["error"] = true;
+        errorResponse["message"] = message;
+        for (const PendingCall &call : calls) {
+            if (call.callback) call.callback(errorResponse);
+        }
+    }
+}
+
 void AlgorithmServiceClient::getSkillTree(const QJsonObject &request,
                                         std::function<void(const QJsonObject&)> callback)
 {
@@ -193,6 +555,12 @@ void AlgorithmServiceClient::getSkillTree(const QJsonObject &request,
         return;
     }
 
+    const QString endpoint = QStringLiteral("Algorithm.GetSkillTree");
+    if (m_breaker && !m_breaker->allowRequest(endpoint)) {
+        if (callback) callback(makeCircuitOpenError(endpoint));
+        return;
+    }
+
     algorithm_proto::SkillTreeRequest grpcRequest;
     grpcRequest.set_character_id(request["playerId"].toInt());
 
@@ -204,6 +572,11 @@ void AlgorithmServiceClient::getSkillTree(const QJsonObject &request,
 
     grpc::Status status = stub_->GetSkillTree(&context, grpcRequest, &grpcResponse);
 
+    if (m_breaker) {
+        status.ok() ? m_breaker->recordSuccess(endpoint)
+                    : m_breaker->recordFailure(endpoint);
+    }
+
     if (status.ok()) {
         QJsonObject response;
         response["characterId"] = grpcResponse.character_id();
@@ -233,6 +606,87 @@ void AlgorithmServiceClient::getSkillTree(const QJsonObject &request,
     }
 }
 
+void AlgorithmServiceClient::syncSkillTree(const QJsonObject &request,
+                                         std::function<void(const QJsonObject&)> callback)
+{
+    if (!stub_) {
+        qWarning() << "AlgorithmServiceClient: stub未初始化";
+        return;
+    }
+
+    const QString endpoint = QStringLiteral("Algorithm.WatchSkillTree");
+    if (m_breaker && !m_breaker->allowRequest(endpoint)) {
+        if (callback) callback(makeCircuitOpenError(endpoint));
+        return;
+    }
+
+    algorithm_proto::SkillTreeWatchRequest grpcRequest;
+    grpcRequest.set_character_id(request["playerId"].toInt());
+    grpcRequest.set_known_version(m_skillTreeVersion);
+
+    grpc::ClientContext context;
+    std::chrono::system_clock::time_point deadline =
+        std::chrono::system_clock::now() + std::chrono::milliseconds(m_timeout);
+    context.set_deadline(deadline);
+
+    auto reader = stub_->WatchSkillTree(&context, grpcRequest);
+
+    algorithm_proto::SkillTreeDelta delta;
+    bool received = reader->Read(&delta);
+    // 仅取初始增量，版本同步后立即关闭流
+    context.TryCancel();
+    grpc::Status status = reader->Finish();
+
+    // 流式RPC按是否读到初始增量统计（主动取消后Finish
+    // 返回CANCELLED，不代表服务端故障）
+    if (m_breaker) {
+        received ? m_breaker->recordSuccess(endpoint)
+                 : m_breaker->recordFailure(endpoint);
+    }
+
+    if (!received) {
+        qWarning() << "AlgorithmServiceClient: syncSkillTree失败:"
+                   << QString::fromStdString(status.error_message());
+        if (callback) {
+            QJsonObject errorResponse;
+            errorResponse["error"] = true;
+            errorResponse["message"] = QString::fromStdString(status.error_message());
+            callback(errorResponse);
+        }
+        return;
+    }
+
+    // 快照重置缓存，增量合并，UP_TO_DATE 零传输直接回放缓存
+    if (delta.change() == algorithm_proto::SkillTreeDelta::FULL_SNAPSHOT) {
+        m_skillTreeCache.clear();
+    }
+    for (int i = 0; i < delta.nodes_size(); ++i) {
+        const auto& skill = delta.nodes(i);
+        QJsonObject skillObj;
+        skillObj["skillId"] = skill.skill_id();
+        skillObj["name"] = QString::fromStdString(skill.name());
+        skillObj["description"] = QString::fromStdString(skill.description());
+        skillObj["damageMultiplier"] = static_cast<double>(skill.damage_multiplier());
+        skillObj["manaCost"] = skill.mana_cost();
+        skillObj["cooldown"] = skill.cooldown();
+        skillObj["canLearn"] = skill.can_learn();
+        m_skillTreeCache[skill.skill_id()] = skillObj;
+    }
+    m_skillTreeVersion = delta.version();
+
+    QJsonObject response;
+    response["characterId"] = request["playerId"].toInt();
+    response["version"] = static_cast<double>(m_skillTreeVersion);
+    response["fromCache"] =
+        (delta.change() == algorithm_proto::SkillTreeDelta::UP_TO_DATE);
+    QJsonArray skillsArray;
+    for (auto it = m_skillTreeCache.constBegin(); it != m_skillTreeCache.constEnd(); ++it) {
+        skillsArray.append(it.value());
+    }
+    response["skills"] = skillsArray;
+    if (callback) callback(response);
+}
+
 void AlgorithmServiceClient::validateData(const QJsonObject &request,
                                         std::function<void(const QJsonObject&)> callback)
 {
@@ -241,6 +695,12 @@ void AlgorithmServiceClient::validateData(const QJsonObject &request,
         return;
     }
 
+    const QString endpoint = QStringLiteral("Algorithm.ValidateInput");
+    if (m_breaker && !m_breaker->allowRequest(endpoint)) {
+        if (callback) callback(makeCircuitOpenError(endpoint));
+        return;
+    }
+
     algorithm_proto::ValidationRequest grpcRequest;
     grpcRequest.set_validation_type(request["validationType"].toString().toStdString());
 
@@ -258,6 +718,11 @@ void AlgorithmServiceClient::validateData(const QJsonObject &request,
 
     grpc::Status status = stub_->ValidateInput(&context, grpcRequest, &grpcResponse);
 
+    if (m_breaker) {
+        status.ok() ? m_breaker->recordSuccess(endpoint)
+                    : m_breaker->recordFailure(endpoint);
+    }
+
     if (status.ok()) {
         QJsonObject response;
         response["isValid"] = grpcResponse.is_valid();
@@ -278,6 +743,15 @@ void AlgorithmServiceClient::validateData(const QJsonObject &request,
     }
 }
 
+double AlgorithmServiceClient::skillDamageMultiplier(int skillId) const
+{
+    auto it = m_skillTreeCache.constFind(skillId);
+    if (it != m_skillTreeCache.constEnd()) {
+        return it.value()["damageMultiplier"].toDouble(1.0);
+    }
+    return 1.0;
+}
+
 void AlgorithmServiceClient::setTimeout(int timeoutMs)
 {
     m_timeout = qMax(1000, timeoutMs);
@@ -329,3 +803,60 @@ QJsonObject AlgorithmServiceClient::createSkillTreeRequest(int playerId, const Q
     request["profession"] = profession;
     return request;
 }
+
+// ==================== 协程接口 ====================
+
+namespace {
+
+/**
+ * @brief 构造stub未初始化的错误结果
+ */
+QJsonObject makeStubNotReadyError()
+{
+    QJsonObject error;
+    error["error"] = true;
+    error["message"] = QStringLiteral("gRPC stub未初始化");
+    return error;
+}
+
+} // namespace
+
+net::RpcCall AlgorithmServiceClient::calculateDamage(const QJsonObject &request)
+{
+    if (!stub_) {
+        return net::RpcCall::immediate(makeStubNotReadyError());
+    }
+    return net::RpcCall(this, [this, request](net::RpcCall::Reply done) {
+        calculateDamage(request, std::move(done));
+    });
+}
+
+net::RpcCall AlgorithmServiceClient::makeAIDecision(const QJsonObject &request)
+{
+    if (!stub_) {
+        return net::RpcCall::immediate(makeStubNotReadyError());
+    }
+    return net::RpcCall(this, [this, request](net::RpcCall::Reply done) {
+        makeAIDecision(request, std::move(done));
+    });
+}
+
+net::RpcCall AlgorithmServiceClient::getSkillTree(const QJsonObject &request)
+{
+    if (!stub_) {
+        return net::RpcCall::immediate(makeStubNotReadyError());
+    }
+    return net::RpcCall(this, [this, request](net::RpcCall::Reply done) {
+        getSkillTree(request, std::move(done));
+    });
+}
+
+net::RpcCall AlgorithmServiceClient::validateData(const QJsonObject &request)
+{
+    if (!stub_) {
+        return net::RpcCall::immediate(makeStubNotReadyError());
+    }
+    return net::RpcCall(this, [this, request](net::RpcCall::Reply done) {
+        validateData(request, std::move(done));
+    });
+}
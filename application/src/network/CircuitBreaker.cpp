@@ -0,0 +1,159 @@
+/*
+ * 文件名: CircuitBreaker.cpp
+ * 说明: 熔断器的具体实现。
+ * 作者: 彭承康
+ * 创建时间: 2026-08-28
+ */
+#include "network/CircuitBreaker.h"
+#include <QDateTime>
+#include <QDebug>
+#include <QMutexLocker>
+
+CircuitBreaker::CircuitBreaker(QObject *parent)
+    : QObject(parent)
+{
+}
+
+bool CircuitBreaker::allowRequest(const QString &endpoint)
+{
+    QMutexLocker locker(&m_mutex);
+
+    EndpointStats &stats = m_endpoints[endpoint];
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+
+    switch (stats.state) {
+        case State::Closed:
+            return true;
+
+        case State::Open:
+            // 冷却期结束转半开，放行单个探测请求
+            if (now - stats.openedAtMs >= OPEN_COOLDOWN_MS) {
+                stats.state = State::HalfOpen;
+                stats.probeInFlight = true;
+                return true;
+            }
+            return false;
+
+        case State::HalfOpen:
+            if (!stats.probeInFlight) {
+                stats.probeInFlight = true;
+                return true;
+            }
+            return false;
+    }
+
+    return true;
+}
+
+void CircuitBreaker::recordSuccess(const QString &endpoint)
+{
+    bool closedNow = false;
+    {
+        QMutexLocker locker(&m_mutex);
+
+        auto it = m_endpoints.find(endpoint);
+        if (it == m_endpoints.end()) {
+            return;
+        }
+
+        EndpointStats &stats = it.value();
+        if (stats.state != State::Closed) {
+            // 探测成功（或外部健康检查成功），恢复闭合并清零统计
+            stats = EndpointStats{};
+            closedNow = true;
+        } else {
+            rollWindow(stats, QDateTime::currentMSecsSinceEpoch());
+            stats.total++;
+        }
+    }
+
+    // 信号在锁外发出，避免直连槽回调重入时死锁
+    if (closedNow) {
+        emit circuitClosed(endpoint);
+    }
+}
+
+void CircuitBreaker::recordFailure(const QString &endpoint)
+{
+    bool openedNow = false;
+    {
+        QMutexLocker locker(&m_mutex);
+
+        EndpointStats &stats = m_endpoints[endpoint];
+        const qint64 now = QDateTime::currentMSecsSinceEpoch();
+
+        if (stats.state == State::HalfOpen) {
+            // 探测失败，重新打开并重计冷却
+            stats.state = State::Open;
+            stats.openedAtMs = now;
+            stats.probeInFlight = false;
+            openedNow = true;
+        } else if (stats.state == State::Closed) {
+            rollWindow(stats, now);
+            stats.total++;
+            stats.failures++;
+            if (stats.total >= MIN_SAMPLES && stats.failures * 2 >= stats.total) {
+                stats.state = State::Open;
+                stats.openedAtMs = now;
+                openedNow = true;
+            }
+        }
+        // Open状态下请求已被拦截，失败只可能来自打开前已在途
+        // 的RPC，不再重复统计
+    }
+
+    if (openedNow) {
+        qWarning() << "CircuitBreaker: 熔断打开:" << endpoint;
+        emit circuitOpened(endpoint);
+    }
+}
+
+CircuitBreaker::State CircuitBreaker::state(const QString &endpoint) const
+{
+    QMutexLocker locker(&m_mutex);
+
+    auto it = m_endpoints.constFind(endpoint);
+    if (it == m_endpoints.constEnd()) {
+        return State::Closed;
+    }
+    return it.value().state;
+}
+
+QJsonObject CircuitBreaker::snapshot() const
+{
+    QMutexLocker locker(&m_mutex);
+
+    QJsonObject result;
+    for (auto it = m_endpoints.constBegin(); it != m_endpoints.constEnd(); ++it) {
+        const EndpointStats &stats = it.value();
+        QJsonObject entry;
+        entry["state"] = stateString(stats.state);
+        entry["failures"] = stats.failures;
+        entry["total"] = stats.total;
+        result[it.key()] = entry;
+    }
+    return result;
+}
+
+void CircuitBreaker::rollWindow(EndpointStats &stats, qint64 nowMs)
+{
+    if (nowMs - stats.windowStartMs >= WINDOW_MS) {
+        stats.windowStartMs = nowMs;
+        stats.failures = 0;
+        stats.total = 0;
+    }
+}
+
+QString CircuitBreaker::stateString(State state)
+{
+    switch (state) {
+        case State::Closed:
+            return "闭合";
+        case State::Open:
+            return "打开";
+        case State::HalfOpen:
+            return "半开";
+        default:
+            return "未知";
+    }
+}
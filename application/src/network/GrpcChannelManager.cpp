@@ -0,0 +1,181 @@
+/*
+ * 文件名: GrpcChannelManager.cpp
+ * 说明: gRPC通道管理器实现
+ * 作者: 彭承康
+ * 创建时间: 2026-08-28
+ */
+#include "network/GrpcChannelManager.h"
+#include <QDateTime>
+#include <QDebug>
+#include <QRandomGenerator>
+#include <QTimer>
+
+GrpcChannelManager::GrpcChannelManager(QObject *parent)
+    : QObject(parent)
+    , m_pollTimer(nullptr)
+{
+    m_pollTimer = new QTimer(this);
+    m_pollTimer->setInterval(POLL_INTERVAL_MS);
+    connect(m_pollTimer, &QTimer::timeout, this, &GrpcChannelManager::pollChannelStates);
+
+    qDebug() << "GrpcChannelManager: 通道管理器创建完成";
+}
+
+GrpcChannelManager::~GrpcChannelManager()
+{
+    stopWatching();
+    m_channels.clear();
+}
+
+std::shared_ptr<grpc::Channel> GrpcChannelManager::channelFor(const QString &target)
+{
+    auto it = m_channels.find(target);
+    if (it != m_channels.end()) {
+        return it->channel;
+    }
+
+    // keepalive探测让空闲连接也能及时发现断链；重连退避
+    // 上下限与本类的后台监视保持一致
+    grpc::ChannelArguments args;
+    args.SetInt(GRPC_ARG_KEEPALIVE_TIME_MS, 30000);
+    args.SetInt(GRPC_ARG_KEEPALIVE_TIMEOUT_MS, 10000);
+    args.SetInt(GRPC_ARG_KEEPALIVE_PERMIT_WITHOUT_CALLS, 1);
+    args.SetInt(GRPC_ARG_HTTP2_MAX_PINGS_WITHOUT_DATA, 0);
+    args.SetInt(GRPC_ARG_INITIAL_RECONNECT_BACKOFF_MS, INITIAL_BACKOFF_MS);
+    args.SetInt(GRPC_ARG_MAX_RECONNECT_BACKOFF_MS, MAX_BACKOFF_MS);
+
+    ChannelEntry entry;
+    entry.channel = grpc::CreateCustomChannel(target.toStdString(),
+                                              grpc::InsecureChannelCredentials(),
+                                              args);
+    m_channels.insert(target, entry);
+
+    qDebug() << "GrpcChannelManager: 创建持久通道:" << target;
+    return entry.channel;
+}
+
+bool GrpcChannelManager::isReady(const QString &target) const
+{
+    auto it = m_channels.constFind(target);
+    return it != m_channels.constEnd() && it->ready;
+}
+
+void GrpcChannelManager::setReplicaTargets(const QString &service, const QStringList &targets)
+{
+    m_replicas.insert(service, targets);
+
+    // 立即为每个副本建立持久通道并纳入监视
+    for (const QString &target : targets) {
+        channelFor(target);
+    }
+
+    qDebug() << "GrpcChannelManager: 服务" << service
+             << "配置" << targets.size() << "个副本";
+}
+
+QString GrpcChannelManager::pickReplica(const QString &service, const QString &exclude)
+{
+    const QStringList targets = m_replicas.value(service);
+    if (targets.isEmpty()) {
+        return QString();
+    }
+
+    // 两轮选择：先在就绪副本中找最少未完成请求的；全部未就绪
+    // 时（启动初期或网络抖动）再不看就绪状态选一个，让gRPC的
+    // 重连逻辑有机会在这条通道上恢复
+    QString best;
+    int bestOutstanding = 0;
+    for (int pass = 0; pass < 2 && best.isEmpty(); ++pass) {
+        const bool requireReady = (pass == 0);
+        for (const QString &target : targets) {
+            if (target == exclude) {
+                continue;
+            }
+            auto it = m_channels.constFind(target);
+            if (it == m_channels.constEnd()) {
+                continue;
+            }
+            if (requireReady && !it->ready) {
+                continue;
+            }
+            if (best.isEmpty() || it->outstanding < bestOutstanding) {
+                best = target;
+                bestOutstanding = it->outstanding;
+            }
+        }
+    }
+
+    // 只有一个副本且被exclude时退回该副本，保证总能选出地址
+    if (best.isEmpty()) {
+        best = targets.first();
+    }
+    return best;
+}
+
+void GrpcChannelManager::beginCall(const QString &target)
+{
+    auto it = m_channels.find(target);
+    if (it != m_channels.end()) {
+        ++it->outstanding;
+    }
+}
+
+void GrpcChannelManager::endCall(const QString &target)
+{
+    auto it = m_channels.find(target);
+    if (it != m_channels.end() && it->outstanding > 0) {
+        --it->outstanding;
+    }
+}
+
+void GrpcChannelManager::startWatching()
+{
+    if (!m_pollTimer->isActive()) {
+        m_pollTimer->start();
+        qDebug() << "GrpcChannelManager: 开始监视通道状态";
+    }
+}
+
+void GrpcChannelManager::stopWatching()
+{
+    if (m_pollTimer && m_pollTimer->isActive()) {
+        m_pollTimer->stop();
+    }
+}
+
+void GrpcChannelManager::pollChannelStates()
+{
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+
+    for (auto it = m_channels.begin(); it != m_channels.end(); ++it) {
+        ChannelEntry &entry = it.value();
+        const grpc_connectivity_state state = entry.channel->GetState(false);
+        const bool readyNow = (state == GRPC_CHANNEL_READY);
+
+        if (readyNow != entry.ready) {
+            entry.ready = readyNow;
+            if (readyNow) {
+                entry.backoffMs = INITIAL_BACKOFF_MS;
+                entry.nextKickTime = 0;
+                qDebug() << "GrpcChannelManager: 通道就绪:" << it.key();
+                emit channelReady(it.key());
+            } else {
+                qWarning() << "GrpcChannelManager: 通道失去连接:" << it.key();
+                emit channelLost(it.key());
+            }
+        }
+
+        // 掉线通道按带抖动的指数退避触发重连：GetState(true)
+        // 请求gRPC发起连接尝试，退避由本类控制，避免所有
+        // 客户端在同一时刻同时冲击刚恢复的服务端
+        const bool needsKick = (state == GRPC_CHANNEL_IDLE ||
+                                state == GRPC_CHANNEL_TRANSIENT_FAILURE);
+        if (needsKick && now >= entry.nextKickTime) {
+            entry.channel->GetState(true);
+
+            const int jitter = QRandomGenerator::global()->bounded(entry.backoffMs / 2 + 1);
+            entry.nextKickTime = now + entry.backoffMs / 2 + jitter;
+            entry.backoffMs = qMin(entry.backoffMs * 2, MAX_BACKOFF_MS);
+        }
+    }
+}
@@ -10,6 +10,10 @@
 #include "network/NetworkManager.h"
 #include "network/AlgorithmServiceClient.h"
 #include "network/StrategyServiceClient.h"
+#include "network/CircuitBreaker.h"
+#include "network/GrpcChannelManager.h"
+#include "network/SendAggregator.h"
+#include "core/SyncedClock.h"
 #include <QTimer>
 #include <QDebug>
 
@@ -19,6 +23,8 @@ NetworkManager::NetworkManager(QObject *parent)
     , m_strategyClient(nullptr)
     , m_connectionState(ConnectionState::Disconnected)
     , m_reconnectTimer(nullptr)
+    , m_clockSyncTimer(nullptr)
+    , m_clockSyncSamplesTaken(0)
     , m_reconnectAttempts(0)
     , m_maxReconnectAttempts(5)
     , m_reconnectInterval(5000)
@@ -29,7 +35,11 @@ NetworkManager::NetworkManager(QObject *parent)
     m_reconnectTimer = new QTimer(this);
     m_reconnectTimer->setSingleShot(true);
     connect(m_reconnectTimer, &QTimer::timeout, this, &NetworkManager::attemptReconnect);
-    
+
+    // 时钟同步采样定时器：连接建立后启动（见onStrategyServiceConnected）
+    m_clockSyncTimer = new QTimer(this);
+    connect(m_clockSyncTimer, &QTimer::timeout, this, &NetworkManager::onClockSyncTick);
+
     qDebug() << "NetworkManager: 网络管理器初始化完成";
 }
 
@@ -42,20 +52,55 @@ NetworkManager::~NetworkManager()
 bool NetworkManager::initialize()
 {
     try {
+        // 创建通道管理器：持久通道由它统一持有，客户端只
+        // 复用，重连时不再重建TCP/TLS连接
+        m_channelManager = std::make_unique<GrpcChannelManager>(this);
+        connect(m_channelManager.get(), &GrpcChannelManager::channelReady,
+                this, &NetworkManager::onChannelReady);
+        connect(m_channelManager.get(), &GrpcChannelManager::channelLost,
+                this, &NetworkManager::onChannelLost);
+
+        // 创建共享熔断器：两个客户端按RPC方法统计失败率，
+        // 服务端故障时快速失败而不是每次调用都等到超时
+        m_circuitBreaker = std::make_unique<CircuitBreaker>(this);
+        connect(m_circuitBreaker.get(), &CircuitBreaker::circuitOpened,
+                this, &NetworkManager::onCircuitOpened);
+        connect(m_circuitBreaker.get(), &CircuitBreaker::circuitClosed,
+                this, &NetworkManager::onCircuitClosed);
+
+        // 算法服务地址支持逗号分隔的副本列表；首地址作为默认
+        // 通道，整个列表交给客户端做副本感知负载均衡
+        QStringList algorithmTargets;
+        for (const QString &entry : m_algorithmServiceUrl.split(',', Qt::SkipEmptyParts)) {
+            algorithmTargets.append(entry.trimmed());
+        }
+        const QString primaryAlgorithmUrl =
+            algorithmTargets.isEmpty() ? m_algorithmServiceUrl : algorithmTargets.first();
+
         // 创建算法服务客户端
         m_algorithmClient = std::make_unique<AlgorithmServiceClient>(this);
-        if (!m_algorithmClient->initialize(m_algorithmServiceUrl)) {
+        if (!m_algorithmClient->initialize(primaryAlgorithmUrl,
+                                           m_channelManager->channelFor(primaryAlgorithmUrl))) {
             qCritical() << "NetworkManager: 算法服务客户端初始化失败";
             return false;
         }
-        
+        if (algorithmTargets.size() > 1) {
+            m_algorithmClient->configureReplicas(algorithmTargets, m_channelManager.get());
+        }
+        m_algorithmClient->setCircuitBreaker(m_circuitBreaker.get());
+
         // 创建策略服务客户端
         m_strategyClient = std::make_unique<StrategyServiceClient>(this);
-        if (!m_strategyClient->initialize(m_strategyServiceUrl)) {
+        if (!m_strategyClient->initialize(m_strategyServiceUrl,
+                                          m_channelManager->channelFor(m_strategyServiceUrl))) {
             qCritical() << "NetworkManager: 策略服务客户端初始化失败";
             return false;
         }
-        
+        m_strategyClient->setCircuitBreaker(m_circuitBreaker.get());
+
+        // 创建出站消息聚合器：小消息按帧合并后经策略客户端发出
+        m_sendAggregator = std::make_unique<SendAggregator>(m_strategyClient.get(), this);
+
         // 连接客户端信号
         setupClientConnections();
         
@@ -79,7 +124,12 @@ bool NetworkManager::connectToServices()
     
     setConnectionState(ConnectionState::Connecting);
     m_reconnectAttempts = 0;
-    
+
+    // 通道管理器开始在后台监视连接状态
+    if (m_channelManager) {
+        m_channelManager->startWatching();
+    }
+
     // 异步连接算法服务
     if (m_algorithmClient) {
         m_algorithmClient->connectToService();
@@ -101,9 +151,13 @@ void NetworkManager::disconnect()
     
     qDebug() << "NetworkManager: 断开服务连接";
     
-    // 停止重连定时器
+    // 停止重连定时器、时钟采样和通道监视
     m_reconnectTimer->stop();
-    
+    m_clockSyncTimer->stop();
+    if (m_channelManager) {
+        m_channelManager->stopWatching();
+    }
+
     // 断开客户端连接
     if (m_algorithmClient) {
         m_algorithmClient->disconnect();
@@ -171,6 +225,11 @@ StrategyServiceClient* NetworkManager::getStrategyClient() const
     return m_strategyClient.get();
 }
 
+SendAggregator* NetworkManager::getSendAggregator() const
+{
+    return m_sendAggregator.get();
+}
+
 QJsonObject NetworkManager::getConnectionInfo() const
 {
     QJsonObject info;
@@ -191,7 +250,12 @@ QJsonObject NetworkManager::getConnectionInfo() const
         clientStates["strategy"] = m_strategyClient->isConnected();
     }
     info["clientStates"] = clientStates;
-    
+
+    // 各RPC endpoint的熔断状态
+    if (m_circuitBreaker) {
+        info["circuitBreaker"] = m_circuitBreaker->snapshot();
+    }
+
     return info;
 }
 
@@ -327,6 +391,50 @@ void NetworkManager::attemptReconnect()
     });
 }
 
+void NetworkManager::onChannelReady(const QString &target)
+{
+    qDebug() << "NetworkManager: 通道恢复就绪:" << target;
+
+    // 传输层恢复后立即探活对应客户端，尽快回到Connected
+    if (target == m_algorithmServiceUrl && m_algorithmClient &&
+        !m_algorithmClient->isConnected()) {
+        m_algorithmClient->connectToService();
+    }
+    if (target == m_strategyServiceUrl && m_strategyClient &&
+        !m_strategyClient->isConnected()) {
+        m_strategyClient->connectToService();
+    }
+}
+
+void NetworkManager::onChannelLost(const QString &target)
+{
+    qWarning() << "NetworkManager: 通道失去连接:" << target;
+
+    // 标记对应客户端断开；传输层重连由通道管理器按
+    // 带抖动的退避在后台驱动
+    if (target == m_algorithmServiceUrl && m_algorithmClient) {
+        m_algorithmClient->disconnect();
+    }
+    if (target == m_strategyServiceUrl && m_strategyClient) {
+        m_strategyClient->disconnect();
+    }
+}
+
+void NetworkManager::onCircuitOpened(const QString &endpoint)
+{
+    qWarning() << "NetworkManager: 熔断打开:" << endpoint;
+
+    const QString serviceName =
+        endpoint.startsWith(QStringLiteral("Algorithm")) ? QStringLiteral("Algorithm")
+                                                         : QStringLiteral("Strategy");
+    emit serviceError(serviceName, QStringLiteral("熔断打开: ") + endpoint);
+}
+
+void NetworkManager::onCircuitClosed(const QString &endpoint)
+{
+    qDebug() << "NetworkManager: 熔断恢复闭合:" << endpoint;
+}
+
 void NetworkManager::onAlgorithmServiceConnected()
 {
     qDebug() << "NetworkManager: 算法服务连接成功";
@@ -350,14 +458,38 @@ void NetworkManager::onStrategyServiceConnected()
 {
     qDebug() << "NetworkManager: 策略服务连接成功";
     checkOverallConnectionState();
+
+    // 旧连接的钟差估计不再可信；快采几次迅速收敛，再降到稳态间隔
+    SyncedClock::instance()->reset();
+    m_clockSyncSamplesTaken = 0;
+    m_clockSyncTimer->setInterval(CLOCK_SYNC_BURST_INTERVAL_MS);
+    m_clockSyncTimer->start();
+    onClockSyncTick();
 }
 
 void NetworkManager::onStrategyServiceDisconnected()
 {
     qDebug() << "NetworkManager: 策略服务连接断开";
+    m_clockSyncTimer->stop();
     checkOverallConnectionState();
 }
 
+void NetworkManager::onClockSyncTick()
+{
+    if (!m_strategyClient || !m_strategyClient->isConnected()) {
+        m_clockSyncTimer->stop();
+        return;
+    }
+
+    m_strategyClient->syncClock();
+
+    // 快采阶段结束后降到稳态间隔
+    ++m_clockSyncSamplesTaken;
+    if (m_clockSyncSamplesTaken == CLOCK_SYNC_BURST_COUNT) {
+        m_clockSyncTimer->setInterval(CLOCK_SYNC_STEADY_INTERVAL_MS);
+    }
+}
+
 void NetworkManager::onStrategyServiceError(const QString &error)
 {
     qWarning() << "NetworkManager: 策略服务错误:" << error;
@@ -0,0 +1,60 @@
+/*
+ * 文件名: SendAggregator.cpp
+ * 说明: 每帧出站消息聚合器的实现。
+ * 作者: 彭承康
+ * 创建时间: 2026-08-28
+ */
+#include "network/SendAggregator.h"
+#include "network/StrategyServiceClient.h"
+
+#include <QDebug>
+
+SendAggregator::SendAggregator(StrategyServiceClient *client, QObject *parent)
+    : QObject(parent)
+    , m_client(client)
+{
+}
+
+void SendAggregator::enqueueWorldState(const QJsonObject &worldState, bool urgent)
+{
+    // 按顶层键并入合并对象：同键后写覆盖先写，与服务端的
+    // 按键合并语义一致
+    for (auto it = worldState.constBegin(); it != worldState.constEnd(); ++it) {
+        m_pendingState.insert(it.key(), it.value());
+    }
+    ++m_pendingMessages;
+    ++m_enqueuedCount;
+
+    if (urgent) {
+        // 战斗消息不等帧末：已排队的内容搭同一个包发出
+        flushFrame();
+    }
+}
+
+int SendAggregator::flushFrame()
+{
+    if (m_pendingMessages == 0) {
+        return 0;
+    }
+
+    const int messageCount = m_pendingMessages;
+    QJsonObject request;
+    request.insert(QStringLiteral("worldState"), m_pendingState);
+
+    // 先清空再发送：同步回调里再入队的消息归入下一帧
+    m_pendingState = QJsonObject();
+    m_pendingMessages = 0;
+    m_coalescedCount += static_cast<quint64>(messageCount - 1);
+
+    if (m_client != nullptr) {
+        m_client->updateWorldState(request, [](const QJsonObject &response) {
+            if (response.value(QStringLiteral("error")).toBool()) {
+                qWarning() << "SendAggregator: 合并载荷发送失败:"
+                           << response.value(QStringLiteral("message")).toString();
+            }
+        });
+    }
+
+    emit flushed(messageCount);
+    return 1;
+}
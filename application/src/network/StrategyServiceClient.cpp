@@ -5,10 +5,77 @@
  * 创建时间: 2026-02-18
  */
 #include "network/StrategyServiceClient.h"
+#include "network/CircuitBreaker.h"
+#include "game/GameState.h"
+#include "core/SyncedClock.h"
+#include "net/GrpcCompressionPolicy.h"
 #include <QDebug>
 #include <QJsonArray>
 #include <QJsonDocument>
 
+namespace {
+
+/**
+ * @brief 构造熔断打开时的快速失败结果
+ */
+QJsonObject makeCircuitOpenError(const QString &endpoint)
+{
+    QJsonObject error;
+    error["error"] = true;
+    error["circuitOpen"] = true;
+    error["message"] = QStringLiteral("熔断打开，快速失败: ") + endpoint;
+    return error;
+}
+
+/**
+ * @brief 还原JSON指针段的转义（~1→/，~0→~）
+ */
+QString unescapePointerSegment(QString segment)
+{
+    segment.replace(QStringLiteral("~1"), QStringLiteral("/"));
+    segment.replace(QStringLiteral("~0"), QStringLiteral("~"));
+    return segment;
+}
+
+/**
+ * @brief 把RFC-6902补丁折算成只含改动键的最小状态对象
+ *
+ * 服务端UpdateWorldState按键合并，add/replace直接映射为键赋值；
+ * remove与两层以上的路径在按键合并语义下表达不了，返回false让
+ * 调用方退回完整上传。
+ *
+ * @param ops 补丁操作数组
+ * @param outState 输出的最小状态对象
+ * @return bool 是否全部操作都可折算
+ */
+bool foldPatchToMinimalState(const QJsonArray &ops, QJsonObject *outState)
+{
+    for (const QJsonValue &entry : ops) {
+        const QJsonObject op = entry.toObject();
+        if (op["op"].toString() == QStringLiteral("remove")) {
+            return false;
+        }
+        const QString path = op["path"].toString();
+        if (!path.startsWith(QLatin1Char('/'))) {
+            return false;
+        }
+        const QStringList segments = path.mid(1).split(QLatin1Char('/'));
+        if (segments.size() == 1) {
+            (*outState)[unescapePointerSegment(segments[0])] = op["value"];
+        } else if (segments.size() == 2) {
+            const QString parent = unescapePointerSegment(segments[0]);
+            QJsonObject child = (*outState)[parent].toObject();
+            child[unescapePointerSegment(segments[1])] = op["value"];
+            (*outState)[parent] = child;
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
 StrategyServiceClient::StrategyServiceClient(QObject *parent)
     : QObject(parent)
     , m_connected(false)
@@ -25,7 +92,8 @@ StrategyServiceClient::~StrategyServiceClient()
     qDebug() << "StrategyServiceClient: gRPC客户端销毁";
 }
 
-bool StrategyServiceClient::initialize(const QString &serviceUrl)
+bool StrategyServiceClient::initialize(const QString &serviceUrl,
+                                       std::shared_ptr<grpc::Channel> sharedChannel)
 {
     m_serviceUrl = serviceUrl;
 
@@ -35,14 +103,24 @@ bool StrategyServiceClient::initialize(const QString &serviceUrl)
         m_serviceUrl = m_serviceUrl.mid(8);
     }
 
-    channel_ = grpc::CreateChannel(m_serviceUrl.toStdString(),
-                                   grpc::InsecureChannelCredentials());
+    // 优先复用通道管理器的持久通道，重连不再重付建连成本
+    if (sharedChannel) {
+        channel_ = std::move(sharedChannel);
+    } else {
+        channel_ = grpc::CreateChannel(m_serviceUrl.toStdString(),
+                                       grpc::InsecureChannelCredentials());
+    }
     stub_ = strategy_proto::StrategyService::NewStub(channel_);
 
     qDebug() << "StrategyServiceClient: 初始化完成，服务地址:" << m_serviceUrl;
     return true;
 }
 
+void StrategyServiceClient::setCircuitBreaker(CircuitBreaker *breaker)
+{
+    m_breaker = breaker;
+}
+
 void StrategyServiceClient::connectToService()
 {
     if (m_connected) {
@@ -92,6 +170,13 @@ bool StrategyServiceClient::testConnection()
 
     grpc::Status status = stub_->QueryGameState(&context, request, &response);
 
+    // 健康检查不经熔断拦截，结果参与统计：服务恢复时它天然
+    // 充当半开探测，成功即让QueryGameState的熔断恢复闭合
+    if (m_breaker) {
+        status.ok() ? m_breaker->recordSuccess(QStringLiteral("Strategy.QueryGameState"))
+                    : m_breaker->recordFailure(QStringLiteral("Strategy.QueryGameState"));
+    }
+
     if (status.ok()) {
         if (!m_connected) {
             m_connected = true;
@@ -113,6 +198,12 @@ void StrategyServiceClient::getGameRules(const QJsonObject &request,
         return;
     }
 
+    const QString endpoint = QStringLiteral("Strategy.GetGameRules");
+    if (m_breaker && !m_breaker->allowRequest(endpoint)) {
+        if (callback) callback(makeCircuitOpenError(endpoint));
+        return;
+    }
+
     strategy_proto::RulesRequest grpcRequest;
     grpcRequest.set_category(request["category"].toString().toStdString());
     grpcRequest.set_active_only(request["activeOnly"].toBool(true));
@@ -125,6 +216,11 @@ void StrategyServiceClient::getGameRules(const QJsonObject &request,
 
     grpc::Status status = stub_->GetGameRules(&context, grpcRequest, &grpcResponse);
 
+    if (m_breaker) {
+        status.ok() ? m_breaker->recordSuccess(endpoint)
+                    : m_breaker->recordFailure(endpoint);
+    }
+
     if (status.ok()) {
         QJsonObject response;
         response["category"] = QString::fromStdString(grpcResponse.category());
@@ -161,6 +257,13 @@ void StrategyServiceClient::updateWorldState(const QJsonObject &request,
         return;
     }
 
+    // 与savePlayerData共用endpoint：两者落在同一个RPC方法上
+    const QString endpoint = QStringLiteral("Strategy.UpdateWorldState");
+    if (m_breaker && !m_breaker->allowRequest(endpoint)) {
+        if (callback) callback(makeCircuitOpenError(endpoint));
+        return;
+    }
+
     strategy_proto::WorldStateUpdate grpcRequest;
     QJsonDocument doc(request["worldState"].toObject());
     grpcRequest.set_world_state_json(doc.toJson(QJsonDocument::Compact).toStdString());
@@ -171,8 +274,16 @@ void StrategyServiceClient::updateWorldState(const QJsonObject &request,
         std::chrono::system_clock::now() + std::chrono::milliseconds(m_timeout);
     context.set_deadline(deadline);
 
+    // 大体量世界状态JSON按大小逐RPC启用gzip，小更新不付压缩开销
+    net::ApplyCompressionPolicy(&context, grpcRequest.ByteSizeLong());
+
     grpc::Status status = stub_->UpdateWorldState(&context, grpcRequest, &grpcResponse);
 
+    if (m_breaker) {
+        status.ok() ? m_breaker->recordSuccess(endpoint)
+                    : m_breaker->recordFailure(endpoint);
+    }
+
     if (status.ok()) {
         QJsonObject response;
         response["success"] = grpcResponse.success();
@@ -197,6 +308,12 @@ void StrategyServiceClient::triggerEvent(const QJsonObject &request,
         return;
     }
 
+    const QString endpoint = QStringLiteral("Strategy.TriggerEvent");
+    if (m_breaker && !m_breaker->allowRequest(endpoint)) {
+        if (callback) callback(makeCircuitOpenError(endpoint));
+        return;
+    }
+
     strategy_proto::EventTrigger grpcRequest;
     grpcRequest.set_event_id(request["eventId"].toInt());
 
@@ -213,6 +330,11 @@ void StrategyServiceClient::triggerEvent(const QJsonObject &request,
 
     grpc::Status status = stub_->TriggerEvent(&context, grpcRequest, &grpcResponse);
 
+    if (m_breaker) {
+        status.ok() ? m_breaker->recordSuccess(endpoint)
+                    : m_breaker->recordFailure(endpoint);
+    }
+
     if (status.ok()) {
         QJsonObject response;
         response["triggered"] = grpcResponse.triggered();
@@ -242,6 +364,13 @@ void StrategyServiceClient::getPlayerData(const QJsonObject &request,
         return;
     }
 
+    // 与queryWorldState共用endpoint：两者落在同一个RPC方法上
+    const QString endpoint = QStringLiteral("Strategy.QueryGameState");
+    if (m_breaker && !m_breaker->allowRequest(endpoint)) {
+        if (callback) callback(makeCircuitOpenError(endpoint));
+        return;
+    }
+
     strategy_proto::QueryRequest grpcRequest;
     grpcRequest.set_query_type("player");
     grpcRequest.set_entity_id(request["playerId"].toInt());
@@ -254,6 +383,11 @@ void StrategyServiceClient::getPlayerData(const QJsonObject &request,
 
     grpc::Status status = stub_->QueryGameState(&context, grpcRequest, &grpcResponse);
 
+    if (m_breaker) {
+        status.ok() ? m_breaker->recordSuccess(endpoint)
+                    : m_breaker->recordFailure(endpoint);
+    }
+
     if (status.ok()) {
         QJsonObject response;
         response["isValid"] = grpcResponse.is_valid();
@@ -270,6 +404,82 @@ void StrategyServiceClient::getPlayerData(const QJsonObject &request,
     }
 }
 
+void StrategyServiceClient::queryWorldState(std::function<void(const QJsonObject&)> callback)
+{
+    if (!stub_) {
+        qWarning() << "StrategyServiceClient: stub未初始化";
+        return;
+    }
+
+    const QString endpoint = QStringLiteral("Strategy.QueryGameState");
+    if (m_breaker && !m_breaker->allowRequest(endpoint)) {
+        if (callback) callback(makeCircuitOpenError(endpoint));
+        return;
+    }
+
+    strategy_proto::QueryRequest grpcRequest;
+    grpcRequest.set_query_type("world");
+    grpcRequest.set_delta_sync(true);
+    grpcRequest.set_known_sequence(m_worldStateSequence);
+
+    strategy_proto::GameStateResponse grpcResponse;
+    grpc::ClientContext context;
+    std::chrono::system_clock::time_point deadline =
+        std::chrono::system_clock::now() + std::chrono::milliseconds(m_timeout);
+    context.set_deadline(deadline);
+
+    grpc::Status status = stub_->QueryGameState(&context, grpcRequest, &grpcResponse);
+
+    if (m_breaker) {
+        status.ok() ? m_breaker->recordSuccess(endpoint)
+                    : m_breaker->recordFailure(endpoint);
+    }
+
+    if (!status.ok()) {
+        qWarning() << "StrategyServiceClient: queryWorldState失败:" << QString::fromStdString(status.error_message());
+        if (callback) {
+            QJsonObject errorResponse;
+            errorResponse["error"] = true;
+            errorResponse["message"] = QString::fromStdString(status.error_message());
+            callback(errorResponse);
+        }
+        return;
+    }
+
+    m_worldStateSequence = grpcResponse.sequence();
+
+    // 稳态: 服务端无变化，直接回放缓存，零解析成本
+    if (grpcResponse.up_to_date()) {
+        if (callback) callback(m_worldStateCache);
+        return;
+    }
+
+    // 少量变更: 仅合并变更键，免去整份状态文档的解析
+    if (grpcResponse.changes_size() > 0) {
+        QJsonObject globalVars = m_worldStateCache["global_variables"].toObject();
+        QJsonObject worldFlags = m_worldStateCache["world_flags"].toObject();
+        for (int i = 0; i < grpcResponse.changes_size(); ++i) {
+            const auto &change = grpcResponse.changes(i);
+            const QString key = QString::fromStdString(change.key());
+            if (change.value_case() == strategy_proto::StateChange::kBoolValue) {
+                worldFlags[key] = change.bool_value();
+            } else {
+                globalVars[key] = change.int_value();
+            }
+        }
+        m_worldStateCache["global_variables"] = globalVars;
+        m_worldStateCache["world_flags"] = worldFlags;
+        if (callback) callback(m_worldStateCache);
+        return;
+    }
+
+    // 全量回退: 无基线或序号差距过大，重建本地缓存
+    QJsonDocument doc = QJsonDocument::fromJson(
+        QByteArray::fromStdString(grpcResponse.state_json()));
+    m_worldStateCache = doc.object();
+    if (callback) callback(m_worldStateCache);
+}
+
 void StrategyServiceClient::savePlayerData(const QJsonObject &request,
                                          std::function<void(const QJsonObject&)> callback)
 {
@@ -278,6 +488,13 @@ void StrategyServiceClient::savePlayerData(const QJsonObject &request,
         return;
     }
 
+    // 与updateWorldState共用endpoint：两者落在同一个RPC方法上
+    const QString endpoint = QStringLiteral("Strategy.UpdateWorldState");
+    if (m_breaker && !m_breaker->allowRequest(endpoint)) {
+        if (callback) callback(makeCircuitOpenError(endpoint));
+        return;
+    }
+
     strategy_proto::WorldStateUpdate grpcRequest;
     QJsonDocument doc(request);
     grpcRequest.set_world_state_json(doc.toJson(QJsonDocument::Compact).toStdString());
@@ -288,8 +505,16 @@ void StrategyServiceClient::savePlayerData(const QJsonObject &request,
         std::chrono::system_clock::now() + std::chrono::milliseconds(m_timeout);
     context.set_deadline(deadline);
 
+    // 完整存档JSON通常超过压缩阈值，按大小逐RPC启用gzip
+    net::ApplyCompressionPolicy(&context, grpcRequest.ByteSizeLong());
+
     grpc::Status status = stub_->UpdateWorldState(&context, grpcRequest, &grpcResponse);
 
+    if (m_breaker) {
+        status.ok() ? m_breaker->recordSuccess(endpoint)
+                    : m_breaker->recordFailure(endpoint);
+    }
+
     if (status.ok()) {
         QJsonObject response;
         response["success"] = grpcResponse.success();
@@ -306,6 +531,119 @@ void StrategyServiceClient::savePlayerData(const QJsonObject &request,
     }
 }
 
+void StrategyServiceClient::syncGameState(GameState *gameState,
+                                        std::function<void(const QJsonObject&)> callback)
+{
+    if (!gameState) {
+        qWarning() << "StrategyServiceClient: syncGameState收到空gameState";
+        return;
+    }
+
+    QJsonObject worldState;
+    quint64 coveredVersion = 0;
+    bool patchServed = false;
+
+    QJsonArray ops;
+    if (m_stateSyncVersion > 0 &&
+        gameState->patchSince(m_stateSyncVersion, &ops, &coveredVersion)) {
+        if (ops.isEmpty()) {
+            // 本地无改动：零RPC负载直接回执
+            if (callback) {
+                QJsonObject response;
+                response["success"] = true;
+                response["message"] = QStringLiteral("up_to_date");
+                callback(response);
+            }
+            return;
+        }
+        patchServed = foldPatchToMinimalState(ops, &worldState);
+        if (!patchServed) {
+            worldState = QJsonObject();
+        }
+    }
+
+    if (!patchServed) {
+        // 首次上传、日志无法服务或补丁含删除操作: 退回完整状态
+        worldState = gameState->toJson();
+        coveredVersion = gameState->stateVersion();
+    }
+
+    QJsonObject request;
+    request["worldState"] = worldState;
+
+    // updateWorldState为同步阻塞调用，回调在本线程立即执行，
+    // 捕获this安全；上传成功后才推进版本，失败改动随下次重传
+    updateWorldState(request, [this, coveredVersion, callback](const QJsonObject &response) {
+        if (response["success"].toBool()) {
+            m_stateSyncVersion = coveredVersion;
+        }
+        if (callback) {
+            callback(response);
+        }
+    });
+}
+
+/**
+ * @brief 时钟同步采样
+ * @param callback 可选结果回调
+ *
+ * NTP四时刻交换：t0/t3取SyncedClock稳定时基，t1/t2来自服务端。
+ * 样本在本方法内直接喂入SyncedClock，调用方无需处理任何时间数学。
+ */
+void StrategyServiceClient::syncClock(std::function<void(const QJsonObject&)> callback)
+{
+    if (!stub_) {
+        qWarning() << "StrategyServiceClient: stub未初始化";
+        return;
+    }
+
+    const QString endpoint = QStringLiteral("Strategy.SyncTime");
+    if (m_breaker && !m_breaker->allowRequest(endpoint)) {
+        if (callback) callback(makeCircuitOpenError(endpoint));
+        return;
+    }
+
+    SyncedClock *clock = SyncedClock::instance();
+    const qint64 t0 = clock->localSteadyMs();
+
+    strategy_proto::TimeSyncRequest grpcRequest;
+    grpcRequest.set_client_send_ms(t0);
+
+    strategy_proto::TimeSyncResponse grpcResponse;
+    grpc::ClientContext context;
+    std::chrono::system_clock::time_point deadline =
+        std::chrono::system_clock::now() + std::chrono::milliseconds(m_timeout);
+    context.set_deadline(deadline);
+
+    grpc::Status status = stub_->SyncTime(&context, grpcRequest, &grpcResponse);
+    const qint64 t3 = clock->localSteadyMs();
+
+    if (m_breaker) {
+        status.ok() ? m_breaker->recordSuccess(endpoint)
+                    : m_breaker->recordFailure(endpoint);
+    }
+
+    if (status.ok()) {
+        clock->addExchangeSample(t0, grpcResponse.server_receive_ms(),
+                                 grpcResponse.server_send_ms(), t3);
+        if (callback) {
+            QJsonObject response;
+            response["offsetMs"] = static_cast<qint64>(
+                clock->serverNowMs() - clock->localSteadyMs());
+            response["rttMs"] = clock->lastRttMs();
+            callback(response);
+        }
+    } else {
+        qWarning() << "StrategyServiceClient: syncClock失败:" << QString::fromStdString(status.error_message());
+        if (callback) {
+            QJsonObject errorResponse;
+            errorResponse["error"] = true;
+            errorResponse["message"] = QString::fromStdString(status.error_message());
+            callback(errorResponse);
+        }
+    }
+}
+
 void StrategyServiceClient::setTimeout(int timeoutMs)
 {
     m_timeout = qMax(1000, timeoutMs);
@@ -350,3 +688,70 @@ QJsonObject StrategyServiceClient::createEventRequest(const QString &eventId, co
     request["params"] = params;
     return request;
 }
+
+// ==================== 协程接口 ====================
+
+namespace {
+
+/**
+ * @brief 构造stub未初始化的错误结果
+ */
+QJsonObject makeStubNotReadyError()
+{
+    QJsonObject error;
+    error["error"] = true;
+    error["message"] = QStringLiteral("gRPC stub未初始化");
+    return error;
+}
+
+} // namespace
+
+net::RpcCall StrategyServiceClient::getGameRules(const QJsonObject &request)
+{
+    if (!stub_) {
+        return net::RpcCall::immediate(makeStubNotReadyError());
+    }
+    return net::RpcCall(this, [this, request](net::RpcCall::Reply done) {
+        getGameRules(request, std::move(done));
+    });
+}
+
+net::RpcCall StrategyServiceClient::updateWorldState(const QJsonObject &request)
+{
+    if (!stub_) {
+        return net::RpcCall::immediate(makeStubNotReadyError());
+    }
+    return net::RpcCall(this, [this, request](net::RpcCall::Reply done) {
+        updateWorldState(request, std::move(done));
+    });
+}
+
+net::RpcCall StrategyServiceClient::triggerEvent(const QJsonObject &request)
+{
+    if (!stub_) {
+        return net::RpcCall::immediate(makeStubNotReadyError());
+    }
+    return net::RpcCall(this, [this, request](net::RpcCall::Reply done) {
+        triggerEvent(request, std::move(done));
+    });
+}
+
+net::RpcCall StrategyServiceClient::getPlayerData(const QJsonObject &request)
+{
+    if (!stub_) {
+        return net::RpcCall::immediate(makeStubNotReadyError());
+    }
+    return net::RpcCall(this, [this, request](net::RpcCall::Reply done) {
+        getPlayerData(request, std::move(done));
+    });
+}
+
+net::RpcCall StrategyServiceClient::savePlayerData(const QJsonObject &request)
+{
+    if (!stub_) {
+        return net::RpcCall::immediate(makeStubNotReadyError());
+    }
+    return net::RpcCall(this, [this, request](net::RpcCall::Reply done) {
+        savePlayerData(request, std::move(done));
+    });
+}
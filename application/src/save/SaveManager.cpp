@@ -11,16 +11,108 @@
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QJsonArray>
+#include <QDataStream>
 #include <QFile>
+#include <QFileInfo>
 #include <QDir>
 #include <QStandardPaths>
 #include <QDateTime>
+#include <QDeadlineTimer>
 #include <QDebug>
+#include <QMutexLocker>
+#include <utility>
+
+#if defined(Q_OS_WIN)
+#include <qt_windows.h>
+#include <io.h>
+#else
+#include <cstdio>
+#include <unistd.h>
+#endif
+
+namespace {
+
+// 补丁文件中RFC-6902记录的段名；@前缀与真实段名（"player"、
+// "gameState"）区分，旧版补丁文件里不会出现
+const QString kJsonPatchRecord = QStringLiteral("@jsonPatch");
+
+/**
+ * @brief 把文件缓冲一路刷到磁盘
+ *
+ * flush清空Qt层缓冲后对底层文件描述符做fsync，确保内容在
+ * rename切换前已持久化。失败时调用方应放弃本次替换。
+ */
+bool syncToDisk(QFile &file)
+{
+    if (!file.flush()) {
+        return false;
+    }
+#if defined(Q_OS_WIN)
+    return ::FlushFileBuffers(
+               reinterpret_cast<HANDLE>(::_get_osfhandle(file.handle()))) != 0;
+#else
+    return ::fsync(file.handle()) == 0;
+#endif
+}
+
+/**
+ * @brief 原子改名覆盖已存在的目标文件
+ *
+ * POSIX的rename本身即覆盖语义；Windows需要
+ * MOVEFILE_REPLACE_EXISTING。两个路径必须在同一目录。
+ */
+bool renameOverExisting(const QString &tempPath, const QString &targetPath)
+{
+#if defined(Q_OS_WIN)
+    return ::MoveFileExW(reinterpret_cast<const wchar_t *>(tempPath.utf16()),
+                         reinterpret_cast<const wchar_t *>(targetPath.utf16()),
+                         MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+#else
+    return ::rename(QFile::encodeName(tempPath).constData(),
+                    QFile::encodeName(targetPath).constData()) == 0;
+#endif
+}
+
+/**
+ * @brief 第generation代滚动备份的路径（1为最新）
+ */
+QString backupPathFor(const QString &path, int generation)
+{
+    return QString("%1.bak%2").arg(path).arg(generation);
+}
+
+} // namespace
 
 SaveManager::SaveManager(QObject *parent)
     : QObject(parent)
 {
     initializeSaveDirectory();
+
+    // 扫描线程经队列连接发射SaveInfo，需要注册元类型
+    qRegisterMetaType<SaveInfo>("SaveInfo");
+
+    // 单一后台写线程：保证补丁记录的追加顺序与提交顺序一致
+    m_patchWriter = std::thread(&SaveManager::patchWriterLoop, this);
+}
+
+SaveManager::~SaveManager()
+{
+    // 先停扫描线程：它只读存档，不需要等队列
+    m_scanStopping.store(true);
+    if (m_scanThread.joinable()) {
+        m_scanThread.join();
+    }
+
+    {
+        QMutexLocker locker(&m_patchMutex);
+        m_writerStopping = true;
+        m_patchCondition.wakeAll();
+    }
+
+    // 等待队列中剩余的补丁落盘
+    if (m_patchWriter.joinable()) {
+        m_patchWriter.join();
+    }
 }
 
 bool SaveManager::saveGame(int slot, const Player *player, const GameState *gameState)
@@ -50,25 +142,26 @@ bool SaveManager::saveGame(int slot, const Player *player, const GameState *game
     // 使用GameState自带的序列化
     saveData["gameState"] = gameState->toJson();
 
-    // 写入文件
-    QString savePath = getSavePath(slot);
-    QFile file(savePath);
-
-    if (!file.open(QIODevice::WriteOnly)) {
-        qWarning() << "SaveManager: 无法创建存档文件:" << savePath;
+    // 写入二进制存档
+    if (!writeBinarySave(getBinarySavePath(slot), buildSections(saveData))) {
+        qWarning() << "SaveManager: 无法写入存档文件:" << getBinarySavePath(slot);
         return false;
     }
 
-    QJsonDocument doc(saveData);
-    file.write(doc.toJson());
-    file.close();
+    // 完整存档就是新基线，旧的段补丁和旧版JSON存档作废
+    QFile::remove(getPatchPath(slot));
+    QFile::remove(getSavePath(slot));
+    m_patchBaseVersion.insert(slot, gameState->stateVersion());
+
+    // 旁路索引同步更新，存档列表无需再打开这个文件
+    refreshIndexEntry(slot);
 
     qDebug() << "SaveManager: 游戏保存成功，槽位:" << slot;
     emit gameSaved(slot);
     return true;
 }
 
-bool SaveManager::loadGame(int slot, Player *player, GameState *gameState)
+bool SaveManager::autoSave(int slot, const Player *player, GameState *gameState)
 {
     if (slot < 0 || slot >= MAX_SAVE_SLOTS) {
         qWarning() << "SaveManager: 无效的存档槽位:" << slot;
@@ -80,46 +173,126 @@ bool SaveManager::loadGame(int slot, Player *player, GameState *gameState)
         return false;
     }
 
-    QString savePath = getSavePath(slot);
-    QFile file(savePath);
+    // 取出并清空脏段，返回后新产生的修改留给下一次自动存档
+    const quint32 dirty = gameState->takeDirtySections();
+    if (dirty == 0) {
+        return true; // 无修改，零IO
+    }
 
-    if (!file.exists()) {
-        qWarning() << "SaveManager: 存档文件不存在:" << savePath;
-        return false;
+    // 主线程只做浅快照：QJsonObject隐式共享，拷贝是O(1)，
+    // 序列化和压缩全部推给写线程
+    PatchJob job;
+    job.slot = slot;
+    job.sections.append(qMakePair(QStringLiteral("player"), player->toJson()));
+
+    // 变更日志能服务基线版本时生成RFC-6902补丁：只含实际改动的
+    // 键，同键多次修改折叠为一条
+    bool journalServed = false;
+    if (m_patchBaseVersion.contains(slot)) {
+        QJsonArray ops;
+        quint64 coveredVersion = 0;
+        if (gameState->patchSince(m_patchBaseVersion.value(slot), &ops, &coveredVersion)) {
+            job.patchOps = ops;
+            m_patchBaseVersion.insert(slot, coveredVersion);
+            journalServed = true;
+        }
     }
 
-    if (!file.open(QIODevice::ReadOnly)) {
-        qWarning() << "SaveManager: 无法打开存档文件:" << savePath;
-        return false;
+    // 回退路径：基线未知（本进程尚未对该槽位写过快照）或日志
+    // 窗口服务不了基线版本，退回段快照
+    if (!journalServed) {
+        using SaveSection = GameState::SaveSection;
+        const SaveSection gameSections[] = {
+            SaveSection::PlayerStats, SaveSection::Progress, SaveSection::StateData
+        };
+        for (SaveSection section : gameSections) {
+            if (dirty & static_cast<quint32>(section)) {
+                job.sections.append(qMakePair(QStringLiteral("gameState"),
+                                              gameState->sectionToJson(section)));
+            }
+        }
+        m_patchBaseVersion.insert(slot, gameState->stateVersion());
     }
 
-    QByteArray data = file.readAll();
-    file.close();
+    {
+        QMutexLocker locker(&m_patchMutex);
+        m_patchQueue.enqueue(std::move(job));
+        m_patchCondition.wakeOne();
+    }
 
-    QJsonParseError error;
-    QJsonDocument doc = QJsonDocument::fromJson(data, &error);
+    return true;
+}
 
-    if (error.error != QJsonParseError::NoError) {
-        qWarning() << "SaveManager: 存档文件JSON解析错误:" << error.errorString();
+bool SaveManager::loadGame(int slot, Player *player, GameState *gameState)
+{
+    if (slot < 0 || slot >= MAX_SAVE_SLOTS) {
+        qWarning() << "SaveManager: 无效的存档槽位:" << slot;
         return false;
     }
 
-    QJsonObject saveData = doc.object();
+    if (!player || !gameState) {
+        qWarning() << "SaveManager: 玩家或游戏状态为空";
+        return false;
+    }
+
+    // 旧版JSON存档首次加载时透明迁移为二进制格式
+    if (!QFile::exists(getBinarySavePath(slot)) && QFile::exists(getSavePath(slot))) {
+        if (!migrateLegacySave(slot)) {
+            qWarning() << "SaveManager: 旧版存档迁移失败，槽位:" << slot;
+            return false;
+        }
+    }
+
+    const QStringList wanted = {QStringLiteral("metadata"), QStringLiteral("player"),
+                                QStringLiteral("gameState")};
+    QHash<QString, QJsonObject> sections =
+        readBinarySections(getBinarySavePath(slot), wanted);
+
+    if (sections.isEmpty()) {
+        qWarning() << "SaveManager: 存档文件不存在或损坏:" << getBinarySavePath(slot);
+
+        // 主存档损坏时按代回退到滚动备份，优先最新一代
+        for (int generation = 1;
+             generation <= BACKUP_GENERATIONS && sections.isEmpty(); ++generation) {
+            const QString backup = backupPathFor(getBinarySavePath(slot), generation);
+            if (!QFile::exists(backup)) {
+                continue;
+            }
+            sections = readBinarySections(backup, wanted);
+            if (!sections.isEmpty()) {
+                qWarning() << "SaveManager: 已从滚动备份恢复存档:" << backup;
+            }
+        }
+        if (sections.isEmpty()) {
+            return false;
+        }
+    }
 
     // 验证存档版本
-    QJsonObject metadata = saveData["metadata"].toObject();
+    QJsonObject metadata = sections.value(QStringLiteral("metadata"));
     QString version = metadata["version"].toString();
     if (version != "1.0.0") {
         qWarning() << "SaveManager: 不支持的存档版本:" << version;
         return false;
     }
 
+    QJsonObject saveData;
+    saveData["metadata"] = metadata;
+    saveData["player"] = sections.value(QStringLiteral("player"));
+    saveData["gameState"] = sections.value(QStringLiteral("gameState"));
+
+    // 把自动存档产生的段补丁合并到基线存档之上
+    applyPatches(slot, saveData);
+
     // 使用Player自带的反序列化
     player->loadFromJson(saveData["player"].toObject());
 
     // 使用GameState自带的反序列化
     gameState->loadFromJson(saveData["gameState"].toObject());
 
+    // 批量加载使变更日志失效，旧基线版本不再可服务
+    m_patchBaseVersion.remove(slot);
+
     qDebug() << "SaveManager: 游戏加载成功，槽位:" << slot;
     emit gameLoaded(slot);
     return true;
@@ -132,22 +305,35 @@ bool SaveManager::deleteSave(int slot)
         return false;
     }
     
-    QString savePath = getSavePath(slot);
-    QFile file(savePath);
-    
-    if (!file.exists()) {
-        qDebug() << "SaveManager: 存档文件不存在，无需删除:" << savePath;
+    if (!hasSave(slot)) {
+        qDebug() << "SaveManager: 存档文件不存在，无需删除，槽位:" << slot;
         return true;
     }
-    
-    bool success = file.remove();
+
+    bool success = true;
+    if (QFile::exists(getBinarySavePath(slot))) {
+        success = QFile::remove(getBinarySavePath(slot)) && success;
+    }
+    if (QFile::exists(getSavePath(slot))) {
+        success = QFile::remove(getSavePath(slot)) && success;
+    }
+    QFile::remove(getPatchPath(slot));
+    m_patchBaseVersion.remove(slot);
+
+    // 滚动备份和可能残留的临时文件一并清理
+    for (int generation = 1; generation <= BACKUP_GENERATIONS; ++generation) {
+        QFile::remove(backupPathFor(getBinarySavePath(slot), generation));
+    }
+    QFile::remove(getBinarySavePath(slot) + QStringLiteral(".tmp"));
+
     if (success) {
+        refreshIndexEntry(slot);
         qDebug() << "SaveManager: 存档删除成功，槽位:" << slot;
         emit saveDeleted(slot);
     } else {
         qWarning() << "SaveManager: 存档删除失败，槽位:" << slot;
     }
-    
+
     return success;
 }
 
@@ -157,8 +343,7 @@ bool SaveManager::hasSave(int slot) const
         return false;
     }
     
-    QString savePath = getSavePath(slot);
-    return QFile::exists(savePath);
+    return QFile::exists(getBinarySavePath(slot)) || QFile::exists(getSavePath(slot));
 }
 
 SaveInfo SaveManager::getSaveInfo(int slot) const
@@ -171,32 +356,48 @@ SaveInfo SaveManager::getSaveInfo(int slot) const
         return info;
     }
     
-    QString savePath = getSavePath(slot);
-    QFile file(savePath);
-    
-    if (!file.exists()) {
+    // 二进制存档：部分读取，只解压小的summary段
+    if (QFile::exists(getBinarySavePath(slot))) {
+        const QHash<QString, QJsonObject> sections = readBinarySections(
+            getBinarySavePath(slot), {QStringLiteral("summary")});
+        const QJsonObject summary = sections.value(QStringLiteral("summary"));
+
+        if (!summary.isEmpty()) {
+            info.exists = true;
+            info.timestamp = QDateTime::fromString(summary["timestamp"].toString(), Qt::ISODate);
+            info.playerName = summary["playerName"].toString();
+            info.playerLevel = summary["playerLevel"].toInt();
+            info.profession = static_cast<PlayerProfession>(summary["profession"].toInt());
+            info.currentChapter = summary["currentChapter"].toInt();
+            info.gameProgress = summary["gameProgress"].toInt();
+        }
         return info;
     }
-    
-    if (!file.open(QIODevice::ReadOnly)) {
+
+    // 旧版JSON存档（尚未迁移）
+    QFile file(getSavePath(slot));
+
+    if (!file.exists() || !file.open(QIODevice::ReadOnly)) {
         return info;
     }
-    
+
     QByteArray data = file.readAll();
     file.close();
-    
+
     QJsonParseError error;
     QJsonDocument doc = QJsonDocument::fromJson(data, &error);
-    
+
     if (error.error != QJsonParseError::NoError) {
         return info;
     }
-    
+
     QJsonObject saveData = doc.object();
+    applyPatches(slot, saveData);
+
     QJsonObject metadata = saveData["metadata"].toObject();
     QJsonObject playerData = saveData["player"].toObject();
     QJsonObject gameStateData = saveData["gameState"].toObject();
-    
+
     info.exists = true;
     info.timestamp = QDateTime::fromString(metadata["timestamp"].toString(), Qt::ISODate);
     info.playerName = playerData["name"].toString();
@@ -204,7 +405,7 @@ SaveInfo SaveManager::getSaveInfo(int slot) const
     info.profession = static_cast<PlayerProfession>(playerData["profession"].toInt());
     info.currentChapter = gameStateData["currentChapter"].toInt();
     info.gameProgress = gameStateData["gameProgress"].toInt();
-    
+
     return info;
 }
 
@@ -236,4 +437,576 @@ QString SaveManager::getSavePath(int slot) const
     QString saveDir = QStandardPaths::writableLocation(QStandardPaths::DocumentsLocation);
     saveDir += "/FantasyLegend/Saves";
     return QString("%1/save_%2.json").arg(saveDir).arg(slot);
+}
+
+QString SaveManager::getPatchPath(int slot) const
+{
+    QString saveDir = QStandardPaths::writableLocation(QStandardPaths::DocumentsLocation);
+    saveDir += "/FantasyLegend/Saves";
+    return QString("%1/save_%2.patch").arg(saveDir).arg(slot);
+}
+
+QString SaveManager::getBinarySavePath(int slot) const
+{
+    QString saveDir = QStandardPaths::writableLocation(QStandardPaths::DocumentsLocation);
+    saveDir += "/FantasyLegend/Saves";
+    return QString("%1/save_%2.flsv").arg(saveDir).arg(slot);
+}
+
+QVector<QPair<QString, QJsonObject>> SaveManager::buildSections(const QJsonObject &saveData)
+{
+    const QJsonObject metadata = saveData["metadata"].toObject();
+    const QJsonObject playerData = saveData["player"].toObject();
+    const QJsonObject gameStateData = saveData["gameState"].toObject();
+
+    // summary段冗余存储存档列表需要的少量字段，
+    // getSaveInfo只解压这一段，不碰大的player/gameState段
+    QJsonObject summary;
+    summary["timestamp"] = metadata["timestamp"];
+    summary["playerName"] = playerData["name"];
+    summary["playerLevel"] = playerData["level"];
+    summary["profession"] = playerData["profession"];
+    summary["currentChapter"] = gameStateData["currentChapter"];
+    summary["gameProgress"] = gameStateData["gameProgress"];
+
+    QVector<QPair<QString, QJsonObject>> sections;
+    sections.append(qMakePair(QStringLiteral("metadata"), metadata));
+    sections.append(qMakePair(QStringLiteral("summary"), summary));
+    sections.append(qMakePair(QStringLiteral("player"), playerData));
+    sections.append(qMakePair(QStringLiteral("gameState"), gameStateData));
+    return sections;
+}
+
+bool SaveManager::writeBinarySave(const QString &path,
+                                  const QVector<QPair<QString, QJsonObject>> &sections) const
+{
+    // 原子替换：完整内容先写到同目录的临时文件，fsync后一次
+    // rename切换。写到一半崩溃只会留下临时文件，目标路径上
+    // 要么是完整的旧存档，要么是完整的新存档
+    const QString tempPath = path + QStringLiteral(".tmp");
+    QFile file(tempPath);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        return false;
+    }
+
+    // 逐段压缩载荷
+    QVector<QByteArray> payloads;
+    QVector<quint64> originalSizes;
+    payloads.reserve(sections.size());
+    originalSizes.reserve(sections.size());
+    for (const auto &section : sections) {
+        const QByteArray raw = QJsonDocument(section.second).toJson(QJsonDocument::Compact);
+        originalSizes.append(static_cast<quint64>(raw.size()));
+        payloads.append(qCompress(raw));
+    }
+
+    QDataStream stream(&file);
+    stream.setVersion(QDataStream::Qt_6_0);
+
+    // 文件头 + 段索引（段名、压缩长度、原始长度）。载荷按索引
+    // 顺序紧随其后，读取方累加压缩长度即可定位任意段
+    stream << SAVE_MAGIC << SAVE_FORMAT_VERSION
+           << static_cast<quint32>(sections.size());
+    for (int i = 0; i < sections.size(); ++i) {
+        stream << sections[i].first
+               << static_cast<quint64>(payloads[i].size())
+               << originalSizes[i];
+    }
+    for (const QByteArray &payload : payloads) {
+        stream.writeRawData(payload.constData(), payload.size());
+    }
+
+    if (stream.status() != QDataStream::Ok || !syncToDisk(file)) {
+        file.close();
+        QFile::remove(tempPath);
+        return false;
+    }
+    file.close();
+
+    // 被替换的上一代基线降级为滚动备份后再切换新文件
+    rotateBackups(path);
+
+    if (!renameOverExisting(tempPath, path)) {
+        QFile::remove(tempPath);
+        return false;
+    }
+    return true;
+}
+
+void SaveManager::rotateBackups(const QString &path) const
+{
+    if (!QFile::exists(path)) {
+        return;
+    }
+
+    // 从最旧一代开始腾位：bak(N-1)→bak(N)，当前文件→bak1。
+    // 备份轮换本身不要求原子——任一步失败最多少一代备份，
+    // 主存档路径不受影响
+    QFile::remove(backupPathFor(path, BACKUP_GENERATIONS));
+    for (int generation = BACKUP_GENERATIONS - 1; generation >= 1; --generation) {
+        const QString from = backupPathFor(path, generation);
+        if (QFile::exists(from)) {
+            QFile::rename(from, backupPathFor(path, generation + 1));
+        }
+    }
+    QFile::rename(path, backupPathFor(path, 1));
+}
+
+QHash<QString, QJsonObject> SaveManager::readBinarySections(const QString &path,
+                                                            const QStringList &wanted) const
+{
+    QHash<QString, QJsonObject> result;
+
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return result;
+    }
+
+    QDataStream stream(&file);
+    stream.setVersion(QDataStream::Qt_6_0);
+
+    quint32 magic = 0;
+    quint32 formatVersion = 0;
+    quint32 sectionCount = 0;
+    stream >> magic >> formatVersion >> sectionCount;
+
+    if (stream.status() != QDataStream::Ok || magic != SAVE_MAGIC) {
+        qWarning() << "SaveManager: 非法的存档文件:" << path;
+        return result;
+    }
+    if (formatVersion > SAVE_FORMAT_VERSION) {
+        qWarning() << "SaveManager: 不支持的存档格式版本:" << formatVersion;
+        return result;
+    }
+
+    struct IndexEntry {
+        QString name;
+        quint64 compressedSize = 0;
+    };
+    QVector<IndexEntry> index;
+    index.reserve(static_cast<int>(sectionCount));
+    for (quint32 i = 0; i < sectionCount; ++i) {
+        IndexEntry entry;
+        quint64 originalSize = 0;
+        stream >> entry.name >> entry.compressedSize >> originalSize;
+        if (stream.status() != QDataStream::Ok) {
+            qWarning() << "SaveManager: 存档索引损坏:" << path;
+            return result;
+        }
+        index.append(entry);
+    }
+
+    // 部分读取：跳过不需要的段，只解压wanted中的段
+    qint64 offset = file.pos();
+    for (const IndexEntry &entry : index) {
+        const bool isWanted = wanted.isEmpty() || wanted.contains(entry.name);
+        if (isWanted) {
+            if (!file.seek(offset)) {
+                break;
+            }
+            const QByteArray payload = file.read(static_cast<qint64>(entry.compressedSize));
+            const QJsonDocument doc = QJsonDocument::fromJson(qUncompress(payload));
+            if (doc.isObject()) {
+                result.insert(entry.name, doc.object());
+            }
+        }
+        offset += static_cast<qint64>(entry.compressedSize);
+    }
+
+    file.close();
+    return result;
+}
+
+bool SaveManager::migrateLegacySave(int slot)
+{
+    QFile file(getSavePath(slot));
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    const QByteArray data = file.readAll();
+    file.close();
+
+    QJsonParseError error;
+    const QJsonDocument doc = QJsonDocument::fromJson(data, &error);
+    if (error.error != QJsonParseError::NoError || !doc.isObject()) {
+        qWarning() << "SaveManager: 旧版存档解析失败:" << error.errorString();
+        return false;
+    }
+
+    QJsonObject saveData = doc.object();
+
+    // 已有的段补丁折算进新基线
+    applyPatches(slot, saveData);
+
+    if (!writeBinarySave(getBinarySavePath(slot), buildSections(saveData))) {
+        return false;
+    }
+
+    // 迁移成功后才移除旧文件
+    QFile::remove(getSavePath(slot));
+    QFile::remove(getPatchPath(slot));
+
+    refreshIndexEntry(slot);
+
+    qDebug() << "SaveManager: 旧版JSON存档已迁移为二进制格式，槽位:" << slot;
+    return true;
+}
+
+void SaveManager::patchWriterLoop()
+{
+    for (;;) {
+        QVector<PatchJob> batch;
+        {
+            QMutexLocker locker(&m_patchMutex);
+            while (m_patchQueue.isEmpty() && !m_writerStopping) {
+                m_patchCondition.wait(&m_patchMutex);
+            }
+            if (m_patchQueue.isEmpty() && m_writerStopping) {
+                return; // 队列已清空，允许退出
+            }
+
+            // 组提交窗口：自动存档与任务检查点经常背靠背触发，
+            // 取到首个任务后多等几毫秒关门，把它们并入同一批。
+            // 新任务入队会提前唤醒，继续把窗口剩余时间等完
+            if (!m_writerStopping) {
+                QDeadlineTimer deadline(GROUP_COMMIT_WINDOW_MS);
+                while (!m_writerStopping && !deadline.hasExpired()) {
+                    m_patchCondition.wait(&m_patchMutex, QDeadlineTimer(deadline));
+                }
+            }
+
+            batch.reserve(m_patchQueue.size());
+            while (!m_patchQueue.isEmpty()) {
+                batch.append(m_patchQueue.dequeue());
+            }
+        }
+
+        // 按槽位分组，组内保持提交顺序；槽位间沿用首次出现的
+        // 顺序，每组一次追加写和一次fsync
+        QVector<int> slotOrder;
+        QHash<int, QVector<PatchJob>> bySlot;
+        for (PatchJob &job : batch) {
+            const int slot = job.slot;
+            if (!bySlot.contains(slot)) {
+                slotOrder.append(slot);
+            }
+            bySlot[slot].append(std::move(job));
+        }
+
+        for (int slot : slotOrder) {
+            const QVector<PatchJob> &jobs = bySlot[slot];
+            const bool success = appendPatchBatch(slot, jobs);
+            if (!success) {
+                qWarning() << "SaveManager: 增量存档写入失败，槽位:" << slot;
+            } else {
+                // 补丁改变了文件指纹，索引条目同步刷新，
+                // 否则下次扫描会把该槽位当作外部改动重建
+                refreshIndexEntry(slot);
+            }
+
+            // 跨线程信号，自动队列连接投递回主线程；合批不改变
+            // 对外契约，每个任务仍各自收到一次完成通知
+            for (int i = 0; i < jobs.size(); ++i) {
+                emit autoSaveCompleted(slot, success);
+            }
+        }
+    }
+}
+
+bool SaveManager::appendPatchBatch(int slot, const QVector<PatchJob> &jobs)
+{
+    QFile file(getPatchPath(slot));
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Append)) {
+        return false;
+    }
+
+    QDataStream stream(&file);
+    stream.setVersion(QDataStream::Qt_6_0);
+
+    // 每条记录：段名 + 压缩后的紧凑JSON。追加写保证已有
+    // 记录不被触碰，加载时后写的记录覆盖先写的同名键。
+    // 整批共用本次打开，记录格式与逐任务写入完全相同
+    for (const PatchJob &job : jobs) {
+        for (const auto &section : job.sections) {
+            const QByteArray payload =
+                qCompress(QJsonDocument(section.second).toJson(QJsonDocument::Compact));
+            stream << section.first << payload;
+        }
+
+        // 日志折算出的RFC-6902补丁作为独立记录追加，加载时按序
+        // 应用到gameState段上
+        if (!job.patchOps.isEmpty()) {
+            const QByteArray payload =
+                qCompress(QJsonDocument(job.patchOps).toJson(QJsonDocument::Compact));
+            stream << kJsonPatchRecord << payload;
+        }
+    }
+
+    // 整批一次fsync。追加写天然崩溃安全：掉电最多在文件尾
+    // 留下半条记录，applyPatches读到损坏记录即截断忽略
+    const bool success = stream.status() == QDataStream::Ok && syncToDisk(file);
+    file.close();
+    return success;
+}
+
+void SaveManager::applyPatches(int slot, QJsonObject &saveData) const
+{
+    QFile file(getPatchPath(slot));
+    if (!file.exists() || !file.open(QIODevice::ReadOnly)) {
+        return;
+    }
+
+    QDataStream stream(&file);
+    stream.setVersion(QDataStream::Qt_6_0);
+
+    int applied = 0;
+    while (!stream.atEnd()) {
+        QString target;
+        QByteArray payload;
+        stream >> target >> payload;
+
+        if (stream.status() != QDataStream::Ok) {
+            qWarning() << "SaveManager: 补丁文件尾部记录损坏，忽略剩余部分";
+            break;
+        }
+
+        const QJsonDocument doc = QJsonDocument::fromJson(qUncompress(payload));
+
+        // RFC-6902记录：补丁操作直接应用到gameState段上
+        if (target == kJsonPatchRecord) {
+            if (!doc.isArray()) {
+                continue;
+            }
+            QJsonObject gameStateObject = saveData["gameState"].toObject();
+            if (GameState::applyJsonPatch(gameStateObject, doc.array())) {
+                saveData["gameState"] = gameStateObject;
+                ++applied;
+            } else {
+                qWarning() << "SaveManager: JSON补丁应用失败，忽略该记录";
+            }
+            continue;
+        }
+
+        if (!doc.isObject()) {
+            continue;
+        }
+
+        // 段快照只含被修改的键，按键合并进目标对象
+        QJsonObject merged = saveData[target].toObject();
+        const QJsonObject patch = doc.object();
+        for (auto it = patch.begin(); it != patch.end(); ++it) {
+            merged[it.key()] = it.value();
+        }
+        saveData[target] = merged;
+        ++applied;
+    }
+
+    file.close();
+
+    if (applied > 0) {
+        qDebug() << "SaveManager: 已合并" << applied << "条段补丁，槽位:" << slot;
+    }
+}
+
+// ==================== 旁路元数据索引 ====================
+
+QString SaveManager::getIndexPath() const
+{
+    QString saveDir = QStandardPaths::writableLocation(QStandardPaths::DocumentsLocation);
+    saveDir += "/FantasyLegend/Saves";
+    return QString("%1/save_index.flsi").arg(saveDir);
+}
+
+QHash<int, SaveManager::IndexEntry> SaveManager::readSaveIndex() const
+{
+    QHash<int, IndexEntry> index;
+
+    QFile file(getIndexPath());
+    if (!file.open(QIODevice::ReadOnly)) {
+        return index;
+    }
+
+    QDataStream stream(&file);
+    stream.setVersion(QDataStream::Qt_6_0);
+
+    quint32 magic = 0;
+    quint32 formatVersion = 0;
+    quint32 entryCount = 0;
+    stream >> magic >> formatVersion >> entryCount;
+
+    if (stream.status() != QDataStream::Ok || magic != INDEX_MAGIC ||
+        formatVersion > INDEX_FORMAT_VERSION) {
+        qWarning() << "SaveManager: 旁路索引非法，按空索引重建";
+        return index;
+    }
+
+    for (quint32 i = 0; i < entryCount; ++i) {
+        IndexEntry entry;
+        qint32 profession = 0;
+        stream >> entry.info.slot >> entry.info.exists >> entry.info.timestamp
+               >> entry.info.playerName >> entry.info.playerLevel >> profession
+               >> entry.info.currentChapter >> entry.info.gameProgress
+               >> entry.saveFileTime >> entry.saveFileSize >> entry.patchFileSize;
+        if (stream.status() != QDataStream::Ok) {
+            qWarning() << "SaveManager: 旁路索引条目损坏，忽略剩余部分";
+            break;
+        }
+        entry.info.profession = static_cast<PlayerProfession>(profession);
+        index.insert(entry.info.slot, entry);
+    }
+
+    file.close();
+    return index;
+}
+
+bool SaveManager::writeSaveIndex(const QHash<int, IndexEntry> &index) const
+{
+    // 索引整体重写同样走临时文件+rename，重写中途崩溃时旧
+    // 索引保持完整，不触发全量慢路径扫描
+    const QString tempPath = getIndexPath() + QStringLiteral(".tmp");
+    QFile file(tempPath);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        return false;
+    }
+
+    QDataStream stream(&file);
+    stream.setVersion(QDataStream::Qt_6_0);
+
+    stream << INDEX_MAGIC << INDEX_FORMAT_VERSION
+           << static_cast<quint32>(index.size());
+    for (const IndexEntry &entry : index) {
+        stream << entry.info.slot << entry.info.exists << entry.info.timestamp
+               << entry.info.playerName << entry.info.playerLevel
+               << static_cast<qint32>(entry.info.profession)
+               << entry.info.currentChapter << entry.info.gameProgress
+               << entry.saveFileTime << entry.saveFileSize << entry.patchFileSize;
+    }
+
+    if (stream.status() != QDataStream::Ok || !syncToDisk(file)) {
+        file.close();
+        QFile::remove(tempPath);
+        return false;
+    }
+    file.close();
+
+    if (!renameOverExisting(tempPath, getIndexPath())) {
+        QFile::remove(tempPath);
+        return false;
+    }
+    return true;
+}
+
+void SaveManager::stampEntry(int slot, IndexEntry &entry) const
+{
+    entry.saveFileTime = 0;
+    entry.saveFileSize = 0;
+    entry.patchFileSize = 0;
+
+    QFileInfo saveFile(getBinarySavePath(slot));
+    if (!saveFile.exists()) {
+        saveFile = QFileInfo(getSavePath(slot));
+    }
+    if (saveFile.exists()) {
+        entry.saveFileTime = saveFile.lastModified().toMSecsSinceEpoch();
+        entry.saveFileSize = saveFile.size();
+    }
+
+    const QFileInfo patchFile(getPatchPath(slot));
+    if (patchFile.exists()) {
+        entry.patchFileSize = patchFile.size();
+    }
+}
+
+bool SaveManager::entryMatchesDisk(int slot, const IndexEntry &entry) const
+{
+    IndexEntry current;
+    stampEntry(slot, current);
+
+    return entry.info.exists == hasSave(slot) &&
+           entry.saveFileTime == current.saveFileTime &&
+           entry.saveFileSize == current.saveFileSize &&
+           entry.patchFileSize == current.patchFileSize;
+}
+
+SaveInfo SaveManager::refreshIndexEntry(int slot)
+{
+    IndexEntry entry;
+    entry.info = getSaveInfo(slot);
+    stampEntry(slot, entry);
+
+    // 读-改-写整体持锁：主线程保存与写线程自动存档可能同时
+    // 刷新不同槽位
+    QMutexLocker locker(&m_indexMutex);
+    QHash<int, IndexEntry> index = readSaveIndex();
+    if (entry.info.exists) {
+        index.insert(slot, entry);
+    } else {
+        index.remove(slot);
+    }
+    if (!writeSaveIndex(index)) {
+        qWarning() << "SaveManager: 旁路索引写入失败";
+    }
+    return entry.info;
+}
+
+void SaveManager::scanSavesAsync()
+{
+    // 上一次扫描尚未结束时先等它收尾，保证信号不交错
+    if (m_scanThread.joinable()) {
+        m_scanThread.join();
+    }
+
+    m_scanStopping.store(false);
+    m_scanThread = std::thread(&SaveManager::scanLoop, this);
+}
+
+void SaveManager::scanLoop()
+{
+    const QHash<int, IndexEntry> index = readSaveIndex();
+
+    // 指纹不符被重建的条目，扫描结束后统一写回索引
+    QHash<int, IndexEntry> rebuilt;
+    QList<int> removed;
+
+    for (int slot = 0; slot < MAX_SAVE_SLOTS; ++slot) {
+        if (m_scanStopping.load()) {
+            return;
+        }
+
+        const auto it = index.constFind(slot);
+        if (it != index.constEnd() && entryMatchesDisk(slot, it.value())) {
+            // 快路径：索引命中且指纹一致，零存档文件IO
+            emit saveInfoReady(it.value().info);
+            continue;
+        }
+
+        // 慢路径：索引缺失或存档被外部改动，打开summary段重建
+        IndexEntry entry;
+        entry.info = getSaveInfo(slot);
+        stampEntry(slot, entry);
+        if (entry.info.exists) {
+            rebuilt.insert(slot, entry);
+        } else if (it != index.constEnd()) {
+            removed.append(slot);
+        }
+        emit saveInfoReady(entry.info);
+    }
+
+    if (!rebuilt.isEmpty() || !removed.isEmpty()) {
+        // 持锁重读再合并，不覆盖扫描期间其他线程的刷新
+        QMutexLocker locker(&m_indexMutex);
+        QHash<int, IndexEntry> fresh = readSaveIndex();
+        for (auto it = rebuilt.constBegin(); it != rebuilt.constEnd(); ++it) {
+            fresh.insert(it.key(), it.value());
+        }
+        for (int slot : removed) {
+            fresh.remove(slot);
+        }
+        if (!writeSaveIndex(fresh)) {
+            qWarning() << "SaveManager: 旁路索引写入失败";
+        }
+    }
+
+    emit saveScanCompleted();
 }
\ No newline at end of file
@@ -52,6 +52,9 @@ GameplayWindow::GameplayWindow(QWidget *parent)
     , m_chatTextEdit(nullptr)
     , m_logTextEdit(nullptr)
     , m_updateTimer(nullptr)
+    , m_miniMapWidget(nullptr)
+    , m_gameViewDirty(true)
+    , m_updateTick(0)
     , m_isInventoryVisible(true)
     , m_isChatVisible(true)
     , m_isSkillPanelVisible(false)
@@ -225,34 +228,45 @@ void GameplayWindow::updatePlayerInfo(const QString &name, int level, int health
     mana = qBound(0, mana, maxMana);
     experience = qBound(0, experience, maxExperience);
 
-    // 更新玩家姓名和等级
-    if (m_playerNameLabel) {
+    // 逐元素脏检查：只有与快照不同的控件才重新设置/重绘
+    if (m_playerNameLabel && name != m_playerInfoCache.name) {
         m_playerNameLabel->setText(name);
+        m_playerInfoCache.name = name;
     }
 
-    if (m_playerLevelLabel) {
+    if (m_playerLevelLabel && level != m_playerInfoCache.level) {
         m_playerLevelLabel->setText(QString("等级 %1").arg(level));
+        m_playerInfoCache.level = level;
     }
 
     // 更新生命值
-    if (m_healthBar) {
+    if (m_healthBar && (health != m_playerInfoCache.health ||
+                        maxHealth != m_playerInfoCache.maxHealth)) {
         m_healthBar->setMaximum(maxHealth);
         m_healthBar->setValue(health);
         m_healthBar->setFormat(QString("%1/%2").arg(health).arg(maxHealth));
+        m_playerInfoCache.health = health;
+        m_playerInfoCache.maxHealth = maxHealth;
     }
 
     // 更新魔法值
-    if (m_manaBar) {
+    if (m_manaBar && (mana != m_playerInfoCache.mana ||
+                      maxMana != m_playerInfoCache.maxMana)) {
         m_manaBar->setMaximum(maxMana);
         m_manaBar->setValue(mana);
         m_manaBar->setFormat(QString("%1/%2").arg(mana).arg(maxMana));
+        m_playerInfoCache.mana = mana;
+        m_playerInfoCache.maxMana = maxMana;
     }
 
     // 更新经验值
-    if (m_experienceBar) {
+    if (m_experienceBar && (experience != m_playerInfoCache.experience ||
+                            maxExperience != m_playerInfoCache.maxExperience)) {
         m_experienceBar->setMaximum(maxExperience);
         m_experienceBar->setValue(experience);
         m_experienceBar->setFormat(QString("%1/%2").arg(experience).arg(maxExperience));
+        m_playerInfoCache.experience = experience;
+        m_playerInfoCache.maxExperience = maxExperience;
     }
 }
 
@@ -562,10 +576,10 @@ void GameplayWindow::setupMiniMapPanel(QVBoxLayout* layout)
     mapLayout->setContentsMargins(10, 15, 10, 10);
     
     // 小地图显示区域
-    QWidget* mapWidget = new QWidget();
-    mapWidget->setStyleSheet("background-color: #222; border: 1px solid #555;");
-    mapWidget->setMinimumSize(260, 160);
-    mapLayout->addWidget(mapWidget);
+    m_miniMapWidget = new QWidget();
+    m_miniMapWidget->setStyleSheet("background-color: #222; border: 1px solid #555;");
+    m_miniMapWidget->setMinimumSize(260, 160);
+    mapLayout->addWidget(m_miniMapWidget);
     
     layout->addWidget(m_miniMapPanel);
 }
@@ -739,19 +753,36 @@ void GameplayWindow::startUpdateTimer()
 
 void GameplayWindow::updateUI()
 {
-    // 更新游戏界面渲染
-    if (m_gameView) {
+    ++m_updateTick;
+
+    // 游戏视图按脏标记重绘，没有交互/状态变化的帧跳过
+    if (m_gameView && m_gameViewDirty) {
+        m_gameViewDirty = false;
         m_gameView->update();
     }
 
+    // 小地图属于低优先级元素：定时器为20Hz，每两拍重绘一次（10Hz），
+    // 面板折叠时完全不绘
+    if (m_miniMapWidget && m_miniMapPanel && m_miniMapPanel->isVisible() &&
+        (m_updateTick % 2 == 0)) {
+        m_miniMapWidget->update();
+    }
+
     // 更新性能信息
     if (m_performanceMonitor && m_performanceMonitor->isEnabled()) {
         // 可以在这里更新性能相关的UI元素
     }
 }
 
+void GameplayWindow::markGameViewDirty()
+{
+    m_gameViewDirty = true;
+}
+
 void GameplayWindow::handleLeftClick(const QPoint &position)
 {
+    markGameViewDirty();
+
     // 发射信号供外部处理（移动角色、选择目标等）
     emit leftClicked(position);
 }
@@ -761,6 +792,8 @@ void GameplayWindow::handleRightClick(const QPoint &position)
     // 处理右键点击
     qDebug() << "GameplayWindow: 右键点击位置:" << position;
 
+    markGameViewDirty();
+
     // 发射信号
     emit rightClicked(position);
 
@@ -23,6 +23,7 @@
 #include <QScrollArea>
 #include <QSplitter>
 #include <QTextEdit>
+#include <QTimer>
 #include <QDebug>
 
 InventoryWindow::InventoryWindow(QWidget *parent)
@@ -32,6 +33,7 @@ InventoryWindow::InventoryWindow(QWidget *parent)
     , m_itemDetailPanel(nullptr)
     , m_capacityLabel(nullptr)
     , m_selectedSlot(-1)
+    , m_refreshScheduled(false)
 {
     qDebug() << "InventoryWindow: 初始化背包窗口";
     
@@ -213,13 +215,10 @@ void InventoryWindow::setupConnections()
 {
     if (!m_inventorySystem) return;
     
-    // 连接背包系统信号
-    connect(m_inventorySystem, &Game::InventorySystem::itemAdded,
-            this, &InventoryWindow::onItemAdded);
-    connect(m_inventorySystem, &Game::InventorySystem::itemRemoved,
-            this, &InventoryWindow::onItemRemoved);
-    connect(m_inventorySystem, &Game::InventorySystem::itemsChanged,
-            this, &InventoryWindow::updateInventoryDisplay);
+    // 行级增量更新：单槽位变化只标脏对应行，同帧内的连续
+    // 变化（如批量拾取）合并为事件循环末尾的一次批量刷新
+    connect(m_inventorySystem, &Game::InventorySystem::slotChanged,
+            this, &InventoryWindow::onSlotChanged);
 }
 
 void InventoryWindow::updateInventoryDisplay()
@@ -376,22 +375,53 @@ void InventoryWindow::onSlotClicked()
     qDebug() << "InventoryWindow: 选中槽位" << slotIndex;
 }
 
-void InventoryWindow::onItemAdded(int itemId, int quantity)
+void InventoryWindow::onSlotChanged(int slotIndex)
 {
-    qDebug() << "InventoryWindow: 物品添加" << itemId << "x" << quantity;
-    updateInventoryDisplay();
+    m_dirtySlots.insert(slotIndex);
+
+    if (!m_refreshScheduled) {
+        m_refreshScheduled = true;
+        QTimer::singleShot(0, this, &InventoryWindow::applyPendingSlotUpdates);
+    }
 }
 
-void InventoryWindow::onItemRemoved(int itemId, int quantity)
+void InventoryWindow::applyPendingSlotUpdates()
 {
-    qDebug() << "InventoryWindow: 物品移除" << itemId << "x" << quantity;
-    updateInventoryDisplay();
+    m_refreshScheduled = false;
+
+    if (!m_inventorySystem || m_dirtySlots.isEmpty()) {
+        return;
+    }
+
+    // 一次布局通道内应用全部行更新，中途不触发重绘
+    setUpdatesEnabled(false);
+
+    for (int slotIndex : m_dirtySlots) {
+        updateSlotDisplay(slotIndex);
+    }
+
+    // 容量信息整批只刷新一次
+    m_capacityLabel->setText(QString("%1/%2")
+        .arg(m_inventorySystem->getUsedSlots())
+        .arg(m_inventorySystem->getCapacity()));
+
+    // 选中槽位若被改动，详情面板同步刷新
+    if (m_selectedSlot >= 0 && m_dirtySlots.contains(m_selectedSlot)) {
+        updateItemDetail(m_selectedSlot);
+    }
+
+    setUpdatesEnabled(true);
+
+    qDebug() << "InventoryWindow: 批量刷新" << m_dirtySlots.size() << "个槽位";
+    m_dirtySlots.clear();
 }
 
 void InventoryWindow::sortInventory()
 {
     if (m_inventorySystem) {
         m_inventorySystem->sortInventory();
+        // 批量重排走全量刷新，不逐槽位走增量路径
+        updateInventoryDisplay();
         qDebug() << "InventoryWindow: 背包已整理";
     }
 }
@@ -402,6 +432,7 @@ void InventoryWindow::clearInventory()
         m_inventorySystem->clearInventory();
         m_selectedSlot = -1;
         updateItemDetail(-1);
+        updateInventoryDisplay();
         qDebug() << "InventoryWindow: 背包已清空";
     }
 }
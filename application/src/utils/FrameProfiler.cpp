@@ -0,0 +1,161 @@
+/*
+ * 文件名: FrameProfiler.cpp
+ * 说明: 分层作用域帧剖析器实现
+ * 作者: 彭承康
+ * 创建时间: 2026-08-28
+ */
+
+#include "utils/FrameProfiler.h"
+
+#include <QFile>
+#include <QHash>
+#include <QTextStream>
+#include <QDebug>
+
+#include <algorithm>
+#include <thread>
+
+thread_local int ProfileZoneScope::s_depth = 0;
+
+namespace {
+
+// 每线程缓存自己的缓冲指针，热路径不查注册表
+thread_local FrameProfiler::ThreadBuffer *t_buffer = nullptr;
+
+quint64 currentThreadId()
+{
+    return static_cast<quint64>(
+        std::hash<std::thread::id>{}(std::this_thread::get_id()));
+}
+
+} // namespace
+
+FrameProfiler& FrameProfiler::instance()
+{
+    static FrameProfiler profiler;
+    return profiler;
+}
+
+void FrameProfiler::setEnabled(bool enabled)
+{
+    m_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+FrameProfiler::ThreadBuffer* FrameProfiler::currentThreadBuffer()
+{
+    if (t_buffer) {
+        return t_buffer;
+    }
+
+    // 冷路径: 线程首次记录时注册
+    std::lock_guard<std::mutex> lock(m_registryMutex);
+    m_buffers.emplace_back(
+        std::unique_ptr<ThreadBuffer>(new ThreadBuffer(currentThreadId())));
+    t_buffer = m_buffers.back().get();
+    return t_buffer;
+}
+
+QVector<FrameProfiler::ZoneStats> FrameProfiler::aggregate() const
+{
+    QHash<const char*, ZoneStats> byName;
+
+    {
+        std::lock_guard<std::mutex> lock(m_registryMutex);
+        for (const auto &buffer : m_buffers) {
+            const std::size_t count =
+                std::min(buffer->m_head, ThreadBuffer::CAPACITY);
+            for (std::size_t i = 0; i < count; ++i) {
+                const ZoneEvent &event = buffer->m_events[i];
+                if (!event.name || event.endNs < event.beginNs) {
+                    continue;
+                }
+                ZoneStats &stats = byName[event.name];
+                if (stats.count == 0) {
+                    stats.name = QString::fromLatin1(event.name);
+                }
+                const qint64 duration = event.endNs - event.beginNs;
+                stats.totalNs += duration;
+                stats.maxNs = std::max(stats.maxNs, duration);
+                ++stats.count;
+            }
+        }
+    }
+
+    QVector<ZoneStats> result;
+    result.reserve(byName.size());
+    for (auto it = byName.constBegin(); it != byName.constEnd(); ++it) {
+        result.append(it.value());
+    }
+    std::sort(result.begin(), result.end(),
+              [](const ZoneStats &a, const ZoneStats &b) {
+                  return a.totalNs > b.totalNs;
+              });
+    return result;
+}
+
+QString FrameProfiler::overlaySummary(int maxZones) const
+{
+    const QVector<ZoneStats> stats = aggregate();
+
+    QString summary;
+    const int zoneCount = std::min(maxZones, static_cast<int>(stats.size()));
+    for (int i = 0; i < zoneCount; ++i) {
+        const ZoneStats &zone = stats[i];
+        const double avgUs = zone.count > 0
+            ? static_cast<double>(zone.totalNs) / zone.count / 1000.0
+            : 0.0;
+        summary += QString("%1  avg %2us  max %3us  x%4\n")
+                       .arg(zone.name, -32)
+                       .arg(avgUs, 0, 'f', 1)
+                       .arg(zone.maxNs / 1000)
+                       .arg(zone.count);
+    }
+    return summary;
+}
+
+bool FrameProfiler::exportChromeTrace(const QString &filePath) const
+{
+    QFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qWarning() << "FrameProfiler: 无法写入追踪文件:" << filePath;
+        return false;
+    }
+
+    // Chrome tracing的"X"完整事件: 时间戳与时长以微秒计
+    QTextStream out(&file);
+    out << "[";
+    bool first = true;
+
+    std::lock_guard<std::mutex> lock(m_registryMutex);
+    for (const auto &buffer : m_buffers) {
+        const std::size_t count =
+            std::min(buffer->m_head, ThreadBuffer::CAPACITY);
+        for (std::size_t i = 0; i < count; ++i) {
+            const ZoneEvent &event = buffer->m_events[i];
+            if (!event.name || event.endNs < event.beginNs) {
+                continue;
+            }
+            if (!first) {
+                out << ",";
+            }
+            first = false;
+            out << "\n{\"name\":\"" << event.name
+                << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer->threadId()
+                << ",\"ts\":" << event.beginNs / 1000
+                << ",\"dur\":" << (event.endNs - event.beginNs) / 1000
+                << ",\"args\":{\"depth\":" << event.depth << "}}";
+        }
+    }
+
+    out << "\n]\n";
+    qDebug() << "FrameProfiler: 追踪已导出到" << filePath;
+    return true;
+}
+
+void FrameProfiler::clear()
+{
+    std::lock_guard<std::mutex> lock(m_registryMutex);
+    for (auto &buffer : m_buffers) {
+        buffer->m_head = 0;
+    }
+}
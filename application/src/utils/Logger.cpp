@@ -3,8 +3,10 @@
  * 说明: 日志系统实现
  * 作者: 彭承康
  * 创建时间: 2026-02-18
+ * 更新时间: 2026-08-28 — 同步写改为无锁环形缓冲+后台刷盘线程
  *
  * 本文件实现游戏的日志记录功能，支持多种日志级别和输出方式。
+ * 调用线程只推入环形缓冲，时间戳格式化与所有I/O由后台线程完成。
  */
 
 #include "utils/Logger.h"
@@ -14,26 +16,47 @@
 #include <QTextStream>
 #include <QStringConverter>
 #include <QMutexLocker>
+#include <chrono>
+#include <cstdint>
 #include <iostream>
 
+namespace {
+// 缓冲为空时后台线程的休眠间隔
+constexpr std::chrono::milliseconds IDLE_SLEEP_INTERVAL(2);
+}
+
 Logger* Logger::s_instance = nullptr;
 QMutex Logger::s_mutex;
 
 Logger::Logger(QObject *parent)
     : QObject(parent)
-    , m_logLevel(LogLevel::Info)
+    , m_logLevel(static_cast<int>(LogLevel::Info))
     , m_enableConsoleOutput(true)
     , m_enableFileOutput(true)
     , m_maxLogFiles(10)
     , m_maxFileSize(10 * 1024 * 1024) // 10MB
+    , m_ring(std::make_unique<Slot[]>(RING_CAPACITY))
 {
+    for (std::size_t i = 0; i < RING_CAPACITY; ++i) {
+        m_ring[i].sequence.store(i, std::memory_order_relaxed);
+    }
+    m_recentLines.reserve(RECENT_LINES_CAPACITY);
+
     initializeLogDirectory();
-    openLogFile();
+
+    // 日志文件由后台线程打开，构造函数不做文件I/O
+    m_workerThread = std::thread(&Logger::processRing, this);
 }
 
 Logger::~Logger()
 {
+    m_stopFlag.store(true, std::memory_order_release);
+    if (m_workerThread.joinable()) {
+        m_workerThread.join();
+    }
+
     if (m_logFile.isOpen()) {
+        m_logStream.flush();
         m_logFile.close();
     }
 }
@@ -49,32 +72,18 @@ Logger* Logger::instance()
 
 void Logger::log(LogLevel level, const QString &message, const QString &category)
 {
-    if (level < m_logLevel) {
+    if (static_cast<int>(level) < m_logLevel.load(std::memory_order_relaxed)) {
         return;
     }
-    
-    QMutexLocker locker(&m_mutex);
-    
-    QString timestamp = QDateTime::currentDateTime().toString("yyyy-MM-dd hh:mm:ss.zzz");
-    QString levelStr = logLevelToString(level);
-    QString formattedMessage = QString("[%1] [%2] [%3] %4")
-                              .arg(timestamp)
-                              .arg(levelStr)
-                              .arg(category)
-                              .arg(message);
-    
-    // 控制台输出
-    if (m_enableConsoleOutput) {
-        outputToConsole(level, formattedMessage);
-    }
-    
-    // 文件输出
-    if (m_enableFileOutput && m_logFile.isOpen()) {
-        outputToFile(formattedMessage);
-    }
-    
-    // 发送信号给UI
-    emit logMessage(level, message, category, timestamp);
+
+    // 生产侧只付级别过滤、取时间戳和两次QString引用计数拷贝，
+    // 格式化与I/O全部推迟到后台线程
+    LogRecord record;
+    record.level = level;
+    record.timestampMs = QDateTime::currentMSecsSinceEpoch();
+    record.message = message;
+    record.category = category;
+    submit(std::move(record));
 }
 
 void Logger::debug(const QString &message, const QString &category)
@@ -104,50 +113,231 @@ void Logger::critical(const QString &message, const QString &category)
 
 void Logger::setLogLevel(LogLevel level)
 {
-    QMutexLocker locker(&m_mutex);
-    m_logLevel = level;
+    m_logLevel.store(static_cast<int>(level), std::memory_order_relaxed);
 }
 
 void Logger::setConsoleOutput(bool enabled)
 {
-    QMutexLocker locker(&m_mutex);
-    m_enableConsoleOutput = enabled;
+    m_enableConsoleOutput.store(enabled, std::memory_order_relaxed);
 }
 
 void Logger::setFileOutput(bool enabled)
 {
-    QMutexLocker locker(&m_mutex);
-    m_enableFileOutput = enabled;
-    
-    if (enabled && !m_logFile.isOpen()) {
-        openLogFile();
-    } else if (!enabled && m_logFile.isOpen()) {
-        m_logFile.close();
-    }
+    // 只切换开关，文件的打开/关闭由后台线程在主循环中完成
+    m_enableFileOutput.store(enabled, std::memory_order_relaxed);
 }
 
 void Logger::setMaxLogFiles(int count)
 {
-    QMutexLocker locker(&m_mutex);
-    m_maxLogFiles = qMax(1, count);
+    m_maxLogFiles.store(qMax(1, count), std::memory_order_relaxed);
 }
 
 void Logger::setMaxFileSize(qint64 size)
 {
-    QMutexLocker locker(&m_mutex);
-    m_maxFileSize = qMax(1024LL, size);
+    m_maxFileSize.store(qMax(1024LL, size), std::memory_order_relaxed);
+}
+
+QStringList Logger::recentLines() const
+{
+    QMutexLocker locker(&m_recentMutex);
+
+    QStringList lines;
+    lines.reserve(m_recentLines.size());
+
+    if (m_recentLines.size() < RECENT_LINES_CAPACITY) {
+        for (const QString &line : m_recentLines) {
+            lines.append(line);
+        }
+    } else {
+        // 缓冲已绕回，从最旧的一行开始输出
+        for (int i = 0; i < RECENT_LINES_CAPACITY; ++i) {
+            lines.append(m_recentLines[(m_recentNext + i) % RECENT_LINES_CAPACITY]);
+        }
+    }
+    return lines;
+}
+
+quint64 Logger::droppedCount() const
+{
+    return m_droppedCount.load(std::memory_order_relaxed);
+}
+
+void Logger::flush()
+{
+    // 有界等待缓冲排空，最长约1秒
+    for (int i = 0; i < 500; ++i) {
+        if (m_head.load(std::memory_order_acquire) ==
+            m_tail.load(std::memory_order_acquire)) {
+            return;
+        }
+        std::this_thread::sleep_for(IDLE_SLEEP_INTERVAL);
+    }
+}
+
+void Logger::submit(LogRecord &&record)
+{
+    LogRecord pending = std::move(record);
+    if (tryEnqueue(std::move(pending))) {
+        return;
+    }
+
+    // 缓冲满：释放最旧槽位后重试，绝不阻塞调用线程
+    for (int attempt = 0; attempt < DROP_OLDEST_RETRY_LIMIT; ++attempt) {
+        tryDiscardOldest();
+        LogRecord retry = pending;
+        if (tryEnqueue(std::move(retry))) {
+            return;
+        }
+    }
+
+    m_droppedCount.fetch_add(1, std::memory_order_relaxed);
+}
+
+bool Logger::tryEnqueue(LogRecord &&record)
+{
+    std::size_t pos = m_head.load(std::memory_order_relaxed);
+    for (;;) {
+        Slot &slot = m_ring[pos & (RING_CAPACITY - 1)];
+        const std::size_t seq = slot.sequence.load(std::memory_order_acquire);
+        const std::intptr_t diff =
+            static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos);
+
+        if (diff == 0) {
+            // 槽位可写，CAS竞争该位置
+            if (m_head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                slot.record = std::move(record);
+                slot.sequence.store(pos + 1, std::memory_order_release);
+                return true;
+            }
+        } else if (diff < 0) {
+            // 缓冲满
+            return false;
+        } else {
+            pos = m_head.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+bool Logger::tryDequeue(LogRecord &record)
+{
+    std::size_t pos = m_tail.load(std::memory_order_relaxed);
+    for (;;) {
+        Slot &slot = m_ring[pos & (RING_CAPACITY - 1)];
+        const std::size_t seq = slot.sequence.load(std::memory_order_acquire);
+        const std::intptr_t diff =
+            static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos + 1);
+
+        if (diff == 0) {
+            // 生产者丢弃最旧日志时也推进tail，故消费侧同样用CAS
+            if (m_tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                record = std::move(slot.record);
+                slot.sequence.store(pos + RING_CAPACITY, std::memory_order_release);
+                return true;
+            }
+        } else if (diff < 0) {
+            // 缓冲空
+            return false;
+        } else {
+            pos = m_tail.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+bool Logger::tryDiscardOldest()
+{
+    std::size_t pos = m_tail.load(std::memory_order_relaxed);
+    for (;;) {
+        Slot &slot = m_ring[pos & (RING_CAPACITY - 1)];
+        const std::size_t seq = slot.sequence.load(std::memory_order_acquire);
+        const std::intptr_t diff =
+            static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos + 1);
+
+        if (diff == 0) {
+            if (m_tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                slot.record = LogRecord{};
+                slot.sequence.store(pos + RING_CAPACITY, std::memory_order_release);
+                m_droppedCount.fetch_add(1, std::memory_order_relaxed);
+                return true;
+            }
+        } else if (diff < 0) {
+            return false;
+        } else {
+            pos = m_tail.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+void Logger::processRing()
+{
+    LogRecord record;
+    for (;;) {
+        // 文件输出开关的落实在后台线程：按需打开或关闭日志文件
+        const bool fileEnabled = m_enableFileOutput.load(std::memory_order_relaxed);
+        if (fileEnabled && !m_logFile.isOpen()) {
+            openLogFile();
+        } else if (!fileEnabled && m_logFile.isOpen()) {
+            m_logStream.flush();
+            m_logFile.close();
+        }
+
+        bool processed = false;
+        // 批量汲取：一次唤醒尽量清空缓冲，减少切换
+        while (tryDequeue(record)) {
+            processed = true;
+
+            const QString timestamp = QDateTime::fromMSecsSinceEpoch(record.timestampMs)
+                                          .toString("yyyy-MM-dd hh:mm:ss.zzz");
+            const QString formattedMessage = QString("[%1] [%2] [%3] %4")
+                                            .arg(timestamp)
+                                            .arg(logLevelToString(record.level))
+                                            .arg(record.category)
+                                            .arg(record.message);
+
+            if (m_enableConsoleOutput.load(std::memory_order_relaxed)) {
+                outputToConsole(record.level, formattedMessage);
+            }
+
+            if (m_logFile.isOpen()) {
+                outputToFile(formattedMessage);
+            }
+
+            appendRecentLine(formattedMessage);
+
+            // 跨线程发射，连接到UI的槽为队列式投递
+            emit logMessage(record.level, record.message, record.category, timestamp);
+        }
+
+        if (!processed) {
+            if (m_stopFlag.load(std::memory_order_acquire)) {
+                break;
+            }
+            std::this_thread::sleep_for(IDLE_SLEEP_INTERVAL);
+        }
+    }
+}
+
+void Logger::appendRecentLine(const QString &line)
+{
+    QMutexLocker locker(&m_recentMutex);
+
+    if (m_recentLines.size() < RECENT_LINES_CAPACITY) {
+        m_recentLines.append(line);
+    } else {
+        m_recentLines[m_recentNext] = line;
+    }
+    m_recentNext = (m_recentNext + 1) % RECENT_LINES_CAPACITY;
 }
 
 void Logger::initializeLogDirectory()
 {
     QString logDir = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation);
     logDir += "/logs";
-    
+
     QDir dir;
     if (!dir.exists(logDir)) {
         dir.mkpath(logDir);
     }
-    
+
     m_logDirectory = logDir;
 }
 
@@ -156,22 +346,22 @@ void Logger::openLogFile()
     if (m_logFile.isOpen()) {
         m_logFile.close();
     }
-    
+
     QString timestamp = QDateTime::currentDateTime().toString("yyyyMMdd_hhmmss");
     QString fileName = QString("%1/game_%2.log").arg(m_logDirectory, timestamp);
-    
+
     m_logFile.setFileName(fileName);
     if (m_logFile.open(QIODevice::WriteOnly | QIODevice::Append)) {
         m_logStream.setDevice(&m_logFile);
         m_logStream.setEncoding(QStringConverter::Utf8);
-        
+
         // 写入日志文件头
         m_logStream << "=== Fantasy Legend Game Log ===" << Qt::endl;
         m_logStream << "Started at: " << QDateTime::currentDateTime().toString() << Qt::endl;
         m_logStream << "===============================" << Qt::endl;
         m_logStream.flush();
     }
-    
+
     // 清理旧日志文件
     cleanupOldLogFiles();
 }
@@ -196,12 +386,12 @@ void Logger::outputToFile(const QString &message)
     if (!m_logFile.isOpen()) {
         return;
     }
-    
+
     m_logStream << message << Qt::endl;
     m_logStream.flush();
-    
+
     // 检查文件大小，如果超过限制则轮转
-    if (m_logFile.size() > m_maxFileSize) {
+    if (m_logFile.size() > m_maxFileSize.load(std::memory_order_relaxed)) {
         rotateLogFile();
     }
 }
@@ -217,11 +407,11 @@ void Logger::cleanupOldLogFiles()
     QDir logDir(m_logDirectory);
     QStringList filters;
     filters << "game_*.log";
-    
+
     QFileInfoList logFiles = logDir.entryInfoList(filters, QDir::Files, QDir::Time);
-    
+
     // 删除超过最大数量的旧日志文件
-    while (logFiles.size() > m_maxLogFiles) {
+    while (logFiles.size() > m_maxLogFiles.load(std::memory_order_relaxed)) {
         QFileInfo oldestFile = logFiles.takeLast();
         QFile::remove(oldestFile.absoluteFilePath());
     }
@@ -263,4 +453,4 @@ void logError(const QString &message, const QString &category)
 void logCritical(const QString &message, const QString &category)
 {
     Logger::instance()->critical(message, category);
-}
\ No newline at end of file
+}
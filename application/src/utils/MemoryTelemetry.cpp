@@ -0,0 +1,109 @@
+/*
+ * 文件名: MemoryTelemetry.cpp
+ * 说明: 按子系统归属的内存遥测实现。
+ * 作者: 彭承康
+ * 创建时间: 2026-08-28
+ */
+
+#include "utils/MemoryTelemetry.h"
+
+MemoryTelemetry* MemoryTelemetry::instance()
+{
+    static MemoryTelemetry telemetry;
+    return &telemetry;
+}
+
+void MemoryTelemetry::recordAlloc(Subsystem subsystem, qint64 bytes)
+{
+    Counter &counter = m_counters[static_cast<size_t>(subsystem)];
+    const qint64 current =
+        counter.current.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+    counter.allocs.fetch_add(1, std::memory_order_relaxed);
+    raisePeak(counter, current);
+}
+
+void MemoryTelemetry::recordFree(Subsystem subsystem, qint64 bytes)
+{
+    Counter &counter = m_counters[static_cast<size_t>(subsystem)];
+    counter.current.fetch_sub(bytes, std::memory_order_relaxed);
+}
+
+void MemoryTelemetry::setUsage(Subsystem subsystem, qint64 bytes)
+{
+    Counter &counter = m_counters[static_cast<size_t>(subsystem)];
+    counter.current.store(bytes, std::memory_order_relaxed);
+    raisePeak(counter, bytes);
+}
+
+MemoryTelemetry::SubsystemStats MemoryTelemetry::stats(Subsystem subsystem) const
+{
+    const Counter &counter = m_counters[static_cast<size_t>(subsystem)];
+    SubsystemStats result;
+    result.currentBytes = counter.current.load(std::memory_order_relaxed);
+    result.peakBytes = counter.peak.load(std::memory_order_relaxed);
+    result.allocCount = counter.allocs.load(std::memory_order_relaxed);
+    return result;
+}
+
+qint64 MemoryTelemetry::totalTrackedBytes() const
+{
+    qint64 total = 0;
+    for (const Counter &counter : m_counters) {
+        total += counter.current.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+QJsonObject MemoryTelemetry::snapshot() const
+{
+    QJsonObject result;
+    qint64 total = 0;
+
+    for (int i = 0; i < SUBSYSTEM_COUNT; ++i) {
+        const SubsystemStats entry = stats(static_cast<Subsystem>(i));
+        total += entry.currentBytes;
+
+        QJsonObject item;
+        item["current"] = entry.currentBytes;
+        item["peak"] = entry.peakBytes;
+        item["allocs"] = entry.allocCount;
+        result[QString::fromLatin1(subsystemName(static_cast<Subsystem>(i)))] = item;
+    }
+
+    result["tracked_total"] = total;
+    return result;
+}
+
+void MemoryTelemetry::resetPeaks()
+{
+    for (Counter &counter : m_counters) {
+        counter.peak.store(counter.current.load(std::memory_order_relaxed),
+                           std::memory_order_relaxed);
+    }
+}
+
+const char* MemoryTelemetry::subsystemName(Subsystem subsystem)
+{
+    switch (subsystem) {
+    case Subsystem::Core:     return "core";
+    case Subsystem::Game:     return "game";
+    case Subsystem::Graphics: return "graphics";
+    case Subsystem::Audio:    return "audio";
+    case Subsystem::Network:  return "network";
+    case Subsystem::UI:       return "ui";
+    case Subsystem::Save:     return "save";
+    case Subsystem::Other:    return "other";
+    case Subsystem::Count:    break;
+    }
+    return "unknown";
+}
+
+void MemoryTelemetry::raisePeak(Counter &counter, qint64 value)
+{
+    qint64 peak = counter.peak.load(std::memory_order_relaxed);
+    while (value > peak &&
+           !counter.peak.compare_exchange_weak(peak, value,
+                                               std::memory_order_relaxed)) {
+        // peak已被其他线程抬高，重读后判断是否仍需更新
+    }
+}
@@ -13,6 +13,8 @@
  */
 
 #include "utils/PerformanceMonitor.h"
+#include "utils/MemoryTelemetry.h"
+#include "monitor/MetricsExporter.h"
 #include <QTimer>
 #include <QDebug>
 #include <QDateTime>
@@ -20,6 +22,7 @@
 #include <QJsonObject>
 #include <QJsonArray>
 #include <QFile>
+#include <QRandomGenerator>
 #include <QStandardPaths>
 #include <QDir>
 #include <QProcess>
@@ -204,6 +207,20 @@ void PerformanceMonitor::resetMemoryStats()
 {
     m_currentMemoryUsage = 0;
     m_peakMemoryUsage = 0;
+    MemoryTelemetry::instance()->resetPeaks();
+}
+
+QJsonObject PerformanceMonitor::getMemoryBreakdown() const
+{
+    QJsonObject breakdown = MemoryTelemetry::instance()->snapshot();
+    breakdown["process_rss"] = m_currentMemoryUsage;
+    breakdown["process_rss_peak"] = m_peakMemoryUsage;
+    return breakdown;
+}
+
+void PerformanceMonitor::recordStartupProfile(const QJsonObject &profile)
+{
+    m_startupProfile = profile;
 }
 
 void PerformanceMonitor::startMonitoring()
@@ -409,6 +426,11 @@ bool PerformanceMonitor::exportPerformanceData(const QString &filePath) const
     }
     root["history"] = history;
 
+    // 本次启动的阶段剖析，跨版本对比启动耗时
+    if (!m_startupProfile.isEmpty()) {
+        root["startup"] = m_startupProfile;
+    }
+
     QJsonDocument doc(root);
     QFile file(filePath);
     if (!file.open(QIODevice::WriteOnly)) {
@@ -423,6 +445,85 @@ bool PerformanceMonitor::exportPerformanceData(const QString &filePath) const
     return true;
 }
 
+quint64 PerformanceMonitor::generateTraceId()
+{
+    quint64 id = 0;
+    while (id == 0) {
+        id = QRandomGenerator::global()->generate64();
+    }
+    return id;
+}
+
+void PerformanceMonitor::recordTraceEvent(quint64 traceId, const char *hop)
+{
+    if (!m_isEnabled || traceId == 0) {
+        return;
+    }
+    m_traceRing.Record(traceId, hop);
+}
+
+bool PerformanceMonitor::exportTraceEvents(const QString &filePath) const
+{
+    if (!m_traceRing.DumpCsv(filePath.toStdString())) {
+        qWarning() << "PerformanceMonitor: 无法写入追踪事件文件:" << filePath;
+        return false;
+    }
+    qDebug() << "PerformanceMonitor: 追踪事件已导出到:" << filePath;
+    return true;
+}
+
+bool PerformanceMonitor::startMetricsExporter(quint16 port, const QString &persistPath)
+{
+    if (m_metricsExporter) {
+        return false;
+    }
+    auto exporter = std::make_unique<metrics::MetricsExporter>();
+
+    // 采集器在抓取时取一份指标结构体拷贝，更新路径不为导出
+    // 付任何代价
+    exporter->AddCollector([this]() {
+        const PerformanceMetrics current = getCurrentMetrics();
+        std::vector<metrics::MetricSample> samples;
+        samples.push_back({"client_fps", "gauge", current.fps});
+        samples.push_back({"client_fps_average", "gauge", current.averageFps});
+        samples.push_back({"client_memory_bytes", "gauge",
+                           static_cast<double>(current.memoryUsage)});
+        samples.push_back({"client_draw_calls", "gauge",
+                           static_cast<double>(current.drawCalls)});
+        samples.push_back({"client_triangles", "gauge",
+                           static_cast<double>(current.triangles)});
+        samples.push_back({"client_frame_time_us", "gauge",
+                           static_cast<double>(current.frameTime)});
+        samples.push_back({"client_render_time_us", "gauge",
+                           static_cast<double>(current.renderTime)});
+        samples.push_back({"client_frames_total", "counter",
+                           static_cast<double>(m_frameCount)});
+        return samples;
+    });
+
+    if (!exporter->Start(port, persistPath.toStdString())) {
+        qWarning() << "PerformanceMonitor: 指标导出端口绑定失败:" << port;
+        return false;
+    }
+
+    // 回灌累计帧数：瞬时指标（gauge）不回灌
+    const auto &restored = exporter->RestoredSamples();
+    const auto it = restored.find("client_frames_total");
+    if (it != restored.end()) {
+        m_frameCount = static_cast<int>(it->second);
+    }
+
+    m_metricsExporter = std::move(exporter);
+    qDebug() << "PerformanceMonitor: 指标导出已启动，端口:"
+             << m_metricsExporter->Port();
+    return true;
+}
+
+void PerformanceMonitor::stopMetricsExporter()
+{
+    m_metricsExporter.reset();
+}
+
 void PerformanceMonitor::updateMetrics()
 {
     updateMemoryStats();
@@ -0,0 +1,120 @@
+/*
+ * 文件名: StartupProfiler.cpp
+ * 说明: 启动阶段计时器实现
+ * 作者: 彭承康
+ * 创建时间: 2026-08-28
+ */
+#include "utils/StartupProfiler.h"
+#include "utils/PerformanceMonitor.h"
+
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QStandardPaths>
+
+StartupProfiler *StartupProfiler::s_instance = nullptr;
+
+StartupProfiler* StartupProfiler::instance()
+{
+    if (!s_instance) {
+        s_instance = new StartupProfiler();
+    }
+    return s_instance;
+}
+
+StartupProfiler::StartupProfiler()
+{
+    m_clock.start();
+}
+
+void StartupProfiler::beginPhase(const QString &name)
+{
+    if (m_finished) {
+        return;
+    }
+    Phase phase;
+    phase.name = name;
+    phase.beginMs = m_clock.elapsed();
+    m_phases.push_back(phase);
+}
+
+void StartupProfiler::endPhase(const QString &name)
+{
+    if (m_finished) {
+        return;
+    }
+    // 与最近一次未结束的同名阶段配对，支持嵌套
+    for (auto it = m_phases.rbegin(); it != m_phases.rend(); ++it) {
+        if (it->durationMs < 0 && it->name == name) {
+            it->durationMs = m_clock.elapsed() - it->beginMs;
+            return;
+        }
+    }
+    qWarning() << "StartupProfiler: endPhase未找到配对的开始标记:" << name;
+}
+
+QJsonObject StartupProfiler::report() const
+{
+    QJsonObject root;
+    root["schema"] = QStringLiteral("startup_profile_v1");
+    root["version"] = QCoreApplication::applicationVersion();
+    root["launchedAt"] = QDateTime::currentDateTime().toString(Qt::ISODate);
+    root["totalMs"] = m_clock.elapsed();
+
+    QJsonArray phases;
+    for (const Phase &phase : m_phases) {
+        QJsonObject entry;
+        entry["name"] = phase.name;
+        entry["beginMs"] = phase.beginMs;
+        entry["durationMs"] = phase.durationMs;
+        phases.append(entry);
+    }
+    root["phases"] = phases;
+    return root;
+}
+
+void StartupProfiler::finish()
+{
+    if (m_finished) {
+        return;
+    }
+
+    // 未闭合的阶段按当前时刻收尾，报告里不留-1
+    const qint64 now = m_clock.elapsed();
+    for (Phase &phase : m_phases) {
+        if (phase.durationMs < 0) {
+            phase.durationMs = now - phase.beginMs;
+        }
+    }
+
+    const QJsonObject profile = report();
+    m_finished = true;
+
+    // 每次启动一行紧凑JSON，外部采集按前缀抓取
+    qInfo().noquote() << "STARTUP_PROFILE"
+                      << QString::fromUtf8(
+                             QJsonDocument(profile).toJson(QJsonDocument::Compact));
+
+    // 落盘到性能报告目录，与PerformanceMonitor的报告同处
+    const QString reportDir =
+        QStandardPaths::writableLocation(QStandardPaths::AppDataLocation) + "/performance";
+    QDir().mkpath(reportDir);
+    const QString timestamp = QDateTime::currentDateTime().toString("yyyyMMdd_hhmmss");
+    const QString reportPath = QString("%1/startup_%2.json").arg(reportDir, timestamp);
+
+    QFile file(reportPath);
+    if (file.open(QIODevice::WriteOnly)) {
+        file.write(QJsonDocument(profile).toJson());
+        file.close();
+        qDebug() << "StartupProfiler: 启动报告已写入:" << reportPath;
+    } else {
+        qWarning() << "StartupProfiler: 无法写入启动报告:" << reportPath;
+    }
+
+    // 并入性能监控器，随性能报告一起导出，跨版本对比
+    PerformanceMonitor::instance()->recordStartupProfile(profile);
+}
@@ -0,0 +1,430 @@
+/*
+ * MetricsExporter.h
+ *
+ * Shared pull-based metrics export used by the per-layer
+ * PerformanceMonitors. Layers register collector callbacks that
+ * snapshot their counters and histograms on demand; a background
+ * thread serves the snapshot as Prometheus text exposition over a
+ * minimal HTTP listener and periodically persists it into a small
+ * on-disk slot ring so monotonic counters survive restarts.
+ *
+ * Scrape cost is proportional to the number of metrics, not to the
+ * metric update rate: collectors read atomics/snapshots at scrape
+ * time and nothing is recorded per update.
+ */
+#ifndef MONITOR_METRICSEXPORTER_H
+#define MONITOR_METRICSEXPORTER_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#if defined(_WIN32)
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#else
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/select.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+namespace metrics {
+
+/**
+ * One exported sample. `type` is the Prometheus metric type
+ * ("counter" or "gauge"); `name` is sanitized at render time.
+ */
+struct MetricSample {
+    std::string name;
+    std::string type;
+    double value = 0.0;
+};
+
+/**
+ * Pull-based metrics registry with an HTTP text endpoint and on-disk
+ * ring persistence.
+ *
+ * Thread-safety: AddCollector/Start/Stop are expected from one
+ * owning thread; RenderExposition and the background thread take the
+ * collector mutex, so collectors themselves must be thread-safe
+ * (reading atomics or taking their own snapshots).
+ */
+class MetricsExporter {
+public:
+    using Collector = std::function<std::vector<MetricSample>()>;
+
+    // Persistence ring layout: fixed-size slots appended round-robin.
+    // A torn write corrupts at most the newest slot; loading falls
+    // back to the newest slot that parses completely.
+    static constexpr std::size_t PERSIST_SLOT_COUNT = 8;
+    static constexpr std::size_t PERSIST_SLOT_BYTES = 8192;
+    static constexpr std::chrono::seconds PERSIST_INTERVAL{10};
+
+    MetricsExporter() = default;
+
+    ~MetricsExporter() { Stop(); }
+
+    MetricsExporter(const MetricsExporter&) = delete;
+    MetricsExporter& operator=(const MetricsExporter&) = delete;
+
+    /**
+     * Register a collector. Called for every scrape and every
+     * persistence tick.
+     */
+    void AddCollector(Collector collector) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        collectors_.push_back(std::move(collector));
+    }
+
+    /**
+     * Start the endpoint and persistence.
+     *
+     * @param port listen port (0 picks an ephemeral port, see Port())
+     * @param persist_path ring file path; empty disables persistence
+     * @return false if the socket could not be bound
+     */
+    bool Start(std::uint16_t port, const std::string& persist_path) {
+        if (running_.load()) {
+            return false;
+        }
+        persist_path_ = persist_path;
+        if (!persist_path_.empty()) {
+            LoadPersisted();
+        }
+        if (!OpenListener(port)) {
+            return false;
+        }
+        running_.store(true);
+        server_thread_ = std::thread([this]() { ServeLoop(); });
+        return true;
+    }
+
+    /** Stop the background thread and close the listener. */
+    void Stop() {
+        if (!running_.exchange(false)) {
+            return;
+        }
+        CloseListener();
+        if (server_thread_.joinable()) {
+            server_thread_.join();
+        }
+        // Final snapshot so a clean shutdown persists up-to-date values.
+        if (!persist_path_.empty()) {
+            PersistSnapshot();
+        }
+    }
+
+    /** Bound port (useful when Start was given port 0). */
+    std::uint16_t Port() const { return bound_port_; }
+
+    /**
+     * Values restored from the persistence ring at Start, keyed by
+     * sanitized metric name. Monitors use this to re-seed monotonic
+     * counters after a restart.
+     */
+    const std::unordered_map<std::string, double>& RestoredSamples() const {
+        return restored_;
+    }
+
+    /**
+     * Render the current snapshot in Prometheus text exposition
+     * format (one # TYPE line per metric, then the sample).
+     */
+    std::string RenderExposition() const {
+        std::string out;
+        out.reserve(1024);
+        for (const MetricSample& sample : Collect()) {
+            const std::string name = SanitizeName(sample.name);
+            out += "# TYPE " + name + " " + sample.type + "\n";
+            out += name + " " + FormatValue(sample.value) + "\n";
+        }
+        return out;
+    }
+
+private:
+#if defined(_WIN32)
+    using SocketHandle = SOCKET;
+    static constexpr SocketHandle INVALID_HANDLE = INVALID_SOCKET;
+    static void CloseSocket(SocketHandle s) { ::closesocket(s); }
+#else
+    using SocketHandle = int;
+    static constexpr SocketHandle INVALID_HANDLE = -1;
+    static void CloseSocket(SocketHandle s) { ::close(s); }
+#endif
+
+    std::vector<MetricSample> Collect() const {
+        std::vector<MetricSample> samples;
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (const Collector& collector : collectors_) {
+            std::vector<MetricSample> part = collector();
+            samples.insert(samples.end(),
+                           std::make_move_iterator(part.begin()),
+                           std::make_move_iterator(part.end()));
+        }
+        return samples;
+    }
+
+    // Exposition names: [a-zA-Z0-9_:], everything else becomes '_'.
+    static std::string SanitizeName(const std::string& raw) {
+        std::string name = raw;
+        for (char& c : name) {
+            const bool ok = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') ||
+                            (c >= '0' && c <= '9') || c == '_' || c == ':';
+            if (!ok) {
+                c = '_';
+            }
+        }
+        if (name.empty() || (name[0] >= '0' && name[0] <= '9')) {
+            name.insert(name.begin(), '_');
+        }
+        return name;
+    }
+
+    static std::string FormatValue(double value) {
+        char buffer[64];
+        std::snprintf(buffer, sizeof(buffer), "%.17g", value);
+        return buffer;
+    }
+
+    bool OpenListener(std::uint16_t port) {
+#if defined(_WIN32)
+        static const int winsock_ready = []() {
+            WSADATA wsa;
+            return ::WSAStartup(MAKEWORD(2, 2), &wsa);
+        }();
+        if (winsock_ready != 0) {
+            return false;
+        }
+#endif
+        listen_socket_ = ::socket(AF_INET, SOCK_STREAM, 0);
+        if (listen_socket_ == INVALID_HANDLE) {
+            return false;
+        }
+        int reuse = 1;
+        ::setsockopt(listen_socket_, SOL_SOCKET, SO_REUSEADDR,
+                     reinterpret_cast<const char*>(&reuse), sizeof(reuse));
+
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_ANY);
+        addr.sin_port = htons(port);
+        if (::bind(listen_socket_, reinterpret_cast<sockaddr*>(&addr),
+                   sizeof(addr)) != 0 ||
+            ::listen(listen_socket_, 4) != 0) {
+            CloseSocket(listen_socket_);
+            listen_socket_ = INVALID_HANDLE;
+            return false;
+        }
+
+        sockaddr_in bound{};
+        socklen_t len = sizeof(bound);
+        if (::getsockname(listen_socket_, reinterpret_cast<sockaddr*>(&bound),
+                          &len) == 0) {
+            bound_port_ = ntohs(bound.sin_port);
+        }
+        return true;
+    }
+
+    void CloseListener() {
+        if (listen_socket_ != INVALID_HANDLE) {
+#if defined(_WIN32)
+            ::shutdown(listen_socket_, SD_BOTH);
+#else
+            ::shutdown(listen_socket_, SHUT_RDWR);
+#endif
+            CloseSocket(listen_socket_);
+            listen_socket_ = INVALID_HANDLE;
+        }
+    }
+
+    /**
+     * Single background thread: multiplexes accept() with a 1s
+     * select timeout and runs the persistence tick in between, so
+     * export needs no second thread.
+     */
+    void ServeLoop() {
+        auto next_persist = std::chrono::steady_clock::now() + PERSIST_INTERVAL;
+        while (running_.load()) {
+            fd_set readable;
+            FD_ZERO(&readable);
+            FD_SET(listen_socket_, &readable);
+            timeval timeout{};
+            timeout.tv_sec = 1;
+            const int ready = ::select(
+                static_cast<int>(listen_socket_ + 1), &readable, nullptr,
+                nullptr, &timeout);
+            if (!running_.load()) {
+                break;
+            }
+            if (ready > 0) {
+                const SocketHandle client = ::accept(listen_socket_, nullptr, nullptr);
+                if (client != INVALID_HANDLE) {
+                    ServeClient(client);
+                    CloseSocket(client);
+                }
+            }
+            if (!persist_path_.empty() &&
+                std::chrono::steady_clock::now() >= next_persist) {
+                PersistSnapshot();
+                next_persist = std::chrono::steady_clock::now() + PERSIST_INTERVAL;
+            }
+        }
+    }
+
+    void ServeClient(SocketHandle client) {
+        // Read and discard the request; any GET gets the exposition.
+        char request[1024];
+        (void)::recv(client, request, sizeof(request), 0);
+
+        const std::string body = RenderExposition();
+        std::string response =
+            "HTTP/1.0 200 OK\r\n"
+            "Content-Type: text/plain; version=0.0.4; charset=utf-8\r\n"
+            "Content-Length: " + std::to_string(body.size()) + "\r\n"
+            "Connection: close\r\n\r\n" + body;
+        std::size_t sent = 0;
+        while (sent < response.size()) {
+            const auto n = ::send(client, response.data() + sent,
+#if defined(_WIN32)
+                                  static_cast<int>(response.size() - sent),
+#else
+                                  response.size() - sent,
+#endif
+                                  0);
+            if (n <= 0) {
+                break;
+            }
+            sent += static_cast<std::size_t>(n);
+        }
+    }
+
+    // ---- on-disk slot ring ----
+    //
+    // Slot format (zero-padded to PERSIST_SLOT_BYTES):
+    //   #seq <sequence> <sample-count>\n
+    //   <name> <value>\n ...
+    //   #end\n
+    // The "#end" marker makes torn writes detectable.
+
+    void PersistSnapshot() {
+        std::FILE* file = std::fopen(persist_path_.c_str(), "r+b");
+        if (file == nullptr) {
+            file = std::fopen(persist_path_.c_str(), "w+b");
+        }
+        if (file == nullptr) {
+            return;
+        }
+
+        const std::vector<MetricSample> samples = Collect();
+        std::string slot = "#seq " + std::to_string(persist_sequence_) + " " +
+                           std::to_string(samples.size()) + "\n";
+        for (const MetricSample& sample : samples) {
+            slot += SanitizeName(sample.name) + " " + FormatValue(sample.value) + "\n";
+        }
+        slot += "#end\n";
+        if (slot.size() > PERSIST_SLOT_BYTES) {
+            slot.resize(PERSIST_SLOT_BYTES);  // oversized snapshot: drop tail
+        } else {
+            slot.resize(PERSIST_SLOT_BYTES, '\0');
+        }
+
+        const std::size_t index = persist_sequence_ % PERSIST_SLOT_COUNT;
+        if (std::fseek(file, static_cast<long>(index * PERSIST_SLOT_BYTES),
+                       SEEK_SET) == 0) {
+            std::fwrite(slot.data(), 1, slot.size(), file);
+            std::fflush(file);
+            ++persist_sequence_;
+        }
+        std::fclose(file);
+    }
+
+    void LoadPersisted() {
+        std::FILE* file = std::fopen(persist_path_.c_str(), "rb");
+        if (file == nullptr) {
+            return;
+        }
+
+        std::uint64_t best_seq = 0;
+        bool found = false;
+        std::unordered_map<std::string, double> best;
+        std::vector<char> slot(PERSIST_SLOT_BYTES);
+        for (std::size_t i = 0; i < PERSIST_SLOT_COUNT; ++i) {
+            if (std::fseek(file, static_cast<long>(i * PERSIST_SLOT_BYTES),
+                           SEEK_SET) != 0 ||
+                std::fread(slot.data(), 1, slot.size(), file) != slot.size()) {
+                break;
+            }
+            std::uint64_t seq = 0;
+            std::unordered_map<std::string, double> values;
+            if (ParseSlot(slot, seq, values) && (!found || seq >= best_seq)) {
+                best_seq = seq;
+                best = std::move(values);
+                found = true;
+            }
+        }
+        std::fclose(file);
+
+        if (found) {
+            restored_ = std::move(best);
+            persist_sequence_ = best_seq + 1;
+        }
+    }
+
+    static bool ParseSlot(const std::vector<char>& slot, std::uint64_t& seq,
+                          std::unordered_map<std::string, double>& values) {
+        const char* end = slot.data() + slot.size();
+        const char* line = slot.data();
+        unsigned long long parsed_seq = 0;
+        unsigned long long count = 0;
+        int consumed = 0;
+        if (std::sscanf(line, "#seq %llu %llu%n", &parsed_seq, &count,
+                        &consumed) != 2) {
+            return false;
+        }
+        line += consumed + 1;  // skip newline
+
+        for (unsigned long long i = 0; i < count; ++i) {
+            if (line >= end) {
+                return false;
+            }
+            char name[256];
+            double value = 0.0;
+            consumed = 0;
+            if (std::sscanf(line, "%255s %lf%n", name, &value, &consumed) != 2) {
+                return false;
+            }
+            values[name] = value;
+            line += consumed + 1;
+        }
+        if (line >= end || std::strncmp(line, "#end", 4) != 0) {
+            return false;
+        }
+        seq = parsed_seq;
+        return true;
+    }
+
+    mutable std::mutex mutex_;
+    std::vector<Collector> collectors_;
+    std::unordered_map<std::string, double> restored_;
+    std::string persist_path_;
+    std::uint64_t persist_sequence_ = 0;
+    std::atomic<bool> running_{false};
+    std::thread server_thread_;
+    SocketHandle listen_socket_ = INVALID_HANDLE;
+    std::uint16_t bound_port_ = 0;
+};
+
+} // namespace metrics
+
+#endif // MONITOR_METRICSEXPORTER_H
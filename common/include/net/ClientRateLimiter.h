@@ -0,0 +1,201 @@
+/*
+ * File: ClientRateLimiter.h
+ * Description: Shared per-client token-bucket rate limiter for the gRPC servers.
+ */
+#ifndef NET_CLIENTRATELIMITER_H
+#define NET_CLIENTRATELIMITER_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+
+namespace net {
+
+// Per-client token-bucket rate limiting shared by the algorithm and
+// strategy gRPC servers. Buckets are keyed by peer identity (the
+// transport address gRPC reports) with an independent bucket per RPC
+// class, so a client hammering the expensive compute RPCs exhausts its
+// own compute budget without touching its reads — let alone anyone
+// else's. Accounting on the request path is O(1): one hash lookup plus
+// a lazy refill multiply; no background refill thread exists.
+
+/**
+ * @brief Coarse RPC classes with independent budgets.
+ */
+enum class RpcClass : std::size_t {
+    Read = 0,     ///< Cheap lookups (rules, skill trees, state queries)
+    Compute = 1,  ///< CPU-heavy calls (damage batches, AI decisions, pathfinding)
+    Mutate = 2,   ///< State-changing calls (world updates, event triggers)
+    Stream = 3,   ///< Long-lived subscriptions (charged once at open)
+};
+
+/// Number of RPC classes; sized for std::array of per-class state.
+inline constexpr std::size_t kRpcClassCount = 4;
+
+/**
+ * @brief Refill rate and capacity of one class's bucket.
+ *
+ * A non-positive tokens_per_second disables limiting for the class.
+ */
+struct RateLimitConfig {
+    double tokens_per_second = 0.0;  ///< Steady-state admission rate
+    double burst = 0.0;              ///< Bucket capacity (burst allowance)
+};
+
+/**
+ * @brief Token buckets per peer identity with O(1) admission checks.
+ *
+ * Thread-safe; a single mutex guards the peer table. The table is
+ * bounded: once kMaxTrackedClients peers are tracked, entries idle for
+ * kIdleEvictSeconds are swept before a new peer is admitted, so an
+ * address-churning client cannot grow the table without bound.
+ * Admission and rejection counts per class are kept as relaxed atomics
+ * for the monitoring surfaces of both servers.
+ */
+class ClientRateLimiter {
+public:
+    /// Peers tracked before idle entries are swept.
+    static constexpr std::size_t kMaxTrackedClients = 1024;
+    /// A peer idle this long is evictable during a sweep.
+    static constexpr std::int64_t kIdleEvictSeconds = 60;
+
+    explicit ClientRateLimiter(const std::array<RateLimitConfig, kRpcClassCount>& configs)
+        : configs_(configs) {}
+
+    /**
+     * @brief Admits or rejects one request for the peer's class bucket.
+     */
+    bool TryAcquire(std::string_view peer, RpcClass rpc_class) {
+        return TryAcquireAt(peer, rpc_class, NowMicros());
+    }
+
+    /**
+     * @brief Deterministic-time variant of TryAcquire used by tests.
+     *
+     * @param now_us Monotonic timestamp in microseconds; callers must
+     *               never pass a value older than a previous call's.
+     */
+    bool TryAcquireAt(std::string_view peer, RpcClass rpc_class, std::int64_t now_us) {
+        const std::size_t cls = static_cast<std::size_t>(rpc_class);
+        if (configs_[cls].tokens_per_second <= 0.0) {
+            admitted_[cls].fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = clients_.find(peer);
+        if (it == clients_.end()) {
+            if (clients_.size() >= kMaxTrackedClients) {
+                EvictIdleLocked(now_us);
+            }
+            ClientBuckets buckets;
+            for (std::size_t i = 0; i < kRpcClassCount; ++i) {
+                buckets.tokens[i] = configs_[i].burst;
+            }
+            buckets.last_refill_us = now_us;
+            it = clients_.emplace(std::string(peer), buckets).first;
+        }
+
+        ClientBuckets& buckets = it->second;
+        RefillLocked(buckets, now_us);
+        if (buckets.tokens[cls] >= 1.0) {
+            buckets.tokens[cls] -= 1.0;
+            admitted_[cls].fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+        rejected_[cls].fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    /// Requests admitted for the class since construction.
+    std::uint64_t AdmittedCount(RpcClass rpc_class) const {
+        return admitted_[static_cast<std::size_t>(rpc_class)].load(
+            std::memory_order_relaxed);
+    }
+
+    /// Requests rejected for the class since construction.
+    std::uint64_t RejectedCount(RpcClass rpc_class) const {
+        return rejected_[static_cast<std::size_t>(rpc_class)].load(
+            std::memory_order_relaxed);
+    }
+
+    /// Rejections summed over all classes (the overflow metric).
+    std::uint64_t TotalRejected() const {
+        std::uint64_t total = 0;
+        for (const auto& count : rejected_) {
+            total += count.load(std::memory_order_relaxed);
+        }
+        return total;
+    }
+
+    /// Number of peers currently tracked.
+    std::size_t TrackedClients() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return clients_.size();
+    }
+
+private:
+    // Heterogeneous lookup: find by string_view without allocating a
+    // temporary key string on every request.
+    struct StringHash {
+        using is_transparent = void;
+        std::size_t operator()(std::string_view value) const {
+            return std::hash<std::string_view>{}(value);
+        }
+    };
+
+    /// One peer's buckets; a shared refill timestamp serves all classes.
+    struct ClientBuckets {
+        std::array<double, kRpcClassCount> tokens{};
+        std::int64_t last_refill_us = 0;
+    };
+
+    static std::int64_t NowMicros() {
+        return std::chrono::duration_cast<std::chrono::microseconds>(
+                   std::chrono::steady_clock::now().time_since_epoch())
+            .count();
+    }
+
+    void RefillLocked(ClientBuckets& buckets, std::int64_t now_us) const {
+        const std::int64_t elapsed_us = now_us - buckets.last_refill_us;
+        if (elapsed_us <= 0) {
+            return;
+        }
+        const double elapsed_seconds = static_cast<double>(elapsed_us) / 1e6;
+        for (std::size_t i = 0; i < kRpcClassCount; ++i) {
+            const double refilled =
+                buckets.tokens[i] + elapsed_seconds * configs_[i].tokens_per_second;
+            buckets.tokens[i] = refilled < configs_[i].burst ? refilled : configs_[i].burst;
+        }
+        buckets.last_refill_us = now_us;
+    }
+
+    void EvictIdleLocked(std::int64_t now_us) {
+        const std::int64_t idle_cutoff_us = now_us - kIdleEvictSeconds * 1'000'000;
+        for (auto it = clients_.begin(); it != clients_.end();) {
+            if (it->second.last_refill_us < idle_cutoff_us) {
+                it = clients_.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+
+    const std::array<RateLimitConfig, kRpcClassCount> configs_;
+    mutable std::mutex mutex_;
+    std::unordered_map<std::string, ClientBuckets, StringHash, std::equal_to<>> clients_;
+    std::array<std::atomic<std::uint64_t>, kRpcClassCount> admitted_{};
+    std::array<std::atomic<std::uint64_t>, kRpcClassCount> rejected_{};
+};
+
+} // namespace net
+
+#endif // NET_CLIENTRATELIMITER_H
@@ -0,0 +1,54 @@
+/*
+ * File: GrpcCompressionPolicy.h
+ * Description: Shared size-based per-RPC gRPC compression policy.
+ */
+#ifndef NET_GRPCCOMPRESSIONPOLICY_H
+#define NET_GRPCCOMPRESSIONPOLICY_H
+
+#include <cstddef>
+
+#include <grpcpp/grpcpp.h>
+
+namespace net {
+
+// Per-RPC compression policy shared by the strategy server and the
+// clients. QueryGameState responses carrying state_json run to hundreds
+// of KB over WAN links and gzip well; small hot messages such as
+// CalculateDamage cost more CPU to deflate than the bytes saved. The
+// decision is therefore made per message from its serialized size
+// instead of per channel. gRPC C++ ships gzip and deflate only — the
+// codec set is not pluggable, so zstd would require forking the
+// library; gzip is what this policy applies.
+
+/**
+ * @brief Payloads at or above this many bytes are gzip-compressed.
+ *
+ * Below this size the gzip header plus CPU cost outweighs the savings
+ * for the JSON-ish payloads this tree sends.
+ */
+inline constexpr std::size_t kCompressionThresholdBytes = 4096;
+
+/**
+ * @brief Whether a payload of the given serialized size should be compressed.
+ */
+inline bool ShouldCompress(std::size_t payload_bytes) {
+    return payload_bytes >= kCompressionThresholdBytes;
+}
+
+/**
+ * @brief Apply the size policy to a call context.
+ *
+ * Works with grpc::ServerContext and grpc::CallbackServerContext (set
+ * before the handler returns, i.e. before the response is sent) as well
+ * as grpc::ClientContext (set before the stub call, compresses the
+ * request; response decompression is transparent on the client).
+ */
+template <typename Context>
+void ApplyCompressionPolicy(Context* context, std::size_t payload_bytes) {
+    context->set_compression_algorithm(
+        ShouldCompress(payload_bytes) ? GRPC_COMPRESS_GZIP : GRPC_COMPRESS_NONE);
+}
+
+} // namespace net
+
+#endif // NET_GRPCCOMPRESSIONPOLICY_H
@@ -0,0 +1,120 @@
+/*
+ * File: BinaryCodec.h
+ * Description: Shared little-endian binary encode/decode primitives.
+ */
+#ifndef SERIALIZATION_BINARYCODEC_H
+#define SERIALIZATION_BINARYCODEC_H
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace serialization {
+
+// Wire conventions shared by save files, RPC payload bodies, and
+// replication messages: fixed-width little-endian fields, strings and
+// repeated sections length-prefixed with uint32 so readers can validate
+// before touching the payload. Writers append to a std::string; readers
+// walk a caller-owned buffer without copying (see ReadStringView).
+
+/**
+ * @brief Append a trivially copyable value in its in-memory byte order.
+ */
+template <typename T>
+void AppendPod(std::string& out, T value) {
+    static_assert(std::is_trivially_copyable_v<T>);
+    char bytes[sizeof(T)];
+    std::memcpy(bytes, &value, sizeof(T));
+    out.append(bytes, sizeof(T));
+}
+
+/**
+ * @brief Append a uint32 length prefix followed by the string bytes.
+ */
+inline void AppendString(std::string& out, std::string_view value) {
+    AppendPod(out, static_cast<std::uint32_t>(value.size()));
+    out.append(value);
+}
+
+/**
+ * @brief Bounds-checked sequential reader over an encoded buffer.
+ *
+ * The reader borrows the buffer; string_view results stay valid only
+ * while the buffer outlives them. Every Read* returns false instead of
+ * reading past the end, so a truncated or corrupt message fails cleanly
+ * partway through instead of crashing.
+ */
+class ByteReader {
+public:
+    explicit ByteReader(std::string_view data) : data_(data) {}
+
+    template <typename T>
+    bool ReadPod(T& value) {
+        static_assert(std::is_trivially_copyable_v<T>);
+        if (pos_ + sizeof(T) > data_.size()) {
+            return false;
+        }
+        std::memcpy(&value, data_.data() + pos_, sizeof(T));
+        pos_ += sizeof(T);
+        return true;
+    }
+
+    /**
+     * @brief Read a length-prefixed string into an owning std::string.
+     */
+    bool ReadString(std::string& value) {
+        std::string_view view;
+        if (!ReadStringView(view)) {
+            return false;
+        }
+        value.assign(view);
+        return true;
+    }
+
+    /**
+     * @brief Read a length-prefixed string as a view into the buffer.
+     *
+     * Zero-copy: no allocation, the view aliases the encoded buffer.
+     */
+    bool ReadStringView(std::string_view& value) {
+        std::uint32_t length = 0;
+        if (!ReadPod(length) || pos_ + length > data_.size()) {
+            return false;
+        }
+        value = data_.substr(pos_, length);
+        pos_ += length;
+        return true;
+    }
+
+    /**
+     * @brief Consume the remainder of the buffer as an owning string.
+     */
+    bool ReadRest(std::string& value) {
+        value.assign(data_.substr(pos_));
+        pos_ = data_.size();
+        return true;
+    }
+
+    /**
+     * @brief Consume the remainder of the buffer as a view.
+     */
+    bool ReadRestView(std::string_view& value) {
+        value = data_.substr(pos_);
+        pos_ = data_.size();
+        return true;
+    }
+
+    bool AtEnd() const { return pos_ == data_.size(); }
+
+    std::size_t Position() const { return pos_; }
+
+private:
+    std::string_view data_;
+    std::size_t pos_ = 0;
+};
+
+} // namespace serialization
+
+#endif // SERIALIZATION_BINARYCODEC_H
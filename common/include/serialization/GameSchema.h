@@ -0,0 +1,113 @@
+/*
+ * File: GameSchema.h
+ * Description: Versioned binary schema for core game types shared by all layers.
+ */
+#ifndef SERIALIZATION_GAMESCHEMA_H
+#define SERIALIZATION_GAMESCHEMA_H
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace serialization {
+
+// Every record shares one frame: 4-byte magic 'FLSR', uint16 schema
+// version, uint8 record type, then the type-specific payload. The same
+// frame is valid as a save-file section, an RPC payload body, or a
+// replication message, so a battle result is encoded once and read by
+// all three consumers without re-conversion.
+
+constexpr std::uint16_t kSchemaVersion = 1;
+
+/**
+ * @brief Record type discriminator carried in the frame header.
+ */
+enum class RecordType : std::uint8_t {
+    CharacterStats = 1,
+    WorldDelta = 2,
+    BattleResult = 3,
+};
+
+/**
+ * @brief Character stat block as exchanged between the layers.
+ *
+ * Field set mirrors algorithm::CharacterStats' combat-relevant columns;
+ * presentation-only data (name text, icons) stays out of the schema.
+ */
+struct CharacterStatsRecord {
+    std::int32_t character_id = 0;
+    std::int32_t level = 1;
+    float current_hp = 0.0f;
+    float max_hp = 0.0f;
+    float current_mp = 0.0f;
+    float max_mp = 0.0f;
+    float attack = 0.0f;
+    float defense = 0.0f;
+    float magic_attack = 0.0f;
+    float magic_defense = 0.0f;
+    float speed = 0.0f;
+};
+
+/**
+ * @brief One key change inside a world delta.
+ *
+ * The key is a view into the decoded buffer — zero-copy, valid only
+ * while that buffer outlives the record. Copy the view if the change
+ * must be retained past the buffer's lifetime.
+ */
+struct WorldDeltaEntry {
+    std::string_view key;
+    bool is_flag = false;
+    bool bool_value = false;
+    std::int32_t int_value = 0;
+};
+
+/**
+ * @brief Batch of world state changes since a known sequence number.
+ */
+struct WorldDeltaRecord {
+    std::uint64_t sequence = 0;
+    std::vector<WorldDeltaEntry> changes;
+};
+
+/**
+ * @brief Outcome of one combat exchange.
+ *
+ * The effect text is a view into the decoded buffer (see
+ * WorldDeltaEntry for the lifetime rule).
+ */
+struct BattleResultRecord {
+    std::int32_t attacker_id = 0;
+    std::int32_t defender_id = 0;
+    std::int32_t damage = 0;
+    bool is_critical = false;
+    float remaining_hp = 0.0f;
+    std::string_view effect;
+};
+
+/**
+ * @brief Check whether a buffer starts with the shared frame header.
+ */
+bool IsSchemaFrame(std::string_view data);
+
+/**
+ * @brief Read the record type of a frame without decoding the payload.
+ * @return true when the frame header is valid and the version matches.
+ */
+bool PeekRecordType(std::string_view data, RecordType& type);
+
+std::string Encode(const CharacterStatsRecord& record);
+std::string Encode(const WorldDeltaRecord& record);
+std::string Encode(const BattleResultRecord& record);
+
+// Decoders validate the frame, version, and record type, then fill the
+// record from the payload. View fields alias `data`; the caller keeps
+// the buffer alive for as long as the record is used.
+bool Decode(std::string_view data, CharacterStatsRecord& record);
+bool Decode(std::string_view data, WorldDeltaRecord& record);
+bool Decode(std::string_view data, BattleResultRecord& record);
+
+} // namespace serialization
+
+#endif // SERIALIZATION_GAMESCHEMA_H
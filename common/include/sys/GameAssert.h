@@ -0,0 +1,101 @@
+/*
+ * File: GameAssert.h
+ * Description: Tiered assertion macros shared by all layers, compiled out by build profile.
+ */
+#ifndef SYS_GAMEASSERT_H
+#define SYS_GAMEASSERT_H
+
+#include <cstdio>
+#include <cstdlib>
+
+// Hot paths (damage batches, event dispatch, the connection-pool free ring)
+// had accumulated defensive checks that every build paid for. This header
+// splits them into three tiers so that production keeps only the checks
+// whose failure would corrupt state, while the cheaper-to-skip invariants
+// stay available in development builds:
+//
+//   GAME_ASSERT          always active, every build profile
+//   GAME_DEBUG_ASSERT    active when GAME_ASSERT_LEVEL >= 1
+//   GAME_PARANOID_ASSERT active when GAME_ASSERT_LEVEL >= 2 (per-element
+//                        checks inside tight loops)
+//
+// GAME_ASSERT_LEVEL is normally injected by the root CMakeLists.txt
+// (Debug = 2, RelWithDebInfo = 1, Release/MinSizeRel = 0, overridable via
+// the GAME_ASSERT_LEVEL cache variable). When building a translation unit
+// outside CMake the fallback below derives the tier from NDEBUG.
+//
+// Checks that are part of an interface contract — returning an error
+// result for a null skill, throwing std::invalid_argument for a bad
+// argument — are not assertions and must not be converted to this tier
+// system; these macros are for internal invariants only.
+
+#ifndef GAME_ASSERT_LEVEL
+#ifdef NDEBUG
+#define GAME_ASSERT_LEVEL 0
+#else
+#define GAME_ASSERT_LEVEL 2
+#endif
+#endif
+
+// Failure path shared by every tier: report and abort. Assertions guard
+// invariants, so there is no recovery story — continuing would run on
+// corrupted state.
+#define GAME_ASSERT_FAIL_(tier, expr)                                        \
+    do {                                                                     \
+        std::fprintf(stderr, "%s failed: %s (%s:%d)\n",                      \
+                     tier, expr, __FILE__, __LINE__);                        \
+        std::abort();                                                        \
+    } while (0)
+
+// Disabled tiers keep the expression inside an unreachable branch: it is
+// never evaluated and folds away entirely, but it still compiles, so
+// variables used only by assertions do not trip -Werror when the tier is
+// compiled out and the expression cannot silently rot.
+#define GAME_ASSERT_DISABLED_(expr)                                          \
+    do {                                                                     \
+        if (false) {                                                         \
+            (void)(expr);                                                    \
+        }                                                                    \
+    } while (0)
+
+/**
+ * @brief Safety-critical invariant; checked in every build profile.
+ */
+#define GAME_ASSERT(expr)                                                    \
+    do {                                                                     \
+        if (!(expr)) {                                                       \
+            GAME_ASSERT_FAIL_("GAME_ASSERT", #expr);                         \
+        }                                                                    \
+    } while (0)
+
+/**
+ * @brief Internal precondition already guaranteed by callers; development
+ *        builds verify it, production builds compile it out.
+ */
+#if GAME_ASSERT_LEVEL >= 1
+#define GAME_DEBUG_ASSERT(expr)                                              \
+    do {                                                                     \
+        if (!(expr)) {                                                       \
+            GAME_ASSERT_FAIL_("GAME_DEBUG_ASSERT", #expr);                   \
+        }                                                                    \
+    } while (0)
+#else
+#define GAME_DEBUG_ASSERT(expr) GAME_ASSERT_DISABLED_(expr)
+#endif
+
+/**
+ * @brief Per-element invariant inside a tight loop; too expensive for
+ *        anything but full debug builds.
+ */
+#if GAME_ASSERT_LEVEL >= 2
+#define GAME_PARANOID_ASSERT(expr)                                           \
+    do {                                                                     \
+        if (!(expr)) {                                                       \
+            GAME_ASSERT_FAIL_("GAME_PARANOID_ASSERT", #expr);                \
+        }                                                                    \
+    } while (0)
+#else
+#define GAME_PARANOID_ASSERT(expr) GAME_ASSERT_DISABLED_(expr)
+#endif
+
+#endif // SYS_GAMEASSERT_H
@@ -0,0 +1,107 @@
+/*
+ * File: TraceRing.h
+ * Description: Fixed-size per-process ring buffer for cross-layer trace events.
+ */
+#ifndef TRACE_TRACERING_H
+#define TRACE_TRACERING_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace trace {
+
+/**
+ * @brief One hop of a traced action.
+ *
+ * The trace id is generated by the first hop (the client) and carried
+ * through gRPC metadata; timestamps use the system clock in
+ * microseconds so events from different processes on the same host
+ * merge onto one timeline.
+ */
+struct TraceEvent {
+    std::uint64_t trace_id = 0;
+    std::int64_t timestamp_us = 0;
+    char hop[24] = {};
+};
+
+/**
+ * @brief Lock-free fixed-capacity trace event ring.
+ *
+ * Recording is an atomic index bump plus a plain slot write — cheap
+ * enough to leave enabled in production. The ring overwrites oldest
+ * events; snapshots are best-effort diagnostics and may observe a slot
+ * mid-overwrite under heavy write pressure, which shows up as one
+ * garbled event rather than a crash.
+ */
+class TraceRing {
+public:
+    static constexpr std::size_t CAPACITY = 4096;
+
+    /**
+     * @brief Record one hop for a trace id at the current time.
+     */
+    void Record(std::uint64_t trace_id, const char* hop) {
+        const std::size_t index =
+            next_.fetch_add(1, std::memory_order_relaxed) % CAPACITY;
+        TraceEvent& slot = events_[index];
+        slot.trace_id = trace_id;
+        slot.timestamp_us = NowMicros();
+        std::strncpy(slot.hop, hop, sizeof(slot.hop) - 1);
+        slot.hop[sizeof(slot.hop) - 1] = '\0';
+    }
+
+    /**
+     * @brief Copy out all recorded events, oldest first.
+     */
+    std::vector<TraceEvent> Snapshot() const {
+        std::vector<TraceEvent> out;
+        out.reserve(CAPACITY);
+        const std::size_t next = next_.load(std::memory_order_relaxed);
+        const std::size_t count = next < CAPACITY ? next : CAPACITY;
+        const std::size_t start = next < CAPACITY ? 0 : next % CAPACITY;
+        for (std::size_t i = 0; i < count; ++i) {
+            const TraceEvent& event = events_[(start + i) % CAPACITY];
+            if (event.trace_id != 0) {
+                out.push_back(event);
+            }
+        }
+        return out;
+    }
+
+    /**
+     * @brief Write the ring as CSV (trace_id,timestamp_us,hop).
+     *
+     * The format is what tools/trace_merge consumes.
+     */
+    bool DumpCsv(const std::string& path) const {
+        std::ofstream file(path, std::ios::trunc);
+        if (!file.is_open()) {
+            return false;
+        }
+        for (const TraceEvent& event : Snapshot()) {
+            file << event.trace_id << ',' << event.timestamp_us << ','
+                 << event.hop << '\n';
+        }
+        return file.good();
+    }
+
+private:
+    static std::int64_t NowMicros() {
+        return std::chrono::duration_cast<std::chrono::microseconds>(
+                   std::chrono::system_clock::now().time_since_epoch())
+            .count();
+    }
+
+    std::array<TraceEvent, CAPACITY> events_{};
+    std::atomic<std::size_t> next_{0};
+};
+
+} // namespace trace
+
+#endif // TRACE_TRACERING_H
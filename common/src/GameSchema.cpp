@@ -0,0 +1,172 @@
+/*
+ * File: GameSchema.cpp
+ * Description: Versioned binary schema implementation.
+ */
+
+#include "serialization/GameSchema.h"
+
+#include "serialization/BinaryCodec.h"
+
+#include <cstring>
+
+namespace {
+
+constexpr char kFrameMagic[4] = {'F', 'L', 'S', 'R'};
+
+std::string EncodeFrameHeader(serialization::RecordType type) {
+    std::string out;
+    out.append(kFrameMagic, sizeof(kFrameMagic));
+    serialization::AppendPod(out, serialization::kSchemaVersion);
+    serialization::AppendPod(out, static_cast<std::uint8_t>(type));
+    return out;
+}
+
+bool DecodeFrameHeader(serialization::ByteReader& reader,
+                       serialization::RecordType expected) {
+    char magic[sizeof(kFrameMagic)];
+    for (char& byte : magic) {
+        if (!reader.ReadPod(byte)) {
+            return false;
+        }
+    }
+    if (std::memcmp(magic, kFrameMagic, sizeof(kFrameMagic)) != 0) {
+        return false;
+    }
+
+    std::uint16_t version = 0;
+    if (!reader.ReadPod(version) || version != serialization::kSchemaVersion) {
+        return false;
+    }
+
+    std::uint8_t type = 0;
+    return reader.ReadPod(type) &&
+           type == static_cast<std::uint8_t>(expected);
+}
+
+} // namespace
+
+namespace serialization {
+
+bool IsSchemaFrame(std::string_view data) {
+    return data.size() >= sizeof(kFrameMagic) &&
+           std::memcmp(data.data(), kFrameMagic, sizeof(kFrameMagic)) == 0;
+}
+
+bool PeekRecordType(std::string_view data, RecordType& type) {
+    if (!IsSchemaFrame(data)) {
+        return false;
+    }
+
+    ByteReader reader(data.substr(sizeof(kFrameMagic)));
+    std::uint16_t version = 0;
+    std::uint8_t raw_type = 0;
+    if (!reader.ReadPod(version) || version != kSchemaVersion ||
+        !reader.ReadPod(raw_type)) {
+        return false;
+    }
+
+    type = static_cast<RecordType>(raw_type);
+    return true;
+}
+
+std::string Encode(const CharacterStatsRecord& record) {
+    std::string out = EncodeFrameHeader(RecordType::CharacterStats);
+    AppendPod(out, record.character_id);
+    AppendPod(out, record.level);
+    AppendPod(out, record.current_hp);
+    AppendPod(out, record.max_hp);
+    AppendPod(out, record.current_mp);
+    AppendPod(out, record.max_mp);
+    AppendPod(out, record.attack);
+    AppendPod(out, record.defense);
+    AppendPod(out, record.magic_attack);
+    AppendPod(out, record.magic_defense);
+    AppendPod(out, record.speed);
+    return out;
+}
+
+std::string Encode(const WorldDeltaRecord& record) {
+    std::string out = EncodeFrameHeader(RecordType::WorldDelta);
+    AppendPod(out, record.sequence);
+    AppendPod(out, static_cast<std::uint32_t>(record.changes.size()));
+    for (const WorldDeltaEntry& change : record.changes) {
+        AppendString(out, change.key);
+        AppendPod(out, static_cast<std::uint8_t>(change.is_flag ? 1 : 0));
+        AppendPod(out, static_cast<std::uint8_t>(change.bool_value ? 1 : 0));
+        AppendPod(out, change.int_value);
+    }
+    return out;
+}
+
+std::string Encode(const BattleResultRecord& record) {
+    std::string out = EncodeFrameHeader(RecordType::BattleResult);
+    AppendPod(out, record.attacker_id);
+    AppendPod(out, record.defender_id);
+    AppendPod(out, record.damage);
+    AppendPod(out, static_cast<std::uint8_t>(record.is_critical ? 1 : 0));
+    AppendPod(out, record.remaining_hp);
+    AppendString(out, record.effect);
+    return out;
+}
+
+bool Decode(std::string_view data, CharacterStatsRecord& record) {
+    ByteReader reader(data);
+    return DecodeFrameHeader(reader, RecordType::CharacterStats) &&
+           reader.ReadPod(record.character_id) &&
+           reader.ReadPod(record.level) &&
+           reader.ReadPod(record.current_hp) &&
+           reader.ReadPod(record.max_hp) &&
+           reader.ReadPod(record.current_mp) &&
+           reader.ReadPod(record.max_mp) &&
+           reader.ReadPod(record.attack) &&
+           reader.ReadPod(record.defense) &&
+           reader.ReadPod(record.magic_attack) &&
+           reader.ReadPod(record.magic_defense) &&
+           reader.ReadPod(record.speed);
+}
+
+bool Decode(std::string_view data, WorldDeltaRecord& record) {
+    ByteReader reader(data);
+    if (!DecodeFrameHeader(reader, RecordType::WorldDelta)) {
+        return false;
+    }
+
+    std::uint32_t count = 0;
+    if (!reader.ReadPod(record.sequence) || !reader.ReadPod(count)) {
+        return false;
+    }
+
+    record.changes.clear();
+    record.changes.reserve(count);
+    for (std::uint32_t i = 0; i < count; ++i) {
+        WorldDeltaEntry change;
+        std::uint8_t is_flag = 0;
+        std::uint8_t bool_value = 0;
+        if (!reader.ReadStringView(change.key) || !reader.ReadPod(is_flag) ||
+            !reader.ReadPod(bool_value) || !reader.ReadPod(change.int_value)) {
+            return false;
+        }
+        change.is_flag = is_flag != 0;
+        change.bool_value = bool_value != 0;
+        record.changes.push_back(change);
+    }
+    return true;
+}
+
+bool Decode(std::string_view data, BattleResultRecord& record) {
+    ByteReader reader(data);
+    std::uint8_t is_critical = 0;
+    if (!DecodeFrameHeader(reader, RecordType::BattleResult) ||
+        !reader.ReadPod(record.attacker_id) ||
+        !reader.ReadPod(record.defender_id) ||
+        !reader.ReadPod(record.damage) ||
+        !reader.ReadPod(is_critical) ||
+        !reader.ReadPod(record.remaining_hp) ||
+        !reader.ReadStringView(record.effect)) {
+        return false;
+    }
+    record.is_critical = is_critical != 0;
+    return true;
+}
+
+} // namespace serialization
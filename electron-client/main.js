@@ -152,6 +152,14 @@ ipcMain.handle("strategy:query-state", (_, request) =>
     invokeRpc(strategyClient, "QueryGameState", request)
 );
 
+ipcMain.handle("strategy:asset-manifest", (_, request) =>
+    invokeRpc(strategyClient, "GetAssetManifest", request)
+);
+
+ipcMain.handle("strategy:asset-chunk", (_, request) =>
+    invokeRpc(strategyClient, "GetAssetChunk", request)
+);
+
 app.whenReady().then(() => {
     createWindow();
 
@@ -9,5 +9,7 @@ contextBridge.exposeInMainWorld("gameApi", {
     getGameRules: (request) => ipcRenderer.invoke("strategy:game-rules", request),
     updateWorldState: (request) => ipcRenderer.invoke("strategy:update-world", request),
     triggerEvent: (request) => ipcRenderer.invoke("strategy:trigger-event", request),
-    queryGameState: (request) => ipcRenderer.invoke("strategy:query-state", request)
+    queryGameState: (request) => ipcRenderer.invoke("strategy:query-state", request),
+    getAssetManifest: (request) => ipcRenderer.invoke("strategy:asset-manifest", request),
+    getAssetChunk: (request) => ipcRenderer.invoke("strategy:asset-chunk", request)
 });
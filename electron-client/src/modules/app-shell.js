@@ -6,6 +6,7 @@
       jobs,
       localState,
       backendSync,
+      assetSync,
       safeOn,
       showToast,
       setView,
@@ -221,6 +222,10 @@
       renderChapterSummary();
       refreshWorldMapLayout(false);
       backendSync.bootstrapFromBackend();
+      // Asset sync is incremental (chunk cache keyed by content hash)
+      // and resumable, so kicking it off at every boot is cheap: an
+      // unchanged manifest costs one round trip.
+      assetSync?.syncAssets?.().catch(() => {});
     }
 
     return Object.freeze({
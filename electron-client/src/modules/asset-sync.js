@@ -0,0 +1,181 @@
+(function initFantasyAssetSyncModule() {
+  const MANIFEST_CACHE_KEY = 'asset_manifest_v1';
+  const CHUNK_CACHE_PREFIX = 'asset_chunk_v1:';
+  const CHUNK_RETRY_LIMIT = 3;
+
+  function toUint8Array(data) {
+    if (data instanceof Uint8Array) return data;
+    if (Array.isArray(data)) return Uint8Array.from(data);
+    if (data && typeof data === 'object' && Array.isArray(data.data)) {
+      return Uint8Array.from(data.data);
+    }
+    return new Uint8Array(0);
+  }
+
+  function bytesToBase64(bytes) {
+    let binary = '';
+    const STRIDE = 0x8000;
+    for (let i = 0; i < bytes.length; i += STRIDE) {
+      binary += String.fromCharCode.apply(null, bytes.subarray(i, i + STRIDE));
+    }
+    return btoa(binary);
+  }
+
+  function base64ToBytes(encoded) {
+    const binary = atob(encoded);
+    const bytes = new Uint8Array(binary.length);
+    for (let i = 0; i < binary.length; i += 1) {
+      bytes[i] = binary.charCodeAt(i);
+    }
+    return bytes;
+  }
+
+  async function sha256Hex(bytes) {
+    if (!window.crypto?.subtle) return null;
+    const digest = await window.crypto.subtle.digest('SHA-256', bytes);
+    return Array.from(new Uint8Array(digest))
+      .map((byte) => byte.toString(16).padStart(2, '0'))
+      .join('');
+  }
+
+  function createAssetSyncModule(deps) {
+    const {
+      appendLog,
+      services = window.FantasyGameServices,
+      storage = window.localStorage
+    } = deps || {};
+
+    if (!services) {
+      throw new Error('FantasyGameServices failed to load.');
+    }
+
+    const assets = new Map();
+    const log = typeof appendLog === 'function' ? appendLog : () => {};
+
+    function readCachedManifest() {
+      try {
+        const parsed = JSON.parse(storage.getItem(MANIFEST_CACHE_KEY) || 'null');
+        return parsed && Array.isArray(parsed.assets) ? parsed : null;
+      } catch {
+        return null;
+      }
+    }
+
+    function readCachedChunk(hash) {
+      const encoded = storage.getItem(CHUNK_CACHE_PREFIX + hash);
+      if (!encoded) return null;
+      try {
+        return base64ToBytes(encoded);
+      } catch {
+        storage.removeItem(CHUNK_CACHE_PREFIX + hash);
+        return null;
+      }
+    }
+
+    function writeCachedChunk(hash, bytes) {
+      try {
+        storage.setItem(CHUNK_CACHE_PREFIX + hash, bytesToBase64(bytes));
+      } catch {
+        // Cache full: the chunk still lands in memory for this session;
+        // the next visit re-downloads whatever did not fit.
+      }
+    }
+
+    async function fetchManifest() {
+      const cached = readCachedManifest();
+      const response = await services.getAssetManifest({
+        known_version: cached ? String(cached.version) : '0'
+      });
+      if (response.up_to_date && cached) {
+        return cached;
+      }
+      const manifest = {
+        version: Number(response.version) || 0,
+        assets: Array.isArray(response.assets) ? response.assets : []
+      };
+      storage.setItem(MANIFEST_CACHE_KEY, JSON.stringify(manifest));
+      return manifest;
+    }
+
+    async function fetchChunk(chunk) {
+      let lastError = null;
+      for (let attempt = 0; attempt < CHUNK_RETRY_LIMIT; attempt += 1) {
+        try {
+          const response = await services.getAssetChunk({ chunk_hash: chunk.hash });
+          if (!response.found) {
+            throw new Error('chunk not found: ' + chunk.hash);
+          }
+          const bytes = toUint8Array(response.data);
+          const digest = await sha256Hex(bytes);
+          if (digest && digest !== chunk.hash) {
+            throw new Error('chunk hash mismatch: ' + chunk.hash);
+          }
+          return bytes;
+        } catch (error) {
+          lastError = error;
+        }
+      }
+      throw lastError;
+    }
+
+    async function assembleAsset(assetInfo) {
+      const buffer = new Uint8Array(Number(assetInfo.size) || 0);
+      let downloaded = 0;
+      for (const chunk of assetInfo.chunks || []) {
+        let bytes = readCachedChunk(chunk.hash);
+        if (!bytes || bytes.length !== Number(chunk.size)) {
+          bytes = await fetchChunk(chunk);
+          writeCachedChunk(chunk.hash, bytes);
+          downloaded += 1;
+        }
+        buffer.set(bytes, Number(chunk.offset));
+      }
+      assets.set(assetInfo.name, buffer);
+      return downloaded;
+    }
+
+    // Incremental, resumable sync: every received chunk is cached by
+    // content hash before the next request, so a dropped connection
+    // resumes from the first missing chunk instead of from zero, and
+    // repeat visits transfer only chunks whose hash changed.
+    async function syncAssets() {
+      const manifest = await fetchManifest();
+      let downloaded = 0;
+      let failed = 0;
+      for (const assetInfo of manifest.assets) {
+        try {
+          downloaded += await assembleAsset(assetInfo);
+        } catch (error) {
+          failed += 1;
+          log('资源同步失败: ' + assetInfo.name + ' (' + (error.details || error.message || error) + ')');
+        }
+      }
+      log('资源同步完成: ' + assets.size + ' 个资源，新下载 ' + downloaded + ' 个块' + (failed ? '，' + failed + ' 个失败' : ''));
+      return { assetCount: assets.size, downloadedChunks: downloaded, failedAssets: failed };
+    }
+
+    function getAsset(name) {
+      return assets.get(name) || null;
+    }
+
+    function clearChunkCache() {
+      const doomed = [];
+      for (let i = 0; i < storage.length; i += 1) {
+        const key = storage.key(i);
+        if (key && key.startsWith(CHUNK_CACHE_PREFIX)) doomed.push(key);
+      }
+      doomed.forEach((key) => storage.removeItem(key));
+      storage.removeItem(MANIFEST_CACHE_KEY);
+    }
+
+    return Object.freeze({
+      syncAssets,
+      getAsset,
+      clearChunkCache
+    });
+  }
+
+  window.FantasyAssetSyncModule = Object.freeze({
+    createAssetSyncModule
+  });
+})();
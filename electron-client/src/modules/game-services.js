@@ -48,7 +48,9 @@
       getGameRules: (request) => invoke('getGameRules', request),
       updateWorldState: (request) => invoke('updateWorldState', request),
       triggerEvent: (request) => invoke('triggerEvent', request),
-      queryGameState: (request) => invoke('queryGameState', request)
+      queryGameState: (request) => invoke('queryGameState', request),
+      getAssetManifest: (request) => invoke('getAssetManifest', request),
+      getAssetChunk: (request) => invoke('getAssetChunk', request)
     });
   }
 
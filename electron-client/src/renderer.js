@@ -104,6 +104,14 @@ if (!window.FantasyBackendSyncModule) {
   throw new Error("FantasyBackendSyncModule failed to load.");
 }
 
+const {
+  createAssetSyncModule
+} = window.FantasyAssetSyncModule || {};
+
+if (!window.FantasyAssetSyncModule) {
+  throw new Error("FantasyAssetSyncModule failed to load.");
+}
+
 const {
   createAppShellModule
 } = window.FantasyAppShellModule || {};
@@ -215,6 +223,13 @@ const backendSync = createBackendSyncModule({
   storage: window.localStorage
 });
 
+const assetSync = createAssetSyncModule({
+  appendLog,
+  storage: window.localStorage
+});
+
+window.FantasyAssetSyncRuntime = assetSync;
+
 const gameplayRuntime = createGameplayRuntimeModule({
   state,
   refs,
@@ -400,6 +415,7 @@ const appShellRuntime = createAppShellModule({
   jobs: JOBS,
   localState,
   backendSync,
+  assetSync,
   safeOn,
   showToast,
   setView,
@@ -0,0 +1,134 @@
+/*
+ * File: AITickScheduler.h
+ * Description: Relevance-tiered scheduler for AI decision ticks.
+ */
+#ifndef STRATEGY_AITICKSCHEDULER_H
+#define STRATEGY_AITICKSCHEDULER_H
+
+#include "AIDecisionEngine.h"
+#include "SpatialIndex.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace strategy {
+
+/**
+ * @brief Relevance tier an NPC is currently ticked at.
+ */
+enum class AITickTier {
+    ACTIVE,     ///< near a player: decisions at full tick rate
+    DISTANT,    ///< no player nearby: 1/10th rate, batched with peers
+    SLEEPING    ///< passive and unwoken: no decisions at all
+};
+
+/**
+ * @brief Schedules AI decision requests by NPC relevance.
+ *
+ * Ticking every registered NPC at full rate makes AI cost scale with
+ * world population instead of active gameplay. This scheduler sorts
+ * NPCs into three tiers each tick: NPCs within ACTIVE_RADIUS of any
+ * player tick every tick; distant NPCs tick every DISTANT_DIVISOR-th
+ * tick, staggered by id so they spread evenly instead of spiking, and
+ * all distant NPCs due on the same tick are dispatched in one batch so
+ * the catch-up work goes through the batch decision path; Passive NPCs
+ * (algorithm::NPCType::Passive) sleep entirely until an event wakes
+ * them, after which they run at full rate for a bounded number of
+ * ticks and go back to sleep.
+ *
+ * NPC positions live in a uniform-grid SpatialIndex; each tick computes
+ * the active set with one batched radius query around the tracked
+ * players, so relevance sorting costs O(NPCs near players) plus a flat
+ * pass over the registry instead of an O(NPCs x players) distance scan.
+ *
+ * Decisions are issued through the injected batch sink (one call per
+ * tick with every due NPC id), which keeps the scheduler free of a
+ * direct AlgorithmInterface dependency and lets tests observe the
+ * dispatch pattern directly.
+ */
+class AITickScheduler {
+public:
+    /** @brief Called once per tick with the ids due this tick. */
+    using DecisionBatchSink = std::function<void(const std::vector<int>& npc_ids)>;
+
+    /** @brief NPCs within this distance of a player are ACTIVE. */
+    static constexpr float ACTIVE_RADIUS = 50.0f;
+
+    /** @brief Distant NPCs tick once every this many ticks. */
+    static constexpr int DISTANT_DIVISOR = 10;
+
+    /** @brief Full-rate ticks a woken passive NPC stays awake. */
+    static constexpr int DEFAULT_WAKE_TICKS = 10;
+
+    explicit AITickScheduler(DecisionBatchSink sink = nullptr);
+
+    /** @brief Replace the batch sink; a null sink drops dispatches. */
+    void SetSink(DecisionBatchSink sink);
+
+    /**
+     * @brief Register an NPC with its type and position.
+     *
+     * Passive-typed NPCs start SLEEPING; everything else starts in the
+     * distance-derived tier on the next tick.
+     */
+    void RegisterNPC(int npc_id, algorithm::NPCType type, float x, float y);
+
+    void UnregisterNPC(int npc_id);
+
+    void UpdateNPCPosition(int npc_id, float x, float y);
+
+    /** @brief Track a player position used for relevance distances. */
+    void UpdatePlayerPosition(int player_id, float x, float y);
+
+    void RemovePlayer(int player_id);
+
+    /**
+     * @brief Wake a sleeping passive NPC for a bounded burst of ticks.
+     *
+     * Non-passive NPCs ignore the call (their tier is distance-driven).
+     * Unknown ids are ignored so event fan-out can wake blindly.
+     */
+    void WakeNPC(int npc_id, int wake_ticks = DEFAULT_WAKE_TICKS);
+
+    /**
+     * @brief Advance one full-rate tick and dispatch due NPCs as a batch.
+     * @return Number of NPCs dispatched this tick.
+     */
+    std::size_t Tick();
+
+    /** @brief Tier the NPC would tick at right now (diagnostics/tests). */
+    AITickTier TierOf(int npc_id) const;
+
+    std::size_t RegisteredCount() const;
+
+private:
+    struct NPCEntry {
+        bool passive;
+        int wake_ticks_left;
+    };
+
+    struct PlayerPosition {
+        float x;
+        float y;
+    };
+
+    bool NearAnyPlayerLocked(float x, float y) const;
+    AITickTier TierOfLocked(int npc_id, const NPCEntry& entry) const;
+
+    mutable std::mutex mutex_;
+    std::unordered_map<int, NPCEntry> npcs_;
+    // Positions are held only by the index; the registry keeps tiering
+    // state so the two cannot drift apart.
+    SpatialIndex npc_index_;
+    std::unordered_map<int, PlayerPosition> players_;
+    std::uint64_t tick_count_ = 0;
+    DecisionBatchSink sink_;
+};
+
+} // namespace strategy
+
+#endif // STRATEGY_AITICKSCHEDULER_H
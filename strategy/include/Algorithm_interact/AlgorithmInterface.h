@@ -28,7 +28,7 @@ namespace strategy {
 
 /**
  * @brief 算法层交互接口
- * 
+ *
  * 该类作为策略层与算法层之间的桥梁，封装了所有对算法服务的调用。
  * 主要功能包括：
  * - 管理算法服务的连接和生命周期
@@ -36,6 +36,11 @@ namespace strategy {
  * - 提供AI决策服务的访问接口
  * - 支持批量操作以提高性能
  * - 提供服务状态检查和错误处理
+ *
+ * @note 传输方式：标准部署中策略服务与算法服务同机运行，本接口
+ *       直接内嵌algorithm_service静态库，所有调用都是进程内函数
+ *       调用，没有序列化和网络往返开销。50051端口的gRPC服务面向
+ *       外部客户端，策略层到算法层的调用不经过它。
  */
 class AlgorithmInterface {
 public:
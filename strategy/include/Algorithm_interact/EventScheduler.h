@@ -6,12 +6,21 @@
 #define STRATEGY_EVENTSCHEDULER_H
 
 #include "../IStrategyService.h"
+#include "../common/EventRecord.h"
+#include "../common/StringInterner.h"
 
+#include <array>
 #include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
 #include <functional>
 #include <memory>
+#include <mutex>
 #include <queue>
+#include <span>
 #include <string>
+#include <thread>
 #include <unordered_map>
 #include <vector>
 
@@ -26,32 +35,132 @@ enum class EventType {
 
 struct GameEvent {
     int event_id;
-    std::string event_name;
+    // Interned at registration; triggers and async snapshots copy a u32
+    // instead of a string (resolve via EventScheduler::EventNameOf).
+    StringId name_id = kInvalidStringId;
     EventType type;
     std::vector<int> params;
     std::function<bool()> condition;
-    std::function<std::string(const std::vector<int>&)> handler;
+    // Handlers take a span so triggers can pass pooled record params
+    // (or a caller's vector) without copying them per call.
+    std::function<std::string(std::span<const int>)> handler;
     std::chrono::steady_clock::time_point trigger_time;
     int repeat_interval_ms;
     bool is_active;
+    bool is_heavy = false;  // run on the worker pool when async mode is enabled
+};
+
+/**
+ * @brief One entry of a bulk delayed-event schedule request.
+ */
+struct DelayedEventSpec {
+    int event_id;
+    std::vector<int> params;
+    int delay_ms;
 };
 
 class EventScheduler {
 public:
+    using EventCompletionCallback = std::function<void(int, const EventTriggerResult&)>;
+
     EventScheduler();
+    ~EventScheduler();
 
     EventTriggerResult TriggerEvent(int event_id, const std::vector<int>& params);
 
+    /**
+     * @brief Trigger an event described by a pooled compact record.
+     *
+     * Hot path for high-frequency events (combat ticks, movement): the
+     * record's params are read in place, so a trigger performs no heap
+     * allocation of its own in steady state.
+     */
+    EventTriggerResult TriggerEvent(const CompactEventRecord& record);
+
+    /**
+     * @brief Build a pooled record for an event trigger.
+     *
+     * Fills the interned name id from the registry (kInvalidStringId for
+     * unknown events). Params up to EVENT_INLINE_PARAM_CAPACITY are stored
+     * inline; larger lists spill into the pool's arena. The record stays
+     * valid until ResetRecordPool().
+     */
+    CompactEventRecord& AcquireRecord(int event_id, std::span<const int> params);
+
+    /**
+     * @brief Recycle every record handed out by AcquireRecord.
+     *
+     * Called once per request (or per tick) by the owning service after
+     * results have been serialized.
+     */
+    void ResetRecordPool();
+
+    /**
+     * @brief Start the handler worker pool.
+     *
+     * While the pool runs, due events marked heavy are dispatched to a
+     * task queue and executed off the caller's thread, so a slow handler
+     * never stalls the world tick. Results of off-thread handlers are
+     * reported through the completion callback instead of the return
+     * value of ProcessPendingEvents.
+     */
+    void EnableAsyncExecution(std::size_t worker_count);
+
+    /**
+     * @brief Dispatch heavy handlers to the shared ExecutorService.
+     *
+     * Same off-thread semantics as EnableAsyncExecution but without a
+     * private worker pool: tasks ride the process-wide executor's
+     * events lane, so the scheduler adds no threads of its own. When
+     * the lane sheds, the handler degrades to inline execution in the
+     * tick. Mutually exclusive with a running private pool.
+     */
+    void EnableSharedAsyncExecution();
+
+    /**
+     * @brief Stop the worker pool, draining queued tasks inline first.
+     *
+     * Also leaves shared-executor mode; handlers run inline again.
+     */
+    void DisableAsyncExecution();
+
+    /**
+     * @brief Tag an event's handler as heavy (worker-pool candidate).
+     * @return false if the event id is unknown.
+     */
+    bool MarkEventHeavy(int event_id, bool heavy = true);
+
+    /**
+     * @brief Set the callback invoked after an off-thread handler finishes.
+     *
+     * Called from worker threads; the callback must be thread-safe.
+     */
+    void SetCompletionCallback(EventCompletionCallback callback);
+
     bool ScheduleDelayedEvent(int event_id, const std::vector<int>& params, int delay_ms);
 
+    /**
+     * @brief Move overload: the param vector is moved into the event,
+     *        so callers that hand over a temporary pay no copy.
+     */
+    bool ScheduleDelayedEvent(int event_id, std::vector<int>&& params, int delay_ms);
+
+    /**
+     * @brief Schedule a batch of delayed events (mass respawn waves etc.).
+     *
+     * Reads the clock once and inserts every entry in O(1) each.
+     * @return Number of entries that referenced a known event and were scheduled.
+     */
+    std::size_t ScheduleDelayedEvents(const std::vector<DelayedEventSpec>& specs);
+
     bool RegisterConditionalEvent(
         int event_id,
         std::function<bool()> condition,
-        std::function<std::string(const std::vector<int>&)> handler);
+        std::function<std::string(std::span<const int>)> handler);
 
     bool RegisterPeriodicEvent(
         int event_id,
-        std::function<std::string(const std::vector<int>&)> handler,
+        std::function<std::string(std::span<const int>)> handler,
         int interval_ms);
 
     std::vector<EventTriggerResult> ProcessPendingEvents();
@@ -60,20 +169,91 @@ public:
 
     bool CancelEvent(int event_id);
 
+    /**
+     * @brief Interned name id of a registered event.
+     * @return kInvalidStringId if the event id is unknown.
+     */
+    StringId GetEventNameId(int event_id) const;
+
+    /** @brief Resolve an interned event-name id (logs, diagnostics). */
+    const std::string& EventNameOf(StringId name_id) const;
+
 private:
+    /**
+     * @brief Hierarchical timer wheel with O(1) insert and expire.
+     *
+     * Four levels of 256 slots at 10 ms resolution: level 0 covers
+     * ~2.5 s, each higher level covers 256x the span below it. Entries
+     * land in the coarsest level that can hold their delay and cascade
+     * down one level at a time as the wheel turns, so neither insert
+     * nor expiry ever reheaps a global queue.
+     */
+    class TimerWheel {
+    public:
+        TimerWheel();
+
+        void Schedule(int event_id, std::chrono::steady_clock::time_point when);
+
+        /**
+         * @brief Advance the wheel to `now`, appending due event ids.
+         *
+         * Ids are appended roughly in expiry order (per 10 ms tick).
+         */
+        void Advance(std::chrono::steady_clock::time_point now, std::vector<int>& due);
+
+        bool Empty() const;
+
+    private:
+        struct TimerEntry {
+            int event_id;
+            std::uint64_t expire_tick;
+        };
+
+        static constexpr int WHEEL_LEVELS = 4;
+        static constexpr std::size_t SLOTS_PER_LEVEL = 256;
+        static constexpr int SLOT_BITS = 8;  // log2(SLOTS_PER_LEVEL)
+        static constexpr long long TICK_MS = 10;
+
+        std::array<std::array<std::vector<TimerEntry>, SLOTS_PER_LEVEL>, WHEEL_LEVELS> slots_;
+        std::vector<int> overdue_;  // scheduled at or before the current tick
+        std::chrono::steady_clock::time_point epoch_;
+        std::uint64_t current_tick_ = 0;
+        std::size_t pending_ = 0;
+
+        std::uint64_t TickFor(std::chrono::steady_clock::time_point when) const;
+        void Insert(TimerEntry entry);
+        void Cascade(int level, std::size_t slot);
+    };
+
     std::unordered_map<int, GameEvent> events_;
-    std::priority_queue<
-        std::pair<std::chrono::steady_clock::time_point, int>,
-        std::vector<std::pair<std::chrono::steady_clock::time_point, int>>,
-        std::greater<std::pair<std::chrono::steady_clock::time_point, int>>
-    > scheduled_events_;
+    StringInterner event_names_;
+    TimerWheel wheel_;
+    EventRecordPool record_pool_;
+
+    // Worker-pool task: a snapshot of the event and its params, so the
+    // scheduler maps can change while the handler runs.
+    struct AsyncTask {
+        GameEvent event;
+        std::vector<int> params;
+    };
+
+    std::vector<std::thread> workers_;
+    std::queue<AsyncTask> task_queue_;
+    std::mutex task_mutex_;
+    std::condition_variable task_condition_;
+    bool stop_workers_ = false;
+    bool use_shared_executor_ = false;  // dispatch via ExecutorService instead of workers_
+    EventCompletionCallback completion_callback_;
+
+    void WorkerLoop();
+    void DispatchAsync(const GameEvent& event);
 
     void InitializeDefaultEvents();
     void InitializeStoryEvents();
     void InitializeCombatEvents();
     void InitializeQuestEvents();
 
-    EventTriggerResult ExecuteEvent(const GameEvent& event, const std::vector<int>& params);
+    EventTriggerResult ExecuteEvent(const GameEvent& event, std::span<const int> params);
 };
 
 } // namespace strategy
@@ -5,6 +5,7 @@
 #ifndef STRATEGY_GAMERULEMANAGER_H
 #define STRATEGY_GAMERULEMANAGER_H
 
+#include <cstddef>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -35,6 +36,13 @@ struct GameRules {
 
 /**
  * @brief Manages built-in and dynamic game rules.
+ *
+ * Rules are compiled into a flat condition table the first time they are
+ * evaluated: condition keys become dense slots, numeric thresholds are
+ * parsed once, and CheckRuleCondition walks the table comparing
+ * pre-parsed integers instead of re-scanning operator prefixes and
+ * doing a map lookup per condition. The table is rebuilt lazily only
+ * after AddRule/UpdateRuleStatus invalidate it.
  */
 class GameRuleManager {
 public:
@@ -53,12 +61,52 @@ public:
     bool UpdateRuleStatus(const std::string& rule_id, bool is_active);
 
 private:
+    // Comparison opcodes for compiled conditions.
+    enum class CompiledOp : unsigned char {
+        GreaterEqual,
+        LessEqual,
+        Greater,
+        Less,
+        EqualString,
+        AlwaysFalse  // malformed condition, e.g. non-numeric threshold
+    };
+
+    // One condition in the flat table.
+    struct CompiledCondition {
+        int key_slot = 0;
+        CompiledOp op = CompiledOp::AlwaysFalse;
+        int threshold = 0;           // numeric ops
+        std::string expected;        // EqualString
+    };
+
+    // Span of conditions belonging to one rule.
+    struct CompiledRule {
+        std::size_t first_condition = 0;
+        std::size_t condition_count = 0;
+        bool is_active = false;
+    };
+
     std::unordered_map<std::string, GameRule> rules_;
 
+    // Compiled form, rebuilt lazily when rules_dirty_ is set.
+    bool rules_dirty_ = true;
+    std::unordered_map<std::string, int> key_slot_of_;
+    std::vector<CompiledCondition> compiled_conditions_;
+    std::unordered_map<std::string, CompiledRule> compiled_rules_;
+
+    // Per-call scratch, indexed by key slot; reused to avoid allocations
+    // on the request path.
+    std::vector<const std::string*> slot_text_;
+    std::vector<int> slot_number_;
+    std::vector<unsigned char> slot_is_number_;
+
     void InitializeDefaultRules();
     void InitializeCombatRules();
     void InitializeStoryRules();
     void InitializeQuestRules();
+
+    /** Rebuilds the flat condition table from rules_ if needed. */
+    void EnsureCompiled();
 };
 
 } // namespace strategy
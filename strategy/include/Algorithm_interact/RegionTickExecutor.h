@@ -0,0 +1,193 @@
+/*
+ * File: RegionTickExecutor.h
+ * Description: Parallel per-region world ticking with a cross-region mailbox.
+ */
+#ifndef STRATEGY_REGIONTICKEXECUTOR_H
+#define STRATEGY_REGIONTICKEXECUTOR_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <span>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace strategy {
+
+/**
+ * @brief One cross-region interaction queued through the mailbox.
+ *
+ * Produced by a region's tick handler via RegionTickContext::Send and
+ * delivered in the target region's inbox on the NEXT tick, so no region
+ * ever reads another region's state mid-tick.
+ */
+struct RegionMessage {
+    int from_region = 0;
+    int to_region = 0;
+    int entity_id = 0;
+    std::vector<int> payload;
+};
+
+/**
+ * @brief Per-region view handed to the tick handler.
+ *
+ * Entities and inbox are views into region-local storage; they are valid
+ * only for the duration of the handler call. Send queues a message into
+ * the region's outbox (region-local, no lock beyond the region's own),
+ * routed to its target after the parallel phase completes.
+ */
+class RegionTickContext {
+public:
+    RegionTickContext(int region_id,
+                      std::span<const int> entities,
+                      std::span<const RegionMessage> inbox,
+                      std::vector<RegionMessage>& outbox)
+        : region_id_(region_id), entities_(entities), inbox_(inbox), outbox_(outbox) {}
+
+    int RegionId() const { return region_id_; }
+    std::span<const int> Entities() const { return entities_; }
+    std::span<const RegionMessage> Inbox() const { return inbox_; }
+
+    /**
+     * @brief Queue a message for another region's next tick.
+     */
+    void Send(int to_region, int entity_id, std::vector<int> payload) {
+        outbox_.push_back(RegionMessage{region_id_, to_region, entity_id, std::move(payload)});
+    }
+
+private:
+    int region_id_;
+    std::span<const int> entities_;
+    std::span<const RegionMessage> inbox_;
+    std::vector<RegionMessage>& outbox_;
+};
+
+/**
+ * @brief Ticks world regions in parallel over a persistent worker pool.
+ *
+ * The single-threaded world tick capped the biggest map at one core.
+ * State is partitioned by region: each region owns its entity list,
+ * inbox, and outbox under a region-local mutex, and TickAll runs every
+ * region's handler concurrently on the pool. Interactions that span a
+ * boundary go through the mailbox — a handler never touches another
+ * region's data directly, so the parallel phase is lock-contention free
+ * and scales with core count.
+ *
+ * Tick protocol per TickAll call:
+ *   1. parallel phase — every region's handler runs on the pool with
+ *      its entities and the messages routed to it last tick;
+ *   2. routing phase — after all handlers finish, outboxes are drained
+ *      into the target regions' inboxes for the next tick. Messages to
+ *      unknown regions are dropped and counted.
+ */
+class RegionTickExecutor {
+public:
+    using RegionTickFn = std::function<void(RegionTickContext&)>;
+
+    /**
+     * @brief Mailbox and routing counters.
+     */
+    struct Stats {
+        std::size_t regions = 0;
+        std::size_t entities = 0;
+        std::size_t messages_routed = 0;
+        std::size_t messages_dropped = 0;
+    };
+
+    static constexpr std::size_t DEFAULT_WORKER_COUNT = 8;
+
+    explicit RegionTickExecutor(std::size_t worker_count = DEFAULT_WORKER_COUNT);
+    ~RegionTickExecutor();
+
+    RegionTickExecutor(const RegionTickExecutor&) = delete;
+    RegionTickExecutor& operator=(const RegionTickExecutor&) = delete;
+
+    /**
+     * @brief Install the per-region tick handler.
+     *
+     * Called once per region per TickAll, possibly concurrently for
+     * different regions — the handler must only touch region-local data
+     * plus what the context exposes.
+     */
+    void SetTickHandler(RegionTickFn handler);
+
+    /**
+     * @brief Place an entity in a region, creating the region on first use.
+     *
+     * Re-assigning moves the entity between regions (border crossing).
+     * Moves are applied at the next TickAll boundary — like mailbox
+     * messages — so handlers can reassign entities mid-tick (including
+     * their own) without touching another region's lock.
+     */
+    void AssignEntity(int entity_id, int region_id);
+
+    void RemoveEntity(int entity_id);
+
+    /**
+     * @brief Region an entity currently lives in (-1 if unknown).
+     */
+    int RegionOf(int entity_id) const;
+
+    /**
+     * @brief Run one world tick across all regions.
+     * @return Number of regions ticked.
+     */
+    std::size_t TickAll();
+
+    Stats GetStats() const;
+
+private:
+    /**
+     * @brief Region-local state; the mutex covers every field.
+     */
+    struct Region {
+        int id = 0;
+        mutable std::mutex mutex;
+        std::vector<int> entities;
+        std::vector<RegionMessage> inbox;
+        std::vector<RegionMessage> outbox;
+    };
+
+    /**
+     * @brief One deferred entity move (from_region -1 = spawn, to_region
+     *        -1 = despawn), applied at the next tick boundary.
+     */
+    struct PendingMove {
+        int entity_id;
+        int from_region;
+        int to_region;
+    };
+
+    // Regions are created on demand and never destroyed; std::map keeps
+    // node addresses stable while worker tasks hold Region pointers.
+    std::map<int, Region> regions_;
+    std::unordered_map<int, int> entity_regions_;
+    std::vector<PendingMove> pending_moves_;
+    mutable std::mutex registry_mutex_;
+
+    RegionTickFn tick_handler_;
+
+    // Persistent tick workers: TickAll enqueues one task per region and
+    // blocks until the completion count drains back to zero.
+    std::vector<std::thread> workers_;
+    std::vector<Region*> task_queue_;
+    std::size_t tasks_in_flight_ = 0;
+    bool stop_workers_ = false;
+    std::mutex task_mutex_;
+    std::condition_variable task_condition_;
+    std::condition_variable done_condition_;
+
+    std::size_t messages_routed_ = 0;
+    std::size_t messages_dropped_ = 0;
+
+    void WorkerLoop();
+    void TickRegion(Region& region);
+    void ApplyPendingMoves();
+};
+
+} // namespace strategy
+
+#endif // STRATEGY_REGIONTICKEXECUTOR_H
@@ -0,0 +1,96 @@
+/*
+ * File: SpatialIndex.h
+ * Description: Uniform-grid spatial index for NPC proximity queries.
+ */
+#ifndef STRATEGY_SPATIALINDEX_H
+#define STRATEGY_SPATIALINDEX_H
+
+#include <cstddef>
+#include <cstdint>
+#include <shared_mutex>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace strategy {
+
+/**
+ * @brief Uniform-grid index over entity positions.
+ *
+ * Entities hash into fixed-size grid cells; a radius query visits only
+ * the cells overlapping the query circle and filters candidates by
+ * exact distance, so proximity scans cost O(entities nearby) instead of
+ * O(world). The cell size should be on the order of the common query
+ * radius — much smaller and a query touches many cells, much larger and
+ * each cell over-returns.
+ *
+ * Internally synchronized: position updates take the exclusive lock,
+ * queries the shared lock, so concurrent readers never contend with
+ * each other.
+ */
+class SpatialIndex {
+public:
+    /** @brief Default cell edge length in world units. */
+    static constexpr float DEFAULT_CELL_SIZE = 32.0f;
+
+    explicit SpatialIndex(float cell_size = DEFAULT_CELL_SIZE);
+
+    /** @brief Insert an entity or move it to a new position. */
+    void Upsert(int id, float x, float y);
+
+    void Remove(int id);
+
+    /**
+     * @brief Fetch an entity's last known position.
+     * @return false if the id is not indexed.
+     */
+    bool GetPosition(int id, float& x, float& y) const;
+
+    /** @brief Ids within `radius` of the point, in no particular order. */
+    std::vector<int> QueryRadius(float x, float y, float radius) const;
+
+    /**
+     * @brief Union of ids within `radius` of any center, deduplicated.
+     *
+     * One lock acquisition and one visited-set for the whole batch;
+     * callers scanning around many anchors at once (per-player
+     * relevance tiers, area events) should prefer this over repeated
+     * QueryRadius calls.
+     */
+    std::vector<int> QueryRadiusBatch(
+        const std::vector<std::pair<float, float>>& centers, float radius) const;
+
+    std::size_t Size() const;
+
+private:
+    struct Entry {
+        float x;
+        float y;
+        std::int64_t cell;
+    };
+
+    static std::int64_t PackCell(std::int32_t cx, std::int32_t cy);
+    std::int32_t CellCoord(float v) const;
+
+    void RemoveFromCellLocked(std::int64_t cell, int id);
+
+    /**
+     * @brief Append ids inside the circle to `out`.
+     *
+     * `visited` deduplicates across overlapping circles in a batch;
+     * pass nullptr for a single circle, whose cells are disjoint.
+     */
+    void CollectCircleLocked(float x, float y, float radius,
+                             std::unordered_set<int>* visited,
+                             std::vector<int>& out) const;
+
+    float cell_size_;
+    mutable std::shared_mutex mutex_;
+    std::unordered_map<int, Entry> entries_;
+    std::unordered_map<std::int64_t, std::vector<int>> cells_;
+};
+
+} // namespace strategy
+
+#endif // STRATEGY_SPATIALINDEX_H
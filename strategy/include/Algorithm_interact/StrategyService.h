@@ -6,11 +6,16 @@
 #define STRATEGY_STRATEGYSERVICE_H
 
 #include "../IStrategyService.h"
+#include "AITickScheduler.h"
 #include "EventScheduler.h"
+#include "RegionTickExecutor.h"
 #include "GameRuleManager.h"
+#include "WorldEventArchive.h"
 #include "WorldStateEngine.h"
 
 #include <memory>
+#include <mutex>
+#include <span>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -25,8 +30,86 @@ public:
     WorldStateResult UpdateWorldState(const WorldStateUpdate& update) override;
     EventTriggerResult TriggerEvent(const EventTriggerRequest& request) override;
 
+    /**
+     * @brief Span-based trigger path shared with the gRPC layer.
+     *
+     * Params are read in place (wire buffers included) and forwarded to
+     * the scheduler through a pooled compact record, so high-frequency
+     * triggers do not copy their param list at any hop.
+     */
+    EventTriggerResult TriggerEvent(int event_id, std::span<const int> params);
+
     GameRules GetGameRules(const std::string& rule_category);
     GameState QueryGameState(const std::string& query_type);
+    GameStateDelta QueryGameStateDelta(const std::string& query_type,
+                                       std::uint64_t known_sequence);
+
+    /**
+     * @brief Register a region-of-interest subscription.
+     *
+     * The filter describes what the client can see (map region, entity
+     * set, key namespaces); subsequent PollStateInterest calls return
+     * only matching deltas from the change journal, so per-subscriber
+     * bandwidth scales with the interest set instead of world size.
+     *
+     * @return Subscription id for polling and unregistration.
+     */
+    int RegisterStateInterest(StateInterestFilter filter);
+
+    /** @brief Replace a subscription's filter (e.g. the player moved regions). */
+    bool UpdateStateInterest(int subscription_id, StateInterestFilter filter);
+
+    void UnregisterStateInterest(int subscription_id);
+
+    /**
+     * @brief Serve a subscriber's next update relative to its sequence.
+     *
+     * Unknown ids return an invalid reply (sequence 0, no payload) so a
+     * stale subscriber re-registers instead of receiving the full world.
+     */
+    GameStateDelta PollStateInterest(int subscription_id, std::uint64_t known_sequence);
+
+    /**
+     * @brief Scheduler that decides which NPCs need an AI decision each tick.
+     *
+     * Callers register NPCs/players and drive Tick() from the game loop;
+     * successful TriggerEvent calls wake the affected passive NPCs.
+     */
+    AITickScheduler& GetAITickScheduler() { return *ai_tick_scheduler_; }
+
+    /** @brief Install the batch sink that receives due NPC ids per tick. */
+    void SetAIDecisionSink(AITickScheduler::DecisionBatchSink sink);
+
+    /**
+     * @brief Drop NPC ids whose quantized AI context has not meaningfully
+     *        changed since their last dispatched decision.
+     *
+     * Intended to run inside the decision sink before a tick batch is
+     * forwarded to the algorithm layer: most NPCs' contexts are identical
+     * tick over tick, and an unchanged quantized context means the
+     * previous decision still applies, so re-requesting it buys nothing.
+     * First-seen ids always pass. Not synchronized against itself; call
+     * it only from the tick thread that drives the scheduler.
+     */
+    std::vector<int> FilterNPCsNeedingAIDecision(const std::vector<int>& npc_ids);
+
+    /**
+     * @brief Region-partitioned parallel world ticker.
+     *
+     * Callers assign entities to regions, install a tick handler, and
+     * drive TickAll() from the game loop; regions tick concurrently and
+     * cross-region interactions travel through the mailbox.
+     */
+    RegionTickExecutor& GetRegionTicker() { return *region_ticker_; }
+
+    /**
+     * @brief Two-tier archive of triggered event history.
+     *
+     * Successful TriggerEvent calls are recorded here; callers attach
+     * cold-tier storage and start the archival schedule at service
+     * startup, and query recent + archived history in one call.
+     */
+    WorldEventArchive& GetEventArchive() { return *event_archive_; }
 
 private:
     void UpdateEventRuleMapFromJson(const std::string& world_state_json);
@@ -38,7 +121,17 @@ private:
     std::unique_ptr<GameRuleManager> rule_manager_;
     std::unique_ptr<WorldStateEngine> world_engine_;
     std::unique_ptr<EventScheduler> event_scheduler_;
+    std::unique_ptr<AITickScheduler> ai_tick_scheduler_;
+    std::unique_ptr<RegionTickExecutor> region_ticker_;
+    std::unique_ptr<WorldEventArchive> event_archive_;
     std::unordered_map<int, std::string> event_rule_map_;
+    // Interest subscriptions: filters are copied out under the mutex and
+    // matching runs lock-free against the engine's journal.
+    mutable std::mutex interest_mutex_;
+    std::unordered_map<int, StateInterestFilter> interest_filters_;
+    int next_interest_id_ = 1;
+    // Last quantized context dispatched per NPC; tick-thread state only.
+    std::unordered_map<int, WorldStateEngine::QuantizedAIContext> last_ai_contexts_;
     std::string event_rule_versions_json_;
     std::string event_rule_publish_history_json_;
 };
@@ -0,0 +1,181 @@
+/*
+ * File: WorldEventArchive.h
+ * Description: Two-tier archive for triggered world events (hot ring + time-partitioned tables).
+ */
+#ifndef STRATEGY_WORLDEVENTARCHIVE_H
+#define STRATEGY_WORLDEVENTARCHIVE_H
+
+#include "../database/BaseRepository.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+namespace strategy {
+
+/**
+ * @brief One triggered event as kept by the archive.
+ */
+struct TriggeredEventRecord {
+    int event_id = 0;
+    long long triggered_at_ms = 0;  // UTC milliseconds since epoch
+    std::string result_json;
+};
+
+/**
+ * @brief Repository for the time-partitioned cold tier.
+ *
+ * Events land in one table per UTC day (world_events_pYYYYMMDD), so
+ * the cold tier never accumulates into a single ever-growing table:
+ * inserts only touch today's partition, range queries only open the
+ * partitions the range covers, and retention is a table drop instead
+ * of a mass delete. Partition DDL is idempotent and cached per name.
+ */
+class WorldEventPartitionRepository : public BaseRepository {
+public:
+    explicit WorldEventPartitionRepository(std::unique_ptr<IDatabaseConnection> connection);
+
+    /** @brief Table name of the partition covering a timestamp. */
+    static std::string PartitionNameFor(long long timestamp_ms);
+
+    /**
+     * @brief Bulk-insert records into their daily partitions.
+     *
+     * Rows are grouped by partition and written with ExecuteBulkInsert,
+     * one multi-row statement per chunk inside a transaction. Partitions
+     * are created on first use.
+     *
+     * @return Number of rows written; on failure the unwritten tail is
+     *         left untouched so the caller can retry it later.
+     */
+    std::size_t InsertEvents(const std::vector<TriggeredEventRecord>& records);
+
+    /**
+     * @brief Read archived events inside [from_ms, to_ms], ascending.
+     *
+     * Walks the daily partitions the range covers; partitions that were
+     * never created read as empty via the Try* channel instead of
+     * throwing. Stops once `limit` rows are collected.
+     */
+    std::vector<TriggeredEventRecord> QueryRange(long long from_ms,
+                                                 long long to_ms,
+                                                 std::size_t limit);
+
+private:
+    /** @brief Create a partition table if it does not exist yet. */
+    bool EnsurePartition(const std::string& partition);
+
+    std::unordered_set<std::string> ensured_partitions_;
+};
+
+/**
+ * @brief Two-tier store for triggered world event history.
+ *
+ * The hot tier is a capped in-memory ring: recent events stay cheap to
+ * scan and the tier can no longer grow with uptime. A background pass
+ * moves events older than the archival window into the partitioned
+ * cold tier; entries evicted from the full ring before they were
+ * archived are staged so the pipeline never silently loses history
+ * (the staging buffer itself is capped, and overflow is counted).
+ * Query() answers from both tiers in one ascending, merged view.
+ *
+ * Thread safety: all public methods are safe to call concurrently;
+ * the ring and the repository are guarded by separate mutexes so
+ * recording events never waits on cold-tier I/O.
+ */
+class WorldEventArchive {
+public:
+    static constexpr std::size_t DEFAULT_HOT_CAPACITY = 4096;
+
+    explicit WorldEventArchive(std::size_t hot_capacity = DEFAULT_HOT_CAPACITY);
+
+    ~WorldEventArchive();
+
+    /**
+     * @brief Attach the cold-tier storage connection.
+     *
+     * Without storage the archive still works as a bounded hot ring;
+     * evicted-but-unarchived entries are staged up to the ring capacity
+     * and dropped (counted) beyond that.
+     */
+    void AttachStorage(std::unique_ptr<IDatabaseConnection> connection);
+
+    /** @brief Append a triggered event to the hot ring. */
+    void Record(int event_id, long long triggered_at_ms, std::string result_json);
+
+    /**
+     * @brief Move events older than the cutoff into the cold tier.
+     *
+     * Also flushes entries previously evicted from the full ring. Rows
+     * the repository failed to write are re-staged for the next pass.
+     *
+     * @return Number of rows archived.
+     */
+    std::size_t ArchiveOlderThan(long long cutoff_ms);
+
+    /**
+     * @brief Events inside [from_ms, to_ms] across both tiers.
+     *
+     * Cold rows come first (they are strictly older than anything still
+     * in the ring), then matching hot entries; the merged view is
+     * ascending by trigger time and truncated to `limit` rows.
+     */
+    std::vector<TriggeredEventRecord> Query(long long from_ms,
+                                            long long to_ms,
+                                            std::size_t limit = DEFAULT_QUERY_LIMIT);
+
+    /**
+     * @brief Start the background archival schedule.
+     *
+     * Every `interval` the worker archives events older than `window`.
+     * The thread sleeps on a condition variable between passes and is
+     * joined by StopArchival() or destruction.
+     */
+    void StartArchival(std::chrono::seconds interval, std::chrono::seconds window);
+
+    /** @brief Stop and join the background archival thread. */
+    void StopArchival();
+
+    /** @brief Entries currently in the hot ring. */
+    std::size_t GetHotCount() const;
+
+    /** @brief Entries dropped because the staging buffer overflowed. */
+    std::uint64_t GetDroppedCount() const;
+
+private:
+    static constexpr std::size_t DEFAULT_QUERY_LIMIT = 1024;
+
+    /** @brief One background pass: archive everything older than the window. */
+    void ArchivalLoop(std::chrono::seconds interval, std::chrono::seconds window);
+
+    const std::size_t hot_capacity_;
+
+    // Hot tier: ring of the newest events plus the staging buffer of
+    // evicted-but-unarchived entries. Guarded by ring_mutex_ only.
+    mutable std::mutex ring_mutex_;
+    std::deque<TriggeredEventRecord> hot_;
+    std::deque<TriggeredEventRecord> staged_;
+    std::uint64_t dropped_count_ = 0;
+
+    // Cold tier; storage_mutex_ serializes all repository access.
+    std::mutex storage_mutex_;
+    std::unique_ptr<WorldEventPartitionRepository> repository_;
+
+    // Background schedule, ConnectionPool-health-checker style.
+    std::mutex worker_mutex_;
+    std::condition_variable worker_cv_;
+    bool stop_worker_ = false;
+    std::thread worker_;
+};
+
+} // namespace strategy
+
+#endif // STRATEGY_WORLDEVENTARCHIVE_H
@@ -0,0 +1,164 @@
+/*
+ * File: WorldFlagPages.h
+ * Description: Namespace-paged bitset storage for world flags.
+ */
+#ifndef STRATEGY_WORLDFLAGPAGES_H
+#define STRATEGY_WORLDFLAGPAGES_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace strategy {
+
+/**
+ * @brief Stable position of a registered flag: page index plus bit.
+ */
+struct FlagHandle {
+    static constexpr std::uint32_t INVALID_PAGE = 0xFFFFFFFFu;
+
+    std::uint32_t page = INVALID_PAGE;
+    std::uint32_t bit = 0;
+
+    bool IsValid() const { return page != INVALID_PAGE; }
+};
+
+/**
+ * @brief Bit-packed world flag store, paged by name namespace.
+ *
+ * A map node per boolean costs ~50 bytes; here a flag is one bit.
+ * Flags register once and receive a dense index inside their
+ * namespace's page (the namespace is the name prefix through the
+ * first '_', e.g. "quest_"), so 50k flags cost kilobytes of bitset
+ * plus the name table. Pages have fixed bit capacity and their words
+ * never reallocate, which makes Test() a single lock-free atomic bit
+ * test — registration is the only operation that takes the registry
+ * mutex.
+ *
+ * Each page carries a change version bumped only when a bit actually
+ * flips; delta-sync consumers poll PagesChangedSince() with their
+ * last-seen versions instead of diffing the flag map.
+ */
+class WorldFlagPages {
+public:
+    /// Bits per page; a namespace outgrowing this chains a new page.
+    static constexpr std::uint32_t PAGE_FLAG_CAPACITY = 4096;
+
+    /// Upper bound on pages (MAX_PAGES * PAGE_FLAG_CAPACITY flags total).
+    static constexpr std::uint32_t MAX_PAGES = 256;
+
+    WorldFlagPages() = default;
+
+    /**
+     * @brief Namespace of a flag name: the prefix through the first '_'
+     *        ("quest_complete" -> "quest_"); names without one share
+     *        the unnamed page.
+     */
+    static std::string NamespaceOf(const std::string& name);
+
+    /**
+     * @brief Register a flag, returning its stable handle.
+     *
+     * Idempotent; an already-registered name returns its existing
+     * handle. Returns an invalid handle once MAX_PAGES is exhausted.
+     */
+    FlagHandle Register(const std::string& name);
+
+    /** @brief Handle of a registered flag, invalid if never registered. */
+    FlagHandle Find(const std::string& name) const;
+
+    /** @brief Lock-free single-bit test; invalid handles read as false. */
+    bool Test(FlagHandle handle) const;
+
+    /**
+     * @brief Set or clear one flag.
+     * @return true if the bit actually changed (bumps the page version).
+     */
+    bool Set(FlagHandle handle, bool value);
+
+    /** @brief True when every handle's bit is set (empty span: true). */
+    bool TestAll(std::span<const FlagHandle> handles) const;
+
+    /** @brief True when at least one handle's bit is set. */
+    bool TestAny(std::span<const FlagHandle> handles) const;
+
+    /**
+     * @brief Bulk set/clear.
+     * @return Number of bits that actually changed.
+     */
+    std::size_t SetMany(std::span<const FlagHandle> handles, bool value);
+
+    /** @brief Pages allocated so far. */
+    std::uint32_t PageCount() const;
+
+    /** @brief Namespace a page belongs to. */
+    const std::string& PageNamespace(std::uint32_t page) const;
+
+    /** @brief Change version of a page (bumped per actual bit flip). */
+    std::uint64_t PageVersion(std::uint32_t page) const;
+
+    /**
+     * @brief Pages whose version moved past the caller's snapshot.
+     *
+     * `known_versions` is indexed by page; pages beyond its size (new
+     * since the snapshot) always report as changed.
+     */
+    std::vector<std::uint32_t> PagesChangedSince(
+        std::span<const std::uint64_t> known_versions) const;
+
+    /** @brief Visit every registered flag with its current value. */
+    void ForEachFlag(const std::function<void(const std::string&, bool)>& fn) const;
+
+    /** @brief Clear all bits (registrations survive; versions advance). */
+    void Clear();
+
+    /** @brief Registered flag count across all pages. */
+    std::size_t GetRegisteredCount() const;
+
+private:
+    static constexpr std::uint32_t WORDS_PER_PAGE = PAGE_FLAG_CAPACITY / 64;
+
+    /**
+     * @brief One namespace page: fixed word array so Test() never races
+     *        a reallocation, plus the dense name table for snapshots.
+     */
+    struct Page {
+        explicit Page(std::string page_namespace)
+            : ns(std::move(page_namespace)) {}
+
+        std::string ns;
+        std::array<std::atomic<std::uint64_t>, WORDS_PER_PAGE> words{};
+        std::atomic<std::uint64_t> change_version{0};
+        std::vector<std::string> names;  // bit index -> name; registry_mutex_
+    };
+
+    // Per-namespace registration cursor: current page and next free bit.
+    struct NamespaceCursor {
+        std::uint32_t page = FlagHandle::INVALID_PAGE;
+        std::uint32_t next_bit = PAGE_FLAG_CAPACITY;
+    };
+
+    const Page* PageAt(std::uint32_t page) const;
+    Page* PageAt(std::uint32_t page);
+
+    // Page slots are written once under registry_mutex_ and thereafter
+    // immutable, so handle-based reads never take a lock.
+    std::array<std::unique_ptr<Page>, MAX_PAGES> pages_;
+    std::atomic<std::uint32_t> page_count_{0};
+
+    mutable std::mutex registry_mutex_;
+    std::unordered_map<std::string, FlagHandle> handles_;
+    std::unordered_map<std::string, NamespaceCursor> cursors_;
+};
+
+} // namespace strategy
+
+#endif // STRATEGY_WORLDFLAGPAGES_H
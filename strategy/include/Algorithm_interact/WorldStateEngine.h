@@ -5,14 +5,52 @@
 #ifndef STRATEGY_WORLDSTATEENGINE_H
 #define STRATEGY_WORLDSTATEENGINE_H
 
+#include "../IStrategyService.h"
+#include "../common/StringInterner.h"
+#include "SpatialIndex.h"
+#include "WorldFlagPages.h"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <span>
 #include <string>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace strategy {
 
+/**
+ * @brief Relation type between two NPCs.
+ *
+ * Stored as one byte per edge; the string forms ("friend", "enemy",
+ * "neutral", "ally") exist only at the query/serialization boundary.
+ */
+enum class RelationType : std::uint8_t {
+    Neutral = 0,
+    Friend = 1,
+    Enemy = 2,
+    Ally = 3,
+};
+
+/** @brief Canonical name of a relation type. */
+const std::string& RelationTypeName(RelationType type);
+
+/** @brief Parse a relation type name; unknown names map to Neutral. */
+RelationType RelationTypeFromName(const std::string& name);
+
 /**
  * @brief NPC relation information.
+ *
+ * Query/serialization model only: relations live in a slab-allocated
+ * edge graph inside the engine and are materialized into this shape on
+ * read, so snapshot consumers keep seeing strings.
  */
 struct NPCRelation {
     int npc_id;
@@ -22,6 +60,17 @@ struct NPCRelation {
     std::vector<std::string> shared_history;
 };
 
+/**
+ * @brief One entry of a bulk relation update.
+ */
+struct NPCRelationUpdate {
+    int npc_id = 0;
+    int target_id = 0;
+    RelationType type = RelationType::Neutral;
+    int trust_change = 0;
+    std::string history_event;  // empty = no history entry recorded
+};
+
 /**
  * @brief World state container.
  */
@@ -42,8 +91,51 @@ struct GameState {
     bool is_valid;
 };
 
+/**
+ * @brief Result of a sequence-based delta query.
+ *
+ * Exactly one of three shapes: up_to_date (the client already has the
+ * current state, no payload), delta_valid (only the keys changed since
+ * the client's sequence), or neither — the journal cannot cover the gap
+ * and `full` carries a complete resync snapshot.
+ */
+struct GameStateDelta {
+    bool up_to_date = false;
+    bool delta_valid = false;
+    std::vector<StateChange> changes;
+    std::uint64_t sequence = 0;
+    GameState full;
+};
+
+/**
+ * @brief Region-of-interest filter for state queries and subscriptions.
+ *
+ * Each category is opt-in: variables and flags are included when their
+ * key matches an exact name or one of the namespace prefixes; NPC
+ * relations are included when the source NPC is in the entity set or
+ * currently positioned inside the region rectangle. Active events are
+ * global and always included on full resyncs. An empty filter matches
+ * nothing, so a subscriber only pays for what it registered.
+ */
+struct StateInterestFilter {
+    std::vector<std::string> key_prefixes;  // flag/variable namespaces, e.g. "quest_"
+    std::vector<std::string> keys;          // exact variable/flag names
+    std::vector<int> entity_ids;            // NPCs of interest
+    bool has_region = false;                // map region of interest
+    float region_min_x = 0.0f;
+    float region_min_y = 0.0f;
+    float region_max_x = 0.0f;
+    float region_max_y = 0.0f;
+};
+
 /**
  * @brief Handles world state update/query operations.
+ *
+ * State is sharded by key hash with a reader-writer lock per shard:
+ * concurrent GetGlobalVariable/GetWorldFlag reads from many gRPC
+ * threads take shared locks on independent shards and never contend
+ * with each other. Snapshot queries assemble a WorldState by locking
+ * each shard shared in turn.
  */
 class WorldStateEngine {
 public:
@@ -51,25 +143,391 @@ public:
 
     bool UpdateWorldState(const std::string& world_state_json);
     WorldState GetCurrentWorldState() const;
+
+    /**
+     * @brief Answer a state query from the published snapshot.
+     *
+     * Queries are served copy-on-write: the first query after a mutation
+     * builds an immutable snapshot (state plus pre-rendered state_json)
+     * and publishes it under a version number; every further query at
+     * the same version copies from that snapshot without touching any
+     * shard lock, so heavy read load no longer serializes against world
+     * updates.
+     */
     GameState QueryGameState(const std::string& query_type);
 
+    /**
+     * @brief Monotonic mutation counter backing the snapshot cache.
+     *        Bumped by every state-changing operation.
+     */
+    std::uint64_t GetStateVersion() const;
+
+    /**
+     * @brief Apply an incremental delta instead of a full-state document.
+     *
+     * Each change touches only its own shard, so the cost is O(changes).
+     * Deltas must carry a strictly increasing sequence number; a stale or
+     * duplicate sequence is rejected without modifying any state.
+     * @return true if the delta was applied.
+     */
+    bool ApplyDelta(const std::vector<StateChange>& changes, std::uint64_t sequence);
+
+    /**
+     * @brief Sequence number of the last applied delta (0 = none yet).
+     */
+    std::uint64_t GetAppliedSequence() const;
+
+    /**
+     * @brief Answer a query relative to the caller's last-seen sequence.
+     *
+     * Serves from the change journal when it covers the gap, so a
+     * steady-state poller receives either an empty "current" reply or
+     * just the changed keys instead of the full state document. Falls
+     * back to a full snapshot when the client has no baseline or the
+     * journal has been trimmed or invalidated past its sequence.
+     */
+    GameStateDelta QueryGameStateDelta(const std::string& query_type,
+                                       std::uint64_t known_sequence);
+
+    /**
+     * @brief Current change-journal sequence number (0 = no changes yet).
+     */
+    std::uint64_t GetChangeSequence() const;
+
+    /**
+     * @brief Whether a journal key matches the filter's key interest.
+     */
+    static bool MatchesKey(const StateInterestFilter& filter, const std::string& key);
+
+    /**
+     * @brief Filtered form of QueryGameStateDelta for subscriptions.
+     *
+     * Serves only journal changes whose key matches the filter; when the
+     * gap is covered but nothing of interest changed the reply is
+     * up_to_date, so the subscriber still advances its sequence without
+     * parsing a payload. Resync fallbacks carry the filtered snapshot
+     * from QueryGameStateFiltered instead of the full world.
+     */
+    GameStateDelta QueryGameStateDelta(const StateInterestFilter& filter,
+                                       std::uint64_t known_sequence);
+
+    /**
+     * @brief Snapshot restricted to the filter's interest set.
+     *
+     * Built from the published snapshot, so it takes no shard locks; the
+     * rendered state_json covers only the filtered state, keeping resync
+     * payloads proportional to the subscriber's view.
+     */
+    GameState QueryGameStateFiltered(const StateInterestFilter& filter);
+
+    /**
+     * @brief Serialize the full world state as a versioned binary snapshot.
+     *
+     * Format: magic "FLWS" + version, then length-prefixed sections per
+     * map (global variables, world flags, NPC relations, active events)
+     * with little-endian fixed-width fields. Avoids the string formatting
+     * and regex cost of the JSON path for large worlds.
+     */
+    std::string SerializeBinarySnapshot() const;
+
+    /**
+     * @brief Replace the world state from a binary snapshot.
+     * @return false if the payload is truncated or not a snapshot.
+     */
+    bool LoadBinarySnapshot(const std::string& data);
+
+    /**
+     * @brief Check whether a payload carries the binary snapshot magic.
+     */
+    static bool IsBinarySnapshot(const std::string& data);
+
     bool UpdateNPCRelation(int npc_id, int target_id, const std::string& relation_type, int trust_change);
     NPCRelation GetNPCRelation(int npc_id, int target_id) const;
 
+    /** @brief Capacity of the per-edge shared-history ring. */
+    static constexpr std::size_t RELATION_HISTORY_CAPACITY = 8;
+
+    /**
+     * @brief Apply a batch of relation updates in one pass.
+     *
+     * Faction events touch thousands of edges at once; this form groups
+     * the updates by shard so each shard lock is taken once per batch
+     * instead of once per edge, and retires the published snapshot once
+     * at the end. History events are interned and pushed onto the
+     * edge's ring, evicting the oldest entry when full.
+     *
+     * @return Number of updates applied.
+     */
+    std::size_t UpdateNPCRelations(const std::vector<NPCRelationUpdate>& updates);
+
     void SetGlobalVariable(const std::string& var_name, int value);
     int GetGlobalVariable(const std::string& var_name) const;
 
     void SetWorldFlag(const std::string& flag_name, bool value);
     bool GetWorldFlag(const std::string& flag_name) const;
 
+    /**
+     * @brief Intern a variable/flag name, returning its stable id.
+     *
+     * Register names once at load time; the id overloads below then hash
+     * and compare integers on the tick path instead of strings. The
+     * string overloads remain as the slow path and intern on first use.
+     */
+    StringId InternKey(const std::string& name);
+
+    void SetGlobalVariable(StringId key_id, int value);
+    int GetGlobalVariable(StringId key_id) const;
+
+    void SetWorldFlag(StringId key_id, bool value);
+    bool GetWorldFlag(StringId key_id) const;
+
+    /**
+     * @brief True when every flag in the span is set.
+     *
+     * Rule-evaluation form: each check is one atomic bit test against
+     * the flag pages, with no lock and no hashing of strings.
+     */
+    bool TestWorldFlagsAll(std::span<const StringId> key_ids) const;
+
+    /**
+     * @brief Set or clear a batch of flags, journaling each change.
+     * @return Number of flags whose value actually changed.
+     */
+    std::size_t SetWorldFlags(std::span<const StringId> key_ids, bool value);
+
+    /**
+     * @brief Underlying paged flag store.
+     *
+     * Exposes per-page change versions so delta-sync consumers can ask
+     * which namespaces moved instead of diffing the whole flag map.
+     */
+    const WorldFlagPages& FlagPages() const { return flag_pages_; }
+
+    /** @brief Radius of the crowding term in AI decision contexts. */
+    static constexpr float AI_CONTEXT_RADIUS = 50.0f;
+
+    /**
+     * @brief Track an NPC's world position in the spatial index.
+     *
+     * Positions feed the proximity queries below and the crowding term
+     * of GetAIDecisionContext; they are not part of the serialized
+     * world state and never touch the shards or the snapshot cache.
+     */
+    void UpdateNPCPosition(int npc_id, float x, float y);
+
+    void RemoveNPCPosition(int npc_id);
+
+    /** @brief Ids of NPCs within `radius` of a point. */
+    std::vector<int> QueryNPCsInRadius(float x, float y, float radius) const;
+
+    /**
+     * @brief Union of NPCs within `radius` of any center, deduplicated.
+     *
+     * Batch form for callers scanning around many anchors at once —
+     * the relevance-tiered tick scheduler and area-of-effect events.
+     */
+    std::vector<int> QueryNPCsInRadius(
+        const std::vector<std::pair<float, float>>& centers, float radius) const;
+
     std::vector<int> GetAIDecisionContext(int npc_id) const;
 
+    /** @brief Number of slots in a quantized AI decision context. */
+    static constexpr std::size_t AI_CONTEXT_SLOTS = 8;
+
+    /**
+     * @brief Fixed-size quantized form of an AI decision context.
+     *
+     * Slots mirror GetAIDecisionContext: npc id, trust bucket, player
+     * level, combat-count bucket, story progress, the two combat/tutorial
+     * flags, and the crowding bucket.
+     */
+    using QuantizedAIContext = std::array<int, AI_CONTEXT_SLOTS>;
+
+    /** @brief Bucket width for the trust slot (-100..100 range). */
+    static constexpr int AI_TRUST_QUANT_STEP = 25;
+
+    /** @brief Bucket width for monotonically counting slots. */
+    static constexpr int AI_COUNTER_QUANT_STEP = 10;
+
+    /** @brief Bucket width for the nearby-NPC crowding slot. */
+    static constexpr int AI_CROWD_QUANT_STEP = 3;
+
+    /**
+     * @brief Quantized AI decision context, cached per NPC.
+     *
+     * Most NPCs' contexts are identical tick over tick, so the context is
+     * not rebuilt per call: the cached array is reused until the state
+     * version or a position update retires it. Trust, counters, and the
+     * crowding term are bucketed by the step constants above, so
+     * fluctuations smaller than a bucket never surface as a change.
+     */
+    QuantizedAIContext GetQuantizedAIContext(int npc_id) const;
+
+    /**
+     * @brief Cheap similarity test between two quantized contexts.
+     *
+     * Quantization is the tolerance: contexts are similar exactly when
+     * every bucketed slot matches, so the test is one array compare.
+     */
+    static bool AIContextsSimilar(const QuantizedAIContext& a,
+                                  const QuantizedAIContext& b);
+
 private:
-    WorldState current_state_;
+    /**
+     * @brief One relation edge in the slab.
+     *
+     * Fixed-size record: the type is an enum byte and the shared history
+     * is a ring of interned event ids, so 100k edges stay a few MB of
+     * contiguous memory instead of per-edge string and vector heaps.
+     * Edges of one NPC form a singly linked chain through `next_edge`.
+     */
+    struct RelationEdge {
+        int target_id = 0;
+        int next_edge = -1;            // next edge of the same NPC, -1 = end
+        std::int16_t trust_level = 0;  // -100 to 100
+        RelationType type = RelationType::Neutral;
+        std::uint8_t history_size = 0;
+        std::uint8_t history_head = 0;  // ring index of the oldest entry
+        std::array<StringId, RELATION_HISTORY_CAPACITY> history{};
+    };
+
+    /**
+     * @brief One hash shard of the world state.
+     */
+    // Variables are stored under interned ids; names are only
+    // materialized again when a snapshot is built or journaled. World
+    // flags live outside the shards entirely (see flag_pages_ below).
+    // Relations are sharded by source npc_id: `relation_heads` maps an
+    // NPC to its first edge in `relation_slab`, so one shard lock covers
+    // a whole adjacency walk. There is no relation-removal API, so the
+    // slab only grows and needs no free list; snapshot loads swap the
+    // containers wholesale.
+    struct StateShard {
+        mutable std::shared_mutex mutex;
+        std::vector<RelationEdge> relation_slab;
+        std::unordered_map<int, int> relation_heads;
+        std::unordered_map<StringId, int> global_variables;
+    };
+
+    static constexpr std::size_t STATE_SHARD_COUNT = 16;
+
+    std::array<StateShard, STATE_SHARD_COUNT> shards_;
+    mutable StringInterner key_interner_;
+
+    // Relation history event names; separate table so event ids stay
+    // dense even when variable/flag names churn.
+    mutable StringInterner history_interner_;
+
+    /** @brief Find an edge in a shard; caller holds the shard lock. */
+    static const RelationEdge* FindEdge(const StateShard& shard, int npc_id, int target_id);
+
+    /** @brief Find or create an edge; caller holds the shard lock exclusively. */
+    static RelationEdge& EdgeFor(StateShard& shard, int npc_id, int target_id);
+
+    /** @brief Push a history event id onto an edge's ring, evicting the oldest. */
+    static void PushHistory(RelationEdge& edge, StringId event_id);
+
+    /** @brief Materialize an edge into the string-bearing query model. */
+    NPCRelation MaterializeRelation(int npc_id, const RelationEdge& edge) const;
+
+    // World flags as namespace-paged bitsets: one bit per registered
+    // flag instead of a map node per boolean, so checks are lock-free
+    // single-bit tests. flag_handles_ caches StringId -> handle so the
+    // id overloads stay string-free after first use.
+    WorldFlagPages flag_pages_;
+    mutable std::mutex flag_handle_mutex_;
+    mutable std::vector<FlagHandle> flag_handles_;
+
+    /** @brief Handle for a flag id, registering the flag on first use. */
+    FlagHandle EnsureFlagHandle(StringId key_id);
+
+    /** @brief Handle for a flag id; invalid if the flag was never set. */
+    FlagHandle FindFlagHandle(StringId key_id) const;
+
+    // NPC positions for proximity queries. The index synchronizes
+    // itself, so position updates never contend with state shards.
+    SpatialIndex npc_positions_;
+
+    // Active events and the update timestamp are low-traffic; they are
+    // not sharded. The timestamp is atomic so writers never take a lock.
+    mutable std::shared_mutex events_mutex_;
+    std::vector<std::string> active_events_;
+    std::atomic<long long> last_update_time_{0};
+    std::atomic<std::uint64_t> applied_sequence_{0};
+
+    /**
+     * @brief One journaled mutation for sequence-based delta queries.
+     */
+    struct JournalEntry {
+        std::uint64_t sequence;
+        StateChange change;
+    };
+
+    static constexpr std::size_t JOURNAL_CAPACITY = 1024;
+
+    // Change journal: every variable/flag write appends one entry. Bulk
+    // replaces that bypass the setters (binary snapshot load, active-event
+    // replacement) invalidate it, forcing straddling clients onto the full
+    // resync path. The critical section is a bounded push, so the shared
+    // mutex does not reintroduce the cross-shard contention the shards
+    // exist to avoid.
+    mutable std::mutex journal_mutex_;
+    std::deque<JournalEntry> journal_;
+    std::uint64_t change_sequence_ = 0;
+    std::uint64_t journal_floor_ = 0;
+
+    StateShard& ShardFor(int key);
+    const StateShard& ShardFor(int key) const;
+    StateShard& ShardForId(StringId key_id);
+    const StateShard& ShardForId(StringId key_id) const;
+
+    void RecordChange(StateChange change);
+    void InvalidateJournal();
+
+    /**
+     * @brief Immutable published snapshot: full state plus its rendered
+     *        JSON, valid for exactly one state version.
+     */
+    struct PublishedSnapshot {
+        std::uint64_t version;
+        WorldState state;
+        std::string state_json;
+    };
+
+    // Copy-on-write cache: readers grab the shared pointer (the slot
+    // mutex guards only the pointer copy, never the build), then read
+    // and serialize from the immutable snapshot with no shard locks.
+    // Publication is lazy — eagerly rebuilding on every setter write
+    // would make writes O(world size).
+    std::atomic<std::uint64_t> state_version_{0};
+    mutable std::mutex snapshot_mutex_;
+    mutable std::shared_ptr<const PublishedSnapshot> published_snapshot_;
+
+    std::shared_ptr<const PublishedSnapshot> AcquireSnapshot() const;
+    void BumpStateVersion();
+
+    /**
+     * @brief Cached quantized context, valid for one version pair.
+     */
+    struct CachedAIContext {
+        std::uint64_t state_version;
+        std::uint64_t position_version;
+        QuantizedAIContext quantized;
+    };
+
+    // Position updates bypass the shards and never bump the state
+    // version, so the context cache tracks them with its own counter.
+    std::atomic<std::uint64_t> position_version_{0};
+    mutable std::mutex ai_context_mutex_;
+    mutable std::unordered_map<int, CachedAIContext> ai_context_cache_;
+
+    static QuantizedAIContext QuantizeAIContext(const std::vector<int>& context);
 
     void InitializeDefaultState();
-    std::string SerializeWorldState() const;
+    WorldState BuildSnapshot() const;
+    std::string SerializeWorldState(const WorldState& snapshot) const;
     bool DeserializeWorldState(const std::string& json_data);
+    void TouchUpdateTime();
 };
 
 } // namespace strategy
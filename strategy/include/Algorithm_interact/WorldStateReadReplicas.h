@@ -0,0 +1,143 @@
+/*
+ * File: WorldStateReadReplicas.h
+ * Description: Bounded-staleness read replicas fed by the world state replication stream.
+ */
+#ifndef STRATEGY_WORLDSTATEREADREPLICAS_H
+#define STRATEGY_WORLDSTATEREADREPLICAS_H
+
+#include "WorldStateEngine.h"
+#include "WorldStateReplicator.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace strategy {
+
+/**
+ * @brief Pool of read-only world state replicas with bounded staleness.
+ *
+ * QueryGameState traffic outnumbers writes by roughly 50:1 and most
+ * callers tolerate a short staleness window, yet every query on the
+ * authoritative engine competes with the world tick for the snapshot
+ * cache. This pool owns N replica engines, each drained by its own
+ * lightweight thread from the snapshot-plus-delta wire stream published
+ * by WorldStateReplicator: wire Publish() as (or behind) the
+ * replicator's publish callback, and route read RPCs through Query().
+ *
+ * Query() picks a replica round-robin and serves from it when the
+ * replica is in sync and its backlog is within the staleness bound;
+ * otherwise it falls through to the next replica and finally to the
+ * authoritative engine, so correctness never depends on replica health.
+ * A replica that detects a sequence gap (e.g. after queue overflow)
+ * reports once through the resync callback so the owner can ask the
+ * replicator for a fresh snapshot.
+ */
+class WorldStateReadReplicas {
+public:
+    /// Invoked (at most once per desync) when a replica needs a snapshot.
+    using ResyncRequestFn = std::function<void()>;
+
+    static constexpr std::size_t DEFAULT_REPLICA_COUNT = 2;
+    /// A replica whose queue backlog exceeds this is considered stale.
+    static constexpr std::uint64_t DEFAULT_MAX_LAG_MESSAGES = 64;
+    /// Per-replica queue bound; overflow drops the backlog and resyncs.
+    static constexpr std::size_t QUEUE_CAPACITY = 1024;
+
+    /**
+     * @brief Constructor; starts one consumer thread per replica.
+     * @param authoritative engine serving writes and stale-fallback reads
+     * @param replica_count number of replica engines
+     * @param max_lag_messages staleness bound as queued-message backlog
+     */
+    explicit WorldStateReadReplicas(
+        WorldStateEngine& authoritative,
+        std::size_t replica_count = DEFAULT_REPLICA_COUNT,
+        std::uint64_t max_lag_messages = DEFAULT_MAX_LAG_MESSAGES);
+
+    ~WorldStateReadReplicas();
+
+    WorldStateReadReplicas(const WorldStateReadReplicas&) = delete;
+    WorldStateReadReplicas& operator=(const WorldStateReadReplicas&) = delete;
+
+    /**
+     * @brief Feed one replication wire message to every replica.
+     *
+     * Wire this as the WorldStateReplicator publish callback (or call it
+     * from one). Enqueueing is non-blocking; a full replica queue is
+     * cleared, which the consumer detects as a gap and resyncs from the
+     * next snapshot.
+     */
+    void Publish(const std::string& message);
+
+    /**
+     * @brief Install the callback used to request a resync snapshot.
+     */
+    void SetResyncRequestFn(ResyncRequestFn fn);
+
+    /**
+     * @brief Answer a state query, preferring a fresh replica.
+     */
+    GameState Query(const std::string& query_type);
+
+    /**
+     * @brief Whether every replica has drained its queue and is in sync.
+     */
+    bool IsCaughtUp() const;
+
+    /**
+     * @brief Query routing counters (monitoring).
+     */
+    struct Stats {
+        std::uint64_t replica_queries = 0;    ///< served from a replica
+        std::uint64_t primary_fallbacks = 0;  ///< fell back to authoritative
+    };
+
+    Stats GetStats() const;
+
+private:
+    /**
+     * @brief One replica engine with its consumer thread and queue.
+     */
+    struct ReplicaSlot {
+        WorldStateEngine engine;
+        WorldStateReplica consumer;
+        std::thread worker;
+        std::mutex queue_mutex;
+        std::condition_variable queue_cv;
+        std::deque<std::string> queue;
+        std::atomic<std::uint64_t> consumed_count{0};
+        bool resync_reported = false;
+
+        ReplicaSlot() : consumer(engine) {}
+    };
+
+    void ConsumeLoop(ReplicaSlot& slot);
+    void ReportDesync(ReplicaSlot& slot);
+
+    WorldStateEngine& authoritative_;
+    const std::uint64_t max_lag_messages_;
+
+    std::vector<std::unique_ptr<ReplicaSlot>> replicas_;
+    std::atomic<std::uint64_t> published_count_{0};
+    std::atomic<std::size_t> next_replica_{0};
+    std::atomic<bool> running_{true};
+
+    mutable std::mutex resync_mutex_;
+    ResyncRequestFn resync_fn_;
+
+    std::atomic<std::uint64_t> replica_queries_{0};
+    std::atomic<std::uint64_t> primary_fallbacks_{0};
+};
+
+} // namespace strategy
+
+#endif // STRATEGY_WORLDSTATEREADREPLICAS_H
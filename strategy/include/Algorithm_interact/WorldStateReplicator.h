@@ -0,0 +1,119 @@
+/*
+ * File: WorldStateReplicator.h
+ * Description: Snapshot-plus-delta replication of world state between instances.
+ */
+#ifndef STRATEGY_WORLDSTATEREPLICATOR_H
+#define STRATEGY_WORLDSTATEREPLICATOR_H
+
+#include "WorldStateEngine.h"
+
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace strategy {
+
+/**
+ * @brief Primary-side replication driver.
+ *
+ * Applies deltas to the local WorldStateEngine and publishes each one as
+ * a sequenced wire message through a transport-agnostic publish callback.
+ * A full binary snapshot is published every N deltas (and on demand) so a
+ * standby can bootstrap or resynchronize after a gap without replaying
+ * the whole history. Messages are framed with a magic header and a
+ * sequence number; the payloads reuse the engine's binary snapshot and
+ * delta representations.
+ */
+class WorldStateReplicator {
+public:
+    using PublishFn = std::function<void(const std::string& message)>;
+
+    static constexpr int DEFAULT_SNAPSHOT_EVERY_DELTAS = 256;
+
+    /**
+     * @brief Constructor.
+     * @param engine engine owning the authoritative state
+     * @param publish callback receiving encoded wire messages
+     * @param snapshot_every_deltas full snapshot cadence in applied deltas
+     */
+    WorldStateReplicator(WorldStateEngine& engine,
+                         PublishFn publish,
+                         int snapshot_every_deltas = DEFAULT_SNAPSHOT_EVERY_DELTAS);
+
+    /**
+     * @brief Apply a delta locally and publish it to standbys.
+     *
+     * The sequence number is allocated here so the local engine and the
+     * stream can never diverge.
+     * @return true if the delta was applied and published.
+     */
+    bool ReplicateDelta(const std::vector<StateChange>& changes);
+
+    /**
+     * @brief Publish a full snapshot immediately (e.g. when a standby
+     *        reports it is out of sync).
+     */
+    void PublishSnapshot();
+
+    /**
+     * @brief Sequence number of the last published message.
+     */
+    std::uint64_t GetPublishedSequence() const;
+
+private:
+    void PublishSnapshotLocked();
+
+    WorldStateEngine& engine_;
+    PublishFn publish_;
+    const int snapshot_every_deltas_;
+    int deltas_since_snapshot_ = 0;
+    mutable std::mutex mutex_;
+};
+
+/**
+ * @brief Standby-side replication consumer.
+ *
+ * Feeds received wire messages into a warm standby engine. Snapshots
+ * (re)establish a baseline; deltas must arrive with consecutive
+ * sequence numbers on top of it. Duplicates are ignored, a gap marks
+ * the replica out of sync until the next snapshot, and callers can poll
+ * IsInSync() to request one from the primary. Promotion on failover is
+ * just starting to serve from the local engine.
+ */
+class WorldStateReplica {
+public:
+    /**
+     * @brief Constructor.
+     * @param engine standby engine receiving replicated state
+     */
+    explicit WorldStateReplica(WorldStateEngine& engine);
+
+    /**
+     * @brief Consume one wire message from the primary.
+     * @return true if the message was applied or safely ignored;
+     *         false on a malformed message or a detected gap.
+     */
+    bool Consume(const std::string& message);
+
+    /**
+     * @brief Whether the replica has a baseline and has seen no gap.
+     */
+    bool IsInSync() const;
+
+    /**
+     * @brief Sequence number of the last applied message (0 = none).
+     */
+    std::uint64_t GetLastSequence() const;
+
+private:
+    WorldStateEngine& engine_;
+    std::uint64_t last_sequence_ = 0;
+    bool in_sync_ = false;
+    mutable std::mutex mutex_;
+};
+
+} // namespace strategy
+
+#endif // STRATEGY_WORLDSTATEREPLICATOR_H
@@ -5,13 +5,29 @@
 #ifndef STRATEGY_ISTRATEGYSERVICE_H
 #define STRATEGY_ISTRATEGYSERVICE_H
 
+#include <cstdint>
 #include <string>
 #include <vector>
 
 namespace strategy {
 
+/**
+ * @brief Single key/value change inside a world-state delta.
+ */
+struct StateChange {
+    std::string key;
+    bool is_flag = false;  // true → world flag, false → global variable
+    int int_value = 0;
+    bool bool_value = false;
+};
+
 struct WorldStateUpdate {
     std::string world_state_json;
+    // Delta path: when changes is non-empty the JSON payload is ignored
+    // and the engine applies O(changes) work. Deltas carry a monotonic
+    // sequence number; stale or duplicate sequences are rejected.
+    std::vector<StateChange> changes;
+    std::uint64_t sequence = 0;
 };
 
 struct WorldStateResult {
@@ -3,22 +3,33 @@
  * 说明: 策略层异步日志服务头文件。
  * 作者: 彭承康
  * 创建时间: 2025-07-13
+ * 更新时间: 2026-08-27 — 互斥锁队列替换为有界无锁MPSC环形缓冲
+ * 更新时间: 2026-08-28 — 自适应批处理窗口与批量分发接口
+ * 更新时间: 2026-08-28 — 运行期输出端热切换、分模块级别过滤与突发抓取
  *
  * 本服务使用装饰器模式，为其他日志服务（如控制台、文件）提供异步功能。
- * 它内部维护一个线程安全的日志消息队列和一个后台工作线程，
- * 以解耦日志生成与I/O操作，避免阻塞主线程。
+ * 生产者通过无锁环形缓冲推入日志（多生产者，单消费者），
+ * 后台工作线程批量取出并分发，日志调用永不阻塞游戏逻辑线程。
+ *
+ * 工作线程采用自适应批处理：缓冲有积压时连续整批汲取并经
+ * LogBatch一次交给各输出端；空转时在条件变量上按动态窗口
+ * 休眠（持续空闲逐步放宽，一有活干立即收紧），生产者只在
+ * 消费者确实休眠时才进锁唤醒，入队热路径保持无锁。
  */
 #ifndef STRATEGY_ASYNCLOGSERVICE_H
 #define STRATEGY_ASYNCLOGSERVICE_H
 
 #include "ILogService.h"
-#include <vector>
-#include <string>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
 #include <memory>
-#include <thread>
 #include <mutex>
-#include <condition_variable>
-#include <queue>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
 
 namespace strategy {
 
@@ -28,12 +39,29 @@ namespace strategy {
  */
 class AsyncLogService : public ILogService {
 public:
+    /**
+     * @brief 缓冲溢出策略
+     */
+    enum class OverflowPolicy {
+        DropOldest,  // 丢弃最旧的日志，为新日志腾出空间（默认）
+        DropNewest   // 丢弃新日志，保留已入队的
+    };
+
     /**
      * @brief 构造函数
+     *
+     * use_shared_executor 为 true 时不再自建后台线程，批量分发
+     * 以单飞任务提交到共享 ExecutorService 的日志通道：有记录
+     * 到达且没有分发任务在途时挂一个，任务汲取到空后自行退出，
+     * 空闲时执行器里没有本服务的任何任务。通道被卸载时生产者
+     * 内联完成本轮分发，日志不丢。
+     *
      * @param services 日志服务池，日志将被分发到池中的所有服务。
+     * @param use_shared_executor 是否使用共享执行器代替私有线程
      */
-    explicit AsyncLogService(std::vector<std::shared_ptr<ILogService>> services);
-    
+    explicit AsyncLogService(std::vector<std::shared_ptr<ILogService>> services,
+                             bool use_shared_executor = false);
+
     /**
      * @brief 析构函数
      * 安全地停止后台线程，并确保所有缓冲区的日志都被处理。
@@ -41,8 +69,8 @@ public:
     virtual ~AsyncLogService();
 
     /**
-     * @brief 将日志消息推入队列（非阻塞）
-     * 该方法是线程安全的。
+     * @brief 将日志消息推入环形缓冲（无锁、非阻塞）
+     * 该方法是线程安全的；缓冲满时按溢出策略处理，绝不阻塞调用线程。
      */
     void Log(LogLevel level,
              const std::string& file,
@@ -50,13 +78,256 @@ public:
              const std::string& type,
              const std::string& message) override;
 
+    /**
+     * @brief 移动版本：字符串被移入日志消息，全程零拷贝
+     *
+     * 传入右值（临时字符串、std::move后的变量）时命中此重载，
+     * file/type/message 直接移动进槽位，不发生任何字符串拷贝。
+     * 每次字符串拷贝会使 GetStringCopyCount() 加一，可据此验证
+     * 热路径零拷贝。
+     */
+    void Log(LogLevel level,
+             std::string&& file,
+             int line,
+             std::string&& type,
+             std::string&& message);
+
+    /**
+     * @brief 获取生产侧字符串拷贝计数（诊断用）
+     * @return const引用重载触发的字符串拷贝总次数
+     */
+    std::uint64_t GetStringCopyCount() const {
+        return string_copies_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief 清零字符串拷贝计数
+     */
+    void ResetStringCopyCount() {
+        string_copies_.store(0, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief 延迟格式化日志（生产侧仅做POD拷贝）
+     *
+     * 捕获格式串指针与至多 MAX_DEFERRED_ARGS 个POD参数进槽位，
+     * 格式化推迟到工作线程执行。格式串用 "{}" 作占位符，
+     * format/file/type 必须是字符串字面量（指针在程序期内有效）。
+     */
+    template <typename... Args>
+    void LogDeferred(LogLevel level,
+                     const char* file,
+                     int line,
+                     const char* type,
+                     const char* format,
+                     Args... args) {
+        static_assert(sizeof...(Args) <= MAX_DEFERRED_ARGS,
+                      "LogDeferred: 参数个数超出槽位容量");
+        LogMessage msg;
+        msg.deferred = true;
+        msg.payload.level = level;
+        msg.payload.file = file;
+        msg.payload.line = line;
+        msg.payload.type = type;
+        msg.payload.format = format;
+        msg.payload.arg_count = static_cast<std::uint8_t>(sizeof...(Args));
+        if constexpr (sizeof...(Args) > 0) {
+            const LogArg captured[] = {ToLogArg(args)...};
+            for (std::size_t i = 0; i < sizeof...(Args); ++i) {
+                msg.payload.args[i] = captured[i];
+            }
+        }
+        Submit(std::move(msg));
+    }
+
+    /**
+     * @brief 运行期整体替换输出端集合（免重启）
+     *
+     * 新集合以不可变快照原子换入，消费者每批分发前取一次快照，
+     * 换入瞬间在途的批次仍完整交给旧集合，之后的批次全部走新
+     * 集合——切换点前后各批不丢不重。旧输出端在最后一个持有
+     * 快照的批次完成后由shared_ptr自然析构。
+     *
+     * @param services 新的日志服务池
+     */
+    void ReconfigureSinks(std::vector<std::shared_ptr<ILogService>> services);
+
+    /**
+     * @brief 设置全局最低日志级别
+     *
+     * 低于该级别的日志在生产侧即被丢弃（一次relaxed原子比较），
+     * 不入环形缓冲、不占分发带宽。
+     */
+    void SetMinLevel(LogLevel level);
+
+    /**
+     * @brief 设置某模块（type字段）的最低级别覆盖
+     *
+     * 覆盖可高于全局（压低吵闹模块）也可低于全局（放开排障
+     * 模块）。覆盖表以写时复制快照换入，消费者每批取一次，
+     * 调整期间日志流不停顿。
+     */
+    void SetTypeMinLevel(const std::string& type, LogLevel level);
+
+    /**
+     * @brief 清除某模块的级别覆盖，回落到全局级别
+     */
+    void ClearTypeMinLevel(const std::string& type);
+
+    /**
+     * @brief 开启突发抓取：把临时提升的详细日志收进内存环
+     *
+     * 抓取期间级别不低于capture_level的记录全部写入有界内存环
+     * （容量满后覆盖最旧），其中未达到输出端阈值的记录只进环、
+     * 不落盘——事故现场要详细日志时不必重启也不必刷盘。
+     *
+     * @param capture_level 抓取的最低级别
+     * @param capacity 内存环容量（条数）
+     */
+    void EnableBurstCapture(LogLevel capture_level,
+                            std::size_t capacity = DEFAULT_BURST_CAPACITY);
+
+    /**
+     * @brief 关闭突发抓取；环中已抓取的内容保留待取证
+     */
+    void DisableBurstCapture();
+
+    /**
+     * @brief 取出并清空突发抓取内容（按时间顺序）
+     */
+    std::vector<LogRecord> DumpBurstCapture();
+
+    /**
+     * @brief 设置缓冲溢出策略
+     */
+    void SetOverflowPolicy(OverflowPolicy policy);
+
+    /**
+     * @brief 因缓冲溢出被丢弃的日志条数
+     */
+    std::uint64_t GetDroppedCount() const;
+
 private:
     /**
      * @brief 后台线程的工作函数
-     * 从队列中取出日志消息并分发给日志服务池中的所有服务。
+     *
+     * 循环整批汲取环形缓冲并经LogBatch分发；缓冲空时在条件
+     * 变量上按动态窗口休眠，窗口随连续空闲轮数翻倍放宽、
+     * 一旦取到批次立即收紧到最短。
      */
     void ProcessQueue();
 
+    /**
+     * @brief 整批取出环形缓冲中的日志
+     *
+     * 延迟格式化消息在此完成格式化；每批最多MAX_BATCH_SIZE
+     * 条，积压更深时由下一轮继续汲取，单批内存有界。
+     *
+     * @param batch 输出参数，记录被追加到尾部
+     * @return std::size_t 本次取出的条数
+     */
+    std::size_t DrainBatch(std::vector<LogRecord>& batch);
+
+    /**
+     * @brief 入队后唤醒可能在休眠的消费者
+     *
+     * 仅在消费者标记自己正在等待时才进锁通知；持续负载下
+     * 标记为否，生产路径不碰互斥锁。共享执行器模式下改为
+     * 调度一个单飞分发任务。
+     */
+    void WakeConsumer();
+
+    /**
+     * @brief 共享执行器模式：确保有一个分发任务在途（单飞）
+     *
+     * drain_scheduled_ 保证任一时刻至多一个消费者在汲取环形
+     * 缓冲，MPSC的单消费者不变量不被破坏；提交被拒时在调用
+     * 线程内联分发。
+     */
+    void ScheduleDrain();
+
+    /**
+     * @brief 共享执行器任务体：汲取到空，清标志后接力补漏
+     */
+    void RunScheduledDrain();
+
+    /**
+     * @brief 连续整批汲取并分发，直到环形缓冲为空
+     */
+    void DrainToServices();
+
+    /// 输出端集合的不可变快照（整体替换，不原地修改）
+    using SinkSet = std::vector<std::shared_ptr<ILogService>>;
+    /// 模块级别覆盖表的不可变快照
+    using TypeLevelMap = std::unordered_map<std::string, LogLevel>;
+
+    /**
+     * @brief 一批分发所需的配置快照
+     *
+     * 消费者每批取一次（一次短锁），批内所有记录按同一份配置
+     * 过滤与分发，换配置不会把一批记录劈成两种行为。
+     */
+    struct DispatchConfig {
+        std::shared_ptr<const SinkSet> sinks;
+        std::shared_ptr<const TypeLevelMap> type_levels;
+        LogLevel min_level = LogLevel::DEBUG;
+        bool burst_active = false;
+        LogLevel burst_level = LogLevel::DEBUG;
+    };
+
+    /**
+     * @brief 取当前配置快照（config_mutex_内一次拷贝两个shared_ptr）
+     */
+    DispatchConfig SnapshotConfig() const;
+
+    /**
+     * @brief 过滤并分发一批记录
+     *
+     * 先把达到抓取级别的记录收进突发环，再剔除低于生效级别
+     * （模块覆盖优先于全局）的记录，剩余整批交给各输出端。
+     */
+    void DispatchBatch(std::vector<LogRecord>& batch);
+
+    /**
+     * @brief 重算生产侧入队级别下限（须持有config_mutex_）
+     *
+     * 下限取全局级别、所有模块覆盖与突发抓取级别的最小值：
+     * 任何一处想要的记录都必须先进得了环形缓冲，精确的分级
+     * 过滤留给消费者按快照完成。
+     */
+    void RecomputeEnqueueFloorLocked();
+
+    /**
+     * @brief 把一条记录写入突发环（须持有burst_mutex_）
+     */
+    void CaptureBurstLocked(const LogRecord& record);
+
+    // 延迟格式化参数（仅POD，入队是一次memcpy）
+    struct LogArg {
+        enum class Type : std::uint8_t { Int, UInt, Float, Bool, CString };
+        Type type = Type::Int;
+        union {
+            long long int_value;
+            unsigned long long uint_value;
+            double float_value;
+            bool bool_value;
+            const char* cstr_value;
+        };
+    };
+
+    static constexpr std::size_t MAX_DEFERRED_ARGS = 4;
+
+    // 延迟格式化载荷：格式串与参数的POD快照
+    struct DeferredPayload {
+        LogLevel level = LogLevel::INFO;
+        const char* file = nullptr;
+        int line = 0;
+        const char* type = nullptr;
+        const char* format = nullptr;
+        std::uint8_t arg_count = 0;
+        LogArg args[MAX_DEFERRED_ARGS];
+    };
+
     // 内部日志消息结构体
     struct LogMessage {
         LogLevel level;
@@ -64,16 +335,107 @@ private:
         int line;
         std::string type;
         std::string message;
+        bool deferred = false;     // true 时走 payload，message等字段为空
+        DeferredPayload payload;
     };
 
-    std::vector<std::shared_ptr<ILogService>> service_pool_; // 日志服务池
-    std::queue<LogMessage> log_queue_;                       // 日志消息队列
-    std::mutex queue_mutex_;                                 // 队列互斥锁
-    std::condition_variable condition_;                      // 条件变量，用于线程同步
-    std::thread worker_thread_;                              // 后台工作线程
-    bool stop_flag_ = false;                                 // 线程停止标志
+    static LogArg ToLogArg(int value) { return MakeIntArg(value); }
+    static LogArg ToLogArg(long value) { return MakeIntArg(value); }
+    static LogArg ToLogArg(long long value) { return MakeIntArg(value); }
+    static LogArg ToLogArg(unsigned int value) { return MakeUIntArg(value); }
+    static LogArg ToLogArg(unsigned long value) { return MakeUIntArg(value); }
+    static LogArg ToLogArg(unsigned long long value) { return MakeUIntArg(value); }
+    static LogArg ToLogArg(float value) { return MakeFloatArg(value); }
+    static LogArg ToLogArg(double value) { return MakeFloatArg(value); }
+    static LogArg ToLogArg(bool value) {
+        LogArg arg;
+        arg.type = LogArg::Type::Bool;
+        arg.bool_value = value;
+        return arg;
+    }
+    static LogArg ToLogArg(const char* value) {
+        LogArg arg;
+        arg.type = LogArg::Type::CString;
+        arg.cstr_value = value;
+        return arg;
+    }
+
+    static LogArg MakeIntArg(long long value) {
+        LogArg arg;
+        arg.type = LogArg::Type::Int;
+        arg.int_value = value;
+        return arg;
+    }
+    static LogArg MakeUIntArg(unsigned long long value) {
+        LogArg arg;
+        arg.type = LogArg::Type::UInt;
+        arg.uint_value = value;
+        return arg;
+    }
+    static LogArg MakeFloatArg(double value) {
+        LogArg arg;
+        arg.type = LogArg::Type::Float;
+        arg.float_value = value;
+        return arg;
+    }
+
+    static std::string FormatDeferred(const DeferredPayload& payload);
+
+    void Submit(LogMessage&& msg);
+
+    /**
+     * @brief 环形缓冲槽位
+     *
+     * sequence 采用Vyukov协议: 等于下标表示可写，等于下标+1表示可读，
+     * 读取后置为下标+容量进入下一轮。生产者CAS竞争写入位置，
+     * 无互斥锁；溢出时生产者按同一协议释放最旧槽位并计数。
+     */
+    struct Slot {
+        std::atomic<std::size_t> sequence;
+        LogMessage message;
+    };
+
+    // 缓冲容量（2的幂，便于位运算取模）
+    static constexpr std::size_t QUEUE_CAPACITY = 8192;
+    // 突发抓取内存环的默认容量
+    static constexpr std::size_t DEFAULT_BURST_CAPACITY = 1024;
+
+    bool TryEnqueue(LogMessage&& msg);
+    bool TryDequeue(LogMessage& msg);
+    bool TryDiscardOldest();
+
+    // 运行期配置：冷路径持锁换快照，消费者每批读一次；
+    // 生产侧只碰enqueue_floor_这个镜像原子，热路径仍然无锁
+    mutable std::mutex config_mutex_;                         // 配置换入互斥锁（冷路径）
+    std::shared_ptr<const SinkSet> sinks_;                    // 输出端集合快照
+    std::shared_ptr<const TypeLevelMap> type_levels_;         // 模块级别覆盖快照
+    LogLevel min_level_ = LogLevel::DEBUG;                    // 全局最低级别
+    bool burst_active_ = false;                               // 突发抓取开关
+    LogLevel burst_level_ = LogLevel::DEBUG;                  // 突发抓取级别
+    std::atomic<int> enqueue_floor_{0};                       // 生产侧入队级别下限
+
+    // 突发抓取内存环：消费者在分发路径写入，管理面取证时读出
+    std::mutex burst_mutex_;                                  // 突发环互斥锁
+    std::vector<LogRecord> burst_ring_;                       // 抓取内容（有界）
+    std::size_t burst_capacity_ = 0;                          // 环容量（条数）
+    std::size_t burst_next_ = 0;                              // 下一个写入位置
+    bool burst_wrapped_ = false;                              // 是否已覆盖过最旧记录
+
+    std::unique_ptr<Slot[]> ring_;                            // 环形缓冲
+    std::atomic<std::size_t> head_{0};                        // 生产者写入位置
+    std::atomic<std::size_t> tail_{0};                        // 消费/丢弃位置
+    std::atomic<std::uint64_t> dropped_count_{0};             // 溢出丢弃计数
+    std::atomic<std::uint64_t> string_copies_{0};             // 生产侧字符串拷贝计数（诊断）
+    std::atomic<OverflowPolicy> overflow_policy_{OverflowPolicy::DropOldest};
+    std::thread worker_thread_;                               // 后台工作线程
+    const bool use_shared_executor_ = false;                  // 经共享执行器分发
+    std::atomic<bool> drain_scheduled_{false};                // 分发任务是否在途（单飞）
+    std::atomic<bool> stop_flag_{false};                      // 线程停止标志
+    std::mutex wake_mutex_;                                   // 消费者休眠互斥锁（冷路径）
+    std::condition_variable wake_cv_;                         // 消费者唤醒条件
+    std::atomic<bool> consumer_waiting_{false};               // 消费者是否在休眠
 };
 
 } // namespace strategy
 
-#endif // STRATEGY_ASYNCLOGSERVICE_H 
\ No newline at end of file
+#endif // STRATEGY_ASYNCLOGSERVICE_H
@@ -11,6 +11,7 @@
 #define STRATEGY_ILOGSERVICE_H
 
 #include <string>
+#include <vector>
 
 namespace strategy {
 
@@ -25,6 +26,20 @@ enum class LogLevel {
     FATAL
 };
 
+/**
+ * @brief 一条已就绪的日志记录
+ *
+ * 批量分发接口的载荷：异步服务在工作线程把环形缓冲整批
+ * 取出后，以记录列表一次交给各个输出端。
+ */
+struct LogRecord {
+    LogLevel level = LogLevel::INFO;  ///< 日志级别
+    std::string file;                 ///< 文件名
+    int line = 0;                     ///< 行号
+    std::string type;                 ///< 错误类型或分类
+    std::string message;              ///< 日志内容
+};
+
 /**
  * @brief 日志服务接口（抽象类）
  * 单一职责：只负责日志输出。
@@ -47,6 +62,20 @@ public:
                      int line,
                      const std::string& type,
                      const std::string& message) = 0;
+
+    /**
+     * @brief 批量输出日志
+     *
+     * 默认实现逐条转调Log；能从批量中获益的实现（如文件服务
+     * 把整批合并为一次写盘）应重写此方法。
+     *
+     * @param records 日志记录列表
+     */
+    virtual void LogBatch(const std::vector<LogRecord>& records) {
+        for (const LogRecord& record : records) {
+            Log(record.level, record.file, record.line, record.type, record.message);
+        }
+    }
 };
 
 } // namespace strategy
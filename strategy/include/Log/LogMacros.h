@@ -13,4 +13,10 @@
 #define STRATEGY_LOG(logService, level, type, message) \
     (logService).Log((level), __FILE__, __LINE__, (type), (message))
 
+// 延迟格式化日志宏（仅用于 AsyncLogService）：
+// 生产侧只捕获格式串指针和POD参数，格式化在工作线程执行。
+// format 用 "{}" 占位，format/type 必须是字符串字面量。
+#define STRATEGY_LOG_DEFERRED(logService, level, type, format, ...) \
+    (logService).LogDeferred((level), __FILE__, __LINE__, (type), (format) __VA_OPT__(,) __VA_ARGS__)
+
 #endif // STRATEGY_LOGMACROS_H 
\ No newline at end of file
@@ -3,28 +3,44 @@
  * 说明: 策略层日志服务文件实现头文件。
  * 作者: 彭承康
  * 创建时间: 2025-07-13
+ * 更新时间: 2026-08-27 — 批量缓冲写入与按大小轮转
  */
 #ifndef STRATEGY_LOGSERVICEFILE_H
 #define STRATEGY_LOGSERVICEFILE_H
 
 #include "Log/ILogService.h"
-#include <string>
+#include <chrono>
+#include <cstddef>
 #include <fstream>
+#include <functional>
 #include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
 
 namespace strategy {
 
 /**
  * @brief 文件日志服务实现
  * 单一职责：只负责日志输出到文件。
+ *
+ * 日志先进入写缓冲，累计到一定条数或距上次落盘超过刷新间隔时
+ * 一次性追加写入，避免每条日志一次小写盘。文件超过大小上限时
+ * 轮转为带时间戳的归档文件，可注册回调在后台线程对归档做
+ * 压缩等后续处理。
  */
 class LogServiceFile : public ILogService {
 public:
-    explicit LogServiceFile(const std::string& filename);
+    // 默认文件大小上限：10MB
+    static constexpr std::size_t DEFAULT_MAX_FILE_SIZE_BYTES = 10 * 1024 * 1024;
+
+    explicit LogServiceFile(const std::string& filename,
+                            std::size_t max_file_size_bytes = DEFAULT_MAX_FILE_SIZE_BYTES);
     virtual ~LogServiceFile();
 
     /**
-     * @brief 输出日志到文件
+     * @brief 输出日志到文件（进入写缓冲，按批次落盘）
      */
     void Log(LogLevel level,
              const std::string& file,
@@ -32,11 +48,48 @@ public:
              const std::string& type,
              const std::string& message) override;
 
+    /**
+     * @brief 批量输出日志到文件
+     *
+     * 整批在锁外格式化为一个连续块后一次并入写缓冲，
+     * 时间戳每批只取一次，锁的持有时间与批大小无关。
+     */
+    void LogBatch(const std::vector<LogRecord>& records) override;
+
+    /**
+     * @brief 立即把写缓冲刷到磁盘
+     */
+    void Flush();
+
+    /**
+     * @brief 注册轮转回调
+     *
+     * 文件轮转后在后台线程以归档文件路径调用，典型用途是
+     * 压缩或清理归档。回调不得抛异常。
+     */
+    void SetRotationCallback(std::function<void(const std::string&)> callback);
+
 private:
+    // 批量刷新阈值：累计条数或距上次落盘的毫秒数，先到者触发
+    static constexpr std::size_t FLUSH_BATCH_MESSAGES = 64;
+    static constexpr long long FLUSH_INTERVAL_MS = 100;
+
     std::string LogLevelToString(LogLevel level) const;
+    void FlushLocked();
+    void RotateLocked();
+
+    std::string filename_;
+    std::size_t max_file_size_;
     std::unique_ptr<std::ofstream> log_file_;
+    std::string write_buffer_;                       // 待落盘的已格式化日志
+    std::size_t buffered_messages_ = 0;
+    std::size_t current_file_size_ = 0;
+    std::chrono::steady_clock::time_point last_flush_;
+    std::mutex mutex_;
+    std::function<void(const std::string&)> rotation_callback_;
+    std::vector<std::thread> rotation_workers_;      // 归档处理线程，析构时join
 };
 
 } // namespace strategy
 
-#endif // STRATEGY_LOGSERVICEFILE_H 
\ No newline at end of file
+#endif // STRATEGY_LOGSERVICEFILE_H
@@ -0,0 +1,153 @@
+/*
+ * File: StrategyGrpcCallbackServiceImpl.h
+ * Description: Strategy layer gRPC callback-API service bridge.
+ */
+#ifndef STRATEGY_GRPCCALLBACKSERVICEIMPL_H
+#define STRATEGY_GRPCCALLBACKSERVICEIMPL_H
+
+#include "Algorithm_interact/StrategyService.h"
+#include "Log/AsyncLogService.h"
+#include "StrategyGrpcArenaAllocator.h"
+#include "StrategyService.grpc.pb.h"
+#include "StrategyService.pb.h"
+#include "common/BoundedWorkerPool.h"
+#include "config/AssetChunkStore.h"
+
+#include <grpcpp/grpcpp.h>
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+
+namespace strategy {
+
+/**
+ * @brief gRPC callback-API service implementation delegating to StrategyService.
+ *
+ * Handlers run on a bounded worker pool with priority lanes and finish
+ * their reactor from the worker: TriggerEvent is combat-affecting and
+ * rides the interactive lane, UpdateWorldState the world-sync lane, and
+ * bulk QueryGameState reads the analytics lane. The pool dequeues by
+ * weighted round-robin, so a flood of state queries can no longer delay
+ * event processing, and under pressure analytics load is shed first with
+ * RESOURCE_EXHAUSTED while interactive RPCs keep their full queue.
+ * GetGameRules and health checks stay inline on the event-loop thread.
+ *
+ * Request/response messages for every method are created on pooled protobuf
+ * arenas (see StrategyGrpcArenaAllocator.h), so per-call proto construction
+ * does not hit the global heap at high QPS.
+ */
+class StrategyGrpcCallbackServiceImpl final
+    : public strategy_proto::StrategyService::CallbackService {
+public:
+    explicit StrategyGrpcCallbackServiceImpl(
+        std::size_t worker_threads = BoundedWorkerPool::DEFAULT_THREAD_COUNT,
+        std::size_t max_pending_requests = BoundedWorkerPool::DEFAULT_MAX_QUEUE_SIZE);
+    ~StrategyGrpcCallbackServiceImpl() override = default;
+
+    grpc::ServerUnaryReactor* GetGameRules(
+        grpc::CallbackServerContext* context,
+        const strategy_proto::RulesRequest* request,
+        strategy_proto::GameRulesResponse* response) override;
+
+    grpc::ServerUnaryReactor* UpdateWorldState(
+        grpc::CallbackServerContext* context,
+        const strategy_proto::WorldStateUpdate* request,
+        strategy_proto::StatusResponse* response) override;
+
+    grpc::ServerUnaryReactor* TriggerEvent(
+        grpc::CallbackServerContext* context,
+        const strategy_proto::EventTrigger* request,
+        strategy_proto::EventResult* response) override;
+
+    grpc::ServerUnaryReactor* QueryGameState(
+        grpc::CallbackServerContext* context,
+        const strategy_proto::QueryRequest* request,
+        strategy_proto::GameStateResponse* response) override;
+
+    /**
+     * @brief Content-hashed asset manifest; snapshot lookup, inline.
+     */
+    grpc::ServerUnaryReactor* GetAssetManifest(
+        grpc::CallbackServerContext* context,
+        const strategy_proto::AssetManifestRequest* request,
+        strategy_proto::AssetManifestResponse* response) override;
+
+    /**
+     * @brief Range read over asset bytes; bulk traffic, analytics lane.
+     */
+    grpc::ServerUnaryReactor* GetAssetChunk(
+        grpc::CallbackServerContext* context,
+        const strategy_proto::AssetChunkRequest* request,
+        strategy_proto::AssetChunkResponse* response) override;
+
+    /**
+     * @brief Clock-sync sample; two clock reads, always inline.
+     *
+     * Queueing behind a worker lane would add exactly the latency the
+     * sample is trying to measure.
+     */
+    grpc::ServerUnaryReactor* SyncTime(
+        grpc::CallbackServerContext* context,
+        const strategy_proto::TimeSyncRequest* request,
+        strategy_proto::TimeSyncResponse* response) override;
+
+    /**
+     * @brief Runtime log reconfiguration; rare admin traffic, inline.
+     */
+    grpc::ServerUnaryReactor* ConfigureLogging(
+        grpc::CallbackServerContext* context,
+        const strategy_proto::LogConfigRequest* request,
+        strategy_proto::LogConfigResponse* response) override;
+
+    /**
+     * @brief Attaches the log service that ConfigureLogging administers.
+     */
+    void AttachLogService(std::shared_ptr<AsyncLogService> log_service) {
+        log_service_ = std::move(log_service);
+    }
+
+private:
+    /**
+     * @brief Finishes the reactor inline on the event-loop thread.
+     */
+    grpc::ServerUnaryReactor* FinishInline(
+        grpc::CallbackServerContext* context,
+        const std::function<grpc::Status()>& handler);
+
+    /**
+     * @brief Hands the handler to the worker pool on the given priority
+     *        lane and finishes the reactor from the worker; fails fast
+     *        when the lane is shedding.
+     */
+    grpc::ServerUnaryReactor* FinishOnWorker(
+        grpc::CallbackServerContext* context,
+        TaskLane lane,
+        std::function<grpc::Status()> handler);
+
+    StrategyService service_;
+    AssetChunkStore asset_store_;
+    BoundedWorkerPool workers_;
+    std::shared_ptr<AsyncLogService> log_service_;
+
+    // Shared arena pool and per-method message allocators; the allocators
+    // are registered with the generated service in the constructor and must
+    // outlive it, so they are plain members declared after the pool.
+    grpc_arena::ArenaPool arena_pool_;
+    grpc_arena::ArenaMessageAllocator<strategy_proto::RulesRequest,
+                                      strategy_proto::GameRulesResponse>
+        rules_allocator_{arena_pool_};
+    grpc_arena::ArenaMessageAllocator<strategy_proto::WorldStateUpdate,
+                                      strategy_proto::StatusResponse>
+        world_state_allocator_{arena_pool_};
+    grpc_arena::ArenaMessageAllocator<strategy_proto::EventTrigger,
+                                      strategy_proto::EventResult>
+        event_allocator_{arena_pool_};
+    grpc_arena::ArenaMessageAllocator<strategy_proto::QueryRequest,
+                                      strategy_proto::GameStateResponse>
+        query_allocator_{arena_pool_};
+};
+
+} // namespace strategy
+
+#endif // STRATEGY_GRPCCALLBACKSERVICEIMPL_H
@@ -0,0 +1,256 @@
+/*
+ * File: StrategyGrpcMessageMapping.h
+ * Description: Conversions between strategy_proto messages and internal types.
+ *
+ * Shared by the synchronous and callback gRPC service implementations so
+ * both wire formats stay in lockstep.
+ */
+#ifndef STRATEGY_GRPCMESSAGEMAPPING_H
+#define STRATEGY_GRPCMESSAGEMAPPING_H
+
+#include "Algorithm_interact/StrategyService.h"
+#include "StrategyService.pb.h"
+#include "config/AssetChunkStore.h"
+
+#include <cstddef>
+#include <span>
+#include <utility>
+
+namespace strategy {
+namespace grpc_mapping {
+
+/**
+ * @brief Copies a rule set into the wire response.
+ * @param rules internal rule set
+ * @param active_only skip inactive rules when true
+ * @param response wire response to fill
+ */
+inline void FillGameRulesResponse(const GameRules& rules,
+                                  bool active_only,
+                                  strategy_proto::GameRulesResponse* response) {
+    response->set_category(rules.category);
+    response->set_version(rules.version);
+
+    for (const auto& rule : rules.rules) {
+        if (active_only && !rule.is_active) {
+            continue;
+        }
+
+        auto* out_rule = response->add_rules();
+        out_rule->set_rule_id(rule.rule_id);
+        out_rule->set_description(rule.description);
+        out_rule->set_category(rule.category);
+        out_rule->set_priority(rule.priority);
+        out_rule->set_is_active(rule.is_active);
+
+        auto* out_conditions = out_rule->mutable_conditions();
+        for (const auto& condition : rule.conditions) {
+            (*out_conditions)[condition.first] = condition.second;
+        }
+
+        auto* out_effects = out_rule->mutable_effects();
+        for (const auto& effect : rule.effects) {
+            (*out_effects)[effect.first] = effect.second;
+        }
+    }
+}
+
+/**
+ * @brief Converts a wire world-state update into the internal form.
+ */
+inline WorldStateUpdate ToInternalWorldStateUpdate(const strategy_proto::WorldStateUpdate& request) {
+    WorldStateUpdate internal_update;
+    // On the delta path the JSON payload is ignored by the engine, so skip
+    // copying what is by far the largest string field in the message.
+    if (request.changes_size() == 0) {
+        internal_update.world_state_json = request.world_state_json();
+    }
+    internal_update.sequence = request.sequence();
+    internal_update.changes.reserve(static_cast<std::size_t>(request.changes_size()));
+    for (const auto& change : request.changes()) {
+        StateChange internal_change;
+        internal_change.key = change.key();
+        if (change.value_case() == strategy_proto::StateChange::kBoolValue) {
+            internal_change.is_flag = true;
+            internal_change.bool_value = change.bool_value();
+        } else {
+            internal_change.int_value = change.int_value();
+        }
+        internal_update.changes.push_back(std::move(internal_change));
+    }
+    return internal_update;
+}
+
+/**
+ * @brief Converts a wire interest filter into the internal form.
+ */
+inline StateInterestFilter ToInternalInterestFilter(const strategy_proto::InterestFilter& filter) {
+    StateInterestFilter internal_filter;
+    internal_filter.key_prefixes.assign(filter.key_prefixes().begin(),
+                                        filter.key_prefixes().end());
+    internal_filter.keys.assign(filter.keys().begin(), filter.keys().end());
+    internal_filter.entity_ids.assign(filter.entity_ids().begin(),
+                                      filter.entity_ids().end());
+    internal_filter.has_region = filter.has_region();
+    internal_filter.region_min_x = filter.region_min_x();
+    internal_filter.region_min_y = filter.region_min_y();
+    internal_filter.region_max_x = filter.region_max_x();
+    internal_filter.region_max_y = filter.region_max_y();
+    return internal_filter;
+}
+
+/**
+ * @brief Zero-copy view over a wire event trigger's params.
+ *
+ * The span aliases the repeated field's buffer; it is only valid while
+ * the request message is alive, which both service implementations
+ * guarantee for the duration of the call.
+ */
+inline std::span<const int> EventParamSpan(const strategy_proto::EventTrigger& request) {
+    return std::span<const int>(request.params().data(),
+                                static_cast<std::size_t>(request.params_size()));
+}
+
+/**
+ * @brief Moves an event trigger result into the wire response.
+ *
+ * Takes the result by value so string payloads (result JSON, state-change
+ * descriptions) transfer their buffers instead of being copied.
+ */
+inline void FillEventResult(EventTriggerResult result,
+                            strategy_proto::EventResult* response) {
+    response->set_triggered(result.triggered);
+    response->set_result_json(std::move(result.result_json));
+    for (int npc_id : result.affected_npcs) {
+        response->add_affected_npcs(npc_id);
+    }
+    for (auto& change : result.state_changes) {
+        response->add_state_changes(std::move(change));
+    }
+}
+
+/**
+ * @brief Moves a game state query result into the wire response.
+ *
+ * Takes the state by value: it is a per-query snapshot the caller never
+ * reuses, so the JSON document, event names and NPC history strings are
+ * moved rather than copied into the response.
+ */
+inline void FillGameStateResponse(GameState state,
+                                  strategy_proto::GameStateResponse* response) {
+    response->set_state_json(std::move(state.state_json));
+    response->set_is_valid(state.is_valid);
+
+    auto* world_state = response->mutable_world_state();
+    world_state->set_last_update_time(state.world_state.last_update_time);
+
+    auto* global_vars = world_state->mutable_global_variables();
+    for (const auto& entry : state.world_state.global_variables) {
+        (*global_vars)[entry.first] = entry.second;
+    }
+
+    auto* world_flags = world_state->mutable_world_flags();
+    for (const auto& entry : state.world_state.world_flags) {
+        (*world_flags)[entry.first] = entry.second;
+    }
+
+    for (auto& event_name : state.world_state.active_events) {
+        world_state->add_active_events(std::move(event_name));
+    }
+
+    for (auto& relation_entry : state.world_state.npc_relations) {
+        auto& relation = relation_entry.second;
+        auto* out_relation = world_state->add_npc_relations();
+        out_relation->set_npc_id(relation.npc_id);
+        out_relation->set_target_id(relation.target_id);
+        out_relation->set_relation_type(std::move(relation.relation_type));
+        out_relation->set_trust_level(relation.trust_level);
+        for (auto& history : relation.shared_history) {
+            out_relation->add_shared_history(std::move(history));
+        }
+    }
+}
+
+/**
+ * @brief Moves a delta query result into the wire response.
+ *
+ * Emits one of the three delta shapes: an empty "current" reply, the
+ * changed keys only, or a full resync via FillGameStateResponse.
+ */
+inline void FillGameStateDeltaResponse(GameStateDelta delta,
+                                       strategy_proto::GameStateResponse* response) {
+    response->set_sequence(delta.sequence);
+
+    if (delta.up_to_date) {
+        response->set_up_to_date(true);
+        response->set_is_valid(true);
+        return;
+    }
+
+    if (delta.delta_valid) {
+        for (auto& change : delta.changes) {
+            auto* out_change = response->add_changes();
+            out_change->set_key(std::move(change.key));
+            if (change.is_flag) {
+                out_change->set_bool_value(change.bool_value);
+            } else {
+                out_change->set_int_value(change.int_value);
+            }
+        }
+        response->set_is_valid(true);
+        return;
+    }
+
+    FillGameStateResponse(std::move(delta.full), response);
+}
+
+/**
+ * @brief Copies an asset manifest into the wire response.
+ *
+ * When the client's known version matches, only the version number and
+ * the up-to-date flag go out; repeat visits skip the chunk lists.
+ */
+inline void FillAssetManifestResponse(const AssetManifest& manifest,
+                                      std::uint64_t known_version,
+                                      strategy_proto::AssetManifestResponse* response) {
+    response->set_version(manifest.version);
+    if (known_version != 0 && known_version == manifest.version) {
+        response->set_up_to_date(true);
+        return;
+    }
+
+    for (const AssetManifestEntry& entry : manifest.assets) {
+        auto* out_asset = response->add_assets();
+        out_asset->set_name(entry.name);
+        out_asset->set_size(entry.size);
+        out_asset->set_hash(entry.hash);
+        out_asset->set_chunk_size(entry.chunk_size);
+        for (const AssetChunkInfo& chunk : entry.chunks) {
+            auto* out_chunk = out_asset->add_chunks();
+            out_chunk->set_index(chunk.index);
+            out_chunk->set_offset(chunk.offset);
+            out_chunk->set_size(chunk.size);
+            out_chunk->set_hash(chunk.hash);
+        }
+    }
+}
+
+/**
+ * @brief Moves a range-read result into the wire response.
+ *
+ * Takes the result by value so the chunk payload transfers its buffer
+ * instead of being copied.
+ */
+inline void FillAssetChunkResponse(AssetChunkData chunk,
+                                   strategy_proto::AssetChunkResponse* response) {
+    response->set_found(chunk.found);
+    response->set_offset(chunk.offset);
+    response->set_data(std::move(chunk.data));
+    response->set_hash(std::move(chunk.hash));
+    response->set_eof(chunk.eof);
+}
+
+} // namespace grpc_mapping
+} // namespace strategy
+
+#endif // STRATEGY_GRPCMESSAGEMAPPING_H
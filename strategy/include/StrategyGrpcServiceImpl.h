@@ -6,11 +6,15 @@
 #define STRATEGY_GRPCSERVICEIMPL_H
 
 #include "Algorithm_interact/StrategyService.h"
+#include "Log/AsyncLogService.h"
 #include "StrategyService.grpc.pb.h"
 #include "StrategyService.pb.h"
+#include "config/AssetChunkStore.h"
 
 #include <grpcpp/grpcpp.h>
 
+#include <memory>
+
 namespace strategy {
 
 /**
@@ -41,8 +45,80 @@ public:
         const strategy_proto::QueryRequest* request,
         strategy_proto::GameStateResponse* response) override;
 
+    /**
+     * @brief Region-of-interest subscription stream.
+     *
+     * Registers the request's filter and pushes only matching change
+     * journal deltas; quiet polls advance the subscriber's sequence
+     * without writing to the stream, so idle subscriptions cost no
+     * bandwidth. The filter is unregistered when the client cancels.
+     */
+    grpc::Status SubscribeWorldState(
+        grpc::ServerContext* context,
+        const strategy_proto::StateSubscribeRequest* request,
+        grpc::ServerWriter<strategy_proto::GameStateResponse>* writer) override;
+
+    /**
+     * @brief Content-hashed asset manifest for incremental client sync.
+     *
+     * Clients send their cached manifest version; an unchanged manifest
+     * returns only the version number, so repeat visits cost one small
+     * round trip before chunk downloads start.
+     */
+    grpc::Status GetAssetManifest(
+        grpc::ServerContext* context,
+        const strategy_proto::AssetManifestRequest* request,
+        strategy_proto::AssetManifestResponse* response) override;
+
+    /**
+     * @brief Range read over asset bytes (resumable downloads).
+     *
+     * Locates the chunk either by content hash or by name + offset;
+     * a failed sync resumes from the last chunk the client is missing.
+     */
+    grpc::Status GetAssetChunk(
+        grpc::ServerContext* context,
+        const strategy_proto::AssetChunkRequest* request,
+        strategy_proto::AssetChunkResponse* response) override;
+
+    /**
+     * @brief Clock-sync sample (NTP-style four-timestamp exchange).
+     *
+     * Stamps server wall-clock time at receive and at send so clients
+     * can subtract server processing time from the measured round trip.
+     * The handler itself does no work beyond reading the clock.
+     */
+    grpc::Status SyncTime(
+        grpc::ServerContext* context,
+        const strategy_proto::TimeSyncRequest* request,
+        strategy_proto::TimeSyncResponse* response) override;
+
+    /**
+     * @brief Runtime log reconfiguration (levels, module filters, burst
+     *        capture) without a service restart.
+     *
+     * Applies the requested changes to the attached AsyncLogService;
+     * fails with FAILED_PRECONDITION when no log service is attached.
+     */
+    grpc::Status ConfigureLogging(
+        grpc::ServerContext* context,
+        const strategy_proto::LogConfigRequest* request,
+        strategy_proto::LogConfigResponse* response) override;
+
+    /**
+     * @brief Attaches the log service that ConfigureLogging administers.
+     *
+     * The server wires its process-wide async logger in here at startup;
+     * the bridge only holds a reference and never owns log output itself.
+     */
+    void AttachLogService(std::shared_ptr<AsyncLogService> log_service) {
+        log_service_ = std::move(log_service);
+    }
+
 private:
     StrategyService service_;
+    AssetChunkStore asset_store_;
+    std::shared_ptr<AsyncLogService> log_service_;
 };
 
 } // namespace strategy
@@ -0,0 +1,211 @@
+/*
+ * 文件名: BoundedWorkerPool.h
+ * 说明: 有界任务队列工作线程池（分优先级通道）
+ * 作者: 彭承康
+ * 创建时间: 2026-08-28
+ *
+ * 固定数量的工作线程从有界队列中取任务执行。
+ * 队列满时 TryEnqueue 立即返回失败而不是阻塞调用方，
+ * 供回调式 gRPC 服务把慢请求移出事件循环线程。
+ *
+ * 任务按通道排队：交互（战斗相关）> 世界同步 > 分析（批量读）。
+ * 出队按权重轮转，保证压力下低优先级通道仍有份额而不会饿死；
+ * 入队侧压力到达各通道的卸载阈值时先拒绝分析流量，最后才轮到
+ * 交互流量，让洪峰状态查询不会挤掉事件触发。
+ */
+
+#ifndef STRATEGY_BOUNDEDWORKERPOOL_H
+#define STRATEGY_BOUNDEDWORKERPOOL_H
+
+#include <array>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace strategy {
+
+/**
+ * @brief 任务优先级通道
+ *
+ * 数值越小优先级越高；权重与卸载阈值按通道索引取值。
+ */
+enum class TaskLane : std::uint8_t {
+    Interactive = 0,  ///< 战斗/事件触发等延迟敏感请求
+    WorldSync = 1,    ///< 世界状态同步写入
+    Analytics = 2,    ///< 批量状态读取等可丢弃流量
+};
+
+/**
+ * @brief 有界任务队列工作线程池
+ *
+ * 线程数与总队列容量在构造时固定。每个通道独立排队，工作线程
+ * 按权重轮转出队；队列压力超过通道的卸载阈值时拒绝新任务，
+ * 由调用方决定降级策略（如返回 RESOURCE_EXHAUSTED）。
+ */
+class BoundedWorkerPool {
+public:
+    static constexpr std::size_t DEFAULT_THREAD_COUNT = 4;      ///< 默认工作线程数
+    static constexpr std::size_t DEFAULT_MAX_QUEUE_SIZE = 256;  ///< 默认队列容量
+
+    static constexpr std::size_t LANE_COUNT = 3;  ///< 通道数
+
+    /// 加权轮转的每轮配额：交互4 : 世界同步2 : 分析1
+    static constexpr std::array<int, LANE_COUNT> LANE_WEIGHTS = {4, 2, 1};
+
+    /// 各通道卸载阈值（占总容量的八分之几）：总排队数达到阈值即拒绝。
+    /// 分析流量在半满时最先被卸载，交互流量直到队列全满才拒绝。
+    static constexpr std::array<std::size_t, LANE_COUNT> LANE_SHED_EIGHTHS = {8, 7, 4};
+
+    /**
+     * @brief 构造函数，启动工作线程
+     * @param thread_count 工作线程数
+     * @param max_queue_size 队列容量上限（全通道合计）
+     */
+    explicit BoundedWorkerPool(std::size_t thread_count = DEFAULT_THREAD_COUNT,
+                               std::size_t max_queue_size = DEFAULT_MAX_QUEUE_SIZE)
+        : max_queue_size_(max_queue_size == 0 ? 1 : max_queue_size) {
+        credits_ = LANE_WEIGHTS;
+        const std::size_t count = thread_count == 0 ? 1 : thread_count;
+        workers_.reserve(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            workers_.emplace_back([this]() { WorkerLoop(); });
+        }
+    }
+
+    /**
+     * @brief 析构函数，停止接收新任务并等待已入队任务执行完毕
+     */
+    ~BoundedWorkerPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_requested_ = true;
+        }
+        condition_.notify_all();
+        for (std::thread& worker : workers_) {
+            if (worker.joinable()) {
+                worker.join();
+            }
+        }
+    }
+
+    BoundedWorkerPool(const BoundedWorkerPool&) = delete;
+    BoundedWorkerPool& operator=(const BoundedWorkerPool&) = delete;
+
+    /**
+     * @brief 尝试入队一个交互通道任务（兼容旧调用方）
+     */
+    bool TryEnqueue(std::function<void()> task) {
+        return TryEnqueue(TaskLane::Interactive, std::move(task));
+    }
+
+    /**
+     * @brief 尝试按通道入队一个任务
+     * @param lane 优先级通道
+     * @param task 任务
+     * @return true 已入队；false 通道已卸载或线程池已停止
+     */
+    bool TryEnqueue(TaskLane lane, std::function<void()> task) {
+        const auto lane_index = static_cast<std::size_t>(lane);
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (stop_requested_ || QueuedLocked() >= ShedThreshold(lane_index)) {
+                return false;
+            }
+            lanes_[lane_index].push_back(std::move(task));
+        }
+        condition_.notify_one();
+        return true;
+    }
+
+    /**
+     * @brief 获取当前排队任务数（全通道合计）
+     * @return 排队任务数
+     */
+    std::size_t GetQueuedCount() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return QueuedLocked();
+    }
+
+    /**
+     * @brief 获取指定通道的排队任务数
+     */
+    std::size_t GetQueuedCount(TaskLane lane) const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return lanes_[static_cast<std::size_t>(lane)].size();
+    }
+
+private:
+    /**
+     * @brief 工作线程主循环
+     */
+    void WorkerLoop() {
+        while (true) {
+            std::function<void()> task;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                condition_.wait(lock,
+                                [this]() { return stop_requested_ || QueuedLocked() > 0; });
+                if (QueuedLocked() == 0) {
+                    return;  // 停止且队列已清空
+                }
+                task = PopTaskLocked();
+            }
+            task();
+        }
+    }
+
+    /**
+     * @brief 按权重轮转取出下一个任务（调用方持锁，队列非空）
+     *
+     * 每轮各通道有 LANE_WEIGHTS 份配额，按优先级顺序消费；
+     * 有任务的通道配额耗尽时重置整轮配额。低优先级通道每轮
+     * 保底份额，洪峰下不会被完全饿死。
+     */
+    std::function<void()> PopTaskLocked() {
+        for (int pass = 0; pass < 2; ++pass) {
+            for (std::size_t lane = 0; lane < LANE_COUNT; ++lane) {
+                if (!lanes_[lane].empty() && credits_[lane] > 0) {
+                    --credits_[lane];
+                    std::function<void()> task = std::move(lanes_[lane].front());
+                    lanes_[lane].pop_front();
+                    return task;
+                }
+            }
+            // 所有非空通道的配额都已耗尽，开始新一轮
+            credits_ = LANE_WEIGHTS;
+        }
+        // 不可达：第二趟时必有通道既非空又有配额
+        return []() {};
+    }
+
+    std::size_t QueuedLocked() const {
+        std::size_t total = 0;
+        for (const auto& lane : lanes_) {
+            total += lane.size();
+        }
+        return total;
+    }
+
+    std::size_t ShedThreshold(std::size_t lane_index) const {
+        const std::size_t threshold = max_queue_size_ * LANE_SHED_EIGHTHS[lane_index] / 8;
+        return threshold == 0 ? 1 : threshold;
+    }
+
+    const std::size_t max_queue_size_;                          ///< 队列容量上限
+    mutable std::mutex mutex_;                                  ///< 保护队列
+    std::condition_variable condition_;                         ///< 任务到达通知
+    std::array<std::deque<std::function<void()>>, LANE_COUNT> lanes_;  ///< 各通道任务队列
+    std::array<int, LANE_COUNT> credits_;                       ///< 本轮剩余出队配额
+    std::vector<std::thread> workers_;                          ///< 工作线程
+    bool stop_requested_ = false;                               ///< 停止标志
+};
+
+} // namespace strategy
+
+#endif // STRATEGY_BOUNDEDWORKERPOOL_H
@@ -0,0 +1,172 @@
+/*
+ * 文件名: EventRecord.h
+ * 说明: 紧凑事件记录（池化、内联参数、溢出竞技场）
+ * 作者: 彭承康
+ * 创建时间: 2026-08-28
+ *
+ * 高频事件（战斗 tick、移动）此前每次触发都要把
+ * std::vector<int> 参数拷贝进 EventTriggerResult 再转发到
+ * gRPC 层，堆分配随事件频率线性增长。本文件提供调度器与
+ * gRPC 适配层共用的紧凑记录格式：事件名用驻留 id，参数
+ * 不超过 8 个时内联存放，超出部分落入按代回收的整型
+ * 竞技场。记录本身由池复用，稳态下触发一次事件不产生
+ * 任何堆分配。
+ */
+#ifndef STRATEGY_EVENTRECORD_H
+#define STRATEGY_EVENTRECORD_H
+
+#include "StringInterner.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <span>
+#include <vector>
+
+namespace strategy {
+
+/// 记录内联参数容量，超出的参数进入溢出竞技场
+inline constexpr std::size_t EVENT_INLINE_PARAM_CAPACITY = 8;
+
+/**
+ * @brief 溢出参数竞技场
+ *
+ * 按块分配的整型 bump 分配器。Reset() 只回退游标、保留
+ * 已有块，稳态下 Allocate 不触碰堆。返回的指针在下一次
+ * Reset() 前有效。
+ */
+class EventParamArena {
+public:
+    /**
+     * @brief 分配count个int的连续存储
+     */
+    int* Allocate(std::size_t count) {
+        if (count > CHUNK_CAPACITY) {
+            // 超大参数列表单独成块，同样随Reset()复用
+            oversized_.push_back(std::make_unique<int[]>(count));
+            return oversized_.back().get();
+        }
+        if (chunk_index_ >= chunks_.size() || offset_ + count > CHUNK_CAPACITY) {
+            if (chunk_index_ < chunks_.size() && offset_ + count > CHUNK_CAPACITY) {
+                ++chunk_index_;
+            }
+            if (chunk_index_ >= chunks_.size()) {
+                chunks_.push_back(std::make_unique<int[]>(CHUNK_CAPACITY));
+            }
+            offset_ = 0;
+        }
+        int* out = chunks_[chunk_index_].get() + offset_;
+        offset_ += count;
+        return out;
+    }
+
+    /**
+     * @brief 回收本代全部分配，保留底层块
+     */
+    void Reset() {
+        chunk_index_ = 0;
+        offset_ = 0;
+        oversized_.clear();
+    }
+
+private:
+    static constexpr std::size_t CHUNK_CAPACITY = 1024;
+
+    std::vector<std::unique_ptr<int[]>> chunks_;
+    std::vector<std::unique_ptr<int[]>> oversized_;
+    std::size_t chunk_index_ = 0;
+    std::size_t offset_ = 0;
+};
+
+/**
+ * @brief 紧凑事件记录
+ *
+ * 事件名以驻留 id 表示，参数小于等于内联容量时存放在
+ * 记录内部，否则指向竞技场中的溢出区。溢出参数的生命期
+ * 与所属池的当前代一致。
+ */
+struct CompactEventRecord {
+    int event_id = 0;
+    StringId name_id = kInvalidStringId;
+
+    /**
+     * @brief 写入参数（内联或落入竞技场）
+     */
+    void AssignParams(std::span<const int> params, EventParamArena& arena) {
+        param_count_ = static_cast<std::uint32_t>(params.size());
+        if (params.size() <= EVENT_INLINE_PARAM_CAPACITY) {
+            spill_params_ = nullptr;
+            for (std::size_t i = 0; i < params.size(); ++i) {
+                inline_params_[i] = params[i];
+            }
+        } else {
+            spill_params_ = arena.Allocate(params.size());
+            for (std::size_t i = 0; i < params.size(); ++i) {
+                spill_params_[i] = params[i];
+            }
+        }
+    }
+
+    /**
+     * @brief 参数视图（零拷贝）
+     */
+    std::span<const int> Params() const {
+        const int* base = spill_params_ ? spill_params_ : inline_params_.data();
+        return std::span<const int>(base, param_count_);
+    }
+
+private:
+    std::array<int, EVENT_INLINE_PARAM_CAPACITY> inline_params_{};
+    int* spill_params_ = nullptr;
+    std::uint32_t param_count_ = 0;
+};
+
+/**
+ * @brief 事件记录池
+ *
+ * 按代复用记录与溢出竞技场：Acquire 取出下一条空闲记录，
+ * Reset 使本代全部记录与溢出参数重新可用。记录存放在
+ * std::deque 中，扩容不搬移已借出的记录。
+ */
+class EventRecordPool {
+public:
+    /**
+     * @brief 取一条记录并填充
+     */
+    CompactEventRecord& Acquire(int event_id, StringId name_id, std::span<const int> params) {
+        if (in_use_ >= records_.size()) {
+            records_.emplace_back();
+        }
+        CompactEventRecord& record = records_[in_use_++];
+        record.event_id = event_id;
+        record.name_id = name_id;
+        record.AssignParams(params, arena_);
+        return record;
+    }
+
+    /**
+     * @brief 回收本代全部记录与溢出参数
+     */
+    void Reset() {
+        in_use_ = 0;
+        arena_.Reset();
+    }
+
+    /**
+     * @brief 当前借出的记录数
+     */
+    std::size_t InUse() const {
+        return in_use_;
+    }
+
+private:
+    std::deque<CompactEventRecord> records_;
+    EventParamArena arena_;
+    std::size_t in_use_ = 0;
+};
+
+} // namespace strategy
+
+#endif // STRATEGY_EVENTRECORD_H
@@ -0,0 +1,178 @@
+/*
+ * 文件名: ExecutorService.h
+ * 说明: 策略层共享执行器（命名通道的统一线程池入口）
+ * 作者: 彭承康
+ * 创建时间: 2026-08-28
+ *
+ * 各子系统（日志、事件处理、数据库回调）不再各自起线程，
+ * 而是把任务提交到进程内唯一的共享执行器：总线程数与队列
+ * 容量在一处配置（Configure），8核宿主机上不再因每个子系统
+ * 各养一套worker而超订。
+ *
+ * 通道复用BoundedWorkerPool的加权轮转与卸载语义：事件处理
+ * 延迟敏感走高优先级通道，数据库回调次之，日志批量分发走
+ * 最低优先级且压力下最先被卸载（被拒的任务由调用方内联
+ * 降级执行，不丢任务）。每通道提交/拒绝计数写入
+ * PerformanceMonitor计数器注册表，队列深度可随时查询。
+ */
+
+#ifndef STRATEGY_EXECUTORSERVICE_H
+#define STRATEGY_EXECUTORSERVICE_H
+
+#include "BoundedWorkerPool.h"
+#include "../monitor/PerformanceMonitor.h"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+namespace strategy {
+
+/**
+ * @brief 共享执行器的命名通道
+ *
+ * 序号即BoundedWorkerPool的优先级通道：事件 > 数据库回调 > 日志。
+ */
+enum class ExecutorLane : std::uint8_t {
+    Events = 0,       ///< 事件处理器（延迟敏感）
+    DbCallbacks = 1,  ///< 数据库异步回调
+    Logging = 2,      ///< 日志批量分发（可卸载，调用方内联降级）
+};
+
+/**
+ * @brief 策略层共享执行器
+ *
+ * 通常经GetInstance()使用进程级实例；测试可自建实例验证
+ * 配置与通道行为。底层线程池在首次提交时惰性创建，Configure
+ * 仅在此之前生效。
+ */
+class ExecutorService {
+public:
+    static constexpr std::size_t LANE_COUNT = BoundedWorkerPool::LANE_COUNT;  ///< 通道数
+    static constexpr std::size_t DEFAULT_THREAD_COUNT =
+        BoundedWorkerPool::DEFAULT_THREAD_COUNT;  ///< 默认工作线程数
+    static constexpr std::size_t DEFAULT_QUEUE_SIZE =
+        BoundedWorkerPool::DEFAULT_MAX_QUEUE_SIZE;  ///< 默认队列容量
+
+    /**
+     * @brief 获取进程级共享实例
+     * @return ExecutorService实例引用
+     */
+    static ExecutorService& GetInstance() {
+        static ExecutorService instance;
+        return instance;
+    }
+
+    ExecutorService() = default;
+
+    ExecutorService(const ExecutorService&) = delete;
+    ExecutorService& operator=(const ExecutorService&) = delete;
+
+    /**
+     * @brief 配置线程数与队列容量（仅在线程池创建前生效）
+     *
+     * 服务启动早期调用一次；首次Submit之后线程数固定，
+     * 再配置返回false。
+     *
+     * @param thread_count 工作线程数（0回退为默认值）
+     * @param queue_size 队列容量上限（全通道合计，0回退为默认值）
+     * @return 配置是否生效
+     */
+    bool Configure(std::size_t thread_count, std::size_t queue_size) {
+        std::lock_guard<std::mutex> lock(pool_mutex_);
+        if (pool_ != nullptr) {
+            return false;
+        }
+        thread_count_ = thread_count == 0 ? DEFAULT_THREAD_COUNT : thread_count;
+        queue_size_ = queue_size == 0 ? DEFAULT_QUEUE_SIZE : queue_size;
+        return true;
+    }
+
+    /**
+     * @brief 按通道提交一个任务
+     *
+     * 通道被卸载或执行器已停止时返回false，调用方自行降级
+     * （通常内联执行），任务永不静默丢失。
+     *
+     * @param lane 命名通道
+     * @param task 任务
+     * @return 是否已入队
+     */
+    bool Submit(ExecutorLane lane, std::function<void()> task) {
+        const auto lane_index = static_cast<std::size_t>(lane);
+        const bool accepted =
+            Pool().TryEnqueue(static_cast<TaskLane>(lane), std::move(task));
+        if (accepted) {
+            submitted_[lane_index].fetch_add(1, std::memory_order_relaxed);
+        } else {
+            rejected_[lane_index].fetch_add(1, std::memory_order_relaxed);
+            RejectedCounter(lane_index).fetch_add(1, std::memory_order_relaxed);
+        }
+        return accepted;
+    }
+
+    /**
+     * @brief 指定通道的当前排队任务数
+     */
+    std::size_t GetQueueDepth(ExecutorLane lane) const {
+        std::lock_guard<std::mutex> lock(pool_mutex_);
+        if (pool_ == nullptr) {
+            return 0;
+        }
+        return pool_->GetQueuedCount(static_cast<TaskLane>(lane));
+    }
+
+    /**
+     * @brief 指定通道的累计提交成功数
+     */
+    std::uint64_t GetSubmittedCount(ExecutorLane lane) const {
+        return submitted_[static_cast<std::size_t>(lane)].load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief 指定通道的累计拒绝数（卸载/停止）
+     */
+    std::uint64_t GetRejectedCount(ExecutorLane lane) const {
+        return rejected_[static_cast<std::size_t>(lane)].load(std::memory_order_relaxed);
+    }
+
+private:
+    /**
+     * @brief 惰性创建并返回底层线程池
+     */
+    BoundedWorkerPool& Pool() {
+        std::lock_guard<std::mutex> lock(pool_mutex_);
+        if (pool_ == nullptr) {
+            pool_ = std::make_unique<BoundedWorkerPool>(thread_count_, queue_size_);
+        }
+        return *pool_;
+    }
+
+    /**
+     * @brief 通道拒绝计数的监控注册表入口（引用进程生命周期有效）
+     */
+    static std::atomic<std::uint64_t>& RejectedCounter(std::size_t lane_index) {
+        static const std::array<std::atomic<std::uint64_t>*, LANE_COUNT> counters = {
+            &PerformanceMonitor::GetInstance().GetCounter("executor_events_rejected"),
+            &PerformanceMonitor::GetInstance().GetCounter("executor_db_callbacks_rejected"),
+            &PerformanceMonitor::GetInstance().GetCounter("executor_logging_rejected"),
+        };
+        return *counters[lane_index];
+    }
+
+    mutable std::mutex pool_mutex_;                     ///< 保护惰性创建与配置
+    std::unique_ptr<BoundedWorkerPool> pool_;           ///< 底层共享线程池
+    std::size_t thread_count_ = DEFAULT_THREAD_COUNT;   ///< 配置的线程数
+    std::size_t queue_size_ = DEFAULT_QUEUE_SIZE;       ///< 配置的队列容量
+    std::array<std::atomic<std::uint64_t>, LANE_COUNT> submitted_{};  ///< 每通道提交数
+    std::array<std::atomic<std::uint64_t>, LANE_COUNT> rejected_{};   ///< 每通道拒绝数
+};
+
+} // namespace strategy
+
+#endif // STRATEGY_EXECUTORSERVICE_H
@@ -0,0 +1,168 @@
+/*
+ * 文件名: StrategyResult.h
+ * 说明: 策略层无分配错误传播通道（expected风格）
+ * 作者: 彭承康
+ * 创建时间: 2026-08-28
+ *
+ * 热路径上的可预期失败（连接池关闭、连接为空、约束冲突）走
+ * 返回值而不是异常：抛出/展开的开销与异常消息的字符串拼接都
+ * 发生在借出、查询这类每请求路径上，对尾延迟影响明显。
+ *
+ * StrategyError 构造时只记录错误码与静态上下文字符串，不做任何
+ * 堆分配；完整消息在调用 Message() 时才惰性拼接，成功路径和
+ * "检查后丢弃"的失败路径都不付格式化成本。携带驱动侧动态详情
+ * 的构造仅用于真正失败的冷路径。
+ *
+ * 真正异常的失败（配置错误、构造期初始化失败）仍然抛出
+ * StrategyException；Result::ValueOrThrow() 负责在两种风格的
+ * 边界上转换。
+ */
+#ifndef STRATEGY_STRATEGYRESULT_H
+#define STRATEGY_STRATEGYRESULT_H
+
+#include "StrategyException.h"
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <variant>
+
+namespace strategy {
+
+/**
+ * @brief 策略层错误码
+ *
+ * 取值即 StrategyException::GetErrorCode() 使用的错误码，
+ * 两条错误通道共用同一套编号。
+ */
+enum class StrategyErrc : std::uint16_t {
+    Ok = 0,                  ///< 无错误（仅作哨兵，不应出现在错误对象中）
+    PoolShutdown = 1,        ///< 连接池已关闭
+    ConnectionCreateFailed,  ///< 新建数据库连接失败
+    NotConnected,            ///< 连接为空或未建立
+    QueryFailed,             ///< 语句执行失败（驱动侧错误）
+    ConstraintViolation,     ///< 唯一键/约束冲突
+    InvalidArgument,         ///< 参数非法
+    NotFound,                ///< 目标记录不存在
+};
+
+/**
+ * @brief 错误码的稳定文本名（用于日志与消息拼接）
+ */
+constexpr const char* StrategyErrcName(StrategyErrc code) noexcept {
+    switch (code) {
+        case StrategyErrc::Ok:                     return "ok";
+        case StrategyErrc::PoolShutdown:           return "pool_shutdown";
+        case StrategyErrc::ConnectionCreateFailed: return "connection_create_failed";
+        case StrategyErrc::NotConnected:           return "not_connected";
+        case StrategyErrc::QueryFailed:            return "query_failed";
+        case StrategyErrc::ConstraintViolation:    return "constraint_violation";
+        case StrategyErrc::InvalidArgument:        return "invalid_argument";
+        case StrategyErrc::NotFound:               return "not_found";
+    }
+    return "unknown";
+}
+
+/**
+ * @brief 轻量错误对象
+ *
+ * 两参构造（码 + 静态上下文字面量）不做堆分配，适合热路径；
+ * 三参构造携带驱动返回的动态详情，仅在失败冷路径使用。
+ */
+class StrategyError {
+public:
+    /**
+     * @brief 无分配构造
+     * @param code 错误码
+     * @param context 上下文说明，必须是静态存储期的字符串字面量
+     */
+    StrategyError(StrategyErrc code, const char* context) noexcept
+        : code_(code), context_(context) {}
+
+    /**
+     * @brief 带动态详情的构造（冷路径）
+     * @param detail 驱动或底层库返回的详情文本
+     */
+    StrategyError(StrategyErrc code, const char* context, std::string detail)
+        : code_(code), context_(context), detail_(std::move(detail)) {}
+
+    StrategyErrc Code() const noexcept { return code_; }
+    const char* Context() const noexcept { return context_; }
+    const std::string& Detail() const noexcept { return detail_; }
+
+    /**
+     * @brief 惰性拼接完整错误消息
+     *
+     * 只有调用方确实要记录或上抛时才付字符串构造成本。
+     */
+    std::string Message() const {
+        std::string message(context_);
+        if (!detail_.empty()) {
+            message += ": ";
+            message += detail_;
+        }
+        message += " [";
+        message += StrategyErrcName(code_);
+        message += "]";
+        return message;
+    }
+
+    /**
+     * @brief 转换为策略层异常（result风格 → 异常风格的边界）
+     */
+    StrategyException ToException() const {
+        return StrategyException(Message(), static_cast<int>(code_));
+    }
+
+private:
+    StrategyErrc code_;
+    const char* context_;  ///< 静态字面量，不持有所有权
+    std::string detail_;   ///< 动态详情，热路径上为空
+};
+
+/**
+ * @brief 值或错误的二选一返回类型（std::expected风格）
+ *
+ * C++20下自备的最小实现：值和错误都按值持有，隐式从两者构造，
+ * 使 `return value;` 与 `return StrategyError{...};` 都能直写。
+ */
+template <typename T>
+class [[nodiscard]] Result {
+public:
+    Result(T value) : storage_(std::in_place_index<0>, std::move(value)) {}
+    Result(StrategyError error) : storage_(std::in_place_index<1>, std::move(error)) {}
+
+    bool HasValue() const noexcept { return storage_.index() == 0; }
+    explicit operator bool() const noexcept { return HasValue(); }
+
+    T& Value() & { return std::get<0>(storage_); }
+    const T& Value() const& { return std::get<0>(storage_); }
+    T&& Value() && { return std::get<0>(std::move(storage_)); }
+
+    const StrategyError& Error() const { return std::get<1>(storage_); }
+
+    /**
+     * @brief 取值，失败时退回给定默认值
+     */
+    T ValueOr(T fallback) const& {
+        return HasValue() ? std::get<0>(storage_) : std::move(fallback);
+    }
+
+    /**
+     * @brief 取值，失败时抛出 StrategyException
+     *
+     * 保留异常接口的旧调用方经此委托，行为不变。
+     */
+    T ValueOrThrow() && {
+        if (!HasValue()) {
+            throw Error().ToException();
+        }
+        return std::get<0>(std::move(storage_));
+    }
+
+private:
+    std::variant<T, StrategyError> storage_;
+};
+
+} // namespace strategy
+
+#endif // STRATEGY_STRATEGYRESULT_H
@@ -0,0 +1,97 @@
+/*
+ * 文件名: StringInterner.h
+ * 说明: 字符串驻留表（名字 → 稳定整数 id）
+ * 作者: 彭承康
+ * 创建时间: 2026-08-28
+ *
+ * 变量名、旗标名、事件名在加载期注册一次，热路径改用 u32 id
+ * 做整数哈希与比较，避免每个世界 tick 的字符串哈希与拷贝。
+ */
+
+#ifndef STRATEGY_STRINGINTERNER_H
+#define STRATEGY_STRINGINTERNER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+
+namespace strategy {
+
+/// 驻留字符串 id，从 0 起连续分配
+using StringId = std::uint32_t;
+
+/// 无效 id（Find 未命中时返回）
+inline constexpr StringId kInvalidStringId = 0xFFFFFFFFu;
+
+/**
+ * @brief 线程安全的字符串驻留表
+ *
+ * id 注册后永不失效。NameOf 返回的引用在表的生命周期内
+ * 保持有效：名字存放在 std::deque 中，追加不搬移已有元素。
+ */
+class StringInterner {
+public:
+    /**
+     * @brief 注册名字（已注册则返回原 id）
+     * @param name 要驻留的名字
+     * @return 该名字的稳定 id
+     */
+    StringId Intern(const std::string& name) {
+        {
+            std::shared_lock<std::shared_mutex> lock(mutex_);
+            auto it = ids_.find(name);
+            if (it != ids_.end()) {
+                return it->second;
+            }
+        }
+
+        std::unique_lock<std::shared_mutex> lock(mutex_);
+        auto it = ids_.find(name);
+        if (it != ids_.end()) {
+            return it->second;
+        }
+        const StringId id = static_cast<StringId>(names_.size());
+        names_.push_back(name);
+        ids_.emplace(name, id);
+        return id;
+    }
+
+    /**
+     * @brief 查找名字的 id
+     * @return 未注册时返回 kInvalidStringId
+     */
+    StringId Find(const std::string& name) const {
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        auto it = ids_.find(name);
+        return it != ids_.end() ? it->second : kInvalidStringId;
+    }
+
+    /**
+     * @brief id 对应的名字
+     * @return 无效 id 返回空串
+     */
+    const std::string& NameOf(StringId id) const {
+        static const std::string empty;
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        return id < names_.size() ? names_[id] : empty;
+    }
+
+    /** @brief 已注册的名字数量 */
+    std::size_t Size() const {
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        return names_.size();
+    }
+
+private:
+    mutable std::shared_mutex mutex_;
+    std::unordered_map<std::string, StringId> ids_;
+    std::deque<std::string> names_;
+};
+
+} // namespace strategy
+
+#endif // STRATEGY_STRINGINTERNER_H
@@ -0,0 +1,201 @@
+/*
+ * 文件名: AssetChunkStore.h
+ * 说明: 资源分块存储，为客户端提供按内容哈希的增量传输
+ * 作者: 彭承康
+ * 创建时间: 2026-08-28
+ *
+ * 把资源内容切成固定大小的块并对每块计算SHA-256，对外提供
+ * 清单（块哈希列表）与范围读取两个原语：客户端先拉清单，与
+ * 本地按哈希键入的块缓存比对，只下载缺失或变化的块；断点续传
+ * 天然成立——已到手的块按哈希缓存，重试时直接跳过。
+ *
+ * 与ConfigService相同的快照组织：读取方解引用原子快照指针，
+ * 不加锁；写入方（增删资源）构建新快照后整体原子替换，清单
+ * 版本号随之递增，客户端据此判断缓存是否过期。
+ */
+
+#ifndef STRATEGY_ASSET_CHUNK_STORE_H
+#define STRATEGY_ASSET_CHUNK_STORE_H
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace strategy {
+
+/**
+ * @brief 单个资源块的清单条目
+ */
+struct AssetChunkInfo {
+    std::uint32_t index = 0;     ///< 块序号（从0开始）
+    std::uint64_t offset = 0;    ///< 块在资源内的字节偏移
+    std::uint32_t size = 0;      ///< 块字节数（末块可能不足块大小）
+    std::string hash;            ///< 块内容的SHA-256（十六进制）
+};
+
+/**
+ * @brief 单个资源的清单条目
+ */
+struct AssetManifestEntry {
+    std::string name;                    ///< 资源名（相对路径风格）
+    std::uint64_t size = 0;              ///< 资源总字节数
+    std::string hash;                    ///< 整体内容的SHA-256（十六进制）
+    std::uint32_t chunk_size = 0;        ///< 切块大小
+    std::vector<AssetChunkInfo> chunks;  ///< 块列表（按偏移升序）
+};
+
+/**
+ * @brief 全量资源清单快照
+ */
+struct AssetManifest {
+    std::uint64_t version = 0;               ///< 单调递增的清单版本号
+    std::vector<AssetManifestEntry> assets;  ///< 资源列表（按名称升序）
+};
+
+/**
+ * @brief 一次范围读取的结果
+ */
+struct AssetChunkData {
+    bool found = false;          ///< 资源是否存在且偏移有效
+    std::uint64_t offset = 0;    ///< 实际起始偏移
+    std::string data;            ///< 字节内容（可能被钳到资源末尾）
+    std::string hash;            ///< 范围恰为一个清单块时为该块哈希，否则为空
+    bool eof = false;            ///< 本次读取是否到达资源末尾
+};
+
+/**
+ * @brief 资源分块存储
+ *
+ * 写入方增删资源时重新切块并计算哈希（O(资源大小)），读取方
+ * 取清单与读范围均为无锁快照访问，适合被gRPC处理线程直接调用。
+ */
+class AssetChunkStore {
+public:
+    /// 默认切块大小；64KB在弱网上重传代价与清单体积之间取平衡
+    static constexpr std::uint32_t DEFAULT_CHUNK_SIZE = 64 * 1024;
+
+    /**
+     * @brief 构造存储
+     * @param chunk_size 切块大小（字节），0回退为默认值
+     */
+    explicit AssetChunkStore(std::uint32_t chunk_size = DEFAULT_CHUNK_SIZE);
+
+    /**
+     * @brief 添加或替换一个资源
+     *
+     * 切块与哈希在调用线程完成，成功后原子替换快照并递增
+     * 清单版本号；内容未变化（整体哈希相同）时不发布新快照。
+     *
+     * @param name 资源名
+     * @param content 资源内容（按值传入并被存储接管）
+     * @return 是否产生了新版本（内容未变化时返回false）
+     */
+    bool AddAsset(const std::string& name, std::string content);
+
+    /**
+     * @brief 从文件加载一个资源
+     * @param name 资源名
+     * @param path 文件路径
+     * @return 读取并添加是否成功
+     */
+    bool LoadAssetFile(const std::string& name, const std::string& path);
+
+    /**
+     * @brief 递归加载一个目录下的全部文件
+     *
+     * 资源名取相对目录的generic路径（正斜杠分隔），与客户端
+     * 缓存键保持平台无关。
+     *
+     * @param dir 目录路径
+     * @return 成功加载的文件数（目录不存在时为0）
+     */
+    std::size_t LoadAssetDirectory(const std::string& dir);
+
+    /**
+     * @brief 移除一个资源
+     * @param name 资源名
+     * @return 资源原本是否存在
+     */
+    bool RemoveAsset(const std::string& name);
+
+    /**
+     * @brief 获取当前清单快照（无锁）
+     *
+     * 客户端在一次同步内持有同一份快照，与期间发生的资源
+     * 更新互不影响。
+     *
+     * @return 当前清单，未加载任何资源时为空清单（version 0）
+     */
+    std::shared_ptr<const AssetManifest> GetManifest() const;
+
+    /**
+     * @brief 读取一个资源的字节范围（无锁）
+     *
+     * 偏移越界时返回not found；长度被钳到资源末尾。范围恰好
+     * 对齐一个清单块时回带该块哈希，客户端可据此校验后入缓存。
+     *
+     * @param name 资源名
+     * @param offset 起始字节偏移
+     * @param max_bytes 最大读取字节数（0回退为切块大小）
+     * @return 范围读取结果
+     */
+    AssetChunkData ReadRange(const std::string& name,
+                             std::uint64_t offset,
+                             std::uint32_t max_bytes) const;
+
+    /**
+     * @brief 按块哈希读取（无锁）
+     *
+     * 命中客户端缓存键的反向路径：清单里出现过的哈希直接
+     * 定位到块，无须携带资源名与偏移。
+     *
+     * @param hash 块内容的SHA-256（十六进制）
+     * @return 范围读取结果（未知哈希为not found）
+     */
+    AssetChunkData ReadChunkByHash(const std::string& hash) const;
+
+    /**
+     * @brief 当前清单版本号（无锁）
+     */
+    std::uint64_t GetVersion() const;
+
+private:
+    /// 一份不可变内容快照：清单 + 内容 + 哈希反查索引
+    struct Snapshot {
+        AssetManifest manifest;
+        /// 资源名 → 内容；内容以shared_ptr共享，快照替换不复制字节
+        std::unordered_map<std::string, std::shared_ptr<const std::string>> contents;
+        /// 块哈希 → (资源名, 块序号)
+        std::unordered_map<std::string, std::pair<std::string, std::uint32_t>> chunk_index;
+    };
+
+    /**
+     * @brief 为一段内容构建清单条目（切块 + 逐块哈希）
+     * @param name 资源名
+     * @param content 资源内容
+     * @return 清单条目
+     */
+    AssetManifestEntry BuildEntry(const std::string& name,
+                                  const std::string& content) const;
+
+    /**
+     * @brief 以当前快照为基础发布变更（writer_mutex_内调用）
+     * @param name 变更的资源名
+     * @param content 新内容；空指针表示移除
+     * @return 是否发布了新快照
+     */
+    bool PublishLocked(const std::string& name,
+                       std::shared_ptr<const std::string> content);
+
+    std::uint32_t chunk_size_;                           ///< 切块大小
+    std::atomic<std::shared_ptr<const Snapshot>> snapshot_;  ///< 当前快照
+    mutable std::mutex writer_mutex_;                    ///< 串行化写入方
+};
+
+} // namespace strategy
+
+#endif // STRATEGY_ASSET_CHUNK_STORE_H
@@ -7,22 +7,44 @@
  * 本类提供统一的配置管理接口，支持从文件加载配置，
  * 并提供类型安全的配置项访问方法。采用单例模式确保
  * 全局配置的一致性。
+ *
+ * 配置以不可变快照组织：读取方解引用原子快照指针，不加锁；
+ * 写入方（加载、热重载、SetString）构建新快照后整体原子替换。
+ * 配合后台文件监视线程实现零停机热重载：解析和校验在监视线程
+ * 完成，失败时保留旧快照，服务无须重启即可下发调参。
  */
 
 #ifndef STRATEGY_CONFIG_SERVICE_H
 #define STRATEGY_CONFIG_SERVICE_H
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <filesystem>
 #include <string>
 #include <memory>
 #include <map>
 #include <mutex>
+#include <thread>
 #include <vector>
 
 namespace strategy {
 
+/**
+ * @brief 不可变配置快照
+ *
+ * 一次加载/重载的完整结果。发布后不再修改，读取方可以长期
+ * 持有shared_ptr在多个键之间保持一致视图。
+ */
+struct ConfigSnapshot {
+    std::map<std::string, std::string> values;  ///< 配置键值
+    std::uint64_t version = 0;                  ///< 单调递增的快照版本号
+};
+
 /**
  * @brief 配置管理服务
- * 
+ *
  * 提供统一的配置管理功能，支持从JSON/YAML文件加载配置，
  * 并提供类型安全的配置项访问接口。
  */
@@ -36,6 +58,10 @@ public:
 
     /**
      * @brief 从文件加载配置
+     *
+     * 解析和校验在调用线程完成，成功后原子替换快照；
+     * 失败时保留当前快照，读取方不受影响。
+     *
      * @param config_file 配置文件路径
      * @return 加载是否成功
      */
@@ -48,13 +74,47 @@ public:
      */
     bool LoadFromJson(const std::string& json_content);
 
+    /**
+     * @brief 获取当前配置快照（无锁）
+     *
+     * 需要在多个键之间保持一致视图的读取方持有返回的快照，
+     * 期间发生的热重载不影响已持有的指针。
+     *
+     * @return 当前快照，加载前为空快照（version 0）
+     */
+    std::shared_ptr<const ConfigSnapshot> GetSnapshot() const;
+
+    /**
+     * @brief 当前快照版本号（无锁）
+     *
+     * 每次成功的加载/重载/SetString递增；调用方可据此检测
+     * 配置是否变化并失效自己的派生缓存。
+     */
+    std::uint64_t GetVersion() const;
+
+    /**
+     * @brief 开始监视配置文件变化
+     *
+     * 启动后台线程按poll_interval轮询文件修改时间，变化时
+     * 在监视线程解析并原子替换快照（热重载）。重复调用无效果。
+     *
+     * @param poll_interval 轮询间隔
+     * @return 是否成功启动（尚未LoadConfig时返回false）
+     */
+    bool StartWatching(std::chrono::milliseconds poll_interval = DEFAULT_WATCH_INTERVAL);
+
+    /**
+     * @brief 停止监视配置文件
+     */
+    void StopWatching();
+
     /**
      * @brief 获取字符串配置项
      * @param key 配置键
      * @param default_value 默认值
      * @return 配置值
      */
-    std::string GetString(const std::string& key, const std::string& default_value = "");
+    std::string GetString(const std::string& key, const std::string& default_value = "") const;
 
     /**
      * @brief 获取整数配置项
@@ -62,7 +122,7 @@ public:
      * @param default_value 默认值
      * @return 配置值
      */
-    int GetInt(const std::string& key, int default_value = 0);
+    int GetInt(const std::string& key, int default_value = 0) const;
 
     /**
      * @brief 获取布尔配置项
@@ -70,7 +130,7 @@ public:
      * @param default_value 默认值
      * @return 配置值
      */
-    bool GetBool(const std::string& key, bool default_value = false);
+    bool GetBool(const std::string& key, bool default_value = false) const;
 
     /**
      * @brief 获取浮点数配置项
@@ -78,10 +138,13 @@ public:
      * @param default_value 默认值
      * @return 配置值
      */
-    double GetDouble(const std::string& key, double default_value = 0.0);
+    double GetDouble(const std::string& key, double default_value = 0.0) const;
 
     /**
      * @brief 设置配置项
+     *
+     * 以当前快照为基础构建含新值的快照并原子替换。
+     *
      * @param key 配置键
      * @param value 配置值
      */
@@ -106,22 +169,47 @@ public:
      */
     std::vector<std::string> GetAllKeys() const;
 
+    /// 默认的文件监视轮询间隔
+    static constexpr std::chrono::milliseconds DEFAULT_WATCH_INTERVAL{1000};
+
 private:
-    ConfigService() = default;
-    ~ConfigService() = default;
+    ConfigService();
+    ~ConfigService();
     ConfigService(const ConfigService&) = delete;
     ConfigService& operator=(const ConfigService&) = delete;
 
-    std::map<std::string, std::string> config_data_;  ///< 配置数据存储
-    std::string config_file_path_;                    ///< 配置文件路径
-    mutable std::mutex config_mutex_;                 ///< 线程安全锁
+    /// 当前配置快照；读取方原子加载，写入方原子替换
+    std::atomic<std::shared_ptr<const ConfigSnapshot>> snapshot_;
+
+    std::string config_file_path_;                    ///< 配置文件路径（writer_mutex_保护）
+    std::filesystem::file_time_type loaded_mtime_{};  ///< 上次成功加载时的文件修改时间
+    mutable std::mutex writer_mutex_;                 ///< 串行化写入方（不拦截读取）
+
+    std::thread watcher_;                             ///< 文件监视线程
+    std::mutex watcher_mutex_;                        ///< 监视线程的启停同步
+    std::condition_variable watcher_cv_;              ///< 轮询等待/提前唤醒
+    bool watching_ = false;                           ///< 监视线程运行标志
 
     /**
      * @brief 解析JSON配置内容
      * @param json_content JSON内容
+     * @param out 解析出的键值对
      * @return 解析是否成功
      */
-    bool ParseJsonContent(const std::string& json_content);
+    bool ParseJsonContent(const std::string& json_content,
+                          std::map<std::string, std::string>& out) const;
+
+    /**
+     * @brief 发布新快照（writer_mutex_内调用）
+     * @param values 新快照的键值对
+     */
+    void PublishLocked(std::map<std::string, std::string> values);
+
+    /**
+     * @brief 文件监视循环
+     * @param poll_interval 轮询间隔
+     */
+    void WatchLoop(std::chrono::milliseconds poll_interval);
 
     /**
      * @brief 从嵌套键获取值
@@ -8,8 +8,12 @@
 #define STRATEGY_DATABASE_BASEREPOSITORY_H
 
 #include "database/IDatabaseConnection.h"
+#include "common/StrategyResult.h"
+#include <chrono>
+#include <cstddef>
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace strategy {
 
@@ -23,13 +27,59 @@ protected:
     
     /**
      * @brief 执行查询并返回结果
+     *
+     * 语句耗时记入PerformanceMonitor的db_query_latency直方图；
+     * 超过慢查询阈值的语句进入慢查询日志，并按限速补抓EXPLAIN。
      */
     QueryResult ExecuteQuery(const std::string& query, const std::vector<std::any>& params = {});
-    
+
     /**
      * @brief 执行更新操作
+     *
+     * 计时与慢查询捕获同ExecuteQuery。
      */
     int ExecuteUpdate(const std::string& query, const std::vector<std::any>& params = {});
+
+    /**
+     * @brief 执行查询的无异常版本（热路径）
+     *
+     * 连接为空以 NotConnected 错误返回，不构造异常也不拼接
+     * 消息；驱动抛出的异常被翻译为带错误码的 StrategyError
+     *（约束冲突识别为 ConstraintViolation）。计时与慢查询捕获
+     * 同 ExecuteQuery。
+     */
+    Result<QueryResult> TryExecuteQuery(const std::string& query,
+                                        const std::vector<std::any>& params = {});
+
+    /**
+     * @brief 执行更新的无异常版本（热路径）
+     *
+     * 错误语义同 TryExecuteQuery；唯一键冲突这类业务上可预期
+     * 的失败经 Error().Code() 判别，调用方不再为此付异常展开
+     * 的开销。
+     */
+    Result<int> TryExecuteUpdate(const std::string& query,
+                                 const std::vector<std::any>& params = {});
+
+    // 流式查询默认每批行数
+    static constexpr std::size_t DEFAULT_STREAM_BATCH_SIZE = 256;
+
+    /**
+     * @brief 流式执行查询
+     *
+     * 结果按批次交给handler迭代，内存占用与结果行数无关，
+     * 供排行榜等大结果集查询使用。batch_size为1即逐行模式。
+     *
+     * @param query SQL语句
+     * @param params 绑定参数
+     * @param handler 批次回调，返回false提前终止
+     * @param batch_size 每批行数
+     * @return 实际交给回调的总行数
+     */
+    std::size_t ExecuteQueryStream(const std::string& query,
+                                   const std::vector<std::any>& params,
+                                   const RowBatchHandler& handler,
+                                   std::size_t batch_size = DEFAULT_STREAM_BATCH_SIZE);
     
     /**
      * @brief 开始事务
@@ -50,6 +100,96 @@ protected:
      * @brief 获取最后插入的ID
      */
     long long GetLastInsertId();
+
+    // 批量操作默认分块大小（每块一条多行语句、一个事务）
+    static constexpr std::size_t DEFAULT_BULK_CHUNK_SIZE = 500;
+
+    /**
+     * @brief 批量插入
+     *
+     * 按分块拼接多行 INSERT INTO ... VALUES (?,...),(?,...) 语句，
+     * 每块在独立事务中执行，失败的块整体回滚并中止后续块。
+     *
+     * @param table 表名
+     * @param columns 列名列表
+     * @param rows 行数据，每行的参数个数必须等于列数
+     * @param chunk_size 每块最大行数
+     * @return 实际插入的行数
+     * @throws std::invalid_argument 如果列为空或行宽不匹配
+     */
+    int ExecuteBulkInsert(const std::string& table,
+                          const std::vector<std::string>& columns,
+                          const std::vector<std::vector<std::any>>& rows,
+                          std::size_t chunk_size = DEFAULT_BULK_CHUNK_SIZE);
+
+    /**
+     * @brief 批量更新
+     *
+     * 对每行执行同一条参数化语句，按分块包在事务里提交，
+     * 免去逐行提交的开销。
+     *
+     * @param query 参数化更新语句（? 或 $n 占位）
+     * @param rows 每行一组参数
+     * @param chunk_size 每个事务包含的行数
+     * @return 实际更新的行数
+     */
+    int ExecuteBulkUpdate(const std::string& query,
+                          const std::vector<std::vector<std::any>>& rows,
+                          std::size_t chunk_size = DEFAULT_BULK_CHUNK_SIZE);
+
+    /**
+     * @brief 批量删除
+     *
+     * 按分块拼接 DELETE FROM ... WHERE key IN (?,...) 语句，
+     * 每块在独立事务中执行。
+     *
+     * @param table 表名
+     * @param key_column 主键列名
+     * @param keys 要删除的主键值列表
+     * @param chunk_size 每块最大主键数
+     * @return 实际删除的行数
+     */
+    int ExecuteBulkDelete(const std::string& table,
+                          const std::string& key_column,
+                          const std::vector<std::any>& keys,
+                          std::size_t chunk_size = DEFAULT_BULK_CHUNK_SIZE);
+
+private:
+    /**
+     * @brief 把驱动异常翻译为带错误码的 StrategyError
+     *
+     * 消息中出现约束/唯一键字样时归类为 ConstraintViolation，
+     * 其余归类为 QueryFailed；原始消息作为动态详情保留。
+     */
+    static StrategyError TranslateDriverError(const std::exception& e);
+
+    /**
+     * @brief 记录一次语句执行的耗时
+     *
+     * 写入db_query_latency直方图；达到慢查询阈值时写入慢查询
+     * 日志，并在拿到限速名额时经当前连接补抓EXPLAIN执行计划。
+     *
+     * @param query 刚执行的语句
+     * @param params 绑定参数
+     * @param start 执行开始时刻
+     */
+    void ObserveQuery(const std::string& query,
+                      const std::vector<std::any>& params,
+                      std::chrono::steady_clock::time_point start);
+
+    /**
+     * @brief 对语句补抓EXPLAIN执行计划
+     *
+     * 直接走connection_，不经计时包装，避免EXPLAIN自身再被
+     * 当作慢查询递归捕获；失败（语法不支持EXPLAIN、连接异常）
+     * 时返回空串，不影响主记录。
+     *
+     * @param query 待解释的语句
+     * @param params 绑定参数
+     * @return 执行计划文本，逐行换行拼接
+     */
+    std::string CaptureExplainPlan(const std::string& query,
+                                   const std::vector<std::any>& params);
 };
 
 } // namespace strategy
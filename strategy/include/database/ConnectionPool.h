@@ -3,12 +3,16 @@
  * 说明: 数据库连接池管理器，提供高效的数据库连接复用机制
  * 作者: 彭承康
  * 创建时间: 2026-02-18
+ * 更新时间: 2026-08-27 — 无锁快路径、异步获取与等待耗时直方图
+ * 更新时间: 2026-08-28 — 后台健康检查线程，借出路径不再同步探活
+ * 更新时间: 2026-08-28 — 负载自适应池大小：空闲缩到下限，排队涨到上限
  *
  * 本类实现数据库连接池功能，包括：
  * 1. 连接的创建、复用和回收
  * 2. 线程安全的连接获取和归还
  * 3. 连接池大小的动态管理
- * 4. 连接健康检查和自动重连
+ * 4. 后台线程对空闲连接做健康检查和自动重连
+ * 5. 按负载自适应调整池大小（见 AdaptPoolSize）
  *
  * 使用示例：
  *   DatabaseConfig config = {...};
@@ -22,113 +26,227 @@
 
 #include "IDatabaseConnection.h"
 #include "DatabaseConfig.h"
-#include <queue>
-#include <mutex>
+#include "common/StrategyResult.h"
+#include <array>
+#include <atomic>
+#include <chrono>
 #include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <future>
 #include <memory>
-#include <atomic>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
 
 namespace strategy {
 
+/**
+ * @brief 连接池状态快照
+ *
+ * wait_time_buckets 为连接获取等待耗时直方图，
+ * 桶边界见 ConnectionPool::WAIT_BUCKET_BOUNDS_MS：
+ * [<1ms, <10ms, <100ms, <1s, >=1s]。
+ */
+struct PoolStatus {
+    std::size_t total_connections = 0;       ///< 当前连接总数
+    std::size_t available_connections = 0;   ///< 池中空闲连接数
+    std::size_t target_size = 0;             ///< 自适应软上限（介于下限与上限之间）
+    std::uint64_t grow_decisions = 0;        ///< 累计扩容决策次数
+    std::uint64_t shrink_decisions = 0;      ///< 累计缩容决策次数
+    std::array<std::uint64_t, 5> wait_time_buckets{};  ///< 等待耗时直方图
+};
+
 /**
  * @brief 数据库连接池管理器
- * 
+ *
  * 提供高效的数据库连接复用机制，避免频繁创建和销毁连接的开销。
  * 支持多线程并发访问，自动管理连接的生命周期。
- * 
+ *
  * 核心功能：
  * - 预创建指定数量的数据库连接
  * - 线程安全的连接获取和归还
- * - 连接健康检查和自动重连
- * - 连接池大小的动态调整
- * - 连接超时和清理机制
- * 
+ * - 有空闲连接时走无锁快路径（Vyukov环形缓冲传递槽位下标）
+ * - 异步获取：池耗尽时挂起future而不是阻塞线程
+ * - 后台线程周期性探活空闲连接并补足到最小水位，
+ *   借出路径不做同步探活（MySQL的IsConnected要走一次
+ *   mysql_ping往返，放在借出热路径上代价过高）
+ * - 负载自适应池大小：借出只能涨到软上限 target_size_，
+ *   持续排队时后台线程分步上调软上限（至多到配置上限），
+ *   连续空闲若干轮后下调并物理关闭多余空闲连接（至少保留
+ *   配置下限），相邻两次调整之间有最小间隔限速
+ * - 获取等待耗时直方图
+ *
  * 线程安全性：本类是线程安全的，支持多线程并发访问
  */
 class ConnectionPool {
 public:
+    // 等待耗时直方图桶边界（毫秒），最后一桶为超出部分
+    static constexpr std::array<long long, 4> WAIT_BUCKET_BOUNDS_MS = {1, 10, 100, 1000};
+    static constexpr std::size_t WAIT_BUCKET_COUNT = WAIT_BUCKET_BOUNDS_MS.size() + 1;
+
     /**
      * @brief 构造函数
      * @param config 数据库配置信息，包含连接参数和池配置
      * @throws std::invalid_argument 如果配置无效
      * @throws DatabaseException 如果初始连接创建失败
-     * 
+     *
      * @note 构造时会预创建最小数量的连接
      */
     explicit ConnectionPool(const DatabaseConfig& config);
-    
+
     /**
      * @brief 析构函数
-     * 
+     *
      * 关闭所有活跃连接，清理资源。
      * 等待所有借出的连接归还后再销毁。
      */
     ~ConnectionPool();
-    
+
     /**
      * @brief 从连接池获取一个可用连接
-     * 
-     * 如果池中有可用连接，立即返回；否则创建新连接（不超过最大限制）。
-     * 如果达到最大连接数且无可用连接，将阻塞等待直到有连接归还。
-     * 
+     *
+     * 池中有空闲连接时通过无锁环形缓冲直接取出，不加互斥锁；
+     * 否则创建新连接（不超过自适应软上限）。如果达到软上限且
+     * 无可用连接，将阻塞等待直到有连接归还；等待同时作为负载
+     * 信号推动后台线程上调软上限。
+     *
      * @return std::shared_ptr<IDatabaseConnection> 数据库连接对象
-     * @throws DatabaseException 如果无法创建新连接
-     * @throws std::runtime_error 如果连接池已关闭
-     * 
-     * @note 返回的连接保证是已连接且健康的
+     * @throws StrategyException 如果连接池已关闭
+     *
+     * @note 委托 TryGetConnection，失败时把错误转为异常；
+     *       每请求热路径请直接使用 TryGetConnection
      * @note 使用完毕后必须调用 ReturnConnection 归还
      */
     std::shared_ptr<IDatabaseConnection> GetConnection();
-    
+
+    /**
+     * @brief 获取连接的无异常版本（热路径）
+     *
+     * 语义与 GetConnection 相同，但可预期失败（连接池已关闭）
+     * 以 StrategyError 返回而不抛异常：借出是每请求路径，
+     * 关停期间大量请求同时失败时异常展开会放大尾延迟。
+     * 错误对象构造无堆分配，消息在调用 Message() 时才拼接。
+     *
+     * @return Result<std::shared_ptr<IDatabaseConnection>>
+     *         成功为连接对象，失败为带错误码的 StrategyError
+     */
+    Result<std::shared_ptr<IDatabaseConnection>> TryGetConnection();
+
+    /**
+     * @brief 异步获取连接
+     *
+     * 有空闲连接或可创建新连接时返回已就绪的future；
+     * 池耗尽时将请求挂入等待队列，连接归还时按先后顺序满足，
+     * 调用线程不阻塞，适合gRPC处理器让出线程。
+     *
+     * @return std::future<std::shared_ptr<IDatabaseConnection>>
+     * @note 连接池关闭时，挂起的future以 std::runtime_error 结束
+     */
+    std::future<std::shared_ptr<IDatabaseConnection>> GetConnectionAsync();
+
     /**
      * @brief 将连接归还到连接池
-     * 
-     * 检查连接健康状态，如果连接正常则放回池中复用，
-     * 否则销毁连接并在需要时创建新连接补充。
-     * 
+     *
+     * 有异步等待者时直接转交连接；否则检查连接健康状态，
+     * 正常则放回池中复用，异常则尝试重连或销毁。
+     *
      * @param conn 要归还的数据库连接，不能为空
      * @throws std::invalid_argument 如果连接为空
-     * 
+     *
      * @note 归还后不应再使用该连接对象
      * @note 如果连接已断开，会自动销毁而不是放回池中
      */
     void ReturnConnection(std::shared_ptr<IDatabaseConnection> conn);
-    
+
     /**
      * @brief 获取连接池当前状态信息
-     * @return std::pair<size_t, size_t> 返回 (当前连接数, 可用连接数)
+     * @return PoolStatus 连接总数、空闲数与等待耗时直方图
      */
-    std::pair<size_t, size_t> GetPoolStatus() const;
-    
+    PoolStatus GetPoolStatus() const;
+
     /**
      * @brief 关闭连接池
-     * 
+     *
      * 停止接受新的连接请求，等待所有借出连接归还，
      * 然后关闭所有连接并清理资源。
-     * 
+     *
      * @note 关闭后的连接池不能再使用
+     * @note 挂起的异步请求以异常结束
      */
     void Shutdown();
-    
+
 private:
+    /**
+     * @brief 空闲槽位下标环形缓冲的槽
+     *
+     * sequence 采用Vyukov协议（与AsyncLogService的环形缓冲一致）：
+     * 等于下标表示可写，等于下标+1表示可读，取出后置为下标+容量。
+     * 生产/消费两侧均CAS竞争，无互斥锁。
+     */
+    struct IndexSlot {
+        std::atomic<std::size_t> sequence;
+        std::size_t index = 0;
+    };
+
+    // 异步等待者：归还连接时按入队顺序满足
+    struct AsyncWaiter {
+        std::promise<std::shared_ptr<IDatabaseConnection>> promise;
+        std::chrono::steady_clock::time_point start;
+    };
+
+    // 阻塞等待时检查空闲环的轮询间隔
+    static constexpr std::chrono::milliseconds WAIT_POLL_INTERVAL{10};
+
+    // 后台健康检查的巡检周期
+    static constexpr std::chrono::seconds HEALTH_CHECK_INTERVAL{30};
+
+    // 自适应池大小参数：单次扩容/缩容步长、相邻两次调整的最小
+    // 间隔（限速），以及触发缩容所需的连续空闲巡检轮数
+    static constexpr std::size_t ADAPT_GROW_STEP = 2;
+    static constexpr std::size_t ADAPT_SHRINK_STEP = 1;
+    static constexpr std::chrono::seconds ADAPT_RESIZE_COOLDOWN{5};
+    static constexpr unsigned ADAPT_SHRINK_IDLE_ROUNDS = 2;
+
     DatabaseConfig config_;                                           ///< 数据库配置信息
-    std::queue<std::shared_ptr<IDatabaseConnection>> available_connections_; ///< 可用连接队列
-    mutable std::mutex mutex_;                                        ///< 保护连接池状态的互斥锁
+    std::vector<std::shared_ptr<IDatabaseConnection>> slots_;         ///< 槽位 → 连接
+    std::unordered_map<IDatabaseConnection*, std::size_t> index_of_;  ///< 连接 → 槽位
+    std::unique_ptr<IndexSlot[]> free_ring_;                          ///< 空闲槽位下标环形缓冲
+    std::size_t ring_capacity_ = 0;                                   ///< 环容量（2的幂）
+    std::atomic<std::size_t> ring_head_{0};                           ///< 环写入位置
+    std::atomic<std::size_t> ring_tail_{0};                           ///< 环读取位置
+    std::atomic<std::size_t> available_count_{0};                     ///< 空闲连接计数
+    std::deque<AsyncWaiter> async_waiters_;                           ///< 挂起的异步请求
+    std::vector<std::size_t> dead_slots_;                             ///< 可复用的空槽位
+    mutable std::mutex mutex_;                                        ///< 保护慢路径状态的互斥锁
     std::condition_variable condition_;                               ///< 用于等待可用连接的条件变量
-    std::atomic<size_t> current_size_;                               ///< 当前连接池总大小
-    std::atomic<size_t> borrowed_count_;                             ///< 当前借出的连接数量
-    std::atomic<bool> shutdown_;                                     ///< 连接池关闭标志
-    
+    std::atomic<size_t> current_size_;                                ///< 当前连接池总大小
+    std::atomic<size_t> borrowed_count_;                              ///< 当前借出的连接数量
+    std::atomic<bool> shutdown_;                                      ///< 连接池关闭标志
+    std::array<std::atomic<std::uint64_t>, WAIT_BUCKET_COUNT> wait_histogram_{};  ///< 等待耗时直方图
+    std::atomic<std::size_t> target_size_{0};                         ///< 自适应软上限
+    std::atomic<std::uint64_t> wait_events_{0};                       ///< 自上次调整以来的排队等待次数
+    std::atomic<std::uint64_t> grow_decisions_{0};                    ///< 累计扩容决策次数
+    std::atomic<std::uint64_t> shrink_decisions_{0};                  ///< 累计缩容决策次数
+    std::chrono::steady_clock::time_point last_resize_{};             ///< 上次调整时间（仅巡检线程访问）
+    unsigned idle_rounds_ = 0;                                        ///< 连续空闲巡检轮数（仅巡检线程访问）
+    bool adapt_requested_ = false;                                    ///< 请求提前调整（checker_mutex_保护）
+    std::mutex checker_mutex_;                                        ///< 健康检查线程的睡眠锁
+    std::condition_variable checker_cv_;                              ///< 用于及时唤醒健康检查线程
+    std::thread health_checker_;                                      ///< 后台健康检查线程
+
     size_t min_size_;                                                ///< 连接池最小大小
     size_t max_size_;                                                ///< 连接池最大大小
-    
+
     /**
      * @brief 创建新的数据库连接
      * @return std::shared_ptr<IDatabaseConnection> 新创建的连接
      * @throws DatabaseException 如果连接创建失败
      */
     std::shared_ptr<IDatabaseConnection> CreateConnection();
-    
+
     /**
      * @brief 检查连接是否健康
      * @param conn 要检查的连接
@@ -136,14 +254,72 @@ private:
      * @return false 连接已断开或异常
      */
     bool IsConnectionHealthy(const std::shared_ptr<IDatabaseConnection>& conn);
-    
+
     /**
      * @brief 初始化连接池
-     * 
+     *
      * 预创建最小数量的连接放入池中。
      * 在构造函数中调用。
      */
     void InitializePool();
+
+    /**
+     * @brief 从空闲环取出一个槽位下标（无锁）
+     */
+    bool TryPopIndex(std::size_t& index);
+
+    /**
+     * @brief 把槽位下标放回空闲环（无锁）
+     */
+    bool TryPushIndex(std::size_t index);
+
+    /**
+     * @brief 在互斥锁内为新连接分配槽位并登记
+     */
+    std::size_t RegisterConnectionLocked(std::shared_ptr<IDatabaseConnection> conn);
+
+    /**
+     * @brief 在互斥锁内丢弃槽位中的连接
+     */
+    void DiscardSlotLocked(std::size_t index);
+
+    /**
+     * @brief 记录一次连接获取的等待耗时
+     */
+    void RecordWaitTime(std::chrono::steady_clock::time_point start);
+
+    /**
+     * @brief 后台健康检查线程主循环
+     *
+     * 每 HEALTH_CHECK_INTERVAL 巡检一轮：逐个取出空闲连接探活，
+     * 健康的放回环中，失效的原位重建或丢弃；巡检结束后把连接
+     * 总数补足到最小水位，保证空闲超时断开后池保持预热状态。
+     * 每轮（以及借出方请求提前唤醒时）运行一次 AdaptPoolSize。
+     */
+    void HealthCheckLoop();
+
+    /**
+     * @brief 按负载调整池大小软上限
+     *
+     * 扩容：自上次调整以来出现过排队等待，软上限按
+     * ADAPT_GROW_STEP 上调（不超过配置上限），等待者随即可
+     * 创建新连接。缩容：连续 ADAPT_SHRINK_IDLE_ROUNDS 轮无等待
+     * 且借出数不足软上限一半，软上限按 ADAPT_SHRINK_STEP 下调
+     *（不低于配置下限）并物理关闭多余的空闲连接。相邻两次调整
+     * 至少间隔 ADAPT_RESIZE_COOLDOWN；每次决策更新计数器并写
+     * PerformanceMonitor 的 pool_adaptive_grow/shrink 指标。
+     */
+    void AdaptPoolSize();
+
+    /**
+     * @brief 借出路径在排队时请求提前运行一轮自适应调整
+     */
+    void RequestAdaptation();
+
+    /**
+     * @brief 在互斥锁内把连接总数补足到最小水位
+     */
+    void TopUpToMinimumLocked();
 };
 
 } // namespace strategy
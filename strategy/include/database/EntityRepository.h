@@ -0,0 +1,271 @@
+/*
+ * 文件名: EntityRepository.h
+ * 说明: 编译期特化的实体仓储模板，SQL语句在编译期按列元数据生成
+ * 作者: 彭承康
+ * 创建时间: 2026-08-28
+ *
+ * BaseRepository的各具体仓储此前在每次调用时用字符串拼接SQL，
+ * 热路径上的拼接与分配是纯开销。本模板以CRTP方式让派生仓储以
+ * constexpr常量描述表名与列元数据，增删改查的SQL形状全部在
+ * 编译期生成为静态字符串，运行期只做参数绑定与结果转换。
+ * 对外的虚接口（如IPlayerRepository）保留为薄适配层。
+ *
+ * 派生类需提供的编译期元数据：
+ *   - TABLE_NAME      表名
+ *   - COLUMNS         列名数组，下标0为主键列
+ *   - UPDATABLE_COUNT 主键之后可写列的数量（COLUMNS[1..N]）
+ *   - INSERT_EXTRA_COLUMNS / INSERT_EXTRA_VALUES（可选）
+ *     插入时由数据库侧填充的附加列，如", created_at"与
+ *     ", CURRENT_TIMESTAMP"
+ * 以及行转换函数 Entity FromRow(row)。
+ */
+#ifndef STRATEGY_DATABASE_ENTITYREPOSITORY_H
+#define STRATEGY_DATABASE_ENTITYREPOSITORY_H
+
+#include "database/BaseRepository.h"
+#include <any>
+#include <array>
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+namespace strategy {
+
+/**
+ * @brief 编译期SQL文本缓冲区
+ *
+ * 定长字符数组加长度，全部操作均可在常量求值中执行。
+ * 生成的语句以静态存储期常量形式驻留，View()返回的视图
+ * 在整个程序生命周期内有效。
+ */
+template <std::size_t Capacity>
+struct SqlBuffer {
+    std::array<char, Capacity> data{};
+    std::size_t size = 0;
+
+    /**
+     * @brief 追加一段文本
+     */
+    constexpr void Append(std::string_view text) {
+        for (char c : text) {
+            data[size++] = c;
+        }
+    }
+
+    /**
+     * @brief 追加形如$N的参数占位符
+     */
+    constexpr void AppendPlaceholder(std::size_t index) {
+        data[size++] = '$';
+        char digits[20] = {};
+        std::size_t count = 0;
+        do {
+            digits[count++] = static_cast<char>('0' + index % 10);
+            index /= 10;
+        } while (index > 0);
+        while (count > 0) {
+            data[size++] = digits[--count];
+        }
+    }
+
+    /**
+     * @brief 取得已生成文本的视图
+     */
+    constexpr std::string_view View() const {
+        return std::string_view(data.data(), size);
+    }
+};
+
+/**
+ * @brief CRTP实体仓储基类
+ *
+ * @tparam Derived 提供表/列元数据与FromRow的具体仓储
+ * @tparam Entity  行转换的目标实体类型
+ */
+template <typename Derived, typename Entity>
+class EntityRepository : public BaseRepository {
+public:
+    using BaseRepository::BaseRepository;
+
+    /**
+     * @brief 按指定列查询全部列的SELECT语句（编译期生成）
+     */
+    template <std::size_t ColumnIndex>
+    static constexpr std::string_view SelectByColumnSql() {
+        return SELECT_BY_COLUMN_TEXT<ColumnIndex>.View();
+    }
+
+    /**
+     * @brief 插入可写列的INSERT语句（编译期生成）
+     */
+    static constexpr std::string_view InsertSql() {
+        return INSERT_TEXT.View();
+    }
+
+    /**
+     * @brief 按主键更新可写列的UPDATE语句（编译期生成）
+     */
+    static constexpr std::string_view UpdateByKeySql() {
+        return UPDATE_BY_KEY_TEXT.View();
+    }
+
+    /**
+     * @brief 按主键删除的DELETE语句（编译期生成）
+     */
+    static constexpr std::string_view DeleteByKeySql() {
+        return DELETE_BY_KEY_TEXT.View();
+    }
+
+protected:
+    /**
+     * @brief 按指定列查询单行并转换为实体
+     */
+    template <std::size_t ColumnIndex>
+    std::optional<Entity> SelectOneBy(const std::any& value) {
+        static const std::string sql{SelectByColumnSql<ColumnIndex>()};
+        auto result = ExecuteQuery(sql, {value});
+        if (!result.empty()) {
+            return static_cast<Derived*>(this)->FromRow(result[0]);
+        }
+        return std::nullopt;
+    }
+
+    /**
+     * @brief 插入一行并返回数据库生成的主键
+     */
+    long long InsertAndReturnId(const std::vector<std::any>& params) {
+        static const std::string sql{InsertSql()};
+        ExecuteUpdate(sql, params);
+        return GetLastInsertId();
+    }
+
+    /**
+     * @brief 按主键更新可写列
+     * @param params 可写列的新值，末尾追加主键值
+     * @return 恰好影响一行时返回true
+     */
+    bool UpdateByKey(const std::vector<std::any>& params) {
+        static const std::string sql{UpdateByKeySql()};
+        return ExecuteUpdate(sql, params) == 1;
+    }
+
+    /**
+     * @brief 按主键删除一行
+     */
+    bool DeleteByKey(const std::any& key) {
+        static const std::string sql{DeleteByKeySql()};
+        return ExecuteUpdate(sql, {key}) == 1;
+    }
+
+private:
+    // 单条语句的编译期容量上限，超出会使常量求值失败
+    static constexpr std::size_t SQL_CAPACITY = 512;
+
+    static constexpr std::size_t ColumnCount() {
+        return std::tuple_size_v<std::remove_cvref_t<decltype(Derived::COLUMNS)>>;
+    }
+
+    static constexpr std::string_view InsertExtraColumns() {
+        if constexpr (requires { Derived::INSERT_EXTRA_COLUMNS; }) {
+            return Derived::INSERT_EXTRA_COLUMNS;
+        } else {
+            return std::string_view{};
+        }
+    }
+
+    static constexpr std::string_view InsertExtraValues() {
+        if constexpr (requires { Derived::INSERT_EXTRA_VALUES; }) {
+            return Derived::INSERT_EXTRA_VALUES;
+        } else {
+            return std::string_view{};
+        }
+    }
+
+    static constexpr SqlBuffer<SQL_CAPACITY> BuildSelectBy(std::size_t column_index) {
+        SqlBuffer<SQL_CAPACITY> sql;
+        sql.Append("SELECT ");
+        for (std::size_t i = 0; i < ColumnCount(); ++i) {
+            if (i > 0) {
+                sql.Append(", ");
+            }
+            sql.Append(Derived::COLUMNS[i]);
+        }
+        sql.Append(" FROM ");
+        sql.Append(Derived::TABLE_NAME);
+        sql.Append(" WHERE ");
+        sql.Append(Derived::COLUMNS[column_index]);
+        sql.Append(" = $1;");
+        return sql;
+    }
+
+    static constexpr SqlBuffer<SQL_CAPACITY> BuildInsert() {
+        SqlBuffer<SQL_CAPACITY> sql;
+        sql.Append("INSERT INTO ");
+        sql.Append(Derived::TABLE_NAME);
+        sql.Append(" (");
+        for (std::size_t i = 1; i <= Derived::UPDATABLE_COUNT; ++i) {
+            if (i > 1) {
+                sql.Append(", ");
+            }
+            sql.Append(Derived::COLUMNS[i]);
+        }
+        sql.Append(InsertExtraColumns());
+        sql.Append(") VALUES (");
+        for (std::size_t i = 1; i <= Derived::UPDATABLE_COUNT; ++i) {
+            if (i > 1) {
+                sql.Append(", ");
+            }
+            sql.AppendPlaceholder(i);
+        }
+        sql.Append(InsertExtraValues());
+        sql.Append(");");
+        return sql;
+    }
+
+    static constexpr SqlBuffer<SQL_CAPACITY> BuildUpdateByKey() {
+        SqlBuffer<SQL_CAPACITY> sql;
+        sql.Append("UPDATE ");
+        sql.Append(Derived::TABLE_NAME);
+        sql.Append(" SET ");
+        for (std::size_t i = 1; i <= Derived::UPDATABLE_COUNT; ++i) {
+            if (i > 1) {
+                sql.Append(", ");
+            }
+            sql.Append(Derived::COLUMNS[i]);
+            sql.Append(" = ");
+            sql.AppendPlaceholder(i);
+        }
+        sql.Append(" WHERE ");
+        sql.Append(Derived::COLUMNS[0]);
+        sql.Append(" = ");
+        sql.AppendPlaceholder(Derived::UPDATABLE_COUNT + 1);
+        sql.Append(";");
+        return sql;
+    }
+
+    static constexpr SqlBuffer<SQL_CAPACITY> BuildDeleteByKey() {
+        SqlBuffer<SQL_CAPACITY> sql;
+        sql.Append("DELETE FROM ");
+        sql.Append(Derived::TABLE_NAME);
+        sql.Append(" WHERE ");
+        sql.Append(Derived::COLUMNS[0]);
+        sql.Append(" = $1;");
+        return sql;
+    }
+
+    template <std::size_t ColumnIndex>
+    static constexpr auto SELECT_BY_COLUMN_TEXT = BuildSelectBy(ColumnIndex);
+    static constexpr auto INSERT_TEXT = BuildInsert();
+    static constexpr auto UPDATE_BY_KEY_TEXT = BuildUpdateByKey();
+    static constexpr auto DELETE_BY_KEY_TEXT = BuildDeleteByKey();
+};
+
+} // namespace strategy
+
+#endif // STRATEGY_DATABASE_ENTITYREPOSITORY_H
@@ -12,11 +12,21 @@
 #include <map>
 #include <memory>
 #include <any>
+#include <algorithm>
+#include <cstddef>
+#include <functional>
 
 namespace strategy {
 
 using QueryResult = std::vector<std::map<std::string, std::any>>;
 
+/**
+ * @brief 流式查询的批次回调
+ *
+ * 每收到一批行调用一次；返回false提前终止，剩余结果不再拉取。
+ */
+using RowBatchHandler = std::function<bool(const QueryResult& batch)>;
+
 class IDatabaseConnection {
 public:
     virtual ~IDatabaseConnection() = default;
@@ -41,6 +51,44 @@ public:
      */
     virtual QueryResult ExecuteQuery(const std::string& query, const std::vector<std::any>& params = {}) = 0;
     
+    /**
+     * @brief 流式执行查询（按批次回调）
+     *
+     * 结果按batch_size分批交给handler，而不是整表物化后返回，
+     * 大结果集（排行榜、报表）的内存占用与结果行数无关。
+     * batch_size为1即逐行模式，供最大的报表查询使用。
+     *
+     * 默认实现退化为ExecuteQuery后分批回调（语义一致但仍整表
+     * 物化）；支持服务端游标的后端应覆盖为真流式。
+     *
+     * @param query SQL语句
+     * @param params 绑定参数
+     * @param batch_size 每批行数，最小为1
+     * @param handler 批次回调，返回false提前终止
+     * @return 实际交给回调的总行数
+     */
+    virtual std::size_t ExecuteQueryStream(const std::string& query,
+                                           const std::vector<std::any>& params,
+                                           std::size_t batch_size,
+                                           const RowBatchHandler& handler) {
+        const QueryResult all = ExecuteQuery(query, params);
+        if (batch_size == 0) {
+            batch_size = 1;
+        }
+
+        std::size_t delivered = 0;
+        for (std::size_t offset = 0; offset < all.size(); offset += batch_size) {
+            const std::size_t count = std::min(batch_size, all.size() - offset);
+            const QueryResult batch(all.begin() + static_cast<std::ptrdiff_t>(offset),
+                                    all.begin() + static_cast<std::ptrdiff_t>(offset + count));
+            delivered += count;
+            if (!handler(batch)) {
+                break;
+            }
+        }
+        return delivered;
+    }
+
     /**
      * @brief 执行更新/插入/删除
      */
@@ -9,6 +9,8 @@
 
 #include "DatabaseConfig.h"
 #include <string>
+#include <functional>
+#include <istream>
 #include <map>
 #include <memory>
 #include <vector>
@@ -25,13 +27,62 @@ public:
         : std::runtime_error("JSON配置解析错误: " + message) {}
 };
 
+/**
+ * @brief 流式解析时标量值的类型
+ */
+enum class JsonValueType {
+    String,   // 字符串
+    Number,   // 数字（原样文本传出）
+    Boolean,  // 布尔
+    Null      // null
+};
+
 /**
  * @brief JSON格式数据库配置解析器
  *
  * 使用简单的行式JSON解析器处理平面配置结构。
+ * 另提供SAX式流式解析（ParseStream）：单遍扫描输入，
+ * 对每个标量值按点分路径回调，不构建内存树，
+ * 适合从大体量配置中只抽取少数键。
  */
 class JsonConfigParser {
 public:
+    /**
+     * @brief 流式解析回调
+     * @param path 点分路径，数组元素带下标，如 "databases.main.host"、"rules[2].id"
+     * @param type 值类型
+     * @param value 值的文本形式（字符串已去引号并处理转义）
+     */
+    using JsonValueCallback =
+        std::function<void(const std::string& path, JsonValueType type, const std::string& value)>;
+
+    /**
+     * @brief SAX式单遍流式解析
+     *
+     * 按块读入并扫描输入，遇到标量值立即回调，不建树。
+     * x86-64上字符串内容与空白跳过走SIMD字节分类快路径
+     *（SSE2基线，AVX2经运行时CPU检测选择），语义与标量路径一致。
+     * path_filter 非空时只回调路径等于某个前缀或位于其下的值，
+     * 其余子树照常跳过扫描但不产生回调。
+     *
+     * @param input 输入流
+     * @param callback 标量值回调
+     * @param path_filter 路径前缀过滤，空表示全部回调
+     * @throws JsonParseException 如果JSON格式错误
+     */
+    static void ParseStream(std::istream& input,
+                            const JsonValueCallback& callback,
+                            const std::vector<std::string>& path_filter = {});
+
+    /**
+     * @brief 流式抽取指定路径的值（便捷封装）
+     * @param input 输入流
+     * @param paths 要抽取的点分路径前缀
+     * @return 路径 → 值文本；未出现的路径不在结果中
+     */
+    static std::map<std::string, std::string>
+        ExtractPaths(std::istream& input, const std::vector<std::string>& paths);
+
     static std::map<std::string, std::shared_ptr<DatabaseConfig>>
         ParseDatabaseConfigs(const std::string& json_content);
 
@@ -3,12 +3,14 @@
  * 说明: 数据库迁移管理器，负责数据库版本控制和结构变更管理
  * 作者: 彭承康
  * 创建时间: 2026-02-18
+ * 更新时间: 2026-08-28 — 依赖感知并行执行与分块可恢复回填
  *
  * 本类提供数据库迁移功能，包括：
  * 1. 自动执行数据库结构升级
  * 2. 支持版本回滚操作
  * 3. 维护迁移历史记录
  * 4. 确保数据库结构与代码版本同步
+ * 5. 无依赖关系的迁移可并行执行，大数据回填分块限速进行
  *
  * 使用示例：
  *   auto connection = std::make_shared<PostgreSQLConnection>(config);
@@ -22,6 +24,8 @@
 
 #include "IDatabaseConnection.h"
 #include "DatabaseConfig.h"
+#include <chrono>
+#include <cstddef>
 #include <vector>
 #include <string>
 #include <memory>
@@ -30,14 +34,23 @@ namespace strategy {
 
 /**
  * @brief 数据库迁移脚本结构
- * 
- * 每个迁移包含版本号、描述和正向/反向SQL脚本
+ *
+ * 每个迁移包含版本号、描述和正向/反向SQL脚本。
+ * depends_on 声明本迁移依赖的其它迁移版本（例如外键引用的表），
+ * 并行执行时只有依赖全部完成后才会调度本迁移；空表示无依赖。
+ *
+ * is_backfill 标记大数据回填类迁移：不在单个大事务里执行，
+ * 而是按主键区间分块提交，进度落表可恢复，块间限速让路给线上流量。
  */
 struct Migration {
     int version;                ///< 迁移版本号，必须递增且唯一
     std::string description;    ///< 迁移描述，用于日志和调试
     std::string up_sql;         ///< 正向迁移SQL（升级数据库结构）
     std::string down_sql;       ///< 反向迁移SQL（回滚数据库结构）
+    std::vector<int> depends_on{};    ///< 依赖的迁移版本，空表示无依赖
+    bool is_backfill = false;         ///< 是否为分块回填迁移
+    std::string backfill_max_id_sql{};  ///< 查询回填上界：返回单行单列 max_id
+    std::string backfill_chunk_sql{};   ///< 单块回填SQL：$1=块起始id(不含)，$2=块结束id(含)
 };
 
 /**
@@ -56,6 +69,10 @@ struct Migration {
  */
 class MigrationManager {
 public:
+    // 回填迁移默认参数：每块1000行主键区间，块间停顿50毫秒让路线上流量
+    static constexpr long long BACKFILL_CHUNK_SIZE = 1000;
+    static constexpr std::chrono::milliseconds BACKFILL_THROTTLE{50};
+
     /**
      * @brief 构造函数
      * @param connection 数据库连接对象，必须已连接且有效
@@ -78,7 +95,30 @@ public:
      * @note 所有迁移在事务中执行，保证原子性
      */
     bool RunMigrations();
-    
+
+    /**
+     * @brief 依赖感知地并行执行所有待处理迁移
+     *
+     * 按 depends_on 把待处理迁移分成若干波（拓扑分层），同一波内
+     * 的迁移互相独立，分摊到传入的连接上并行执行；下一波在上一波
+     * 全部成功后才开始。每个迁移仍在自己的事务中执行。
+     *
+     * @param connections 并行执行用的连接列表，决定并行度；
+     *                    必须全部已连接，不能包含本管理器持有的连接
+     * @return true 所有迁移成功执行
+     * @return false 任一迁移失败（当波执行完后停止，不再调度后续波）
+     *
+     * @note 连接列表为空时退化为 RunMigrations 的串行行为
+     */
+    bool RunMigrationsParallel(const std::vector<std::shared_ptr<IDatabaseConnection>>& connections);
+
+    /**
+     * @brief 设置回填迁移的分块大小与块间停顿
+     * @param chunk_size 单块覆盖的主键区间宽度，须为正
+     * @param throttle 两块之间的停顿时长，用于给线上流量让路
+     */
+    void SetBackfillPacing(long long chunk_size, std::chrono::milliseconds throttle);
+
     /**
      * @brief 回滚数据库到指定版本
      * 
@@ -109,6 +149,8 @@ private:
     std::shared_ptr<IDatabaseConnection> connection_;  ///< 数据库连接对象
     std::vector<Migration> migrations_;                ///< 所有可用的迁移脚本列表
     DatabaseType db_type_;                             ///< 数据库类型
+    long long backfill_chunk_size_ = BACKFILL_CHUNK_SIZE;              ///< 回填分块大小
+    std::chrono::milliseconds backfill_throttle_ = BACKFILL_THROTTLE;  ///< 回填块间停顿
 
     /**
      * @brief 从配置文件或代码中加载迁移脚本
@@ -143,6 +185,43 @@ private:
      * @note 表名通常为 "schema_migrations" 或 "migration_history"
      */
     bool CreateMigrationTable();
+
+    /**
+     * @brief 查询已执行迁移的版本集合
+     *
+     * 并行执行下同一波内的版本可能乱序完成，不能只看最大版本号。
+     */
+    std::vector<int> GetAppliedVersions();
+
+    /**
+     * @brief 在指定连接上执行单个迁移（事务内，回填迁移走分块路径）
+     */
+    bool ApplyMigration(const std::shared_ptr<IDatabaseConnection>& conn,
+                        const Migration& migration);
+
+    /**
+     * @brief 分块、可恢复地执行回填迁移
+     *
+     * 进度记录在 migration_backfill_progress 表中，进程中断后
+     * 重新执行会从上次提交的块继续；全部块完成后写入迁移历史
+     * 并清理进度行。
+     */
+    bool RunBackfillMigration(const std::shared_ptr<IDatabaseConnection>& conn,
+                              const Migration& migration);
+
+    /**
+     * @brief 创建回填进度表（如果不存在）
+     */
+    bool CreateBackfillProgressTable(const std::shared_ptr<IDatabaseConnection>& conn);
+
+    /**
+     * @brief 把待处理迁移按依赖关系拓扑分层
+     * @param pending 待处理迁移（已按版本号排序）
+     * @param waves 输出：每波内的迁移互相独立，可并行执行
+     * @return false 依赖声明形成环或引用了不存在的版本
+     */
+    bool BuildExecutionWaves(const std::vector<const Migration*>& pending,
+                             std::vector<std::vector<const Migration*>>& waves) const;
 };
 
 } // namespace strategy
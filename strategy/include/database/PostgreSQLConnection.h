@@ -11,10 +11,21 @@
 #include "database/IDatabaseConnection.h"
 
 #include <memory>
+#include <string>
+#include <unordered_map>
 #include <pqxx/pqxx>
 
 namespace strategy {
 
+/**
+ * PostgreSQL connection with a per-connection prepared-statement cache.
+ *
+ * Parameterized queries using $n placeholders are prepared once per
+ * connection (keyed by SQL text) and executed as named statements, so
+ * the server plans each hot query shape a single time. The cache lives
+ * for the lifetime of the underlying pqxx connection, which the pool
+ * reuses across borrow/return cycles.
+ */
 class PostgreSQLConnection : public IDatabaseConnection {
 public:
     explicit PostgreSQLConnection(const DatabaseConfig& config);
@@ -25,6 +36,22 @@ public:
     bool IsConnected() const override;
 
     QueryResult ExecuteQuery(const std::string& query, const std::vector<std::any>& params = {}) override;
+
+    /**
+     * True streaming via a server-side cursor: the query runs inside a
+     * DECLARE ... CURSOR and rows are pulled in FETCH batches, so only
+     * one batch is materialized client-side at a time regardless of the
+     * result size. batch_size 1 is the single-row mode for the largest
+     * reports. Parameters are inlined as quoted literals (cursor
+     * declarations bypass the prepared-statement cache); streaming
+     * queries are analytical, not hot OLTP shapes, so the per-call plan
+     * is acceptable.
+     */
+    std::size_t ExecuteQueryStream(const std::string& query,
+                                   const std::vector<std::any>& params,
+                                   std::size_t batch_size,
+                                   const RowBatchHandler& handler) override;
+
     int ExecuteUpdate(const std::string& query, const std::vector<std::any>& params = {}) override;
 
     bool BeginTransaction() override;
@@ -37,8 +64,13 @@ private:
     DatabaseConfig config_;
     std::unique_ptr<pqxx::connection> connection_;
     std::unique_ptr<pqxx::work> transaction_;
+    std::unordered_map<std::string, std::string> prepared_names_;  // SQL text -> statement name
+    int next_statement_id_ = 0;
 
     std::any ConvertPqxxField(const pqxx::field& field);
+
+    /// Returns the cached statement name for the query, preparing it on first use.
+    const std::string& GetPreparedName(const std::string& query);
 };
 
 } // namespace strategy
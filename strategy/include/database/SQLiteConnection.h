@@ -3,6 +3,7 @@
  * 说明: SQLite数据库连接实现
  * 作者: 彭承康
  * 创建时间: 2026-02-18
+ * 更新时间: 2026-08-28 — 批量写模式：组提交事务与异步提交线程
  */
 #ifndef STRATEGY_DATABASE_SQLITECONNECTION_H
 #define STRATEGY_DATABASE_SQLITECONNECTION_H
@@ -10,13 +11,36 @@
 #include "database/IDatabaseConnection.h"
 #include "database/DatabaseConfig.h"
 #include <sqlite3.h>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
 #include <mutex>
 #include <string>
+#include <thread>
 
 namespace strategy {
 
+/**
+ * @brief SQLite数据库连接
+ *
+ * 边缘部署（无PostgreSQL）使用的本地存储后端。默认每条写语句
+ * 自成一个事务，WAL下每次提交都要等一次fsync，吞吐上限约百次/秒。
+ *
+ * 批量写模式（EnableBatchedWrites）把写语句累积到同一个显式事务里，
+ * 由后台提交线程在达到批大小或延迟上限时统一COMMIT（组提交），
+ * 把fsync开销摊薄到整批语句上。语句本身仍在调用线程同步执行，
+ * 同连接的后续读能立即看到未提交的写入。
+ *
+ * @note 批量写模式下，最近 BATCH_MAX_DELAY 内的写入在掉电时可能
+ *       丢失（但不会出现半条语句）；需要持久化屏障时调用
+ *       FlushBatchedWrites()
+ */
 class SQLiteConnection : public IDatabaseConnection {
 public:
+    // 批量写模式默认参数：攒满256条或20毫秒后提交
+    static constexpr std::size_t BATCH_MAX_STATEMENTS = 256;
+    static constexpr std::chrono::milliseconds BATCH_MAX_DELAY{20};
+
     explicit SQLiteConnection(const DatabaseConfig& config);
     virtual ~SQLiteConnection();
 
@@ -33,12 +57,49 @@ public:
 
     long long GetLastInsertId() override;
 
+    /**
+     * @brief 开启批量写模式
+     *
+     * 启动后台提交线程，并把synchronous降为NORMAL（WAL下安全，
+     * 不会损坏数据库）。显式事务（BeginTransaction）不受影响，
+     * 开始前会先提交未完成的批。
+     *
+     * @param max_statements 单批最大语句数，攒满即提交
+     * @param max_delay 批打开后的最长停留时间
+     */
+    void EnableBatchedWrites(std::size_t max_statements = BATCH_MAX_STATEMENTS,
+                             std::chrono::milliseconds max_delay = BATCH_MAX_DELAY);
+
+    /**
+     * @brief 关闭批量写模式
+     *
+     * 提交未完成的批并回收提交线程，之后恢复逐语句自动提交。
+     */
+    void DisableBatchedWrites();
+
+    /**
+     * @brief 持久化屏障：立即提交当前未完成的批
+     * @return 提交是否成功（无未完成批时返回true）
+     */
+    bool FlushBatchedWrites();
+
 private:
     DatabaseConfig config_;
     sqlite3* db_;
     bool in_transaction_;
     mutable std::mutex mutex_;
 
+    // —— 批量写模式状态（mutex_保护）——
+    bool batched_writes_ = false;                       ///< 批量写模式开关
+    bool batch_open_ = false;                           ///< 当前是否有未提交的批事务
+    bool stop_committer_ = false;                       ///< 提交线程退出标志
+    std::size_t batch_pending_ = 0;                     ///< 当前批中累积的语句数
+    std::size_t batch_max_statements_ = BATCH_MAX_STATEMENTS;  ///< 单批最大语句数
+    std::chrono::milliseconds batch_max_delay_{BATCH_MAX_DELAY};  ///< 批最长停留时间
+    std::chrono::steady_clock::time_point batch_opened_at_;  ///< 当前批打开时刻
+    std::condition_variable batch_cv_;                  ///< 唤醒提交线程
+    std::thread commit_thread_;                         ///< 异步提交线程
+
     /**
      * @brief 将PostgreSQL风格的参数占位符($1, $2, ...)转换为SQLite风格(?)
      */
@@ -53,6 +114,24 @@ private:
      * @brief 配置SQLite编译指示（WAL模式、外键、busy_timeout等）
      */
     void ConfigurePragmas();
+
+    /**
+     * @brief 在互斥锁内提交当前未完成的批事务
+     * @return 提交是否成功（无未完成批时返回true）
+     */
+    bool FlushBatchLocked();
+
+    /**
+     * @brief 异步提交线程主循环
+     *
+     * 被唤醒或到达延迟上限时提交打开的批事务。
+     */
+    void CommitLoop();
+
+    /**
+     * @brief 提交未完成的批并回收提交线程（在互斥锁外调用）
+     */
+    void StopCommitThread();
 };
 
 } // namespace strategy
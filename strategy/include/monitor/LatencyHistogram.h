@@ -0,0 +1,147 @@
+/*
+ * 文件名: LatencyHistogram.h
+ * 说明: HDR风格延迟直方图，线程本地缓冲记录，抓取时合并
+ * 作者: 彭承康
+ * 创建时间: 2026-08-28
+ *
+ * 记录路径无锁：每个线程首次记录时注册一块本地计数缓冲，
+ * 之后仅对本线程缓冲做宽松原子自增；Snapshot 在抓取时
+ * 合并所有线程缓冲，适合仪表盘低频轮询。
+ * 桶划分为 HDR 风格（每个2的幂区间固定数量线性子桶），
+ * 相对误差约 12.5%，覆盖 1 微秒到约 15 秒。
+ */
+
+#ifndef STRATEGY_LATENCY_HISTOGRAM_H
+#define STRATEGY_LATENCY_HISTOGRAM_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace strategy {
+
+/**
+ * @brief 直方图抓取快照
+ *
+ * 抓取时刻所有线程缓冲的合并结果，之后可离线计算分位数。
+ */
+struct HistogramSnapshot {
+    std::uint64_t total_count = 0;        ///< 样本总数
+    std::uint64_t total_micros = 0;       ///< 样本总和（微秒）
+    std::vector<std::uint64_t> buckets;   ///< 各桶计数
+
+    /**
+     * @brief 计算分位数（桶下界近似）
+     * @param percentile 分位，取值 [0, 100]
+     * @return 分位数对应的微秒值；无样本时返回0
+     */
+    std::uint64_t GetPercentileMicros(double percentile) const;
+
+    /**
+     * @brief 平均值（微秒）
+     * @return 平均微秒数；无样本时返回0
+     */
+    double GetAverageMicros() const;
+};
+
+/**
+ * @brief HDR风格延迟直方图
+ *
+ * 实例生命周期应为静态（通常由 PerformanceMonitor 注册表持有）。
+ */
+class LatencyHistogram {
+public:
+    static constexpr std::size_t SUB_BUCKET_BITS = 4;    ///< 子桶位数
+    static constexpr std::size_t SUB_BUCKET_COUNT = std::size_t{1} << SUB_BUCKET_BITS;
+    static constexpr std::size_t SUB_BUCKET_HALF = SUB_BUCKET_COUNT / 2;
+    static constexpr std::size_t RANGE_COUNT = 20;       ///< 2的幂区间数，最高约15秒
+    static constexpr std::size_t BUCKET_COUNT =
+        SUB_BUCKET_COUNT + RANGE_COUNT * SUB_BUCKET_HALF;
+
+    LatencyHistogram();
+    ~LatencyHistogram() = default;
+
+    LatencyHistogram(const LatencyHistogram&) = delete;
+    LatencyHistogram& operator=(const LatencyHistogram&) = delete;
+
+    /**
+     * @brief 记录一次延迟（微秒）
+     * @param micros 延迟微秒数
+     */
+    void RecordMicros(std::uint64_t micros);
+
+    /**
+     * @brief 记录一次延迟（时钟差值）
+     * @param elapsed 延迟时长
+     */
+    void Record(std::chrono::steady_clock::duration elapsed);
+
+    /**
+     * @brief 抓取合并快照
+     * @return 当前所有线程缓冲的合并结果
+     */
+    HistogramSnapshot Snapshot() const;
+
+    /**
+     * @brief 计算微秒值所属桶下标
+     * @param micros 微秒值
+     * @return 桶下标，超出范围时落入最后一桶
+     */
+    static std::size_t BucketIndex(std::uint64_t micros);
+
+    /**
+     * @brief 桶下界（微秒）
+     * @param index 桶下标
+     * @return 该桶覆盖区间的下界
+     */
+    static std::uint64_t BucketLowerBoundMicros(std::size_t index);
+
+    /**
+     * @brief RAII记录器，析构时把作用域耗时记入直方图
+     */
+    class ScopedRecord {
+    public:
+        explicit ScopedRecord(LatencyHistogram& histogram)
+            : histogram_(histogram), start_(std::chrono::steady_clock::now()) {}
+
+        ~ScopedRecord() {
+            histogram_.Record(std::chrono::steady_clock::now() - start_);
+        }
+
+        ScopedRecord(const ScopedRecord&) = delete;
+        ScopedRecord& operator=(const ScopedRecord&) = delete;
+
+    private:
+        LatencyHistogram& histogram_;                    ///< 目标直方图
+        std::chrono::steady_clock::time_point start_;    ///< 起始时刻
+    };
+
+private:
+    /**
+     * @brief 单线程计数缓冲
+     *
+     * 仅本线程写入（宽松自增），抓取线程并发读取。
+     */
+    struct ThreadBuffer {
+        std::array<std::atomic<std::uint64_t>, BUCKET_COUNT> counts{};  ///< 各桶计数
+        std::atomic<std::uint64_t> total_micros{0};                     ///< 微秒总和
+    };
+
+    /**
+     * @brief 获取（必要时注册）当前线程的缓冲
+     */
+    ThreadBuffer& LocalBuffer();
+
+    const std::uint64_t id_;                              ///< 实例唯一编号
+    mutable std::mutex buffers_mutex_;                    ///< 仅保护缓冲注册表
+    std::vector<std::shared_ptr<ThreadBuffer>> buffers_;  ///< 各线程缓冲
+};
+
+} // namespace strategy
+
+#endif // STRATEGY_LATENCY_HISTOGRAM_H
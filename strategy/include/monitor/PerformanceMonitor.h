@@ -11,13 +11,23 @@
 #ifndef STRATEGY_PERFORMANCE_MONITOR_H
 #define STRATEGY_PERFORMANCE_MONITOR_H
 
+#include "monitor/LatencyHistogram.h"
+#include "monitor/SlowQueryLog.h"
+#include "trace/TraceRing.h"
+
+#include <atomic>
 #include <chrono>
+#include <cstdint>
 #include <string>
 #include <unordered_map>
 #include <mutex>
 #include <vector>
 #include <memory>
 
+namespace metrics {
+class MetricsExporter;
+}
+
 namespace strategy {
 
 /**
@@ -50,12 +60,116 @@ struct SystemResourceInfo {
  */
 class PerformanceMonitor {
 public:
+    // 内置延迟直方图名称
+    static constexpr const char* HISTOGRAM_RPC_HANDLER = "rpc_handler_latency";       ///< RPC处理延迟
+    static constexpr const char* HISTOGRAM_POOL_WAIT = "connection_pool_wait";        ///< 连接池等待时间
+    static constexpr const char* HISTOGRAM_SCHEDULER_TICK = "event_scheduler_tick";   ///< 事件调度tick耗时
+    static constexpr const char* HISTOGRAM_DB_QUERY = "db_query_latency";             ///< 数据库语句耗时
+
+    // 内置单调计数器名称
+    static constexpr const char* COUNTER_RPC_RATE_LIMITED = "rpc_rate_limited";       ///< 被限流拒绝的RPC数
+    static constexpr const char* COUNTER_POOL_GROW = "pool_adaptive_grow";            ///< 连接池扩容决策数
+    static constexpr const char* COUNTER_POOL_SHRINK = "pool_adaptive_shrink";        ///< 连接池缩容决策数
+
     /**
      * @brief 获取单例实例
      * @return PerformanceMonitor实例引用
      */
     static PerformanceMonitor& GetInstance();
 
+    /**
+     * @brief 获取（必要时创建）命名延迟直方图
+     *
+     * 返回引用在进程生命周期内有效，调用方应缓存引用，
+     * 记录路径无锁。
+     *
+     * @param name 直方图名称
+     * @return 直方图引用
+     */
+    LatencyHistogram& GetHistogram(const std::string& name);
+
+    /**
+     * @brief 抓取所有直方图的合并快照
+     * @return 名称 → 快照
+     */
+    std::unordered_map<std::string, HistogramSnapshot> GetAllHistogramSnapshots() const;
+
+    /**
+     * @brief 获取（必要时创建）命名单调计数器
+     *
+     * 返回引用在进程生命周期内有效，调用方应缓存引用；
+     * 递增用relaxed原子加即可，热路径无锁。
+     *
+     * @param name 计数器名称
+     * @return 计数器引用
+     */
+    std::atomic<std::uint64_t>& GetCounter(const std::string& name);
+
+    /**
+     * @brief 抓取所有计数器的当前值
+     * @return 名称 → 计数值
+     */
+    std::unordered_map<std::string, std::uint64_t> GetAllCounterValues() const;
+
+    /**
+     * @brief 启动指标导出（HTTP拉取端点 + 磁盘环持久化）
+     *
+     * 在给定端口起一个Prometheus文本格式的拉取端点，导出所有
+     * 命名计数器与直方图派生指标（_count/_sum_us与p50/p99分位）。
+     * 抓取时才读快照，开销与指标更新频率无关。persist_path非空
+     * 时指标定期写入固定大小的磁盘槽环，启动时回灌最近一次
+     * 快照中的单调计数器，跨重启续增（直方图重启后从零开始）。
+     *
+     * @param port 监听端口（0为临时端口）
+     * @param persist_path 持久化环文件路径，空串禁用持久化
+     * @return 是否启动成功（端口被占用或已启动时返回false）
+     */
+    bool StartMetricsExporter(std::uint16_t port, const std::string& persist_path);
+
+    /**
+     * @brief 停止指标导出（并写入最后一次持久化快照）
+     */
+    void StopMetricsExporter();
+
+    /**
+     * @brief 获取慢查询日志
+     *
+     * 数据层经BaseRepository的计时包装写入，运维接口读取
+     * 滚动记录做诊断；返回引用在进程生命周期内有效。
+     *
+     * @return 慢查询日志引用
+     */
+    SlowQueryLog& GetSlowQueryLog();
+
+    /**
+     * @brief 记录一个跨层追踪跳点
+     *
+     * trace id由发起方（客户端）生成并经gRPC元数据传播；
+     * 记录路径为原子计数加槽位写入，开销足够低，生产环境
+     * 可常开。
+     *
+     * @param trace_id 追踪ID
+     * @param hop 跳点名称（如"strategy_recv"）
+     */
+    void RecordTraceEvent(std::uint64_t trace_id, const char* hop);
+
+    /**
+     * @brief 抓取追踪事件快照（最旧在前）
+     * @return 事件列表
+     */
+    std::vector<trace::TraceEvent> GetTraceEvents() const;
+
+    /**
+     * @brief 把追踪环导出为CSV（trace_id,timestamp_us,hop）
+     *
+     * 输出格式与tools/trace_merge的输入一致，可与其他进程的
+     * 导出文件合并出单个动作的完整时间线。
+     *
+     * @param path 输出文件路径
+     * @return bool 写入是否成功
+     */
+    bool DumpTraceEvents(const std::string& path) const;
+
     /**
      * @brief 开始计时
      * @param name 计时器名称
@@ -139,7 +253,7 @@ public:
 
 private:
     PerformanceMonitor() = default;
-    ~PerformanceMonitor() = default;
+    ~PerformanceMonitor();
     PerformanceMonitor(const PerformanceMonitor&) = delete;
     PerformanceMonitor& operator=(const PerformanceMonitor&) = delete;
 
@@ -157,6 +271,18 @@ private:
     std::unordered_map<std::string, double> warning_thresholds_;   ///< 警告阈值
     bool enabled_ = true;                                          ///< 是否启用监控
 
+    mutable std::mutex histogram_mutex_;                           ///< 仅保护直方图注册表
+    std::unordered_map<std::string, std::unique_ptr<LatencyHistogram>> histograms_;  ///< 命名直方图
+
+    mutable std::mutex counter_mutex_;                             ///< 仅保护计数器注册表
+    std::unordered_map<std::string, std::unique_ptr<std::atomic<std::uint64_t>>> counters_;  ///< 命名计数器
+
+    trace::TraceRing trace_ring_;                                  ///< 跨层追踪事件环
+
+    SlowQueryLog slow_query_log_;                                  ///< 数据库慢查询日志
+
+    std::unique_ptr<metrics::MetricsExporter> exporter_;           ///< 指标导出器（可选）
+
     /**
      * @brief 更新统计数据
      * @param stats 统计数据引用
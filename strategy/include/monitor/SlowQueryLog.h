@@ -0,0 +1,149 @@
+/*
+ * 文件名: SlowQueryLog.h
+ * 说明: 慢查询捕获与滚动内存报告。
+ * 作者: 彭承康
+ * 创建时间: 2026-08-28
+ *
+ * 生产环境PostgreSQL延迟突增时服务内没有任何可见性，排障
+ * 依赖数据库侧的DBA权限。本组件在数据层记录每条语句的执行
+ * 耗时：超过可配置阈值的语句进入固定容量的滚动记录环（最旧
+ * 的被挤出），并按限速策略自动补抓EXPLAIN执行计划。记录环
+ * 经PerformanceMonitor暴露，运维接口随时可取，无需碰数据库。
+ *
+ * EXPLAIN限速是硬要求：慢查询往往成批出现（锁等待、坏计划
+ * 全表扫），每条都补抓EXPLAIN会在数据库最脆弱的时刻雪上
+ * 加霜，全局间隔内只放行一次。
+ */
+#ifndef STRATEGY_MONITOR_SLOWQUERYLOG_H
+#define STRATEGY_MONITOR_SLOWQUERYLOG_H
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace strategy {
+
+/**
+ * @brief 单条慢查询记录
+ */
+struct SlowQueryRecord {
+    std::string sql;                                    ///< 语句文本
+    double duration_ms = 0.0;                           ///< 执行耗时（毫秒）
+    std::size_t param_count = 0;                        ///< 绑定参数个数
+    std::string explain_plan;                           ///< EXPLAIN输出，未抓取时为空
+    std::chrono::system_clock::time_point captured_at;  ///< 捕获时刻
+};
+
+/**
+ * @brief 慢查询日志
+ *
+ * 线程安全；由PerformanceMonitor持有单实例，各仓储经
+ * BaseRepository的计时包装写入。
+ */
+class SlowQueryLog {
+public:
+    // 默认慢查询阈值、记录环容量与EXPLAIN最小间隔
+    static constexpr double DEFAULT_THRESHOLD_MS = 100.0;
+    static constexpr std::size_t DEFAULT_CAPACITY = 128;
+    static constexpr std::chrono::milliseconds DEFAULT_EXPLAIN_INTERVAL{5000};
+
+    /**
+     * @brief 构造慢查询日志
+     * @param capacity 滚动记录环容量
+     */
+    explicit SlowQueryLog(std::size_t capacity = DEFAULT_CAPACITY);
+
+    /**
+     * @brief 启用/禁用慢查询捕获
+     * @param enabled 是否启用
+     */
+    void SetEnabled(bool enabled);
+
+    /**
+     * @brief 捕获是否启用
+     */
+    bool IsEnabled() const;
+
+    /**
+     * @brief 设置慢查询阈值
+     * @param threshold_ms 阈值（毫秒），不超过则不记录
+     */
+    void SetThresholdMs(double threshold_ms);
+
+    /**
+     * @brief 当前慢查询阈值（毫秒）
+     */
+    double GetThresholdMs() const;
+
+    /**
+     * @brief 设置EXPLAIN抓取的全局最小间隔
+     * @param interval 间隔，间隔内的慢查询只记录不抓计划
+     */
+    void SetExplainInterval(std::chrono::milliseconds interval);
+
+    /**
+     * @brief 该耗时是否达到慢查询标准
+     * @param duration_ms 执行耗时（毫秒）
+     * @return 启用且达到阈值时返回true
+     */
+    bool IsSlow(double duration_ms) const;
+
+    /**
+     * @brief 申请一次EXPLAIN抓取名额（限速器）
+     *
+     * 距上次放行不足最小间隔时拒绝；放行即推进时间戳，
+     * 调用方拿到名额后才执行EXPLAIN。
+     *
+     * @return 是否放行
+     */
+    bool TryAcquireExplainSlot();
+
+    /**
+     * @brief 写入一条慢查询记录
+     *
+     * 超出容量时挤出最旧记录。
+     *
+     * @param record 慢查询记录
+     */
+    void Record(SlowQueryRecord record);
+
+    /**
+     * @brief 取滚动记录快照（最旧在前）
+     */
+    std::vector<SlowQueryRecord> GetRecords() const;
+
+    /**
+     * @brief 累计慢查询条数（含已被挤出的）
+     */
+    std::uint64_t GetSlowQueryCount() const;
+
+    /**
+     * @brief 累计抓取的EXPLAIN次数
+     */
+    std::uint64_t GetExplainCount() const;
+
+    /**
+     * @brief 清空记录与计数（测试/运维复位用）
+     */
+    void Clear();
+
+private:
+    mutable std::mutex mutex_;                          ///< 保护全部状态
+    std::deque<SlowQueryRecord> records_;               ///< 滚动记录环
+    std::size_t capacity_;                              ///< 记录环容量
+    double threshold_ms_ = DEFAULT_THRESHOLD_MS;        ///< 慢查询阈值
+    std::chrono::milliseconds explain_interval_ = DEFAULT_EXPLAIN_INTERVAL;  ///< EXPLAIN最小间隔
+    std::chrono::steady_clock::time_point last_explain_;  ///< 上次放行时刻
+    bool has_explained_ = false;                        ///< 是否放行过EXPLAIN
+    bool enabled_ = true;                               ///< 是否启用
+    std::uint64_t slow_count_ = 0;                      ///< 累计慢查询数
+    std::uint64_t explain_count_ = 0;                   ///< 累计EXPLAIN数
+};
+
+} // namespace strategy
+
+#endif // STRATEGY_MONITOR_SLOWQUERYLOG_H
@@ -10,9 +10,11 @@
 #define STRATEGY_PLAYER_SERVICE_IPLAYERREPOSITORY_H
 
 #include "player_service/Player.h"
+#include <algorithm>
 #include <string>
 #include <optional>
 #include <memory>
+#include <vector>
 
 namespace strategy {
 
@@ -50,6 +52,47 @@ public:
      */
     virtual bool UpdatePlayer(const Player& player) = 0;
 
+    /**
+     * @brief 批量更新玩家信息
+     *
+     * 默认实现逐条调用 UpdatePlayer；支持批量语句的实现
+     * （如PostgreSQL多行更新）应覆盖此方法以减少往返次数。
+     *
+     * @param players 要更新的玩家对象列表
+     * @return 如果全部更新成功，返回 true
+     */
+    virtual bool UpdatePlayers(const std::vector<Player>& players) {
+        bool all_ok = true;
+        for (const Player& player : players) {
+            all_ok = UpdatePlayer(player) && all_ok;
+        }
+        return all_ok;
+    }
+
+    /**
+     * @brief 事务性批量更新玩家信息（交易、公会操作等多实体写入用）
+     *
+     * 所有更新在一个数据库事务中完成：要么全部生效，要么全部
+     * 回滚。实现必须按玩家ID升序获取行锁，保证并发的多实体
+     * 写入以相同顺序加锁，不会互相死锁。latency_budget_ms为
+     * 整批写入的延迟预算，支持语句超时的实现应在预算耗尽时
+     * 放弃并回滚，而不是无限等锁。
+     *
+     * 默认实现不具备事务语义：仅按ID升序排序后委托
+     * UpdatePlayers尽力而为，供不支持事务的后端使用。
+     *
+     * @param players 要更新的玩家对象列表（ID必须有效）
+     * @param latency_budget_ms 整批写入的延迟预算（毫秒）
+     * @return 全部更新在预算内成功时返回 true
+     */
+    virtual bool UpdatePlayersAtomic(const std::vector<Player>& players, int latency_budget_ms) {
+        (void)latency_budget_ms;
+        std::vector<Player> ordered(players);
+        std::sort(ordered.begin(), ordered.end(),
+                  [](const Player& a, const Player& b) { return a.id < b.id; });
+        return UpdatePlayers(ordered);
+    }
+
     /**
      * @brief 根据ID删除玩家
      * @param id 要删除的玩家ID
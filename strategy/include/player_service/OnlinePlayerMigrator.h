@@ -0,0 +1,219 @@
+/*
+ * 文件名: OnlinePlayerMigrator.h
+ * 说明: 玩家表在线迁移器，分块改写数据并持久化检查点
+ * 作者: 彭承康
+ * 创建时间: 2026-08-28
+ *
+ * players表已经大到离线迁移超出维护窗口。本类在后台线程按主键
+ * 区间分块走表，每块调用行变换回调并与检查点同事务提交，进程
+ * 中断后从上次提交的块继续；块间按连接池压力和复制延迟退避，
+ * PlayerService在整个迁移期间保持在线服务。
+ *
+ * 与MigrationManager的分块回填不同：回填是迁移脚本的一部分，
+ * 在RunMigrations内同步执行完才返回；本类面向运行中的服务，
+ * 迁移与线上流量长时间共存，需要独立的生命周期和限速来源。
+ *
+ * 使用示例：
+ *   OnlinePlayerMigrator migrator(connection, "players_v2_email_split",
+ *       [](IDatabaseConnection& conn, long long start, long long end) {
+ *           conn.ExecuteUpdate("UPDATE players SET ... WHERE id > $1 AND id <= $2;",
+ *                              {std::any(start), std::any(end)});
+ *           return true;
+ *       });
+ *   migrator.SetThrottleSources(
+ *       [&pool] { return pool.GetPoolStatus().available_connections == 0; },
+ *       lag_probe);
+ *   migrator.Start();   // 后台推进，服务照常读写
+ */
+#ifndef STRATEGY_PLAYER_SERVICE_ONLINEPLAYERMIGRATOR_H
+#define STRATEGY_PLAYER_SERVICE_ONLINEPLAYERMIGRATOR_H
+
+#include "database/IDatabaseConnection.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace strategy {
+
+/**
+ * @brief 玩家表在线迁移器
+ *
+ * 按主键区间分块改写players表，检查点落表可恢复，
+ * 块间限速让路线上流量。
+ *
+ * 线程安全性：Start/Stop/状态查询可跨线程调用；
+ * 行变换回调在后台迁移线程上执行。
+ */
+class OnlinePlayerMigrator {
+public:
+    // 默认分块参数：每块500行主键区间，块间停顿100毫秒
+    static constexpr long long DEFAULT_CHUNK_SIZE = 500;
+    static constexpr std::chrono::milliseconds DEFAULT_PAUSE{100};
+
+    // 退避阈值与退避时长：复制延迟超过阈值或连接池无空闲连接时，
+    // 暂停一个退避周期再重新检查，不与线上流量争抢资源
+    static constexpr std::chrono::milliseconds MAX_REPLICATION_LAG{2000};
+    static constexpr std::chrono::milliseconds BACKOFF_PAUSE{1000};
+
+    /**
+     * @brief 单块行变换回调
+     *
+     * 在 (chunk_start, chunk_end] 主键区间上执行数据改写，
+     * 与检查点推进处于同一事务中；返回false中止迁移。
+     */
+    using ChunkTransform = std::function<bool(IDatabaseConnection& conn,
+                                              long long chunk_start,
+                                              long long chunk_end)>;
+
+    /**
+     * @brief 连接池压力探测回调
+     *
+     * 返回true表示线上流量正在争抢数据库资源，迁移应让路。
+     * 典型实现：ConnectionPool::GetPoolStatus()的空闲连接数为0。
+     */
+    using PressureProbe = std::function<bool()>;
+
+    /**
+     * @brief 复制延迟探测回调
+     *
+     * 返回当前主从复制延迟；无复制部署时不设置即可。
+     */
+    using LagProbe = std::function<std::chrono::milliseconds()>;
+
+    /**
+     * @brief 构造函数
+     * @param connection 迁移专用数据库连接，必须已连接；
+     *                   不要传入线上请求正在使用的连接
+     * @param migration_name 迁移名，作为检查点表中的主键，
+     *                       同名迁移重启后从检查点恢复
+     * @param transform 单块行变换回调
+     * @throws std::invalid_argument 连接为空、迁移名为空或回调为空
+     */
+    OnlinePlayerMigrator(std::shared_ptr<IDatabaseConnection> connection,
+                         std::string migration_name,
+                         ChunkTransform transform);
+
+    /**
+     * @brief 析构函数
+     * 停止后台线程并等待其退出；检查点已随最后提交的块落表。
+     */
+    ~OnlinePlayerMigrator();
+
+    /**
+     * @brief 设置分块大小与块间停顿
+     * @param chunk_size 单块覆盖的主键区间宽度，须为正
+     * @param pause 两块之间的停顿时长
+     * @throws std::invalid_argument 分块大小非正
+     */
+    void SetPacing(long long chunk_size, std::chrono::milliseconds pause);
+
+    /**
+     * @brief 设置限速来源
+     *
+     * 池压力探测返回true（线上请求正在排队等连接）或复制延迟
+     * 超过 MAX_REPLICATION_LAG 时，迁移暂停 BACKOFF_PAUSE
+     * 后重新检查。两个来源都可为空。
+     *
+     * @param pressure_probe 连接池压力探测回调，可为空
+     * @param lag_probe 复制延迟探测回调，可为空
+     */
+    void SetThrottleSources(PressureProbe pressure_probe, LagProbe lag_probe);
+
+    /**
+     * @brief 启动后台迁移线程
+     *
+     * 从检查点（无则从0）继续推进；迁移上界在启动时确定一次，
+     * 之后新插入的行由应用层写入路径直接写成新格式。
+     *
+     * @return false 已在运行中
+     */
+    bool Start();
+
+    /**
+     * @brief 请求停止并等待后台线程退出
+     *
+     * 当前块执行完并提交检查点后停止，不会留下半块。
+     */
+    void Stop();
+
+    /**
+     * @brief 同步执行迁移直到完成、失败或被Stop打断
+     *
+     * Start的后台线程内部调用本方法；需要同步语义的调用方
+     * （命令行工具、测试）可直接调用。
+     *
+     * @return true 所有块完成并清理了检查点
+     */
+    bool RunToCompletion();
+
+    /**
+     * @brief 后台线程是否在运行
+     */
+    bool IsRunning() const;
+
+    /**
+     * @brief 迁移是否已全部完成
+     */
+    bool IsFinished() const;
+
+    /**
+     * @brief 最后提交的检查点（主键上界）
+     */
+    long long GetCheckpoint() const;
+
+private:
+    /**
+     * @brief 后台线程主循环（RunToCompletion的线程包装）
+     */
+    void MigrationLoop();
+
+    /**
+     * @brief 创建检查点表（如果不存在）
+     */
+    bool EnsureCheckpointTable();
+
+    /**
+     * @brief 读取本迁移的检查点，无则插入初始行并返回0
+     */
+    long long LoadCheckpoint();
+
+    /**
+     * @brief 查询players表当前最大主键作为迁移上界
+     */
+    long long QueryMaxId();
+
+    /**
+     * @brief 是否应退避让路（池压力或复制延迟超阈值）
+     */
+    bool ShouldBackOff() const;
+
+    /**
+     * @brief 可被Stop打断的停顿
+     * @return false 停顿期间收到停止请求
+     */
+    bool InterruptiblePause(std::chrono::milliseconds duration);
+
+    std::shared_ptr<IDatabaseConnection> connection_;  ///< 迁移专用连接
+    std::string migration_name_;                       ///< 迁移名（检查点主键）
+    ChunkTransform transform_;                         ///< 单块行变换回调
+    PressureProbe pressure_probe_;                     ///< 连接池压力探测
+    LagProbe lag_probe_;                               ///< 复制延迟探测
+    long long chunk_size_ = DEFAULT_CHUNK_SIZE;        ///< 分块大小
+    std::chrono::milliseconds pause_ = DEFAULT_PAUSE;  ///< 块间停顿
+    std::atomic<long long> checkpoint_{0};             ///< 最后提交的检查点
+    std::atomic<bool> running_{false};                 ///< 后台线程运行标志
+    std::atomic<bool> finished_{false};                ///< 迁移完成标志
+    mutable std::mutex stop_mutex_;                    ///< 停顿/停止同步锁
+    std::condition_variable stop_condition_;           ///< 用于打断块间停顿
+    bool stop_flag_ = false;                           ///< 停止请求标志
+    std::thread worker_;                               ///< 后台迁移线程
+};
+
+} // namespace strategy
+
+#endif // STRATEGY_PLAYER_SERVICE_ONLINEPLAYERMIGRATOR_H
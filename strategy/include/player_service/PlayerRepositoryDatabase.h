@@ -3,19 +3,40 @@
  * 说明: 基于通用数据库接口的玩家仓储
  * 作者: 彭承康
  * 创建时间: 2026-02-18
+ * 更新时间: 2026-08-28 — 迁移到EntityRepository，SQL改为编译期生成
  */
 #ifndef STRATEGY_PLAYER_SERVICE_PLAYERREPOSITORYDATABASE_H
 #define STRATEGY_PLAYER_SERVICE_PLAYERREPOSITORYDATABASE_H
 
 #include "player_service/IPlayerRepository.h"
-#include "database/BaseRepository.h"
+#include "database/EntityRepository.h"
 #include "database/IDatabaseConnection.h"
+#include <array>
 #include <memory>
+#include <string_view>
 
 namespace strategy {
 
-class PlayerRepositoryDatabase : public IPlayerRepository, public BaseRepository {
+/**
+ * @brief 玩家仓储（通用数据库连接实现）
+ *
+ * IPlayerRepository的薄适配层：表/列元数据以constexpr常量
+ * 描述，所有SQL形状由EntityRepository在编译期生成，虚函数
+ * 体内只做参数绑定、异常兜底与行转换。
+ */
+class PlayerRepositoryDatabase : public IPlayerRepository,
+                                 public EntityRepository<PlayerRepositoryDatabase, Player> {
 public:
+    // 编译期表元数据，下标0为主键列
+    static constexpr std::string_view TABLE_NAME = "players";
+    static constexpr std::array<std::string_view, 5> COLUMNS = {
+        "id", "username", "password_hash", "email", "created_at"
+    };
+    static constexpr std::size_t UPDATABLE_COUNT = 3;
+    // created_at由数据库在插入时填充
+    static constexpr std::string_view INSERT_EXTRA_COLUMNS = ", created_at";
+    static constexpr std::string_view INSERT_EXTRA_VALUES = ", CURRENT_TIMESTAMP";
+
     explicit PlayerRepositoryDatabase(std::unique_ptr<IDatabaseConnection> connection);
     virtual ~PlayerRepositoryDatabase() = default;
 
@@ -23,13 +44,27 @@ public:
     std::optional<Player> FindPlayerById(long long id) override;
     std::optional<Player> FindPlayerByUsername(const std::string& username) override;
     bool UpdatePlayer(const Player& player) override;
+
+    /**
+     * @brief 事务性批量更新（单连接、单事务）
+     *
+     * 所有更新语句按玩家ID升序在同一事务中执行，任一失败或
+     * 延迟预算耗尽即整体回滚。通用接口没有语句级超时，预算
+     * 在相邻语句之间用steady_clock检查。
+     */
+    bool UpdatePlayersAtomic(const std::vector<Player>& players, int latency_budget_ms) override;
+
     bool DeletePlayer(long long id) override;
 
+    /**
+     * @brief 查询结果行转换为Player实体
+     */
+    Player FromRow(const std::map<std::string, std::any>& row);
+
 private:
-    Player ConvertToPlayer(const std::map<std::string, std::any>& row);
     std::chrono::system_clock::time_point ParseTimestamp(const std::string& timestamp_str);
 };
 
 } // namespace strategy
 
-#endif // STRATEGY_PLAYER_SERVICE_PLAYERREPOSITORYDATABASE_H
\ No newline at end of file
+#endif // STRATEGY_PLAYER_SERVICE_PLAYERREPOSITORYDATABASE_H
@@ -29,6 +29,23 @@ public:
     std::optional<Player> FindPlayerByUsername(const std::string& username) override;
     std::optional<Player> FindPlayerById(long long id) override;
     bool UpdatePlayer(const Player& player) override;
+
+    /**
+     * @brief 批量更新玩家信息（单条多行UPDATE语句）
+     * 写后缓存刷新时使用，避免逐条更新的往返开销。
+     */
+    bool UpdatePlayers(const std::vector<Player>& players) override;
+
+    /**
+     * @brief 事务性批量更新（单事务、单连接）
+     *
+     * 先以SELECT ... ORDER BY id FOR UPDATE按ID升序获取全部
+     * 行锁，再用一条多行UPDATE落库。lock_timeout与
+     * statement_timeout按延迟预算以SET LOCAL设置，预算耗尽时
+     * 语句报错、事务整体回滚。
+     */
+    bool UpdatePlayersAtomic(const std::vector<Player>& players, int latency_budget_ms) override;
+
     bool DeletePlayer(long long id) override;
 
 private:
@@ -0,0 +1,122 @@
+/*
+ * 文件名: PlayerRepositoryReadCache.h
+ * 说明: 玩家数据仓库的读通（read-through）缓存装饰器。
+ * 作者: 彭承康
+ * 创建时间: 2026-08-27
+ *
+ * 查询优先命中内存缓存，未命中时回源底层仓库并写入缓存。
+ * 条目带TTL过期；容量超出预算时按LRU淘汰；不存在的玩家ID
+ * 也会缓存（负缓存），避免反复穿透到数据库。写路径
+ * （创建/更新/删除）同步刷新或失效对应条目。
+ */
+#ifndef STRATEGY_PLAYER_SERVICE_PLAYERREPOSITORYREADCACHE_H
+#define STRATEGY_PLAYER_SERVICE_PLAYERREPOSITORYREADCACHE_H
+
+#include "player_service/IPlayerRepository.h"
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+namespace strategy {
+
+/**
+ * @brief 读通缓存玩家仓库
+ * 装饰任意IPlayerRepository实现，使重复查询不再触达数据库。
+ */
+class PlayerRepositoryReadCache : public IPlayerRepository {
+public:
+    // 默认条目存活时间与容量预算（条目数）
+    static constexpr std::chrono::milliseconds DEFAULT_TTL{30000};
+    static constexpr std::size_t DEFAULT_MAX_ENTRIES = 4096;
+
+    /**
+     * @brief 构造函数
+     * @param repository 底层仓库实现
+     * @param ttl 缓存条目存活时间
+     * @param max_entries 缓存容量上限，超出按LRU淘汰
+     */
+    explicit PlayerRepositoryReadCache(
+        std::unique_ptr<IPlayerRepository> repository,
+        std::chrono::milliseconds ttl = DEFAULT_TTL,
+        std::size_t max_entries = DEFAULT_MAX_ENTRIES);
+
+    std::optional<Player> CreatePlayer(const std::string& username,
+                                       const std::string& password_hash,
+                                       const std::string& email) override;
+    std::optional<Player> FindPlayerByUsername(const std::string& username) override;
+
+    /**
+     * @brief 按ID查找玩家（命中缓存时不触达底层仓库）
+     */
+    std::optional<Player> FindPlayerById(long long id) override;
+
+    bool UpdatePlayer(const Player& player) override;
+    bool UpdatePlayers(const std::vector<Player>& players) override;
+
+    /**
+     * @brief 事务性批量更新（委托底层仓库，成功后刷新缓存条目）
+     */
+    bool UpdatePlayersAtomic(const std::vector<Player>& players, int latency_budget_ms) override;
+
+    bool DeletePlayer(long long id) override;
+
+    /**
+     * @brief 使指定玩家的缓存条目失效
+     * 外部直接改库（如后台工具）后调用，保证下次读取回源。
+     */
+    void Invalidate(long long id);
+
+    /**
+     * @brief 缓存命中次数（含负缓存命中）
+     */
+    std::uint64_t GetHitCount() const;
+
+    /**
+     * @brief 缓存未命中（回源）次数
+     */
+    std::uint64_t GetMissCount() const;
+
+private:
+    // 缓存条目：std::nullopt 表示负缓存（确认不存在的ID）
+    struct CacheEntry {
+        long long id = 0;
+        std::optional<Player> player;
+        std::chrono::steady_clock::time_point expire_at;
+    };
+
+    using LruList = std::list<CacheEntry>;
+
+    /**
+     * @brief 在互斥锁内查找未过期条目并移到LRU头部
+     * @return 命中时返回条目指针，否则返回nullptr
+     */
+    const CacheEntry* LookupLocked(long long id);
+
+    /**
+     * @brief 在互斥锁内写入/覆盖条目，必要时按LRU淘汰
+     */
+    void StoreLocked(long long id, std::optional<Player> player);
+
+    /**
+     * @brief 在互斥锁内移除条目
+     */
+    void EraseLocked(long long id);
+
+    std::unique_ptr<IPlayerRepository> repository_;         ///< 底层仓库
+    std::chrono::milliseconds ttl_;                         ///< 条目存活时间
+    std::size_t max_entries_;                               ///< 容量预算
+    LruList lru_;                                           ///< 条目链表，头部最新
+    std::unordered_map<long long, LruList::iterator> by_id_;    ///< ID → 条目
+    std::unordered_map<std::string, long long> id_by_username_; ///< 用户名 → ID（仅正缓存）
+    mutable std::mutex mutex_;                              ///< 保护缓存结构
+    std::uint64_t hit_count_ = 0;                           ///< 命中计数
+    std::uint64_t miss_count_ = 0;                          ///< 回源计数
+};
+
+} // namespace strategy
+
+#endif // STRATEGY_PLAYER_SERVICE_PLAYERREPOSITORYREADCACHE_H
@@ -0,0 +1,102 @@
+/*
+ * 文件名: PlayerRepositoryWriteBehind.h
+ * 说明: 玩家数据仓库的写后（write-behind）装饰器。
+ * 作者: 彭承康
+ * 创建时间: 2026-08-27
+ *
+ * 将写入先保存在内存脏表中合并（同一玩家多次更新只保留最新状态），
+ * 由后台线程按间隔或积压阈值批量刷入底层仓库，数据库写QPS
+ * 与玩家操作频率解耦。读取优先返回脏表中的待写状态，
+ * 保证读己之写。析构时做最终刷新。
+ */
+#ifndef STRATEGY_PLAYER_SERVICE_PLAYERREPOSITORYWRITEBEHIND_H
+#define STRATEGY_PLAYER_SERVICE_PLAYERREPOSITORYWRITEBEHIND_H
+
+#include "player_service/IPlayerRepository.h"
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+namespace strategy {
+
+/**
+ * @brief 写后缓存玩家仓库
+ * 装饰任意IPlayerRepository实现，使其写入异步化、批量化。
+ */
+class PlayerRepositoryWriteBehind : public IPlayerRepository {
+public:
+    // 默认刷新间隔与触发立即刷新的脏记录积压阈值
+    static constexpr std::chrono::milliseconds DEFAULT_FLUSH_INTERVAL{500};
+    static constexpr std::size_t FLUSH_BACKLOG_THRESHOLD = 128;
+
+    /**
+     * @brief 构造函数
+     * @param repository 底层仓库实现
+     * @param flush_interval 后台刷新间隔
+     */
+    explicit PlayerRepositoryWriteBehind(
+        std::unique_ptr<IPlayerRepository> repository,
+        std::chrono::milliseconds flush_interval = DEFAULT_FLUSH_INTERVAL);
+
+    /**
+     * @brief 析构函数
+     * 停止后台线程并把剩余脏记录刷入底层仓库。
+     */
+    ~PlayerRepositoryWriteBehind() override;
+
+    std::optional<Player> CreatePlayer(const std::string& username,
+                                       const std::string& password_hash,
+                                       const std::string& email) override;
+    std::optional<Player> FindPlayerByUsername(const std::string& username) override;
+    std::optional<Player> FindPlayerById(long long id) override;
+
+    /**
+     * @brief 更新玩家信息（写入内存脏表，稍后批量落库）
+     */
+    bool UpdatePlayer(const Player& player) override;
+
+    /**
+     * @brief 事务性批量更新（绕过脏表，直达底层仓库）
+     *
+     * 交易等多实体写入需要原子落库，不能进入异步合并路径。
+     * 受影响玩家在脏表中的待写状态会被本次写入取代；底层
+     * 失败时放回脏表，不丢失更新。
+     */
+    bool UpdatePlayersAtomic(const std::vector<Player>& players, int latency_budget_ms) override;
+
+    bool DeletePlayer(long long id) override;
+
+    /**
+     * @brief 立即把所有脏记录批量刷入底层仓库
+     *
+     * 玩家登出等需要保证落库的时机应显式调用。
+     *
+     * @return 底层批量更新是否全部成功
+     */
+    bool FlushNow();
+
+    /**
+     * @brief 当前脏表中待写记录数
+     */
+    std::size_t GetPendingCount() const;
+
+private:
+    void FlushLoop();
+    bool FlushBatch();
+
+    std::unique_ptr<IPlayerRepository> repository_;   ///< 底层仓库
+    std::unordered_map<long long, Player> dirty_;     ///< 玩家ID → 最新待写状态
+    mutable std::mutex mutex_;                        ///< 保护脏表
+    std::condition_variable flush_condition_;         ///< 唤醒后台刷新线程
+    std::chrono::milliseconds flush_interval_;        ///< 刷新间隔
+    bool stop_flag_ = false;                          ///< 线程停止标志
+    std::thread flush_thread_;                        ///< 后台刷新线程
+};
+
+} // namespace strategy
+
+#endif // STRATEGY_PLAYER_SERVICE_PLAYERREPOSITORYWRITEBEHIND_H
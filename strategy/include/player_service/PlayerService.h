@@ -12,6 +12,7 @@
 #include <memory>
 #include <string>
 #include <optional>
+#include <vector>
 
 namespace strategy {
 
@@ -29,6 +30,9 @@ struct RegisterResult {
 
 class PlayerService {
 public:
+    // 多实体事务写入的默认延迟预算（毫秒）
+    static constexpr int DEFAULT_ATOMIC_WRITE_BUDGET_MS = 250;
+
     explicit PlayerService(std::unique_ptr<IPlayerRepository> repository);
     virtual ~PlayerService() = default;
 
@@ -37,6 +41,21 @@ public:
     std::optional<Player> GetPlayerById(long long id);
     bool UpdatePlayerEmail(long long id, const std::string& new_email);
     bool UpdatePlayerPassword(long long id, const std::string& old_password, const std::string& new_password);
+
+    /**
+     * @brief 事务性更新多个玩家（交易、公会操作用）
+     *
+     * 所有更新在一个数据库事务、一条连接上完成，要么全部生效
+     * 要么全部回滚。同一玩家出现多次时只保留最后一次出现的
+     * 状态；仓库实现按ID升序取锁，并发写入互不死锁。
+     *
+     * @param players 要更新的玩家对象列表（ID必须有效）
+     * @param latency_budget_ms 整批写入的延迟预算（毫秒）
+     * @return 全部更新在预算内成功时返回 true
+     */
+    bool UpdatePlayersAtomic(const std::vector<Player>& players,
+                             int latency_budget_ms = DEFAULT_ATOMIC_WRITE_BUDGET_MS);
+
     bool DeletePlayer(long long id);
 
 private:
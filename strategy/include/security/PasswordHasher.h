@@ -8,6 +8,7 @@
 #define STRATEGY_SECURITY_PASSWORDHASHER_H
 
 #include <string>
+#include <vector>
 
 namespace strategy {
 
@@ -34,6 +35,19 @@ public:
      */
     static bool verifyPassword(const std::string& password, const std::string& stored);
 
+    /**
+     * @brief 批量验证密码
+     *
+     * 哈希计算经由SHA256::hashBatch交错并行，适合登录风暴
+     * 场景下一次校验大量玩家。
+     *
+     * @param passwords 明文密码列表
+     * @param stored 与之对应的 "salt:hash" 存储串列表
+     * @return 与输入一一对应的验证结果；两个列表长度不一致时返回空
+     */
+    static std::vector<bool> verifyPasswords(const std::vector<std::string>& passwords,
+                                             const std::vector<std::string>& stored);
+
 private:
     static std::string generateSalt();
     static std::string hashWithSalt(const std::string& salt, const std::string& password);
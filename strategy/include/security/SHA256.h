@@ -10,6 +10,7 @@
 #include <string>
 #include <array>
 #include <cstdint>
+#include <vector>
 
 namespace strategy {
 
@@ -17,6 +18,9 @@ namespace strategy {
  * @brief SHA-256哈希算法实现
  *
  * 遵循FIPS 180-4标准的纯C++实现，无外部依赖。
+ * x86-64平台运行时检测CPU能力：支持SHA-NI时单条消息
+ * 走硬件指令路径，支持AVX2时批量接口对8条消息做
+ * 跨消息并行；其余情况回退标量实现，结果完全一致。
  */
 class SHA256 {
 public:
@@ -27,9 +31,22 @@ public:
      */
     static std::string hash(const std::string& input);
 
+    /**
+     * @brief 批量计算多条输入的SHA-256哈希值
+     *
+     * 单块消息（不超过55字节）在支持AVX2的机器上按8条
+     * 一组并行计算，长消息与余数回退单条路径。
+     *
+     * @param inputs 输入字符串列表
+     * @return 与输入一一对应的十六进制哈希列表
+     */
+    static std::vector<std::string> hashBatch(const std::vector<std::string>& inputs);
+
 private:
     static constexpr size_t BLOCK_SIZE = 64;
     static constexpr size_t HASH_SIZE = 32;
+    static constexpr size_t SINGLE_BLOCK_MAX = 55;  ///< 填充后仍为单块的最大消息长度
+    static constexpr size_t BATCH_LANES = 8;        ///< AVX2批量路径的并行消息数
 
     static const std::array<uint32_t, 64> K;
 
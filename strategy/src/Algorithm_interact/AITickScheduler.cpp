@@ -0,0 +1,151 @@
+/*
+ * File: AITickScheduler.cpp
+ * Description: Relevance-tiered AI tick scheduler implementation.
+ */
+
+#include "Algorithm_interact/AITickScheduler.h"
+
+#include <unordered_set>
+#include <utility>
+
+namespace strategy {
+
+AITickScheduler::AITickScheduler(DecisionBatchSink sink)
+    : sink_(std::move(sink)) {}
+
+void AITickScheduler::SetSink(DecisionBatchSink sink) {
+    const std::lock_guard<std::mutex> lock(mutex_);
+    sink_ = std::move(sink);
+}
+
+void AITickScheduler::RegisterNPC(int npc_id, algorithm::NPCType type, float x, float y) {
+    const std::lock_guard<std::mutex> lock(mutex_);
+    npcs_[npc_id] = NPCEntry{type == algorithm::NPCType::Passive, 0};
+    npc_index_.Upsert(npc_id, x, y);
+}
+
+void AITickScheduler::UnregisterNPC(int npc_id) {
+    const std::lock_guard<std::mutex> lock(mutex_);
+    npcs_.erase(npc_id);
+    npc_index_.Remove(npc_id);
+}
+
+void AITickScheduler::UpdateNPCPosition(int npc_id, float x, float y) {
+    const std::lock_guard<std::mutex> lock(mutex_);
+    if (npcs_.find(npc_id) != npcs_.end()) {
+        npc_index_.Upsert(npc_id, x, y);
+    }
+}
+
+void AITickScheduler::UpdatePlayerPosition(int player_id, float x, float y) {
+    const std::lock_guard<std::mutex> lock(mutex_);
+    players_[player_id] = PlayerPosition{x, y};
+}
+
+void AITickScheduler::RemovePlayer(int player_id) {
+    const std::lock_guard<std::mutex> lock(mutex_);
+    players_.erase(player_id);
+}
+
+void AITickScheduler::WakeNPC(int npc_id, int wake_ticks) {
+    const std::lock_guard<std::mutex> lock(mutex_);
+    auto it = npcs_.find(npc_id);
+    if (it == npcs_.end() || !it->second.passive || wake_ticks <= 0) {
+        return;
+    }
+    // Extend rather than replace so overlapping wakes do not cut a
+    // burst short.
+    if (wake_ticks > it->second.wake_ticks_left) {
+        it->second.wake_ticks_left = wake_ticks;
+    }
+}
+
+std::size_t AITickScheduler::Tick() {
+    std::vector<int> due;
+    DecisionBatchSink sink;
+
+    {
+        const std::lock_guard<std::mutex> lock(mutex_);
+        sink = sink_;
+        ++tick_count_;
+
+        // One batched radius query around all players replaces the
+        // per-NPC distance scan; its cost tracks the active population.
+        std::vector<std::pair<float, float>> centers;
+        centers.reserve(players_.size());
+        for (const auto& [player_id, position] : players_) {
+            centers.emplace_back(position.x, position.y);
+        }
+        const std::vector<int> near_ids =
+            npc_index_.QueryRadiusBatch(centers, ACTIVE_RADIUS);
+        const std::unordered_set<int> active(near_ids.begin(), near_ids.end());
+
+        for (auto& [npc_id, entry] : npcs_) {
+            if (entry.passive) {
+                // Sleeping until woken; awake bursts run at full rate.
+                if (entry.wake_ticks_left > 0) {
+                    --entry.wake_ticks_left;
+                    due.push_back(npc_id);
+                }
+                continue;
+            }
+
+            if (active.count(npc_id) != 0) {
+                due.push_back(npc_id);
+                continue;
+            }
+
+            // Distant: 1/10th rate, staggered by id so each tick carries
+            // roughly a tenth of the distant population as one batch.
+            if ((tick_count_ + static_cast<std::uint64_t>(npc_id)) % DISTANT_DIVISOR == 0) {
+                due.push_back(npc_id);
+            }
+        }
+    }
+
+    // Dispatch outside the lock: the sink may issue batch RPCs or
+    // in-process decision calls, and registration must not wait on it.
+    if (!due.empty() && sink) {
+        sink(due);
+    }
+    return due.size();
+}
+
+AITickTier AITickScheduler::TierOf(int npc_id) const {
+    const std::lock_guard<std::mutex> lock(mutex_);
+    auto it = npcs_.find(npc_id);
+    if (it == npcs_.end()) {
+        return AITickTier::SLEEPING;
+    }
+    return TierOfLocked(npc_id, it->second);
+}
+
+std::size_t AITickScheduler::RegisteredCount() const {
+    const std::lock_guard<std::mutex> lock(mutex_);
+    return npcs_.size();
+}
+
+bool AITickScheduler::NearAnyPlayerLocked(float x, float y) const {
+    for (const auto& [player_id, position] : players_) {
+        const float dx = x - position.x;
+        const float dy = y - position.y;
+        if (dx * dx + dy * dy <= ACTIVE_RADIUS * ACTIVE_RADIUS) {
+            return true;
+        }
+    }
+    return false;
+}
+
+AITickTier AITickScheduler::TierOfLocked(int npc_id, const NPCEntry& entry) const {
+    if (entry.passive) {
+        return entry.wake_ticks_left > 0 ? AITickTier::ACTIVE : AITickTier::SLEEPING;
+    }
+    float x = 0.0f;
+    float y = 0.0f;
+    if (!npc_index_.GetPosition(npc_id, x, y)) {
+        return AITickTier::DISTANT;
+    }
+    return NearAnyPlayerLocked(x, y) ? AITickTier::ACTIVE : AITickTier::DISTANT;
+}
+
+} // namespace strategy
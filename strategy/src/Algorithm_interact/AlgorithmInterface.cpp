@@ -121,7 +121,7 @@ algorithm::AIDecisionResult AlgorithmInterface::RequestAIDecision(int npc_id, co
         // 构建AI决策请求
         algorithm::AIDecisionRequest request;
         request.npc_id = npc_id;
-        request.context = context;
+        request.context.assign(context.begin(), context.end());
         
         // 调用算法服务进行AI决策
         return algorithm_service_->MakeAIDecision(request);
@@ -175,9 +175,12 @@ bool AlgorithmInterface::IsAlgorithmServiceAvailable() const {
 
 /**
  * @brief 创建算法服务实例实现
- * 
+ *
  * 内部方法，负责创建具体的算法服务对象。
  * 使用make_unique确保异常安全和资源管理。
+ *
+ * @note 同机部署下直接内嵌算法服务实例，伤害计算等调用为进程内
+ *       函数调用，无需任何跨进程传输；只有外部客户端才走gRPC。
  */
 void AlgorithmInterface::CreateAlgorithmService() {
     // 创建算法服务实例
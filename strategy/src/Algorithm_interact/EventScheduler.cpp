@@ -5,16 +5,251 @@
 
 #include "Algorithm_interact/EventScheduler.h"
 
+#include "common/ExecutorService.h"
+#include "monitor/PerformanceMonitor.h"
+
 #include <algorithm>
 #include <exception>
+#include <span>
 #include <sstream>
 
 namespace strategy {
 
+// ============================================================================
+// TimerWheel
+// ============================================================================
+
+EventScheduler::TimerWheel::TimerWheel()
+    : epoch_(std::chrono::steady_clock::now()) {
+}
+
+std::uint64_t EventScheduler::TimerWheel::TickFor(
+    std::chrono::steady_clock::time_point when) const {
+    if (when <= epoch_) {
+        return 0;
+    }
+    const auto elapsed =
+        std::chrono::duration_cast<std::chrono::milliseconds>(when - epoch_).count();
+    return static_cast<std::uint64_t>(elapsed / TICK_MS);
+}
+
+void EventScheduler::TimerWheel::Insert(TimerEntry entry) {
+    if (entry.expire_tick <= current_tick_) {
+        overdue_.push_back(entry.event_id);
+        return;
+    }
+
+    // Pick the coarsest level whose span still resolves this delay.
+    const std::uint64_t delta = entry.expire_tick - current_tick_;
+    int level = 0;
+    std::uint64_t span = SLOTS_PER_LEVEL;
+    while (level < WHEEL_LEVELS - 1 && delta >= span) {
+        span <<= SLOT_BITS;
+        ++level;
+    }
+
+    // Beyond even the top level's horizon: park in the furthest slot the
+    // wheel can address and let cascading re-sort it as time passes.
+    std::uint64_t slot_tick = entry.expire_tick;
+    if (delta >= span) {
+        slot_tick = current_tick_ + span - 1;
+    }
+
+    const std::size_t slot =
+        (slot_tick >> (SLOT_BITS * level)) & (SLOTS_PER_LEVEL - 1);
+    slots_[static_cast<std::size_t>(level)][slot].push_back(entry);
+    ++pending_;
+}
+
+void EventScheduler::TimerWheel::Cascade(int level, std::size_t slot) {
+    std::vector<TimerEntry> bucket =
+        std::move(slots_[static_cast<std::size_t>(level)][slot]);
+    slots_[static_cast<std::size_t>(level)][slot].clear();
+    for (const TimerEntry& entry : bucket) {
+        --pending_;
+        Insert(entry);
+    }
+}
+
+void EventScheduler::TimerWheel::Schedule(int event_id,
+                                          std::chrono::steady_clock::time_point when) {
+    Insert(TimerEntry{event_id, TickFor(when)});
+}
+
+void EventScheduler::TimerWheel::Advance(std::chrono::steady_clock::time_point now,
+                                         std::vector<int>& due) {
+    due.insert(due.end(), overdue_.begin(), overdue_.end());
+    overdue_.clear();
+
+    const std::uint64_t target = TickFor(now);
+    while (current_tick_ < target && pending_ > 0) {
+        ++current_tick_;
+        const std::size_t slot0 = current_tick_ & (SLOTS_PER_LEVEL - 1);
+
+        // Level 0 rolled over: pull the newly reached higher-level slots
+        // down. A zero slot at one level means the level above it rolled
+        // over too.
+        if (slot0 == 0) {
+            for (int level = 1; level < WHEEL_LEVELS; ++level) {
+                const std::size_t slot =
+                    (current_tick_ >> (SLOT_BITS * level)) & (SLOTS_PER_LEVEL - 1);
+                Cascade(level, slot);
+                if (slot != 0) {
+                    break;
+                }
+            }
+        }
+
+        std::vector<TimerEntry>& bucket = slots_[0][slot0];
+        for (const TimerEntry& entry : bucket) {
+            --pending_;
+            if (entry.expire_tick <= current_tick_) {
+                due.push_back(entry.event_id);
+            } else {
+                Insert(entry);
+            }
+        }
+        bucket.clear();
+    }
+
+    if (pending_ == 0) {
+        // Nothing scheduled: skip the idle ticks instead of spinning them.
+        current_tick_ = target;
+    }
+
+    due.insert(due.end(), overdue_.begin(), overdue_.end());
+    overdue_.clear();
+}
+
+bool EventScheduler::TimerWheel::Empty() const {
+    return pending_ == 0 && overdue_.empty();
+}
+
+// ============================================================================
+// EventScheduler
+// ============================================================================
+
 EventScheduler::EventScheduler() {
     InitializeDefaultEvents();
 }
 
+EventScheduler::~EventScheduler() {
+    DisableAsyncExecution();
+}
+
+void EventScheduler::EnableAsyncExecution(std::size_t worker_count) {
+    if (!workers_.empty()) {
+        return;
+    }
+
+    use_shared_executor_ = false;
+    stop_workers_ = false;
+    const std::size_t count = std::max<std::size_t>(1, worker_count);
+    workers_.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        workers_.emplace_back(&EventScheduler::WorkerLoop, this);
+    }
+}
+
+void EventScheduler::EnableSharedAsyncExecution() {
+    if (!workers_.empty()) {
+        DisableAsyncExecution();
+    }
+    use_shared_executor_ = true;
+}
+
+void EventScheduler::DisableAsyncExecution() {
+    use_shared_executor_ = false;
+    if (workers_.empty()) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(task_mutex_);
+        stop_workers_ = true;
+    }
+    task_condition_.notify_all();
+    for (std::thread& worker : workers_) {
+        worker.join();
+    }
+    workers_.clear();
+
+    // Run whatever the workers did not get to, so no due event is lost.
+    while (!task_queue_.empty()) {
+        AsyncTask task = std::move(task_queue_.front());
+        task_queue_.pop();
+        const EventTriggerResult result = ExecuteEvent(task.event, task.params);
+        if (completion_callback_) {
+            completion_callback_(task.event.event_id, result);
+        }
+    }
+}
+
+bool EventScheduler::MarkEventHeavy(int event_id, bool heavy) {
+    auto it = events_.find(event_id);
+    if (it == events_.end()) {
+        return false;
+    }
+    it->second.is_heavy = heavy;
+    return true;
+}
+
+void EventScheduler::SetCompletionCallback(EventCompletionCallback callback) {
+    completion_callback_ = std::move(callback);
+}
+
+void EventScheduler::WorkerLoop() {
+    while (true) {
+        AsyncTask task;
+        {
+            std::unique_lock<std::mutex> lock(task_mutex_);
+            task_condition_.wait(lock, [this] {
+                return stop_workers_ || !task_queue_.empty();
+            });
+            if (stop_workers_ && task_queue_.empty()) {
+                return;
+            }
+            task = std::move(task_queue_.front());
+            task_queue_.pop();
+        }
+
+        const EventTriggerResult result = ExecuteEvent(task.event, task.params);
+        if (completion_callback_) {
+            completion_callback_(task.event.event_id, result);
+        }
+    }
+}
+
+void EventScheduler::DispatchAsync(const GameEvent& event) {
+    if (use_shared_executor_) {
+        // Snapshot the event so the scheduler maps can change while the
+        // handler runs on the shared pool; a shed events lane degrades
+        // to inline execution so no due event is lost.
+        auto task = std::make_shared<AsyncTask>(AsyncTask{event, event.params});
+        const bool accepted = ExecutorService::GetInstance().Submit(
+            ExecutorLane::Events, [this, task]() {
+                const EventTriggerResult result =
+                    ExecuteEvent(task->event, task->params);
+                if (completion_callback_) {
+                    completion_callback_(task->event.event_id, result);
+                }
+            });
+        if (!accepted) {
+            const EventTriggerResult result = ExecuteEvent(task->event, task->params);
+            if (completion_callback_) {
+                completion_callback_(task->event.event_id, result);
+            }
+        }
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(task_mutex_);
+        task_queue_.push(AsyncTask{event, event.params});
+    }
+    task_condition_.notify_one();
+}
+
 EventTriggerResult EventScheduler::TriggerEvent(int event_id, const std::vector<int>& params) {
     auto it = events_.find(event_id);
     if (it == events_.end() || !it->second.is_active) {
@@ -27,30 +262,77 @@ EventTriggerResult EventScheduler::TriggerEvent(int event_id, const std::vector<
     return ExecuteEvent(it->second, params);
 }
 
+EventTriggerResult EventScheduler::TriggerEvent(const CompactEventRecord& record) {
+    auto it = events_.find(record.event_id);
+    if (it == events_.end() || !it->second.is_active) {
+        EventTriggerResult result;
+        result.triggered = false;
+        result.result_json = "{\"error\":\"event not found or inactive\"}";
+        return result;
+    }
+
+    return ExecuteEvent(it->second, record.Params());
+}
+
+CompactEventRecord& EventScheduler::AcquireRecord(int event_id, std::span<const int> params) {
+    return record_pool_.Acquire(event_id, GetEventNameId(event_id), params);
+}
+
+void EventScheduler::ResetRecordPool() {
+    record_pool_.Reset();
+}
+
 bool EventScheduler::ScheduleDelayedEvent(int event_id, const std::vector<int>& params, int delay_ms) {
+    return ScheduleDelayedEvent(event_id, std::vector<int>(params), delay_ms);
+}
+
+bool EventScheduler::ScheduleDelayedEvent(int event_id, std::vector<int>&& params, int delay_ms) {
     auto it = events_.find(event_id);
     if (it == events_.end()) {
         return false;
     }
 
-    GameEvent delayed_event = it->second;
+    // Update the registered event in place; no snapshot copy is needed
+    // since the stored entry is the one being rescheduled anyway.
+    GameEvent& delayed_event = it->second;
     delayed_event.type = EventType::DELAYED;
-    delayed_event.params = params;
+    delayed_event.params = std::move(params);
     delayed_event.trigger_time = std::chrono::steady_clock::now() + std::chrono::milliseconds(delay_ms);
 
-    events_[event_id] = delayed_event;
-    scheduled_events_.push({delayed_event.trigger_time, event_id});
+    wheel_.Schedule(event_id, delayed_event.trigger_time);
 
     return true;
 }
 
+std::size_t EventScheduler::ScheduleDelayedEvents(const std::vector<DelayedEventSpec>& specs) {
+    const auto now = std::chrono::steady_clock::now();
+    std::size_t scheduled = 0;
+
+    for (const DelayedEventSpec& spec : specs) {
+        auto it = events_.find(spec.event_id);
+        if (it == events_.end()) {
+            continue;
+        }
+
+        GameEvent& delayed_event = it->second;
+        delayed_event.type = EventType::DELAYED;
+        delayed_event.params = spec.params;
+        delayed_event.trigger_time = now + std::chrono::milliseconds(spec.delay_ms);
+
+        wheel_.Schedule(spec.event_id, delayed_event.trigger_time);
+        ++scheduled;
+    }
+
+    return scheduled;
+}
+
 bool EventScheduler::RegisterConditionalEvent(
     int event_id,
     std::function<bool()> condition,
-    std::function<std::string(const std::vector<int>&)> handler) {
+    std::function<std::string(std::span<const int>)> handler) {
     GameEvent conditional_event;
     conditional_event.event_id = event_id;
-    conditional_event.event_name = "conditional_event_" + std::to_string(event_id);
+    conditional_event.name_id = event_names_.Intern("conditional_event_" + std::to_string(event_id));
     conditional_event.type = EventType::CONDITIONAL;
     conditional_event.condition = condition;
     conditional_event.handler = handler;
@@ -62,11 +344,11 @@ bool EventScheduler::RegisterConditionalEvent(
 
 bool EventScheduler::RegisterPeriodicEvent(
     int event_id,
-    std::function<std::string(const std::vector<int>&)> handler,
+    std::function<std::string(std::span<const int>)> handler,
     int interval_ms) {
     GameEvent periodic_event;
     periodic_event.event_id = event_id;
-    periodic_event.event_name = "periodic_event_" + std::to_string(event_id);
+    periodic_event.name_id = event_names_.Intern("periodic_event_" + std::to_string(event_id));
     periodic_event.type = EventType::PERIODIC;
     periodic_event.handler = handler;
     periodic_event.repeat_interval_ms = interval_ms;
@@ -74,27 +356,38 @@ bool EventScheduler::RegisterPeriodicEvent(
     periodic_event.is_active = true;
 
     events_[event_id] = periodic_event;
-    scheduled_events_.push({periodic_event.trigger_time, event_id});
+    wheel_.Schedule(event_id, periodic_event.trigger_time);
 
     return true;
 }
 
 std::vector<EventTriggerResult> EventScheduler::ProcessPendingEvents() {
+    // Tick duration feeds the global latency histogram; recording is
+    // lock-free through thread-local buffers.
+    static LatencyHistogram& tick_latency = PerformanceMonitor::GetInstance().GetHistogram(
+        PerformanceMonitor::HISTOGRAM_SCHEDULER_TICK);
+    const LatencyHistogram::ScopedRecord tick_timer(tick_latency);
+
     std::vector<EventTriggerResult> results;
     const auto now = std::chrono::steady_clock::now();
 
-    while (!scheduled_events_.empty() && scheduled_events_.top().first <= now) {
-        const int event_id = scheduled_events_.top().second;
-        scheduled_events_.pop();
+    std::vector<int> due;
+    wheel_.Advance(now, due);
 
+    for (const int event_id : due) {
         auto it = events_.find(event_id);
         if (it != events_.end() && it->second.is_active) {
-            EventTriggerResult result = ExecuteEvent(it->second, it->second.params);
-            results.push_back(result);
+            if ((use_shared_executor_ || !workers_.empty()) && it->second.is_heavy) {
+                // Heavy handlers run off-thread; the tick never waits.
+                DispatchAsync(it->second);
+            } else {
+                EventTriggerResult result = ExecuteEvent(it->second, it->second.params);
+                results.push_back(result);
+            }
 
             if (it->second.type == EventType::PERIODIC) {
                 it->second.trigger_time = now + std::chrono::milliseconds(it->second.repeat_interval_ms);
-                scheduled_events_.push({it->second.trigger_time, event_id});
+                wheel_.Schedule(event_id, it->second.trigger_time);
             }
         }
     }
@@ -122,6 +415,15 @@ bool EventScheduler::CancelEvent(int event_id) {
     return false;
 }
 
+StringId EventScheduler::GetEventNameId(int event_id) const {
+    auto it = events_.find(event_id);
+    return it != events_.end() ? it->second.name_id : kInvalidStringId;
+}
+
+const std::string& EventScheduler::EventNameOf(StringId name_id) const {
+    return event_names_.NameOf(name_id);
+}
+
 void EventScheduler::InitializeDefaultEvents() {
     InitializeStoryEvents();
     InitializeCombatEvents();
@@ -131,9 +433,9 @@ void EventScheduler::InitializeDefaultEvents() {
 void EventScheduler::InitializeStoryEvents() {
     GameEvent story_start;
     story_start.event_id = 1001;
-    story_start.event_name = "story_chapter_start";
+    story_start.name_id = event_names_.Intern("story_chapter_start");
     story_start.type = EventType::IMMEDIATE;
-    story_start.handler = [](const std::vector<int>& params) -> std::string {
+    story_start.handler = [](std::span<const int> params) -> std::string {
         std::ostringstream oss;
         oss << "{\"event\":\"story_start\",\"chapter\":" << (params.empty() ? 1 : params[0]) << "}";
         return oss.str();
@@ -146,9 +448,9 @@ void EventScheduler::InitializeStoryEvents() {
 void EventScheduler::InitializeCombatEvents() {
     GameEvent combat_victory;
     combat_victory.event_id = 2001;
-    combat_victory.event_name = "combat_victory";
+    combat_victory.name_id = event_names_.Intern("combat_victory");
     combat_victory.type = EventType::IMMEDIATE;
-    combat_victory.handler = [](const std::vector<int>& params) -> std::string {
+    combat_victory.handler = [](std::span<const int> params) -> std::string {
         const int exp_gained = params.empty() ? 50 : params[0];
         std::ostringstream oss;
         oss << "{\"event\":\"combat_victory\",\"exp_gained\":" << exp_gained << "}";
@@ -162,9 +464,9 @@ void EventScheduler::InitializeCombatEvents() {
 void EventScheduler::InitializeQuestEvents() {
     GameEvent quest_complete;
     quest_complete.event_id = 3001;
-    quest_complete.event_name = "quest_complete";
+    quest_complete.name_id = event_names_.Intern("quest_complete");
     quest_complete.type = EventType::IMMEDIATE;
-    quest_complete.handler = [](const std::vector<int>& params) -> std::string {
+    quest_complete.handler = [](std::span<const int> params) -> std::string {
         const int quest_id = params.empty() ? 0 : params[0];
         const int reward = params.size() > 1 ? params[1] : 100;
         std::ostringstream oss;
@@ -177,7 +479,7 @@ void EventScheduler::InitializeQuestEvents() {
     events_[quest_complete.event_id] = quest_complete;
 }
 
-EventTriggerResult EventScheduler::ExecuteEvent(const GameEvent& event, const std::vector<int>& params) {
+EventTriggerResult EventScheduler::ExecuteEvent(const GameEvent& event, std::span<const int> params) {
     EventTriggerResult result;
 
     try {
@@ -19,46 +19,6 @@ bool TryParseInt(const std::string& input, int& value) {
     }
 }
 
-bool EvaluateCondition(const std::string& expected, const std::string& actual) {
-    if (expected.rfind(">=", 0) == 0) {
-        int expected_value = 0;
-        int actual_value = 0;
-        return TryParseInt(expected.substr(2), expected_value) &&
-               TryParseInt(actual, actual_value) &&
-               actual_value >= expected_value;
-    }
-
-    if (expected.rfind("<=", 0) == 0) {
-        int expected_value = 0;
-        int actual_value = 0;
-        return TryParseInt(expected.substr(2), expected_value) &&
-               TryParseInt(actual, actual_value) &&
-               actual_value <= expected_value;
-    }
-
-    if (expected.rfind(">", 0) == 0) {
-        int expected_value = 0;
-        int actual_value = 0;
-        return TryParseInt(expected.substr(1), expected_value) &&
-               TryParseInt(actual, actual_value) &&
-               actual_value > expected_value;
-    }
-
-    if (expected.rfind("<", 0) == 0) {
-        int expected_value = 0;
-        int actual_value = 0;
-        return TryParseInt(expected.substr(1), expected_value) &&
-               TryParseInt(actual, actual_value) &&
-               actual_value < expected_value;
-    }
-
-    if (expected.rfind("==", 0) == 0) {
-        return actual == expected.substr(2);
-    }
-
-    return actual == expected;
-}
-
 } // namespace
 
 namespace strategy {
@@ -88,27 +48,142 @@ GameRules GameRuleManager::GetRulesByCategory(const std::string& category) {
 bool GameRuleManager::CheckRuleCondition(
     const std::string& rule_id,
     const std::unordered_map<std::string, std::string>& context) {
-    auto it = rules_.find(rule_id);
-    if (it == rules_.end() || !it->second.is_active) {
+    EnsureCompiled();
+
+    auto it = compiled_rules_.find(rule_id);
+    if (it == compiled_rules_.end() || !it->second.is_active) {
         return false;
     }
 
-    const GameRule& rule = it->second;
+    // Resolve the context into dense slots once: one hash lookup per
+    // context entry, with the numeric form parsed a single time.
+    std::fill(slot_text_.begin(), slot_text_.end(), nullptr);
+    std::fill(slot_is_number_.begin(), slot_is_number_.end(), static_cast<unsigned char>(0));
+    for (const auto& entry : context) {
+        auto slot_it = key_slot_of_.find(entry.first);
+        if (slot_it == key_slot_of_.end()) {
+            continue;
+        }
+        slot_text_[static_cast<std::size_t>(slot_it->second)] = &entry.second;
+        int parsed = 0;
+        if (TryParseInt(entry.second, parsed)) {
+            slot_number_[static_cast<std::size_t>(slot_it->second)] = parsed;
+            slot_is_number_[static_cast<std::size_t>(slot_it->second)] = 1;
+        }
+    }
 
-    for (const auto& condition : rule.conditions) {
-        auto context_it = context.find(condition.first);
-        if (context_it == context.end()) {
+    // Flat table walk: integer compares against pre-parsed thresholds.
+    const CompiledRule& rule = it->second;
+    for (std::size_t i = 0; i < rule.condition_count; ++i) {
+        const CompiledCondition& condition = compiled_conditions_[rule.first_condition + i];
+        const std::size_t slot = static_cast<std::size_t>(condition.key_slot);
+        if (slot_text_[slot] == nullptr) {
             return false;
         }
 
-        if (!EvaluateCondition(condition.second, context_it->second)) {
-            return false;
+        switch (condition.op) {
+            case CompiledOp::GreaterEqual:
+                if (!slot_is_number_[slot] || slot_number_[slot] < condition.threshold) {
+                    return false;
+                }
+                break;
+            case CompiledOp::LessEqual:
+                if (!slot_is_number_[slot] || slot_number_[slot] > condition.threshold) {
+                    return false;
+                }
+                break;
+            case CompiledOp::Greater:
+                if (!slot_is_number_[slot] || slot_number_[slot] <= condition.threshold) {
+                    return false;
+                }
+                break;
+            case CompiledOp::Less:
+                if (!slot_is_number_[slot] || slot_number_[slot] >= condition.threshold) {
+                    return false;
+                }
+                break;
+            case CompiledOp::EqualString:
+                if (*slot_text_[slot] != condition.expected) {
+                    return false;
+                }
+                break;
+            case CompiledOp::AlwaysFalse:
+                return false;
         }
     }
 
     return true;
 }
 
+void GameRuleManager::EnsureCompiled() {
+    if (!rules_dirty_) {
+        return;
+    }
+
+    key_slot_of_.clear();
+    compiled_conditions_.clear();
+    compiled_rules_.clear();
+
+    // Translates one textual condition into its compiled form, parsing
+    // the operator prefix and numeric threshold exactly once.
+    const auto compile_text = [](const std::string& expected, CompiledCondition& entry) {
+        struct OperatorPrefix {
+            const char* prefix;
+            std::size_t length;
+            CompiledOp op;
+        };
+        static constexpr OperatorPrefix NUMERIC_OPERATORS[] = {
+            {">=", 2, CompiledOp::GreaterEqual},
+            {"<=", 2, CompiledOp::LessEqual},
+            {">", 1, CompiledOp::Greater},
+            {"<", 1, CompiledOp::Less},
+        };
+
+        for (const OperatorPrefix& candidate : NUMERIC_OPERATORS) {
+            if (expected.rfind(candidate.prefix, 0) == 0) {
+                int threshold = 0;
+                if (TryParseInt(expected.substr(candidate.length), threshold)) {
+                    entry.op = candidate.op;
+                    entry.threshold = threshold;
+                } else {
+                    entry.op = CompiledOp::AlwaysFalse;
+                }
+                return;
+            }
+        }
+
+        entry.op = CompiledOp::EqualString;
+        entry.expected = expected.rfind("==", 0) == 0 ? expected.substr(2) : expected;
+    };
+
+    for (const auto& pair : rules_) {
+        CompiledRule compiled;
+        compiled.first_condition = compiled_conditions_.size();
+        compiled.is_active = pair.second.is_active;
+
+        for (const auto& condition : pair.second.conditions) {
+            auto slot_it = key_slot_of_.find(condition.first);
+            if (slot_it == key_slot_of_.end()) {
+                slot_it = key_slot_of_.emplace(condition.first, static_cast<int>(key_slot_of_.size())).first;
+            }
+
+            CompiledCondition entry;
+            entry.key_slot = slot_it->second;
+            compile_text(condition.second, entry);
+            compiled_conditions_.push_back(std::move(entry));
+        }
+
+        compiled.condition_count = compiled_conditions_.size() - compiled.first_condition;
+        compiled_rules_.emplace(pair.first, compiled);
+    }
+
+    slot_text_.assign(key_slot_of_.size(), nullptr);
+    slot_number_.assign(key_slot_of_.size(), 0);
+    slot_is_number_.assign(key_slot_of_.size(), 0);
+
+    rules_dirty_ = false;
+}
+
 std::unordered_map<std::string, std::string> GameRuleManager::ApplyRuleEffect(const std::string& rule_id) {
     auto it = rules_.find(rule_id);
     if (it == rules_.end() || !it->second.is_active) {
@@ -120,6 +195,7 @@ std::unordered_map<std::string, std::string> GameRuleManager::ApplyRuleEffect(co
 
 bool GameRuleManager::AddRule(const GameRule& rule) {
     rules_[rule.rule_id] = rule;
+    rules_dirty_ = true;
     return true;
 }
 
@@ -130,6 +206,7 @@ bool GameRuleManager::UpdateRuleStatus(const std::string& rule_id, bool is_activ
     }
 
     it->second.is_active = is_active;
+    rules_dirty_ = true;
     return true;
 }
 
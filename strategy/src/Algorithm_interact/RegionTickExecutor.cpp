@@ -0,0 +1,204 @@
+/*
+ * File: RegionTickExecutor.cpp
+ * Description: Parallel per-region world ticking with a cross-region mailbox.
+ */
+#include "Algorithm_interact/RegionTickExecutor.h"
+
+#include <algorithm>
+#include <unordered_map>
+#include <utility>
+
+namespace strategy {
+
+RegionTickExecutor::RegionTickExecutor(std::size_t worker_count) {
+    const std::size_t count = std::max<std::size_t>(1, worker_count);
+    workers_.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        workers_.emplace_back(&RegionTickExecutor::WorkerLoop, this);
+    }
+}
+
+RegionTickExecutor::~RegionTickExecutor() {
+    {
+        std::lock_guard<std::mutex> lock(task_mutex_);
+        stop_workers_ = true;
+    }
+    task_condition_.notify_all();
+    for (std::thread& worker : workers_) {
+        worker.join();
+    }
+}
+
+void RegionTickExecutor::SetTickHandler(RegionTickFn handler) {
+    tick_handler_ = std::move(handler);
+}
+
+void RegionTickExecutor::AssignEntity(int entity_id, int region_id) {
+    // Entity lists are only touched at tick boundaries (ApplyPendingMoves),
+    // so a handler reassigning entities mid-tick — its own included —
+    // never has to take another region's lock.
+    std::lock_guard<std::mutex> lock(registry_mutex_);
+    int from_region = -1;
+    auto it = entity_regions_.find(entity_id);
+    if (it != entity_regions_.end()) {
+        if (it->second == region_id) {
+            return;
+        }
+        from_region = it->second;
+    }
+    Region& region = regions_[region_id];
+    region.id = region_id;
+    entity_regions_[entity_id] = region_id;
+    pending_moves_.push_back(PendingMove{entity_id, from_region, region_id});
+}
+
+void RegionTickExecutor::RemoveEntity(int entity_id) {
+    std::lock_guard<std::mutex> lock(registry_mutex_);
+    auto it = entity_regions_.find(entity_id);
+    if (it == entity_regions_.end()) {
+        return;
+    }
+    pending_moves_.push_back(PendingMove{entity_id, it->second, -1});
+    entity_regions_.erase(it);
+}
+
+int RegionTickExecutor::RegionOf(int entity_id) const {
+    std::lock_guard<std::mutex> lock(registry_mutex_);
+    auto it = entity_regions_.find(entity_id);
+    return it == entity_regions_.end() ? -1 : it->second;
+}
+
+std::size_t RegionTickExecutor::TickAll() {
+    ApplyPendingMoves();
+
+    // Snapshot the region set; regions are never destroyed, so the
+    // pointers stay valid without the registry lock.
+    std::unordered_map<int, Region*> region_index;
+    std::vector<Region*> to_tick;
+    {
+        std::lock_guard<std::mutex> lock(registry_mutex_);
+        region_index.reserve(regions_.size());
+        to_tick.reserve(regions_.size());
+        for (auto& entry : regions_) {
+            region_index.emplace(entry.first, &entry.second);
+            to_tick.push_back(&entry.second);
+        }
+    }
+    if (to_tick.empty()) {
+        return 0;
+    }
+
+    // Parallel phase: one task per region, wait for the pool to drain.
+    {
+        std::lock_guard<std::mutex> lock(task_mutex_);
+        for (Region* region : to_tick) {
+            task_queue_.push_back(region);
+        }
+        tasks_in_flight_ += to_tick.size();
+    }
+    task_condition_.notify_all();
+    {
+        std::unique_lock<std::mutex> lock(task_mutex_);
+        done_condition_.wait(lock, [this] {
+            return tasks_in_flight_ == 0;
+        });
+    }
+
+    // Routing phase: drain every outbox into the target inboxes, so the
+    // messages arrive with the next tick's context.
+    std::size_t routed = 0;
+    std::size_t dropped = 0;
+    for (Region* region : to_tick) {
+        std::vector<RegionMessage> outgoing;
+        {
+            std::lock_guard<std::mutex> lock(region->mutex);
+            outgoing.swap(region->outbox);
+        }
+        for (RegionMessage& message : outgoing) {
+            auto it = region_index.find(message.to_region);
+            if (it == region_index.end()) {
+                ++dropped;
+                continue;
+            }
+            std::lock_guard<std::mutex> lock(it->second->mutex);
+            it->second->inbox.push_back(std::move(message));
+            ++routed;
+        }
+    }
+    {
+        std::lock_guard<std::mutex> lock(registry_mutex_);
+        messages_routed_ += routed;
+        messages_dropped_ += dropped;
+    }
+
+    return to_tick.size();
+}
+
+RegionTickExecutor::Stats RegionTickExecutor::GetStats() const {
+    std::lock_guard<std::mutex> lock(registry_mutex_);
+    Stats stats;
+    stats.regions = regions_.size();
+    stats.entities = entity_regions_.size();
+    stats.messages_routed = messages_routed_;
+    stats.messages_dropped = messages_dropped_;
+    return stats;
+}
+
+void RegionTickExecutor::ApplyPendingMoves() {
+    // Runs with no worker active; the registry lock keeps the region map
+    // stable against concurrent AssignEntity calls while moves land.
+    std::lock_guard<std::mutex> registry_lock(registry_mutex_);
+    std::vector<PendingMove> moves;
+    moves.swap(pending_moves_);
+    for (const PendingMove& move : moves) {
+        if (move.from_region >= 0) {
+            Region& from = regions_.at(move.from_region);
+            std::lock_guard<std::mutex> lock(from.mutex);
+            from.entities.erase(
+                std::remove(from.entities.begin(), from.entities.end(), move.entity_id),
+                from.entities.end());
+        }
+        if (move.to_region >= 0) {
+            Region& to = regions_.at(move.to_region);
+            std::lock_guard<std::mutex> lock(to.mutex);
+            to.entities.push_back(move.entity_id);
+        }
+    }
+}
+
+void RegionTickExecutor::WorkerLoop() {
+    while (true) {
+        Region* region = nullptr;
+        {
+            std::unique_lock<std::mutex> lock(task_mutex_);
+            task_condition_.wait(lock, [this] {
+                return stop_workers_ || !task_queue_.empty();
+            });
+            if (stop_workers_ && task_queue_.empty()) {
+                return;
+            }
+            region = task_queue_.back();
+            task_queue_.pop_back();
+        }
+
+        TickRegion(*region);
+
+        {
+            std::lock_guard<std::mutex> lock(task_mutex_);
+            --tasks_in_flight_;
+        }
+        done_condition_.notify_all();
+    }
+}
+
+void RegionTickExecutor::TickRegion(Region& region) {
+    std::lock_guard<std::mutex> lock(region.mutex);
+    if (tick_handler_) {
+        RegionTickContext context(region.id, region.entities, region.inbox, region.outbox);
+        tick_handler_(context);
+    }
+    // Inbox messages are delivered exactly once.
+    region.inbox.clear();
+}
+
+} // namespace strategy
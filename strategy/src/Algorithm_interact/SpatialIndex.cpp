@@ -0,0 +1,144 @@
+/*
+ * File: SpatialIndex.cpp
+ * Description: Uniform-grid spatial index implementation.
+ */
+
+#include "Algorithm_interact/SpatialIndex.h"
+
+#include <algorithm>
+#include <cmath>
+#include <mutex>
+
+namespace strategy {
+
+SpatialIndex::SpatialIndex(float cell_size)
+    : cell_size_(cell_size > 0.0f ? cell_size : DEFAULT_CELL_SIZE) {}
+
+std::int64_t SpatialIndex::PackCell(std::int32_t cx, std::int32_t cy) {
+    return (static_cast<std::int64_t>(cx) << 32) |
+           static_cast<std::int64_t>(static_cast<std::uint32_t>(cy));
+}
+
+std::int32_t SpatialIndex::CellCoord(float v) const {
+    return static_cast<std::int32_t>(std::floor(v / cell_size_));
+}
+
+void SpatialIndex::Upsert(int id, float x, float y) {
+    const std::unique_lock<std::shared_mutex> lock(mutex_);
+    const std::int64_t cell = PackCell(CellCoord(x), CellCoord(y));
+
+    auto it = entries_.find(id);
+    if (it != entries_.end()) {
+        if (it->second.cell != cell) {
+            RemoveFromCellLocked(it->second.cell, id);
+            cells_[cell].push_back(id);
+            it->second.cell = cell;
+        }
+        it->second.x = x;
+        it->second.y = y;
+        return;
+    }
+
+    entries_.emplace(id, Entry{x, y, cell});
+    cells_[cell].push_back(id);
+}
+
+void SpatialIndex::Remove(int id) {
+    const std::unique_lock<std::shared_mutex> lock(mutex_);
+    auto it = entries_.find(id);
+    if (it == entries_.end()) {
+        return;
+    }
+    RemoveFromCellLocked(it->second.cell, id);
+    entries_.erase(it);
+}
+
+bool SpatialIndex::GetPosition(int id, float& x, float& y) const {
+    const std::shared_lock<std::shared_mutex> lock(mutex_);
+    auto it = entries_.find(id);
+    if (it == entries_.end()) {
+        return false;
+    }
+    x = it->second.x;
+    y = it->second.y;
+    return true;
+}
+
+std::vector<int> SpatialIndex::QueryRadius(float x, float y, float radius) const {
+    std::vector<int> result;
+    if (radius < 0.0f) {
+        return result;
+    }
+    const std::shared_lock<std::shared_mutex> lock(mutex_);
+    CollectCircleLocked(x, y, radius, nullptr, result);
+    return result;
+}
+
+std::vector<int> SpatialIndex::QueryRadiusBatch(
+    const std::vector<std::pair<float, float>>& centers, float radius) const {
+    std::vector<int> result;
+    if (radius < 0.0f || centers.empty()) {
+        return result;
+    }
+    std::unordered_set<int> visited;
+    const std::shared_lock<std::shared_mutex> lock(mutex_);
+    for (const auto& [cx, cy] : centers) {
+        CollectCircleLocked(cx, cy, radius, &visited, result);
+    }
+    return result;
+}
+
+std::size_t SpatialIndex::Size() const {
+    const std::shared_lock<std::shared_mutex> lock(mutex_);
+    return entries_.size();
+}
+
+void SpatialIndex::RemoveFromCellLocked(std::int64_t cell, int id) {
+    auto cell_it = cells_.find(cell);
+    if (cell_it == cells_.end()) {
+        return;
+    }
+    std::vector<int>& ids = cell_it->second;
+    auto pos = std::find(ids.begin(), ids.end(), id);
+    if (pos != ids.end()) {
+        // Order within a cell is irrelevant: swap-erase keeps removal O(1).
+        *pos = ids.back();
+        ids.pop_back();
+    }
+    if (ids.empty()) {
+        cells_.erase(cell_it);
+    }
+}
+
+void SpatialIndex::CollectCircleLocked(float x, float y, float radius,
+                                       std::unordered_set<int>* visited,
+                                       std::vector<int>& out) const {
+    const float radius_sq = radius * radius;
+    const std::int32_t min_cx = CellCoord(x - radius);
+    const std::int32_t max_cx = CellCoord(x + radius);
+    const std::int32_t min_cy = CellCoord(y - radius);
+    const std::int32_t max_cy = CellCoord(y + radius);
+
+    for (std::int32_t cx = min_cx; cx <= max_cx; ++cx) {
+        for (std::int32_t cy = min_cy; cy <= max_cy; ++cy) {
+            auto cell_it = cells_.find(PackCell(cx, cy));
+            if (cell_it == cells_.end()) {
+                continue;
+            }
+            for (const int id : cell_it->second) {
+                const Entry& entry = entries_.at(id);
+                const float dx = entry.x - x;
+                const float dy = entry.y - y;
+                if (dx * dx + dy * dy > radius_sq) {
+                    continue;
+                }
+                if (visited != nullptr && !visited->insert(id).second) {
+                    continue;
+                }
+                out.push_back(id);
+            }
+        }
+    }
+}
+
+} // namespace strategy
@@ -6,12 +6,15 @@
 #include "Algorithm_interact/StrategyService.h"
 
 #include <algorithm>
+#include <chrono>
 #include <cstdlib>
 #include <exception>
 #include <regex>
+#include <span>
 #include <sstream>
 #include <string>
 #include <unordered_map>
+#include <utility>
 
 namespace {
 
@@ -165,7 +168,8 @@ bool ParseBoolEffectValue(const std::string& value) {
 
 std::unordered_map<std::string, std::string> BuildRuleContext(
     const strategy::WorldState& state,
-    const strategy::EventTriggerRequest& request) {
+    int event_id,
+    std::span<const int> params) {
     std::unordered_map<std::string, std::string> context;
 
     for (const auto& var : state.global_variables) {
@@ -176,28 +180,28 @@ std::unordered_map<std::string, std::string> BuildRuleContext(
         context["flag_" + flag.first] = flag.second ? "true" : "false";
     }
 
-    for (std::size_t i = 0; i < request.params.size(); ++i) {
-        context["param_" + std::to_string(i)] = std::to_string(request.params[i]);
+    for (std::size_t i = 0; i < params.size(); ++i) {
+        context["param_" + std::to_string(i)] = std::to_string(params[i]);
     }
 
-    if (request.event_id == 1001 && !request.params.empty()) {
-        context["player_level"] = std::to_string(request.params[0]);
-    } else if (request.event_id == 2001) {
-        context["player_health"] = request.params.empty() ? "100" : std::to_string(request.params[0]);
+    if (event_id == 1001 && !params.empty()) {
+        context["player_level"] = std::to_string(params[0]);
+    } else if (event_id == 2001) {
+        context["player_health"] = params.empty() ? "100" : std::to_string(params[0]);
         context["enemy_distance"] = "3";
-    } else if (request.event_id == 3001 && !request.params.empty()) {
-        const int killed = request.params.size() > 1 ? request.params[1] : request.params[0];
+    } else if (event_id == 3001 && !params.empty()) {
+        const int killed = params.size() > 1 ? params[1] : params[0];
         context["monsters_killed"] = std::to_string(killed);
     }
 
-    if (context.find("monsters_killed") == context.end() && !request.params.empty()) {
-        context["monsters_killed"] = std::to_string(request.params.back());
+    if (context.find("monsters_killed") == context.end() && !params.empty()) {
+        context["monsters_killed"] = std::to_string(params.back());
     }
-    if (context.find("player_level") == context.end() && !request.params.empty()) {
-        context["player_level"] = std::to_string(request.params[0]);
+    if (context.find("player_level") == context.end() && !params.empty()) {
+        context["player_level"] = std::to_string(params[0]);
     }
     if (context.find("player_health") == context.end()) {
-        context["player_health"] = request.params.empty() ? "100" : std::to_string(request.params[0]);
+        context["player_health"] = params.empty() ? "100" : std::to_string(params[0]);
     }
     if (context.find("enemy_distance") == context.end()) {
         context["enemy_distance"] = "3";
@@ -214,15 +218,58 @@ StrategyService::StrategyService()
     : rule_manager_(std::make_unique<GameRuleManager>()),
       world_engine_(std::make_unique<WorldStateEngine>()),
       event_scheduler_(std::make_unique<EventScheduler>()),
+      ai_tick_scheduler_(std::make_unique<AITickScheduler>()),
+      region_ticker_(std::make_unique<RegionTickExecutor>()),
+      event_archive_(std::make_unique<WorldEventArchive>()),
       event_rule_map_(LoadEventRuleMapFromEnv()),
       event_rule_versions_json_("[]"),
       event_rule_publish_history_json_("[]") {
 }
 
+void StrategyService::SetAIDecisionSink(AITickScheduler::DecisionBatchSink sink) {
+    ai_tick_scheduler_->SetSink(std::move(sink));
+}
+
+std::vector<int> StrategyService::FilterNPCsNeedingAIDecision(const std::vector<int>& npc_ids) {
+    std::vector<int> due;
+    due.reserve(npc_ids.size());
+
+    for (const int npc_id : npc_ids) {
+        const WorldStateEngine::QuantizedAIContext context =
+            world_engine_->GetQuantizedAIContext(npc_id);
+
+        auto it = last_ai_contexts_.find(npc_id);
+        if (it != last_ai_contexts_.end() &&
+            WorldStateEngine::AIContextsSimilar(it->second, context)) {
+            // Unchanged since the last decision was requested: the NPC
+            // can keep acting on it.
+            continue;
+        }
+
+        last_ai_contexts_[npc_id] = context;
+        due.push_back(npc_id);
+    }
+
+    return due;
+}
+
 WorldStateResult StrategyService::UpdateWorldState(const WorldStateUpdate& update) {
     WorldStateResult result;
 
     try {
+        // Delta path: apply O(changes) work, no JSON parsing involved.
+        if (!update.changes.empty()) {
+            if (world_engine_->ApplyDelta(update.changes, update.sequence)) {
+                result.success = true;
+                result.message = "World state delta applied";
+                event_scheduler_->Update();
+            } else {
+                result.success = false;
+                result.message = "World state delta rejected: stale sequence";
+            }
+            return result;
+        }
+
         UpdateEventRuleMapFromJson(update.world_state_json);
         UpdateEventRuleMetaFromJson(update.world_state_json);
         const bool success = world_engine_->UpdateWorldState(update.world_state_json);
@@ -243,12 +290,16 @@ WorldStateResult StrategyService::UpdateWorldState(const WorldStateUpdate& updat
 }
 
 EventTriggerResult StrategyService::TriggerEvent(const EventTriggerRequest& request) {
+    return TriggerEvent(request.event_id, request.params);
+}
+
+EventTriggerResult StrategyService::TriggerEvent(int event_id, std::span<const int> params) {
     EventTriggerResult result;
 
     try {
-        const std::string rule_id = ResolveRuleIdForEvent(request.event_id);
+        const std::string rule_id = ResolveRuleIdForEvent(event_id);
         const WorldState state = world_engine_->GetCurrentWorldState();
-        const auto rule_context = BuildRuleContext(state, request);
+        const auto rule_context = BuildRuleContext(state, event_id, params);
 
         const bool can_trigger = rule_manager_->CheckRuleCondition(rule_id, rule_context);
         if (!can_trigger) {
@@ -257,11 +308,29 @@ EventTriggerResult StrategyService::TriggerEvent(const EventTriggerRequest& requ
             return result;
         }
 
-        result = event_scheduler_->TriggerEvent(request.event_id, request.params);
+        // Forward through a pooled compact record: the scheduler reads
+        // the params in place instead of copying them once more.
+        const CompactEventRecord& record = event_scheduler_->AcquireRecord(event_id, params);
+        result = event_scheduler_->TriggerEvent(record);
+        event_scheduler_->ResetRecordPool();
         if (!result.triggered) {
             return result;
         }
 
+        // Events are the wake source for sleeping passive NPCs: every NPC
+        // the event touched gets a bounded burst of full-rate AI ticks.
+        for (const int npc_id : result.affected_npcs) {
+            ai_tick_scheduler_->WakeNPC(npc_id);
+        }
+
+        // Triggered history goes through the two-tier archive instead of
+        // accumulating in memory forever.
+        event_archive_->Record(
+            event_id,
+            std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::system_clock::now().time_since_epoch()).count(),
+            result.result_json);
+
         const auto effects = rule_manager_->ApplyRuleEffect(rule_id);
         for (const auto& effect : effects) {
             if (effect.first.rfind("global_", 0) == 0) {
@@ -333,6 +402,49 @@ GameState StrategyService::QueryGameState(const std::string& query_type) {
     return world_engine_->QueryGameState(query_type);
 }
 
+GameStateDelta StrategyService::QueryGameStateDelta(const std::string& query_type,
+                                                    std::uint64_t known_sequence) {
+    return world_engine_->QueryGameStateDelta(query_type, known_sequence);
+}
+
+int StrategyService::RegisterStateInterest(StateInterestFilter filter) {
+    std::lock_guard<std::mutex> lock(interest_mutex_);
+    const int subscription_id = next_interest_id_++;
+    interest_filters_.emplace(subscription_id, std::move(filter));
+    return subscription_id;
+}
+
+bool StrategyService::UpdateStateInterest(int subscription_id, StateInterestFilter filter) {
+    std::lock_guard<std::mutex> lock(interest_mutex_);
+    auto it = interest_filters_.find(subscription_id);
+    if (it == interest_filters_.end()) {
+        return false;
+    }
+    it->second = std::move(filter);
+    return true;
+}
+
+void StrategyService::UnregisterStateInterest(int subscription_id) {
+    std::lock_guard<std::mutex> lock(interest_mutex_);
+    interest_filters_.erase(subscription_id);
+}
+
+GameStateDelta StrategyService::PollStateInterest(int subscription_id,
+                                                  std::uint64_t known_sequence) {
+    StateInterestFilter filter;
+    {
+        std::lock_guard<std::mutex> lock(interest_mutex_);
+        auto it = interest_filters_.find(subscription_id);
+        if (it == interest_filters_.end()) {
+            // Unknown subscription: invalid reply, the caller re-registers.
+            return GameStateDelta{};
+        }
+        filter = it->second;
+    }
+
+    return world_engine_->QueryGameStateDelta(filter, known_sequence);
+}
+
 std::string StrategyService::SerializeEventRuleMapJson() const {
     std::ostringstream oss;
     oss << "{\"event_rule_map\":{";
@@ -0,0 +1,318 @@
+/*
+ * File: WorldEventArchive.cpp
+ * Description: Two-tier archive implementation for triggered world events.
+ */
+#include "Algorithm_interact/WorldEventArchive.h"
+
+#include <algorithm>
+#include <any>
+#include <cstdio>
+#include <iostream>
+#include <utility>
+
+namespace strategy {
+
+namespace {
+
+constexpr long long MS_PER_DAY = 24LL * 60LL * 60LL * 1000LL;
+
+// Range queries walk at most this many daily partitions; a wider range
+// is answered from its most recent days instead of scanning years.
+constexpr long long MAX_QUERY_PARTITIONS = 400;
+
+// Tolerant numeric extraction: drivers and fakes disagree on whether a
+// column comes back as int or long long.
+long long AnyToInt64(const std::any& value, long long fallback = 0) {
+    if (const auto* as_int64 = std::any_cast<long long>(&value)) {
+        return *as_int64;
+    }
+    if (const auto* as_int = std::any_cast<int>(&value)) {
+        return *as_int;
+    }
+    return fallback;
+}
+
+} // namespace
+
+WorldEventPartitionRepository::WorldEventPartitionRepository(
+    std::unique_ptr<IDatabaseConnection> connection)
+    : BaseRepository(std::move(connection)) {
+}
+
+std::string WorldEventPartitionRepository::PartitionNameFor(long long timestamp_ms) {
+    const std::chrono::sys_days day{
+        std::chrono::floor<std::chrono::days>(
+            std::chrono::sys_time<std::chrono::milliseconds>(
+                std::chrono::milliseconds(timestamp_ms)))};
+    const std::chrono::year_month_day ymd{day};
+
+    char name[32];
+    std::snprintf(name, sizeof(name), "world_events_p%04d%02d%02d",
+                  static_cast<int>(ymd.year()),
+                  static_cast<unsigned>(ymd.month()),
+                  static_cast<unsigned>(ymd.day()));
+    return std::string(name);
+}
+
+bool WorldEventPartitionRepository::EnsurePartition(const std::string& partition) {
+    if (ensured_partitions_.count(partition) != 0) {
+        return true;
+    }
+    auto created = TryExecuteUpdate(
+        "CREATE TABLE IF NOT EXISTS " + partition +
+        " (event_id INTEGER NOT NULL,"
+        " triggered_at_ms BIGINT NOT NULL,"
+        " result_json TEXT)");
+    if (!created) {
+        std::cerr << "WorldEventArchive: failed to create partition " << partition
+                  << ": " << created.Error().Message() << std::endl;
+        return false;
+    }
+    // Range scans within a partition filter on the trigger time.
+    (void)TryExecuteUpdate("CREATE INDEX IF NOT EXISTS idx_" + partition +
+                           "_time ON " + partition + " (triggered_at_ms)");
+    ensured_partitions_.insert(partition);
+    return true;
+}
+
+std::size_t WorldEventPartitionRepository::InsertEvents(
+    const std::vector<TriggeredEventRecord>& records) {
+    static const std::vector<std::string> kColumns = {
+        "event_id", "triggered_at_ms", "result_json"};
+
+    std::size_t written = 0;
+    std::size_t index = 0;
+    while (index < records.size()) {
+        // Contiguous run of records landing in the same daily partition;
+        // records arrive in trigger order, so runs are long in practice.
+        const std::string partition = PartitionNameFor(records[index].triggered_at_ms);
+        std::vector<std::vector<std::any>> rows;
+        while (index < records.size() &&
+               PartitionNameFor(records[index].triggered_at_ms) == partition) {
+            const TriggeredEventRecord& record = records[index];
+            rows.push_back({std::any(record.event_id),
+                            std::any(record.triggered_at_ms),
+                            std::any(record.result_json)});
+            ++index;
+        }
+
+        if (!EnsurePartition(partition)) {
+            return written;
+        }
+        try {
+            ExecuteBulkInsert(partition, kColumns, rows);
+        } catch (const std::exception& e) {
+            std::cerr << "WorldEventArchive: bulk insert into " << partition
+                      << " failed: " << e.what() << std::endl;
+            return written;
+        }
+        written += rows.size();
+    }
+    return written;
+}
+
+std::vector<TriggeredEventRecord> WorldEventPartitionRepository::QueryRange(
+    long long from_ms, long long to_ms, std::size_t limit) {
+    std::vector<TriggeredEventRecord> out;
+    if (to_ms < from_ms || limit == 0) {
+        return out;
+    }
+
+    long long first_day = from_ms / MS_PER_DAY;
+    const long long last_day = to_ms / MS_PER_DAY;
+    if (last_day - first_day + 1 > MAX_QUERY_PARTITIONS) {
+        first_day = last_day - MAX_QUERY_PARTITIONS + 1;
+    }
+
+    for (long long day = first_day; day <= last_day && out.size() < limit; ++day) {
+        const std::string partition = PartitionNameFor(day * MS_PER_DAY);
+        // A partition that was never created reads as empty; the Try
+        // channel keeps "table missing" off the exception path.
+        auto rows = TryExecuteQuery(
+            "SELECT event_id, triggered_at_ms, result_json FROM " + partition +
+            " WHERE triggered_at_ms >= ? AND triggered_at_ms <= ?"
+            " ORDER BY triggered_at_ms",
+            {std::any(from_ms), std::any(to_ms)});
+        if (!rows) {
+            continue;
+        }
+        for (const auto& row : rows.Value()) {
+            if (out.size() >= limit) {
+                break;
+            }
+            TriggeredEventRecord record;
+            if (const auto it = row.find("event_id"); it != row.end()) {
+                record.event_id = static_cast<int>(AnyToInt64(it->second));
+            }
+            if (const auto it = row.find("triggered_at_ms"); it != row.end()) {
+                record.triggered_at_ms = AnyToInt64(it->second);
+            }
+            if (const auto it = row.find("result_json"); it != row.end()) {
+                if (const auto* json = std::any_cast<std::string>(&it->second)) {
+                    record.result_json = *json;
+                }
+            }
+            out.push_back(std::move(record));
+        }
+    }
+    return out;
+}
+
+WorldEventArchive::WorldEventArchive(std::size_t hot_capacity)
+    : hot_capacity_(hot_capacity == 0 ? DEFAULT_HOT_CAPACITY : hot_capacity) {
+}
+
+WorldEventArchive::~WorldEventArchive() {
+    StopArchival();
+}
+
+void WorldEventArchive::AttachStorage(std::unique_ptr<IDatabaseConnection> connection) {
+    auto repository = std::make_unique<WorldEventPartitionRepository>(std::move(connection));
+    std::lock_guard<std::mutex> lock(storage_mutex_);
+    repository_ = std::move(repository);
+}
+
+void WorldEventArchive::Record(int event_id, long long triggered_at_ms,
+                               std::string result_json) {
+    std::lock_guard<std::mutex> lock(ring_mutex_);
+    hot_.push_back({event_id, triggered_at_ms, std::move(result_json)});
+    if (hot_.size() > hot_capacity_) {
+        // Evicted before archival: stage it for the next cold-tier pass
+        // instead of losing it. The staging buffer is capped too.
+        staged_.push_back(std::move(hot_.front()));
+        hot_.pop_front();
+        if (staged_.size() > hot_capacity_) {
+            staged_.pop_front();
+            ++dropped_count_;
+        }
+    }
+}
+
+std::size_t WorldEventArchive::ArchiveOlderThan(long long cutoff_ms) {
+    std::lock_guard<std::mutex> storage_lock(storage_mutex_);
+    if (!repository_) {
+        return 0;
+    }
+
+    std::vector<TriggeredEventRecord> batch;
+    {
+        std::lock_guard<std::mutex> lock(ring_mutex_);
+        batch.reserve(staged_.size());
+        while (!staged_.empty()) {
+            batch.push_back(std::move(staged_.front()));
+            staged_.pop_front();
+        }
+        // Triggers arrive in time order, so the ring's prefix is exactly
+        // the set of entries older than the cutoff.
+        while (!hot_.empty() && hot_.front().triggered_at_ms < cutoff_ms) {
+            batch.push_back(std::move(hot_.front()));
+            hot_.pop_front();
+        }
+    }
+    if (batch.empty()) {
+        return 0;
+    }
+
+    const std::size_t written = repository_->InsertEvents(batch);
+    if (written < batch.size()) {
+        // Re-stage the unwritten tail in order for the next pass.
+        std::lock_guard<std::mutex> lock(ring_mutex_);
+        staged_.insert(staged_.begin(),
+                       std::make_move_iterator(batch.begin() + written),
+                       std::make_move_iterator(batch.end()));
+        while (staged_.size() > hot_capacity_) {
+            staged_.pop_front();
+            ++dropped_count_;
+        }
+    }
+    return written;
+}
+
+std::vector<TriggeredEventRecord> WorldEventArchive::Query(long long from_ms,
+                                                           long long to_ms,
+                                                           std::size_t limit) {
+    std::vector<TriggeredEventRecord> out;
+    if (to_ms < from_ms || limit == 0) {
+        return out;
+    }
+
+    {
+        std::lock_guard<std::mutex> storage_lock(storage_mutex_);
+        if (repository_) {
+            out = repository_->QueryRange(from_ms, to_ms, limit);
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(ring_mutex_);
+        for (const auto* tier : {&staged_, &hot_}) {
+            for (const TriggeredEventRecord& record : *tier) {
+                if (record.triggered_at_ms >= from_ms && record.triggered_at_ms <= to_ms) {
+                    out.push_back(record);
+                }
+            }
+        }
+    }
+
+    // Cold rows are strictly older than anything still in memory, but a
+    // stable sort keeps the merged view ascending even around the seam.
+    std::stable_sort(out.begin(), out.end(),
+                     [](const TriggeredEventRecord& a, const TriggeredEventRecord& b) {
+                         return a.triggered_at_ms < b.triggered_at_ms;
+                     });
+    if (out.size() > limit) {
+        out.resize(limit);
+    }
+    return out;
+}
+
+void WorldEventArchive::StartArchival(std::chrono::seconds interval,
+                                      std::chrono::seconds window) {
+    StopArchival();
+    {
+        std::lock_guard<std::mutex> lock(worker_mutex_);
+        stop_worker_ = false;
+    }
+    worker_ = std::thread([this, interval, window]() { ArchivalLoop(interval, window); });
+}
+
+void WorldEventArchive::StopArchival() {
+    {
+        std::lock_guard<std::mutex> lock(worker_mutex_);
+        stop_worker_ = true;
+    }
+    worker_cv_.notify_all();
+    if (worker_.joinable()) {
+        worker_.join();
+    }
+}
+
+void WorldEventArchive::ArchivalLoop(std::chrono::seconds interval,
+                                     std::chrono::seconds window) {
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(worker_mutex_);
+            worker_cv_.wait_for(lock, interval, [this]() { return stop_worker_; });
+            if (stop_worker_) {
+                return;
+            }
+        }
+        const long long now_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+        const long long window_ms =
+            std::chrono::duration_cast<std::chrono::milliseconds>(window).count();
+        ArchiveOlderThan(now_ms - window_ms);
+    }
+}
+
+std::size_t WorldEventArchive::GetHotCount() const {
+    std::lock_guard<std::mutex> lock(ring_mutex_);
+    return hot_.size();
+}
+
+std::uint64_t WorldEventArchive::GetDroppedCount() const {
+    std::lock_guard<std::mutex> lock(ring_mutex_);
+    return dropped_count_;
+}
+
+} // namespace strategy
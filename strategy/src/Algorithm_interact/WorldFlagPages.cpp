@@ -0,0 +1,183 @@
+/*
+ * File: WorldFlagPages.cpp
+ * Description: Namespace-paged bitset storage implementation.
+ */
+#include "Algorithm_interact/WorldFlagPages.h"
+
+namespace strategy {
+
+std::string WorldFlagPages::NamespaceOf(const std::string& name) {
+    const std::size_t underscore = name.find('_');
+    if (underscore == std::string::npos) {
+        return std::string();
+    }
+    return name.substr(0, underscore + 1);
+}
+
+FlagHandle WorldFlagPages::Register(const std::string& name) {
+    std::lock_guard<std::mutex> lock(registry_mutex_);
+
+    auto existing = handles_.find(name);
+    if (existing != handles_.end()) {
+        return existing->second;
+    }
+
+    NamespaceCursor& cursor = cursors_[NamespaceOf(name)];
+    if (cursor.next_bit >= PAGE_FLAG_CAPACITY) {
+        // Current page full (or namespace new): chain a fresh page.
+        const std::uint32_t page_index = page_count_.load(std::memory_order_relaxed);
+        if (page_index >= MAX_PAGES) {
+            return FlagHandle{};
+        }
+        pages_[page_index] = std::make_unique<Page>(NamespaceOf(name));
+        // Publish after the slot is fully constructed; readers only
+        // reach the slot through a handle returned below.
+        page_count_.store(page_index + 1, std::memory_order_release);
+        cursor.page = page_index;
+        cursor.next_bit = 0;
+    }
+
+    const FlagHandle handle{cursor.page, cursor.next_bit++};
+    pages_[handle.page]->names.push_back(name);
+    handles_.emplace(name, handle);
+    return handle;
+}
+
+FlagHandle WorldFlagPages::Find(const std::string& name) const {
+    std::lock_guard<std::mutex> lock(registry_mutex_);
+    auto it = handles_.find(name);
+    return it != handles_.end() ? it->second : FlagHandle{};
+}
+
+const WorldFlagPages::Page* WorldFlagPages::PageAt(std::uint32_t page) const {
+    if (page >= page_count_.load(std::memory_order_acquire)) {
+        return nullptr;
+    }
+    return pages_[page].get();
+}
+
+WorldFlagPages::Page* WorldFlagPages::PageAt(std::uint32_t page) {
+    if (page >= page_count_.load(std::memory_order_acquire)) {
+        return nullptr;
+    }
+    return pages_[page].get();
+}
+
+bool WorldFlagPages::Test(FlagHandle handle) const {
+    const Page* page = handle.IsValid() ? PageAt(handle.page) : nullptr;
+    if (page == nullptr || handle.bit >= PAGE_FLAG_CAPACITY) {
+        return false;
+    }
+    const std::uint64_t word =
+        page->words[handle.bit >> 6].load(std::memory_order_acquire);
+    return (word & (1ULL << (handle.bit & 63))) != 0;
+}
+
+bool WorldFlagPages::Set(FlagHandle handle, bool value) {
+    Page* page = handle.IsValid() ? PageAt(handle.page) : nullptr;
+    if (page == nullptr || handle.bit >= PAGE_FLAG_CAPACITY) {
+        return false;
+    }
+    auto& word = page->words[handle.bit >> 6];
+    const std::uint64_t mask = 1ULL << (handle.bit & 63);
+    const std::uint64_t previous = value
+        ? word.fetch_or(mask, std::memory_order_acq_rel)
+        : word.fetch_and(~mask, std::memory_order_acq_rel);
+    const bool changed = ((previous & mask) != 0) != value;
+    if (changed) {
+        page->change_version.fetch_add(1, std::memory_order_release);
+    }
+    return changed;
+}
+
+bool WorldFlagPages::TestAll(std::span<const FlagHandle> handles) const {
+    for (const FlagHandle handle : handles) {
+        if (!Test(handle)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool WorldFlagPages::TestAny(std::span<const FlagHandle> handles) const {
+    for (const FlagHandle handle : handles) {
+        if (Test(handle)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+std::size_t WorldFlagPages::SetMany(std::span<const FlagHandle> handles, bool value) {
+    std::size_t changed = 0;
+    for (const FlagHandle handle : handles) {
+        if (Set(handle, value)) {
+            ++changed;
+        }
+    }
+    return changed;
+}
+
+std::uint32_t WorldFlagPages::PageCount() const {
+    return page_count_.load(std::memory_order_acquire);
+}
+
+const std::string& WorldFlagPages::PageNamespace(std::uint32_t page) const {
+    static const std::string kEmpty;
+    const Page* entry = PageAt(page);
+    return entry != nullptr ? entry->ns : kEmpty;
+}
+
+std::uint64_t WorldFlagPages::PageVersion(std::uint32_t page) const {
+    const Page* entry = PageAt(page);
+    return entry != nullptr ? entry->change_version.load(std::memory_order_acquire) : 0;
+}
+
+std::vector<std::uint32_t> WorldFlagPages::PagesChangedSince(
+    std::span<const std::uint64_t> known_versions) const {
+    std::vector<std::uint32_t> changed;
+    const std::uint32_t count = PageCount();
+    for (std::uint32_t page = 0; page < count; ++page) {
+        if (page >= known_versions.size() || PageVersion(page) != known_versions[page]) {
+            changed.push_back(page);
+        }
+    }
+    return changed;
+}
+
+void WorldFlagPages::ForEachFlag(
+    const std::function<void(const std::string&, bool)>& fn) const {
+    std::lock_guard<std::mutex> lock(registry_mutex_);
+    const std::uint32_t count = page_count_.load(std::memory_order_acquire);
+    for (std::uint32_t page_index = 0; page_index < count; ++page_index) {
+        const Page& page = *pages_[page_index];
+        for (std::uint32_t bit = 0; bit < page.names.size(); ++bit) {
+            const std::uint64_t word =
+                page.words[bit >> 6].load(std::memory_order_acquire);
+            fn(page.names[bit], (word & (1ULL << (bit & 63))) != 0);
+        }
+    }
+}
+
+void WorldFlagPages::Clear() {
+    const std::uint32_t count = PageCount();
+    for (std::uint32_t page_index = 0; page_index < count; ++page_index) {
+        Page& page = *pages_[page_index];
+        bool any_cleared = false;
+        for (auto& word : page.words) {
+            if (word.exchange(0, std::memory_order_acq_rel) != 0) {
+                any_cleared = true;
+            }
+        }
+        if (any_cleared) {
+            page.change_version.fetch_add(1, std::memory_order_release);
+        }
+    }
+}
+
+std::size_t WorldFlagPages::GetRegisteredCount() const {
+    std::lock_guard<std::mutex> lock(registry_mutex_);
+    return handles_.size();
+}
+
+} // namespace strategy
@@ -1,9 +1,17 @@
 ﻿#include "Algorithm_interact/WorldStateEngine.h"
 
+#include "serialization/BinaryCodec.h"
+
 #include <algorithm>
 #include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <mutex>
 #include <regex>
 #include <sstream>
+#include <type_traits>
 
 namespace {
 
@@ -95,22 +103,113 @@ bool TryExtractBool(const std::string& json, const std::string& key, bool& out_v
     return false;
 }
 
+// ---------------------------------------------------------------------------
+// Binary snapshot wire format: the shared serialization codec provides
+// the primitives (little-endian fixed-width fields, length-prefixed
+// strings); only the snapshot frame itself is defined here.
+// ---------------------------------------------------------------------------
+
+constexpr char kSnapshotMagic[4] = {'F', 'L', 'W', 'S'};
+constexpr std::uint16_t kSnapshotVersion = 1;
+
+using serialization::AppendPod;
+using serialization::AppendString;
+
 } // namespace
 
 namespace strategy {
 
+const std::string& RelationTypeName(RelationType type) {
+    static const std::array<std::string, 4> names = {
+        "neutral", "friend", "enemy", "ally"};
+    const auto index = static_cast<std::size_t>(type);
+    return names[index < names.size() ? index : 0];
+}
+
+RelationType RelationTypeFromName(const std::string& name) {
+    if (name == "friend") return RelationType::Friend;
+    if (name == "enemy") return RelationType::Enemy;
+    if (name == "ally") return RelationType::Ally;
+    return RelationType::Neutral;
+}
+
 WorldStateEngine::WorldStateEngine() {
     InitializeDefaultState();
 }
 
+WorldStateEngine::StateShard& WorldStateEngine::ShardFor(int key) {
+    return shards_[std::hash<int>{}(key) % STATE_SHARD_COUNT];
+}
+
+const WorldStateEngine::StateShard& WorldStateEngine::ShardFor(int key) const {
+    return shards_[std::hash<int>{}(key) % STATE_SHARD_COUNT];
+}
+
+WorldStateEngine::StateShard& WorldStateEngine::ShardForId(StringId key_id) {
+    // Interned ids are sequential, so the modulo alone spreads them.
+    return shards_[key_id % STATE_SHARD_COUNT];
+}
+
+const WorldStateEngine::StateShard& WorldStateEngine::ShardForId(StringId key_id) const {
+    return shards_[key_id % STATE_SHARD_COUNT];
+}
+
+void WorldStateEngine::TouchUpdateTime() {
+    last_update_time_.store(
+        std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::system_clock::now().time_since_epoch())
+            .count(),
+        std::memory_order_relaxed);
+    // The timestamp appears in rendered snapshots, so it retires them too.
+    BumpStateVersion();
+}
+
+WorldState WorldStateEngine::BuildSnapshot() const {
+    WorldState snapshot;
+
+    // Shards are locked shared one at a time; the snapshot is therefore
+    // consistent per shard, not across shards, which is sufficient for
+    // query/serialization traffic.
+    for (const auto& shard : shards_) {
+        std::shared_lock<std::shared_mutex> lock(shard.mutex);
+        // Snapshot consumers keep the legacy composite key and string
+        // fields; edges are materialized out of the slab here.
+        for (const auto& head : shard.relation_heads) {
+            for (int index = head.second; index >= 0;
+                 index = shard.relation_slab[static_cast<std::size_t>(index)].next_edge) {
+                const RelationEdge& edge = shard.relation_slab[static_cast<std::size_t>(index)];
+                snapshot.npc_relations[head.first * 10000 + edge.target_id] =
+                    MaterializeRelation(head.first, edge);
+            }
+        }
+        for (const auto& entry : shard.global_variables) {
+            snapshot.global_variables[key_interner_.NameOf(entry.first)] = entry.second;
+        }
+    }
+
+    // Flags live in the paged bitsets, not the shards; materialize them
+    // back into the name-keyed snapshot shape.
+    flag_pages_.ForEachFlag([&snapshot](const std::string& name, bool value) {
+        snapshot.world_flags[name] = value;
+    });
+
+    {
+        std::shared_lock<std::shared_mutex> lock(events_mutex_);
+        snapshot.active_events = active_events_;
+    }
+    snapshot.last_update_time = last_update_time_.load(std::memory_order_relaxed);
+
+    return snapshot;
+}
+
 bool WorldStateEngine::UpdateWorldState(const std::string& world_state_json) {
     try {
-        const bool success = DeserializeWorldState(world_state_json);
+        // Binary snapshots are routed by magic; everything else is JSON.
+        const bool success = IsBinarySnapshot(world_state_json)
+            ? LoadBinarySnapshot(world_state_json)
+            : DeserializeWorldState(world_state_json);
         if (success) {
-            current_state_.last_update_time =
-                std::chrono::duration_cast<std::chrono::milliseconds>(
-                    std::chrono::system_clock::now().time_since_epoch())
-                    .count();
+            TouchUpdateTime();
         }
         return success;
     } catch (const std::exception&) {
@@ -118,65 +217,547 @@ bool WorldStateEngine::UpdateWorldState(const std::string& world_state_json) {
     }
 }
 
+bool WorldStateEngine::ApplyDelta(const std::vector<StateChange>& changes,
+                                  std::uint64_t sequence) {
+    // Claim the sequence number first; losing the race to a newer delta
+    // means this one is stale and must not be applied.
+    std::uint64_t expected = applied_sequence_.load(std::memory_order_relaxed);
+    do {
+        if (sequence <= expected) {
+            return false;
+        }
+    } while (!applied_sequence_.compare_exchange_weak(expected, sequence,
+                                                      std::memory_order_relaxed));
+
+    for (const auto& change : changes) {
+        if (change.is_flag) {
+            SetWorldFlag(change.key, change.bool_value);
+        } else {
+            SetGlobalVariable(change.key, change.int_value);
+        }
+    }
+
+    TouchUpdateTime();
+    return true;
+}
+
+std::uint64_t WorldStateEngine::GetAppliedSequence() const {
+    return applied_sequence_.load(std::memory_order_relaxed);
+}
+
+void WorldStateEngine::BumpStateVersion() {
+    state_version_.fetch_add(1, std::memory_order_release);
+}
+
+std::uint64_t WorldStateEngine::GetStateVersion() const {
+    return state_version_.load(std::memory_order_acquire);
+}
+
+std::shared_ptr<const WorldStateEngine::PublishedSnapshot>
+WorldStateEngine::AcquireSnapshot() const {
+    // Read the version before building: a write racing the build makes
+    // the published snapshot one version old, so the next query rebuilds
+    // instead of serving it as current.
+    const std::uint64_t version = state_version_.load(std::memory_order_acquire);
+
+    {
+        std::lock_guard<std::mutex> lock(snapshot_mutex_);
+        if (published_snapshot_ && published_snapshot_->version == version) {
+            return published_snapshot_;
+        }
+    }
+
+    // Build and render outside the slot mutex; concurrent first readers
+    // may build duplicates, but the newest version wins publication.
+    auto fresh = std::make_shared<PublishedSnapshot>();
+    fresh->version = version;
+    fresh->state = BuildSnapshot();
+    fresh->state_json = SerializeWorldState(fresh->state);
+
+    std::lock_guard<std::mutex> lock(snapshot_mutex_);
+    if (!published_snapshot_ || published_snapshot_->version < version) {
+        published_snapshot_ = fresh;
+    }
+    return fresh;
+}
+
+void WorldStateEngine::RecordChange(StateChange change) {
+    BumpStateVersion();
+    std::lock_guard<std::mutex> lock(journal_mutex_);
+    ++change_sequence_;
+    journal_.push_back(JournalEntry{change_sequence_, std::move(change)});
+    if (journal_.size() > JOURNAL_CAPACITY) {
+        journal_.pop_front();
+    }
+    journal_floor_ = journal_.front().sequence - 1;
+}
+
+void WorldStateEngine::InvalidateJournal() {
+    BumpStateVersion();
+    // Bump the sequence so clients notice something changed, and move the
+    // floor past it so any sequence gap resolves to a full resync.
+    std::lock_guard<std::mutex> lock(journal_mutex_);
+    ++change_sequence_;
+    journal_.clear();
+    journal_floor_ = change_sequence_;
+}
+
+std::uint64_t WorldStateEngine::GetChangeSequence() const {
+    std::lock_guard<std::mutex> lock(journal_mutex_);
+    return change_sequence_;
+}
+
+GameStateDelta WorldStateEngine::QueryGameStateDelta(const std::string& query_type,
+                                                     std::uint64_t known_sequence) {
+    GameStateDelta result;
+
+    {
+        std::lock_guard<std::mutex> lock(journal_mutex_);
+        result.sequence = change_sequence_;
+
+        if (known_sequence == change_sequence_) {
+            result.up_to_date = true;
+            return result;
+        }
+
+        if (known_sequence >= journal_floor_ && known_sequence < change_sequence_) {
+            result.delta_valid = true;
+            for (const auto& entry : journal_) {
+                if (entry.sequence > known_sequence) {
+                    result.changes.push_back(entry.change);
+                }
+            }
+            return result;
+        }
+    }
+
+    // No baseline, journal trimmed past the client's sequence, or the
+    // client is ahead of a restarted engine: full resync.
+    result.full = QueryGameState(query_type);
+    return result;
+}
+
+bool WorldStateEngine::MatchesKey(const StateInterestFilter& filter, const std::string& key) {
+    for (const auto& exact : filter.keys) {
+        if (key == exact) {
+            return true;
+        }
+    }
+    for (const auto& prefix : filter.key_prefixes) {
+        if (key.compare(0, prefix.size(), prefix) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+GameStateDelta WorldStateEngine::QueryGameStateDelta(const StateInterestFilter& filter,
+                                                     std::uint64_t known_sequence) {
+    GameStateDelta result;
+
+    {
+        std::lock_guard<std::mutex> lock(journal_mutex_);
+        result.sequence = change_sequence_;
+
+        if (known_sequence == change_sequence_) {
+            result.up_to_date = true;
+            return result;
+        }
+
+        if (known_sequence >= journal_floor_ && known_sequence < change_sequence_) {
+            // Drop non-matching changes on the server: the subscriber's
+            // bandwidth and parse cost scale with its interest set. A gap
+            // with no matching change still advances the sequence.
+            for (const auto& entry : journal_) {
+                if (entry.sequence > known_sequence && MatchesKey(filter, entry.change.key)) {
+                    result.changes.push_back(entry.change);
+                }
+            }
+            if (result.changes.empty()) {
+                result.up_to_date = true;
+            } else {
+                result.delta_valid = true;
+            }
+            return result;
+        }
+    }
+
+    result.full = QueryGameStateFiltered(filter);
+    return result;
+}
+
+GameState WorldStateEngine::QueryGameStateFiltered(const StateInterestFilter& filter) {
+    const std::shared_ptr<const PublishedSnapshot> snapshot = AcquireSnapshot();
+
+    GameState result;
+    result.is_valid = true;
+
+    WorldState& filtered = result.world_state;
+    filtered.last_update_time = snapshot->state.last_update_time;
+    filtered.active_events = snapshot->state.active_events;
+
+    for (const auto& entry : snapshot->state.global_variables) {
+        if (MatchesKey(filter, entry.first)) {
+            filtered.global_variables.insert(entry);
+        }
+    }
+    for (const auto& entry : snapshot->state.world_flags) {
+        if (MatchesKey(filter, entry.first)) {
+            filtered.world_flags.insert(entry);
+        }
+    }
+
+    for (const auto& entry : snapshot->state.npc_relations) {
+        const NPCRelation& relation = entry.second;
+        bool interested = std::find(filter.entity_ids.begin(), filter.entity_ids.end(),
+                                    relation.npc_id) != filter.entity_ids.end();
+        if (!interested && filter.has_region) {
+            float x = 0.0f;
+            float y = 0.0f;
+            if (npc_positions_.GetPosition(relation.npc_id, x, y)) {
+                interested = x >= filter.region_min_x && x <= filter.region_max_x &&
+                             y >= filter.region_min_y && y <= filter.region_max_y;
+            }
+        }
+        if (interested) {
+            filtered.npc_relations.insert(entry);
+        }
+    }
+
+    // Rendered from the filtered state, so resync payloads stay
+    // proportional to the subscriber's view rather than world size.
+    result.state_json = SerializeWorldState(filtered);
+    return result;
+}
+
+bool WorldStateEngine::IsBinarySnapshot(const std::string& data) {
+    return data.size() >= sizeof(kSnapshotMagic) &&
+           std::memcmp(data.data(), kSnapshotMagic, sizeof(kSnapshotMagic)) == 0;
+}
+
+std::string WorldStateEngine::SerializeBinarySnapshot() const {
+    const WorldState snapshot = BuildSnapshot();
+
+    std::string out;
+    out.append(kSnapshotMagic, sizeof(kSnapshotMagic));
+    AppendPod(out, kSnapshotVersion);
+    AppendPod(out, static_cast<std::int64_t>(snapshot.last_update_time));
+
+    AppendPod(out, static_cast<std::uint32_t>(snapshot.global_variables.size()));
+    for (const auto& entry : snapshot.global_variables) {
+        AppendString(out, entry.first);
+        AppendPod(out, static_cast<std::int32_t>(entry.second));
+    }
+
+    AppendPod(out, static_cast<std::uint32_t>(snapshot.world_flags.size()));
+    for (const auto& entry : snapshot.world_flags) {
+        AppendString(out, entry.first);
+        AppendPod(out, static_cast<std::uint8_t>(entry.second ? 1 : 0));
+    }
+
+    AppendPod(out, static_cast<std::uint32_t>(snapshot.npc_relations.size()));
+    for (const auto& entry : snapshot.npc_relations) {
+        AppendPod(out, static_cast<std::int32_t>(entry.first));
+        AppendPod(out, static_cast<std::int32_t>(entry.second.npc_id));
+        AppendPod(out, static_cast<std::int32_t>(entry.second.target_id));
+        AppendPod(out, static_cast<std::int32_t>(entry.second.trust_level));
+        AppendString(out, entry.second.relation_type);
+        AppendPod(out, static_cast<std::uint32_t>(entry.second.shared_history.size()));
+        for (const auto& history : entry.second.shared_history) {
+            AppendString(out, history);
+        }
+    }
+
+    AppendPod(out, static_cast<std::uint32_t>(snapshot.active_events.size()));
+    for (const auto& event : snapshot.active_events) {
+        AppendString(out, event);
+    }
+
+    return out;
+}
+
+bool WorldStateEngine::LoadBinarySnapshot(const std::string& data) {
+    if (!IsBinarySnapshot(data)) {
+        return false;
+    }
+
+    serialization::ByteReader reader(data);
+    char magic[sizeof(kSnapshotMagic)];
+    std::uint16_t version = 0;
+    std::int64_t update_time = 0;
+    if (!reader.ReadPod(magic) || !reader.ReadPod(version) || !reader.ReadPod(update_time)) {
+        return false;
+    }
+    if (version != kSnapshotVersion) {
+        return false;
+    }
+
+    // Decode fully into a staging state before touching live shards, so a
+    // truncated payload never leaves the engine half-replaced.
+    WorldState staged;
+    staged.last_update_time = update_time;
+
+    std::uint32_t count = 0;
+    if (!reader.ReadPod(count)) {
+        return false;
+    }
+    for (std::uint32_t i = 0; i < count; ++i) {
+        std::string name;
+        std::int32_t value = 0;
+        if (!reader.ReadString(name) || !reader.ReadPod(value)) {
+            return false;
+        }
+        staged.global_variables[name] = value;
+    }
+
+    if (!reader.ReadPod(count)) {
+        return false;
+    }
+    for (std::uint32_t i = 0; i < count; ++i) {
+        std::string name;
+        std::uint8_t value = 0;
+        if (!reader.ReadString(name) || !reader.ReadPod(value)) {
+            return false;
+        }
+        staged.world_flags[name] = (value != 0);
+    }
+
+    if (!reader.ReadPod(count)) {
+        return false;
+    }
+    for (std::uint32_t i = 0; i < count; ++i) {
+        std::int32_t key = 0;
+        NPCRelation relation;
+        std::uint32_t history_count = 0;
+        if (!reader.ReadPod(key) || !reader.ReadPod(relation.npc_id) ||
+            !reader.ReadPod(relation.target_id) || !reader.ReadPod(relation.trust_level) ||
+            !reader.ReadString(relation.relation_type) || !reader.ReadPod(history_count)) {
+            return false;
+        }
+        relation.shared_history.resize(history_count);
+        for (auto& history : relation.shared_history) {
+            if (!reader.ReadString(history)) {
+                return false;
+            }
+        }
+        staged.npc_relations[key] = std::move(relation);
+    }
+
+    if (!reader.ReadPod(count)) {
+        return false;
+    }
+    std::vector<std::string> staged_events(count);
+    for (auto& event : staged_events) {
+        if (!reader.ReadString(event)) {
+            return false;
+        }
+    }
+
+    // Distribute the staged state into per-shard maps, then swap each
+    // shard under its own lock.
+    std::array<StateShard, STATE_SHARD_COUNT> staging;
+    for (auto& entry : staged.npc_relations) {
+        const NPCRelation& relation = entry.second;
+        StateShard& target =
+            staging[std::hash<int>{}(relation.npc_id) % STATE_SHARD_COUNT];
+        RelationEdge& edge = EdgeFor(target, relation.npc_id, relation.target_id);
+        edge.type = RelationTypeFromName(relation.relation_type);
+        edge.trust_level = static_cast<std::int16_t>(
+            std::max(-100, std::min(100, relation.trust_level)));
+        // The ring keeps the newest RELATION_HISTORY_CAPACITY entries;
+        // longer serialized histories are truncated from the front.
+        for (const auto& history : relation.shared_history) {
+            PushHistory(edge, history_interner_.Intern(history));
+        }
+    }
+    for (const auto& entry : staged.global_variables) {
+        const StringId key_id = key_interner_.Intern(entry.first);
+        staging[key_id % STATE_SHARD_COUNT].global_variables[key_id] = entry.second;
+    }
+    for (std::size_t i = 0; i < STATE_SHARD_COUNT; ++i) {
+        std::unique_lock<std::shared_mutex> lock(shards_[i].mutex);
+        shards_[i].relation_slab.swap(staging[i].relation_slab);
+        shards_[i].relation_heads.swap(staging[i].relation_heads);
+        shards_[i].global_variables.swap(staging[i].global_variables);
+    }
+
+    // Flags bypass the shard swap: reset the pages (registrations are
+    // kept) and replay the staged values bit by bit.
+    flag_pages_.Clear();
+    for (const auto& entry : staged.world_flags) {
+        flag_pages_.Set(EnsureFlagHandle(key_interner_.Intern(entry.first)), entry.second);
+    }
+    {
+        std::unique_lock<std::shared_mutex> lock(events_mutex_);
+        active_events_ = std::move(staged_events);
+    }
+    last_update_time_.store(staged.last_update_time, std::memory_order_relaxed);
+
+    // The swap bypassed the per-key setters, so the journal no longer
+    // describes the live state.
+    InvalidateJournal();
+
+    return true;
+}
+
 WorldState WorldStateEngine::GetCurrentWorldState() const {
-    return current_state_;
+    return BuildSnapshot();
 }
 
 GameState WorldStateEngine::QueryGameState(const std::string& query_type) {
+    const std::shared_ptr<const PublishedSnapshot> snapshot = AcquireSnapshot();
+
     GameState result;
-    result.world_state = current_state_;
-    result.state_json = SerializeWorldState();
+    result.state_json = snapshot->state_json;
     result.is_valid = true;
 
     if (query_type == "npc_relations") {
-        WorldState filtered_state;
-        filtered_state.npc_relations = current_state_.npc_relations;
-        filtered_state.last_update_time = current_state_.last_update_time;
-        result.world_state = filtered_state;
+        result.world_state.npc_relations = snapshot->state.npc_relations;
+        result.world_state.last_update_time = snapshot->state.last_update_time;
     } else if (query_type == "global_vars") {
-        WorldState filtered_state;
-        filtered_state.global_variables = current_state_.global_variables;
-        filtered_state.last_update_time = current_state_.last_update_time;
-        result.world_state = filtered_state;
+        result.world_state.global_variables = snapshot->state.global_variables;
+        result.world_state.last_update_time = snapshot->state.last_update_time;
     } else if (query_type == "flags") {
-        WorldState filtered_state;
-        filtered_state.world_flags = current_state_.world_flags;
-        filtered_state.last_update_time = current_state_.last_update_time;
-        result.world_state = filtered_state;
+        result.world_state.world_flags = snapshot->state.world_flags;
+        result.world_state.last_update_time = snapshot->state.last_update_time;
+    } else {
+        result.world_state = snapshot->state;
     }
 
     return result;
 }
 
+const WorldStateEngine::RelationEdge* WorldStateEngine::FindEdge(
+    const StateShard& shard, int npc_id, int target_id) {
+    auto it = shard.relation_heads.find(npc_id);
+    if (it == shard.relation_heads.end()) {
+        return nullptr;
+    }
+    for (int index = it->second; index >= 0;
+         index = shard.relation_slab[static_cast<std::size_t>(index)].next_edge) {
+        const RelationEdge& edge = shard.relation_slab[static_cast<std::size_t>(index)];
+        if (edge.target_id == target_id) {
+            return &edge;
+        }
+    }
+    return nullptr;
+}
+
+WorldStateEngine::RelationEdge& WorldStateEngine::EdgeFor(
+    StateShard& shard, int npc_id, int target_id) {
+    auto [it, inserted] = shard.relation_heads.try_emplace(npc_id, -1);
+    if (!inserted) {
+        for (int index = it->second; index >= 0;
+             index = shard.relation_slab[static_cast<std::size_t>(index)].next_edge) {
+            RelationEdge& edge = shard.relation_slab[static_cast<std::size_t>(index)];
+            if (edge.target_id == target_id) {
+                return edge;
+            }
+        }
+    }
+
+    // New edge: prepend to the NPC's chain so insertion never walks it.
+    RelationEdge edge;
+    edge.target_id = target_id;
+    edge.next_edge = it->second;
+    shard.relation_slab.push_back(edge);
+    it->second = static_cast<int>(shard.relation_slab.size()) - 1;
+    return shard.relation_slab.back();
+}
+
+void WorldStateEngine::PushHistory(RelationEdge& edge, StringId event_id) {
+    if (edge.history_size < RELATION_HISTORY_CAPACITY) {
+        edge.history[(edge.history_head + edge.history_size) % RELATION_HISTORY_CAPACITY] =
+            event_id;
+        ++edge.history_size;
+    } else {
+        // Ring full: overwrite the oldest entry and advance the head.
+        edge.history[edge.history_head] = event_id;
+        edge.history_head =
+            static_cast<std::uint8_t>((edge.history_head + 1) % RELATION_HISTORY_CAPACITY);
+    }
+}
+
+NPCRelation WorldStateEngine::MaterializeRelation(int npc_id, const RelationEdge& edge) const {
+    NPCRelation relation;
+    relation.npc_id = npc_id;
+    relation.target_id = edge.target_id;
+    relation.relation_type = RelationTypeName(edge.type);
+    relation.trust_level = edge.trust_level;
+    relation.shared_history.reserve(edge.history_size);
+    for (std::uint8_t i = 0; i < edge.history_size; ++i) {
+        relation.shared_history.push_back(history_interner_.NameOf(
+            edge.history[(edge.history_head + i) % RELATION_HISTORY_CAPACITY]));
+    }
+    return relation;
+}
+
 bool WorldStateEngine::UpdateNPCRelation(
     int npc_id,
     int target_id,
     const std::string& relation_type,
     int trust_change) {
-    const int relation_key = npc_id * 10000 + target_id;
-
-    auto it = current_state_.npc_relations.find(relation_key);
-    if (it != current_state_.npc_relations.end()) {
-        it->second.relation_type = relation_type;
-        it->second.trust_level = std::max(-100, std::min(100, it->second.trust_level + trust_change));
-    } else {
-        NPCRelation new_relation;
-        new_relation.npc_id = npc_id;
-        new_relation.target_id = target_id;
-        new_relation.relation_type = relation_type;
-        new_relation.trust_level = trust_change;
-        current_state_.npc_relations[relation_key] = new_relation;
+    const RelationType type = RelationTypeFromName(relation_type);
+    StateShard& shard = ShardFor(npc_id);
+    {
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+        RelationEdge& edge = EdgeFor(shard, npc_id, target_id);
+        edge.type = type;
+        edge.trust_level = static_cast<std::int16_t>(
+            std::max(-100, std::min(100, edge.trust_level + trust_change)));
     }
 
+    // Relation changes are not journaled as StateChange entries, but they
+    // must still retire the published snapshot.
+    BumpStateVersion();
     return true;
 }
 
+std::size_t WorldStateEngine::UpdateNPCRelations(const std::vector<NPCRelationUpdate>& updates) {
+    if (updates.empty()) {
+        return 0;
+    }
+
+    // Intern history events before touching any shard lock, and group the
+    // batch by shard so each lock is taken once.
+    std::vector<StringId> event_ids(updates.size(), kInvalidStringId);
+    std::array<std::vector<std::size_t>, STATE_SHARD_COUNT> by_shard;
+    for (std::size_t i = 0; i < updates.size(); ++i) {
+        if (!updates[i].history_event.empty()) {
+            event_ids[i] = history_interner_.Intern(updates[i].history_event);
+        }
+        by_shard[std::hash<int>{}(updates[i].npc_id) % STATE_SHARD_COUNT].push_back(i);
+    }
+
+    for (std::size_t shard_index = 0; shard_index < STATE_SHARD_COUNT; ++shard_index) {
+        if (by_shard[shard_index].empty()) {
+            continue;
+        }
+        StateShard& shard = shards_[shard_index];
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+        for (std::size_t i : by_shard[shard_index]) {
+            const NPCRelationUpdate& update = updates[i];
+            RelationEdge& edge = EdgeFor(shard, update.npc_id, update.target_id);
+            edge.type = update.type;
+            edge.trust_level = static_cast<std::int16_t>(
+                std::max(-100, std::min(100, edge.trust_level + update.trust_change)));
+            if (event_ids[i] != kInvalidStringId) {
+                PushHistory(edge, event_ids[i]);
+            }
+        }
+    }
+
+    // One snapshot retirement for the whole batch.
+    BumpStateVersion();
+    return updates.size();
+}
+
 NPCRelation WorldStateEngine::GetNPCRelation(int npc_id, int target_id) const {
-    const int relation_key = npc_id * 10000 + target_id;
+    const StateShard& shard = ShardFor(npc_id);
+    std::shared_lock<std::shared_mutex> lock(shard.mutex);
 
-    auto it = current_state_.npc_relations.find(relation_key);
-    if (it != current_state_.npc_relations.end()) {
-        return it->second;
+    if (const RelationEdge* edge = FindEdge(shard, npc_id, target_id)) {
+        return MaterializeRelation(npc_id, *edge);
     }
 
     NPCRelation default_relation;
@@ -187,22 +768,146 @@ NPCRelation WorldStateEngine::GetNPCRelation(int npc_id, int target_id) const {
     return default_relation;
 }
 
+StringId WorldStateEngine::InternKey(const std::string& name) {
+    return key_interner_.Intern(name);
+}
+
 void WorldStateEngine::SetGlobalVariable(const std::string& var_name, int value) {
-    current_state_.global_variables[var_name] = value;
+    SetGlobalVariable(key_interner_.Intern(var_name), value);
 }
 
 int WorldStateEngine::GetGlobalVariable(const std::string& var_name) const {
-    auto it = current_state_.global_variables.find(var_name);
-    return (it != current_state_.global_variables.end()) ? it->second : 0;
+    const StringId key_id = key_interner_.Find(var_name);
+    return key_id != kInvalidStringId ? GetGlobalVariable(key_id) : 0;
 }
 
 void WorldStateEngine::SetWorldFlag(const std::string& flag_name, bool value) {
-    current_state_.world_flags[flag_name] = value;
+    SetWorldFlag(key_interner_.Intern(flag_name), value);
 }
 
 bool WorldStateEngine::GetWorldFlag(const std::string& flag_name) const {
-    auto it = current_state_.world_flags.find(flag_name);
-    return (it != current_state_.world_flags.end()) ? it->second : false;
+    const StringId key_id = key_interner_.Find(flag_name);
+    return key_id != kInvalidStringId ? GetWorldFlag(key_id) : false;
+}
+
+void WorldStateEngine::SetGlobalVariable(StringId key_id, int value) {
+    {
+        StateShard& shard = ShardForId(key_id);
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+        shard.global_variables[key_id] = value;
+    }
+
+    // The journal speaks names because deltas cross the process boundary.
+    StateChange change;
+    change.key = key_interner_.NameOf(key_id);
+    change.int_value = value;
+    RecordChange(std::move(change));
+}
+
+int WorldStateEngine::GetGlobalVariable(StringId key_id) const {
+    const StateShard& shard = ShardForId(key_id);
+    std::shared_lock<std::shared_mutex> lock(shard.mutex);
+    auto it = shard.global_variables.find(key_id);
+    return (it != shard.global_variables.end()) ? it->second : 0;
+}
+
+void WorldStateEngine::SetWorldFlag(StringId key_id, bool value) {
+    flag_pages_.Set(EnsureFlagHandle(key_id), value);
+
+    StateChange change;
+    change.key = key_interner_.NameOf(key_id);
+    change.is_flag = true;
+    change.bool_value = value;
+    RecordChange(std::move(change));
+}
+
+bool WorldStateEngine::GetWorldFlag(StringId key_id) const {
+    const FlagHandle handle = FindFlagHandle(key_id);
+    return handle.IsValid() && flag_pages_.Test(handle);
+}
+
+bool WorldStateEngine::TestWorldFlagsAll(std::span<const StringId> key_ids) const {
+    for (const StringId key_id : key_ids) {
+        const FlagHandle handle = FindFlagHandle(key_id);
+        if (!handle.IsValid() || !flag_pages_.Test(handle)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+std::size_t WorldStateEngine::SetWorldFlags(std::span<const StringId> key_ids, bool value) {
+    std::size_t changed = 0;
+    for (const StringId key_id : key_ids) {
+        if (flag_pages_.Set(EnsureFlagHandle(key_id), value)) {
+            ++changed;
+        }
+        StateChange change;
+        change.key = key_interner_.NameOf(key_id);
+        change.is_flag = true;
+        change.bool_value = value;
+        RecordChange(std::move(change));
+    }
+    return changed;
+}
+
+FlagHandle WorldStateEngine::EnsureFlagHandle(StringId key_id) {
+    {
+        std::lock_guard<std::mutex> lock(flag_handle_mutex_);
+        if (key_id < flag_handles_.size() && flag_handles_[key_id].IsValid()) {
+            return flag_handles_[key_id];
+        }
+    }
+    const FlagHandle handle = flag_pages_.Register(key_interner_.NameOf(key_id));
+    if (handle.IsValid()) {
+        std::lock_guard<std::mutex> lock(flag_handle_mutex_);
+        if (key_id >= flag_handles_.size()) {
+            flag_handles_.resize(key_id + 1);
+        }
+        flag_handles_[key_id] = handle;
+    }
+    return handle;
+}
+
+FlagHandle WorldStateEngine::FindFlagHandle(StringId key_id) const {
+    {
+        std::lock_guard<std::mutex> lock(flag_handle_mutex_);
+        if (key_id < flag_handles_.size() && flag_handles_[key_id].IsValid()) {
+            return flag_handles_[key_id];
+        }
+    }
+    // Slow path for ids set through another engine instance's state
+    // (snapshot replication): resolve by name and cache.
+    const FlagHandle handle = flag_pages_.Find(key_interner_.NameOf(key_id));
+    if (handle.IsValid()) {
+        std::lock_guard<std::mutex> lock(flag_handle_mutex_);
+        if (key_id >= flag_handles_.size()) {
+            flag_handles_.resize(key_id + 1);
+        }
+        flag_handles_[key_id] = handle;
+    }
+    return handle;
+}
+
+void WorldStateEngine::UpdateNPCPosition(int npc_id, float x, float y) {
+    npc_positions_.Upsert(npc_id, x, y);
+    position_version_.fetch_add(1, std::memory_order_release);
+}
+
+void WorldStateEngine::RemoveNPCPosition(int npc_id) {
+    npc_positions_.Remove(npc_id);
+    position_version_.fetch_add(1, std::memory_order_release);
+    std::lock_guard<std::mutex> lock(ai_context_mutex_);
+    ai_context_cache_.erase(npc_id);
+}
+
+std::vector<int> WorldStateEngine::QueryNPCsInRadius(float x, float y, float radius) const {
+    return npc_positions_.QueryRadius(x, y, radius);
+}
+
+std::vector<int> WorldStateEngine::QueryNPCsInRadius(
+    const std::vector<std::pair<float, float>>& centers, float radius) const {
+    return npc_positions_.QueryRadiusBatch(centers, radius);
 }
 
 std::vector<int> WorldStateEngine::GetAIDecisionContext(int npc_id) const {
@@ -210,8 +915,17 @@ std::vector<int> WorldStateEngine::GetAIDecisionContext(int npc_id) const {
 
     context.push_back(npc_id);
 
-    const NPCRelation player_relation = GetNPCRelation(npc_id, 1);
-    context.push_back(player_relation.trust_level);
+    // Trust toward the player straight from the edge slab — no string
+    // materialization on the per-NPC tick path.
+    int player_trust = 0;
+    {
+        const StateShard& shard = ShardFor(npc_id);
+        std::shared_lock<std::shared_mutex> lock(shard.mutex);
+        if (const RelationEdge* edge = FindEdge(shard, npc_id, 1)) {
+            player_trust = edge->trust_level;
+        }
+    }
+    context.push_back(player_trust);
 
     context.push_back(GetGlobalVariable("player_level"));
     context.push_back(GetGlobalVariable("combat_count"));
@@ -220,40 +934,93 @@ std::vector<int> WorldStateEngine::GetAIDecisionContext(int npc_id) const {
     context.push_back(GetWorldFlag("in_combat") ? 1 : 0);
     context.push_back(GetWorldFlag("tutorial_complete") ? 1 : 0);
 
+    // Crowding term from the spatial index: neighbours within
+    // AI_CONTEXT_RADIUS, self excluded. O(cells in range), not O(world);
+    // NPCs without a tracked position report zero.
+    int nearby = 0;
+    float x = 0.0f;
+    float y = 0.0f;
+    if (npc_positions_.GetPosition(npc_id, x, y)) {
+        const std::vector<int> neighbours =
+            npc_positions_.QueryRadius(x, y, AI_CONTEXT_RADIUS);
+        nearby = static_cast<int>(neighbours.size()) - 1;
+    }
+    context.push_back(nearby > 0 ? nearby : 0);
+
     return context;
 }
 
+WorldStateEngine::QuantizedAIContext
+WorldStateEngine::QuantizeAIContext(const std::vector<int>& context) {
+    QuantizedAIContext quantized{};
+    for (std::size_t i = 0; i < AI_CONTEXT_SLOTS && i < context.size(); ++i) {
+        quantized[i] = context[i];
+    }
+
+    // Bucket the noisy slots; id, level, progress, and flags stay exact
+    // because any change to them is meaningful on its own.
+    quantized[1] /= AI_TRUST_QUANT_STEP;
+    quantized[3] /= AI_COUNTER_QUANT_STEP;
+    quantized[7] /= AI_CROWD_QUANT_STEP;
+    return quantized;
+}
+
+WorldStateEngine::QuantizedAIContext
+WorldStateEngine::GetQuantizedAIContext(int npc_id) const {
+    // Read the versions before building, mirroring AcquireSnapshot: a
+    // write racing the build stamps the entry one version old, so the
+    // next call rebuilds instead of serving it as current.
+    const std::uint64_t state_version = state_version_.load(std::memory_order_acquire);
+    const std::uint64_t position_version = position_version_.load(std::memory_order_acquire);
+
+    {
+        std::lock_guard<std::mutex> lock(ai_context_mutex_);
+        auto it = ai_context_cache_.find(npc_id);
+        if (it != ai_context_cache_.end() &&
+            it->second.state_version == state_version &&
+            it->second.position_version == position_version) {
+            return it->second.quantized;
+        }
+    }
+
+    // Build outside the cache lock: the rebuild takes shard locks and
+    // must not serialize unrelated NPCs' cache hits behind them.
+    const QuantizedAIContext quantized = QuantizeAIContext(GetAIDecisionContext(npc_id));
+
+    {
+        std::lock_guard<std::mutex> lock(ai_context_mutex_);
+        ai_context_cache_[npc_id] = CachedAIContext{state_version, position_version, quantized};
+    }
+    return quantized;
+}
+
+bool WorldStateEngine::AIContextsSimilar(const QuantizedAIContext& a,
+                                         const QuantizedAIContext& b) {
+    return a == b;
+}
+
 void WorldStateEngine::InitializeDefaultState() {
-    current_state_.global_variables = {
-        {"player_level", 1},
-        {"combat_count", 0},
-        {"story_progress", 0},
-        {"player_exp", 0},
-        {"monsters_killed", 0}
-    };
-
-    current_state_.world_flags = {
-        {"tutorial_complete", false},
-        {"in_combat", false},
-        {"chapter_1_available", false},
-        {"quest_complete", false}
-    };
-
-    current_state_.active_events = {};
-
-    current_state_.last_update_time =
-        std::chrono::duration_cast<std::chrono::milliseconds>(
-            std::chrono::system_clock::now().time_since_epoch())
-            .count();
+    SetGlobalVariable("player_level", 1);
+    SetGlobalVariable("combat_count", 0);
+    SetGlobalVariable("story_progress", 0);
+    SetGlobalVariable("player_exp", 0);
+    SetGlobalVariable("monsters_killed", 0);
+
+    SetWorldFlag("tutorial_complete", false);
+    SetWorldFlag("in_combat", false);
+    SetWorldFlag("chapter_1_available", false);
+    SetWorldFlag("quest_complete", false);
+
+    TouchUpdateTime();
 }
 
-std::string WorldStateEngine::SerializeWorldState() const {
+std::string WorldStateEngine::SerializeWorldState(const WorldState& snapshot) const {
     std::ostringstream oss;
     oss << "{";
 
     oss << "\"global_variables\":{";
     bool first = true;
-    for (const auto& var : current_state_.global_variables) {
+    for (const auto& var : snapshot.global_variables) {
         if (!first) {
             oss << ",";
         }
@@ -264,7 +1031,7 @@ std::string WorldStateEngine::SerializeWorldState() const {
 
     oss << "\"world_flags\":{";
     first = true;
-    for (const auto& flag : current_state_.world_flags) {
+    for (const auto& flag : snapshot.world_flags) {
         if (!first) {
             oss << ",";
         }
@@ -274,15 +1041,15 @@ std::string WorldStateEngine::SerializeWorldState() const {
     oss << "},";
 
     oss << "\"active_events\":[";
-    for (std::size_t i = 0; i < current_state_.active_events.size(); ++i) {
+    for (std::size_t i = 0; i < snapshot.active_events.size(); ++i) {
         if (i != 0) {
             oss << ",";
         }
-        oss << "\"" << current_state_.active_events[i] << "\"";
+        oss << "\"" << snapshot.active_events[i] << "\"";
     }
     oss << "],";
 
-    oss << "\"last_update_time\":" << current_state_.last_update_time;
+    oss << "\"last_update_time\":" << snapshot.last_update_time;
     oss << "}";
 
     return oss.str();
@@ -293,53 +1060,72 @@ bool WorldStateEngine::DeserializeWorldState(const std::string& json_data) {
         return false;
     }
 
+    // Parse into local maps first, then apply per key through the sharded
+    // setters so each write only takes its own shard lock.
+    std::unordered_map<std::string, int> parsed_variables;
+    std::unordered_map<std::string, bool> parsed_flags;
+
     const std::string global_vars_section = ExtractObjectSection(json_data, "global_variables");
     if (!global_vars_section.empty()) {
-        ParseIntMapSection(global_vars_section, current_state_.global_variables);
+        ParseIntMapSection(global_vars_section, parsed_variables);
     }
 
     const std::string world_flags_section = ExtractObjectSection(json_data, "world_flags");
     if (!world_flags_section.empty()) {
-        ParseBoolMapSection(world_flags_section, current_state_.world_flags);
+        ParseBoolMapSection(world_flags_section, parsed_flags);
     }
 
     const std::string active_events_section = ExtractArraySection(json_data, "active_events");
     if (!active_events_section.empty()) {
-        current_state_.active_events.clear();
+        std::vector<std::string> parsed_events;
         const std::regex event_regex("\"([^\"]+)\"");
         for (std::sregex_iterator it(active_events_section.begin(), active_events_section.end(), event_regex), end;
              it != end;
              ++it) {
-            current_state_.active_events.push_back((*it)[1].str());
+            parsed_events.push_back((*it)[1].str());
         }
+        {
+            std::unique_lock<std::shared_mutex> lock(events_mutex_);
+            active_events_ = std::move(parsed_events);
+        }
+        // Active events are not representable as StateChange entries;
+        // straddling delta clients must take the full-state path.
+        InvalidateJournal();
     }
 
     // Map lightweight frontend payload keys.
     int int_value = 0;
     if (TryExtractInt(json_data, "level", int_value)) {
-        current_state_.global_variables["player_level"] = int_value;
+        parsed_variables["player_level"] = int_value;
     }
     if (TryExtractInt(json_data, "story_progress", int_value)) {
-        current_state_.global_variables["story_progress"] = int_value;
+        parsed_variables["story_progress"] = int_value;
     } else if (TryExtractInt(json_data, "day", int_value)) {
-        current_state_.global_variables["story_progress"] = std::max(0, int_value - 1);
+        parsed_variables["story_progress"] = std::max(0, int_value - 1);
     }
     if (TryExtractInt(json_data, "gold", int_value)) {
-        current_state_.global_variables["player_exp"] = int_value;
+        parsed_variables["player_exp"] = int_value;
     }
     if (TryExtractInt(json_data, "combat_count", int_value)) {
-        current_state_.global_variables["combat_count"] = int_value;
+        parsed_variables["combat_count"] = int_value;
     }
 
     bool bool_value = false;
     if (TryExtractBool(json_data, "in_combat", bool_value)) {
-        current_state_.world_flags["in_combat"] = bool_value;
+        parsed_flags["in_combat"] = bool_value;
     }
     if (TryExtractBool(json_data, "tutorial_complete", bool_value)) {
-        current_state_.world_flags["tutorial_complete"] = bool_value;
+        parsed_flags["tutorial_complete"] = bool_value;
     }
     if (TryExtractBool(json_data, "quest_complete", bool_value)) {
-        current_state_.world_flags["quest_complete"] = bool_value;
+        parsed_flags["quest_complete"] = bool_value;
+    }
+
+    for (const auto& entry : parsed_variables) {
+        SetGlobalVariable(entry.first, entry.second);
+    }
+    for (const auto& entry : parsed_flags) {
+        SetWorldFlag(entry.first, entry.second);
     }
 
     return true;
@@ -0,0 +1,147 @@
+/*
+ * File: WorldStateReadReplicas.cpp
+ * Description: Bounded-staleness read replica pool implementation.
+ */
+#include "Algorithm_interact/WorldStateReadReplicas.h"
+
+#include <utility>
+
+namespace strategy {
+
+WorldStateReadReplicas::WorldStateReadReplicas(WorldStateEngine& authoritative,
+                                               std::size_t replica_count,
+                                               std::uint64_t max_lag_messages)
+    : authoritative_(authoritative),
+      max_lag_messages_(max_lag_messages) {
+    replicas_.reserve(replica_count);
+    for (std::size_t i = 0; i < replica_count; ++i) {
+        auto slot = std::make_unique<ReplicaSlot>();
+        slot->worker = std::thread(&WorldStateReadReplicas::ConsumeLoop,
+                                   this, std::ref(*slot));
+        replicas_.push_back(std::move(slot));
+    }
+}
+
+WorldStateReadReplicas::~WorldStateReadReplicas() {
+    running_.store(false);
+    for (auto& slot : replicas_) {
+        {
+            std::lock_guard<std::mutex> lock(slot->queue_mutex);
+        }
+        slot->queue_cv.notify_all();
+    }
+    for (auto& slot : replicas_) {
+        if (slot->worker.joinable()) {
+            slot->worker.join();
+        }
+    }
+}
+
+void WorldStateReadReplicas::Publish(const std::string& message) {
+    published_count_.fetch_add(1, std::memory_order_relaxed);
+    for (auto& slot : replicas_) {
+        {
+            std::lock_guard<std::mutex> lock(slot->queue_mutex);
+            if (slot->queue.size() >= QUEUE_CAPACITY) {
+                // Count the dropped backlog as consumed so the lag gauge
+                // recovers; the consumer sees the sequence gap and goes
+                // out of sync until the next snapshot.
+                slot->consumed_count.fetch_add(slot->queue.size(),
+                                               std::memory_order_relaxed);
+                slot->queue.clear();
+            }
+            slot->queue.push_back(message);
+        }
+        slot->queue_cv.notify_one();
+    }
+}
+
+void WorldStateReadReplicas::SetResyncRequestFn(ResyncRequestFn fn) {
+    std::lock_guard<std::mutex> lock(resync_mutex_);
+    resync_fn_ = std::move(fn);
+}
+
+GameState WorldStateReadReplicas::Query(const std::string& query_type) {
+    const std::size_t count = replicas_.size();
+    if (count > 0) {
+        const std::size_t start =
+            next_replica_.fetch_add(1, std::memory_order_relaxed) % count;
+        for (std::size_t probe = 0; probe < count; ++probe) {
+            ReplicaSlot& slot = *replicas_[(start + probe) % count];
+            const std::uint64_t backlog =
+                published_count_.load(std::memory_order_relaxed) -
+                slot.consumed_count.load(std::memory_order_relaxed);
+            if (slot.consumer.IsInSync() && backlog <= max_lag_messages_) {
+                replica_queries_.fetch_add(1, std::memory_order_relaxed);
+                return slot.engine.QueryGameState(query_type);
+            }
+        }
+    }
+
+    // No fresh replica: correctness falls back to the authoritative engine.
+    primary_fallbacks_.fetch_add(1, std::memory_order_relaxed);
+    return authoritative_.QueryGameState(query_type);
+}
+
+bool WorldStateReadReplicas::IsCaughtUp() const {
+    const std::uint64_t published =
+        published_count_.load(std::memory_order_relaxed);
+    for (const auto& slot : replicas_) {
+        if (!slot->consumer.IsInSync() ||
+            slot->consumed_count.load(std::memory_order_relaxed) < published) {
+            return false;
+        }
+    }
+    return true;
+}
+
+WorldStateReadReplicas::Stats WorldStateReadReplicas::GetStats() const {
+    Stats stats;
+    stats.replica_queries = replica_queries_.load(std::memory_order_relaxed);
+    stats.primary_fallbacks = primary_fallbacks_.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void WorldStateReadReplicas::ConsumeLoop(ReplicaSlot& slot) {
+    while (true) {
+        std::string message;
+        {
+            std::unique_lock<std::mutex> lock(slot.queue_mutex);
+            slot.queue_cv.wait(lock, [this, &slot] {
+                return !slot.queue.empty() || !running_.load();
+            });
+            if (slot.queue.empty()) {
+                return;  // shutdown with a drained queue
+            }
+            message = std::move(slot.queue.front());
+            slot.queue.pop_front();
+        }
+
+        slot.consumer.Consume(message);
+        slot.consumed_count.fetch_add(1, std::memory_order_relaxed);
+
+        if (slot.consumer.IsInSync()) {
+            slot.resync_reported = false;  // recovered; re-arm the report
+        } else {
+            ReportDesync(slot);
+        }
+    }
+}
+
+void WorldStateReadReplicas::ReportDesync(ReplicaSlot& slot) {
+    if (slot.resync_reported) {
+        return;  // one report per desync episode
+    }
+    slot.resync_reported = true;
+
+    ResyncRequestFn fn;
+    {
+        std::lock_guard<std::mutex> lock(resync_mutex_);
+        fn = resync_fn_;
+    }
+    if (fn) {
+        fn();
+    }
+}
+
+} // namespace strategy
@@ -0,0 +1,221 @@
+/*
+ * File: WorldStateReplicator.cpp
+ * Description: Snapshot-plus-delta world state replication implementation.
+ */
+
+#include "Algorithm_interact/WorldStateReplicator.h"
+
+#include "serialization/BinaryCodec.h"
+
+#include <cstring>
+#include <utility>
+
+namespace {
+
+// Wire framing: magic + version + type byte + sequence, then a payload.
+// Field encoding comes from the shared serialization codec.
+constexpr char kReplicationMagic[4] = {'F', 'L', 'R', 'P'};
+constexpr std::uint8_t kReplicationVersion = 1;
+constexpr std::uint8_t kMessageSnapshot = 1;
+constexpr std::uint8_t kMessageDelta = 2;
+
+using serialization::AppendPod;
+using serialization::AppendString;
+using MessageReader = serialization::ByteReader;
+
+std::string EncodeHeader(std::uint8_t type, std::uint64_t sequence) {
+    std::string message;
+    message.append(kReplicationMagic, sizeof(kReplicationMagic));
+    AppendPod(message, kReplicationVersion);
+    AppendPod(message, type);
+    AppendPod(message, sequence);
+    return message;
+}
+
+bool DecodeHeader(MessageReader& reader, std::uint8_t& type, std::uint64_t& sequence) {
+    char magic[sizeof(kReplicationMagic)];
+    for (char& byte : magic) {
+        if (!reader.ReadPod(byte)) {
+            return false;
+        }
+    }
+    if (std::memcmp(magic, kReplicationMagic, sizeof(kReplicationMagic)) != 0) {
+        return false;
+    }
+
+    std::uint8_t version = 0;
+    if (!reader.ReadPod(version) || version != kReplicationVersion) {
+        return false;
+    }
+    return reader.ReadPod(type) && reader.ReadPod(sequence);
+}
+
+std::string EncodeDeltaMessage(std::uint64_t sequence,
+                               const std::vector<strategy::StateChange>& changes) {
+    std::string message = EncodeHeader(kMessageDelta, sequence);
+    AppendPod(message, static_cast<std::uint32_t>(changes.size()));
+    for (const strategy::StateChange& change : changes) {
+        AppendString(message, change.key);
+        AppendPod(message, static_cast<std::uint8_t>(change.is_flag ? 1 : 0));
+        AppendPod(message, static_cast<std::uint8_t>(change.bool_value ? 1 : 0));
+        AppendPod(message, static_cast<std::int32_t>(change.int_value));
+    }
+    return message;
+}
+
+bool DecodeDeltaPayload(MessageReader& reader, std::vector<strategy::StateChange>& changes) {
+    std::uint32_t count = 0;
+    if (!reader.ReadPod(count)) {
+        return false;
+    }
+
+    changes.reserve(count);
+    for (std::uint32_t i = 0; i < count; ++i) {
+        strategy::StateChange change;
+        std::uint8_t is_flag = 0;
+        std::uint8_t bool_value = 0;
+        std::int32_t int_value = 0;
+        if (!reader.ReadString(change.key) || !reader.ReadPod(is_flag) ||
+            !reader.ReadPod(bool_value) || !reader.ReadPod(int_value)) {
+            return false;
+        }
+        change.is_flag = is_flag != 0;
+        change.bool_value = bool_value != 0;
+        change.int_value = int_value;
+        changes.push_back(std::move(change));
+    }
+    return reader.AtEnd();
+}
+
+} // namespace
+
+namespace strategy {
+
+// ============================================================================
+// WorldStateReplicator (primary side)
+// ============================================================================
+
+WorldStateReplicator::WorldStateReplicator(WorldStateEngine& engine,
+                                           PublishFn publish,
+                                           int snapshot_every_deltas)
+    : engine_(engine)
+    , publish_(std::move(publish))
+    , snapshot_every_deltas_(snapshot_every_deltas < 1 ? 1 : snapshot_every_deltas) {
+}
+
+bool WorldStateReplicator::ReplicateDelta(const std::vector<StateChange>& changes) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    const std::uint64_t sequence = engine_.GetAppliedSequence() + 1;
+    if (!engine_.ApplyDelta(changes, sequence)) {
+        return false;
+    }
+
+    if (publish_) {
+        publish_(EncodeDeltaMessage(sequence, changes));
+    }
+
+    if (++deltas_since_snapshot_ >= snapshot_every_deltas_) {
+        PublishSnapshotLocked();
+    }
+    return true;
+}
+
+void WorldStateReplicator::PublishSnapshot() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    PublishSnapshotLocked();
+}
+
+std::uint64_t WorldStateReplicator::GetPublishedSequence() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return engine_.GetAppliedSequence();
+}
+
+void WorldStateReplicator::PublishSnapshotLocked() {
+    if (publish_) {
+        std::string message = EncodeHeader(kMessageSnapshot, engine_.GetAppliedSequence());
+        AppendString(message, engine_.SerializeBinarySnapshot());
+        publish_(message);
+    }
+    deltas_since_snapshot_ = 0;
+}
+
+// ============================================================================
+// WorldStateReplica (standby side)
+// ============================================================================
+
+WorldStateReplica::WorldStateReplica(WorldStateEngine& engine)
+    : engine_(engine) {
+}
+
+bool WorldStateReplica::Consume(const std::string& message) {
+    MessageReader reader(message);
+    std::uint8_t type = 0;
+    std::uint64_t sequence = 0;
+    if (!DecodeHeader(reader, type, sequence)) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    if (type == kMessageSnapshot) {
+        std::string payload;
+        if (!reader.ReadString(payload) || !reader.AtEnd()) {
+            return false;
+        }
+
+        // A snapshot older than what is already applied carries nothing new.
+        if (in_sync_ && sequence < last_sequence_) {
+            return true;
+        }
+
+        if (!engine_.LoadBinarySnapshot(payload)) {
+            return false;
+        }
+        last_sequence_ = sequence;
+        in_sync_ = true;
+        return true;
+    }
+
+    if (type == kMessageDelta) {
+        std::vector<StateChange> changes;
+        if (!DecodeDeltaPayload(reader, changes)) {
+            return false;
+        }
+
+        // Deltas only apply on top of an established baseline.
+        if (!in_sync_) {
+            return false;
+        }
+
+        if (sequence <= last_sequence_) {
+            return true;  // duplicate, already applied
+        }
+        if (sequence != last_sequence_ + 1) {
+            // Lost a message; state is suspect until the next snapshot.
+            in_sync_ = false;
+            return false;
+        }
+
+        if (!engine_.ApplyDelta(changes, sequence)) {
+            in_sync_ = false;
+            return false;
+        }
+        last_sequence_ = sequence;
+        return true;
+    }
+
+    return false;
+}
+
+bool WorldStateReplica::IsInSync() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return in_sync_;
+}
+
+std::uint64_t WorldStateReplica::GetLastSequence() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return last_sequence_;
+}
+
+} // namespace strategy
@@ -1,66 +1,511 @@
 /*
  * 文件名: AsyncLogService.cpp
- * 说明: 策略层异步日志服务实现。
+ * 说明: 策略层异步日志服务实现（无锁MPSC环形缓冲）。
  * 作者: 彭承康
  * 创建时间: 2025-07-13
+ * 更新时间: 2026-08-27 — 互斥锁队列替换为有界无锁MPSC环形缓冲
+ * 更新时间: 2026-08-28 — 自适应批处理窗口与批量分发接口
+ * 更新时间: 2026-08-28 — 运行期输出端热切换、分模块级别过滤与突发抓取
  */
 #include "Log/AsyncLogService.h"
 
+#include "common/ExecutorService.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iterator>
+
 namespace strategy {
 
-AsyncLogService::AsyncLogService(std::vector<std::shared_ptr<ILogService>> services)
-    : service_pool_(std::move(services)) {
-    worker_thread_ = std::thread(&AsyncLogService::ProcessQueue, this);
+namespace {
+// 单批汲取上限：更深的积压由下一轮继续，批缓冲内存有界
+constexpr std::size_t MAX_BATCH_SIZE = 256;
+// 自适应休眠窗口边界：持续空闲时从最短逐轮翻倍到最长，
+// 取到批次立即收回最短；唤醒靠条件变量，窗口只兜底
+constexpr std::chrono::milliseconds MIN_IDLE_WINDOW{1};
+constexpr std::chrono::milliseconds MAX_IDLE_WINDOW{16};
+// 缓冲满时生产者尝试释放最旧槽位的次数上限
+constexpr int DROP_OLDEST_RETRY_LIMIT = 4;
+} // namespace
+
+AsyncLogService::AsyncLogService(std::vector<std::shared_ptr<ILogService>> services,
+                                 bool use_shared_executor)
+    : sinks_(std::make_shared<const SinkSet>(std::move(services))),
+      type_levels_(std::make_shared<const TypeLevelMap>()),
+      ring_(std::make_unique<Slot[]>(QUEUE_CAPACITY)),
+      use_shared_executor_(use_shared_executor) {
+    for (std::size_t i = 0; i < QUEUE_CAPACITY; ++i) {
+        ring_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+    if (!use_shared_executor_) {
+        worker_thread_ = std::thread(&AsyncLogService::ProcessQueue, this);
+    }
 }
 
 AsyncLogService::~AsyncLogService() {
+    stop_flag_.store(true, std::memory_order_release);
+
+    if (use_shared_executor_) {
+        // 等在途的分发任务退出（stop_flag_已置位，不会再接力），
+        // 然后内联排空缓冲里剩下的记录
+        while (drain_scheduled_.load(std::memory_order_acquire)) {
+            std::this_thread::yield();
+        }
+        DrainToServices();
+        return;
+    }
+
     {
-        std::unique_lock<std::mutex> lock(queue_mutex_);
-        stop_flag_ = true;
+        // 消费者可能正睡在动态窗口里，立即唤醒进入停机排空
+        std::lock_guard<std::mutex> lock(wake_mutex_);
+        wake_cv_.notify_one();
     }
-    condition_.notify_one();
     if (worker_thread_.joinable()) {
         worker_thread_.join();
     }
 }
 
+bool AsyncLogService::TryEnqueue(LogMessage&& msg) {
+    std::size_t pos = head_.load(std::memory_order_relaxed);
+    for (;;) {
+        Slot& slot = ring_[pos & (QUEUE_CAPACITY - 1)];
+        const std::size_t seq = slot.sequence.load(std::memory_order_acquire);
+        const std::intptr_t diff =
+            static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos);
+
+        if (diff == 0) {
+            // 槽位可写，CAS竞争该位置
+            if (head_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                slot.message = std::move(msg);
+                slot.sequence.store(pos + 1, std::memory_order_release);
+                return true;
+            }
+        } else if (diff < 0) {
+            // 缓冲满
+            return false;
+        } else {
+            pos = head_.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+bool AsyncLogService::TryDequeue(LogMessage& msg) {
+    std::size_t pos = tail_.load(std::memory_order_relaxed);
+    for (;;) {
+        Slot& slot = ring_[pos & (QUEUE_CAPACITY - 1)];
+        const std::size_t seq = slot.sequence.load(std::memory_order_acquire);
+        const std::intptr_t diff =
+            static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos + 1);
+
+        if (diff == 0) {
+            // 生产者丢弃最旧日志时也推进tail，故消费侧同样用CAS
+            if (tail_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                msg = std::move(slot.message);
+                slot.sequence.store(pos + QUEUE_CAPACITY, std::memory_order_release);
+                return true;
+            }
+        } else if (diff < 0) {
+            // 缓冲空
+            return false;
+        } else {
+            pos = tail_.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+bool AsyncLogService::TryDiscardOldest() {
+    std::size_t pos = tail_.load(std::memory_order_relaxed);
+    for (;;) {
+        Slot& slot = ring_[pos & (QUEUE_CAPACITY - 1)];
+        const std::size_t seq = slot.sequence.load(std::memory_order_acquire);
+        const std::intptr_t diff =
+            static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos + 1);
+
+        if (diff == 0) {
+            if (tail_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                slot.message = LogMessage{};
+                slot.sequence.store(pos + QUEUE_CAPACITY, std::memory_order_release);
+                dropped_count_.fetch_add(1, std::memory_order_relaxed);
+                return true;
+            }
+        } else if (diff < 0) {
+            return false;
+        } else {
+            pos = tail_.load(std::memory_order_relaxed);
+        }
+    }
+}
+
 void AsyncLogService::Log(LogLevel level,
                           const std::string& file,
                           int line,
                           const std::string& type,
                           const std::string& message) {
-    {
-        std::unique_lock<std::mutex> lock(queue_mutex_);
-        log_queue_.push({level, file, line, type, message});
+    // const引用重载必须拷贝三个字符串；计数供零拷贝验证使用
+    string_copies_.fetch_add(3, std::memory_order_relaxed);
+    LogMessage msg;
+    msg.level = level;
+    msg.file = file;
+    msg.line = line;
+    msg.type = type;
+    msg.message = message;
+    Submit(std::move(msg));
+}
+
+void AsyncLogService::Log(LogLevel level,
+                          std::string&& file,
+                          int line,
+                          std::string&& type,
+                          std::string&& message) {
+    LogMessage msg;
+    msg.level = level;
+    msg.file = std::move(file);
+    msg.line = line;
+    msg.type = std::move(type);
+    msg.message = std::move(message);
+    Submit(std::move(msg));
+}
+
+void AsyncLogService::Submit(LogMessage&& msg) {
+    // 生产侧分级闸门：低于下限的记录没有任何去处（全局、模块
+    // 覆盖、突发抓取都不要），一次relaxed比较后直接丢弃
+    const LogLevel level = msg.deferred ? msg.payload.level : msg.level;
+    if (static_cast<int>(level) < enqueue_floor_.load(std::memory_order_relaxed)) {
+        return;
+    }
+
+    LogMessage pending = std::move(msg);
+    if (TryEnqueue(std::move(pending))) {
+        WakeConsumer();
+        return;
+    }
+
+    if (overflow_policy_.load(std::memory_order_relaxed) == OverflowPolicy::DropOldest) {
+        // 释放最旧槽位后重试；消费者同时在推进时有限次即可成功
+        for (int attempt = 0; attempt < DROP_OLDEST_RETRY_LIMIT; ++attempt) {
+            TryDiscardOldest();
+            // TryEnqueue失败时不消费消息，pending可直接重试，无需拷贝
+            if (TryEnqueue(std::move(pending))) {
+                WakeConsumer();
+                return;
+            }
+        }
+    }
+
+    // DropNewest 或重试仍失败：丢弃本条并计数，绝不阻塞调用线程
+    dropped_count_.fetch_add(1, std::memory_order_relaxed);
+}
+
+void AsyncLogService::WakeConsumer() {
+    if (use_shared_executor_) {
+        ScheduleDrain();
+        return;
+    }
+
+    // 负载持续时消费者不休眠，标志为否，热路径到此为止；
+    // 只有消费者真的睡着时才付一次锁的代价
+    if (consumer_waiting_.load(std::memory_order_acquire)) {
+        std::lock_guard<std::mutex> lock(wake_mutex_);
+        wake_cv_.notify_one();
+    }
+}
+
+void AsyncLogService::ScheduleDrain() {
+    if (stop_flag_.load(std::memory_order_acquire)) {
+        return;  // 停机排空由析构函数内联完成
+    }
+    if (drain_scheduled_.exchange(true, std::memory_order_acq_rel)) {
+        return;  // 已有分发任务在途，它会把新记录一并带走
+    }
+
+    const bool accepted = ExecutorService::GetInstance().Submit(
+        ExecutorLane::Logging, [this]() { RunScheduledDrain(); });
+    if (!accepted) {
+        // 日志通道被卸载：在调用线程内联完成本轮，记录不丢
+        RunScheduledDrain();
+    }
+}
+
+void AsyncLogService::RunScheduledDrain() {
+    DrainToServices();
+    drain_scheduled_.store(false, std::memory_order_release);
+
+    // 清标志前到达的生产者看到"在途"不会调度；此处补漏接力，
+    // 确保最后一批记录总有任务负责
+    if (head_.load(std::memory_order_acquire) !=
+            tail_.load(std::memory_order_acquire) &&
+        !stop_flag_.load(std::memory_order_acquire)) {
+        ScheduleDrain();
+    }
+}
+
+void AsyncLogService::DrainToServices() {
+    std::vector<LogRecord> batch;
+    batch.reserve(MAX_BATCH_SIZE);
+    for (;;) {
+        batch.clear();
+        if (DrainBatch(batch) == 0) {
+            return;
+        }
+        DispatchBatch(batch);
+    }
+}
+
+AsyncLogService::DispatchConfig AsyncLogService::SnapshotConfig() const {
+    std::lock_guard<std::mutex> lock(config_mutex_);
+    DispatchConfig config;
+    config.sinks = sinks_;
+    config.type_levels = type_levels_;
+    config.min_level = min_level_;
+    config.burst_active = burst_active_;
+    config.burst_level = burst_level_;
+    return config;
+}
+
+void AsyncLogService::DispatchBatch(std::vector<LogRecord>& batch) {
+    const DispatchConfig config = SnapshotConfig();
+
+    // 先抓取：达到抓取级别的记录全部入环，包括随后会被分级
+    // 过滤掉的——事故取证要的就是这部分不落盘的详细日志
+    if (config.burst_active) {
+        std::lock_guard<std::mutex> lock(burst_mutex_);
+        for (const LogRecord& record : batch) {
+            if (record.level >= config.burst_level) {
+                CaptureBurstLocked(record);
+            }
+        }
+    }
+
+    // 再过滤：模块覆盖优先于全局级别；生产侧闸门只保证下限，
+    // 精确的分级语义在这里按快照一次算清
+    const bool has_overrides = config.type_levels && !config.type_levels->empty();
+    if (has_overrides || config.min_level != LogLevel::DEBUG) {
+        batch.erase(
+            std::remove_if(batch.begin(), batch.end(),
+                           [&config, has_overrides](const LogRecord& record) {
+                               LogLevel threshold = config.min_level;
+                               if (has_overrides) {
+                                   const auto it = config.type_levels->find(record.type);
+                                   if (it != config.type_levels->end()) {
+                                       threshold = it->second;
+                                   }
+                               }
+                               return record.level < threshold;
+                           }),
+            batch.end());
+    }
+    if (batch.empty() || !config.sinks) {
+        return;
+    }
+
+    // 整批一次交给每个输出端：文件服务合并为一次写盘
+    for (const auto& service : *config.sinks) {
+        if (service) {
+            service->LogBatch(batch);
+        }
+    }
+}
+
+void AsyncLogService::ReconfigureSinks(std::vector<std::shared_ptr<ILogService>> services) {
+    auto snapshot = std::make_shared<const SinkSet>(std::move(services));
+    std::lock_guard<std::mutex> lock(config_mutex_);
+    sinks_ = std::move(snapshot);
+}
+
+void AsyncLogService::SetMinLevel(LogLevel level) {
+    std::lock_guard<std::mutex> lock(config_mutex_);
+    min_level_ = level;
+    RecomputeEnqueueFloorLocked();
+}
+
+void AsyncLogService::SetTypeMinLevel(const std::string& type, LogLevel level) {
+    std::lock_guard<std::mutex> lock(config_mutex_);
+    auto updated = std::make_shared<TypeLevelMap>(*type_levels_);
+    (*updated)[type] = level;
+    type_levels_ = std::move(updated);
+    RecomputeEnqueueFloorLocked();
+}
+
+void AsyncLogService::ClearTypeMinLevel(const std::string& type) {
+    std::lock_guard<std::mutex> lock(config_mutex_);
+    if (type_levels_->count(type) == 0) {
+        return;
+    }
+    auto updated = std::make_shared<TypeLevelMap>(*type_levels_);
+    updated->erase(type);
+    type_levels_ = std::move(updated);
+    RecomputeEnqueueFloorLocked();
+}
+
+void AsyncLogService::RecomputeEnqueueFloorLocked() {
+    int floor = static_cast<int>(min_level_);
+    for (const auto& [type, level] : *type_levels_) {
+        floor = std::min(floor, static_cast<int>(level));
+    }
+    if (burst_active_) {
+        floor = std::min(floor, static_cast<int>(burst_level_));
     }
-    condition_.notify_one();
+    enqueue_floor_.store(floor, std::memory_order_relaxed);
+}
+
+void AsyncLogService::EnableBurstCapture(LogLevel capture_level, std::size_t capacity) {
+    std::lock_guard<std::mutex> config_lock(config_mutex_);
+    std::lock_guard<std::mutex> burst_lock(burst_mutex_);
+    burst_active_ = true;
+    burst_level_ = capture_level;
+    burst_ring_.clear();
+    burst_ring_.reserve(capacity);
+    burst_capacity_ = capacity;
+    burst_next_ = 0;
+    burst_wrapped_ = false;
+    RecomputeEnqueueFloorLocked();
+}
+
+void AsyncLogService::DisableBurstCapture() {
+    std::lock_guard<std::mutex> lock(config_mutex_);
+    burst_active_ = false;
+    RecomputeEnqueueFloorLocked();
+}
+
+std::vector<LogRecord> AsyncLogService::DumpBurstCapture() {
+    std::lock_guard<std::mutex> lock(burst_mutex_);
+    std::vector<LogRecord> records;
+    records.reserve(burst_ring_.size());
+    if (burst_wrapped_) {
+        // 覆盖过最旧记录：burst_next_ 起的一段在前才是时间顺序
+        records.insert(records.end(),
+                       std::make_move_iterator(burst_ring_.begin() +
+                                               static_cast<std::ptrdiff_t>(burst_next_)),
+                       std::make_move_iterator(burst_ring_.end()));
+        records.insert(records.end(),
+                       std::make_move_iterator(burst_ring_.begin()),
+                       std::make_move_iterator(burst_ring_.begin() +
+                                               static_cast<std::ptrdiff_t>(burst_next_)));
+    } else {
+        records.insert(records.end(),
+                       std::make_move_iterator(burst_ring_.begin()),
+                       std::make_move_iterator(burst_ring_.end()));
+    }
+    burst_ring_.clear();
+    burst_next_ = 0;
+    burst_wrapped_ = false;
+    return records;
+}
+
+void AsyncLogService::CaptureBurstLocked(const LogRecord& record) {
+    if (burst_capacity_ == 0) {
+        return;
+    }
+    if (burst_ring_.size() < burst_capacity_) {
+        burst_ring_.push_back(record);
+    } else {
+        burst_ring_[burst_next_] = record;
+        burst_wrapped_ = true;
+    }
+    burst_next_ = (burst_next_ + 1) % burst_capacity_;
+}
+
+void AsyncLogService::SetOverflowPolicy(OverflowPolicy policy) {
+    overflow_policy_.store(policy, std::memory_order_relaxed);
+}
+
+std::uint64_t AsyncLogService::GetDroppedCount() const {
+    return dropped_count_.load(std::memory_order_relaxed);
+}
+
+std::string AsyncLogService::FormatDeferred(const DeferredPayload& payload) {
+    std::string result;
+    const char* cursor = payload.format != nullptr ? payload.format : "";
+    std::size_t arg_index = 0;
+
+    while (*cursor != '\0') {
+        if (cursor[0] == '{' && cursor[1] == '}' && arg_index < payload.arg_count) {
+            const LogArg& arg = payload.args[arg_index++];
+            switch (arg.type) {
+                case LogArg::Type::Int:
+                    result += std::to_string(arg.int_value);
+                    break;
+                case LogArg::Type::UInt:
+                    result += std::to_string(arg.uint_value);
+                    break;
+                case LogArg::Type::Float:
+                    result += std::to_string(arg.float_value);
+                    break;
+                case LogArg::Type::Bool:
+                    result += arg.bool_value ? "true" : "false";
+                    break;
+                case LogArg::Type::CString:
+                    result += arg.cstr_value != nullptr ? arg.cstr_value : "(null)";
+                    break;
+            }
+            cursor += 2;
+        } else {
+            result += *cursor;
+            ++cursor;
+        }
+    }
+
+    return result;
+}
+
+std::size_t AsyncLogService::DrainBatch(std::vector<LogRecord>& batch) {
+    const std::size_t before = batch.size();
+    LogMessage msg;
+    while (batch.size() < MAX_BATCH_SIZE && TryDequeue(msg)) {
+        LogRecord record;
+        if (msg.deferred) {
+            // 格式化成本落在工作线程，生产侧只付了POD拷贝
+            record.level = msg.payload.level;
+            record.file = msg.payload.file != nullptr ? msg.payload.file : "";
+            record.line = msg.payload.line;
+            record.type = msg.payload.type != nullptr ? msg.payload.type : "";
+            record.message = FormatDeferred(msg.payload);
+        } else {
+            record.level = msg.level;
+            record.file = std::move(msg.file);
+            record.line = msg.line;
+            record.type = std::move(msg.type);
+            record.message = std::move(msg.message);
+        }
+        batch.push_back(std::move(record));
+    }
+    return batch.size() - before;
 }
 
 void AsyncLogService::ProcessQueue() {
-    while (true) {
-        std::unique_lock<std::mutex> lock(queue_mutex_);
-        condition_.wait(lock, [this] { return !log_queue_.empty() || stop_flag_; });
+    std::vector<LogRecord> batch;
+    batch.reserve(MAX_BATCH_SIZE);
+    std::chrono::milliseconds idle_window = MIN_IDLE_WINDOW;
 
-        if (stop_flag_ && log_queue_.empty()) {
+    for (;;) {
+        batch.clear();
+        if (DrainBatch(batch) > 0) {
+            DispatchBatch(batch);
+            // 有积压说明负载上来了，窗口收紧到最短
+            idle_window = MIN_IDLE_WINDOW;
+            continue;
+        }
+
+        if (stop_flag_.load(std::memory_order_acquire)) {
             break;
         }
 
-        // 为了减小锁的粒度，将队列中的消息移动到局部变量
-        std::queue<LogMessage> processing_queue;
-        log_queue_.swap(processing_queue);
-        
-        lock.unlock(); // 立即释放锁，允许主线程继续推入日志
-
-        while (!processing_queue.empty()) {
-            LogMessage msg = processing_queue.front();
-            processing_queue.pop();
-            for (const auto& service : service_pool_) {
-                if (service) {
-                    service->Log(msg.level, msg.file, msg.line, msg.type, msg.message);
-                }
+        {
+            // 标志置位与休眠同在锁内，生产者的进锁唤醒不会丢失
+            std::unique_lock<std::mutex> lock(wake_mutex_);
+            consumer_waiting_.store(true, std::memory_order_release);
+            if (head_.load(std::memory_order_acquire) ==
+                    tail_.load(std::memory_order_acquire) &&
+                !stop_flag_.load(std::memory_order_acquire)) {
+                wake_cv_.wait_for(lock, idle_window);
             }
+            consumer_waiting_.store(false, std::memory_order_relaxed);
         }
+
+        // 持续空闲逐轮放宽窗口，空闲CPU占用随之下降
+        idle_window = std::min(idle_window * 2, MAX_IDLE_WINDOW);
     }
 }
 
-} // namespace strategy 
\ No newline at end of file
+} // namespace strategy
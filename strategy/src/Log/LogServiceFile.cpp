@@ -3,25 +3,44 @@
  * 说明: 策略层日志服务文件实现。
  * 作者: 彭承康
  * 创建时间: 2025-07-13
+ * 更新时间: 2026-08-27 — 批量缓冲写入与按大小轮转
  */
 #include "Log/LogServiceFile.h"
-#include <iostream>
 #include <chrono>
-#include <iomanip>
+#include <cstdio>
 #include <ctime>
+#include <iomanip>
+#include <sstream>
+#include <utility>
 
 namespace strategy {
 
-LogServiceFile::LogServiceFile(const std::string& filename) {
+LogServiceFile::LogServiceFile(const std::string& filename,
+                               std::size_t max_file_size_bytes)
+    : filename_(filename),
+      max_file_size_(max_file_size_bytes),
+      last_flush_(std::chrono::steady_clock::now()) {
     log_file_ = std::make_unique<std::ofstream>(filename, std::ios_base::app);
     if (!log_file_->is_open()) {
         throw std::runtime_error("Failed to open log file: " + filename);
     }
+    // 追加模式下写入位置即当前文件大小
+    const std::ofstream::pos_type pos = log_file_->tellp();
+    current_file_size_ = pos >= 0 ? static_cast<std::size_t>(pos) : 0;
 }
 
 LogServiceFile::~LogServiceFile() {
-    if (log_file_ && log_file_->is_open()) {
-        log_file_->close();
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        FlushLocked();
+        if (log_file_ && log_file_->is_open()) {
+            log_file_->close();
+        }
+    }
+    for (auto& worker : rotation_workers_) {
+        if (worker.joinable()) {
+            worker.join();
+        }
     }
 }
 
@@ -30,10 +49,47 @@ void LogServiceFile::Log(LogLevel level,
                          int line,
                          const std::string& type,
                          const std::string& message) {
+    auto now = std::chrono::system_clock::now();
+    std::time_t now_c = std::chrono::system_clock::to_time_t(now);
+    std::tm tm_now;
+#if defined(_WIN32) || defined(_WIN64)
+    localtime_s(&tm_now, &now_c);
+#else
+    localtime_r(&now_c, &tm_now);
+#endif
+
+    std::string level_str = LogLevelToString(level);
+
+    std::ostringstream line_stream;
+    line_stream << "["
+                << std::put_time(&tm_now, "%Y-%m-%d %H:%M:%S") << "]"
+                << "[" << level_str << "]"
+                << "[" << file << ":" << line << "]"
+                << "[" << type << "] "
+                << message << "\n";
+
+    std::lock_guard<std::mutex> lock(mutex_);
     if (!log_file_ || !log_file_->is_open()) {
         return;
     }
 
+    write_buffer_ += line_stream.str();
+    ++buffered_messages_;
+
+    // 条数或时间间隔到达阈值时一次性落盘
+    const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - last_flush_).count();
+    if (buffered_messages_ >= FLUSH_BATCH_MESSAGES || elapsed >= FLUSH_INTERVAL_MS) {
+        FlushLocked();
+    }
+}
+
+void LogServiceFile::LogBatch(const std::vector<LogRecord>& records) {
+    if (records.empty()) {
+        return;
+    }
+
+    // 时间戳每批取一次：同批消息的时间差小于落盘粒度
     auto now = std::chrono::system_clock::now();
     std::time_t now_c = std::chrono::system_clock::to_time_t(now);
     std::tm tm_now;
@@ -43,14 +99,96 @@ void LogServiceFile::Log(LogLevel level,
     localtime_r(&now_c, &tm_now);
 #endif
 
-    std::string level_str = LogLevelToString(level);
+    // 锁外把整批格式化为一个连续块
+    std::ostringstream batch_stream;
+    for (const LogRecord& record : records) {
+        batch_stream << "["
+                     << std::put_time(&tm_now, "%Y-%m-%d %H:%M:%S") << "]"
+                     << "[" << LogLevelToString(record.level) << "]"
+                     << "[" << record.file << ":" << record.line << "]"
+                     << "[" << record.type << "] "
+                     << record.message << "\n";
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!log_file_ || !log_file_->is_open()) {
+        return;
+    }
+
+    write_buffer_ += batch_stream.str();
+    buffered_messages_ += records.size();
 
-    *log_file_ << "["
-               << std::put_time(&tm_now, "%Y-%m-%d %H:%M:%S") << "]"
-               << "[" << level_str << "]"
-               << "[" << file << ":" << line << "]"
-               << "[" << type << "] "
-               << message << std::endl;
+    const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - last_flush_).count();
+    if (buffered_messages_ >= FLUSH_BATCH_MESSAGES || elapsed >= FLUSH_INTERVAL_MS) {
+        FlushLocked();
+    }
+}
+
+void LogServiceFile::Flush() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    FlushLocked();
+}
+
+void LogServiceFile::SetRotationCallback(std::function<void(const std::string&)> callback) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    rotation_callback_ = std::move(callback);
+}
+
+void LogServiceFile::FlushLocked() {
+    if (write_buffer_.empty() || !log_file_ || !log_file_->is_open()) {
+        last_flush_ = std::chrono::steady_clock::now();
+        return;
+    }
+
+    // 整批一次写入并刷新，日志I/O从N次小写盘合并为一次
+    log_file_->write(write_buffer_.data(),
+                     static_cast<std::streamsize>(write_buffer_.size()));
+    log_file_->flush();
+    current_file_size_ += write_buffer_.size();
+    write_buffer_.clear();
+    buffered_messages_ = 0;
+    last_flush_ = std::chrono::steady_clock::now();
+
+    if (current_file_size_ >= max_file_size_) {
+        RotateLocked();
+    }
+}
+
+void LogServiceFile::RotateLocked() {
+    log_file_->close();
+
+    // 归档名带时间戳，同一秒内多次轮转时附加文件大小避免覆盖
+    auto now = std::chrono::system_clock::now();
+    std::time_t now_c = std::chrono::system_clock::to_time_t(now);
+    std::tm tm_now;
+#if defined(_WIN32) || defined(_WIN64)
+    localtime_s(&tm_now, &now_c);
+#else
+    localtime_r(&now_c, &tm_now);
+#endif
+    std::ostringstream archive_stream;
+    archive_stream << filename_ << "."
+                   << std::put_time(&tm_now, "%Y%m%d_%H%M%S")
+                   << "." << current_file_size_;
+    const std::string archive_name = archive_stream.str();
+
+    if (std::rename(filename_.c_str(), archive_name.c_str()) != 0) {
+        // 轮转失败则继续追加写原文件，避免丢日志
+        log_file_ = std::make_unique<std::ofstream>(filename_, std::ios_base::app);
+        return;
+    }
+
+    log_file_ = std::make_unique<std::ofstream>(filename_, std::ios_base::trunc);
+    current_file_size_ = 0;
+
+    // 归档后续处理（如压缩）放到后台线程，不占用日志写入路径
+    if (rotation_callback_) {
+        rotation_workers_.emplace_back(
+            [callback = rotation_callback_, archive_name]() {
+                callback(archive_name);
+            });
+    }
 }
 
 std::string LogServiceFile::LogLevelToString(LogLevel level) const {
@@ -64,4 +202,4 @@ std::string LogServiceFile::LogLevelToString(LogLevel level) const {
     }
 }
 
-} // namespace strategy 
\ No newline at end of file
+} // namespace strategy
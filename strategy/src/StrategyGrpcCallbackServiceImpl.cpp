@@ -0,0 +1,287 @@
+/*
+ * File: StrategyGrpcCallbackServiceImpl.cpp
+ * Description: Strategy layer gRPC callback-API service implementation.
+ */
+
+#include "StrategyGrpcCallbackServiceImpl.h"
+
+#include "StrategyGrpcMessageMapping.h"
+#include "monitor/PerformanceMonitor.h"
+#include "net/GrpcCompressionPolicy.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <utility>
+
+namespace {
+
+// Shared handler-latency histogram; recording is lock-free.
+strategy::LatencyHistogram& RpcLatencyHistogram() {
+    static strategy::LatencyHistogram& histogram =
+        strategy::PerformanceMonitor::GetInstance().GetHistogram(
+            strategy::PerformanceMonitor::HISTOGRAM_RPC_HANDLER);
+    return histogram;
+}
+
+// Wraps a handler so exceptions surface as INTERNAL like the sync service.
+grpc::Status RunGuarded(const std::function<grpc::Status()>& handler) {
+    try {
+        return handler();
+    } catch (const std::exception& e) {
+        return grpc::Status(grpc::StatusCode::INTERNAL, e.what());
+    }
+}
+
+} // namespace
+
+namespace strategy {
+
+StrategyGrpcCallbackServiceImpl::StrategyGrpcCallbackServiceImpl(
+    std::size_t worker_threads,
+    std::size_t max_pending_requests)
+    : workers_(worker_threads, max_pending_requests) {
+    // The core game methods take their request/response messages from
+    // pooled protobuf arenas instead of per-call heap construction.
+    SetMessageAllocatorFor_GetGameRules(&rules_allocator_);
+    SetMessageAllocatorFor_UpdateWorldState(&world_state_allocator_);
+    SetMessageAllocatorFor_TriggerEvent(&event_allocator_);
+    SetMessageAllocatorFor_QueryGameState(&query_allocator_);
+
+    // Assets come from the directory named by STRATEGY_ASSET_DIR; the
+    // store stays empty (and the manifest at version 0) when unset.
+    if (const char* asset_dir = std::getenv("STRATEGY_ASSET_DIR")) {
+        const std::size_t loaded = asset_store_.LoadAssetDirectory(asset_dir);
+        std::cout << "StrategyGrpcCallbackServiceImpl: loaded " << loaded
+                  << " assets from " << asset_dir << std::endl;
+    }
+
+    std::cout << "StrategyGrpcCallbackServiceImpl: service initialized ("
+              << worker_threads << " workers)" << std::endl;
+}
+
+grpc::ServerUnaryReactor* StrategyGrpcCallbackServiceImpl::FinishInline(
+    grpc::CallbackServerContext* context,
+    const std::function<grpc::Status()>& handler) {
+    grpc::ServerUnaryReactor* reactor = context->DefaultReactor();
+    {
+        const LatencyHistogram::ScopedRecord rpc_timer(RpcLatencyHistogram());
+        reactor->Finish(RunGuarded(handler));
+    }
+    return reactor;
+}
+
+grpc::ServerUnaryReactor* StrategyGrpcCallbackServiceImpl::FinishOnWorker(
+    grpc::CallbackServerContext* context,
+    TaskLane lane,
+    std::function<grpc::Status()> handler) {
+    grpc::ServerUnaryReactor* reactor = context->DefaultReactor();
+
+    // Latency is measured from arrival so queue wait is included.
+    const auto start = std::chrono::steady_clock::now();
+    const bool enqueued = workers_.TryEnqueue(
+        lane, [reactor, start, handler = std::move(handler)]() {
+            reactor->Finish(RunGuarded(handler));
+            RpcLatencyHistogram().Record(std::chrono::steady_clock::now() - start);
+        });
+
+    if (!enqueued) {
+        // Lower-priority lanes shed before the queue is actually full, so
+        // interactive traffic keeps headroom during query floods.
+        reactor->Finish(grpc::Status(grpc::StatusCode::RESOURCE_EXHAUSTED,
+                                     "strategy worker pool shedding lane load"));
+    }
+    return reactor;
+}
+
+grpc::ServerUnaryReactor* StrategyGrpcCallbackServiceImpl::GetGameRules(
+    grpc::CallbackServerContext* context,
+    const strategy_proto::RulesRequest* request,
+    strategy_proto::GameRulesResponse* response) {
+    // In-memory lookup; completes inline on the event-loop thread.
+    return FinishInline(context, [this, context, request, response]() {
+        const auto rules = service_.GetGameRules(request->category());
+        grpc_mapping::FillGameRulesResponse(rules, request->active_only(), response);
+        // Full rule sets can be large; size decides compression per call.
+        net::ApplyCompressionPolicy(context, response->ByteSizeLong());
+        return grpc::Status::OK;
+    });
+}
+
+grpc::ServerUnaryReactor* StrategyGrpcCallbackServiceImpl::UpdateWorldState(
+    grpc::CallbackServerContext* context,
+    const strategy_proto::WorldStateUpdate* request,
+    strategy_proto::StatusResponse* response) {
+    // May touch persistence; world-sync lane.
+    return FinishOnWorker(context, TaskLane::WorldSync, [this, request, response]() {
+        auto result =
+            service_.UpdateWorldState(grpc_mapping::ToInternalWorldStateUpdate(*request));
+        response->set_success(result.success);
+        response->set_message(std::move(result.message));
+        return grpc::Status::OK;
+    });
+}
+
+grpc::ServerUnaryReactor* StrategyGrpcCallbackServiceImpl::TriggerEvent(
+    grpc::CallbackServerContext* context,
+    const strategy_proto::EventTrigger* request,
+    strategy_proto::EventResult* response) {
+    // Combat-affecting and latency-critical; interactive lane.
+    return FinishOnWorker(context, TaskLane::Interactive, [this, request, response]() {
+        // Params are read straight out of the wire message's repeated
+        // field; no intermediate EventTriggerRequest vector is built.
+        auto result =
+            service_.TriggerEvent(request->event_id(),
+                                  grpc_mapping::EventParamSpan(*request));
+        grpc_mapping::FillEventResult(std::move(result), response);
+        return grpc::Status::OK;
+    });
+}
+
+grpc::ServerUnaryReactor* StrategyGrpcCallbackServiceImpl::QueryGameState(
+    grpc::CallbackServerContext* context,
+    const strategy_proto::QueryRequest* request,
+    strategy_proto::GameStateResponse* response) {
+    // Health probes must answer even when queues are backed up.
+    if (request->query_type() == "health_check") {
+        return FinishInline(context, [response]() {
+            response->set_is_valid(true);
+            response->set_state_json("{\"status\":\"ok\"}");
+            return grpc::Status::OK;
+        });
+    }
+
+    // Bulk state reads are analytics traffic: queued behind interactive
+    // and world-sync work and shed first when the pool backs up, so a
+    // reader flood cannot pin the event-loop threads or delay events.
+    return FinishOnWorker(context, TaskLane::Analytics, [this, context, request, response]() {
+        if (request->delta_sync()) {
+            auto delta = service_.QueryGameStateDelta(request->query_type(),
+                                                      request->known_sequence());
+            grpc_mapping::FillGameStateDeltaResponse(std::move(delta), response);
+        } else {
+            auto state = service_.QueryGameState(request->query_type());
+            grpc_mapping::FillGameStateResponse(std::move(state), response);
+        }
+
+        // state_json runs to hundreds of KB on full snapshots over WAN
+        // links; deltas usually stay under the threshold and go raw.
+        net::ApplyCompressionPolicy(context, response->ByteSizeLong());
+        return grpc::Status::OK;
+    });
+}
+
+grpc::ServerUnaryReactor* StrategyGrpcCallbackServiceImpl::GetAssetManifest(
+    grpc::CallbackServerContext* context,
+    const strategy_proto::AssetManifestRequest* request,
+    strategy_proto::AssetManifestResponse* response) {
+    // Snapshot pointer dereference; completes inline like GetGameRules.
+    return FinishInline(context, [this, context, request, response]() {
+        const auto manifest = asset_store_.GetManifest();
+        grpc_mapping::FillAssetManifestResponse(*manifest,
+                                                request->known_version(),
+                                                response);
+        // Full manifests are hash lists and compress well; up-to-date
+        // receipts stay under the threshold and go raw.
+        net::ApplyCompressionPolicy(context, response->ByteSizeLong());
+        return grpc::Status::OK;
+    });
+}
+
+grpc::ServerUnaryReactor* StrategyGrpcCallbackServiceImpl::GetAssetChunk(
+    grpc::CallbackServerContext* context,
+    const strategy_proto::AssetChunkRequest* request,
+    strategy_proto::AssetChunkResponse* response) {
+    // Bulk transfer traffic: queued behind interactive and world-sync
+    // work so an asset sync burst cannot delay event processing.
+    return FinishOnWorker(context, TaskLane::Analytics, [this, context, request, response]() {
+        auto chunk = request->chunk_hash().empty()
+                         ? asset_store_.ReadRange(request->asset_name(),
+                                                  request->offset(),
+                                                  request->length())
+                         : asset_store_.ReadChunkByHash(request->chunk_hash());
+        grpc_mapping::FillAssetChunkResponse(std::move(chunk), response);
+        // Chunk payloads are already content-addressed; leave compression
+        // to the size policy since many asset formats are pre-compressed.
+        net::ApplyCompressionPolicy(context, response->ByteSizeLong());
+        return grpc::Status::OK;
+    });
+}
+
+grpc::ServerUnaryReactor* StrategyGrpcCallbackServiceImpl::SyncTime(
+    grpc::CallbackServerContext* context,
+    const strategy_proto::TimeSyncRequest* request,
+    strategy_proto::TimeSyncResponse* response) {
+    // Two clock reads; queueing on a worker lane would add exactly the
+    // latency the sample is trying to measure.
+    return FinishInline(context, [request, response]() {
+        const auto now_ms = []() {
+            return std::chrono::duration_cast<std::chrono::milliseconds>(
+                       std::chrono::system_clock::now().time_since_epoch())
+                .count();
+        };
+        response->set_client_send_ms(request->client_send_ms());
+        response->set_server_receive_ms(now_ms());
+        response->set_server_send_ms(now_ms());
+        return grpc::Status::OK;
+    });
+}
+
+grpc::ServerUnaryReactor* StrategyGrpcCallbackServiceImpl::ConfigureLogging(
+    grpc::CallbackServerContext* context,
+    const strategy_proto::LogConfigRequest* request,
+    strategy_proto::LogConfigResponse* response) {
+    // Rare admin traffic touching short-lock config state; inline keeps
+    // it off the worker lanes the game traffic is competing for.
+    return FinishInline(context, [this, request, response]() {
+        if (!log_service_) {
+            return grpc::Status(grpc::StatusCode::FAILED_PRECONDITION,
+                                "no log service attached");
+        }
+
+        const auto to_level = [](std::int32_t value) {
+            return static_cast<LogLevel>(
+                std::clamp<int>(value, static_cast<int>(LogLevel::DEBUG),
+                                static_cast<int>(LogLevel::FATAL)));
+        };
+
+        if (request->has_global_level()) {
+            log_service_->SetMinLevel(to_level(request->global_level()));
+        }
+        for (const auto& entry : request->module_levels()) {
+            if (entry.clear()) {
+                log_service_->ClearTypeMinLevel(entry.module());
+            } else {
+                log_service_->SetTypeMinLevel(entry.module(), to_level(entry.level()));
+            }
+        }
+        if (request->enable_burst()) {
+            if (request->burst_capacity() > 0) {
+                log_service_->EnableBurstCapture(to_level(request->burst_level()),
+                                                 request->burst_capacity());
+            } else {
+                log_service_->EnableBurstCapture(to_level(request->burst_level()));
+            }
+        }
+        if (request->disable_burst()) {
+            log_service_->DisableBurstCapture();
+        }
+        if (request->dump_burst()) {
+            for (auto& record : log_service_->DumpBurstCapture()) {
+                auto* out = response->add_burst_records();
+                out->set_level(static_cast<std::int32_t>(record.level));
+                out->set_file(std::move(record.file));
+                out->set_line(record.line);
+                out->set_module(std::move(record.type));
+                out->set_message(std::move(record.message));
+            }
+        }
+        response->set_success(true);
+        return grpc::Status::OK;
+    });
+}
+
+} // namespace strategy
@@ -1,16 +1,128 @@
-﻿/*
+/*
  * File: StrategyGrpcServiceImpl.cpp
  * Description: Strategy layer gRPC service implementation.
  */
 
 #include "StrategyGrpcServiceImpl.h"
 
+#include "StrategyGrpcMessageMapping.h"
+#include "monitor/PerformanceMonitor.h"
+#include "net/ClientRateLimiter.h"
+#include "net/GrpcCompressionPolicy.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
 #include <exception>
 #include <iostream>
+#include <string>
+#include <thread>
+#include <utility>
+
+namespace {
+
+// Poll interval for interest subscriptions; quiet polls cost a journal
+// scan and no stream write, so the cadence can stay game-loop tight.
+constexpr int SUBSCRIBE_POLL_INTERVAL_MS = 100;
+
+// Shared handler-latency histogram; recording is lock-free.
+strategy::LatencyHistogram& RpcLatencyHistogram() {
+    static strategy::LatencyHistogram& histogram =
+        strategy::PerformanceMonitor::GetInstance().GetHistogram(
+            strategy::PerformanceMonitor::HISTOGRAM_RPC_HANDLER);
+    return histogram;
+}
+
+// Per-client fairness isolation keyed by transport peer identity. The
+// budgets are sized so first-party clients running the normal game loop
+// never hit them; a misbehaving client drains only its own buckets and
+// gets RESOURCE_EXHAUSTED while everyone else keeps full budget.
+net::ClientRateLimiter& RpcRateLimiter() {
+    static net::ClientRateLimiter limiter({{
+        /* Read */ {200.0, 400.0},
+        /* Compute */ {100.0, 200.0},
+        /* Mutate */ {100.0, 200.0},
+        /* Stream */ {2.0, 10.0},
+    }});
+    return limiter;
+}
+
+// Overflow metric: rejected RPCs land in the monitor's counter registry
+// next to the handler-latency histogram.
+std::atomic<std::uint64_t>& RateLimitedCounter() {
+    static std::atomic<std::uint64_t>& counter =
+        strategy::PerformanceMonitor::GetInstance().GetCounter(
+            strategy::PerformanceMonitor::COUNTER_RPC_RATE_LIMITED);
+    return counter;
+}
+
+// Admission check at the top of every handler; costs one hash lookup.
+bool AdmitRpc(const grpc::ServerContext* context, net::RpcClass rpc_class) {
+    if (RpcRateLimiter().TryAcquire(context->peer(), rpc_class)) {
+        return true;
+    }
+    RateLimitedCounter().fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
+
+grpc::Status RateLimitedStatus() {
+    return grpc::Status(grpc::StatusCode::RESOURCE_EXHAUSTED,
+                        "per-client rate limit exceeded");
+}
+
+// Trace-context propagation: clients send their trace id in the
+// "x-trace-id" metadata key; zero means the call is untraced.
+std::uint64_t TraceIdFromContext(const grpc::ServerContext* context) {
+    const auto& metadata = context->client_metadata();
+    auto it = metadata.find("x-trace-id");
+    if (it == metadata.end()) {
+        return 0;
+    }
+    const std::string value(it->second.data(), it->second.size());
+    return std::strtoull(value.c_str(), nullptr, 10);
+}
+
+/**
+ * @brief Records recv/send hops of a traced RPC into the trace ring.
+ *
+ * Recv is recorded on construction, send on destruction, so the pair
+ * brackets the handler body exactly. Untraced calls record nothing.
+ */
+class ScopedTraceHops {
+public:
+    explicit ScopedTraceHops(const grpc::ServerContext* context)
+        : trace_id_(TraceIdFromContext(context)) {
+        if (trace_id_ != 0) {
+            strategy::PerformanceMonitor::GetInstance().RecordTraceEvent(
+                trace_id_, "strategy_recv");
+        }
+    }
+
+    ~ScopedTraceHops() {
+        if (trace_id_ != 0) {
+            strategy::PerformanceMonitor::GetInstance().RecordTraceEvent(
+                trace_id_, "strategy_send");
+        }
+    }
+
+private:
+    std::uint64_t trace_id_;
+};
+
+} // namespace
 
 namespace strategy {
 
 StrategyGrpcServiceImpl::StrategyGrpcServiceImpl() {
+    // Assets come from the directory named by STRATEGY_ASSET_DIR; the
+    // store stays empty (and the manifest at version 0) when unset.
+    if (const char* asset_dir = std::getenv("STRATEGY_ASSET_DIR")) {
+        const std::size_t loaded = asset_store_.LoadAssetDirectory(asset_dir);
+        std::cout << "StrategyGrpcServiceImpl: loaded " << loaded
+                  << " assets from " << asset_dir << std::endl;
+    }
     std::cout << "StrategyGrpcServiceImpl: service initialized" << std::endl;
 }
 
@@ -18,36 +130,17 @@ grpc::Status StrategyGrpcServiceImpl::GetGameRules(
     grpc::ServerContext* context,
     const strategy_proto::RulesRequest* request,
     strategy_proto::GameRulesResponse* response) {
-    (void)context;
+    if (!AdmitRpc(context, net::RpcClass::Read)) {
+        return RateLimitedStatus();
+    }
+    const LatencyHistogram::ScopedRecord rpc_timer(RpcLatencyHistogram());
+    const ScopedTraceHops trace_hops(context);
 
     try {
         const auto rules = service_.GetGameRules(request->category());
-        response->set_category(rules.category);
-        response->set_version(rules.version);
-
-        for (const auto& rule : rules.rules) {
-            if (request->active_only() && !rule.is_active) {
-                continue;
-            }
-
-            auto* out_rule = response->add_rules();
-            out_rule->set_rule_id(rule.rule_id);
-            out_rule->set_description(rule.description);
-            out_rule->set_category(rule.category);
-            out_rule->set_priority(rule.priority);
-            out_rule->set_is_active(rule.is_active);
-
-            auto* out_conditions = out_rule->mutable_conditions();
-            for (const auto& condition : rule.conditions) {
-                (*out_conditions)[condition.first] = condition.second;
-            }
-
-            auto* out_effects = out_rule->mutable_effects();
-            for (const auto& effect : rule.effects) {
-                (*out_effects)[effect.first] = effect.second;
-            }
-        }
-
+        grpc_mapping::FillGameRulesResponse(rules, request->active_only(), response);
+        // Full rule sets can be large; size decides compression per call.
+        net::ApplyCompressionPolicy(context, response->ByteSizeLong());
         return grpc::Status::OK;
     } catch (const std::exception& e) {
         return grpc::Status(grpc::StatusCode::INTERNAL, e.what());
@@ -58,16 +151,18 @@ grpc::Status StrategyGrpcServiceImpl::UpdateWorldState(
     grpc::ServerContext* context,
     const strategy_proto::WorldStateUpdate* request,
     strategy_proto::StatusResponse* response) {
-    (void)context;
+    if (!AdmitRpc(context, net::RpcClass::Mutate)) {
+        return RateLimitedStatus();
+    }
+    const LatencyHistogram::ScopedRecord rpc_timer(RpcLatencyHistogram());
+    const ScopedTraceHops trace_hops(context);
 
     try {
-        WorldStateUpdate internal_update;
-        internal_update.world_state_json = request->world_state_json();
-
-        const auto result = service_.UpdateWorldState(internal_update);
+        auto result =
+            service_.UpdateWorldState(grpc_mapping::ToInternalWorldStateUpdate(*request));
 
         response->set_success(result.success);
-        response->set_message(result.message);
+        response->set_message(std::move(result.message));
 
         return grpc::Status::OK;
     } catch (const std::exception& e) {
@@ -79,26 +174,19 @@ grpc::Status StrategyGrpcServiceImpl::TriggerEvent(
     grpc::ServerContext* context,
     const strategy_proto::EventTrigger* request,
     strategy_proto::EventResult* response) {
-    (void)context;
+    if (!AdmitRpc(context, net::RpcClass::Mutate)) {
+        return RateLimitedStatus();
+    }
+    const LatencyHistogram::ScopedRecord rpc_timer(RpcLatencyHistogram());
+    const ScopedTraceHops trace_hops(context);
 
     try {
-        EventTriggerRequest internal_request;
-        internal_request.event_id = request->event_id();
-        for (int i = 0; i < request->params_size(); ++i) {
-            internal_request.params.push_back(request->params(i));
-        }
-
-        const auto result = service_.TriggerEvent(internal_request);
-
-        response->set_triggered(result.triggered);
-        response->set_result_json(result.result_json);
-        for (int npc_id : result.affected_npcs) {
-            response->add_affected_npcs(npc_id);
-        }
-        for (const auto& change : result.state_changes) {
-            response->add_state_changes(change);
-        }
-
+        // Params are read straight out of the wire message's repeated
+        // field; no intermediate EventTriggerRequest vector is built.
+        auto result =
+            service_.TriggerEvent(request->event_id(),
+                                  grpc_mapping::EventParamSpan(*request));
+        grpc_mapping::FillEventResult(std::move(result), response);
         return grpc::Status::OK;
     } catch (const std::exception& e) {
         return grpc::Status(grpc::StatusCode::INTERNAL, e.what());
@@ -109,7 +197,11 @@ grpc::Status StrategyGrpcServiceImpl::QueryGameState(
     grpc::ServerContext* context,
     const strategy_proto::QueryRequest* request,
     strategy_proto::GameStateResponse* response) {
-    (void)context;
+    if (!AdmitRpc(context, net::RpcClass::Read)) {
+        return RateLimitedStatus();
+    }
+    const LatencyHistogram::ScopedRecord rpc_timer(RpcLatencyHistogram());
+    const ScopedTraceHops trace_hops(context);
 
     try {
         if (request->query_type() == "health_check") {
@@ -118,39 +210,213 @@ grpc::Status StrategyGrpcServiceImpl::QueryGameState(
             return grpc::Status::OK;
         }
 
-        const auto state = service_.QueryGameState(request->query_type());
-        response->set_state_json(state.state_json);
-        response->set_is_valid(state.is_valid);
+        if (request->delta_sync()) {
+            auto delta = service_.QueryGameStateDelta(request->query_type(),
+                                                      request->known_sequence());
+            grpc_mapping::FillGameStateDeltaResponse(std::move(delta), response);
+        } else {
+            auto state = service_.QueryGameState(request->query_type());
+            grpc_mapping::FillGameStateResponse(std::move(state), response);
+        }
 
-        auto* world_state = response->mutable_world_state();
-        world_state->set_last_update_time(state.world_state.last_update_time);
+        // state_json runs to hundreds of KB on full snapshots over WAN
+        // links; deltas usually stay under the threshold and go raw.
+        net::ApplyCompressionPolicy(context, response->ByteSizeLong());
+        return grpc::Status::OK;
+    } catch (const std::exception& e) {
+        return grpc::Status(grpc::StatusCode::INTERNAL, e.what());
+    }
+}
 
-        auto* global_vars = world_state->mutable_global_variables();
-        for (const auto& entry : state.world_state.global_variables) {
-            (*global_vars)[entry.first] = entry.second;
-        }
+grpc::Status StrategyGrpcServiceImpl::SubscribeWorldState(
+    grpc::ServerContext* context,
+    const strategy_proto::StateSubscribeRequest* request,
+    grpc::ServerWriter<strategy_proto::GameStateResponse>* writer) {
+    // Streams are charged once at open; the push loop itself is paced
+    // by the poll interval, not by the client.
+    if (!AdmitRpc(context, net::RpcClass::Stream)) {
+        return RateLimitedStatus();
+    }
+    const ScopedTraceHops trace_hops(context);
 
-        auto* world_flags = world_state->mutable_world_flags();
-        for (const auto& entry : state.world_state.world_flags) {
-            (*world_flags)[entry.first] = entry.second;
-        }
+    const int subscription_id = service_.RegisterStateInterest(
+        grpc_mapping::ToInternalInterestFilter(request->filter()));
+
+    try {
+        std::uint64_t known_sequence = request->known_sequence();
 
-        for (const auto& event_name : state.world_state.active_events) {
-            world_state->add_active_events(event_name);
+        // The first reply always goes out — either the subscriber's
+        // filtered resync or an up-to-date receipt — so the client
+        // learns the current sequence before the push loop starts.
+        {
+            auto delta = service_.PollStateInterest(subscription_id, known_sequence);
+            known_sequence = delta.sequence;
+            strategy_proto::GameStateResponse initial;
+            grpc_mapping::FillGameStateDeltaResponse(std::move(delta), &initial);
+            net::ApplyCompressionPolicy(context, initial.ByteSizeLong());
+            if (!writer->Write(initial)) {
+                service_.UnregisterStateInterest(subscription_id);
+                return grpc::Status::OK;
+            }
         }
 
-        for (const auto& relation_entry : state.world_state.npc_relations) {
-            const auto& relation = relation_entry.second;
-            auto* out_relation = world_state->add_npc_relations();
-            out_relation->set_npc_id(relation.npc_id);
-            out_relation->set_target_id(relation.target_id);
-            out_relation->set_relation_type(relation.relation_type);
-            out_relation->set_trust_level(relation.trust_level);
-            for (const auto& history : relation.shared_history) {
-                out_relation->add_shared_history(history);
+        while (!context->IsCancelled()) {
+            std::this_thread::sleep_for(
+                std::chrono::milliseconds(SUBSCRIBE_POLL_INTERVAL_MS));
+
+            auto delta = service_.PollStateInterest(subscription_id, known_sequence);
+            if (delta.up_to_date) {
+                // Covered gap with no matching changes: advance the
+                // baseline quietly instead of writing an empty push.
+                known_sequence = delta.sequence;
+                continue;
+            }
+            known_sequence = delta.sequence;
+
+            strategy_proto::GameStateResponse push;
+            grpc_mapping::FillGameStateDeltaResponse(std::move(delta), &push);
+            if (!writer->Write(push)) {
+                break;
             }
         }
+    } catch (const std::exception& e) {
+        service_.UnregisterStateInterest(subscription_id);
+        return grpc::Status(grpc::StatusCode::INTERNAL, e.what());
+    }
+
+    service_.UnregisterStateInterest(subscription_id);
+    return grpc::Status::OK;
+}
 
+grpc::Status StrategyGrpcServiceImpl::GetAssetManifest(
+    grpc::ServerContext* context,
+    const strategy_proto::AssetManifestRequest* request,
+    strategy_proto::AssetManifestResponse* response) {
+    if (!AdmitRpc(context, net::RpcClass::Read)) {
+        return RateLimitedStatus();
+    }
+    const LatencyHistogram::ScopedRecord rpc_timer(RpcLatencyHistogram());
+    const ScopedTraceHops trace_hops(context);
+
+    try {
+        const auto manifest = asset_store_.GetManifest();
+        grpc_mapping::FillAssetManifestResponse(*manifest,
+                                                request->known_version(),
+                                                response);
+        // Full manifests are hash lists and compress well; up-to-date
+        // receipts stay under the threshold and go raw.
+        net::ApplyCompressionPolicy(context, response->ByteSizeLong());
+        return grpc::Status::OK;
+    } catch (const std::exception& e) {
+        return grpc::Status(grpc::StatusCode::INTERNAL, e.what());
+    }
+}
+
+grpc::Status StrategyGrpcServiceImpl::GetAssetChunk(
+    grpc::ServerContext* context,
+    const strategy_proto::AssetChunkRequest* request,
+    strategy_proto::AssetChunkResponse* response) {
+    if (!AdmitRpc(context, net::RpcClass::Read)) {
+        return RateLimitedStatus();
+    }
+    const LatencyHistogram::ScopedRecord rpc_timer(RpcLatencyHistogram());
+    const ScopedTraceHops trace_hops(context);
+
+    try {
+        auto chunk = request->chunk_hash().empty()
+                         ? asset_store_.ReadRange(request->asset_name(),
+                                                  request->offset(),
+                                                  request->length())
+                         : asset_store_.ReadChunkByHash(request->chunk_hash());
+        grpc_mapping::FillAssetChunkResponse(std::move(chunk), response);
+        // Chunk payloads are already content-addressed; leave compression
+        // to the size policy since many asset formats are pre-compressed.
+        net::ApplyCompressionPolicy(context, response->ByteSizeLong());
+        return grpc::Status::OK;
+    } catch (const std::exception& e) {
+        return grpc::Status(grpc::StatusCode::INTERNAL, e.what());
+    }
+}
+
+grpc::Status StrategyGrpcServiceImpl::SyncTime(
+    grpc::ServerContext* context,
+    const strategy_proto::TimeSyncRequest* request,
+    strategy_proto::TimeSyncResponse* response) {
+    if (!AdmitRpc(context, net::RpcClass::Read)) {
+        return RateLimitedStatus();
+    }
+    // No latency histogram entry: the handler is two clock reads and
+    // would only skew the RPC latency distribution toward zero.
+
+    const auto now_ms = []() {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(
+                   std::chrono::system_clock::now().time_since_epoch())
+            .count();
+    };
+
+    response->set_client_send_ms(request->client_send_ms());
+    response->set_server_receive_ms(now_ms());
+    response->set_server_send_ms(now_ms());
+    return grpc::Status::OK;
+}
+
+grpc::Status StrategyGrpcServiceImpl::ConfigureLogging(
+    grpc::ServerContext* context,
+    const strategy_proto::LogConfigRequest* request,
+    strategy_proto::LogConfigResponse* response) {
+    // Admin traffic; rare, but it mutates process-wide state.
+    if (!AdmitRpc(context, net::RpcClass::Mutate)) {
+        return RateLimitedStatus();
+    }
+    const LatencyHistogram::ScopedRecord rpc_timer(RpcLatencyHistogram());
+    const ScopedTraceHops trace_hops(context);
+
+    if (!log_service_) {
+        return grpc::Status(grpc::StatusCode::FAILED_PRECONDITION,
+                            "no log service attached");
+    }
+
+    try {
+        const auto to_level = [](std::int32_t value) {
+            return static_cast<LogLevel>(
+                std::clamp<int>(value, static_cast<int>(LogLevel::DEBUG),
+                                static_cast<int>(LogLevel::FATAL)));
+        };
+
+        if (request->has_global_level()) {
+            log_service_->SetMinLevel(to_level(request->global_level()));
+        }
+        for (const auto& entry : request->module_levels()) {
+            if (entry.clear()) {
+                log_service_->ClearTypeMinLevel(entry.module());
+            } else {
+                log_service_->SetTypeMinLevel(entry.module(), to_level(entry.level()));
+            }
+        }
+        if (request->enable_burst()) {
+            if (request->burst_capacity() > 0) {
+                log_service_->EnableBurstCapture(to_level(request->burst_level()),
+                                                 request->burst_capacity());
+            } else {
+                log_service_->EnableBurstCapture(to_level(request->burst_level()));
+            }
+        }
+        if (request->disable_burst()) {
+            log_service_->DisableBurstCapture();
+        }
+        if (request->dump_burst()) {
+            for (auto& record : log_service_->DumpBurstCapture()) {
+                auto* out = response->add_burst_records();
+                out->set_level(static_cast<std::int32_t>(record.level));
+                out->set_file(std::move(record.file));
+                out->set_line(record.line);
+                out->set_module(std::move(record.type));
+                out->set_message(std::move(record.message));
+            }
+            // Burst dumps are repetitive text; size decides compression.
+            net::ApplyCompressionPolicy(context, response->ByteSizeLong());
+        }
+        response->set_success(true);
         return grpc::Status::OK;
     } catch (const std::exception& e) {
         return grpc::Status(grpc::StatusCode::INTERNAL, e.what());
@@ -0,0 +1,221 @@
+/*
+ * 文件名: AssetChunkStore.cpp
+ * 说明: 资源分块存储实现
+ * 作者: 彭承康
+ * 创建时间: 2026-08-28
+ */
+
+#include "config/AssetChunkStore.h"
+
+#include "security/SHA256.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <system_error>
+#include <utility>
+
+namespace strategy {
+
+AssetChunkStore::AssetChunkStore(std::uint32_t chunk_size)
+    : chunk_size_(chunk_size == 0 ? DEFAULT_CHUNK_SIZE : chunk_size) {
+    snapshot_.store(std::make_shared<const Snapshot>());
+}
+
+bool AssetChunkStore::AddAsset(const std::string& name, std::string content) {
+    if (name.empty()) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(writer_mutex_);
+    return PublishLocked(name,
+                         std::make_shared<const std::string>(std::move(content)));
+}
+
+bool AssetChunkStore::LoadAssetFile(const std::string& name, const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        return false;
+    }
+    std::ostringstream buffer;
+    buffer << file.rdbuf();
+    if (file.bad()) {
+        return false;
+    }
+    AddAsset(name, buffer.str());
+    return true;
+}
+
+std::size_t AssetChunkStore::LoadAssetDirectory(const std::string& dir) {
+    std::error_code ec;
+    std::filesystem::recursive_directory_iterator it(dir, ec);
+    if (ec) {
+        return 0;
+    }
+
+    std::size_t loaded = 0;
+    const std::filesystem::path base(dir);
+    for (const auto& entry : it) {
+        if (!entry.is_regular_file(ec) || ec) {
+            continue;
+        }
+        const std::string name =
+            entry.path().lexically_relative(base).generic_string();
+        if (LoadAssetFile(name, entry.path().string())) {
+            ++loaded;
+        }
+    }
+    return loaded;
+}
+
+bool AssetChunkStore::RemoveAsset(const std::string& name) {
+    std::lock_guard<std::mutex> lock(writer_mutex_);
+    return PublishLocked(name, nullptr);
+}
+
+std::shared_ptr<const AssetManifest> AssetChunkStore::GetManifest() const {
+    std::shared_ptr<const Snapshot> snapshot = snapshot_.load();
+    // 清单与快照同生命周期：别名构造让调用方只看到清单部分
+    return std::shared_ptr<const AssetManifest>(snapshot, &snapshot->manifest);
+}
+
+AssetChunkData AssetChunkStore::ReadRange(const std::string& name,
+                                          std::uint64_t offset,
+                                          std::uint32_t max_bytes) const {
+    AssetChunkData result;
+    std::shared_ptr<const Snapshot> snapshot = snapshot_.load();
+
+    auto it = snapshot->contents.find(name);
+    if (it == snapshot->contents.end()) {
+        return result;
+    }
+    const std::string& content = *it->second;
+    if (offset > content.size()) {
+        return result;
+    }
+
+    const std::uint32_t limit = (max_bytes == 0) ? chunk_size_ : max_bytes;
+    const std::uint64_t remaining = content.size() - offset;
+    const std::uint64_t length = std::min<std::uint64_t>(limit, remaining);
+
+    result.found = true;
+    result.offset = offset;
+    result.data.assign(content, static_cast<std::size_t>(offset),
+                       static_cast<std::size_t>(length));
+    result.eof = (offset + length >= content.size());
+
+    // 范围恰为一个清单块时回带块哈希，供客户端校验与缓存键入
+    if (offset % chunk_size_ == 0) {
+        const std::uint32_t index = static_cast<std::uint32_t>(offset / chunk_size_);
+        for (const AssetManifestEntry& entry : snapshot->manifest.assets) {
+            if (entry.name != name) {
+                continue;
+            }
+            if (index < entry.chunks.size() &&
+                entry.chunks[index].size == length) {
+                result.hash = entry.chunks[index].hash;
+            }
+            break;
+        }
+    }
+    return result;
+}
+
+AssetChunkData AssetChunkStore::ReadChunkByHash(const std::string& hash) const {
+    std::shared_ptr<const Snapshot> snapshot = snapshot_.load();
+    auto it = snapshot->chunk_index.find(hash);
+    if (it == snapshot->chunk_index.end()) {
+        return AssetChunkData{};
+    }
+    const std::uint64_t offset =
+        static_cast<std::uint64_t>(it->second.second) * chunk_size_;
+    return ReadRange(it->second.first, offset, chunk_size_);
+}
+
+std::uint64_t AssetChunkStore::GetVersion() const {
+    return snapshot_.load()->manifest.version;
+}
+
+AssetManifestEntry AssetChunkStore::BuildEntry(const std::string& name,
+                                               const std::string& content) const {
+    AssetManifestEntry entry;
+    entry.name = name;
+    entry.size = content.size();
+    entry.hash = SHA256::hash(content);
+    entry.chunk_size = chunk_size_;
+
+    entry.chunks.reserve(content.size() / chunk_size_ + 1);
+    for (std::uint64_t offset = 0; offset < content.size() || offset == 0;
+         offset += chunk_size_) {
+        AssetChunkInfo chunk;
+        chunk.index = static_cast<std::uint32_t>(offset / chunk_size_);
+        chunk.offset = offset;
+        chunk.size = static_cast<std::uint32_t>(
+            std::min<std::uint64_t>(chunk_size_, content.size() - offset));
+        chunk.hash = SHA256::hash(content.substr(
+            static_cast<std::size_t>(offset), chunk.size));
+        entry.chunks.push_back(std::move(chunk));
+        if (content.empty()) {
+            break;  // 空资源保留一个零长块，清单结构保持一致
+        }
+    }
+    return entry;
+}
+
+bool AssetChunkStore::PublishLocked(const std::string& name,
+                                    std::shared_ptr<const std::string> content) {
+    std::shared_ptr<const Snapshot> current = snapshot_.load();
+
+    auto existing = current->contents.find(name);
+    if (content == nullptr) {
+        if (existing == current->contents.end()) {
+            return false;
+        }
+    } else if (existing != current->contents.end() &&
+               *existing->second == *content) {
+        return false;  // 内容未变化，不抬版本号
+    }
+
+    auto next = std::make_shared<Snapshot>();
+    next->contents = current->contents;
+    if (content == nullptr) {
+        next->contents.erase(name);
+    } else {
+        next->contents[name] = std::move(content);
+    }
+
+    // 清单与哈希索引整体重建；资源数量小（美术包级别），重建
+    // 代价由被改资源的切块哈希主导，未变资源的条目可沿用
+    next->manifest.version = current->manifest.version + 1;
+    next->manifest.assets.reserve(next->contents.size());
+    for (const auto& [asset_name, asset_content] : next->contents) {
+        const AssetManifestEntry* reuse = nullptr;
+        if (asset_name != name) {
+            for (const AssetManifestEntry& entry : current->manifest.assets) {
+                if (entry.name == asset_name) {
+                    reuse = &entry;
+                    break;
+                }
+            }
+        }
+        next->manifest.assets.push_back(
+            reuse != nullptr ? *reuse : BuildEntry(asset_name, *asset_content));
+    }
+    std::sort(next->manifest.assets.begin(), next->manifest.assets.end(),
+              [](const AssetManifestEntry& a, const AssetManifestEntry& b) {
+                  return a.name < b.name;
+              });
+
+    for (const AssetManifestEntry& entry : next->manifest.assets) {
+        for (const AssetChunkInfo& chunk : entry.chunks) {
+            // 重复内容的块共享同一哈希，任一定位皆可
+            next->chunk_index.emplace(chunk.hash,
+                                      std::make_pair(entry.name, chunk.index));
+        }
+    }
+
+    snapshot_.store(std::shared_ptr<const Snapshot>(std::move(next)));
+    return true;
+}
+
+} // namespace strategy
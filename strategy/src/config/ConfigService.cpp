@@ -10,6 +10,8 @@
 #include <sstream>
 #include <iostream>
 #include <algorithm>
+#include <system_error>
+#include <utility>
 #include <vector>
 
 namespace strategy {
@@ -19,11 +21,17 @@ ConfigService& ConfigService::GetInstance() {
     return instance;
 }
 
+ConfigService::ConfigService() {
+    // 读取方永远不会看到空指针：未加载时为version 0的空快照
+    snapshot_.store(std::make_shared<const ConfigSnapshot>());
+}
+
+ConfigService::~ConfigService() {
+    StopWatching();
+}
+
 bool ConfigService::LoadConfig(const std::string& config_file) {
-    std::lock_guard<std::mutex> lock(config_mutex_);
-    
-    config_file_path_ = config_file;
-    
+    // 文件读取与解析在锁外完成，失败不触碰当前快照
     std::ifstream file(config_file);
     if (!file.is_open()) {
         std::cerr << "无法打开配置文件: " << config_file << std::endl;
@@ -34,40 +42,143 @@ bool ConfigService::LoadConfig(const std::string& config_file) {
     buffer << file.rdbuf();
     file.close();
 
-    return ParseJsonContent(buffer.str());
+    std::map<std::string, std::string> values;
+    if (!ParseJsonContent(buffer.str(), values)) {
+        return false;
+    }
+
+    std::error_code ec;
+    const auto mtime = std::filesystem::last_write_time(config_file, ec);
+
+    std::lock_guard<std::mutex> lock(writer_mutex_);
+    config_file_path_ = config_file;
+    loaded_mtime_ = ec ? std::filesystem::file_time_type{} : mtime;
+    PublishLocked(std::move(values));
+    return true;
 }
 
 bool ConfigService::LoadFromJson(const std::string& json_content) {
-    std::lock_guard<std::mutex> lock(config_mutex_);
-    return ParseJsonContent(json_content);
+    std::map<std::string, std::string> values;
+    if (!ParseJsonContent(json_content, values)) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(writer_mutex_);
+    PublishLocked(std::move(values));
+    return true;
+}
+
+std::shared_ptr<const ConfigSnapshot> ConfigService::GetSnapshot() const {
+    return snapshot_.load();
+}
+
+std::uint64_t ConfigService::GetVersion() const {
+    return snapshot_.load()->version;
+}
+
+bool ConfigService::StartWatching(std::chrono::milliseconds poll_interval) {
+    {
+        std::lock_guard<std::mutex> lock(writer_mutex_);
+        if (config_file_path_.empty()) {
+            return false;
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(watcher_mutex_);
+    if (watching_) {
+        return true;
+    }
+    watching_ = true;
+    watcher_ = std::thread(&ConfigService::WatchLoop, this, poll_interval);
+    return true;
+}
+
+void ConfigService::StopWatching() {
+    {
+        std::lock_guard<std::mutex> lock(watcher_mutex_);
+        if (!watching_) {
+            return;
+        }
+        watching_ = false;
+    }
+    watcher_cv_.notify_all();
+    if (watcher_.joinable()) {
+        watcher_.join();
+    }
+}
+
+void ConfigService::WatchLoop(std::chrono::milliseconds poll_interval) {
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(watcher_mutex_);
+            watcher_cv_.wait_for(lock, poll_interval, [this] { return !watching_; });
+            if (!watching_) {
+                return;
+            }
+        }
+
+        std::string path;
+        std::filesystem::file_time_type loaded_mtime;
+        {
+            std::lock_guard<std::mutex> lock(writer_mutex_);
+            path = config_file_path_;
+            loaded_mtime = loaded_mtime_;
+        }
+        if (path.empty()) {
+            continue;
+        }
+
+        std::error_code ec;
+        const auto mtime = std::filesystem::last_write_time(path, ec);
+        if (ec) {
+            continue;  // 文件暂时不可见（如原子替换中），下轮再看
+        }
+        if (mtime == loaded_mtime) {
+            continue;
+        }
+
+        // 与上次成功加载时的修改时间不同：在本线程解析并替换；
+        // 失败保留旧快照，只记日志（下轮还会重试到文件再次变化）
+        if (!LoadConfig(path)) {
+            std::cerr << "配置热重载失败，保留当前配置: " << path << std::endl;
+        }
+    }
+}
+
+void ConfigService::PublishLocked(std::map<std::string, std::string> values) {
+    auto next = std::make_shared<ConfigSnapshot>();
+    next->values = std::move(values);
+    next->version = snapshot_.load()->version + 1;
+    snapshot_.store(std::shared_ptr<const ConfigSnapshot>(std::move(next)));
 }
 
-bool ConfigService::ParseJsonContent(const std::string& json_content) {
+bool ConfigService::ParseJsonContent(const std::string& json_content,
+                                     std::map<std::string, std::string>& out) const {
     try {
         // 简化的JSON解析实现
         // 实际项目中建议使用 nlohmann/json 或其他专业JSON库
-        
-        config_data_.clear();
-        
+
+        out.clear();
+
         // 示例配置解析（简化版本）
         std::istringstream iss(json_content);
         std::string line;
-        
+
         while (std::getline(iss, line)) {
             // 移除空白字符
             line.erase(std::remove_if(line.begin(), line.end(), ::isspace), line.end());
-            
+
             // 跳过注释和空行
             if (line.empty() || line[0] == '#' || line.substr(0, 2) == "//") {
                 continue;
             }
-            
+
             // 查找键值对
             size_t colon_pos = line.find(':');
             if (colon_pos != std::string::npos) {
                 std::string key = line.substr(0, colon_pos);
                 std::string value = line.substr(colon_pos + 1);
-                
+
                 // 移除引号
                 if (!key.empty() && key.front() == '"' && key.back() == '"') {
                     key = key.substr(1, key.length() - 2);
@@ -75,29 +186,29 @@ bool ConfigService::ParseJsonContent(const std::string& json_content) {
                 if (!value.empty() && value.front() == '"' && value.back() == '"') {
                     value = value.substr(1, value.length() - 2);
                 }
-                
+
                 // 移除末尾的逗号
                 if (!value.empty() && value.back() == ',') {
                     value.pop_back();
                 }
-                
-                config_data_[key] = value;
+
+                out[key] = value;
             }
         }
-        
+
         // 添加一些默认配置
-        if (config_data_.empty()) {
-            config_data_["server.host"] = "localhost";
-            config_data_["server.port"] = "8080";
-            config_data_["database.host"] = "localhost";
-            config_data_["database.port"] = "5432";
-            config_data_["database.name"] = "game_db";
-            config_data_["log.level"] = "INFO";
-            config_data_["log.file"] = "game.log";
-            config_data_["game.max_players"] = "1000";
-            config_data_["game.debug_mode"] = "false";
+        if (out.empty()) {
+            out["server.host"] = "localhost";
+            out["server.port"] = "8080";
+            out["database.host"] = "localhost";
+            out["database.port"] = "5432";
+            out["database.name"] = "game_db";
+            out["log.level"] = "INFO";
+            out["log.file"] = "game.log";
+            out["game.max_players"] = "1000";
+            out["game.debug_mode"] = "false";
         }
-        
+
         return true;
     } catch (const std::exception& e) {
         std::cerr << "解析配置失败: " << e.what() << std::endl;
@@ -105,29 +216,29 @@ bool ConfigService::ParseJsonContent(const std::string& json_content) {
     }
 }
 
-std::string ConfigService::GetString(const std::string& key, const std::string& default_value) {
-    std::lock_guard<std::mutex> lock(config_mutex_);
-    
-    auto it = config_data_.find(key);
-    if (it != config_data_.end()) {
+std::string ConfigService::GetString(const std::string& key, const std::string& default_value) const {
+    const std::shared_ptr<const ConfigSnapshot> snapshot = snapshot_.load();
+
+    auto it = snapshot->values.find(key);
+    if (it != snapshot->values.end()) {
         return it->second;
     }
-    
+
     // 尝试嵌套键查找
     std::string nested_value = GetNestedValue(key);
     if (!nested_value.empty()) {
         return nested_value;
     }
-    
+
     return default_value;
 }
 
-int ConfigService::GetInt(const std::string& key, int default_value) {
+int ConfigService::GetInt(const std::string& key, int default_value) const {
     std::string value = GetString(key);
     if (value.empty()) {
         return default_value;
     }
-    
+
     try {
         return std::stoi(value);
     } catch (const std::exception&) {
@@ -135,22 +246,22 @@ int ConfigService::GetInt(const std::string& key, int default_value) {
     }
 }
 
-bool ConfigService::GetBool(const std::string& key, bool default_value) {
+bool ConfigService::GetBool(const std::string& key, bool default_value) const {
     std::string value = GetString(key);
     if (value.empty()) {
         return default_value;
     }
-    
+
     std::transform(value.begin(), value.end(), value.begin(), ::tolower);
     return value == "true" || value == "1" || value == "yes" || value == "on";
 }
 
-double ConfigService::GetDouble(const std::string& key, double default_value) {
+double ConfigService::GetDouble(const std::string& key, double default_value) const {
     std::string value = GetString(key);
     if (value.empty()) {
         return default_value;
     }
-    
+
     try {
         return std::stod(value);
     } catch (const std::exception&) {
@@ -159,32 +270,39 @@ double ConfigService::GetDouble(const std::string& key, double default_value) {
 }
 
 void ConfigService::SetString(const std::string& key, const std::string& value) {
-    std::lock_guard<std::mutex> lock(config_mutex_);
-    config_data_[key] = value;
+    std::lock_guard<std::mutex> lock(writer_mutex_);
+    std::map<std::string, std::string> values = snapshot_.load()->values;
+    values[key] = value;
+    PublishLocked(std::move(values));
 }
 
 bool ConfigService::HasKey(const std::string& key) const {
-    std::lock_guard<std::mutex> lock(config_mutex_);
-    return config_data_.find(key) != config_data_.end();
+    const std::shared_ptr<const ConfigSnapshot> snapshot = snapshot_.load();
+    return snapshot->values.find(key) != snapshot->values.end();
 }
 
 bool ConfigService::Reload() {
-    if (config_file_path_.empty()) {
+    std::string path;
+    {
+        std::lock_guard<std::mutex> lock(writer_mutex_);
+        path = config_file_path_;
+    }
+    if (path.empty()) {
         return false;
     }
-    return LoadConfig(config_file_path_);
+    return LoadConfig(path);
 }
 
 std::vector<std::string> ConfigService::GetAllKeys() const {
-    std::lock_guard<std::mutex> lock(config_mutex_);
-    
+    const std::shared_ptr<const ConfigSnapshot> snapshot = snapshot_.load();
+
     std::vector<std::string> keys;
-    keys.reserve(config_data_.size());
-    
-    for (const auto& pair : config_data_) {
+    keys.reserve(snapshot->values.size());
+
+    for (const auto& pair : snapshot->values) {
         keys.push_back(pair.first);
     }
-    
+
     return keys;
 }
 
@@ -195,4 +313,4 @@ std::string ConfigService::GetNestedValue(const std::string& nested_key) const {
     return "";
 }
 
-} // namespace strategy
\ No newline at end of file
+} // namespace strategy
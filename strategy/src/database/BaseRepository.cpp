@@ -5,10 +5,44 @@
  * 创建时间: 2026-02-18
  */
 #include "database/BaseRepository.h"
+#include "monitor/PerformanceMonitor.h"
+#include <algorithm>
+#include <cctype>
 #include <stdexcept>
+#include <utility>
 
 namespace strategy {
 
+namespace {
+
+// 语句是否已是EXPLAIN（忽略前导空白，大小写不敏感），
+// 对这类语句不再补抓执行计划
+bool IsExplainStatement(const std::string& query) {
+    static const std::string kExplain = "EXPLAIN";
+    std::size_t pos = query.find_first_not_of(" \t\r\n");
+    if (pos == std::string::npos || query.size() - pos < kExplain.size()) {
+        return false;
+    }
+    for (std::size_t i = 0; i < kExplain.size(); ++i) {
+        if (std::toupper(static_cast<unsigned char>(query[pos + i])) != kExplain[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// 拼接 "(?, ?, ?)" 形式的单行占位符
+std::string BuildRowPlaceholders(std::size_t column_count) {
+    std::string placeholders = "(";
+    for (std::size_t i = 0; i < column_count; ++i) {
+        placeholders += (i == 0) ? "?" : ", ?";
+    }
+    placeholders += ")";
+    return placeholders;
+}
+
+} // namespace
+
 BaseRepository::BaseRepository(std::unique_ptr<IDatabaseConnection> connection)
     : connection_(std::move(connection)) {
     if (connection_ && !connection_->IsConnected()) {
@@ -17,17 +51,117 @@ BaseRepository::BaseRepository(std::unique_ptr<IDatabaseConnection> connection)
 }
 
 QueryResult BaseRepository::ExecuteQuery(const std::string& query, const std::vector<std::any>& params) {
+    return TryExecuteQuery(query, params).ValueOrThrow();
+}
+
+int BaseRepository::ExecuteUpdate(const std::string& query, const std::vector<std::any>& params) {
+    return TryExecuteUpdate(query, params).ValueOrThrow();
+}
+
+Result<QueryResult> BaseRepository::TryExecuteQuery(const std::string& query,
+                                                    const std::vector<std::any>& params) {
     if (!connection_) {
-        throw std::runtime_error("数据库连接为空");
+        return StrategyError(StrategyErrc::NotConnected, "数据库连接为空");
+    }
+    const auto start = std::chrono::steady_clock::now();
+    try {
+        QueryResult result = connection_->ExecuteQuery(query, params);
+        ObserveQuery(query, params, start);
+        return result;
+    } catch (const std::exception& e) {
+        return TranslateDriverError(e);
     }
-    return connection_->ExecuteQuery(query, params);
 }
 
-int BaseRepository::ExecuteUpdate(const std::string& query, const std::vector<std::any>& params) {
+Result<int> BaseRepository::TryExecuteUpdate(const std::string& query,
+                                             const std::vector<std::any>& params) {
+    if (!connection_) {
+        return StrategyError(StrategyErrc::NotConnected, "数据库连接为空");
+    }
+    const auto start = std::chrono::steady_clock::now();
+    try {
+        const int affected = connection_->ExecuteUpdate(query, params);
+        ObserveQuery(query, params, start);
+        return affected;
+    } catch (const std::exception& e) {
+        return TranslateDriverError(e);
+    }
+}
+
+StrategyError BaseRepository::TranslateDriverError(const std::exception& e) {
+    const std::string what(e.what());
+    // 各驱动的约束冲突消息没有统一格式，按关键字归类：
+    // SQLite报 "UNIQUE constraint failed"，PostgreSQL报
+    // "duplicate key value violates unique constraint"，
+    // MySQL报 "Duplicate entry"
+    const bool constraint = what.find("constraint") != std::string::npos
+                         || what.find("UNIQUE") != std::string::npos
+                         || what.find("Duplicate") != std::string::npos
+                         || what.find("duplicate") != std::string::npos;
+    return StrategyError(constraint ? StrategyErrc::ConstraintViolation
+                                    : StrategyErrc::QueryFailed,
+                         "数据库语句执行失败", what);
+}
+
+std::size_t BaseRepository::ExecuteQueryStream(const std::string& query,
+                                               const std::vector<std::any>& params,
+                                               const RowBatchHandler& handler,
+                                               std::size_t batch_size) {
     if (!connection_) {
         throw std::runtime_error("数据库连接为空");
     }
-    return connection_->ExecuteUpdate(query, params);
+    const auto start = std::chrono::steady_clock::now();
+    const std::size_t delivered = connection_->ExecuteQueryStream(query, params, batch_size, handler);
+    ObserveQuery(query, params, start);
+    return delivered;
+}
+
+void BaseRepository::ObserveQuery(const std::string& query,
+                                  const std::vector<std::any>& params,
+                                  std::chrono::steady_clock::time_point start) {
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+
+    auto& monitor = PerformanceMonitor::GetInstance();
+    monitor.GetHistogram(PerformanceMonitor::HISTOGRAM_DB_QUERY).Record(elapsed);
+
+    const double duration_ms =
+        std::chrono::duration_cast<std::chrono::duration<double, std::milli>>(elapsed).count();
+    SlowQueryLog& slow_log = monitor.GetSlowQueryLog();
+    if (!slow_log.IsSlow(duration_ms)) {
+        return;
+    }
+
+    SlowQueryRecord record;
+    record.sql = query;
+    record.duration_ms = duration_ms;
+    record.param_count = params.size();
+    record.captured_at = std::chrono::system_clock::now();
+    if (!IsExplainStatement(query) && slow_log.TryAcquireExplainSlot()) {
+        record.explain_plan = CaptureExplainPlan(query, params);
+    }
+    slow_log.Record(std::move(record));
+}
+
+std::string BaseRepository::CaptureExplainPlan(const std::string& query,
+                                               const std::vector<std::any>& params) {
+    try {
+        const QueryResult rows = connection_->ExecuteQuery("EXPLAIN " + query, params);
+        std::string plan;
+        for (const auto& row : rows) {
+            for (const auto& field : row) {
+                if (const auto* line = std::any_cast<std::string>(&field.second)) {
+                    if (!plan.empty()) {
+                        plan += '\n';
+                    }
+                    plan += *line;
+                }
+            }
+        }
+        return plan;
+    } catch (...) {
+        // 执行计划只是补充信息，失败不影响慢查询记录本身
+        return std::string();
+    }
 }
 
 bool BaseRepository::BeginTransaction() {
@@ -58,4 +192,118 @@ long long BaseRepository::GetLastInsertId() {
     return connection_->GetLastInsertId();
 }
 
+int BaseRepository::ExecuteBulkInsert(const std::string& table,
+                                      const std::vector<std::string>& columns,
+                                      const std::vector<std::vector<std::any>>& rows,
+                                      std::size_t chunk_size) {
+    if (!connection_) {
+        throw std::runtime_error("数据库连接为空");
+    }
+    if (columns.empty()) {
+        throw std::invalid_argument("批量插入的列列表为空");
+    }
+    if (chunk_size == 0) {
+        chunk_size = DEFAULT_BULK_CHUNK_SIZE;
+    }
+
+    std::string column_list;
+    for (std::size_t i = 0; i < columns.size(); ++i) {
+        column_list += (i == 0) ? columns[i] : (", " + columns[i]);
+    }
+    const std::string row_placeholders = BuildRowPlaceholders(columns.size());
+
+    int total_affected = 0;
+    for (std::size_t offset = 0; offset < rows.size(); offset += chunk_size) {
+        const std::size_t count = std::min(chunk_size, rows.size() - offset);
+
+        // 本块：一条多行INSERT语句，一个事务
+        std::string sql = "INSERT INTO " + table + " (" + column_list + ") VALUES ";
+        std::vector<std::any> params;
+        params.reserve(count * columns.size());
+        for (std::size_t i = 0; i < count; ++i) {
+            const std::vector<std::any>& row = rows[offset + i];
+            if (row.size() != columns.size()) {
+                throw std::invalid_argument("批量插入的行宽与列数不匹配");
+            }
+            sql += (i == 0) ? row_placeholders : (", " + row_placeholders);
+            params.insert(params.end(), row.begin(), row.end());
+        }
+
+        BeginTransaction();
+        try {
+            total_affected += ExecuteUpdate(sql, params);
+            CommitTransaction();
+        } catch (...) {
+            RollbackTransaction();
+            throw;
+        }
+    }
+    return total_affected;
+}
+
+int BaseRepository::ExecuteBulkUpdate(const std::string& query,
+                                      const std::vector<std::vector<std::any>>& rows,
+                                      std::size_t chunk_size) {
+    if (!connection_) {
+        throw std::runtime_error("数据库连接为空");
+    }
+    if (chunk_size == 0) {
+        chunk_size = DEFAULT_BULK_CHUNK_SIZE;
+    }
+
+    int total_affected = 0;
+    for (std::size_t offset = 0; offset < rows.size(); offset += chunk_size) {
+        const std::size_t count = std::min(chunk_size, rows.size() - offset);
+
+        // 逐行执行同一语句，但整块共享一个事务，省去逐行提交
+        BeginTransaction();
+        try {
+            for (std::size_t i = 0; i < count; ++i) {
+                total_affected += ExecuteUpdate(query, rows[offset + i]);
+            }
+            CommitTransaction();
+        } catch (...) {
+            RollbackTransaction();
+            throw;
+        }
+    }
+    return total_affected;
+}
+
+int BaseRepository::ExecuteBulkDelete(const std::string& table,
+                                      const std::string& key_column,
+                                      const std::vector<std::any>& keys,
+                                      std::size_t chunk_size) {
+    if (!connection_) {
+        throw std::runtime_error("数据库连接为空");
+    }
+    if (chunk_size == 0) {
+        chunk_size = DEFAULT_BULK_CHUNK_SIZE;
+    }
+
+    int total_affected = 0;
+    for (std::size_t offset = 0; offset < keys.size(); offset += chunk_size) {
+        const std::size_t count = std::min(chunk_size, keys.size() - offset);
+
+        std::string sql = "DELETE FROM " + table + " WHERE " + key_column + " IN (";
+        std::vector<std::any> params;
+        params.reserve(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            sql += (i == 0) ? "?" : ", ?";
+            params.push_back(keys[offset + i]);
+        }
+        sql += ")";
+
+        BeginTransaction();
+        try {
+            total_affected += ExecuteUpdate(sql, params);
+            CommitTransaction();
+        } catch (...) {
+            RollbackTransaction();
+            throw;
+        }
+    }
+    return total_affected;
+}
+
 } // namespace strategy
@@ -3,11 +3,20 @@
  * 说明: 数据库连接池实现
  * 作者: 彭承康
  * 创建时间: 2026-02-18
+ * 更新时间: 2026-08-27 — 无锁快路径、异步获取与等待耗时直方图
+ * 更新时间: 2026-08-28 — 后台健康检查线程，借出路径不再同步探活
+ * 更新时间: 2026-08-28 — 负载自适应池大小：空闲缩到下限，排队涨到上限
  */
 #include "database/ConnectionPool.h"
 #include "database/DatabaseFactory.h"
+#include "monitor/PerformanceMonitor.h"
+#include "sys/GameAssert.h"
+#include <algorithm>
+#include <bit>
+#include <cstdint>
 #include <iostream>
 #include <stdexcept>
+#include <utility>
 
 namespace strategy {
 
@@ -25,7 +34,26 @@ ConnectionPool::ConnectionPool(const DatabaseConfig& config)
     if (max_size_ < min_size_) {
         max_size_ = min_size_;
     }
+    // 软上限从下限起步，由后台线程按负载在[min, max]之间调整
+    target_size_.store(min_size_, std::memory_order_relaxed);
+
+    slots_.resize(max_size_);
+    dead_slots_.reserve(max_size_);
+    for (std::size_t i = max_size_; i > 0; --i) {
+        dead_slots_.push_back(i - 1);
+    }
+
+    // 空闲环容量取不小于池上限的2的幂，便于位运算取模
+    ring_capacity_ = std::bit_ceil(max_size_);
+    free_ring_ = std::make_unique<IndexSlot[]>(ring_capacity_);
+    for (std::size_t i = 0; i < ring_capacity_; ++i) {
+        free_ring_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
     InitializePool();
+
+    // 空闲连接的探活移出借出路径，由后台线程周期性完成
+    health_checker_ = std::thread(&ConnectionPool::HealthCheckLoop, this);
 }
 
 ConnectionPool::~ConnectionPool() {
@@ -38,8 +66,9 @@ void ConnectionPool::InitializePool() {
         try {
             auto conn = CreateConnection();
             if (conn) {
-                available_connections_.push(conn);
-                ++current_size_;
+                const std::size_t index = RegisterConnectionLocked(conn);
+                TryPushIndex(index);
+                available_count_.fetch_add(1, std::memory_order_relaxed);
             }
         } catch (const std::exception& e) {
             std::cerr << "ConnectionPool: 初始化连接失败: " << e.what() << std::endl;
@@ -61,51 +90,366 @@ bool ConnectionPool::IsConnectionHealthy(const std::shared_ptr<IDatabaseConnecti
     return conn && conn->IsConnected();
 }
 
-std::shared_ptr<IDatabaseConnection> ConnectionPool::GetConnection() {
-    std::unique_lock<std::mutex> lock(mutex_);
+bool ConnectionPool::TryPopIndex(std::size_t& index) {
+    std::size_t pos = ring_tail_.load(std::memory_order_relaxed);
+    for (;;) {
+        IndexSlot& slot = free_ring_[pos & (ring_capacity_ - 1)];
+        const std::size_t seq = slot.sequence.load(std::memory_order_acquire);
+        const std::intptr_t diff =
+            static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos + 1);
 
-    if (shutdown_) {
-        throw std::runtime_error("ConnectionPool: 连接池已关闭");
+        if (diff == 0) {
+            if (ring_tail_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                index = slot.index;
+                // 环里只会出现注册过的槽位下标
+                GAME_PARANOID_ASSERT(index < slots_.size());
+                slot.sequence.store(pos + ring_capacity_, std::memory_order_release);
+                return true;
+            }
+        } else if (diff < 0) {
+            // 环空，无空闲连接
+            return false;
+        } else {
+            pos = ring_tail_.load(std::memory_order_relaxed);
+        }
     }
+}
 
-    // Try to get an available connection
-    while (!available_connections_.empty()) {
-        auto conn = available_connections_.front();
-        available_connections_.pop();
+bool ConnectionPool::TryPushIndex(std::size_t index) {
+    GAME_PARANOID_ASSERT(index < slots_.size());
+    std::size_t pos = ring_head_.load(std::memory_order_relaxed);
+    for (;;) {
+        IndexSlot& slot = free_ring_[pos & (ring_capacity_ - 1)];
+        const std::size_t seq = slot.sequence.load(std::memory_order_acquire);
+        const std::intptr_t diff =
+            static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos);
 
-        if (IsConnectionHealthy(conn)) {
-            ++borrowed_count_;
-            return conn;
+        if (diff == 0) {
+            if (ring_head_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                slot.index = index;
+                slot.sequence.store(pos + 1, std::memory_order_release);
+                return true;
+            }
+        } else if (diff < 0) {
+            // 环满：容量不小于池上限，正常不会发生
+            return false;
+        } else {
+            pos = ring_head_.load(std::memory_order_relaxed);
         }
-        // Unhealthy connection, discard it
-        --current_size_;
     }
+}
+
+std::size_t ConnectionPool::RegisterConnectionLocked(std::shared_ptr<IDatabaseConnection> conn) {
+    // 调用方先检查过 current_size_ < max_size_，必有空槽位
+    GAME_DEBUG_ASSERT(!dead_slots_.empty());
+    const std::size_t index = dead_slots_.back();
+    dead_slots_.pop_back();
+    index_of_[conn.get()] = index;
+    slots_[index] = std::move(conn);
+    ++current_size_;
+    return index;
+}
 
-    // No available connections; create a new one if possible
-    if (current_size_ < max_size_) {
+void ConnectionPool::DiscardSlotLocked(std::size_t index) {
+    GAME_DEBUG_ASSERT(index < slots_.size());
+    if (slots_[index]) {
+        index_of_.erase(slots_[index].get());
+        slots_[index]->Disconnect();
+        slots_[index].reset();
+    }
+    dead_slots_.push_back(index);
+    --current_size_;
+}
+
+void ConnectionPool::RecordWaitTime(std::chrono::steady_clock::time_point start) {
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+
+    // 全局延迟直方图（线程本地缓冲，记录路径无锁）
+    static LatencyHistogram& wait_latency =
+        PerformanceMonitor::GetInstance().GetHistogram(PerformanceMonitor::HISTOGRAM_POOL_WAIT);
+    wait_latency.Record(elapsed);
+
+    const long long elapsed_ms =
+        std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count();
+    std::size_t bucket = WAIT_BUCKET_BOUNDS_MS.size();
+    for (std::size_t i = 0; i < WAIT_BUCKET_BOUNDS_MS.size(); ++i) {
+        if (elapsed_ms < WAIT_BUCKET_BOUNDS_MS[i]) {
+            bucket = i;
+            break;
+        }
+    }
+    wait_histogram_[bucket].fetch_add(1, std::memory_order_relaxed);
+}
+
+void ConnectionPool::TopUpToMinimumLocked() {
+    while (current_size_ < min_size_) {
         try {
             auto conn = CreateConnection();
-            ++current_size_;
-            ++borrowed_count_;
-            return conn;
+            const std::size_t index = RegisterConnectionLocked(std::move(conn));
+            TryPushIndex(index);
+            available_count_.fetch_add(1, std::memory_order_relaxed);
         } catch (const std::exception& e) {
-            std::cerr << "ConnectionPool: 创建新连接失败: " << e.what() << std::endl;
+            std::cerr << "ConnectionPool: 预热补充连接失败: " << e.what() << std::endl;
+            break;
+        }
+    }
+}
+
+void ConnectionPool::RequestAdaptation() {
+    {
+        std::lock_guard<std::mutex> lock(checker_mutex_);
+        adapt_requested_ = true;
+    }
+    checker_cv_.notify_all();
+}
+
+void ConnectionPool::AdaptPoolSize() {
+    // 限速：相邻两次调整至少间隔一个冷却期
+    const auto now = std::chrono::steady_clock::now();
+    if (now - last_resize_ < ADAPT_RESIZE_COOLDOWN) {
+        return;
+    }
+
+    const std::uint64_t waits = wait_events_.exchange(0, std::memory_order_relaxed);
+    const std::size_t target = target_size_.load(std::memory_order_relaxed);
+
+    // 扩容：冷却期内出现过排队等待且还没到上限
+    if (waits > 0) {
+        idle_rounds_ = 0;
+        const std::size_t grown = std::min(target + ADAPT_GROW_STEP, max_size_);
+        if (grown != target) {
+            target_size_.store(grown, std::memory_order_relaxed);
+            grow_decisions_.fetch_add(1, std::memory_order_relaxed);
+            PerformanceMonitor::GetInstance()
+                .GetCounter(PerformanceMonitor::COUNTER_POOL_GROW)
+                .fetch_add(1, std::memory_order_relaxed);
+            last_resize_ = now;
+            std::cout << "ConnectionPool: 排队等待 " << waits
+                      << " 次，软上限 " << target << " -> " << grown << std::endl;
+            // 等待中的借出方现在可以创建新连接了
+            condition_.notify_all();
+        }
+        return;
+    }
+
+    // 缩容：连续若干轮无等待且利用率不足软上限一半
+    const std::size_t borrowed = borrowed_count_.load();
+    if (target > min_size_ && borrowed * 2 < target) {
+        if (++idle_rounds_ < ADAPT_SHRINK_IDLE_ROUNDS) {
+            return;
+        }
+        idle_rounds_ = 0;
+        const std::size_t shrunk =
+            std::max(target - ADAPT_SHRINK_STEP, min_size_);
+        target_size_.store(shrunk, std::memory_order_relaxed);
+        shrink_decisions_.fetch_add(1, std::memory_order_relaxed);
+        PerformanceMonitor::GetInstance()
+            .GetCounter(PerformanceMonitor::COUNTER_POOL_SHRINK)
+            .fetch_add(1, std::memory_order_relaxed);
+        last_resize_ = now;
+
+        // 物理关闭多余的空闲连接，释放数据库侧资源；
+        // 借出中的连接不动，归还后自然受新软上限约束
+        std::size_t closed = 0;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            std::size_t index = 0;
+            while (current_size_ > shrunk && TryPopIndex(index)) {
+                available_count_.fetch_sub(1, std::memory_order_relaxed);
+                DiscardSlotLocked(index);
+                ++closed;
+            }
+        }
+        std::cout << "ConnectionPool: 持续空闲，软上限 " << target << " -> "
+                  << shrunk << "，关闭空闲连接 " << closed << " 个" << std::endl;
+    } else {
+        idle_rounds_ = 0;
+    }
+}
+
+void ConnectionPool::HealthCheckLoop() {
+    std::unique_lock<std::mutex> sleep_lock(checker_mutex_);
+    auto next_sweep = std::chrono::steady_clock::now() + HEALTH_CHECK_INTERVAL;
+    while (!shutdown_) {
+        checker_cv_.wait_until(sleep_lock, next_sweep,
+                               [this]() { return shutdown_.load() || adapt_requested_; });
+        if (shutdown_) {
+            break;
+        }
+        adapt_requested_ = false;
+
+        // 自适应调整：巡检到点或借出方因排队提前唤醒时运行，
+        // 内部按冷却期限速
+        AdaptPoolSize();
+
+        if (std::chrono::steady_clock::now() < next_sweep) {
+            continue;
+        }
+        next_sweep = std::chrono::steady_clock::now() + HEALTH_CHECK_INTERVAL;
+
+        // 本轮最多巡检开始时的空闲连接数个：逐个取出探活后
+        // 立即放回，借出方只会观察到瞬时的空闲数抖动
+        std::size_t sweep = available_count_.load(std::memory_order_relaxed);
+        while (sweep-- > 0 && !shutdown_) {
+            std::size_t index = 0;
+            if (!TryPopIndex(index)) {
+                break;
+            }
+            available_count_.fetch_sub(1, std::memory_order_relaxed);
+
+            // 探活发生在互斥锁外，不影响借出/归还路径
+            if (IsConnectionHealthy(slots_[index])) {
+                TryPushIndex(index);
+                available_count_.fetch_add(1, std::memory_order_relaxed);
+                continue;
+            }
+
+            // 失效：原位重建，失败则丢弃槽位
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (shutdown_) {
+                DiscardSlotLocked(index);
+                break;
+            }
+            try {
+                auto fresh = CreateConnection();
+                index_of_.erase(slots_[index].get());
+                index_of_[fresh.get()] = index;
+                slots_[index] = std::move(fresh);
+                TryPushIndex(index);
+                available_count_.fetch_add(1, std::memory_order_relaxed);
+            } catch (const std::exception& e) {
+                std::cerr << "ConnectionPool: 巡检重建连接失败: " << e.what() << std::endl;
+                DiscardSlotLocked(index);
+            }
+        }
+
+        // 丢弃或空闲超时断开后把连接总数补足到最小水位
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!shutdown_) {
+            TopUpToMinimumLocked();
         }
     }
+}
 
-    // Wait for a connection to be returned
-    condition_.wait(lock, [this]() {
-        return !available_connections_.empty() || shutdown_;
-    });
+std::shared_ptr<IDatabaseConnection> ConnectionPool::GetConnection() {
+    return TryGetConnection().ValueOrThrow();
+}
+
+Result<std::shared_ptr<IDatabaseConnection>> ConnectionPool::TryGetConnection() {
+    const auto start = std::chrono::steady_clock::now();
+
+    for (;;) {
+        if (shutdown_) {
+            return StrategyError(StrategyErrc::PoolShutdown, "ConnectionPool: 连接池已关闭");
+        }
+
+        // 快路径：空闲环中有连接时不加互斥锁。
+        // 不做同步探活（MySQL下是一次网络往返），
+        // 空闲连接的健康状况由后台巡检线程保证。
+        std::size_t index = 0;
+        if (TryPopIndex(index)) {
+            available_count_.fetch_sub(1, std::memory_order_relaxed);
+            ++borrowed_count_;
+            RecordWaitTime(start);
+            return slots_[index];
+        }
+
+        // 慢路径：尝试创建新连接，否则等待归还
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (shutdown_) {
+            return StrategyError(StrategyErrc::PoolShutdown, "ConnectionPool: 连接池已关闭");
+        }
+
+        if (current_size_ < target_size_.load(std::memory_order_relaxed)) {
+            try {
+                auto conn = CreateConnection();
+                RegisterConnectionLocked(conn);
+                ++borrowed_count_;
+                RecordWaitTime(start);
+                return conn;
+            } catch (const std::exception& e) {
+                std::cerr << "ConnectionPool: 创建新连接失败: " << e.what() << std::endl;
+            }
+        }
+
+        // 到达软上限仍无空闲连接：记录排队信号并请求提前调整。
+        // RequestAdaptation 要拿 checker_mutex_，须先放开 mutex_
+        // 以保持 checker_mutex_ -> mutex_ 的加锁顺序
+        wait_events_.fetch_add(1, std::memory_order_relaxed);
+        lock.unlock();
+        RequestAdaptation();
+        lock.lock();
+        if (shutdown_) {
+            return StrategyError(StrategyErrc::PoolShutdown, "ConnectionPool: 连接池已关闭");
+        }
+
+        // 周期性轮询空闲环，避免无锁归还路径与条件变量之间丢失唤醒
+        bool popped = false;
+        condition_.wait_for(lock, WAIT_POLL_INTERVAL, [&]() {
+            if (!popped) {
+                popped = TryPopIndex(index);
+            }
+            return popped || shutdown_.load();
+        });
+
+        if (popped) {
+            available_count_.fetch_sub(1, std::memory_order_relaxed);
+            ++borrowed_count_;
+            RecordWaitTime(start);
+            return slots_[index];
+        }
+    }
+}
+
+std::future<std::shared_ptr<IDatabaseConnection>> ConnectionPool::GetConnectionAsync() {
+    std::promise<std::shared_ptr<IDatabaseConnection>> promise;
+    auto future = promise.get_future();
+    const auto start = std::chrono::steady_clock::now();
 
     if (shutdown_) {
-        throw std::runtime_error("ConnectionPool: 连接池已关闭");
+        promise.set_exception(std::make_exception_ptr(
+            std::runtime_error("ConnectionPool: 连接池已关闭")));
+        return future;
+    }
+
+    // 快路径：立即满足（同样不做同步探活）
+    std::size_t index = 0;
+    if (TryPopIndex(index)) {
+        available_count_.fetch_sub(1, std::memory_order_relaxed);
+        ++borrowed_count_;
+        RecordWaitTime(start);
+        promise.set_value(slots_[index]);
+        return future;
     }
 
-    auto conn = available_connections_.front();
-    available_connections_.pop();
-    ++borrowed_count_;
-    return conn;
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (shutdown_) {
+        promise.set_exception(std::make_exception_ptr(
+            std::runtime_error("ConnectionPool: 连接池已关闭")));
+        return future;
+    }
+
+    if (current_size_ < target_size_.load(std::memory_order_relaxed)) {
+        try {
+            auto conn = CreateConnection();
+            RegisterConnectionLocked(conn);
+            ++borrowed_count_;
+            RecordWaitTime(start);
+            lock.unlock();
+            promise.set_value(std::move(conn));
+            return future;
+        } catch (const std::exception& e) {
+            std::cerr << "ConnectionPool: 创建新连接失败: " << e.what() << std::endl;
+        }
+    }
+
+    // 池耗尽：挂入等待队列，归还时按顺序满足，调用线程不阻塞；
+    // 排队同时作为负载信号推动软上限上调
+    async_waiters_.push_back(AsyncWaiter{std::move(promise), start});
+    wait_events_.fetch_add(1, std::memory_order_relaxed);
+    lock.unlock();
+    RequestAdaptation();
+    return future;
 }
 
 void ConnectionPool::ReturnConnection(std::shared_ptr<IDatabaseConnection> conn) {
@@ -113,46 +457,105 @@ void ConnectionPool::ReturnConnection(std::shared_ptr<IDatabaseConnection> conn)
         throw std::invalid_argument("ConnectionPool: 归还的连接为空");
     }
 
-    std::lock_guard<std::mutex> lock(mutex_);
+    std::unique_lock<std::mutex> lock(mutex_);
     --borrowed_count_;
 
     if (shutdown_) {
-        --current_size_;
+        auto it = index_of_.find(conn.get());
+        if (it != index_of_.end()) {
+            DiscardSlotLocked(it->second);
+        }
+        return;
+    }
+
+    // 有异步等待者时直接转交，连接保持借出状态
+    if (!async_waiters_.empty() && IsConnectionHealthy(conn)) {
+        AsyncWaiter waiter = std::move(async_waiters_.front());
+        async_waiters_.pop_front();
+        ++borrowed_count_;
+        RecordWaitTime(waiter.start);
+        lock.unlock();
+        waiter.promise.set_value(std::move(conn));
+        return;
+    }
+
+    auto it = index_of_.find(conn.get());
+    if (it == index_of_.end()) {
         return;
     }
+    const std::size_t index = it->second;
 
     if (IsConnectionHealthy(conn)) {
-        available_connections_.push(conn);
+        TryPushIndex(index);
+        available_count_.fetch_add(1, std::memory_order_relaxed);
     } else {
-        --current_size_;
+        // 尝试原位重连补充，失败则丢弃槽位
+        try {
+            auto fresh = CreateConnection();
+            index_of_.erase(it);
+            index_of_[fresh.get()] = index;
+            slots_[index] = std::move(fresh);
+            TryPushIndex(index);
+            available_count_.fetch_add(1, std::memory_order_relaxed);
+        } catch (const std::exception& e) {
+            std::cerr << "ConnectionPool: 连接补充失败: " << e.what() << std::endl;
+            DiscardSlotLocked(index);
+            return;
+        }
     }
 
+    lock.unlock();
     condition_.notify_one();
 }
 
-std::pair<size_t, size_t> ConnectionPool::GetPoolStatus() const {
-    std::lock_guard<std::mutex> lock(mutex_);
-    return {current_size_.load(), available_connections_.size()};
+PoolStatus ConnectionPool::GetPoolStatus() const {
+    PoolStatus status;
+    status.total_connections = current_size_.load();
+    status.available_connections = available_count_.load(std::memory_order_relaxed);
+    status.target_size = target_size_.load(std::memory_order_relaxed);
+    status.grow_decisions = grow_decisions_.load(std::memory_order_relaxed);
+    status.shrink_decisions = shrink_decisions_.load(std::memory_order_relaxed);
+    for (std::size_t i = 0; i < WAIT_BUCKET_COUNT; ++i) {
+        status.wait_time_buckets[i] = wait_histogram_[i].load(std::memory_order_relaxed);
+    }
+    return status;
 }
 
 void ConnectionPool::Shutdown() {
+    std::deque<AsyncWaiter> waiters;
     {
         std::lock_guard<std::mutex> lock(mutex_);
         if (shutdown_) {
             return;
         }
         shutdown_ = true;
+        waiters.swap(async_waiters_);
     }
 
     condition_.notify_all();
 
-    // Drain the queue
+    // 唤醒并回收健康检查线程（先短暂持锁，避免唤醒丢失）
+    {
+        std::lock_guard<std::mutex> checker_lock(checker_mutex_);
+    }
+    checker_cv_.notify_all();
+    if (health_checker_.joinable()) {
+        health_checker_.join();
+    }
+
+    // 挂起的异步请求以异常结束
+    for (auto& waiter : waiters) {
+        waiter.promise.set_exception(std::make_exception_ptr(
+            std::runtime_error("ConnectionPool: 连接池已关闭")));
+    }
+
+    // 清空空闲环并关闭所有连接
     std::lock_guard<std::mutex> lock(mutex_);
-    while (!available_connections_.empty()) {
-        auto conn = available_connections_.front();
-        available_connections_.pop();
-        if (conn) {
-            conn->Disconnect();
+    std::size_t index = 0;
+    while (TryPopIndex(index)) {
+        available_count_.fetch_sub(1, std::memory_order_relaxed);
+        if (slots_[index]) {
+            DiscardSlotLocked(index);
         }
     }
     current_size_ = 0;
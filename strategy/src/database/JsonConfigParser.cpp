@@ -9,10 +9,470 @@
 #include <sstream>
 #include <iostream>
 #include <algorithm>
+#include <cctype>
+#include <cstddef>
+#include <cstdio>
 #include <cstdlib>
 
+// x86-64平台编译SIMD扫描路径，运行时按CPUID选择
+#if defined(__x86_64__) || defined(_M_X64)
+#define STRATEGY_JSON_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define STRATEGY_JSON_TARGET_AVX2
+#else
+#include <cpuid.h>
+#define STRATEGY_JSON_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
+
 namespace strategy {
 
+namespace {
+
+// ============ SIMD字节分类（字符串与空白扫描的快路径） ============
+//
+// 解析器的热点是字符串内容和缩进空白的逐字节循环。这里按
+// simdjson stage-1的思路做字节分类：一次比较一整个寄存器宽度，
+// 返回首个"特殊"字节（字符串中的引号/反斜杠，或首个非空白）
+// 的下标，之间的普通字节由调用方整段处理。SSE2是x86-64基线
+// 直接使用；AVX2版本经运行时CPUID检测选择。
+
+#ifdef STRATEGY_JSON_X86
+
+inline std::size_t CountTrailingZeros(unsigned int mask) {
+#if defined(_MSC_VER)
+    unsigned long index = 0;
+    _BitScanForward(&index, mask);
+    return static_cast<std::size_t>(index);
+#else
+    return static_cast<std::size_t>(__builtin_ctz(mask));
+#endif
+}
+
+bool DetectAvx2() {
+    unsigned int ebx = 0;
+#if defined(_MSC_VER)
+    int regs[4] = {0, 0, 0, 0};
+    __cpuidex(regs, 7, 0);
+    ebx = static_cast<unsigned int>(regs[1]);
+#else
+    unsigned int eax = 0;
+    unsigned int ecx = 0;
+    unsigned int edx = 0;
+    if (!__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx)) {
+        return false;
+    }
+#endif
+    return (ebx & (1u << 5)) != 0;
+}
+
+bool HasAvx2() {
+    static const bool avx2 = DetectAvx2();
+    return avx2;
+}
+
+// 尾部不足一个寄存器宽度时的标量收尾
+std::size_t FindStringSpecialScalarTail(const char* data, std::size_t len) {
+    for (std::size_t i = 0; i < len; ++i) {
+        if (data[i] == '"' || data[i] == '\\') {
+            return i;
+        }
+    }
+    return len;
+}
+
+std::size_t FindStringSpecialSse2(const char* data, std::size_t len) {
+    const __m128i quote = _mm_set1_epi8('"');
+    const __m128i backslash = _mm_set1_epi8('\\');
+    std::size_t i = 0;
+    for (; i + 16 <= len; i += 16) {
+        const __m128i chunk =
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        const __m128i hits = _mm_or_si128(_mm_cmpeq_epi8(chunk, quote),
+                                          _mm_cmpeq_epi8(chunk, backslash));
+        const unsigned int mask =
+            static_cast<unsigned int>(_mm_movemask_epi8(hits));
+        if (mask != 0) {
+            return i + CountTrailingZeros(mask);
+        }
+    }
+    return i + FindStringSpecialScalarTail(data + i, len - i);
+}
+
+STRATEGY_JSON_TARGET_AVX2
+std::size_t FindStringSpecialAvx2(const char* data, std::size_t len) {
+    const __m256i quote = _mm256_set1_epi8('"');
+    const __m256i backslash = _mm256_set1_epi8('\\');
+    std::size_t i = 0;
+    for (; i + 32 <= len; i += 32) {
+        const __m256i chunk =
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+        const __m256i hits = _mm256_or_si256(_mm256_cmpeq_epi8(chunk, quote),
+                                             _mm256_cmpeq_epi8(chunk, backslash));
+        const unsigned int mask =
+            static_cast<unsigned int>(_mm256_movemask_epi8(hits));
+        if (mask != 0) {
+            return i + CountTrailingZeros(mask);
+        }
+    }
+    return i + FindStringSpecialSse2(data + i, len - i);
+}
+
+std::size_t FindNonWhitespaceScalarTail(const char* data, std::size_t len) {
+    for (std::size_t i = 0; i < len; ++i) {
+        const char c = data[i];
+        if (c != ' ' && c != '\t' && c != '\n' && c != '\r') {
+            return i;
+        }
+    }
+    return len;
+}
+
+std::size_t FindNonWhitespaceSse2(const char* data, std::size_t len) {
+    const __m128i space = _mm_set1_epi8(' ');
+    const __m128i tab = _mm_set1_epi8('\t');
+    const __m128i newline = _mm_set1_epi8('\n');
+    const __m128i carriage = _mm_set1_epi8('\r');
+    std::size_t i = 0;
+    for (; i + 16 <= len; i += 16) {
+        const __m128i chunk =
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        const __m128i ws = _mm_or_si128(
+            _mm_or_si128(_mm_cmpeq_epi8(chunk, space), _mm_cmpeq_epi8(chunk, tab)),
+            _mm_or_si128(_mm_cmpeq_epi8(chunk, newline),
+                         _mm_cmpeq_epi8(chunk, carriage)));
+        const unsigned int mask =
+            static_cast<unsigned int>(_mm_movemask_epi8(ws)) ^ 0xFFFFu;
+        if (mask != 0) {
+            return i + CountTrailingZeros(mask);
+        }
+    }
+    return i + FindNonWhitespaceScalarTail(data + i, len - i);
+}
+
+STRATEGY_JSON_TARGET_AVX2
+std::size_t FindNonWhitespaceAvx2(const char* data, std::size_t len) {
+    const __m256i space = _mm256_set1_epi8(' ');
+    const __m256i tab = _mm256_set1_epi8('\t');
+    const __m256i newline = _mm256_set1_epi8('\n');
+    const __m256i carriage = _mm256_set1_epi8('\r');
+    std::size_t i = 0;
+    for (; i + 32 <= len; i += 32) {
+        const __m256i chunk =
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+        const __m256i ws = _mm256_or_si256(
+            _mm256_or_si256(_mm256_cmpeq_epi8(chunk, space),
+                            _mm256_cmpeq_epi8(chunk, tab)),
+            _mm256_or_si256(_mm256_cmpeq_epi8(chunk, newline),
+                            _mm256_cmpeq_epi8(chunk, carriage)));
+        const unsigned int mask =
+            ~static_cast<unsigned int>(_mm256_movemask_epi8(ws));
+        if (mask != 0) {
+            return i + CountTrailingZeros(mask);
+        }
+    }
+    return i + FindNonWhitespaceSse2(data + i, len - i);
+}
+
+// 首个引号或反斜杠的下标；不存在时返回len
+std::size_t FindStringSpecial(const char* data, std::size_t len) {
+    using ScanFn = std::size_t (*)(const char*, std::size_t);
+    static const ScanFn scan =
+        HasAvx2() ? FindStringSpecialAvx2 : FindStringSpecialSse2;
+    return scan(data, len);
+}
+
+// 首个非空白字符的下标；全是空白时返回len
+std::size_t FindNonWhitespace(const char* data, std::size_t len) {
+    using ScanFn = std::size_t (*)(const char*, std::size_t);
+    static const ScanFn scan =
+        HasAvx2() ? FindNonWhitespaceAvx2 : FindNonWhitespaceSse2;
+    return scan(data, len);
+}
+
+#else // !STRATEGY_JSON_X86
+
+std::size_t FindStringSpecial(const char* data, std::size_t len) {
+    for (std::size_t i = 0; i < len; ++i) {
+        if (data[i] == '"' || data[i] == '\\') {
+            return i;
+        }
+    }
+    return len;
+}
+
+std::size_t FindNonWhitespace(const char* data, std::size_t len) {
+    for (std::size_t i = 0; i < len; ++i) {
+        const char c = data[i];
+        if (c != ' ' && c != '\t' && c != '\n' && c != '\r') {
+            return i;
+        }
+    }
+    return len;
+}
+
+#endif // STRATEGY_JSON_X86
+
+/**
+ * @brief SAX式JSON扫描器
+ *
+ * 递归下降的单遍解析：不分配任何树节点，标量值经
+ * 路径过滤后直接回调。路径用点分形式拼接，数组元素带下标。
+ *
+ * 输入按块读入内部缓冲区，字符串内容和空白跳过在缓冲区内
+ * 用上面的SIMD分类批量推进，普通字节整段追加而非逐字符分支；
+ * 转义处理与值解析逻辑保持逐字符语义不变。
+ */
+class JsonStreamScanner {
+public:
+    JsonStreamScanner(std::istream& input,
+                      const JsonConfigParser::JsonValueCallback& callback,
+                      const std::vector<std::string>& path_filter)
+        : input_(input), callback_(callback), path_filter_(path_filter) {}
+
+    void Run() {
+        SkipWhitespace();
+        ParseValue("");
+        SkipWhitespace();
+        if (Peek() != EOF) {
+            throw JsonParseException("文档结尾有多余内容");
+        }
+    }
+
+private:
+    static constexpr std::size_t CHUNK_SIZE = 4096;
+
+    // 保证缓冲区内至少有一个未消费字节；输入耗尽时返回false
+    bool FillBuffer() {
+        if (pos_ < buffer_.size()) {
+            return true;
+        }
+        if (eof_) {
+            return false;
+        }
+        buffer_.resize(CHUNK_SIZE);
+        input_.read(buffer_.data(), static_cast<std::streamsize>(CHUNK_SIZE));
+        buffer_.resize(static_cast<std::size_t>(input_.gcount()));
+        pos_ = 0;
+        if (buffer_.empty()) {
+            eof_ = true;
+            return false;
+        }
+        return true;
+    }
+
+    int Peek() {
+        if (!FillBuffer()) {
+            return EOF;
+        }
+        return static_cast<unsigned char>(buffer_[pos_]);
+    }
+
+    int Next() {
+        if (!FillBuffer()) {
+            throw JsonParseException("输入意外结束");
+        }
+        return static_cast<unsigned char>(buffer_[pos_++]);
+    }
+
+    void SkipWhitespace() {
+        while (FillBuffer()) {
+            pos_ += FindNonWhitespace(buffer_.data() + pos_, buffer_.size() - pos_);
+            if (pos_ < buffer_.size()) {
+                return;
+            }
+        }
+    }
+
+    void Expect(char expected) {
+        const int c = Next();
+        if (c != expected) {
+            throw JsonParseException(std::string("期望字符 '") + expected + "'");
+        }
+    }
+
+    // 过滤：路径等于某前缀、位于前缀之下、或是前缀的祖先（后者不回调但需继续下钻）
+    bool PathEmits(const std::string& path) const {
+        if (path_filter_.empty()) {
+            return true;
+        }
+        for (const std::string& prefix : path_filter_) {
+            if (path == prefix ||
+                (path.size() > prefix.size() && path.compare(0, prefix.size(), prefix) == 0 &&
+                 (path[prefix.size()] == '.' || path[prefix.size()] == '['))) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void Emit(const std::string& path, JsonValueType type, const std::string& value) {
+        if (callback_ && PathEmits(path)) {
+            callback_(path, type, value);
+        }
+    }
+
+    std::string ParseString() {
+        Expect('"');
+        std::string result;
+        for (;;) {
+            if (!FillBuffer()) {
+                throw JsonParseException("输入意外结束");
+            }
+            // 快路径：在当前块内定位下一个引号或反斜杠，
+            // 之间的普通字节整段追加
+            const char* base = buffer_.data() + pos_;
+            const std::size_t remaining = buffer_.size() - pos_;
+            const std::size_t special = FindStringSpecial(base, remaining);
+            if (special > 0) {
+                result.append(base, special);
+                pos_ += special;
+                if (special == remaining) {
+                    continue; // 特殊字符落在下一块
+                }
+            }
+            // 扫描保证此处只可能是引号或反斜杠
+            const int c = Next();
+            if (c == '"') {
+                return result;
+            }
+            {
+                const int escaped = Next();
+                switch (escaped) {
+                    case '"': result += '"'; break;
+                    case '\\': result += '\\'; break;
+                    case '/': result += '/'; break;
+                    case 'b': result += '\b'; break;
+                    case 'f': result += '\f'; break;
+                    case 'n': result += '\n'; break;
+                    case 'r': result += '\r'; break;
+                    case 't': result += '\t'; break;
+                    case 'u':
+                        // \uXXXX 原样传出，配置值中极少出现
+                        result += "\\u";
+                        break;
+                    default:
+                        throw JsonParseException("非法转义字符");
+                }
+            }
+        }
+    }
+
+    void ParseObject(const std::string& path) {
+        Expect('{');
+        SkipWhitespace();
+        if (Peek() == '}') {
+            Next();
+            return;
+        }
+        for (;;) {
+            SkipWhitespace();
+            const std::string key = ParseString();
+            SkipWhitespace();
+            Expect(':');
+            SkipWhitespace();
+            ParseValue(path.empty() ? key : path + "." + key);
+            SkipWhitespace();
+            const int c = Next();
+            if (c == '}') {
+                return;
+            }
+            if (c != ',') {
+                throw JsonParseException("对象成员之间期望 ','");
+            }
+        }
+    }
+
+    void ParseArray(const std::string& path) {
+        Expect('[');
+        SkipWhitespace();
+        if (Peek() == ']') {
+            Next();
+            return;
+        }
+        std::size_t index = 0;
+        for (;;) {
+            SkipWhitespace();
+            ParseValue(path + "[" + std::to_string(index) + "]");
+            ++index;
+            SkipWhitespace();
+            const int c = Next();
+            if (c == ']') {
+                return;
+            }
+            if (c != ',') {
+                throw JsonParseException("数组元素之间期望 ','");
+            }
+        }
+    }
+
+    void ParseLiteral(const std::string& path, const std::string& literal,
+                      JsonValueType type) {
+        for (const char expected : literal) {
+            if (Next() != expected) {
+                throw JsonParseException("非法字面量");
+            }
+        }
+        Emit(path, type, literal);
+    }
+
+    void ParseNumber(const std::string& path) {
+        std::string text;
+        int c = Peek();
+        while (c != EOF && (std::isdigit(c) != 0 || c == '-' || c == '+' ||
+                            c == '.' || c == 'e' || c == 'E')) {
+            text += static_cast<char>(Next());
+            c = Peek();
+        }
+        if (text.empty()) {
+            throw JsonParseException("非法数字");
+        }
+        Emit(path, JsonValueType::Number, text);
+    }
+
+    void ParseValue(const std::string& path) {
+        switch (Peek()) {
+            case '{': ParseObject(path); break;
+            case '[': ParseArray(path); break;
+            case '"': Emit(path, JsonValueType::String, ParseString()); break;
+            case 't': ParseLiteral(path, "true", JsonValueType::Boolean); break;
+            case 'f': ParseLiteral(path, "false", JsonValueType::Boolean); break;
+            case 'n': ParseLiteral(path, "null", JsonValueType::Null); break;
+            default: ParseNumber(path); break;
+        }
+    }
+
+    std::istream& input_;
+    const JsonConfigParser::JsonValueCallback& callback_;
+    const std::vector<std::string>& path_filter_;
+    std::string buffer_;
+    std::size_t pos_ = 0;
+    bool eof_ = false;
+};
+
+} // namespace
+
+void JsonConfigParser::ParseStream(std::istream& input,
+                                   const JsonValueCallback& callback,
+                                   const std::vector<std::string>& path_filter) {
+    JsonStreamScanner scanner(input, callback, path_filter);
+    scanner.Run();
+}
+
+std::map<std::string, std::string>
+JsonConfigParser::ExtractPaths(std::istream& input, const std::vector<std::string>& paths) {
+    std::map<std::string, std::string> values;
+    ParseStream(
+        input,
+        [&values](const std::string& path, JsonValueType, const std::string& value) {
+            values[path] = value;
+        },
+        paths);
+    return values;
+}
+
 std::string JsonConfigParser::ExtractStringValue(const std::string& json, const std::string& key) {
     std::string search = "\"" + key + "\"";
     size_t pos = json.find(search);
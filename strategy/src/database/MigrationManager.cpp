@@ -3,11 +3,16 @@
  * 说明: 数据库迁移管理器实现
  * 作者: 彭承康
  * 创建时间: 2026-02-18
+ * 更新时间: 2026-08-28 — 依赖感知并行执行与分块可恢复回填
  */
 #include "database/MigrationManager.h"
+#include <atomic>
 #include <iostream>
 #include <stdexcept>
 #include <algorithm>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
 
 namespace strategy {
 
@@ -68,7 +73,8 @@ void MigrationManager::LoadSQLiteMigrations() {
         "  save_data TEXT NOT NULL,"
         "  created_at TEXT DEFAULT CURRENT_TIMESTAMP"
         ");",
-        "DROP TABLE IF EXISTS game_saves;"
+        "DROP TABLE IF EXISTS game_saves;",
+        {1}  // 外键引用players表
     });
 }
 
@@ -99,7 +105,8 @@ void MigrationManager::LoadPostgreSQLMigrations() {
         "  save_data TEXT NOT NULL,"
         "  created_at TIMESTAMP DEFAULT CURRENT_TIMESTAMP"
         ");",
-        "DROP TABLE IF EXISTS game_saves;"
+        "DROP TABLE IF EXISTS game_saves;",
+        {1}  // 外键引用players表
     });
 }
 
@@ -144,39 +151,296 @@ int MigrationManager::GetCurrentVersion() {
     return 0;
 }
 
-bool MigrationManager::RunMigrations() {
+std::vector<int> MigrationManager::GetAppliedVersions() {
+    std::vector<int> applied;
+    try {
+        auto result = connection_->ExecuteQuery(
+            "SELECT version FROM schema_migrations;"
+        );
+        for (const auto& row : result) {
+            auto it = row.find("version");
+            if (it != row.end()) {
+                applied.push_back(static_cast<int>(std::any_cast<long long>(it->second)));
+            }
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "MigrationManager: 查询已执行版本失败: " << e.what() << std::endl;
+    }
+    return applied;
+}
+
+void MigrationManager::SetBackfillPacing(long long chunk_size, std::chrono::milliseconds throttle) {
+    if (chunk_size <= 0) {
+        throw std::invalid_argument("MigrationManager: 回填分块大小必须为正");
+    }
+    backfill_chunk_size_ = chunk_size;
+    backfill_throttle_ = throttle;
+}
+
+bool MigrationManager::CreateBackfillProgressTable(const std::shared_ptr<IDatabaseConnection>& conn) {
+    try {
+        std::string sql;
+        if (db_type_ == DatabaseType::SQLITE) {
+            sql = "CREATE TABLE IF NOT EXISTS migration_backfill_progress ("
+                  "  version INTEGER PRIMARY KEY,"
+                  "  last_done_id INTEGER NOT NULL,"
+                  "  updated_at TEXT DEFAULT CURRENT_TIMESTAMP"
+                  ");";
+        } else {
+            sql = "CREATE TABLE IF NOT EXISTS migration_backfill_progress ("
+                  "  version INT PRIMARY KEY,"
+                  "  last_done_id BIGINT NOT NULL,"
+                  "  updated_at TIMESTAMP DEFAULT CURRENT_TIMESTAMP"
+                  ");";
+        }
+        conn->ExecuteUpdate(sql);
+        return true;
+    } catch (const std::exception& e) {
+        std::cerr << "MigrationManager: 创建回填进度表失败: " << e.what() << std::endl;
+        return false;
+    }
+}
+
+bool MigrationManager::RunBackfillMigration(const std::shared_ptr<IDatabaseConnection>& conn,
+                                            const Migration& migration) {
+    if (migration.backfill_max_id_sql.empty() || migration.backfill_chunk_sql.empty()) {
+        std::cerr << "MigrationManager: 回填迁移 v" << migration.version
+                  << " 缺少分块SQL" << std::endl;
+        return false;
+    }
+    if (!CreateBackfillProgressTable(conn)) {
+        return false;
+    }
+
+    try {
+        // 回填上界在开始时确定一次，之后新插入的行由应用层写入路径保证
+        long long max_id = 0;
+        auto max_result = conn->ExecuteQuery(migration.backfill_max_id_sql);
+        if (!max_result.empty()) {
+            auto it = max_result[0].find("max_id");
+            if (it != max_result[0].end()) {
+                max_id = std::any_cast<long long>(it->second);
+            }
+        }
+
+        // 上次中断的进度：从最后提交的块之后继续
+        long long last_done = 0;
+        auto progress = conn->ExecuteQuery(
+            "SELECT last_done_id FROM migration_backfill_progress WHERE version = $1;",
+            {std::any(migration.version)}
+        );
+        if (!progress.empty()) {
+            auto it = progress[0].find("last_done_id");
+            if (it != progress[0].end()) {
+                last_done = std::any_cast<long long>(it->second);
+                std::cout << "MigrationManager: 回填 v" << migration.version
+                          << " 从 id=" << last_done << " 处恢复" << std::endl;
+            }
+        } else {
+            conn->ExecuteUpdate(
+                "INSERT INTO migration_backfill_progress (version, last_done_id) VALUES ($1, 0);",
+                {std::any(migration.version)}
+            );
+        }
+
+        while (last_done < max_id) {
+            long long chunk_end = std::min(last_done + backfill_chunk_size_, max_id);
+
+            // 每块一个小事务：回填区间 + 进度推进一起提交，保证可恢复
+            conn->BeginTransaction();
+            conn->ExecuteUpdate(migration.backfill_chunk_sql,
+                                {std::any(last_done), std::any(chunk_end)});
+            conn->ExecuteUpdate(
+                "UPDATE migration_backfill_progress SET last_done_id = $1, "
+                "updated_at = CURRENT_TIMESTAMP WHERE version = $2;",
+                {std::any(chunk_end), std::any(migration.version)}
+            );
+            conn->CommitTransaction();
+
+            last_done = chunk_end;
+
+            // 块间停顿，让路给线上流量
+            if (last_done < max_id && backfill_throttle_.count() > 0) {
+                std::this_thread::sleep_for(backfill_throttle_);
+            }
+        }
+
+        // 全部块完成：写迁移历史并清理进度行
+        conn->BeginTransaction();
+        conn->ExecuteUpdate(
+            "INSERT INTO schema_migrations (version, description) VALUES ($1, $2);",
+            {std::any(migration.version), std::any(migration.description)}
+        );
+        conn->ExecuteUpdate(
+            "DELETE FROM migration_backfill_progress WHERE version = $1;",
+            {std::any(migration.version)}
+        );
+        conn->CommitTransaction();
+        return true;
+
+    } catch (const std::exception& e) {
+        std::cerr << "MigrationManager: 回填迁移 v" << migration.version
+                  << " 失败: " << e.what() << std::endl;
+        conn->RollbackTransaction();
+        return false;
+    }
+}
+
+bool MigrationManager::ApplyMigration(const std::shared_ptr<IDatabaseConnection>& conn,
+                                      const Migration& migration) {
+    std::cout << "MigrationManager: 执行迁移 v" << migration.version
+              << ": " << migration.description << std::endl;
+
+    if (migration.is_backfill) {
+        return RunBackfillMigration(conn, migration);
+    }
+
+    try {
+        conn->BeginTransaction();
+
+        conn->ExecuteUpdate(migration.up_sql);
+
+        conn->ExecuteUpdate(
+            "INSERT INTO schema_migrations (version, description) VALUES ($1, $2);",
+            {std::any(migration.version), std::any(migration.description)}
+        );
+
+        conn->CommitTransaction();
+        std::cout << "MigrationManager: 迁移 v" << migration.version << " 成功" << std::endl;
+        return true;
+
+    } catch (const std::exception& e) {
+        std::cerr << "MigrationManager: 迁移 v" << migration.version
+                  << " 失败: " << e.what() << std::endl;
+        conn->RollbackTransaction();
+        return false;
+    }
+}
+
+bool MigrationManager::BuildExecutionWaves(const std::vector<const Migration*>& pending,
+                                           std::vector<std::vector<const Migration*>>& waves) const {
+    // 已执行或不在待处理集中的依赖视为已满足
+    std::unordered_map<int, const Migration*> by_version;
+    for (const auto* m : pending) {
+        by_version[m->version] = m;
+    }
+
+    std::unordered_set<int> done;
+    std::vector<const Migration*> remaining = pending;
+
+    while (!remaining.empty()) {
+        std::vector<const Migration*> wave;
+        std::vector<const Migration*> next_remaining;
+
+        for (const auto* m : remaining) {
+            bool ready = true;
+            for (int dep : m->depends_on) {
+                if (by_version.count(dep) != 0 && done.count(dep) == 0) {
+                    ready = false;
+                    break;
+                }
+            }
+            (ready ? wave : next_remaining).push_back(m);
+        }
+
+        if (wave.empty()) {
+            // 没有任何迁移可调度：依赖声明形成环
+            std::cerr << "MigrationManager: 迁移依赖存在环，无法调度" << std::endl;
+            return false;
+        }
+
+        for (const auto* m : wave) {
+            done.insert(m->version);
+        }
+        waves.push_back(std::move(wave));
+        remaining = std::move(next_remaining);
+    }
+
+    return true;
+}
+
+bool MigrationManager::RunMigrationsParallel(
+    const std::vector<std::shared_ptr<IDatabaseConnection>>& connections) {
+    if (connections.empty()) {
+        return RunMigrations();
+    }
+
     if (!CreateMigrationTable()) {
         return false;
     }
 
-    int current_version = GetCurrentVersion();
-    std::cout << "MigrationManager: 当前数据库版本: " << current_version << std::endl;
+    auto applied = GetAppliedVersions();
+    std::unordered_set<int> applied_set(applied.begin(), applied.end());
 
+    std::vector<const Migration*> pending;
     for (const auto& migration : migrations_) {
-        if (migration.version <= current_version) {
-            continue;
+        if (applied_set.count(migration.version) == 0) {
+            pending.push_back(&migration);
+        }
+    }
+    if (pending.empty()) {
+        std::cout << "MigrationManager: 无待处理迁移" << std::endl;
+        return true;
+    }
+
+    std::vector<std::vector<const Migration*>> waves;
+    if (!BuildExecutionWaves(pending, waves)) {
+        return false;
+    }
+
+    for (const auto& wave : waves) {
+        std::cout << "MigrationManager: 并行执行一波 " << wave.size()
+                  << " 个迁移，连接数 " << connections.size() << std::endl;
+
+        std::atomic<bool> wave_ok{true};
+        std::atomic<std::size_t> next_index{0};
+        std::vector<std::thread> workers;
+        std::size_t worker_count = std::min(connections.size(), wave.size());
+
+        for (std::size_t w = 0; w < worker_count; ++w) {
+            workers.emplace_back([this, &wave, &wave_ok, &next_index, conn = connections[w]]() {
+                // 每个工作线程独占一条连接，按序领取本波内的迁移
+                while (wave_ok.load(std::memory_order_acquire)) {
+                    std::size_t index = next_index.fetch_add(1, std::memory_order_relaxed);
+                    if (index >= wave.size()) {
+                        break;
+                    }
+                    if (!ApplyMigration(conn, *wave[index])) {
+                        wave_ok.store(false, std::memory_order_release);
+                    }
+                }
+            });
+        }
+        for (auto& worker : workers) {
+            worker.join();
         }
 
-        std::cout << "MigrationManager: 执行迁移 v" << migration.version
-                  << ": " << migration.description << std::endl;
+        if (!wave_ok.load(std::memory_order_acquire)) {
+            std::cerr << "MigrationManager: 本波迁移失败，停止调度后续波" << std::endl;
+            return false;
+        }
+    }
 
-        try {
-            connection_->BeginTransaction();
+    std::cout << "MigrationManager: 所有迁移完成" << std::endl;
+    return true;
+}
 
-            connection_->ExecuteUpdate(migration.up_sql);
+bool MigrationManager::RunMigrations() {
+    if (!CreateMigrationTable()) {
+        return false;
+    }
 
-            connection_->ExecuteUpdate(
-                "INSERT INTO schema_migrations (version, description) VALUES ($1, $2);",
-                {std::any(migration.version), std::any(migration.description)}
-            );
+    int current_version = GetCurrentVersion();
+    std::cout << "MigrationManager: 当前数据库版本: " << current_version << std::endl;
 
-            connection_->CommitTransaction();
-            std::cout << "MigrationManager: 迁移 v" << migration.version << " 成功" << std::endl;
+    auto applied = GetAppliedVersions();
+    std::unordered_set<int> applied_set(applied.begin(), applied.end());
 
-        } catch (const std::exception& e) {
-            std::cerr << "MigrationManager: 迁移 v" << migration.version
-                      << " 失败: " << e.what() << std::endl;
-            connection_->RollbackTransaction();
+    for (const auto& migration : migrations_) {
+        if (applied_set.count(migration.version) != 0) {
+            continue;
+        }
+        if (!ApplyMigration(connection_, migration)) {
             return false;
         }
     }
@@ -8,11 +8,47 @@
 #include "database/PostgreSQLConnection.h"
 
 #include <iostream>
+#include <optional>
 #include <stdexcept>
 #include <string>
 
 namespace {
 
+// True when the query binds parameters via $n placeholders (the form the
+// server-side prepared-statement protocol understands).
+bool UsesDollarPlaceholders(const std::string& query) {
+    return query.find('$') != std::string::npos;
+}
+
+// Converts a parameter to its text representation for a prepared statement;
+// empty optional maps to SQL NULL.
+std::optional<std::string> ParamToText(const std::any& param) {
+    if (!param.has_value()) {
+        return std::nullopt;
+    }
+
+    if (param.type() == typeid(int)) {
+        return std::to_string(std::any_cast<int>(param));
+    }
+    if (param.type() == typeid(long long)) {
+        return std::to_string(std::any_cast<long long>(param));
+    }
+    if (param.type() == typeid(double)) {
+        return std::to_string(std::any_cast<double>(param));
+    }
+    if (param.type() == typeid(bool)) {
+        return std::string(std::any_cast<bool>(param) ? "true" : "false");
+    }
+    if (param.type() == typeid(std::string)) {
+        return std::any_cast<std::string>(param);
+    }
+    if (param.type() == typeid(const char*)) {
+        return std::string(std::any_cast<const char*>(param));
+    }
+
+    throw std::invalid_argument("Unsupported PostgreSQL parameter type");
+}
+
 std::string ParamToSqlLiteral(pqxx::transaction_base& txn, const std::any& param) {
     if (!param.has_value()) {
         return "NULL";
@@ -97,6 +133,9 @@ bool PostgreSQLConnection::Connect() {
         const std::string conn_str = config_.GetConnectionString();
         connection_ = std::make_unique<pqxx::connection>(conn_str);
 
+        // A fresh session has no server-side statements; drop stale names.
+        prepared_names_.clear();
+
         if (connection_->is_open()) {
             std::cout << "PostgreSQL connected: " << config_.database << std::endl;
             return true;
@@ -120,6 +159,7 @@ void PostgreSQLConnection::Disconnect() {
     if (connection_) {
         connection_.reset();
     }
+    prepared_names_.clear();
 }
 
 bool PostgreSQLConnection::IsConnected() const {
@@ -135,8 +175,18 @@ QueryResult PostgreSQLConnection::ExecuteQuery(const std::string& query, const s
 
     try {
         pqxx::work txn(*connection_);
-        const std::string sql = BuildSqlWithParams(txn, query, params);
-        const pqxx::result rows = txn.exec(sql);
+        pqxx::result rows;
+        if (!params.empty() && UsesDollarPlaceholders(query)) {
+            // Hot path: named statement, planned once per connection.
+            const std::string& name = GetPreparedName(query);
+            pqxx::params args;
+            for (const auto& param : params) {
+                args.append(ParamToText(param));
+            }
+            rows = txn.exec_prepared(name, args);
+        } else {
+            rows = txn.exec(BuildSqlWithParams(txn, query, params));
+        }
         txn.commit();
 
         for (const auto& row : rows) {
@@ -155,6 +205,61 @@ QueryResult PostgreSQLConnection::ExecuteQuery(const std::string& query, const s
     return result;
 }
 
+std::size_t PostgreSQLConnection::ExecuteQueryStream(const std::string& query,
+                                                     const std::vector<std::any>& params,
+                                                     std::size_t batch_size,
+                                                     const RowBatchHandler& handler) {
+    if (!IsConnected()) {
+        throw std::runtime_error("Database is not connected");
+    }
+    if (batch_size == 0) {
+        batch_size = 1;
+    }
+
+    std::size_t delivered = 0;
+    try {
+        pqxx::work txn(*connection_);
+
+        // The cursor keeps the result set on the server; each FETCH
+        // materializes at most one batch client-side.
+        const std::string cursor_name = "fl_stream_cursor";
+        txn.exec("DECLARE " + cursor_name + " NO SCROLL CURSOR FOR " +
+                 BuildSqlWithParams(txn, query, params));
+
+        const std::string fetch_sql =
+            "FETCH " + std::to_string(batch_size) + " FROM " + cursor_name;
+        bool keep_going = true;
+        while (keep_going) {
+            const pqxx::result rows = txn.exec(fetch_sql);
+            if (rows.empty()) {
+                break;
+            }
+
+            QueryResult batch;
+            batch.reserve(rows.size());
+            for (const auto& row : rows) {
+                std::map<std::string, std::any> row_data;
+                for (std::size_t i = 0; i < row.size(); ++i) {
+                    const std::string column_name = rows.column_name(i);
+                    row_data[column_name] =
+                        ConvertPqxxField(row[static_cast<pqxx::row::size_type>(i)]);
+                }
+                batch.push_back(std::move(row_data));
+            }
+
+            delivered += batch.size();
+            keep_going = handler(batch);
+        }
+
+        txn.exec("CLOSE " + cursor_name);
+        txn.commit();
+    } catch (const std::exception& e) {
+        std::cerr << "Streaming query failed: " << e.what() << std::endl;
+        throw;
+    }
+    return delivered;
+}
+
 int PostgreSQLConnection::ExecuteUpdate(const std::string& query, const std::vector<std::any>& params) {
     if (!IsConnected()) {
         throw std::runtime_error("Database is not connected");
@@ -162,8 +267,17 @@ int PostgreSQLConnection::ExecuteUpdate(const std::string& query, const std::vec
 
     try {
         pqxx::work txn(*connection_);
-        const std::string sql = BuildSqlWithParams(txn, query, params);
-        const pqxx::result rows = txn.exec(sql);
+        pqxx::result rows;
+        if (!params.empty() && UsesDollarPlaceholders(query)) {
+            const std::string& name = GetPreparedName(query);
+            pqxx::params args;
+            for (const auto& param : params) {
+                args.append(ParamToText(param));
+            }
+            rows = txn.exec_prepared(name, args);
+        } else {
+            rows = txn.exec(BuildSqlWithParams(txn, query, params));
+        }
         txn.commit();
 
         return static_cast<int>(rows.affected_rows());
@@ -235,6 +349,16 @@ long long PostgreSQLConnection::GetLastInsertId() {
     return -1;
 }
 
+const std::string& PostgreSQLConnection::GetPreparedName(const std::string& query) {
+    auto it = prepared_names_.find(query);
+    if (it == prepared_names_.end()) {
+        std::string name = "fl_stmt_" + std::to_string(next_statement_id_++);
+        connection_->prepare(name, query);
+        it = prepared_names_.emplace(query, std::move(name)).first;
+    }
+    return it->second;
+}
+
 std::any PostgreSQLConnection::ConvertPqxxField(const pqxx::field& field) {
     if (field.is_null()) {
         return std::any{};
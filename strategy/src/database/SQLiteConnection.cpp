@@ -3,6 +3,7 @@
  * 说明: SQLite数据库连接实现
  * 作者: 彭承康
  * 创建时间: 2026-02-18
+ * 更新时间: 2026-08-28 — 批量写模式：组提交事务与异步提交线程
  */
 
 #ifdef HAS_SQLITE
@@ -25,6 +26,89 @@ SQLiteConnection::~SQLiteConnection() {
     Disconnect();
 }
 
+void SQLiteConnection::EnableBatchedWrites(std::size_t max_statements,
+                                           std::chrono::milliseconds max_delay) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (batched_writes_) {
+            return;
+        }
+        batched_writes_ = true;
+        stop_committer_ = false;
+        batch_max_statements_ = max_statements > 0 ? max_statements : BATCH_MAX_STATEMENTS;
+        batch_max_delay_ = max_delay.count() > 0 ? max_delay : BATCH_MAX_DELAY;
+
+        // WAL下NORMAL不会损坏数据库，只是掉电时可能丢最后一批
+        if (db_) {
+            sqlite3_exec(db_, "PRAGMA synchronous=NORMAL;", nullptr, nullptr, nullptr);
+        }
+    }
+    commit_thread_ = std::thread(&SQLiteConnection::CommitLoop, this);
+}
+
+void SQLiteConnection::DisableBatchedWrites() {
+    StopCommitThread();
+    std::lock_guard<std::mutex> lock(mutex_);
+    batched_writes_ = false;
+    if (db_) {
+        sqlite3_exec(db_, "PRAGMA synchronous=FULL;", nullptr, nullptr, nullptr);
+    }
+}
+
+bool SQLiteConnection::FlushBatchedWrites() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return FlushBatchLocked();
+}
+
+bool SQLiteConnection::FlushBatchLocked() {
+    if (!batch_open_) {
+        return true;
+    }
+
+    int rc = sqlite3_exec(db_, "COMMIT;", nullptr, nullptr, nullptr);
+    if (rc != SQLITE_OK) {
+        std::cerr << "SQLite批量提交失败: " << sqlite3_errmsg(db_) << std::endl;
+        sqlite3_exec(db_, "ROLLBACK;", nullptr, nullptr, nullptr);
+    }
+    batch_open_ = false;
+    batch_pending_ = 0;
+    return rc == SQLITE_OK;
+}
+
+void SQLiteConnection::CommitLoop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (!stop_committer_) {
+        // 攒满一批时被ExecuteUpdate唤醒，否则最迟延迟上限后醒来
+        batch_cv_.wait_for(lock, batch_max_delay_, [this]() {
+            return stop_committer_ || batch_pending_ >= batch_max_statements_;
+        });
+
+        if (!batch_open_) {
+            continue;
+        }
+
+        const bool batch_full = batch_pending_ >= batch_max_statements_;
+        const bool delay_elapsed =
+            std::chrono::steady_clock::now() - batch_opened_at_ >= batch_max_delay_;
+        if (stop_committer_ || batch_full || delay_elapsed) {
+            FlushBatchLocked();
+        }
+    }
+    // 退出前提交残留的批，保证关闭路径不丢写
+    FlushBatchLocked();
+}
+
+void SQLiteConnection::StopCommitThread() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_committer_ = true;
+    }
+    batch_cv_.notify_all();
+    if (commit_thread_.joinable()) {
+        commit_thread_.join();
+    }
+}
+
 bool SQLiteConnection::Connect() {
     std::lock_guard<std::mutex> lock(mutex_);
 
@@ -49,6 +133,9 @@ bool SQLiteConnection::Connect() {
 }
 
 void SQLiteConnection::Disconnect() {
+    // 先提交未完成的批并回收提交线程，再关闭数据库
+    StopCommitThread();
+
     std::lock_guard<std::mutex> lock(mutex_);
 
     if (in_transaction_) {
@@ -194,6 +281,17 @@ int SQLiteConnection::ExecuteUpdate(const std::string& query, const std::vector<
         throw std::runtime_error("SQLite: 数据库未连接");
     }
 
+    // 批量写模式：语句累积到同一个显式事务里，由提交线程统一COMMIT
+    // （提交线程已停止时退回逐语句自动提交，避免写入滞留）
+    const bool batching = batched_writes_ && !stop_committer_ && !in_transaction_;
+    if (batching && !batch_open_) {
+        if (sqlite3_exec(db_, "BEGIN;", nullptr, nullptr, nullptr) == SQLITE_OK) {
+            batch_open_ = true;
+            batch_pending_ = 0;
+            batch_opened_at_ = std::chrono::steady_clock::now();
+        }
+    }
+
     std::string converted_query = ConvertParamPlaceholders(query);
 
     sqlite3_stmt* stmt = nullptr;
@@ -217,6 +315,13 @@ int SQLiteConnection::ExecuteUpdate(const std::string& query, const std::vector<
 
     int changes = sqlite3_changes(db_);
     sqlite3_finalize(stmt);
+
+    if (batching && batch_open_) {
+        ++batch_pending_;
+        if (batch_pending_ >= batch_max_statements_) {
+            batch_cv_.notify_one();
+        }
+    }
     return changes;
 }
 
@@ -231,6 +336,9 @@ bool SQLiteConnection::BeginTransaction() {
         return true;
     }
 
+    // 显式事务优先：先提交未完成的批，避免嵌套BEGIN
+    FlushBatchLocked();
+
     int rc = sqlite3_exec(db_, "BEGIN;", nullptr, nullptr, nullptr);
     if (rc != SQLITE_OK) {
         std::cerr << "SQLite开始事务失败: " << sqlite3_errmsg(db_) << std::endl;
@@ -0,0 +1,128 @@
+/*
+ * 文件名: LatencyHistogram.cpp
+ * 说明: HDR风格延迟直方图实现
+ * 作者: 彭承康
+ * 创建时间: 2026-08-28
+ */
+
+#include "monitor/LatencyHistogram.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <unordered_map>
+
+namespace strategy {
+
+namespace {
+
+/// 实例编号分配器，避免释放后地址复用造成线程本地缓存串号
+std::atomic<std::uint64_t> g_next_histogram_id{1};
+
+} // namespace
+
+std::uint64_t HistogramSnapshot::GetPercentileMicros(double percentile) const {
+    if (total_count == 0 || buckets.empty()) {
+        return 0;
+    }
+
+    const double clamped = std::clamp(percentile, 0.0, 100.0);
+    const std::uint64_t target = static_cast<std::uint64_t>(
+        std::ceil(clamped / 100.0 * static_cast<double>(total_count)));
+    const std::uint64_t needed = std::max<std::uint64_t>(target, 1);
+
+    std::uint64_t cumulative = 0;
+    for (std::size_t i = 0; i < buckets.size(); ++i) {
+        cumulative += buckets[i];
+        if (cumulative >= needed) {
+            return LatencyHistogram::BucketLowerBoundMicros(i);
+        }
+    }
+
+    return LatencyHistogram::BucketLowerBoundMicros(buckets.size() - 1);
+}
+
+double HistogramSnapshot::GetAverageMicros() const {
+    if (total_count == 0) {
+        return 0.0;
+    }
+    return static_cast<double>(total_micros) / static_cast<double>(total_count);
+}
+
+LatencyHistogram::LatencyHistogram()
+    : id_(g_next_histogram_id.fetch_add(1, std::memory_order_relaxed)) {}
+
+std::size_t LatencyHistogram::BucketIndex(std::uint64_t micros) {
+    if (micros < SUB_BUCKET_COUNT) {
+        return static_cast<std::size_t>(micros);
+    }
+
+    // 高半区子桶：去掉最高位之外的精度，保留 SUB_BUCKET_BITS 位
+    const unsigned width = static_cast<unsigned>(std::bit_width(micros));
+    const unsigned shift = width - static_cast<unsigned>(SUB_BUCKET_BITS);
+    const std::uint64_t sub = (micros >> shift) - SUB_BUCKET_HALF;
+    const std::size_t index = SUB_BUCKET_COUNT +
+        static_cast<std::size_t>(shift - 1) * SUB_BUCKET_HALF +
+        static_cast<std::size_t>(sub);
+
+    return std::min(index, BUCKET_COUNT - 1);
+}
+
+std::uint64_t LatencyHistogram::BucketLowerBoundMicros(std::size_t index) {
+    if (index < SUB_BUCKET_COUNT) {
+        return static_cast<std::uint64_t>(index);
+    }
+
+    const std::size_t range = (index - SUB_BUCKET_COUNT) / SUB_BUCKET_HALF;
+    const std::uint64_t sub = (index - SUB_BUCKET_COUNT) % SUB_BUCKET_HALF + SUB_BUCKET_HALF;
+    return sub << (range + 1);
+}
+
+void LatencyHistogram::RecordMicros(std::uint64_t micros) {
+    ThreadBuffer& buffer = LocalBuffer();
+    buffer.counts[BucketIndex(micros)].fetch_add(1, std::memory_order_relaxed);
+    buffer.total_micros.fetch_add(micros, std::memory_order_relaxed);
+}
+
+void LatencyHistogram::Record(std::chrono::steady_clock::duration elapsed) {
+    if (elapsed.count() < 0) {
+        elapsed = std::chrono::steady_clock::duration::zero();
+    }
+    RecordMicros(static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count()));
+}
+
+HistogramSnapshot LatencyHistogram::Snapshot() const {
+    HistogramSnapshot snapshot;
+    snapshot.buckets.assign(BUCKET_COUNT, 0);
+
+    std::lock_guard<std::mutex> lock(buffers_mutex_);
+    for (const auto& buffer : buffers_) {
+        for (std::size_t i = 0; i < BUCKET_COUNT; ++i) {
+            const std::uint64_t count = buffer->counts[i].load(std::memory_order_relaxed);
+            snapshot.buckets[i] += count;
+            snapshot.total_count += count;
+        }
+        snapshot.total_micros += buffer->total_micros.load(std::memory_order_relaxed);
+    }
+
+    return snapshot;
+}
+
+LatencyHistogram::ThreadBuffer& LatencyHistogram::LocalBuffer() {
+    // 线程本地缓存：实例编号 → 本线程缓冲
+    thread_local std::unordered_map<std::uint64_t, std::shared_ptr<ThreadBuffer>> tls_buffers;
+
+    auto it = tls_buffers.find(id_);
+    if (it == tls_buffers.end()) {
+        auto buffer = std::make_shared<ThreadBuffer>();
+        {
+            std::lock_guard<std::mutex> lock(buffers_mutex_);
+            buffers_.push_back(buffer);
+        }
+        it = tls_buffers.emplace(id_, std::move(buffer)).first;
+    }
+    return *it->second;
+}
+
+} // namespace strategy
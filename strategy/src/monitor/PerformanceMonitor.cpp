@@ -6,6 +6,7 @@
  */
 
 #include "monitor/PerformanceMonitor.h"
+#include "monitor/MetricsExporter.h"
 #include <iostream>
 #include <iomanip>
 #include <algorithm>
@@ -30,6 +31,116 @@ PerformanceMonitor& PerformanceMonitor::GetInstance() {
     return instance;
 }
 
+PerformanceMonitor::~PerformanceMonitor() = default;
+
+bool PerformanceMonitor::StartMetricsExporter(std::uint16_t port,
+                                              const std::string& persist_path) {
+    if (exporter_) {
+        return false;
+    }
+    auto exporter = std::make_unique<metrics::MetricsExporter>();
+
+    // 采集器在抓取时才读计数器原子值和直方图快照，更新路径
+    // 不为导出付任何代价
+    exporter->AddCollector([this]() {
+        std::vector<metrics::MetricSample> samples;
+        for (const auto& [name, value] : GetAllCounterValues()) {
+            samples.push_back({name, "counter", static_cast<double>(value)});
+        }
+        for (const auto& [name, snapshot] : GetAllHistogramSnapshots()) {
+            samples.push_back({name + "_count", "counter",
+                               static_cast<double>(snapshot.total_count)});
+            samples.push_back({name + "_sum_us", "counter",
+                               static_cast<double>(snapshot.total_micros)});
+            samples.push_back({name + "_p50_us", "gauge",
+                               static_cast<double>(snapshot.GetPercentileMicros(50.0))});
+            samples.push_back({name + "_p99_us", "gauge",
+                               static_cast<double>(snapshot.GetPercentileMicros(99.0))});
+        }
+        return samples;
+    });
+
+    if (!exporter->Start(port, persist_path)) {
+        return false;
+    }
+
+    // 回灌上次运行的单调计数器值；直方图派生指标（带_count/_us
+    // 后缀）不回灌，直方图本身重启后从零开始
+    for (const auto& [name, value] : exporter->RestoredSamples()) {
+        if (name.ends_with("_count") || name.ends_with("_us")) {
+            continue;
+        }
+        GetCounter(name).store(static_cast<std::uint64_t>(value),
+                               std::memory_order_relaxed);
+    }
+
+    exporter_ = std::move(exporter);
+    return true;
+}
+
+void PerformanceMonitor::StopMetricsExporter() {
+    exporter_.reset();
+}
+
+LatencyHistogram& PerformanceMonitor::GetHistogram(const std::string& name) {
+    std::lock_guard<std::mutex> lock(histogram_mutex_);
+
+    auto it = histograms_.find(name);
+    if (it == histograms_.end()) {
+        it = histograms_.emplace(name, std::make_unique<LatencyHistogram>()).first;
+    }
+    return *it->second;
+}
+
+std::unordered_map<std::string, HistogramSnapshot>
+PerformanceMonitor::GetAllHistogramSnapshots() const {
+    std::unordered_map<std::string, HistogramSnapshot> snapshots;
+
+    std::lock_guard<std::mutex> lock(histogram_mutex_);
+    for (const auto& pair : histograms_) {
+        snapshots.emplace(pair.first, pair.second->Snapshot());
+    }
+    return snapshots;
+}
+
+std::atomic<std::uint64_t>& PerformanceMonitor::GetCounter(const std::string& name) {
+    std::lock_guard<std::mutex> lock(counter_mutex_);
+
+    auto it = counters_.find(name);
+    if (it == counters_.end()) {
+        it = counters_.emplace(name, std::make_unique<std::atomic<std::uint64_t>>(0)).first;
+    }
+    return *it->second;
+}
+
+std::unordered_map<std::string, std::uint64_t>
+PerformanceMonitor::GetAllCounterValues() const {
+    std::unordered_map<std::string, std::uint64_t> values;
+
+    std::lock_guard<std::mutex> lock(counter_mutex_);
+    for (const auto& pair : counters_) {
+        values.emplace(pair.first, pair.second->load(std::memory_order_relaxed));
+    }
+    return values;
+}
+
+SlowQueryLog& PerformanceMonitor::GetSlowQueryLog() {
+    return slow_query_log_;
+}
+
+void PerformanceMonitor::RecordTraceEvent(std::uint64_t trace_id, const char* hop) {
+    if (!enabled_ || trace_id == 0) return;
+    trace_ring_.Record(trace_id, hop);
+}
+
+std::vector<trace::TraceEvent> PerformanceMonitor::GetTraceEvents() const {
+    return trace_ring_.Snapshot();
+}
+
+bool PerformanceMonitor::DumpTraceEvents(const std::string& path) const {
+    return trace_ring_.DumpCsv(path);
+}
+
 void PerformanceMonitor::StartTimer(const std::string& name) {
     if (!enabled_) return;
 
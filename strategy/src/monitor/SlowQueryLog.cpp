@@ -0,0 +1,100 @@
+/*
+ * 文件名: SlowQueryLog.cpp
+ * 说明: 慢查询捕获与滚动内存报告实现
+ * 作者: 彭承康
+ * 创建时间: 2026-08-28
+ */
+
+#include "monitor/SlowQueryLog.h"
+
+#include <utility>
+
+namespace strategy {
+
+SlowQueryLog::SlowQueryLog(std::size_t capacity)
+    : capacity_(capacity > 0 ? capacity : DEFAULT_CAPACITY) {
+}
+
+void SlowQueryLog::SetEnabled(bool enabled) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    enabled_ = enabled;
+}
+
+bool SlowQueryLog::IsEnabled() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return enabled_;
+}
+
+void SlowQueryLog::SetThresholdMs(double threshold_ms) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    threshold_ms_ = threshold_ms;
+}
+
+double SlowQueryLog::GetThresholdMs() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return threshold_ms_;
+}
+
+void SlowQueryLog::SetExplainInterval(std::chrono::milliseconds interval) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    explain_interval_ = interval;
+}
+
+bool SlowQueryLog::IsSlow(double duration_ms) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return enabled_ && duration_ms >= threshold_ms_;
+}
+
+bool SlowQueryLog::TryAcquireExplainSlot() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!enabled_) {
+        return false;
+    }
+
+    auto now = std::chrono::steady_clock::now();
+    if (has_explained_ && now - last_explain_ < explain_interval_) {
+        return false;
+    }
+    last_explain_ = now;
+    has_explained_ = true;
+    ++explain_count_;
+    return true;
+}
+
+void SlowQueryLog::Record(SlowQueryRecord record) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!enabled_) {
+        return;
+    }
+
+    ++slow_count_;
+    records_.push_back(std::move(record));
+    while (records_.size() > capacity_) {
+        records_.pop_front();
+    }
+}
+
+std::vector<SlowQueryRecord> SlowQueryLog::GetRecords() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return std::vector<SlowQueryRecord>(records_.begin(), records_.end());
+}
+
+std::uint64_t SlowQueryLog::GetSlowQueryCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return slow_count_;
+}
+
+std::uint64_t SlowQueryLog::GetExplainCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return explain_count_;
+}
+
+void SlowQueryLog::Clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    records_.clear();
+    slow_count_ = 0;
+    explain_count_ = 0;
+    has_explained_ = false;
+}
+
+} // namespace strategy
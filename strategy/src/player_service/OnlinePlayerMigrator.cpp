@@ -0,0 +1,237 @@
+/*
+ * 文件名: OnlinePlayerMigrator.cpp
+ * 说明: 玩家表在线迁移器实现
+ * 作者: 彭承康
+ * 创建时间: 2026-08-28
+ */
+#include "player_service/OnlinePlayerMigrator.h"
+#include <algorithm>
+#include <iostream>
+#include <stdexcept>
+
+namespace strategy {
+
+OnlinePlayerMigrator::OnlinePlayerMigrator(std::shared_ptr<IDatabaseConnection> connection,
+                                           std::string migration_name,
+                                           ChunkTransform transform)
+    : connection_(std::move(connection))
+    , migration_name_(std::move(migration_name))
+    , transform_(std::move(transform)) {
+    if (!connection_ || !connection_->IsConnected()) {
+        throw std::invalid_argument("OnlinePlayerMigrator: 连接为空或未连接");
+    }
+    if (migration_name_.empty()) {
+        throw std::invalid_argument("OnlinePlayerMigrator: 迁移名不能为空");
+    }
+    if (!transform_) {
+        throw std::invalid_argument("OnlinePlayerMigrator: 行变换回调不能为空");
+    }
+}
+
+OnlinePlayerMigrator::~OnlinePlayerMigrator() {
+    Stop();
+}
+
+void OnlinePlayerMigrator::SetPacing(long long chunk_size, std::chrono::milliseconds pause) {
+    if (chunk_size <= 0) {
+        throw std::invalid_argument("OnlinePlayerMigrator: 分块大小必须为正");
+    }
+    chunk_size_ = chunk_size;
+    pause_ = pause;
+}
+
+void OnlinePlayerMigrator::SetThrottleSources(PressureProbe pressure_probe, LagProbe lag_probe) {
+    pressure_probe_ = std::move(pressure_probe);
+    lag_probe_ = std::move(lag_probe);
+}
+
+bool OnlinePlayerMigrator::Start() {
+    if (running_.exchange(true)) {
+        return false;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(stop_mutex_);
+        stop_flag_ = false;
+    }
+    worker_ = std::thread(&OnlinePlayerMigrator::MigrationLoop, this);
+    return true;
+}
+
+void OnlinePlayerMigrator::Stop() {
+    {
+        std::lock_guard<std::mutex> lock(stop_mutex_);
+        stop_flag_ = true;
+    }
+    stop_condition_.notify_all();
+
+    if (worker_.joinable()) {
+        worker_.join();
+    }
+    running_.store(false);
+}
+
+bool OnlinePlayerMigrator::RunToCompletion() {
+    if (!EnsureCheckpointTable()) {
+        return false;
+    }
+
+    try {
+        // 迁移上界在开始时确定一次，之后新插入的行由应用层
+        // 写入路径直接写成新格式，不需要回头补迁
+        const long long max_id = QueryMaxId();
+        long long last_done = LoadCheckpoint();
+        checkpoint_.store(last_done);
+
+        if (last_done > 0 && last_done < max_id) {
+            std::cout << "OnlinePlayerMigrator: " << migration_name_
+                      << " 从 id=" << last_done << " 处恢复" << std::endl;
+        }
+
+        while (last_done < max_id) {
+            {
+                std::lock_guard<std::mutex> lock(stop_mutex_);
+                if (stop_flag_) {
+                    return false;
+                }
+            }
+
+            // 线上流量吃紧时退避，不与其争抢数据库资源
+            if (ShouldBackOff()) {
+                if (!InterruptiblePause(BACKOFF_PAUSE)) {
+                    return false;
+                }
+                continue;
+            }
+
+            const long long chunk_end = std::min(last_done + chunk_size_, max_id);
+
+            // 每块一个小事务：数据改写 + 检查点推进一起提交，
+            // 进程中断后从最后提交的块继续，不会留下半块
+            connection_->BeginTransaction();
+            if (!transform_(*connection_, last_done, chunk_end)) {
+                connection_->RollbackTransaction();
+                std::cerr << "OnlinePlayerMigrator: " << migration_name_
+                          << " 行变换在区间 (" << last_done << ", " << chunk_end
+                          << "] 返回失败，迁移中止" << std::endl;
+                return false;
+            }
+            connection_->ExecuteUpdate(
+                "UPDATE player_migration_checkpoint SET last_done_id = $1, "
+                "updated_at = CURRENT_TIMESTAMP WHERE migration_name = $2;",
+                {std::any(chunk_end), std::any(migration_name_)}
+            );
+            connection_->CommitTransaction();
+
+            last_done = chunk_end;
+            checkpoint_.store(last_done);
+
+            // 块间停顿，让路给线上流量
+            if (last_done < max_id && pause_.count() > 0) {
+                if (!InterruptiblePause(pause_)) {
+                    return false;
+                }
+            }
+        }
+
+        // 全部块完成，清理检查点行
+        connection_->ExecuteUpdate(
+            "DELETE FROM player_migration_checkpoint WHERE migration_name = $1;",
+            {std::any(migration_name_)}
+        );
+        finished_.store(true);
+        std::cout << "OnlinePlayerMigrator: " << migration_name_
+                  << " 完成，共迁移到 id=" << max_id << std::endl;
+        return true;
+
+    } catch (const std::exception& e) {
+        connection_->RollbackTransaction();
+        std::cerr << "OnlinePlayerMigrator: " << migration_name_
+                  << " 失败: " << e.what() << std::endl;
+        return false;
+    }
+}
+
+bool OnlinePlayerMigrator::IsRunning() const {
+    return running_.load();
+}
+
+bool OnlinePlayerMigrator::IsFinished() const {
+    return finished_.load();
+}
+
+long long OnlinePlayerMigrator::GetCheckpoint() const {
+    return checkpoint_.load();
+}
+
+void OnlinePlayerMigrator::MigrationLoop() {
+    RunToCompletion();
+    running_.store(false);
+}
+
+bool OnlinePlayerMigrator::EnsureCheckpointTable() {
+    try {
+        connection_->ExecuteUpdate(
+            "CREATE TABLE IF NOT EXISTS player_migration_checkpoint ("
+            "  migration_name VARCHAR(128) PRIMARY KEY,"
+            "  last_done_id BIGINT NOT NULL,"
+            "  updated_at TIMESTAMP DEFAULT CURRENT_TIMESTAMP"
+            ");"
+        );
+        return true;
+    } catch (const std::exception& e) {
+        std::cerr << "OnlinePlayerMigrator: 创建检查点表失败: " << e.what() << std::endl;
+        return false;
+    }
+}
+
+long long OnlinePlayerMigrator::LoadCheckpoint() {
+    auto progress = connection_->ExecuteQuery(
+        "SELECT last_done_id FROM player_migration_checkpoint WHERE migration_name = $1;",
+        {std::any(migration_name_)}
+    );
+    if (!progress.empty()) {
+        auto it = progress[0].find("last_done_id");
+        if (it != progress[0].end()) {
+            return std::any_cast<long long>(it->second);
+        }
+    }
+
+    connection_->ExecuteUpdate(
+        "INSERT INTO player_migration_checkpoint (migration_name, last_done_id) "
+        "VALUES ($1, 0);",
+        {std::any(migration_name_)}
+    );
+    return 0;
+}
+
+long long OnlinePlayerMigrator::QueryMaxId() {
+    auto result = connection_->ExecuteQuery(
+        "SELECT COALESCE(MAX(id), 0) AS max_id FROM players;");
+    if (!result.empty()) {
+        auto it = result[0].find("max_id");
+        if (it != result[0].end()) {
+            return std::any_cast<long long>(it->second);
+        }
+    }
+    return 0;
+}
+
+bool OnlinePlayerMigrator::ShouldBackOff() const {
+    // 池压力探测为真说明线上请求正在排队等连接，迁移先让路
+    if (pressure_probe_ && pressure_probe_()) {
+        return true;
+    }
+    if (lag_probe_ && lag_probe_() > MAX_REPLICATION_LAG) {
+        return true;
+    }
+    return false;
+}
+
+bool OnlinePlayerMigrator::InterruptiblePause(std::chrono::milliseconds duration) {
+    std::unique_lock<std::mutex> lock(stop_mutex_);
+    stop_condition_.wait_for(lock, duration, [this] { return stop_flag_; });
+    return !stop_flag_;
+}
+
+} // namespace strategy
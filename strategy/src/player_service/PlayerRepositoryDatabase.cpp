@@ -3,8 +3,11 @@
  * 说明: 基于通用数据库接口的玩家仓储实现
  * 作者: 彭承康
  * 创建时间: 2026-02-18
+ * 更新时间: 2026-08-28 — 迁移到EntityRepository，SQL改为编译期生成
  */
 #include "player_service/PlayerRepositoryDatabase.h"
+#include <algorithm>
+#include <chrono>
 #include <iostream>
 #include <iomanip>
 #include <sstream>
@@ -12,17 +15,12 @@
 namespace strategy {
 
 PlayerRepositoryDatabase::PlayerRepositoryDatabase(std::unique_ptr<IDatabaseConnection> connection)
-    : BaseRepository(std::move(connection)) {
+    : EntityRepository(std::move(connection)) {
 }
 
 std::optional<Player> PlayerRepositoryDatabase::CreatePlayer(const std::string& username, const std::string& password_hash, const std::string& email) {
     try {
-        std::string sql = "INSERT INTO players (username, password_hash, email, created_at) VALUES ($1, $2, $3, CURRENT_TIMESTAMP);";
-
-        std::vector<std::any> params = {username, password_hash, email};
-        ExecuteUpdate(sql, params);
-
-        long long new_id = GetLastInsertId();
+        const long long new_id = InsertAndReturnId({username, password_hash, email});
         if (new_id > 0) {
             return FindPlayerById(new_id);
         }
@@ -34,14 +32,7 @@ std::optional<Player> PlayerRepositoryDatabase::CreatePlayer(const std::string&
 
 std::optional<Player> PlayerRepositoryDatabase::FindPlayerById(long long id) {
     try {
-        std::string sql = "SELECT id, username, password_hash, email, created_at FROM players WHERE id = $1;";
-        
-        std::vector<std::any> params = {id};
-        auto result = ExecuteQuery(sql, params);
-        
-        if (!result.empty()) {
-            return ConvertToPlayer(result[0]);
-        }
+        return SelectOneBy<0>(id);
     } catch (const std::exception& e) {
         std::cerr << "查找玩家失败: " << e.what() << std::endl;
     }
@@ -50,14 +41,7 @@ std::optional<Player> PlayerRepositoryDatabase::FindPlayerById(long long id) {
 
 std::optional<Player> PlayerRepositoryDatabase::FindPlayerByUsername(const std::string& username) {
     try {
-        std::string sql = "SELECT id, username, password_hash, email, created_at FROM players WHERE username = $1;";
-        
-        std::vector<std::any> params = {username};
-        auto result = ExecuteQuery(sql, params);
-        
-        if (!result.empty()) {
-            return ConvertToPlayer(result[0]);
-        }
+        return SelectOneBy<1>(username);
     } catch (const std::exception& e) {
         std::cerr << "查找玩家失败: " << e.what() << std::endl;
     }
@@ -66,48 +50,83 @@ std::optional<Player> PlayerRepositoryDatabase::FindPlayerByUsername(const std::
 
 bool PlayerRepositoryDatabase::UpdatePlayer(const Player& player) {
     try {
-        std::string sql = "UPDATE players SET username = $1, password_hash = $2, email = $3 WHERE id = $4;";
-        
-        std::vector<std::any> params = {player.username, player.password_hash, player.email, player.id};
-        int affected_rows = ExecuteUpdate(sql, params);
-        
-        return affected_rows == 1;
+        return UpdateByKey({player.username, player.password_hash, player.email, player.id});
     } catch (const std::exception& e) {
         std::cerr << "更新玩家失败: " << e.what() << std::endl;
         return false;
     }
 }
 
+bool PlayerRepositoryDatabase::UpdatePlayersAtomic(const std::vector<Player>& players, int latency_budget_ms) {
+    if (players.empty()) {
+        return true;
+    }
+    if (players.size() == 1) {
+        return UpdatePlayer(players.front());
+    }
+
+    // 按ID升序执行：并发的多实体写入以相同顺序取行锁，互不死锁
+    std::vector<const Player*> ordered;
+    ordered.reserve(players.size());
+    for (const Player& player : players) {
+        ordered.push_back(&player);
+    }
+    std::sort(ordered.begin(), ordered.end(),
+              [](const Player* a, const Player* b) { return a->id < b->id; });
+
+    const auto deadline = std::chrono::steady_clock::now()
+                        + std::chrono::milliseconds(latency_budget_ms);
+
+    if (!BeginTransaction()) {
+        return false;
+    }
+    try {
+        for (const Player* player : ordered) {
+            if (std::chrono::steady_clock::now() >= deadline) {
+                std::cerr << "事务性批量更新超出延迟预算("
+                          << latency_budget_ms << "ms)，已回滚" << std::endl;
+                RollbackTransaction();
+                return false;
+            }
+            if (!UpdateByKey({player->username, player->password_hash,
+                              player->email, player->id})) {
+                RollbackTransaction();
+                return false;
+            }
+        }
+        return CommitTransaction();
+    } catch (const std::exception& e) {
+        std::cerr << "事务性批量更新玩家失败: " << e.what() << std::endl;
+        RollbackTransaction();
+        return false;
+    }
+}
+
 bool PlayerRepositoryDatabase::DeletePlayer(long long id) {
     try {
-        std::string sql = "DELETE FROM players WHERE id = $1;";
-        
-        std::vector<std::any> params = {id};
-        int affected_rows = ExecuteUpdate(sql, params);
-        
-        return affected_rows == 1;
+        return DeleteByKey(id);
     } catch (const std::exception& e) {
         std::cerr << "删除玩家失败: " << e.what() << std::endl;
         return false;
     }
 }
 
-Player PlayerRepositoryDatabase::ConvertToPlayer(const std::map<std::string, std::any>& row) {
+Player PlayerRepositoryDatabase::FromRow(const std::map<std::string, std::any>& row) {
     Player player;
-    
+
     try {
         player.id = std::any_cast<long long>(row.at("id"));
         player.username = std::any_cast<std::string>(row.at("username"));
         player.password_hash = std::any_cast<std::string>(row.at("password_hash"));
         player.email = std::any_cast<std::string>(row.at("email"));
-        
+
         // 解析时间戳
         std::string created_at_str = std::any_cast<std::string>(row.at("created_at"));
         player.created_at = ParseTimestamp(created_at_str);
     } catch (const std::exception& e) {
         std::cerr << "转换玩家数据失败: " << e.what() << std::endl;
     }
-    
+
     return player;
 }
 
@@ -118,4 +137,4 @@ std::chrono::system_clock::time_point PlayerRepositoryDatabase::ParseTimestamp(c
     return std::chrono::system_clock::from_time_t(std::mktime(&tm));
 }
 
-} // namespace strategy
\ No newline at end of file
+} // namespace strategy
@@ -8,6 +8,7 @@
 #ifdef HAS_PQXX
 
 #include "player_service/PlayerRepositoryPostgres.h"
+#include <algorithm>
 #include <stdexcept>
 #include <iostream>
 #include <sstream>      // 用于字符串流处理
@@ -105,6 +106,103 @@ bool PlayerRepositoryPostgres::UpdatePlayer(const Player& player) {
     }
 }
 
+bool PlayerRepositoryPostgres::UpdatePlayers(const std::vector<Player>& players) {
+    if (players.empty()) {
+        return true;
+    }
+    if (players.size() == 1) {
+        return UpdatePlayer(players.front());
+    }
+
+    try {
+        pqxx::work txn(*connection_);
+        // 单条多行UPDATE：所有待写玩家拼成VALUES表一次落库
+        std::string sql =
+            "UPDATE players SET password_hash = v.password_hash, email = v.email "
+            "FROM (VALUES ";
+        for (std::size_t i = 0; i < players.size(); ++i) {
+            if (i > 0) {
+                sql += ", ";
+            }
+            sql += "(" + std::to_string(players[i].id) + "::bigint, "
+                 + txn.quote(players[i].password_hash) + ", "
+                 + txn.quote(players[i].email) + ")";
+        }
+        sql += ") AS v(id, password_hash, email) WHERE players.id = v.id;";
+
+        pqxx::result r = txn.exec(sql);
+        txn.commit();
+
+        return static_cast<std::size_t>(r.affected_rows()) == players.size();
+    } catch (const std::exception& e) {
+        std::cerr << "批量更新玩家失败: " << e.what() << std::endl;
+        return false;
+    }
+}
+
+bool PlayerRepositoryPostgres::UpdatePlayersAtomic(const std::vector<Player>& players, int latency_budget_ms) {
+    if (players.empty()) {
+        return true;
+    }
+    if (players.size() == 1) {
+        return UpdatePlayer(players.front());
+    }
+
+    // 按ID升序加锁：并发的多实体写入以相同顺序取锁，互不死锁
+    std::vector<const Player*> ordered;
+    ordered.reserve(players.size());
+    for (const Player& player : players) {
+        ordered.push_back(&player);
+    }
+    std::sort(ordered.begin(), ordered.end(),
+              [](const Player* a, const Player* b) { return a->id < b->id; });
+
+    try {
+        pqxx::work txn(*connection_);
+
+        // 延迟预算：等锁与执行都不得超出，超时由数据库侧报错回滚
+        const std::string budget = std::to_string(latency_budget_ms);
+        txn.exec("SET LOCAL lock_timeout = '" + budget + "ms';");
+        txn.exec("SET LOCAL statement_timeout = '" + budget + "ms';");
+
+        std::string lock_sql = "SELECT id FROM players WHERE id IN (";
+        for (std::size_t i = 0; i < ordered.size(); ++i) {
+            if (i > 0) {
+                lock_sql += ", ";
+            }
+            lock_sql += std::to_string(ordered[i]->id);
+        }
+        lock_sql += ") ORDER BY id FOR UPDATE;";
+        txn.exec(lock_sql);
+
+        // 锁已到手，复用多行UPDATE的形状一次落库
+        std::string sql =
+            "UPDATE players SET password_hash = v.password_hash, email = v.email "
+            "FROM (VALUES ";
+        for (std::size_t i = 0; i < ordered.size(); ++i) {
+            if (i > 0) {
+                sql += ", ";
+            }
+            sql += "(" + std::to_string(ordered[i]->id) + "::bigint, "
+                 + txn.quote(ordered[i]->password_hash) + ", "
+                 + txn.quote(ordered[i]->email) + ")";
+        }
+        sql += ") AS v(id, password_hash, email) WHERE players.id = v.id;";
+
+        pqxx::result r = txn.exec(sql);
+        if (static_cast<std::size_t>(r.affected_rows()) != ordered.size()) {
+            // 有玩家不存在：整体放弃，不做部分写入
+            txn.abort();
+            return false;
+        }
+        txn.commit();
+        return true;
+    } catch (const std::exception& e) {
+        std::cerr << "事务性批量更新玩家失败: " << e.what() << std::endl;
+        return false;
+    }
+}
+
 bool PlayerRepositoryPostgres::DeletePlayer(long long id) {
     try {
         pqxx::work txn(*connection_);
@@ -0,0 +1,177 @@
+/*
+ * 文件名: PlayerRepositoryReadCache.cpp
+ * 说明: 玩家数据仓库读通缓存装饰器的实现。
+ * 作者: 彭承康
+ * 创建时间: 2026-08-27
+ */
+#include "player_service/PlayerRepositoryReadCache.h"
+#include <utility>
+
+namespace strategy {
+
+PlayerRepositoryReadCache::PlayerRepositoryReadCache(
+    std::unique_ptr<IPlayerRepository> repository,
+    std::chrono::milliseconds ttl,
+    std::size_t max_entries)
+    : repository_(std::move(repository)),
+      ttl_(ttl),
+      max_entries_(max_entries > 0 ? max_entries : 1) {
+}
+
+const PlayerRepositoryReadCache::CacheEntry* PlayerRepositoryReadCache::LookupLocked(long long id) {
+    auto it = by_id_.find(id);
+    if (it == by_id_.end()) {
+        return nullptr;
+    }
+    if (std::chrono::steady_clock::now() >= it->second->expire_at) {
+        // 过期条目当作未命中处理，顺手清理
+        EraseLocked(id);
+        return nullptr;
+    }
+    // 命中：移到LRU头部
+    lru_.splice(lru_.begin(), lru_, it->second);
+    return &lru_.front();
+}
+
+void PlayerRepositoryReadCache::StoreLocked(long long id, std::optional<Player> player) {
+    EraseLocked(id);
+
+    CacheEntry entry;
+    entry.id = id;
+    entry.player = std::move(player);
+    entry.expire_at = std::chrono::steady_clock::now() + ttl_;
+    lru_.push_front(std::move(entry));
+    by_id_[id] = lru_.begin();
+    if (lru_.front().player.has_value()) {
+        id_by_username_[lru_.front().player->username] = id;
+    }
+
+    // 超出预算：从LRU尾部淘汰
+    while (lru_.size() > max_entries_) {
+        EraseLocked(lru_.back().id);
+    }
+}
+
+void PlayerRepositoryReadCache::EraseLocked(long long id) {
+    auto it = by_id_.find(id);
+    if (it == by_id_.end()) {
+        return;
+    }
+    if (it->second->player.has_value()) {
+        id_by_username_.erase(it->second->player->username);
+    }
+    lru_.erase(it->second);
+    by_id_.erase(it);
+}
+
+std::optional<Player> PlayerRepositoryReadCache::CreatePlayer(const std::string& username,
+                                                              const std::string& password_hash,
+                                                              const std::string& email) {
+    auto player = repository_->CreatePlayer(username, password_hash, email);
+    if (player.has_value()) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        StoreLocked(player->id, player);
+    }
+    return player;
+}
+
+std::optional<Player> PlayerRepositoryReadCache::FindPlayerByUsername(const std::string& username) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = id_by_username_.find(username);
+        if (it != id_by_username_.end()) {
+            const CacheEntry* entry = LookupLocked(it->second);
+            if (entry != nullptr && entry->player.has_value()) {
+                ++hit_count_;
+                return entry->player;
+            }
+        }
+        ++miss_count_;
+    }
+
+    auto player = repository_->FindPlayerByUsername(username);
+    if (player.has_value()) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        StoreLocked(player->id, player);
+    }
+    return player;
+}
+
+std::optional<Player> PlayerRepositoryReadCache::FindPlayerById(long long id) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        const CacheEntry* entry = LookupLocked(id);
+        if (entry != nullptr) {
+            ++hit_count_;
+            // 负缓存命中：确认不存在，直接返回空
+            return entry->player;
+        }
+        ++miss_count_;
+    }
+
+    auto player = repository_->FindPlayerById(id);
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        // 不存在的ID也缓存，防止反复穿透
+        StoreLocked(id, player);
+    }
+    return player;
+}
+
+bool PlayerRepositoryReadCache::UpdatePlayer(const Player& player) {
+    if (!repository_->UpdatePlayer(player)) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    StoreLocked(player.id, player);
+    return true;
+}
+
+bool PlayerRepositoryReadCache::UpdatePlayers(const std::vector<Player>& players) {
+    if (!repository_->UpdatePlayers(players)) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const Player& player : players) {
+        StoreLocked(player.id, player);
+    }
+    return true;
+}
+
+bool PlayerRepositoryReadCache::UpdatePlayersAtomic(const std::vector<Player>& players, int latency_budget_ms) {
+    if (!repository_->UpdatePlayersAtomic(players, latency_budget_ms)) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const Player& player : players) {
+        StoreLocked(player.id, player);
+    }
+    return true;
+}
+
+bool PlayerRepositoryReadCache::DeletePlayer(long long id) {
+    const bool deleted = repository_->DeletePlayer(id);
+    if (deleted) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        // 删除后写入负缓存：后续查询直接得到"不存在"
+        StoreLocked(id, std::nullopt);
+    }
+    return deleted;
+}
+
+void PlayerRepositoryReadCache::Invalidate(long long id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    EraseLocked(id);
+}
+
+std::uint64_t PlayerRepositoryReadCache::GetHitCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return hit_count_;
+}
+
+std::uint64_t PlayerRepositoryReadCache::GetMissCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return miss_count_;
+}
+
+} // namespace strategy
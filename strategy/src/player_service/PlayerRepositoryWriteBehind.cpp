@@ -0,0 +1,171 @@
+/*
+ * 文件名: PlayerRepositoryWriteBehind.cpp
+ * 说明: 玩家数据仓库写后装饰器的实现。
+ * 作者: 彭承康
+ * 创建时间: 2026-08-27
+ */
+#include "player_service/PlayerRepositoryWriteBehind.h"
+#include <utility>
+#include <vector>
+
+namespace strategy {
+
+PlayerRepositoryWriteBehind::PlayerRepositoryWriteBehind(
+    std::unique_ptr<IPlayerRepository> repository,
+    std::chrono::milliseconds flush_interval)
+    : repository_(std::move(repository)),
+      flush_interval_(flush_interval) {
+    flush_thread_ = std::thread(&PlayerRepositoryWriteBehind::FlushLoop, this);
+}
+
+PlayerRepositoryWriteBehind::~PlayerRepositoryWriteBehind() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_flag_ = true;
+    }
+    flush_condition_.notify_all();
+    if (flush_thread_.joinable()) {
+        flush_thread_.join();
+    }
+    // 最终刷新：进程退出前不留脏记录
+    FlushBatch();
+}
+
+std::optional<Player> PlayerRepositoryWriteBehind::CreatePlayer(
+    const std::string& username,
+    const std::string& password_hash,
+    const std::string& email) {
+    // 创建必须立即落库以获得数据库分配的ID
+    return repository_->CreatePlayer(username, password_hash, email);
+}
+
+std::optional<Player> PlayerRepositoryWriteBehind::FindPlayerByUsername(const std::string& username) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (const auto& [id, player] : dirty_) {
+            if (player.username == username) {
+                return player;
+            }
+        }
+    }
+    return repository_->FindPlayerByUsername(username);
+}
+
+std::optional<Player> PlayerRepositoryWriteBehind::FindPlayerById(long long id) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = dirty_.find(id);
+        if (it != dirty_.end()) {
+            // 读己之写：返回尚未落库的最新状态
+            return it->second;
+        }
+    }
+    return repository_->FindPlayerById(id);
+}
+
+bool PlayerRepositoryWriteBehind::UpdatePlayer(const Player& player) {
+    std::size_t pending = 0;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        // 同一玩家的多次更新在脏表中合并，只保留最新状态
+        dirty_[player.id] = player;
+        pending = dirty_.size();
+    }
+    if (pending >= FLUSH_BACKLOG_THRESHOLD) {
+        flush_condition_.notify_one();
+    }
+    return true;
+}
+
+bool PlayerRepositoryWriteBehind::UpdatePlayersAtomic(const std::vector<Player>& players, int latency_budget_ms) {
+    // 取出受影响玩家的待写状态：本次事务写入携带最终状态，
+    // 留在脏表里的旧状态稍后刷新会覆盖事务结果
+    std::unordered_map<long long, Player> superseded;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (const Player& player : players) {
+            auto it = dirty_.find(player.id);
+            if (it != dirty_.end()) {
+                superseded.insert(dirty_.extract(it));
+            }
+        }
+    }
+
+    if (repository_->UpdatePlayersAtomic(players, latency_budget_ms)) {
+        return true;
+    }
+
+    // 事务失败：事务前的待写状态仍然有效，放回脏表
+    // （期间未被新写入覆盖的才放回）
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto& [id, player] : superseded) {
+        dirty_.try_emplace(id, std::move(player));
+    }
+    return false;
+}
+
+bool PlayerRepositoryWriteBehind::DeletePlayer(long long id) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        // 待写状态对已删除玩家无意义，直接丢弃
+        dirty_.erase(id);
+    }
+    return repository_->DeletePlayer(id);
+}
+
+bool PlayerRepositoryWriteBehind::FlushNow() {
+    return FlushBatch();
+}
+
+std::size_t PlayerRepositoryWriteBehind::GetPendingCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return dirty_.size();
+}
+
+bool PlayerRepositoryWriteBehind::FlushBatch() {
+    std::unordered_map<long long, Player> batch;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        batch.swap(dirty_);
+    }
+    if (batch.empty()) {
+        return true;
+    }
+
+    std::vector<Player> players;
+    players.reserve(batch.size());
+    for (auto& [id, player] : batch) {
+        players.push_back(std::move(player));
+    }
+
+    if (repository_->UpdatePlayers(players)) {
+        return true;
+    }
+
+    // 批量失败：未被新写入覆盖的记录放回脏表，留待下轮重试
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (Player& player : players) {
+        dirty_.try_emplace(player.id, std::move(player));
+    }
+    return false;
+}
+
+void PlayerRepositoryWriteBehind::FlushLoop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (!stop_flag_) {
+        flush_condition_.wait_for(lock, flush_interval_, [this]() {
+            return stop_flag_ || dirty_.size() >= FLUSH_BACKLOG_THRESHOLD;
+        });
+        if (stop_flag_) {
+            break;
+        }
+        if (dirty_.empty()) {
+            continue;
+        }
+        lock.unlock();
+        FlushBatch();
+        lock.lock();
+    }
+}
+
+} // namespace strategy
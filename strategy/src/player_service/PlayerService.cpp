@@ -6,6 +6,7 @@
  */
 #include "player_service/PlayerService.h"
 #include "security/PasswordHasher.h"
+#include <map>
 #include <regex>
 #include <iostream>
 
@@ -111,6 +112,33 @@ bool PlayerService::UpdatePlayerPassword(long long id, const std::string& old_pa
     return repository_->UpdatePlayer(*player);
 }
 
+bool PlayerService::UpdatePlayersAtomic(const std::vector<Player>& players, int latency_budget_ms) {
+    if (players.empty()) {
+        return true;
+    }
+    if (latency_budget_ms <= 0) {
+        return false;
+    }
+
+    // 去重：同一玩家出现多次时保留最后一次出现的状态，
+    // 避免事务内对同一行的重复写入
+    std::map<long long, const Player*> latest;
+    for (const Player& player : players) {
+        if (player.id <= 0) {
+            return false;
+        }
+        latest[player.id] = &player;
+    }
+
+    std::vector<Player> batch;
+    batch.reserve(latest.size());
+    for (const auto& [id, player] : latest) {
+        batch.push_back(*player);
+    }
+
+    return repository_->UpdatePlayersAtomic(batch, latency_budget_ms);
+}
+
 bool PlayerService::DeletePlayer(long long id) {
     return repository_->DeletePlayer(id);
 }
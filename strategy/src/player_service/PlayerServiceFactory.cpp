@@ -6,6 +6,8 @@
  */
 #include "player_service/PlayerServiceFactory.h"
 #include "player_service/PlayerRepositoryDatabase.h"
+#include "player_service/PlayerRepositoryWriteBehind.h"
+#include "player_service/PlayerRepositoryReadCache.h"
 #include "database/DatabaseFactory.h"
 #include "database/DatabaseConfigManager.h"
 #include <stdexcept>
@@ -16,7 +18,11 @@ std::unique_ptr<PlayerService> PlayerServiceFactory::CreatePostgresPlayerService
 #ifdef HAS_PQXX
     // 为了兼容性保留旧接口
     auto repository = std::make_unique<PlayerRepositoryPostgres>(connection_string);
-    return std::make_unique<PlayerService>(std::move(repository));
+    // 写后缓存：更新先合并在内存，按间隔批量落库，降低写QPS
+    auto write_behind = std::make_unique<PlayerRepositoryWriteBehind>(std::move(repository));
+    // 读通缓存：重复查询命中内存，写路径同步刷新对应条目
+    auto read_cache = std::make_unique<PlayerRepositoryReadCache>(std::move(write_behind));
+    return std::make_unique<PlayerService>(std::move(read_cache));
 #else
     (void)connection_string;
     throw std::runtime_error("PostgreSQL支持未启用（需要编译时定义HAS_PQXX）");
@@ -33,7 +33,7 @@ bool PasswordHasher::constantTimeCompare(const std::string& a, const std::string
     }
     volatile uint8_t result = 0;
     for (size_t i = 0; i < a.size(); ++i) {
-        result |= static_cast<uint8_t>(a[i]) ^ static_cast<uint8_t>(b[i]);
+        result = result | (static_cast<uint8_t>(a[i]) ^ static_cast<uint8_t>(b[i]));
     }
     return result == 0;
 }
@@ -55,4 +55,37 @@ bool PasswordHasher::verifyPassword(const std::string& password, const std::stri
     return constantTimeCompare(expected_hash, actual_hash);
 }
 
+std::vector<bool> PasswordHasher::verifyPasswords(const std::vector<std::string>& passwords,
+                                                  const std::vector<std::string>& stored) {
+    if (passwords.size() != stored.size()) {
+        return {};
+    }
+
+    std::vector<bool> results(passwords.size(), false);
+
+    // 收集格式合法的条目，哈希计算交给批量接口
+    std::vector<size_t> indices;
+    std::vector<std::string> salted_inputs;
+    std::vector<std::string> expected_hashes;
+    indices.reserve(passwords.size());
+    salted_inputs.reserve(passwords.size());
+    expected_hashes.reserve(passwords.size());
+
+    for (size_t i = 0; i < passwords.size(); ++i) {
+        const size_t sep = stored[i].find(':');
+        if (sep == std::string::npos) {
+            continue;
+        }
+        indices.push_back(i);
+        salted_inputs.push_back(stored[i].substr(0, sep) + passwords[i]);
+        expected_hashes.push_back(stored[i].substr(sep + 1));
+    }
+
+    const std::vector<std::string> actual_hashes = SHA256::hashBatch(salted_inputs);
+    for (size_t j = 0; j < indices.size(); ++j) {
+        results[indices[j]] = constantTimeCompare(expected_hashes[j], actual_hashes[j]);
+    }
+    return results;
+}
+
 } // namespace strategy
@@ -9,8 +9,363 @@
 #include <sstream>
 #include <iomanip>
 
+// x86-64平台编译SIMD代码路径，运行时按CPUID选择
+#if defined(__x86_64__) || defined(_M_X64)
+#define STRATEGY_SHA256_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define STRATEGY_TARGET_SHANI
+#define STRATEGY_TARGET_AVX2
+#else
+#include <cpuid.h>
+#define STRATEGY_TARGET_SHANI __attribute__((target("sha,sse4.1")))
+#define STRATEGY_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
+
 namespace strategy {
 
+#ifdef STRATEGY_SHA256_X86
+namespace {
+
+/**
+ * @brief 运行时CPU能力
+ */
+struct CpuFeatures {
+    bool sha_ni = false;
+    bool avx2 = false;
+};
+
+CpuFeatures DetectCpuFeatures() {
+    CpuFeatures features;
+    unsigned int ebx = 0;
+#if defined(_MSC_VER)
+    int regs[4] = {0, 0, 0, 0};
+    __cpuidex(regs, 7, 0);
+    ebx = static_cast<unsigned int>(regs[1]);
+#else
+    unsigned int eax = 0;
+    unsigned int ecx = 0;
+    unsigned int edx = 0;
+    if (!__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx)) {
+        return features;
+    }
+#endif
+    features.sha_ni = (ebx & (1u << 29)) != 0;
+    features.avx2 = (ebx & (1u << 5)) != 0;
+    return features;
+}
+
+const CpuFeatures& Features() {
+    static const CpuFeatures features = DetectCpuFeatures();
+    return features;
+}
+
+/**
+ * @brief SHA-NI单块压缩（Intel参考实现的指令序列）
+ */
+STRATEGY_TARGET_SHANI
+void ProcessBlockShaNi(const uint8_t* block, std::array<uint32_t, 8>& state) {
+    // 把 a..h 装入 ABEF/CDGH 寄存器布局
+    __m128i tmp = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&state[0]));
+    __m128i state1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&state[4]));
+
+    tmp = _mm_shuffle_epi32(tmp, 0xB1);        // CDAB
+    state1 = _mm_shuffle_epi32(state1, 0x1B);  // EFGH
+    __m128i state0 = _mm_alignr_epi8(tmp, state1, 8);  // ABEF
+    state1 = _mm_blend_epi16(state1, tmp, 0xF0);       // CDGH
+
+    const __m128i byte_swap = _mm_set_epi64x(
+        static_cast<long long>(0x0c0d0e0f08090a0bULL),
+        static_cast<long long>(0x0405060700010203ULL));
+
+    const __m128i abef_save = state0;
+    const __m128i cdgh_save = state1;
+
+    const __m128i* input = reinterpret_cast<const __m128i*>(block);
+
+    // 第0-3轮
+    __m128i msg0 = _mm_shuffle_epi8(_mm_loadu_si128(input + 0), byte_swap);
+    __m128i msg = _mm_add_epi32(msg0, _mm_set_epi64x(
+        static_cast<long long>(0xE9B5DBA5B5C0FBCFULL), static_cast<long long>(0x71374491428A2F98ULL)));
+    state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
+    msg = _mm_shuffle_epi32(msg, 0x0E);
+    state0 = _mm_sha256rnds2_epu32(state0, state1, msg);
+
+    // 第4-7轮
+    __m128i msg1 = _mm_shuffle_epi8(_mm_loadu_si128(input + 1), byte_swap);
+    msg = _mm_add_epi32(msg1, _mm_set_epi64x(
+        static_cast<long long>(0xAB1C5ED5923F82A4ULL), static_cast<long long>(0x59F111F13956C25BULL)));
+    state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
+    msg = _mm_shuffle_epi32(msg, 0x0E);
+    state0 = _mm_sha256rnds2_epu32(state0, state1, msg);
+    msg0 = _mm_sha256msg1_epu32(msg0, msg1);
+
+    // 第8-11轮
+    __m128i msg2 = _mm_shuffle_epi8(_mm_loadu_si128(input + 2), byte_swap);
+    msg = _mm_add_epi32(msg2, _mm_set_epi64x(
+        static_cast<long long>(0x550C7DC3243185BEULL), static_cast<long long>(0x12835B01D807AA98ULL)));
+    state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
+    msg = _mm_shuffle_epi32(msg, 0x0E);
+    state0 = _mm_sha256rnds2_epu32(state0, state1, msg);
+    msg1 = _mm_sha256msg1_epu32(msg1, msg2);
+
+    // 第12-15轮
+    __m128i msg3 = _mm_shuffle_epi8(_mm_loadu_si128(input + 3), byte_swap);
+    msg = _mm_add_epi32(msg3, _mm_set_epi64x(
+        static_cast<long long>(0xC19BF1749BDC06A7ULL), static_cast<long long>(0x80DEB1FE72BE5D74ULL)));
+    state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
+    __m128i tmp2 = _mm_alignr_epi8(msg3, msg2, 4);
+    msg0 = _mm_add_epi32(msg0, tmp2);
+    msg0 = _mm_sha256msg2_epu32(msg0, msg3);
+    msg = _mm_shuffle_epi32(msg, 0x0E);
+    state0 = _mm_sha256rnds2_epu32(state0, state1, msg);
+    msg2 = _mm_sha256msg1_epu32(msg2, msg3);
+
+    // 第16-19轮
+    msg = _mm_add_epi32(msg0, _mm_set_epi64x(
+        static_cast<long long>(0x240CA1CC0FC19DC6ULL), static_cast<long long>(0xEFBE4786E49B69C1ULL)));
+    state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
+    tmp2 = _mm_alignr_epi8(msg0, msg3, 4);
+    msg1 = _mm_add_epi32(msg1, tmp2);
+    msg1 = _mm_sha256msg2_epu32(msg1, msg0);
+    msg = _mm_shuffle_epi32(msg, 0x0E);
+    state0 = _mm_sha256rnds2_epu32(state0, state1, msg);
+    msg3 = _mm_sha256msg1_epu32(msg3, msg0);
+
+    // 第20-23轮
+    msg = _mm_add_epi32(msg1, _mm_set_epi64x(
+        static_cast<long long>(0x76F988DA5CB0A9DCULL), static_cast<long long>(0x4A7484AA2DE92C6FULL)));
+    state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
+    tmp2 = _mm_alignr_epi8(msg1, msg0, 4);
+    msg2 = _mm_add_epi32(msg2, tmp2);
+    msg2 = _mm_sha256msg2_epu32(msg2, msg1);
+    msg = _mm_shuffle_epi32(msg, 0x0E);
+    state0 = _mm_sha256rnds2_epu32(state0, state1, msg);
+    msg0 = _mm_sha256msg1_epu32(msg0, msg1);
+
+    // 第24-27轮
+    msg = _mm_add_epi32(msg2, _mm_set_epi64x(
+        static_cast<long long>(0xBF597FC7B00327C8ULL), static_cast<long long>(0xA831C66D983E5152ULL)));
+    state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
+    tmp2 = _mm_alignr_epi8(msg2, msg1, 4);
+    msg3 = _mm_add_epi32(msg3, tmp2);
+    msg3 = _mm_sha256msg2_epu32(msg3, msg2);
+    msg = _mm_shuffle_epi32(msg, 0x0E);
+    state0 = _mm_sha256rnds2_epu32(state0, state1, msg);
+    msg1 = _mm_sha256msg1_epu32(msg1, msg2);
+
+    // 第28-31轮
+    msg = _mm_add_epi32(msg3, _mm_set_epi64x(
+        static_cast<long long>(0x1429296706CA6351ULL), static_cast<long long>(0xD5A79147C6E00BF3ULL)));
+    state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
+    tmp2 = _mm_alignr_epi8(msg3, msg2, 4);
+    msg0 = _mm_add_epi32(msg0, tmp2);
+    msg0 = _mm_sha256msg2_epu32(msg0, msg3);
+    msg = _mm_shuffle_epi32(msg, 0x0E);
+    state0 = _mm_sha256rnds2_epu32(state0, state1, msg);
+    msg2 = _mm_sha256msg1_epu32(msg2, msg3);
+
+    // 第32-35轮
+    msg = _mm_add_epi32(msg0, _mm_set_epi64x(
+        static_cast<long long>(0x53380D134D2C6DFCULL), static_cast<long long>(0x2E1B213827B70A85ULL)));
+    state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
+    tmp2 = _mm_alignr_epi8(msg0, msg3, 4);
+    msg1 = _mm_add_epi32(msg1, tmp2);
+    msg1 = _mm_sha256msg2_epu32(msg1, msg0);
+    msg = _mm_shuffle_epi32(msg, 0x0E);
+    state0 = _mm_sha256rnds2_epu32(state0, state1, msg);
+    msg3 = _mm_sha256msg1_epu32(msg3, msg0);
+
+    // 第36-39轮
+    msg = _mm_add_epi32(msg1, _mm_set_epi64x(
+        static_cast<long long>(0x92722C8581C2C92EULL), static_cast<long long>(0x766A0ABB650A7354ULL)));
+    state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
+    tmp2 = _mm_alignr_epi8(msg1, msg0, 4);
+    msg2 = _mm_add_epi32(msg2, tmp2);
+    msg2 = _mm_sha256msg2_epu32(msg2, msg1);
+    msg = _mm_shuffle_epi32(msg, 0x0E);
+    state0 = _mm_sha256rnds2_epu32(state0, state1, msg);
+    msg0 = _mm_sha256msg1_epu32(msg0, msg1);
+
+    // 第40-43轮
+    msg = _mm_add_epi32(msg2, _mm_set_epi64x(
+        static_cast<long long>(0xC76C51A3C24B8B70ULL), static_cast<long long>(0xA81A664BA2BFE8A1ULL)));
+    state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
+    tmp2 = _mm_alignr_epi8(msg2, msg1, 4);
+    msg3 = _mm_add_epi32(msg3, tmp2);
+    msg3 = _mm_sha256msg2_epu32(msg3, msg2);
+    msg = _mm_shuffle_epi32(msg, 0x0E);
+    state0 = _mm_sha256rnds2_epu32(state0, state1, msg);
+    msg1 = _mm_sha256msg1_epu32(msg1, msg2);
+
+    // 第44-47轮
+    msg = _mm_add_epi32(msg3, _mm_set_epi64x(
+        static_cast<long long>(0x106AA070F40E3585ULL), static_cast<long long>(0xD6990624D192E819ULL)));
+    state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
+    tmp2 = _mm_alignr_epi8(msg3, msg2, 4);
+    msg0 = _mm_add_epi32(msg0, tmp2);
+    msg0 = _mm_sha256msg2_epu32(msg0, msg3);
+    msg = _mm_shuffle_epi32(msg, 0x0E);
+    state0 = _mm_sha256rnds2_epu32(state0, state1, msg);
+    msg2 = _mm_sha256msg1_epu32(msg2, msg3);
+
+    // 第48-51轮
+    msg = _mm_add_epi32(msg0, _mm_set_epi64x(
+        static_cast<long long>(0x34B0BCB52748774CULL), static_cast<long long>(0x1E376C0819A4C116ULL)));
+    state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
+    tmp2 = _mm_alignr_epi8(msg0, msg3, 4);
+    msg1 = _mm_add_epi32(msg1, tmp2);
+    msg1 = _mm_sha256msg2_epu32(msg1, msg0);
+    msg = _mm_shuffle_epi32(msg, 0x0E);
+    state0 = _mm_sha256rnds2_epu32(state0, state1, msg);
+    msg3 = _mm_sha256msg1_epu32(msg3, msg0);
+
+    // 第52-55轮
+    msg = _mm_add_epi32(msg1, _mm_set_epi64x(
+        static_cast<long long>(0x682E6FF35B9CCA4FULL), static_cast<long long>(0x4ED8AA4A391C0CB3ULL)));
+    state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
+    tmp2 = _mm_alignr_epi8(msg1, msg0, 4);
+    msg2 = _mm_add_epi32(msg2, tmp2);
+    msg2 = _mm_sha256msg2_epu32(msg2, msg1);
+    msg = _mm_shuffle_epi32(msg, 0x0E);
+    state0 = _mm_sha256rnds2_epu32(state0, state1, msg);
+
+    // 第56-59轮
+    msg = _mm_add_epi32(msg2, _mm_set_epi64x(
+        static_cast<long long>(0x8CC7020884C87814ULL), static_cast<long long>(0x78A5636F748F82EEULL)));
+    state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
+    tmp2 = _mm_alignr_epi8(msg2, msg1, 4);
+    msg3 = _mm_add_epi32(msg3, tmp2);
+    msg3 = _mm_sha256msg2_epu32(msg3, msg2);
+    msg = _mm_shuffle_epi32(msg, 0x0E);
+    state0 = _mm_sha256rnds2_epu32(state0, state1, msg);
+
+    // 第60-63轮
+    msg = _mm_add_epi32(msg3, _mm_set_epi64x(
+        static_cast<long long>(0xC67178F2BEF9A3F7ULL), static_cast<long long>(0xA4506CEB90BEFFFAULL)));
+    state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
+    msg = _mm_shuffle_epi32(msg, 0x0E);
+    state0 = _mm_sha256rnds2_epu32(state0, state1, msg);
+
+    state0 = _mm_add_epi32(state0, abef_save);
+    state1 = _mm_add_epi32(state1, cdgh_save);
+
+    // 还原为 a..h 自然顺序
+    tmp = _mm_shuffle_epi32(state0, 0x1B);        // FEBA
+    state1 = _mm_shuffle_epi32(state1, 0xB1);     // DCHG
+    state0 = _mm_blend_epi16(tmp, state1, 0xF0);  // DCBA
+    state1 = _mm_alignr_epi8(state1, tmp, 8);     // HGFE
+
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(&state[0]), state0);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(&state[4]), state1);
+}
+
+// AVX2按消息并行的轮函数：每个通道是一条独立消息
+#define SHA256_ROTR8(x, n) \
+    _mm256_or_si256(_mm256_srli_epi32((x), (n)), _mm256_slli_epi32((x), 32 - (n)))
+#define SHA256_CH8(x, y, z) \
+    _mm256_xor_si256(_mm256_and_si256((x), (y)), _mm256_andnot_si256((x), (z)))
+#define SHA256_MAJ8(x, y, z) \
+    _mm256_xor_si256(_mm256_xor_si256(_mm256_and_si256((x), (y)), \
+        _mm256_and_si256((x), (z))), _mm256_and_si256((y), (z)))
+#define SHA256_SIGMA0_8(x) \
+    _mm256_xor_si256(_mm256_xor_si256(SHA256_ROTR8((x), 2), SHA256_ROTR8((x), 13)), SHA256_ROTR8((x), 22))
+#define SHA256_SIGMA1_8(x) \
+    _mm256_xor_si256(_mm256_xor_si256(SHA256_ROTR8((x), 6), SHA256_ROTR8((x), 11)), SHA256_ROTR8((x), 25))
+#define SHA256_GAMMA0_8(x) \
+    _mm256_xor_si256(_mm256_xor_si256(SHA256_ROTR8((x), 7), SHA256_ROTR8((x), 18)), _mm256_srli_epi32((x), 3))
+#define SHA256_GAMMA1_8(x) \
+    _mm256_xor_si256(_mm256_xor_si256(SHA256_ROTR8((x), 17), SHA256_ROTR8((x), 19)), _mm256_srli_epi32((x), 10))
+
+/**
+ * @brief AVX2并行压缩8条单块消息
+ * @param blocks 8条已填充的64字节块
+ * @param states 8组哈希状态（就地更新）
+ * @param round_constants 64个轮常量
+ */
+STRATEGY_TARGET_AVX2
+void ProcessBlocks8Avx2(const std::array<std::array<uint8_t, 64>, 8>& blocks,
+                        std::array<std::array<uint32_t, 8>, 8>& states,
+                        const uint32_t* round_constants) {
+    __m256i w[64];
+    alignas(32) uint32_t lane_words[8];
+
+    for (int i = 0; i < 16; ++i) {
+        for (int lane = 0; lane < 8; ++lane) {
+            const uint8_t* bytes = blocks[static_cast<size_t>(lane)].data() + i * 4;
+            lane_words[lane] = (static_cast<uint32_t>(bytes[0]) << 24) |
+                               (static_cast<uint32_t>(bytes[1]) << 16) |
+                               (static_cast<uint32_t>(bytes[2]) << 8) |
+                               static_cast<uint32_t>(bytes[3]);
+        }
+        w[i] = _mm256_load_si256(reinterpret_cast<const __m256i*>(lane_words));
+    }
+
+    for (int i = 16; i < 64; ++i) {
+        w[i] = _mm256_add_epi32(
+            _mm256_add_epi32(SHA256_GAMMA1_8(w[i - 2]), w[i - 7]),
+            _mm256_add_epi32(SHA256_GAMMA0_8(w[i - 15]), w[i - 16]));
+    }
+
+    __m256i vars[8];
+    for (int j = 0; j < 8; ++j) {
+        for (int lane = 0; lane < 8; ++lane) {
+            lane_words[lane] = states[static_cast<size_t>(lane)][static_cast<size_t>(j)];
+        }
+        vars[j] = _mm256_load_si256(reinterpret_cast<const __m256i*>(lane_words));
+    }
+
+    __m256i a = vars[0];
+    __m256i b = vars[1];
+    __m256i c = vars[2];
+    __m256i d = vars[3];
+    __m256i e = vars[4];
+    __m256i f = vars[5];
+    __m256i g = vars[6];
+    __m256i h = vars[7];
+
+    for (int i = 0; i < 64; ++i) {
+        const __m256i t1 = _mm256_add_epi32(
+            _mm256_add_epi32(_mm256_add_epi32(h, SHA256_SIGMA1_8(e)), SHA256_CH8(e, f, g)),
+            _mm256_add_epi32(_mm256_set1_epi32(static_cast<int>(round_constants[i])), w[i]));
+        const __m256i t2 = _mm256_add_epi32(SHA256_SIGMA0_8(a), SHA256_MAJ8(a, b, c));
+        h = g;
+        g = f;
+        f = e;
+        e = _mm256_add_epi32(d, t1);
+        d = c;
+        c = b;
+        b = a;
+        a = _mm256_add_epi32(t1, t2);
+    }
+
+    const __m256i sums[8] = {
+        _mm256_add_epi32(vars[0], a), _mm256_add_epi32(vars[1], b),
+        _mm256_add_epi32(vars[2], c), _mm256_add_epi32(vars[3], d),
+        _mm256_add_epi32(vars[4], e), _mm256_add_epi32(vars[5], f),
+        _mm256_add_epi32(vars[6], g), _mm256_add_epi32(vars[7], h)};
+
+    for (int j = 0; j < 8; ++j) {
+        _mm256_store_si256(reinterpret_cast<__m256i*>(lane_words), sums[j]);
+        for (int lane = 0; lane < 8; ++lane) {
+            states[static_cast<size_t>(lane)][static_cast<size_t>(j)] = lane_words[lane];
+        }
+    }
+}
+
+#undef SHA256_ROTR8
+#undef SHA256_CH8
+#undef SHA256_MAJ8
+#undef SHA256_SIGMA0_8
+#undef SHA256_SIGMA1_8
+#undef SHA256_GAMMA0_8
+#undef SHA256_GAMMA1_8
+
+} // namespace
+#endif // STRATEGY_SHA256_X86
+
 const std::array<uint32_t, 64> SHA256::K = {
     0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5,
     0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
@@ -118,13 +473,32 @@ std::string SHA256::hash(const std::string& input) {
         0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
     };
 
+#ifdef STRATEGY_SHA256_X86
+    // 运行时分发：支持SHA-NI时走硬件指令压缩
+    const bool use_sha_ni = Features().sha_ni;
+#else
+    const bool use_sha_ni = false;
+#endif
+
+    const auto compress = [use_sha_ni](const uint8_t* block, std::array<uint32_t, 8>& s) {
+#ifdef STRATEGY_SHA256_X86
+        if (use_sha_ni) {
+            ProcessBlockShaNi(block, s);
+            return;
+        }
+#else
+        (void)use_sha_ni;
+#endif
+        processBlock(block, s);
+    };
+
     const auto* data = reinterpret_cast<const uint8_t*>(input.data());
     uint64_t bit_len = static_cast<uint64_t>(input.size()) * 8;
     size_t offset = 0;
 
     // Process complete blocks
     while (offset + BLOCK_SIZE <= input.size()) {
-        processBlock(data + offset, state);
+        compress(data + offset, state);
         offset += BLOCK_SIZE;
     }
 
@@ -142,12 +516,69 @@ std::string SHA256::hash(const std::string& input) {
     }
 
     // Process remaining blocks
-    processBlock(padding.data(), state);
+    compress(padding.data(), state);
     if (pad_len == 128) {
-        processBlock(padding.data() + 64, state);
+        compress(padding.data() + 64, state);
     }
 
     return toHex(state);
 }
 
+std::vector<std::string> SHA256::hashBatch(const std::vector<std::string>& inputs) {
+    std::vector<std::string> output(inputs.size());
+
+#ifdef STRATEGY_SHA256_X86
+    if (Features().avx2) {
+        // 单块消息按8条一组并行；长消息与余数走单条路径
+        std::vector<size_t> single_block;
+        single_block.reserve(inputs.size());
+        for (size_t i = 0; i < inputs.size(); ++i) {
+            if (inputs[i].size() <= SINGLE_BLOCK_MAX) {
+                single_block.push_back(i);
+            }
+        }
+
+        size_t pos = 0;
+        while (single_block.size() - pos >= BATCH_LANES) {
+            std::array<std::array<uint8_t, 64>, 8> blocks{};
+            std::array<std::array<uint32_t, 8>, 8> states;
+
+            for (size_t lane = 0; lane < BATCH_LANES; ++lane) {
+                const std::string& message = inputs[single_block[pos + lane]];
+                std::array<uint8_t, 64>& block = blocks[lane];
+                std::memcpy(block.data(), message.data(), message.size());
+                block[message.size()] = 0x80;
+                const uint64_t bit_len = static_cast<uint64_t>(message.size()) * 8;
+                for (int i = 0; i < 8; ++i) {
+                    block[63 - static_cast<size_t>(i)] = static_cast<uint8_t>(bit_len >> (i * 8));
+                }
+                states[lane] = {
+                    0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+                    0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+                };
+            }
+
+            ProcessBlocks8Avx2(blocks, states, K.data());
+
+            for (size_t lane = 0; lane < BATCH_LANES; ++lane) {
+                output[single_block[pos + lane]] = toHex(states[lane]);
+            }
+            pos += BATCH_LANES;
+        }
+
+        for (size_t i = 0; i < inputs.size(); ++i) {
+            if (output[i].empty()) {
+                output[i] = hash(inputs[i]);
+            }
+        }
+        return output;
+    }
+#endif
+
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        output[i] = hash(inputs[i]);
+    }
+    return output;
+}
+
 } // namespace strategy
@@ -0,0 +1,161 @@
+/*
+ * test_asset_chunk_store.cpp
+ *
+ * Tests for the content-hashed asset chunk store: chunk boundaries,
+ * manifest versioning, range reads, hash-keyed lookup and the
+ * incremental property that only changed chunks change hash.
+ */
+#include <gtest/gtest.h>
+
+#include "config/AssetChunkStore.h"
+#include "security/SHA256.h"
+
+#include <string>
+
+namespace {
+
+// Small chunks keep the fixtures readable; production uses 64KB.
+constexpr std::uint32_t TEST_CHUNK_SIZE = 16;
+
+std::string MakeContent(std::size_t size, char seed) {
+    std::string content(size, '\0');
+    for (std::size_t i = 0; i < size; ++i) {
+        content[i] = static_cast<char>('a' + (seed + i) % 26);
+    }
+    return content;
+}
+
+} // namespace
+
+TEST(AssetChunkStoreTest, ChunksContentWithExpectedBoundaries) {
+    strategy::AssetChunkStore store(TEST_CHUNK_SIZE);
+    const std::string content = MakeContent(40, 0);  // 16 + 16 + 8
+    ASSERT_TRUE(store.AddAsset("maps/town.json", content));
+
+    const auto manifest = store.GetManifest();
+    ASSERT_EQ(manifest->assets.size(), 1u);
+    const auto& entry = manifest->assets[0];
+    EXPECT_EQ(entry.name, "maps/town.json");
+    EXPECT_EQ(entry.size, 40u);
+    EXPECT_EQ(entry.hash, strategy::SHA256::hash(content));
+    ASSERT_EQ(entry.chunks.size(), 3u);
+    EXPECT_EQ(entry.chunks[0].offset, 0u);
+    EXPECT_EQ(entry.chunks[0].size, TEST_CHUNK_SIZE);
+    EXPECT_EQ(entry.chunks[2].offset, 32u);
+    EXPECT_EQ(entry.chunks[2].size, 8u);
+    EXPECT_EQ(entry.chunks[1].hash,
+              strategy::SHA256::hash(content.substr(16, 16)));
+}
+
+TEST(AssetChunkStoreTest, ManifestVersionTracksChanges) {
+    strategy::AssetChunkStore store(TEST_CHUNK_SIZE);
+    EXPECT_EQ(store.GetVersion(), 0u);
+
+    EXPECT_TRUE(store.AddAsset("a.bin", MakeContent(20, 0)));
+    EXPECT_EQ(store.GetVersion(), 1u);
+
+    // Unchanged content does not publish a new version.
+    EXPECT_FALSE(store.AddAsset("a.bin", MakeContent(20, 0)));
+    EXPECT_EQ(store.GetVersion(), 1u);
+
+    EXPECT_TRUE(store.AddAsset("a.bin", MakeContent(20, 5)));
+    EXPECT_EQ(store.GetVersion(), 2u);
+
+    EXPECT_TRUE(store.RemoveAsset("a.bin"));
+    EXPECT_EQ(store.GetVersion(), 3u);
+    EXPECT_FALSE(store.RemoveAsset("a.bin"));
+    EXPECT_TRUE(store.GetManifest()->assets.empty());
+}
+
+TEST(AssetChunkStoreTest, ReadRangeClampsAndReportsEof) {
+    strategy::AssetChunkStore store(TEST_CHUNK_SIZE);
+    const std::string content = MakeContent(40, 0);
+    store.AddAsset("a.bin", content);
+
+    // Chunk-aligned read carries the manifest hash for client caching.
+    auto chunk = store.ReadRange("a.bin", 16, TEST_CHUNK_SIZE);
+    ASSERT_TRUE(chunk.found);
+    EXPECT_EQ(chunk.data, content.substr(16, 16));
+    EXPECT_EQ(chunk.hash, strategy::SHA256::hash(content.substr(16, 16)));
+    EXPECT_FALSE(chunk.eof);
+
+    // Tail read is clamped and flagged as eof; not a whole chunk.
+    auto tail = store.ReadRange("a.bin", 36, TEST_CHUNK_SIZE);
+    ASSERT_TRUE(tail.found);
+    EXPECT_EQ(tail.data, content.substr(36));
+    EXPECT_TRUE(tail.hash.empty());
+    EXPECT_TRUE(tail.eof);
+
+    // Final chunk read at its exact (short) size still hashes.
+    auto last = store.ReadRange("a.bin", 32, TEST_CHUNK_SIZE);
+    ASSERT_TRUE(last.found);
+    EXPECT_EQ(last.hash, strategy::SHA256::hash(content.substr(32)));
+    EXPECT_TRUE(last.eof);
+
+    EXPECT_FALSE(store.ReadRange("a.bin", 41, 1).found);
+    EXPECT_FALSE(store.ReadRange("missing.bin", 0, 1).found);
+}
+
+TEST(AssetChunkStoreTest, ReadChunkByHashLocatesChunk) {
+    strategy::AssetChunkStore store(TEST_CHUNK_SIZE);
+    const std::string content = MakeContent(40, 3);
+    store.AddAsset("a.bin", content);
+
+    const auto manifest = store.GetManifest();
+    const auto& middle = manifest->assets[0].chunks[1];
+    auto chunk = store.ReadChunkByHash(middle.hash);
+    ASSERT_TRUE(chunk.found);
+    EXPECT_EQ(chunk.offset, middle.offset);
+    EXPECT_EQ(chunk.data, content.substr(16, 16));
+
+    EXPECT_FALSE(store.ReadChunkByHash("deadbeef").found);
+}
+
+TEST(AssetChunkStoreTest, OnlyChangedChunksChangeHash) {
+    strategy::AssetChunkStore store(TEST_CHUNK_SIZE);
+    std::string content = MakeContent(48, 0);  // three full chunks
+    store.AddAsset("a.bin", content);
+    const auto before = store.GetManifest();
+
+    // Mutate one byte inside the middle chunk only.
+    content[20] = 'Z';
+    store.AddAsset("a.bin", content);
+    const auto after = store.GetManifest();
+
+    const auto& old_chunks = before->assets[0].chunks;
+    const auto& new_chunks = after->assets[0].chunks;
+    ASSERT_EQ(old_chunks.size(), new_chunks.size());
+    EXPECT_EQ(old_chunks[0].hash, new_chunks[0].hash);
+    EXPECT_NE(old_chunks[1].hash, new_chunks[1].hash);
+    EXPECT_EQ(old_chunks[2].hash, new_chunks[2].hash);
+}
+
+TEST(AssetChunkStoreTest, EmptyAssetKeepsSingleZeroLengthChunk) {
+    strategy::AssetChunkStore store(TEST_CHUNK_SIZE);
+    store.AddAsset("empty.bin", "");
+
+    const auto manifest = store.GetManifest();
+    ASSERT_EQ(manifest->assets.size(), 1u);
+    ASSERT_EQ(manifest->assets[0].chunks.size(), 1u);
+    EXPECT_EQ(manifest->assets[0].chunks[0].size, 0u);
+
+    auto chunk = store.ReadRange("empty.bin", 0, 0);
+    EXPECT_TRUE(chunk.found);
+    EXPECT_TRUE(chunk.data.empty());
+    EXPECT_TRUE(chunk.eof);
+}
+
+TEST(AssetChunkStoreTest, UnchangedAssetEntryReusedAcrossUpdates) {
+    strategy::AssetChunkStore store(TEST_CHUNK_SIZE);
+    store.AddAsset("a.bin", MakeContent(32, 0));
+    store.AddAsset("b.bin", MakeContent(32, 7));
+    const auto before = store.GetManifest();
+
+    store.AddAsset("b.bin", MakeContent(32, 9));
+    const auto after = store.GetManifest();
+
+    ASSERT_EQ(after->assets.size(), 2u);
+    // Assets are name-sorted; a.bin's hashes are untouched by b's update.
+    EXPECT_EQ(before->assets[0].hash, after->assets[0].hash);
+    EXPECT_NE(before->assets[1].hash, after->assets[1].hash);
+}
@@ -0,0 +1,156 @@
+/*
+ * test_executor_service.cpp
+ *
+ * Tests for the shared executor: configuration window, lane submission
+ * and counters, plus the EventScheduler and AsyncLogService integrations
+ * that route their background work through it.
+ */
+#include <gtest/gtest.h>
+
+#include "common/ExecutorService.h"
+#include "Algorithm_interact/EventScheduler.h"
+#include "Log/AsyncLogService.h"
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// Polls a predicate with a deadline; executor tasks finish quickly but
+// on another thread.
+template <typename Predicate>
+bool WaitFor(Predicate predicate,
+             std::chrono::milliseconds timeout = std::chrono::milliseconds(2000)) {
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+    while (std::chrono::steady_clock::now() < deadline) {
+        if (predicate()) {
+            return true;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return predicate();
+}
+
+class RecordingLogService : public strategy::ILogService {
+public:
+    void Log(strategy::LogLevel,
+             const std::string&,
+             int,
+             const std::string&,
+             const std::string& message) override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        messages_.push_back(message);
+    }
+
+    std::vector<std::string> Messages() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return messages_;
+    }
+
+private:
+    mutable std::mutex mutex_;
+    std::vector<std::string> messages_;
+};
+
+} // namespace
+
+TEST(ExecutorServiceTest, RunsSubmittedTasksPerLane) {
+    strategy::ExecutorService executor;
+    std::atomic<int> ran{0};
+
+    EXPECT_TRUE(executor.Submit(strategy::ExecutorLane::Events, [&]() { ++ran; }));
+    EXPECT_TRUE(executor.Submit(strategy::ExecutorLane::DbCallbacks, [&]() { ++ran; }));
+    EXPECT_TRUE(executor.Submit(strategy::ExecutorLane::Logging, [&]() { ++ran; }));
+
+    EXPECT_TRUE(WaitFor([&]() { return ran.load() == 3; }));
+    EXPECT_EQ(executor.GetSubmittedCount(strategy::ExecutorLane::Events), 1u);
+    EXPECT_EQ(executor.GetSubmittedCount(strategy::ExecutorLane::DbCallbacks), 1u);
+    EXPECT_EQ(executor.GetSubmittedCount(strategy::ExecutorLane::Logging), 1u);
+    EXPECT_EQ(executor.GetRejectedCount(strategy::ExecutorLane::Events), 0u);
+}
+
+TEST(ExecutorServiceTest, ConfigureOnlyBeforeFirstSubmit) {
+    strategy::ExecutorService executor;
+    EXPECT_TRUE(executor.Configure(2, 64));
+    EXPECT_TRUE(executor.Configure(1, 32));  // still unstarted, reconfigurable
+
+    std::atomic<bool> ran{false};
+    ASSERT_TRUE(executor.Submit(strategy::ExecutorLane::Events, [&]() { ran = true; }));
+    EXPECT_TRUE(WaitFor([&]() { return ran.load(); }));
+
+    // The pool exists now; the thread count is fixed.
+    EXPECT_FALSE(executor.Configure(8, 512));
+}
+
+TEST(ExecutorServiceTest, ShedsLoggingLaneFirstAndCountsRejections) {
+    strategy::ExecutorService executor;
+    // One thread, tiny queue: block the worker, then overfill.
+    ASSERT_TRUE(executor.Configure(1, 8));
+
+    std::atomic<bool> release{false};
+    ASSERT_TRUE(executor.Submit(strategy::ExecutorLane::Events, [&]() {
+        while (!release.load()) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }));
+
+    // The logging lane sheds at half capacity; events keep going longer.
+    std::size_t logging_accepted = 0;
+    for (int i = 0; i < 16; ++i) {
+        if (executor.Submit(strategy::ExecutorLane::Logging, []() {})) {
+            ++logging_accepted;
+        }
+    }
+    EXPECT_LT(logging_accepted, 16u);
+    EXPECT_GT(executor.GetRejectedCount(strategy::ExecutorLane::Logging), 0u);
+    EXPECT_GT(executor.GetQueueDepth(strategy::ExecutorLane::Logging), 0u);
+
+    release = true;
+}
+
+TEST(ExecutorServiceTest, EventSchedulerHeavyHandlersRunOnSharedExecutor) {
+    strategy::EventScheduler scheduler;
+    scheduler.EnableSharedAsyncExecution();
+
+    std::atomic<int> completions{0};
+    std::thread::id handler_thread;
+    scheduler.SetCompletionCallback(
+        [&](int, const strategy::EventTriggerResult&) { ++completions; });
+    scheduler.RegisterPeriodicEvent(9301, [&](std::span<const int>) {
+        handler_thread = std::this_thread::get_id();
+        return std::string("{}");
+    }, 10);
+    ASSERT_TRUE(scheduler.MarkEventHeavy(9301));
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(30));
+    scheduler.ProcessPendingEvents();
+
+    // Heavy handlers report through the completion callback, not the
+    // tick's return value, whether they ran pooled or degraded inline.
+    EXPECT_TRUE(WaitFor([&]() { return completions.load() >= 1; }));
+
+    scheduler.DisableAsyncExecution();
+}
+
+TEST(ExecutorServiceTest, AsyncLogServiceDrainsThroughSharedExecutor) {
+    auto sink = std::make_shared<RecordingLogService>();
+    {
+        strategy::AsyncLogService logger({sink}, /*use_shared_executor=*/true);
+        for (int i = 0; i < 100; ++i) {
+            logger.Log(strategy::LogLevel::INFO, "test.cpp", i, "test",
+                       "message " + std::to_string(i));
+        }
+        // Destruction waits out the in-flight drain task and flushes
+        // whatever is still buffered.
+    }
+
+    const auto messages = sink->Messages();
+    ASSERT_EQ(messages.size(), 100u);
+    EXPECT_EQ(messages.front(), "message 0");
+    EXPECT_EQ(messages.back(), "message 99");
+}
@@ -5,6 +5,8 @@
 #include <gtest/gtest.h>
 #include "database/JsonConfigParser.h"
 #include <cstdlib>
+#include <sstream>
+#include <vector>
 
 using namespace strategy;
 
@@ -299,3 +301,100 @@ TEST(JsonConfigParser, UnsetEnvironmentVariableReplacedWithEmpty) {
     // Unset env var replaced with empty string; empty host falls back to "localhost"
     EXPECT_EQ(config->host, "localhost");
 }
+
+// ============================================================================
+// ParseStream (SAX mode) tests
+// ============================================================================
+
+TEST(JsonConfigParser, ParseStreamEmitsTypedValuesWithPaths) {
+    std::istringstream input(R"({
+        "databases": {
+            "main": {"host": "db1", "port": 5432, "ssl": true},
+            "replica": {"host": "db2", "note": null}
+        },
+        "rules": [{"id": 1}, {"id": 2}]
+    })");
+
+    std::vector<std::string> seen;
+    JsonConfigParser::ParseStream(
+        input,
+        [&seen](const std::string& path, JsonValueType type, const std::string& value) {
+            std::string tag;
+            switch (type) {
+                case JsonValueType::String: tag = "s"; break;
+                case JsonValueType::Number: tag = "n"; break;
+                case JsonValueType::Boolean: tag = "b"; break;
+                case JsonValueType::Null: tag = "0"; break;
+            }
+            seen.push_back(tag + ":" + path + "=" + value);
+        });
+
+    ASSERT_EQ(seen.size(), 7u);
+    EXPECT_EQ(seen[0], "s:databases.main.host=db1");
+    EXPECT_EQ(seen[1], "n:databases.main.port=5432");
+    EXPECT_EQ(seen[2], "b:databases.main.ssl=true");
+    EXPECT_EQ(seen[4], "0:databases.replica.note=null");
+    EXPECT_EQ(seen[5], "n:rules[0].id=1");
+    EXPECT_EQ(seen[6], "n:rules[1].id=2");
+}
+
+TEST(JsonConfigParser, ParseStreamPathFilterSkipsOtherSubtrees) {
+    std::istringstream input(R"({
+        "databases": {"main": {"host": "db1", "port": 5432}},
+        "huge_rule_blob": {"a": 1, "b": 2, "c": 3}
+    })");
+
+    const auto values = JsonConfigParser::ExtractPaths(input, {"databases.main"});
+
+    ASSERT_EQ(values.size(), 2u);
+    EXPECT_EQ(values.at("databases.main.host"), "db1");
+    EXPECT_EQ(values.at("databases.main.port"), "5432");
+}
+
+TEST(JsonConfigParser, ParseStreamHandlesLongStringsAcrossChunks) {
+    // Strings far larger than the scanner's internal read chunk, so the
+    // SIMD span-append path has to stitch values across buffer refills.
+    const std::string long_plain(20000, 'x');
+    std::string long_escaped;
+    for (int i = 0; i < 5000; ++i) {
+        long_escaped += "ab\\\"c\\\\";
+    }
+    std::string expected_escaped;
+    for (int i = 0; i < 5000; ++i) {
+        expected_escaped += "ab\"c\\";
+    }
+
+    std::istringstream input("{\"plain\": \"" + long_plain +
+                             "\", \"escaped\": \"" + long_escaped + "\"}");
+    const auto values = JsonConfigParser::ExtractPaths(input, {});
+
+    ASSERT_EQ(values.size(), 2u);
+    EXPECT_EQ(values.at("plain"), long_plain);
+    EXPECT_EQ(values.at("escaped"), expected_escaped);
+}
+
+TEST(JsonConfigParser, ParseStreamSkipsLongWhitespaceRuns) {
+    // Deep pretty-printed indentation exercises the vectorized
+    // whitespace skip, including runs that cross chunk boundaries.
+    const std::string pad(9000, ' ');
+    std::istringstream input("{" + pad + "\"key\"" + pad + ":" + pad + "42" +
+                             pad + "}" + std::string(100, '\n'));
+
+    const auto values = JsonConfigParser::ExtractPaths(input, {});
+    ASSERT_EQ(values.size(), 1u);
+    EXPECT_EQ(values.at("key"), "42");
+}
+
+TEST(JsonConfigParser, ParseStreamRejectsMalformedInput) {
+    std::istringstream truncated(R"({"key": "value")");
+    EXPECT_THROW(
+        JsonConfigParser::ParseStream(truncated, [](const std::string&, JsonValueType,
+                                                    const std::string&) {}),
+        JsonParseException);
+
+    std::istringstream trailing(R"({"key": 1} extra)");
+    EXPECT_THROW(
+        JsonConfigParser::ParseStream(trailing, [](const std::string&, JsonValueType,
+                                                   const std::string&) {}),
+        JsonParseException);
+}
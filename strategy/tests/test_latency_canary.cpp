@@ -0,0 +1,129 @@
+/*
+ * test_latency_canary.cpp
+ *
+ * Tests for the shared continuous latency canary: sample delivery to
+ * the injected sink, failure accounting, edge-triggered p99 threshold
+ * alerts and the background cadence.
+ */
+#include <gtest/gtest.h>
+
+#include "monitor/LatencyCanary.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace {
+
+// Sink collecting every sample the canary hands out
+struct RecordingSink {
+    std::mutex mutex;
+    std::vector<std::pair<std::string, bool>> samples;
+
+    metrics::LatencyCanary::SampleSink AsFn() {
+        return [this](const std::string& name, std::uint64_t, bool ok) {
+            std::lock_guard<std::mutex> lock(mutex);
+            samples.emplace_back(name, ok);
+        };
+    }
+};
+
+} // namespace
+
+TEST(LatencyCanaryTest, RunOnceFeedsEverySampleToTheSink) {
+    RecordingSink sink;
+    metrics::LatencyCanary canary;
+    canary.SetSampleSink(sink.AsFn());
+    canary.AddProbe("probe_a", []() { return true; }, 1000000);
+    canary.AddProbe("probe_b", []() { return true; }, 1000000);
+
+    canary.RunOnce();
+    canary.RunOnce();
+
+    std::lock_guard<std::mutex> lock(sink.mutex);
+    ASSERT_EQ(sink.samples.size(), 4u);
+    EXPECT_EQ(sink.samples[0].first, "probe_a");
+    EXPECT_EQ(sink.samples[1].first, "probe_b");
+    EXPECT_TRUE(sink.samples[0].second);
+
+    EXPECT_EQ(canary.GetProbeStats("probe_a").samples, 2u);
+    EXPECT_EQ(canary.GetProbeStats("probe_b").samples, 2u);
+}
+
+TEST(LatencyCanaryTest, FailedProbesAreCountedAndExcludedFromTheWindow) {
+    RecordingSink sink;
+    metrics::LatencyCanary canary;
+    canary.SetSampleSink(sink.AsFn());
+    canary.AddProbe("flaky", []() { return false; }, 1000000);
+
+    for (int i = 0; i < 5; ++i) {
+        canary.RunOnce();
+    }
+
+    const auto stats = canary.GetProbeStats("flaky");
+    EXPECT_EQ(stats.samples, 0u);
+    EXPECT_EQ(stats.failures, 5u);
+    EXPECT_EQ(stats.p99_micros, 0u);
+    // Failures still reach the sink (flagged), so dashboards see them
+    std::lock_guard<std::mutex> lock(sink.mutex);
+    ASSERT_EQ(sink.samples.size(), 5u);
+    EXPECT_FALSE(sink.samples[0].second);
+}
+
+TEST(LatencyCanaryTest, AlertFiresOncePerThresholdCrossing) {
+    std::atomic<int> alerts{0};
+    metrics::LatencyCanary canary;
+    canary.SetAlertHandler([&alerts](const std::string&, std::uint64_t p99_us,
+                                     std::uint64_t threshold_us) {
+        EXPECT_GT(p99_us, threshold_us);
+        alerts.fetch_add(1);
+    });
+    // Every run sleeps 2 ms against a 1 ms threshold, so the windowed
+    // p99 is over the line as soon as the window is deep enough.
+    canary.AddProbe(
+        "slow",
+        []() {
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+            return true;
+        },
+        1000);
+
+    const int runs =
+        static_cast<int>(metrics::LatencyCanary::MIN_SAMPLES_FOR_ALERT) + 10;
+    for (int i = 0; i < runs; ++i) {
+        canary.RunOnce();
+    }
+
+    // Edge-triggered: the sustained breach pages exactly once
+    EXPECT_EQ(alerts.load(), 1);
+    EXPECT_EQ(canary.GetAlertCount(), 1u);
+    EXPECT_GT(canary.GetProbeStats("slow").p99_micros, 1000u);
+}
+
+TEST(LatencyCanaryTest, BackgroundCadenceRunsProbesUntilStopped) {
+    std::atomic<int> runs{0};
+    metrics::LatencyCanary canary;
+    canary.AddProbe("tick", [&runs]() {
+        runs.fetch_add(1);
+        return true;
+    }, 1000000);
+
+    ASSERT_TRUE(canary.Start(std::chrono::milliseconds(5)));
+    // Starting twice must be rejected while running
+    EXPECT_FALSE(canary.Start(std::chrono::milliseconds(5)));
+
+    for (int i = 0; i < 200 && runs.load() == 0; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    canary.Stop();
+    EXPECT_GE(runs.load(), 1);
+
+    const int after_stop = runs.load();
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_EQ(runs.load(), after_stop);
+}
@@ -0,0 +1,179 @@
+/*
+ * test_metrics_exporter.cpp
+ *
+ * Tests for the shared pull-based metrics exporter: exposition
+ * rendering, name sanitization, slot-ring persistence round-trips and
+ * the strategy PerformanceMonitor integration (counter re-seeding
+ * across a simulated restart).
+ */
+#include <gtest/gtest.h>
+
+#include "monitor/MetricsExporter.h"
+#include "monitor/PerformanceMonitor.h"
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#if !defined(_WIN32)
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+std::string TempRingPath(const char* tag) {
+    return std::string(::testing::TempDir()) + "metrics_ring_" + tag + ".bin";
+}
+
+} // namespace
+
+TEST(MetricsExporterTest, RendersExpositionFromCollectors) {
+    metrics::MetricsExporter exporter;
+    exporter.AddCollector([]() {
+        std::vector<metrics::MetricSample> samples;
+        samples.push_back({"requests_total", "counter", 42.0});
+        samples.push_back({"queue_depth", "gauge", 3.5});
+        return samples;
+    });
+
+    const std::string text = exporter.RenderExposition();
+    EXPECT_NE(text.find("# TYPE requests_total counter\n"), std::string::npos);
+    EXPECT_NE(text.find("requests_total 42\n"), std::string::npos);
+    EXPECT_NE(text.find("# TYPE queue_depth gauge\n"), std::string::npos);
+    EXPECT_NE(text.find("queue_depth 3.5\n"), std::string::npos);
+}
+
+TEST(MetricsExporterTest, SanitizesMetricNames) {
+    metrics::MetricsExporter exporter;
+    exporter.AddCollector([]() {
+        std::vector<metrics::MetricSample> samples;
+        samples.push_back({"rpc.handler-latency p99", "gauge", 1.0});
+        samples.push_back({"7days", "counter", 2.0});
+        return samples;
+    });
+
+    const std::string text = exporter.RenderExposition();
+    EXPECT_NE(text.find("rpc_handler_latency_p99 1\n"), std::string::npos);
+    EXPECT_NE(text.find("_7days 2\n"), std::string::npos);
+}
+
+TEST(MetricsExporterTest, PersistsAndRestoresAcrossRestart) {
+    const std::string path = TempRingPath("roundtrip");
+    std::remove(path.c_str());
+
+    double counter_value = 123.0;
+    {
+        metrics::MetricsExporter exporter;
+        exporter.AddCollector([&counter_value]() {
+            std::vector<metrics::MetricSample> samples;
+            samples.push_back({"events_total", "counter", counter_value});
+            return samples;
+        });
+        ASSERT_TRUE(exporter.Start(0, path));
+        exporter.Stop();  // writes the final snapshot
+    }
+
+    metrics::MetricsExporter restarted;
+    ASSERT_TRUE(restarted.Start(0, path));
+    const auto& restored = restarted.RestoredSamples();
+    restarted.Stop();
+
+    auto it = restored.find("events_total");
+    ASSERT_NE(it, restored.end());
+    EXPECT_DOUBLE_EQ(it->second, 123.0);
+
+    std::remove(path.c_str());
+}
+
+TEST(MetricsExporterTest, KeepsNewestValidSlotAfterMultipleSnapshots) {
+    const std::string path = TempRingPath("newest");
+    std::remove(path.c_str());
+
+    double value = 0.0;
+    for (int round = 0; round < 3; ++round) {
+        value = 10.0 * (round + 1);
+        metrics::MetricsExporter exporter;
+        exporter.AddCollector([&value]() {
+            std::vector<metrics::MetricSample> samples;
+            samples.push_back({"rounds_total", "counter", value});
+            return samples;
+        });
+        ASSERT_TRUE(exporter.Start(0, path));
+        exporter.Stop();
+    }
+
+    metrics::MetricsExporter restarted;
+    ASSERT_TRUE(restarted.Start(0, path));
+    const auto& restored = restarted.RestoredSamples();
+    restarted.Stop();
+
+    auto it = restored.find("rounds_total");
+    ASSERT_NE(it, restored.end());
+    EXPECT_DOUBLE_EQ(it->second, 30.0);
+
+    std::remove(path.c_str());
+}
+
+#if !defined(_WIN32)
+TEST(MetricsExporterTest, ServesExpositionOverHttp) {
+    metrics::MetricsExporter exporter;
+    exporter.AddCollector([]() {
+        std::vector<metrics::MetricSample> samples;
+        samples.push_back({"scrape_probe", "gauge", 7.0});
+        return samples;
+    });
+    if (!exporter.Start(0, "")) {
+        GTEST_SKIP() << "socket bind not permitted in this environment";
+    }
+    ASSERT_NE(exporter.Port(), 0);
+
+    const int client = ::socket(AF_INET, SOCK_STREAM, 0);
+    ASSERT_GE(client, 0);
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = htons(exporter.Port());
+    ASSERT_EQ(::connect(client, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)), 0);
+
+    const char request[] = "GET /metrics HTTP/1.0\r\n\r\n";
+    ASSERT_GT(::send(client, request, sizeof(request) - 1, 0), 0);
+
+    std::string response;
+    char buffer[1024];
+    ssize_t n = 0;
+    while ((n = ::recv(client, buffer, sizeof(buffer), 0)) > 0) {
+        response.append(buffer, static_cast<std::size_t>(n));
+    }
+    ::close(client);
+    exporter.Stop();
+
+    EXPECT_NE(response.find("200 OK"), std::string::npos);
+    EXPECT_NE(response.find("text/plain; version=0.0.4"), std::string::npos);
+    EXPECT_NE(response.find("scrape_probe 7\n"), std::string::npos);
+}
+#endif
+
+TEST(MetricsExporterTest, MonitorReseedsCountersAfterRestart) {
+    const std::string path = TempRingPath("monitor");
+    std::remove(path.c_str());
+
+    auto& monitor = strategy::PerformanceMonitor::GetInstance();
+    auto& counter = monitor.GetCounter("restart_probe_total");
+    counter.store(57);
+
+    if (!monitor.StartMetricsExporter(0, path)) {
+        GTEST_SKIP() << "socket bind not permitted in this environment";
+    }
+    monitor.StopMetricsExporter();  // persists 57
+
+    counter.store(0);  // simulate process restart losing in-memory state
+    ASSERT_TRUE(monitor.StartMetricsExporter(0, path));
+    monitor.StopMetricsExporter();
+
+    EXPECT_EQ(counter.load(), 57u);
+
+    std::remove(path.c_str());
+}
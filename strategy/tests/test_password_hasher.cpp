@@ -72,3 +72,31 @@ TEST(PasswordHasher, HashOutputIsHexOnly) {
             << "Non-hex char in hash: " << c;
     }
 }
+
+TEST(PasswordHasher, BatchVerifyMatchesSingleVerify) {
+    std::vector<std::string> passwords;
+    std::vector<std::string> stored;
+    for (int i = 0; i < 20; ++i) {
+        const std::string password = "player_password_" + std::to_string(i);
+        passwords.push_back(password);
+        stored.push_back(PasswordHasher::hashPassword(password));
+    }
+    // A few wrong passwords and one malformed stored entry.
+    passwords[3] = "wrong";
+    passwords[11] = "also wrong";
+    stored[7] = "nocolonhere";
+
+    const std::vector<bool> results = PasswordHasher::verifyPasswords(passwords, stored);
+    ASSERT_EQ(results.size(), passwords.size());
+    for (size_t i = 0; i < passwords.size(); ++i) {
+        EXPECT_EQ(results[i], PasswordHasher::verifyPassword(passwords[i], stored[i]))
+            << "mismatch at index " << i;
+    }
+    EXPECT_FALSE(results[3]);
+    EXPECT_FALSE(results[7]);
+    EXPECT_TRUE(results[0]);
+}
+
+TEST(PasswordHasher, BatchVerifyRejectsMismatchedSizes) {
+    EXPECT_TRUE(PasswordHasher::verifyPasswords({"one"}, {}).empty());
+}
@@ -60,3 +60,34 @@ TEST(SHA256, SingleCharacterHash) {
     std::string hash = SHA256::hash("a");
     EXPECT_EQ(hash, "ca978112ca1bbdcafac231b39a23dc4da786eff8147c4e72b9807785afee48bb");
 }
+
+TEST(SHA256, BatchMatchesSingleHashAcrossLengths) {
+    std::vector<std::string> inputs;
+    // Cover empty, sub-block, exactly-single-block-limit, and multi-block inputs.
+    inputs.push_back("");
+    inputs.push_back("abc");
+    inputs.push_back(std::string(55, 'x'));
+    inputs.push_back(std::string(56, 'y'));
+    inputs.push_back(std::string(200, 'z'));
+    for (int i = 0; i < 20; ++i) {
+        inputs.push_back("player_" + std::to_string(i));
+    }
+
+    const std::vector<std::string> batch = SHA256::hashBatch(inputs);
+    ASSERT_EQ(batch.size(), inputs.size());
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        EXPECT_EQ(batch[i], SHA256::hash(inputs[i])) << "mismatch at index " << i;
+    }
+}
+
+TEST(SHA256, BatchKnownVectors) {
+    const std::vector<std::string> batch = SHA256::hashBatch({"", "a", "hello world"});
+    ASSERT_EQ(batch.size(), 3u);
+    EXPECT_EQ(batch[0], "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855");
+    EXPECT_EQ(batch[1], "ca978112ca1bbdcafac231b39a23dc4da786eff8147c4e72b9807785afee48bb");
+    EXPECT_EQ(batch[2], "b94d27b9934d3e08a52e52d7da7dabfac484efe37a5380ee9088f7ace2efcde9");
+}
+
+TEST(SHA256, BatchHandlesEmptyInput) {
+    EXPECT_TRUE(SHA256::hashBatch({}).empty());
+}
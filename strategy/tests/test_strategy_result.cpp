@@ -0,0 +1,138 @@
+/*
+ * test_strategy_result.cpp
+ *
+ * Tests for the expected-style error channel: error codes with lazily
+ * formatted detail, Result value/error semantics, and the repository
+ * Try* paths that report predictable failures without throwing.
+ */
+#include <gtest/gtest.h>
+
+#include "common/StrategyResult.h"
+#include "database/BaseRepository.h"
+
+#include <any>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+// Connection whose statements always fail with a driver-style message.
+class FailingConnection : public strategy::IDatabaseConnection {
+public:
+    explicit FailingConnection(std::string error) : error_(std::move(error)) {}
+
+    bool Connect() override { return true; }
+    void Disconnect() override {}
+    bool IsConnected() const override { return true; }
+
+    strategy::QueryResult ExecuteQuery(const std::string&,
+                                       const std::vector<std::any>&) override {
+        throw std::runtime_error(error_);
+    }
+
+    int ExecuteUpdate(const std::string&,
+                      const std::vector<std::any>&) override {
+        throw std::runtime_error(error_);
+    }
+
+    bool BeginTransaction() override { return true; }
+    bool CommitTransaction() override { return true; }
+    bool RollbackTransaction() override { return true; }
+    long long GetLastInsertId() override { return 0; }
+
+private:
+    std::string error_;
+};
+
+// Exposes the protected Try* helpers for testing.
+class TryTestRepository : public strategy::BaseRepository {
+public:
+    using strategy::BaseRepository::BaseRepository;
+    using strategy::BaseRepository::TryExecuteQuery;
+    using strategy::BaseRepository::TryExecuteUpdate;
+    using strategy::BaseRepository::ExecuteUpdate;
+};
+
+} // namespace
+
+TEST(StrategyResultTest, ErrorCarriesCodeAndFormatsMessageLazily) {
+    const strategy::StrategyError error(strategy::StrategyErrc::PoolShutdown,
+                                        "ConnectionPool: 连接池已关闭");
+    EXPECT_EQ(error.Code(), strategy::StrategyErrc::PoolShutdown);
+    EXPECT_STREQ(error.Context(), "ConnectionPool: 连接池已关闭");
+    EXPECT_TRUE(error.Detail().empty());
+
+    const std::string message = error.Message();
+    EXPECT_NE(message.find("连接池已关闭"), std::string::npos);
+    EXPECT_NE(message.find("[pool_shutdown]"), std::string::npos);
+
+    const strategy::StrategyError detailed(strategy::StrategyErrc::QueryFailed,
+                                           "数据库语句执行失败",
+                                           "syntax error near SELECT");
+    EXPECT_NE(detailed.Message().find("syntax error near SELECT"), std::string::npos);
+}
+
+TEST(StrategyResultTest, ResultHoldsValueOrError) {
+    strategy::Result<int> ok(42);
+    ASSERT_TRUE(ok.HasValue());
+    EXPECT_EQ(ok.Value(), 42);
+    EXPECT_EQ(ok.ValueOr(-1), 42);
+
+    strategy::Result<int> failed(
+        strategy::StrategyError(strategy::StrategyErrc::NotFound, "记录不存在"));
+    ASSERT_FALSE(failed.HasValue());
+    EXPECT_EQ(failed.Error().Code(), strategy::StrategyErrc::NotFound);
+    EXPECT_EQ(failed.ValueOr(-1), -1);
+}
+
+TEST(StrategyResultTest, ValueOrThrowConvertsErrorToException) {
+    auto make_failed = []() {
+        return strategy::Result<int>(
+            strategy::StrategyError(strategy::StrategyErrc::PoolShutdown,
+                                    "ConnectionPool: 连接池已关闭"));
+    };
+    try {
+        make_failed().ValueOrThrow();
+        FAIL() << "expected StrategyException";
+    } catch (const strategy::StrategyException& e) {
+        EXPECT_EQ(e.GetErrorCode(),
+                  static_cast<int>(strategy::StrategyErrc::PoolShutdown));
+        EXPECT_NE(std::string(e.what()).find("连接池已关闭"), std::string::npos);
+    }
+}
+
+TEST(StrategyResultTest, RepositoryTryPathsReportErrorsWithoutThrowing) {
+    // Null connection: predictable failure, no exception on the Try path.
+    TryTestRepository empty_repo(nullptr);
+    auto no_conn = empty_repo.TryExecuteQuery("SELECT 1");
+    ASSERT_FALSE(no_conn.HasValue());
+    EXPECT_EQ(no_conn.Error().Code(), strategy::StrategyErrc::NotConnected);
+
+    // SQLite-style unique violation is classified as a constraint conflict.
+    TryTestRepository conflict_repo(std::make_unique<FailingConnection>(
+        "UNIQUE constraint failed: players.username"));
+    auto conflict = conflict_repo.TryExecuteUpdate(
+        "INSERT INTO players (username) VALUES (?)", {std::any(std::string("kang"))});
+    ASSERT_FALSE(conflict.HasValue());
+    EXPECT_EQ(conflict.Error().Code(), strategy::StrategyErrc::ConstraintViolation);
+    EXPECT_NE(conflict.Error().Detail().find("players.username"), std::string::npos);
+
+    // Other driver errors map to QueryFailed.
+    TryTestRepository broken_repo(std::make_unique<FailingConnection>(
+        "no such table: ghosts"));
+    auto broken = broken_repo.TryExecuteQuery("SELECT * FROM ghosts");
+    ASSERT_FALSE(broken.HasValue());
+    EXPECT_EQ(broken.Error().Code(), strategy::StrategyErrc::QueryFailed);
+
+    // The throwing wrapper still throws, now with the translated code.
+    try {
+        conflict_repo.ExecuteUpdate("INSERT INTO players (username) VALUES (?)",
+                                    {std::any(std::string("kang"))});
+        FAIL() << "expected StrategyException";
+    } catch (const strategy::StrategyException& e) {
+        EXPECT_EQ(e.GetErrorCode(),
+                  static_cast<int>(strategy::StrategyErrc::ConstraintViolation));
+    }
+}
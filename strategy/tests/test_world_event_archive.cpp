@@ -0,0 +1,184 @@
+/*
+ * test_world_event_archive.cpp
+ *
+ * Tests for the two-tier world event archive: hot-ring capping and
+ * staging, daily-partition naming, bulk archival through the
+ * repository, and queries spanning the hot and cold tiers.
+ */
+#include <gtest/gtest.h>
+
+#include "Algorithm_interact/WorldEventArchive.h"
+
+#include <any>
+#include <cctype>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr long long kMsPerDay = 24LL * 60LL * 60LL * 1000LL;
+
+// In-memory connection backing the cold tier: CREATE/INSERT statements
+// are recorded, inserted rows are kept per partition, and SELECTs
+// answer from them (tables never created throw like a real driver).
+class PartitionFakeConnection : public strategy::IDatabaseConnection {
+public:
+    bool Connect() override { return true; }
+    void Disconnect() override {}
+    bool IsConnected() const override { return true; }
+
+    strategy::QueryResult ExecuteQuery(const std::string& query,
+                                       const std::vector<std::any>& params) override {
+        const std::string partition = ExtractTableName(query, "FROM ");
+        auto it = partitions.find(partition);
+        if (it == partitions.end()) {
+            throw std::runtime_error("no such table: " + partition);
+        }
+        const long long from = std::any_cast<long long>(params.at(0));
+        const long long to = std::any_cast<long long>(params.at(1));
+        strategy::QueryResult rows;
+        for (const auto& row : it->second) {
+            const long long at = std::any_cast<long long>(row.at("triggered_at_ms"));
+            if (at >= from && at <= to) {
+                rows.push_back(row);
+            }
+        }
+        return rows;
+    }
+
+    int ExecuteUpdate(const std::string& query,
+                      const std::vector<std::any>& params) override {
+        statements.push_back(query);
+        if (query.rfind("CREATE TABLE", 0) == 0) {
+            partitions.try_emplace(ExtractTableName(query, "EXISTS "));
+            return 0;
+        }
+        if (query.rfind("INSERT INTO", 0) == 0) {
+            const std::string partition = ExtractTableName(query, "INSERT INTO ");
+            // Three columns per row, as built by ExecuteBulkInsert.
+            for (std::size_t i = 0; i + 3 <= params.size(); i += 3) {
+                partitions[partition].push_back(
+                    {{"event_id", params[i]},
+                     {"triggered_at_ms", params[i + 1]},
+                     {"result_json", params[i + 2]}});
+            }
+            return static_cast<int>(params.size() / 3);
+        }
+        return 0;
+    }
+
+    bool BeginTransaction() override { return true; }
+    bool CommitTransaction() override { return true; }
+    bool RollbackTransaction() override { return true; }
+    long long GetLastInsertId() override { return 0; }
+
+    std::vector<std::string> statements;
+    std::map<std::string, std::vector<std::map<std::string, std::any>>> partitions;
+
+private:
+    static std::string ExtractTableName(const std::string& query, const std::string& anchor) {
+        const std::size_t start = query.find(anchor) + anchor.size();
+        std::size_t end = start;
+        while (end < query.size() &&
+               (std::isalnum(static_cast<unsigned char>(query[end])) || query[end] == '_')) {
+            ++end;
+        }
+        return query.substr(start, end - start);
+    }
+};
+
+} // namespace
+
+TEST(WorldEventArchiveTest, PartitionNamesFollowUtcDays) {
+    // 2026-08-28 00:00:00 UTC.
+    const long long day_ms = 20693LL * kMsPerDay;
+    EXPECT_EQ(strategy::WorldEventPartitionRepository::PartitionNameFor(day_ms),
+              "world_events_p20260828");
+    EXPECT_EQ(strategy::WorldEventPartitionRepository::PartitionNameFor(day_ms - 1),
+              "world_events_p20260827");
+}
+
+TEST(WorldEventArchiveTest, HotRingCapsAndStagesEvictions) {
+    strategy::WorldEventArchive archive(4);
+    for (int i = 0; i < 6; ++i) {
+        archive.Record(100 + i, 1000 + i, "{}");
+    }
+
+    // The ring holds the newest four; the two evicted entries are
+    // staged (not dropped) and still answer queries.
+    EXPECT_EQ(archive.GetHotCount(), 4u);
+    EXPECT_EQ(archive.GetDroppedCount(), 0u);
+    const auto all = archive.Query(0, 2000);
+    ASSERT_EQ(all.size(), 6u);
+    EXPECT_EQ(all.front().event_id, 100);
+    EXPECT_EQ(all.back().event_id, 105);
+
+    // Without storage the staging buffer is capped at ring capacity.
+    for (int i = 0; i < 10; ++i) {
+        archive.Record(200 + i, 3000 + i, "{}");
+    }
+    EXPECT_GT(archive.GetDroppedCount(), 0u);
+}
+
+TEST(WorldEventArchiveTest, ArchivesOldEventsIntoDailyPartitions) {
+    auto connection = std::make_unique<PartitionFakeConnection>();
+    PartitionFakeConnection* backing = connection.get();
+
+    strategy::WorldEventArchive archive(16);
+    archive.AttachStorage(std::move(connection));
+
+    const long long day_ms = 20693LL * kMsPerDay;
+    archive.Record(1, day_ms - kMsPerDay, "{\"old\":1}");   // previous day
+    archive.Record(2, day_ms + 100, "{\"old\":2}");
+    archive.Record(3, day_ms + 5000, "{\"new\":true}");
+
+    // Cutoff between the second and third event: two rows move out.
+    EXPECT_EQ(archive.ArchiveOlderThan(day_ms + 1000), 2u);
+    EXPECT_EQ(archive.GetHotCount(), 1u);
+
+    ASSERT_EQ(backing->partitions.count("world_events_p20260827"), 1u);
+    ASSERT_EQ(backing->partitions.count("world_events_p20260828"), 1u);
+    EXPECT_EQ(backing->partitions["world_events_p20260827"].size(), 1u);
+    EXPECT_EQ(backing->partitions["world_events_p20260828"].size(), 1u);
+
+    // Partition DDL ran once per table, via CREATE TABLE IF NOT EXISTS.
+    int creates = 0;
+    for (const std::string& statement : backing->statements) {
+        if (statement.rfind("CREATE TABLE IF NOT EXISTS world_events_p", 0) == 0) {
+            ++creates;
+        }
+    }
+    EXPECT_EQ(creates, 2);
+
+    // A second pass with nothing old enough is a no-op.
+    EXPECT_EQ(archive.ArchiveOlderThan(day_ms + 1000), 0u);
+}
+
+TEST(WorldEventArchiveTest, QuerySpansColdAndHotTiers) {
+    auto connection = std::make_unique<PartitionFakeConnection>();
+    strategy::WorldEventArchive archive(16);
+    archive.AttachStorage(std::move(connection));
+
+    const long long day_ms = 20693LL * kMsPerDay;
+    for (int i = 0; i < 6; ++i) {
+        archive.Record(300 + i, day_ms + i * 1000, "{}");
+    }
+    // First three rows become cold, the rest stay hot.
+    ASSERT_EQ(archive.ArchiveOlderThan(day_ms + 2500), 3u);
+    ASSERT_EQ(archive.GetHotCount(), 3u);
+
+    const auto merged = archive.Query(day_ms, day_ms + 10000);
+    ASSERT_EQ(merged.size(), 6u);
+    for (int i = 0; i < 6; ++i) {
+        EXPECT_EQ(merged[i].event_id, 300 + i);
+    }
+
+    // Limit truncates the ascending merged view.
+    const auto limited = archive.Query(day_ms, day_ms + 10000, 2);
+    ASSERT_EQ(limited.size(), 2u);
+    EXPECT_EQ(limited[0].event_id, 300);
+    EXPECT_EQ(limited[1].event_id, 301);
+}
@@ -0,0 +1,129 @@
+/*
+ * test_world_flag_pages.cpp
+ *
+ * Tests for the namespace-paged bitset flag store and the world state
+ * engine's flag paths on top of it.
+ */
+#include <gtest/gtest.h>
+
+#include "Algorithm_interact/WorldFlagPages.h"
+#include "Algorithm_interact/WorldStateEngine.h"
+
+#include <string>
+#include <vector>
+
+TEST(WorldFlagPagesTest, RegistersDenseBitsPerNamespace) {
+    strategy::WorldFlagPages pages;
+
+    EXPECT_EQ(strategy::WorldFlagPages::NamespaceOf("quest_complete"), "quest_");
+    EXPECT_EQ(strategy::WorldFlagPages::NamespaceOf("bossdead"), "");
+
+    const auto quest_a = pages.Register("quest_a");
+    const auto quest_b = pages.Register("quest_b");
+    const auto combat_x = pages.Register("combat_x");
+
+    ASSERT_TRUE(quest_a.IsValid());
+    // Same namespace: same page, consecutive bits.
+    EXPECT_EQ(quest_a.page, quest_b.page);
+    EXPECT_EQ(quest_b.bit, quest_a.bit + 1);
+    // Different namespace: different page.
+    EXPECT_NE(combat_x.page, quest_a.page);
+    EXPECT_EQ(pages.PageNamespace(quest_a.page), "quest_");
+
+    // Registration is idempotent.
+    const auto again = pages.Register("quest_a");
+    EXPECT_EQ(again.page, quest_a.page);
+    EXPECT_EQ(again.bit, quest_a.bit);
+    EXPECT_EQ(pages.GetRegisteredCount(), 3u);
+
+    // Find does not register.
+    EXPECT_FALSE(pages.Find("never_registered_flag").IsValid());
+}
+
+TEST(WorldFlagPagesTest, SetReportsChangesAndBumpsPageVersion) {
+    strategy::WorldFlagPages pages;
+    const auto flag = pages.Register("combat_started");
+
+    EXPECT_FALSE(pages.Test(flag));
+    const auto version_before = pages.PageVersion(flag.page);
+
+    EXPECT_TRUE(pages.Set(flag, true));    // actually flips
+    EXPECT_TRUE(pages.Test(flag));
+    EXPECT_FALSE(pages.Set(flag, true));   // no-op write, no version bump
+    const auto version_after = pages.PageVersion(flag.page);
+    EXPECT_EQ(version_after, version_before + 1);
+
+    EXPECT_TRUE(pages.Set(flag, false));
+    EXPECT_FALSE(pages.Test(flag));
+
+    // Change tracking: only the touched page reports as changed.
+    const auto other = pages.Register("quest_done");
+    std::vector<std::uint64_t> known(pages.PageCount());
+    for (std::uint32_t i = 0; i < pages.PageCount(); ++i) {
+        known[i] = pages.PageVersion(i);
+    }
+    pages.Set(other, true);
+    const auto changed = pages.PagesChangedSince(known);
+    ASSERT_EQ(changed.size(), 1u);
+    EXPECT_EQ(changed[0], other.page);
+}
+
+TEST(WorldFlagPagesTest, BulkTestAndSetOperateOnHandleSpans) {
+    strategy::WorldFlagPages pages;
+    std::vector<strategy::FlagHandle> handles;
+    for (int i = 0; i < 8; ++i) {
+        handles.push_back(pages.Register("quest_step_" + std::to_string(i)));
+    }
+
+    EXPECT_FALSE(pages.TestAny(handles));
+    EXPECT_EQ(pages.SetMany(handles, true), 8u);
+    EXPECT_TRUE(pages.TestAll(handles));
+    EXPECT_EQ(pages.SetMany(handles, true), 0u);  // already set
+
+    pages.Set(handles[3], false);
+    EXPECT_FALSE(pages.TestAll(handles));
+    EXPECT_TRUE(pages.TestAny(handles));
+}
+
+TEST(WorldFlagPagesTest, FullNamespacePageChainsANewOne) {
+    strategy::WorldFlagPages pages;
+    strategy::FlagHandle first;
+    strategy::FlagHandle overflow;
+    for (std::uint32_t i = 0; i <= strategy::WorldFlagPages::PAGE_FLAG_CAPACITY; ++i) {
+        const auto handle = pages.Register("quest_" + std::to_string(i));
+        if (i == 0) {
+            first = handle;
+        }
+        overflow = handle;
+    }
+    ASSERT_TRUE(overflow.IsValid());
+    EXPECT_NE(overflow.page, first.page);
+    EXPECT_EQ(overflow.bit, 0u);
+    EXPECT_EQ(pages.PageNamespace(overflow.page), "quest_");
+}
+
+TEST(WorldFlagPagesTest, EngineFlagsAreBackedByPages) {
+    strategy::WorldStateEngine engine;
+
+    engine.SetWorldFlag("quest_dragon_slain", true);
+    EXPECT_TRUE(engine.GetWorldFlag("quest_dragon_slain"));
+    EXPECT_FALSE(engine.GetWorldFlag("quest_never_set"));
+
+    // Id-based path and the bulk all-set test.
+    const auto slain_id = engine.InternKey("quest_dragon_slain");
+    const auto gate_id = engine.InternKey("quest_gate_open");
+    EXPECT_TRUE(engine.GetWorldFlag(slain_id));
+
+    const std::vector<strategy::StringId> both = {slain_id, gate_id};
+    EXPECT_FALSE(engine.TestWorldFlagsAll(both));
+    EXPECT_EQ(engine.SetWorldFlags(both, true), 1u);  // slain already set
+    EXPECT_TRUE(engine.TestWorldFlagsAll(both));
+
+    // Snapshots still materialize the name-keyed map shape.
+    const auto state = engine.GetCurrentWorldState();
+    const auto it = state.world_flags.find("quest_gate_open");
+    ASSERT_NE(it, state.world_flags.end());
+    EXPECT_TRUE(it->second);
+
+    EXPECT_GE(engine.FlagPages().GetRegisteredCount(), 2u);
+}
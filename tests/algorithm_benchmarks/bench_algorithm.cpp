@@ -0,0 +1,158 @@
+/*
+ * bench_algorithm.cpp
+ * Algorithm layer microbenchmarks (Google Benchmark).
+ *
+ * Fixtures mirror production battle sizes: 500 registered characters
+ * and 200 NPCs. Run via `make bench_algorithm && ./bin/bench_algorithm`.
+ */
+#include <benchmark/benchmark.h>
+
+#include "AIDecisionEngine.h"
+#include "AlgorithmService.h"
+#include "DamageCalculator.h"
+#include "InputValidator.h"
+#include "SkillTreeManager.h"
+
+#include <vector>
+
+using namespace algorithm;
+
+namespace {
+
+constexpr int kCharacterCount = 500;
+constexpr int kNpcCount = 200;
+
+/**
+ * @brief Shared fixture: service with 500 characters and 200 typed NPCs.
+ */
+class AlgorithmFixture : public benchmark::Fixture {
+public:
+    void SetUp(const benchmark::State&) override {
+        service = std::make_unique<AlgorithmService>();
+
+        for (int i = 0; i < kCharacterCount; ++i) {
+            Profession profession =
+                static_cast<Profession>(1 + (i % 3));  // Warrior/Mage/Archer
+            CharacterStats stats =
+                service->GetDefaultStats(profession, 1 + (i % 50));
+            stats.character_id = i + 1;
+            service->RegisterCharacter(stats);
+        }
+
+        for (int i = 0; i < kNpcCount; ++i) {
+            service->RegisterNPCType(i + 1, static_cast<NPCType>(i % 5));
+        }
+    }
+
+    void TearDown(const benchmark::State&) override { service.reset(); }
+
+    std::unique_ptr<AlgorithmService> service;
+};
+
+} // namespace
+
+// ============================================================================
+// DamageCalculator::CalculateExtendedDamage
+// ============================================================================
+BENCHMARK_F(AlgorithmFixture, ExtendedDamage)(benchmark::State& state) {
+    ExtendedDamageRequest request;
+    request.attacker = *service->GetCharacterStats(1);
+    request.defender = *service->GetCharacterStats(2);
+    request.skill_id = 100;  // 强力斩
+    request.skill_level = 3;
+
+    for (auto _ : state) {
+        auto result = service->CalculateExtendedDamage(request);
+        benchmark::DoNotOptimize(result);
+    }
+}
+
+// ============================================================================
+// AIDecisionEngine::MakeDecision — one decision per NPC across the zone
+// ============================================================================
+BENCHMARK_F(AlgorithmFixture, AIDecisionPerNpc)(benchmark::State& state) {
+    std::vector<AIDecisionRequest> requests;
+    requests.reserve(kNpcCount);
+    for (int i = 0; i < kNpcCount; ++i) {
+        AIDecisionRequest request;
+        request.npc_id = i + 1;
+        // 距离 / 血量% / 战斗中 / 威胁
+        request.context = {3 + (i % 10), 20 + (i % 80), 1, i % 10};
+        requests.push_back(request);
+    }
+
+    for (auto _ : state) {
+        for (const auto& request : requests) {
+            auto result = service->MakeAIDecision(request);
+            benchmark::DoNotOptimize(result);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * kNpcCount);
+}
+
+// ============================================================================
+// AlgorithmService::MakeAIDecisionsBatch — same workload, one batch call
+// ============================================================================
+BENCHMARK_F(AlgorithmFixture, AIDecisionBatch)(benchmark::State& state) {
+    std::vector<AIDecisionRequest> requests;
+    requests.reserve(kNpcCount);
+    for (int i = 0; i < kNpcCount; ++i) {
+        AIDecisionRequest request;
+        request.npc_id = i + 1;
+        request.context = {3 + (i % 10), 20 + (i % 80), 1, i % 10};
+        requests.push_back(request);
+    }
+
+    for (auto _ : state) {
+        auto results = service->MakeAIDecisionsBatch(requests);
+        benchmark::DoNotOptimize(results);
+    }
+    state.SetItemsProcessed(state.iterations() * kNpcCount);
+}
+
+// ============================================================================
+// SkillTreeManager::GetSkill — frozen-index lookup over the full id range
+// ============================================================================
+static void BM_SkillLookup(benchmark::State& state) {
+    SkillTreeManager manager;
+    const std::vector<int> ids = {1, 2, 3, 100, 105, 109, 200, 204,
+                                  209, 300, 306, 309, 42, 150, 250};
+
+    for (auto _ : state) {
+        for (int id : ids) {
+            benchmark::DoNotOptimize(manager.GetSkill(id));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(ids.size()));
+}
+BENCHMARK(BM_SkillLookup);
+
+// ============================================================================
+// InputValidator — damage request validation hot path
+// ============================================================================
+static void BM_ValidateDamageRequest(benchmark::State& state) {
+    CharacterStatsRegistry registry;
+    SkillTreeManager skill_manager;
+    InputValidator validator;
+
+    for (int i = 0; i < kCharacterCount; ++i) {
+        CharacterStats stats =
+            registry.getDefaultStats(static_cast<Profession>(1 + (i % 3)), 10);
+        stats.character_id = i + 1;
+        registry.registerCharacter(stats);
+    }
+
+    DamageRequest request;
+    request.attacker_id = 1;
+    request.defender_id = 2;
+    request.skill_id = 100;
+
+    for (auto _ : state) {
+        auto result =
+            validator.validateDamageRequest(request, registry, skill_manager);
+        benchmark::DoNotOptimize(result);
+    }
+}
+BENCHMARK(BM_ValidateDamageRequest);
+
+BENCHMARK_MAIN();
@@ -4,6 +4,7 @@
  */
 #include <gtest/gtest.h>
 #include "AlgorithmService.h"
+#include "AIDecisionEngine.h"
 
 using namespace algorithm;
 
@@ -120,6 +121,108 @@ TEST_F(AlgorithmServiceTest, MakeAIDecisionInvalidRequestReturnsDefault) {
     EXPECT_EQ(result.action_id, 0);  // default/idle on validation failure
 }
 
+// ============================================================================
+// AI difficulty scaling
+// ============================================================================
+
+TEST_F(AlgorithmServiceTest, DifficultyReactionDelayPropagatesToResult) {
+    service.RegisterNPCType(20, NPCType::Warrior);
+
+    DifficultyParams params;
+    params.reaction_delay_ms = 250;
+    service.SetAIDifficulty(NPCType::Warrior, params);
+
+    AIDecisionRequest req;
+    req.npc_id = 20;
+    req.context = {5, 80, 1, 5};
+
+    auto result = service.MakeAIDecision(req);
+    EXPECT_EQ(result.reaction_delay_ms, 250);
+}
+
+TEST_F(AlgorithmServiceTest, DifficultyPerNpcOverrideBeatsTypeBaseline) {
+    AIDecisionEngine engine;
+    engine.RegisterNPCType(30, NPCType::Warrior);
+    engine.RegisterNPCType(31, NPCType::Warrior);
+
+    DifficultyParams baseline;
+    baseline.reaction_delay_ms = 100;
+    engine.SetDifficulty(NPCType::Warrior, baseline);
+
+    DifficultyParams override_params;
+    override_params.reaction_delay_ms = 300;
+    engine.SetNPCDifficulty(31, override_params);
+
+    AIDecisionRequest req;
+    req.npc_id = 30;
+    req.context = {5, 80, 1, 5};
+    EXPECT_EQ(engine.MakeDecision(req).reaction_delay_ms, 100);
+
+    req.npc_id = 31;
+    EXPECT_EQ(engine.MakeDecision(req).reaction_delay_ms, 300);
+
+    engine.ClearNPCDifficulty(31);
+    EXPECT_EQ(engine.MakeDecision(req).reaction_delay_ms, 100);
+}
+
+TEST_F(AlgorithmServiceTest, DifficultyHighAggressionFavorsAttackWhenHurt) {
+    AIDecisionEngine engine;
+    engine.RegisterNPCType(40, NPCType::Warrior);
+
+    // Low-HP warrior candidates mix heal/defend/attack; with the
+    // aggressive tilt and near-greedy temperature, attack dominates
+    DifficultyParams params;
+    params.aggression = 100.0f;
+    params.choice_temperature = 0.05f;
+    engine.SetDifficulty(NPCType::Warrior, params);
+
+    AIDecisionRequest req;
+    req.npc_id = 40;
+    req.context = {3, 30, 1, 5, 80};  // near, low hp, in combat, has mana
+
+    for (int i = 0; i < 20; ++i) {
+        EXPECT_EQ(engine.MakeDecision(req).action_id, 1);
+    }
+}
+
+TEST_F(AlgorithmServiceTest, DifficultyLowAggressionAvoidsAttackWhenHurt) {
+    AIDecisionEngine engine;
+    engine.RegisterNPCType(41, NPCType::Warrior);
+
+    DifficultyParams params;
+    params.aggression = 0.01f;
+    params.choice_temperature = 0.05f;
+    engine.SetDifficulty(NPCType::Warrior, params);
+
+    AIDecisionRequest req;
+    req.npc_id = 41;
+    req.context = {3, 30, 1, 5, 80};
+
+    for (int i = 0; i < 20; ++i) {
+        EXPECT_NE(engine.MakeDecision(req).action_id, 1);
+    }
+}
+
+TEST_F(AlgorithmServiceTest, DifficultyChangeKeepsDecisionCacheWarm) {
+    AIDecisionEngine engine;
+    engine.RegisterNPCType(50, NPCType::Mage);
+
+    AIDecisionRequest req;
+    req.npc_id = 50;
+    req.context = {15, 90, 1, 5, 80};
+    engine.MakeDecision(req);
+    const auto before = engine.GetDecisionCacheStats();
+
+    DifficultyParams params;
+    params.aggression = 2.0f;
+    engine.SetDifficulty(NPCType::Mage, params);
+
+    engine.MakeDecision(req);
+    const auto after = engine.GetDecisionCacheStats();
+    EXPECT_EQ(after.entries, before.entries);
+    EXPECT_EQ(after.hits, before.hits + 1);  // tuning did not evict the entry
+}
+
 // ============================================================================
 // Element multiplier
 // ============================================================================
@@ -237,3 +340,255 @@ TEST_F(AlgorithmServiceTest, ValidateSkillLearnInvalidSkillFails) {
     auto result = service.ValidateSkillLearn(9999, Profession::Warrior, {});
     EXPECT_FALSE(result.success);
 }
+
+// ============================================================================
+// Batch damage calculation
+// ============================================================================
+
+TEST_F(AlgorithmServiceTest, CalculateDamageBatchMatchesRequestOrder) {
+    for (int id = 1; id <= 4; ++id) {
+        CharacterStats stats = service.GetDefaultStats(Profession::Warrior, 5);
+        stats.character_id = id;
+        stats.name = "Combatant" + std::to_string(id);
+        service.RegisterCharacter(stats);
+    }
+
+    std::vector<DamageRequest> requests;
+    for (int defender = 2; defender <= 4; ++defender) {
+        requests.push_back({1, defender, 1});
+    }
+
+    auto results = service.CalculateDamageBatch(requests);
+
+    ASSERT_EQ(results.size(), requests.size());
+    for (const auto& result : results) {
+        EXPECT_GT(result.damage, 0);
+    }
+}
+
+TEST_F(AlgorithmServiceTest, CalculateDamageBatchEmptyReturnsEmpty) {
+    auto results = service.CalculateDamageBatch({});
+    EXPECT_TRUE(results.empty());
+}
+
+// ============================================================================
+// Batch AI decisions
+// ============================================================================
+
+TEST_F(AlgorithmServiceTest, BatchAIDecisionsMatchRequestOrder) {
+    std::vector<AIDecisionRequest> requests;
+    for (int npc_id = 1; npc_id <= 30; ++npc_id) {
+        service.RegisterNPCType(npc_id, (npc_id % 2 == 0) ? NPCType::Mage : NPCType::Warrior);
+        AIDecisionRequest request;
+        request.npc_id = npc_id;
+        request.context = {3, 80, 1, 5};
+        requests.push_back(request);
+    }
+
+    auto results = service.MakeAIDecisionsBatch(requests);
+
+    ASSERT_EQ(results.size(), requests.size());
+    for (const auto& result : results) {
+        EXPECT_GE(result.action_id, 0);
+        EXPECT_LE(result.action_id, 9);
+        EXPECT_FALSE(result.description.empty());
+    }
+}
+
+TEST_F(AlgorithmServiceTest, BatchAIDecisionsInvalidRequestIsolated) {
+    service.RegisterNPCType(1, NPCType::Warrior);
+
+    AIDecisionRequest valid;
+    valid.npc_id = 1;
+    valid.context = {3, 80, 1, 5};
+
+    AIDecisionRequest invalid;
+    invalid.npc_id = -1;  // Invalid NPC id fails validation
+    invalid.context = {3, 80, 1, 5};
+
+    std::vector<AIDecisionRequest> requests{valid, invalid};
+    auto results = service.MakeAIDecisionsBatch(requests);
+
+    ASSERT_EQ(results.size(), 2u);
+    EXPECT_FALSE(results[0].description.empty());
+    EXPECT_EQ(results[1].action_id, 0);
+}
+
+// ============================================================================
+// AIDecisionEngine decision-memory slab tests
+// ============================================================================
+
+TEST(AIDecisionEngineMemory, DecisionsStillValidAfterGlobalClear) {
+    AIDecisionEngine engine;
+    engine.RegisterNPCType(7, NPCType::Warrior);
+
+    AIDecisionRequest request;
+    request.npc_id = 7;
+    request.context = {3, 80, 1, 5};
+
+    for (int i = 0; i < 10; ++i) {
+        auto result = engine.MakeDecision(request);
+        EXPECT_GT(result.action_id, 0);
+    }
+
+    engine.ClearMemory();  // O(1)代数推进
+    auto result = engine.MakeDecision(request);
+    EXPECT_GT(result.action_id, 0);
+}
+
+TEST(AIDecisionEngineMemory, BudgetOverflowDoesNotBreakDecisions) {
+    AIDecisionEngine engine;
+    engine.SetMemoryBudget(2);  // 仅追踪2个NPC
+
+    AIDecisionRequest request;
+    request.context = {3, 80, 1, 5};
+    for (int npc = 1; npc <= 5; ++npc) {
+        engine.RegisterNPCType(npc, NPCType::Archer);
+        request.npc_id = npc;
+        auto result = engine.MakeDecision(request);
+        EXPECT_GT(result.action_id, 0);
+    }
+
+    engine.ClearMemory(3);  // 未追踪NPC的单独清除也应安全
+}
+
+// ============================================================================
+// Boss phase precomputation tests
+// ============================================================================
+
+TEST(AIDecisionEngineBossPhase, DesperatePhaseUsesDesperateCandidates) {
+    AIDecisionEngine engine;
+    engine.RegisterNPCType(9, NPCType::Boss);
+
+    AIDecisionRequest request;
+    request.npc_id = 9;
+    request.context = {3, 10, 1, 8};  // HP 10% → 绝望阶段
+
+    for (int i = 0; i < 20; ++i) {
+        auto result = engine.MakeDecision(request);
+        // 绝望阶段候选集仅含必杀(9)和技能(3)
+        EXPECT_TRUE(result.action_id == 9 || result.action_id == 3)
+            << "unexpected action " << result.action_id;
+    }
+}
+
+TEST(AIDecisionEngineBossPhase, PhaseBoundariesMatchThresholds) {
+    AIDecisionEngine engine;
+    engine.RegisterNPCType(9, NPCType::Boss);
+
+    // 正常阶段 (HP > 50%) 的候选集不含必杀技(9)
+    AIDecisionRequest request;
+    request.npc_id = 9;
+    request.context = {3, 100, 1, 8};
+    for (int i = 0; i < 20; ++i) {
+        auto result = engine.MakeDecision(request);
+        EXPECT_NE(result.action_id, 9);
+    }
+
+    // 越界HP值被钳制，不会越过查表范围
+    request.context = {3, 250, 1, 8};
+    EXPECT_NO_THROW(engine.MakeDecision(request));
+    request.context = {3, -5, 1, 8};
+    EXPECT_NO_THROW(engine.MakeDecision(request));
+}
+
+// ============================================================================
+// AIDecisionEngine decision-cache tests
+// ============================================================================
+
+TEST(AIDecisionEngineCache, SameQuantizedSituationHitsAfterFirstMiss) {
+    AIDecisionEngine engine;
+
+    AIDecisionRequest request;
+    request.npc_id = 1;
+    request.context = {3, 80, 1, 2};  // 近战、高HP、战斗中、低威胁
+    engine.MakeDecision(request);
+
+    auto stats = engine.GetDecisionCacheStats();
+    EXPECT_EQ(stats.misses, 1u);
+    EXPECT_EQ(stats.hits, 0u);
+    EXPECT_EQ(stats.entries, 1u);
+
+    // 不同NPC、不同原始数值，但量化档位相同 → 命中
+    request.npc_id = 42;
+    request.context = {4, 85, 1, 3};
+    engine.MakeDecision(request);
+
+    stats = engine.GetDecisionCacheStats();
+    EXPECT_EQ(stats.misses, 1u);
+    EXPECT_EQ(stats.hits, 1u);
+    EXPECT_EQ(stats.entries, 1u);
+}
+
+TEST(AIDecisionEngineCache, ConditionBoundariesSeparateEntries) {
+    AIDecisionEngine engine;
+
+    AIDecisionRequest request;
+    request.npc_id = 1;
+
+    // HP 39 与 40 横跨IsHealthLow阈值(<40) → 两个条目
+    request.context = {3, 39, 1, 2};
+    engine.MakeDecision(request);
+    request.context = {3, 40, 1, 2};
+    engine.MakeDecision(request);
+    auto stats = engine.GetDecisionCacheStats();
+    EXPECT_EQ(stats.misses, 2u);
+    EXPECT_EQ(stats.entries, 2u);
+
+    // HP 41 与 50 同在[40,50]档 → 命中HP 40建立的条目
+    request.context = {3, 41, 1, 2};
+    engine.MakeDecision(request);
+    request.context = {3, 50, 1, 2};
+    engine.MakeDecision(request);
+    stats = engine.GetDecisionCacheStats();
+    EXPECT_EQ(stats.misses, 2u);
+    EXPECT_EQ(stats.hits, 2u);
+    EXPECT_EQ(stats.entries, 2u);
+}
+
+TEST(AIDecisionEngineCache, InvalidatePerTypeRemovesOnlyThatType) {
+    AIDecisionEngine engine;
+    engine.RegisterNPCType(7, NPCType::Mage);
+
+    AIDecisionRequest warrior_request;
+    warrior_request.npc_id = 1;  // 未注册 → 默认战士
+    warrior_request.context = {3, 80, 1, 2};
+    engine.MakeDecision(warrior_request);
+
+    AIDecisionRequest mage_request;
+    mage_request.npc_id = 7;
+    mage_request.context = {3, 80, 1, 2, 90};
+    engine.MakeDecision(mage_request);
+
+    EXPECT_EQ(engine.GetDecisionCacheStats().entries, 2u);
+
+    engine.InvalidateDecisionCache(NPCType::Mage);
+    EXPECT_EQ(engine.GetDecisionCacheStats().entries, 1u);
+
+    // 法师情境重新求值，战士条目仍命中
+    engine.MakeDecision(mage_request);
+    engine.MakeDecision(warrior_request);
+    const auto stats = engine.GetDecisionCacheStats();
+    EXPECT_EQ(stats.entries, 2u);
+    EXPECT_EQ(stats.misses, 3u);
+    EXPECT_EQ(stats.hits, 1u);
+}
+
+TEST(AIDecisionEngineCache, CachedSituationsStillProduceValidDecisions) {
+    AIDecisionEngine engine;
+    engine.RegisterNPCType(9, NPCType::Boss);
+
+    AIDecisionRequest request;
+    request.npc_id = 9;
+    request.context = {3, 10, 1, 8};  // 绝望阶段
+
+    // 命中路径下阶段候选集约束依旧成立
+    for (int i = 0; i < 20; ++i) {
+        auto result = engine.MakeDecision(request);
+        EXPECT_TRUE(result.action_id == 9 || result.action_id == 3)
+            << "unexpected action " << result.action_id;
+    }
+    const auto stats = engine.GetDecisionCacheStats();
+    EXPECT_EQ(stats.misses, 1u);
+    EXPECT_EQ(stats.hits, 19u);
+}
@@ -0,0 +1,75 @@
+/*
+ * test_bulk_status_ticker.cpp
+ * BulkStatusTicker unit tests
+ */
+#include <gtest/gtest.h>
+#include "BulkStatusTicker.h"
+
+#include <algorithm>
+#include <vector>
+
+using namespace algorithm;
+
+namespace {
+
+float DeltaFor(const std::vector<BulkStatusTicker::HpDelta>& deltas, int target_id) {
+    for (const auto& delta : deltas) {
+        if (delta.target_id == target_id) {
+            return delta.delta;
+        }
+    }
+    return 0.0f;
+}
+
+} // namespace
+
+TEST(BulkStatusTicker, AggregatesDeltasPerTargetInOnePass) {
+    BulkStatusTicker ticker;
+    ASSERT_TRUE(ticker.addEffect(1, StatusEffectType::Burn, 10.0f, 3, 1000.0f));
+    ASSERT_TRUE(ticker.addEffect(1, StatusEffectType::Poison, 0.05f, 3, 1000.0f));
+    ASSERT_TRUE(ticker.addEffect(2, StatusEffectType::Regeneration, 0.02f, 2, 500.0f));
+    EXPECT_EQ(ticker.size(), 3u);
+
+    const auto deltas = ticker.tickAll();
+    ASSERT_EQ(deltas.size(), 2u);
+    // Target 1: -10 burn plus -50 poison (5% of 1000) combined into one entry.
+    EXPECT_FLOAT_EQ(DeltaFor(deltas, 1), -60.0f);
+    // Target 2: +10 regen (2% of 500).
+    EXPECT_FLOAT_EQ(DeltaFor(deltas, 2), 10.0f);
+}
+
+TEST(BulkStatusTicker, ExpiredEffectsAreCompactedAway) {
+    BulkStatusTicker ticker;
+    ticker.addEffect(1, StatusEffectType::Bleed, 5.0f, 1, 100.0f);
+    ticker.addEffect(1, StatusEffectType::Burn, 3.0f, 2, 100.0f);
+
+    auto deltas = ticker.tickAll();
+    EXPECT_FLOAT_EQ(DeltaFor(deltas, 1), -8.0f);
+    EXPECT_EQ(ticker.size(), 1u);  // the one-turn bleed is gone
+
+    deltas = ticker.tickAll();
+    EXPECT_FLOAT_EQ(DeltaFor(deltas, 1), -3.0f);
+    EXPECT_EQ(ticker.size(), 0u);
+
+    // A fully drained ticker produces no deltas.
+    EXPECT_TRUE(ticker.tickAll().empty());
+}
+
+TEST(BulkStatusTicker, RejectsNonHpEffectsAndRemovesDeadTargets) {
+    BulkStatusTicker ticker;
+    // Stun and Shield do not change HP per turn and stay out of the columns.
+    EXPECT_FALSE(ticker.addEffect(1, StatusEffectType::Stun, 1.0f, 2, 100.0f));
+    EXPECT_FALSE(ticker.addEffect(1, StatusEffectType::Shield, 50.0f, 2, 100.0f));
+    EXPECT_FALSE(ticker.addEffect(1, StatusEffectType::Burn, 5.0f, 0, 100.0f));
+    EXPECT_EQ(ticker.size(), 0u);
+
+    ticker.addEffect(1, StatusEffectType::Burn, 5.0f, 5, 100.0f);
+    ticker.addEffect(2, StatusEffectType::Burn, 7.0f, 5, 100.0f);
+    ticker.removeTarget(1);
+    EXPECT_EQ(ticker.size(), 1u);
+
+    const auto deltas = ticker.tickAll();
+    ASSERT_EQ(deltas.size(), 1u);
+    EXPECT_EQ(deltas[0].target_id, 2);
+    EXPECT_FLOAT_EQ(deltas[0].delta, -7.0f);
+}
@@ -160,3 +160,58 @@ TEST_F(CharacterStatsRegistryTest, ScaleByLevelOneReturnsSame) {
     EXPECT_FLOAT_EQ(scaled.max_hp, base.max_hp);
     EXPECT_FLOAT_EQ(scaled.attack, base.attack);
 }
+
+// ============================================================================
+// SoA stats columns
+// ============================================================================
+
+TEST_F(CharacterStatsRegistryTest, StatsColumnsTrackRegistration) {
+    CharacterStats stats = registry.getDefaultStats(Profession::Archer, 3);
+    stats.character_id = 42;
+    registry.registerCharacter(stats);
+
+    const auto& columns = registry.getStatsColumns();
+    int row = registry.getStatsRow(42);
+    ASSERT_GE(row, 0);
+    ASSERT_LT(static_cast<size_t>(row), columns.size());
+    EXPECT_EQ(columns.character_id[row], 42);
+    EXPECT_FLOAT_EQ(columns.attack[row], stats.attack);
+    EXPECT_FLOAT_EQ(columns.defense[row], stats.defense);
+    EXPECT_EQ(columns.element[row], stats.element);
+}
+
+TEST_F(CharacterStatsRegistryTest, ReRegisterUpdatesColumnsInPlace) {
+    CharacterStats stats = registry.getDefaultStats(Profession::Warrior, 1);
+    stats.character_id = 7;
+    registry.registerCharacter(stats);
+    const size_t rows_before = registry.getStatsColumns().size();
+
+    stats.attack = 99.0f;
+    registry.registerCharacter(stats);
+
+    const auto& columns = registry.getStatsColumns();
+    EXPECT_EQ(columns.size(), rows_before);
+    int row = registry.getStatsRow(7);
+    ASSERT_GE(row, 0);
+    EXPECT_FLOAT_EQ(columns.attack[row], 99.0f);
+}
+
+TEST_F(CharacterStatsRegistryTest, GatherStatsSkipsUnknownIds) {
+    for (int id = 1; id <= 3; ++id) {
+        CharacterStats stats = registry.getDefaultStats(Profession::Mage, id);
+        stats.character_id = id;
+        registry.registerCharacter(stats);
+    }
+
+    CharacterStatsColumns gathered;
+    size_t count = registry.gatherStats({3, 999, 1}, gathered);
+
+    EXPECT_EQ(count, 2u);
+    ASSERT_EQ(gathered.size(), 2u);
+    EXPECT_EQ(gathered.character_id[0], 3);
+    EXPECT_EQ(gathered.character_id[1], 1);
+}
+
+TEST_F(CharacterStatsRegistryTest, GetStatsRowReturnsMinusOneForUnknown) {
+    EXPECT_EQ(registry.getStatsRow(55555), -1);
+}
@@ -0,0 +1,86 @@
+/*
+ * test_client_rate_limiter.cpp
+ * Per-client token-bucket rate limiter tests (deterministic time)
+ */
+#include <gtest/gtest.h>
+#include "net/ClientRateLimiter.h"
+
+using net::ClientRateLimiter;
+using net::RateLimitConfig;
+using net::RpcClass;
+
+namespace {
+
+constexpr std::int64_t kSecond = 1'000'000;  // microseconds
+
+ClientRateLimiter MakeLimiter() {
+    // Tiny budgets so tests exhaust them in a few calls:
+    // Read 1/s burst 2, Compute 1/s burst 1, Mutate unlimited, Stream 1/s burst 1.
+    return ClientRateLimiter({{
+        {1.0, 2.0},
+        {1.0, 1.0},
+        {0.0, 0.0},
+        {1.0, 1.0},
+    }});
+}
+
+} // namespace
+
+TEST(ClientRateLimiterTest, BurstThenRejectUntilRefill) {
+    ClientRateLimiter limiter = MakeLimiter();
+
+    EXPECT_TRUE(limiter.TryAcquireAt("peerA", RpcClass::Read, 0));
+    EXPECT_TRUE(limiter.TryAcquireAt("peerA", RpcClass::Read, 0));
+    EXPECT_FALSE(limiter.TryAcquireAt("peerA", RpcClass::Read, 0));
+    EXPECT_EQ(limiter.RejectedCount(RpcClass::Read), 1u);
+
+    // One second refills one token; the bucket never exceeds its burst.
+    EXPECT_TRUE(limiter.TryAcquireAt("peerA", RpcClass::Read, kSecond));
+    EXPECT_FALSE(limiter.TryAcquireAt("peerA", RpcClass::Read, kSecond));
+
+    EXPECT_EQ(limiter.AdmittedCount(RpcClass::Read), 3u);
+    EXPECT_EQ(limiter.RejectedCount(RpcClass::Read), 2u);
+    EXPECT_EQ(limiter.TotalRejected(), 2u);
+}
+
+TEST(ClientRateLimiterTest, ClientsHaveIndependentBuckets) {
+    ClientRateLimiter limiter = MakeLimiter();
+
+    // peerA drains its compute bucket; peerB's budget is untouched.
+    EXPECT_TRUE(limiter.TryAcquireAt("peerA", RpcClass::Compute, 0));
+    EXPECT_FALSE(limiter.TryAcquireAt("peerA", RpcClass::Compute, 0));
+    EXPECT_TRUE(limiter.TryAcquireAt("peerB", RpcClass::Compute, 0));
+}
+
+TEST(ClientRateLimiterTest, ClassesHaveIndependentBuckets) {
+    ClientRateLimiter limiter = MakeLimiter();
+
+    // Draining compute does not consume the same peer's read budget.
+    EXPECT_TRUE(limiter.TryAcquireAt("peerA", RpcClass::Compute, 0));
+    EXPECT_FALSE(limiter.TryAcquireAt("peerA", RpcClass::Compute, 0));
+    EXPECT_TRUE(limiter.TryAcquireAt("peerA", RpcClass::Read, 0));
+}
+
+TEST(ClientRateLimiterTest, NonPositiveRateDisablesLimiting) {
+    ClientRateLimiter limiter = MakeLimiter();
+
+    for (int i = 0; i < 100; ++i) {
+        EXPECT_TRUE(limiter.TryAcquireAt("peerA", RpcClass::Mutate, 0));
+    }
+    EXPECT_EQ(limiter.RejectedCount(RpcClass::Mutate), 0u);
+}
+
+TEST(ClientRateLimiterTest, IdlePeersAreEvictedWhenTableIsFull) {
+    ClientRateLimiter limiter = MakeLimiter();
+
+    for (std::size_t i = 0; i < ClientRateLimiter::kMaxTrackedClients; ++i) {
+        limiter.TryAcquireAt("peer" + std::to_string(i), RpcClass::Read, 0);
+    }
+    EXPECT_EQ(limiter.TrackedClients(), ClientRateLimiter::kMaxTrackedClients);
+
+    // A new peer past the cutoff sweeps every idle entry first.
+    const std::int64_t later =
+        (ClientRateLimiter::kIdleEvictSeconds + 1) * kSecond;
+    EXPECT_TRUE(limiter.TryAcquireAt("latecomer", RpcClass::Read, later));
+    EXPECT_EQ(limiter.TrackedClients(), 1u);
+}
@@ -5,6 +5,9 @@
 #include <gtest/gtest.h>
 #include "CooldownTracker.h"
 
+#include <thread>
+#include <vector>
+
 using namespace algorithm;
 
 class CooldownTrackerTest : public ::testing::Test {
@@ -118,3 +121,40 @@ TEST_F(CooldownTrackerTest, MultipleTicks) {
     tracker.tick(5000);
     EXPECT_TRUE(tracker.isReady(1, 100));
 }
+
+TEST_F(CooldownTrackerTest, ConcurrentStartAndQueryAcrossCharacters) {
+    // Many battle sessions touching disjoint characters concurrently.
+    std::vector<std::thread> workers;
+    for (int t = 0; t < 4; ++t) {
+        workers.emplace_back([this, t]() {
+            const int base_id = t * 1000;
+            for (int i = 0; i < 200; ++i) {
+                tracker.startCooldown(base_id + i, 100, 5000);
+                tracker.isReady(base_id + i, 100);
+                tracker.getRemainingCooldown(base_id + i, 100);
+            }
+        });
+    }
+    workers.emplace_back([this]() {
+        for (int i = 0; i < 100; ++i) {
+            tracker.tickAll(10);
+        }
+    });
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    // Clock advanced by 1000ms total; all cooldowns still pending.
+    EXPECT_FALSE(tracker.isReady(0, 100));
+    EXPECT_FALSE(tracker.isReady(3000, 100));
+}
+
+TEST_F(CooldownTrackerTest, TickAllAdvancesEveryCharacter) {
+    tracker.startCooldown(1, 100, 2000);
+    tracker.startCooldown(2, 100, 3000);
+
+    tracker.tickAll(2500);
+
+    EXPECT_TRUE(tracker.isReady(1, 100));
+    EXPECT_FALSE(tracker.isReady(2, 100));
+}
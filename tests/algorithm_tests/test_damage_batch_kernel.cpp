@@ -0,0 +1,109 @@
+/*
+ * test_damage_batch_kernel.cpp
+ * DamageBatchKernel unit tests (SIMD kernel vs scalar formula)
+ */
+#include <gtest/gtest.h>
+#include "DamageBatchKernel.h"
+#include "DamageCalculator.h"
+
+using namespace algorithm;
+
+namespace {
+
+float ScalarFormula(float base, float elem, float defense, float crit,
+                    float buff, float variance) {
+    const float defense_mult = 1.0f - defense / (defense + 100.0f);
+    return base * elem * defense_mult * crit * buff * variance;
+}
+
+} // namespace
+
+TEST(DamageBatchKernelTest, EmptyInputProducesEmptyOutput) {
+    DamageBatchSoA input;
+    std::vector<float> output;
+    ComputeDamageBatch(input, output);
+    EXPECT_TRUE(output.empty());
+}
+
+TEST(DamageBatchKernelTest, MatchesScalarFormula) {
+    // 21 targets: exercises both the 4-wide SIMD loop and the scalar tail.
+    DamageBatchSoA input;
+    const size_t count = 21;
+    input.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        const float f = static_cast<float>(i);
+        input.base_damage.push_back(40.0f + f * 3.0f);
+        input.element_multiplier.push_back(0.75f + 0.05f * static_cast<float>(i % 5));
+        input.defense.push_back(f * 7.0f);
+        input.crit_multiplier.push_back((i % 3 == 0) ? 1.5f : 1.0f);
+        input.attack_buff.push_back(1.0f + 0.1f * static_cast<float>(i % 2));
+        input.variance.push_back(0.95f + 0.005f * f);
+    }
+
+    std::vector<float> output;
+    ComputeDamageBatch(input, output);
+
+    ASSERT_EQ(output.size(), count);
+    for (size_t i = 0; i < count; ++i) {
+        const float expected = ScalarFormula(
+            input.base_damage[i], input.element_multiplier[i], input.defense[i],
+            input.crit_multiplier[i], input.attack_buff[i], input.variance[i]);
+        EXPECT_NEAR(output[i], expected, expected * 1e-5f) << "target " << i;
+    }
+}
+
+TEST(DamageBatchKernelTest, ZeroDefenseLeavesDamageUnreduced) {
+    DamageBatchSoA input;
+    input.base_damage = {100.0f};
+    input.element_multiplier = {1.0f};
+    input.defense = {0.0f};
+    input.crit_multiplier = {1.0f};
+    input.attack_buff = {1.0f};
+    input.variance = {1.0f};
+
+    std::vector<float> output;
+    ComputeDamageBatch(input, output);
+
+    ASSERT_EQ(output.size(), 1u);
+    EXPECT_FLOAT_EQ(output[0], 100.0f);
+}
+
+TEST(DamageCalculatorAoeTest, AoeDamageResolvesAllTargets) {
+    DamageCalculator calculator;
+
+    AoeDamageRequest request;
+    request.attacker.attack = 30.0f;
+    request.attacker.element = Element::Fire;
+    request.skill_id = 1;
+
+    for (int i = 0; i < 20; ++i) {
+        CharacterStats defender;
+        defender.character_id = 100 + i;
+        defender.defense = 5.0f + static_cast<float>(i);
+        defender.element = (i % 2 == 0) ? Element::Grass : Element::Water;
+        request.defenders.push_back(defender);
+    }
+
+    auto results = calculator.CalculateAoeDamage(request);
+
+    ASSERT_EQ(results.size(), request.defenders.size());
+    for (const auto& result : results) {
+        EXPECT_GE(result.damage, 1);
+        EXPECT_FALSE(result.effect.empty());
+    }
+}
+
+TEST(DamageCalculatorAoeTest, AoeInvalidSkillReturnsZeroDamage) {
+    DamageCalculator calculator;
+
+    AoeDamageRequest request;
+    request.skill_id = 99999;
+    request.defenders.resize(3);
+
+    auto results = calculator.CalculateAoeDamage(request);
+
+    ASSERT_EQ(results.size(), 3u);
+    for (const auto& result : results) {
+        EXPECT_EQ(result.damage, 0);
+    }
+}
@@ -4,6 +4,7 @@
  */
 #include <gtest/gtest.h>
 #include "AlgorithmService.h"
+#include "BattleRng.h"
 
 using namespace algorithm;
 
@@ -70,6 +71,26 @@ TEST_F(DamageCalculatorTest, DamageResultHasEffectDescription) {
     EXPECT_FALSE(result.effect.empty());
 }
 
+TEST_F(DamageCalculatorTest, EffectDescriptionCarriesSkillDamageAndMultiplier) {
+    ExtendedDamageRequest ext;
+    ext.attacker = *service.GetCharacterStats(1);
+    ext.defender = *service.GetCharacterStats(2);
+    ext.skill_id = 1;
+    ext.skill_level = 1;
+
+    auto result = service.CalculateExtendedDamage(ext);
+
+    // Stack-buffer formatting must keep the established description shape:
+    // skill name in brackets, the damage number, and the one-decimal
+    // element multiplier when the hit has an advantage.
+    EXPECT_NE(result.effect.find("使用 ["), std::string::npos);
+    EXPECT_NE(result.effect.find("造成 " + std::to_string(result.damage) + " 点"),
+              std::string::npos);
+    if (result.element_multiplier > 1.1f) {
+        EXPECT_NE(result.effect.find("(克制效果 x2.0)"), std::string::npos);
+    }
+}
+
 TEST_F(DamageCalculatorTest, ExtendedDamageFireVsGrassHasElementAdvantage) {
     ExtendedDamageRequest ext;
     ext.attacker = *service.GetCharacterStats(1);
@@ -101,3 +122,70 @@ TEST_F(DamageCalculatorTest, SameAttackerDefenderReturnsZeroDamage) {
     auto result = service.CalculateDamage(req);
     EXPECT_EQ(result.damage, 0);
 }
+
+// ============================================================================
+// Deterministic battle RNG tests
+// ============================================================================
+
+TEST_F(DamageCalculatorTest, SameSeedReplaysIdenticalDamageSequence) {
+    ExtendedDamageRequest req;
+    req.attacker = *service.GetCharacterStats(1);
+    req.defender = *service.GetCharacterStats(2);
+    req.skill_id = 100;
+    req.skill_level = 2;
+
+    service.SetBattleSeed(12345);
+    std::vector<int> first_run;
+    for (int i = 0; i < 8; ++i) {
+        first_run.push_back(service.CalculateExtendedDamage(req).damage);
+    }
+
+    service.SetBattleSeed(12345);
+    for (int i = 0; i < 8; ++i) {
+        EXPECT_EQ(service.CalculateExtendedDamage(req).damage, first_run[i]);
+    }
+}
+
+TEST_F(DamageCalculatorTest, DifferentSeedsDivergeSomewhere) {
+    ExtendedDamageRequest req;
+    req.attacker = *service.GetCharacterStats(1);
+    req.defender = *service.GetCharacterStats(2);
+    req.skill_id = 100;
+    req.skill_level = 2;
+
+    service.SetBattleSeed(1);
+    std::vector<int> run_a;
+    for (int i = 0; i < 16; ++i) {
+        run_a.push_back(service.CalculateExtendedDamage(req).damage);
+    }
+
+    service.SetBattleSeed(2);
+    bool diverged = false;
+    for (int i = 0; i < 16; ++i) {
+        if (service.CalculateExtendedDamage(req).damage != run_a[i]) {
+            diverged = true;
+        }
+    }
+    EXPECT_TRUE(diverged);
+}
+
+TEST(BattleRng, CounterDrawsAreStatelessAndReproducible) {
+    BattleRng rng(42);
+    float a = rng.uniform01At(7);
+    float b = rng.uniform01At(7);
+    EXPECT_FLOAT_EQ(a, b);
+    EXPECT_GE(a, 0.0f);
+    EXPECT_LT(a, 1.0f);
+
+    // 顺序取数与按计数器取数一致
+    BattleRng sequential(42);
+    EXPECT_FLOAT_EQ(sequential.uniform01(), rng.uniform01At(0));
+    EXPECT_FLOAT_EQ(sequential.uniform01(), rng.uniform01At(1));
+}
+
+TEST(BattleRng, ReserveReturnsDisjointRanges) {
+    BattleRng rng(9);
+    EXPECT_EQ(rng.reserve(3), 0u);
+    EXPECT_EQ(rng.reserve(5), 3u);
+    EXPECT_EQ(rng.reserve(1), 8u);
+}
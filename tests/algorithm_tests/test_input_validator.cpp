@@ -244,3 +244,42 @@ TEST_F(DamageRequestValidatorTest, ValidRequestProducesDamage) {
     // Should return a result (damage might be 0 if skill doesn't exist, but no crash)
     EXPECT_GE(result.damage, 0);
 }
+
+// ============================================================================
+// validateField / validateFields tests (table-driven rules)
+// ============================================================================
+
+TEST_F(InputValidatorTest, KnownNumericFieldInRangePasses) {
+    EXPECT_TRUE(validator.validateField("skill_id", "100").success);
+    EXPECT_TRUE(validator.validateField("level", "50").success);
+    EXPECT_TRUE(validator.validateField("crit_rate", "0.25").success);
+}
+
+TEST_F(InputValidatorTest, KnownNumericFieldOutOfRangeFails) {
+    EXPECT_FALSE(validator.validateField("skill_id", "99999").success);
+    EXPECT_FALSE(validator.validateField("level", "0").success);
+    EXPECT_FALSE(validator.validateField("crit_rate", "1.5").success);
+}
+
+TEST_F(InputValidatorTest, NonNumericValueForNumericFieldFails) {
+    EXPECT_FALSE(validator.validateField("skill_id", "abc").success);
+    EXPECT_FALSE(validator.validateField("crit_rate", "fast").success);
+}
+
+TEST_F(InputValidatorTest, UnknownFieldOnlyRequiresNonEmpty) {
+    EXPECT_TRUE(validator.validateField("custom_tag", "whatever").success);
+    EXPECT_FALSE(validator.validateField("custom_tag", "").success);
+}
+
+TEST_F(InputValidatorTest, ValidateFieldsPreservesOrder) {
+    std::vector<std::pair<std::string, std::string>> fields = {
+        {"skill_id", "100"},
+        {"level", "999"},
+        {"name", "Hero"},
+    };
+    auto results = validator.validateFields(fields);
+    ASSERT_EQ(results.size(), 3u);
+    EXPECT_TRUE(results[0].success);
+    EXPECT_FALSE(results[1].success);
+    EXPECT_TRUE(results[2].success);
+}
@@ -0,0 +1,188 @@
+/*
+ * test_navigation_service.cpp
+ * NavigationService unit tests
+ */
+#include <gtest/gtest.h>
+#include "NavigationService.h"
+
+#include <cstdlib>
+#include <vector>
+
+using namespace algorithm;
+
+namespace {
+
+// 全可行走网格
+std::vector<uint8_t> OpenGrid(int width, int height) {
+    return std::vector<uint8_t>(
+        static_cast<size_t>(width) * static_cast<size_t>(height), 1);
+}
+
+void SetBlocked(std::vector<uint8_t>& grid, int width, int x, int y) {
+    grid[static_cast<size_t>(y) * static_cast<size_t>(width) +
+         static_cast<size_t>(x)] = 0;
+}
+
+// 路径合法性: 首尾匹配查询端点，相邻拐点轴对齐
+void ExpectValidWaypoints(const PathResult& result,
+                          GridPoint start, GridPoint goal) {
+    ASSERT_TRUE(result.reachable);
+    ASSERT_FALSE(result.waypoints.empty());
+    EXPECT_EQ(result.waypoints.front().x, start.x);
+    EXPECT_EQ(result.waypoints.front().y, start.y);
+    EXPECT_EQ(result.waypoints.back().x, goal.x);
+    EXPECT_EQ(result.waypoints.back().y, goal.y);
+    for (size_t i = 1; i < result.waypoints.size(); ++i) {
+        const GridPoint& a = result.waypoints[i - 1];
+        const GridPoint& b = result.waypoints[i];
+        EXPECT_TRUE(a.x == b.x || a.y == b.y)
+            << "拐点段必须轴对齐: (" << a.x << "," << a.y
+            << ") -> (" << b.x << "," << b.y << ")";
+    }
+}
+
+} // namespace
+
+class NavigationServiceTest : public ::testing::Test {
+protected:
+    NavigationService nav;
+};
+
+TEST_F(NavigationServiceTest, RegisterRejectsBadDimensions) {
+    auto grid = OpenGrid(8, 8);
+    EXPECT_FALSE(nav.RegisterMap(1, 0, 8, grid));
+    EXPECT_FALSE(nav.RegisterMap(1, 8, -1, grid));
+    EXPECT_FALSE(nav.RegisterMap(1, 9, 8, grid));  // 长度与尺寸不符
+    EXPECT_TRUE(nav.RegisterMap(1, 8, 8, grid));
+}
+
+TEST_F(NavigationServiceTest, WalkableQueryCoversBoundsAndBlockedCells) {
+    auto grid = OpenGrid(8, 8);
+    SetBlocked(grid, 8, 3, 3);
+    ASSERT_TRUE(nav.RegisterMap(1, 8, 8, grid));
+
+    EXPECT_TRUE(nav.IsWalkable(1, {0, 0}));
+    EXPECT_FALSE(nav.IsWalkable(1, {3, 3}));
+    EXPECT_FALSE(nav.IsWalkable(1, {8, 0}));    // 越界
+    EXPECT_FALSE(nav.IsWalkable(99, {0, 0}));   // 未注册地图
+}
+
+TEST_F(NavigationServiceTest, StraightPathCompressesToTwoWaypoints) {
+    ASSERT_TRUE(nav.RegisterMap(1, 8, 8, OpenGrid(8, 8)));
+
+    const PathResult result = nav.FindPath({1, {0, 4}, {7, 4}});
+    ExpectValidWaypoints(result, {0, 4}, {7, 4});
+    EXPECT_EQ(result.waypoints.size(), 2u);  // 直线只剩起终点
+}
+
+TEST_F(NavigationServiceTest, PathRoutesAroundWall) {
+    auto grid = OpenGrid(8, 8);
+    // 竖墙留一个缺口 (3, 7)
+    for (int y = 0; y < 7; ++y) {
+        SetBlocked(grid, 8, 3, y);
+    }
+    ASSERT_TRUE(nav.RegisterMap(1, 8, 8, grid));
+
+    const PathResult result = nav.FindPath({1, {0, 0}, {7, 0}});
+    ExpectValidWaypoints(result, {0, 0}, {7, 0});
+    // 必须绕到缺口行
+    bool passes_gap_row = false;
+    for (const GridPoint& point : result.waypoints) {
+        if (point.y == 7) {
+            passes_gap_row = true;
+        }
+    }
+    EXPECT_TRUE(passes_gap_row);
+}
+
+TEST_F(NavigationServiceTest, FullWallMakesGoalUnreachable) {
+    auto grid = OpenGrid(8, 8);
+    for (int y = 0; y < 8; ++y) {
+        SetBlocked(grid, 8, 3, y);
+    }
+    ASSERT_TRUE(nav.RegisterMap(1, 8, 8, grid));
+
+    const PathResult result = nav.FindPath({1, {0, 0}, {7, 0}});
+    EXPECT_FALSE(result.reachable);
+    EXPECT_TRUE(result.waypoints.empty());
+
+    // 可达性快判与寻路结论一致
+    EXPECT_FALSE(nav.IsReachable(1, {0, 0}, {7, 0}));
+    EXPECT_TRUE(nav.IsReachable(1, {0, 0}, {2, 7}));
+}
+
+TEST_F(NavigationServiceTest, SameCellQueryIsTrivial) {
+    ASSERT_TRUE(nav.RegisterMap(1, 8, 8, OpenGrid(8, 8)));
+    const PathResult result = nav.FindPath({1, {4, 4}, {4, 4}});
+    ASSERT_TRUE(result.reachable);
+    ASSERT_EQ(result.waypoints.size(), 1u);
+    EXPECT_EQ(result.waypoints.front().x, 4);
+}
+
+TEST_F(NavigationServiceTest, CrossRegionRepeatQueryHitsCache) {
+    // 40格宽跨越3个区域块，起终点落在不同区域
+    ASSERT_TRUE(nav.RegisterMap(1, 40, 8, OpenGrid(40, 8)));
+
+    const PathResult first = nav.FindPath({1, {0, 0}, {39, 0}});
+    ASSERT_TRUE(first.reachable);
+    EXPECT_FALSE(first.from_cache);
+
+    const PathResult second = nav.FindPath({1, {1, 1}, {38, 2}});
+    ASSERT_TRUE(second.reachable);
+    // 起终区域相同 → 区域路径直接来自缓存
+    EXPECT_TRUE(second.from_cache);
+
+    const auto stats = nav.GetPathCacheStats();
+    EXPECT_EQ(stats.entries, 1u);
+    EXPECT_EQ(stats.hits, 1u);
+    EXPECT_EQ(stats.misses, 1u);
+}
+
+TEST_F(NavigationServiceTest, ReRegisterInvalidatesCachedPaths) {
+    ASSERT_TRUE(nav.RegisterMap(1, 40, 8, OpenGrid(40, 8)));
+    ASSERT_TRUE(nav.FindPath({1, {0, 0}, {39, 0}}).reachable);
+    ASSERT_EQ(nav.GetPathCacheStats().entries, 1u);
+
+    // 重新注册后旧区域号作废，缓存必须清空
+    ASSERT_TRUE(nav.RegisterMap(1, 40, 8, OpenGrid(40, 8)));
+    EXPECT_EQ(nav.GetPathCacheStats().entries, 0u);
+
+    const PathResult after = nav.FindPath({1, {0, 0}, {39, 0}});
+    ASSERT_TRUE(after.reachable);
+    EXPECT_FALSE(after.from_cache);
+}
+
+TEST_F(NavigationServiceTest, BatchMatchesSingleQueries) {
+    auto grid = OpenGrid(40, 8);
+    for (int y = 1; y < 8; ++y) {
+        SetBlocked(grid, 40, 20, y);
+    }
+    ASSERT_TRUE(nav.RegisterMap(1, 40, 8, grid));
+
+    const std::vector<PathQuery> queries = {
+        {1, {0, 0}, {39, 7}},
+        {1, {5, 5}, {5, 5}},
+        {99, {0, 0}, {1, 1}},     // 未注册地图
+        {1, {20, 4}, {0, 0}},     // 起点在墙上
+    };
+    const auto batch = nav.FindPathsBatch(queries);
+    ASSERT_EQ(batch.size(), queries.size());
+
+    for (size_t i = 0; i < queries.size(); ++i) {
+        const PathResult single = nav.FindPath(queries[i]);
+        EXPECT_EQ(batch[i].reachable, single.reachable) << "查询 " << i;
+    }
+    EXPECT_TRUE(batch[0].reachable);
+    EXPECT_TRUE(batch[1].reachable);
+    EXPECT_FALSE(batch[2].reachable);
+    EXPECT_FALSE(batch[3].reachable);
+}
+
+TEST_F(NavigationServiceTest, UnregisterMapDropsQueries) {
+    ASSERT_TRUE(nav.RegisterMap(1, 8, 8, OpenGrid(8, 8)));
+    ASSERT_TRUE(nav.FindPath({1, {0, 0}, {7, 7}}).reachable);
+
+    nav.UnregisterMap(1);
+    EXPECT_FALSE(nav.FindPath({1, {0, 0}, {7, 7}}).reachable);
+    EXPECT_FALSE(nav.IsReachable(1, {0, 0}, {7, 7}));
+}
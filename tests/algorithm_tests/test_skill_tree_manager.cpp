@@ -0,0 +1,194 @@
+/*
+ * test_skill_tree_manager.cpp
+ * SkillTreeManager frozen index tests
+ */
+#include <gtest/gtest.h>
+#include "SkillTreeManager.h"
+
+using namespace algorithm;
+
+class SkillTreeManagerTest : public ::testing::Test {
+protected:
+    SkillTreeManager manager;
+};
+
+TEST_F(SkillTreeManagerTest, FrozenAfterConstruction) {
+    EXPECT_TRUE(manager.IsFrozen());
+}
+
+TEST_F(SkillTreeManagerTest, FrozenLookupFindsDefaultSkills) {
+    const SkillNode* basic = manager.GetSkill(1);
+    ASSERT_NE(basic, nullptr);
+    EXPECT_EQ(basic->skill_id, 1);
+
+    const SkillNode* ultimate = manager.GetSkill(309);
+    ASSERT_NE(ultimate, nullptr);
+    EXPECT_EQ(ultimate->skill_id, 309);
+}
+
+TEST_F(SkillTreeManagerTest, FrozenLookupRejectsUnknownIds) {
+    EXPECT_EQ(manager.GetSkill(-1), nullptr);
+    EXPECT_EQ(manager.GetSkill(50), nullptr);
+    EXPECT_EQ(manager.GetSkill(99999), nullptr);
+}
+
+TEST_F(SkillTreeManagerTest, AddSkillInvalidatesFreezeUntilRefrozen) {
+    SkillNode custom;
+    custom.skill_id = 400;
+    custom.name = "TestSkill";
+    custom.prerequisites = {1};
+    manager.AddSkill(custom);
+
+    // 未冻结时走哈希表路径，新技能立即可见
+    EXPECT_FALSE(manager.IsFrozen());
+    ASSERT_NE(manager.GetSkill(400), nullptr);
+
+    manager.FreezeTree();
+    EXPECT_TRUE(manager.IsFrozen());
+    const SkillNode* skill = manager.GetSkill(400);
+    ASSERT_NE(skill, nullptr);
+    EXPECT_EQ(skill->name, "TestSkill");
+}
+
+TEST_F(SkillTreeManagerTest, FrozenPrerequisiteCheckMatchesSkillData) {
+    // 106 重击 requires 102 and 103
+    EXPECT_FALSE(manager.CanLearnSkill(106, {102}));
+    EXPECT_TRUE(manager.CanLearnSkill(106, {102, 103}));
+    // 技能1无前置
+    EXPECT_TRUE(manager.CanLearnSkill(1, {}));
+    EXPECT_FALSE(manager.CanLearnSkill(99999, {}));
+}
+
+TEST_F(SkillTreeManagerTest, EvaluatedTreeReflectsReportedState) {
+    // 自洽的已学集合：102/103的前置100及其前置1都已学习
+    manager.UpdateCharacterSkillState(7, {1, 100, 102, 103}, {2, 1, 1, 1});
+
+    const EvaluatedSkillTree tree = manager.GetEvaluatedTree(7);
+    ASSERT_EQ(static_cast<int>(tree.entries.size()), manager.GetSkillCount());
+    EXPECT_EQ(tree.state_version, 1u);
+    EXPECT_EQ(tree.tree_version, manager.GetTreeVersion());
+
+    auto find_entry = [&tree](int skill_id) -> const EvaluatedSkillEntry* {
+        for (const auto& entry : tree.entries) {
+            if (entry.skill_id == skill_id) return &entry;
+        }
+        return nullptr;
+    };
+
+    // 已学技能: 解锁并带等级折算值
+    const EvaluatedSkillEntry* basic = find_entry(1);
+    ASSERT_NE(basic, nullptr);
+    EXPECT_TRUE(basic->unlocked);
+    EXPECT_EQ(basic->level, 2);
+    EXPECT_FLOAT_EQ(basic->effective_multiplier, manager.GetScaledMultiplier(1, 2));
+    EXPECT_EQ(basic->effective_cooldown_ms, manager.GetScaledCooldown(1, 2));
+
+    // 106 前置(102,103)已满足: 可学但未学习
+    const EvaluatedSkillEntry* unlockable = find_entry(106);
+    ASSERT_NE(unlockable, nullptr);
+    EXPECT_TRUE(unlockable->unlocked);
+    EXPECT_EQ(unlockable->level, 0);
+
+    // 再次上报递增状态版本
+    manager.UpdateCharacterSkillState(7, {1, 100, 102, 103, 106}, {2, 1, 1, 1, 1});
+    EXPECT_EQ(manager.GetEvaluatedTree(7).state_version, 2u);
+}
+
+TEST_F(SkillTreeManagerTest, ClosureUnlockabilityIsTransitive) {
+    // 106 重击的闭包: 直接前置102/103 + 传递前置100/1
+    const auto partial = manager.BuildLearnedBitset({102, 103});
+    EXPECT_FALSE(manager.IsSkillUnlockable(106, partial));
+
+    const auto full = manager.BuildLearnedBitset({1, 100, 102, 103});
+    EXPECT_TRUE(manager.IsSkillUnlockable(106, full));
+
+    // 无前置技能对任意位集都可解锁；未知ID不可
+    EXPECT_TRUE(manager.IsSkillUnlockable(1, partial));
+    EXPECT_FALSE(manager.IsSkillUnlockable(99999, full));
+}
+
+TEST_F(SkillTreeManagerTest, BatchUnlockabilityMatchesPerSkillQueries) {
+    const std::vector<int> learned = {1, 2, 100, 101};
+    const auto flags = manager.EvaluateUnlockability(learned);
+    const auto all_skills = manager.GetAllSkills();
+    ASSERT_EQ(flags.size(), all_skills.size());
+
+    const auto bits = manager.BuildLearnedBitset(learned);
+    for (size_t i = 0; i < all_skills.size(); ++i) {
+        EXPECT_EQ(flags[i] != 0,
+                  manager.IsSkillUnlockable(all_skills[i]->skill_id, bits))
+            << "skill_id=" << all_skills[i]->skill_id;
+    }
+
+    // 抽查: 102(前置100)可解锁，106(闭包含102/103)不可
+    const auto find_flag = [&](int skill_id) -> bool {
+        for (size_t i = 0; i < all_skills.size(); ++i) {
+            if (all_skills[i]->skill_id == skill_id) return flags[i] != 0;
+        }
+        return false;
+    };
+    EXPECT_TRUE(find_flag(102));
+    EXPECT_FALSE(find_flag(106));
+}
+
+TEST_F(SkillTreeManagerTest, ClosureRebuiltAfterRefreeze) {
+    SkillNode custom;
+    custom.skill_id = 400;
+    custom.name = "ClosureSkill";
+    custom.prerequisites = {106};  // 闭包应展开到 102/103/100/1
+    manager.AddSkill(custom);
+    manager.FreezeTree();
+
+    EXPECT_FALSE(manager.IsSkillUnlockable(
+        400, manager.BuildLearnedBitset({106, 102, 103})));
+    EXPECT_TRUE(manager.IsSkillUnlockable(
+        400, manager.BuildLearnedBitset({1, 100, 102, 103, 106})));
+}
+
+TEST_F(SkillTreeManagerTest, EffectiveMultiplierUsesCacheWithFallback) {
+    manager.UpdateCharacterSkillState(7, {1}, {2});
+
+    // 缓存等级一致: 读预算值；等级不一致或角色未知: 现场折算
+    EXPECT_FLOAT_EQ(manager.GetEffectiveMultiplier(7, 1, 2),
+                    manager.GetScaledMultiplier(1, 2));
+    EXPECT_FLOAT_EQ(manager.GetEffectiveMultiplier(7, 1, 3),
+                    manager.GetScaledMultiplier(1, 3));
+    EXPECT_FLOAT_EQ(manager.GetEffectiveMultiplier(999, 1, 2),
+                    manager.GetScaledMultiplier(1, 2));
+}
+
+TEST_F(SkillTreeManagerTest, EvaluatedTreeSnapshotRoundTripsAndGuardsVersion) {
+    manager.UpdateCharacterSkillState(7, {1, 102}, {2, 1});
+
+    const std::string blob = manager.SerializeEvaluatedTree(7);
+    ASSERT_FALSE(blob.empty());
+    // 无缓存角色序列化为空串
+    EXPECT_TRUE(manager.SerializeEvaluatedTree(12345).empty());
+
+    // 恢复到另一个角色ID，条目逐项一致
+    ASSERT_TRUE(manager.RestoreEvaluatedTree(99, blob));
+    const EvaluatedSkillTree restored = manager.GetEvaluatedTree(99);
+    const EvaluatedSkillTree original = manager.GetEvaluatedTree(7);
+    ASSERT_EQ(restored.entries.size(), original.entries.size());
+    EXPECT_EQ(restored.state_version, original.state_version);
+
+    // 截断负载被拒绝
+    EXPECT_FALSE(manager.RestoreEvaluatedTree(98, blob.substr(0, blob.size() / 2)));
+
+    // 技能树内容更新后旧快照失效，缓存也随之判为缺失
+    SkillNode custom;
+    custom.skill_id = 400;
+    custom.name = "TestSkill";
+    manager.AddSkill(custom);
+    manager.FreezeTree();
+    EXPECT_FALSE(manager.RestoreEvaluatedTree(99, blob));
+    EXPECT_TRUE(manager.GetEvaluatedTree(7).entries.empty());
+}
+
+TEST_F(SkillTreeManagerTest, FrozenProfessionListSortedById) {
+    auto skills = manager.GetSkillsByProfession(Profession::Mage);
+    ASSERT_FALSE(skills.empty());
+    for (size_t i = 1; i < skills.size(); ++i) {
+        EXPECT_LT(skills[i - 1]->skill_id, skills[i]->skill_id);
+    }
+}
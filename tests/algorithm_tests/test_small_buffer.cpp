@@ -0,0 +1,109 @@
+/*
+ * test_small_buffer.cpp
+ * SmallVector/SmallString unit tests
+ */
+#include <gtest/gtest.h>
+#include "SmallBuffer.h"
+#include "AlgorithmService.h"
+
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace algorithm;
+
+// ============================================================================
+// SmallVector tests
+// ============================================================================
+
+TEST(SmallVectorTest, StaysInlineWithinCapacity) {
+    SmallVector<int, 4> vec;
+    EXPECT_TRUE(vec.empty());
+    EXPECT_TRUE(vec.IsInline());
+
+    vec = {1, 2, 3, 4};
+    ASSERT_EQ(vec.size(), 4u);
+    EXPECT_TRUE(vec.IsInline());
+    EXPECT_EQ(vec[0], 1);
+    EXPECT_EQ(vec[3], 4);
+}
+
+TEST(SmallVectorTest, SpillsToHeapAndKeepsContents) {
+    SmallVector<int, 4> vec;
+    for (int i = 0; i < 20; ++i) {
+        vec.push_back(i);
+    }
+    ASSERT_EQ(vec.size(), 20u);
+    EXPECT_FALSE(vec.IsInline());
+    for (int i = 0; i < 20; ++i) {
+        EXPECT_EQ(vec[static_cast<std::size_t>(i)], i);
+    }
+
+    // 拷贝与移动保持内容，移动后源可复用
+    SmallVector<int, 4> copy = vec;
+    EXPECT_EQ(copy.size(), 20u);
+    SmallVector<int, 4> moved = std::move(vec);
+    EXPECT_EQ(moved.size(), 20u);
+    EXPECT_EQ(moved[19], 19);
+    vec = {7};
+    ASSERT_EQ(vec.size(), 1u);
+    EXPECT_EQ(vec[0], 7);
+}
+
+TEST(SmallVectorTest, AssignFromIteratorRange) {
+    const std::vector<int> source = {5, 80, 1, 5};
+    SmallVector<int, 8> vec;
+    vec.assign(source.begin(), source.end());
+    ASSERT_EQ(vec.size(), 4u);
+    EXPECT_TRUE(vec.IsInline());
+    EXPECT_EQ(vec[1], 80);
+}
+
+// ============================================================================
+// SmallString tests
+// ============================================================================
+
+TEST(SmallStringTest, InlineAssignAndAppend) {
+    SmallString<16> str;
+    EXPECT_TRUE(str.empty());
+    EXPECT_TRUE(str.IsInline());
+
+    str = "abc";
+    str += "def";
+    str += '!';
+    EXPECT_EQ(str, "abcdef!");
+    EXPECT_EQ(str.size(), 7u);
+    EXPECT_TRUE(str.IsInline());
+    EXPECT_STREQ(str.c_str(), "abcdef!");
+}
+
+TEST(SmallStringTest, SpillsToHeapBeyondInlineCapacity) {
+    SmallString<8> str;
+    const std::string long_text(64, 'x');
+    str = long_text;
+    EXPECT_EQ(str.size(), 64u);
+    EXPECT_FALSE(str.IsInline());
+    EXPECT_EQ(str.str(), long_text);
+
+    SmallString<8> moved = std::move(str);
+    EXPECT_EQ(moved.size(), 64u);
+    EXPECT_TRUE(str.empty());
+}
+
+// ============================================================================
+// Hot structs end-to-end
+// ============================================================================
+
+TEST(SmallBufferHotStructTest, DecisionPathAvoidsHeapForTypicalSizes) {
+    AlgorithmService service;
+
+    AIDecisionRequest request;
+    request.npc_id = 1;
+    request.context = {5, 80, 1, 5};
+    EXPECT_TRUE(request.context.IsInline());
+
+    const AIDecisionResult result = service.MakeAIDecision(request);
+    EXPECT_FALSE(result.description.empty());
+    // 典型描述长度落在内联容量内，不触发堆分配
+    EXPECT_TRUE(result.description.IsInline());
+}
@@ -0,0 +1,139 @@
+/*
+ * test_state_checkpoint.cpp
+ * AlgorithmService state checkpoint save/restore tests
+ */
+#include <gtest/gtest.h>
+#include "AlgorithmService.h"
+#include "AIDecisionEngine.h"
+#include "CooldownTracker.h"
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+using namespace algorithm;
+
+namespace {
+
+// Unique checkpoint path under the system temp dir, removed on scope exit.
+class TempCheckpointFile {
+public:
+    explicit TempCheckpointFile(const char* name)
+        : path_((std::filesystem::temp_directory_path() / name).string()) {
+        std::remove(path_.c_str());
+    }
+    ~TempCheckpointFile() { std::remove(path_.c_str()); }
+
+    const std::string& path() const { return path_; }
+
+private:
+    std::string path_;
+};
+
+} // namespace
+
+TEST(StateCheckpointTest, SaveAndRestoreRoundTrip) {
+    TempCheckpointFile file("algo_ckpt_roundtrip.bin");
+
+    AlgorithmService original;
+    CharacterStats hero = original.GetDefaultStats(Profession::Warrior, 12);
+    hero.character_id = 7;
+    hero.name = "Checkpoint Hero";
+    hero.current_hp = 123.0f;
+    original.RegisterCharacter(hero);
+    original.RegisterNPCType(42, NPCType::Boss);
+    original.StartSkillCooldown(7, 101, 60000);
+    original.TickCooldowns(10000);
+
+    ASSERT_TRUE(original.SaveStateCheckpoint(file.path()));
+
+    AlgorithmService restored;
+    ASSERT_TRUE(restored.LoadStateCheckpoint(file.path()));
+
+    const CharacterStats* stats = restored.GetCharacterStats(7);
+    ASSERT_NE(stats, nullptr);
+    EXPECT_EQ(stats->name, "Checkpoint Hero");
+    EXPECT_EQ(stats->profession, Profession::Warrior);
+    EXPECT_EQ(stats->level, 12);
+    EXPECT_FLOAT_EQ(stats->current_hp, 123.0f);
+
+    // Cooldown resumes with the remaining time, not from scratch.
+    EXPECT_FALSE(restored.IsSkillReady(7, 101));
+    restored.TickCooldowns(50000);
+    EXPECT_TRUE(restored.IsSkillReady(7, 101));
+}
+
+TEST(StateCheckpointTest, LoadRejectsMissingAndCorruptFiles) {
+    TempCheckpointFile file("algo_ckpt_corrupt.bin");
+
+    AlgorithmService service;
+    EXPECT_FALSE(service.LoadStateCheckpoint(file.path()));
+
+    {
+        std::ofstream out(file.path(), std::ios::binary);
+        out << "not a checkpoint";
+    }
+    EXPECT_FALSE(service.LoadStateCheckpoint(file.path()));
+}
+
+TEST(StateCheckpointTest, SaveOverwritesPreviousCheckpoint) {
+    TempCheckpointFile file("algo_ckpt_overwrite.bin");
+
+    AlgorithmService service;
+    CharacterStats first = service.GetDefaultStats(Profession::Mage, 3);
+    first.character_id = 1;
+    service.RegisterCharacter(first);
+    ASSERT_TRUE(service.SaveStateCheckpoint(file.path()));
+
+    CharacterStats second = service.GetDefaultStats(Profession::Archer, 5);
+    second.character_id = 2;
+    service.RegisterCharacter(second);
+    ASSERT_TRUE(service.SaveStateCheckpoint(file.path()));
+
+    AlgorithmService restored;
+    ASSERT_TRUE(restored.LoadStateCheckpoint(file.path()));
+    EXPECT_NE(restored.GetCharacterStats(1), nullptr);
+    EXPECT_NE(restored.GetCharacterStats(2), nullptr);
+}
+
+TEST(CooldownTrackerCheckpointTest, ExportImportPreservesRemainingTime) {
+    CooldownTracker tracker;
+    tracker.startCooldown(1, 100, 5000);
+    tracker.startCooldown(2, 200, 1000);
+    tracker.tickAll(2000);  // skill 200 has expired, skill 100 has 3s left
+
+    std::vector<CooldownTracker::SnapshotEntry> entries;
+    const int64_t clock_ms = tracker.exportState(entries);
+    ASSERT_EQ(entries.size(), 1u);  // expired cooldowns are not exported
+
+    CooldownTracker restored;
+    restored.importState(clock_ms, entries);
+    EXPECT_FALSE(restored.isReady(1, 100));
+    EXPECT_EQ(restored.getRemainingCooldown(1, 100), 3000);
+    EXPECT_TRUE(restored.isReady(2, 200));
+}
+
+TEST(AIDecisionEngineCheckpointTest, MemoryExportImportKeepsRecentActions) {
+    AIDecisionEngine engine;
+    engine.RegisterNPCType(5, NPCType::Warrior);
+    // Overfill the ring so only the most recent entries survive.
+    for (int action = 1; action <= 7; ++action) {
+        AIDecisionRequest request;
+        request.npc_id = 5;
+        request.context = {3, 80, 1, 2};
+        engine.MakeDecision(request);
+    }
+
+    const auto exported = engine.ExportDecisionMemory();
+    ASSERT_EQ(exported.size(), 1u);
+    EXPECT_EQ(exported[0].npc_id, 5);
+    EXPECT_FALSE(exported[0].recent_actions.empty());
+
+    AIDecisionEngine restored;
+    restored.ImportDecisionMemory(exported);
+    const auto round_trip = restored.ExportDecisionMemory();
+    ASSERT_EQ(round_trip.size(), 1u);
+    EXPECT_EQ(round_trip[0].recent_actions, exported[0].recent_actions);
+}
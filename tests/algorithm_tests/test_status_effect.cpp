@@ -4,6 +4,7 @@
  */
 #include <gtest/gtest.h>
 #include "StatusEffect.h"
+#include "StatusEffectPool.h"
 
 using namespace algorithm;
 
@@ -198,3 +199,54 @@ TEST(StatusEffectHelper, EmptyEffectsDefaultMultipliers) {
     EXPECT_FLOAT_EQ(StatusEffectHelper::getTotalDamageOverTime(empty, 1000.0f), 0.0f);
     EXPECT_FLOAT_EQ(StatusEffectHelper::getTotalShieldAmount(empty), 0.0f);
 }
+
+// ============================================================================
+// StatusEffectPool / ActiveEffectList tests
+// ============================================================================
+
+TEST(StatusEffectPool, AcquireGetRelease) {
+    StatusEffectPool pool;
+    auto handle = pool.acquire(StatusEffectHelper::createBurn(5.0f, 3));
+    ASSERT_NE(handle, StatusEffectPool::INVALID_HANDLE);
+
+    const StatusEffect* effect = pool.get(handle);
+    ASSERT_NE(effect, nullptr);
+    EXPECT_EQ(effect->type, StatusEffectType::Burn);
+    EXPECT_EQ(pool.activeCount(), 1u);
+
+    pool.release(handle);
+    EXPECT_EQ(pool.get(handle), nullptr);
+    EXPECT_EQ(pool.activeCount(), 0u);
+}
+
+TEST(StatusEffectPool, SlotReuseInvalidatesStaleHandle) {
+    StatusEffectPool pool;
+    auto first = pool.acquire(StatusEffectHelper::createPoison(0.05f, 2));
+    pool.release(first);
+
+    // 槽位被复用，旧句柄必须失效
+    auto second = pool.acquire(StatusEffectHelper::createShield(30.0f, 2));
+    EXPECT_EQ(pool.capacity(), 1u);
+    EXPECT_EQ(pool.get(first), nullptr);
+    ASSERT_NE(pool.get(second), nullptr);
+    EXPECT_EQ(pool.get(second)->type, StatusEffectType::Shield);
+}
+
+TEST(ActiveEffectList, AddRemoveSwapsFromTail) {
+    ActiveEffectList list;
+    EXPECT_TRUE(list.add(1));
+    EXPECT_TRUE(list.add(2));
+    EXPECT_TRUE(list.add(3));
+    list.removeAt(0);
+    EXPECT_EQ(list.size(), 2u);
+    EXPECT_EQ(list[0], 3u);  // 尾部交换
+    EXPECT_EQ(list[1], 2u);
+}
+
+TEST(ActiveEffectList, RejectsWhenFull) {
+    ActiveEffectList list;
+    for (size_t i = 0; i < ActiveEffectList::MAX_EFFECTS; ++i) {
+        EXPECT_TRUE(list.add(static_cast<StatusEffectPool::Handle>(i + 1)));
+    }
+    EXPECT_FALSE(list.add(999));
+}
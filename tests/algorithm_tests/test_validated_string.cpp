@@ -0,0 +1,92 @@
+/*
+ * test_validated_string.cpp
+ * PlayerName/ChatLine validated-string type tests
+ */
+#include <gtest/gtest.h>
+#include "ValidatedString.h"
+#include "InputValidator.h"
+#include <string>
+
+using namespace algorithm;
+
+// ============================================================================
+// PlayerName
+// ============================================================================
+
+TEST(PlayerNameTest, AcceptsAsciiAndCjkNames) {
+    EXPECT_TRUE(PlayerName::Validate("Hero").success);
+    EXPECT_TRUE(PlayerName::Validate("hero_42").success);
+    EXPECT_TRUE(PlayerName::Validate("a-b-c").success);
+    EXPECT_TRUE(PlayerName::Validate("勇者阿光").success);
+    EXPECT_TRUE(PlayerName::Validate("Hero勇者").success);
+}
+
+TEST(PlayerNameTest, RejectsForbiddenAscii) {
+    EXPECT_FALSE(PlayerName::Validate("").success);
+    EXPECT_FALSE(PlayerName::Validate("has space").success);
+    EXPECT_FALSE(PlayerName::Validate("semi;colon").success);
+    EXPECT_FALSE(PlayerName::Validate("new\nline").success);
+    EXPECT_FALSE(PlayerName::Validate("-leading").success);
+}
+
+TEST(PlayerNameTest, RejectsOverlongInput) {
+    const std::string too_long(PlayerName::MAX_BYTES + 1, 'a');
+    EXPECT_FALSE(PlayerName::Validate(too_long).success);
+    EXPECT_TRUE(PlayerName::Validate(std::string(PlayerName::MAX_BYTES, 'a')).success);
+}
+
+TEST(PlayerNameTest, RejectsMalformedUtf8) {
+    // Truncated lead byte, bare continuation, overlong encoding,
+    // UTF-16 surrogate, and beyond U+10FFFF.
+    EXPECT_FALSE(PlayerName::Validate("a\xE4\xBD").success);
+    EXPECT_FALSE(PlayerName::Validate("a\x80z").success);
+    EXPECT_FALSE(PlayerName::Validate("a\xC0\xAFz").success);
+    EXPECT_FALSE(PlayerName::Validate("a\xE0\x9F\xBFz").success);
+    EXPECT_FALSE(PlayerName::Validate("a\xED\xA0\x80z").success);
+    EXPECT_FALSE(PlayerName::Validate("a\xF4\x90\x80\x80z").success);
+}
+
+TEST(PlayerNameTest, CreateCarriesValidatedValue) {
+    const auto name = PlayerName::Create("勇者_01");
+    ASSERT_TRUE(name.has_value());
+    EXPECT_EQ(name->value(), "勇者_01");
+
+    EXPECT_FALSE(PlayerName::Create("bad name").has_value());
+}
+
+// ============================================================================
+// ChatLine
+// ============================================================================
+
+TEST(ChatLineTest, AcceptsPrintableAsciiAndUtf8) {
+    EXPECT_TRUE(ChatLine::Validate("gg wp, nice fight!").success);
+    EXPECT_TRUE(ChatLine::Validate("组队刷副本，来两个奶").success);
+    EXPECT_TRUE(ChatLine::Validate("emoji \xF0\x9F\x98\x80 ok").success);
+}
+
+TEST(ChatLineTest, RejectsControlCharacters) {
+    EXPECT_FALSE(ChatLine::Validate("").success);
+    EXPECT_FALSE(ChatLine::Validate("line\nbreak").success);
+    EXPECT_FALSE(ChatLine::Validate("tab\there").success);
+    EXPECT_FALSE(ChatLine::Validate(std::string("nul\0byte", 8)).success);
+}
+
+TEST(ChatLineTest, RejectsOverlongInput) {
+    EXPECT_TRUE(ChatLine::Validate(std::string(ChatLine::MAX_BYTES, 'x')).success);
+    EXPECT_FALSE(ChatLine::Validate(std::string(ChatLine::MAX_BYTES + 1, 'x')).success);
+}
+
+// ============================================================================
+// InputValidator field-rule integration
+// ============================================================================
+
+TEST(ValidatedStringFieldRules, NameAndChatFieldsUseTypedValidation) {
+    InputValidator validator;
+
+    EXPECT_TRUE(validator.validateField("name", "Hero勇者").success);
+    EXPECT_FALSE(validator.validateField("name", "has space").success);
+    EXPECT_FALSE(validator.validateField("player_name", "a\x80z").success);
+
+    EXPECT_TRUE(validator.validateField("chat_line", "hello world").success);
+    EXPECT_FALSE(validator.validateField("message", "line\nbreak").success);
+}
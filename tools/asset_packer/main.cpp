@@ -0,0 +1,254 @@
+/*
+ * 文件名: main.cpp
+ * 说明: FLPK资源包构建工具。
+ * 作者: 彭承康
+ * 创建时间: 2026-08-28
+ *
+ * 用法: asset_packer <输出.flpk> <资源目录> [--compress]
+ *
+ * 将资源目录下的所有文件打包为单个FLPK归档，供客户端一次
+ * mmap后直接访问，消除冷启动时数千次小文件打开的开销。
+ * 二进制布局必须与 application/include/core/AssetPack.h 的
+ * 读取器保持一致：
+ *   头部64字节: magic "FLPK"(4) + version(4, LE) + entryCount(8, LE)
+ *               + indexOffset(8, LE) + indexSize(8, LE) + 保留
+ *   数据区:     每个条目起始位置按64字节对齐
+ *   索引区:     pathLength(2) + path(UTF-8) + dataOffset(8)
+ *               + storedSize(8) + originalSize(8) + flags(4)
+ * 压缩条目(flags=1)的载荷使用qCompress兼容格式：
+ * 4字节大端原始大小 + zlib流，客户端用qUncompress还原。
+ * 只依赖标准库；zlib存在时才启用--compress。
+ */
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#ifdef ASSET_PACKER_HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+namespace {
+
+constexpr std::uint32_t FORMAT_VERSION = 1;
+constexpr std::size_t HEADER_SIZE = 64;
+constexpr std::size_t DATA_ALIGNMENT = 64;
+constexpr std::uint32_t FLAG_COMPRESSED = 1;
+
+/**
+ * @brief 单个归档条目的索引信息
+ */
+struct PackEntry {
+    std::string path;               ///< 归档内相对路径（'/'分隔）
+    std::uint64_t dataOffset = 0;   ///< 数据块偏移
+    std::uint64_t storedSize = 0;   ///< 存储大小（含压缩头）
+    std::uint64_t originalSize = 0; ///< 原始大小
+    std::uint32_t flags = 0;        ///< 条目标志位
+};
+
+void appendLe16(std::vector<unsigned char> &out, std::uint16_t value)
+{
+    out.push_back(static_cast<unsigned char>(value & 0xFF));
+    out.push_back(static_cast<unsigned char>((value >> 8) & 0xFF));
+}
+
+void appendLe32(std::vector<unsigned char> &out, std::uint32_t value)
+{
+    for (int i = 0; i < 4; ++i) {
+        out.push_back(static_cast<unsigned char>((value >> (8 * i)) & 0xFF));
+    }
+}
+
+void appendLe64(std::vector<unsigned char> &out, std::uint64_t value)
+{
+    for (int i = 0; i < 8; ++i) {
+        out.push_back(static_cast<unsigned char>((value >> (8 * i)) & 0xFF));
+    }
+}
+
+/**
+ * @brief 读取整个文件
+ *
+ * @param path 文件路径
+ * @param data 输出参数，文件内容
+ * @return bool 是否读取成功
+ */
+bool readFile(const std::filesystem::path &path, std::vector<unsigned char> &data)
+{
+    std::ifstream in(path, std::ios::binary | std::ios::ate);
+    if (!in) {
+        return false;
+    }
+    const std::streamsize size = in.tellg();
+    in.seekg(0);
+    data.resize(static_cast<std::size_t>(size));
+    return size == 0 ||
+           static_cast<bool>(in.read(reinterpret_cast<char *>(data.data()), size));
+}
+
+#ifdef ASSET_PACKER_HAVE_ZLIB
+/**
+ * @brief 按qCompress兼容格式压缩
+ *
+ * 输出为4字节大端原始大小 + zlib流；压缩无收益时返回false。
+ *
+ * @param raw 原始数据
+ * @param out 输出参数，压缩结果
+ * @return bool 是否采用压缩
+ */
+bool compressEntry(const std::vector<unsigned char> &raw, std::vector<unsigned char> &out)
+{
+    uLongf bound = compressBound(static_cast<uLong>(raw.size()));
+    out.resize(4 + bound);
+
+    const std::uint32_t originalSize = static_cast<std::uint32_t>(raw.size());
+    out[0] = static_cast<unsigned char>((originalSize >> 24) & 0xFF);
+    out[1] = static_cast<unsigned char>((originalSize >> 16) & 0xFF);
+    out[2] = static_cast<unsigned char>((originalSize >> 8) & 0xFF);
+    out[3] = static_cast<unsigned char>(originalSize & 0xFF);
+
+    if (compress2(out.data() + 4, &bound, raw.data(),
+                  static_cast<uLong>(raw.size()), Z_BEST_COMPRESSION) != Z_OK) {
+        return false;
+    }
+    out.resize(4 + bound);
+
+    // 压缩后反而更大就放弃，保留零拷贝读取能力
+    return out.size() < raw.size();
+}
+#endif
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    if (argc < 3) {
+        std::cerr << "用法: " << argv[0] << " <输出.flpk> <资源目录> [--compress]\n";
+        return 1;
+    }
+
+    const std::filesystem::path outputPath = argv[1];
+    const std::filesystem::path inputDir = argv[2];
+    bool wantCompression = (argc > 3 && std::string(argv[3]) == "--compress");
+
+    if (!std::filesystem::is_directory(inputDir)) {
+        std::cerr << "asset_packer: 资源目录不存在: " << inputDir << "\n";
+        return 1;
+    }
+
+#ifndef ASSET_PACKER_HAVE_ZLIB
+    if (wantCompression) {
+        std::cerr << "asset_packer: 构建时未找到zlib，--compress被忽略\n";
+        wantCompression = false;
+    }
+#endif
+
+    std::ofstream out(outputPath, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        std::cerr << "asset_packer: 无法创建输出文件: " << outputPath << "\n";
+        return 1;
+    }
+
+    // 先写占位头部，条目与索引写完后回填
+    const std::vector<char> headerPlaceholder(HEADER_SIZE, 0);
+    out.write(headerPlaceholder.data(), static_cast<std::streamsize>(HEADER_SIZE));
+
+    std::vector<PackEntry> entries;
+    std::uint64_t cursor = HEADER_SIZE;
+    std::uint64_t totalOriginal = 0;
+    std::uint64_t totalStored = 0;
+
+    for (const auto &dirEntry :
+         std::filesystem::recursive_directory_iterator(inputDir)) {
+        if (!dirEntry.is_regular_file()) {
+            continue;
+        }
+
+        std::vector<unsigned char> raw;
+        if (!readFile(dirEntry.path(), raw)) {
+            std::cerr << "asset_packer: 读取失败，跳过: " << dirEntry.path() << "\n";
+            continue;
+        }
+
+        PackEntry entry;
+        entry.path =
+            std::filesystem::relative(dirEntry.path(), inputDir).generic_string();
+        entry.originalSize = raw.size();
+
+        const std::vector<unsigned char> *payload = &raw;
+#ifdef ASSET_PACKER_HAVE_ZLIB
+        std::vector<unsigned char> compressed;
+        if (wantCompression && !raw.empty() && compressEntry(raw, compressed)) {
+            payload = &compressed;
+            entry.flags |= FLAG_COMPRESSED;
+        }
+#endif
+        entry.storedSize = payload->size();
+
+        // 数据块按64字节对齐，未压缩条目可零拷贝解码
+        const std::uint64_t padding =
+            (DATA_ALIGNMENT - cursor % DATA_ALIGNMENT) % DATA_ALIGNMENT;
+        if (padding > 0) {
+            const std::vector<char> zeros(padding, 0);
+            out.write(zeros.data(), static_cast<std::streamsize>(padding));
+            cursor += padding;
+        }
+
+        entry.dataOffset = cursor;
+        out.write(reinterpret_cast<const char *>(payload->data()),
+                  static_cast<std::streamsize>(payload->size()));
+        cursor += payload->size();
+
+        totalOriginal += entry.originalSize;
+        totalStored += entry.storedSize;
+        entries.push_back(std::move(entry));
+    }
+
+    // 索引区
+    const std::uint64_t indexOffset = cursor;
+    std::vector<unsigned char> index;
+    for (const PackEntry &entry : entries) {
+        if (entry.path.size() > UINT16_MAX) {
+            std::cerr << "asset_packer: 路径过长，跳过索引: " << entry.path << "\n";
+            continue;
+        }
+        appendLe16(index, static_cast<std::uint16_t>(entry.path.size()));
+        index.insert(index.end(), entry.path.begin(), entry.path.end());
+        appendLe64(index, entry.dataOffset);
+        appendLe64(index, entry.storedSize);
+        appendLe64(index, entry.originalSize);
+        appendLe32(index, entry.flags);
+    }
+    out.write(reinterpret_cast<const char *>(index.data()),
+              static_cast<std::streamsize>(index.size()));
+
+    // 回填头部
+    std::vector<unsigned char> header;
+    header.push_back('F');
+    header.push_back('L');
+    header.push_back('P');
+    header.push_back('K');
+    appendLe32(header, FORMAT_VERSION);
+    appendLe64(header, entries.size());
+    appendLe64(header, indexOffset);
+    appendLe64(header, index.size());
+    header.resize(HEADER_SIZE, 0);
+
+    out.seekp(0);
+    out.write(reinterpret_cast<const char *>(header.data()),
+              static_cast<std::streamsize>(header.size()));
+    out.close();
+
+    if (!out) {
+        std::cerr << "asset_packer: 写入失败: " << outputPath << "\n";
+        return 1;
+    }
+
+    std::cout << "asset_packer: 打包完成 " << outputPath << "，共 " << entries.size()
+              << " 个条目，原始 " << totalOriginal << " 字节，存储 " << totalStored
+              << " 字节\n";
+    return 0;
+}
@@ -0,0 +1,180 @@
+/*
+ * 文件名: main.cpp
+ * 说明: 纹理图集构建工具。
+ * 作者: 彭承康
+ * 创建时间: 2026-08-28
+ *
+ * 用法: atlas_packer <输出基名> <图像目录> [--max-width N]
+ *
+ * 将目录下的零散精灵图像合并为一张图集（<基名>.png）和对应的
+ * JSON索引（<基名>.json），供 SpriteRenderer::loadAtlas 在运行时
+ * 做区域查询。同一图集内的精灵在批量渲染时合并为一个绘制批次，
+ * 这是密集战斗场景降低绘制调用数的前提。
+ *
+ * 打包算法为简单的货架式（shelf）装箱：按高度降序排列后逐行
+ * 填充，行宽超过--max-width（默认2048）时换行。对游戏里以
+ * 小图标和角色帧为主的素材，空间利用率足够且结果可复现。
+ *
+ * 索引格式与读取端一致：
+ *   { "regions": { "ui/button_normal": { "x":0, "y":0, "w":64, "h":32 } } }
+ * 区域名为相对路径去掉扩展名。
+ */
+#include <QCoreApplication>
+#include <QDir>
+#include <QDirIterator>
+#include <QFile>
+#include <QImage>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QPainter>
+
+#include <algorithm>
+#include <cstdio>
+
+namespace {
+
+constexpr int DEFAULT_MAX_WIDTH = 2048;
+/// 区域间留白，避免采样时相邻区域渗色
+constexpr int REGION_PADDING = 2;
+
+/**
+ * @brief 待打包的单张图像
+ */
+struct SourceImage {
+    QString regionName;     ///< 区域名（相对路径去扩展名）
+    QImage image;           ///< 图像数据
+    int x = 0;              ///< 在图集中的位置
+    int y = 0;
+};
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+
+    const QStringList args = app.arguments();
+    if (args.size() < 3) {
+        std::fprintf(stderr, "用法: atlas_packer <输出基名> <图像目录> [--max-width N]\n");
+        return 1;
+    }
+
+    const QString outputBase = args.at(1);
+    const QDir inputDir(args.at(2));
+    int maxWidth = DEFAULT_MAX_WIDTH;
+    if (args.size() > 4 && args.at(3) == QStringLiteral("--max-width")) {
+        maxWidth = args.at(4).toInt();
+        if (maxWidth <= 0) {
+            std::fprintf(stderr, "atlas_packer: 无效的--max-width值\n");
+            return 1;
+        }
+    }
+
+    if (!inputDir.exists()) {
+        std::fprintf(stderr, "atlas_packer: 图像目录不存在: %s\n",
+                     qPrintable(inputDir.path()));
+        return 1;
+    }
+
+    // 收集所有可加载的图像
+    std::vector<SourceImage> sources;
+    QDirIterator iterator(inputDir.path(),
+                          { "*.png", "*.jpg", "*.jpeg", "*.bmp" },
+                          QDir::Files, QDirIterator::Subdirectories);
+    while (iterator.hasNext()) {
+        const QString filePath = iterator.next();
+        QImage image(filePath);
+        if (image.isNull()) {
+            std::fprintf(stderr, "atlas_packer: 图像加载失败，跳过: %s\n",
+                         qPrintable(filePath));
+            continue;
+        }
+        if (image.width() + 2 * REGION_PADDING > maxWidth) {
+            std::fprintf(stderr, "atlas_packer: 图像宽度超过图集上限，跳过: %s\n",
+                         qPrintable(filePath));
+            continue;
+        }
+
+        SourceImage source;
+        QString relative = inputDir.relativeFilePath(filePath);
+        const int dot = relative.lastIndexOf(QLatin1Char('.'));
+        source.regionName = (dot > 0) ? relative.left(dot) : relative;
+        source.image = image.convertToFormat(QImage::Format_ARGB32_Premultiplied);
+        sources.push_back(std::move(source));
+    }
+
+    if (sources.empty()) {
+        std::fprintf(stderr, "atlas_packer: 目录下没有可打包的图像\n");
+        return 1;
+    }
+
+    // 货架式装箱：按高度降序逐行填充，行满换行
+    std::sort(sources.begin(), sources.end(),
+              [](const SourceImage &a, const SourceImage &b) {
+                  if (a.image.height() != b.image.height()) {
+                      return a.image.height() > b.image.height();
+                  }
+                  return a.regionName < b.regionName;
+              });
+
+    int cursorX = REGION_PADDING;
+    int cursorY = REGION_PADDING;
+    int shelfHeight = 0;
+    int atlasWidth = 0;
+    for (SourceImage &source : sources) {
+        const int width = source.image.width();
+        const int height = source.image.height();
+        if (cursorX + width + REGION_PADDING > maxWidth) {
+            cursorX = REGION_PADDING;
+            cursorY += shelfHeight + REGION_PADDING;
+            shelfHeight = 0;
+        }
+        source.x = cursorX;
+        source.y = cursorY;
+        cursorX += width + REGION_PADDING;
+        shelfHeight = std::max(shelfHeight, height);
+        atlasWidth = std::max(atlasWidth, cursorX);
+    }
+    const int atlasHeight = cursorY + shelfHeight + REGION_PADDING;
+
+    // 合成图集
+    QImage atlas(atlasWidth, atlasHeight, QImage::Format_ARGB32_Premultiplied);
+    atlas.fill(Qt::transparent);
+    {
+        QPainter painter(&atlas);
+        for (const SourceImage &source : sources) {
+            painter.drawImage(source.x, source.y, source.image);
+        }
+    }
+
+    const QString imagePath = outputBase + QStringLiteral(".png");
+    if (!atlas.save(imagePath)) {
+        std::fprintf(stderr, "atlas_packer: 图集保存失败: %s\n", qPrintable(imagePath));
+        return 1;
+    }
+
+    // 写索引
+    QJsonObject regions;
+    for (const SourceImage &source : sources) {
+        QJsonObject region;
+        region.insert(QStringLiteral("x"), source.x);
+        region.insert(QStringLiteral("y"), source.y);
+        region.insert(QStringLiteral("w"), source.image.width());
+        region.insert(QStringLiteral("h"), source.image.height());
+        regions.insert(source.regionName, region);
+    }
+    QJsonObject root;
+    root.insert(QStringLiteral("regions"), regions);
+
+    const QString indexPath = outputBase + QStringLiteral(".json");
+    QFile indexFile(indexPath);
+    if (!indexFile.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        std::fprintf(stderr, "atlas_packer: 索引保存失败: %s\n", qPrintable(indexPath));
+        return 1;
+    }
+    indexFile.write(QJsonDocument(root).toJson(QJsonDocument::Indented));
+
+    std::printf("atlas_packer: 打包完成 %s (%dx%d)，共 %zu 个区域\n",
+                qPrintable(imagePath), atlasWidth, atlasHeight, sources.size());
+    return 0;
+}
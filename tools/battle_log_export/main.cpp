@@ -0,0 +1,151 @@
+/*
+ * 文件名: main.cpp
+ * 说明: 战斗动作日志导出查看工具。
+ * 作者: 彭承康
+ * 创建时间: 2026-08-28
+ *
+ * 用法: battle_log_export <battle_log.bin> [--csv]
+ *
+ * 读取客户端 BattleActionLog::exportBinary 导出的二进制战斗
+ * 日志（魔数FLBL，小端定长记录），按记录顺序打印每个动作的
+ * 回合、行动者、目标、技能、伤害与标志位，用于支持工单排查
+ * "这场战斗发生了什么"。--csv 输出逗号分隔格式便于导入表格。
+ */
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr std::uint32_t EXPORT_MAGIC = 0x464C424C;  // "FLBL"
+constexpr std::uint16_t EXPORT_VERSION = 1;
+
+// 与 BattleActionLog::Flag 保持一致
+constexpr std::uint16_t FLAG_CRITICAL = 0x1;
+constexpr std::uint16_t FLAG_TARGET_DEFEATED = 0x2;
+constexpr std::uint16_t FLAG_ENEMY_ACTION = 0x4;
+constexpr std::uint16_t FLAG_SKILL = 0x8;
+
+/**
+ * @brief 一条定长动作记录（与客户端导出布局一致）
+ */
+struct ActionRecord {
+    std::uint16_t turn = 0;
+    std::int16_t actorId = 0;
+    std::int16_t targetId = 0;
+    std::uint16_t skillId = 0;
+    std::int32_t damage = 0;
+    std::uint16_t flags = 0;
+};
+
+std::uint16_t readU16(std::istream &stream)
+{
+    unsigned char bytes[2] = {0, 0};
+    stream.read(reinterpret_cast<char *>(bytes), 2);
+    return static_cast<std::uint16_t>(bytes[0] | (bytes[1] << 8));
+}
+
+std::uint32_t readU32(std::istream &stream)
+{
+    unsigned char bytes[4] = {0, 0, 0, 0};
+    stream.read(reinterpret_cast<char *>(bytes), 4);
+    return static_cast<std::uint32_t>(bytes[0]) |
+           (static_cast<std::uint32_t>(bytes[1]) << 8) |
+           (static_cast<std::uint32_t>(bytes[2]) << 16) |
+           (static_cast<std::uint32_t>(bytes[3]) << 24);
+}
+
+std::string actorName(std::int16_t actorId)
+{
+    return actorId == -1 ? "玩家" : "敌人" + std::to_string(actorId);
+}
+
+std::string flagText(std::uint16_t flags)
+{
+    std::string text;
+    if (flags & FLAG_CRITICAL) {
+        text += " 暴击";
+    }
+    if (flags & FLAG_TARGET_DEFEATED) {
+        text += " 目标倒下";
+    }
+    return text;
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    if (argc < 2) {
+        std::cerr << "用法: battle_log_export <battle_log.bin> [--csv]" << std::endl;
+        return 1;
+    }
+
+    const std::string path = argv[1];
+    const bool csv = argc > 2 && std::strcmp(argv[2], "--csv") == 0;
+
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        std::cerr << "无法打开文件: " << path << std::endl;
+        return 1;
+    }
+
+    if (readU32(file) != EXPORT_MAGIC) {
+        std::cerr << "不是战斗日志导出文件（魔数不匹配）" << std::endl;
+        return 1;
+    }
+    const std::uint16_t version = readU16(file);
+    if (version != EXPORT_VERSION) {
+        std::cerr << "不支持的格式版本: " << version << std::endl;
+        return 1;
+    }
+
+    const std::uint32_t count = readU32(file);
+    std::vector<ActionRecord> records;
+    records.reserve(count);
+    for (std::uint32_t i = 0; i < count && file; ++i) {
+        ActionRecord record;
+        record.turn = readU16(file);
+        record.actorId = static_cast<std::int16_t>(readU16(file));
+        record.targetId = static_cast<std::int16_t>(readU16(file));
+        record.skillId = readU16(file);
+        record.damage = static_cast<std::int32_t>(readU32(file));
+        record.flags = readU16(file);
+        records.push_back(record);
+    }
+
+    if (records.size() != count) {
+        std::cerr << "文件截断: 预期 " << count << " 条记录，读到 "
+                  << records.size() << " 条" << std::endl;
+        return 1;
+    }
+
+    if (csv) {
+        std::cout << "turn,actor,target,skill,damage,flags\n";
+        for (const ActionRecord &record : records) {
+            std::cout << record.turn << ',' << record.actorId << ','
+                      << record.targetId << ',' << record.skillId << ','
+                      << record.damage << ',' << record.flags << '\n';
+        }
+        return 0;
+    }
+
+    std::cout << "战斗日志: " << records.size() << " 条动作记录" << std::endl;
+    for (const ActionRecord &record : records) {
+        const char *verb = (record.flags & FLAG_SKILL) ? "技能" : "攻击";
+        std::cout << "回合" << record.turn << "  "
+                  << actorName(record.actorId) << " -> "
+                  << actorName(record.targetId) << "  "
+                  << verb;
+        if (record.skillId != 0) {
+            std::cout << "#" << record.skillId;
+        }
+        std::cout << "  伤害 " << record.damage
+                  << flagText(record.flags) << std::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,280 @@
+/*
+ * 文件名: main.cpp
+ * 说明: 无头压测客户端，模拟N个并发玩家对后端服务施压。
+ * 作者: 彭承康
+ * 创建时间: 2026-08-28
+ *
+ * 用法: stress_client [--players N] [--duration 秒]
+ *                     [--algorithm host:port] [--strategy host:port]
+ *                     [--mix 战斗:查询:登录] [--timeout 毫秒]
+ *
+ * 复用游戏客户端的gRPC封装（仅Qt Core，无GUI依赖）。每个模拟
+ * 玩家一个线程、一套独立客户端与通道，按权重混合执行战斗伤害
+ * 计算（算法服务）、世界状态查询和玩家数据加载（登录路径，经
+ * 策略服务的QueryGameState落到PlayerService），结束后汇总各
+ * 动作的吞吐与延迟分位数，上线前就能暴露扩容临界点。
+ */
+#include "network/AlgorithmServiceClient.h"
+#include "network/StrategyServiceClient.h"
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QJsonObject>
+#include <QRandomGenerator>
+#include <QString>
+#include <QStringList>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+namespace {
+
+/**
+ * @brief 压测动作类型
+ */
+enum ActionKind {
+    ACTION_BATTLE = 0,  ///< 战斗伤害计算（算法服务）
+    ACTION_QUERY = 1,   ///< 世界状态查询（策略服务）
+    ACTION_LOGIN = 2,   ///< 玩家数据加载（策略服务，登录路径）
+    ACTION_COUNT = 3
+};
+
+const char *const ACTION_NAMES[ACTION_COUNT] = {"battle", "query", "login"};
+
+/**
+ * @brief 单个动作类型的采样统计
+ */
+struct ActionStats {
+    std::vector<qint64> latenciesUs;    ///< 成功调用的延迟（微秒）
+    qint64 errors = 0;                  ///< 失败次数
+};
+
+/**
+ * @brief 压测配置
+ */
+struct StressConfig {
+    int players = 8;                    ///< 并发模拟玩家数
+    int durationSec = 30;               ///< 压测时长（秒）
+    int timeoutMs = 5000;               ///< 单次RPC超时（毫秒）
+    QString algorithmAddr = QStringLiteral("localhost:50051");
+    QString strategyAddr = QStringLiteral("localhost:50052");
+    int mix[ACTION_COUNT] = {60, 30, 10};   ///< 动作权重 战斗:查询:登录
+};
+
+/**
+ * @brief 模拟玩家工作线程
+ *
+ * 独立的客户端与gRPC通道，按权重随机混合动作直到收到停止
+ * 标志。RNG按线程序号播种，同配置下动作序列可复现。
+ *
+ * @param workerIndex 线程序号
+ * @param config 压测配置
+ * @param stop 停止标志
+ * @param stats 本线程的统计输出（按动作类型索引）
+ */
+void runWorker(int workerIndex, const StressConfig &config,
+               const std::atomic<bool> &stop, ActionStats *stats)
+{
+    AlgorithmServiceClient algorithmClient;
+    StrategyServiceClient strategyClient;
+    algorithmClient.initialize(config.algorithmAddr);
+    strategyClient.initialize(config.strategyAddr);
+    algorithmClient.setTimeout(config.timeoutMs);
+    strategyClient.setTimeout(config.timeoutMs);
+
+    QRandomGenerator rng(static_cast<quint32>(workerIndex + 1));
+    const int mixTotal = config.mix[ACTION_BATTLE] + config.mix[ACTION_QUERY]
+                       + config.mix[ACTION_LOGIN];
+
+    QElapsedTimer latencyTimer;
+    while (!stop.load(std::memory_order_relaxed)) {
+        // 按权重选择动作
+        int roll = rng.bounded(mixTotal);
+        int kind = ACTION_BATTLE;
+        while (roll >= config.mix[kind]) {
+            roll -= config.mix[kind];
+            ++kind;
+        }
+
+        // 客户端封装是同步阻塞调用，回调在返回前执行完毕
+        bool ok = false;
+        const auto recordResult = [&ok](const QJsonObject &response) {
+            ok = !response.value("error").toBool(false);
+        };
+
+        latencyTimer.start();
+        switch (kind) {
+        case ACTION_BATTLE: {
+            QJsonObject request;
+            request["attackerId"] = -1;
+            request["defenderId"] = static_cast<int>(rng.bounded(1, 100));
+            request["skillId"] = static_cast<int>(rng.bounded(4));
+            algorithmClient.calculateDamage(request, recordResult);
+            break;
+        }
+        case ACTION_QUERY:
+            strategyClient.queryWorldState(recordResult);
+            break;
+        case ACTION_LOGIN: {
+            QJsonObject request;
+            request["playerId"] = workerIndex * 1000 + static_cast<int>(rng.bounded(1000));
+            strategyClient.getPlayerData(request, recordResult);
+            break;
+        }
+        default:
+            break;
+        }
+        const qint64 elapsedUs = latencyTimer.nsecsElapsed() / 1000;
+
+        if (ok) {
+            stats[kind].latenciesUs.push_back(elapsedUs);
+        } else {
+            ++stats[kind].errors;
+        }
+    }
+}
+
+/**
+ * @brief 取排序后延迟序列的分位数
+ *
+ * @param sorted 升序延迟序列
+ * @param percentile 分位（0-100）
+ * @return qint64 分位延迟（微秒），序列为空时返回0
+ */
+qint64 percentileUs(const std::vector<qint64> &sorted, int percentile)
+{
+    if (sorted.empty()) {
+        return 0;
+    }
+    const std::size_t index = (sorted.size() - 1) * percentile / 100;
+    return sorted[index];
+}
+
+void printUsage()
+{
+    std::printf("用法: stress_client [--players N] [--duration 秒]\n"
+                "                    [--algorithm host:port] [--strategy host:port]\n"
+                "                    [--mix 战斗:查询:登录] [--timeout 毫秒]\n");
+}
+
+/**
+ * @brief 解析命令行参数
+ *
+ * @param arguments 命令行参数列表
+ * @param config 解析输出
+ * @return bool 是否解析成功
+ */
+bool parseArguments(const QStringList &arguments, StressConfig &config)
+{
+    for (int i = 1; i < arguments.size(); ++i) {
+        const QString &arg = arguments.at(i);
+        const bool hasValue = (i + 1 < arguments.size());
+
+        if (arg == QStringLiteral("--players") && hasValue) {
+            config.players = arguments.at(++i).toInt();
+        } else if (arg == QStringLiteral("--duration") && hasValue) {
+            config.durationSec = arguments.at(++i).toInt();
+        } else if (arg == QStringLiteral("--timeout") && hasValue) {
+            config.timeoutMs = arguments.at(++i).toInt();
+        } else if (arg == QStringLiteral("--algorithm") && hasValue) {
+            config.algorithmAddr = arguments.at(++i);
+        } else if (arg == QStringLiteral("--strategy") && hasValue) {
+            config.strategyAddr = arguments.at(++i);
+        } else if (arg == QStringLiteral("--mix") && hasValue) {
+            const QStringList parts = arguments.at(++i).split(':');
+            if (parts.size() != ACTION_COUNT) {
+                return false;
+            }
+            for (int kind = 0; kind < ACTION_COUNT; ++kind) {
+                config.mix[kind] = parts.at(kind).toInt();
+            }
+        } else {
+            return false;
+        }
+    }
+
+    const int mixTotal = config.mix[ACTION_BATTLE] + config.mix[ACTION_QUERY]
+                       + config.mix[ACTION_LOGIN];
+    return config.players > 0 && config.durationSec > 0 && config.timeoutMs > 0
+        && mixTotal > 0 && config.mix[ACTION_BATTLE] >= 0
+        && config.mix[ACTION_QUERY] >= 0 && config.mix[ACTION_LOGIN] >= 0;
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+
+    StressConfig config;
+    if (!parseArguments(app.arguments(), config)) {
+        printUsage();
+        return 1;
+    }
+
+    std::printf("stress_client: %d 并发玩家, %d 秒, 动作权重 战斗:查询:登录 = %d:%d:%d\n",
+                config.players, config.durationSec,
+                config.mix[ACTION_BATTLE], config.mix[ACTION_QUERY],
+                config.mix[ACTION_LOGIN]);
+    std::printf("stress_client: 算法服务 %s, 策略服务 %s\n",
+                qPrintable(config.algorithmAddr), qPrintable(config.strategyAddr));
+
+    // 每个模拟玩家一个线程和一组独立统计，运行期间无共享写入
+    std::atomic<bool> stop(false);
+    std::vector<std::vector<ActionStats>> workerStats(
+        static_cast<std::size_t>(config.players), std::vector<ActionStats>(ACTION_COUNT));
+    std::vector<std::thread> workers;
+    workers.reserve(static_cast<std::size_t>(config.players));
+
+    QElapsedTimer wallTimer;
+    wallTimer.start();
+    for (int i = 0; i < config.players; ++i) {
+        workers.emplace_back(runWorker, i, std::cref(config), std::cref(stop),
+                             workerStats[static_cast<std::size_t>(i)].data());
+    }
+
+    std::this_thread::sleep_for(std::chrono::seconds(config.durationSec));
+    stop.store(true, std::memory_order_relaxed);
+    for (std::thread &worker : workers) {
+        worker.join();
+    }
+    const double elapsedSec = wallTimer.nsecsElapsed() / 1e9;
+
+    // 汇总并输出各动作的吞吐与延迟分位数
+    std::printf("\n=== 压测结果 (%d 玩家, %.1f 秒) ===\n", config.players, elapsedSec);
+    std::printf("%-8s %10s %8s %10s %10s %10s %10s %10s\n",
+                "动作", "次数", "失败", "qps", "p50(us)", "p90(us)", "p99(us)", "max(us)");
+
+    qint64 totalCalls = 0;
+    for (int kind = 0; kind < ACTION_COUNT; ++kind) {
+        std::vector<qint64> merged;
+        qint64 errors = 0;
+        for (const auto &stats : workerStats) {
+            const ActionStats &actionStats = stats[static_cast<std::size_t>(kind)];
+            merged.insert(merged.end(), actionStats.latenciesUs.begin(),
+                          actionStats.latenciesUs.end());
+            errors += actionStats.errors;
+        }
+        std::sort(merged.begin(), merged.end());
+
+        const qint64 calls = static_cast<qint64>(merged.size()) + errors;
+        totalCalls += calls;
+        std::printf("%-8s %10lld %8lld %10.1f %10lld %10lld %10lld %10lld\n",
+                    ACTION_NAMES[kind],
+                    static_cast<long long>(calls),
+                    static_cast<long long>(errors),
+                    merged.empty() ? 0.0 : merged.size() / elapsedSec,
+                    static_cast<long long>(percentileUs(merged, 50)),
+                    static_cast<long long>(percentileUs(merged, 90)),
+                    static_cast<long long>(percentileUs(merged, 99)),
+                    static_cast<long long>(merged.empty() ? 0 : merged.back()));
+    }
+    std::printf("总计: %lld 次调用, %.1f qps\n",
+                static_cast<long long>(totalCalls), totalCalls / elapsedSec);
+
+    return 0;
+}
@@ -0,0 +1,166 @@
+/*
+ * 文件名: main.cpp
+ * 说明: 跨层追踪时间线合并工具。
+ * 作者: 彭承康
+ * 创建时间: 2026-08-28
+ *
+ * 用法: trace_merge <导出.csv> [<导出.csv> ...] [--trace <id>]
+ *
+ * 读取各进程追踪环导出的CSV文件（trace_id,timestamp_us,hop），
+ * 按trace id归组、按时间戳排序，打印每个动作的跳点时间线和
+ * 相邻跳点间的耗时。指定--trace时只输出单个动作，便于排查
+ * "这次战斗操作慢在哪一层"。时间戳为各进程的系统时钟（微秒），
+ * 同机部署下可直接合并。
+ */
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+/**
+ * @brief 一条追踪记录
+ */
+struct TraceRow {
+    std::uint64_t traceId = 0;      ///< 追踪ID
+    std::int64_t timestampUs = 0;   ///< 系统时钟时间戳（微秒）
+    std::string hop;                ///< 跳点名称
+    std::string source;             ///< 来源文件（区分进程）
+};
+
+bool parseLine(const std::string &line, const std::string &source, TraceRow &row)
+{
+    std::istringstream stream(line);
+    std::string idField;
+    std::string timestampField;
+
+    if (!std::getline(stream, idField, ',') ||
+        !std::getline(stream, timestampField, ',') ||
+        !std::getline(stream, row.hop)) {
+        return false;
+    }
+
+    try {
+        row.traceId = std::stoull(idField);
+        row.timestampUs = std::stoll(timestampField);
+    } catch (const std::exception &) {
+        return false;
+    }
+
+    row.source = source;
+    return row.traceId != 0 && !row.hop.empty();
+}
+
+bool loadFile(const std::string &path, std::vector<TraceRow> &rows)
+{
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        std::cerr << "trace_merge: 无法打开文件: " << path << std::endl;
+        return false;
+    }
+
+    std::string line;
+    while (std::getline(file, line)) {
+        if (line.empty()) {
+            continue;
+        }
+        TraceRow row;
+        if (parseLine(line, path, row)) {
+            rows.push_back(std::move(row));
+        }
+    }
+    return true;
+}
+
+void printTimeline(std::uint64_t traceId, std::vector<TraceRow> rows)
+{
+    std::sort(rows.begin(), rows.end(),
+              [](const TraceRow &a, const TraceRow &b) {
+                  return a.timestampUs < b.timestampUs;
+              });
+
+    const std::int64_t start = rows.front().timestampUs;
+    const std::int64_t total = rows.back().timestampUs - start;
+
+    std::cout << "trace " << traceId << " (" << rows.size() << " 跳点, 共 "
+              << total << "us)" << std::endl;
+
+    std::int64_t previous = start;
+    for (const TraceRow &row : rows) {
+        std::cout << "  +" << (row.timestampUs - start) << "us\t"
+                  << row.hop << "\t(+" << (row.timestampUs - previous)
+                  << "us)\t[" << row.source << "]" << std::endl;
+        previous = row.timestampUs;
+    }
+}
+
+void printUsage()
+{
+    std::cout << "用法: trace_merge <导出.csv> [<导出.csv> ...] [--trace <id>]"
+              << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    std::vector<std::string> files;
+    std::uint64_t onlyTrace = 0;
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg == "--trace") {
+            if (i + 1 >= argc) {
+                printUsage();
+                return 1;
+            }
+            try {
+                onlyTrace = std::stoull(argv[++i]);
+            } catch (const std::exception &) {
+                std::cerr << "trace_merge: 无效的trace id" << std::endl;
+                return 1;
+            }
+        } else if (arg == "--help" || arg == "-h") {
+            printUsage();
+            return 0;
+        } else {
+            files.push_back(arg);
+        }
+    }
+
+    if (files.empty()) {
+        printUsage();
+        return 1;
+    }
+
+    std::vector<TraceRow> rows;
+    for (const std::string &file : files) {
+        if (!loadFile(file, rows)) {
+            return 1;
+        }
+    }
+
+    // 按trace id归组；map保证输出顺序稳定
+    std::map<std::uint64_t, std::vector<TraceRow>> traces;
+    for (TraceRow &row : rows) {
+        if (onlyTrace != 0 && row.traceId != onlyTrace) {
+            continue;
+        }
+        traces[row.traceId].push_back(std::move(row));
+    }
+
+    if (traces.empty()) {
+        std::cout << "trace_merge: 没有匹配的追踪记录" << std::endl;
+        return 0;
+    }
+
+    for (auto &entry : traces) {
+        printTimeline(entry.first, std::move(entry.second));
+    }
+    return 0;
+}